@@ -564,7 +564,9 @@ install(TARGETS onnx_test_runner
         RUNTIME  DESTINATION ${CMAKE_INSTALL_BINDIR})
 
 if(onnxruntime_BUILD_BENCHMARKS)
-  add_executable(onnxruntime_benchmark ${TEST_SRC_DIR}/onnx/microbenchmark/main.cc ${TEST_SRC_DIR}/onnx/microbenchmark/modeltest.cc)
+  add_executable(onnxruntime_benchmark ${TEST_SRC_DIR}/onnx/microbenchmark/main.cc ${TEST_SRC_DIR}/onnx/microbenchmark/modeltest.cc
+                 ${TEST_SRC_DIR}/onnx/microbenchmark/model_zoo.cc ${TEST_SRC_DIR}/onnx/microbenchmark/history_reporter.cc
+                 ${TEST_SRC_DIR}/onnx/microbenchmark/kernel_benchmark.cc ${TEST_SRC_DIR}/onnx/microbenchmark/kernels.cc)
   target_include_directories(onnxruntime_benchmark PRIVATE ${ONNXRUNTIME_ROOT} ${onnxruntime_graph_header} benchmark)
   if(WIN32)
     target_compile_options(onnxruntime_benchmark PRIVATE "$<$<COMPILE_LANGUAGE:CUDA>:-Xcompiler /wd4141>"
@@ -715,6 +717,18 @@ list(APPEND onnxruntime_mlas_test_libs Threads::Threads)
 target_link_libraries(onnxruntime_mlas_test PRIVATE ${onnxruntime_mlas_test_libs})
 set_target_properties(onnxruntime_mlas_test PROPERTIES FOLDER "ONNXRuntimeTest")
 
+if(onnxruntime_BUILD_BENCHMARKS)
+  file(GLOB onnxruntime_mlas_benchmark_src CONFIGURE_DEPENDS
+    "${TEST_SRC_DIR}/mlas/bench/*.cpp"
+    "${TEST_SRC_DIR}/mlas/bench/*.h"
+  )
+  add_executable(onnxruntime_mlas_benchmark ${onnxruntime_mlas_benchmark_src})
+  target_include_directories(onnxruntime_mlas_benchmark PRIVATE ${ONNXRUNTIME_ROOT}/core/mlas/inc ${ONNXRUNTIME_ROOT})
+  target_link_libraries(onnxruntime_mlas_benchmark PRIVATE benchmark ${onnxruntime_mlas_test_libs})
+  add_dependencies(onnxruntime_mlas_benchmark ${onnxruntime_EXTERNAL_DEPENDENCIES})
+  set_target_properties(onnxruntime_mlas_benchmark PROPERTIES FOLDER "ONNXRuntimeTest")
+endif()
+
 add_library(custom_op_library SHARED ${REPO_ROOT}/onnxruntime/test/testdata/custom_op_library/custom_op_library.cc)
 target_include_directories(custom_op_library PRIVATE ${REPO_ROOT}/include)
 if(UNIX)
@@ -6,6 +6,7 @@ using System.Runtime.InteropServices;
 using System.Collections.Generic;
 using System.IO;
 using System.Linq;
+using System.Threading.Tasks;
 
 
 namespace Microsoft.ML.OnnxRuntime
@@ -23,6 +24,14 @@ namespace Microsoft.ML.OnnxRuntime
         private RunOptions _builtInRunOptions = null;
 
 
+        internal IntPtr Handle
+        {
+            get
+            {
+                return _nativeHandle;
+            }
+        }
+
         #region Public API
 
         /// <summary>
@@ -206,6 +215,146 @@ namespace Microsoft.ML.OnnxRuntime
 
         }
 
+        /// <summary>
+        /// Runs the loaded model for the <paramref name="inputValues"/> named <paramref name="inputNames"/>, writing the outputs
+        /// named <paramref name="outputNames"/> to the caller-owned <paramref name="outputValues"/>. The values are reused as they are,
+        /// so a run with the same arrays makes no managed allocations.
+        /// </summary>
+        /// <param name="inputNames"></param>
+        /// <param name="inputValues"></param>
+        /// <param name="outputNames"></param>
+        /// <param name="outputValues">One preallocated value per output name, with the shape of the output</param>
+        public void Run(string[] inputNames, OrtValue[] inputValues, string[] outputNames, OrtValue[] outputValues)
+        {
+            Run(_builtInRunOptions, inputNames, inputValues, outputNames, outputValues);
+        }
+
+        /// <summary>
+        /// Runs the loaded model for the given <paramref name="inputValues"/>, writing the caller-owned <paramref name="outputValues"/>.
+        /// Uses the given RunOptions for this run.
+        /// </summary>
+        /// <param name="options"></param>
+        /// <param name="inputNames"></param>
+        /// <param name="inputValues"></param>
+        /// <param name="outputNames"></param>
+        /// <param name="outputValues">One preallocated value per output name, with the shape of the output</param>
+        public void Run(RunOptions options, string[] inputNames, OrtValue[] inputValues, string[] outputNames, OrtValue[] outputValues)
+        {
+            if (inputNames.Length != inputValues.Length)
+            {
+                throw new ArgumentException("There must be one input value per input name", nameof(inputValues));
+            }
+            if (outputNames.Length != outputValues.Length)
+            {
+                throw new ArgumentException("There must be one output value per output name", nameof(outputValues));
+            }
+
+            unsafe
+            {
+                IntPtr* inputHandles = stackalloc IntPtr[Math.Max(inputValues.Length, 1)];
+                IntPtr* outputHandles = stackalloc IntPtr[Math.Max(outputValues.Length, 1)];
+                for (int i = 0; i < inputValues.Length; i++)
+                {
+                    inputHandles[i] = inputValues[i].Handle;
+                }
+                for (int i = 0; i < outputValues.Length; i++)
+                {
+                    outputHandles[i] = outputValues[i].Handle;
+                }
+
+                NativeApiStatus.VerifySuccess(NativeMethods.OrtRunWithValues(
+                                                this._nativeHandle,
+                                                options.Handle,
+                                                inputNames,
+                                                (IntPtr)inputHandles,
+                                                (UIntPtr)inputValues.Length,
+                                                outputNames,
+                                                (UIntPtr)outputValues.Length,
+                                                (IntPtr)outputHandles
+                                                ));
+            }
+        }
+
+        /// <summary>
+        /// Runs the loaded model for the given inputs on a thread of the session's intra-op thread pool, without blocking
+        /// the calling thread, and fetches the outputs specified in <paramref name="outputNames"/>.
+        /// The session must have more than one intra-op thread, and must not be disposed until the task completes.
+        /// </summary>
+        /// <param name="inputs"></param>
+        /// <param name="outputNames"></param>
+        /// <returns>A task of the output tensors in a Collection of NamedOnnxValue. User must dispose the output.</returns>
+        public Task<IDisposableReadOnlyCollection<DisposableNamedOnnxValue>> RunAsync(IReadOnlyCollection<NamedOnnxValue> inputs, IReadOnlyCollection<string> outputNames)
+        {
+            return RunAsync(inputs, outputNames, _builtInRunOptions);
+        }
+
+        /// <summary>
+        /// Runs the loaded model for the given inputs on a thread of the session's intra-op thread pool, without blocking
+        /// the calling thread, and fetches the outputs specified in <paramref name="outputNames"/>. Uses the given
+        /// RunOptions, which must not be disposed until the task completes.
+        /// </summary>
+        /// <param name="inputs"></param>
+        /// <param name="outputNames"></param>
+        /// <param name="options"></param>
+        /// <returns>A task of the output tensors in a Collection of NamedOnnxValue. User must dispose the output.</returns>
+        public Task<IDisposableReadOnlyCollection<DisposableNamedOnnxValue>> RunAsync(IReadOnlyCollection<NamedOnnxValue> inputs, IReadOnlyCollection<string> outputNames, RunOptions options)
+        {
+            var run = new AsyncRun(inputs, outputNames);
+            var inputNames = inputs.Select(input => input.Name).ToArray();
+
+            // the run keeps itself alive until its callback is called
+            var handle = GCHandle.Alloc(run);
+            IntPtr status = NativeMethods.OrtRunAsync(
+                                                this._nativeHandle,
+                                                options.Handle,
+                                                inputNames,
+                                                run.InputValues,
+                                                (UIntPtr)(run.InputValues.Length),
+                                                run.OutputNames,
+                                                (UIntPtr)(run.OutputNames.Length),
+                                                run.OutputValues,
+                                                _runAsyncCallback,
+                                                GCHandle.ToIntPtr(handle)
+                                                );
+            if (status != IntPtr.Zero)
+            {
+                handle.Free();
+                run.Release();
+                NativeApiStatus.VerifySuccess(status);
+            }
+
+            return run.Completion.Task;
+        }
+
+        /// <summary>
+        /// Creates a binding of the inputs and outputs of this session for <see cref="Run(OrtIoBinding)"/>.
+        /// </summary>
+        /// <returns>The binding. User must dispose it.</returns>
+        public OrtIoBinding CreateIoBinding()
+        {
+            return new OrtIoBinding(this);
+        }
+
+        /// <summary>
+        /// Runs the loaded model with the inputs bound to <paramref name="ioBinding"/>, writing its bound outputs.
+        /// </summary>
+        /// <param name="ioBinding"></param>
+        public void Run(OrtIoBinding ioBinding)
+        {
+            Run(ioBinding, _builtInRunOptions);
+        }
+
+        /// <summary>
+        /// Runs the loaded model with the inputs bound to <paramref name="ioBinding"/>, writing its bound outputs.
+        /// Uses the given RunOptions for this run.
+        /// </summary>
+        /// <param name="ioBinding"></param>
+        /// <param name="options"></param>
+        public void Run(OrtIoBinding ioBinding, RunOptions options)
+        {
+            NativeApiStatus.VerifySuccess(NativeMethods.OrtRunWithBinding(_nativeHandle, options.Handle, ioBinding.Handle));
+        }
+
         //TODO: kept internal until implemented
         internal ModelMetadata ModelMetadata
         {
@@ -219,6 +368,97 @@ namespace Microsoft.ML.OnnxRuntime
 
         #region private methods
 
+        // The native values and buffers of a RunAsync, released when it's done
+        private class AsyncRun
+        {
+            public readonly TaskCompletionSource<IDisposableReadOnlyCollection<DisposableNamedOnnxValue>> Completion =
+                new TaskCompletionSource<IDisposableReadOnlyCollection<DisposableNamedOnnxValue>>();
+            public readonly IReadOnlyCollection<NamedOnnxValue> Inputs;
+            public readonly IntPtr[] InputValues;
+            public readonly System.Buffers.MemoryHandle[] PinnedBufferHandles;
+            public readonly string[] OutputNames;
+            public readonly IntPtr OutputValues;  // native array written by the run
+
+            public AsyncRun(IReadOnlyCollection<NamedOnnxValue> inputs, IReadOnlyCollection<string> outputNames)
+            {
+                Inputs = inputs;
+                InputValues = new IntPtr[inputs.Count];
+                PinnedBufferHandles = new System.Buffers.MemoryHandle[inputs.Count];
+                int inputIndex = 0;
+                foreach (var input in inputs)
+                {
+                    input.ToNativeOnnxValue(out InputValues[inputIndex], out PinnedBufferHandles[inputIndex]);
+                    inputIndex++;
+                }
+
+                OutputNames = outputNames.ToArray();
+                OutputValues = Marshal.AllocHGlobal(Math.Max(OutputNames.Length, 1) * IntPtr.Size);
+                for (int i = 0; i < OutputNames.Length; i++)
+                {
+                    Marshal.WriteIntPtr(OutputValues, i * IntPtr.Size, IntPtr.Zero);
+                }
+            }
+
+            public void Release()
+            {
+                int inputIndex = 0;
+                foreach (var input in Inputs)
+                {
+                    // same as Run: the user disposes the values of a DisposableNamedOnnxValue
+                    if (input.GetType() == typeof(NamedOnnxValue))
+                    {
+                        NativeMethods.OrtReleaseValue(InputValues[inputIndex]);
+                        PinnedBufferHandles[inputIndex].Dispose();
+                    }
+                    inputIndex++;
+                }
+                Marshal.FreeHGlobal(OutputValues);
+            }
+        }
+
+        // kept by the class so the native code can call it back at any time
+        private static readonly NativeMethods.DOrtRunAsyncCallback _runAsyncCallback = OnRunAsyncDone;
+
+        private static void OnRunAsyncDone(IntPtr userData, IntPtr outputValues, UIntPtr outputCount, IntPtr status)
+        {
+            var handle = GCHandle.FromIntPtr(userData);
+            var run = (AsyncRun)handle.Target;
+            handle.Free();
+
+            var outputValueArray = new IntPtr[run.OutputNames.Length];
+            for (int i = 0; i < outputValueArray.Length; i++)
+            {
+                outputValueArray[i] = Marshal.ReadIntPtr(run.OutputValues, i * IntPtr.Size);
+            }
+            run.Release();
+
+            // the task is completed on another thread, so its continuations don't run on the thread of the session
+            Task.Run(() =>
+            {
+                try
+                {
+                    NativeApiStatus.VerifySuccess(status);
+                    var result = new DisposableList<DisposableNamedOnnxValue>();
+                    for (int i = 0; i < outputValueArray.Length; i++)
+                    {
+                        result.Add(DisposableNamedOnnxValue.CreateFromOnnxValue(run.OutputNames[i], outputValueArray[i]));
+                    }
+                    run.Completion.SetResult(result);
+                }
+                catch (Exception e)
+                {
+                    foreach (var value in outputValueArray)
+                    {
+                        if (value != IntPtr.Zero)
+                        {
+                            NativeMethods.OrtReleaseValue(value);
+                        }
+                    }
+                    run.Completion.SetException(e);
+                }
+            });
+        }
+
         private void Init(string modelPath, SessionOptions options)
         {
             var envHandle = OnnxRuntime.Handle;
@@ -127,6 +127,67 @@ namespace Microsoft.ML.OnnxRuntime
         public IntPtr ReleaseTensorTypeAndShapeInfo;
         public IntPtr ReleaseSessionOptions;
         public IntPtr ReleaseCustomOpDomain;
+
+        public IntPtr GetDenotationFromTypeInfo;
+        public IntPtr CastTypeInfoToMapTypeInfo;
+        public IntPtr CastTypeInfoToSequenceTypeInfo;
+        public IntPtr GetMapKeyType;
+        public IntPtr GetMapValueType;
+        public IntPtr GetSequenceElementType;
+        public IntPtr ReleaseMapTypeInfo;
+        public IntPtr ReleaseSequenceTypeInfo;
+        public IntPtr SessionEndProfiling;
+        public IntPtr SessionGetModelMetadata;
+        public IntPtr ModelMetadataGetProducerName;
+        public IntPtr ModelMetadataGetGraphName;
+        public IntPtr ModelMetadataGetDomain;
+        public IntPtr ModelMetadataGetDescription;
+        public IntPtr ModelMetadataLookupCustomMetadataMap;
+        public IntPtr ModelMetadataGetVersion;
+        public IntPtr ReleaseModelMetadata;
+        public IntPtr CreateEnvWithGlobalThreadPools;
+        public IntPtr DisablePerSessionThreads;
+        public IntPtr RunOptionsSetShrinkMemoryArenas;
+        public IntPtr CreateAndRegisterAllocator;
+        public IntPtr EnableEnvAllocators;
+        public IntPtr EnableMemPatternBucketing;
+        public IntPtr SetThreadPoolSpinning;
+        public IntPtr SetIntraOpThreadAffinity;
+        public IntPtr SetInterOpThreadAffinity;
+        public IntPtr SetThreadPoolNumaNode;
+        public IntPtr SetSessionStateCacheFilePath;
+        public IntPtr DisablePrePacking;
+        public IntPtr EnableEnvPrePackedWeights;
+        public IntPtr EnableCpuTuning;
+        public IntPtr RunOptionsSetComputeStream;
+        public IntPtr EnableMemoryEfficientExecutionOrder;
+        public IntPtr AddFreeDimensionOverrideByName;
+        public IntPtr EnableShapeSpecialization;
+        public IntPtr AddStateBinding;
+        public IntPtr RunOptionsSetStateStreamId;
+        public IntPtr ReleaseStateStream;
+        public IntPtr CreateIoBinding;
+        public IntPtr ReleaseIoBinding;
+        public IntPtr BindInput;
+        public IntPtr BindOutput;
+        public IntPtr BindOutputToDevice;
+        public IntPtr RunWithBinding;
+        public IntPtr GetBoundOutputNames;
+        public IntPtr GetBoundOutputValues;
+        public IntPtr ClearBoundInputs;
+        public IntPtr ClearBoundOutputs;
+        public IntPtr CreatePreparedRun;
+        public IntPtr ReleasePreparedRun;
+        public IntPtr RunPrepared;
+        public IntPtr RunAsync;
+        public IntPtr SessionGetMemoryArenaStats;
+        public IntPtr EnableRunResultCache;
+        public IntPtr SessionGetRunResultCacheStats;
+        public IntPtr SessionWarmUp;
+        public IntPtr EnableEnvSharedInitializers;
+        public IntPtr RunOptionsSetCollectRunStats;
+        public IntPtr RunOptionsGetRunStats;
+        public IntPtr SessionGetCumulativeRunStats;
     }
 
     internal static class NativeMethods
@@ -154,6 +215,8 @@ namespace Microsoft.ML.OnnxRuntime
             OrtCreateSession = (DOrtCreateSession)Marshal.GetDelegateForFunctionPointer(api_.CreateSession, typeof(DOrtCreateSession));
             OrtCreateSessionFromArray = (DOrtCreateSessionFromArray)Marshal.GetDelegateForFunctionPointer(api_.CreateSessionFromArray, typeof(DOrtCreateSessionFromArray));
             OrtRun = (DOrtRun)Marshal.GetDelegateForFunctionPointer(api_.Run, typeof(DOrtRun));
+            OrtRunWithValues = (DOrtRunWithValues)Marshal.GetDelegateForFunctionPointer(api_.Run, typeof(DOrtRunWithValues));
+            OrtRunAsync = (DOrtRunAsync)Marshal.GetDelegateForFunctionPointer(api_.RunAsync, typeof(DOrtRunAsync));
             OrtSessionGetInputCount = (DOrtSessionGetInputCount)Marshal.GetDelegateForFunctionPointer(api_.SessionGetInputCount, typeof(DOrtSessionGetInputCount));
             OrtSessionGetOutputCount = (DOrtSessionGetOutputCount)Marshal.GetDelegateForFunctionPointer(api_.SessionGetOutputCount, typeof(DOrtSessionGetOutputCount));
             OrtSessionGetOverridableInitializerCount = (DOrtSessionGetOverridableInitializerCount)Marshal.GetDelegateForFunctionPointer(api_.SessionGetOverridableInitializerCount, typeof(DOrtSessionGetOverridableInitializerCount));
@@ -224,6 +287,17 @@ namespace Microsoft.ML.OnnxRuntime
             OrtGetSymbolicDimensions = (DOrtGetSymbolicDimensions)Marshal.GetDelegateForFunctionPointer(api_.GetSymbolicDimensions, typeof(DOrtGetSymbolicDimensions));
             OrtGetTensorShapeElementCount = (DOrtGetTensorShapeElementCount)Marshal.GetDelegateForFunctionPointer(api_.GetTensorShapeElementCount, typeof(DOrtGetTensorShapeElementCount));
             OrtReleaseValue = (DOrtReleaseValue)Marshal.GetDelegateForFunctionPointer(api_.ReleaseValue, typeof(DOrtReleaseValue));
+
+            OrtCreateIoBinding = (DOrtCreateIoBinding)Marshal.GetDelegateForFunctionPointer(api_.CreateIoBinding, typeof(DOrtCreateIoBinding));
+            OrtReleaseIoBinding = (DOrtReleaseIoBinding)Marshal.GetDelegateForFunctionPointer(api_.ReleaseIoBinding, typeof(DOrtReleaseIoBinding));
+            OrtBindInput = (DOrtBindInput)Marshal.GetDelegateForFunctionPointer(api_.BindInput, typeof(DOrtBindInput));
+            OrtBindOutput = (DOrtBindOutput)Marshal.GetDelegateForFunctionPointer(api_.BindOutput, typeof(DOrtBindOutput));
+            OrtBindOutputToDevice = (DOrtBindOutputToDevice)Marshal.GetDelegateForFunctionPointer(api_.BindOutputToDevice, typeof(DOrtBindOutputToDevice));
+            OrtRunWithBinding = (DOrtRunWithBinding)Marshal.GetDelegateForFunctionPointer(api_.RunWithBinding, typeof(DOrtRunWithBinding));
+            OrtGetBoundOutputNames = (DOrtGetBoundOutputNames)Marshal.GetDelegateForFunctionPointer(api_.GetBoundOutputNames, typeof(DOrtGetBoundOutputNames));
+            OrtGetBoundOutputValues = (DOrtGetBoundOutputValues)Marshal.GetDelegateForFunctionPointer(api_.GetBoundOutputValues, typeof(DOrtGetBoundOutputValues));
+            OrtClearBoundInputs = (DOrtClearBoundInputs)Marshal.GetDelegateForFunctionPointer(api_.ClearBoundInputs, typeof(DOrtClearBoundInputs));
+            OrtClearBoundOutputs = (DOrtClearBoundOutputs)Marshal.GetDelegateForFunctionPointer(api_.ClearBoundOutputs, typeof(DOrtClearBoundOutputs));
         }
 
         [DllImport(nativeLib, CharSet = charSet)]
@@ -284,6 +358,40 @@ namespace Microsoft.ML.OnnxRuntime
                                                 );
         public static DOrtRun OrtRun;
 
+        // Run with the input and output value arrays passed as pointers, so the caller can keep them on its stack
+        public delegate IntPtr /*(ONNStatus*)*/ DOrtRunWithValues(
+                                                IntPtr /*(OrtSession*)*/ session,
+                                                IntPtr /*(OrtSessionRunOptions*)*/ runOptions,  // can be null to use the default options
+                                                string[] inputNames,
+                                                IntPtr /* (OrtValue*[])*/ inputValues,
+                                                UIntPtr inputCount,
+                                                string[] outputNames,
+                                                UIntPtr outputCount,
+                                                IntPtr /* (OrtValue*[])*/ outputValues /* The preallocated output values, which the run writes to */
+                                                );
+        public static DOrtRunWithValues OrtRunWithValues;
+
+        public delegate void DOrtRunAsyncCallback(
+                                                IntPtr /*(void*)*/ userData,
+                                                IntPtr /*(OrtValue**)*/ outputValues,
+                                                UIntPtr outputCount,
+                                                IntPtr /*(OrtStatus*)*/ status  // null if the run succeeded, released by the callback otherwise
+                                                );
+
+        public delegate IntPtr /*(ONNStatus*)*/ DOrtRunAsync(
+                                                IntPtr /*(OrtSession*)*/ session,
+                                                IntPtr /*(OrtSessionRunOptions*)*/ runOptions,  // can be null to use the default options
+                                                string[] inputNames,
+                                                IntPtr[] /* (OrtValue*[])*/ inputValues,
+                                                UIntPtr inputCount,
+                                                string[] outputNames,
+                                                UIntPtr outputCount,
+                                                IntPtr /* (OrtValue*[])*/ outputValues, /* Native array of output value pointers, valid until the callback is called */
+                                                DOrtRunAsyncCallback callback,
+                                                IntPtr userData
+                                                );
+        public static DOrtRunAsync OrtRunAsync;
+
         public delegate IntPtr /*(OrtStatus*)*/ DOrtSessionGetInputCount(
                                                 IntPtr /*(OrtSession*)*/ session,
                                                 out UIntPtr count);
@@ -651,6 +759,42 @@ namespace Microsoft.ML.OnnxRuntime
 
         #endregion
 
+        #region IoBinding API
+
+        public delegate IntPtr /*(OrtStatus*)*/ DOrtCreateIoBinding(IntPtr /*(OrtSession*)*/ session, out IntPtr /*(OrtIoBinding**)*/ binding);
+        public static DOrtCreateIoBinding OrtCreateIoBinding;
+
+        public delegate void DOrtReleaseIoBinding(IntPtr /*(OrtIoBinding*)*/ binding);
+        public static DOrtReleaseIoBinding OrtReleaseIoBinding;
+
+        public delegate IntPtr /*(OrtStatus*)*/ DOrtBindInput(IntPtr /*(OrtIoBinding*)*/ binding, string name, IntPtr /*(const OrtValue*)*/ value);
+        public static DOrtBindInput OrtBindInput;
+
+        public delegate IntPtr /*(OrtStatus*)*/ DOrtBindOutput(IntPtr /*(OrtIoBinding*)*/ binding, string name, IntPtr /*(const OrtValue*)*/ value);
+        public static DOrtBindOutput OrtBindOutput;
+
+        public delegate IntPtr /*(OrtStatus*)*/ DOrtBindOutputToDevice(IntPtr /*(OrtIoBinding*)*/ binding, string name, IntPtr /*(const OrtMemoryInfo*)*/ memInfo);
+        public static DOrtBindOutputToDevice OrtBindOutputToDevice;
+
+        public delegate IntPtr /*(OrtStatus*)*/ DOrtRunWithBinding(IntPtr /*(OrtSession*)*/ session, IntPtr /*(const OrtRunOptions*)*/ runOptions, IntPtr /*(OrtIoBinding*)*/ binding);
+        public static DOrtRunWithBinding OrtRunWithBinding;
+
+        public delegate IntPtr /*(OrtStatus*)*/ DOrtGetBoundOutputNames(IntPtr /*(const OrtIoBinding*)*/ binding, IntPtr /*(OrtAllocator*)*/ allocator,
+                                                                        out IntPtr /*(char***)*/ names, out UIntPtr count);
+        public static DOrtGetBoundOutputNames OrtGetBoundOutputNames;
+
+        public delegate IntPtr /*(OrtStatus*)*/ DOrtGetBoundOutputValues(IntPtr /*(const OrtIoBinding*)*/ binding, IntPtr /*(OrtAllocator*)*/ allocator,
+                                                                         out IntPtr /*(OrtValue***)*/ values, out UIntPtr count);
+        public static DOrtGetBoundOutputValues OrtGetBoundOutputValues;
+
+        public delegate void DOrtClearBoundInputs(IntPtr /*(OrtIoBinding*)*/ binding);
+        public static DOrtClearBoundInputs OrtClearBoundInputs;
+
+        public delegate void DOrtClearBoundOutputs(IntPtr /*(OrtIoBinding*)*/ binding);
+        public static DOrtClearBoundOutputs OrtClearBoundOutputs;
+
+        #endregion
+
         public static byte[] GetPlatformSerializedString(string str)
         {
             if (RuntimeInformation.IsOSPlatform(OSPlatform.Windows))
@@ -0,0 +1,167 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+using System;
+using System.Buffers;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace Microsoft.ML.OnnxRuntime
+{
+    /// <summary>
+    /// The inputs and outputs bound to an InferenceSession for InferenceSession.Run(OrtIoBinding).
+    /// The bound inputs are copied once to the device that consumes them, and the bound outputs are
+    /// reused by the next run instead of being allocated again.
+    /// </summary>
+    public class OrtIoBinding : IDisposable
+    {
+        private IntPtr _nativeHandle;
+        // the native values and pinned buffers of the bound values, released when they're unbound
+        private readonly List<Tuple<IntPtr, MemoryHandle>> _boundInputs = new List<Tuple<IntPtr, MemoryHandle>>();
+        private readonly List<Tuple<IntPtr, MemoryHandle>> _boundOutputs = new List<Tuple<IntPtr, MemoryHandle>>();
+
+        internal OrtIoBinding(InferenceSession session)
+        {
+            NativeApiStatus.VerifySuccess(NativeMethods.OrtCreateIoBinding(session.Handle, out _nativeHandle));
+        }
+
+        internal IntPtr Handle
+        {
+            get
+            {
+                return _nativeHandle;
+            }
+        }
+
+        /// <summary>
+        /// Binds the input to the value. The buffer of the value is pinned until the input is unbound.
+        /// </summary>
+        public void BindInput(NamedOnnxValue input)
+        {
+            _boundInputs.Add(BindValue(input, NativeMethods.OrtBindInput));
+        }
+
+        /// <summary>
+        /// Binds the output to a preallocated value, which the runs write to.
+        /// </summary>
+        public void BindOutput(NamedOnnxValue output)
+        {
+            _boundOutputs.Add(BindValue(output, NativeMethods.OrtBindOutput));
+        }
+
+        /// <summary>
+        /// Binds the output to CPU memory. The first run allocates it, and the next runs reuse it.
+        /// </summary>
+        public void BindOutputToCpu(string name)
+        {
+            NativeApiStatus.VerifySuccess(NativeMethods.OrtBindOutputToDevice(_nativeHandle, name, NativeMemoryInfo.DefaultInstance.Handle));
+        }
+
+        /// <summary>
+        /// Returns the bound outputs, in the order they were bound. User must dispose the outputs.
+        /// </summary>
+        public IDisposableReadOnlyCollection<DisposableNamedOnnxValue> GetOutputValues()
+        {
+            var allocator = NativeMemoryAllocator.DefaultInstance;
+            IntPtr names = IntPtr.Zero;
+            IntPtr values = IntPtr.Zero;
+            UIntPtr count;
+            NativeApiStatus.VerifySuccess(NativeMethods.OrtGetBoundOutputNames(_nativeHandle, allocator.Handle, out names, out count));
+            try
+            {
+                UIntPtr valueCount;
+                NativeApiStatus.VerifySuccess(NativeMethods.OrtGetBoundOutputValues(_nativeHandle, allocator.Handle, out values, out valueCount));
+
+                var result = new DisposableList<DisposableNamedOnnxValue>();
+                for (int i = 0; i < (int)count; i++)
+                {
+                    IntPtr namePtr = Marshal.ReadIntPtr(names, i * IntPtr.Size);
+                    string name = Marshal.PtrToStringAnsi(namePtr);
+                    allocator.FreeMemory(namePtr);
+                    result.Add(DisposableNamedOnnxValue.CreateFromOnnxValue(name, Marshal.ReadIntPtr(values, i * IntPtr.Size)));
+                }
+                return result;
+            }
+            finally
+            {
+                if (names != IntPtr.Zero)
+                {
+                    allocator.FreeMemory(names);
+                }
+                if (values != IntPtr.Zero)
+                {
+                    allocator.FreeMemory(values);
+                }
+            }
+        }
+
+        public void ClearBoundInputs()
+        {
+            NativeMethods.OrtClearBoundInputs(_nativeHandle);
+            ReleaseValues(_boundInputs);
+        }
+
+        public void ClearBoundOutputs()
+        {
+            NativeMethods.OrtClearBoundOutputs(_nativeHandle);
+            ReleaseValues(_boundOutputs);
+        }
+
+        private delegate IntPtr DBindValue(IntPtr binding, string name, IntPtr value);
+
+        private Tuple<IntPtr, MemoryHandle> BindValue(NamedOnnxValue namedValue, DBindValue bind)
+        {
+            IntPtr value;
+            MemoryHandle pinnedBufferHandle;
+            namedValue.ToNativeOnnxValue(out value, out pinnedBufferHandle);
+            try
+            {
+                NativeApiStatus.VerifySuccess(bind(_nativeHandle, namedValue.Name, value));
+            }
+            catch (OnnxRuntimeException)
+            {
+                NativeMethods.OrtReleaseValue(value);
+                pinnedBufferHandle.Dispose();
+                throw;
+            }
+            return Tuple.Create(value, pinnedBufferHandle);
+        }
+
+        private static void ReleaseValues(List<Tuple<IntPtr, MemoryHandle>> values)
+        {
+            foreach (var value in values)
+            {
+                NativeMethods.OrtReleaseValue(value.Item1);
+                value.Item2.Dispose();
+            }
+            values.Clear();
+        }
+
+        #region IDisposable
+
+        ~OrtIoBinding()
+        {
+            Dispose(false);
+        }
+
+        public void Dispose()
+        {
+            GC.SuppressFinalize(this);
+            Dispose(true);
+        }
+
+        protected virtual void Dispose(bool disposing)
+        {
+            // the native binding shares the buffers of the bound values, release it first
+            if (_nativeHandle != IntPtr.Zero)
+            {
+                NativeMethods.OrtReleaseIoBinding(_nativeHandle);
+                _nativeHandle = IntPtr.Zero;
+            }
+            ReleaseValues(_boundInputs);
+            ReleaseValues(_boundOutputs);
+        }
+
+        #endregion
+    }
+}
@@ -0,0 +1,140 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+using System;
+using System.Buffers;
+
+namespace Microsoft.ML.OnnxRuntime
+{
+    /// <summary>
+    /// A native tensor using the memory of a pinned Memory&lt;T&gt;, for InferenceSession.Run(RunOptions, string[], OrtValue[], string[], OrtValue[]).
+    /// It can be passed to any number of runs, as an input or as a caller-owned output, without being converted again:
+    /// the runs read and write the memory in place, so its content can change between them.
+    /// </summary>
+    public class OrtValue : IDisposable
+    {
+        private IntPtr _nativeHandle;
+        private MemoryHandle _pinnedMemory;  // released with the native value
+
+        private OrtValue(IntPtr nativeHandle, MemoryHandle pinnedMemory)
+        {
+            _nativeHandle = nativeHandle;
+            _pinnedMemory = pinnedMemory;
+        }
+
+        internal IntPtr Handle
+        {
+            get
+            {
+                return _nativeHandle;
+            }
+        }
+
+        /// <summary>
+        /// Creates a tensor of the <paramref name="shape"/> using <paramref name="memory"/>, which stays pinned until the value is disposed.
+        /// The memory must hold exactly the elements of the shape. Strings aren't supported.
+        /// </summary>
+        /// <param name="memory"></param>
+        /// <param name="shape"></param>
+        /// <returns>The tensor value. User must dispose it.</returns>
+        public static OrtValue CreateTensorValueFromMemory<T>(Memory<T> memory, long[] shape)
+        {
+            TensorElementType elementType = GetElementType(typeof(T));
+            Type type;
+            int width;
+            TensorElementTypeConverter.GetTypeAndWidth(elementType, out type, out width);
+
+            long elementCount = 1;
+            foreach (var dim in shape)
+            {
+                if (dim < 0)
+                {
+                    throw new ArgumentException("The dimensions of the shape can't be negative", nameof(shape));
+                }
+                elementCount *= dim;
+            }
+            if (elementCount != memory.Length)
+            {
+                throw new ArgumentException("The shape has " + elementCount + " elements but the memory has " + memory.Length, nameof(shape));
+            }
+
+            var pinnedMemory = memory.Pin();
+            IntPtr value = IntPtr.Zero;
+            try
+            {
+                IntPtr dataBufferPointer;
+                unsafe
+                {
+                    dataBufferPointer = (IntPtr)pinnedMemory.Pointer;
+                }
+                NativeApiStatus.VerifySuccess(NativeMethods.OrtCreateTensorWithDataAsOrtValue(
+                                                NativeMemoryInfo.DefaultInstance.Handle,
+                                                dataBufferPointer,
+                                                (UIntPtr)(memory.Length * width),
+                                                shape,
+                                                (UIntPtr)shape.Length,
+                                                elementType,
+                                                out value));
+            }
+            catch (OnnxRuntimeException)
+            {
+                pinnedMemory.Dispose();
+                throw;
+            }
+            return new OrtValue(value, pinnedMemory);
+        }
+
+        private static TensorElementType GetElementType(Type type)
+        {
+            if (type == typeof(float))
+                return TensorElementType.Float;
+            if (type == typeof(double))
+                return TensorElementType.Double;
+            if (type == typeof(int))
+                return TensorElementType.Int32;
+            if (type == typeof(uint))
+                return TensorElementType.UInt32;
+            if (type == typeof(long))
+                return TensorElementType.Int64;
+            if (type == typeof(ulong))
+                return TensorElementType.UInt64;
+            if (type == typeof(short))
+                return TensorElementType.Int16;
+            if (type == typeof(ushort))
+                return TensorElementType.UInt16;
+            if (type == typeof(byte))
+                return TensorElementType.UInt8;
+            if (type == typeof(sbyte))
+                return TensorElementType.Int8;
+            if (type == typeof(bool))
+                return TensorElementType.Bool;
+            throw new NotSupportedException("The element type " + type + " isn't supported by OrtValue");
+        }
+
+        #region IDisposable
+
+        ~OrtValue()
+        {
+            Dispose(false);
+        }
+
+        public void Dispose()
+        {
+            GC.SuppressFinalize(this);
+            Dispose(true);
+        }
+
+        protected virtual void Dispose(bool disposing)
+        {
+            // the native value uses the pinned memory, release it first
+            if (_nativeHandle != IntPtr.Zero)
+            {
+                NativeMethods.OrtReleaseValue(_nativeHandle);
+                _nativeHandle = IntPtr.Zero;
+                _pinnedMemory.Dispose();
+            }
+        }
+
+        #endregion
+    }
+}
@@ -209,6 +209,108 @@ namespace Microsoft.ML.OnnxRuntime.Tests
             }
         }
 
+        [Fact]
+        private void CanRunInferenceWithIoBinding()
+        {
+            string modelPath = Path.Combine(Directory.GetCurrentDirectory(), "squeezenet.onnx");
+
+            using (var session = new InferenceSession(modelPath))
+            using (var ioBinding = session.CreateIoBinding())
+            {
+                var inputMeta = session.InputMetadata;
+                float[] inputData = LoadTensorFromFile(@"bench.in"); // this is the data for only one input tensor for this model
+                foreach (var name in inputMeta.Keys)
+                {
+                    var tensor = new DenseTensor<float>(inputData, inputMeta[name].Dimensions);
+                    ioBinding.BindInput(NamedOnnxValue.CreateFromTensor<float>(name, tensor));
+                }
+                ioBinding.BindOutputToCpu("softmaxout_1");
+
+                // the output allocated by the first run is reused by the second one
+                for (int i = 0; i < 2; i++)
+                {
+                    session.Run(ioBinding);
+                    using (var results = ioBinding.GetOutputValues())
+                    {
+                        validateRunResults(results);
+                    }
+                }
+            }
+        }
+
+        [Fact]
+        private void CanRunInferenceWithOrtValues()
+        {
+            string modelPath = Path.Combine(Directory.GetCurrentDirectory(), "squeezenet.onnx");
+
+            using (var session = new InferenceSession(modelPath))
+            {
+                var inputMeta = session.InputMetadata;
+                float[] inputData = LoadTensorFromFile(@"bench.in"); // this is the data for only one input tensor for this model
+                float[] expectedOutput = LoadTensorFromFile(@"bench.expected_out");
+                var inputNames = inputMeta.Keys.ToArray();
+                var outputNames = new string[] { "softmaxout_1" };
+                var outputData = new float[expectedOutput.Length];
+                var inputValues = inputNames.Select(name => OrtValue.CreateTensorValueFromMemory(new Memory<float>(inputData),
+                    inputMeta[name].Dimensions.Select(dim => (long)dim).ToArray())).ToArray();
+                var outputValues = new OrtValue[] { OrtValue.CreateTensorValueFromMemory(new Memory<float>(outputData), new long[] { 1, 1000, 1, 1 }) };
+                try
+                {
+                    // the same values are reused by every run, which writes the output array in place
+                    for (int i = 0; i < 2; i++)
+                    {
+                        Array.Clear(outputData, 0, outputData.Length);
+                        session.Run(inputNames, inputValues, outputNames, outputValues);
+                        Assert.Equal(expectedOutput, outputData, new floatComparer());
+                    }
+
+                    Assert.Throws<ArgumentException>(() => session.Run(inputNames, inputValues, outputNames, new OrtValue[0]));
+                }
+                finally
+                {
+                    foreach (var value in inputValues.Concat(outputValues))
+                    {
+                        value.Dispose();
+                    }
+                }
+
+                Assert.Throws<ArgumentException>(() => OrtValue.CreateTensorValueFromMemory(new Memory<float>(outputData), new long[] { 1, 999 }));
+            }
+        }
+
+        [Fact]
+        private async Task CanRunInferenceAsync()
+        {
+            string modelPath = Path.Combine(Directory.GetCurrentDirectory(), "squeezenet.onnx");
+
+            using (var options = new SessionOptions())
+            {
+                options.IntraOpNumThreads = 2;
+                using (var session = new InferenceSession(modelPath, options))
+                {
+                    var inputMeta = session.InputMetadata;
+                    var container = new List<NamedOnnxValue>();
+                    float[] inputData = LoadTensorFromFile(@"bench.in"); // this is the data for only one input tensor for this model
+                    foreach (var name in inputMeta.Keys)
+                    {
+                        var tensor = new DenseTensor<float>(inputData, inputMeta[name].Dimensions);
+                        container.Add(NamedOnnxValue.CreateFromTensor<float>(name, tensor));
+                    }
+                    IReadOnlyCollection<string> outputNames = session.OutputMetadata.Keys.ToList();
+
+                    // several runs are in flight at the same time
+                    var tasks = Enumerable.Range(0, 4).Select(i => session.RunAsync(container, outputNames)).ToList();
+                    foreach (var task in tasks)
+                    {
+                        using (var results = await task)
+                        {
+                            validateRunResults(results);
+                        }
+                    }
+                }
+            }
+        }
+
         private void validateRunResults(IDisposableReadOnlyCollection<DisposableNamedOnnxValue> results)
         {
             float[] expectedOutput = LoadTensorFromFile(@"bench.expected_out");
@@ -16,10 +16,12 @@ namespace onnxruntime {
 //   - tensor values: The lifetimes of these tensor-values are statically
 //     determined, which is used for memory reuse/sharing optimizations. The
 //     runtime allocates/frees these values at the right time (as determined
-//     by the static allocation plan). Note that this is simplified since we
-//     do not try to optimize for "slice" like ops, where we may be able to
-//     conditionally reuse memory/data in some cases but not others.
-//     Generalizing this is future work.
+//     by the static allocation plan).
+//   - views: the outputs of "slice" like ops that are statically known to be
+//     a contiguous block of their input are placed within the buffer of the
+//     input instead of being copied. The kernel sets the offset of the view.
+//     Other cases, where the data is only contiguous for some input shapes,
+//     are still copied.
 
 enum class AllocKind {
   kAllocate = 0,
@@ -27,7 +29,8 @@ enum class AllocKind {
   kPreExisting = 2,
   kAllocateStatically = 3,
   kAllocateOutput = 4,
-  kShare = 5
+  kShare = 5,
+  kView = 6
 };
 
 std::ostream& operator<<(std::ostream& out, AllocKind alloc_kind);
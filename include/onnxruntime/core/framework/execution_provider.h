@@ -11,10 +11,14 @@
 #include "core/framework/tensor.h"
 #include "core/framework/func_api.h"
 #include "core/framework/data_transfer.h"
+#include "core/framework/run_options.h"
 
 namespace onnxruntime {
 class GraphViewer;
 class Node;
+namespace profiling {
+class DeviceProfiler;
+}  // namespace profiling
 }  // namespace onnxruntime
 namespace onnxruntime {
 
@@ -125,8 +129,10 @@ class IExecutionProvider {
      NOTE that due to async execution in provider, the actual work of previous
      Run may not be finished on device This function should be regarded as the
      point after which a new Run would start to submit commands from CPU
+     @param run_options The options of the Run that is starting, e.g. a
+     caller supplied compute stream the provider should order its work with.
   */
-  virtual common::Status OnRunStart();
+  virtual common::Status OnRunStart(const RunOptions& run_options);
 
   /**
      Called when InferenceSession::Run ended
@@ -136,8 +142,50 @@ class IExecutionProvider {
   */
   virtual common::Status OnRunEnd();
 
+  /**
+     Whether the provider can record the device work of a whole Run and replay it
+     in later Run calls. Only used when every node of the graph is assigned to the
+     provider and the inputs and outputs are bound to fixed device buffers.
+  */
+  virtual bool IsGraphCaptureEnabled() const { return false; }
+
+  /**
+     Called between OnRunStart and OnRunEnd. Replays the work recorded for graph_key,
+     if there is any, and sets replayed accordingly.
+  */
+  virtual common::Status ReplayGraph(const std::string& graph_key, bool& replayed);
+
+  /**
+     Called before the graph is executed for graph_key when ReplayGraph did not replay it.
+     The provider sets capturing if it prepares to record the execution that follows,
+     in which case EndGraphCapture must be called once the execution returns.
+  */
+  virtual common::Status BeginGraphCapture(const std::string& graph_key, bool& capturing);
+
+  /**
+     Called after an execution that BeginGraphCapture prepared for. If run_status is OK the
+     recorded work, if any, is kept for graph_key and submitted. Otherwise graph_key is not
+     recorded again, and rerun is set if nothing was executed so the Run must execute again.
+  */
+  virtual common::Status EndGraphCapture(const std::string& graph_key, const common::Status& run_status,
+                                         bool& rerun);
+
+  /**
+     Profiler of the device work of the provider, e.g. its kernel launches and copies.
+     Called once when the session is initialized; the events it collects while profiling
+     is enabled are added to the profile of the session. nullptr if the provider has none.
+  */
+  virtual std::unique_ptr<profiling::DeviceProfiler> GetProfiler();
+
   void InsertAllocator(AllocatorPtr allocator);
 
+  /**
+     Replace the allocator that has the same OrtMemoryInfo as 'allocator'.
+     Used to make the provider use an allocator shared across sessions.
+     @return false if the provider has no such allocator, in which case nothing is changed.
+  */
+  bool ReplaceAllocator(AllocatorPtr allocator);
+
   /**
   Given a list of fused_node, return create_state/compute/release_state func for each node.
   */
@@ -36,6 +36,11 @@ struct OrtValue {
     return data_ && type_;
   }
 
+  // true if other OrtValue instances hold the same data, so it can't be modified without them seeing it
+  bool IsShared() const noexcept {
+    return data_.use_count() > 1;
+  }
+
   template <typename T>
   const T& Get() const {
     ORT_ENFORCE(onnxruntime::DataTypeImpl::GetType<T>() == type_, onnxruntime::DataTypeImpl::GetType<T>(), " != ", type_);
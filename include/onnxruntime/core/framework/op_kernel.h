@@ -13,6 +13,7 @@
 #include "core/framework/ml_value.h"
 #include "core/framework/op_kernel_info.h"
 #include "core/framework/op_node_proto_helper.h"
+#include "core/framework/prepacked_weights.h"
 #include "core/framework/tensor.h"
 #include "core/framework/sparse_tensor.h"
 #include "core/graph/constants.h"
@@ -28,6 +29,12 @@ namespace concurrency {
 class ThreadPool;
 }
 
+// Work done by a call to OpKernel::Compute, estimated from the shapes of its inputs and outputs. See OpKernel::GetCost.
+struct KernelCost {
+  int64_t flops = 0;  // arithmetic operations, two per multiply-add
+  int64_t bytes = 0;  // bytes of memory read and written
+};
+
 class OpKernel {
  public:
   using DoneCallback = std::function<void()>;
@@ -49,6 +56,48 @@ class OpKernel {
     ORT_NOT_IMPLEMENTED(__FUNCTION__, " is not implemented");
   }
 
+  /**
+  Override to convert a constant initializer input into a layout better suited to the kernel, once when the session
+  is initialized, rather than on every call to Compute. Only called for CPU tensors.
+  @param tensor The constant initializer.
+  @param input_idx The index of the input the initializer is bound to.
+  @param alloc The allocator to create the packed buffers with. They may outlive the session.
+  @param is_packed Set to true if the kernel packed the tensor and filled prepacked_weights.
+  @param prepacked_weights The packed buffers. They are handed back by UseSharedPrePackedBuffers, which is where the
+  kernel should take the pointers it computes with.
+  */
+  virtual Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                         /*out*/ bool& is_packed, /*out*/ PrePackedWeights& prepacked_weights) {
+    ORT_UNUSED_PARAMETER(tensor);
+    ORT_UNUSED_PARAMETER(input_idx);
+    ORT_UNUSED_PARAMETER(alloc);
+    ORT_UNUSED_PARAMETER(prepacked_weights);
+    is_packed = false;
+    return Status::OK();
+  }
+
+  /**
+  Called after PrePack packed an input, with the buffers produced by this kernel or, if packed weights are shared
+  across sessions, by an identical kernel of another session for the same initializer data. The buffers are owned by
+  the session state or the env, and stay valid for the lifetime of the kernel.
+  */
+  virtual Status UseSharedPrePackedBuffers(const PrePackedWeights& prepacked_weights, int input_idx) {
+    ORT_UNUSED_PARAMETER(prepacked_weights);
+    ORT_UNUSED_PARAMETER(input_idx);
+    return Status::OK();
+  }
+
+  /**
+  Override to estimate the work done by the call to Compute that just completed with context, which the profiler
+  reports with the achieved GFLOPS and GB/s of the call. The inputs and outputs of the call are still available.
+  @returns false if the kernel has no cost model.
+  */
+  virtual bool GetCost(OpKernelContext& context, /*out*/ KernelCost& cost) const {
+    ORT_UNUSED_PARAMETER(context);
+    ORT_UNUSED_PARAMETER(cost);
+    return false;
+  }
+
   const OrtMemoryInfo& Allocator(int id, OrtMemType mem_type) const {
     return op_kernel_info_.GetMemoryInfo(id, mem_type);
   }
@@ -173,6 +222,14 @@ class OpKernelContext {
   _Ret_maybenull_ onnxruntime::concurrency::ThreadPool* GetOperatorThreadPool() const { return threadpool_; }
 
  protected:
+  // For executors that resolved the index of the first argument of the node in the frame ahead of time, see
+  // IExecutionFrame::GetNodeOffset.
+  OpKernelContext(IExecutionFrame* frame,
+                  const OpKernel* kernel,
+                  concurrency::ThreadPool* threadpool,
+                  const logging::Logger& logger,
+                  int node_input_start_index);
+
   onnxruntime::NodeIndex GetNodeIndex() const;
 
   const OrtValue* GetInputMLValue(int index) const;
@@ -258,6 +315,21 @@ KernelCreateInfo BuildKernelCreateInfo();
 }  // namespace cuda
 }  // namespace contrib
 
+// Placeholder entry of a kernel registration table, skipped by the registration loops. It keeps the table non-empty
+// when every kernel of it is excluded by a reduced operator build (tools/ci_build/exclude_unused_ops.py).
+template <>
+inline KernelCreateInfo BuildKernelCreateInfo<void>() { return KernelCreateInfo(nullptr, nullptr); }
+
+namespace ml {
+template <>
+inline KernelCreateInfo BuildKernelCreateInfo<void>() { return KernelCreateInfo(nullptr, nullptr); }
+}  // namespace ml
+
+namespace contrib {
+template <>
+inline KernelCreateInfo BuildKernelCreateInfo<void>() { return KernelCreateInfo(nullptr, nullptr); }
+}  // namespace contrib
+
 using BuildKernelCreateInfoFn = KernelCreateInfo (*)();
 
 // Naming convention for operator kernel classes
@@ -0,0 +1,19 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+// The buffers a kernel converted a constant initializer into in OpKernel::PrePack, e.g. the weights of a GEMM in the
+// packed panel layout of MLAS. They are owned by the session, or by the env if they are shared with other sessions.
+struct PrePackedWeights {
+  std::vector<BufferUniquePtr> buffers_;
+  std::vector<size_t> buffer_sizes_;
+};
+
+}  // namespace onnxruntime
@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <atomic>
+#include "core/framework/run_stats.h"
 #include "core/session/onnxruntime_c_api.h"
 
 /**
@@ -22,6 +25,41 @@ struct OrtRunOptions {
   // be forced to terminate with an error status.
   bool terminate = false;
 
+  // Set to 'true' to return the memory regions of the session's arenas that are entirely free
+  // back to the device allocators once the Run() call completes. Useful for long running servers
+  // where one large request would otherwise keep the process at its peak memory usage.
+  bool shrink_memory_arenas = false;
+
+  // Optional caller owned device stream (a cudaStream_t for the CUDA execution provider) the Run is ordered with.
+  // The provider waits for the work already queued on it before the Run starts, and makes it wait for the Run's
+  // work when the Run ends, so the caller can keep pipelining without a host synchronization.
+  void* compute_stream = nullptr;
+
+  // Set to 'true' to leave the outputs that are not pre-allocated on the device of the node that produced them
+  // instead of copying them to CPU memory. The Run waits for the device to finish before it returns, so the
+  // outputs can be fed to a session on another device or thread. Used between the stages of a PipelineSession.
+  bool fetches_on_device = false;
+
+  // Stream whose state the Run reads and updates when the session has state bindings (see
+  // SessionOptions::state_bindings). The bound inputs that aren't fed are fed with the bound outputs of the previous
+  // Run of the stream, and the bound outputs are kept for the next one, whether or not they are fetched. Feeding a
+  // bound input resets the state. -1 runs without state.
+  int64_t state_stream_id = -1;
+
+  // Set to 'true' to have each Run() call that uses this instance write its statistics to run_stats when it
+  // succeeds. The instance must not be used by concurrent Run() calls then.
+  bool collect_run_stats = false;
+  mutable onnxruntime::RunStats run_stats;
+
+  // Priority of the Run among the Run calls of the sessions using the global thread pools of the env (see
+  // CreateEnvWithGlobalThreadPools). Between two of its nodes, a Run waits while a Run of a higher priority is in
+  // progress, which leaves the shared thread pools to the latter. Ignored by the sessions with their own pools.
+  int priority = 0;
+
+  // Time after which the Run calls using this instance are abandoned between two nodes with an error status, as if
+  // terminate were set. time_point::max() for no deadline.
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+
   OrtRunOptions() = default;
   ~OrtRunOptions() = default;
 
@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace onnxruntime {
+
+/**
+ * Memory and time statistics of Run calls, for a single Run (see OrtRunOptions::collect_run_stats) or summed over
+ * the runs of a session (see InferenceSession::GetCumulativeRunStats).
+ * The allocations are the ones of the main graph: the subgraphs of control flow nodes aren't included.
+ */
+struct RunStats {
+  int64_t num_runs = 0;
+  // buffers allocated from the session allocators for the intermediate values and the outputs, including the blocks
+  // of the memory patterns, and their bytes
+  int64_t num_allocations = 0;
+  int64_t bytes_allocated = 0;
+  // peak of the bytes of those buffers held at the same time. the maximum over the runs for the session totals.
+  int64_t peak_bytes = 0;
+  // bytes of the inputs and outputs copied between devices
+  int64_t bytes_copied = 0;
+  // time spent executing the nodes, and copying the inputs and outputs between devices
+  int64_t execution_time_us = 0;
+  int64_t copy_time_us = 0;
+  // runs which placed their intermediate values with a cached memory pattern that fitted all of them
+  int64_t num_memory_pattern_hits = 0;
+
+  void Add(const RunStats& other) {
+    num_runs += other.num_runs;
+    num_allocations += other.num_allocations;
+    bytes_allocated += other.bytes_allocated;
+    peak_bytes = std::max(peak_bytes, other.peak_bytes);
+    bytes_copied += other.bytes_copied;
+    execution_time_us += other.execution_time_us;
+    copy_time_us += other.copy_time_us;
+    num_memory_pattern_hits += other.num_memory_pattern_hits;
+  }
+};
+
+}  // namespace onnxruntime
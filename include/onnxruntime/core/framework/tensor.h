@@ -162,20 +162,35 @@ class Tensor final {
 
   void* MutableDataRaw(MLDataType type) {
     ORT_ENFORCE(type == dtype_, "Tensor type mismatch.", type, "!=", dtype_);
-    return p_data_;
+    return static_cast<char*>(p_data_) + byte_offset_;
   }
 
   const void* DataRaw(MLDataType type) const {
     ORT_ENFORCE(type == dtype_, "Tensor type mismatch.", type, "!=", dtype_);
-    return p_data_;
+    return static_cast<char*>(p_data_) + byte_offset_;
   }
 
   void* MutableDataRaw() noexcept {
-    return p_data_;
+    return static_cast<char*>(p_data_) + byte_offset_;
   }
 
   const void* DataRaw() const noexcept {
-    return p_data_;
+    return static_cast<char*>(p_data_) + byte_offset_;
+  }
+
+  /**
+   * The offset in bytes of the data of the tensor within its buffer.
+   */
+  ptrdiff_t ByteOffset() const noexcept {
+    return byte_offset_;
+  }
+
+  /**
+   * Moves the data of the tensor within its buffer, e.g. to make it a view of a block of another tensor.
+   * @warning the buffer must hold the data of the tensor at the new offset.
+   */
+  void SetByteOffset(ptrdiff_t byte_offset) noexcept {
+    byte_offset_ = byte_offset;
   }
 
   /**
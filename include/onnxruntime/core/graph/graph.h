@@ -454,6 +454,9 @@ class Node {
   // This allows attribute adding and removing.
   NodeAttributes attributes_;
 
+  // Incremented when an attribute is added, changed or removed.
+  uint64_t attributes_version_ = 0;
+
   // Graph that contains this Node
   Graph* graph_;
 
@@ -924,6 +927,13 @@ class Graph {
 
   common::Status InferAndVerifyTypeMatch(Node& node, const ONNX_NAMESPACE::OpSchema& op);
 
+  // Returns true if the inputs, outputs and attributes of the node are the same as when it was last inferred, so the
+  // types and shapes of its outputs are still valid.
+  bool IsInferenceUpToDate(const Node& node) const;
+
+  // Record the state of the node after its types and shapes were inferred.
+  void SetInferenceUpToDate(const Node& node);
+
   // perform type and shape inferencing on the subgraph and Resolve to validate
   static common::Status InferAndVerifySubgraphTypes(const Node& node, Graph& subgraph,
                                                     const std::vector<const ONNX_NAMESPACE::TypeProto*>& input_types,
@@ -1051,6 +1061,18 @@ class Graph {
   // number of times Resolve has run.
   int num_resolves_ = 0;
 
+  // The inputs, outputs and attributes of a node when its types and shapes were last inferred.
+  struct InferredNodeState {
+    const ONNX_NAMESPACE::OpSchema* op = nullptr;
+    uint64_t attributes_version = 0;
+    std::vector<std::pair<const NodeArg*, uint64_t>> inputs;
+    std::vector<NodeArg*> outputs;
+  };
+
+  // State of the nodes of this graph as of the last Resolve. A node whose state is unchanged is not inferred again,
+  // and as its outputs keep their types and shapes, neither are its consumers unless something else changed for them.
+  std::unordered_map<NodeIndex, InferredNodeState> inferred_node_states_;
+
   const logging::Logger& logger_;
 };
 
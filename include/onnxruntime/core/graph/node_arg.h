@@ -98,5 +98,9 @@ class NodeArg {
 
   // Flag indicates whether <*this> node arg exists or not.
   bool exists_;
+
+  // Incremented when the type, the shape or the initializer of <*this> node arg changes. Graph::Resolve uses it to
+  // skip type/shape inferencing of the nodes whose inputs didn't change since the previous Resolve.
+  uint64_t version_ = 0;
 };
 }  // namespace onnxruntime
@@ -10,6 +10,9 @@
 #include "core/optimizer/graph_transformer_level.h"
 
 namespace onnxruntime {
+namespace profiling {
+class Profiler;
+}
 
 /**
 @class GraphTransformer
@@ -39,7 +42,16 @@ class GraphTransformer {
   */
   common::Status Apply(Graph& graph, bool& modified, const logging::Logger& logger) const;
 
+  /** Sets the profiler the transformer may record finer grained events to, such as the rewrites of each rule.
+  The GraphTransformerManager records an event for each application of the transformer. */
+  void SetProfiler(profiling::Profiler* profiler) noexcept {
+    profiler_ = profiler;
+  }
+
  protected:
+  /** Gets the profiler if one was set and it is enabled, nullptr otherwise. */
+  profiling::Profiler* EnabledProfiler() const noexcept;
+
   /** Helper method to call ApplyImpl on any subgraphs in the Node. */
   common::Status Recurse(Node& node, bool& modified, int graph_level, const logging::Logger& logger) const {
     int subgraph_level = ++graph_level;
@@ -66,5 +78,6 @@ class GraphTransformer {
 
   const std::string name_;
   const std::unordered_set<std::string> compatible_provider_types_;
+  profiling::Profiler* profiler_ = nullptr;
 };
 }  // namespace onnxruntime
@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <string>
 #include <vector>
 #include <functional>
@@ -29,6 +33,38 @@ namespace onnxruntime {
 
 namespace concurrency {
 
+/**
+ * Options controlling how the threads of a ThreadPool wait for work and where they run.
+ */
+struct ThreadOptions {
+  // Let idle worker threads spin for a while before they block waiting for new work.
+  bool allow_spinning = true;
+
+  // How long, in microseconds, a thread waiting for the other threads to finish a parallel loop spins
+  // before it blocks. 0 blocks straight away.
+  unsigned int spin_duration_us = 0;
+
+  // Logical processors the worker threads are pinned to. Empty leaves the placement to the OS.
+  std::vector<size_t> affinity;
+};
+
+/**
+ * Utilization counters of a ThreadPool, see ThreadPool::GetStats. The counts are since the pool was created.
+ * The work given to the Eigen pool through GetHandler isn't counted.
+ */
+struct ThreadPoolStats {
+  int num_threads = 0;
+  // Tasks scheduled which no worker thread started yet.
+  int64_t queued_tasks = 0;
+  // Worker threads running a task.
+  int64_t active_workers = 0;
+  // Tasks the worker threads completed.
+  int64_t num_tasks = 0;
+  // Work a thread took from another one: the tasks scheduled by a worker thread, which queues them for itself, and
+  // run by another worker, and the blocks of the parallel loops run by the worker threads rather than the caller.
+  int64_t num_steals = 0;
+};
+
 /**
  * Generic class for instantiating thread pools.
  * Don't put any object of this type into a global variable in a Win32 DLL.
@@ -40,6 +76,8 @@ class ThreadPool {
   */
   ThreadPool(const std::string& name, int num_threads);
 
+  ThreadPool(const std::string& name, int num_threads, const ThreadOptions& thread_options);
+
   /*
   Enqueue a unit of work.
   */
@@ -50,11 +88,45 @@ class ThreadPool {
   */
   void ParallelFor(int32_t total, std::function<void(int32_t)> fn);
 
+  /*
+  Schedule work in the interval [0, total) without wrapping each call in a std::function.
+  The calling thread runs iterations too, and returns once all of them have completed.
+  */
+  template <typename F>
+  void ParallelFor(int32_t total, F&& fn) {
+    if (total <= 0)
+      return;
+
+    // split into a few blocks per thread so faster threads can pick up more of the work
+    const int32_t num_threads = NumThreads() + 1;
+    RunBlocks(total, std::max<int32_t>(1, total / (blocks_per_thread_ * num_threads)), fn);
+  }
+
   /*
   Schedule work in the interval [0, total), with calls split into (num_batches) batches.
   */
   void BatchParallelFor(int32_t total, std::function<void(int32_t)> fn, int32_t num_batches = 0);
 
+  template <typename F>
+  void BatchParallelFor(int32_t total, F&& fn, int32_t num_batches = 0) {
+    if (total <= 0)
+      return;
+
+    if (num_batches <= 0) {
+      num_batches = std::min(total, NumThreads());
+    }
+
+    if (num_batches <= 1) {
+      for (int32_t i = 0; i < total; i++) {
+        fn(i);
+      }
+      return;
+    }
+
+    num_batches = std::min(num_batches, total);
+    RunBlocks(total, (total + num_batches - 1) / num_batches, fn);
+  }
+
   /*
   Schedule work in the interval [first, last].
   */
@@ -105,10 +177,117 @@ class ThreadPool {
 
   int CurrentThreadId() const;
 
-  Eigen::ThreadPool& GetHandler() { return impl_; }
+  // A snapshot of the counters, read without stopping the pool, so the counts may be off by the tasks starting or
+  // completing meanwhile. Thread-safe.
+  ThreadPoolStats GetStats() const;
+
+  // Eigen thread environment that applies the pool's affinity to each worker thread before it starts.
+  struct ThreadEnvironment : Eigen::StlThreadEnvironment {
+    std::vector<size_t> affinity;
+
+    EnvThread* CreateThread(std::function<void()> f) {
+      if (affinity.empty()) {
+        return Eigen::StlThreadEnvironment::CreateThread(std::move(f));
+      }
+
+      const std::vector<size_t>& processors = affinity;
+      return Eigen::StlThreadEnvironment::CreateThread([processors, f]() {
+        SetCurrentThreadAffinity(processors);
+        f();
+      });
+    }
+  };
+
+  using EigenThreadPool = Eigen::ThreadPoolTempl<ThreadEnvironment>;
+
+  EigenThreadPool& GetHandler() { return impl_; }
 
  private:
-  Eigen::ThreadPool impl_;
+  static void SetCurrentThreadAffinity(const std::vector<size_t>& processors);
+
+  static ThreadEnvironment MakeEnvironment(const ThreadOptions& thread_options);
+
+  // State of a parallel loop, shared by the calling thread and the helper tasks it schedules. The blocks are
+  // claimed dynamically, so a helper that starts after they were all claimed returns without touching the loop
+  // body, and the caller only waits for the blocks to complete rather than for every helper to start.
+  struct ParallelForState {
+    ParallelForState(int32_t total_in, int32_t block_size_in)
+        : total(total_in),
+          block_size(block_size_in),
+          num_blocks((total_in + block_size_in - 1) / block_size_in),
+          barrier(static_cast<unsigned int>(num_blocks)) {}
+
+    const int32_t total;
+    const int32_t block_size;
+    const int32_t num_blocks;
+    std::atomic<int32_t> next_block{0};
+    std::atomic<int32_t> completed_blocks{0};
+    Eigen::Barrier barrier;
+  };
+
+  // returns the number of blocks run
+  template <typename F>
+  static int32_t RunClaimedBlocks(ParallelForState& state, const F* fn) {
+    int32_t num_blocks = 0;
+    for (int32_t block = state.next_block.fetch_add(1, std::memory_order_relaxed); block < state.num_blocks;
+         block = state.next_block.fetch_add(1, std::memory_order_relaxed)) {
+      const int32_t begin = block * state.block_size;
+      const int32_t end = std::min(begin + state.block_size, state.total);
+      for (int32_t i = begin; i < end; ++i) {
+        (*fn)(i);
+      }
+      state.completed_blocks.fetch_add(1, std::memory_order_release);
+      state.barrier.Notify();
+      ++num_blocks;
+    }
+    return num_blocks;
+  }
+
+  template <typename F>
+  void RunBlocks(int32_t total, int32_t block_size, const F& fn) {
+    auto state = std::make_shared<ParallelForState>(total, block_size);
+    const int32_t num_helpers = std::min(state->num_blocks - 1, NumThreads());
+    const F* fn_ptr = &fn;
+    for (int32_t i = 0; i < num_helpers; ++i) {
+      Schedule([this, state, fn_ptr]() {
+        const int32_t num_blocks = RunClaimedBlocks(*state, fn_ptr);
+        if (num_blocks != 0) {
+          steals_.fetch_add(num_blocks, std::memory_order_relaxed);
+        }
+      });
+    }
+
+    RunClaimedBlocks(*state, fn_ptr);
+    SpinUntilCompleted(*state);
+    state->barrier.Wait();
+  }
+
+  // Give the helpers up to spin_duration_us to finish their blocks before blocking on the barrier, which
+  // saves a sleep/wake-up round trip for the short loops that are typical in inference.
+  void SpinUntilCompleted(const ParallelForState& state) const {
+    if (spin_duration_us_ == 0 || state.completed_blocks.load(std::memory_order_acquire) == state.num_blocks)
+      return;
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(spin_duration_us_);
+    while (state.completed_blocks.load(std::memory_order_acquire) != state.num_blocks &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+  }
+
+  void RunTask(const std::function<void()>& fn, int scheduling_thread);
+
+  const unsigned int spin_duration_us_ = 0;
+  // blocks of a parallel loop per thread, more on the processors whose cores run at different speeds, so the work
+  // the fast cores take over from the slow ones is finer grained
+  const int32_t blocks_per_thread_ = 4;
+  // utilization counters, updated with relaxed atomics as they are only read by GetStats. They are declared before
+  // impl_ so they outlive the worker threads.
+  std::atomic<int64_t> scheduled_tasks_{0};
+  std::atomic<int64_t> started_tasks_{0};
+  std::atomic<int64_t> completed_tasks_{0};
+  std::atomic<int64_t> steals_{0};
+  EigenThreadPool impl_;
 };
 
 }  // namespace concurrency
@@ -12,6 +12,27 @@ extern "C" {
  */
 ORT_API_STATUS(OrtSessionOptionsAppendExecutionProvider_CUDA, _In_ OrtSessionOptions* options, int device_id);
 
+/**
+ * \param device_id cuda device id, starts from zero.
+ * \param enable_cuda_graph set to a non-zero value to record the kernels of a Run into a CUDA graph and replay it
+ * in the later Runs that bind their inputs and outputs to the same device buffers with the same shapes.
+ * Only used if every node of the model is assigned to the CUDA execution provider.
+ */
+ORT_API_STATUS(OrtSessionOptionsAppendExecutionProviderEx_CUDA, _In_ OrtSessionOptions* options, int device_id,
+               int enable_cuda_graph);
+
+/**
+ * The cuDNN convolution algorithms the CUDA execution provider picks are cached per device and shared by all the
+ * sessions of the process. These save the cache of a device to a file and load it back, e.g. in a later process,
+ * so that the algorithm search is skipped for the convolution shapes already seen.
+ * Entries are recorded under the GPU name and the cuDNN version, the entries of other GPU models or cuDNN versions
+ * in the file are ignored by the load and kept by the save.
+ * \param device_id cuda device id, starts from zero.
+ * \param file_path path of the cache file.
+ */
+ORT_API_STATUS(OrtSaveCudnnAlgoCache_CUDA, int device_id, _In_ const ORTCHAR_T* file_path);
+ORT_API_STATUS(OrtLoadCudnnAlgoCache_CUDA, int device_id, _In_ const ORTCHAR_T* file_path);
+
 #ifdef __cplusplus
 }
 #endif
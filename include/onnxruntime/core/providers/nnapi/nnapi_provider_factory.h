@@ -8,6 +8,17 @@ extern "C" {
 
 ORT_API_STATUS(OrtSessionOptionsAppendExecutionProvider_Nnapi, _In_ OrtSessionOptions* options);
 
+/**
+ * \param use_fp16 set to a non-zero value to let NNAPI compute the float32 models in float16 (relaxed computation),
+ * which the NPUs and GPUs of most devices need to run them. On by default in
+ * OrtSessionOptionsAppendExecutionProvider_Nnapi.
+ * \param execution_preference the ANEURALNETWORKS_PREFER_* value the models are compiled with:
+ * 0 for low power, 1 for fast single answer, 2 for sustained speed (the default of
+ * OrtSessionOptionsAppendExecutionProvider_Nnapi).
+ */
+ORT_API_STATUS(OrtSessionOptionsAppendExecutionProviderEx_Nnapi, _In_ OrtSessionOptions* options, int use_fp16,
+               int execution_preference);
+
 #ifdef __cplusplus
 }
 #endif
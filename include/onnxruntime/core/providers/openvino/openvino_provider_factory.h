@@ -13,6 +13,18 @@ extern "C" {
 ORT_API_STATUS(OrtSessionOptionsAppendExecutionProvider_OpenVINO,
     _In_ OrtSessionOptions* options, const char* device_id);
 
+/**
+ * \param device_id OpenVINO device, e.g. "CPU".
+ * \param num_streams number of throughput streams of the device, 0 for the default of the plugin. The concurrent
+ * Runs of a session, and the slices of a batch, are dispatched to as many infer requests as the plugin finds optimal
+ * for these streams, so that they overlap on the device instead of running one after the other.
+ * \param blob_cache_dir if not empty, directory where the networks compiled for the device are exported, and from
+ * where they are imported by the later sessions of the same model on the same device instead of being compiled
+ * again. Ignored by the plugins that can't export their networks.
+ */
+ORT_API_STATUS(OrtSessionOptionsAppendExecutionProviderEx_OpenVINO, _In_ OrtSessionOptions* options,
+               const char* device_id, int num_streams, _In_opt_ const char* blob_cache_dir);
+
 #ifdef __cplusplus
 }
 #endif
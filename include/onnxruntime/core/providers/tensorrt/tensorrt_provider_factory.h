@@ -9,6 +9,26 @@ extern "C" {
 
 ORT_API_STATUS(OrtSessionOptionsAppendExecutionProvider_Tensorrt, _In_ OrtSessionOptions* options, int device_id);
 
+/**
+ * \param device_id cuda device id, starts from zero.
+ * \param option_keys, option_values provider options, they override the ORT_TENSORRT_* environment variables:
+ *   "profile_shapes": the shape ranges of the dynamic inputs, one optimization profile each. The profiles are
+ *   separated by '|', the inputs of a profile by ';', an input is <name>:<min shape>,<opt shape>,<max shape> and
+ *   the dims of a shape are separated by 'x', e.g. "input_ids:1x16,8x128,32x512;mask:1x16,8x128,32x512".
+ *   A single engine covering all the profiles is built, and each Run uses the first profile covering its inputs.
+ *   "fp16_enable": "1" to let TensorRT use FP16 kernels.
+ *   "int8_enable": "1" to let TensorRT use INT8 kernels, needs "int8_calibration_table".
+ *   "int8_calibration_table": path of a text file with a "<tensor name> <max abs value>" line per tensor, e.g.
+ *   written from sample feeds by tools/quantization/trt_calibration_table.py. The layers of the tensors without a
+ *   range run in FP16 or FP32.
+ *   "context_pool_size": number of execution contexts per optimization profile, each with its own device memory
+ *   and CUDA stream, so that as many concurrent Runs execute at once. Only used for engines with the
+ *   "profile_shapes" option or without dynamic shapes.
+ */
+ORT_API_STATUS(OrtSessionOptionsAppendExecutionProviderEx_Tensorrt, _In_ OrtSessionOptions* options, int device_id,
+               _In_ const char* const* option_keys,
+               _In_ const char* const* option_values, size_t num_options);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,13 +5,18 @@
 
 #include <atomic>
 #include <memory>
+#include <vector>
 #include "core/common/common.h"
 #include "core/common/status.h"
+#include "core/framework/allocator.h"
 #include "core/platform/threadpool.h"
 #include "core/common/logging/logging.h"
 
 struct ThreadingOptions;
 namespace onnxruntime {
+class PrepackedWeightsContainer;
+class SharedInitializerStore;
+
 /** TODO: remove this class
    Provides the runtime environment for onnxruntime.
    Create one instance for the duration of execution.
@@ -54,6 +59,35 @@ class Environment {
     return create_global_thread_pools_;
   }
 
+  /**
+   * Registers an allocator that can be shared across sessions. Sessions created with
+   * SessionOptions::use_env_allocators use it in place of the execution provider allocator
+   * with the same OrtMemoryInfo, instead of each building its own arena.
+   * Register the allocators before creating the sessions that should use them.
+   * The allocator must be thread safe.
+   */
+  Status RegisterAllocator(AllocatorPtr allocator);
+
+  const std::vector<AllocatorPtr>& GetRegisteredSharedAllocators() const {
+    return shared_allocators_;
+  }
+
+  /**
+   * Store of the weights pre-packed by the kernels of the sessions created with
+   * SessionOptions::use_env_prepacked_weights, so those sessions share one copy of each packed weight.
+   */
+  const std::shared_ptr<PrepackedWeightsContainer>& GetPrepackedWeightsContainer() const {
+    return prepacked_weights_container_;
+  }
+
+  /**
+   * Store of the constant initializers of the sessions created with SessionOptions::use_env_shared_initializers,
+   * so those sessions share one copy of each initializer with the same content.
+   */
+  const std::shared_ptr<SharedInitializerStore>& GetSharedInitializerStore() const {
+    return shared_initializer_store_;
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Environment);
 
@@ -66,5 +100,8 @@ class Environment {
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> intra_op_thread_pool_;
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
   bool create_global_thread_pools_{false};
+  std::vector<AllocatorPtr> shared_allocators_;
+  std::shared_ptr<PrepackedWeightsContainer> prepacked_weights_container_;
+  std::shared_ptr<SharedInitializerStore> shared_initializer_store_;
 };
 }  // namespace onnxruntime
@@ -19,9 +19,11 @@ extern "C" {
 #define _In_opt_
 #define _Out_
 #define _Outptr_
+#define _Outptr_opt_
 #define _Out_opt_
 #define _Inout_
 #define _Inout_opt_
+#define _In_reads_(X)
 #define _Frees_ptr_opt_
 #define _Ret_maybenull_
 #define _Ret_notnull_
@@ -159,6 +161,9 @@ ORT_RUNTIME_CLASS(CustomOpDomain);
 ORT_RUNTIME_CLASS(MapTypeInfo);
 ORT_RUNTIME_CLASS(SequenceTypeInfo);
 ORT_RUNTIME_CLASS(ModelMetadata);
+ORT_RUNTIME_CLASS(IoBinding);
+ORT_RUNTIME_CLASS(PreparedRun);
+ORT_RUNTIME_CLASS(ThreadPool);  // owned by the session or the env, never released by the user
 
 // When passing in an allocator to any ORT function, be sure that the allocator object
 // is not destroyed until the last allocated object using it is freed.
@@ -173,6 +178,11 @@ typedef void(ORT_API_CALL* OrtLoggingFunction)(
     void* param, OrtLoggingLevel severity, const char* category, const char* logid, const char* code_location,
     const char* message);
 
+// Called by RunAsync on a thread of the session when the run is done. outputs is the output array given to RunAsync.
+// status is null if the run succeeded. Otherwise the callback owns it and releases it with ReleaseStatus.
+typedef void(ORT_API_CALL* RunAsyncCallbackFn)(void* user_data, OrtValue** outputs, size_t num_outputs,
+                                                OrtStatus* status);
+
 // Set Graph optimization level.
 // Refer https://github.com/microsoft/onnxruntime/blob/master/docs/ONNX_Runtime_Graph_Optimizations.md
 // for in-depth undersrtanding of Graph Optimizations in ORT
@@ -218,6 +228,23 @@ typedef struct ThreadingOptions {
 
   // number of threads used to parallelize execution across ops
   int inter_op_num_threads;  // use 0 if you want onnxruntime to choose a value for you
+
+  // microseconds a thread waiting for a parallel loop to complete spins before it blocks
+  unsigned int spin_duration_us;  // use 0 to block straight away
+
+  // set to non-zero so idle worker threads block right away instead of spinning for new work
+  int disable_worker_spinning;
+
+  // set to non-zero to pin the worker threads to the logical processors of numa_node.
+  // ignored for a pool that has an explicit affinity below.
+  int pin_to_numa_node;
+  int numa_node;
+
+  // logical processors the worker threads of each pool are pinned to. use NULL/0 to leave the placement to the OS.
+  const size_t* intra_op_thread_affinity;
+  size_t intra_op_thread_affinity_len;
+  const size_t* inter_op_thread_affinity;
+  size_t inter_op_thread_affinity_len;
 } ThreadingOptions;
 
 struct OrtApi;
@@ -772,6 +799,433 @@ struct OrtApi {
   * This API should be used in conjunction with CreateEnvWithGlobalThreadPools API.
   */
   OrtStatus*(ORT_API_CALL* DisablePerSessionThreads)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /*
+  * Set to a non-zero value so that the memory arenas of the session release their entirely free
+  * regions back to the device once each OrtRun call that uses this OrtRunOptions instance completes.
+  */
+  OrtStatus*(ORT_API_CALL* RunOptionsSetShrinkMemoryArenas)(_Inout_ OrtRunOptions* options, int value)NO_EXCEPTION;
+
+  /*
+  * Creates an allocator for the device described by mem_info and registers it on the env so that it
+  * can be shared by the sessions created with EnableEnvAllocators. Register the allocators before creating
+  * the sessions that should use them. Only CPU arena allocators are supported at the moment.
+  */
+  OrtStatus*(ORT_API_CALL* CreateAndRegisterAllocator)(_Inout_ OrtEnv* env, _In_ const OrtMemoryInfo* mem_info)NO_EXCEPTION;
+
+  /*
+  * Calling this API will make the session use the allocators registered on the env with
+  * CreateAndRegisterAllocator in place of the execution provider allocators with the same OrtMemoryInfo.
+  */
+  OrtStatus*(ORT_API_CALL* EnableEnvAllocators)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /*
+  * Enable the memory pattern optimization for inputs with dynamic shapes. Input dimensions are rounded up
+  * to the smallest of bucket_boundaries that is not less than them (or to the next power of two if
+  * num_boundaries is 0) so inputs in the same bucket share one memory pattern.
+  * \param bucket_boundaries bucket upper bounds in increasing order. Can be NULL if num_boundaries is 0.
+  */
+  OrtStatus*(ORT_API_CALL* EnableMemPatternBucketing)(_Inout_ OrtSessionOptions* options,
+                                                      _In_opt_ const int64_t* bucket_boundaries,
+                                                      size_t num_boundaries)NO_EXCEPTION;
+
+  /*
+  * Sets how the threads of the session thread pools wait.
+  * \param spin_duration_us microseconds a thread waiting for a parallel loop to complete spins before it blocks.
+  * \param allow_worker_spinning set to 0 so idle worker threads block right away instead of spinning for new work.
+  */
+  OrtStatus*(ORT_API_CALL* SetThreadPoolSpinning)(_Inout_ OrtSessionOptions* options, unsigned int spin_duration_us,
+                                                  int allow_worker_spinning)NO_EXCEPTION;
+
+  /*
+  * Pins the intra op (or inter op) worker threads of the session to the given logical processors.
+  * If the number of threads was not set, one thread is created per logical processor.
+  */
+  OrtStatus*(ORT_API_CALL* SetIntraOpThreadAffinity)(_Inout_ OrtSessionOptions* options,
+                                                     _In_ const size_t* logical_processors, size_t len)NO_EXCEPTION;
+  OrtStatus*(ORT_API_CALL* SetInterOpThreadAffinity)(_Inout_ OrtSessionOptions* options,
+                                                     _In_ const size_t* logical_processors, size_t len)NO_EXCEPTION;
+
+  /*
+  * Pins the worker threads of the session to the logical processors of a NUMA node.
+  * A pool with an explicit affinity keeps it. Use -1 to clear.
+  */
+  OrtStatus*(ORT_API_CALL* SetThreadPoolNumaNode)(_Inout_ OrtSessionOptions* options, int numa_node)NO_EXCEPTION;
+
+  /*
+  * Caches the graph of the session after the graph transformations and partitioning in the given file.
+  * A later session created for the same model with the same options and execution providers skips them.
+  * The large initializers are written aligned to <path>.data, which the later sessions map in place.
+  */
+  OrtStatus*(ORT_API_CALL* SetSessionStateCacheFilePath)(_Inout_ OrtSessionOptions* options,
+                                                         _In_ const ORTCHAR_T* cache_file_path)NO_EXCEPTION;
+
+  /*
+  * By default the kernels convert their constant weights into the layout they compute with once, when the session
+  * is initialized. DisablePrePacking turns this off.
+  * With EnableEnvPrePackedWeights the packed weights are kept in the env and shared by the sessions with this option
+  * that load the same weights, so each one is packed and held in memory once.
+  */
+  OrtStatus*(ORT_API_CALL* DisablePrePacking)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+  OrtStatus*(ORT_API_CALL* EnableEnvPrePackedWeights)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /*
+  * Lets the CPU kernels that autotune (such as Conv) measure their candidate algorithms and thread counts the first
+  * time they see a shape and keep the fastest.
+  * \param cache_file_path optional file the measured configurations are kept in, keyed by the processor model, so
+  * later sessions on identical hosts reuse them. May be null.
+  */
+  OrtStatus*(ORT_API_CALL* EnableCpuTuning)(_Inout_ OrtSessionOptions* options,
+                                            _In_opt_ const ORTCHAR_T* cache_file_path)NO_EXCEPTION;
+
+  /*
+  * Orders the device work of each OrtRun call that uses this OrtRunOptions instance with a caller owned stream
+  * (a cudaStream_t for the CUDA execution provider). The Run waits for the work already queued on the stream
+  * before it starts, and work queued on the stream after the Run returns waits for the Run's results; no host
+  * synchronization is involved. Pass null to use the execution provider's own streams only.
+  */
+  OrtStatus*(ORT_API_CALL* RunOptionsSetComputeStream)(_Inout_ OrtRunOptions* options, _In_opt_ void* stream)NO_EXCEPTION;
+
+  /*
+  * Lets the sequential executor run the nodes in an order chosen to lower the peak memory of the intermediate
+  * tensors, estimated from their inferred shapes, instead of the default topological order.
+  * Has no effect with ORT_PARALLEL execution mode.
+  */
+  OrtStatus*(ORT_API_CALL* EnableMemoryEfficientExecutionOrder)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /*
+  * Like AddFreeDimensionOverride, but the override applies to the free dimensions named dim_name (their dim_param)
+  * instead of the ones with a denotation.
+  */
+  OrtStatus*(ORT_API_CALL* AddFreeDimensionOverrideByName)(_Inout_ OrtSessionOptions* options,
+                                                           _In_ const char* dim_name, _In_ int64_t dim_value)NO_EXCEPTION;
+
+  /*
+  * Lets the session keep up to max_variants variants of its graph optimized for fixed values of the named free
+  * dimensions of the model inputs. A variant is created once a set of values has been seen in min_runs calls to
+  * Run, and the later calls with the same values run it instead of the generic graph.
+  * Only used when the CPU execution provider is the only one registered.
+  */
+  OrtStatus*(ORT_API_CALL* EnableShapeSpecialization)(_Inout_ OrtSessionOptions* options, int max_variants,
+                                                      int min_runs)NO_EXCEPTION;
+
+  /*
+  * Binds the output output_name of the model to its input input_name, such as Y_h to initial_h of a streaming LSTM.
+  * A Run whose run options have a state stream id feeds the bound inputs it isn't given with the bound outputs of
+  * the previous Run of the stream, which are kept by the session without being copied to the caller.
+  */
+  OrtStatus*(ORT_API_CALL* AddStateBinding)(_Inout_ OrtSessionOptions* options, _In_ const char* output_name,
+                                            _In_ const char* input_name)NO_EXCEPTION;
+
+  /*
+  * Sets the stream whose state is used by the Run calls with these run options. -1, the default, runs without state.
+  */
+  OrtStatus*(ORT_API_CALL* RunOptionsSetStateStreamId)(_Inout_ OrtRunOptions* options, int64_t stream_id)NO_EXCEPTION;
+
+  /*
+  * Releases the state kept for the stream stream_id. The next Run of the stream starts from the fed inputs.
+  */
+  OrtStatus*(ORT_API_CALL* ReleaseStateStream)(_Inout_ OrtSession* sess, int64_t stream_id)NO_EXCEPTION;
+
+  /*
+  * Creates a binding of the inputs and outputs of the session for RunWithBinding. The bound inputs are copied once to
+  * the device that consumes them, and the bound outputs are kept by the binding and reused by the next run.
+  */
+  OrtStatus*(ORT_API_CALL* CreateIoBinding)(_Inout_ OrtSession* sess, _Outptr_ OrtIoBinding** out)NO_EXCEPTION;
+  ORT_CLASS_RELEASE(IoBinding);
+
+  /*
+  * Binds the input name to value, copying it to the device of the node that consumes it if that's another device.
+  */
+  OrtStatus*(ORT_API_CALL* BindInput)(_Inout_ OrtIoBinding* binding, _In_ const char* name,
+                                      _In_ const OrtValue* value)NO_EXCEPTION;
+
+  /*
+  * Binds the output name to a preallocated value, which the runs write to.
+  */
+  OrtStatus*(ORT_API_CALL* BindOutput)(_Inout_ OrtIoBinding* binding, _In_ const char* name,
+                                       _In_ const OrtValue* value)NO_EXCEPTION;
+
+  /*
+  * Binds the output name to a device. The runs allocate the output there and don't copy it to CPU memory.
+  */
+  OrtStatus*(ORT_API_CALL* BindOutputToDevice)(_Inout_ OrtIoBinding* binding, _In_ const char* name,
+                                               _In_ const OrtMemoryInfo* mem_info)NO_EXCEPTION;
+
+  /*
+  * Runs the session with the bound inputs, writing the bound outputs.
+  */
+  OrtStatus*(ORT_API_CALL* RunWithBinding)(_Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                                           _Inout_ OrtIoBinding* binding)NO_EXCEPTION;
+
+  /*
+  * Returns the names of the bound outputs, in the order they were bound. names and each name are allocated with
+  * allocator, which the caller uses to free them.
+  */
+  OrtStatus*(ORT_API_CALL* GetBoundOutputNames)(_In_ const OrtIoBinding* binding, _Inout_ OrtAllocator* allocator,
+                                                _Outptr_ char*** names, _Out_ size_t* count)NO_EXCEPTION;
+
+  /*
+  * Returns the bound outputs, in the order they were bound. values is allocated with allocator, which the caller
+  * uses to free it, and each value is released with ReleaseValue. The values share their buffers with the binding.
+  */
+  OrtStatus*(ORT_API_CALL* GetBoundOutputValues)(_In_ const OrtIoBinding* binding, _Inout_ OrtAllocator* allocator,
+                                                 _Outptr_ OrtValue*** values, _Out_ size_t* count)NO_EXCEPTION;
+
+  /*
+  * Removes all the bound inputs or outputs.
+  */
+  void(ORT_API_CALL* ClearBoundInputs)(_Inout_ OrtIoBinding* binding)NO_EXCEPTION;
+  void(ORT_API_CALL* ClearBoundOutputs)(_Inout_ OrtIoBinding* binding)NO_EXCEPTION;
+
+  /*
+  * Resolves the inputs and outputs of the runs of the session with the given names once, for RunPrepared. The runs
+  * with it skip the name lookups. It can be used by concurrent RunPrepared calls, and must not outlive the session.
+  */
+  OrtStatus*(ORT_API_CALL* CreatePreparedRun)(_In_ OrtSession* sess, _In_ const char* const* input_names,
+                                              size_t input_len, _In_ const char* const* output_names,
+                                              size_t output_names_len, _Outptr_ OrtPreparedRun** out)NO_EXCEPTION;
+  ORT_CLASS_RELEASE(PreparedRun);
+
+  /*
+  * Same as Run, with the input and output names of the prepared run. input has one value per input name and output
+  * one entry per output name, in the order of the names given to CreatePreparedRun.
+  */
+  OrtStatus*(ORT_API_CALL* RunPrepared)(_Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                                        _In_ const OrtPreparedRun* prepared_run, _In_ const OrtValue* const* input,
+                                        _Inout_ OrtValue** output)NO_EXCEPTION;
+
+  /*
+  * Same as Run, but returns once the run is scheduled on the intra-op thread pool of the session, which must have
+  * more than 1 thread. callback is called with user_data when the run is done, unless an error is returned. The
+  * output array and run_options must stay valid until then. The session waits for its pending runs when it's
+  * released, so it must not be released by the callback.
+  */
+  OrtStatus*(ORT_API_CALL* RunAsync)(_Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                                     _In_ const char* const* input_names, _In_ const OrtValue* const* input,
+                                     size_t input_len, _In_ const char* const* output_names, size_t output_names_len,
+                                     _Inout_ OrtValue** output, _In_ RunAsyncCallbackFn callback,
+                                     _In_opt_ void* user_data)NO_EXCEPTION;
+
+  /*
+  * Get the usage of the arena allocators of the session, summed over its execution providers: the bytes in use by
+  * tensors, the bytes the arenas hold from the devices, the peak of the bytes in use and the number of allocations.
+  * Arenas which don't track their usage count as empty. Any of the outputs may be null.
+  */
+  OrtStatus*(ORT_API_CALL* SessionGetMemoryArenaStats)(_In_ const OrtSession* sess, _Out_opt_ int64_t* bytes_in_use,
+                                                       _Out_opt_ int64_t* total_allocated_bytes,
+                                                       _Out_opt_ int64_t* max_bytes_in_use,
+                                                       _Out_opt_ int64_t* num_allocs)NO_EXCEPTION;
+
+  /*
+  * Cache the outputs of the Run calls of the sessions, up to max_bytes, and return copies of them when a session is
+  * run again with the same inputs instead of running the graph. Only used for graphs without random or custom ops,
+  * and for runs on CPU tensors which don't pre-allocate their outputs. A max_bytes of 0 disables the cache.
+  */
+  OrtStatus*(ORT_API_CALL* EnableRunResultCache)(_Inout_ OrtSessionOptions* options, size_t max_bytes)NO_EXCEPTION;
+
+  /*
+  * Get the statistics of the run result cache of the session: the runs found in the cache and the ones that weren't,
+  * the number of cached runs and the bytes they hold. All 0 if the session doesn't cache its runs.
+  * Any of the outputs may be null.
+  */
+  OrtStatus*(ORT_API_CALL* SessionGetRunResultCacheStats)(_In_ const OrtSession* sess, _Out_opt_ int64_t* hits,
+                                                          _Out_opt_ int64_t* misses, _Out_opt_ int64_t* num_entries,
+                                                          _Out_opt_ int64_t* bytes)NO_EXCEPTION;
+
+  /*
+  * Run the session twice with zero-filled inputs and discard the outputs, so that the kernels, the memory patterns and
+  * the arenas are initialized before the first real run. Call it once per representative set of input shapes.
+  * input_shapes[i] holds the input_shape_lengths[i] dimensions of the input input_names[i]. The inputs which aren't
+  * listed use the shapes of the model, which must not have free dimensions.
+  */
+  OrtStatus*(ORT_API_CALL* SessionWarmUp)(_Inout_ OrtSession* sess,
+                                          _In_reads_(input_count) const char* const* input_names,
+                                          _In_reads_(input_count) const int64_t* const* input_shapes,
+                                          _In_reads_(input_count) const size_t* input_shape_lengths,
+                                          size_t input_count)NO_EXCEPTION;
+
+  /*
+  * Keep the constant initializers in CPU memory in the env and share them between the sessions with this option:
+  * the sessions loading initializers with the same type, shape and content, e.g. the same model with different
+  * execution providers or thread settings, hold a single read-only copy of each. Combine with
+  * EnableEnvPrePackedWeights to share the packed weights too.
+  */
+  OrtStatus*(ORT_API_CALL* EnableEnvSharedInitializers)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /*
+  * Collect the memory and time statistics of the Run calls using these run options, see RunOptionsGetRunStats.
+  * The run options must not be used by concurrent Run calls while the statistics are collected.
+  */
+  OrtStatus*(ORT_API_CALL* RunOptionsSetCollectRunStats)(_Inout_ OrtRunOptions* options, int value)NO_EXCEPTION;
+
+  /*
+  * Get the statistics of the last Run call which used these run options with RunOptionsSetCollectRunStats enabled:
+  * the buffers allocated for the intermediate values and the outputs of the main graph and their bytes, the peak of
+  * the bytes held at the same time, the bytes of the inputs and outputs copied between devices, the microseconds spent
+  * executing the nodes and copying the values, and whether a cached memory pattern placed all the intermediate values
+  * (1) or not (0). All 0 before such a run. Any of the outputs may be null.
+  */
+  OrtStatus*(ORT_API_CALL* RunOptionsGetRunStats)(_In_ const OrtRunOptions* options,
+                                                  _Out_opt_ int64_t* num_allocations,
+                                                  _Out_opt_ int64_t* bytes_allocated, _Out_opt_ int64_t* peak_bytes,
+                                                  _Out_opt_ int64_t* bytes_copied,
+                                                  _Out_opt_ int64_t* execution_time_us,
+                                                  _Out_opt_ int64_t* copy_time_us,
+                                                  _Out_opt_ int64_t* memory_pattern_hit)NO_EXCEPTION;
+
+  /*
+  * Get the statistics of RunOptionsGetRunStats summed over the successful Run calls of the session, whether they
+  * collected their own statistics or not: the peak is the maximum over the runs and memory_pattern_hits counts the
+  * runs which hit. The runs answered by the run result cache aren't included. Any of the outputs may be null.
+  */
+  OrtStatus*(ORT_API_CALL* SessionGetCumulativeRunStats)(_In_ const OrtSession* sess, _Out_opt_ int64_t* num_runs,
+                                                         _Out_opt_ int64_t* num_allocations,
+                                                         _Out_opt_ int64_t* bytes_allocated,
+                                                         _Out_opt_ int64_t* peak_bytes,
+                                                         _Out_opt_ int64_t* bytes_copied,
+                                                         _Out_opt_ int64_t* execution_time_us,
+                                                         _Out_opt_ int64_t* copy_time_us,
+                                                         _Out_opt_ int64_t* memory_pattern_hits)NO_EXCEPTION;
+
+  /*
+  * Count the kernel calls of each node of the session and its subgraphs, see SessionGetOpStats.
+  */
+  OrtStatus*(ORT_API_CALL* EnableOpStats)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /*
+  * Get the number of entries of SessionGetOpStats: the nodes of the session and its subgraphs, or their op types if
+  * by_op_type is not 0. It doesn't change once the session is initialized. 0 if EnableOpStats wasn't called.
+  */
+  OrtStatus*(ORT_API_CALL* SessionGetOpStatsCount)(_In_ const OrtSession* sess, int by_op_type,
+                                                   _Out_ size_t* count)NO_EXCEPTION;
+
+  /*
+  * Get the counters summed over the kernel calls of a node, or of all the nodes of an op type if by_op_type is not
+  * 0, since the session was created: the number of calls, their total, minimum, maximum and 99th percentile time
+  * (rounded up to a power of two) in microseconds, the bytes of their input and output tensors, and the operations
+  * estimated from the shapes by the CPU kernels of Conv, Gemm, MatMul, Add, Sub, Mul, Div, the reductions and
+  * Attention (0 for the others). The nodes come in a fixed order and include the ones which didn't run yet. name is the name of the node or the op type, and is
+  * allocated with allocator like op_type. Any of the other outputs may be null.
+  */
+  OrtStatus*(ORT_API_CALL* SessionGetOpStats)(_In_ const OrtSession* sess, int by_op_type, size_t index,
+                                              _Inout_ OrtAllocator* allocator, _Outptr_ char** name,
+                                              _Outptr_opt_ char** op_type, _Out_opt_ int64_t* num_calls,
+                                              _Out_opt_ int64_t* total_time_us, _Out_opt_ int64_t* min_time_us,
+                                              _Out_opt_ int64_t* max_time_us, _Out_opt_ int64_t* p99_time_us,
+                                              _Out_opt_ int64_t* bytes_read, _Out_opt_ int64_t* bytes_written,
+                                              _Out_opt_ int64_t* flops)NO_EXCEPTION;
+
+  /*
+  * Record the allocations and frees of the buffers of the values, with the value, its producer node and the state of
+  * the arena, as a memory timeline in the profile file. Only used if profiling is enabled and isn't sampled.
+  */
+  OrtStatus*(ORT_API_CALL* EnableMemoryProfiling)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /*
+  * Get the utilization of the arena allocators of the session, summed over its execution providers like
+  * SessionGetMemoryArenaStats: the bytes in use by tensors, the bytes the arenas reserved from the devices, the size
+  * of the largest free chunk of the arenas, i.e. the largest allocation they serve without reserving more memory,
+  * and the number of times they reserved more memory. Any of the outputs may be null.
+  */
+  OrtStatus*(ORT_API_CALL* SessionGetMemoryArenaUtilization)(_In_ const OrtSession* sess,
+                                                             _Out_opt_ int64_t* bytes_in_use,
+                                                             _Out_opt_ int64_t* bytes_reserved,
+                                                             _Out_opt_ int64_t* largest_free_chunk,
+                                                             _Out_opt_ int64_t* num_extends)NO_EXCEPTION;
+
+  /*
+  * Get the utilization of the intra-op thread pool of the session, or of its inter-op one if inter_op is not 0, which
+  * is the pool of the env if the session uses the global thread pools: its number of threads, the tasks queued which
+  * no thread started yet, the threads running a task, the tasks completed and the work a thread took from another
+  * one, i.e. the tasks stolen from the queue of another thread and the blocks of the parallel loops run by the pool
+  * rather than the calling thread. The counts are since the pool was created. All 0 if there is no such pool.
+  * It can be called while the session runs. Any of the outputs may be null.
+  */
+  OrtStatus*(ORT_API_CALL* SessionGetThreadPoolStats)(_In_ const OrtSession* sess, int inter_op,
+                                                      _Out_opt_ int* num_threads, _Out_opt_ int64_t* queued_tasks,
+                                                      _Out_opt_ int64_t* active_workers, _Out_opt_ int64_t* num_tasks,
+                                                      _Out_opt_ int64_t* num_steals)NO_EXCEPTION;
+
+  /*
+  * Get the utilization of the global intra-op thread pool of the env, or of its inter-op one if inter_op is not 0,
+  * like SessionGetThreadPoolStats. All 0 if the env wasn't created with global thread pools.
+  */
+  OrtStatus*(ORT_API_CALL* GetEnvThreadPoolStats)(_In_ const OrtEnv* env, int inter_op, _Out_opt_ int* num_threads,
+                                                  _Out_opt_ int64_t* queued_tasks, _Out_opt_ int64_t* active_workers,
+                                                  _Out_opt_ int64_t* num_tasks,
+                                                  _Out_opt_ int64_t* num_steals)NO_EXCEPTION;
+
+  /*
+  * Let the graph partitioning leave on the CPU the groups of connected nodes an execution provider on another device
+  * claims, e.g. CUDA, when they are estimated to run faster on the CPU once the copies to and from the device are
+  * counted. The estimates use the shapes inferred for the graph, the operations per second of the CPU and of the
+  * device in billions and the bandwidth of the copies in GB per second. A value of 0 keeps the default one.
+  */
+  OrtStatus*(ORT_API_CALL* EnableCostBasedPartitioning)(_Inout_ OrtSessionOptions* options, double host_gflops,
+                                                        double device_gflops, double copy_gbps)NO_EXCEPTION;
+
+  /*
+  * Get the intra-op thread pool the kernel of a custom op runs on, the one of its session or of the env, to split
+  * its work like the built-in kernels. out is null if the session has no intra-op thread pool, which
+  * ThreadPool_ParallelFor and ThreadPool_GetDegreeOfParallelism accept.
+  */
+  OrtStatus*(ORT_API_CALL* KernelContext_GetThreadPool)(_In_ const OrtKernelContext* context,
+                                                        _Outptr_result_maybenull_ OrtThreadPool** out)NO_EXCEPTION;
+
+  /*
+  * Get the number of threads running the calls of ThreadPool_ParallelFor on pool, the calling thread included.
+  * 1 if pool is null.
+  */
+  OrtStatus*(ORT_API_CALL* ThreadPool_GetDegreeOfParallelism)(_In_opt_ const OrtThreadPool* pool,
+                                                              _Out_ int* out)NO_EXCEPTION;
+
+  /*
+  * Call fn(user_data, index) for each index in [0, total) on the threads of pool and the calling thread, and return
+  * once all the calls completed. The calls run on the calling thread if pool is null. fn must not throw.
+  */
+  OrtStatus*(ORT_API_CALL* ThreadPool_ParallelFor)(_In_opt_ OrtThreadPool* pool, size_t total,
+                                                   _In_ void(ORT_API_CALL* fn)(void* user_data, size_t index),
+                                                   _In_opt_ void* user_data)NO_EXCEPTION;
+
+  /*
+  * Allocate a scratch buffer of size bytes for the kernel of a custom op, from the allocator of its execution
+  * provider, i.e. the arena of the session when it is enabled. It must be freed with KernelContext_Free, with the
+  * context of a call of the same kernel, usually before the kernel returns.
+  */
+  OrtStatus*(ORT_API_CALL* KernelContext_Allocate)(_In_ const OrtKernelContext* context, size_t size,
+                                                   _Outptr_ void** out)NO_EXCEPTION;
+
+  OrtStatus*(ORT_API_CALL* KernelContext_Free)(_In_ const OrtKernelContext* context, _In_opt_ void* p)NO_EXCEPTION;
+
+  /*
+  * Parse a model loaded from a file without the raw data of its large initializers, which stays in the file until
+  * the session creates the initializers, mapping them into memory where their alignment allows it. Loading a model
+  * then peaks at about its size in memory. The model file must stay unchanged while the session lives.
+  */
+  OrtStatus*(ORT_API_CALL* EnableLazyInitializerLoading)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /*
+  * Run the float nodes placed on the CUDA execution provider in float16 where it has a float16 kernel for them,
+  * inserting Casts where they meet the other nodes, so the inputs and outputs of the model keep their types.
+  * allow_ops and deny_ops are comma separated op types: only the nodes whose op is allowed and not denied are
+  * converted. NULL stands for the default lists, which keep Softmax, the normalizations and the reductions in float.
+  */
+  OrtStatus*(ORT_API_CALL* EnableCudaMixedPrecision)(_Inout_ OrtSessionOptions* options, _In_opt_ const char* allow_ops,
+                                                     _In_opt_ const char* deny_ops)NO_EXCEPTION;
+
+  /*
+  * Set the priority of the OrtRun calls using these run options among the ones of the sessions using the global
+  * thread pools of the env. Between two nodes, a call waits while a call of a higher priority is in progress. 0 by
+  * default.
+  */
+  OrtStatus*(ORT_API_CALL* RunOptionsSetPriority)(_Inout_ OrtRunOptions* options, int priority)NO_EXCEPTION;
+
+  /*
+  * Abandon the OrtRun calls using these run options which are still running timeout_ms milliseconds after this
+  * call, as if RunOptionsSetTerminate had been called. A negative timeout_ms removes the deadline.
+  */
+  OrtStatus*(ORT_API_CALL* RunOptionsSetDeadline)(_Inout_ OrtRunOptions* options, int64_t timeout_ms)NO_EXCEPTION;
 };
 
 /*
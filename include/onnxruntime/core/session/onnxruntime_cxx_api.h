@@ -71,6 +71,8 @@ ORT_DEFINE_RELEASE(TensorTypeAndShapeInfo);
 ORT_DEFINE_RELEASE(TypeInfo);
 ORT_DEFINE_RELEASE(Value);
 ORT_DEFINE_RELEASE(ModelMetadata);
+ORT_DEFINE_RELEASE(IoBinding);
+ORT_DEFINE_RELEASE(PreparedRun);
 
 // This is used internally by the C++ API. This is the common base class used by the wrapper objects.
 template <typename T>
@@ -119,6 +121,17 @@ struct Env;
 struct TypeInfo;
 struct Value;
 struct ModelMetadata;
+struct IoBinding;
+struct PreparedRun;
+
+// Utilization of a thread pool, see OrtApi::SessionGetThreadPoolStats
+struct ThreadPoolStats {
+  int num_threads{};
+  int64_t queued_tasks{};
+  int64_t active_workers{};
+  int64_t num_tasks{};
+  int64_t num_steals{};
+};
 
 struct Env : Base<OrtEnv> {
   Env(std::nullptr_t) {}
@@ -130,6 +143,12 @@ struct Env : Base<OrtEnv> {
   Env& EnableTelemetryEvents();
   Env& DisableTelemetryEvents();
 
+  // create an allocator that sessions created with SessionOptions::EnableEnvAllocators share
+  Env& CreateAndRegisterAllocator(const OrtMemoryInfo* mem_info);
+
+  // the global thread pools, see OrtApi::GetEnvThreadPoolStats
+  ThreadPoolStats GetThreadPoolStats(bool inter_op) const;
+
   static const OrtApi* s_api;
 };
 
@@ -140,6 +159,32 @@ struct CustomOpDomain : Base<OrtCustomOpDomain> {
   void Add(OrtCustomOp* op);
 };
 
+// Memory and time statistics of Run calls, see OrtApi::RunOptionsGetRunStats and OrtApi::SessionGetCumulativeRunStats
+struct RunStats {
+  int64_t num_runs{};  // only set by Session::GetCumulativeRunStats
+  int64_t num_allocations{};
+  int64_t bytes_allocated{};
+  int64_t peak_bytes{};
+  int64_t bytes_copied{};
+  int64_t execution_time_us{};
+  int64_t copy_time_us{};
+  int64_t memory_pattern_hits{};
+};
+
+// Counters of the kernel calls of a node or an op type, see OrtApi::SessionGetOpStats
+struct OpStats {
+  std::string name;
+  std::string op_type;
+  int64_t num_calls{};
+  int64_t total_time_us{};
+  int64_t min_time_us{};
+  int64_t max_time_us{};
+  int64_t p99_time_us{};
+  int64_t bytes_read{};
+  int64_t bytes_written{};
+  int64_t flops{};
+};
+
 struct RunOptions : Base<OrtRunOptions> {
   RunOptions(std::nullptr_t) {}
   RunOptions();
@@ -157,6 +202,24 @@ struct RunOptions : Base<OrtRunOptions> {
   RunOptions& SetTerminate();
   // unset the terminate flag so this RunOptions instance can be used in a new Session::Run call
   RunOptions& UnsetTerminate();
+
+  // release the entirely free regions of the session's memory arenas once the Run call completes
+  RunOptions& SetShrinkMemoryArenas(bool value);
+
+  // order the device work of the Run calls with a caller owned stream, e.g. a cudaStream_t
+  RunOptions& SetComputeStream(void* stream);
+
+  // run with the state of a stream of Run calls (see SessionOptions::AddStateBinding). -1 runs without state
+  RunOptions& SetStateStreamId(int64_t stream_id);
+
+  // collect the statistics of the Run calls, which GetRunStats returns for the last of them
+  RunOptions& SetCollectRunStats(bool value);
+  RunStats GetRunStats() const;
+
+  // order the Run calls with the ones of the other sessions using the global thread pools of the env
+  RunOptions& SetPriority(int priority);
+  // abandon the Run calls still running timeout_ms milliseconds from now. -1 removes the deadline
+  RunOptions& SetDeadline(int64_t timeout_ms);
 };
 
 struct SessionOptions : Base<OrtSessionOptions> {
@@ -188,6 +251,30 @@ struct SessionOptions : Base<OrtSessionOptions> {
   SessionOptions& Add(OrtCustomOpDomain* custom_op_domain);
 
   SessionOptions& DisablePerSessionThreads();
+
+  SessionOptions& EnableEnvAllocators();
+
+  SessionOptions& EnableMemPatternBucketing(const std::vector<int64_t>& bucket_boundaries = {});
+
+  SessionOptions& SetThreadPoolSpinning(unsigned int spin_duration_us, bool allow_worker_spinning = true);
+  SessionOptions& SetIntraOpThreadAffinity(const std::vector<size_t>& logical_processors);
+  SessionOptions& SetInterOpThreadAffinity(const std::vector<size_t>& logical_processors);
+  SessionOptions& SetThreadPoolNumaNode(int numa_node);
+  SessionOptions& SetSessionStateCacheFilePath(const ORTCHAR_T* cache_file_path);
+  SessionOptions& DisablePrePacking();
+  SessionOptions& EnableEnvPrePackedWeights();
+  SessionOptions& EnableEnvSharedInitializers();
+  SessionOptions& EnableOpStats();
+  SessionOptions& EnableMemoryProfiling();
+  SessionOptions& EnableCpuTuning(const ORTCHAR_T* cache_file_path = nullptr);
+  SessionOptions& EnableMemoryEfficientExecutionOrder();
+  SessionOptions& AddFreeDimensionOverrideByName(const char* dim_name, int64_t dim_value);
+  SessionOptions& EnableShapeSpecialization(int max_variants, int min_runs = 10);
+  SessionOptions& AddStateBinding(const char* output_name, const char* input_name);
+  SessionOptions& EnableRunResultCache(size_t max_bytes);
+  SessionOptions& EnableCostBasedPartitioning(double host_gflops = 0, double device_gflops = 0, double copy_gbps = 0);
+  SessionOptions& EnableLazyInitializerLoading();
+  SessionOptions& EnableCudaMixedPrecision(const char* allow_ops = nullptr, const char* deny_ops = nullptr);
 };
 
 struct ModelMetadata : Base<OrtModelMetadata> {
@@ -202,6 +289,25 @@ struct ModelMetadata : Base<OrtModelMetadata> {
   int64_t GetVersion() const;
 };
 
+// Usage of the arena allocators of a session, see OrtApi::SessionGetMemoryArenaStats and
+// OrtApi::SessionGetMemoryArenaUtilization
+struct MemoryArenaStats {
+  int64_t bytes_in_use{};
+  int64_t total_allocated_bytes{};
+  int64_t max_bytes_in_use{};
+  int64_t num_allocs{};
+  int64_t largest_free_chunk{};
+  int64_t num_extends{};
+};
+
+// Statistics of the run result cache of a session, see OrtApi::SessionGetRunResultCacheStats
+struct RunResultCacheStats {
+  int64_t hits{};
+  int64_t misses{};
+  int64_t num_entries{};
+  int64_t bytes{};
+};
+
 struct Session : Base<OrtSession> {
   explicit Session(std::nullptr_t) {}
   Session(Env& env, const ORTCHAR_T* model_path, const SessionOptions& options);
@@ -213,6 +319,11 @@ struct Session : Base<OrtSession> {
   // Run for when there is a list of prealloated outputs
   void Run(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
            const char* const* output_names, Value* output_values, size_t output_count);
+  // Run that returns once it's scheduled, and calls callback with user_data when it's done. output_values must stay
+  // valid until then
+  void RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                size_t input_count, const char* const* output_names, Value* output_values, size_t output_count,
+                RunAsyncCallbackFn callback, void* user_data);
 
   size_t GetInputCount() const;
   size_t GetOutputCount() const;
@@ -223,6 +334,21 @@ struct Session : Base<OrtSession> {
   char* GetOverridableInitializerName(size_t index, OrtAllocator* allocator) const;
   char* EndProfiling(OrtAllocator* allocator) const;
   ModelMetadata GetModelMetadata() const;
+  MemoryArenaStats GetMemoryArenaStats() const;
+  ThreadPoolStats GetThreadPoolStats(bool inter_op) const;
+  RunResultCacheStats GetRunResultCacheStats() const;
+  RunStats GetCumulativeRunStats() const;
+  std::vector<OpStats> GetOpStats(bool by_op_type, OrtAllocator* allocator) const;
+  void ReleaseStateStream(int64_t stream_id);
+  // Run twice with zero-filled inputs of the given shapes, see OrtApi::SessionWarmUp
+  void WarmUp(const char* const* input_names, const int64_t* const* input_shapes, const size_t* input_shape_lengths,
+              size_t input_count);
+  // Run with the inputs and outputs bound to binding
+  void Run(const RunOptions& run_options, IoBinding& binding);
+  // Run with the input and output names of prepared_run, taking the values in the order of the names
+  std::vector<Value> Run(const RunOptions& run_options, const PreparedRun& prepared_run, const Value* input_values);
+  void Run(const RunOptions& run_options, const PreparedRun& prepared_run, const Value* input_values,
+           Value* output_values);
 
   TypeInfo GetInputTypeInfo(size_t index) const;
   TypeInfo GetOutputTypeInfo(size_t index) const;
@@ -312,6 +438,30 @@ struct MemoryInfo : Base<OrtMemoryInfo> {
   explicit MemoryInfo(OrtMemoryInfo* p) : Base<OrtMemoryInfo>{p} {}
 };
 
+struct IoBinding : Base<OrtIoBinding> {
+  explicit IoBinding(std::nullptr_t) {}
+  explicit IoBinding(Session& session);
+
+  void BindInput(const char* name, const Value& value);
+  void BindOutput(const char* name, const Value& value);
+  void BindOutput(const char* name, const MemoryInfo& mem_info);
+  std::vector<std::string> GetOutputNames() const;
+  std::vector<Value> GetOutputValues() const;
+  void ClearBoundInputs();
+  void ClearBoundOutputs();
+};
+
+struct PreparedRun : Base<OrtPreparedRun> {
+  explicit PreparedRun(std::nullptr_t) {}
+  PreparedRun(Session& session, const char* const* input_names, size_t input_count,
+              const char* const* output_names, size_t output_count);
+
+  size_t GetOutputCount() const { return output_count_; }
+
+ private:
+  size_t output_count_{};
+};
+
 //
 // Custom OPs (only needed to implement custom OPs)
 //
@@ -341,6 +491,14 @@ struct CustomOpApi {
   size_t KernelContext_GetOutputCount(const OrtKernelContext* context);
   OrtValue* KernelContext_GetOutput(OrtKernelContext* context, _In_ size_t index, _In_ const int64_t* dim_values, size_t dim_count);
 
+  OrtThreadPool* KernelContext_GetThreadPool(const OrtKernelContext* context);
+  int ThreadPool_GetDegreeOfParallelism(const OrtThreadPool* pool);
+  // fn(size_t index) is called for each index in [0, total), it must not throw
+  template <typename F>
+  void ThreadPool_ParallelFor(OrtThreadPool* pool, size_t total, F&& fn);
+  void* KernelContext_Allocate(const OrtKernelContext* context, size_t size);
+  void KernelContext_Free(const OrtKernelContext* context, void* p);
+
   void ThrowOnError(OrtStatus* result);
 
  private:
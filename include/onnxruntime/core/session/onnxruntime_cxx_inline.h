@@ -98,6 +98,18 @@ inline Env& Env::DisableTelemetryEvents() {
   return *this;
 }
 
+inline Env& Env::CreateAndRegisterAllocator(const OrtMemoryInfo* mem_info) {
+  ThrowOnError(Global<void>::api_.CreateAndRegisterAllocator(p_, mem_info));
+  return *this;
+}
+
+inline ThreadPoolStats Env::GetThreadPoolStats(bool inter_op) const {
+  ThreadPoolStats stats;
+  ThrowOnError(Global<void>::api_.GetEnvThreadPoolStats(p_, inter_op, &stats.num_threads, &stats.queued_tasks,
+                                                        &stats.active_workers, &stats.num_tasks, &stats.num_steals));
+  return stats;
+}
+
 inline CustomOpDomain::CustomOpDomain(const char* domain) {
   ThrowOnError(Global<void>::api_.CreateCustomOpDomain(domain, &p_));
 }
@@ -147,6 +159,45 @@ inline RunOptions& RunOptions::UnsetTerminate() {
   return *this;
 }
 
+inline RunOptions& RunOptions::SetShrinkMemoryArenas(bool value) {
+  ThrowOnError(Global<void>::api_.RunOptionsSetShrinkMemoryArenas(p_, value ? 1 : 0));
+  return *this;
+}
+
+inline RunOptions& RunOptions::SetComputeStream(void* stream) {
+  ThrowOnError(Global<void>::api_.RunOptionsSetComputeStream(p_, stream));
+  return *this;
+}
+
+inline RunOptions& RunOptions::SetStateStreamId(int64_t stream_id) {
+  ThrowOnError(Global<void>::api_.RunOptionsSetStateStreamId(p_, stream_id));
+  return *this;
+}
+
+inline RunOptions& RunOptions::SetCollectRunStats(bool value) {
+  ThrowOnError(Global<void>::api_.RunOptionsSetCollectRunStats(p_, value ? 1 : 0));
+  return *this;
+}
+
+inline RunStats RunOptions::GetRunStats() const {
+  RunStats stats;
+  ThrowOnError(Global<void>::api_.RunOptionsGetRunStats(p_, &stats.num_allocations, &stats.bytes_allocated,
+                                                        &stats.peak_bytes, &stats.bytes_copied,
+                                                        &stats.execution_time_us, &stats.copy_time_us,
+                                                        &stats.memory_pattern_hits));
+  return stats;
+}
+
+inline RunOptions& RunOptions::SetPriority(int priority) {
+  ThrowOnError(Global<void>::api_.RunOptionsSetPriority(p_, priority));
+  return *this;
+}
+
+inline RunOptions& RunOptions::SetDeadline(int64_t timeout_ms) {
+  ThrowOnError(Global<void>::api_.RunOptionsSetDeadline(p_, timeout_ms));
+  return *this;
+}
+
 inline SessionOptions::SessionOptions() {
   ThrowOnError(Global<void>::api_.CreateSessionOptions(&p_));
 }
@@ -246,6 +297,69 @@ inline void Session::Run(const RunOptions& run_options, const char* const* input
   ThrowOnError(Global<void>::api_.Run(p_, run_options, input_names, ort_input_values, input_count, output_names, output_count, ort_output_values));
 }
 
+inline void Session::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                              size_t input_count, const char* const* output_names, Value* output_values,
+                              size_t output_count, RunAsyncCallbackFn callback, void* user_data) {
+  static_assert(sizeof(Value) == sizeof(OrtValue*), "Value is really just an array of OrtValue* in memory, so we can reinterpret_cast safely");
+  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Value*>(input_values));
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(Global<void>::api_.RunAsync(p_, run_options, input_names, ort_input_values, input_count, output_names,
+                                           output_count, ort_output_values, callback, user_data));
+}
+
+inline MemoryArenaStats Session::GetMemoryArenaStats() const {
+  MemoryArenaStats stats;
+  ThrowOnError(Global<void>::api_.SessionGetMemoryArenaStats(p_, &stats.bytes_in_use, &stats.total_allocated_bytes,
+                                                             &stats.max_bytes_in_use, &stats.num_allocs));
+  ThrowOnError(Global<void>::api_.SessionGetMemoryArenaUtilization(p_, nullptr, nullptr, &stats.largest_free_chunk,
+                                                                   &stats.num_extends));
+  return stats;
+}
+
+inline ThreadPoolStats Session::GetThreadPoolStats(bool inter_op) const {
+  ThreadPoolStats stats;
+  ThrowOnError(Global<void>::api_.SessionGetThreadPoolStats(p_, inter_op, &stats.num_threads, &stats.queued_tasks,
+                                                            &stats.active_workers, &stats.num_tasks,
+                                                            &stats.num_steals));
+  return stats;
+}
+
+inline RunResultCacheStats Session::GetRunResultCacheStats() const {
+  RunResultCacheStats stats;
+  ThrowOnError(Global<void>::api_.SessionGetRunResultCacheStats(p_, &stats.hits, &stats.misses, &stats.num_entries,
+                                                                &stats.bytes));
+  return stats;
+}
+
+inline RunStats Session::GetCumulativeRunStats() const {
+  RunStats stats;
+  ThrowOnError(Global<void>::api_.SessionGetCumulativeRunStats(p_, &stats.num_runs, &stats.num_allocations,
+                                                               &stats.bytes_allocated, &stats.peak_bytes,
+                                                               &stats.bytes_copied, &stats.execution_time_us,
+                                                               &stats.copy_time_us, &stats.memory_pattern_hits));
+  return stats;
+}
+
+inline std::vector<OpStats> Session::GetOpStats(bool by_op_type, OrtAllocator* allocator) const {
+  size_t count;
+  ThrowOnError(Global<void>::api_.SessionGetOpStatsCount(p_, by_op_type, &count));
+  std::vector<OpStats> all_stats(count);
+  for (size_t i = 0; i < count; ++i) {
+    OpStats& stats = all_stats[i];
+    char* name;
+    char* op_type;
+    ThrowOnError(Global<void>::api_.SessionGetOpStats(p_, by_op_type, i, allocator, &name, &op_type, &stats.num_calls,
+                                                      &stats.total_time_us, &stats.min_time_us, &stats.max_time_us,
+                                                      &stats.p99_time_us, &stats.bytes_read, &stats.bytes_written,
+                                                      &stats.flops));
+    stats.name = name;
+    stats.op_type = op_type;
+    allocator->Free(allocator, name);
+    allocator->Free(allocator, op_type);
+  }
+  return all_stats;
+}
+
 inline size_t Session::GetInputCount() const {
   size_t out;
   ThrowOnError(Global<void>::api_.SessionGetInputCount(p_, &out));
@@ -288,6 +402,100 @@ inline char* Session::EndProfiling(OrtAllocator* allocator) const {
   return out;
 }
 
+inline void Session::ReleaseStateStream(int64_t stream_id) {
+  ThrowOnError(Global<void>::api_.ReleaseStateStream(p_, stream_id));
+}
+
+inline void Session::WarmUp(const char* const* input_names, const int64_t* const* input_shapes,
+                            const size_t* input_shape_lengths, size_t input_count) {
+  ThrowOnError(Global<void>::api_.SessionWarmUp(p_, input_names, input_shapes, input_shape_lengths, input_count));
+}
+
+inline void Session::Run(const RunOptions& run_options, IoBinding& binding) {
+  ThrowOnError(Global<void>::api_.RunWithBinding(p_, run_options, binding));
+}
+
+inline IoBinding::IoBinding(Session& session) {
+  ThrowOnError(Global<void>::api_.CreateIoBinding(session, &p_));
+}
+
+inline void IoBinding::BindInput(const char* name, const Value& value) {
+  ThrowOnError(Global<void>::api_.BindInput(p_, name, value));
+}
+
+inline void IoBinding::BindOutput(const char* name, const Value& value) {
+  ThrowOnError(Global<void>::api_.BindOutput(p_, name, value));
+}
+
+inline void IoBinding::BindOutput(const char* name, const MemoryInfo& mem_info) {
+  ThrowOnError(Global<void>::api_.BindOutputToDevice(p_, name, mem_info));
+}
+
+inline std::vector<std::string> IoBinding::GetOutputNames() const {
+  AllocatorWithDefaultOptions allocator;
+  char** names;
+  size_t count;
+  ThrowOnError(Global<void>::api_.GetBoundOutputNames(p_, allocator, &names, &count));
+
+  std::vector<std::string> result;
+  for (size_t i = 0; i < count; ++i) {
+    result.emplace_back(names[i]);
+    allocator.Free(names[i]);
+  }
+  if (names != nullptr) {
+    allocator.Free(names);
+  }
+  return result;
+}
+
+inline std::vector<Value> IoBinding::GetOutputValues() const {
+  AllocatorWithDefaultOptions allocator;
+  OrtValue** values;
+  size_t count;
+  ThrowOnError(Global<void>::api_.GetBoundOutputValues(p_, allocator, &values, &count));
+
+  std::vector<Value> result;
+  for (size_t i = 0; i < count; ++i) {
+    result.emplace_back(values[i]);
+  }
+  if (values != nullptr) {
+    allocator.Free(values);
+  }
+  return result;
+}
+
+inline void IoBinding::ClearBoundInputs() {
+  Global<void>::api_.ClearBoundInputs(p_);
+}
+
+inline void IoBinding::ClearBoundOutputs() {
+  Global<void>::api_.ClearBoundOutputs(p_);
+}
+
+inline std::vector<Value> Session::Run(const RunOptions& run_options, const PreparedRun& prepared_run,
+                                       const Value* input_values) {
+  std::vector<Ort::Value> output_values;
+  for (size_t i = 0; i < prepared_run.GetOutputCount(); i++)
+    output_values.emplace_back(nullptr);
+  Run(run_options, prepared_run, input_values, output_values.data());
+  return output_values;
+}
+
+inline void Session::Run(const RunOptions& run_options, const PreparedRun& prepared_run, const Value* input_values,
+                         Value* output_values) {
+  static_assert(sizeof(Value) == sizeof(OrtValue*), "Value is really just an array of OrtValue* in memory, so we can reinterpret_cast safely");
+  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Value*>(input_values));
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(Global<void>::api_.RunPrepared(p_, run_options, prepared_run, ort_input_values, ort_output_values));
+}
+
+inline PreparedRun::PreparedRun(Session& session, const char* const* input_names, size_t input_count,
+                                const char* const* output_names, size_t output_count)
+    : output_count_{output_count} {
+  ThrowOnError(Global<void>::api_.CreatePreparedRun(session, input_names, input_count, output_names, output_count,
+                                                     &p_));
+}
+
 inline ModelMetadata Session::GetModelMetadata() const {
   OrtModelMetadata* out;
   ThrowOnError(Global<void>::api_.SessionGetModelMetadata(p_, &out));
@@ -605,8 +813,145 @@ inline OrtValue* CustomOpApi::KernelContext_GetOutput(OrtKernelContext* context,
   return out;
 }
 
+inline OrtThreadPool* CustomOpApi::KernelContext_GetThreadPool(const OrtKernelContext* context) {
+  OrtThreadPool* out;
+  ThrowOnError(api_.KernelContext_GetThreadPool(context, &out));
+  return out;
+}
+
+inline int CustomOpApi::ThreadPool_GetDegreeOfParallelism(const OrtThreadPool* pool) {
+  int out;
+  ThrowOnError(api_.ThreadPool_GetDegreeOfParallelism(pool, &out));
+  return out;
+}
+
+template <typename F>
+inline void CustomOpApi::ThreadPool_ParallelFor(OrtThreadPool* pool, size_t total, F&& fn) {
+  using FnType = typename std::remove_reference<F>::type;
+  ThrowOnError(api_.ThreadPool_ParallelFor(
+      pool, total, [](void* user_data, size_t index) { (*static_cast<FnType*>(user_data))(index); },
+      const_cast<void*>(static_cast<const void*>(&fn))));
+}
+
+inline void* CustomOpApi::KernelContext_Allocate(const OrtKernelContext* context, size_t size) {
+  void* out;
+  ThrowOnError(api_.KernelContext_Allocate(context, size, &out));
+  return out;
+}
+
+inline void CustomOpApi::KernelContext_Free(const OrtKernelContext* context, void* p) {
+  ThrowOnError(api_.KernelContext_Free(context, p));
+}
+
 inline SessionOptions& SessionOptions::DisablePerSessionThreads() {
   ThrowOnError(Global<void>::api_.DisablePerSessionThreads(p_));
   return *this;
 }
+
+inline SessionOptions& SessionOptions::EnableEnvAllocators() {
+  ThrowOnError(Global<void>::api_.EnableEnvAllocators(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableMemPatternBucketing(const std::vector<int64_t>& bucket_boundaries) {
+  ThrowOnError(Global<void>::api_.EnableMemPatternBucketing(p_, bucket_boundaries.data(), bucket_boundaries.size()));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::SetThreadPoolSpinning(unsigned int spin_duration_us, bool allow_worker_spinning) {
+  ThrowOnError(Global<void>::api_.SetThreadPoolSpinning(p_, spin_duration_us, allow_worker_spinning ? 1 : 0));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::SetIntraOpThreadAffinity(const std::vector<size_t>& logical_processors) {
+  ThrowOnError(Global<void>::api_.SetIntraOpThreadAffinity(p_, logical_processors.data(), logical_processors.size()));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::SetInterOpThreadAffinity(const std::vector<size_t>& logical_processors) {
+  ThrowOnError(Global<void>::api_.SetInterOpThreadAffinity(p_, logical_processors.data(), logical_processors.size()));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::SetThreadPoolNumaNode(int numa_node) {
+  ThrowOnError(Global<void>::api_.SetThreadPoolNumaNode(p_, numa_node));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::SetSessionStateCacheFilePath(const ORTCHAR_T* cache_file_path) {
+  ThrowOnError(Global<void>::api_.SetSessionStateCacheFilePath(p_, cache_file_path));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::DisablePrePacking() {
+  ThrowOnError(Global<void>::api_.DisablePrePacking(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableEnvPrePackedWeights() {
+  ThrowOnError(Global<void>::api_.EnableEnvPrePackedWeights(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableEnvSharedInitializers() {
+  ThrowOnError(Global<void>::api_.EnableEnvSharedInitializers(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableOpStats() {
+  ThrowOnError(Global<void>::api_.EnableOpStats(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableMemoryProfiling() {
+  ThrowOnError(Global<void>::api_.EnableMemoryProfiling(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableCpuTuning(const ORTCHAR_T* cache_file_path) {
+  ThrowOnError(Global<void>::api_.EnableCpuTuning(p_, cache_file_path));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableMemoryEfficientExecutionOrder() {
+  ThrowOnError(Global<void>::api_.EnableMemoryEfficientExecutionOrder(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::AddFreeDimensionOverrideByName(const char* dim_name, int64_t dim_value) {
+  ThrowOnError(Global<void>::api_.AddFreeDimensionOverrideByName(p_, dim_name, dim_value));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableShapeSpecialization(int max_variants, int min_runs) {
+  ThrowOnError(Global<void>::api_.EnableShapeSpecialization(p_, max_variants, min_runs));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::AddStateBinding(const char* output_name, const char* input_name) {
+  ThrowOnError(Global<void>::api_.AddStateBinding(p_, output_name, input_name));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableRunResultCache(size_t max_bytes) {
+  ThrowOnError(Global<void>::api_.EnableRunResultCache(p_, max_bytes));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableCostBasedPartitioning(double host_gflops, double device_gflops,
+                                                                   double copy_gbps) {
+  ThrowOnError(Global<void>::api_.EnableCostBasedPartitioning(p_, host_gflops, device_gflops, copy_gbps));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableLazyInitializerLoading() {
+  ThrowOnError(Global<void>::api_.EnableLazyInitializerLoading(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableCudaMixedPrecision(const char* allow_ops, const char* deny_ops) {
+  ThrowOnError(Global<void>::api_.EnableCudaMixedPrecision(p_, allow_ops, deny_ops));
+  return *this;
+}
+
 }  // namespace Ort
\ No newline at end of file
@@ -244,6 +244,24 @@ public class OnnxTensor implements OnnxValue {
     }
   }
 
+  /**
+   * Returns a direct ByteBuffer view of the memory of the OnnxTensor, in the native platform
+   * endian-ness, without copying it.
+   *
+   * <p>The view is only valid while the OnnxTensor is open, and sees the writes of the runs to an
+   * output tensor, e.g. the outputs of {@link OrtSession#run(OrtSession.IoBinding)} which are
+   * reused by the next run. This method returns null if the OnnxTensor contains Strings.
+   *
+   * @return A ByteBuffer view of the OnnxTensor.
+   */
+  public ByteBuffer getByteBufferView() {
+    if (info.type != OnnxJavaType.STRING) {
+      return getBuffer();
+    } else {
+      return null;
+    }
+  }
+
   /**
    * Wraps the OrtTensor pointer in a direct byte buffer of the native platform endian-ness. Unless
    * you really know what you're doing, you want this one rather than the native call {@link
@@ -14,6 +14,8 @@ import java.util.List;
 import java.util.Map;
 import java.util.Optional;
 import java.util.Set;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
 import java.util.logging.Logger;
 
 /**
@@ -209,41 +211,11 @@ public class OrtSession implements AutoCloseable {
   public Result run(Map<String, OnnxTensor> inputs, Set<String> requestedOutputs)
       throws OrtException {
     if (!closed) {
-      if (inputs.isEmpty() || (inputs.size() > numInputs)) {
-        throw new OrtException(
-            "Unexpected number of inputs, expected [1," + numInputs + ") found " + inputs.size());
-      }
-      if (requestedOutputs.isEmpty() || (requestedOutputs.size() > numOutputs)) {
-        throw new OrtException(
-            "Unexpected number of requestedOutputs, expected [1,"
-                + numOutputs
-                + ") found "
-                + requestedOutputs.size());
-      }
       String[] inputNamesArray = new String[inputs.size()];
       long[] inputHandles = new long[inputs.size()];
-      int i = 0;
-      for (Map.Entry<String, OnnxTensor> t : inputs.entrySet()) {
-        if (inputNames.contains(t.getKey())) {
-          inputNamesArray[i] = t.getKey();
-          inputHandles[i] = t.getValue().getNativeHandle();
-          i++;
-        } else {
-          throw new OrtException(
-              "Unknown input name " + t.getKey() + ", expected one of " + inputNames.toString());
-        }
-      }
       String[] outputNamesArray = new String[requestedOutputs.size()];
-      i = 0;
-      for (String s : requestedOutputs) {
-        if (outputNames.contains(s)) {
-          outputNamesArray[i] = s;
-          i++;
-        } else {
-          throw new OrtException(
-              "Unknown output name " + s + ", expected one of " + outputNames.toString());
-        }
-      }
+      checkInputsAndOutputs(
+          inputs, requestedOutputs, inputNamesArray, inputHandles, outputNamesArray);
       OnnxValue[] outputValues =
           run(
               OnnxRuntime.ortApiHandle,
@@ -260,6 +232,125 @@ public class OrtSession implements AutoCloseable {
     }
   }
 
+  /**
+   * Schedules the scoring of an input feed dict on the intra-op thread pool of the session,
+   * returning a future of the map of all inferred outputs.
+   *
+   * @param inputs The inputs to score, which must stay open until the future is done.
+   * @return The future of the inferred outputs.
+   * @throws OrtException If there was an error in native code, the input names are invalid, or if
+   *     there are zero or too many inputs.
+   * @see #runAsync(Map, Set)
+   */
+  public CompletableFuture<Result> runAsync(Map<String, OnnxTensor> inputs) throws OrtException {
+    return runAsync(inputs, outputNames);
+  }
+
+  /**
+   * Schedules the scoring of an input feed dict on the intra-op thread pool of the session,
+   * returning a future of the map of requested inferred outputs.
+   *
+   * <p>The session must be created with more than 1 intra-op thread. The future completes
+   * exceptionally with an {@link OrtException} if the run fails, and its dependent stages run on
+   * the common fork join pool instead of the threads of the session. Closing the session waits for
+   * its pending runs.
+   *
+   * @param inputs The inputs to score, which must stay open until the future is done.
+   * @param requestedOutputs The requested outputs.
+   * @return The future of the inferred outputs.
+   * @throws OrtException If there was an error in native code, the input or output names are
+   *     invalid, or if there are zero or too many inputs or outputs.
+   */
+  public CompletableFuture<Result> runAsync(
+      Map<String, OnnxTensor> inputs, Set<String> requestedOutputs) throws OrtException {
+    if (!closed) {
+      String[] inputNamesArray = new String[inputs.size()];
+      long[] inputHandles = new long[inputs.size()];
+      String[] outputNamesArray = new String[requestedOutputs.size()];
+      checkInputsAndOutputs(
+          inputs, requestedOutputs, inputNamesArray, inputHandles, outputNamesArray);
+      // the native callback completes this with the handles of the outputs, which are converted
+      // here so the Java classes are loaded by the class loader of the session.
+      CompletableFuture<long[]> outputHandles = new CompletableFuture<>();
+      runAsync(
+          OnnxRuntime.ortApiHandle,
+          nativeHandle,
+          inputNamesArray,
+          inputHandles,
+          inputNamesArray.length,
+          outputNamesArray,
+          outputNamesArray.length,
+          outputHandles);
+      return outputHandles.thenApplyAsync(
+          handles -> {
+            try {
+              return new Result(
+                  outputNamesArray,
+                  convertOutputs(OnnxRuntime.ortApiHandle, allocator.handle, handles));
+            } catch (OrtException e) {
+              throw new CompletionException(e);
+            }
+          });
+    } else {
+      throw new IllegalStateException("Trying to score a closed OrtSession.");
+    }
+  }
+
+  /**
+   * Creates a binding of the inputs and outputs of this session for {@link #run(IoBinding)}.
+   *
+   * @return The binding, which must be closed.
+   * @throws OrtException If there was an error in native code.
+   */
+  public IoBinding createIoBinding() throws OrtException {
+    if (!closed) {
+      return new IoBinding(createIoBinding(OnnxRuntime.ortApiHandle, nativeHandle));
+    } else {
+      throw new IllegalStateException("Trying to bind a closed OrtSession.");
+    }
+  }
+
+  /**
+   * Scores the inputs bound to the binding, writing its bound outputs.
+   *
+   * <p>The returned outputs share their buffers with the binding, which reuses them in the next
+   * run.
+   *
+   * @param binding The inputs and outputs.
+   * @return The bound outputs.
+   * @throws OrtException If there was an error in native code.
+   */
+  public Result run(IoBinding binding) throws OrtException {
+    if (!closed) {
+      OnnxValue[] outputValues =
+          runWithBinding(
+              OnnxRuntime.ortApiHandle, nativeHandle, allocator.handle, binding.nativeHandle);
+      return new Result(binding.outputNames.toArray(new String[0]), outputValues);
+    } else {
+      throw new IllegalStateException("Trying to score a closed OrtSession.");
+    }
+  }
+
+  /**
+   * Scores the inputs bound to the binding, writing its bound outputs in place without returning
+   * them.
+   *
+   * <p>When the inputs and outputs are bound to tensors created from direct {@link
+   * java.nio.ByteBuffer}s, the run reads and writes the buffers of the caller. It then makes no
+   * JNI copies and allocates no Java objects, so a scoring loop reusing the binding produces no
+   * garbage.
+   *
+   * @param binding The inputs and outputs.
+   * @throws OrtException If there was an error in native code.
+   */
+  public void runInPlace(IoBinding binding) throws OrtException {
+    if (!closed) {
+      runWithBindingInPlace(OnnxRuntime.ortApiHandle, nativeHandle, binding.nativeHandle);
+    } else {
+      throw new IllegalStateException("Trying to score a closed OrtSession.");
+    }
+  }
+
   @Override
   public String toString() {
     return "OrtSession(numInputs=" + numInputs + ",numOutputs=" + numOutputs + ")";
@@ -296,6 +387,54 @@ public class OrtSession implements AutoCloseable {
     return output;
   }
 
+  /**
+   * Checks the inputs and requested outputs of a run, filling the arrays of their names and the
+   * handles of the input tensors.
+   *
+   * @throws OrtException If the input or output names are invalid, or if there are zero or too
+   *     many inputs or outputs.
+   */
+  private void checkInputsAndOutputs(
+      Map<String, OnnxTensor> inputs,
+      Set<String> requestedOutputs,
+      String[] inputNamesArray,
+      long[] inputHandles,
+      String[] outputNamesArray)
+      throws OrtException {
+    if (inputs.isEmpty() || (inputs.size() > numInputs)) {
+      throw new OrtException(
+          "Unexpected number of inputs, expected [1," + numInputs + ") found " + inputs.size());
+    }
+    if (requestedOutputs.isEmpty() || (requestedOutputs.size() > numOutputs)) {
+      throw new OrtException(
+          "Unexpected number of requestedOutputs, expected [1,"
+              + numOutputs
+              + ") found "
+              + requestedOutputs.size());
+    }
+    int i = 0;
+    for (Map.Entry<String, OnnxTensor> t : inputs.entrySet()) {
+      if (inputNames.contains(t.getKey())) {
+        inputNamesArray[i] = t.getKey();
+        inputHandles[i] = t.getValue().getNativeHandle();
+        i++;
+      } else {
+        throw new OrtException(
+            "Unknown input name " + t.getKey() + ", expected one of " + inputNames.toString());
+      }
+    }
+    i = 0;
+    for (String s : requestedOutputs) {
+      if (outputNames.contains(s)) {
+        outputNamesArray[i] = s;
+        i++;
+      } else {
+        throw new OrtException(
+            "Unknown output name " + s + ", expected one of " + outputNames.toString());
+      }
+    }
+  }
+
   private native long createSession(
       long apiHandle, long envHandle, String modelPath, long optsHandle) throws OrtException;
 
@@ -329,8 +468,140 @@ public class OrtSession implements AutoCloseable {
       long numOutputs)
       throws OrtException;
 
+  private native void runAsync(
+      long apiHandle,
+      long nativeHandle,
+      String[] inputNamesArray,
+      long[] inputs,
+      long numInputs,
+      String[] outputNamesArray,
+      long numOutputs,
+      CompletableFuture<long[]> outputHandles)
+      throws OrtException;
+
+  private native OnnxValue[] convertOutputs(
+      long apiHandle, long allocatorHandle, long[] outputHandles) throws OrtException;
+
   private native void closeSession(long apiHandle, long nativeHandle) throws OrtException;
 
+  private native long createIoBinding(long apiHandle, long nativeHandle) throws OrtException;
+
+  private native OnnxValue[] runWithBinding(
+      long apiHandle, long nativeHandle, long allocatorHandle, long bindingHandle)
+      throws OrtException;
+
+  private native void runWithBindingInPlace(long apiHandle, long nativeHandle, long bindingHandle)
+      throws OrtException;
+
+  /**
+   * The inputs and outputs bound to a session for {@link OrtSession#run(IoBinding)}.
+   *
+   * <p>The bound inputs are copied once to the device that consumes them, and the bound outputs are
+   * reused by the next run instead of being allocated again. The bound tensors must stay open while
+   * they're bound.
+   */
+  public static class IoBinding implements AutoCloseable {
+
+    private final long nativeHandle;
+
+    private final List<String> outputNames = new ArrayList<>();
+
+    private boolean closed = false;
+
+    IoBinding(long nativeHandle) {
+      this.nativeHandle = nativeHandle;
+    }
+
+    /**
+     * Binds the input to the tensor.
+     *
+     * @param name The input name.
+     * @param tensor The input value.
+     * @throws OrtException If the name is invalid or the tensor couldn't be copied to its device.
+     */
+    public void bindInput(String name, OnnxTensor tensor) throws OrtException {
+      checkClosed();
+      bindInput(OnnxRuntime.ortApiHandle, nativeHandle, name, tensor.getNativeHandle());
+    }
+
+    /**
+     * Binds the output to a preallocated tensor, which the runs write to.
+     *
+     * @param name The output name.
+     * @param tensor The output value.
+     * @throws OrtException If there was an error in native code.
+     */
+    public void bindOutput(String name, OnnxTensor tensor) throws OrtException {
+      checkClosed();
+      bindOutput(OnnxRuntime.ortApiHandle, nativeHandle, name, tensor.getNativeHandle());
+      addOutputName(name);
+    }
+
+    /**
+     * Binds the output to CPU memory. The first run allocates it, and the next runs reuse it.
+     *
+     * @param name The output name.
+     * @throws OrtException If there was an error in native code.
+     */
+    public void bindOutputToCpu(String name) throws OrtException {
+      checkClosed();
+      bindOutputToCpu(OnnxRuntime.ortApiHandle, nativeHandle, name);
+      addOutputName(name);
+    }
+
+    /** Removes all the bound inputs. */
+    public void clearBoundInputs() {
+      checkClosed();
+      clearBoundInputs(OnnxRuntime.ortApiHandle, nativeHandle);
+    }
+
+    /** Removes all the bound outputs. */
+    public void clearBoundOutputs() {
+      checkClosed();
+      clearBoundOutputs(OnnxRuntime.ortApiHandle, nativeHandle);
+      outputNames.clear();
+    }
+
+    /** Releases the binding. */
+    @Override
+    public void close() {
+      if (!closed) {
+        closeIoBinding(OnnxRuntime.ortApiHandle, nativeHandle);
+        closed = true;
+      } else {
+        throw new IllegalStateException("Trying to close an already closed IoBinding.");
+      }
+    }
+
+    private void checkClosed() {
+      if (closed) {
+        throw new IllegalStateException("Trying to use a closed IoBinding.");
+      }
+    }
+
+    // a name bound again keeps its position in the outputs
+    private void addOutputName(String name) {
+      if (!outputNames.contains(name)) {
+        outputNames.add(name);
+      }
+    }
+
+    private native void bindInput(long apiHandle, long nativeHandle, String name, long valueHandle)
+        throws OrtException;
+
+    private native void bindOutput(long apiHandle, long nativeHandle, String name, long valueHandle)
+        throws OrtException;
+
+    private native void bindOutputToCpu(long apiHandle, long nativeHandle, String name)
+        throws OrtException;
+
+    private native void clearBoundInputs(long apiHandle, long nativeHandle);
+
+    private native void clearBoundOutputs(long apiHandle, long nativeHandle);
+
+    private native void closeIoBinding(long apiHandle, long nativeHandle);
+  }
+
   /**
    * Represents the options used to construct this session.
    *
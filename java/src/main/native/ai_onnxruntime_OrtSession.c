@@ -3,6 +3,7 @@
  * Licensed under the MIT License.
  */
 #include <jni.h>
+#include <stdlib.h>
 #include <string.h>
 #include "onnxruntime/core/session/onnxruntime_c_api.h"
 #include "OrtJniUtil.h"
@@ -309,6 +310,211 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run
     return outputArray;
 }
 
+/*
+ * State of a run scheduled by runAsync, freed by its callback.
+ */
+typedef struct {
+    JavaVM* jvm;
+    const OrtApi* api;
+    jobject future; // Global reference to the CompletableFuture<long[]> of the output handles.
+    jclass ortExceptionClass; // Global reference, as the callback thread can't find the application's classes.
+    OrtValue** outputValues;
+} RunAsyncContext;
+
+static void releaseRunAsyncContext(JNIEnv * jniEnv, RunAsyncContext* context) {
+    (*jniEnv)->DeleteGlobalRef(jniEnv, context->future);
+    (*jniEnv)->DeleteGlobalRef(jniEnv, context->ortExceptionClass);
+    free(context->outputValues);
+    free(context);
+}
+
+static void ORT_API_CALL runAsyncCallback(void* userData, OrtValue** outputs, size_t numOutputs, OrtStatus* status) {
+    RunAsyncContext* context = (RunAsyncContext*) userData;
+    const OrtApi* api = context->api;
+
+    // The callback runs on a thread of the session, which is attached for the duration of the call.
+    JNIEnv* jniEnv;
+    jboolean attached = JNI_FALSE;
+    if ((*context->jvm)->GetEnv(context->jvm, (void**)&jniEnv, JNI_VERSION_1_6) == JNI_EDETACHED) {
+        if ((*context->jvm)->AttachCurrentThreadAsDaemon(context->jvm, (void**)&jniEnv, NULL) != JNI_OK) {
+            // Nothing can be reported without a JNIEnv.
+            return;
+        }
+        attached = JNI_TRUE;
+    }
+
+    jclass futureClass = (*jniEnv)->GetObjectClass(jniEnv, context->future);
+    if (status == NULL) {
+        jlongArray outputHandles = (*jniEnv)->NewLongArray(jniEnv, numOutputs);
+        for (size_t i = 0; i < numOutputs; i++) {
+            jlong handle = (jlong) outputs[i];
+            (*jniEnv)->SetLongArrayRegion(jniEnv, outputHandles, i, 1, &handle);
+        }
+        jmethodID complete = (*jniEnv)->GetMethodID(jniEnv, futureClass, "complete", "(Ljava/lang/Object;)Z");
+        (*jniEnv)->CallBooleanMethod(jniEnv, context->future, complete, outputHandles);
+    } else {
+        jmethodID exceptionConstructor = (*jniEnv)->GetMethodID(jniEnv, context->ortExceptionClass, "<init>", "(ILjava/lang/String;)V");
+        jstring message = (*jniEnv)->NewStringUTF(jniEnv, api->GetErrorMessage(status));
+        jobject exception = (*jniEnv)->NewObject(jniEnv, context->ortExceptionClass, exceptionConstructor, convertErrorCode(api->GetErrorCode(status)), message);
+        api->ReleaseStatus(status);
+        jmethodID completeExceptionally = (*jniEnv)->GetMethodID(jniEnv, futureClass, "completeExceptionally", "(Ljava/lang/Throwable;)Z");
+        (*jniEnv)->CallBooleanMethod(jniEnv, context->future, completeExceptionally, exception);
+    }
+    if ((*jniEnv)->ExceptionCheck(jniEnv)) {
+        (*jniEnv)->ExceptionDescribe(jniEnv);
+        (*jniEnv)->ExceptionClear(jniEnv);
+    }
+    releaseRunAsyncContext(jniEnv, context);
+
+    if (attached) {
+        (*context->jvm)->DetachCurrentThread(context->jvm);
+    }
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession
+ * Method:    runAsync
+ * Signature: (JJ[Ljava/lang/String;[JJ[Ljava/lang/String;JLjava/util/concurrent/CompletableFuture;)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_runAsync
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle, jobjectArray inputNamesArr, jlongArray tensorArr, jlong numInputs, jobjectArray outputNamesArr, jlong numOutputs, jobject future) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+
+    // The run copies the names and input values before it's scheduled, but writes the outputs to the
+    // output array of the context when it's done.
+    RunAsyncContext* context = (RunAsyncContext*) malloc(sizeof(RunAsyncContext));
+    (*jniEnv)->GetJavaVM(jniEnv, &context->jvm);
+    context->api = api;
+    context->future = (*jniEnv)->NewGlobalRef(jniEnv, future);
+    jclass ortExceptionClass = (*jniEnv)->FindClass(jniEnv, "ai/onnxruntime/OrtException");
+    context->ortExceptionClass = (jclass) (*jniEnv)->NewGlobalRef(jniEnv, ortExceptionClass);
+    context->outputValues = (OrtValue**) calloc(numOutputs, sizeof(OrtValue*));
+
+    const char** inputNames = (const char**) malloc(sizeof(char*)*numInputs);
+    jobject* javaInputStrings = (jobject*) malloc(sizeof(jobject)*numInputs);
+    for (int i = 0; i < numInputs; i++) {
+        javaInputStrings[i] = (*jniEnv)->GetObjectArrayElement(jniEnv,inputNamesArr,i);
+        inputNames[i] = (*jniEnv)->GetStringUTFChars(jniEnv,javaInputStrings[i],NULL);
+    }
+    const char** outputNames = (const char**) malloc(sizeof(char*)*numOutputs);
+    jobject* javaOutputStrings = (jobject*) malloc(sizeof(jobject)*numOutputs);
+    for (int i = 0; i < numOutputs; i++) {
+        javaOutputStrings[i] = (*jniEnv)->GetObjectArrayElement(jniEnv,outputNamesArr,i);
+        outputNames[i] = (*jniEnv)->GetStringUTFChars(jniEnv,javaOutputStrings[i],NULL);
+    }
+    jlong* inputTensors = (*jniEnv)->GetLongArrayElements(jniEnv,tensorArr,NULL);
+
+    OrtStatus* status = api->RunAsync((OrtSession*)sessionHandle, NULL, (const char* const*) inputNames, (const OrtValue* const*) inputTensors, numInputs, (const char* const*) outputNames, numOutputs, context->outputValues, runAsyncCallback, context);
+
+    (*jniEnv)->ReleaseLongArrayElements(jniEnv,tensorArr,inputTensors,JNI_ABORT);
+    for (int i = 0; i < numInputs; i++) {
+        (*jniEnv)->ReleaseStringUTFChars(jniEnv,javaInputStrings[i],inputNames[i]);
+    }
+    for (int i = 0; i < numOutputs; i++) {
+        (*jniEnv)->ReleaseStringUTFChars(jniEnv,javaOutputStrings[i],outputNames[i]);
+    }
+    free(inputNames);
+    free(javaInputStrings);
+    free(outputNames);
+    free(javaOutputStrings);
+
+    // The callback isn't called when the run isn't scheduled.
+    if (status != NULL) {
+        releaseRunAsyncContext(jniEnv, context);
+        checkOrtStatus(jniEnv,api,status);
+    }
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession
+ * Method:    convertOutputs
+ * Signature: (JJ[J)[Lai/onnxruntime/OnnxValue;
+ */
+JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_convertOutputs
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong allocatorHandle, jlongArray outputHandles) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+
+    jsize numOutputs = (*jniEnv)->GetArrayLength(jniEnv, outputHandles);
+    jlong* outputValues = (*jniEnv)->GetLongArrayElements(jniEnv,outputHandles,NULL);
+
+    char *onnxValueClassName = "ai/onnxruntime/OnnxValue";
+    jclass onnxValueClass = (*jniEnv)->FindClass(jniEnv, onnxValueClassName);
+    jobjectArray outputArray = (*jniEnv)->NewObjectArray(jniEnv,numOutputs,onnxValueClass,NULL);
+    for (int i = 0; i < numOutputs; i++) {
+        if (outputValues[i] != 0) {
+            jobject onnxValue = convertOrtValueToONNXValue(jniEnv,api,allocator,(OrtValue*)outputValues[i]);
+            (*jniEnv)->SetObjectArrayElement(jniEnv,outputArray,i,onnxValue);
+        }
+    }
+    (*jniEnv)->ReleaseLongArrayElements(jniEnv,outputHandles,outputValues,JNI_ABORT);
+
+    return outputArray;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession
+ * Method:    createIoBinding
+ * Signature: (JJ)J
+ */
+JNIEXPORT jlong JNICALL Java_ai_onnxruntime_OrtSession_createIoBinding
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    OrtIoBinding* binding;
+    checkOrtStatus(jniEnv,api,api->CreateIoBinding((OrtSession*)sessionHandle,&binding));
+    return (jlong) binding;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession
+ * Method:    runWithBinding
+ * Signature: (JJJJ)[Lai/onnxruntime/OnnxValue;
+ */
+JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_runWithBinding
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle, jlong allocatorHandle, jlong bindingHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+    OrtIoBinding* binding = (OrtIoBinding*) bindingHandle;
+
+    checkOrtStatus(jniEnv,api,api->RunWithBinding((OrtSession*)sessionHandle, NULL, binding));
+
+    // Fetch the bound outputs, which share their buffers with the binding.
+    OrtValue** outputValues;
+    size_t numOutputs;
+    checkOrtStatus(jniEnv,api,api->GetBoundOutputValues(binding, allocator, &outputValues, &numOutputs));
+
+    // Construct the output array of ONNXValues
+    char *onnxValueClassName = "ai/onnxruntime/OnnxValue";
+    jclass onnxValueClass = (*jniEnv)->FindClass(jniEnv, onnxValueClassName);
+    jobjectArray outputArray = (*jniEnv)->NewObjectArray(jniEnv,numOutputs,onnxValueClass,NULL);
+    for (size_t i = 0; i < numOutputs; i++) {
+        jobject onnxValue = convertOrtValueToONNXValue(jniEnv,api,allocator,outputValues[i]);
+        (*jniEnv)->SetObjectArrayElement(jniEnv,outputArray,i,onnxValue);
+    }
+    if (outputValues != NULL) {
+        checkOrtStatus(jniEnv,api,api->AllocatorFree(allocator,outputValues));
+    }
+
+    return outputArray;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession
+ * Method:    runWithBindingInPlace
+ * Signature: (JJJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_runWithBindingInPlace
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle, jlong bindingHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    // The outputs stay in the bound values, which the caller reads directly.
+    checkOrtStatus(jniEnv,api,api->RunWithBinding((OrtSession*)sessionHandle, NULL, (OrtIoBinding*)bindingHandle));
+}
+
 /*
  * Class:     ai_onnxruntime_OrtSession
  * Method:    closeSession
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * Licensed under the MIT License.
+ */
+#include <jni.h>
+#include <string.h>
+#include "onnxruntime/core/session/onnxruntime_c_api.h"
+#include "OrtJniUtil.h"
+#include "ai_onnxruntime_OrtSession_IoBinding.h"
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    bindInput
+ * Signature: (JJLjava/lang/String;J)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_bindInput
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong handle, jstring name, jlong valueHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    const char* cName = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+    checkOrtStatus(jniEnv,api,api->BindInput((OrtIoBinding*)handle, cName, (const OrtValue*)valueHandle));
+    (*jniEnv)->ReleaseStringUTFChars(jniEnv,name,cName);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    bindOutput
+ * Signature: (JJLjava/lang/String;J)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_bindOutput
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong handle, jstring name, jlong valueHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    const char* cName = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+    checkOrtStatus(jniEnv,api,api->BindOutput((OrtIoBinding*)handle, cName, (const OrtValue*)valueHandle));
+    (*jniEnv)->ReleaseStringUTFChars(jniEnv,name,cName);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    bindOutputToCpu
+ * Signature: (JJLjava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_bindOutputToCpu
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong handle, jstring name) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    OrtMemoryInfo* memoryInfo;
+    checkOrtStatus(jniEnv,api,api->CreateCpuMemoryInfo(OrtDeviceAllocator, OrtMemTypeDefault, &memoryInfo));
+    const char* cName = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+    checkOrtStatus(jniEnv,api,api->BindOutputToDevice((OrtIoBinding*)handle, cName, memoryInfo));
+    (*jniEnv)->ReleaseStringUTFChars(jniEnv,name,cName);
+    api->ReleaseMemoryInfo(memoryInfo);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    clearBoundInputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_clearBoundInputs
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong handle) {
+    (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    api->ClearBoundInputs((OrtIoBinding*)handle);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    clearBoundOutputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_clearBoundOutputs
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong handle) {
+    (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    api->ClearBoundOutputs((OrtIoBinding*)handle);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    closeIoBinding
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_closeIoBinding
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong handle) {
+    (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    api->ReleaseIoBinding((OrtIoBinding*)handle);
+}
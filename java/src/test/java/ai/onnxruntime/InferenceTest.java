@@ -26,6 +26,7 @@ import java.io.IOException;
 import java.io.InputStream;
 import java.io.UncheckedIOException;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.nio.FloatBuffer;
 import java.nio.file.Files;
 import java.nio.file.Path;
@@ -37,6 +38,7 @@ import java.util.Iterator;
 import java.util.List;
 import java.util.Map;
 import java.util.Set;
+import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
 import java.util.concurrent.TimeUnit;
@@ -435,6 +437,114 @@ public class InferenceTest {
     }
   }
 
+  @Test
+  public void ioBindingTest() throws OrtException {
+    String modelPath = getResourcePath("/squeezenet.onnx").toString();
+    try (OrtEnvironment env = OrtEnvironment.getEnvironment("ioBindingTest");
+        SessionOptions options = new SessionOptions();
+        OrtSession session = env.createSession(modelPath, options);
+        OrtSession.IoBinding binding = session.createIoBinding()) {
+      NodeInfo inputMeta = session.getInputInfo().values().iterator().next();
+      float[] inputData = loadTensorFromFile(getResourcePath("/bench.in"));
+      Object tensorData =
+          OrtUtil.reshape(inputData, ((TensorInfo) inputMeta.getInfo()).getShape());
+      float[] expectedOutput = loadTensorFromFile(getResourcePath("/bench.expected_out"));
+
+      try (OnnxTensor inputTensor = OnnxTensor.createTensor(env, tensorData)) {
+        binding.bindInput(inputMeta.getName(), inputTensor);
+        binding.bindOutputToCpu("softmaxout_1");
+
+        // the output allocated by the first run is reused by the second one
+        for (int i = 0; i < 2; i++) {
+          try (OrtSession.Result results = session.run(binding)) {
+            assertEquals(1, results.size());
+            OnnxTensor resultTensor = (OnnxTensor) results.get(0);
+            float[] resultArray = TestHelpers.flattenFloat(resultTensor.getValue());
+            assertArrayEquals(expectedOutput, resultArray, 1e-6f);
+          }
+        }
+      }
+    }
+  }
+
+  @Test
+  public void ioBindingInPlaceTest() throws OrtException {
+    String modelPath = getResourcePath("/squeezenet.onnx").toString();
+    try (OrtEnvironment env = OrtEnvironment.getEnvironment("ioBindingInPlaceTest");
+        SessionOptions options = new SessionOptions();
+        OrtSession session = env.createSession(modelPath, options);
+        OrtSession.IoBinding binding = session.createIoBinding()) {
+      NodeInfo inputMeta = session.getInputInfo().values().iterator().next();
+      long[] inputShape = ((TensorInfo) inputMeta.getInfo()).getShape();
+      float[] inputData = loadTensorFromFile(getResourcePath("/bench.in"));
+      float[] expectedOutput = loadTensorFromFile(getResourcePath("/bench.expected_out"));
+
+      FloatBuffer inputBuffer =
+          ByteBuffer.allocateDirect(inputData.length * 4)
+              .order(ByteOrder.nativeOrder())
+              .asFloatBuffer();
+      inputBuffer.put(inputData);
+      inputBuffer.rewind();
+      FloatBuffer outputBuffer =
+          ByteBuffer.allocateDirect(expectedOutput.length * 4)
+              .order(ByteOrder.nativeOrder())
+              .asFloatBuffer();
+
+      try (OnnxTensor inputTensor = OnnxTensor.createTensor(env, inputBuffer, inputShape);
+          OnnxTensor outputTensor =
+              OnnxTensor.createTensor(env, outputBuffer, new long[] {1, 1000, 1, 1})) {
+        binding.bindInput(inputMeta.getName(), inputTensor);
+        binding.bindOutput("softmaxout_1", outputTensor);
+
+        // every run writes the buffer of the caller in place
+        float[] resultArray = new float[expectedOutput.length];
+        for (int i = 0; i < 2; i++) {
+          session.runInPlace(binding);
+          outputBuffer.rewind();
+          outputBuffer.get(resultArray);
+          assertArrayEquals(expectedOutput, resultArray, 1e-6f);
+        }
+
+        FloatBuffer view = outputTensor.getByteBufferView().asFloatBuffer();
+        assertEquals(expectedOutput.length, view.capacity());
+        assertEquals(expectedOutput[0], view.get(0), 1e-6f);
+      }
+    }
+  }
+
+  @Test
+  public void runAsyncTest() throws Exception {
+    String modelPath = getResourcePath("/squeezenet.onnx").toString();
+    try (OrtEnvironment env = OrtEnvironment.getEnvironment("runAsyncTest");
+        SessionOptions options = new SessionOptions()) {
+      options.setIntraOpNumThreads(2);
+      try (OrtSession session = env.createSession(modelPath, options)) {
+        NodeInfo inputMeta = session.getInputInfo().values().iterator().next();
+        float[] inputData = loadTensorFromFile(getResourcePath("/bench.in"));
+        Object tensorData =
+            OrtUtil.reshape(inputData, ((TensorInfo) inputMeta.getInfo()).getShape());
+        float[] expectedOutput = loadTensorFromFile(getResourcePath("/bench.expected_out"));
+
+        try (OnnxTensor inputTensor = OnnxTensor.createTensor(env, tensorData)) {
+          Map<String, OnnxTensor> container = new HashMap<>();
+          container.put(inputMeta.getName(), inputTensor);
+          List<CompletableFuture<Result>> futures = new ArrayList<>();
+          for (int i = 0; i < 4; i++) {
+            futures.add(session.runAsync(container));
+          }
+          for (CompletableFuture<Result> future : futures) {
+            try (Result results = future.get()) {
+              assertEquals(1, results.size());
+              OnnxTensor resultTensor = (OnnxTensor) results.get(0);
+              float[] resultArray = TestHelpers.flattenFloat(resultTensor.getValue());
+              assertArrayEquals(expectedOutput, resultArray, 1e-6f);
+            }
+          }
+        }
+      }
+    }
+  }
+
   @Test
   public void throwWrongInputName() throws OrtException {
     SqueezeNetTuple tuple = openSessionSqueezeNet();
@@ -10,6 +10,6 @@ __version__ = "1.2.0"
 __author__ = "Microsoft"
 
 from onnxruntime.capi._pybind_state import get_all_providers, get_available_providers, get_device, RunOptions, SessionOptions, set_default_logger_severity, NodeArg, ModelMetadata, GraphOptimizationLevel, ExecutionMode
-from onnxruntime.capi.session import InferenceSession
+from onnxruntime.capi.session import InferenceSession, IOBinding, OrtValue
 from onnxruntime.capi import onnxruntime_validation
 onnxruntime_validation.check_distro_info()
@@ -2,7 +2,10 @@
 // Licensed under the MIT License.
 
 #include "bahdanau_attention.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
+#include "core/util/math_cpuonly.h"
 
 #include <stdexcept>
 #include <memory.h>
@@ -20,6 +23,7 @@ BahdanauAttention<T>::BahdanauAttention(AllocatorPtr allocator, const logging::L
   values_ = Allocate(allocator_, batch_size_ * max_memory_steps_ * memory_depth_, values_ptr_, true);
   keys_ = Allocate(allocator_, batch_size_ * max_memory_steps_ * attn_depth_, keys_ptr_, true);
   processed_query_ = Allocate(allocator_, batch_size_ * attn_depth_, processed_query_ptr_, true);
+  hidden_ = Allocate(allocator_, batch_size_ * max_memory_steps_ * attn_depth_, hidden_ptr_, true);
   mem_seq_lengths_ = Allocate(allocator_, batch_size_, mem_seq_lengths_ptr_, true);
 
   ORT_ENFORCE(!normalize_, "not support normalize yet.");
@@ -79,30 +83,6 @@ void BahdanauAttention<T>::PrepareMemory(
                   keys_.data(), attn_depth_, ttp_);
 }
 
-template <typename T>
-static void SoftmaxInplace(const gsl::span<T>& alignments) {
-  T* x = alignments.data();
-  size_t len = alignments.size();
-
-  double sum = 0.0;
-
-  for (size_t i = 0; i < len; i++) {
-    T e = exp(x[i]);
-    sum += e;
-    x[i] = e;
-  }
-
-  if (sum == 0.0) {
-    for (size_t i = 0; i < len; i++) {
-      x[i] = static_cast<T>(1.0 / len);
-    }
-  } else {
-    for (size_t i = 0; i < len; i++) {
-      x[i] = static_cast<T>(x[i] / sum);
-    }
-  }
-}
-
 /**
   * Args:
   *     queries: Tensor, shape `[batch_size_, query_depth_]` to compare to keys.
@@ -123,35 +103,38 @@ void BahdanauAttention<T>::Compute(
 
   std::fill(aligns.begin(), aligns.end(), T{});
 
-  // return math_ops.reduce_sum(v * math_ops.tanh(keys + processed_query), [2])
-  for (int b = 0; b < batch_size_; b++) {
+  // each batch entry is independent, so they run in parallel with single threaded MLAS calls
+  concurrency::ThreadPool::TryParallelFor(ttp_, batch_size_, [&](int32_t b) {
     T* alignments = aligns.data() + b * max_memory_steps_;
     const T* keys = keys_.data() + b * max_memory_steps_ * attn_depth_;
     const T* query = processed_query_.data() + b * attn_depth_;
+    T* hidden = hidden_.data() + b * max_memory_steps_ * attn_depth_;
 
-    int mem_steps = mem_seq_lengths_[b];
+    // return math_ops.reduce_sum(v * math_ops.tanh(keys + processed_query), [2])
+    const int mem_steps = mem_seq_lengths_[b];
     for (int step = 0; step < mem_steps; step++) {
       const T* keys_on_step = keys + step * attn_depth_;
-      T* dest = alignments + step;
-
-      // reduce_sum(v * tanh(keys[step] + query)) on last dimension
-      *dest = T(0.0);
+      T* hidden_on_step = hidden + step * attn_depth_;
       for (int i = 0; i < attn_depth_; i++) {
-        *dest += (attention_v_[i] * tanh(keys_on_step[i] + query[i]));
+        hidden_on_step[i] = keys_on_step[i] + query[i];
       }
     }
+    MlasComputeTanh(hidden, hidden, static_cast<size_t>(mem_steps) * attn_depth_);
+    EigenVectorMap<T>(alignments, mem_steps) =
+        ConstEigenMatrixMap<T>(hidden, attn_depth_, mem_steps).transpose() *
+        ConstEigenVectorMap<T>(attention_v_.data(), attn_depth_);
 
-    SoftmaxInplace(gsl::span<T>{alignments, gsl::narrow_cast<gsl::index>(mem_steps)});
+    MlasComputeSoftmax(alignments, alignments, 1, static_cast<size_t>(mem_steps), false, nullptr);
 
-    // Calculate the context
+    // Calculate the context. the alignments past the memory steps are 0
     auto outspan = output.subspan(b * memory_depth_);
     auto values = values_.subspan(b * max_memory_steps_ * memory_depth_);
     math::GemmEx<T>(CblasNoTrans, CblasNoTrans,
-                    1, memory_depth_, max_memory_steps_, T{1.0},
+                    1, memory_depth_, mem_steps, T{1.0},
                     alignments, max_memory_steps_,
                     values.data(), memory_depth_, T{0.0},
-                    outspan.data(), memory_depth_, ttp_);
-  }
+                    outspan.data(), memory_depth_, nullptr);
+  });
 }
 
 template class BahdanauAttention<float>;
@@ -73,6 +73,10 @@ class BahdanauAttention : public IAttentionMechanism<T> {
   IAllocatorUniquePtr<T> processed_query_ptr_;
   gsl::span<T> processed_query_;
 
+  // keys + processed query, then its tanh, for each memory step
+  IAllocatorUniquePtr<T> hidden_ptr_;
+  gsl::span<T> hidden_;
+
   IAllocatorUniquePtr<int> mem_seq_lengths_ptr_;
   gsl::span<int> mem_seq_lengths_;
 
@@ -31,6 +31,28 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<int32_t>()),
     DeepCpuAttnLstmOp);
 
+Status DeepCpuAttnLstmOp::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                  bool& is_packed, PrePackedWeights& prepacked_weights) {
+  // W and R have shape [num_directions, 4*hidden_size, input_size + attention_size or hidden_size]. leave any other
+  // shape to ValidateInputs to report.
+  is_packed = (input_idx == 1 || input_idx == 2) &&
+              tensor.Shape().NumDimensions() == 3 &&
+              tensor.Shape()[0] == num_directions_ &&
+              tensor.Shape()[1] == 4 * hidden_size_ &&
+              onnxruntime::rnn::detail::PackWeightsPerDirection(alloc, tensor, 0, 4 * hidden_size_,
+                                                                prepacked_weights);
+  return Status::OK();
+}
+
+Status DeepCpuAttnLstmOp::UseSharedPrePackedBuffers(const PrePackedWeights& prepacked_weights, int input_idx) {
+  std::vector<const void*>& packed = input_idx == 1 ? packed_W_ : packed_R_;
+  packed.clear();
+  for (const auto& buffer : prepacked_weights.buffers_) {
+    packed.push_back(buffer.get());
+  }
+  return Status::OK();
+}
+
 Status
 DeepCpuAttnLstmOp::Compute(OpKernelContext* context) const {
   const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
@@ -208,6 +230,11 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
 
   concurrency::ThreadPool* thread_pool = context.GetOperatorThreadPool();
 
+  // the packed weights of a direction, or nullptr if PrePack didn't pack them
+  auto packed_weights = [](const std::vector<const void*>& packed, size_t direction) -> const void* {
+    return direction < packed.size() ? packed[direction] : nullptr;
+  };
+
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
     gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
@@ -309,8 +336,10 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
         activation_funcs_.Entries()[5],
         clip_, thread_pool);
 
-    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
-    bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+               packed_weights(packed_W_, 0), packed_weights(packed_R_, 0), output_1, hidden_output_1, last_cell_1);
+    bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2,
+               packed_weights(packed_W_, 1), packed_weights(packed_R_, 1), output_2, hidden_output_2, last_cell_2);
 
   } else {
     BahdanauAttention<T> fam(
@@ -351,7 +380,8 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
         activation_funcs_.Entries()[2],
         clip_, thread_pool);
 
-    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+               packed_weights(packed_W_, 0), packed_weights(packed_R_, 0), output_1, hidden_output_1, last_cell_1);
   }
 
   if (!output.empty()) {
@@ -61,6 +61,12 @@ class DeepCpuAttnLstmOp final : public OpKernel {
 
   Status Compute(OpKernelContext* context) const override;
 
+  // packs the W and R weights of each direction once, so the GEMMs run on every step don't pack them again
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights& prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(const PrePackedWeights& prepacked_weights, int input_idx) override;
+
   ~DeepCpuAttnLstmOp() override = default;
 
  private:
@@ -92,6 +98,10 @@ class DeepCpuAttnLstmOp final : public OpKernel {
 
   ActivationFuncs activation_funcs_;
 
+  // W and R packed by PrePack, one buffer per direction. empty if they are not constant initializers.
+  std::vector<const void*> packed_W_;
+  std::vector<const void*> packed_R_;
+
 // Threadpool for operator. If concurrent Compute calls are possible, it will be shared
 // across them. mutable due to this.
 // The alternative would be to create a threadpool in each call to Compute but that would incur thread creation
@@ -103,6 +103,7 @@ void UniDirectionalAttnLstm<T>::AllocateBuffers() {
                                               batched_internal_memory_clipped_ptr_, fill);
 
   output_iofc_ = Allocate(allocator_, hidden_size_ * 4 * batch_size_ * seq_length_, output_iofc_ptr_, fill);
+  step_inputs_ = Allocate(allocator_, batch_size_ * (input_size_ + attention_size_), step_inputs_ptr_);
 
   if (use_bias_) {
     bias_WRi_ = Allocate(allocator_, hidden_size_, bias_WRi_ptr_);
@@ -197,6 +198,8 @@ void UniDirectionalAttnLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
                                         const int num_directions,
                                         const gsl::span<const T>& input_weights,
                                         const gsl::span<const T>& recurrent_weights,
+                                        const void* packed_input_weights,
+                                        const void* packed_recurrent_weights,
                                         gsl::span<T>& outputs,
                                         gsl::span<T>& final_hidden_state,
                                         gsl::span<T>& final_cell_state) {
@@ -247,16 +250,19 @@ void UniDirectionalAttnLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
   const int hidden_size_x4 = 4 * hidden_size_;
   const int total_rows = max_sequence_length * batch_size_;
 
-  // apply the weights to all the inputs and save to output_IOFC
-  ComputeGemm(total_rows, hidden_size_x4, input_size_, T{1.0},
-              inputs.cbegin(), inputs.cend(),
-              input_size_,
-              input_weights.cbegin(), input_weights.cend(),  // W[iofc]^T
-              input_size_ + attention_size_, T{0.0},
-              output_iofc_.begin(), output_iofc_.end(),
-              hidden_size_x4, ttp_);
-
-  DumpMatrix("Xt*(W[iofc]^T)", output_iofc_.data(), total_rows, hidden_size_x4);
+  // apply the weights to all the inputs and save to output_IOFC. the packed weights can't be split between the
+  // inputs and the attention, so they are applied to both on each step instead
+  if (packed_input_weights == nullptr) {
+    ComputeGemm(total_rows, hidden_size_x4, input_size_, T{1.0},
+                inputs.cbegin(), inputs.cend(),
+                input_size_,
+                input_weights.cbegin(), input_weights.cend(),  // W[iofc]^T
+                input_size_ + attention_size_, T{0.0},
+                output_iofc_.begin(), output_iofc_.end(),
+                hidden_size_x4, ttp_);
+
+    DumpMatrix("Xt*(W[iofc]^T)", output_iofc_.data(), total_rows, hidden_size_x4);
+  }
 
   int fused_hidden_rows = batch_size_ / hidden_num_threads_;
   if (batch_size_ % hidden_num_threads_ != 0)
@@ -289,23 +295,52 @@ void UniDirectionalAttnLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
       // shape is [ attention_size_ ]
       const gsl::span<const T> attention = attention_wrapper_.GetAttnStates();
 
-      // Xt*(W[iofc]^T) = INPUTt * W[iofc]^T + At-1 * WA[iofc]
-      ComputeGemm(batch_size_, hidden_size_x4, attention_size_, T{1.0},
-                  attention.cbegin(), attention.cend(),  // At-1
-                  attention_size_,
-                  input_weights.cbegin() + input_size_, input_weights.cend(),  // WA[iofc]
-                  input_size_ + attention_size_, T{1.0},
-                  step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4, ttp_);
+      if (packed_input_weights != nullptr) {
+        // Xt*(W[iofc]^T) = concat(INPUTt, At-1) * W[iofc]^T
+        const int step_input_size = input_size_ + attention_size_;
+        const T* step_input = inputs.data() + step * batch_size_ * input_size_;
+        for (int lrow = 0; lrow < batch_size_; lrow++) {
+          T* dst = step_inputs_.data() + lrow * step_input_size;
+          std::copy_n(step_input + lrow * input_size_, input_size_, dst);
+          std::copy_n(attention.data() + lrow * attention_size_, attention_size_, dst + input_size_);
+        }
+
+        ComputeGemm(batch_size_, hidden_size_x4, step_input_size, T{1.0},
+                    step_inputs_.cbegin(), step_inputs_.cend(),  // [Xt, At-1]
+                    step_input_size,
+                    packed_input_weights,  // W[iofc]
+                    T{0.0},
+                    step_out_IOFC, output_iofc_.end(),
+                    hidden_size_x4, ttp_);
+      } else {
+        // Xt*(W[iofc]^T) = INPUTt * W[iofc]^T + At-1 * WA[iofc]
+        ComputeGemm(batch_size_, hidden_size_x4, attention_size_, T{1.0},
+                    attention.cbegin(), attention.cend(),  // At-1
+                    attention_size_,
+                    input_weights.cbegin() + input_size_, input_weights.cend(),  // WA[iofc]
+                    input_size_ + attention_size_, T{1.0},
+                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4, ttp_);
+      }
 
       // calculate Xt*(W[iofc]^T) + Ht-1*R[iofc]
-      ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, T{1.0},
-                  previous_state, previous_state_end,  // Ht-1
-                  hidden_size_,
-                  recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
-                  hidden_size_, T{1.0},
-                  step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4, ttp_);
+      if (packed_recurrent_weights != nullptr) {
+        ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, T{1.0},
+                    previous_state, previous_state_end,  // Ht-1
+                    hidden_size_,
+                    packed_recurrent_weights,  // R[iofc]
+                    T{1.0},
+                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4, ttp_);
+      } else {
+        ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, T{1.0},
+                    previous_state, previous_state_end,  // Ht-1
+                    hidden_size_,
+                    recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
+                    hidden_size_, T{1.0},
+                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4, ttp_);
+      }
 
       span_T_iter batched_output, batched_output_end;
       if (output_sequence) {
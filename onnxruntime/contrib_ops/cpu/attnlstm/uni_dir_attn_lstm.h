@@ -58,6 +58,8 @@ class UniDirectionalAttnLstm {
                const int num_directions,
                const gsl::span<const T>& input_weights,
                const gsl::span<const T>& recurrent_weights,
+               const void* packed_input_weights,
+               const void* packed_recurrent_weights,
                gsl::span<T>& outputs,
                gsl::span<T>& final_hidden_state,
                gsl::span<T>& final_cell_state);
@@ -114,6 +116,10 @@ class UniDirectionalAttnLstm {
 
   int hidden_num_threads_ = -1;
 
+  // the inputs of a step followed by the attention of the previous step, for the packed input weights
+  IAllocatorUniquePtr<T> step_inputs_ptr_;
+  gsl::span<T> step_inputs_;
+
   IAllocatorUniquePtr<T> output_iofc_ptr_;
   IAllocatorUniquePtr<T> hidden0_ptr_, batched_hidden0_ptr_;
   gsl::span<T> output_iofc_;
@@ -0,0 +1,564 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/beam_search.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+
+#include "core/common/safeint.h"
+#include "core/framework/allocator.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/session_state.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/framework/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    BeamSearch,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("I", DataTypeImpl::GetTensorType<int64_t>()),
+    BeamSearch);
+
+// The decoder subgraph has the inputs (input_ids, position_ids, past_0, ..., past_{L-1}) and the outputs
+// (logits, present_0, ..., present_{L-1}), with the shapes of the Attention op state for past and present:
+//   input_ids, position_ids : (batch_size * num_beams, sequence_length)
+//   past_i                  : (2, batch_size * num_beams, num_heads, past_sequence_length, head_size)
+//   logits                  : (batch_size * num_beams, sequence_length, vocab_size)
+//   present_i               : (2, batch_size * num_beams, num_heads, past_sequence_length + sequence_length, head_size)
+struct BeamSearch::Info {
+  Info(const onnxruntime::Node& node, const GraphViewer& subgraph_in)
+      : subgraph(subgraph_in) {
+    num_implicit_inputs = static_cast<int>(node.ImplicitInputDefs().size());
+
+    auto& subgraph_inputs = subgraph.GetInputs();
+    auto& subgraph_outputs = subgraph.GetOutputs();
+
+    ORT_ENFORCE(subgraph_inputs.size() >= 2,
+                "Graph in 'decoder' attribute of BeamSearch should have input_ids and position_ids inputs. Found:",
+                subgraph_inputs.size());
+    num_layers = static_cast<int>(subgraph_inputs.size()) - 2;
+    ORT_ENFORCE(subgraph_outputs.size() == static_cast<size_t>(1 + num_layers),
+                "Graph in 'decoder' attribute of BeamSearch has ", num_layers, " past inputs so it requires ",
+                1 + num_layers, " outputs (logits and the presents) but has ", subgraph_outputs.size());
+
+    for (const auto* input : subgraph_inputs) {
+      subgraph_input_names.push_back(input->Name());
+    }
+    for (const auto* output : subgraph_outputs) {
+      subgraph_output_names.push_back(output->Name());
+    }
+
+    // the number of heads and the head size are needed to create the empty past of the first step
+    for (int i = 0; i < num_layers; ++i) {
+      const auto* shape = subgraph_inputs[2 + i]->Shape();
+      ORT_ENFORCE(shape != nullptr && shape->dim_size() == 5 && shape->dim(2).has_dim_value() &&
+                      shape->dim(4).has_dim_value(),
+                  "Input ", subgraph_inputs[2 + i]->Name(), " of the BeamSearch decoder should have the shape ",
+                  "(2, batch_size, num_heads, past_sequence_length, head_size) with known num_heads and head_size");
+      if (i == 0) {
+        num_heads = shape->dim(2).dim_value();
+        head_size = shape->dim(4).dim_value();
+      }
+      ORT_ENFORCE(shape->dim(2).dim_value() == num_heads && shape->dim(4).dim_value() == head_size,
+                  "The past inputs of the BeamSearch decoder should have the same num_heads and head_size");
+    }
+  }
+
+  const GraphViewer& subgraph;
+
+  int num_implicit_inputs;
+  int num_layers;
+  int64_t num_heads = 0;
+  int64_t head_size = 0;
+
+  std::vector<std::string> subgraph_input_names;
+  std::vector<std::string> subgraph_output_names;
+};
+
+namespace {
+
+// The finished sequences of a batch entry: the num_beams best ones, scored by their sum of log probabilities
+// normalized by their length to the power of length_penalty.
+class BeamHypotheses {
+ public:
+  BeamHypotheses(int num_beams, float length_penalty, bool early_stopping)
+      : num_beams_(num_beams), length_penalty_(length_penalty), early_stopping_(early_stopping) {}
+
+  void Add(const int64_t* tokens, int length, float sum_logprobs) {
+    const float score = sum_logprobs / std::pow(static_cast<float>(length), length_penalty_);
+    if (static_cast<int>(beams_.size()) == num_beams_) {
+      if (score <= beams_[worst_].score) {
+        return;
+      }
+      beams_[worst_] = Hypothesis{score, std::vector<int64_t>(tokens, tokens + length)};
+    } else {
+      beams_.push_back(Hypothesis{score, std::vector<int64_t>(tokens, tokens + length)});
+    }
+    worst_ = 0;
+    for (size_t i = 1; i < beams_.size(); ++i) {
+      if (beams_[i].score < beams_[worst_].score) {
+        worst_ = i;
+      }
+    }
+  }
+
+  // Whether no beam can do better than the worst finished sequence any more, given the best sum of log
+  // probabilities of the beams at length cur_len.
+  bool IsDone(float best_sum_logprobs, int cur_len) const {
+    if (static_cast<int>(beams_.size()) < num_beams_) {
+      return false;
+    }
+    if (early_stopping_) {
+      return true;
+    }
+    return beams_[worst_].score >= best_sum_logprobs / std::pow(static_cast<float>(cur_len), length_penalty_);
+  }
+
+  // Writes the num_sequences best sequences padded to max_length, and their scores if scores isn't null.
+  void Output(int num_sequences, int max_length, int64_t pad_token_id, int64_t* sequences, float* scores) {
+    std::stable_sort(beams_.begin(), beams_.end(),
+                     [](const Hypothesis& a, const Hypothesis& b) { return a.score > b.score; });
+    for (int i = 0; i < num_sequences; ++i) {
+      const auto& tokens = beams_[i].tokens;
+      int64_t* sequence = sequences + static_cast<size_t>(i) * max_length;
+      std::copy(tokens.begin(), tokens.end(), sequence);
+      std::fill(sequence + tokens.size(), sequence + max_length, pad_token_id);
+      if (scores != nullptr) {
+        scores[i] = beams_[i].score;
+      }
+    }
+  }
+
+ private:
+  struct Hypothesis {
+    float score;
+    std::vector<int64_t> tokens;
+  };
+
+  int num_beams_;
+  float length_penalty_;
+  bool early_stopping_;
+  std::vector<Hypothesis> beams_;
+  size_t worst_ = 0;
+};
+
+template <typename T>
+OrtValue MakeOrtValue(const TensorShape& shape, T* data, const OrtMemoryInfo& info) {
+  auto p_tensor = onnxruntime::make_unique<Tensor>(DataTypeImpl::GetType<T>(), shape, data, info);
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  return OrtValue{p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc()};
+}
+
+}  // namespace
+
+class BeamSearchImpl {
+ public:
+  BeamSearchImpl(OpKernelContextInternal& context, const SessionState& session_state, const BeamSearch::Info& info,
+                 int64_t eos_token_id, int64_t pad_token_id, bool early_stopping)
+      : context_(context),
+        session_state_(session_state),
+        info_(info),
+        implicit_inputs_(context_.GetImplicitInputs()),
+        eos_token_id_(eos_token_id),
+        pad_token_id_(pad_token_id),
+        early_stopping_(early_stopping) {}
+
+  // Validate the inputs
+  Status Initialize();
+
+  // Run the decoder until every batch entry is done or max_length is reached, then write the outputs.
+  Status Execute(const FeedsFetchesManager& ffm);
+
+ private:
+  // Scores the candidate tokens from the logits of a step, and selects the next beams: next_tokens_ and
+  // next_beam_indices_. Finished sequences go to the hypotheses of their batch entry.
+  Status ProcessLogits(const Tensor& logits, int cur_len);
+
+  // Writes the key/value state of the selected beams to the past buffers, from the presents of the step
+  void ReorderPast(const std::vector<OrtValue>& fetches, int past_sequence_length);
+
+  OpKernelContextInternal& context_;
+  const SessionState& session_state_;
+  const BeamSearch::Info& info_;
+  const std::vector<const OrtValue*>& implicit_inputs_;
+
+  int64_t eos_token_id_;
+  int64_t pad_token_id_;
+  bool early_stopping_;
+
+  int batch_size_ = 0;
+  int prompt_length_ = 0;
+  int max_length_ = 0;
+  int num_beams_ = 1;
+  int num_return_sequences_ = 1;
+  float length_penalty_ = 1.0f;
+
+  // the buffers below are allocated once and reused by every step
+  std::vector<float> beam_scores_;            // (batch_size * num_beams), sum of log probabilities of each beam
+  std::vector<int64_t> sequences_;            // (batch_size * num_beams, max_length), tokens of each beam
+  std::vector<int64_t> next_sequences_;       // sequences_ of the next step
+  std::vector<float> next_token_scores_;      // (num_beams * vocab_size), candidate scores of a batch entry
+  std::vector<int32_t> candidates_;           // (num_beams * vocab_size), candidates sorted by score
+  std::vector<int64_t> next_tokens_;          // (batch_size * num_beams)
+  std::vector<int32_t> next_beam_indices_;    // (batch_size * num_beams), beam each next beam continues
+  std::vector<BeamHypotheses> hypotheses_;    // (batch_size)
+  std::vector<bool> done_;                    // (batch_size)
+  std::vector<BufferUniquePtr> past_buffers_;  // (num_layers), the past of the next step with room for max_length
+};
+
+Status BeamSearchImpl::Initialize() {
+  const auto* input_ids = context_.Input<Tensor>(0);
+  const auto& input_dims = input_ids->Shape().GetDims();
+  if (input_dims.size() != 2 || input_dims[1] < 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "BeamSearch input 'input_ids' should have the shape (batch_size, sequence_length) with "
+                           "sequence_length > 0. Got shape of ", input_ids->Shape());
+  }
+  batch_size_ = static_cast<int>(input_dims[0]);
+  prompt_length_ = static_cast<int>(input_dims[1]);
+
+  auto read_scalar = [this](int index, const char* name, auto default_value, auto& value) -> Status {
+    using TValue = decltype(default_value);
+    const auto* tensor = context_.Input<Tensor>(index);
+    if (tensor == nullptr) {
+      value = default_value;
+      return Status::OK();
+    }
+    if (tensor->Shape().Size() != 1) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "BeamSearch input '", name,
+                             "' should be a scalar tensor. Got shape of ", tensor->Shape());
+    }
+    value = static_cast<typename std::remove_reference<decltype(value)>::type>(*tensor->Data<TValue>());
+    return Status::OK();
+  };
+  ORT_RETURN_IF_ERROR(read_scalar(1, "max_length", int64_t{0}, max_length_));
+  ORT_RETURN_IF_ERROR(read_scalar(2, "num_beams", int64_t{1}, num_beams_));
+  ORT_RETURN_IF_ERROR(read_scalar(3, "num_return_sequences", int64_t{1}, num_return_sequences_));
+  ORT_RETURN_IF_ERROR(read_scalar(4, "length_penalty", 1.0f, length_penalty_));
+
+  if (max_length_ < prompt_length_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "BeamSearch max_length ", max_length_,
+                           " is less than the sequence length of input_ids ", prompt_length_);
+  }
+  if (num_beams_ < 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "BeamSearch num_beams should be positive. Got ",
+                           num_beams_);
+  }
+  if (num_return_sequences_ < 1 || num_return_sequences_ > num_beams_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "BeamSearch num_return_sequences should be in [1, ",
+                           num_beams_, "]. Got ", num_return_sequences_);
+  }
+
+  const size_t num_rows = static_cast<size_t>(batch_size_) * num_beams_;
+  // only the first beam of each batch entry is live at the start, so the first step doesn't select the same token
+  // from identical beams
+  beam_scores_.assign(num_rows, -1e9f);
+  for (int b = 0; b < batch_size_; ++b) {
+    beam_scores_[static_cast<size_t>(b) * num_beams_] = 0.0f;
+  }
+
+  sequences_.assign(num_rows * max_length_, pad_token_id_);
+  next_sequences_.assign(num_rows * max_length_, pad_token_id_);
+  const int64_t* input_data = input_ids->Data<int64_t>();
+  for (size_t row = 0; row < num_rows; ++row) {
+    const int64_t* prompt = input_data + (row / num_beams_) * prompt_length_;
+    std::copy(prompt, prompt + prompt_length_, sequences_.begin() + row * max_length_);
+  }
+
+  next_tokens_.resize(num_rows);
+  next_beam_indices_.resize(num_rows);
+  hypotheses_.assign(batch_size_, BeamHypotheses(num_beams_, length_penalty_, early_stopping_));
+  done_.assign(batch_size_, false);
+
+  return Status::OK();
+}
+
+Status BeamSearchImpl::ProcessLogits(const Tensor& logits, int cur_len) {
+  const auto& dims = logits.Shape().GetDims();
+  const size_t num_rows = static_cast<size_t>(batch_size_) * num_beams_;
+  if (dims.size() != 3 || static_cast<size_t>(dims[0]) != num_rows) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The BeamSearch decoder output 'logits' should have the shape ",
+                           "(batch_size * num_beams, sequence_length, vocab_size). Got shape of ", logits.Shape());
+  }
+  const int64_t sequence_length = dims[1];
+  const int vocab_size = static_cast<int>(dims[2]);
+  const float* logits_data = logits.Data<float>();
+
+  const int num_candidates = num_beams_ * vocab_size;
+  next_token_scores_.resize(num_candidates);
+  candidates_.resize(num_candidates);
+
+  for (int b = 0; b < batch_size_; ++b) {
+    const size_t first_row = static_cast<size_t>(b) * num_beams_;
+    if (done_[b]) {
+      // a finished batch entry keeps generating padding
+      for (int i = 0; i < num_beams_; ++i) {
+        next_tokens_[first_row + i] = pad_token_id_;
+        next_beam_indices_[first_row + i] = static_cast<int32_t>(first_row);
+        beam_scores_[first_row + i] = 0.0f;
+      }
+      continue;
+    }
+
+    // scores of the candidates: the log softmax of the logits of the last token of each beam plus the beam score
+    for (int i = 0; i < num_beams_; ++i) {
+      const float* row = logits_data + ((first_row + i) * sequence_length + sequence_length - 1) * vocab_size;
+      const float max_logit = *std::max_element(row, row + vocab_size);
+      float sum = 0.0f;
+      for (int v = 0; v < vocab_size; ++v) {
+        sum += std::exp(row[v] - max_logit);
+      }
+      const float offset = beam_scores_[first_row + i] - max_logit - std::log(sum);
+      float* scores = next_token_scores_.data() + static_cast<size_t>(i) * vocab_size;
+      for (int v = 0; v < vocab_size; ++v) {
+        scores[v] = row[v] + offset;
+      }
+    }
+
+    // the 2 * num_beams best candidates: at least num_beams of them don't end their sequence
+    const int num_top = std::min(num_candidates, 2 * num_beams_);
+    std::iota(candidates_.begin(), candidates_.end(), 0);
+    std::partial_sort(candidates_.begin(), candidates_.begin() + num_top, candidates_.end(),
+                      [this](int32_t a, int32_t b) {
+                        return next_token_scores_[a] > next_token_scores_[b] ||
+                               (next_token_scores_[a] == next_token_scores_[b] && a < b);
+                      });
+
+    int num_next = 0;
+    for (int rank = 0; rank < num_top && num_next < num_beams_; ++rank) {
+      const int32_t candidate = candidates_[rank];
+      const size_t beam_row = first_row + candidate / vocab_size;
+      const int64_t token = candidate % vocab_size;
+      const float score = next_token_scores_[candidate];
+      if (token == eos_token_id_) {
+        // only the end of a sequence among the num_beams best candidates is a finished sequence
+        if (rank < num_beams_) {
+          hypotheses_[b].Add(sequences_.data() + beam_row * max_length_, cur_len, score);
+        }
+        continue;
+      }
+      next_tokens_[first_row + num_next] = token;
+      next_beam_indices_[first_row + num_next] = static_cast<int32_t>(beam_row);
+      beam_scores_[first_row + num_next] = score;
+      ++num_next;
+    }
+    if (num_next < num_beams_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The BeamSearch decoder vocabulary is too small for ", num_beams_,
+                             " beams");
+    }
+
+    done_[b] = hypotheses_[b].IsDone(next_token_scores_[candidates_[0]], cur_len);
+  }
+
+  // the sequences of the next beams are the ones of the beams they continue plus their token
+  for (size_t row = 0; row < num_rows; ++row) {
+    const int64_t* src = sequences_.data() + next_beam_indices_[row] * static_cast<size_t>(max_length_);
+    int64_t* dst = next_sequences_.data() + row * max_length_;
+    std::copy(src, src + cur_len, dst);
+    dst[cur_len] = next_tokens_[row];
+  }
+  sequences_.swap(next_sequences_);
+
+  return Status::OK();
+}
+
+void BeamSearchImpl::ReorderPast(const std::vector<OrtValue>& fetches, int past_sequence_length) {
+  const size_t num_rows = static_cast<size_t>(batch_size_) * num_beams_;
+  const size_t row_size = static_cast<size_t>(info_.num_heads) * past_sequence_length * info_.head_size;
+  for (int layer = 0; layer < info_.num_layers; ++layer) {
+    const float* present = fetches[1 + layer].Get<Tensor>().Data<float>();
+    float* past = static_cast<float*>(past_buffers_[layer].get());
+    for (size_t kv = 0; kv < 2; ++kv) {
+      for (size_t row = 0; row < num_rows; ++row) {
+        const float* src = present + (kv * num_rows + next_beam_indices_[row]) * row_size;
+        std::copy(src, src + row_size, past + (kv * num_rows + row) * row_size);
+      }
+    }
+  }
+}
+
+Status BeamSearchImpl::Execute(const FeedsFetchesManager& ffm) {
+  auto cpu_allocator = session_state_.GetExecutionProviders()
+                           .Get(onnxruntime::kCpuExecutionProvider)
+                           ->GetAllocator(0, OrtMemTypeDefault);
+  const auto& cpu_info = cpu_allocator->Info();
+  const int64_t num_rows = static_cast<int64_t>(batch_size_) * num_beams_;
+
+  // the past of each layer has room for the state of max_length tokens, and is viewed with the shape of each step
+  const size_t past_capacity = SafeInt<size_t>(2) * num_rows * info_.num_heads * max_length_ * info_.head_size;
+  for (int layer = 0; layer < info_.num_layers; ++layer) {
+    past_buffers_.emplace_back(cpu_allocator->Alloc(past_capacity * sizeof(float)), BufferDeleter(cpu_allocator));
+  }
+
+  // the ids and positions of the prompt for the first step, then of the last token of each beam
+  std::vector<int64_t> input_ids(num_rows * prompt_length_);
+  std::vector<int64_t> position_ids(num_rows * prompt_length_);
+  for (int64_t row = 0; row < num_rows; ++row) {
+    std::copy(sequences_.begin() + row * max_length_, sequences_.begin() + row * max_length_ + prompt_length_,
+              input_ids.begin() + row * prompt_length_);
+    std::iota(position_ids.begin() + row * prompt_length_, position_ids.begin() + (row + 1) * prompt_length_, 0);
+  }
+
+  std::vector<OrtValue> feeds;
+  feeds.reserve(2 + info_.num_layers + info_.num_implicit_inputs);
+  feeds.push_back(MakeOrtValue(TensorShape({num_rows, prompt_length_}), input_ids.data(), cpu_info));
+  feeds.push_back(MakeOrtValue(TensorShape({num_rows, prompt_length_}), position_ids.data(), cpu_info));
+  for (int layer = 0; layer < info_.num_layers; ++layer) {
+    feeds.push_back(MakeOrtValue(TensorShape({2, num_rows, info_.num_heads, 0, info_.head_size}),
+                                 static_cast<float*>(past_buffers_[layer].get()), cpu_info));
+  }
+  for (const auto* entry : implicit_inputs_) {
+    feeds.push_back(*entry);
+  }
+
+  std::vector<OrtValue> fetches;
+  int cur_len = prompt_length_;
+  while (cur_len < max_length_) {
+    fetches.clear();
+    ORT_RETURN_IF_ERROR(utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
+                                               ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(),
+                                               context_.Logger()));
+
+    ORT_RETURN_IF_ERROR(ProcessLogits(fetches[0].Get<Tensor>(), cur_len));
+    ++cur_len;
+    if (std::all_of(done_.begin(), done_.end(), [](bool done) { return done; }) || cur_len == max_length_) {
+      break;
+    }
+
+    // the next step feeds the last token of each beam with the state of the tokens before it
+    if (cur_len - 1 == prompt_length_) {
+      input_ids.resize(num_rows);
+      position_ids.resize(num_rows);
+      feeds[0] = MakeOrtValue(TensorShape({num_rows, 1}), input_ids.data(), cpu_info);
+      feeds[1] = MakeOrtValue(TensorShape({num_rows, 1}), position_ids.data(), cpu_info);
+    }
+    std::copy(next_tokens_.begin(), next_tokens_.end(), input_ids.begin());
+    std::fill(position_ids.begin(), position_ids.end(), cur_len - 1);
+
+    const TensorShape past_shape({2, num_rows, info_.num_heads, cur_len - 1, info_.head_size});
+    for (int layer = 0; layer < info_.num_layers; ++layer) {
+      const auto& present = fetches[1 + layer].Get<Tensor>();
+      if (present.Shape() != past_shape) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The BeamSearch decoder output ",
+                               info_.subgraph_output_names[1 + layer], " should have the shape ", past_shape,
+                               ". Got shape of ", present.Shape());
+      }
+    }
+    if (num_beams_ == 1) {
+      // greedy search: the beams don't move, so the presents are the next pasts
+      for (int layer = 0; layer < info_.num_layers; ++layer) {
+        feeds[2 + layer] = fetches[1 + layer];
+      }
+    } else {
+      ReorderPast(fetches, cur_len - 1);
+      for (int layer = 0; layer < info_.num_layers; ++layer) {
+        feeds[2 + layer] = MakeOrtValue(past_shape, static_cast<float*>(past_buffers_[layer].get()), cpu_info);
+      }
+    }
+  }
+
+  // the beams still running at the end are candidates as well
+  for (int b = 0; b < batch_size_; ++b) {
+    if (done_[b]) {
+      continue;
+    }
+    for (int i = 0; i < num_beams_; ++i) {
+      const size_t row = static_cast<size_t>(b) * num_beams_ + i;
+      hypotheses_[b].Add(sequences_.data() + row * max_length_, cur_len, beam_scores_[row]);
+    }
+  }
+
+  Tensor* sequences = context_.Output(0, TensorShape({batch_size_, num_return_sequences_, max_length_}));
+  Tensor* scores = context_.Output(1, TensorShape({batch_size_, num_return_sequences_}));
+  int64_t* sequences_data = sequences->MutableData<int64_t>();
+  float* scores_data = scores != nullptr ? scores->MutableData<float>() : nullptr;
+  for (int b = 0; b < batch_size_; ++b) {
+    hypotheses_[b].Output(num_return_sequences_, max_length_, pad_token_id_,
+                          sequences_data + static_cast<size_t>(b) * num_return_sequences_ * max_length_,
+                          scores_data != nullptr ? scores_data + static_cast<size_t>(b) * num_return_sequences_
+                                                 : nullptr);
+  }
+
+  return Status::OK();
+}
+
+BeamSearch::BeamSearch(const OpKernelInfo& info) : OpKernel(info) {
+  // make sure the attribute was present even though we don't need it here.
+  // The GraphProto is loaded as a Graph instance by main Graph::Resolve,
+  // and a SessionState instance for executing the subgraph is created by InferenceSession.
+  ONNX_NAMESPACE::GraphProto proto;
+  ORT_ENFORCE(info.GetAttr<ONNX_NAMESPACE::GraphProto>("decoder", &proto).IsOK());
+  ORT_IGNORE_RETURN_VALUE(proto);
+
+  ORT_ENFORCE(info.GetAttr<int64_t>("eos_token_id", &eos_token_id_).IsOK());
+  pad_token_id_ = info.GetAttrOrDefault<int64_t>("pad_token_id", eos_token_id_);
+  early_stopping_ = info.GetAttrOrDefault<int64_t>("early_stopping", 0) != 0;
+}
+
+// we need this to be in the .cc so 'unique_ptr<Info> info_' can be handled
+BeamSearch::~BeamSearch() = default;
+
+common::Status BeamSearch::SetupSubgraphExecutionInfo(const SessionState& session_state,
+                                                      const std::string& attribute_name,
+                                                      const SessionState& subgraph_session_state) {
+  ORT_ENFORCE(info_ == nullptr, "SetupSubgraphExecutionInfo should only be called once for each subgraph.");
+  ORT_UNUSED_PARAMETER(attribute_name);
+
+  const auto& node = Node();
+  info_ = onnxruntime::make_unique<BeamSearch::Info>(node, *subgraph_session_state.GetGraphViewer());
+
+  // the ids, positions and pasts are created by the kernel on CPU, the implicit inputs come from the outer graph
+  std::vector<std::string> feed_names = info_->subgraph_input_names;
+  for (auto& entry : node.ImplicitInputDefs()) {
+    feed_names.push_back(entry->Name());
+  }
+
+  size_t start_at = info_->subgraph_input_names.size();
+  std::vector<OrtDevice> feed_locations;
+  ORT_RETURN_IF_ERROR(controlflow::detail::FindDevicesForValues(session_state, feed_names, feed_locations, start_at));
+
+  std::unique_ptr<FeedsFetchesManager> ffm;
+  ORT_RETURN_IF_ERROR(FeedsFetchesManager::Create(feed_names, info_->subgraph_output_names,
+                                                  subgraph_session_state.GetOrtValueNameIdxMap(), ffm));
+  ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(subgraph_session_state, *ffm));
+
+  // the logits are scored and the presents reordered on CPU
+  const auto& cpu_allocator_info = session_state.GetExecutionProviders()
+                                       .Get(onnxruntime::kCpuExecutionProvider)
+                                       ->GetAllocator(0, OrtMemTypeDefault)
+                                       ->Info();
+  std::vector<const OrtMemoryInfo*> fetch_locations(info_->subgraph_output_names.size(), &cpu_allocator_info);
+
+  utils::FinalizeFeedFetchCopyInfo(subgraph_session_state, *ffm, feed_locations, fetch_locations);
+
+  feeds_fetches_manager_ = std::move(ffm);
+
+  return Status::OK();
+}
+
+Status BeamSearch::Compute(OpKernelContext* ctx) const {
+  auto* ctx_internal = static_cast<OpKernelContextInternal*>(ctx);
+  auto* session_state = ctx_internal->SubgraphSessionState("decoder");
+  ORT_ENFORCE(session_state, "Subgraph SessionState was not found for 'decoder' attribute.");
+  ORT_ENFORCE(feeds_fetches_manager_, "CreateFeedsFetchesManager must be called prior to execution of graph.");
+
+  BeamSearchImpl impl{*ctx_internal, *session_state, *info_, eos_token_id_, pad_token_id_, early_stopping_};
+  ORT_RETURN_IF_ERROR(impl.Initialize());
+  return impl.Execute(*feeds_fetches_manager_);
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/feeds_fetches_manager.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/controlflow/utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Generates sequences from a decoder subgraph by beam search, or greedy search with a single beam. Each step runs
+// the decoder on the last token of every beam with the key/value state of the tokens before it, then scores the
+// candidate tokens, keeps the best beams and reorders the state of the decoder to match them, without leaving the
+// kernel between steps.
+class BeamSearch : public OpKernel, public controlflow::IControlFlowKernel {
+ public:
+  BeamSearch(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* ctx) const override;
+
+  common::Status SetupSubgraphExecutionInfo(const SessionState& session_state,
+                                            const std::string& attribute_name,
+                                            const SessionState& subgraph_session_state) override;
+
+  // hide internal implementation details via forward declaration.
+  struct Info;
+  ~BeamSearch();
+
+ private:
+  int64_t eos_token_id_;
+  int64_t pad_token_id_;
+  bool early_stopping_;
+
+  // Info and FeedsFetchesManager re-used for each decoder step.
+  std::unique_ptr<Info> info_;
+  std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -2,7 +2,9 @@
 // Licensed under the MIT License.
 
 #include "attention.h"
+#include "core/framework/kernel_cost.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/mlas/inc/mlas.h"
 #include "onnx/defs/schema.h"
 #include "core/util/eigen_common_wrapper.h"
 #include "core/util/math.h"
@@ -12,6 +14,11 @@
 #include "core/providers/cpu/tensor/transpose.h"
 #include "core/common/safeint.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
 namespace onnxruntime {
 namespace contrib {
 // These ops are internal-only, so register outside of onnx
@@ -28,10 +35,21 @@ namespace contrib {
 
 REGISTER_KERNEL_TYPED(float)
 
+namespace attention_details {
+// From this sequence length on, the attention of each head is computed by tiles of queries and keys, so the
+// (S x S) matrix of the scores is never materialized
+constexpr int kMinSequenceLengthToBlock = 512;
+// Queries and keys per tile: a tile of scores is 64KB and stays in the L2 cache with the tiles of Q, K and V
+constexpr int kQueryBlockSize = 64;
+constexpr int kKeyBlockSize = 256;
+}  // namespace attention_details
+
 AttentionBase::AttentionBase(const OpKernelInfo& info) {
   int64_t num_heads = 0;
   ORT_ENFORCE(info.GetAttr("num_heads", &num_heads).IsOK() && num_heads > 0);
   num_heads_ = static_cast<int>(num_heads);
+
+  is_unidirectional_ = info.GetAttrOrDefault<int64_t>("unidirectional", 0) == 1;
 }
 
 Status AttentionBase::CheckInputs(const OpKernelContext* context) const {
@@ -39,8 +57,10 @@ Status AttentionBase::CheckInputs(const OpKernelContext* context) const {
   //   Input 0 - input       : (batch_size, sequence_length, hidden_size)
   //   Input 1 - weights     : (hidden_size, 3 * hidden_size)
   //   Input 2 - bias        : (3 * hidden_size)
-  //   Input 3 - mask_index  : (batch_size)
-  //   Output                : (batch_size, sequence_length, hidden_size)
+  //   Input 3 - mask_index  : (batch_size), optional
+  //   Input 4 - past        : (2, batch_size, num_heads, past_sequence_length, head_size), optional
+  //   Output 0              : (batch_size, sequence_length, hidden_size)
+  //   Output 1 - present    : (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size), optional
 
   const Tensor* input = context->Input<Tensor>(0);
   const auto dims = input->Shape().GetDims();
@@ -82,14 +102,31 @@ Status AttentionBase::CheckInputs(const OpKernelContext* context) const {
   }
 
   const Tensor* mask_index = context->Input<Tensor>(3);
-  const auto mask_dims = mask_index->Shape().GetDims();
-  if (mask_dims.size() != 1) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
-                           "Input 3 is expected to have 1 dimension, got ", mask_dims.size());
+  if (mask_index != nullptr) {
+    const auto mask_dims = mask_index->Shape().GetDims();
+    if (mask_dims.size() != 1) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 3 is expected to have 1 dimension, got ", mask_dims.size());
+    }
+    if (static_cast<int>(mask_dims[0]) != batch_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Inputs 3 and 0 shall have same length at dimension 0");
+    }
   }
-  if (static_cast<int>(mask_dims[0]) != batch_size) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
-                           "Inputs 3 and 0 shall have same length at dimension 0");
+
+  const Tensor* past = context->Input<Tensor>(4);
+  if (past != nullptr) {
+    const auto past_dims = past->Shape().GetDims();
+    if (past_dims.size() != 5) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 4 is expected to have 5 dimensions, got ", past_dims.size());
+    }
+    if (past_dims[0] != 2 || past_dims[1] != dims[0] || past_dims[2] != num_heads_ ||
+        past_dims[4] != hidden_size / num_heads_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 4 is expected to have shape (2, batch_size, num_heads, past_sequence_length, "
+                             "head_size), got ", past->Shape());
+    }
   }
 
   return Status::OK();
@@ -98,6 +135,22 @@ Status AttentionBase::CheckInputs(const OpKernelContext* context) const {
 template <typename T>
 Attention<T>::Attention(const OpKernelInfo& info) : OpKernel(info), AttentionBase(info) {}
 
+template <typename T>
+bool Attention<T>::GetCost(OpKernelContext& context, KernelCost& cost) const {
+  const auto& input_dims = context.Input<Tensor>(0)->Shape().GetDims();
+  if (input_dims.size() != 3) {
+    return false;
+  }
+
+  const int64_t batch_size = input_dims[0];
+  const int64_t sequence_length = input_dims[1];
+  const int64_t hidden_size = input_dims[2];
+  const int64_t num_tokens = batch_size * sequence_length;
+  cost.flops = 2 * num_tokens * hidden_size * 3 * hidden_size + 2 * 2 * num_tokens * sequence_length * hidden_size;
+  cost.bytes = kernel_cost::TensorBytes(context);
+  return true;
+}
+
 template <typename T>
 Status Attention<T>::Compute(OpKernelContext* context) const {
   ORT_RETURN_IF_ERROR(CheckInputs(context));
@@ -106,6 +159,7 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
   const Tensor* weights = context->Input<Tensor>(1);
   const Tensor* bias = context->Input<Tensor>(2);
   const Tensor* mask_index = context->Input<Tensor>(3);
+  const Tensor* past = context->Input<Tensor>(4);
 
   const auto dims = input->Shape().GetDims();
   const int batch_size = static_cast<int>(dims[0]);
@@ -113,14 +167,26 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
   const int hidden_size = static_cast<int>(dims[2]);
   const int head_size = hidden_size / num_heads_;
 
+  // the keys and values are the ones of the past tokens followed by the ones of the input tokens
+  const int past_sequence_length = past != nullptr ? static_cast<int>(past->Shape()[3]) : 0;
+  const int all_sequence_length = past_sequence_length + sequence_length;
+
   TensorShape output_shape(dims);
   Tensor* output = context->Output(0, output_shape);
 
+  std::vector<int64_t> present_dims{2, batch_size, num_heads_, all_sequence_length, head_size};
+  TensorShape present_shape(present_dims);
+  Tensor* present = context->Output(1, present_shape);
+
   constexpr size_t element_size = sizeof(T);
 
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
+  if (past == nullptr && present == nullptr && sequence_length >= attention_details::kMinSequenceLengthToBlock) {
+    return ComputeBlocked(context, *input, *weights, *bias, mask_index, allocator, *output);
+  }
+
   // STEP.1: gemm_data(BS, 3NH) = input(BS, NH) x weights(NH, 3NH) + bias(3NH)
   auto gemm_data = allocator->Alloc(SafeInt<size_t>(batch_size) * sequence_length * 3 * hidden_size * element_size);
   BufferUniquePtr gemm_buffer(gemm_data, BufferDeleter(allocator));
@@ -177,23 +243,59 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
     });
   }
 
-  // STEP.2: scratch(B, N, S, S) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S, H -> B, N, H, S) + 1 x mask_index(B -> B, 1, 1, 1)
+  // present(2, B, N, L, H) = concat(past(2, B, N, P, H), K, V) with L = P + S. Without present, the concatenation
+  // only lives in the temp space. The attention reads the keys and values of all the L tokens from it.
+  const T* K_all = K;
+  const T* V_all = V;
+  BufferUniquePtr kv_buffer;
+  if (past != nullptr || present != nullptr) {
+    T* kv_data = nullptr;
+    if (present != nullptr) {
+      kv_data = present->template MutableData<T>();
+    } else {
+      kv_data = reinterpret_cast<T*>(allocator->Alloc(
+          SafeInt<size_t>(2) * batch_size * num_heads_ * all_sequence_length * head_size * element_size));
+      kv_buffer = BufferUniquePtr(kv_data, BufferDeleter(allocator));
+    }
+    const T* past_data = past != nullptr ? past->template Data<T>() : nullptr;
+    const int past_chunk = past_sequence_length * head_size;
+    const int new_chunk = sequence_length * head_size;
+    const int all_chunk = all_sequence_length * head_size;
+
+    // one task per (K or V, batch, head): the state of the past tokens, then the one of the input tokens
+    const int loop_len = 2 * batch_size * num_heads_;
+    concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), loop_len, [&](int32_t i) {
+      const int kv_index = i / (batch_size * num_heads_);
+      const int head_index = i % (batch_size * num_heads_);
+      T* dest = kv_data + static_cast<size_t>(i) * all_chunk;
+      if (past_chunk > 0) {
+        memcpy(dest, past_data + static_cast<size_t>(i) * past_chunk, past_chunk * element_size);
+      }
+      const T* src = (kv_index == 0 ? K : V) + static_cast<size_t>(head_index) * new_chunk;
+      memcpy(dest + past_chunk, src, new_chunk * element_size);
+    });
+    K_all = kv_data;
+    V_all = kv_data + static_cast<size_t>(batch_size) * num_heads_ * all_chunk;
+  }
+
+  // STEP.2: scratch(B, N, S, L) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, L, H -> B, N, H, L) + 1 x mask_index(B -> B, 1, 1, 1)
+  //         When unidirectional, the scores of the tokens after the current one are masked as well.
   auto scratch_data = allocator->Alloc(
-      SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * sequence_length * element_size);
+      SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * all_sequence_length * element_size);
   BufferUniquePtr scratch_buffer(scratch_data, BufferDeleter(allocator));
 
   {
-    auto scratch_broadcast_data = allocator->Alloc(SafeInt<size_t>(batch_size) * sequence_length * element_size);
+    auto scratch_broadcast_data = allocator->Alloc(SafeInt<size_t>(batch_size) * all_sequence_length * element_size);
     BufferUniquePtr scratch_broadcast_buffer(scratch_broadcast_data, BufferDeleter(allocator));
-    memset(scratch_broadcast_data, 0, batch_size * sequence_length * element_size);
+    memset(scratch_broadcast_data, 0, batch_size * all_sequence_length * element_size);
     T* p_scratch_broadcast_current_data = reinterpret_cast<T*>(scratch_broadcast_data);
-    for (int b_i = 0; b_i < batch_size; b_i++) {
+    for (int b_i = 0; b_i < batch_size && mask_index != nullptr; b_i++) {
       // TODO: mask_index can be used in softmax to save some calculation.
       int mask = mask_index->template Data<int32_t>()[b_i];
-      for (int m_i = mask; m_i < sequence_length; m_i++) {
+      for (int m_i = mask; m_i < all_sequence_length; m_i++) {
         p_scratch_broadcast_current_data[m_i] = static_cast<T>(-10000.0);
       }
-      p_scratch_broadcast_current_data += sequence_length;
+      p_scratch_broadcast_current_data += all_sequence_length;
     }
 
     const int loop_len = batch_size * num_heads_;
@@ -201,90 +303,89 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
 
     concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), loop_len, [&](int32_t i) {
       const int batch_index = i / num_heads_;
-      // broadcast masks (B) -> (B.N.)S.S
-      const T* broadcast_data_src = reinterpret_cast<T*>(scratch_broadcast_data) + batch_index * sequence_length;
-      T* broadcast_data_dest = reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i;
+      // broadcast masks (B) -> (B.N.)S.L
+      const T* broadcast_data_src = reinterpret_cast<T*>(scratch_broadcast_data) + batch_index * all_sequence_length;
+      T* broadcast_data_dest = reinterpret_cast<T*>(scratch_data) + sequence_length * all_sequence_length * i;
       for (int seq_index = 0; seq_index < sequence_length; seq_index++) {
-        memcpy(broadcast_data_dest, broadcast_data_src, sequence_length * sizeof(T));
-        broadcast_data_dest += sequence_length;
+        memcpy(broadcast_data_dest, broadcast_data_src, all_sequence_length * sizeof(T));
+        if (is_unidirectional_) {
+          // the input token seq_index is the token past_sequence_length + seq_index of the keys
+          for (int future_index = past_sequence_length + seq_index + 1; future_index < all_sequence_length;
+               future_index++) {
+            broadcast_data_dest[future_index] += static_cast<T>(-10000.0);
+          }
+        }
+        broadcast_data_dest += all_sequence_length;
       }
-
-      // gemm
-
-      //                   original           transposed            iteration
-      // A: Q              (BxNxSxH)          (B.N.)S x H            S x H
-      // B: K'             (BxNxSxH)          (B.N.)H x S            H x S
-      // C: scratch_data   (BxNxSxS)          (B.N.)S x S            S x S
-
-      math::Gemm<T, concurrency::ThreadPool>(
-          CblasNoTrans,
-          CblasTrans,
-          sequence_length,
-          sequence_length,
-          head_size,
-          alpha,
-          Q + sequence_length * head_size * i,
-          K + sequence_length * head_size * i,
-          1.0,
-          reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i,
-          nullptr);
     });
+
+    //                   original           transposed            iteration
+    // A: Q              (BxNxSxH)          (B.N.)S x H            S x H
+    // B: K'             (BxNxLxH)          (B.N.)H x L            H x L
+    // C: scratch_data   (BxNxSxL)          (B.N.)S x L            S x L
+
+    MlasGemmBatch(CblasNoTrans,
+                  CblasTrans,
+                  sequence_length,
+                  all_sequence_length,
+                  head_size,
+                  alpha,
+                  Q,
+                  head_size,
+                  sequence_length * head_size,
+                  K_all,
+                  head_size,
+                  all_sequence_length * head_size,
+                  1.0f,
+                  reinterpret_cast<T*>(scratch_data),
+                  all_sequence_length,
+                  sequence_length * all_sequence_length,
+                  loop_len,
+                  context->GetOperatorThreadPool());
   }
 
-  // STEP.3: P(B, N, S, S) = Softmax(scratch)
+  // STEP.3: P(B, N, S, L) = Softmax(scratch)
   {
     const int N = batch_size * num_heads_ * sequence_length;
-    const int D = sequence_length;
-
-    concurrency::ThreadPool::TryBatchParallelFor(context->GetOperatorThreadPool(), N, [&](int j) {
-      float* x = reinterpret_cast<T*>(scratch_data) + j * D;
-      float* y = x;
-
-      // e^x is represented as infinity if x is large enough, like 100.f.
-      // Infinity divided by Infinity is a NAN. Thus, softmax gets a NAN if one or more item are large enough.
-      // a math transform as below is leveraged to get a stable softmax:
-      // e^xi/(e^x1 + ...e^xn) = e^(xi - max) / (e^(x1 - max) + ... + e^(xn - max))
-      float max = -std::numeric_limits<float>::infinity();
-      for (int i = 0; i < D; i++) {
-        if (max < x[i]) max = x[i];
-      }
-      for (int i = 0; i < D; i++) {
-        y[i] = expf(x[i] - max);
-      }
-
-      double sum = 0.0;
-
-      for (int i = 0; i < D; i++) {
-        sum += x[i];
-      }
-
-      if (sum == 0) {
-        for (int i = 0; i < D; i++) {
-          y[i] = 1.0f / (float)D;
-        }
-      } else {
-        for (int i = 0; i < D; i++) {
-          y[i] = x[i] / (float)sum;
-        }
-      }
-    });
+    const int D = all_sequence_length;
+
+    // The softmax is computed in place. MLAS subtracts the maximum of each row before computing
+    // the exponentials to get a stable softmax:
+    // e^xi/(e^x1 + ...e^xn) = e^(xi - max) / (e^(x1 - max) + ... + e^(xn - max))
+    MlasComputeSoftmax(reinterpret_cast<T*>(scratch_data),
+                       reinterpret_cast<T*>(scratch_data),
+                       N,
+                       D,
+                       false,
+                       context->GetOperatorThreadPool());
   }
 
-  // STEP.4: out_tmp(B, N, S, H) = P(B, N, S, S) x V(B, N, S, H)
+  // STEP.4: out_tmp(B, N, S, H) = P(B, N, S, L) x V(B, N, L, H)
   auto out_tmp_data = allocator->Alloc(
       SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * head_size * element_size);
   BufferUniquePtr out_tmp_buffer(out_tmp_data, BufferDeleter(allocator));
 
+  MlasGemmBatch(CblasNoTrans,
+                CblasNoTrans,
+                sequence_length,
+                head_size,
+                all_sequence_length,
+                1.0f,
+                reinterpret_cast<T*>(scratch_data),
+                all_sequence_length,
+                sequence_length * all_sequence_length,
+                V_all,
+                head_size,
+                all_sequence_length * head_size,
+                0.0f,
+                reinterpret_cast<T*>(out_tmp_data),
+                head_size,
+                sequence_length * head_size,
+                batch_size * num_heads_,
+                context->GetOperatorThreadPool());
+
   concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), batch_size * num_heads_, [&](int i) {
     T* current_tmp_data = reinterpret_cast<T*>(out_tmp_data) + sequence_length * head_size * i;
-    math::MatMul<T>(
-        sequence_length,
-        head_size,
-        sequence_length,
-        reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i,
-        V + sequence_length * head_size * i,
-        current_tmp_data,
-        nullptr);
 
     // transpose: out(B, S, N, H) = transpose out_tmp(B, N, S, H)
     const int batch_index = i / num_heads_;
@@ -301,5 +402,148 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+template <typename T>
+Status Attention<T>::ComputeBlocked(OpKernelContext* context, const Tensor& input, const Tensor& weights,
+                                    const Tensor& bias, const Tensor* mask_index, const AllocatorPtr& allocator,
+                                    Tensor& output) const {
+  using namespace attention_details;
+
+  const auto dims = input.Shape().GetDims();
+  const int batch_size = static_cast<int>(dims[0]);
+  const int sequence_length = static_cast<int>(dims[1]);
+  const int hidden_size = static_cast<int>(dims[2]);
+  const int head_size = hidden_size / num_heads_;
+  auto* tp = context->GetOperatorThreadPool();
+
+  // STEP.1: QKV(BS, 3NH) = input(BS, NH) x weights(NH, 3NH) + bias(3NH), as a single GEMM. The heads of Q, K and V
+  //         are read in place with a leading dimension of 3NH.
+  auto qkv_data = allocator->Alloc(SafeInt<size_t>(batch_size) * sequence_length * 3 * hidden_size * sizeof(T));
+  BufferUniquePtr qkv_buffer(qkv_data, BufferDeleter(allocator));
+  const T* QKV = reinterpret_cast<T*>(qkv_data);
+  const int qkv_ld = 3 * hidden_size;
+  {
+    MLAS_GEMM_EPILOGUE epilogue{bias.template Data<T>(), nullptr, nullptr, 0};
+    MlasGemm(CblasNoTrans, CblasNoTrans,
+             static_cast<size_t>(batch_size) * sequence_length, qkv_ld, hidden_size,
+             1.0f, input.template Data<T>(), hidden_size,
+             weights.template Data<T>(), qkv_ld,
+             0.0f, reinterpret_cast<T*>(qkv_data), qkv_ld,
+             &epilogue, tp);
+  }
+
+  // STEP.2: for each tile of queries of a head, out = softmax(1/sqrt(H) x Q x K') x V over the tiles of keys. The
+  //         softmax is computed online: the outputs are rescaled when the maximum score of a row increases.
+  //         The keys past mask_index are skipped rather than masked, as are the keys after the last query of the
+  //         tile when unidirectional. The scores of the other masked keys don't contribute, as in the unblocked
+  //         computation where their exponentials underflow to 0.
+  const int num_query_blocks = (sequence_length + kQueryBlockSize - 1) / kQueryBlockSize;
+  const int num_tasks = batch_size * num_heads_ * num_query_blocks;
+  const int max_batches = tp != nullptr ? tp->NumThreads() + 1 : 1;
+  const int num_batches = std::min(num_tasks, max_batches);
+
+  // a tile of scores plus the maximum and the sum of each of its rows, per batch of tasks
+  const size_t scratch_size = static_cast<size_t>(kQueryBlockSize) * (kKeyBlockSize + 2);
+  auto scratch_data = allocator->Alloc(SafeInt<size_t>(num_batches) * scratch_size * sizeof(T));
+  BufferUniquePtr scratch_buffer(scratch_data, BufferDeleter(allocator));
+
+  const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
+  T* output_data = output.template MutableData<T>();
+
+  concurrency::ThreadPool::TryBatchParallelFor(
+      tp, num_batches,
+      [&](int32_t batch) {
+        T* scores = reinterpret_cast<T*>(scratch_data) + batch * scratch_size;
+        T* row_max = scores + kQueryBlockSize * kKeyBlockSize;
+        T* row_sum = row_max + kQueryBlockSize;
+
+        // the tasks are strided over the batches, the tasks of the last queries having the most keys when
+        // unidirectional
+        for (int task = batch; task < num_tasks; task += num_batches) {
+          const int batch_index = task / (num_heads_ * num_query_blocks);
+          const int head_index = (task / num_query_blocks) % num_heads_;
+          const int query_begin = (task % num_query_blocks) * kQueryBlockSize;
+          const int num_queries = std::min(kQueryBlockSize, sequence_length - query_begin);
+
+          int num_keys = sequence_length;
+          if (mask_index != nullptr) {
+            const int mask = mask_index->template Data<int32_t>()[batch_index];
+            if (mask > 0) {
+              num_keys = std::min(num_keys, mask);
+            }
+          }
+          if (is_unidirectional_) {
+            num_keys = std::min(num_keys, query_begin + num_queries);
+          }
+
+          const T* batch_qkv = QKV + static_cast<size_t>(batch_index) * sequence_length * qkv_ld;
+          const T* Q = batch_qkv + static_cast<size_t>(query_begin) * qkv_ld + head_index * head_size;
+          T* out = output_data + (static_cast<size_t>(batch_index) * sequence_length + query_begin) * hidden_size +
+                   head_index * head_size;
+
+          for (int key_begin = 0; key_begin < num_keys; key_begin += kKeyBlockSize) {
+            const int block_keys = std::min(kKeyBlockSize, num_keys - key_begin);
+            const T* K = batch_qkv + static_cast<size_t>(key_begin) * qkv_ld + hidden_size + head_index * head_size;
+            const T* V = K + hidden_size;
+
+            // scores(q, k) = 1/sqrt(H) x Q(q, H) x K'(H, k)
+            MlasGemm(CblasNoTrans, CblasTrans, num_queries, block_keys, head_size,
+                     alpha, Q, qkv_ld, K, qkv_ld, 0.0f, scores, block_keys, nullptr);
+
+            const bool first_block = key_begin == 0;
+            for (int q = 0; q < num_queries; ++q) {
+              T* row = scores + q * block_keys;
+              int row_keys = block_keys;
+              if (is_unidirectional_) {
+                // the tokens after the query, the first key of the first tile always being kept
+                row_keys = std::max(0, std::min(block_keys, query_begin + q + 1 - key_begin));
+                std::fill(row + row_keys, row + block_keys, std::numeric_limits<T>::lowest());
+              }
+
+              T new_max = row_keys > 0 ? *std::max_element(row, row + row_keys) : std::numeric_limits<T>::lowest();
+              if (!first_block) {
+                new_max = std::max(new_max, row_max[q]);
+                // the outputs and the sum so far were computed with the previous maximum
+                const T scale = std::exp(row_max[q] - new_max);
+                if (scale != 1.0f) {
+                  T* out_row = out + q * hidden_size;
+                  for (int h = 0; h < head_size; ++h) {
+                    out_row[h] *= scale;
+                  }
+                  row_sum[q] *= scale;
+                }
+              } else {
+                row_sum[q] = 0.0f;
+              }
+              row_max[q] = new_max;
+              for (int k = 0; k < block_keys; ++k) {
+                row[k] -= new_max;
+              }
+            }
+
+            MlasComputeExp(scores, scores, static_cast<size_t>(num_queries) * block_keys);
+            for (int q = 0; q < num_queries; ++q) {
+              const T* row = scores + q * block_keys;
+              row_sum[q] += std::accumulate(row, row + block_keys, 0.0f);
+            }
+
+            // out(q, H) += P(q, k) x V(k, H)
+            MlasGemm(CblasNoTrans, CblasNoTrans, num_queries, head_size, block_keys,
+                     1.0f, scores, block_keys, V, qkv_ld, first_block ? 0.0f : 1.0f, out, hidden_size, nullptr);
+          }
+
+          for (int q = 0; q < num_queries; ++q) {
+            const T inv_sum = 1.0f / row_sum[q];
+            T* out_row = out + q * hidden_size;
+            for (int h = 0; h < head_size; ++h) {
+              out_row[h] *= inv_sum;
+            }
+          }
+        }
+      },
+      num_batches);
+
+  return Status::OK();
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -14,7 +14,8 @@ class AttentionBase {
   AttentionBase(const OpKernelInfo& info);
   Status CheckInputs(const OpKernelContext* context) const;
 
-  int num_heads_;  // number of attention heads
+  int num_heads_;           // number of attention heads
+  bool is_unidirectional_;  // whether every token can only attend to previous tokens
 };
 
 template <typename T>
@@ -22,6 +23,14 @@ class Attention : public OpKernel, public AttentionBase {
  public:
   explicit Attention(const OpKernelInfo& info);
   Status Compute(OpKernelContext* context) const override;
+
+  // the projection of the input to Q, K and V, then the scores Q * K' and their product with V in all the heads
+  bool GetCost(OpKernelContext& context, KernelCost& cost) const override;
+
+ private:
+  // Computes the attention of long sequences by tiles, without the scores of all the pairs of tokens
+  Status ComputeBlocked(OpKernelContext* context, const Tensor& input, const Tensor& weights, const Tensor& bias,
+                        const Tensor* mask_index, const AllocatorPtr& allocator, Tensor& output) const;
 };
 
 }  // namespace contrib
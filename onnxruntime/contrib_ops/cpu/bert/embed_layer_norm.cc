@@ -3,32 +3,111 @@
 
 #include "embed_layer_norm.h"
 #include "embed_layer_norm_helper.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 #include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/gather.h"
 
-#include <atomic>
+#include <algorithm>
+#include <cmath>
 
 namespace onnxruntime {
 namespace contrib {
 // These ops are internal-only, so register outside of onnx
-#define REGISTER_KERNEL_TYPED(T)                                  \
-  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
-      EmbedLayerNormalization,                                    \
-      kMSDomain,                                                  \
-      1,                                                          \
-      T,                                                          \
-      kCpuExecutionProvider,                                      \
-      KernelDefBuilder()                                          \
-          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+#define REGISTER_KERNEL_TYPED(T)                                                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                                  \
+      EmbedLayerNormalization,                                                                    \
+      kMSDomain,                                                                                  \
+      1,                                                                                          \
+      T,                                                                                          \
+      kCpuExecutionProvider,                                                                      \
+      KernelDefBuilder()                                                                          \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())                                  \
+          .TypeConstraint("T2", std::vector<MLDataType>{DataTypeImpl::GetTensorType<float>(),     \
+                                                        DataTypeImpl::GetTensorType<MLFloat16>(), \
+                                                        DataTypeImpl::GetTensorType<int8_t>()}),  \
       EmbedLayerNorm<T>);
 
 REGISTER_KERNEL_TYPED(float)
 
+namespace {
+
+// An embedding table with float, float16 or int8 rows. The int8 rows are dequantized with a scale per row.
+class EmbeddingTable {
+ public:
+  EmbeddingTable(const Tensor& table, const Tensor* scale)
+      : data_(static_cast<const char*>(table.DataRaw())),
+        row_bytes_(table.Shape()[1] * static_cast<int64_t>(table.DataType()->Size())),
+        scales_(scale != nullptr ? scale->Data<float>() : nullptr) {
+    if (table.IsDataType<MLFloat16>()) {
+      kind_ = Kind::Float16;
+    } else if (table.IsDataType<int8_t>()) {
+      kind_ = Kind::Int8;
+    }
+  }
+
+  const void* Row(int64_t index) const { return data_ + index * row_bytes_; }
+  int64_t RowBytes() const { return row_bytes_; }
+
+  // Writes the row at index to y as float, or adds it to y if accumulate is true. buffer holds the float16 rows
+  // converted for the sum.
+  void GatherRow(int64_t index, float* y, float* buffer, int64_t hidden_size, bool accumulate) const {
+    EigenVectorArrayMap<float> output(y, hidden_size);
+    switch (kind_) {
+      case Kind::Float: {
+        ConstEigenVectorArrayMap<float> row(static_cast<const float*>(Row(index)), hidden_size);
+        if (accumulate) {
+          output += row;
+        } else {
+          output = row;
+        }
+        break;
+      }
+      case Kind::Float16: {
+        MlasConvertHalfToFloatBuffer(static_cast<const unsigned short*>(Row(index)), accumulate ? buffer : y,
+                                     static_cast<size_t>(hidden_size));
+        if (accumulate) {
+          output += ConstEigenVectorArrayMap<float>(buffer, hidden_size);
+        }
+        break;
+      }
+      case Kind::Int8: {
+        auto row = ConstEigenVectorArrayMap<int8_t>(static_cast<const int8_t*>(Row(index)), hidden_size)
+                       .cast<float>() *
+                   scales_[index];
+        if (accumulate) {
+          output += row;
+        } else {
+          output = row;
+        }
+        break;
+      }
+    }
+  }
+
+ private:
+  enum class Kind {
+    Float,
+    Float16,
+    Int8
+  };
+
+  const char* data_;
+  int64_t row_bytes_;
+  const float* scales_;
+  Kind kind_ = Kind::Float;
+};
+
+}  // namespace
+
 template <typename T>
 EmbedLayerNorm<T>::EmbedLayerNorm(const OpKernelInfo& info) : OpKernel(info) {}
 
 template <typename T>
 Status EmbedLayerNorm<T>::Compute(OpKernelContext* context) const {
+  // the embeddings are gathered as float whatever the type of their tables
+  static_assert(std::is_same<T, float>::value, "EmbedLayerNorm on CPU computes in float");
+
   ORT_RETURN_IF_ERROR(embed_layer_norm::CheckInputs(context));
 
   const Tensor* input_ids = context->Input<Tensor>(0);
@@ -65,62 +144,60 @@ Status EmbedLayerNorm<T>::Compute(OpKernelContext* context) const {
 
   auto input_ids_data = input_ids->template Data<int32_t>();
   auto segment_ids_data = segment_ids->template Data<int32_t>();
-  auto word_embedding_data = word_embedding->template Data<T>();
-  auto position_embedding_data = position_embedding->template Data<T>();
-  auto segment_embedding_data = segment_embedding->template Data<T>();
   auto gamma_data = gamma->template Data<T>();
   auto beta_data = beta->template Data<T>();
   auto output_data = output->template MutableData<T>();
 
-  // Calculate output
-  {
-    std::atomic_bool failed{false};
-
-    int n = batch_size * sequence_length;
-    concurrency::ThreadPool::TryBatchParallelFor(context->GetOperatorThreadPool(), n, [=, &failed](int index) {
-      int word_col_index = input_ids_data[index];
-      if (word_col_index < 0 || word_col_index >= word_embedding_length) {
-        failed.store(true, std::memory_order_release);
-        return;
-      }
-      int position_col_index = index % sequence_length;
-      if (position_col_index >= position_embedding_length) {
-        failed.store(true, std::memory_order_release);
-        return;
-      }
-      int segment_col_index = segment_ids_data[index];
-      if (segment_col_index < 0 || segment_col_index >= segment_embedding_length) {
-        failed.store(true, std::memory_order_release);
-        return;
-      }
+  // Check the indices first as the parallel loop below can't return an error.
+  const int n = batch_size * sequence_length;
+  if (sequence_length > position_embedding_length) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "input index out of range");
+  }
+  for (int index = 0; index < n; index++) {
+    if (input_ids_data[index] < 0 || input_ids_data[index] >= word_embedding_length ||
+        segment_ids_data[index] < 0 || segment_ids_data[index] >= segment_embedding_length) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "input index out of range");
+    }
+  }
 
-      T* y = output_data + index * hidden_size;
-      const T* input_word_embedding = word_embedding_data + word_col_index * hidden_size;
-      const T* input_position_embedding = position_embedding_data + position_col_index * hidden_size;
-      const T* input_segment_embedding = segment_embedding_data + segment_col_index * hidden_size;
+  const EmbeddingTable word_table(*word_embedding, context->Input<Tensor>(8));
+  const EmbeddingTable position_table(*position_embedding, context->Input<Tensor>(9));
+  const EmbeddingTable segment_table(*segment_embedding, context->Input<Tensor>(10));
 
-      T sum = static_cast<T>(0);
-      for (int i = 0; i < hidden_size; i++) {
-        T subtotal = input_word_embedding[i] + input_position_embedding[i] + input_segment_embedding[i];
-        y[i] = subtotal;
-        sum += subtotal;
-      }
-      T mean = sum / hidden_size;
-      sum = 0;
-      for (int i = 0; i < hidden_size; i++) {
-        T a = y[i] - mean;
-        y[i] = a;
-        sum += a * a;
-      }
-      T e = sqrt(sum / hidden_size + static_cast<T>(1.0e-13));
-      for (int i = 0; i < hidden_size; i++) {
-        y[i] = y[i] / e * gamma_data[i] + beta_data[i];
+  // Calculate output
+  {
+    ConstEigenVectorArrayMap<T> gamma_array(gamma_data, hidden_size);
+    ConstEigenVectorArrayMap<T> beta_array(beta_data, hidden_size);
+
+    // each task normalizes enough tokens to write about kGatherParallelBlockBytes of output
+    const int64_t tokens_per_block = GatherRowsPerBlock(n, hidden_size * static_cast<int64_t>(sizeof(T)));
+    const int64_t num_blocks = (n + tokens_per_block - 1) / tokens_per_block;
+
+    concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), static_cast<int32_t>(num_blocks),
+                                            [&](int32_t block) {
+      const int64_t begin = block * tokens_per_block;
+      const int64_t end = std::min<int64_t>(begin + tokens_per_block, n);
+      std::vector<float> buffer(static_cast<size_t>(hidden_size));
+
+      for (int64_t index = begin; index < end; index++) {
+        // the word rows are the ones read at random
+        if (index + kGatherPrefetchDistance < end) {
+          PrefetchGatherRow(word_table.Row(input_ids_data[index + kGatherPrefetchDistance]),
+                            static_cast<size_t>(word_table.RowBytes()));
+        }
+
+        T* y = output_data + index * hidden_size;
+        word_table.GatherRow(input_ids_data[index], y, buffer.data(), hidden_size, false);
+        position_table.GatherRow(index % sequence_length, y, buffer.data(), hidden_size, true);
+        segment_table.GatherRow(segment_ids_data[index], y, buffer.data(), hidden_size, true);
+
+        EigenVectorArrayMap<T> y_array(y, hidden_size);
+        const T mean = y_array.mean();
+        y_array -= mean;
+        const T e = std::sqrt(y_array.square().mean() + static_cast<T>(1.0e-13));
+        y_array = y_array / e * gamma_array + beta_array;
       }
     });
-
-    if (failed.load(std::memory_order_acquire)) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "input index out of range");
-    }
   }
 
   // Calculate mask
@@ -86,6 +86,22 @@ Status CheckInputs(const OpKernelContext* context) {
                            "gamma is expected to have size of ", word_embedding_dims[1], ", got ", gamma_dims[0]);
   }
 
+  // int8 embedding tables are dequantized with a scale per row
+  const char* table_names[] = {"word_embedding", "position_embedding", "segment_embedding"};
+  for (int i = 0; i < 3; ++i) {
+    const Tensor* table = context->Input<Tensor>(2 + i);
+    const Tensor* scale = context->Input<Tensor>(8 + i);  // optional. nullptr if not provided
+    if (table->IsDataType<int8_t>()) {
+      if (nullptr == scale || scale->Shape().NumDimensions() != 1 || scale->Shape()[0] != table->Shape()[0]) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "int8 ", table_names[i], " requires a 1D scale with one value per row");
+      }
+    } else if (nullptr != scale) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "The scale of ", table_names[i], " is only used by an int8 table");
+    }
+  }
+
   return Status::OK();
 }
 
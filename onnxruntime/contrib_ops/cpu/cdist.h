@@ -8,10 +8,8 @@
 #include "core/framework/op_kernel.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/util/math_cpuonly.h"
+#include "core/util/math.h"
 #include "assert.h"
-#ifndef USE_OPENMP
-#include "core/util/eigen_common_wrapper.h"
-#endif
 
 namespace onnxruntime {
 namespace contrib {
@@ -32,61 +30,52 @@ void cdist_single_threaded(const T* a, const T* b, T* dest, size_t ma, size_t mb
   }
 }
 
-template <typename T, typename ElemFunc>
-class CDistOneBlock {
- public:
-  const T* a;
-  const T* b;
-  T* dest;
-  size_t mb;
-  size_t n;
-
-  CDistOneBlock(const T* a1, const T* b1, T* dest1, size_t mb1, size_t n1)
-      : a(a1), b(b1), dest(dest1), mb(mb1), n(n1) {}
-
-  void operator()(Eigen::Index start, Eigen::Index end) {
-    Eigen::Index mb_local = mb;
-    Eigen::Index i = start / mb_local;
-    Eigen::Index j = start - i * mb_local;
-    assert(i * mb_local + j == start);
-    Eigen::Index i_end = end / mb_local;
-    Eigen::Index j_end = end - i_end * mb_local;
-    assert(i_end * mb_local + j_end == end);
-
-    T* dest_local = dest + start;
-    ElemFunc f;
-    const T* a1 = a + n * i;
-    for (; i != i_end; ++i) {
-      a1 = a + n * i;
-      for (; j != mb_local; ++j) {
-        const T* b1 = b + n * j;
-        *dest_local++ = f(a1, b1, n);
-      }
-      j = 0;
-    }
-    a1 = a + n * i;
-    for (j = 0; j != j_end; ++j) {
-      const T* b1 = b + n * j;
-      *dest_local++ = f(a1, b1, n);
-    }
-    assert(dest_local == dest + end);
-  }
-};
-
+// As cdist_single_threaded, with the rows of a split between the threads of tp.
 template <typename T, typename ElemFunc>
 void cdist(const T* a, const T* b, T* dest, size_t ma, size_t mb, size_t n, concurrency::ThreadPool* tp) {
-#ifndef USE_OPENMP
-  if (tp == nullptr) {
-#else
-  (void)tp;
-#endif
-    return cdist_single_threaded<T, ElemFunc>(a, b, dest, ma, mb, n);
-#ifndef USE_OPENMP
-  }
-  Eigen::ThreadPoolDevice device(&tp->GetHandler(), tp->NumThreads());
-  device.parallelFor(ma * mb, Eigen::TensorOpCost(0, 0, static_cast<double>(3 * n)),
-                     CDistOneBlock<T, ElemFunc>(a, b, dest, mb, n));
-#endif
+  concurrency::ThreadPool::TryBatchParallelFor(tp, static_cast<int32_t>(ma), [&](ptrdiff_t i) {
+    cdist_single_threaded<T, ElemFunc>(a + n * i, b, dest + mb * i, 1, mb, n);
+  });
+}
+
+// dest = -2 * a * b^T
+template <typename T>
+void cdist_gemm(const T* a, const T* b, T* dest, size_t ma, size_t mb, size_t n, concurrency::ThreadPool* tp);
+
+template <>
+inline void cdist_gemm<float>(const float* a, const float* b, float* dest, size_t ma, size_t mb, size_t n,
+                              concurrency::ThreadPool* tp) {
+  math::Gemm<float, concurrency::ThreadPool>(CblasNoTrans, CblasTrans, ma, mb, n, -2.f, a, b, 0.f, dest, tp);
+}
+
+template <>
+inline void cdist_gemm<double>(const double* a, const double* b, double* dest, size_t ma, size_t mb, size_t n,
+                               concurrency::ThreadPool*) {
+  EigenMatrixMapRowMajor<double>(dest, ma, mb).noalias() =
+      -2.0 * ConstEigenMatrixMapRowMajor<double>(a, ma, n) * ConstEigenMatrixMapRowMajor<double>(b, mb, n).transpose();
+}
+
+// Computes the squared Euclidean distances as ||a||^2 + ||b||^2 - 2 * a * b^T, so the bulk of the work is a single
+// GEMM instead of ma * mb dot products. The distances are clamped at 0 as the cancellation of the sum can leave
+// slightly negative values for (nearly) equal rows.
+//\param norms: buffer of ma + mb elements
+template <typename T>
+void cdist_sqeuclidean_gemm(const T* a, const T* b, T* dest, size_t ma, size_t mb, size_t n, bool take_sqrt,
+                            T* norms, concurrency::ThreadPool* tp) {
+  EigenVectorMap<T> norms_a(norms, ma);
+  EigenVectorMap<T> norms_b(norms + ma, mb);
+  norms_a = ConstEigenMatrixMapRowMajor<T>(a, ma, n).rowwise().squaredNorm();
+  norms_b = ConstEigenMatrixMapRowMajor<T>(b, mb, n).rowwise().squaredNorm();
+
+  cdist_gemm<T>(a, b, dest, ma, mb, n, tp);
+
+  concurrency::ThreadPool::TryBatchParallelFor(tp, static_cast<int32_t>(ma), [&](ptrdiff_t i) {
+    auto row = EigenVectorArrayMap<T>(dest + mb * i, mb);
+    row = (row + norms_b.array() + norms_a[i]).max(T(0));
+    if (take_sqrt) {
+      row = row.sqrt();
+    }
+  });
 }
 
 template <typename T>
@@ -131,23 +120,32 @@ class CDist final : public OpKernel {
     TensorShape output_shape = {shape_a[0], shape_b[0]};
     Tensor* C = context->Output(0, output_shape);
     T* output = C->MutableData<T>();
-    switch (mode_) {
-      case EUCLIDEAN:
-        if (shape_a[1] >= 8)
-          cdist<T, EuclideanWithEigen<T> >(A->Data<T>(), B->Data<T>(), output, shape_a[0], shape_b[0], shape_a[1], tp);
-        else  // for smaller vector size, a raw loop is better
-          cdist<T, Euclidean<T> >(A->Data<T>(), B->Data<T>(), output, shape_a[0], shape_b[0], shape_a[1], tp);
-        break;
-      case SQEUCLIDEAN:
-        if (shape_a[1] >= 8)
-          cdist<T, SqeuclideanWithEigen<T> >(A->Data<T>(), B->Data<T>(), output, shape_a[0], shape_b[0], shape_a[1],
-                                             tp);
-        else  // for smaller vector size, a raw loop is better
-          cdist<T, Sqeuclidean<T> >(A->Data<T>(), B->Data<T>(), output, shape_a[0], shape_b[0], shape_a[1], tp);
-        break;
-      default:
-        return Status(ONNXRUNTIME, NOT_IMPLEMENTED);
+    const size_t ma = static_cast<size_t>(shape_a[0]);
+    const size_t mb = static_cast<size_t>(shape_b[0]);
+    const size_t n = static_cast<size_t>(shape_a[1]);
+    if (ma == 0 || mb == 0) {
+      return Status::OK();
+    }
+
+    // for smaller vector size, a raw loop is better
+    if (n < 8) {
+      switch (mode_) {
+        case EUCLIDEAN:
+          cdist<T, Euclidean<T> >(A->Data<T>(), B->Data<T>(), output, ma, mb, n, tp);
+          break;
+        case SQEUCLIDEAN:
+          cdist<T, Sqeuclidean<T> >(A->Data<T>(), B->Data<T>(), output, ma, mb, n, tp);
+          break;
+        default:
+          return Status(ONNXRUNTIME, NOT_IMPLEMENTED);
+      }
+      return Status::OK();
     }
+
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+    auto norms = IAllocator::MakeUniquePtr<T>(alloc, ma + mb);
+    cdist_sqeuclidean_gemm<T>(A->Data<T>(), B->Data<T>(), output, ma, mb, n, mode_ == EUCLIDEAN, norms.get(), tp);
     return Status::OK();
   }
 };
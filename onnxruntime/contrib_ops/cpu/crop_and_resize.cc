@@ -16,6 +16,7 @@ limitations under the License.
 
 #include "contrib_ops/cpu/crop_and_resize.h"
 
+#include <algorithm>
 #include <cmath>
 #include "core/util/math_cpuonly.h"
 #include "core/common/common.h"
@@ -43,6 +44,52 @@ namespace contrib {
 
 ADD_TYPED_CROPANDRESIZE_OP(float);
 
+// The position in the input of each row or column of the crop of a roi, computed once for all the channels of the
+// roi: the two input coordinates it is interpolated from, its interpolation weight, and whether it is inside the
+// input.
+template <typename T>
+struct CropAxisTable {
+  std::vector<int64_t> low;
+  std::vector<int64_t> high;
+  std::vector<int64_t> closest;
+  std::vector<float> lerp;
+  std::vector<bool> inside;
+
+  void Init(int64_t pooled_size, int64_t size, T roi_start, T roi_end) {
+    low.resize(pooled_size);
+    high.resize(pooled_size);
+    closest.resize(pooled_size);
+    lerp.resize(pooled_size);
+    inside.resize(pooled_size);
+
+    T scale = (pooled_size > 1) ? (roi_end - roi_start) * (size - 1) / (pooled_size - 1) : 0;
+    for (int64_t p = 0; p < pooled_size; p++) {
+      T in = static_cast<T>((pooled_size > 1)
+                                ? roi_start * (size - 1) + p * scale
+                                : 0.5 * (roi_start + roi_end) * (size - 1));
+      if (p == pooled_size - 1) {
+        in = static_cast<T>((pooled_size > 1)
+                                ? roi_end * (size - 1)
+                                : 0.5 * (roi_start + roi_end) * (size - 1));
+      }
+      if (p == 0) {
+        in = static_cast<T>((pooled_size > 1)
+                                ? roi_start * (size - 1)
+                                : 0.5 * (roi_start + roi_end) * (size - 1));
+      }
+      inside[p] = !(in < 0 || in > size - 1);
+      if (!inside[p]) {
+        continue;
+      }
+
+      low[p] = static_cast<int>(floorf(static_cast<float>(in)));
+      high[p] = static_cast<int>(ceilf(static_cast<float>(in)));
+      closest[p] = static_cast<int>(roundf(static_cast<float>(in)));
+      lerp[p] = static_cast<float>(in - low[p]);
+    }
+  }
+};
+
 template <typename T>
 void CropAndResizeForward(const TensorShape& output_shape,
                           const T* bottom_data,
@@ -59,117 +106,70 @@ void CropAndResizeForward(const TensorShape& output_shape,
   int64_t channels = output_shape[1];
   int64_t pooled_height = output_shape[2];
   int64_t pooled_width = output_shape[3];
-
-  ThreadPool::TryBatchParallelFor(ttp, static_cast<int32_t>(n_rois), [&](int32_t n) {
-    int64_t index_n = n * channels * pooled_width * pooled_height;
-
-    const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
-    const auto roi_batch_ind = batch_indices_ptr[n];
-
-    T roi_start_w = offset_bottom_rois[1];
-    T roi_start_h = offset_bottom_rois[0];
-    T roi_end_w = offset_bottom_rois[3];
-    T roi_end_h = offset_bottom_rois[2];
-
-    T height_scale = (pooled_height > 1)
-                         ? (roi_end_h - roi_start_h) * (height - 1) / (pooled_height - 1)
-                         : 0;
-    T width_scale = (pooled_width > 1)
-                        ? (roi_end_w - roi_start_w) * (width - 1) / (pooled_width - 1)
-                        : 0;
-
-    for (auto ph = 0; ph < pooled_height; ph++) {
-      T in_y = static_cast<T>((pooled_height > 1)
-                                  ? roi_start_h * (height - 1) + ph * height_scale
-                                  : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
-      if (ph == pooled_height - 1) {
-        in_y = static_cast<T>((pooled_height > 1)
-                                  ? roi_end_h * (height - 1)
-                                  : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
-      }
-      if (ph == 0) {
-        in_y = static_cast<T>((pooled_height > 1)
-                                  ? roi_start_h * (height - 1)
-                                  : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
-      }
-      if (in_y < 0 || in_y > height - 1) {
-        for (int64_t pw = 0; pw < pooled_width; pw++) {
-          for (int64_t c = 0; c < channels; c++) {
-            int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-            int64_t index = index_n_c + ph * pooled_width + pw;
-            top_data[index] = extrapolation_value;
-          }
-        }
-        continue;
+  const bool bilinear = mode == "bilinear";
+
+  // the (roi, channel) pairs are split in contiguous ranges across the threads, so a range only computes the
+  // positions of the crop of a roi once for all its channels
+  const int64_t num_tasks = n_rois * channels;
+  const auto num_batches = static_cast<int32_t>(
+      ttp == nullptr ? 1 : std::min<int64_t>(num_tasks, ttp->NumThreads() + 1));
+
+  ThreadPool::TryBatchParallelFor(ttp, num_batches, [&](int32_t batch) {
+    CropAxisTable<T> y_table;
+    CropAxisTable<T> x_table;
+    int64_t table_roi = -1;
+
+    for (int64_t task = num_tasks * batch / num_batches, end = num_tasks * (batch + 1) / num_batches; task < end;
+         ++task) {
+      const int64_t n = task / channels;
+      const int64_t c = task % channels;
+      if (n != table_roi) {
+        const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
+        y_table.Init(pooled_height, height, offset_bottom_rois[0], offset_bottom_rois[2]);
+        x_table.Init(pooled_width, width, offset_bottom_rois[1], offset_bottom_rois[3]);
+        table_roi = n;
       }
 
-      const int top_y_index = static_cast<int>(floorf(static_cast<float>(in_y)));
-      const int bottom_y_index = static_cast<int>(ceilf(static_cast<float>(in_y)));
-      const float y_lerp = static_cast<float>(in_y - top_y_index);
-
-      for (auto pw = 0; pw < pooled_width; pw++) {
-        T in_x = static_cast<T>((pooled_width > 1)
-                                    ? roi_start_w * (width - 1) + pw * width_scale
-                                    : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
-        if (pw == pooled_width - 1) {
-          in_x = static_cast<T>((pooled_width > 1)
-                                    ? roi_end_w * (width - 1)
-                                    : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
-        }
-        if (pw == 0) {
-          in_x = static_cast<T>((pooled_width > 1)
-                                    ? roi_start_w * (width - 1)
-                                    : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
-        }
-        if (in_x < 0 || in_x > width - 1) {
-          for (int64_t c = 0; c < channels; c++) {
-            int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-            int64_t index = index_n_c + ph * pooled_width + pw;
-            top_data[index] = extrapolation_value;
-          }
+      const T* offset_bottom_data =
+          bottom_data + static_cast<int64_t>((batch_indices_ptr[n] * channels + c) * height * width);
+      T* offset_top_data = top_data + task * pooled_height * pooled_width;
+
+      for (int64_t ph = 0; ph < pooled_height; ph++) {
+        T* top_row = offset_top_data + ph * pooled_width;
+        if (!y_table.inside[ph]) {
+          std::fill_n(top_row, pooled_width, static_cast<T>(extrapolation_value));
           continue;
         }
 
-        T output_val = extrapolation_value;
-        if (mode == "bilinear") {
-          const int left_x_index = static_cast<int>(floorf(static_cast<float>(in_x)));
-          const int right_x_index = static_cast<int>(ceilf(static_cast<float>(in_x)));
-          const float x_lerp = static_cast<float>(in_x - left_x_index);
-          auto top_left_index = top_y_index * width + left_x_index;
-          auto top_right_index = top_y_index * width + right_x_index;
-          auto bottom_left_index = bottom_y_index * width + left_x_index;
-          auto bottom_right_index = bottom_y_index * width + right_x_index;
-
-          for (auto c = 0; c < channels; c++) {
-            int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-            int64_t index = index_n_c + ph * pooled_width + pw;
-            const T* offset_bottom_data =
-                bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-            const float top_left(static_cast<float>(offset_bottom_data[top_left_index]));
-            const float top_right(static_cast<float>(offset_bottom_data[top_right_index]));
-            const float bottom_left(static_cast<float>(offset_bottom_data[bottom_left_index]));
-            const float bottom_right(static_cast<float>(offset_bottom_data[bottom_right_index]));
+        if (bilinear) {
+          const T* bottom_top_row = offset_bottom_data + y_table.low[ph] * width;
+          const T* bottom_bottom_row = offset_bottom_data + y_table.high[ph] * width;
+          const float y_lerp = y_table.lerp[ph];
+          for (int64_t pw = 0; pw < pooled_width; pw++) {
+            if (!x_table.inside[pw]) {
+              top_row[pw] = extrapolation_value;
+              continue;
+            }
+
+            const float x_lerp = x_table.lerp[pw];
+            const float top_left(static_cast<float>(bottom_top_row[x_table.low[pw]]));
+            const float top_right(static_cast<float>(bottom_top_row[x_table.high[pw]]));
+            const float bottom_left(static_cast<float>(bottom_bottom_row[x_table.low[pw]]));
+            const float bottom_right(static_cast<float>(bottom_bottom_row[x_table.high[pw]]));
             const float top = top_left + (top_right - top_left) * x_lerp;
             const float bottom = bottom_left + (bottom_right - bottom_left) * x_lerp;
-            output_val = top + (bottom - top) * y_lerp;
-            top_data[index] = output_val;
+            top_row[pw] = top + (bottom - top) * y_lerp;
           }
         } else {  // mode == "nearest"
-          const int closest_x_index = static_cast<int>(roundf(static_cast<float>(in_x)));
-          const int closest_y_index = static_cast<int>(roundf(static_cast<float>(in_y)));
-          auto closest_index = closest_y_index * width + closest_x_index;
-
-          for (auto c = 0; c < channels; c++) {
-            int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-            int64_t index = index_n_c + ph * pooled_width + pw;
-            const T* offset_bottom_data =
-                bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-            top_data[index] = static_cast<float>(offset_bottom_data[closest_index]);
+          const T* closest_row = offset_bottom_data + y_table.closest[ph] * width;
+          for (int64_t pw = 0; pw < pooled_width; pw++) {
+            top_row[pw] = x_table.inside[pw] ? static_cast<float>(closest_row[x_table.closest[pw]])
+                                             : extrapolation_value;
           }
         }
-      }  // for pw
-    }    // for ph
-  });    // for n
+      }  // for ph
+    }    // for (n, c)
+  }, num_batches);
 }
 
 template <typename T>
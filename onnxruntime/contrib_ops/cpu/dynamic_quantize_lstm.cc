@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/rnn/deep_cpu_lstm.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// DeepCpuLstmOp runs the GEMMs with the uint8 weights when the node is a DynamicQuantizeLSTM
+ONNX_OPERATOR_KERNEL_EX(
+    DynamicQuantizeLSTM,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<int32_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>()),
+    DeepCpuLstmOp);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,144 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/dynamic_quantize_matmul.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/common.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+#include "core/util/math_cpuonly.h"
+#include "core/util/qmath.h"
+
+#include <cmath>
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    DynamicQuantizeMatMul,
+    kMSDomain,
+    1,
+    uint8_t,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>()),
+    DynamicQuantizeMatMul<uint8_t>);
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    DynamicQuantizeMatMul,
+    kMSDomain,
+    1,
+    int8_t,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<int8_t>()),
+    DynamicQuantizeMatMul<int8_t>);
+
+// Computes the uint8 scale and zero point of A exactly like DynamicQuantizeLinear, so that the results match the
+// unfused DynamicQuantizeLinear -> MatMulInteger -> Cast -> Mul graph.
+static void GetQuantizationParameter(const float* data, int64_t num_of_elements, float& scale, uint8_t& zero_point) {
+  const float qmax = std::numeric_limits<uint8_t>::max();
+  const float qmin = std::numeric_limits<uint8_t>::min();
+
+  // ensure the input range includes zero
+  const float min = std::min(ConstEigenVectorMap<float>(data, num_of_elements).minCoeff(), 0.0f);
+  const float max = std::max(ConstEigenVectorMap<float>(data, num_of_elements).maxCoeff(), 0.0f);
+
+  scale = (max - min) / (qmax - qmin);
+  const float initial_zero_point = qmin - min / scale;
+  zero_point = static_cast<uint8_t>(std::nearbyintf(std::max(qmin, std::min(qmax, initial_zero_point))));
+}
+
+static void QGemm(int M, int N, int K, const uint8_t* a, uint8_t a_offset, const uint8_t* b, uint8_t b_offset,
+                  int32_t* c, concurrency::ThreadPool* thread_pool) {
+  QGemmu8u8_s32(M, N, K, a, K, a_offset, b, N, b_offset, c, N, thread_pool);
+}
+
+static void QGemm(int M, int N, int K, const uint8_t* a, uint8_t a_offset, const int8_t* b, int8_t b_offset,
+                  int32_t* c, concurrency::ThreadPool* thread_pool) {
+  QGemmu8s8_s32(M, N, K, a, K, a_offset, b, N, b_offset, c, N, thread_pool);
+}
+
+template <typename T>
+Status DynamicQuantizeMatMul<T>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const auto* a = ctx->Input<Tensor>(0);
+  const auto* b = ctx->Input<Tensor>(1);
+  const auto* b_scale_tensor = ctx->Input<Tensor>(2);
+  const auto* b_zero_point_tensor = ctx->Input<Tensor>(3);
+  const auto* bias_tensor = ctx->Input<Tensor>(4);
+  ORT_ENFORCE(a != nullptr && b != nullptr && b_scale_tensor != nullptr);
+
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(b_scale_tensor),
+                    "DynamicQuantizeMatMul : b_scale must be a scalar or 1D tensor of size 1");
+  const float b_scale = *b_scale_tensor->template Data<float>();
+  T b_zero_point = 0;
+  if (b_zero_point_tensor != nullptr) {
+    ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(b_zero_point_tensor),
+                      "DynamicQuantizeMatMul : b_zero_point must be a scalar or 1D tensor of size 1");
+    b_zero_point = *b_zero_point_tensor->template Data<T>();
+  }
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+  const auto M = static_cast<int>(helper.M());
+  const auto N = static_cast<int>(helper.N());
+  const auto K = static_cast<int>(helper.K());
+
+  const float* bias = nullptr;
+  if (bias_tensor != nullptr) {
+    ORT_RETURN_IF_NOT(bias_tensor->Shape().NumDimensions() == 1 && bias_tensor->Shape()[0] == N,
+                      "DynamicQuantizeMatMul : bias must be a 1D tensor of size N");
+    bias = bias_tensor->template Data<float>();
+  }
+
+  const int64_t a_size = a->Shape().Size();
+  if (y->Shape().Size() == 0 || a_size == 0) {
+    const auto rows = y->Shape().Size() / std::max(N, 1);
+    auto output = EigenMatrixMapRowMajor<float>(y->template MutableData<float>(), rows, N);
+    output.setZero();
+    if (bias != nullptr) {
+      output.rowwise() += ConstEigenVectorMap<float>(bias, N).transpose();
+    }
+    return Status::OK();
+  }
+
+  float a_scale;
+  uint8_t a_zero_point;
+  GetQuantizationParameter(a->template Data<float>(), a_size, a_scale, a_zero_point);
+
+#ifndef MLAS_SUPPORTS_GEMM_U8X8
+  // only the MLAS kernels apply zero points for u8s8
+  if (std::is_same<T, int8_t>::value && (a_zero_point != 0 || b_zero_point != 0)) {
+    ORT_NOT_IMPLEMENTED("DynamicQuantizeMatMul: Unsupported input types with zero point");
+  }
+#endif
+
+  // quantize all of A once, then reuse one int32 block for the product of each matrix pair
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+  auto quantized_a = IAllocator::MakeUniquePtr<uint8_t>(alloc, static_cast<size_t>(a_size));
+  MlasQuantizeLinear(a->template Data<float>(), quantized_a.get(), static_cast<size_t>(a_size), a_scale, a_zero_point);
+  auto gemm_output = IAllocator::MakeUniquePtr<int32_t>(alloc, static_cast<size_t>(M) * N);
+
+  const float multiplier = a_scale * b_scale;
+  for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+    QGemm(M, N, K, quantized_a.get() + helper.LeftOffsets()[i], a_zero_point,
+          b->template Data<T>() + helper.RightOffsets()[i], b_zero_point, gemm_output.get(), thread_pool);
+
+    // dequantize and add the bias while the block is still in cache
+    auto output = EigenMatrixMapRowMajor<float>(y->template MutableData<float>() + helper.OutputOffsets()[i], M, N);
+    output = ConstEigenMatrixMapRowMajor<int32_t>(gemm_output.get(), M, N).template cast<float>() * multiplier;
+    if (bias != nullptr) {
+      output.rowwise() += ConstEigenVectorMap<float>(bias, N).transpose();
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,243 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_elementwise.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+// Number of elements evaluated by each instruction before moving to the next one. The operands and results of one
+// block stay in the L1 cache for the programs the fusion creates.
+static constexpr int64_t kBlockSize = 256;
+
+// Minimum number of output bytes each thread computes before another thread is used.
+static constexpr int64_t kMinBytesPerThread = 64 * 1024;
+
+static bool IsUnary(FusedElementwise::OpCode op) {
+  return op >= FusedElementwise::OpCode::Abs;
+}
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  static const std::unordered_map<std::string, OpCode> op_codes{
+      {"Add", OpCode::Add},
+      {"Sub", OpCode::Sub},
+      {"Mul", OpCode::Mul},
+      {"Div", OpCode::Div},
+      {"Max", OpCode::Max},
+      {"Min", OpCode::Min},
+      {"Abs", OpCode::Abs},
+      {"Neg", OpCode::Neg},
+      {"Sqrt", OpCode::Sqrt},
+      {"Exp", OpCode::Exp},
+      {"Erf", OpCode::Erf},
+      {"Relu", OpCode::Relu},
+      {"Sigmoid", OpCode::Sigmoid},
+      {"Tanh", OpCode::Tanh},
+  };
+
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  ORT_ENFORCE(info.GetAttrs<std::string>("ops", ops).IsOK() && !ops.empty(), "FusedElementwise: ops is required");
+  ORT_ENFORCE(info.GetAttrs<int64_t>("operands", operands).IsOK() && operands.size() == 2 * ops.size(),
+              "FusedElementwise: operands must have two values for each op");
+
+  const auto num_inputs = static_cast<int64_t>(info.GetInputCount());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    auto op_code = op_codes.find(ops[i]);
+    ORT_ENFORCE(op_code != op_codes.end(), "FusedElementwise: unsupported op ", ops[i]);
+
+    // an instruction can only read the inputs and the results of the instructions before it
+    const int64_t num_values = num_inputs + static_cast<int64_t>(i);
+    Instruction instruction{op_code->second, {operands[2 * i], operands[2 * i + 1]}};
+    ORT_ENFORCE(instruction.operands[0] >= 0 && instruction.operands[0] < num_values,
+                "FusedElementwise: invalid operand for op ", i);
+    if (IsUnary(instruction.op)) {
+      instruction.operands[1] = -1;
+    } else {
+      ORT_ENFORCE(instruction.operands[1] >= 0 && instruction.operands[1] < num_values,
+                  "FusedElementwise: invalid operand for op ", i);
+    }
+    program_.push_back(instruction);
+  }
+}
+
+static void Evaluate(FusedElementwise::OpCode op, const float* a, const float* b, float* out, int64_t count) {
+  using OpCode = FusedElementwise::OpCode;
+  ConstEigenVectorArrayMap<float> x(a, count);
+  EigenVectorArrayMap<float> y(out, count);
+  switch (op) {
+    case OpCode::Add:
+      y = x + ConstEigenVectorArrayMap<float>(b, count);
+      break;
+    case OpCode::Sub:
+      y = x - ConstEigenVectorArrayMap<float>(b, count);
+      break;
+    case OpCode::Mul:
+      y = x * ConstEigenVectorArrayMap<float>(b, count);
+      break;
+    case OpCode::Div:
+      y = x / ConstEigenVectorArrayMap<float>(b, count);
+      break;
+    case OpCode::Max:
+      y = x.max(ConstEigenVectorArrayMap<float>(b, count));
+      break;
+    case OpCode::Min:
+      y = x.min(ConstEigenVectorArrayMap<float>(b, count));
+      break;
+    case OpCode::Abs:
+      y = x.abs();
+      break;
+    case OpCode::Neg:
+      y = -x;
+      break;
+    case OpCode::Sqrt:
+      y = x.sqrt();
+      break;
+    case OpCode::Exp:
+      MlasComputeExp(a, out, static_cast<size_t>(count));
+      break;
+    case OpCode::Erf:
+      MlasComputeErf(a, out, static_cast<size_t>(count));
+      break;
+    case OpCode::Relu:
+      y = x.max(0.0f);
+      break;
+    case OpCode::Sigmoid:
+      MlasComputeLogistic(a, out, static_cast<size_t>(count));
+      break;
+    case OpCode::Tanh:
+      MlasComputeTanh(a, out, static_cast<size_t>(count));
+      break;
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  const int num_inputs = context->InputCount();
+
+  // the output has the broadcast shape of the inputs
+  std::vector<int64_t> output_dims;
+  for (int i = 0; i < num_inputs; ++i) {
+    const auto& dims = context->Input<Tensor>(i)->Shape().GetDims();
+    if (dims.size() > output_dims.size()) {
+      output_dims.insert(output_dims.begin(), dims.size() - output_dims.size(), 1);
+    }
+    const size_t offset = output_dims.size() - dims.size();
+    for (size_t j = 0; j < dims.size(); ++j) {
+      if (output_dims[offset + j] == 1) {
+        output_dims[offset + j] = dims[j];
+      } else if (dims[j] != 1 && dims[j] != output_dims[offset + j]) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedElementwise: input ", i, " with shape ",
+                               context->Input<Tensor>(i)->Shape(), " can't be broadcast to the other inputs");
+      }
+    }
+  }
+
+  // each input is read either elementwise or repeated over the leading axes of the output, so the element of the
+  // input at output index n is at n % input_size.
+  const TensorShape output_shape(output_dims);
+  const int64_t output_size = output_shape.Size();
+  std::vector<const float*> input_data(num_inputs);
+  std::vector<int64_t> input_sizes(num_inputs);
+  for (int i = 0; i < num_inputs; ++i) {
+    const auto* input = context->Input<Tensor>(i);
+    const auto& dims = input->Shape().GetDims();
+    size_t first_axis = 0;
+    while (first_axis < dims.size() && dims[first_axis] == 1) {
+      ++first_axis;
+    }
+    for (size_t j = first_axis; j < dims.size(); ++j) {
+      if (dims[j] != output_dims[output_dims.size() - dims.size() + j]) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedElementwise: input ", i, " with shape ",
+                               input->Shape(), " can only be broadcast over the leading axes of the output shape ",
+                               output_shape);
+      }
+    }
+    input_data[i] = input->template Data<float>();
+    input_sizes[i] = input->Shape().Size();
+  }
+
+  Tensor* Y = context->Output(0, output_shape);
+  if (output_size == 0) {
+    return Status::OK();
+  }
+  float* output_data = Y->template MutableData<float>();
+
+  const int64_t num_blocks = (output_size + kBlockSize - 1) / kBlockSize;
+  const auto num_instructions = program_.size();
+
+  // evaluates the blocks [first, last). each value of the program, input or result, gets a slot of the scratch
+  // buffer unless it's read directly from the input or written directly to the output.
+  auto compute_blocks = [&](int64_t first, int64_t last) {
+    std::vector<float> scratch(static_cast<size_t>((num_inputs + num_instructions) * kBlockSize));
+    std::vector<const float*> values(num_inputs + num_instructions);
+
+    for (int64_t block = first; block < last; ++block) {
+      const int64_t start = block * kBlockSize;
+      const int64_t count = std::min(kBlockSize, output_size - start);
+
+      for (int i = 0; i < num_inputs; ++i) {
+        if (input_sizes[i] == output_size) {
+          values[i] = input_data[i] + start;
+          continue;
+        }
+
+        float* slot = scratch.data() + i * kBlockSize;
+        if (input_sizes[i] == 1) {
+          std::fill_n(slot, count, input_data[i][0]);
+        } else {
+          for (int64_t n = 0, index = start % input_sizes[i]; n < count; ++n) {
+            slot[n] = input_data[i][index];
+            if (++index == input_sizes[i]) {
+              index = 0;
+            }
+          }
+        }
+        values[i] = slot;
+      }
+
+      for (size_t k = 0; k < num_instructions; ++k) {
+        const auto& instruction = program_[k];
+        float* result = k + 1 == num_instructions ? output_data + start
+                                                  : scratch.data() + (num_inputs + k) * kBlockSize;
+        const float* b = instruction.operands[1] >= 0 ? values[instruction.operands[1]] : nullptr;
+        Evaluate(instruction.op, values[instruction.operands[0]], b, result, count);
+        values[num_inputs + k] = result;
+      }
+    }
+  };
+
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  int64_t num_ranges = 1;
+  if (tp != nullptr) {
+    num_ranges = std::min<int64_t>({static_cast<int64_t>(tp->NumThreads()) + 1, num_blocks,
+                                    output_size * static_cast<int64_t>(sizeof(float)) / kMinBytesPerThread});
+  }
+
+  if (num_ranges <= 1) {
+    compute_blocks(0, num_blocks);
+  } else {
+    tp->ParallelFor(static_cast<int32_t>(num_ranges), [&](int32_t range) {
+      compute_blocks(num_blocks * range / num_ranges, num_blocks * (range + 1) / num_ranges);
+    });
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
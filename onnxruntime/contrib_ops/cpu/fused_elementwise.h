@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Evaluates a chain of float elementwise ops in one pass over the output. The ops run one block of elements at a
+// time, so the intermediate values stay in cache instead of being written to full tensors.
+class FusedElementwise final : public OpKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+  enum class OpCode {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Max,
+    Min,
+    Abs,
+    Neg,
+    Sqrt,
+    Exp,
+    Erf,
+    Relu,
+    Sigmoid,
+    Tanh,
+  };
+
+  // operands index the inputs first, then the results of the previous instructions.
+  // the second operand of a unary op is -1.
+  struct Instruction {
+    OpCode op;
+    int64_t operands[2];
+  };
+
+ private:
+  std::vector<Instruction> program_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
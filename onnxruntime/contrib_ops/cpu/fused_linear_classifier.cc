@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_linear_classifier.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedLinearClassifier,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", std::vector<MLDataType>{DataTypeImpl::GetTensorType<std::string>(),
+                                                      DataTypeImpl::GetTensorType<int64_t>()}),
+    FusedLinearClassifier);
+
+// Number of rows preprocessed and scored together. The features of a block stay in the L2 cache for the models
+// of the pipelines this fusion targets.
+static constexpr int64_t kRowBlock = 64;
+
+FusedLinearClassifier::FusedLinearClassifier(const OpKernelInfo& info)
+    : OpKernel(info),
+      scale_(info.GetAttrsOrDefault<float>("scale")),
+      offset_(info.GetAttrsOrDefault<float>("offset")),
+      normalization_(ml::MakeNormalize(info.GetAttrOrDefault<std::string>("norm", "MAX"))),
+      threshold_(info.GetAttrOrDefault<float>("threshold", 1.0f)),
+      post_transform_(ml::MakeTransform(info.GetAttrOrDefault<std::string>("post_transform", "NONE"))),
+      intercepts_(info.GetAttrsOrDefault<float>("intercepts")),
+      classlabels_strings_(info.GetAttrsOrDefault<std::string>("classlabels_strings")),
+      classlabels_ints_(info.GetAttrsOrDefault<int64_t>("classlabels_ints")) {
+  std::vector<std::string> steps;
+  ORT_ENFORCE(info.GetAttrs<std::string>("steps", steps).IsOK() && !steps.empty(),
+              "FusedLinearClassifier: steps is required");
+  for (const auto& step : steps) {
+    if (step == "Scaler") {
+      ORT_ENFORCE(!scale_.empty() && scale_.size() == offset_.size(),
+                  "FusedLinearClassifier: the Scaler step requires scale and offset of the same size");
+      steps_.push_back(Step::Scaler);
+    } else if (step == "Normalizer") {
+      steps_.push_back(Step::Normalizer);
+    } else if (step == "Binarizer") {
+      steps_.push_back(Step::Binarizer);
+    } else {
+      ORT_THROW("FusedLinearClassifier: unsupported step ", step);
+    }
+  }
+
+  ORT_ENFORCE(info.GetAttrs<float>("coefficients", coefficients_).IsOK() && !coefficients_.empty(),
+              "FusedLinearClassifier: coefficients is required");
+  using_strings_ = !classlabels_strings_.empty();
+  class_count_ = static_cast<int64_t>(intercepts_.size());
+  ORT_ENFORCE(class_count_ > 0, "FusedLinearClassifier: intercepts is required");
+}
+
+bool FusedLinearClassifier::Preprocess(float* data, int64_t rows, int64_t num_features) const {
+  for (int64_t r = 0; r < rows; ++r) {
+    EigenVectorArrayMap<float> row(data + r * num_features, num_features);
+    for (auto step : steps_) {
+      switch (step) {
+        case Step::Scaler:
+          if (scale_.size() == 1) {
+            row = (row - offset_[0]) * scale_[0];
+          } else {
+            row = (row - ConstEigenVectorArrayMap<float>(offset_.data(), num_features)) *
+                  ConstEigenVectorArrayMap<float>(scale_.data(), num_features);
+          }
+          break;
+        case Step::Normalizer: {
+          float norm = 0.f;
+          switch (normalization_) {
+            case ml::NORMALIZE::NMAX:
+              norm = row.maxCoeff();
+              break;
+            case ml::NORMALIZE::L1:
+              norm = row.abs().sum();
+              break;
+            case ml::NORMALIZE::L2:
+              norm = std::sqrt(row.square().sum());
+              break;
+            default:
+              break;
+          }
+          if (norm != 0.f) {
+            row /= norm;
+          }
+          break;
+        }
+        case Step::Binarizer:
+          if (row.isNaN().any()) {
+            return false;
+          }
+          row = (row > threshold_).cast<float>();
+          break;
+      }
+    }
+  }
+  return true;
+}
+
+Status FusedLinearClassifier::Compute(OpKernelContext* ctx) const {
+  const auto& X = *ctx->Input<Tensor>(0);
+  const TensorShape& input_shape = X.Shape();
+  if (input_shape.NumDimensions() == 0 || input_shape.NumDimensions() > 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "FusedLinearClassifier: the input must have 1 or 2 dimensions. Got ", input_shape);
+  }
+
+  const int64_t num_batches = input_shape.NumDimensions() == 1 ? 1 : input_shape[0];
+  const int64_t num_features = input_shape.NumDimensions() == 1 ? input_shape[0] : input_shape[1];
+  if (scale_.size() > 1 && static_cast<int64_t>(scale_.size()) != num_features) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedLinearClassifier: either both scale and offset can be "
+                           "of feature size (", num_features, ") or 1");
+  }
+  if (static_cast<int64_t>(coefficients_.size()) != class_count_ * num_features) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedLinearClassifier: expected ",
+                           class_count_ * num_features, " coefficients for ", num_features, " features. Got ",
+                           coefficients_.size());
+  }
+
+  Tensor* Y = ctx->Output(0, TensorShape({num_batches}));
+
+  int64_t output_classes = class_count_;
+  bool add_second_class = false;
+  if (class_count_ == 1 &&
+      ((using_strings_ && classlabels_strings_.size() == 2) ||
+       (!using_strings_ && classlabels_ints_.size() == 2))) {
+    output_classes = 2;
+    add_second_class = true;
+  }
+
+  Tensor* Z = ctx->Output(1, TensorShape({num_batches, output_classes}));
+  if (num_batches == 0) {
+    return Status::OK();
+  }
+
+  const float* x_data = X.Data<float>();
+  float* z_data = Z->MutableData<float>();
+
+  // the blocks of rows are split across the threads. the GEMM only uses the thread pool when there's a single batch.
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const int64_t n_blocks = (num_batches + kRowBlock - 1) / kRowBlock;
+  const auto n_batches = static_cast<int32_t>(tp == nullptr ? 1 : std::min<int64_t>(n_blocks, tp->NumThreads() + 1));
+  std::atomic<bool> found_nan{false};
+
+  auto compute_batch = [&](int32_t batch) {
+    std::vector<float> features(static_cast<size_t>(std::min(kRowBlock, num_batches) * num_features));
+
+    for (int64_t block = n_blocks * batch / n_batches, end = n_blocks * (batch + 1) / n_batches; block < end;
+         ++block) {
+      const int64_t first_row = block * kRowBlock;
+      const int64_t n_rows = std::min(kRowBlock, num_batches - first_row);
+      std::copy_n(x_data + first_row * num_features, n_rows * num_features, features.data());
+      if (!Preprocess(features.data(), n_rows, num_features)) {
+        found_nan = true;
+        return;
+      }
+
+      // scores: features * coefficients_^T + intercepts_, written compactly at the start of the block's output. the
+      // score of the second class is added by the post transform.
+      float* scores = z_data + first_row * output_classes;
+      for (int64_t r = 0; r < n_rows; ++r) {
+        std::copy(intercepts_.begin(), intercepts_.end(), scores + r * class_count_);
+      }
+      MlasGemm(CblasNoTrans, CblasTrans, static_cast<size_t>(n_rows), static_cast<size_t>(class_count_),
+               static_cast<size_t>(num_features), 1.f, features.data(), static_cast<size_t>(num_features),
+               coefficients_.data(), static_cast<size_t>(num_features), 1.f, scores,
+               static_cast<size_t>(class_count_), n_batches == 1 ? tp : nullptr);
+
+      for (int64_t r = 0; r < n_rows; ++r) {
+        const float* row_scores = scores + r * class_count_;
+        const int64_t n = first_row + r;
+        if (class_count_ == 1) {
+          const bool positive = row_scores[0] > 0;
+          if (using_strings_) {
+            const bool use_class_labels = classlabels_strings_.size() == 2;
+            Y->MutableData<std::string>()[n] =
+                use_class_labels ? classlabels_strings_[positive ? 1 : 0] : (positive ? "1" : "0");
+          } else {
+            const bool use_class_labels = classlabels_ints_.size() == 2;
+            Y->MutableData<int64_t>()[n] =
+                use_class_labels ? classlabels_ints_[positive ? 1 : 0] : (positive ? 1 : 0);
+          }
+        } else {
+          const int64_t maxclass = std::max_element(row_scores, row_scores + class_count_) - row_scores;
+          if (using_strings_) {
+            Y->MutableData<std::string>()[n] = classlabels_strings_[maxclass];
+          } else {
+            Y->MutableData<int64_t>()[n] = classlabels_ints_[maxclass];
+          }
+        }
+      }
+
+      if (post_transform_ != ml::POST_EVAL_TRANSFORM::NONE || add_second_class) {
+        ml::batched_update_scores_inplace(gsl::make_span(scores, static_cast<size_t>(n_rows * output_classes)),
+                                          n_rows, class_count_, post_transform_, add_second_class ? 1 : -1,
+                                          nullptr);
+      }
+    }
+  };
+
+  if (n_batches == 1) {
+    compute_batch(0);
+  } else {
+    concurrency::ThreadPool::TryBatchParallelFor(tp, n_batches, compute_batch, n_batches);
+  }
+
+  if (found_nan) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "FusedLinearClassifier: the input of the Binarizer step is NaN");
+  }
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
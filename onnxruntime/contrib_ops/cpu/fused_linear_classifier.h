@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/ml/ml_common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// A LinearClassifier whose input is first transformed by a chain of Scaler, Normalizer and Binarizer ops.
+// The rows are processed one block at a time: the preprocessed features of a block stay in cache and go straight to
+// the GEMM computing its scores, instead of being written to a full tensor by each op.
+class FusedLinearClassifier final : public OpKernel {
+ public:
+  explicit FusedLinearClassifier(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+  enum class Step {
+    Scaler,
+    Normalizer,
+    Binarizer,
+  };
+
+ private:
+  // applies the steps to the `rows` rows of features in `data`. returns false if the Binarizer finds a NaN.
+  bool Preprocess(float* data, int64_t rows, int64_t num_features) const;
+
+  std::vector<Step> steps_;
+  std::vector<float> scale_;
+  std::vector<float> offset_;
+  ml::NORMALIZE normalization_;
+  float threshold_;
+
+  ml::POST_EVAL_TRANSFORM post_transform_;
+  bool using_strings_;
+  int64_t class_count_;
+  std::vector<float> coefficients_;
+  std::vector<float> intercepts_;
+  std::vector<std::string> classlabels_strings_;
+  std::vector<int64_t> classlabels_ints_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
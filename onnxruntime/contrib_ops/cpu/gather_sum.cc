@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/gather_sum.h"
+
+#include <algorithm>
+
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/gather.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    GatherSum,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("Tind", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(),
+                                                        DataTypeImpl::GetTensorType<int64_t>()}),
+    GatherSum<float>);
+
+template <typename T, typename Tind>
+static Status GatherSumImpl(const Tensor& data, const Tensor& indices, Tensor& output, concurrency::ThreadPool* tp) {
+  const TensorShape& data_shape = data.Shape();
+  const TensorShape& indices_shape = indices.Shape();
+
+  const int64_t num_rows = data_shape[0];
+  const int64_t row_size = data_shape.SizeFromDimension(1);
+  const int64_t bag_size = indices_shape[indices_shape.NumDimensions() - 1];
+  const int64_t num_bags = indices_shape.SizeToDimension(indices_shape.NumDimensions() - 1);
+
+  const T* data_base = data.template Data<T>();
+  const Tind* indices_data = indices.template Data<Tind>();
+  T* output_data = output.template MutableData<T>();
+
+  // Check the indices first as the parallel loop below can't return an error.
+  const int64_t num_indices = indices_shape.Size();
+  for (int64_t i = 0; i < num_indices; ++i) {
+    const Tind idx = indices_data[i];
+    if (idx < -num_rows || idx >= num_rows) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "indices element out of data bounds, idx=", idx,
+                             " must be within the inclusive range [", -num_rows, ",", num_rows - 1, "]");
+    }
+  }
+
+  auto data_row = [&](int64_t index) {
+    const int64_t idx = static_cast<int64_t>(indices_data[index]);
+    return data_base + (idx < 0 ? idx + num_rows : idx) * row_size;
+  };
+
+  // each task sums enough bags to read about kGatherParallelBlockBytes of rows
+  const int64_t row_bytes = row_size * static_cast<int64_t>(sizeof(T));
+  const int64_t bags_per_block = GatherRowsPerBlock(num_bags, row_bytes * std::max<int64_t>(bag_size, 1));
+  const int64_t num_blocks = (num_bags + bags_per_block - 1) / bags_per_block;
+
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t block) {
+    const int64_t begin = block * bags_per_block;
+    const int64_t end = std::min(begin + bags_per_block, num_bags);
+
+    for (int64_t bag = begin; bag < end; ++bag) {
+      EigenVectorArrayMap<T> sum(output_data + bag * row_size, row_size);
+      sum.setZero();
+
+      const int64_t first_index = bag * bag_size;
+      const int64_t end_index = first_index + bag_size;
+      const int64_t block_end_index = end * bag_size;
+      for (int64_t index = first_index; index < end_index; ++index) {
+        if (index + kGatherPrefetchDistance < block_end_index) {
+          PrefetchGatherRow(data_row(index + kGatherPrefetchDistance), static_cast<size_t>(row_bytes));
+        }
+        sum += ConstEigenVectorArrayMap<T>(data_row(index), row_size);
+      }
+    }
+  });
+
+  return Status::OK();
+}
+
+template <typename T>
+Status GatherSum<T>::Compute(OpKernelContext* context) const {
+  const auto* data = context->Input<Tensor>(0);
+  const auto* indices = context->Input<Tensor>(1);
+  const TensorShape& data_shape = data->Shape();
+  const TensorShape& indices_shape = indices->Shape();
+
+  if (data_shape.NumDimensions() < 1 || indices_shape.NumDimensions() < 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "GatherSum: data and indices must have rank 1 or more");
+  }
+
+  std::vector<int64_t> output_dims(indices_shape.GetDims().begin(), indices_shape.GetDims().end() - 1);
+  output_dims.insert(output_dims.end(), data_shape.GetDims().begin() + 1, data_shape.GetDims().end());
+  Tensor* output = context->Output(0, TensorShape(std::move(output_dims)));
+
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  if (indices->IsDataType<int32_t>()) {
+    return GatherSumImpl<T, int32_t>(*data, *indices, *output, tp);
+  }
+  return GatherSumImpl<T, int64_t>(*data, *indices, *output, tp);
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,23 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Fused Gather (axis 0) + ReduceSum over the last axis of the indices, as used by embedding bag lookups.
+// The gathered rows are accumulated directly into the output instead of being materialized.
+template <typename T>
+class GatherSum final : public OpKernel {
+ public:
+  explicit GatherSum(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
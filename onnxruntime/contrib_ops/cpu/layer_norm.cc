@@ -94,13 +94,9 @@ Status LayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
                                                  const T* p_input = X_data + task_idx * norm_size;
                                                  T* p_output = Y_data + task_idx * norm_size;
 
-                                                 T mean = 0;
-                                                 T mean_square = 0;
-
-                                                 for (int64_t h = 0; h < norm_size; h++) {
-                                                   mean += p_input[h];
-                                                   mean_square += p_input[h] * p_input[h];
-                                                 }
+                                                 T mean;
+                                                 T mean_square;
+                                                 ComputeSumAndSumSquare(p_input, norm_size, mean, mean_square);
 
                                                  mean = mean / norm_size;
                                                  mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon_);
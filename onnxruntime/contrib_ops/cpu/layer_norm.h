@@ -6,10 +6,27 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 namespace contrib {
 
+// Computes the sum and the sum of squares of a row of the normalization in a single pass.
+template <typename T>
+void ComputeSumAndSumSquare(const T* x, int64_t n, T& sum, T& sum_square) {
+  sum = 0;
+  sum_square = 0;
+  for (int64_t h = 0; h < n; h++) {
+    sum += x[h];
+    sum_square += x[h] * x[h];
+  }
+}
+
+template <>
+inline void ComputeSumAndSumSquare<float>(const float* x, int64_t n, float& sum, float& sum_square) {
+  MlasReduceSumAndSumSquare(x, static_cast<size_t>(n), &sum, &sum_square);
+}
+
 template <typename T>
 class LayerNorm final : public OpKernel {
  public:
@@ -9,6 +9,11 @@
 
 #include "contrib_ops/cpu/murmur_hash3.h"
 
+#include <algorithm>
+#include <limits>
+
+#include "core/platform/threadpool.h"
+
 // Platform-specific functions and macros
 
 // Microsoft Visual Studio
@@ -108,7 +113,7 @@ ONNX_OPERATOR_KERNEL_EX(
                                                       DataTypeImpl::GetTensorType<uint32_t>()}),
     MurmurHash3);
 
-void MurmurHash3::MurmurHash3_x86_32(const void* key, int len, uint32_t seed, void* out) const {
+uint32_t MurmurHash3::MurmurHash3_x86_32(const void* key, int len, uint32_t seed) {
   const uint8_t* data = reinterpret_cast<const uint8_t*>(key);
   const int nblocks = len / 4;
   uint32_t h1 = seed;
@@ -154,15 +159,33 @@ void MurmurHash3::MurmurHash3_x86_32(const void* key, int len, uint32_t seed, vo
   // finalization
   h1 ^= len;
 
-  h1 = fmix(h1);
+  return fmix(h1);
+}
 
-  if (is_positive_) {
-    *(uint32_t*)out = h1;
-  } else {
-    *(int32_t*)out = h1;
-  }
+// MurmurHash3_x86_32 of a single 4 byte block, which has no tail. It only uses arithmetic on 32 bit lanes, so the
+// compiler vectorizes the loops calling it over a tensor.
+FORCE_INLINE uint32_t MurmurHash3_x86_32_4Bytes(uint32_t k1, uint32_t seed) {
+  k1 *= 0xcc9e2d51;
+  k1 = (k1 << 15) | (k1 >> 17);
+  k1 *= 0x1b873593;
+
+  uint32_t h1 = seed ^ k1;
+  h1 = (h1 << 13) | (h1 >> 19);
+  h1 = h1 * 5 + 0xe6546b64;
+
+  h1 ^= 4;
+  h1 ^= h1 >> 16;
+  h1 *= 0x85ebca6b;
+  h1 ^= h1 >> 13;
+  h1 *= 0xc2b2ae35;
+  h1 ^= h1 >> 16;
+  return h1;
 }
 
+// Elements hashed by each task of the thread pool.
+constexpr int64_t kNumericBlockSize = 16384;
+constexpr int64_t kStringBlockSize = 1024;
+
 Status MurmurHash3::Compute(OpKernelContext* ctx) const {
   const Tensor* keys = ctx->Input<Tensor>(0);
   ORT_ENFORCE(keys);
@@ -179,31 +202,40 @@ Status MurmurHash3::Compute(OpKernelContext* ctx) const {
   // however, all is needed is a ptr that can step 4 bytes at a time and for that reason we choose
   // raw data casted to a type of choice.
   ORT_ENFORCE(sizeof(uint32_t) == output_element_bytes, "Invalid assumption of output element size");
+  ORT_ENFORCE(is_string || sizeof(uint32_t) == input_element_bytes, "Invalid assumption of input element size");
   auto output = reinterpret_cast<uint32_t*>(output_tensor->MutableDataRaw());
 
-  if (is_string) {
-    auto input = keys->Data<std::string>();
-    const auto input_end = input + input_count;
-    while (input != input_end) {
-      MurmurHash3_x86_32(input->c_str(),
-                         static_cast<int>(input->length()),
-                         seed_,
-                         output);
-      ++input;
-      ++output;
-    }
-  } else {
-    auto input = reinterpret_cast<const uint32_t*>(keys->DataRaw());
-    const auto input_end = input + input_count;
-    while (input != input_end) {
-      MurmurHash3_x86_32(input,
-                         static_cast<int>(input_element_bytes),
-                         seed_,
-                         output);
-      ++input;
-      ++output;
-    }
-  }
+  const int64_t block_size = is_string ? kStringBlockSize : kNumericBlockSize;
+  const int64_t num_blocks = (input_count + block_size - 1) / block_size;
+  ORT_RETURN_IF_NOT(num_blocks <= std::numeric_limits<int32_t>::max(), "Too many elements to hash: ", input_count);
+
+  const uint32_t seed = seed_;
+  const uint32_t num_buckets = num_buckets_;
+  concurrency::ThreadPool::TryBatchParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<int32_t>(num_blocks), [&](int32_t block) {
+        const int64_t begin = block * block_size;
+        const int64_t end = std::min(input_count, begin + block_size);
+        uint32_t* block_output = output + begin;
+        if (is_string) {
+          const std::string* input = keys->Data<std::string>();
+          for (int64_t i = begin; i < end; ++i) {
+            *block_output++ = MurmurHash3_x86_32(input[i].c_str(), static_cast<int>(input[i].length()), seed);
+          }
+        } else {
+          const uint32_t* input = reinterpret_cast<const uint32_t*>(keys->DataRaw());
+          for (int64_t i = begin; i < end; ++i) {
+            *block_output++ = MurmurHash3_x86_32_4Bytes(input[i], seed);
+          }
+        }
+
+        // hashing trick: the bucket of each key, without another pass over a tensor of hashes
+        if (num_buckets != 0) {
+          for (uint32_t* bucket = output + begin; bucket != block_output; ++bucket) {
+            *bucket %= num_buckets;
+          }
+        }
+      });
+
   return Status::OK();
 }
 
@@ -14,16 +14,22 @@ class MurmurHash3 final : public OpKernel {
   MurmurHash3(const OpKernelInfo& info) : OpKernel(info) {
     seed_ = static_cast<uint32_t>(info.GetAttrOrDefault<int64_t>("seed", 0));
     is_positive_ = info.GetAttrOrDefault<int64_t>("positive", 1) == 1;
+    const int64_t num_buckets = info.GetAttrOrDefault<int64_t>("num_buckets", 0);
+    ORT_ENFORCE(num_buckets >= 0 && num_buckets <= (is_positive_ ? UINT32_MAX : INT32_MAX),
+                "num_buckets is out of range of the output type: ", num_buckets);
+    num_buckets_ = static_cast<uint32_t>(num_buckets);
   }
 
   Status Compute(OpKernelContext* context) const override;
 
 private:
-  void MurmurHash3_x86_32(const void* key, int len, uint32_t seed, void* out) const;
+  static uint32_t MurmurHash3_x86_32(const void* key, int len, uint32_t seed);
 
 private :
   uint32_t seed_;
   bool is_positive_{true};
+  // 0 outputs the hashes, else their buckets
+  uint32_t num_buckets_{0};
 };
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -78,11 +78,28 @@ ONNX_CPU_OPERATOR_TYPED_NCHWC_KERNEL(
 Status ReorderInput::Compute(OpKernelContext* context) const {
   const auto* X = context->Input<Tensor>(0);
   const auto& X_shape = X->Shape();
-  ORT_ENFORCE(X_shape.NumDimensions() == 4);
-  ORT_ENFORCE((X_shape[1] % MlasNchwcGetBlockSize()) == 0);
+  const auto X_rank = X_shape.NumDimensions();
+  ORT_ENFORCE(X_rank == 4);
+
+  const auto* x_data = X->template Data<float>();
+  if (channels_last_) {
+    ORT_ENFORCE((X_shape[X_rank - 1] % MlasNchwcGetBlockSize()) == 0);
+
+    // Build the output shape in NCHW order.
+    std::vector<int64_t> Y_shape(X_rank);
+    Y_shape[0] = X_shape[0];
+    Y_shape[1] = X_shape[X_rank - 1];
+    for (size_t i = 0; i < X_rank - 2; i++) {
+      Y_shape[2 + i] = X_shape[1 + i];
+    }
+    auto* Y = context->Output(0, Y_shape);
+    MlasReorderInputNhwc(X_shape.GetDims().data(), x_data, Y->template MutableData<float>());
+  } else {
+    ORT_ENFORCE((X_shape[1] % MlasNchwcGetBlockSize()) == 0);
 
-  auto* Y = context->Output(0, X_shape);
-  MlasReorderInput(X_shape.GetDims().data(), X->template Data<float>(), Y->template MutableData<float>());
+    auto* Y = context->Output(0, X_shape);
+    MlasReorderInput(X_shape.GetDims().data(), x_data, Y->template MutableData<float>());
+  }
 
   return Status::OK();
 }
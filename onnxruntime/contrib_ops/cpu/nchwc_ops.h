@@ -15,9 +15,13 @@ namespace contrib {
 class ReorderInput : public OpKernel {
  public:
   ReorderInput(const OpKernelInfo& info) : OpKernel(info) {
+    channels_last_ = info.GetAttrOrDefault<int64_t>("channels_last", 0);
   }
 
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t channels_last_;
 };
 
 class ReorderOutput : public OpKernel {
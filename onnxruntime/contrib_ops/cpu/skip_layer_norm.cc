@@ -6,6 +6,7 @@
 #include "core/providers/common.h"
 #include "core/platform/threadpool.h"
 #include "skip_layer_norm.h"
+#include "layer_norm.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -101,19 +102,21 @@ Status SkipLayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
                                                  const T* p_skip = skip_data + task_idx * hidden_size;
                                                  T* p_output = output_data + task_idx * hidden_size;
 
-                                                 T mean = 0;
-                                                 T mean_square = 0;
-
-                                                 for (int64_t h = 0; h < hidden_size; h++) {
-                                                   T value = p_input[h] + p_skip[h];
-                                                   if (nullptr != bias_data) {
-                                                     value += bias_data[h];
+                                                 if (nullptr != bias_data) {
+                                                   for (int64_t h = 0; h < hidden_size; h++) {
+                                                     p_output[h] = p_input[h] + p_skip[h] + bias_data[h];
+                                                   }
+                                                 } else {
+                                                   for (int64_t h = 0; h < hidden_size; h++) {
+                                                     p_output[h] = p_input[h] + p_skip[h];
                                                    }
-                                                   p_output[h] = value;
-                                                   mean += value;
-                                                   mean_square += value * value;
                                                  }
 
+                                                 // the row is still in cache, so reduce it in a separate pass
+                                                 T mean;
+                                                 T mean_square;
+                                                 ComputeSumAndSumSquare(p_output, hidden_size, mean, mean_square);
+
                                                  mean = mean / hidden_size;
                                                  mean_square = sqrt(mean_square / hidden_size - mean * mean + float(1e-12));
 
@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/sparse_matmul.h"
+#include "core/platform/threadpool.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    SparseMatMul,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    SparseMatMul);
+
+// Minimum number of multiply-adds each thread computes before another thread is used.
+static constexpr int64_t kMinMultiplyAddsPerThread = 64 * 1024;
+
+// Checks that the CSR form of B is consistent, so the kernel reads and writes within bounds.
+static Status ValidateCsr(const Tensor& values, const Tensor& col_indices, const Tensor& row_offsets, int64_t n) {
+  const int64_t nnz = values.Shape().Size();
+  ORT_RETURN_IF_NOT(values.Shape().NumDimensions() == 1 && col_indices.Shape().NumDimensions() == 1 &&
+                        col_indices.Shape().Size() == nnz,
+                    "SparseMatMul: B_values and B_col_indices must be 1-D tensors of the same size");
+  ORT_RETURN_IF_NOT(row_offsets.Shape().NumDimensions() == 1 && row_offsets.Shape().Size() >= 1,
+                    "SparseMatMul: B_row_offsets must be a 1-D tensor of size K + 1");
+
+  const int64_t k = row_offsets.Shape().Size() - 1;
+  const auto* offsets = row_offsets.template Data<int64_t>();
+  ORT_RETURN_IF_NOT(offsets[0] == 0 && offsets[k] == nnz,
+                    "SparseMatMul: B_row_offsets must start at 0 and end at the number of values");
+  for (int64_t row = 0; row < k; ++row) {
+    ORT_RETURN_IF_NOT(offsets[row] <= offsets[row + 1], "SparseMatMul: B_row_offsets must be non-decreasing");
+  }
+
+  const auto* cols = col_indices.template Data<int32_t>();
+  for (int64_t i = 0; i < nnz; ++i) {
+    ORT_RETURN_IF_NOT(cols[i] >= 0 && cols[i] < n, "SparseMatMul: column index ", cols[i], " is out of range");
+  }
+
+  return Status::OK();
+}
+
+SparseMatMul::SparseMatMul(const OpKernelInfo& info) : OpKernel(info) {
+  ORT_ENFORCE(info.GetAttr<int64_t>("N", &n_).IsOK() && n_ >= 0, "SparseMatMul: N is required");
+
+  // B is normally a set of initializers created by the sparse weight transformer, so it's only checked once
+  const Tensor* values = nullptr;
+  const Tensor* col_indices = nullptr;
+  const Tensor* row_offsets = nullptr;
+  if (info.TryGetConstantInput(1, &values) && info.TryGetConstantInput(2, &col_indices) &&
+      info.TryGetConstantInput(3, &row_offsets)) {
+    auto status = ValidateCsr(*values, *col_indices, *row_offsets, n_);
+    ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+    is_b_validated_ = true;
+  }
+}
+
+Status SparseMatMul::Compute(OpKernelContext* context) const {
+  const auto* A = context->Input<Tensor>(0);
+  const auto* values = context->Input<Tensor>(1);
+  const auto* col_indices = context->Input<Tensor>(2);
+  const auto* row_offsets = context->Input<Tensor>(3);
+  const auto* bias = context->Input<Tensor>(4);
+
+  if (!is_b_validated_) {
+    ORT_RETURN_IF_ERROR(ValidateCsr(*values, *col_indices, *row_offsets, n_));
+  }
+
+  const auto& a_shape = A->Shape();
+  const int64_t k = row_offsets->Shape().Size() - 1;
+  if (a_shape.NumDimensions() == 0 || a_shape[a_shape.NumDimensions() - 1] != k) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "SparseMatMul: the last dimension of A with shape ",
+                           a_shape, " must be the number of rows of B, ", k);
+  }
+  if (bias != nullptr && (bias->Shape().NumDimensions() != 1 || bias->Shape()[0] != n_)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "SparseMatMul: bias must be a 1-D tensor of size ", n_);
+  }
+
+  std::vector<int64_t> y_dims = a_shape.GetDims();
+  y_dims.back() = n_;
+  Tensor* Y = context->Output(0, TensorShape(y_dims));
+
+  const int64_t m = a_shape.SizeToDimension(a_shape.NumDimensions() - 1);
+  if (m == 0 || n_ == 0) {
+    return Status::OK();
+  }
+
+  const auto* a_data = A->template Data<float>();
+  const auto* b_values = values->template Data<float>();
+  const auto* b_cols = col_indices->template Data<int32_t>();
+  const auto* b_offsets = row_offsets->template Data<int64_t>();
+  const float* bias_data = bias != nullptr ? bias->template Data<float>() : nullptr;
+  auto* y_data = Y->template MutableData<float>();
+
+  // each row of Y is the sum of the rows of B scaled by the elements of the matching row of A. the zeros of A, e.g.
+  // after a Relu, skip their row of B.
+  auto compute_rows = [&](int64_t first, int64_t last) {
+    for (int64_t row = first; row < last; ++row) {
+      float* y = y_data + row * n_;
+      if (bias_data != nullptr) {
+        std::copy_n(bias_data, n_, y);
+      } else {
+        std::fill_n(y, n_, 0.0f);
+      }
+
+      const float* a = a_data + row * k;
+      for (int64_t i = 0; i < k; ++i) {
+        const float scale = a[i];
+        if (scale == 0.0f) {
+          continue;
+        }
+        for (int64_t j = b_offsets[i]; j < b_offsets[i + 1]; ++j) {
+          y[b_cols[j]] += scale * b_values[j];
+        }
+      }
+    }
+  };
+
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  int64_t num_ranges = 1;
+  if (tp != nullptr) {
+    const int64_t multiply_adds = m * std::max<int64_t>(values->Shape().Size(), n_);
+    num_ranges = std::min<int64_t>({static_cast<int64_t>(tp->NumThreads()) + 1, m,
+                                    multiply_adds / kMinMultiplyAddsPerThread});
+  }
+
+  if (num_ranges <= 1) {
+    compute_rows(0, m);
+  } else {
+    tp->ParallelFor(static_cast<int32_t>(num_ranges), [&](int32_t range) {
+      compute_rows(m * range / num_ranges, m * (range + 1) / num_ranges);
+    });
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
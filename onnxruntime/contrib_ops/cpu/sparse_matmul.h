@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Multiplies a dense A by a sparse B given in CSR form. The work is proportional to the number of non-zero elements of
+// B, so a weight pruned to a high sparsity costs a fraction of a dense MatMul.
+class SparseMatMul final : public OpKernel {
+ public:
+  explicit SparseMatMul(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t n_;
+
+  // true if B is a constant input that was validated when the kernel was created
+  bool is_b_validated_ = false;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -7,114 +7,124 @@
 #include "core/util/math_cpuonly.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/framework/op_kernel_context_internal.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 namespace contrib {
 
-void WordConvEmbedding::CharEmbeddingLookup(
-    const int* seq_ptr,
-    const float* char_embedding_weight_p,
-    size_t seq_len,
-    size_t word_len,
-    size_t char_embedding_size,
-    size_t filter_width,
-    const int* words_len_ptr,
-    float* dst) const {
-  for (size_t word_inx = 0; word_inx < seq_len; word_inx++) {
-    if (words_len_ptr[word_inx] > 0) {
-      const int* cur_seq_ptr = seq_ptr + word_inx * word_len;
-      float* cur_dst_ptr = dst + word_inx * word_len * char_embedding_size;
-      size_t char_length_to_lookup = std::max<size_t>(words_len_ptr[word_inx], filter_width);
-      for (size_t char_inx = 0; char_inx < char_length_to_lookup; char_inx++) {
-        memcpy(cur_dst_ptr, char_embedding_weight_p + (*cur_seq_ptr) * char_embedding_size, sizeof(float) * char_embedding_size);
-        cur_dst_ptr += char_embedding_size;
-        cur_seq_ptr++;
-      }
+namespace {
+
+// Words convolved by each task of the thread pool.
+constexpr int64_t kWordsPerTask = 32;
+
+// Packs the filters [num_filters, 1, filter_width, char_embedding_size] as B in conv = unfolded * filters^T.
+BufferUniquePtr PackFilters(const AllocatorPtr& alloc, const Tensor& w_conv, /*out*/ size_t& packed_size) {
+  const auto& shape = w_conv.Shape();
+  const size_t num_filters = static_cast<size_t>(shape[0]);
+  const size_t kernel_size = static_cast<size_t>(shape.SizeFromDimension(1));
+  packed_size = MlasGemmPackBSize(num_filters, kernel_size);
+  if (packed_size == 0) {
+    return BufferUniquePtr();
+  }
+
+  void* packed_data = alloc->Alloc(packed_size);
+  MlasGemmPackB(CblasTrans, num_filters, kernel_size, w_conv.Data<float>(), kernel_size, packed_data);
+  return BufferUniquePtr(packed_data, BufferDeleter(alloc));
+}
+
+}  // namespace
+
+Status WordConvEmbedding::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                  bool& is_packed, PrePackedWeights& prepacked_weights) {
+  is_packed = false;
+  if (input_idx == 1 && tensor.Shape().NumDimensions() == 4) {
+    size_t packed_size = 0;
+    auto packed = PackFilters(alloc, tensor, packed_size);
+    if (packed) {
+      prepacked_weights.buffers_.push_back(std::move(packed));
+      prepacked_weights.buffer_sizes_.push_back(packed_size);
+      is_packed = true;
     }
   }
+  return Status::OK();
 }
 
-//input : [sequence_length, word_length, char_embedding_size]
+Status WordConvEmbedding::UseSharedPrePackedBuffers(const PrePackedWeights& prepacked_weights, int input_idx) {
+  if (input_idx == 1) {
+    packed_filters_ = prepacked_weights.buffers_[0].get();
+  }
+  return Status::OK();
+}
+
+// The windows of filter_width characters of the words [first_word, last_word) are unfolded straight from the char
+// embeddings into one matrix, convolved with the filters by a single GEMM and max-pooled per word. tanh is increasing,
+// so the bias and the activation are applied to the pooled maximum instead of every window.
 void WordConvEmbedding::ComputeConvMaxPoolWithActivation(
-    AllocatorPtr allocator,
-    const float* input,
-    const float* weights,
+    const int* seq_ptr,
+    const float* char_embedding_weight_p,
+    const void* packed_filters,
     const float* bias,
     const int* words_len_ptr,
-    int64_t seq_len,
+    int64_t first_word,
+    int64_t last_word,
     int64_t word_len,
     int64_t char_embedding_size,
     int64_t filter_width,
     int64_t num_filters,
-    float* output, concurrency::ThreadPool* tp) const {
-  int64_t input_word_size = word_len * char_embedding_size;
-  int64_t unfolded_width = word_len - filter_width + 1;
-  int64_t unfolded_kernal_size = filter_width * char_embedding_size;
-  int64_t unfolded_segment_size = unfolded_width * unfolded_kernal_size;
-  int64_t conv_res_segment_size = unfolded_width * num_filters;
-  int64_t memcpy_size = unfolded_kernal_size * sizeof(float);
-
-  auto unfolded_buffer_p = IAllocator::MakeUniquePtr<float>(allocator, seq_len * unfolded_segment_size);
-  auto conv_result_p = IAllocator::MakeUniquePtr<float>(allocator, seq_len * conv_res_segment_size);
-  auto conv_activation_result_p = IAllocator::MakeUniquePtr<float>(allocator, seq_len * conv_res_segment_size);
-
-  int64_t word_inx = 0;
-  while (word_inx < seq_len) {
-    if (words_len_ptr[word_inx] <= 0) {
-      word_inx++;
-      continue;
-    }
-
-    float* words_unfolded_buffer_p = unfolded_buffer_p.get();
-    int64_t words_unfolded_width = 0;
-    int64_t tmp_word_inx = word_inx;
-    float* conv_buf_p = conv_result_p.get();
-    float* pactivationbuf = conv_activation_result_p.get();
-
-    // unfolding buffer
-    while (tmp_word_inx < seq_len && words_len_ptr[tmp_word_inx] > 0) {
-      const float* current_word_input = input + tmp_word_inx * input_word_size;
-      int64_t word_unfolded_width = std::max<int64_t>(words_len_ptr[tmp_word_inx], filter_width) - filter_width + 1;
-      words_unfolded_width += word_unfolded_width;
-      for (int64_t unfolded_inx = 0; unfolded_inx < word_unfolded_width; unfolded_inx++) {
-        memcpy(words_unfolded_buffer_p, current_word_input, memcpy_size);
-        current_word_input += char_embedding_size;
-        words_unfolded_buffer_p += unfolded_kernal_size;
+    float* unfolded_buffer,
+    float* conv_buffer,
+    float* output,
+    concurrency::ThreadPool* tp) const {
+  const int64_t unfolded_kernel_size = filter_width * char_embedding_size;
+  const size_t char_embedding_bytes = char_embedding_size * sizeof(float);
+
+  // unfolding buffer
+  int64_t unfolded_rows = 0;
+  float* unfolded_row = unfolded_buffer;
+  for (int64_t word_inx = first_word; word_inx < last_word; word_inx++) {
+    const int* word_chars = seq_ptr + word_inx * word_len;
+    const int64_t word_unfolded_width =
+        words_len_ptr[word_inx] > 0 ? std::max<int64_t>(words_len_ptr[word_inx], filter_width) - filter_width + 1 : 0;
+    for (int64_t unfolded_inx = 0; unfolded_inx < word_unfolded_width; unfolded_inx++) {
+      for (int64_t char_inx = 0; char_inx < filter_width; char_inx++) {
+        memcpy(unfolded_row, char_embedding_weight_p + word_chars[unfolded_inx + char_inx] * char_embedding_size,
+               char_embedding_bytes);
+        unfolded_row += char_embedding_size;
       }
-      tmp_word_inx++;
     }
+    unfolded_rows += word_unfolded_width;
+  }
 
-    math::GemmEx<float>(
-        CblasNoTrans, CblasTrans,
-        static_cast<int>(words_unfolded_width), static_cast<int>(num_filters), static_cast<int>(unfolded_kernal_size), 1.0f,
-        unfolded_buffer_p.get(), static_cast<int>(unfolded_kernal_size),
-        weights, static_cast<int>(unfolded_kernal_size), 0.0f,
-        conv_buf_p, static_cast<int>(num_filters), tp);
-
-    for (int64_t unfolded_inx = 0; unfolded_inx < words_unfolded_width; unfolded_inx++)
-      for (int64_t filter_inx = 0; filter_inx < num_filters; filter_inx++) {
-        conv_buf_p[unfolded_inx * num_filters + filter_inx] += bias[filter_inx];
-      }
-    MlasComputeTanh(conv_buf_p, pactivationbuf, words_unfolded_width * num_filters);
+  if (unfolded_rows > 0) {
+    MlasGemm(CblasNoTrans, static_cast<size_t>(unfolded_rows), static_cast<size_t>(num_filters),
+             static_cast<size_t>(unfolded_kernel_size), 1.0f,
+             unfolded_buffer, static_cast<size_t>(unfolded_kernel_size),
+             packed_filters, 0.0f,
+             conv_buffer, static_cast<size_t>(num_filters), tp);
+  }
 
-    float* activationbuf_cur_ptr = pactivationbuf;
-    for (int64_t pool_word_inx = word_inx; pool_word_inx < tmp_word_inx; pool_word_inx++) {
-      float* result_ptr = output + pool_word_inx * num_filters;
-      for (int64_t filter_inx = 0; filter_inx < num_filters; filter_inx++) {
-        result_ptr[filter_inx] = -1.0f * 1e12f;
-      }
+  const float* conv_row = conv_buffer;
+  for (int64_t word_inx = first_word; word_inx < last_word; word_inx++) {
+    float* result_ptr = output + word_inx * num_filters;
+    if (words_len_ptr[word_inx] <= 0) {
+      // a word without characters has no embedding
+      std::fill_n(result_ptr, num_filters, 0.0f);
+      continue;
+    }
 
-      int64_t word_unfolded_width = std::max<int64_t>(words_len_ptr[pool_word_inx], filter_width) - filter_width + 1;
-      for (int64_t unfolded_inx = 0; unfolded_inx < word_unfolded_width; unfolded_inx++) {
-        for (int64_t filter_inx = 0; filter_inx < num_filters; filter_inx++) {
-          result_ptr[filter_inx] = std::max(activationbuf_cur_ptr[filter_inx], result_ptr[filter_inx]);
-        }
-        activationbuf_cur_ptr += num_filters;
-      }
+    const int64_t word_unfolded_width = std::max<int64_t>(words_len_ptr[word_inx], filter_width) - filter_width + 1;
+    auto result = EigenVectorArrayMap<float>(result_ptr, num_filters);
+    result = ConstEigenVectorArrayMap<float>(conv_row, num_filters);
+    conv_row += num_filters;
+    for (int64_t unfolded_inx = 1; unfolded_inx < word_unfolded_width; unfolded_inx++) {
+      result = result.max(ConstEigenVectorArrayMap<float>(conv_row, num_filters));
+      conv_row += num_filters;
     }
-    word_inx = tmp_word_inx;
+    result += ConstEigenVectorArrayMap<float>(bias, num_filters);
+    MlasComputeTanh(result_ptr, result_ptr, static_cast<size_t>(num_filters));
   }
 }
+
 void WordConvEmbedding::CalculateLengthOfEachWordInSequence(
     const int* seq_ptr,
     int* words_len_ptr,
@@ -182,43 +192,64 @@ Status WordConvEmbedding::Compute(OpKernelContext* ctx) const {
   TensorShape Y_dims{seq_len, filter_size};
   Tensor* Y = ctx->Output(/*index*/ 0, Y_dims);
 
+  if (filter_width > word_len) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Conv kernel size 1 ", filter_width,
+                           " is larger than the word length ", word_len);
+  }
+
   const int* seq_ptr = sequence.Data<int>();
+  float* output = Y->MutableData<float>();
+  if (seq_len == 0) {
+    return Status::OK();
+  }
 
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
 
-  // allocate memory for char look up
-  // seq_len * word_len * char_embedding_size
-  size_t chars_embeddings_size = seq_len * word_len * char_embedding_size;
-  auto chars_embeddings_ptr = IAllocator::MakeUniquePtr<float>(alloc, chars_embeddings_size);
   auto words_length_ptr = IAllocator::MakeUniquePtr<int>(alloc, seq_len);
-  std::memset(chars_embeddings_ptr.get(), 0, chars_embeddings_size * sizeof(float));
-  std::memset(words_length_ptr.get(), 0, seq_len * sizeof(int));
-
   CalculateLengthOfEachWordInSequence(seq_ptr, words_length_ptr.get(), seq_len, word_len);
 
-  CharEmbeddingLookup(seq_ptr,
-                      w_char_embedding.Data<float>(),
-                      seq_len,
-                      word_len,
-                      char_embedding_size,
-                      filter_width,
-                      words_length_ptr.get(),
-                      chars_embeddings_ptr.get());
-
-  ComputeConvMaxPoolWithActivation(
-      alloc,
-      chars_embeddings_ptr.get(),
-      w_conv.Data<float>(),
-      b_conv.Data<float>(),
-      words_length_ptr.get(),
-      seq_len,
-      word_len,
-      char_embedding_size,
-      filter_width,
-      filter_size,
-      Y->MutableData<float>(),
-      ctx->GetOperatorThreadPool());
+  // the filters are packed once by PrePack if they are a constant initializer
+  const void* packed_filters = packed_filters_;
+  BufferUniquePtr packed_filters_buffer;
+  if (packed_filters == nullptr) {
+    size_t packed_size = 0;
+    packed_filters_buffer = PackFilters(alloc, w_conv, packed_size);
+    packed_filters = packed_filters_buffer.get();
+  }
+
+  // each task unfolds and convolves its words with a single GEMM in its own buffers. with a single task, the GEMM
+  // is threaded instead.
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const int64_t num_tasks = tp == nullptr ? 1 : std::min<int64_t>((seq_len + kWordsPerTask - 1) / kWordsPerTask,
+                                                                  tp->NumThreads());
+  const int64_t words_per_task = (seq_len + num_tasks - 1) / num_tasks;
+  const int64_t unfolded_width = word_len - filter_width + 1;
+  const int64_t unfolded_buffer_size = words_per_task * unfolded_width * filter_width * char_embedding_size;
+  const int64_t conv_buffer_size = words_per_task * unfolded_width * filter_size;
+  auto buffers = IAllocator::MakeUniquePtr<float>(alloc, num_tasks * (unfolded_buffer_size + conv_buffer_size));
+
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_tasks), [&](int32_t task) {
+    const int64_t first_word = task * words_per_task;
+    const int64_t last_word = std::min(seq_len, first_word + words_per_task);
+    float* unfolded_buffer = buffers.get() + task * (unfolded_buffer_size + conv_buffer_size);
+    ComputeConvMaxPoolWithActivation(
+        seq_ptr,
+        w_char_embedding.Data<float>(),
+        packed_filters,
+        b_conv.Data<float>(),
+        words_length_ptr.get(),
+        first_word,
+        last_word,
+        word_len,
+        char_embedding_size,
+        filter_width,
+        filter_size,
+        unfolded_buffer,
+        unfolded_buffer + unfolded_buffer_size,
+        output,
+        num_tasks == 1 ? tp : nullptr);
+  });
 
   return Status::OK();
 }
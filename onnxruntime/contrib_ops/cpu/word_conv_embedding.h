@@ -20,28 +20,28 @@ class WordConvEmbedding final : public OpKernel {
 
   Status Compute(OpKernelContext* context) const override;
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights& prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(const PrePackedWeights& prepacked_weights, int input_idx) override;
+
  private:
-  void CharEmbeddingLookup(
+  void ComputeConvMaxPoolWithActivation(
       const int* seq_ptr,
       const float* char_embedding_weight_p,
-      size_t seq_len,
-      size_t word_len,
-      size_t char_embedding_size,
-      size_t filter_width,
-      const int* words_len_ptr,
-      float* dst) const;
-  void ComputeConvMaxPoolWithActivation(
-      AllocatorPtr allocator,
-      const float* input,
-      const float* weights,
+      const void* packed_filters,
       const float* bias,
       const int* words_len_ptr,
-      int64_t seq_len,
+      int64_t first_word,
+      int64_t last_word,
       int64_t word_len,
       int64_t char_embedding_size,
       int64_t filter_width,
       int64_t num_filters,
-      float* output, onnxruntime::concurrency::ThreadPool* tp) const;
+      float* unfolded_buffer,
+      float* conv_buffer,
+      float* output,
+      onnxruntime::concurrency::ThreadPool* tp) const;
   void CalculateLengthOfEachWordInSequence(
       const int* seq_ptr,
       int* words_len_ptr,
@@ -56,6 +56,9 @@ class WordConvEmbedding final : public OpKernel {
   int64_t embedding_size_{Info().GetAttrOrDefault<int64_t>("embedding_size", -1)};
   int64_t conv_window_size_{Info().GetAttrOrDefault<int64_t>("conv_window_size", -1)};
   int64_t char_embedding_size_{Info().GetAttrOrDefault<int64_t>("char_embedding_size", -1)};
+
+  // the conv weights packed by PrePack, nullptr if they aren't a constant initializer
+  const void* packed_filters_{nullptr};
 };
 
 }  // namespace contrib
@@ -41,11 +41,21 @@ Status Attention<T>::ComputeInternal(OpKernelContext* context) const {
   //   Input 1 - weights     : (hidden_size, 3 * hidden_size)
   //   Input 2 - bias        : (3 * hidden_size)
   //   Input 3 - mask_index  : (batch_size)
-  //   Output                : (batch_size, sequence_length, hidden_size)
+  //   Input 4 - past        : not supported
+  //   Output 0              : (batch_size, sequence_length, hidden_size)
+  //   Output 1 - present    : not supported
   const Tensor* input = context->Input<Tensor>(0);
   const Tensor* weights = context->Input<Tensor>(1);
   const Tensor* bias = context->Input<Tensor>(2);
   const Tensor* mask_index = context->Input<Tensor>(3);
+  if (mask_index == nullptr || is_unidirectional_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                           "Attention on CUDA requires mask_index and does not support the unidirectional attribute");
+  }
+  if (context->Input<Tensor>(4) != nullptr || (Node().OutputDefs().size() > 1 && Node().OutputDefs()[1]->Exists())) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                           "Attention on CUDA does not support the past input and the present output");
+  }
 
   const auto dims = input->Shape().GetDims();
   int batch_size = static_cast<int>(dims[0]);
@@ -25,6 +25,7 @@ limitations under the License.
 #include <cublas_v2.h>
 #include <cuda_fp16.h>
 #include <math_constants.h>
+#include <mma.h>
 #include "core/providers/cuda/cu_inc/common.cuh"
 #include "core/providers/cuda/cuda_common.h"
 #include "attention_impl.h"
@@ -49,7 +50,15 @@ size_t ScratchSize(size_t element_size, int batch_size, int num_heads, int seque
   return bytesAligned;
 }
 
+// Largest head size of the fused attention kernels. Larger heads go through the GEMM + softmax path.
+constexpr int kFusedMaxHeadSize = 128;
+
 size_t GetAttentionWorkspaceSize(size_t element_size, int batch_size, int num_heads, int head_size, int sequence_length) {
+  // the fused kernels read Q, K and V from the input in place and don't materialize the BxNxSxS scores
+  if (head_size <= kFusedMaxHeadSize) {
+    return 0;
+  }
+
   size_t qkv_size = 3 * batch_size * sequence_length * num_heads * head_size * element_size;
   return qkv_size + 2 * ScratchSize(element_size, batch_size, num_heads, sequence_length);
 }
@@ -405,6 +414,326 @@ bool QkvToContext(
   return LaunchTransCtx(stream, sequence_length, batch_size, head_size, num_heads, scratch3, output);
 }
 
+// Fused attention: each thread block computes the context of a tile of query rows of one head. The keys and values
+// are streamed through shared memory a tile at a time and the softmax is computed online: every row keeps the running
+// max and sum of its scores, and the partial context is rescaled whenever the max grows. The scores never leave the
+// chip, so the memory traffic is O(S*H) per head instead of O(S^2), and no workspace is needed.
+// Input is the BxSx3xNxH output of the QKV GEMM, output is BxSxNxH.
+constexpr int kWarpSize = 32;
+constexpr int kFusedWarps = 4;
+constexpr int kFusedBlockN = kWarpSize;  // keys per tile, one per lane in the softmax
+constexpr int kFusedRowsPerWarp = 4;
+
+__device__ inline float WarpReduceMax(float value) {
+#pragma unroll
+  for (int offset = kWarpSize / 2; offset > 0; offset /= 2) {
+    value = fmaxf(value, __shfl_xor_sync(0xffffffff, value, offset));
+  }
+  return value;
+}
+
+__device__ inline float WarpReduceSum(float value) {
+#pragma unroll
+  for (int offset = kWarpSize / 2; offset > 0; offset /= 2) {
+    value += __shfl_xor_sync(0xffffffff, value, offset);
+  }
+  return value;
+}
+
+__device__ inline int QkvOffset(int batch, int sequence_length, int s, int matrix, int num_heads, int head_size,
+                                int head) {
+  return ((batch * sequence_length + s) * 3 + matrix) * num_heads * head_size + head * head_size;
+}
+
+// SIMT kernel with fp32 accumulation, for any head size up to kFusedMaxHeadSize.
+// Each warp owns kFusedRowsPerWarp query rows, lane j scores key j of the tile and the context is split over lanes.
+template <typename T>
+__global__ void FusedAttentionKernel(const int sequence_length, const int head_size, const float scale,
+                                     const int* mask_index, const T* input, T* output) {
+  constexpr int kBlockM = kFusedWarps * kFusedRowsPerWarp;
+  constexpr int kValuesPerLane = kFusedMaxHeadSize / kWarpSize;
+  __shared__ float q_tile[kBlockM][kFusedMaxHeadSize];
+  __shared__ float k_tile[kFusedBlockN][kFusedMaxHeadSize + 1];  // padded so that lanes reading a column don't conflict
+  __shared__ float v_tile[kFusedBlockN][kFusedMaxHeadSize];
+
+  const int head = blockIdx.y;
+  const int num_heads = gridDim.y;
+  const int batch = blockIdx.z;
+  const int row_begin = blockIdx.x * kBlockM;
+  const int warp = threadIdx.x / kWarpSize;
+  const int lane = threadIdx.x % kWarpSize;
+  const int num_valid = min(sequence_length, mask_index[batch]);
+
+  for (int i = threadIdx.x; i < kBlockM * head_size; i += blockDim.x) {
+    const int r = i / head_size;
+    const int d = i % head_size;
+    const int s = row_begin + r;
+    q_tile[r][d] = s < sequence_length
+                       ? float(input[QkvOffset(batch, sequence_length, s, 0, num_heads, head_size, head) + d]) * scale
+                       : 0.f;
+  }
+
+  float row_max[kFusedRowsPerWarp];
+  float row_sum[kFusedRowsPerWarp];
+  float context[kFusedRowsPerWarp][kValuesPerLane];
+#pragma unroll
+  for (int r = 0; r < kFusedRowsPerWarp; ++r) {
+    row_max[r] = -CUDART_INF_F;
+    row_sum[r] = 0.f;
+#pragma unroll
+    for (int v = 0; v < kValuesPerLane; ++v) {
+      context[r][v] = 0.f;
+    }
+  }
+
+  // keys past the mask are skipped entirely
+  for (int key_begin = 0; key_begin < num_valid; key_begin += kFusedBlockN) {
+    __syncthreads();
+    for (int i = threadIdx.x; i < kFusedBlockN * head_size; i += blockDim.x) {
+      const int j = i / head_size;
+      const int d = i % head_size;
+      const int s = key_begin + j;
+      const bool valid = s < num_valid;
+      k_tile[j][d] = valid ? float(input[QkvOffset(batch, sequence_length, s, 1, num_heads, head_size, head) + d]) : 0.f;
+      v_tile[j][d] = valid ? float(input[QkvOffset(batch, sequence_length, s, 2, num_heads, head_size, head) + d]) : 0.f;
+    }
+    __syncthreads();
+
+    const bool key_valid = key_begin + lane < num_valid;
+#pragma unroll
+    for (int r = 0; r < kFusedRowsPerWarp; ++r) {
+      const int row = warp * kFusedRowsPerWarp + r;
+      float score = -CUDART_INF_F;
+      if (key_valid) {
+        score = 0.f;
+        for (int d = 0; d < head_size; ++d) {
+          score += q_tile[row][d] * k_tile[lane][d];
+        }
+      }
+
+      // the first key of the tile is valid, so the new max is finite
+      const float new_max = fmaxf(row_max[r], WarpReduceMax(score));
+      const float p = key_valid ? expf(score - new_max) : 0.f;
+      const float correction = expf(row_max[r] - new_max);
+      row_sum[r] = row_sum[r] * correction + WarpReduceSum(p);
+      row_max[r] = new_max;
+
+#pragma unroll
+      for (int v = 0; v < kValuesPerLane; ++v) {
+        context[r][v] *= correction;
+      }
+      for (int j = 0; j < kFusedBlockN; ++j) {
+        const float p_j = __shfl_sync(0xffffffff, p, j);
+#pragma unroll
+        for (int v = 0; v < kValuesPerLane; ++v) {
+          const int d = v * kWarpSize + lane;
+          if (d < head_size) {
+            context[r][v] += p_j * v_tile[j][d];
+          }
+        }
+      }
+    }
+  }
+
+#pragma unroll
+  for (int r = 0; r < kFusedRowsPerWarp; ++r) {
+    const int s = row_begin + warp * kFusedRowsPerWarp + r;
+    if (s < sequence_length) {
+      // a fully masked row has no valid key, its context is 0
+      const float inverse_sum = row_sum[r] > 0.f ? 1.f / row_sum[r] : 0.f;
+#pragma unroll
+      for (int v = 0; v < kValuesPerLane; ++v) {
+        const int d = v * kWarpSize + lane;
+        if (d < head_size) {
+          output[((batch * sequence_length + s) * num_heads + head) * head_size + d] = T(context[r][v] * inverse_sum);
+        }
+      }
+    }
+  }
+}
+
+// Tensor core kernel for fp16 on sm_70 and later, head size a multiple of 16.
+// The Q*K' and P*V products of a tile run on WMMA 16x16x16 fragments with fp32 accumulation. The running context is
+// kept in shared memory in fp32, where the softmax step rescales it before the next P*V accumulates into it.
+constexpr int kWmmaSize = 16;
+constexpr int kWmmaBlockM = 32;
+constexpr int kWmmaRowsPerWarp = kWmmaBlockM / kFusedWarps;
+// leading dimensions, padded to spread the rows over the shared memory banks while keeping the 32 byte alignment
+// that the WMMA loads and stores need
+constexpr int kWmmaHalfLd = kFusedMaxHeadSize + 8;
+constexpr int kWmmaContextLd = kFusedMaxHeadSize + 4;
+constexpr int kWmmaScoreLd = kFusedBlockN + 4;
+constexpr int kWmmaProbLd = kFusedBlockN + 8;
+
+__global__ void FusedAttentionTensorCoreKernel(const int sequence_length, const int head_size, const float scale,
+                                               const int* mask_index, const half* input, half* output) {
+#if __CUDA_ARCH__ >= 700
+  using namespace nvcuda;
+  using FragmentA = wmma::fragment<wmma::matrix_a, kWmmaSize, kWmmaSize, kWmmaSize, half, wmma::row_major>;
+  using FragmentC = wmma::fragment<wmma::accumulator, kWmmaSize, kWmmaSize, kWmmaSize, float>;
+  constexpr int kMaxSteps = kFusedMaxHeadSize / kWmmaSize;
+
+  // the Q tile is only read once into fragments, the context tile reuses its memory
+  __shared__ __align__(32) char q_context_buffer[kWmmaBlockM * kWmmaContextLd * sizeof(float)];
+  __shared__ __align__(32) half k_tile[kFusedBlockN * kWmmaHalfLd];
+  __shared__ __align__(32) half v_tile[kFusedBlockN * kWmmaHalfLd];
+  __shared__ __align__(32) float score_tile[kWmmaBlockM * kWmmaScoreLd];
+  __shared__ __align__(32) half prob_tile[kWmmaBlockM * kWmmaProbLd];
+  __shared__ float row_max[kWmmaBlockM];
+  __shared__ float row_sum[kWmmaBlockM];
+  half* q_tile = reinterpret_cast<half*>(q_context_buffer);
+  float* context_tile = reinterpret_cast<float*>(q_context_buffer);
+
+  const int head = blockIdx.y;
+  const int num_heads = gridDim.y;
+  const int batch = blockIdx.z;
+  const int row_begin = blockIdx.x * kWmmaBlockM;
+  const int warp = threadIdx.x / kWarpSize;
+  const int lane = threadIdx.x % kWarpSize;
+  const int num_valid = min(sequence_length, mask_index[batch]);
+  const int steps = head_size / kWmmaSize;
+
+  for (int i = threadIdx.x; i < kWmmaBlockM * head_size; i += blockDim.x) {
+    const int r = i / head_size;
+    const int d = i % head_size;
+    const int s = row_begin + r;
+    q_tile[r * kWmmaHalfLd + d] =
+        s < sequence_length ? input[QkvOffset(batch, sequence_length, s, 0, num_heads, head_size, head) + d]
+                            : __float2half(0.f);
+  }
+  __syncthreads();
+
+  // warp w computes the 16x16 score block (w / 2, w % 2) of every tile
+  const int score_m = warp / 2;
+  const int score_n = warp % 2;
+  FragmentA q_fragments[kMaxSteps];
+#pragma unroll
+  for (int k = 0; k < kMaxSteps; ++k) {
+    if (k < steps) {
+      wmma::load_matrix_sync(q_fragments[k], q_tile + score_m * kWmmaSize * kWmmaHalfLd + k * kWmmaSize, kWmmaHalfLd);
+    }
+  }
+  __syncthreads();
+
+  for (int i = threadIdx.x; i < kWmmaBlockM * kWmmaContextLd; i += blockDim.x) {
+    context_tile[i] = 0.f;
+  }
+  if (threadIdx.x < kWmmaBlockM) {
+    row_max[threadIdx.x] = -CUDART_INF_F;
+    row_sum[threadIdx.x] = 0.f;
+  }
+
+  for (int key_begin = 0; key_begin < num_valid; key_begin += kFusedBlockN) {
+    __syncthreads();
+    for (int i = threadIdx.x; i < kFusedBlockN * head_size; i += blockDim.x) {
+      const int j = i / head_size;
+      const int d = i % head_size;
+      const int s = key_begin + j;
+      const bool valid = s < num_valid;
+      k_tile[j * kWmmaHalfLd + d] =
+          valid ? input[QkvOffset(batch, sequence_length, s, 1, num_heads, head_size, head) + d] : __float2half(0.f);
+      v_tile[j * kWmmaHalfLd + d] =
+          valid ? input[QkvOffset(batch, sequence_length, s, 2, num_heads, head_size, head) + d] : __float2half(0.f);
+    }
+    __syncthreads();
+
+    // S = Q * K', K is read as a column major K'
+    {
+      FragmentC score;
+      wmma::fill_fragment(score, 0.f);
+#pragma unroll
+      for (int k = 0; k < kMaxSteps; ++k) {
+        if (k < steps) {
+          wmma::fragment<wmma::matrix_b, kWmmaSize, kWmmaSize, kWmmaSize, half, wmma::col_major> key;
+          wmma::load_matrix_sync(key, k_tile + score_n * kWmmaSize * kWmmaHalfLd + k * kWmmaSize, kWmmaHalfLd);
+          wmma::mma_sync(score, q_fragments[k], key, score);
+        }
+      }
+      wmma::store_matrix_sync(score_tile + score_m * kWmmaSize * kWmmaScoreLd + score_n * kWmmaSize, score,
+                              kWmmaScoreLd, wmma::mem_row_major);
+    }
+    __syncthreads();
+
+    // online softmax of the tile, lane j takes key j of each row of the warp
+    const bool key_valid = key_begin + lane < num_valid;
+    for (int r = 0; r < kWmmaRowsPerWarp; ++r) {
+      const int row = warp * kWmmaRowsPerWarp + r;
+      const float score = key_valid ? score_tile[row * kWmmaScoreLd + lane] * scale : -CUDART_INF_F;
+      const float old_max = row_max[row];
+      const float new_max = fmaxf(old_max, WarpReduceMax(score));
+      const float p = key_valid ? expf(score - new_max) : 0.f;
+      const float correction = expf(old_max - new_max);
+      const float tile_sum = WarpReduceSum(p);
+      prob_tile[row * kWmmaProbLd + lane] = __float2half(p);
+      for (int d = lane; d < head_size; d += kWarpSize) {
+        context_tile[row * kWmmaContextLd + d] *= correction;
+      }
+      if (lane == 0) {
+        row_max[row] = new_max;
+        row_sum[row] = row_sum[row] * correction + tile_sum;
+      }
+    }
+    __syncthreads();
+
+    // context += P * V
+    for (int f = warp; f < (kWmmaBlockM / kWmmaSize) * steps; f += kFusedWarps) {
+      const int context_m = f / steps;
+      const int context_n = f % steps;
+      float* context_block = context_tile + context_m * kWmmaSize * kWmmaContextLd + context_n * kWmmaSize;
+      FragmentC context;
+      wmma::load_matrix_sync(context, context_block, kWmmaContextLd, wmma::mem_row_major);
+#pragma unroll
+      for (int k = 0; k < kFusedBlockN / kWmmaSize; ++k) {
+        FragmentA prob;
+        wmma::fragment<wmma::matrix_b, kWmmaSize, kWmmaSize, kWmmaSize, half, wmma::row_major> value;
+        wmma::load_matrix_sync(prob, prob_tile + context_m * kWmmaSize * kWmmaProbLd + k * kWmmaSize, kWmmaProbLd);
+        wmma::load_matrix_sync(value, v_tile + k * kWmmaSize * kWmmaHalfLd + context_n * kWmmaSize, kWmmaHalfLd);
+        wmma::mma_sync(context, prob, value, context);
+      }
+      wmma::store_matrix_sync(context_block, context, kWmmaContextLd, wmma::mem_row_major);
+    }
+  }
+  __syncthreads();
+
+  for (int i = threadIdx.x; i < kWmmaBlockM * head_size; i += blockDim.x) {
+    const int r = i / head_size;
+    const int d = i % head_size;
+    const int s = row_begin + r;
+    if (s < sequence_length) {
+      const float inverse_sum = row_sum[r] > 0.f ? 1.f / row_sum[r] : 0.f;
+      output[((batch * sequence_length + s) * num_heads + head) * head_size + d] =
+          __float2half(context_tile[r * kWmmaContextLd + d] * inverse_sum);
+    }
+  }
+#endif
+}
+
+template <typename T>
+bool LaunchFusedAttention(cudaStream_t stream,
+                          const int batch_size, const int sequence_length, const int num_heads, const int head_size,
+                          const T* input, T* output, const int* mask_index) {
+  const float rsqrt_head_size = 1.f / sqrt(static_cast<float>(head_size));
+  const dim3 grid(CeilDiv(sequence_length, kFusedWarps * kFusedRowsPerWarp), num_heads, batch_size);
+  FusedAttentionKernel<T><<<grid, kFusedWarps * kWarpSize, 0, stream>>>(
+      sequence_length, head_size, rsqrt_head_size, mask_index, input, output);
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
+bool LaunchFusedAttention(cudaStream_t stream,
+                          const int batch_size, const int sequence_length, const int num_heads, const int head_size,
+                          const half* input, half* output, const int* mask_index) {
+  if (head_size % kWmmaSize != 0 || DeviceProp::GetDeviceProps().major < 7) {
+    return LaunchFusedAttention<half>(stream, batch_size, sequence_length, num_heads, head_size,
+                                      input, output, mask_index);
+  }
+
+  const float rsqrt_head_size = 1.f / sqrt(static_cast<float>(head_size));
+  const dim3 grid(CeilDiv(sequence_length, kWmmaBlockM), num_heads, batch_size);
+  FusedAttentionTensorCoreKernel<<<grid, kFusedWarps * kWarpSize, 0, stream>>>(
+      sequence_length, head_size, rsqrt_head_size, mask_index, input, output);
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
 bool LaunchAttentionKernel(
     const void* input,
     const int* mask_index,
@@ -419,6 +748,15 @@ bool LaunchAttentionKernel(
   // use default stream
   const cudaStream_t stream = nullptr;
 
+  if (head_size <= kFusedMaxHeadSize) {
+    if (element_size == 2) {
+      return LaunchFusedAttention(stream, batch_size, sequence_length, num_heads, head_size,
+                                  reinterpret_cast<const half*>(input), reinterpret_cast<half*>(output), mask_index);
+    }
+    return LaunchFusedAttention(stream, batch_size, sequence_length, num_heads, head_size,
+                                reinterpret_cast<const float*>(input), reinterpret_cast<float*>(output), mask_index);
+  }
+
   if (element_size == 2) {
     return QkvToContext(cublas, stream,
                         batch_size, sequence_length, num_heads, head_size, element_size,
@@ -7,6 +7,7 @@
 namespace onnxruntime {
 namespace contrib {
 namespace cuda {
+  // Heads of up to 128 run in a fused kernel that needs no workspace, larger heads need BxNxSxS scratch buffers.
   size_t GetAttentionWorkspaceSize(size_t element_size, int batchsize, int num_heads, int head_size, int sequence_length);
 
   bool LaunchAttentionKernel(
@@ -17,7 +18,7 @@ namespace cuda {
    int sequence_length,       // Sequence length (S)
    int num_heads,             // Number of attention heads (N)
    int head_size,             // Hidden layer size per head (H)
-   void* workspace,           // Temporary buffer 
+   void* workspace,           // Temporary buffer, see GetAttentionWorkspaceSize
    cublasHandle_t& cublas,    // Cublas handle
    const size_t element_size  // Element size of input tensor
    );
@@ -69,6 +69,86 @@ __global__ void SkipLayerNormKernel(
   LayerNorm<T, TPB>(thread_data, ld, offset, beta, gamma, output);
 }
 
+// Each thread adds a vector of ILP elements of input, skip and bias loaded with single vector instructions, the row
+// must fit in one pass of the block (ld <= TPB * ILP). The mean and variance are accumulated in fp32 for fp16 too.
+template <typename T, unsigned TPB, int ILP>
+__global__ void SkipLayerNormKernelVec(
+    const int ld, const T* input, const T* skip, const T* beta, const T* gamma, const T* bias, T* output) {
+  using VecT = AlignedVector<T, ILP>;
+  const float reverse_ld = 1.f / ld;
+  const int offset = blockIdx.x * ld;
+  const int i = threadIdx.x * ILP;
+
+  // reduce x and x^2
+  cub::KeyValuePair<float, float> thread_data(0.f, 0.f);
+  float val[ILP];
+  if (i < ld) {
+    const VecT input_v = *reinterpret_cast<const VecT*>(&input[offset + i]);
+    const VecT skip_v = *reinterpret_cast<const VecT*>(&skip[offset + i]);
+    VecT bias_v;
+    if (bias != nullptr) {
+      bias_v = *reinterpret_cast<const VecT*>(&bias[i]);
+    }
+
+#pragma unroll
+    for (int k = 0; k < ILP; ++k) {
+      val[k] = float(input_v.val[k]) + float(skip_v.val[k]);
+      if (bias != nullptr) {
+        val[k] += float(bias_v.val[k]);
+      }
+      const float rldval = reverse_ld * val[k];
+      thread_data.key += rldval;
+      thread_data.value += rldval * val[k];
+    }
+  }
+
+  using BlockReduce = cub::BlockReduce<cub::KeyValuePair<float, float>, TPB>;
+  __shared__ typename BlockReduce::TempStorage temp_storage;
+  __shared__ float mu;      // mean
+  __shared__ float rsigma;  // 1 / std.dev.
+
+  KeyValuePairSum pair_sum;
+  const auto sum_kv = BlockReduce(temp_storage).Reduce(thread_data, pair_sum);
+
+  if (threadIdx.x == 0) {
+    mu = sum_kv.key;
+    rsigma = Rsqrt(sum_kv.value - mu * mu);
+  }
+  __syncthreads();
+
+  if (i < ld) {
+    const VecT gamma_v = *reinterpret_cast<const VecT*>(&gamma[i]);
+    const VecT beta_v = *reinterpret_cast<const VecT*>(&beta[i]);
+    VecT output_v;
+#pragma unroll
+    for (int k = 0; k < ILP; ++k) {
+      output_v.val[k] = T(float(gamma_v.val[k]) * (val[k] - mu) * rsigma + float(beta_v.val[k]));
+    }
+    *reinterpret_cast<VecT*>(&output[offset + i]) = output_v;
+  }
+}
+
+template <typename T, int ILP>
+bool LaunchSkipLayerNormVec(
+    cudaStream_t stream, const int ld, const int grid_size, const T* input, const T* skip,
+    const T* beta, const T* gamma, const T* bias, T* output) {
+  const int threads = ld / ILP;
+  if (threads <= 32) {
+    SkipLayerNormKernelVec<T, 32, ILP><<<grid_size, 32, 0, stream>>>(ld, input, skip, beta, gamma, bias, output);
+  } else if (threads <= 64) {
+    SkipLayerNormKernelVec<T, 64, ILP><<<grid_size, 64, 0, stream>>>(ld, input, skip, beta, gamma, bias, output);
+  } else if (threads <= 128) {
+    SkipLayerNormKernelVec<T, 128, ILP><<<grid_size, 128, 0, stream>>>(ld, input, skip, beta, gamma, bias, output);
+  } else if (threads <= 256) {
+    SkipLayerNormKernelVec<T, 256, ILP><<<grid_size, 256, 0, stream>>>(ld, input, skip, beta, gamma, bias, output);
+  } else if (threads <= 512) {
+    SkipLayerNormKernelVec<T, 512, ILP><<<grid_size, 512, 0, stream>>>(ld, input, skip, beta, gamma, bias, output);
+  } else {
+    return false;
+  }
+  return true;
+}
+
 template <typename T>
 bool ComputeSkipLayerNorm(
     cudaStream_t stream, const int ld, const int n, const T* input, const T* skip,
@@ -77,6 +157,12 @@ bool ComputeSkipLayerNorm(
   assert(n % ld == 0);
   const int grid_size = n / ld;
 
+  // 16 byte loads: 8 halves or 4 floats per thread
+  constexpr int ILP = 16 / sizeof(T);
+  if (ld % ILP == 0 && LaunchSkipLayerNormVec<T, ILP>(stream, ld, grid_size, input, skip, beta, gamma, bias, output)) {
+    return CUDA_CALL(cudaPeekAtLastError());
+  }
+
   if (ld <= 32) {
     constexpr int block_size = 32;
     SkipLayerNormKernelSmall<T, block_size>
@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "core/providers/cuda/shared_inc/cuda_call.h"
+#include "bias_gelu_impl.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// fp16 values are computed in fp32
+template <typename T>
+struct BiasGeluCompute {
+  using type = T;
+};
+
+template <>
+struct BiasGeluCompute<half> {
+  using type = float;
+};
+
+// Each thread handles ILP consecutive elements, read and written with single vector instructions. The elements of a
+// vector share the bias vector at the same position of the last axis, so bias_length must be a multiple of ILP.
+template <typename T, unsigned TPB, int ILP>
+__global__ void BiasGeluKernel(int input_length, int bias_length, const T* input, const T* bias, T* output) {
+  using VecT = AlignedVector<T, ILP>;
+  using ComputeT = typename BiasGeluCompute<T>::type;
+  const int idx = (blockIdx.x * TPB + threadIdx.x) * ILP;
+
+  if (idx < input_length) {
+    const VecT input_v = *reinterpret_cast<const VecT*>(&input[idx]);
+    const VecT bias_v = *reinterpret_cast<const VecT*>(&bias[idx % bias_length]);
+    VecT output_v;
+#pragma unroll
+    for (int k = 0; k < ILP; ++k) {
+      const ComputeT x = static_cast<ComputeT>(input_v.val[k]) + static_cast<ComputeT>(bias_v.val[k]);
+      output_v.val[k] = T(_Gelu(x));
+    }
+    *reinterpret_cast<VecT*>(&output[idx]) = output_v;
+  }
+}
+
+template <typename T>
+bool LaunchBiasGeluKernel(cudaStream_t stream, int input_length, int bias_length, const T* input, const T* bias, T* output) {
+  constexpr int blockSize = 256;
+
+  // 16 byte loads: 8 halves, 4 floats or 2 doubles per thread
+  constexpr int ILP = 16 / sizeof(T);
+  if (0 == (bias_length % ILP)) {
+    const int gridSize = CeilDiv(input_length / ILP, blockSize);
+    BiasGeluKernel<T, blockSize, ILP><<<gridSize, blockSize, 0, stream>>>(input_length, bias_length, input, bias, output);
+  } else {
+    const int gridSize = CeilDiv(input_length, blockSize);
+    BiasGeluKernel<T, blockSize, 1><<<gridSize, blockSize, 0, stream>>>(input_length, bias_length, input, bias, output);
+  }
+
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
+template bool LaunchBiasGeluKernel(cudaStream_t stream, int input_length, int bias_length, const half* input, const half* bias, half* output);
+template bool LaunchBiasGeluKernel(cudaStream_t stream, int input_length, int bias_length, const float* input, const float* bias, float* output);
+template bool LaunchBiasGeluKernel(cudaStream_t stream, int input_length, int bias_length, const double* input, const double* bias, double* output);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,16 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Gelu(input + bias) where bias is a vector along the last axis of input, i.e. bias_length divides input_length.
+template <typename T>
+bool LaunchBiasGeluKernel(cudaStream_t stream, int input_length, int bias_length, const T* input, const T* bias, T* output);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #include "binary_elementwise_ops.h"
 #include "binary_elementwise_ops_impl.h"
+#include "bias_gelu_impl.h"
 
 using namespace onnxruntime::common;
 namespace onnxruntime {
@@ -62,7 +63,52 @@ namespace cuda {
   CONTRIB_BINARY_OP_TYPED(name, ver, float)     \
   CONTRIB_BINARY_OP_TYPED(name, ver, double)
 
-CONTRIB_BINARY_OP_HFD(BiasGelu, 1)
+#define CONTRIB_BINARY_ELEMENTWISE_REGISTER_KERNEL_HFD(name, ver)        \
+  CONTRIB_BINARY_ELEMENTWISE_REGISTER_KERNEL_TYPED(name, ver, MLFloat16) \
+  CONTRIB_BINARY_ELEMENTWISE_REGISTER_KERNEL_TYPED(name, ver, float)     \
+  CONTRIB_BINARY_ELEMENTWISE_REGISTER_KERNEL_TYPED(name, ver, double)
+
+CONTRIB_BINARY_ELEMENTWISE_REGISTER_KERNEL_HFD(BiasGelu, 1)
+
+template <typename T>
+Status BiasGelu<T>::ComputeInternal(OpKernelContext* context) const {
+  typedef typename ToCudaType<T>::MappedType CudaT;
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* bias = context->Input<Tensor>(1);
+  const auto& input_shape = input->Shape();
+  const auto& bias_shape = bias->Shape();
+
+  // the Add + Gelu pattern of BiasGeluFusion, bias along the last axis: run the vectorized kernel
+  if (bias_shape.NumDimensions() == 1 && input_shape.NumDimensions() >= 1 && bias_shape[0] > 0 &&
+      bias_shape[0] == input_shape[input_shape.NumDimensions() - 1]) {
+    Tensor* output = context->Output(0, input_shape);
+    if (!LaunchBiasGeluKernel<CudaT>(nullptr,
+                                     static_cast<int>(input_shape.Size()),
+                                     static_cast<int>(bias_shape[0]),
+                                     reinterpret_cast<const CudaT*>(input->template Data<T>()),
+                                     reinterpret_cast<const CudaT*>(bias->template Data<T>()),
+                                     reinterpret_cast<CudaT*>(output->template MutableData<T>()))) {
+      CUDA_CALL(cudaGetLastError());
+      return Status(common::ONNXRUNTIME, common::FAIL);
+    }
+    return Status::OK();
+  }
+
+  BinaryElementwisePreparation prepare;
+  ORT_RETURN_IF_ERROR(Prepare(context, &prepare));
+  Impl_BiasGelu<CudaT>(
+      prepare.output_rank_or_simple_broadcast,
+      &prepare.lhs_padded_strides,
+      reinterpret_cast<const CudaT*>(prepare.lhs_tensor->template Data<T>()),
+      &prepare.rhs_padded_strides,
+      reinterpret_cast<const CudaT*>(prepare.rhs_tensor->template Data<T>()),
+      &prepare.fdm_output_strides,
+      prepare.fdm_H,
+      prepare.fdm_C,
+      reinterpret_cast<CudaT*>(prepare.output_tensor->template MutableData<T>()),
+      prepare.output_tensor->Shape().Size());
+  return Status::OK();
+}
 
 }  // namespace cuda
 }  // namespace contrib
@@ -40,6 +40,8 @@ struct ScheduleContext {
   }
   tvm::Schedule schedule;
   std::map<const tvm::Node*, ScheduleType> scheduled_tensors;
+  // multiplies the natural vector width of the vectorized tensors, 1 in the rule-based schedules
+  int vector_width_factor = 1;
 };
 
 // Scheduler inserts a tvm::Schedule content to a tvm::Tensor
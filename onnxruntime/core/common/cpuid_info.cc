@@ -6,6 +6,7 @@
 #endif
 
 #if defined(PLATFORM_X86)
+#include <cstring>
 #include <memory>
 #include <mutex>
 
@@ -62,6 +63,7 @@ CPUIDInfo::CPUIDInfo() noexcept {
 
       if (num_IDs >= 7) {
         GetCPUID(7, data);
+        is_hybrid_ = (data[3] & (1 << 15)) != 0;
         has_avx2_ = has_avx_ && (data[1] & (1 << 5));
         has_avx512f_ = has_avx512 && (data[1] & (1 << 16));
         // Add check for AVX512 Skylake since tensorization GEMM need intrinsics from avx512bw/avx512dq.
@@ -70,6 +72,20 @@ CPUIDInfo::CPUIDInfo() noexcept {
       }
     }
   }
+
+  // the brand string is returned in 16 byte pieces by the extended functions 0x80000002 to 0x80000004
+  GetCPUID(static_cast<int>(0x80000000u), data);
+  if (static_cast<unsigned int>(data[0]) >= 0x80000004u) {
+    char brand[49] = {};
+    for (int i = 0; i < 3; ++i) {
+      GetCPUID(static_cast<int>(0x80000002u) + i, data);
+      memcpy(brand + 16 * i, data, 16);
+    }
+    cpu_model_ = brand;
+    const auto first = cpu_model_.find_first_not_of(' ');
+    const auto last = cpu_model_.find_last_not_of(' ');
+    cpu_model_ = first == std::string::npos ? std::string() : cpu_model_.substr(first, last - first + 1);
+  }
 #endif
 }
 
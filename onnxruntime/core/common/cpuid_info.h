@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <string>
+
 namespace onnxruntime {
 
 class CPUIDInfo {
@@ -18,6 +20,13 @@ class CPUIDInfo {
   bool HasAVX512Skylake() const { return has_avx512_skylake_; }
   bool HasF16C() const { return has_f16c_; }
 
+  // Whether the processor mixes core types, e.g. the performance and efficiency cores of Intel hybrid processors,
+  // which run the same work at different speeds.
+  bool IsHybrid() const { return is_hybrid_; }
+
+  // The brand string of the processor, or an empty string if it isn't known on this platform.
+  const std::string& GetCPUModel() const { return cpu_model_; }
+
  private:
   CPUIDInfo() noexcept;
   bool has_avx_{false};
@@ -25,6 +34,8 @@ class CPUIDInfo {
   bool has_avx512f_{false};
   bool has_avx512_skylake_{false};
   bool has_f16c_{false};
+  bool is_hybrid_{false};
+  std::string cpu_model_;
 };
 
 }  // namespace onnxruntime
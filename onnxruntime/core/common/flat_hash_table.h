@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+// Open-addressing hash table for lookup tables which are built once, e.g. by a kernel constructor, and then only read
+// in the hot loop of the kernel. The entries are stored contiguously, and the slots only hold a part of the hash of
+// their key and the index of their entry, so the linear probing of a lookup usually reads a single cache line and
+// compares a single key, where std::unordered_map chases a pointer per node of the bucket.
+// Erasing isn't supported. The pointers returned by Find and Emplace are invalidated by the next insertion.
+template <typename TKey, typename TValue, typename THash = std::hash<TKey>, typename TKeyEqual = std::equal_to<TKey>>
+class FlatHashTable {
+ public:
+  FlatHashTable() = default;
+
+  void Reserve(size_t num_entries) {
+    entries_.reserve(num_entries);
+    if (num_entries * 2 > slots_.size()) {
+      Rehash(num_entries * 2);
+    }
+  }
+
+  // Inserts (key, value) if key isn't in the table. Returns the value of key and whether it was inserted.
+  std::pair<TValue*, bool> Emplace(const TKey& key, const TValue& value) {
+    // keep the load factor at or below 1/2 so the probe sequences stay short
+    if ((entries_.size() + 1) * 2 > slots_.size()) {
+      Rehash(std::max<size_t>(16, slots_.size() * 2));
+    }
+    const uint64_t hash = MixHash(hasher_(key));
+    size_t index = static_cast<size_t>(hash) & mask_;
+    const uint32_t tag = Tag(hash);
+    while (slots_[index].entry != 0) {
+      const auto entry = slots_[index].entry - 1;
+      if (slots_[index].tag == tag && key_equal_(entries_[entry].first, key)) {
+        return {&entries_[entry].second, false};
+      }
+      index = (index + 1) & mask_;
+    }
+    ORT_ENFORCE(entries_.size() < UINT32_MAX, "FlatHashTable supports up to 2^32 - 1 entries");
+    entries_.emplace_back(key, value);
+    slots_[index].tag = tag;
+    slots_[index].entry = static_cast<uint32_t>(entries_.size());
+    return {&entries_.back().second, true};
+  }
+
+  // Inserts (key, value), replacing the value of key if it's in the table already.
+  void InsertOrAssign(const TKey& key, const TValue& value) {
+    auto result = Emplace(key, value);
+    if (!result.second) {
+      *result.first = value;
+    }
+  }
+
+  // Returns the value of key, nullptr if key isn't in the table.
+  const TValue* Find(const TKey& key) const {
+    if (entries_.empty()) {
+      return nullptr;
+    }
+    const uint64_t hash = MixHash(hasher_(key));
+    size_t index = static_cast<size_t>(hash) & mask_;
+    const uint32_t tag = Tag(hash);
+    while (slots_[index].entry != 0) {
+      if (slots_[index].tag == tag) {
+        const auto& entry = entries_[slots_[index].entry - 1];
+        if (key_equal_(entry.first, key)) {
+          return &entry.second;
+        }
+      }
+      index = (index + 1) & mask_;
+    }
+    return nullptr;
+  }
+
+  size_t Size() const { return entries_.size(); }
+  bool Empty() const { return entries_.empty(); }
+
+ private:
+  struct Slot {
+    uint32_t tag;
+    uint32_t entry;  // index of the entry + 1, 0 for an empty slot
+  };
+
+  // spreads the hash over all the bits, std::hash of integers being the identity in some implementations
+  static uint64_t MixHash(size_t hash) {
+    uint64_t h = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+    return h ^ (h >> 29);
+  }
+
+  // the bits of the hash which don't select the slot, compared before the keys
+  static uint32_t Tag(uint64_t hash) { return static_cast<uint32_t>(hash >> 32); }
+
+  void Rehash(size_t min_slots) {
+    size_t num_slots = 16;
+    while (num_slots < min_slots) {
+      num_slots *= 2;
+    }
+    slots_.assign(num_slots, Slot{0, 0});
+    mask_ = num_slots - 1;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      const uint64_t hash = MixHash(hasher_(entries_[i].first));
+      size_t index = static_cast<size_t>(hash) & mask_;
+      while (slots_[index].entry != 0) {
+        index = (index + 1) & mask_;
+      }
+      slots_[index].tag = Tag(hash);
+      slots_[index].entry = static_cast<uint32_t>(i + 1);
+    }
+  }
+
+  std::vector<Slot> slots_;
+  std::vector<std::pair<TKey, TValue>> entries_;
+  size_t mask_ = 0;
+  THash hasher_;
+  TKeyEqual key_equal_;
+};
+
+}  // namespace onnxruntime
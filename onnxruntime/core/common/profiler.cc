@@ -3,10 +3,25 @@
 
 #include "profiler.h"
 
+#include <algorithm>
+
 namespace onnxruntime {
 namespace profiling {
 using namespace std::chrono;
 
+std::atomic<uint64_t> Profiler::next_id_{0};
+
+void LatencyHistogram::Add(long long duration_us) {
+  size_t bucket = 0;
+  while (bucket + 1 < kNumBuckets && duration_us >= (1LL << bucket)) {
+    ++bucket;
+  }
+  ++buckets[bucket];
+  ++count;
+  total_us += duration_us;
+  max_us = std::max(max_us, duration_us);
+}
+
 #ifdef ENABLE_STATIC_PROFILER_INSTANCE
 Profiler* Profiler::instance_ = nullptr;
 
@@ -41,6 +56,7 @@ void Profiler::StartProfiling(const logging::Logger* custom_logger) {
   profile_with_logger_ = true;
   custom_logger_ = custom_logger;
   profiling_start_time_ = StartTime();
+  StartDeviceProfilers();
 }
 
 template <typename T>
@@ -49,6 +65,7 @@ void Profiler::StartProfiling(const std::basic_string<T>& file_name) {
   profile_stream_.open(file_name, std::ios::out | std::ios::trunc);
   profile_stream_file_ = ToMBString(file_name);
   profiling_start_time_ = StartTime();
+  StartDeviceProfilers();
 }
 
 template void Profiler::StartProfiling<char>(const std::basic_string<char>& file_name);
@@ -56,23 +73,143 @@ template void Profiler::StartProfiling<char>(const std::basic_string<char>& file
 template void Profiler::StartProfiling<wchar_t>(const std::basic_string<wchar_t>& file_name);
 #endif
 
+void Profiler::EnableSampling(int sampling_interval, std::chrono::milliseconds flush_interval) {
+  ORT_ENFORCE(sampling_interval > 0, "The sampling interval must be positive");
+  ORT_ENFORCE(!enabled_, "Sampling must be enabled before profiling starts");
+  sampling_interval_ = sampling_interval;
+  flush_interval_ = flush_interval;
+}
+
+bool Profiler::SampleExecution() {
+  if (!enabled_) {
+    return false;
+  }
+  if (!IsSampling()) {
+    return true;
+  }
+
+  if (num_executions_.fetch_add(1, std::memory_order_relaxed) % sampling_interval_ != 0) {
+    return false;
+  }
+
+  // merge the thread buffers from time to time so they don't fill up, unless another thread is already doing it
+  const long long now_us = TimeDiffMicroSeconds(profiling_start_time_);
+  if (now_us - last_flush_us_.load(std::memory_order_relaxed) >= duration_cast<microseconds>(flush_interval_).count()) {
+    last_flush_us_.store(now_us, std::memory_order_relaxed);
+    FlushSamples(/*wait*/ false);
+  }
+  return true;
+}
+
+Profiler::SampleBuffer& Profiler::ThreadSampleBuffer() {
+  // the buffers of the thread per profiler id. a profiler registers the buffer of a thread once.
+  thread_local std::unordered_map<uint64_t, SampleBuffer*> thread_buffers;
+  auto it = thread_buffers.find(id_);
+  if (it != thread_buffers.end()) {
+    return *it->second;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto& buffer = sample_buffers_[std::this_thread::get_id()];
+  if (buffer == nullptr) {
+    buffer = onnxruntime::make_unique<SampleBuffer>();
+  }
+  thread_buffers.emplace(id_, buffer.get());
+  return *buffer;
+}
+
+void Profiler::RecordSample(const std::string& event_name, long long duration_us) {
+  SampleBuffer& buffer = ThreadSampleBuffer();
+  const size_t head = buffer.head.load(std::memory_order_relaxed);
+  if (head - buffer.tail.load(std::memory_order_acquire) == SampleBuffer::kCapacity) {
+    buffer.num_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  auto& sample = buffer.samples[head % SampleBuffer::kCapacity];
+  sample.name.assign(event_name);
+  sample.duration_us = duration_us;
+  buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::FlushSamples(bool wait) {
+  std::unique_lock<OrtMutex> flush_lock(flush_mutex_, std::defer_lock);
+  if (wait) {
+    flush_lock.lock();
+  } else if (!flush_lock.try_lock()) {
+    return;
+  }
+
+  std::vector<SampleBuffer*> buffers;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    for (auto& thread_buffer : sample_buffers_) {
+      buffers.push_back(thread_buffer.second.get());
+    }
+  }
+
+  for (SampleBuffer* buffer : buffers) {
+    const size_t tail = buffer->tail.load(std::memory_order_relaxed);
+    const size_t head = buffer->head.load(std::memory_order_acquire);
+    for (size_t i = tail; i < head; ++i) {
+      const auto& sample = buffer->samples[i % SampleBuffer::kCapacity];
+      latency_histograms_[sample.name].Add(sample.duration_us);
+    }
+    buffer->tail.store(head, std::memory_order_release);
+    num_dropped_samples_ += buffer->num_dropped.exchange(0, std::memory_order_relaxed);
+  }
+}
+
+std::unordered_map<std::string, LatencyHistogram> Profiler::GetLatencyHistograms() {
+  FlushSamples(/*wait*/ true);
+  std::lock_guard<OrtMutex> lock(flush_mutex_);
+  return latency_histograms_;
+}
+
 void Profiler::EndTimeAndRecordEvent(EventCategory category,
                                      const std::string& event_name,
                                      TimePoint& start_time,
                                      const std::initializer_list<std::pair<std::string, std::string>>& event_args,
                                      bool /*sync_gpu*/) {
+  EndTimeAndRecordEvent(category, event_name, start_time,
+                        std::unordered_map<std::string, std::string>{event_args.begin(), event_args.end()});
+}
+
+void Profiler::EndTimeAndRecordEvent(EventCategory category,
+                                     const std::string& event_name,
+                                     TimePoint& start_time,
+                                     std::unordered_map<std::string, std::string>&& event_args) {
   long long dur = TimeDiffMicroSeconds(start_time);
+  if (IsSampling()) {
+    RecordSample(event_name, dur);
+    return;
+  }
+
   long long ts = TimeDiffMicroSeconds(profiling_start_time_, start_time);
 
-  EventRecord event(category, logging::GetProcessId(),
-                    logging::GetThreadId(), event_name, ts, dur, {event_args.begin(), event_args.end()});
+  AddEvent(EventRecord(category, logging::GetProcessId(),
+                       logging::GetThreadId(), event_name, ts, dur, std::move(event_args)));
+}
+
+void Profiler::RecordMemoryEvent(const std::string& event_name,
+                                 std::unordered_map<std::string, std::string>&& event_args) {
+  if (!enabled_ || IsSampling()) {
+    return;
+  }
+
+  long long ts = TimeDiffMicroSeconds(profiling_start_time_);
+  AddEvent(EventRecord(MEMORY_EVENT, logging::GetProcessId(),
+                       logging::GetThreadId(), event_name, ts, 0, std::move(event_args)));
+}
+
+void Profiler::AddEvent(EventRecord&& event) {
   if (profile_with_logger_) {
     custom_logger_->SendProfileEvent(event);
   } else {
     //TODO: sync_gpu if needed.
     std::lock_guard<OrtMutex> lock(mutex_);
     if (events_.size() < max_num_events_) {
-      events_.emplace_back(event);
+      events_.emplace_back(std::move(event));
     } else {
       if (session_logger_ && !max_events_reached) {
         LOGS(*session_logger_, ERROR)
@@ -83,10 +220,73 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
   }
 }
 
+void Profiler::AddDeviceProfiler(std::unique_ptr<DeviceProfiler> device_profiler) {
+  ORT_ENFORCE(device_profiler != nullptr);
+  if (enabled_ && !IsSampling()) {
+    device_profiler->Start(profiling_start_time_);
+  }
+  device_profilers_.push_back(std::move(device_profiler));
+}
+
+void Profiler::StartDeviceCorrelation(const std::string& node_name) {
+  if (device_profilers_.empty()) {
+    return;
+  }
+  uint64_t correlation_id;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = correlation_ids_.find(node_name);
+    if (it == correlation_ids_.end()) {
+      correlated_node_names_.push_back(node_name);
+      it = correlation_ids_.emplace(node_name, correlated_node_names_.size()).first;
+    }
+    correlation_id = it->second;
+  }
+  for (auto& device_profiler : device_profilers_) {
+    device_profiler->PushCorrelation(correlation_id);
+  }
+}
+
+void Profiler::EndDeviceCorrelation() {
+  for (auto& device_profiler : device_profilers_) {
+    device_profiler->PopCorrelation();
+  }
+}
+
+void Profiler::StartDeviceProfilers() {
+  if (IsSampling()) {
+    return;
+  }
+  for (auto& device_profiler : device_profilers_) {
+    device_profiler->Start(profiling_start_time_);
+  }
+}
+
+void Profiler::StopDeviceProfilers() {
+  for (auto& device_profiler : device_profilers_) {
+    for (auto& correlated_event : device_profiler->Stop()) {
+      auto& event = correlated_event.second;
+      const uint64_t correlation_id = correlated_event.first;
+      if (correlation_id > 0 && correlation_id <= correlated_node_names_.size()) {
+        event.args["node_name"] = correlated_node_names_[correlation_id - 1];
+      }
+      if (profile_with_logger_) {
+        custom_logger_->SendProfileEvent(event);
+      } else {
+        std::lock_guard<OrtMutex> lock(mutex_);
+        if (events_.size() < max_num_events_) {
+          events_.emplace_back(std::move(event));
+        }
+      }
+    }
+  }
+}
+
 std::string Profiler::EndProfiling() {
   if (!enabled_) {
     return std::string();
   }
+  StopDeviceProfilers();
   if (profile_with_logger_) {
     profile_with_logger_ = false;
     return std::string();
@@ -96,37 +296,107 @@ std::string Profiler::EndProfiling() {
     LOGS(*session_logger_, INFO) << "Writing profiler data to file " << profile_stream_file_;
   }
 
+  if (IsSampling()) {
+    WriteLatencyHistograms();
+    profile_stream_.close();
+    enabled_ = false;
+    return profile_stream_file_;
+  }
+
   std::lock_guard<OrtMutex> lock(mutex_);
   profile_stream_ << "[\n";
 
   for (size_t i = 0; i < events_.size(); ++i) {
-    auto& rec = events_[i];
-    profile_stream_ << R"({"cat" : ")" << event_categor_names_[rec.cat] << "\",";
-    profile_stream_ << "\"pid\" :" << rec.pid << ",";
-    profile_stream_ << "\"tid\" :" << rec.tid << ",";
-    profile_stream_ << "\"dur\" :" << rec.dur << ",";
-    profile_stream_ << "\"ts\" :" << rec.ts << ",";
-    profile_stream_ << R"("ph" : "X",)";
-    profile_stream_ << R"("name" :")" << rec.name << "\",";
-    profile_stream_ << "\"args\" : {";
-    bool is_first_arg = true;
-    for (std::pair<std::string, std::string> event_arg : rec.args) {
-      if (!is_first_arg) profile_stream_ << ",";
-      profile_stream_ << "\"" << event_arg.first << "\" : \"" << event_arg.second << "\"";
-      is_first_arg = false;
-    }
-    profile_stream_ << "}";
-    if (i == events_.size() - 1) {
-      profile_stream_ << "}\n";
-    } else {
-      profile_stream_ << "},\n";
+    if (i > 0) {
+      profile_stream_ << ",\n";
     }
+    WriteEvent(events_[i]);
   }
-  profile_stream_ << "]\n";
+  profile_stream_ << (events_.empty() ? "]\n" : "\n]\n");
   profile_stream_.close();
   enabled_ = false;  // will not collect profile after writing.
   return profile_stream_file_;
 }
 
+void Profiler::WriteEvent(const EventRecord& rec) {
+  const bool is_memory_event = rec.cat == MEMORY_EVENT;
+  profile_stream_ << R"({"cat" : ")" << event_categor_names_[rec.cat] << "\",";
+  profile_stream_ << "\"pid\" :" << rec.pid << ",";
+  profile_stream_ << "\"tid\" :" << rec.tid << ",";
+  profile_stream_ << "\"dur\" :" << rec.dur << ",";
+  profile_stream_ << "\"ts\" :" << rec.ts << ",";
+  profile_stream_ << (is_memory_event ? R"("ph" : "i","s" : "p",)" : R"("ph" : "X",)");
+  profile_stream_ << R"("name" :")" << rec.name << "\",";
+  profile_stream_ << "\"args\" : {";
+  bool is_first_arg = true;
+  for (const auto& event_arg : rec.args) {
+    if (!is_first_arg) profile_stream_ << ",";
+    profile_stream_ << "\"" << event_arg.first << "\" : \"" << event_arg.second << "\"";
+    is_first_arg = false;
+  }
+  profile_stream_ << "}}";
+
+  if (!is_memory_event) {
+    return;
+  }
+
+  // the counter of the location, e.g. "memory Cpu", with the byte counts as numbers so the trace viewer plots them
+  auto location = rec.args.find("location");
+  profile_stream_ << ",\n";
+  profile_stream_ << R"({"cat" : ")" << event_categor_names_[rec.cat] << "\",";
+  profile_stream_ << "\"pid\" :" << rec.pid << ",";
+  profile_stream_ << "\"tid\" :" << rec.tid << ",";
+  profile_stream_ << "\"ts\" :" << rec.ts << ",";
+  profile_stream_ << R"("ph" : "C",)";
+  profile_stream_ << R"("name" :"memory )" << (location != rec.args.end() ? location->second : "") << "\",";
+  profile_stream_ << "\"args\" : {";
+  is_first_arg = true;
+  static const std::string kBytesSuffix = "_bytes";
+  for (const auto& event_arg : rec.args) {
+    const std::string& name = event_arg.first;
+    if (name.size() <= kBytesSuffix.size() ||
+        name.compare(name.size() - kBytesSuffix.size(), kBytesSuffix.size(), kBytesSuffix) != 0) {
+      continue;
+    }
+    if (!is_first_arg) profile_stream_ << ",";
+    profile_stream_ << "\"" << name << "\" : " << event_arg.second;
+    is_first_arg = false;
+  }
+  profile_stream_ << "}}";
+}
+
+void Profiler::WriteLatencyHistograms() {
+  FlushSamples(/*wait*/ true);
+  std::lock_guard<OrtMutex> lock(flush_mutex_);
+
+  if (num_dropped_samples_ > 0 && session_logger_) {
+    LOGS(*session_logger_, WARNING) << num_dropped_samples_
+                                    << " profile events were dropped because a thread buffer was full.";
+  }
+
+  // one object per event name. "buckets" maps the upper bound of each non empty bucket in microseconds to its count.
+  profile_stream_ << "[\n";
+  size_t i = 0;
+  for (const auto& name_histogram : latency_histograms_) {
+    const LatencyHistogram& histogram = name_histogram.second;
+    profile_stream_ << R"({"name" :")" << name_histogram.first << "\",";
+    profile_stream_ << "\"count\" :" << histogram.count << ",";
+    profile_stream_ << "\"total_us\" :" << histogram.total_us << ",";
+    profile_stream_ << "\"max_us\" :" << histogram.max_us << ",";
+    profile_stream_ << "\"buckets\" : {";
+    bool is_first_bucket = true;
+    for (size_t b = 0; b < LatencyHistogram::kNumBuckets; ++b) {
+      if (histogram.buckets[b] == 0) {
+        continue;
+      }
+      if (!is_first_bucket) profile_stream_ << ",";
+      profile_stream_ << "\"" << (1LL << b) << "\" : " << histogram.buckets[b];
+      is_first_bucket = false;
+    }
+    profile_stream_ << (++i == latency_histograms_.size() ? "}}\n" : "}},\n");
+  }
+  profile_stream_ << "]\n";
+}
+
 }  // namespace profiling
 }  // namespace onnxruntime
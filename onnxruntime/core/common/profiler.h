@@ -2,10 +2,19 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include <tuple>
 #include <initializer_list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include "core/platform/ort_mutex.h"
 #include "core/common/logging/logging.h"
 
@@ -17,6 +26,40 @@ namespace profiling {
 // note that static profiler instance only works with single session
 //#define ENABLE_STATIC_PROFILER_INSTANCE
 
+/**
+ * Collects the events of a device, e.g. the kernels an execution provider launches, while the Profiler is enabled.
+ * The Profiler pushes the correlation id of a node before the node runs and pops it after, and the device profiler
+ * tags the device events launched in between with it so that they can be attributed to the node.
+ */
+class DeviceProfiler {
+ public:
+  virtual ~DeviceProfiler() = default;
+
+  // Start collecting events. The timestamps of the events are relative to profiling_start_time.
+  virtual void Start(TimePoint profiling_start_time) = 0;
+
+  virtual void PushCorrelation(uint64_t correlation_id) = 0;
+  virtual void PopCorrelation() = 0;
+
+  // Stop collecting events and return them with the correlation id they were launched under, 0 if none.
+  virtual std::vector<std::pair<uint64_t, EventRecord>> Stop() = 0;
+};
+
+/**
+ * Distribution of the durations of the events with the same name, in buckets of powers of two microseconds.
+ */
+struct LatencyHistogram {
+  static constexpr size_t kNumBuckets = 32;
+
+  // bucket b counts the durations in [2^(b-1), 2^b) microseconds, bucket 0 those under 1. the last one is unbounded.
+  std::array<uint64_t, kNumBuckets> buckets{};
+  uint64_t count = 0;
+  long long total_us = 0;
+  long long max_us = 0;
+
+  void Add(long long duration_us);
+};
+
 /**
  * Main class for profiling. It continues to accumulate events and produce
  * a corresponding "complete event (X)" in "chrome tracing" format.
@@ -45,6 +88,29 @@ class Profiler {
   template <typename T>
   void StartProfiling(const std::basic_string<T>& file_name);
 
+  /*
+  Profile in sampling mode once started: only 1 in sampling_interval executions of a graph record their node
+  events, and the events are aggregated into a LatencyHistogram per event name instead of being kept. Each thread
+  records into its own buffer without locking, and the buffers are merged at most every flush_interval and when the
+  histograms are read. EndProfiling writes the histograms to the file. Device profilers are not started.
+  */
+  void EnableSampling(int sampling_interval, std::chrono::milliseconds flush_interval);
+
+  bool IsSampling() const {
+    return sampling_interval_ > 0;
+  }
+
+  /*
+  Whether an execution of a graph that's starting records its node events: always when every execution is profiled,
+  for 1 in sampling_interval executions in sampling mode, and never when the profiler isn't enabled.
+  */
+  bool SampleExecution();
+
+  /*
+  The latency histograms per event name aggregated so far in sampling mode.
+  */
+  std::unordered_map<std::string, LatencyHistogram> GetLatencyHistograms();
+
   /*
   Produce current time point for any profiling action.
   */
@@ -67,6 +133,32 @@ class Profiler {
                              const std::initializer_list<std::pair<std::string, std::string>>& event_args = {},
                              bool sync_gpu = false);
 
+  /*
+  Same as above with args built by the caller, e.g. the cost of a kernel call.
+  */
+  void EndTimeAndRecordEvent(EventCategory category,
+                             const std::string& event_name,
+                             TimePoint& start_time,
+                             std::unordered_map<std::string, std::string>&& event_args);
+
+  /*
+  Record a MEMORY_EVENT at the current time, e.g. the allocation of a tensor with its size and the state of the
+  arena. It is written as an instant event, followed by a counter event that draws the memory timeline of the
+  location of the event from its numeric "*_bytes" args. Not recorded in sampling mode.
+  */
+  void RecordMemoryEvent(const std::string& event_name, std::unordered_map<std::string, std::string>&& event_args);
+
+  /*
+  Add a device profiler whose events are merged into the profile. It is started with the profiler.
+  */
+  void AddDeviceProfiler(std::unique_ptr<DeviceProfiler> device_profiler);
+
+  /*
+  Attribute the device events launched until EndDeviceCorrelation to the node.
+  */
+  void StartDeviceCorrelation(const std::string& node_name);
+  void EndDeviceCorrelation();
+
   /*
   Write profile data to the given stream in chrome format defined below.
   https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview#
@@ -98,10 +190,87 @@ class Profiler {
   static constexpr size_t max_num_events_ = 1000000;
   bool profile_with_logger_{false};
 
+  void AddEvent(EventRecord&& event);
+  void WriteEvent(const EventRecord& rec);
+  void StartDeviceProfilers();
+  void StopDeviceProfilers();
+
+  // The events a thread records in sampling mode. The thread is the only producer and the flush the only consumer,
+  // so the ring needs no lock. The event names are copied into strings that keep their capacity, so once the slots
+  // have been used recording doesn't allocate. Events are dropped while the ring is full.
+  struct SampleBuffer {
+    struct Sample {
+      std::string name;
+      long long duration_us = 0;
+    };
+
+    static constexpr size_t kCapacity = 4096;
+
+    SampleBuffer() : samples(kCapacity) {}
+
+    std::vector<Sample> samples;
+    std::atomic<size_t> head{0};  // the next slot the thread writes
+    std::atomic<size_t> tail{0};  // the next slot the flush reads
+    std::atomic<uint64_t> num_dropped{0};
+  };
+
+  void RecordSample(const std::string& event_name, long long duration_us);
+  SampleBuffer& ThreadSampleBuffer();
+  // merges the samples of all the threads into latency_histograms_. blocks for flush_mutex_ only if wait.
+  void FlushSamples(bool wait);
+  void WriteLatencyHistograms();
+
+  int sampling_interval_{0};
+  std::chrono::milliseconds flush_interval_{0};
+  std::atomic<uint64_t> num_executions_{0};
+  std::atomic<long long> last_flush_us_{0};
+  // identifies the profiler in the thread local buffer lookup, unlike its address which may be reused
+  const uint64_t id_{next_id_++};
+  static std::atomic<uint64_t> next_id_;
+
+  std::unordered_map<std::thread::id, std::unique_ptr<SampleBuffer>> sample_buffers_;  // guarded by mutex_
+  OrtMutex flush_mutex_;
+  std::unordered_map<std::string, LatencyHistogram> latency_histograms_;  // guarded by flush_mutex_
+  uint64_t num_dropped_samples_{0};                                      // guarded by flush_mutex_
+
+  std::vector<std::unique_ptr<DeviceProfiler>> device_profilers_;
+  // correlation id of each node name, the index in correlated_node_names_ plus one
+  std::unordered_map<std::string, uint64_t> correlation_ids_;
+  std::vector<std::string> correlated_node_names_;
+
 #ifdef ENABLE_STATIC_PROFILER_INSTANCE
   static Profiler* instance_;
 #endif
 };
 
+/*
+Records a SESSION_EVENT named event_name for the lifetime of the object, if profiler isn't null and is enabled when the
+object is created. It is recorded even if the scope is left by an error, to break down the time of the steps of the
+session initialization that ran.
+*/
+class ScopedSessionEvent {
+ public:
+  ScopedSessionEvent(Profiler* profiler, std::string event_name)
+      : profiler_(profiler != nullptr && profiler->IsEnabled() ? profiler : nullptr),
+        event_name_(std::move(event_name)) {
+    if (profiler_ != nullptr) {
+      start_time_ = profiler_->StartTime();
+    }
+  }
+
+  ~ScopedSessionEvent() {
+    if (profiler_ != nullptr) {
+      profiler_->EndTimeAndRecordEvent(SESSION_EVENT, event_name_, start_time_);
+    }
+  }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ScopedSessionEvent);
+
+  Profiler* profiler_;
+  std::string event_name_;
+  TimePoint start_time_;
+};
+
 }  // namespace profiling
 }  // namespace onnxruntime
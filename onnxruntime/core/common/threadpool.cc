@@ -3,6 +3,8 @@
 
 #include "core/platform/threadpool.h"
 #include "core/common/common.h"
+#include "core/common/cpuid_info.h"
+#include "core/platform/env.h"
 
 #include <cassert>
 
@@ -22,91 +24,56 @@
 
 using Eigen::Barrier;
 
-namespace {
-//Copied from MlasPartitionWork
-inline void PartitionWork(
-    int32_t ThreadId,
-    int32_t ThreadCount,
-    int32_t TotalWork,
-    int32_t* WorkIndex,
-    int32_t* WorkRemaining) {
-  const int32_t WorkPerThread = TotalWork / ThreadCount;
-  const int32_t WorkPerThreadExtra = TotalWork % ThreadCount;
-
-  if (ThreadId < WorkPerThreadExtra) {
-    *WorkIndex = (WorkPerThread + 1) * ThreadId;
-    *WorkRemaining = WorkPerThread + 1;
-  } else {
-    *WorkIndex = WorkPerThread * ThreadId + WorkPerThreadExtra;
-    *WorkRemaining = WorkPerThread;
-  }
-}
-
-}  // namespace
-
 namespace onnxruntime {
 
 namespace concurrency {
 //
 // ThreadPool
 //
-ThreadPool::ThreadPool(const std::string&, int num_threads) : impl_(num_threads) {}
+ThreadPool::ThreadPool(const std::string& name, int num_threads) : ThreadPool(name, num_threads, ThreadOptions()) {}
 
-void ThreadPool::Schedule(std::function<void()> fn) { impl_.Schedule(fn); }
+ThreadPool::ThreadPool(const std::string&, int num_threads, const ThreadOptions& thread_options)
+    : spin_duration_us_(thread_options.spin_duration_us),
+      blocks_per_thread_(CPUIDInfo::GetCPUIDInfo().IsHybrid() ? 16 : 4),
+      impl_(num_threads, thread_options.allow_spinning, MakeEnvironment(thread_options)) {}
 
-void ThreadPool::ParallelFor(int32_t total, std::function<void(int32_t)> fn) {
-  if (total <= 0)
-    return;
+ThreadPool::ThreadEnvironment ThreadPool::MakeEnvironment(const ThreadOptions& thread_options) {
+  ThreadEnvironment env;
+  env.affinity = thread_options.affinity;
+  return env;
+}
 
-  if (total == 1) {
-    fn(0);
-    return;
-  }
+void ThreadPool::SetCurrentThreadAffinity(const std::vector<size_t>& processors) {
+  // failing to pin a thread only costs performance, so carry on with the placement chosen by the OS
+  auto status = Env::Default().SetCurrentThreadAffinity(processors);
+  ORT_UNUSED_PARAMETER(status);
+}
 
-  // TODO: Eigen supports a more efficient ThreadPoolDevice mechanism
-  // We will simply rely on the work queue and stealing in the short term.
-  Barrier barrier(static_cast<unsigned int>(total));
-  std::function<void(int32_t)> handle_iteration = [&barrier, &fn](int iteration) {
-    fn(iteration);
-    barrier.Notify();
-  };
+void ThreadPool::Schedule(std::function<void()> fn) {
+  // Eigen queues a task scheduled by one of its worker threads for that thread, and the others steal it from there
+  const int scheduling_thread = impl_.CurrentThreadId();
+  scheduled_tasks_.fetch_add(1, std::memory_order_relaxed);
+  impl_.Schedule([this, fn = std::move(fn), scheduling_thread]() { RunTask(fn, scheduling_thread); });
+}
 
-  for (int32_t id = 0; id < total; ++id) {
-    Schedule([=, &handle_iteration]() { handle_iteration(id); });
+void ThreadPool::RunTask(const std::function<void()>& fn, int scheduling_thread) {
+  started_tasks_.fetch_add(1, std::memory_order_relaxed);
+  if (scheduling_thread >= 0 && impl_.CurrentThreadId() != scheduling_thread) {
+    steals_.fetch_add(1, std::memory_order_relaxed);
   }
+  fn();
+  completed_tasks_.fetch_add(1, std::memory_order_relaxed);
+}
 
-  barrier.Wait();
+void ThreadPool::ParallelFor(int32_t total, std::function<void(int32_t)> fn) {
+  // explicitly forward to the template version so fn isn't wrapped in another std::function
+  const auto& fn_ref = fn;
+  ParallelFor<const std::function<void(int32_t)>&>(total, fn_ref);
 }
 
 void ThreadPool::BatchParallelFor(int32_t total, std::function<void(int32_t)> fn, int32_t num_batches) {
-  if (total <= 0)
-    return;
-
-  if (total == 1) {
-    fn(0);
-    return;
-  }
-
-  if (num_batches <= 1) {
-    for (int i = 0; i < total; i++) {
-      fn(i);
-    }
-    return;
-  }
-
-  if (num_batches >= total) {
-    ParallelFor(total, fn);
-    return;
-  }
-
-  ParallelFor(num_batches, [&](int batch_index) {
-    int start, work_remaining;
-    PartitionWork(batch_index, num_batches, total, &start, &work_remaining);
-    int end = start + work_remaining;
-    for (int i = start; i < end; i++) {
-      fn(i);
-    }
-  });
+  const auto& fn_ref = fn;
+  BatchParallelFor<const std::function<void(int32_t)>&>(total, fn_ref, num_batches);
 }
 
 void ThreadPool::ParallelForRange(int64_t first, int64_t last, std::function<void(int64_t, int64_t)> fn) {
@@ -139,5 +106,20 @@ void ThreadPool::ParallelForRange(int64_t first, int64_t last, std::function<voi
 int ThreadPool::NumThreads() const { return impl_.NumThreads(); }
 
 int ThreadPool::CurrentThreadId() const { return impl_.CurrentThreadId(); }
+
+ThreadPoolStats ThreadPool::GetStats() const {
+  // a task increments the counters in the reverse order, and the clamping covers the reads which still race with it
+  const int64_t completed = completed_tasks_.load(std::memory_order_relaxed);
+  const int64_t started = started_tasks_.load(std::memory_order_relaxed);
+  const int64_t scheduled = scheduled_tasks_.load(std::memory_order_relaxed);
+
+  ThreadPoolStats stats;
+  stats.num_threads = NumThreads();
+  stats.queued_tasks = std::max<int64_t>(0, scheduled - started);
+  stats.active_workers = std::max<int64_t>(0, started - completed);
+  stats.num_tasks = completed;
+  stats.num_steals = steals_.load(std::memory_order_relaxed);
+  return stats;
+}
 }  // namespace concurrency
 }  // namespace onnxruntime
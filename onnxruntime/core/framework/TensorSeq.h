@@ -4,20 +4,56 @@
 #pragma once
 
 #include "core/framework/tensor.h"
+#include <cstddef>
+#include <iterator>
+#include <memory>
 #include <vector>
 #include <utility>
 
 namespace onnxruntime {
 // Put this in a separate file to avoid circular dependency between tensor.h and data_types.h
 // Data type to represent a sequence of tensors of the same type
+//
+// The tensors of a sequence are never modified once added, so the sequences built from another one, e.g. by
+// SequenceInsert or SequenceErase, share its tensors instead of copying them. A tensor lives as long as the last
+// sequence holding it.
 class TensorSeq {
  public:
+  using ElementPtr = std::shared_ptr<const Tensor>;
+
   TensorSeq() = default;
   explicit TensorSeq(MLDataType elem_type) noexcept {
     SetType(elem_type);
   }
 
-  using const_iterator = std::vector<Tensor>::const_iterator;
+  // iterates over the tensors of the sequence
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Tensor;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Tensor*;
+    using reference = const Tensor&;
+
+    explicit const_iterator(std::vector<ElementPtr>::const_iterator it) : it_(it) {}
+
+    reference operator*() const { return **it_; }
+    pointer operator->() const { return it_->get(); }
+    const_iterator& operator++() {
+      ++it_;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator previous = *this;
+      ++it_;
+      return previous;
+    }
+    bool operator==(const const_iterator& other) const { return it_ == other.it_; }
+    bool operator!=(const const_iterator& other) const { return it_ != other.it_; }
+
+   private:
+    std::vector<ElementPtr>::const_iterator it_;
+  };
 
   // Sets the element type after construction.
   // Expects sequence to be empty at the time.
@@ -28,6 +64,15 @@ class TensorSeq {
   }
 
   void SetElements(std::vector<Tensor>&& tensors) {
+    assert(tensors_.empty());
+    tensors_.reserve(tensors.size());
+    for (auto& tensor : tensors) {
+      tensors_.push_back(std::make_shared<Tensor>(std::move(tensor)));
+    }
+  }
+
+  // Sets tensors which may be shared with other sequences.
+  void SetElements(std::vector<ElementPtr>&& tensors) {
     assert(tensors_.empty());
     tensors_ = std::move(tensors);
   }
@@ -46,15 +91,21 @@ class TensorSeq {
 
   // Suitable for for range loop
   const_iterator begin() const noexcept {
-    return tensors_.cbegin();
+    return const_iterator(tensors_.cbegin());
   }
 
   const_iterator end() const noexcept {
-    return tensors_.cend();
+    return const_iterator(tensors_.cend());
   }
 
   // Get by index
   const Tensor& Get(size_t i) const {
+    ORT_ENFORCE(i < tensors_.size());
+    return *tensors_[i];
+  }
+
+  // Get by index, to share the tensor with another sequence
+  const ElementPtr& GetElement(size_t i) const {
     ORT_ENFORCE(i < tensors_.size());
     return tensors_[i];
   }
@@ -69,7 +120,7 @@ class TensorSeq {
 
   // TODO: optimization opportunity - if all tensors in the seq are scalars, we can potentially represent them
   // as vector<primitive type>
-  std::vector<Tensor> tensors_;
+  std::vector<ElementPtr> tensors_;
 };
 
 }  // namespace onnxruntime
@@ -2,8 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/framework/allocation_planner.h"
+#include <limits>
 #include <list>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 #include <sstream>
 #include "core/common/exceptions.h"
@@ -15,6 +17,7 @@
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
+#include "core/graph/graph_utils.h"
 
 using namespace onnxruntime::common;
 using namespace ONNX_NAMESPACE;
@@ -40,6 +43,9 @@ std::ostream& operator<<(std::ostream& out, AllocKind alloc_kind) {
     case AllocKind::kShare:
       out << "Share";
       break;
+    case AllocKind::kView:
+      out << "View";
+      break;
   }
   return out;
 }
@@ -62,7 +68,8 @@ std::ostream& operator<<(std::ostream& out, std::pair<const SequentialExecutionP
     if (0 <= index && static_cast<size_t>(index) < plan_size) {
       auto& elt_plan = plan.allocation_plan[index];
       out << elt_plan.alloc_kind;
-      if (elt_plan.alloc_kind == AllocKind::kReuse) out << " " << elt_plan.reused_buffer;
+      if (elt_plan.alloc_kind == AllocKind::kReuse || elt_plan.alloc_kind == AllocKind::kView)
+        out << " " << elt_plan.reused_buffer;
 
       auto& loc = elt_plan.location;
       out << ", " << loc.ToString();
@@ -134,6 +141,7 @@ class PlannerImpl {
     const onnxruntime::NodeArg* p_def_site;  // the (unique) NodeArg corresponding to the MLValue
     int usecount = 0;                        // static reference-count
     OrtValueIndex reused_buffer_index;       // index of original buffer to reuse
+    bool is_view = false;                    // the value is a block at an offset within the original buffer
   };
 
   // ort_value_info_ is indexed by an OrtValueIndex
@@ -184,6 +192,7 @@ class PlannerImpl {
     OrtValueInfo& info = ort_value_info_[id];
     info.usecount = 0;
     info.reused_buffer_index = id;  // initially, no reuse; the ml-value uses its own buffer
+    info.is_view = false;
     info.p_def_site = p_def_site;
   }
 
@@ -212,6 +221,10 @@ class PlannerImpl {
       return false;
     }
 
+    // a view is placed at an offset within its buffer, which is lost when its buffer is reused. the kernels that
+    // alias their input copy it when it isn't in the same buffer.
+    auto is_view = [this](const onnxruntime::NodeArg& arg) { return ort_value_info_[Index(arg.Name())].is_view; };
+
     const std::vector<std::pair<int, int>>& alias_map = ci->kernel_def->Alias();
     auto input_args = node.InputDefs();
     for (auto pair : alias_map) {
@@ -219,7 +232,7 @@ class PlannerImpl {
         // we _must_ reuse this input to satisfy aliasing requirement: (e.g., for reshape)
         if ((0 <= pair.first) && (static_cast<size_t>(pair.first) < input_args.size())) {
           auto p_input_arg = input_args[pair.first];
-          if (p_input_arg->Exists()) {
+          if (p_input_arg->Exists() && !is_view(*p_input_arg)) {
             *reusable_input = Index(p_input_arg->Name());
             return true;
           }
@@ -232,7 +245,7 @@ class PlannerImpl {
       if (pair.second == output_arg_num) {
         if ((0 <= pair.first) && (static_cast<size_t>(pair.first) < input_args.size())) {
           auto p_input_arg = input_args[pair.first];
-          if (p_input_arg->Exists()) {
+          if (p_input_arg->Exists() && !is_view(*p_input_arg)) {
             auto input_arg_index = Index(p_input_arg->Name());
             auto original = Buffer(input_arg_index);
             if (1 == UseCount(original)) {
@@ -249,6 +262,44 @@ class PlannerImpl {
     return false;
   }
 
+  // Find if output_arg can be a view of a contiguous block of one of the inputs of the node instead of a copy.
+  // This is the case for the outputs of a Split on the CPU when all the dimensions before the split axis are 1.
+  bool FindViewedInput(const onnxruntime::Node& node, int output_arg_num, OrtValueIndex* viewed_input) {
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Split", {2, 11}) ||
+        node.GetExecutionProviderType() != kCpuExecutionProvider) {
+      return false;
+    }
+
+    const auto* p_input_arg = node.InputDefs()[0];
+    const auto* p_output_arg = node.OutputDefs()[output_arg_num];
+    const auto* p_input_shape = p_input_arg->Exists() ? context_.GetShape(*p_input_arg) : nullptr;
+    if (nullptr == p_input_shape ||
+        p_input_arg->TypeAsProto()->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+      return false;
+    }
+
+    const auto& attributes = node.GetAttributes();
+    const auto axis_attr = attributes.find("axis");
+    int64_t axis = axis_attr != attributes.end() ? axis_attr->second.i() : 0;
+    const int rank = p_input_shape->dim_size();
+    if (axis < -rank || axis >= rank) return false;
+    if (axis < 0) axis += rank;
+    for (int i = 0; i < axis; ++i) {
+      const auto& dim = p_input_shape->dim(i);
+      if (!utils::HasDimValue(dim) || dim.dim_value() != 1) return false;
+    }
+
+    // the kernel places the view relative to the start of the input, so the input can't be a view itself
+    auto input_index = Index(p_input_arg->Name());
+    if (ort_value_info_[input_index].is_view || HasFence(p_input_arg) ||
+        !(AllocPlan(input_index).location == AllocPlan(p_output_arg->Name()).location)) {
+      return false;
+    }
+
+    *viewed_input = input_index;
+    return true;
+  }
+
   static bool SameShape(const TensorShapeProto& shape1, const TensorShapeProto& shape2) {
     // TODO: This should probably be defined to be the equality operator on TensorShapeProto.
     namespace on = ONNX_NAMESPACE;
@@ -270,6 +321,59 @@ class PlannerImpl {
     return true;
   }
 
+  // Returns true if the two shapes have the same number of elements, where an unknown dimension is treated as a
+  // symbol. e.g. {batch, seq, hidden} and {seq, batch, hidden} have the same size, as do {batch, 4, 8} and
+  // {32, batch}. The concrete sizes are resolved once the buffers are allocated at execution time.
+  static bool SameSymbolicSize(const TensorShapeProto& shape1, const TensorShapeProto& shape2) {
+    int64_t known_size1 = 1, known_size2 = 1;
+    std::vector<std::string> symbols1, symbols2;
+
+    auto accumulate = [](const TensorShapeProto& shape, int64_t& known_size, std::vector<std::string>& symbols) {
+      for (const auto& dim : shape.dim()) {
+        if (utils::HasDimValue(dim) && dim.dim_value() >= 0) {
+          // guard against overflow. treat the shape as unknown in that case.
+          if (dim.dim_value() > 0 && known_size > std::numeric_limits<int64_t>::max() / dim.dim_value())
+            return false;
+          known_size *= dim.dim_value();
+        } else if (utils::HasDimParam(dim) && !dim.dim_param().empty()) {
+          // a product such as "2*batch*seq", as recorded by the symbolic shape inference, is split into its factors
+          const auto& dim_param = dim.dim_param();
+          if (dim_param.find('+') != std::string::npos) {
+            symbols.push_back(dim_param);
+            continue;
+          }
+          size_t begin = 0;
+          while (begin <= dim_param.size()) {
+            size_t end = std::min(dim_param.find('*', begin), dim_param.size());
+            const auto factor = dim_param.substr(begin, end - begin);
+            if (!factor.empty() && std::all_of(factor.begin(), factor.end(), ::isdigit)) {
+              const auto value = std::stoll(factor);
+              if (value > 0 && known_size > std::numeric_limits<int64_t>::max() / value)
+                return false;
+              known_size *= value;
+            } else {
+              symbols.push_back(factor);
+            }
+            begin = end + 1;
+          }
+        } else {
+          return false;  // unknown dimension with no symbol
+        }
+      }
+      std::sort(symbols.begin(), symbols.end());
+      return true;
+    };
+
+    if (!accumulate(shape1, known_size1, symbols1) || !accumulate(shape2, known_size2, symbols2))
+      return false;
+
+    // a zero sized dimension makes the symbols irrelevant
+    if (known_size1 == 0 || known_size2 == 0)
+      return known_size1 == known_size2;
+
+    return known_size1 == known_size2 && symbols1 == symbols2;
+  }
+
   /*! \brief Given a tensor-type, return the size of an element of the tensor.
   */
   static size_t GetElementSize(const DataType& tensor_type) {
@@ -295,20 +399,10 @@ class PlannerImpl {
     // If either of the tensors is a string, don't treat them the same. Moreover, reusing a string tensor for a string
     // tensor without releasing the previous memory can cause memory leaks; hence we don't allow reuse across string
     // tensors as well.
-    return !(is_type1_string || is_type2_string) && (type1_size == type2_size) && SameShape(shape1, shape2);
-
-    /* TODO: we can improve this if the concrete shapes are known for both as below.
-       Unclear whether this is worthwhile though.
-    if (KnownSize(p_shape1) && KnownSize(p_shape2)) {
-      // Comparison of statically-known size
-      auto size1 = NumElements(p_shape1) * EltSize(ptype1);
-      auto size2 = NumElements(p_shape2) * EltSize(ptype2);
-      return size1 == size2;
-    } else {
-      // Comparison of statically-unknown size buffers
-      return SameElementSize(ptype1, ptype2) && SameShape(shape1, shape2);
-    }
-    */
+    // Compare the number of elements rather than the shapes so buffers can be reused across ops such as
+    // Reshape or Transpose that change the shape but not the size, including when the dims are symbolic.
+    return !(is_type1_string || is_type2_string) && (type1_size == type2_size) &&
+           (SameShape(shape1, shape2) || SameSymbolicSize(shape1, shape2));
   }
 
   bool SameSize(const onnxruntime::NodeArg& arg1, const onnxruntime::NodeArg& arg2) {
@@ -355,6 +449,8 @@ class PlannerImpl {
     // Initialize node_has_fence.
     plan_.node_has_fence.resize(graph_viewer_.MaxNodeIndex());
 
+    plan_.node_priority.resize(graph_viewer_.MaxNodeIndex());
+
     // Initialize allocation plan:
     plan_.allocation_plan.resize(num_ml_values);
   }
@@ -579,6 +675,10 @@ class PlannerImpl {
         } else if (IsNonTensor(*node_output)) {
           // we do not try sharing-optimization for non-tensors
           AllocPlan(current).alloc_kind = AllocKind::kAllocate;
+        } else if (FindViewedInput(*pnode, output_arg_num, &reused)) {
+          // the output is a block of one of the input buffers, at an offset set by the kernel
+          Reuse(reused, current, AllocKind::kView);
+          ort_value_info_[current].is_view = true;
         } else if (FindReusableInput(*pnode, output_arg_num, &reused)) {
           // Reuse one of this node's input buffers as the output buffer (for in-place update)
           Reuse(reused, current, AllocKind::kReuse);
@@ -632,7 +732,7 @@ class PlannerImpl {
       AllocPlanPerValue& value_plan = AllocPlan(index);
 
       has_fence = value_plan.create_fence_if_async;
-      if (value_plan.alloc_kind == AllocKind::kReuse) {
+      if (value_plan.alloc_kind == AllocKind::kReuse || value_plan.alloc_kind == AllocKind::kView) {
         // Buffer reused, check original buffer to see if fence is shared.
         has_fence = has_fence || AllocPlan(value_plan.reused_buffer).create_fence_if_async;
       }
@@ -666,6 +766,159 @@ class PlannerImpl {
     return Status::OK();
   }
 
+  // Estimated size in bytes of a tensor, used to order the nodes. A symbolic dimension counts as 1, so values that
+  // scale with the same batch or sequence dimension are compared by the rest of their shape.
+  size_t EstimatedSize(const onnxruntime::NodeArg& arg) const {
+    const auto* shape = context_.GetShape(arg);
+    if (shape == nullptr || arg.TypeAsProto() == nullptr) return 0;
+    const auto* tensor_type = DataTypeImpl::TypeFromProto(*arg.TypeAsProto())->AsTensorType();
+    if (tensor_type == nullptr) return 0;
+
+    size_t size = tensor_type->GetElementType()->Size();
+    for (const auto& dim : shape->dim()) {
+      if (utils::HasDimValue(dim) && dim.dim_value() >= 0) {
+        if (dim.dim_value() > 0 && size > std::numeric_limits<size_t>::max() / static_cast<size_t>(dim.dim_value()))
+          return std::numeric_limits<size_t>::max() / 2;
+        size *= static_cast<size_t>(dim.dim_value());
+      }
+    }
+    return size;
+  }
+
+  // Bookkeeping shared by the ordering search and the peak estimate: the sizes of the values produced by the nodes
+  // of this graph, and how many nodes read each value.
+  struct OrderingInfo {
+    std::unordered_map<const onnxruntime::NodeArg*, size_t> produced_size;
+    std::unordered_map<const onnxruntime::NodeArg*, int> consumer_count;
+    std::unordered_set<const onnxruntime::NodeArg*> graph_outputs;
+  };
+
+  static std::vector<const onnxruntime::NodeArg*> UniqueInputs(const onnxruntime::Node& node) {
+    std::vector<const onnxruntime::NodeArg*> inputs;
+    auto add = [&inputs](const onnxruntime::NodeArg* arg) {
+      if (arg->Exists() && std::find(inputs.begin(), inputs.end(), arg) == inputs.end()) inputs.push_back(arg);
+    };
+    for (const auto* arg : node.InputDefs()) add(arg);
+    for (const auto* arg : node.ImplicitInputDefs()) add(arg);
+    return inputs;
+  }
+
+  OrderingInfo GetOrderingInfo(const std::vector<NodeIndex>& nodes) const {
+    OrderingInfo info;
+    for (const auto* output : graph_viewer_.GetOutputs()) info.graph_outputs.insert(output);
+    for (auto node_index : nodes) {
+      const auto* pnode = graph_viewer_.GetNode(node_index);
+      for (const auto* output : pnode->OutputDefs()) {
+        if (output->Exists()) info.produced_size[output] = EstimatedSize(*output);
+      }
+      for (const auto* input : UniqueInputs(*pnode)) ++info.consumer_count[input];
+    }
+    return info;
+  }
+
+  // The change in the estimated live size once `node` has run: its outputs are allocated, and the values it reads
+  // for the last time are freed, as are its outputs that nothing reads.
+  static int64_t LiveSizeDelta(const onnxruntime::Node& node, const OrderingInfo& info,
+                               const std::unordered_map<const onnxruntime::NodeArg*, int>& remaining_uses) {
+    int64_t delta = 0;
+    for (const auto* output : node.OutputDefs()) {
+      if (!output->Exists()) continue;
+      const auto size = static_cast<int64_t>(info.produced_size.at(output));
+      delta += size;
+      if (info.consumer_count.count(output) == 0 && info.graph_outputs.count(output) == 0) delta -= size;
+    }
+    for (const auto* input : UniqueInputs(node)) {
+      auto produced = info.produced_size.find(input);
+      if (produced != info.produced_size.end() && remaining_uses.at(input) == 1 &&
+          info.graph_outputs.count(input) == 0) {
+        delta -= static_cast<int64_t>(produced->second);
+      }
+    }
+    return delta;
+  }
+
+  // Estimated peak size of the values produced by the nodes while running them in `order`.
+  size_t EstimatePeakSize(const std::vector<NodeIndex>& order, const OrderingInfo& info) const {
+    auto remaining_uses = info.consumer_count;
+    int64_t live = 0, peak = 0;
+    for (auto node_index : order) {
+      const auto* pnode = graph_viewer_.GetNode(node_index);
+      // the inputs are still alive while the outputs are being written
+      int64_t output_size = 0;
+      for (const auto* output : pnode->OutputDefs()) {
+        if (output->Exists()) output_size += static_cast<int64_t>(info.produced_size.at(output));
+      }
+      peak = std::max(peak, live + output_size);
+      live += LiveSizeDelta(*pnode, info, remaining_uses);
+      for (const auto* input : UniqueInputs(*pnode)) --remaining_uses[input];
+    }
+    return static_cast<size_t>(peak);
+  }
+
+  // Search for a topological order with a lower peak of live memory than the default one. The order is built greedily:
+  // of the nodes whose inputs are ready, the one that grows the live size the least (or frees the most) runs next, and
+  // ties keep the default order. Returns an empty vector if the order doesn't lower the estimated peak.
+  std::vector<NodeIndex> ComputeMemoryEfficientOrder(const std::vector<NodeIndex>& default_order) const {
+    const auto info = GetOrderingInfo(default_order);
+
+    std::unordered_map<NodeIndex, size_t> position;
+    std::unordered_map<NodeIndex, size_t> pending_inputs;
+    std::vector<NodeIndex> ready;
+    for (size_t i = 0; i < default_order.size(); ++i) {
+      const auto* pnode = graph_viewer_.GetNode(default_order[i]);
+      position[default_order[i]] = i;
+      pending_inputs[default_order[i]] = pnode->GetInputEdgesCount();
+      if (pnode->GetInputEdgesCount() == 0) ready.push_back(default_order[i]);
+    }
+
+    auto remaining_uses = info.consumer_count;
+    std::vector<NodeIndex> order;
+    order.reserve(default_order.size());
+    while (!ready.empty()) {
+      size_t best = 0;
+      int64_t best_delta = std::numeric_limits<int64_t>::max();
+      for (size_t i = 0; i < ready.size(); ++i) {
+        const auto delta = LiveSizeDelta(*graph_viewer_.GetNode(ready[i]), info, remaining_uses);
+        if (delta < best_delta || (delta == best_delta && position[ready[i]] < position[ready[best]])) {
+          best = i;
+          best_delta = delta;
+        }
+      }
+
+      const auto node_index = ready[best];
+      ready[best] = ready.back();
+      ready.pop_back();
+      order.push_back(node_index);
+
+      const auto* pnode = graph_viewer_.GetNode(node_index);
+      for (const auto* input : UniqueInputs(*pnode)) --remaining_uses[input];
+      for (auto edge = pnode->OutputEdgesBegin(), end = pnode->OutputEdgesEnd(); edge != end; ++edge) {
+        if (--pending_inputs[edge->GetNode().Index()] == 0) ready.push_back(edge->GetNode().Index());
+      }
+    }
+
+    if (order.size() != default_order.size() ||
+        EstimatePeakSize(order, info) >= EstimatePeakSize(default_order, info)) {
+      return {};
+    }
+    return order;
+  }
+
+  // Compute the priority of each node as the length of the longest downstream path to a graph output, counting
+  // every node as one unit of work. Nodes on the critical path get the highest priority.
+  void ComputeNodePriorities() {
+    const auto& execution_plan = plan_.execution_plan;
+    for (auto it = execution_plan.rbegin(), end = execution_plan.rend(); it != end; ++it) {
+      auto pnode = graph_viewer_.GetNode(it->node_index);
+      size_t longest_downstream = 0;
+      for (auto output_node = pnode->OutputNodesBegin(), nodes_end = pnode->OutputNodesEnd();
+           output_node != nodes_end; ++output_node) {
+        longest_downstream = std::max(longest_downstream, plan_.node_priority[output_node->Index()]);
+      }
+      plan_.node_priority[it->node_index] = longest_downstream + 1;
+    }
+  }
+
   // Convert information in a freelist (about which ml-value becomes free when) into
   // a deallocation plan in the format required in an ExecutionPlan
   void GenerateDeallocationPlan() {
@@ -711,9 +964,13 @@ Status PlannerImpl::CreatePlan() {
 
   Initialize(p_graph_nodes.size(), static_cast<size_t>(num_ml_values));
 
-  // Determine execution order: we use the default topological sort order for now. We can later
-  // explore more efficient orderings (from a memory usage perspective).
-  for (auto n : p_graph_nodes) {
+  // Determine execution order: the default topological sort order, unless a memory efficient order is requested
+  // and found. The parallel executor doesn't follow the execution plan order.
+  std::vector<NodeIndex> memory_efficient_order;
+  if (context_.IsMemoryEfficientOrderEnabled() && !context_.IsParallelExecutionEnabled()) {
+    memory_efficient_order = ComputeMemoryEfficientOrder(p_graph_nodes);
+  }
+  for (auto n : memory_efficient_order.empty() ? p_graph_nodes : memory_efficient_order) {
     plan_.execution_plan.emplace_back(n);
   }
 
@@ -729,6 +986,9 @@ Status PlannerImpl::CreatePlan() {
   // convert information in the freelist_ into a deallocation plan in required format
   GenerateDeallocationPlan();
 
+  // execution_plan is in topological order, so the successors of a node are processed first in reverse order
+  ComputeNodePriorities();
+
   return Status::OK();
 }
 
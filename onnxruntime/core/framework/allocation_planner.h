@@ -27,12 +27,15 @@ class ISequentialPlannerContext {
   // If it returns true, planner won't reuse output tensors
   // see PlannerImpl::ComputeReusePlan
   virtual bool IsParallelExecutionEnabled() const { return false; }
+  // If it returns true, planner looks for a node order that lowers the peak size of the live tensors
+  // see PlannerImpl::ComputeMemoryEfficientOrder
+  virtual bool IsMemoryEfficientOrderEnabled() const { return false; }
 };
 
 class SequentialPlannerContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerContext(ExecutionMode execution_mode)
-      : m_execution_mode(execution_mode) {
+  SequentialPlannerContext(ExecutionMode execution_mode, bool enable_memory_efficient_order = false)
+      : m_execution_mode(execution_mode), m_enable_memory_efficient_order(enable_memory_efficient_order) {
   }
 
   const ONNX_NAMESPACE::TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
@@ -41,8 +44,11 @@ class SequentialPlannerContext : public ISequentialPlannerContext {
 
   bool IsParallelExecutionEnabled() const override { return m_execution_mode == ExecutionMode::ORT_PARALLEL; }
 
+  bool IsMemoryEfficientOrderEnabled() const override { return m_enable_memory_efficient_order; }
+
  private:
   ExecutionMode m_execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  bool m_enable_memory_efficient_order = false;
 };
 
 class SequentialPlanner {
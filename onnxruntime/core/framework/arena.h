@@ -9,6 +9,68 @@
 #include "core/framework/allocator.h"
 
 namespace onnxruntime {
+// Runtime statistics collected by an allocator.
+struct AllocatorStats {
+  int64_t num_allocs;             // Number of allocations.
+  int64_t bytes_in_use;           // Number of bytes in use.
+  int64_t total_allocated_bytes;  // The total number of allocated bytes by the allocator.
+  int64_t max_bytes_in_use;       // The maximum bytes in use.
+  int64_t max_alloc_size;         // The max single allocation seen.
+                                  // The upper limit what the allocator can allocate, if such a limit
+                                  // is known. Certain allocator may return 0 to indicate the limit is
+                                  // unknown.
+  int64_t bytes_limit;
+  int64_t num_thread_cache_hits;    // Number of allocations served by the per-thread chunk cache.
+  int64_t num_thread_cache_misses;  // Number of cacheable allocations that had to go to the shared bins.
+  int64_t max_total_allocated_bytes;  // The maximum number of bytes allocated from the device at once.
+  int64_t num_cross_stream_reuses;    // Number of allocations served by memory freed on another stream.
+  int64_t num_extends;                // Number of times the allocator allocated more memory from the device.
+  int64_t largest_free_chunk;         // Size of the largest free chunk, i.e. the largest allocation served without
+                                      // allocating from the device. 0 if the allocator doesn't track it.
+
+  AllocatorStats() { Clear(); }
+
+  void Clear() {
+    this->num_allocs = 0;
+    this->bytes_in_use = 0;
+    this->max_bytes_in_use = 0;
+    this->max_alloc_size = 0;
+    this->bytes_limit = 0;
+    this->total_allocated_bytes = 0;
+    this->num_thread_cache_hits = 0;
+    this->num_thread_cache_misses = 0;
+    this->max_total_allocated_bytes = 0;
+    this->num_cross_stream_reuses = 0;
+    this->num_extends = 0;
+    this->largest_free_chunk = 0;
+  }
+
+  // Share of the memory allocated from the device that is cached but not in use.
+  double Fragmentation() const {
+    return total_allocated_bytes > 0
+               ? static_cast<double>(total_allocated_bytes - bytes_in_use) / static_cast<double>(total_allocated_bytes)
+               : 0.0;
+  }
+
+  std::string DebugString() const {
+    std::ostringstream ss;
+    ss << "Limit:           " << this->bytes_limit << "\n"
+       << "InUse:          " << this->bytes_in_use << "\n"
+       << "TotalAllocated: " << this->total_allocated_bytes << "\n"
+       << "MaxInUse:       " << this->max_bytes_in_use << "\n"
+       << "NumAllocs:      " << this->num_allocs << "\n"
+       << "MaxAllocSize:   " << this->max_alloc_size << "\n"
+       << "CacheHits:      " << this->num_thread_cache_hits << "\n"
+       << "CacheMisses:    " << this->num_thread_cache_misses << "\n"
+       << "MaxAllocated:   " << this->max_total_allocated_bytes << "\n"
+       << "CrossStream:    " << this->num_cross_stream_reuses << "\n"
+       << "NumExtends:     " << this->num_extends << "\n"
+       << "LargestFree:    " << this->largest_free_chunk << "\n"
+       << "Fragmentation:  " << this->Fragmentation() << "\n";
+    return ss.str();
+  }
+};
+
 // The interface for arena which manage memory allocations
 // Arena will hold a pool of pre-allocate memories and manage their lifecycle.
 // Need an underline IResourceAllocator to allocate memories.
@@ -27,6 +89,13 @@ class IArenaAllocator : public IAllocator {
   virtual size_t Used() const = 0;
   virtual size_t Max() const = 0;
   const OrtMemoryInfo& Info() const override = 0;
+  // Return the memory that is not currently in use back to the underlying device allocator,
+  // so the footprint of the arena tracks the working set instead of the all-time peak.
+  // Shrink call need to be thread safe.
+  virtual Status Shrink() = 0;
+  // Copy the statistics of the arena to stats.
+  // GetStats call need to be thread safe.
+  virtual void GetStats(AllocatorStats* stats) = 0;
   // allocate host pinned memory?
 };
 
@@ -56,10 +125,20 @@ class DummyArena : public IArenaAllocator {
     return Alloc(size);
   }
 
+  // nothing is cached so there is nothing to release
+  Status Shrink() override {
+    return Status::OK();
+  }
+
   size_t Used() const override {
     ORT_NOT_IMPLEMENTED(__FUNCTION__, " is not implemented");
   }
 
+  // nothing is tracked
+  void GetStats(AllocatorStats* stats) override {
+    stats->Clear();
+  }
+
   size_t Max() const override {
     ORT_NOT_IMPLEMENTED(__FUNCTION__, " is not implemented");
   }
@@ -75,38 +154,4 @@ class DummyArena : public IArenaAllocator {
   OrtMemoryInfo info_;
 };
 
-// Runtime statistics collected by an allocator.
-struct AllocatorStats {
-  int64_t num_allocs;             // Number of allocations.
-  int64_t bytes_in_use;           // Number of bytes in use.
-  int64_t total_allocated_bytes;  // The total number of allocated bytes by the allocator.
-  int64_t max_bytes_in_use;       // The maximum bytes in use.
-  int64_t max_alloc_size;         // The max single allocation seen.
-                                  // The upper limit what the allocator can allocate, if such a limit
-                                  // is known. Certain allocator may return 0 to indicate the limit is
-                                  // unknown.
-  int64_t bytes_limit;
-
-  AllocatorStats() { Clear(); }
-
-  void Clear() {
-    this->num_allocs = 0;
-    this->bytes_in_use = 0;
-    this->max_bytes_in_use = 0;
-    this->max_alloc_size = 0;
-    this->bytes_limit = 0;
-    this->total_allocated_bytes = 0;
-  }
-
-  std::string DebugString() const {
-    std::ostringstream ss;
-    ss << "Limit:           " << this->bytes_limit << "\n"
-       << "InUse:          " << this->bytes_in_use << "\n"
-       << "TotalAllocated: " << this->total_allocated_bytes << "\n"
-       << "MaxInUse:       " << this->max_bytes_in_use << "\n"
-       << "NumAllocs:      " << this->num_allocs << "\n"
-       << "MaxAllocSize:   " << this->max_alloc_size << "\n";
-    return ss.str();
-  }
-};
 }  // namespace onnxruntime
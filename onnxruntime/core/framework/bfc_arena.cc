@@ -5,12 +5,14 @@
 
 namespace onnxruntime {
 BFCArena::BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator,
-                   size_t total_memory)
+                   size_t total_memory,
+                   bool enable_thread_cache)
     : device_allocator_(std::move(resource_allocator)),
       free_chunks_list_(kInvalidChunkHandle),
       next_allocation_id_(1),
       info_(device_allocator_->Info().name, OrtAllocatorType::OrtArenaAllocator,
-            device_allocator_->Info().device, device_allocator_->Info().id, device_allocator_->Info().mem_type) {
+            device_allocator_->Info().device, device_allocator_->Info().id, device_allocator_->Info().mem_type),
+      enable_thread_cache_(enable_thread_cache) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name;
   curr_region_allocation_bytes_ = RoundedBytes(std::min(total_memory, size_t{1048576}));
 
@@ -34,6 +36,16 @@ BFCArena::BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator,
       ORT_ENFORCE(BinForSize(bin_size * 2) != BinFromIndex(b));
     }
   }
+
+  if (enable_thread_cache_) {
+    ORT_ENFORCE(BinNumForSize(kThreadCacheMaxChunkBytes * 2 - 1) + 1 == kThreadCacheNumBins);
+    thread_cache_shards_.reserve(kNumThreadCacheShards);
+    live_chunk_shards_.reserve(kNumThreadCacheShards);
+    for (size_t i = 0; i < kNumThreadCacheShards; ++i) {
+      thread_cache_shards_.push_back(onnxruntime::make_unique<ThreadCacheShard>());
+      live_chunk_shards_.push_back(onnxruntime::make_unique<LiveChunkShard>());
+    }
+  }
 }
 
 BFCArena::~BFCArena() {
@@ -123,6 +135,8 @@ bool BFCArena::Extend(size_t rounded_bytes) {
                      << " bytes.";
 
   stats_.total_allocated_bytes += bytes;
+  stats_.max_total_allocated_bytes = std::max(stats_.max_total_allocated_bytes, stats_.total_allocated_bytes);
+  ++stats_.num_extends;
   LOGS_DEFAULT(INFO) << "Total allocated bytes: "
                      << stats_.total_allocated_bytes;
 
@@ -180,9 +194,90 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
+  if (enable_thread_cache_ && size != 0 && RoundedBytes(size) <= kThreadCacheMaxChunkBytes) {
+    return AllocateFromThreadCache(size);
+  }
   return AllocateRawInternal(size, false);
 }
 
+BFCArena::ThreadCacheShard& BFCArena::ThreadCacheShardForCurrentThread() {
+  // Threads are assigned shards round-robin the first time they allocate from any arena,
+  // which spreads the threads of a pool evenly across the shards.
+  static std::atomic<size_t> next_thread_index{0};
+  thread_local size_t thread_index = next_thread_index++;
+  return *thread_cache_shards_[thread_index % kNumThreadCacheShards];
+}
+
+void BFCArena::TrackThreadCacheChunk(void* ptr, size_t size, size_t requested_size) {
+  LiveChunkShard& live = LiveChunkShardFor(ptr);
+  std::lock_guard<OrtMutex> lock(live.mutex);
+  live.chunks[ptr] = LiveChunkInfo{size, requested_size};
+}
+
+void* BFCArena::AllocateFromThreadCache(size_t num_bytes) {
+  size_t rounded_bytes = RoundedBytes(num_bytes);
+  BinNum bin_num = BinNumForSize(rounded_bytes);
+
+  CachedChunk cached;
+  {
+    ThreadCacheShard& shard = ThreadCacheShardForCurrentThread();
+    std::lock_guard<OrtMutex> lock(shard.mutex);
+    auto& entries = shard.bins[bin_num];
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+      if (it->size >= rounded_bytes) {
+        cached = *it;
+        *it = entries.back();
+        entries.pop_back();
+        break;
+      }
+    }
+  }
+
+  if (cached.ptr != nullptr) {
+    ++thread_cache_hits_;
+    TrackThreadCacheChunk(cached.ptr, cached.size, num_bytes);
+    return cached.ptr;
+  }
+
+  ++thread_cache_misses_;
+  size_t chunk_size = 0;
+  void* ptr = AllocateRawInternal(num_bytes, false, &chunk_size);
+  if (ptr != nullptr) {
+    TrackThreadCacheChunk(ptr, chunk_size, num_bytes);
+  }
+  return ptr;
+}
+
+bool BFCArena::FreeToThreadCache(void* ptr) {
+  size_t chunk_size = 0;
+  {
+    LiveChunkShard& live = LiveChunkShardFor(ptr);
+    std::lock_guard<OrtMutex> lock(live.mutex);
+    auto it = live.chunks.find(ptr);
+    if (it == live.chunks.end()) {
+      return false;
+    }
+    chunk_size = it->second.size;
+    live.chunks.erase(it);
+  }
+
+  BinNum bin_num = BinNumForSize(chunk_size);
+  if (bin_num < kThreadCacheNumBins) {
+    ThreadCacheShard& shard = ThreadCacheShardForCurrentThread();
+    std::lock_guard<OrtMutex> lock(shard.mutex);
+    auto& entries = shard.bins[bin_num];
+    if (entries.size() < kThreadCacheChunksPerBin) {
+      entries.push_back(CachedChunk{ptr, chunk_size});
+      return true;
+    }
+  }
+
+  // the cache bin is full so give the chunk back to the shared bins
+  std::lock_guard<OrtMutex> lock(lock_);
+  DeallocateRawInternal(ptr);
+  return true;
+}
+
 void* BFCArena::Reserve(size_t size) {
   if (size == 0)
     return nullptr;
@@ -196,10 +291,84 @@ void* BFCArena::Reserve(size_t size) {
   stats_.max_alloc_size = std::max<size_t>(static_cast<size_t>(stats_.max_alloc_size), size);
   stats_.max_bytes_in_use = std::max<int64_t>(static_cast<int64_t>(stats_.max_bytes_in_use), stats_.bytes_in_use);
   stats_.total_allocated_bytes += size;
+  stats_.max_total_allocated_bytes = std::max(stats_.max_total_allocated_bytes, stats_.total_allocated_bytes);
   return ptr;
 }
 
+void BFCArena::FlushThreadCache() {
+  std::vector<void*> cached_ptrs;
+  for (auto& shard : thread_cache_shards_) {
+    std::lock_guard<OrtMutex> lock(shard->mutex);
+    for (auto& entries : shard->bins) {
+      for (const auto& entry : entries) {
+        cached_ptrs.push_back(entry.ptr);
+      }
+      entries.clear();
+    }
+  }
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  for (void* ptr : cached_ptrs) {
+    DeallocateRawInternal(ptr);
+  }
+}
+
+Status BFCArena::Shrink() {
+  if (enable_thread_cache_) {
+    FlushThreadCache();
+  }
+
+  std::lock_guard<OrtMutex> lock(lock_);
+
+  // A region with nothing in use has been coalesced into a single free chunk that covers all of it.
+  std::vector<void*> free_regions;
+  for (const auto& region : region_manager_.regions()) {
+    ChunkHandle h = region_manager_.get_handle(region.ptr());
+    const Chunk* c = ChunkFromHandle(h);
+    if (!c->in_use() && c->size == region.memory_size()) {
+      free_regions.push_back(region.ptr());
+    }
+  }
+
+  size_t released_bytes = 0;
+  for (void* region_ptr : free_regions) {
+    ChunkHandle h = region_manager_.get_handle(region_ptr);
+    size_t region_bytes = ChunkFromHandle(h)->size;
+    RemoveFreeChunkFromBin(h);
+    DeleteChunk(h);
+    region_manager_.RemoveAllocationRegion(region_ptr);
+    device_allocator_->Free(region_ptr);
+    stats_.total_allocated_bytes -= region_bytes;
+    released_bytes += region_bytes;
+  }
+
+  if (!free_regions.empty()) {
+    // restart the geometric growth from the largest region we kept so the next Extend
+    // does not jump straight back to the peak region size
+    size_t largest_region_bytes = RoundedBytes(std::min(memory_limit_, size_t{1048576}));
+    for (const auto& region : region_manager_.regions()) {
+      largest_region_bytes = std::max(largest_region_bytes, region.memory_size());
+    }
+    curr_region_allocation_bytes_ = largest_region_bytes;
+
+    LOGS_DEFAULT(INFO) << "Shrunk BFCArena for " << device_allocator_->Info().name << " by " << released_bytes
+                       << " bytes. Total allocated bytes: " << stats_.total_allocated_bytes;
+  }
+
+  return Status::OK();
+}
+
 size_t BFCArena::RequestedSize(const void* ptr) {
+  if (enable_thread_cache_) {
+    // a chunk reused from the thread cache keeps the requested size of its first use in the bins
+    LiveChunkShard& live = LiveChunkShardFor(ptr);
+    std::lock_guard<OrtMutex> lock(live.mutex);
+    auto it = live.chunks.find(ptr);
+    if (it != live.chunks.end()) {
+      return it->second.requested_size;
+    }
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
@@ -216,7 +385,8 @@ size_t BFCArena::AllocatedSize(const void* ptr) {
 }
 
 void* BFCArena::AllocateRawInternal(size_t num_bytes,
-                                    bool dump_log_on_failure) {
+                                    bool dump_log_on_failure,
+                                    size_t* chunk_size) {
   if (num_bytes == 0) {
     LOGS_DEFAULT(VERBOSE) << "tried to allocate 0 bytes";
     return nullptr;
@@ -230,8 +400,15 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
   std::lock_guard<OrtMutex> lock(lock_);
+  auto set_chunk_size = [this, chunk_size](const void* p) {
+    if (chunk_size != nullptr) {
+      *chunk_size = ChunkFromHandle(region_manager_.get_handle(p))->size;
+    }
+  };
+
   void* ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
   if (ptr != nullptr) {
+    set_chunk_size(ptr);
     return ptr;
   }
 
@@ -242,6 +419,7 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   if (Extend(rounded_bytes)) {
     ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
     if (ptr != nullptr) {
+      set_chunk_size(ptr);
       return ptr;
     }
   }
@@ -262,6 +440,17 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
+  stats->num_thread_cache_hits = thread_cache_hits_;
+  stats->num_thread_cache_misses = thread_cache_misses_;
+  // the chunks of a bin are sorted by size and the bins by their minimum size, so the largest free chunk is the
+  // last one of the last bin holding any
+  for (BinNum b = kNumBins - 1; b >= 0; --b) {
+    const Bin* bin = BinFromIndex(b);
+    if (!bin->free_chunks.empty()) {
+      stats->largest_free_chunk = static_cast<int64_t>(ChunkFromHandle(*bin->free_chunks.rbegin())->size);
+      break;
+    }
+  }
 }
 
 void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
@@ -351,6 +540,11 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+
+  if (enable_thread_cache_ && FreeToThreadCache(p)) {
+    return;
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -16,9 +16,12 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
@@ -46,9 +49,14 @@ namespace onnxruntime {
 // coalescing.  One assumption we make is that the process using this
 // allocator owns pretty much all of the memory, and that nearly
 // all requests to allocate memory go through this interface.
+//
+// If enable_thread_cache is true, small allocations are served from a
+// per-thread cache of recently freed chunks that sits in front of the bins,
+// so most small Alloc/Free pairs never take the arena wide lock.
 class BFCArena : public IArenaAllocator {
  public:
-  BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator, size_t total_memory);
+  BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator, size_t total_memory,
+           bool enable_thread_cache = false);
 
   ~BFCArena() override;
 
@@ -62,6 +70,10 @@ class BFCArena : public IArenaAllocator {
 
   void* Reserve(size_t size) override;
 
+  // Frees every AllocationRegion that has no chunk in use, after returning the chunks held
+  // by the per-thread cache to the bins.
+  Status Shrink() override;
+
   size_t Used() const override {
     return static_cast<size_t>(stats_.bytes_in_use);
   }
@@ -79,14 +91,15 @@ class BFCArena : public IArenaAllocator {
     return device_allocator_->CreateFence(session_state);
   }
 
-  void GetStats(AllocatorStats* stats);
+  void GetStats(AllocatorStats* stats) override;
 
   size_t RequestedSize(const void* ptr);
 
   size_t AllocatedSize(const void* ptr);
 
  private:
-  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure);
+  // If chunk_size is not null it is set to the size of the chunk backing the returned pointer.
+  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure, size_t* chunk_size = nullptr);
   void DeallocateRawInternal(void* ptr);
 
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
@@ -271,6 +284,14 @@ class BFCArena : public IArenaAllocator {
       regions_.insert(entry, AllocationRegion(ptr, memory_size));
     }
 
+    void RemoveAllocationRegion(void* ptr) {
+      auto entry =
+          std::upper_bound(regions_.begin(), regions_.end(), ptr, &Comparator);
+      ORT_ENFORCE(entry != regions_.end() && entry->ptr() == ptr,
+                  "Could not find Region for ", ptr);
+      regions_.erase(entry);
+    }
+
     ChunkHandle get_handle(const void* p) const {
       return RegionFor(p)->get_handle(p);
     }
@@ -365,6 +386,57 @@ class BFCArena : public IArenaAllocator {
   // Computes and returns a BinDebugInfo for each Bin.
   std::array<BinDebugInfo, kNumBins> get_bin_debug_info();
 
+  // Per-thread cache of freed chunks.
+  //
+  // Chunks held by the cache stay 'in use' as far as the bins are concerned, so the
+  // cache only needs to remember the pointer and the chunk size. Each thread is
+  // assigned one of kNumThreadCacheShards shards, and every pointer handed out through
+  // the cache is tracked in a live shard selected by its address so that Free can find
+  // the chunk size without consulting the RegionManager. Both shards have their own
+  // mutex which is effectively uncontended; lock_ is only taken on a cache miss or when
+  // a cache bin is full.
+  static const size_t kThreadCacheMaxChunkBytes = 64 * 1024;
+  static const int kThreadCacheNumBins = 9;  // BinNumForSize(kThreadCacheMaxChunkBytes * 2 - 1) + 1
+  static const size_t kThreadCacheChunksPerBin = 8;
+  static const size_t kNumThreadCacheShards = 16;
+
+  struct CachedChunk {
+    void* ptr = nullptr;
+    size_t size = 0;
+  };
+
+  struct ThreadCacheShard {
+    OrtMutex mutex;
+    std::array<std::vector<CachedChunk>, kThreadCacheNumBins> bins;
+  };
+
+  struct LiveChunkInfo {
+    size_t size;
+    size_t requested_size;
+  };
+
+  struct LiveChunkShard {
+    OrtMutex mutex;
+    std::unordered_map<const void*, LiveChunkInfo> chunks;
+  };
+
+  void* AllocateFromThreadCache(size_t num_bytes);
+
+  // Gives every chunk held by the per-thread cache back to the bins.
+  void FlushThreadCache();
+
+  // Returns false if 'ptr' was not handed out through the thread cache.
+  bool FreeToThreadCache(void* ptr);
+
+  void TrackThreadCacheChunk(void* ptr, size_t size, size_t requested_size);
+
+  ThreadCacheShard& ThreadCacheShardForCurrentThread();
+
+  LiveChunkShard& LiveChunkShardFor(const void* ptr) {
+    auto p_int = reinterpret_cast<std::uintptr_t>(ptr);
+    return *live_chunk_shards_[(p_int >> kMinAllocationBits) % kNumThreadCacheShards];
+  }
+
   // Structures immutable after construction
   size_t memory_limit_ = 0;
 
@@ -441,6 +513,12 @@ class BFCArena : public IArenaAllocator {
 
   std::unordered_map<void*, size_t> reserved_chunks_;
 
+  const bool enable_thread_cache_;
+  std::vector<std::unique_ptr<ThreadCacheShard>> thread_cache_shards_;
+  std::vector<std::unique_ptr<LiveChunkShard>> live_chunk_shards_;
+  std::atomic<int64_t> thread_cache_hits_{0};
+  std::atomic<int64_t> thread_cache_misses_{0};
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BFCArena);
 };
 #ifdef __GNUC__
@@ -3,8 +3,11 @@
 
 #include "core/framework/execution_frame.h"
 
+#include <algorithm>
 #include <sstream>
 
+#include "core/common/profiler.h"
+#include "core/framework/arena.h"
 #include "core/framework/mem_pattern_planner.h"
 #include "core/framework/execution_plan_base.h"
 #include "core/framework/sequential_execution_plan.h"
@@ -100,6 +103,23 @@ Status IExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
   return Status::OK();
 }
 
+void IExecutionFrame::ResetValues(const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds,
+                                  const std::unordered_map<int, OrtValue>& initializers,
+                                  const std::vector<int>& fetch_mlvalue_idxs, const std::vector<OrtValue>& fetches) {
+  fetch_mlvalue_idxs_.assign(fetch_mlvalue_idxs.begin(), fetch_mlvalue_idxs.end());
+  ORT_ENFORCE(feeds.size() == feed_mlvalue_idxs.size());
+  ORT_ENFORCE(fetches.empty() || fetches.size() == fetch_mlvalue_idxs_.size());
+
+  ClearValues();
+  Init(feed_mlvalue_idxs, feeds, initializers, fetches);
+}
+
+void IExecutionFrame::ClearValues() {
+  for (auto& value : all_values_) {
+    value = OrtValue();
+  }
+}
+
 int IExecutionFrame::GetNodeIdxToMLValueIdx(int index) const {
   // the validity of index is checked by GetMLValueIndex
   int ort_value_idx = node_index_info_.GetMLValueIndex(index);
@@ -176,6 +196,45 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
       session_state_(session_state),
       mem_patterns_(nullptr),
       planner_(nullptr) {
+  SetUpRun(feeds, fetch_mlvalue_idxs, fetch_allocators);
+}
+
+ExecutionFrame::~ExecutionFrame() {
+  if (memory_profiler_ != nullptr) {
+    RecordEndOfRun();
+  }
+}
+
+void ExecutionFrame::Reset(const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds,
+                           const std::vector<int>& fetch_mlvalue_idxs, const std::vector<OrtValue>& fetches,
+                           const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  ResetValues(feed_mlvalue_idxs, feeds, session_state_.GetInitializedTensors(), fetch_mlvalue_idxs, fetches);
+
+  custom_allocators_.clear();
+  mem_patterns_miss_ = false;
+  planner_.reset();
+  count_allocations_ = false;
+  std::fill(allocated_sizes_.begin(), allocated_sizes_.end(), 0);
+  num_allocations_ = 0;
+  bytes_allocated_ = 0;
+  bytes_in_use_ = 0;
+  peak_bytes_in_use_ = 0;
+
+  SetUpRun(feeds, fetch_mlvalue_idxs, fetch_allocators);
+}
+
+void ExecutionFrame::EndRun() {
+  if (memory_profiler_ != nullptr) {
+    RecordEndOfRun();
+    memory_profiler_ = nullptr;
+  }
+  ClearValues();
+}
+
+void ExecutionFrame::SetUpRun(const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
+                              const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  const SessionState& session_state = session_state_;
+
   // map the custom allocators to ort_value_idx entries
   if (!fetch_allocators.empty()) {
     for (size_t idx = 0, end = fetch_mlvalue_idxs.size(); idx < end; ++idx) {
@@ -188,46 +247,117 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
     }
   }
 
+  memory_profiler_ = nullptr;
+  if (session_state.GetEnableMemoryProfiling() && session_state.GetExecutionPlan() &&
+      session_state.Profiler().IsEnabled() && !session_state.Profiler().IsSampling()) {
+    memory_profiler_ = &session_state.Profiler();
+    const auto& ort_value_idx_map = session_state.GetOrtValueNameIdxMap();
+    const size_t num_values = static_cast<size_t>(ort_value_idx_map.MaxIdx()) + 1;
+    profiled_buffers_.assign(num_values, ProfiledBuffer());
+    profiled_bytes_in_use_.clear();
+    arena_reserved_bytes_.clear();
+    // the names are the same for every run of the frame
+    if (value_names_.empty()) {
+      value_names_.resize(num_values);
+      producer_names_.resize(num_values);
+      for (const auto& name_idx : ort_value_idx_map) {
+        value_names_[name_idx.second] = name_idx.first;
+      }
+      const GraphViewer* graph_viewer = session_state.GetGraphViewer();
+      if (graph_viewer != nullptr) {
+        for (const auto& node : graph_viewer->Nodes()) {
+          for (const auto* output_def : node.OutputDefs()) {
+            int ort_value_idx;
+            if (output_def->Exists() && ort_value_idx_map.GetIdx(output_def->Name(), ort_value_idx).IsOK()) {
+              producer_names_[ort_value_idx] = node.Name();
+            }
+          }
+        }
+      }
+    }
+  }
+
   // If the session enable memory pattern optimization
   // and we have execution plan generated, try to setup
   // memory pattern optimization.
+  mem_patterns_ = nullptr;
   if (session_state.GetEnableMemoryPattern() && session_state.GetExecutionPlan()) {
-    std::vector<std::reference_wrapper<const TensorShape>> input_shapes;
     bool all_tensors = true;
     // Reserve mem to avoid re-allocation.
-    input_shapes.reserve(feeds.size());
+    input_shapes_.clear();
+    input_shapes_.reserve(feeds.size());
     for (const auto& feed : feeds) {
       if (!(feed.IsTensor())) {
         all_tensors = false;
         break;
       }
       auto& tensor = feed.Get<Tensor>();
-      input_shapes.push_back(std::cref(tensor.Shape()));
+      input_shapes_.push_back(std::cref(tensor.Shape()));
     }
 
     //if there are some traditional ml value type in inputs disable the memory pattern optimization.
     if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(input_shapes);
-      // if no existing patterns, generate one in this executionframe
-      if (!mem_patterns_) {
+      mem_patterns_ = session_state.GetMemoryPatternGroup(input_shapes_);
+      // if no existing patterns, generate one in this executionframe.
+      // with bucketing the patterns may come from a smaller shape in the same bucket, so keep tracing
+      // in case they need to be regenerated.
+      if (!mem_patterns_ || session_state.GetEnableMemoryPatternBucketing()) {
         planner_ = onnxruntime::make_unique<OrtValuePatternPlanner>(*session_state.GetExecutionPlan());
-      } else {
-        // pre-allocate the big chunk requested in memory pattern.
-        // all the internal kernel's input/output tensors will be allocated on these buffer.
-        for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
-          ORT_ENFORCE(buffers_.find(mem_patterns_->locations[i]) == buffers_.end());
-          AllocatorPtr alloc = GetAllocator(mem_patterns_->locations[i]);
-          void* buffer = mem_patterns_->patterns[i].PeakSize() > 0
-                             ? alloc->Alloc(mem_patterns_->patterns[i].PeakSize())
-                             : nullptr;
-          buffers_[mem_patterns_->locations[i]] = BufferUniquePtr(buffer, alloc);
+      }
+    }
+    input_shapes_.clear();
+  }
+
+  // the blocks of a previous run of the frame are reused if it had the same patterns
+  if (mem_patterns_ != buffers_patterns_) {
+    buffers_.clear();
+    buffers_patterns_ = mem_patterns_;
+    if (mem_patterns_) {
+      // pre-allocate the big chunk requested in memory pattern.
+      // all the internal kernel's input/output tensors will be allocated on these buffer.
+      for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
+        ORT_ENFORCE(buffers_.find(mem_patterns_->locations[i]) == buffers_.end());
+        AllocatorPtr alloc = GetAllocator(mem_patterns_->locations[i]);
+        void* buffer = mem_patterns_->patterns[i].PeakSize() > 0
+                           ? alloc->Alloc(mem_patterns_->patterns[i].PeakSize())
+                           : nullptr;
+        buffers_[mem_patterns_->locations[i]] = BufferUniquePtr(buffer, alloc);
+        if (buffer != nullptr) {
+          CountAllocation(-1, mem_patterns_->patterns[i].PeakSize());
+          if (memory_profiler_ != nullptr) {
+            RecordMemoryEvent(true, -1, mem_patterns_->locations[i], mem_patterns_->patterns[i].PeakSize(), false);
+          }
         }
       }
     }
+  } else if (mem_patterns_) {
+    // the kept blocks are in use by this run, though it didn't allocate them
+    for (const auto& pattern : mem_patterns_->patterns) {
+      bytes_in_use_ += pattern.PeakSize();
+    }
+    peak_bytes_in_use_ = std::max(peak_bytes_in_use_, bytes_in_use_);
   }
 }
 
-ExecutionFrame::~ExecutionFrame() = default;
+void ExecutionFrame::RecordEndOfRun() {
+  // the values still held by the frame, except the outputs that outlive it, and the memory pattern blocks
+  for (size_t idx = 0; idx < profiled_buffers_.size(); ++idx) {
+    const int ort_value_idx = static_cast<int>(idx);
+    if (profiled_buffers_[idx].allocated && !IsOutput(ort_value_idx)) {
+      RecordFree(ort_value_idx);
+    }
+  }
+  for (auto& location_buffer : buffers_) {
+    if (location_buffer.second != nullptr) {
+      const size_t size = buffers_patterns_->GetPatterns(location_buffer.first)->PeakSize();
+      location_buffer.second.reset();
+      RecordMemoryEvent(false, -1, location_buffer.first, size, false);
+    }
+  }
+  // a profiled run allocates its blocks, so that the timeline of each run is complete
+  buffers_.clear();
+  buffers_patterns_ = nullptr;
+}
 
 Status ExecutionFrame::AllocateMLValueTensorSelfOwnBuffer(OrtValue& ort_value, int ort_value_index,
                                                           MLDataType element_type, const OrtMemoryInfo& location,
@@ -277,19 +407,28 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
       // if block not found, fall back to default behavior
       if (block) {
         auto it = buffers_.find(location);
+        // with bucketing the pattern may have been generated from a larger shape, so any tensor that fits can use it
+        bool block_fits = session_state_.GetEnableMemoryPatternBucketing() ? size <= block->size_
+                                                                            : size == block->size_;
         // if the block is not correct, log message then fall back to default behavior
-        if (it != buffers_.end() && block->size_ == size) {
+        if (it != buffers_.end() && block_fits) {
           void* buffer = it->second.get();
           auto status = AllocateTensorWithPreAllocateBufferHelper(
               ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
               shape);
+          if (status.IsOK()) {
+            TraceAllocate(ort_value_index, size);
+            if (memory_profiler_ != nullptr) {
+              RecordMemoryEvent(true, ort_value_index, location, size, true);
+            }
+          }
           return status;
         }
-        if (block->size_ != size) {
+        if (!block_fits) {
+          mem_patterns_miss_ = true;
           // the block size may vary especially if the model has NonZero ops, or different sequence lengths are
           // fed in, so use VERBOSE as the log level as it's expected.
-          // TODO: Should we re-use the block if the size is large enough? Would probably need to allow it
-          // to be freed if the size difference was too large so our memory usage doesn't stick at a high water mark
+          // enable memory pattern bucketing in the session options to re-use blocks that are large enough.
           LOGS(session_state_.Logger(), VERBOSE) << "For ort_value with index: " << ort_value_index
                                                  << ", block in memory pattern size is: " << block->size_
                                                  << " but the actually size is: " << size
@@ -315,6 +454,12 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   if (!utils::IsDataTypeString(element_type)) {
     TraceAllocate(ort_value_index, size);
   }
+  if (count_allocations_) {
+    CountAllocation(ort_value_index, size);
+  }
+  if (memory_profiler_ != nullptr) {
+    RecordMemoryEvent(true, ort_value_index, location, size, false);
+  }
 
   return Status::OK();
 }
@@ -452,6 +597,17 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_
             ort_value, reuse_mlvalue_index, ml_data_type, alloc_info, *shape, per_alloc_plan.create_fence_if_async));
         break;
       }
+      case AllocKind::kView: {
+        // created at the start of the viewed buffer. the kernel moves it to its offset within the buffer.
+        const auto& viewed_tensor = GetMLValue(per_alloc_plan.reused_buffer).Get<Tensor>();
+        if (shape->Size() > viewed_tensor.Shape().Size()) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "View of shape ", *shape, " doesn't fit in a buffer of shape ",
+                                 viewed_tensor.Shape(), ". Validate the shapes in the model.");
+        }
+        ORT_RETURN_IF_ERROR(AllocateTensorWithPreAllocateBufferHelper(
+            ort_value, const_cast<void*>(viewed_tensor.DataRaw()), ml_data_type, alloc_info, *shape));
+        break;
+      }
       case AllocKind::kShare: {
         int reuse_mlvalue_index = per_alloc_plan.reused_buffer;
         // copy at the OrtValue level so the shared_ptr for the data is shared between the two OrtValue instances
@@ -489,9 +645,97 @@ Status ExecutionFrame::CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_
 Status ExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
   ORT_RETURN_IF_ERROR(IExecutionFrame::ReleaseMLValueImpl(ort_value_idx));
   TraceFree(ort_value_idx);
+  CountFree(ort_value_idx);
+  // the release of a value whose reads are still pending is deferred to the end of the run
+  if (memory_profiler_ != nullptr && profiled_buffers_[ort_value_idx].allocated &&
+      !GetMLValue(ort_value_idx).IsAllocated()) {
+    RecordFree(ort_value_idx);
+  }
   return Status::OK();
 }
 
+void ExecutionFrame::CountAllocation(int ort_value_idx, size_t size) {
+  ++num_allocations_;
+  bytes_allocated_ += size;
+  bytes_in_use_ += size;
+  peak_bytes_in_use_ = std::max(peak_bytes_in_use_, bytes_in_use_);
+  if (ort_value_idx >= 0) {
+    if (allocated_sizes_.empty()) {
+      allocated_sizes_.resize(session_state_.GetExecutionPlan()->allocation_plan.size());
+    }
+    allocated_sizes_[ort_value_idx] = size;
+  }
+}
+
+void ExecutionFrame::CountFree(int ort_value_idx) {
+  // the release of a value whose reads are still pending is deferred to the end of the run
+  if (static_cast<size_t>(ort_value_idx) < allocated_sizes_.size() && !GetMLValue(ort_value_idx).IsAllocated()) {
+    bytes_in_use_ -= allocated_sizes_[ort_value_idx];
+    allocated_sizes_[ort_value_idx] = 0;
+  }
+}
+
+void ExecutionFrame::UpdateRunStats(RunStats& stats) const {
+  stats.num_allocations += static_cast<int64_t>(num_allocations_);
+  stats.bytes_allocated += static_cast<int64_t>(bytes_allocated_);
+  stats.peak_bytes = std::max(stats.peak_bytes, static_cast<int64_t>(peak_bytes_in_use_));
+  if (mem_patterns_ != nullptr && !mem_patterns_miss_) {
+    ++stats.num_memory_pattern_hits;
+  }
+}
+
+void ExecutionFrame::RecordFree(int ort_value_idx) {
+  ProfiledBuffer& buffer = profiled_buffers_[ort_value_idx];
+  buffer.allocated = false;
+  RecordMemoryEvent(false, ort_value_idx, buffer.location, buffer.size, buffer.in_memory_pattern);
+}
+
+void ExecutionFrame::RecordMemoryEvent(bool allocate, int ort_value_idx, const OrtMemoryInfo& location, size_t size,
+                                       bool in_memory_pattern) {
+  const std::string location_name = std::string(location.name) + ":" + std::to_string(location.id);
+  if (allocate && ort_value_idx >= 0) {
+    ProfiledBuffer& buffer = profiled_buffers_[ort_value_idx];
+    buffer.allocated = true;
+    buffer.in_memory_pattern = in_memory_pattern;
+    buffer.size = size;
+    buffer.location = location;
+  }
+
+  size_t& bytes_in_use = profiled_bytes_in_use_[location_name];
+  if (!in_memory_pattern) {
+    bytes_in_use = allocate ? bytes_in_use + size : bytes_in_use - std::min(bytes_in_use, size);
+  }
+
+  std::unordered_map<std::string, std::string> args{
+      {"value", ort_value_idx >= 0 ? value_names_[ort_value_idx] : "memory_pattern_buffer"},
+      {"node", ort_value_idx >= 0 ? producer_names_[ort_value_idx] : ""},
+      {"size", std::to_string(size)},
+      {"location", location_name},
+      {"in_memory_pattern", in_memory_pattern ? "1" : "0"},
+      {"frame_in_use_bytes", std::to_string(bytes_in_use)},
+  };
+
+  // the state of the arena after the call, with whether it had to allocate from the device since the last event
+  AllocatorPtr alloc = GetAllocator(location);
+  if (alloc != nullptr && alloc->Info().alloc_type == OrtArenaAllocator) {
+    auto arena = std::dynamic_pointer_cast<IArenaAllocator>(alloc);
+    if (arena != nullptr) {
+      AllocatorStats stats;
+      arena->GetStats(&stats);
+      auto reserved = arena_reserved_bytes_.find(location_name);
+      const bool extended = reserved != arena_reserved_bytes_.end() && stats.total_allocated_bytes > reserved->second;
+      arena_reserved_bytes_[location_name] = stats.total_allocated_bytes;
+      args.emplace("arena_in_use_bytes", std::to_string(stats.bytes_in_use));
+      args.emplace("arena_reserved_bytes", std::to_string(stats.total_allocated_bytes));
+      args.emplace("arena_limit", std::to_string(stats.bytes_limit));
+      args.emplace("arena_fragmentation", std::to_string(stats.Fragmentation()));
+      args.emplace("arena_extended", extended ? "1" : "0");
+    }
+  }
+
+  memory_profiler_->RecordMemoryEvent(allocate ? "memory_alloc" : "memory_free", std::move(args));
+}
+
 const AllocPlanPerValue& ExecutionFrame::GetAllocationPlan(int ort_value_idx) {
   const SequentialExecutionPlan* p_seq_exec_plan = session_state_.GetExecutionPlan();
   const auto& alloc_plan = p_seq_exec_plan->allocation_plan;
@@ -546,4 +790,44 @@ Status ExecutionFrame::GeneratePatterns(MemoryPatternGroup* out) const {
   return planner_->GeneratePatterns(out);
 }
 
+ExecutionFramePool::FrameHandle::~FrameHandle() {
+  if (frame_ != nullptr) {
+    pool_->Release(std::move(frame_));
+  }
+}
+
+ExecutionFramePool::FrameHandle ExecutionFramePool::Acquire(
+    const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds,
+    const std::vector<int>& fetch_mlvalue_idxs, const std::vector<OrtValue>& fetches,
+    const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+    const SessionState& session_state) {
+  std::unique_ptr<ExecutionFrame> frame;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    if (!frames_.empty()) {
+      frame = std::move(frames_.back());
+      frames_.pop_back();
+    }
+  }
+
+  if (frame != nullptr) {
+    frame->Reset(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators);
+  } else {
+    frame = onnxruntime::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches,
+                                                     fetch_allocators, session_state);
+  }
+  return FrameHandle(*this, std::move(frame));
+}
+
+void ExecutionFramePool::Clear() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  frames_.clear();
+}
+
+void ExecutionFramePool::Release(std::unique_ptr<ExecutionFrame> frame) {
+  frame->EndRun();
+  std::lock_guard<OrtMutex> lock(mutex_);
+  frames_.push_back(std::move(frame));
+}
+
 }  // namespace onnxruntime
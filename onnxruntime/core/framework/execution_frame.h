@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "core/common/common.h"
@@ -11,9 +14,11 @@
 #include "core/framework/iexecutor.h"
 #include "core/framework/ml_value.h"
 #include "core/framework/node_index_info.h"
+#include "core/framework/run_stats.h"
 #include "core/framework/sequential_execution_plan.h"
 #include "core/framework/tensor.h"
 #include "core/graph/graph_viewer.h"
+#include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
 
@@ -22,6 +27,9 @@ class OrtValueNameIdxMap;
 class OrtValuePatternPlanner;
 struct MemoryPatternGroup;
 class NodeIndexInfo;
+namespace profiling {
+class Profiler;
+}
 
 class IExecutionFrame {
  protected:
@@ -69,6 +77,14 @@ class IExecutionFrame {
   // returns true if the ort_value_idx is an output from the graph
   bool IsOutput(int ort_value_idx) const;
 
+  // set up the values for another run as the constructor does. the capacity of the vectors is kept.
+  void ResetValues(const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds,
+                   const std::unordered_map<int, OrtValue>& initializers, const std::vector<int>& fetch_mlvalue_idxs,
+                   const std::vector<OrtValue>& fetches);
+
+  // release all the values, including the feeds, initializers and outputs the frame shares
+  void ClearValues();
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IExecutionFrame);
 
@@ -94,7 +110,7 @@ class IExecutionFrame {
   // perf optimization to avoid calling all_values_.size() repeatedly as the size is fixed once constructed
   const size_t all_values_size_;
 
-  const std::vector<int> fetch_mlvalue_idxs_;
+  std::vector<int> fetch_mlvalue_idxs_;
 };
 
 class ExecutionFrame final : public IExecutionFrame {
@@ -107,6 +123,15 @@ class ExecutionFrame final : public IExecutionFrame {
 
   ~ExecutionFrame() override;
 
+  // Reuse the frame for another run of the same session state, as if it was constructed with these arguments. The
+  // memory pattern blocks are kept if the run uses the same memory patterns.
+  void Reset(const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds,
+             const std::vector<int>& fetch_mlvalue_idxs, const std::vector<OrtValue>& fetches,
+             const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
+  // Release the values of the run once the outputs are fetched, so that an idle frame doesn't hold them.
+  void EndRun();
+
   // TODO: These two AllocateMLValue... methods are in the API purely for unit test usage.
   // Fix the unit tests so they set an execution plan that results in these methods being called by
   // GetOrCreateNodeOutputMLValue instead
@@ -125,9 +150,27 @@ class ExecutionFrame final : public IExecutionFrame {
     return planner_ != nullptr;
   }
 
+  // true if the patterns traced in this frame should be written to the session state cache,
+  // either because there were no cached patterns for the input shapes, or because some tensors
+  // did not fit in the blocks of the bucketed patterns that were used.
+  bool ShouldUpdateMemoryPatterns() const {
+    return planner_ != nullptr && (mem_patterns_ == nullptr || mem_patterns_miss_);
+  }
+
+  // Counts the buffers allocated for the values of the frame from now on. Not thread-safe, so only used by the
+  // sequential executor.
+  void EnableRunStats() { count_allocations_ = true; }
+
+  // Adds the buffers allocated by this frame, their peak, and whether the cached memory patterns were used to 'stats'.
+  void UpdateRunStats(RunStats& stats) const;
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ExecutionFrame);
 
+  // the part of the construction that depends on the run
+  void SetUpRun(const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
+                const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
   AllocatorPtr GetAllocatorImpl(const OrtMemoryInfo& info) const override;
   Status ReleaseMLValueImpl(int ort_value_idx) override;
   Status CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape, size_t nnz) override;
@@ -145,6 +188,18 @@ class ExecutionFrame final : public IExecutionFrame {
   void TraceAllocate(int ort_value_idx, size_t size);
   void TraceFree(int ort_value_idx);
 
+  // count the buffers allocated for the run statistics. ort_value_idx is -1 for the memory pattern blocks.
+  void CountAllocation(int ort_value_idx, size_t size);
+  void CountFree(int ort_value_idx);
+
+  // record the allocation or free of a buffer as a memory event of the profiler, with the value it holds, the producer
+  // node of the value and the state of the arena. ort_value_idx is -1 for the memory pattern blocks.
+  void RecordMemoryEvent(bool allocate, int ort_value_idx, const OrtMemoryInfo& location, size_t size,
+                         bool in_memory_pattern);
+  void RecordFree(int ort_value_idx);
+  // record the frees of the values the frame still holds, except the outputs, and release the memory pattern blocks
+  void RecordEndOfRun();
+
   const AllocPlanPerValue& GetAllocationPlan(int ort_value_idx);
 
   const SessionState& session_state_;
@@ -155,7 +210,10 @@ class ExecutionFrame final : public IExecutionFrame {
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
-  const MemoryPatternGroup* mem_patterns_;
+  std::shared_ptr<const MemoryPatternGroup> mem_patterns_;
+
+  // set when a tensor did not fit in its block of the bucketed mem_patterns_.
+  bool mem_patterns_miss_ = false;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
@@ -163,5 +221,79 @@ class ExecutionFrame final : public IExecutionFrame {
 
   // Big chunks on different locations that will be used by mem_pattern.
   std::map<OrtMemoryInfo, BufferUniquePtr> buffers_;
+  // the patterns buffers_ were allocated for, which may be those of a previous run of the frame
+  std::shared_ptr<const MemoryPatternGroup> buffers_patterns_;
+  std::vector<std::reference_wrapper<const TensorShape>> input_shapes_;
+
+  // size of the buffer allocated by this frame for each value, 0 if the value doesn't own one
+  bool count_allocations_ = false;
+  std::vector<size_t> allocated_sizes_;
+  size_t num_allocations_ = 0;
+  size_t bytes_allocated_ = 0;
+  size_t bytes_in_use_ = 0;
+  size_t peak_bytes_in_use_ = 0;
+
+  // the profiler recording the memory events if the session enables memory profiling, or null
+  profiling::Profiler* memory_profiler_ = nullptr;
+  // the names of the values and of the nodes producing them, indexed by ort_value_idx
+  std::vector<std::string> value_names_;
+  std::vector<std::string> producer_names_;
+  // the buffer recorded for each value until it is freed. a value placed in a memory pattern block has no buffer of
+  // its own: its size isn't counted in the bytes in use of the location, which already include the block.
+  struct ProfiledBuffer {
+    bool allocated = false;
+    bool in_memory_pattern = false;
+    size_t size = 0;
+    OrtMemoryInfo location;
+  };
+  std::vector<ProfiledBuffer> profiled_buffers_;
+  // per location name, the bytes of the buffers allocated by this frame that are in use, and the bytes the arena had
+  // reserved at the last event to tell when it extends
+  std::unordered_map<std::string, size_t> profiled_bytes_in_use_;
+  std::unordered_map<std::string, int64_t> arena_reserved_bytes_;
+};
+
+/**
+ * The execution frames of a session state that are idle between runs. A run takes one, or creates one if they are
+ * all in use, and gives it back when done, so there are as many frames as concurrent runs and a run usually reuses
+ * the vectors, the custom allocator map and the memory pattern blocks of a previous run. Thread-safe.
+ */
+class ExecutionFramePool {
+ public:
+  // Gives the frame back to the pool when destroyed.
+  class FrameHandle {
+   public:
+    FrameHandle(ExecutionFramePool& pool, std::unique_ptr<ExecutionFrame> frame)
+        : pool_(&pool), frame_(std::move(frame)) {}
+    FrameHandle(FrameHandle&& other) noexcept : pool_(other.pool_), frame_(std::move(other.frame_)) {}
+    ~FrameHandle();
+
+    ExecutionFrame& operator*() const { return *frame_; }
+    ExecutionFrame* operator->() const { return frame_.get(); }
+
+   private:
+    ORT_DISALLOW_COPY_AND_ASSIGNMENT(FrameHandle);
+
+    ExecutionFramePool* pool_;
+    std::unique_ptr<ExecutionFrame> frame_;
+  };
+
+  ExecutionFramePool() = default;
+
+  FrameHandle Acquire(const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds,
+                      const std::vector<int>& fetch_mlvalue_idxs, const std::vector<OrtValue>& fetches,
+                      const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                      const SessionState& session_state);
+
+  // destroy the idle frames
+  void Clear();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ExecutionFramePool);
+
+  void Release(std::unique_ptr<ExecutionFrame> frame);
+
+  OrtMutex mutex_;
+  std::vector<std::unique_ptr<ExecutionFrame>> frames_;
 };
 }  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 #include "core/framework/execution_provider.h"
 
+#include "core/common/profiler.h"
 #include "core/graph/graph_viewer.h"
 #include "core/framework/compute_capability.h"
 #include "core/framework/kernel_registry_manager.h"
@@ -45,10 +46,28 @@ IExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph,
 
 common::Status IExecutionProvider::Sync() const { return Status::OK(); };
 
-common::Status IExecutionProvider::OnRunStart() { return Status::OK(); }
+common::Status IExecutionProvider::OnRunStart(const RunOptions& /*run_options*/) { return Status::OK(); }
 
 common::Status IExecutionProvider::OnRunEnd() { return Status::OK(); }
 
+std::unique_ptr<profiling::DeviceProfiler> IExecutionProvider::GetProfiler() { return nullptr; }
+
+common::Status IExecutionProvider::ReplayGraph(const std::string& /*graph_key*/, bool& replayed) {
+  replayed = false;
+  return Status::OK();
+}
+
+common::Status IExecutionProvider::BeginGraphCapture(const std::string& /*graph_key*/, bool& capturing) {
+  capturing = false;
+  return Status::OK();
+}
+
+common::Status IExecutionProvider::EndGraphCapture(const std::string& /*graph_key*/,
+                                                   const common::Status& /*run_status*/, bool& rerun) {
+  rerun = false;
+  return Status::OK();
+}
+
 void IExecutionProvider::InsertAllocator(AllocatorPtr allocator) {
   const OrtMemoryInfo& info = allocator->Info();
   const int key = MakeKey(info.id, info.mem_type);
@@ -60,6 +79,24 @@ void IExecutionProvider::InsertAllocator(AllocatorPtr allocator) {
   allocator_list_.emplace_back(gsl::not_null<IAllocator*>(allocator.get()));
 }
 
+bool IExecutionProvider::ReplaceAllocator(AllocatorPtr allocator) {
+  const OrtMemoryInfo& info = allocator->Info();
+  auto iter = allocators_.find(MakeKey(info.id, info.mem_type));
+  if (iter == allocators_.end() || !(iter->second->Info() == info)) {
+    return false;
+  }
+
+  const IAllocator* old_allocator = iter->second.get();
+  for (auto& entry : allocator_list_) {
+    if (entry.get() == old_allocator) {
+      entry = gsl::not_null<const IAllocator*>(allocator.get());
+    }
+  }
+
+  iter->second = std::move(allocator);
+  return true;
+}
+
 common::Status IExecutionProvider::Compile(const std::vector<onnxruntime::Node*>& /*fused_node*/,
                                            std::vector<NodeComputeInfo>& /*node_compute_funcs*/) {
   return common::Status(common::ONNXRUNTIME, common::NOT_IMPLEMENTED);
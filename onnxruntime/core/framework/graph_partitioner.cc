@@ -10,6 +10,16 @@
 #include "core/framework/execution_providers.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/func_kernel.h"
+#include "core/framework/session_options.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/framework/utils.h"
+#include "core/common/logging/logging.h"
+#include "core/common/profiler.h"
+#include "core/platform/tracing.h"
+
+#include <functional>
+#include <numeric>
+#include <unordered_set>
 
 // uncomment this line to count non-CUDA ops in ONNX domain
 //#define COUNT_NON_CUDA_OPS
@@ -105,6 +115,171 @@ static Node* PlaceNode(Graph& graph, std::unique_ptr<IndexedSubGraph> capability
   return nullptr;
 }
 
+namespace {
+
+// Number of elements of a value from its inferred shape, or -1 if it isn't fully known.
+int64_t StaticElementCount(const NodeArg& arg) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) return -1;
+  int64_t count = 1;
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim) || dim.dim_value() < 0) return -1;
+    count *= dim.dim_value();
+  }
+  return count;
+}
+
+int64_t StaticSizeInBytes(const NodeArg& arg) {
+  if (arg.TypeAsProto() == nullptr) return -1;
+  const auto* tensor_type = DataTypeImpl::TypeFromProto(*arg.TypeAsProto())->AsTensorType();
+  const int64_t count = StaticElementCount(arg);
+  if (tensor_type == nullptr || count < 0) return -1;
+  return count * static_cast<int64_t>(tensor_type->GetElementType()->Size());
+}
+
+// Operations of a node estimated from the inferred shapes, or -1 if they aren't known: two per multiply-add for the
+// convolutions and the matrix products, one per output element for the other nodes.
+int64_t EstimateFlops(const Node& node) {
+  const auto& inputs = node.InputDefs();
+  const auto& outputs = node.OutputDefs();
+  if (outputs.empty()) return 0;
+  const int64_t output_count = StaticElementCount(*outputs[0]);
+  if (output_count < 0) return -1;
+
+  const std::string& op_type = node.OpType();
+  if ((op_type == "Conv" || op_type == "FusedConv") && inputs.size() > 1) {
+    // each output element reads the C / group * kernel size weights of its output channel
+    const int64_t weight_count = StaticElementCount(*inputs[1]);
+    const auto* weight_shape = inputs[1]->Shape();
+    if (weight_count < 0 || weight_shape->dim_size() == 0 || weight_shape->dim(0).dim_value() == 0) return -1;
+    return 2 * output_count * (weight_count / weight_shape->dim(0).dim_value());
+  }
+  if ((op_type == "MatMul" || op_type == "FusedMatMul" || op_type == "Gemm") && !inputs.empty()) {
+    const auto* a_shape = inputs[0]->Shape();
+    if (a_shape == nullptr || a_shape->dim_size() == 0) return -1;
+    int k_axis = a_shape->dim_size() - 1;
+    if (op_type == "Gemm") {
+      const auto& attributes = node.GetAttributes();
+      auto trans_a = attributes.find("transA");
+      k_axis = trans_a != attributes.end() && trans_a->second.i() != 0 ? 0 : 1;
+      if (a_shape->dim_size() != 2) return -1;
+    }
+    const auto& k_dim = a_shape->dim(k_axis);
+    if (!utils::HasDimValue(k_dim)) return -1;
+    return 2 * output_count * k_dim.dim_value();
+  }
+  return output_count;
+}
+
+}  // namespace
+
+void GraphPartitioner::RemoveUnprofitableCapabilities(
+    const Graph& graph, const std::string& provider_type,
+    std::vector<std::unique_ptr<ComputeCapability>>& capabilities) const {
+  // the capabilities the provider could be given, by node
+  std::unordered_map<NodeIndex, size_t> node_capability;
+  for (size_t i = 0; i < capabilities.size(); ++i) {
+    for (auto node_index : capabilities[i]->sub_graph->nodes) {
+      const Node* node = graph.GetNode(node_index);
+      if (node != nullptr && node->GetExecutionProviderType().empty()) node_capability[node_index] = i;
+    }
+  }
+
+  // group the capabilities connected by an edge, as the values between them stay on the device
+  std::vector<size_t> group(capabilities.size());
+  std::iota(group.begin(), group.end(), 0);
+  std::function<size_t(size_t)> find_group = [&group, &find_group](size_t i) {
+    return group[i] == i ? i : group[i] = find_group(group[i]);
+  };
+  for (const auto& entry : node_capability) {
+    const Node* node = graph.GetNode(entry.first);
+    for (auto edge = node->OutputEdgesBegin(); edge != node->OutputEdgesEnd(); ++edge) {
+      auto consumer = node_capability.find(edge->GetNode().Index());
+      if (consumer != node_capability.end()) group[find_group(entry.second)] = find_group(consumer->second);
+    }
+  }
+  std::unordered_map<size_t, std::vector<size_t>> groups;
+  for (size_t i = 0; i < capabilities.size(); ++i) {
+    groups[find_group(i)].push_back(i);
+  }
+
+  // the values produced on this device or by a provider on another device don't need a copy from the host
+  auto on_device = [&node_capability, &provider_type](const Node& node) {
+    const std::string& assigned = node.GetExecutionProviderType();
+    return assigned.empty() ? node_capability.count(node.Index()) != 0
+                            : assigned == provider_type || !utils::ProviderIsCpuBased(assigned);
+  };
+  std::unordered_set<const NodeArg*> graph_outputs(graph.GetOutputs().begin(), graph.GetOutputs().end());
+  const auto& model = *cost_model_;
+  std::vector<bool> removed(capabilities.size(), false);
+  for (const auto& entry : groups) {
+    int64_t flops = 0;
+    int64_t copied_bytes = 0;
+    int64_t num_copies = 0;
+    bool known = true;
+    bool runs_on_host = true;
+    std::unordered_set<const NodeArg*> copied;
+    auto add_copy = [&](const NodeArg* arg) {
+      if (!copied.insert(arg).second) return;
+      const int64_t bytes = StaticSizeInBytes(*arg);
+      known = known && bytes >= 0;
+      copied_bytes += bytes;
+      ++num_copies;
+    };
+
+    for (size_t i : entry.second) {
+      for (auto node_index : capabilities[i]->sub_graph->nodes) {
+        const Node* node = graph.GetNode(node_index);
+        if (node == nullptr || !node->GetExecutionProviderType().empty()) continue;
+        const int64_t node_flops = EstimateFlops(*node);
+        known = known && node_flops >= 0;
+        flops += node_flops;
+        runs_on_host = runs_on_host && kernel_registry_mgr_.HasImplementationOf(*node, kCpuExecutionProvider);
+
+        std::unordered_set<int> produced_inputs;
+        for (auto edge = node->InputEdgesBegin(); edge != node->InputEdgesEnd(); ++edge) {
+          produced_inputs.insert(edge->GetDstArgIndex());
+          if (!on_device(edge->GetNode())) add_copy(node->InputDefs()[edge->GetDstArgIndex()]);
+        }
+        const auto& input_defs = node->InputDefs();
+        for (int j = 0; j < static_cast<int>(input_defs.size()); ++j) {
+          // the graph inputs are copied on each run, the initializers once
+          const ONNX_NAMESPACE::TensorProto* initializer = nullptr;
+          if (input_defs[j]->Exists() && produced_inputs.count(j) == 0 &&
+              !graph.GetInitializedTensor(input_defs[j]->Name(), initializer)) {
+            add_copy(input_defs[j]);
+          }
+        }
+        for (auto edge = node->OutputEdgesBegin(); edge != node->OutputEdgesEnd(); ++edge) {
+          if (!on_device(edge->GetNode())) add_copy(node->OutputDefs()[edge->GetSrcArgIndex()]);
+        }
+        for (const auto* output : node->OutputDefs()) {
+          if (graph_outputs.count(output) != 0) add_copy(output);
+        }
+      }
+    }
+    if (!known || !runs_on_host) continue;
+
+    const double host_us = static_cast<double>(flops) / (model.host_gflops * 1e3);
+    const double device_us = static_cast<double>(flops) / (model.device_gflops * 1e3) +
+                             model.kernel_launch_us * static_cast<double>(entry.second.size()) +
+                             model.copy_latency_us * static_cast<double>(num_copies) +
+                             static_cast<double>(copied_bytes) / (model.copy_gbps * 1e3);
+    if (device_us >= host_us) {
+      LOGS_DEFAULT(INFO) << "Leaving " << entry.second.size() << " subgraphs claimed by " << provider_type
+                         << " to the next providers: estimated " << device_us << " us with the copies against "
+                         << host_us << " us on the host";
+      for (size_t i : entry.second) removed[i] = true;
+    }
+  }
+
+  size_t kept = 0;
+  for (size_t i = 0; i < capabilities.size(); ++i) {
+    if (!removed[i]) capabilities[kept++] = std::move(capabilities[i]);
+  }
+  capabilities.resize(kept);
+}
+
 Status GraphPartitioner::Partition(Graph& graph, bool export_dll, FuncManager& func_mgr) const {
   // It is a greedy partitioning algorithm per provider preferences user provided when calling ONNX RUNTIME right now.
   // 1. Execution providers' capabilities are checked one by one.
@@ -151,8 +326,15 @@ Status GraphPartitioner::Partition(Graph& graph, bool export_dll, FuncManager& f
   for (auto& provider : providers_) {
     int count = 0;
     std::vector<Node*> nodes_need_compile;
-    std::vector<std::unique_ptr<ComputeCapability>> capabilities =
-        provider->GetCapability(graph_viewer, kernel_registry_mgr_.GetKernelRegistriesByProviderType(provider->Type()));
+    std::vector<std::unique_ptr<ComputeCapability>> capabilities;
+    {
+      profiling::ScopedSessionEvent event(profiler_, provider->Type() + "_get_capability");
+      capabilities = provider->GetCapability(graph_viewer,
+                                             kernel_registry_mgr_.GetKernelRegistriesByProviderType(provider->Type()));
+    }
+    if (cost_model_ != nullptr && !utils::ProviderIsCpuBased(provider->Type())) {
+      RemoveUnprofitableCapabilities(graph, provider->Type(), capabilities);
+    }
     for (auto& capability : capabilities) {
       Node* n = PlaceNode(graph, std::move(capability->sub_graph), kernel_registry_mgr_, provider->Type(), count);
       if (n != nullptr) {
@@ -161,14 +343,21 @@ Status GraphPartitioner::Partition(Graph& graph, bool export_dll, FuncManager& f
     }
 
     if (!nodes_need_compile.empty()) {
+      profiling::ScopedSessionEvent event(profiler_, provider->Type() + "_compile");
       if (export_dll) {
         std::string dll_path;
-        ORT_RETURN_IF_ERROR(provider->Compile(nodes_need_compile, dll_path));
+        ORT_TRACE_COMPILE_START(provider->Type().c_str(), nodes_need_compile.size());
+        Status compile_status = provider->Compile(nodes_need_compile, dll_path);
+        ORT_TRACE_COMPILE_STOP(provider->Type().c_str(), nodes_need_compile.size());
+        ORT_RETURN_IF_ERROR(compile_status);
         for (auto* node : nodes_need_compile)
           ORT_RETURN_IF_ERROR(func_mgr.AddFuncInfo(node->Name(), dll_path));
       } else {
         std::vector<NodeComputeInfo> node_compute_funcs;
-        ORT_RETURN_IF_ERROR(provider->Compile(nodes_need_compile, node_compute_funcs));
+        ORT_TRACE_COMPILE_START(provider->Type().c_str(), nodes_need_compile.size());
+        Status compile_status = provider->Compile(nodes_need_compile, node_compute_funcs);
+        ORT_TRACE_COMPILE_STOP(provider->Type().c_str(), nodes_need_compile.size());
+        ORT_RETURN_IF_ERROR(compile_status);
         ORT_ENFORCE(node_compute_funcs.size() == nodes_need_compile.size(),
                     "Provider doesn't return correct number of compiled functions");
         for (size_t j = 0; j < nodes_need_compile.size(); j++)
@@ -12,6 +12,11 @@ namespace onnxruntime {
 
 class ExecutionProviders;
 class KernelRegistryManager;
+struct ComputeCapability;
+struct PartitioningCostModel;
+namespace profiling {
+class Profiler;
+}
 
 class GraphPartitioner {
  public:
@@ -22,10 +27,25 @@ class GraphPartitioner {
 
   Status Partition(Graph& graph, bool export_dll, FuncManager& func_mgr) const;
 
+  // Set the profiler that records the GetCapability and Compile calls of each provider. Nothing is recorded unless
+  // the profiler is enabled.
+  void SetProfiler(profiling::Profiler* profiler) { profiler_ = profiler; }
+
+  // Partition with the costs of cost_model rather than greedily, see SessionOptions::enable_cost_based_partitioning.
+  // nullptr, the default, partitions greedily. cost_model must outlive the partitioner.
+  void SetCostModel(const PartitioningCostModel* cost_model) { cost_model_ = cost_model; }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphPartitioner);
 
+  // Remove from the capabilities of a provider on a device the groups of connected nodes which are estimated to run
+  // faster on the host, once the copies of their inputs and outputs are counted.
+  void RemoveUnprofitableCapabilities(const Graph& graph, const std::string& provider_type,
+                                      std::vector<std::unique_ptr<ComputeCapability>>& capabilities) const;
+
   KernelRegistryManager& kernel_registry_mgr_;
   const ExecutionProviders& providers_;
+  profiling::Profiler* profiler_ = nullptr;
+  const PartitioningCostModel* cost_model_ = nullptr;
 };
 }  // namespace onnxruntime
@@ -9,6 +9,7 @@
 #include "core/common/status.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/ml_value.h"
+#include "core/framework/run_stats.h"
 
 struct OrtValue;
 namespace onnxruntime {
@@ -44,5 +45,11 @@ class IExecutor {
                                  // optional custom allocators. key is index in fetches
                                  const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
                                  const logging::Logger& logger) = 0;
+
+  // Set to have Execute add the allocations of the run to 'run_stats', if the executor tracks them.
+  void SetRunStats(RunStats* run_stats) { run_stats_ = run_stats; }
+
+ protected:
+  RunStats* run_stats_ = nullptr;
 };
 }  // namespace onnxruntime
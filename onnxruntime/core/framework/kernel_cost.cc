@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/kernel_cost.h"
+
+#include <iomanip>
+#include <sstream>
+
+namespace onnxruntime {
+namespace kernel_cost {
+
+namespace {
+
+bool IsTensor(MLDataType type) {
+  return type != nullptr && type->IsTensorType();
+}
+
+std::string FormatRate(double rate) {
+  std::ostringstream ss;
+  ss << std::fixed << std::setprecision(3) << rate;
+  return ss.str();
+}
+
+}  // namespace
+
+int64_t TensorBytes(OpKernelContext& context) {
+  int64_t bytes = 0;
+  for (int i = 0; i < context.InputCount(); ++i) {
+    if (IsTensor(context.InputType(i))) {
+      bytes += static_cast<int64_t>(context.Input<Tensor>(i)->SizeInBytes());
+    }
+  }
+  for (int i = 0; i < context.OutputCount(); ++i) {
+    if (IsTensor(context.OutputType(i))) {
+      bytes += static_cast<int64_t>(context.Output<Tensor>(i)->SizeInBytes());
+    }
+  }
+  return bytes;
+}
+
+KernelCost Elementwise(OpKernelContext& context, int64_t flops_per_element) {
+  KernelCost cost;
+  if (context.OutputCount() > 0 && IsTensor(context.OutputType(0))) {
+    cost.flops = flops_per_element * context.Output<Tensor>(0)->Shape().Size();
+  }
+  cost.bytes = TensorBytes(context);
+  return cost;
+}
+
+KernelCost DotProducts(OpKernelContext& context, int64_t reduction_size) {
+  return Elementwise(context, 2 * reduction_size);
+}
+
+KernelCost Convolution(OpKernelContext& context) {
+  const auto& filter_shape = context.Input<Tensor>(1)->Shape();
+  const int64_t num_filters = filter_shape.NumDimensions() > 0 ? filter_shape[0] : 0;
+  return DotProducts(context, num_filters > 0 ? filter_shape.Size() / num_filters : 0);
+}
+
+void AddProfilingArgs(const OpKernel& kernel, OpKernelContext& context, int64_t duration_us,
+                      std::unordered_map<std::string, std::string>& args) {
+  KernelCost cost;
+  if (!kernel.GetCost(context, cost)) {
+    return;
+  }
+
+  args["flops"] = std::to_string(cost.flops);
+  args["bytes"] = std::to_string(cost.bytes);
+  if (duration_us > 0) {
+    // operations per microsecond / 1000 = GFLOPS, bytes per microsecond / 1000 = GB/s
+    args["gflops"] = FormatRate(static_cast<double>(cost.flops) / duration_us / 1000.0);
+    args["gbps"] = FormatRate(static_cast<double>(cost.bytes) / duration_us / 1000.0);
+  }
+}
+
+}  // namespace kernel_cost
+}  // namespace onnxruntime
@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace kernel_cost {
+
+// Bytes of the input and output tensors of a call, the memory traffic of a kernel reading each input element and
+// writing each output element once.
+int64_t TensorBytes(OpKernelContext& context);
+
+// Cost of a kernel computing each element of its first output with flops_per_element operations.
+KernelCost Elementwise(OpKernelContext& context, int64_t flops_per_element = 1);
+
+// Cost of a call to a kernel computing output elements as dot products of reduction_size elements, as matrix
+// multiplications and convolutions do.
+KernelCost DotProducts(OpKernelContext& context, int64_t reduction_size);
+
+// Cost of a call to a convolution kernel whose filter [M, C / group, kernel...] is the second input. Each output
+// element is a dot product over the C / group channels and the kernel.
+KernelCost Convolution(OpKernelContext& context);
+
+// Adds the "flops" and "bytes" of the call and the achieved "gflops" and "gbps" to the args of its profiler event if
+// the kernel has a cost model.
+void AddProfilingArgs(const OpKernel& kernel, OpKernelContext& context, int64_t duration_us,
+                      std::unordered_map<std::string, std::string>& args);
+
+}  // namespace kernel_cost
+}  // namespace onnxruntime
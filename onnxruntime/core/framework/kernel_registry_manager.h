@@ -75,6 +75,8 @@ class KernelRegistryManager {
     return result;
   }
 
+  bool HasCustomKernelRegistries() const { return !custom_kernel_registries_.empty(); }
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelRegistryManager);
 
  private:
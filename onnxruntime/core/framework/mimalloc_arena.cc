@@ -24,6 +24,12 @@ namespace onnxruntime {
         return mi_malloc(size);
     }
 
+    Status MiMallocArena::Shrink() {
+        // return free segments and pages to the OS
+        mi_collect(true);
+        return Status::OK();
+    }
+
     // mimalloc only maintains stats when compiled under debug (which in turn sets MI_STAT)
     void MiMallocArena::GetStats(AllocatorStats* stats) {
 #if (MI_STAT>1)
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/numa_allocator.h"
+
+#include <new>
+
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+// the granularity of the memory returned by Env::AllocateNumaMemory on the platforms we support
+static constexpr size_t kNumaPageSize = 4096;
+
+NumaCPUAllocator::NumaCPUAllocator(int numa_node)
+    : numa_node_(numa_node), memory_info_(CPU, OrtAllocatorType::OrtDeviceAllocator) {
+  ORT_ENFORCE(numa_node >= 0, "Invalid NUMA node: ", numa_node);
+}
+
+NumaCPUAllocator::~NumaCPUAllocator() {
+  for (const auto& allocation : allocations_) {
+    Env::Default().FreeNumaMemory(allocation.first, allocation.second);
+  }
+}
+
+void* NumaCPUAllocator::Alloc(size_t size) {
+  if (size == 0) return nullptr;
+
+  size_t rounded_size = 0;
+  if (!CalcMemSizeForArrayWithAlignment(1, size, kNumaPageSize, &rounded_size)) {
+    throw std::bad_alloc();
+  }
+
+  void* p = Env::Default().AllocateNumaMemory(rounded_size, numa_node_);
+  if (p == nullptr) throw std::bad_alloc();
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  allocations_[p] = rounded_size;
+  return p;
+}
+
+void NumaCPUAllocator::Free(void* p) {
+  if (p == nullptr) return;
+
+  size_t size = 0;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = allocations_.find(p);
+    ORT_ENFORCE(it != allocations_.end(), "Freeing memory that was not allocated by this allocator");
+    size = it->second;
+    allocations_.erase(it);
+  }
+
+  Env::Default().FreeNumaMemory(p, size);
+}
+
+}  // namespace onnxruntime
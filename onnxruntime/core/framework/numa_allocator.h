@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <unordered_map>
+
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// CPU allocator that places its memory on a NUMA node, so it stays local to the threads pinned to that node no matter
+// which thread touches it first. Every allocation is rounded up to whole pages, so it is meant to sit behind an arena
+// that requests large chunks rather than to serve small allocations directly.
+class NumaCPUAllocator : public IDeviceAllocator {
+ public:
+  explicit NumaCPUAllocator(int numa_node);
+  ~NumaCPUAllocator() override;
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  const OrtMemoryInfo& Info() const override { return memory_info_; }
+
+  int NumaNode() const { return numa_node_; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NumaCPUAllocator);
+
+  const int numa_node_;
+  const OrtMemoryInfo memory_info_;
+
+  // size of each live allocation, which is needed to release it
+  OrtMutex mutex_;
+  std::unordered_map<void*, size_t> allocations_;
+};
+
+}  // namespace onnxruntime
@@ -25,6 +25,20 @@ OpKernelContext::OpKernelContext(IExecutionFrame* frame,
   node_output_start_index_ = node_implicit_input_start_index_ + ImplicitInputCount();
 }
 
+OpKernelContext::OpKernelContext(IExecutionFrame* frame,
+                                 const OpKernel* kernel,
+                                 concurrency::ThreadPool* threadpool,
+                                 const logging::Logger& logger,
+                                 int node_input_start_index)
+    : execution_frame_(frame),
+      kernel_(kernel),
+      threadpool_(threadpool),
+      logger_(&logger),
+      node_input_start_index_(node_input_start_index) {
+  node_implicit_input_start_index_ = node_input_start_index_ + InputCount();
+  node_output_start_index_ = node_implicit_input_start_index_ + ImplicitInputCount();
+}
+
 Tensor* OpKernelContext::Output(int index, const TensorShape& shape) {
   auto p_ml_value = OutputMLValue(index, shape);
   return p_ml_value ? p_ml_value->GetMutable<Tensor>() : nullptr;
@@ -25,15 +25,20 @@ class OpKernelContextInternal : public OpKernelContext {
       : OpKernelContext(&frame, &kernel, session_state.GetThreadPool(), logger),
         session_state_(session_state),
         terminate_flag_(terminate_flag) {
-    const auto& implicit_inputs = kernel.Node().ImplicitInputDefs();
-    int num_implicit_inputs = static_cast<int>(implicit_inputs.size());
-    implicit_input_values_.reserve(num_implicit_inputs);
+    InitImplicitInputs(kernel);
+  }
 
-    for (int i = 0; i < num_implicit_inputs; ++i) {
-      const auto* entry = GetImplicitInputMLValue(i);
-      ORT_ENFORCE(entry != nullptr, "All implicit inputs should have OrtValue instances by now. ",
-                  implicit_inputs[i]->Name(), " does not.");
-      implicit_input_values_.push_back(entry);
+  // with the index of the first argument of the node in the frame resolved by the session state
+  explicit OpKernelContextInternal(const SessionState& session_state,
+                                   IExecutionFrame& frame,
+                                   const SessionState::ExecutionStep& step,
+                                   const logging::Logger& logger,
+                                   const bool& terminate_flag)
+      : OpKernelContext(&frame, step.kernel, session_state.GetThreadPool(), logger, step.node_input_start_index),
+        session_state_(session_state),
+        terminate_flag_(terminate_flag) {
+    if (step.has_implicit_inputs) {
+      InitImplicitInputs(*step.kernel);
     }
   }
 
@@ -61,6 +66,19 @@ class OpKernelContextInternal : public OpKernelContext {
   const bool& GetTerminateFlag() const noexcept { return terminate_flag_; }
 
  private:
+  void InitImplicitInputs(const OpKernel& kernel) {
+    const auto& implicit_inputs = kernel.Node().ImplicitInputDefs();
+    int num_implicit_inputs = static_cast<int>(implicit_inputs.size());
+    implicit_input_values_.reserve(num_implicit_inputs);
+
+    for (int i = 0; i < num_implicit_inputs; ++i) {
+      const auto* entry = GetImplicitInputMLValue(i);
+      ORT_ENFORCE(entry != nullptr, "All implicit inputs should have OrtValue instances by now. ",
+                  implicit_inputs[i]->Name(), " does not.");
+      implicit_input_values_.push_back(entry);
+    }
+  }
+
   const SessionState& session_state_;
   const bool& terminate_flag_;
   std::vector<const OrtValue*> implicit_input_values_;
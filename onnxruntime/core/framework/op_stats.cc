@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/op_stats.h"
+
+#include <algorithm>
+
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+
+namespace {
+
+const Tensor* GetTensor(const OrtValue* value) {
+  return value != nullptr && value->IsAllocated() && value->IsTensor() ? &value->Get<Tensor>() : nullptr;
+}
+
+int64_t TensorBytes(const OrtValue* value) {
+  const Tensor* tensor = GetTensor(value);
+  return tensor != nullptr ? static_cast<int64_t>(tensor->SizeInBytes()) : 0;
+}
+
+void AtomicMin(std::atomic<int64_t>& target, int64_t value) {
+  int64_t current = target.load(std::memory_order_relaxed);
+  while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+void AtomicMax(std::atomic<int64_t>& target, int64_t value) {
+  int64_t current = target.load(std::memory_order_relaxed);
+  while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+void OpStatsCollector::AddNode(const Node& node) {
+  if (node_counters_.find(&node) != node_counters_.end()) {
+    return;
+  }
+
+  auto counters = onnxruntime::make_unique<Counters>();
+  counters->name = node.Name();
+  counters->op_type = node.OpType();
+  node_counters_[&node] = counters.get();
+  counters_.push_back(std::move(counters));
+}
+
+void OpStatsCollector::RecordCall(const OpKernel& kernel, int64_t time_ns, OpKernelContextInternal& context) {
+  const Node& node = kernel.Node();
+  auto entry = node_counters_.find(&node);
+  ORT_ENFORCE(entry != node_counters_.end(), "Node ", node.Name(), " wasn't added to the op stats.");
+  Counters& counters = *entry->second;
+
+  int64_t bytes_read = 0;
+  for (int i = 0; i < context.InputCount(); ++i) {
+    bytes_read += TensorBytes(context.GetInputMLValue(i));
+  }
+  int64_t bytes_written = 0;
+  for (int i = 0; i < context.OutputCount(); ++i) {
+    bytes_written += TensorBytes(context.GetOutputMLValue(i));
+  }
+
+  const int64_t time_us = time_ns / 1000;
+  int bucket = 0;
+  while (bucket < kNumTimeBuckets - 1 && (int64_t{1} << bucket) <= time_us) {
+    ++bucket;
+  }
+
+  counters.num_calls.fetch_add(1, std::memory_order_relaxed);
+  counters.total_time_ns.fetch_add(time_ns, std::memory_order_relaxed);
+  AtomicMin(counters.min_time_ns, time_ns);
+  AtomicMax(counters.max_time_ns, time_ns);
+  counters.bytes_read.fetch_add(bytes_read, std::memory_order_relaxed);
+  counters.bytes_written.fetch_add(bytes_written, std::memory_order_relaxed);
+  KernelCost cost;
+  if (kernel.GetCost(context, cost)) {
+    counters.flops.fetch_add(cost.flops, std::memory_order_relaxed);
+  }
+  counters.time_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void OpStatsCollector::Accumulate(const Counters& counters, OpStats& stats, int64_t& min_time_ns,
+                                  int64_t& max_time_ns, std::vector<int64_t>& histogram) {
+  stats.num_calls += counters.num_calls.load(std::memory_order_relaxed);
+  stats.total_time_us += counters.total_time_ns.load(std::memory_order_relaxed);
+  min_time_ns = std::min(min_time_ns, counters.min_time_ns.load(std::memory_order_relaxed));
+  max_time_ns = std::max(max_time_ns, counters.max_time_ns.load(std::memory_order_relaxed));
+  stats.bytes_read += counters.bytes_read.load(std::memory_order_relaxed);
+  stats.bytes_written += counters.bytes_written.load(std::memory_order_relaxed);
+  stats.flops += counters.flops.load(std::memory_order_relaxed);
+  for (int b = 0; b < kNumTimeBuckets; ++b) {
+    histogram[b] += counters.time_buckets[b].load(std::memory_order_relaxed);
+  }
+}
+
+std::vector<OpStats> OpStatsCollector::GetStats(bool by_op_type) const {
+  std::vector<OpStats> stats;
+  // total_time_us holds nanoseconds until the end
+  std::vector<int64_t> min_times_ns;
+  std::vector<int64_t> max_times_ns;
+  std::vector<std::vector<int64_t>> histograms;
+  std::unordered_map<std::string, size_t> op_type_entries;
+
+  for (const auto& counters : counters_) {
+    size_t entry = stats.size();
+    if (by_op_type) {
+      entry = op_type_entries.emplace(counters->op_type, stats.size()).first->second;
+    }
+    if (entry == stats.size()) {
+      stats.emplace_back();
+      stats.back().name = by_op_type ? counters->op_type : counters->name;
+      stats.back().op_type = counters->op_type;
+      min_times_ns.push_back(INT64_MAX);
+      max_times_ns.push_back(0);
+      histograms.emplace_back(kNumTimeBuckets, 0);
+    }
+    Accumulate(*counters, stats[entry], min_times_ns[entry], max_times_ns[entry], histograms[entry]);
+  }
+
+  for (size_t i = 0; i < stats.size(); ++i) {
+    OpStats& entry = stats[i];
+    entry.total_time_us /= 1000;
+    if (entry.num_calls == 0) {
+      continue;
+    }
+
+    entry.min_time_us = min_times_ns[i] / 1000;
+    entry.max_time_us = max_times_ns[i] / 1000;
+
+    // the first bucket reaching 99% of the calls
+    const int64_t p99_calls = entry.num_calls - entry.num_calls / 100;
+    int64_t calls = 0;
+    int bucket = 0;
+    while (bucket < kNumTimeBuckets - 1 && (calls += histograms[i][bucket]) < p99_calls) {
+      ++bucket;
+    }
+    entry.p99_time_us = std::min(int64_t{1} << bucket, entry.max_time_us);
+  }
+
+  return stats;
+}
+
+}  // namespace onnxruntime
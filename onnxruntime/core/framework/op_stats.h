@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+class Node;
+class OpKernel;
+class OpKernelContextInternal;
+
+/**
+ * Cumulative counters of the calls to the kernel of a node, or to the kernels of all the nodes of an op type,
+ * see InferenceSession::GetOpStats.
+ */
+struct OpStats {
+  std::string name;  // name of the node, or the op type for the totals of an op type
+  std::string op_type;
+  int64_t num_calls = 0;
+  int64_t total_time_us = 0;
+  int64_t min_time_us = 0;
+  int64_t max_time_us = 0;
+  // upper bound of the power of two bucket of microseconds holding the 99th percentile of the calls, capped by the max
+  int64_t p99_time_us = 0;
+  // bytes of the input and output tensors of the calls
+  int64_t bytes_read = 0;
+  int64_t bytes_written = 0;
+  // operations estimated from the shapes by the kernels with a cost model, see OpKernel::GetCost. 0 for the others.
+  int64_t flops = 0;
+};
+
+/**
+ * Collects OpStats for the nodes of a session and of its subgraphs. The nodes are added while the kernels are
+ * created, then the executors record the calls concurrently: each node has its own atomic counters, so the threads
+ * of the parallel executor don't contend on a lock.
+ */
+class OpStatsCollector {
+ public:
+  OpStatsCollector() = default;
+
+  // Not thread-safe: all the nodes are added before the first run.
+  void AddNode(const Node& node);
+
+  // Records a call to kernel which took time_ns, reading the sizes of the inputs and outputs of the context. The node
+  // of the kernel must have been added.
+  void RecordCall(const OpKernel& kernel, int64_t time_ns, OpKernelContextInternal& context);
+
+  // The counters per node in the order the nodes were added, or summed per op type in the order of the first node
+  // of each op type. Nodes which didn't run yet are included with num_calls 0.
+  std::vector<OpStats> GetStats(bool by_op_type) const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OpStatsCollector);
+
+  static constexpr int kNumTimeBuckets = 32;
+
+  struct Counters {
+    std::string name;
+    std::string op_type;
+    std::atomic<int64_t> num_calls{0};
+    std::atomic<int64_t> total_time_ns{0};
+    std::atomic<int64_t> min_time_ns{INT64_MAX};
+    std::atomic<int64_t> max_time_ns{0};
+    std::atomic<int64_t> bytes_read{0};
+    std::atomic<int64_t> bytes_written{0};
+    std::atomic<int64_t> flops{0};
+    // bucket b counts the calls of less than 2^b microseconds, and of at least 2^(b - 1) for b > 0
+    std::atomic<int64_t> time_buckets[kNumTimeBuckets] = {};
+  };
+
+  // sums the counters into stats, keeping the maximum, the minimum and the histogram in histogram
+  static void Accumulate(const Counters& counters, OpStats& stats, int64_t& min_time_ns, int64_t& max_time_ns,
+                         std::vector<int64_t>& histogram);
+
+  std::vector<std::unique_ptr<Counters>> counters_;
+  std::unordered_map<const Node*, Counters*> node_counters_;
+};
+
+}  // namespace onnxruntime
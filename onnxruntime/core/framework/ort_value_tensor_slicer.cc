@@ -67,19 +67,25 @@ OrtValueTensorSlicer<T>::Iterator::Iterator(T& ort_value, size_t slice_dimension
 template <typename T>
 void OrtValueTensorSlicer<T>::Iterator::MaterializeMLValue() const {
   position_materialized_ = position_;
-  const void* tensor_slice_data_raw = static_cast<const char*>(tensor_data_raw_) + (position_ * per_iteration_offset_);
+  const ptrdiff_t byte_offset = static_cast<ptrdiff_t>(position_ * per_iteration_offset_);
 
-  // create a sub Tensor for the current position, and put it in an OrtValue.
+  // if nothing else holds the sub-Tensor of the previous position, e.g. the feeds of a previous subgraph execution,
+  // move it to the current position instead of creating a new Tensor and OrtValue for every position.
+  if (current_.IsAllocated() && !current_.IsShared()) {
+    current_.template GetMutable<Tensor>()->SetByteOffset(byte_offset);
+    return;
+  }
+
+  // create a sub Tensor for the start of the section to slice, offset to the current position, and put it in an
+  // OrtValue.
   //
   // We need the non-const data pointer from the Tensor in order to create the sub-Tensors as we iterate,
   // so a const_cast is required.
   // However we will only return a non-const OrtValue from operator* if OrtValueTensorSlicer was created with
   // a non-const OrtValue, so externally we maintain constness as expected.
-  //
-  // TODO: Ideally we could avoid the overhead of creating a new Tensor (mainly cost of copying type and shape info)
-  // and would simply update Tensor::p_data_ given all other info remains constant for each slice.
   auto sub_tensor = onnxruntime::make_unique<Tensor>(tensor_data_type_, per_iteration_shape_,
-                                                     const_cast<void*>(tensor_slice_data_raw), *tensor_location_);
+                                                     const_cast<void*>(tensor_data_raw_), *tensor_location_);
+  sub_tensor->SetByteOffset(byte_offset);
   auto ml_tensor = DataTypeImpl::GetType<Tensor>();
   current_ = OrtValue{sub_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc()};
 }
@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/packed_strings.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+
+PackedStrings::PackedStrings(AllocatorPtr allocator, size_t num_strings_hint, size_t num_bytes_hint)
+    : allocator_(std::move(allocator)) {
+  ORT_ENFORCE(allocator_ != nullptr, "PackedStrings requires an allocator");
+  if (num_strings_hint > 0) {
+    Grow(ends_, ends_capacity_, 0, num_strings_hint);
+  }
+  if (num_bytes_hint > 0) {
+    Grow(bytes_, bytes_capacity_, 0, num_bytes_hint);
+  }
+}
+
+template <typename T>
+void PackedStrings::Grow(IAllocatorUniquePtr<T>& buffer, size_t& capacity, size_t size, size_t required) {
+  // double the capacity so the appends are amortized constant time
+  const size_t new_capacity = std::max(required, std::max<size_t>(capacity * 2, 16));
+  auto new_buffer = IAllocator::MakeUniquePtr<T>(allocator_, new_capacity);
+  ORT_ENFORCE(new_buffer != nullptr, "Failed to allocate ", new_capacity, " elements for the packed strings");
+  if (size > 0) {
+    memcpy(new_buffer.get(), buffer.get(), size * sizeof(T));
+  }
+  buffer = std::move(new_buffer);
+  capacity = new_capacity;
+}
+
+void PackedStrings::Append(const char* data, size_t size) {
+  if (num_strings_ == ends_capacity_) {
+    Grow(ends_, ends_capacity_, num_strings_, num_strings_ + 1);
+  }
+  if (num_bytes_ + size > bytes_capacity_) {
+    Grow(bytes_, bytes_capacity_, num_bytes_, num_bytes_ + size);
+  }
+  if (size > 0) {
+    memcpy(bytes_.get() + num_bytes_, data, size);
+  }
+  num_bytes_ += size;
+  ends_.get()[num_strings_++] = num_bytes_;
+}
+
+void PackedStrings::AppendTensor(const Tensor& tensor) {
+  ORT_ENFORCE(tensor.IsDataTypeString(), "PackedStrings can only hold the elements of string tensors");
+  const auto* strings = tensor.Data<std::string>();
+  const auto num_strings = static_cast<size_t>(tensor.Shape().Size());
+  size_t num_bytes = 0;
+  for (size_t i = 0; i < num_strings; ++i) {
+    num_bytes += strings[i].size();
+  }
+  if (num_strings_ + num_strings > ends_capacity_) {
+    Grow(ends_, ends_capacity_, num_strings_, num_strings_ + num_strings);
+  }
+  if (num_bytes_ + num_bytes > bytes_capacity_) {
+    Grow(bytes_, bytes_capacity_, num_bytes_, num_bytes_ + num_bytes);
+  }
+  for (size_t i = 0; i < num_strings; ++i) {
+    Append(strings[i].data(), strings[i].size());
+  }
+}
+
+Status PackedStrings::CopyTo(Tensor& tensor) const {
+  ORT_RETURN_IF_NOT(tensor.IsDataTypeString(), "PackedStrings can only be copied to a string tensor");
+  ORT_RETURN_IF_NOT(static_cast<size_t>(tensor.Shape().Size()) == num_strings_, "The tensor has ",
+                    tensor.Shape().Size(), " elements but there are ", num_strings_, " strings");
+  auto* strings = tensor.MutableData<std::string>();
+  for (size_t i = 0; i < num_strings_; ++i) {
+    const auto s = (*this)[i];
+    strings[i].assign(s.data(), s.size());
+  }
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
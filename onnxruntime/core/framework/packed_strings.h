@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstring>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+// Contiguous storage of a sequence of strings: their bytes back to back in one buffer and their end offsets in a
+// second one, both allocated from an allocator, e.g. the temp space allocator of a kernel. Kernels producing many
+// strings, such as tokens, build them here instead of allocating a std::string for each of them, and copy them into
+// their string output at the end.
+class PackedStrings {
+ public:
+  // Read-only view of a string of a PackedStrings or of a std::string. Views of a PackedStrings are invalidated by
+  // Append and Clear.
+  class View {
+   public:
+    View() = default;
+    View(const char* data, size_t size) : data_(data), size_(size) {}
+    View(const std::string& s) : data_(s.data()), size_(s.size()) {}  // NOLINT(runtime/explicit)
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    std::string ToString() const { return std::string(data_, size_); }
+
+    bool operator==(const View& other) const {
+      return size_ == other.size_ && (size_ == 0 || memcmp(data_, other.data_, size_) == 0);
+    }
+    bool operator!=(const View& other) const { return !(*this == other); }
+
+   private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+  };
+
+  // The hints size the buffers, which grow as needed.
+  explicit PackedStrings(AllocatorPtr allocator, size_t num_strings_hint = 0, size_t num_bytes_hint = 0);
+
+  void Append(const char* data, size_t size);
+  void Append(View s) { Append(s.data(), s.size()); }
+
+  // Appends the elements of a string tensor.
+  void AppendTensor(const Tensor& tensor);
+
+  size_t Size() const { return num_strings_; }
+  size_t NumBytes() const { return num_bytes_; }
+
+  View operator[](size_t i) const {
+    const size_t begin = i == 0 ? 0 : ends_.get()[i - 1];
+    return View(bytes_.get() + begin, ends_.get()[i] - begin);
+  }
+
+  // Removes the strings, keeping the buffers.
+  void Clear() {
+    num_strings_ = 0;
+    num_bytes_ = 0;
+  }
+
+  // Copies the strings to the elements of a string tensor with Size() elements.
+  Status CopyTo(Tensor& tensor) const;
+
+ private:
+  ORT_DISALLOW_COPY_AND_ASSIGNMENT(PackedStrings);
+
+  template <typename T>
+  void Grow(IAllocatorUniquePtr<T>& buffer, size_t& capacity, size_t size, size_t required);
+
+  AllocatorPtr allocator_;
+  IAllocatorUniquePtr<char> bytes_;
+  size_t bytes_capacity_ = 0;
+  size_t num_bytes_ = 0;
+  IAllocatorUniquePtr<size_t> ends_;
+  size_t ends_capacity_ = 0;
+  size_t num_strings_ = 0;
+};
+
+}  // namespace onnxruntime
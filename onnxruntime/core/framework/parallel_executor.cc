@@ -3,6 +3,7 @@
 
 #include "core/framework/parallel_executor.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <thread>
@@ -11,6 +12,7 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
+#include "core/framework/kernel_cost.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/utils.h"
@@ -21,9 +23,9 @@ namespace onnxruntime {
 ParallelExecutor::ParallelExecutor(const SessionState& session_state, const bool& terminate_flag)
     : out_standings_(0), terminate_flag_(terminate_flag), executor_pool_(session_state.GetInterOpThreadPool()) {
   auto graph_viewer = session_state.GetGraphViewer();
-  node_refs_.resize(graph_viewer->MaxNodeIndex());
+  node_refs_ = onnxruntime::make_unique<std::atomic<size_t>[]>(graph_viewer->MaxNodeIndex());
   for (auto& node : graph_viewer->Nodes()) {
-    node_refs_[node.Index()] = node.GetInputEdgesCount();
+    node_refs_[node.Index()].store(node.GetInputEdgesCount(), std::memory_order_relaxed);
   }
 }
 
@@ -33,27 +35,40 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
                                  const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
                                  const logging::Logger& logger) {
   TimePoint tp;
-  const bool is_profiler_enabled = session_state.Profiler().IsEnabled();
+  is_profiler_enabled_ = session_state.Profiler().SampleExecution();
+  const bool is_profiler_enabled = is_profiler_enabled_;
   if (is_profiler_enabled) {
     tp = session_state.Profiler().StartTime();
   }
 
   root_frame_ = onnxruntime::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches,
                                                  fetch_allocators, session_state);
-  //std::cout << "start nodes:" << std::endl;
+  // schedule the root nodes in order of priority so the critical path starts first. the highest priority one is
+  // run on this thread rather than blocking it until the graph completes.
+  const SequentialExecutionPlan& exec_plan = *session_state.GetExecutionPlan();
+  std::vector<NodeIndex> root_nodes;
   for (auto node_index : session_state.GetGraphViewer()->GetRootNodes()) {
-    auto p_op_kernel = session_state.GetKernel(node_index);
-    if (!p_op_kernel)
-      continue;
+    if (session_state.GetKernel(node_index))
+      root_nodes.push_back(node_index);
+  }
+
+  std::stable_sort(root_nodes.begin(), root_nodes.end(), [&exec_plan](NodeIndex a, NodeIndex b) {
+    return exec_plan.NodePriority(a) > exec_plan.NodePriority(b);
+  });
 
-    //std::cout << "\t" << p_op_kernel->Node().Name() << std::endl;
-    EnqueueNode(node_index, session_state, logger);
+  if (!root_nodes.empty()) {
+    out_standings_.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 1; i < root_nodes.size(); ++i) {
+      EnqueueNode(root_nodes[i], session_state, logger);
+    }
+
+    RunNodeAndFinish(root_nodes.front(), session_state, logger);
   }
 
   // Wait for finish.
   {
     std::unique_lock<OrtMutex> lock(complete_mutex_);
-    while (out_standings_ > 0) complete_cv_.wait(lock);
+    while (out_standings_.load(std::memory_order_acquire) > 0) complete_cv_.wait(lock);
   }
 
   Status status = Status::OK();
@@ -81,7 +96,7 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
   ORT_RETURN_IF_ERROR(root_frame_->GetOutputs(fetches));
   VLOGS(logger, 1) << "Done execution.";
 
-  if (root_frame_->HasMemoryPatternPlanner()) {
+  if (root_frame_->ShouldUpdateMemoryPatterns()) {
     std::vector<std::reference_wrapper<const TensorShape>> input_shapes;
     bool all_tensors = true;
     for (const auto& feed : feeds) {
@@ -119,7 +134,9 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
   auto graph_viewer = session_state.GetGraphViewer();
   TimePoint sync_time_begin;
   TimePoint kernel_begin_time;
-  const bool f_profiler_enabled = session_state.Profiler().IsEnabled();
+  const bool f_profiler_enabled = is_profiler_enabled_;
+  OpStatsCollector* const op_stats = session_state.GetOpStatsCollector();
+  TimePoint compute_begin_time;
   const SequentialExecutionPlan& exec_plan = *session_state.GetExecutionPlan();
 
   // Avoid context switching if possible.
@@ -184,17 +201,24 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
                                                      {{"op_name", p_op_kernel->KernelDef().OpName()}});
 
       kernel_begin_time = session_state.Profiler().StartTime();
+      session_state.Profiler().StartDeviceCorrelation(node.Name());
     }
 
     // call compute on the kernel
     VLOGS(logger, 1) << "Computing kernel: " << node.Name();
 
     // Execute the kernel.
+    if (op_stats != nullptr) {
+      compute_begin_time = std::chrono::high_resolution_clock::now();
+    }
     try {
       status = p_op_kernel->Compute(&op_kernel_context);
     } catch (const std::exception& ex) {
       status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
     }
+    if (f_profiler_enabled) {
+      session_state.Profiler().EndDeviceCorrelation();
+    }
 
     if (!status.IsOK()) {
       std::ostringstream ss;
@@ -206,11 +230,21 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
       break;
     }
 
+    if (op_stats != nullptr) {
+      const auto compute_time = std::chrono::high_resolution_clock::now() - compute_begin_time;
+      op_stats->RecordCall(*p_op_kernel, std::chrono::duration_cast<std::chrono::nanoseconds>(compute_time).count(),
+                           op_kernel_context);
+    }
+
     if (f_profiler_enabled) {
-      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                     node.Name() + "_kernel_time",
-                                                     kernel_begin_time,
-                                                     {{"op_name", p_op_kernel->KernelDef().OpName()}, {"provider", p_op_kernel->KernelDef().Provider()}});
+      std::unordered_map<std::string, std::string> kernel_args{{"op_name", p_op_kernel->KernelDef().OpName()},
+                                                               {"provider", p_op_kernel->KernelDef().Provider()}};
+      if (!session_state.Profiler().IsSampling()) {
+        kernel_cost::AddProfilingArgs(*p_op_kernel, op_kernel_context, TimeDiffMicroSeconds(kernel_begin_time),
+                                      kernel_args);
+      }
+      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT, node.Name() + "_kernel_time",
+                                                     kernel_begin_time, std::move(kernel_args));
 
       sync_time_begin = session_state.Profiler().StartTime();
     }
@@ -250,25 +284,32 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
     keep_running = false;
 
     // Checking which output nodes ready for running.
+    // The thread that takes a node's count to zero owns running it. acq_rel ensures the outputs written by all
+    // the producers are visible to that thread.
     {
       auto begin = node.OutputEdgesBegin();
       auto end = node.OutputEdgesEnd();
+      size_t next_node_index = 0;
 
-      std::lock_guard<OrtMutex> lock(ref_mutex_);
       for (auto it = begin; it != end; it++) {
         auto idx = (*it).GetNode().Index();
-        if ((--node_refs_[idx]) == 0) {
+        if (node_refs_[idx].fetch_sub(1, std::memory_order_acq_rel) == 1) {
           if (!keep_running) {
-            node_index = idx;
+            // keep running one ready successor on this thread instead of going through the thread pool.
+            next_node_index = idx;
             keep_running = true;
+          } else if (exec_plan.NodePriority(idx) > exec_plan.NodePriority(next_node_index)) {
+            // prefer the successor on the critical path
+            EnqueueNode(next_node_index, session_state, logger);
+            next_node_index = idx;
           } else {
             EnqueueNode(idx, session_state, logger);
           }
         }
+      }
 
-        // std::cout << "handle output, current name: " << node.Name() << ", current index: "
-        // << p_node_index << ", output name: " << (*it)->GetNode().Name() << ", output index: "
-        // << (*it)->GetNode().Index() << ", after -- output ref: " << node_refs_[idx] << std::endl;
+      if (keep_running) {
+        node_index = next_node_index;
       }
     }
   }
@@ -277,35 +318,39 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
 }
 
 void ParallelExecutor::EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger) {
-  {
-    std::unique_lock<OrtMutex> lock(complete_mutex_);
-    // if there are errors there's no point queuing more work
-    if (!errors_.empty())
-      return;
+  // if there are errors there's no point queuing more work
+  if (has_errors_.load(std::memory_order_relaxed))
+    return;
 
-    out_standings_++;
-  }
+  out_standings_.fetch_add(1, std::memory_order_relaxed);
 
+  // when called from a worker thread the Eigen pool pushes the task to that worker's own queue, where it can be
+  // stolen by idle workers, so there's no central queue to contend on.
   executor_pool_->Schedule([this, p_node_index, &session_state, &logger]() {
-    auto create_exception_message = [p_node_index, &session_state](const std::exception* ex) {
-      const auto* node = session_state.GetGraphViewer()->GetNode(p_node_index);
-
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exception running nodes starting at ", node->OpType(),
-                             " node '", node->Name(), "'. ",
-                             ex ? ex->what() : "Unknown exception was caught by catch-all handler.");
-    };
+    RunNodeAndFinish(p_node_index, session_state, logger);
+  });
+}
 
-    Status status;
-    try {
-      status = ParallelExecutor::RunNodeAsync(p_node_index, std::cref(session_state), std::cref(logger));
-    } catch (const std::exception& ex) {
-      status = create_exception_message(&ex);
-    } catch (...) {
-      // catch node processing failure exceptions here to prevent app crash.
-      status = create_exception_message(nullptr);
-    }
+void ParallelExecutor::RunNodeAndFinish(size_t p_node_index, const SessionState& session_state,
+                                        const logging::Logger& logger) {
+  auto create_exception_message = [p_node_index, &session_state](const std::exception* ex) {
+    const auto* node = session_state.GetGraphViewer()->GetNode(p_node_index);
+
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exception running nodes starting at ", node->OpType(),
+                           " node '", node->Name(), "'. ",
+                           ex ? ex->what() : "Unknown exception was caught by catch-all handler.");
+  };
+
+  Status status;
+  try {
+    status = ParallelExecutor::RunNodeAsync(p_node_index, std::cref(session_state), std::cref(logger));
+  } catch (const std::exception& ex) {
+    status = create_exception_message(&ex);
+  } catch (...) {
+    // catch node processing failure exceptions here to prevent app crash.
+    status = create_exception_message(nullptr);
+  }
 
-    FinishNodeRun(status);
-  });
+  FinishNodeRun(status);
 }
 }  // namespace onnxruntime
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <vector>
 #include "core/common/common.h"
 #include "core/common/status.h"
@@ -35,29 +37,34 @@ class ParallelExecutor : public IExecutor {
 
   void EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
 
+  // Run the node and the chain of successors that become ready on the current thread, then update out_standings_.
+  // The node must have been counted in out_standings_ already.
+  void RunNodeAndFinish(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
+
   void FinishNodeRun(const Status& status) {
-    bool finished = false;
-    {
-      //Because we have a mutex here, it's not possible another thread is doing the test("while (out_standings_ > 0)"
+    if (!status.IsOK()) {
       std::lock_guard<OrtMutex> lock(complete_mutex_);
-      finished = --out_standings_ == 0;
-      if (!status.IsOK())
-        errors_.push_back(status);
+      errors_.push_back(status);
+      has_errors_.store(true, std::memory_order_relaxed);
     }
 
-    if (finished) {
-      //std::cout << "all out standing nodes are completed." << std::endl;
+    if (out_standings_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      // take the lock so the notification can't be lost between the waiter checking out_standings_ and waiting
+      std::lock_guard<OrtMutex> lock(complete_mutex_);
       complete_cv_.notify_all();
     }
   }
 
   std::unique_ptr<ExecutionFrame> root_frame_;
-  std::vector<size_t> node_refs_;
-  OrtMutex ref_mutex_;
-  int out_standings_;  //protected by complete_mutex_
-  OrtMutex complete_mutex_;
+  // number of inputs edges of each node that are not yet satisfied. a node is ready once it reaches zero.
+  std::unique_ptr<std::atomic<size_t>[]> node_refs_;
+  std::atomic<int> out_standings_;
+  std::atomic<bool> has_errors_{false};
+  OrtMutex complete_mutex_;  // protects errors_ and is used with complete_cv_
   OrtCondVar complete_cv_;
   std::vector<Status> errors_;
+  // whether this execution records profile events, decided once when it starts
+  bool is_profiler_enabled_{false};
 
   const bool& terminate_flag_;
   // TODO: Temporary threadpool for the executor.  This is a costly way to handle the problem.
@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_container.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+
+PrepackedWeightsContainer::PrepackedWeightsContainer() : allocator_(std::make_shared<CPUAllocator>()) {}
+
+Status PrepackedWeightsContainer::GetOrPack(const std::string& key, const PackFn& pack,
+                                            std::shared_ptr<const PrePackedWeights>& weights) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = prepacked_weights_.find(key);
+  if (it != prepacked_weights_.end()) {
+    weights = it->second;
+    return Status::OK();
+  }
+
+  auto packed_weights = std::make_shared<PrePackedWeights>();
+  bool is_packed = false;
+  ORT_RETURN_IF_ERROR(pack(allocator_, is_packed, *packed_weights));
+  if (!is_packed) {
+    // the kernel doesn't pack the tensor, so don't remember anything. asking it again is cheap.
+    weights = nullptr;
+    return Status::OK();
+  }
+
+  weights = packed_weights;
+  prepacked_weights_[key] = std::move(packed_weights);
+  return Status::OK();
+}
+
+size_t PrepackedWeightsContainer::NumPrePackedWeights() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return prepacked_weights_.size();
+}
+
+// 64-bit FNV-1a over 8 byte words, which is fast enough to run over every weight of a model
+static uint64_t HashBytes(const void* data, size_t len) {
+  constexpr uint64_t kPrime = 1099511628211ULL;
+  uint64_t hash = 14695981039346656037ULL;
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes + i, sizeof(word));
+    hash = (hash ^ word) * kPrime;
+  }
+  for (; i < len; ++i) {
+    hash = (hash ^ bytes[i]) * kPrime;
+  }
+  return hash;
+}
+
+std::string PrepackedWeightsContainer::GenerateKey(const OpKernel& kernel, int input_idx, const Tensor& tensor) {
+  const auto& kernel_def = kernel.KernelDef();
+  std::ostringstream key;
+  key << kernel_def.Provider() << ':' << kernel_def.Domain() << ':' << kernel_def.OpName() << ':'
+      << kernel_def.SinceVersion().first << ':' << input_idx;
+
+  // attributes such as transB change the layout a kernel packs the tensor into
+  const auto& attributes = kernel.Node().GetAttributes();
+  std::vector<std::string> names;
+  names.reserve(attributes.size());
+  for (const auto& attribute : attributes) {
+    names.push_back(attribute.first);
+  }
+  std::sort(names.begin(), names.end());
+  for (const auto& name : names) {
+    const std::string value = attributes.at(name).SerializeAsString();
+    key << ':' << name << '=' << std::hex << HashBytes(value.data(), value.size()) << std::dec;
+  }
+
+  key << ':' << DataTypeImpl::ToString(tensor.DataType()) << ':' << tensor.Shape().ToString() << ':' << std::hex
+      << HashBytes(tensor.DataRaw(), tensor.SizeInBytes());
+  return key.str();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "core/framework/allocator.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+class OpKernel;
+class Tensor;
+
+// Store of the weights pre-packed by the kernels of the sessions sharing it, so the sessions loading the same model
+// pack each weight once and keep a single copy of it. The buffers are allocated from an allocator owned by the
+// store and are released when the store and every session using it are destroyed.
+class PrepackedWeightsContainer {
+ public:
+  PrepackedWeightsContainer();
+
+  // allocator for the packed buffers, which need to outlive the session that packed them
+  AllocatorPtr GetAllocator() const { return allocator_; }
+
+  // Returns the weights packed for 'key', calling 'pack' to create them if no kernel packed them yet.
+  // 'weights' is null if the kernel didn't pack the tensor.
+  using PackFn = std::function<Status(AllocatorPtr alloc, bool& is_packed, PrePackedWeights& weights)>;
+  Status GetOrPack(const std::string& key, const PackFn& pack, std::shared_ptr<const PrePackedWeights>& weights);
+
+  size_t NumPrePackedWeights() const;
+
+  // Creates the key for input 'input_idx' of 'kernel' holding 'tensor'. The key identifies the kernel, the node
+  // attributes that can change the packed layout, and the shape, type and content of the tensor.
+  static std::string GenerateKey(const OpKernel& kernel, int input_idx, const Tensor& tensor);
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsContainer);
+
+  AllocatorPtr allocator_;
+
+  // packing is done under the lock, so a weight is never packed twice by sessions initialized concurrently
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<const PrePackedWeights>> prepacked_weights_;
+};
+
+}  // namespace onnxruntime
@@ -53,3 +53,49 @@ ORT_API_STATUS_IMPL(OrtApis::RunOptionsUnsetTerminate, _Inout_ OrtRunOptions* op
   options->terminate = false;
   return nullptr;
 }
+
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsSetShrinkMemoryArenas, _Inout_ OrtRunOptions* options, int value) {
+  options->shrink_memory_arenas = value != 0;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsSetCollectRunStats, _Inout_ OrtRunOptions* options, int value) {
+  options->collect_run_stats = value != 0;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsGetRunStats, _In_ const OrtRunOptions* options,
+                    _Out_opt_ int64_t* num_allocations, _Out_opt_ int64_t* bytes_allocated, _Out_opt_ int64_t* peak_bytes, _Out_opt_ int64_t* bytes_copied,
+                    _Out_opt_ int64_t* execution_time_us, _Out_opt_ int64_t* copy_time_us,
+                    _Out_opt_ int64_t* memory_pattern_hit) {
+  const auto& stats = options->run_stats;
+  if (num_allocations != nullptr) *num_allocations = stats.num_allocations;
+  if (bytes_allocated != nullptr) *bytes_allocated = stats.bytes_allocated;
+  if (peak_bytes != nullptr) *peak_bytes = stats.peak_bytes;
+  if (bytes_copied != nullptr) *bytes_copied = stats.bytes_copied;
+  if (execution_time_us != nullptr) *execution_time_us = stats.execution_time_us;
+  if (copy_time_us != nullptr) *copy_time_us = stats.copy_time_us;
+  if (memory_pattern_hit != nullptr) *memory_pattern_hit = stats.num_memory_pattern_hits;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsSetComputeStream, _Inout_ OrtRunOptions* options, _In_opt_ void* stream) {
+  options->compute_stream = stream;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsSetStateStreamId, _Inout_ OrtRunOptions* options, int64_t stream_id) {
+  options->state_stream_id = stream_id < 0 ? -1 : stream_id;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsSetPriority, _Inout_ OrtRunOptions* options, int priority) {
+  options->priority = priority;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsSetDeadline, _Inout_ OrtRunOptions* options, int64_t timeout_ms) {
+  options->deadline = timeout_ms < 0 ? std::chrono::steady_clock::time_point::max()
+                                     : std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+  return nullptr;
+}
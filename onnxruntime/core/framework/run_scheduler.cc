@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/run_scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <map>
+
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+namespace {
+// the Run of the calling thread
+thread_local RunScheduler::ScopedRun* current_run = nullptr;
+
+// the Runs in progress which share the global thread pools
+struct SharedRuns {
+  OrtMutex mutex;
+  OrtCondVar run_ended;
+  std::map<int, int> num_runs_by_priority;
+  // read between the nodes without the mutex, INT_MIN while there is no Run
+  std::atomic<int> highest_priority{INT_MIN};
+};
+
+SharedRuns& GetSharedRuns() {
+  static SharedRuns shared_runs;
+  return shared_runs;
+}
+
+// how long a waiting Run sleeps at most before it checks its terminate flag and deadline again
+constexpr std::chrono::milliseconds kMaxWaitTime{10};
+}  // namespace
+
+RunScheduler::ScopedRun::ScopedRun(const RunOptions& run_options, bool shares_thread_pools)
+    : priority_(run_options.priority),
+      deadline_(run_options.deadline),
+      shares_thread_pools_(shares_thread_pools),
+      previous_(current_run) {
+  if (shares_thread_pools_) {
+    auto& shared_runs = GetSharedRuns();
+    std::lock_guard<OrtMutex> lock(shared_runs.mutex);
+    ++shared_runs.num_runs_by_priority[priority_];
+    shared_runs.highest_priority = shared_runs.num_runs_by_priority.rbegin()->first;
+  }
+  current_run = this;
+}
+
+RunScheduler::ScopedRun::~ScopedRun() {
+  current_run = previous_;
+  if (shares_thread_pools_) {
+    auto& shared_runs = GetSharedRuns();
+    {
+      std::lock_guard<OrtMutex> lock(shared_runs.mutex);
+      auto it = shared_runs.num_runs_by_priority.find(priority_);
+      if (--it->second == 0) {
+        shared_runs.num_runs_by_priority.erase(it);
+      }
+      shared_runs.highest_priority = shared_runs.num_runs_by_priority.empty()
+                                         ? INT_MIN
+                                         : shared_runs.num_runs_by_priority.rbegin()->first;
+    }
+    shared_runs.run_ended.notify_all();
+  }
+}
+
+common::Status RunScheduler::BeforeNode(const bool& terminate_flag) {
+  const ScopedRun* run = current_run;
+  if (run == nullptr) {
+    return Status::OK();
+  }
+
+  const bool has_deadline = run->deadline_ != std::chrono::steady_clock::time_point::max();
+  auto past_deadline = [run, has_deadline]() {
+    return has_deadline && std::chrono::steady_clock::now() >= run->deadline_;
+  };
+
+  auto& shared_runs = GetSharedRuns();
+  if (run->shares_thread_pools_ && shared_runs.highest_priority > run->priority_) {
+    std::unique_lock<OrtMutex> lock(shared_runs.mutex);
+    while (shared_runs.num_runs_by_priority.rbegin()->first > run->priority_ && !terminate_flag &&
+           !past_deadline()) {
+      auto wait_time = std::chrono::duration_cast<std::chrono::nanoseconds>(kMaxWaitTime);
+      if (has_deadline) {
+        wait_time = std::min(wait_time, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                            run->deadline_ - std::chrono::steady_clock::now()));
+      }
+      shared_runs.run_ended.wait_for(lock, wait_time);
+    }
+  }
+
+  if (past_deadline()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to the deadline of the Run being exceeded.");
+  }
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/framework/run_options.h"
+
+namespace onnxruntime {
+
+/**
+Orders the Run calls of the sessions sharing the global thread pools of the env by RunOptions::priority, and abandons
+the Run calls past their RunOptions::deadline.
+
+A Run is registered for the thread calling it by a RunScheduler::ScopedRun, and the SequentialExecutor calls
+BeforeNode between the nodes it executes on that thread, the ones of the subgraphs included. There a Run sharing the
+pools waits while a Run of a higher priority is in progress, so the pools go to the latter once the current node
+completes, and any Run fails once its deadline passed, like a Run whose terminate flag is set.
+*/
+class RunScheduler {
+ public:
+  class ScopedRun {
+   public:
+    // shares_thread_pools: whether the session of the Run uses the global thread pools. Only those Runs are ordered
+    // by priority.
+    ScopedRun(const RunOptions& run_options, bool shares_thread_pools);
+    ~ScopedRun();
+
+   private:
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ScopedRun);
+
+    friend class RunScheduler;
+    const int priority_;
+    const std::chrono::steady_clock::time_point deadline_;
+    const bool shares_thread_pools_;
+    ScopedRun* const previous_;  // the Run this one is nested in on the same thread, e.g. from a custom op
+  };
+
+  // Wait while a Run of a higher priority than the one of the calling thread is in progress, unless terminate_flag
+  // gets set. Returns a FAIL status once the deadline of the Run passed. A nop on threads without a Run.
+  static common::Status BeforeNode(const bool& terminate_flag);
+};
+
+}  // namespace onnxruntime
@@ -25,7 +25,7 @@ struct AllocPlanPerValue {
   AllocKind alloc_kind{AllocKind::kAllocate};
   MLDataType value_type{nullptr};
   OrtMemoryInfo location;
-  // reused_buffer is valid only if alloc_kind == kReuse. It indicates
+  // reused_buffer is valid only if alloc_kind == kReuse or kView. It indicates
   // which OrtValue's buffer must be reused for this OrtValue.
   OrtValueIndex reused_buffer{0};
   // if the value is used in async kernel, a fence object would be created
@@ -72,6 +72,10 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   // to_be_freed: vector elements represent indices of ml-values to be freed (as described above)
   std::vector<OrtValueIndex> to_be_freed;
 
+  // Length of the longest path from each node to a graph output, including the node itself, indexed by node index.
+  // Used by the parallel executor to run the nodes on the critical path first when several are ready.
+  std::vector<size_t> node_priority;
+
   const OrtMemoryInfo& GetLocation(size_t ort_value_index) const override {
     return allocation_plan[ort_value_index].location;
   }
@@ -92,6 +96,10 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   bool NodeHasFence(onnxruntime::NodeIndex node_index) const {
     return node_has_fence[node_index];
   }
+
+  size_t NodePriority(onnxruntime::NodeIndex node_index) const {
+    return node_index < node_priority.size() ? node_priority[node_index] : 0;
+  }
 };
 
 // Output details of an execution plan:
@@ -11,8 +11,10 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
+#include "core/framework/kernel_cost.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/run_scheduler.h"
 #include "core/framework/utils.h"
 
 // Define this symbol to create Concurrency Visualizer markers.
@@ -25,9 +27,9 @@
 using namespace Concurrency;
 #endif
 
-#ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
-#include <Windows.h>
 #include "core/platform/tracing.h"
+
+#if defined(ONNXRUNTIME_ENABLE_INSTRUMENT) && defined(_WIN32)
 namespace {
 LARGE_INTEGER OrtGetPerformanceFrequency() {
   LARGE_INTEGER v;
@@ -44,8 +46,7 @@ LARGE_INTEGER perf_freq = OrtGetPerformanceFrequency();
 namespace onnxruntime {
 
 static Status ReleaseNodeMLValues(ExecutionFrame& frame,
-                                  const SequentialExecutionPlan& seq_exec_plan,
-                                  const SequentialExecutionPlan::NodeExecutionPlan& node_exec_plan,
+                                  const SessionState::ExecutionStep& step,
                                   const logging::Logger& logger);
 
 Status SequentialExecutor::Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
@@ -53,27 +54,43 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
                                    std::vector<OrtValue>& fetches,
                                    const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
                                    const logging::Logger& logger) {
-  const bool is_profiler_enabled = session_state.Profiler().IsEnabled();
+  // decided once per run. the profiler isn't touched by the node loop unless it is set.
+  profiling::Profiler* const profiler =
+      session_state.Profiler().SampleExecution() ? &session_state.Profiler() : nullptr;
+  const bool is_profiler_enabled = profiler != nullptr;
   TimePoint tp;
   TimePoint sync_time_begin;
   TimePoint kernel_begin_time;
+  OpStatsCollector* const op_stats = session_state.GetOpStatsCollector();
+  TimePoint compute_begin_time;
 
   if (is_profiler_enabled) {
-    tp = session_state.Profiler().StartTime();
+    tp = profiler->StartTime();
   }
 
-  ExecutionFrame frame{feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators, session_state};
+  // a frame of a previous run is reused if there's one idle. it goes back to the pool when the run ends.
+  auto frame_handle = session_state.GetExecutionFramePool().Acquire(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs,
+                                                                    fetches, fetch_allocators, session_state);
+  ExecutionFrame& frame = *frame_handle;
+  if (run_stats_ != nullptr) {
+    frame.EnableRunStats();
+  }
 
   LOGS(logger, INFO) << "Begin execution";
   const SequentialExecutionPlan& seq_exec_plan = *session_state.GetExecutionPlan();
-  const auto& exec_plan_vec = seq_exec_plan.execution_plan;
-  VLOGS(logger, 1) << "Size of execution plan vector: " << exec_plan_vec.size();
+  const auto& steps = session_state.GetExecutionSteps();
+  const auto& step_event_names = session_state.GetExecutionStepEventNames();
+  if (steps.size() != seq_exec_plan.execution_plan.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The kernels of the ", seq_exec_plan.execution_plan.size(),
+                           " nodes of the execution plan were not created.");
+  }
+  VLOGS(logger, 1) << "Size of execution plan vector: " << steps.size();
 
   // uncomment the line below to dump execution plan
   //std::cout << std::make_pair(p_seq_exec_plan, &session_state) << "\n";
-  const auto* graph_viewer = session_state.GetGraphViewer();
 
 #ifdef CONCURRENCY_VISUALIZER
+  const auto* graph_viewer = session_state.GetGraphViewer();
   // need unique name for the series. number of nodes should be good enough for a subgraph
   char series_name[MaxSeriesNameLengthInChars] = "MainGraph";
   if (graph_viewer->IsSubgraph()) {
@@ -84,40 +101,46 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
   diagnostic::marker_series series(series_name);
 #endif
 
-  for (const auto& node_exec_plan : exec_plan_vec) {
+  for (size_t step_index = 0; step_index < steps.size(); ++step_index) {
+    // leaves the thread pools to the Runs of a higher priority, and stops past the deadline of the Run
+    ORT_RETURN_IF_ERROR(RunScheduler::BeforeNode(terminate_flag_));
     if (terminate_flag_) {
       LOGS(logger, WARNING) << "Exiting due to terminate flag being set to true.";
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
     }
 
-    auto node_index = node_exec_plan.node_index;
-    const auto& node = *graph_viewer->GetNode(node_exec_plan.node_index);
+    const auto& step = steps[step_index];
+    const auto& node = *step.node;
 
 #ifdef CONCURRENCY_VISUALIZER
     series.write_flag(node.Name().c_str());
 #endif
 
-    auto p_op_kernel = session_state.GetKernel(node_index);
+    const OpKernel* p_op_kernel = step.kernel;
 
     // if a kernel has been added in the session state, it better be NON-null.
     if (p_op_kernel == nullptr)
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for node: ",
                              node.Name());
-#ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
+#if defined(ONNXRUNTIME_ENABLE_INSTRUMENT) && defined(_WIN32)
+    // the OpEnd events are read by tool/etw
+    const bool write_op_end = TraceLoggingProviderEnabled(telemetry_provider_handle, 0, 0);
     LARGE_INTEGER kernel_start;
-    QueryPerformanceCounter(&kernel_start);
+    if (write_op_end) {
+      QueryPerformanceCounter(&kernel_start);
+    }
 #endif
     // construct OpKernelContext
     // TODO: log kernel inputs?
-    OpKernelContextInternal op_kernel_context(session_state, frame, *p_op_kernel, logger, terminate_flag_);
+    OpKernelContextInternal op_kernel_context(session_state, frame, step, logger, terminate_flag_);
     // TODO: log kernel outputs?
     if (is_profiler_enabled) {
-      sync_time_begin = session_state.Profiler().StartTime();
+      sync_time_begin = profiler->StartTime();
     }
 
     // sync before compute
     int queue_id = p_op_kernel->KernelDef().ExecQueueId();
-    if (seq_exec_plan.NodeHasFence(node_index)) {
+    if (step.has_fence) {
       for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
         Fence_t fence = op_kernel_context.InputFence(input_index);
         if (fence) {
@@ -152,28 +175,35 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
 #endif
 
     if (is_profiler_enabled) {
-      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                     p_op_kernel->Node().Name() + "_fence_before",
-                                                     sync_time_begin,
-                                                     {{"op_name", p_op_kernel->KernelDef().OpName()}});
+      profiler->EndTimeAndRecordEvent(profiling::NODE_EVENT, step_event_names[step_index].fence_before,
+                                      sync_time_begin, {{"op_name", p_op_kernel->KernelDef().OpName()}});
 
-      // call compute on the kernel
-      VLOGS(logger, 1) << "Computing kernel: " << p_op_kernel->Node().Name();
-
-      kernel_begin_time = session_state.Profiler().StartTime();
+      kernel_begin_time = profiler->StartTime();
+      profiler->StartDeviceCorrelation(node.Name());
     }
 
+    // call compute on the kernel
+    VLOGS(logger, 1) << "Computing kernel: " << node.Name();
+
 #ifdef CONCURRENCY_VISUALIZER
     {
       diagnostic::span span(series, "%s.%d", node.OpType().c_str(), node.Index());
 #endif
       Status compute_status;
 
+      if (op_stats != nullptr) {
+        compute_begin_time = std::chrono::high_resolution_clock::now();
+      }
+      ORT_TRACE_NODE_START(node.Name().c_str(), node.OpType().c_str(), node.GetExecutionProviderType().c_str());
       try {
         compute_status = p_op_kernel->Compute(&op_kernel_context);
       } catch (const std::exception& ex) {
         compute_status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
       }
+      ORT_TRACE_NODE_STOP(node.Name().c_str(), node.OpType().c_str(), node.GetExecutionProviderType().c_str());
+      if (is_profiler_enabled) {
+        profiler->EndDeviceCorrelation();
+      }
 
       if (!compute_status.IsOK()) {
         std::ostringstream ss;
@@ -184,21 +214,31 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
         return Status(compute_status.Category(), compute_status.Code(), msg_string);
       }
 
+      if (op_stats != nullptr) {
+        const auto compute_time = std::chrono::high_resolution_clock::now() - compute_begin_time;
+        op_stats->RecordCall(*p_op_kernel, std::chrono::duration_cast<std::chrono::nanoseconds>(compute_time).count(),
+                             op_kernel_context);
+      }
+
 #ifdef CONCURRENCY_VISUALIZER
     }
 #endif
 
     if (is_profiler_enabled) {
-      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                     p_op_kernel->Node().Name() + "_kernel_time",
-                                                     kernel_begin_time,
-                                                     {{"op_name", p_op_kernel->KernelDef().OpName()}, {"provider", p_op_kernel->KernelDef().Provider()}});
+      std::unordered_map<std::string, std::string> kernel_args{{"op_name", p_op_kernel->KernelDef().OpName()},
+                                                               {"provider", p_op_kernel->KernelDef().Provider()}};
+      if (!profiler->IsSampling()) {
+        kernel_cost::AddProfilingArgs(*p_op_kernel, op_kernel_context, TimeDiffMicroSeconds(kernel_begin_time),
+                                      kernel_args);
+      }
+      profiler->EndTimeAndRecordEvent(profiling::NODE_EVENT, step_event_names[step_index].kernel_time,
+                                      kernel_begin_time, std::move(kernel_args));
 
-      sync_time_begin = session_state.Profiler().StartTime();
+      sync_time_begin = profiler->StartTime();
     }
 
     // sync after compute for outputs
-    if (seq_exec_plan.NodeHasFence(node_index)) {
+    if (step.has_fence) {
       for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
         Fence_t fence = op_kernel_context.InputFence(input_index);
         if (fence) {
@@ -220,24 +260,24 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
         }
       }
     }
-#ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
-    LARGE_INTEGER kernel_stop;
-    QueryPerformanceCounter(&kernel_stop);
-    LARGE_INTEGER elapsed;
-    elapsed.QuadPart = kernel_stop.QuadPart - kernel_start.QuadPart;
-    elapsed.QuadPart *= 1000000;
-    elapsed.QuadPart /= perf_freq.QuadPart;
-    // Log an event
-    TraceLoggingWrite(telemetry_provider_handle,  // handle to my provider
-                      "OpEnd",       // Event Name that should uniquely identify your event.
-                      TraceLoggingValue(p_op_kernel->KernelDef().OpName().c_str(), "op_name"),
-                      TraceLoggingValue(elapsed.QuadPart, "time"));
+#if defined(ONNXRUNTIME_ENABLE_INSTRUMENT) && defined(_WIN32)
+    if (write_op_end) {
+      LARGE_INTEGER kernel_stop;
+      QueryPerformanceCounter(&kernel_stop);
+      LARGE_INTEGER elapsed;
+      elapsed.QuadPart = kernel_stop.QuadPart - kernel_start.QuadPart;
+      elapsed.QuadPart *= 1000000;
+      elapsed.QuadPart /= perf_freq.QuadPart;
+      // Log an event
+      TraceLoggingWrite(telemetry_provider_handle,  // handle to my provider
+                        "OpEnd",                    // Event Name that should uniquely identify your event.
+                        TraceLoggingValue(p_op_kernel->KernelDef().OpName().c_str(), "op_name"),
+                        TraceLoggingValue(elapsed.QuadPart, "time"));
+    }
 #endif
     if (is_profiler_enabled) {
-      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                     p_op_kernel->Node().Name() + "_fence_after",
-                                                     sync_time_begin,
-                                                     {{"op_name", p_op_kernel->KernelDef().OpName()}});
+      profiler->EndTimeAndRecordEvent(profiling::NODE_EVENT, step_event_names[step_index].fence_after,
+                                      sync_time_begin, {{"op_name", p_op_kernel->KernelDef().OpName()}});
     }
 
 #if defined(DEBUG_NODE_INPUTS_OUTPUTS)
@@ -245,8 +285,8 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
 #endif
 
     // free ml-values corresponding to this node
-    VLOGS(logger, 1) << "Releasing node ML values after computing kernel: " << p_op_kernel->Node().Name();
-    ORT_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, node_exec_plan, logger));
+    VLOGS(logger, 1) << "Releasing node ML values after computing kernel: " << node.Name();
+    ORT_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, step, logger));
   }
 
   VLOGS(logger, 1) << "Fetching output.";
@@ -254,7 +294,7 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
   ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
   VLOGS(logger, 1) << "Done with execution.";
 
-  if (frame.HasMemoryPatternPlanner()) {
+  if (frame.ShouldUpdateMemoryPatterns()) {
     std::vector<std::reference_wrapper<const TensorShape>> input_shapes;
     bool all_tensors = true;
     for (const auto& feed : feeds) {
@@ -274,18 +314,21 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
   }
 
   if (is_profiler_enabled) {
-    session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", tp);
+    profiler->EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", tp);
+  }
+
+  if (run_stats_ != nullptr) {
+    frame.UpdateRunStats(*run_stats_);
   }
 
   return Status::OK();
 }
 
 static Status ReleaseNodeMLValues(ExecutionFrame& frame,
-                                  const SequentialExecutionPlan& seq_exec_plan,
-                                  const SequentialExecutionPlan::NodeExecutionPlan& node_exec_plan,
+                                  const SessionState::ExecutionStep& step,
                                   const logging::Logger& logger) {
-  for (auto i = node_exec_plan.free_from_index; i <= node_exec_plan.free_to_index; ++i) {
-    auto ort_value_idx = seq_exec_plan.to_be_freed[i];
+  for (const OrtValueIndex* it = step.release_begin; it != step.release_end; ++it) {
+    auto ort_value_idx = *it;
     VLOGS(logger, 1) << "Releasing ort_value with index: " << ort_value_idx;
     ORT_RETURN_IF_ERROR(frame.ReleaseMLValue(ort_value_idx));
   }
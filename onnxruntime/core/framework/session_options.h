@@ -4,14 +4,31 @@
 #pragma once
 
 #include <string>
+#include <utility>
 #include <vector>
 #include "core/session/onnxruntime_c_api.h"
 #include "core/optimizer/graph_transformer_level.h"
 
 namespace onnxruntime {
+enum class FreeDimensionOverrideType {
+  Denotation,  // the override applies to the free dimensions with this denotation, case insensitive
+  Name,        // the override applies to the free dimensions with this name (dim_param)
+};
+
 struct FreeDimensionOverride {
-  std::string dimension_denotation;
+  std::string dimension_identifier;
   int64_t dimension_override;
+  FreeDimensionOverrideType dimension_identifier_type = FreeDimensionOverrideType::Denotation;
+};
+
+// Throughputs and fixed costs the cost-based graph partitioning estimates the latency of the nodes with, see
+// SessionOptions::enable_cost_based_partitioning.
+struct PartitioningCostModel {
+  double host_gflops = 50.0;      // operations per second of the kernels on the host, in billions
+  double device_gflops = 2000.0;  // operations per second of the kernels on a device, in billions
+  double kernel_launch_us = 5.0;  // fixed cost of a kernel, or a fused subgraph, on a device
+  double copy_gbps = 10.0;        // bandwidth of the copies between the host and a device, in GB per second
+  double copy_latency_us = 10.0;  // fixed cost of a copy between the host and a device
 };
 
 /**
@@ -26,6 +43,12 @@ struct SessionOptions {
   // non empty filepath enables serialization of the transformed optimized model to the specified filepath.
   std::basic_string<ORTCHAR_T> optimized_model_filepath;
 
+  // non empty filepath enables a cache of the transformed and partitioned graph. if the file holds the graph of the
+  // same model created with the same options and execution providers, the graph transformations and partitioning
+  // are skipped. otherwise the file is (re)written once the session is initialized. the large initializers are kept
+  // in <file>.data, aligned so they are mapped in place rather than parsed and copied.
+  std::basic_string<ORTCHAR_T> session_state_cache_filepath;
+
   // enable the memory pattern optimization.
   // The idea is if the input shapes are the same, we could trace the internal memory allocation
   // and generate a memory pattern for future request. So next time we could just do one allocation
@@ -33,6 +56,13 @@ struct SessionOptions {
   // See class 'OrtValuePatternPlanner'.
   bool enable_mem_pattern = true;
 
+  // share memory patterns between inputs with different shapes by rounding the input dimensions up to buckets.
+  // a block of a cached pattern is re-used by any tensor that fits in it, and the cached pattern is regenerated
+  // if a larger shape in the same bucket needs more memory.
+  // dimensions are rounded up to the next power of two if mem_pattern_bucket_boundaries is empty.
+  bool enable_mem_pattern_bucketing = false;
+  std::vector<int64_t> mem_pattern_bucket_boundaries;
+
   // enable the memory arena on CPU
   // Arena may pre-allocate memory for future usage.
   // set this option to false if you don't want it.
@@ -41,6 +71,22 @@ struct SessionOptions {
   // the prefix of the profile file. The current time will be appended to the file name.
   std::basic_string<ORTCHAR_T> profile_file_prefix = ORT_TSTR("onnxruntime_profile_");
 
+  // If not 0 and enable_profiling is set, profiling runs in a sampling mode cheap enough to leave on: the node events
+  // of 1 in profiling_sampling_interval graph executions are aggregated into latency histograms per event, which
+  // InferenceSession::GetProfilingHistograms returns and the profile file holds, instead of being kept one by one.
+  // The threads record into their own buffers, which are merged at most every profiling_flush_interval_ms.
+  int profiling_sampling_interval = 0;
+  int profiling_flush_interval_ms = 1000;
+
+  // Collect cumulative counters per node and op type of the kernel calls (count, time, bytes of the tensors and
+  // estimated FLOPs), see InferenceSession::GetOpStats. Independent of profiling.
+  bool enable_op_stats = false;
+
+  // If enable_profiling is set and profiling isn't sampled, record every buffer the execution frames allocate and
+  // free for the values, with the value, its producer node and the state of the arena, as a memory timeline in the
+  // profile file.
+  bool enable_memory_profiling = false;
+
   std::string session_logid;  ///< logger id to use for session output
 
   /// Log severity for the inference session. Applies to session load, initialization, etc.
@@ -61,12 +107,94 @@ struct SessionOptions {
   // configuring this makes sense only when you're using parallel executor
   int inter_op_num_threads = 0;
 
+  // how long, in microseconds, a thread waiting for the other threads of a parallel loop spins before it blocks.
+  unsigned int thread_pool_spin_duration_us = 0;
+
+  // let idle worker threads spin for a while before they block waiting for new work.
+  bool allow_thread_pool_worker_spinning = true;
+
+  // logical processors the intra op and inter op worker threads are pinned to. empty leaves the placement to the OS.
+  std::vector<size_t> intra_op_thread_affinity;
+  std::vector<size_t> inter_op_thread_affinity;
+
+  // pins the worker threads of a pool without an explicit affinity to the processors of this NUMA node. -1 for none.
+  int thread_pool_numa_node = -1;
+
   // For models with free input dimensions (most commonly batch size), specifies a set of values to override those
-  // free dimensions with, keyed by dimension denotation.
+  // free dimensions with, keyed by dimension denotation or name.
   std::vector<FreeDimensionOverride> free_dimension_overrides;
 
+  // If not 0, the session keeps up to this many variants of its graph optimized for fixed values of the named free
+  // dimensions of the model inputs (such as batch and sequence length). A variant is created, with the free
+  // dimensions overridden, once a set of values has been seen in shape_specialization_min_runs calls to Run, and
+  // later calls with the same values run it. The other calls run the generic graph. Only used when the CPU
+  // execution provider is the only one registered.
+  int shape_specialization_max_variants = 0;
+  int shape_specialization_min_runs = 10;
+
   // By default the session uses its own set of threadpools, unless this is set to false.
   // Use this in conjunction with the CreateEnvWithGlobalThreadPools API.
   bool use_per_session_threads = true;
+
+  // By default each execution provider of the session creates its own allocators. If this is set to true,
+  // allocators registered on the env (see Environment::RegisterAllocator) are used in place of the provider
+  // allocators with the same OrtMemoryInfo, so multiple sessions share one arena.
+  bool use_env_allocators = false;
+
+  // By default the kernels pre-pack constant weights into the layout they compute with when the session is
+  // initialized (see OpKernel::PrePack), unless this is set to true.
+  bool disable_prepacking = false;
+
+  // If set to true, the weights pre-packed by the kernels are kept in the env (see
+  // Environment::GetPrepackedWeightsContainer) and shared by all the sessions with this option that load the same
+  // weights, so each one is packed and kept in memory once.
+  bool use_env_prepacked_weights = false;
+
+  // If set to true, the constant initializers in CPU memory are kept in the env (see
+  // Environment::GetSharedInitializerStore) and shared by all the sessions with this option that load initializers
+  // with the same content, so memory use grows with the number of distinct models rather than sessions.
+  bool use_env_shared_initializers = false;
+
+  // If set to true, the CPU kernels that autotune (such as Conv) measure their candidate algorithms and thread counts
+  // the first time they see a shape and keep the fastest. A non empty cpu_tuning_cache_filepath keeps the measured
+  // configurations in that file, keyed by the processor model, so later sessions on identical hosts reuse them.
+  bool enable_cpu_tuning = false;
+  std::basic_string<ORTCHAR_T> cpu_tuning_cache_filepath;
+
+  // If set to true, the sequential executor runs the nodes in an order chosen to lower the peak size of the
+  // intermediate tensors (estimated from their inferred shapes), if one is found, instead of the default topological
+  // order. This lets larger batches fit in the same memory, possibly at the cost of some locality.
+  bool enable_memory_efficient_execution_order = false;
+
+  // Pairs of (output name, input name) of the model that carry state from one Run to the next, such as the Y_h and
+  // initial_h of a streaming LSTM. A Run with RunOptions::state_stream_id set feeds the bound inputs it isn't given
+  // with the outputs of the previous Run of the same stream, which stay on the device that produced them.
+  std::vector<std::pair<std::string, std::string>> state_bindings;
+
+  // If not 0, the session caches the outputs of its Run calls, up to this many bytes, and returns copies of them
+  // when it's run again with the same inputs instead of running the graph. Only used if the graph has no random or
+  // custom ops, for runs on CPU tensors that don't pre-allocate their outputs. See RunResultCache.
+  size_t run_result_cache_max_bytes = 0;
+
+  // If set to true, the graph partitioning leaves on the CPU the groups of connected nodes an execution provider on
+  // another device claims when they are estimated to run faster on the CPU, counting the copies to and from the device,
+  // instead of assigning them greedily in the order of the providers. The estimates use the shapes inferred for the
+  // graph and partitioning_cost_model, and the groups with unknown shapes are assigned as usual.
+  bool enable_cost_based_partitioning = false;
+  PartitioningCostModel partitioning_cost_model;
+
+  // If set to true, a model loaded from a file is parsed without the raw data of its large initializers, which the
+  // initializers refer to in the file as external data (see Model::LoadReferencingInitializerData). The session state
+  // then maps them, or reads them one at a time, when it creates the initializers, so loading a model peaks at about
+  // its size in memory rather than a multiple of it. The model file has to stay unchanged while the session lives.
+  bool enable_lazy_initializer_loading = false;
+
+  // If set to true, the float nodes assigned to the CUDA execution provider whose op is in
+  // mixed_precision_allow_ops and not in mixed_precision_deny_ops compute in float16, with Casts inserted at the
+  // boundaries with the other nodes (see AutoMixedPrecisionTransformer). Empty lists stand for the default ones,
+  // which keep the numerically sensitive ops such as Softmax, the normalizations and the reductions in float.
+  bool enable_cuda_mixed_precision = false;
+  std::vector<std::string> mixed_precision_allow_ops;
+  std::vector<std::string> mixed_precision_deny_ops;
 };
 }  // namespace onnxruntime
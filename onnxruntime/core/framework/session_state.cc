@@ -3,6 +3,8 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 
 #include "core/common/logging/logging.h"
@@ -77,9 +79,34 @@ Status SessionState::CreateKernels(const KernelRegistryManager& custom_registry_
     }
     session_kernels_.clear();
     session_kernels_.resize(max_nodeid + 1, nullptr);
-    for (auto& node : graph_viewer_->Nodes()) {
-      // construct and save the kernels
+
+    // construct and save the kernels
+    auto create_kernel = [this, &custom_registry_manager](const Node& node,
+                                                          const IExecutionProvider& exec_provider) -> Status {
       std::unique_ptr<OpKernel> op_kernel;
+      common::Status status = custom_registry_manager.CreateKernel(node, exec_provider, *this, op_kernel);
+      if (!status.IsOK()) {
+        return common::Status(
+            status.Category(), status.Code(),
+            MakeString("Kernel creation failed for node: ", node.Name(), " with error: ", status.ErrorMessage()));
+      }
+      assert(session_kernels_[node.Index()] == nullptr);
+      // assumes vector is already resize()'ed to the number of nodes in the graph
+      session_kernels_[node.Index()] = op_kernel.release();
+      return Status::OK();
+    };
+
+    // the built-in CPU kernels only read the session state in their constructors, so they are created in parallel.
+    // kernels of other providers may compile or register resources with the provider, and fused nodes and custom
+    // kernels may not be safe to construct concurrently, so those are created one at a time.
+    const bool create_cpu_kernels_in_parallel =
+        thread_pool_ != nullptr && !custom_registry_manager.HasCustomKernelRegistries();
+    std::vector<const Node*> cpu_nodes;
+    for (auto& node : graph_viewer_->Nodes()) {
+      if (op_stats_ != nullptr) {
+        op_stats_->AddNode(node);
+      }
+
       onnxruntime::ProviderType exec_provider_name = node.GetExecutionProviderType();
 
       const IExecutionProvider* exec_provider = nullptr;
@@ -88,23 +115,114 @@ Status SessionState::CreateKernels(const KernelRegistryManager& custom_registry_
                                " as there's no execution provider allocated.");
       }
 
-      common::Status status = custom_registry_manager.CreateKernel(node, *exec_provider, *this, op_kernel);
-      if (!status.IsOK()) {
-        return common::Status(
-            status.Category(), status.Code(),
-            MakeString("Kernel creation failed for node: ", node.Name(), " with error: ", status.ErrorMessage()));
+      if (create_cpu_kernels_in_parallel && exec_provider_name == onnxruntime::kCpuExecutionProvider &&
+          node.NodeType() != Node::Type::Fused) {
+        cpu_nodes.push_back(&node);
+      } else {
+        ORT_RETURN_IF_ERROR(create_kernel(node, *exec_provider));
+      }
+    }
+
+    if (!cpu_nodes.empty()) {
+      const IExecutionProvider& cpu_provider = *execution_providers_.get().Get(onnxruntime::kCpuExecutionProvider);
+      std::vector<Status> statuses(cpu_nodes.size());
+      concurrency::ThreadPool::TryParallelFor(thread_pool_, static_cast<int32_t>(cpu_nodes.size()), [&](int32_t i) {
+        statuses[i] = create_kernel(*cpu_nodes[i], cpu_provider);
+      });
+      for (const auto& status : statuses) {
+        ORT_RETURN_IF_ERROR(status);
       }
-      assert(session_kernels_[node.Index()] == nullptr);
-      // assumes vector is already resize()'ed to the number of nodes in the graph
-      session_kernels_[node.Index()] = op_kernel.release();
     }
   }
   node_index_info_ = onnxruntime::make_unique<NodeIndexInfo>(*graph_viewer_, ort_value_name_idx_map_);
+  ResolveExecutionSteps();
+  return Status::OK();
+}
+
+Status SessionState::PrePackInitializedConstantTensors() {
+  const IExecutionProvider* cpu_provider = execution_providers_.get().Get(onnxruntime::kCpuExecutionProvider);
+  if (cpu_provider == nullptr) {
+    return Status::OK();
+  }
+  AllocatorPtr session_cpu_allocator = cpu_provider->GetAllocator(0, OrtMemTypeDefault);
+
+  for (const auto& node : graph_viewer_->Nodes()) {
+    OpKernel* kernel = GetMutableKernel(node.Index());
+    // the packed buffers are in CPU memory, so only the CPU kernels can use them
+    if (kernel == nullptr || node.GetExecutionProviderType() != onnxruntime::kCpuExecutionProvider) {
+      continue;
+    }
+
+    int input_idx = 0;
+    for (const auto* input_def : node.InputDefs()) {
+      int ort_value_idx;
+      if (input_def->Exists() && ort_value_name_idx_map_.GetIdx(input_def->Name(), ort_value_idx).IsOK()) {
+        auto it = constant_initialized_tensors_.find(ort_value_idx);
+        if (it != constant_initialized_tensors_.end() && it->second.IsTensor()) {
+          const Tensor& tensor = it->second.Get<Tensor>();
+          if (tensor.Location().device.Type() == OrtDevice::CPU) {
+            std::shared_ptr<const PrePackedWeights> weights;
+            if (prepacked_weights_container_ != nullptr) {
+              ORT_RETURN_IF_ERROR(prepacked_weights_container_->GetOrPack(
+                  PrepackedWeightsContainer::GenerateKey(*kernel, input_idx, tensor),
+                  [kernel, input_idx, &tensor](AllocatorPtr alloc, bool& is_packed, PrePackedWeights& packed) {
+                    return kernel->PrePack(tensor, input_idx, alloc, is_packed, packed);
+                  },
+                  weights));
+            } else {
+              auto packed = std::make_shared<PrePackedWeights>();
+              bool is_packed = false;
+              ORT_RETURN_IF_ERROR(kernel->PrePack(tensor, input_idx, session_cpu_allocator, is_packed, *packed));
+              if (is_packed) {
+                weights = std::move(packed);
+              }
+            }
+
+            if (weights != nullptr) {
+              ORT_RETURN_IF_ERROR(kernel->UseSharedPrePackedBuffers(*weights, input_idx));
+              prepacked_weights_.push_back(std::move(weights));
+            }
+          }
+        }
+      }
+      ++input_idx;
+    }
+  }
+
   return Status::OK();
 }
 
 void SessionState::SetExecutionPlan(std::unique_ptr<SequentialExecutionPlan> p_seq_exec_plan) {
   p_seq_exec_plan_ = std::move(p_seq_exec_plan);
+  ResolveExecutionSteps();
+}
+
+void SessionState::ResolveExecutionSteps() {
+  // the idle frames refer to the plan and the node index info
+  execution_frame_pool_.Clear();
+  execution_steps_.clear();
+  execution_step_event_names_.clear();
+  if (p_seq_exec_plan_ == nullptr || session_kernels_.empty() || graph_viewer_ == nullptr ||
+      node_index_info_ == nullptr) {
+    return;
+  }
+
+  const auto& execution_plan = p_seq_exec_plan_->execution_plan;
+  execution_steps_.reserve(execution_plan.size());
+  execution_step_event_names_.reserve(execution_plan.size());
+  for (const auto& node_exec_plan : execution_plan) {
+    const NodeIndex node_index = node_exec_plan.node_index;
+    const Node* node = graph_viewer_->GetNode(node_index);
+    // free_to_index is below free_from_index if there is nothing to release
+    const OrtValueIndex* to_be_freed = p_seq_exec_plan_->to_be_freed.data();
+    const int num_released = std::max(node_exec_plan.free_to_index - node_exec_plan.free_from_index + 1, 0);
+    const OrtValueIndex* release_begin = num_released > 0 ? to_be_freed + node_exec_plan.free_from_index : nullptr;
+    execution_steps_.push_back({GetKernel(node_index), node, node_index, node_index_info_->GetNodeOffset(node_index),
+                                p_seq_exec_plan_->NodeHasFence(node_index), !node->ImplicitInputDefs().empty(),
+                                release_begin, release_begin + num_released});
+    const std::string& name = node->Name();
+    execution_step_event_names_.push_back({name + "_fence_before", name + "_kernel_time", name + "_fence_after"});
+  }
 }
 
 const SequentialExecutionPlan* SessionState::GetExecutionPlan() const { return p_seq_exec_plan_.get(); }
@@ -148,15 +266,43 @@ void SessionState::SetProfiler(profiling::Profiler& profiler) { profiler_ = &pro
 
 ::onnxruntime::profiling::Profiler& SessionState::Profiler() const { return *profiler_; }
 
-static int64_t CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& shapes) {
+static int64_t RoundUpToBucket(int64_t dim, const std::vector<int64_t>& bucket_boundaries) {
+  if (dim <= 0) {
+    return dim;
+  }
+
+  if (bucket_boundaries.empty()) {
+    int64_t bucket = 1;
+    while (bucket < dim && bucket <= std::numeric_limits<int64_t>::max() / 2) {
+      bucket <<= 1;
+    }
+    return std::max(bucket, dim);
+  }
+
+  auto it = std::lower_bound(bucket_boundaries.cbegin(), bucket_boundaries.cend(), dim);
+  return it != bucket_boundaries.cend() ? *it : dim;
+}
+
+static size_t TotalPeakSize(const MemoryPatternGroup& mem_patterns) {
+  size_t total = 0;
+  for (const auto& pattern : mem_patterns.patterns) {
+    total += pattern.PeakSize();
+  }
+  return total;
+}
+
+int64_t SessionState::CalculateMemoryPatternsKey(
+    const std::vector<std::reference_wrapper<const TensorShape>>& shapes) const {
   int64_t key = 0;
   for (auto shape : shapes) {
-    for (auto dim : shape.get().GetDims()) key ^= dim;
+    for (auto dim : shape.get().GetDims()) {
+      key ^= enable_mem_pattern_bucketing_ ? RoundUpToBucket(dim, mem_pattern_bucket_boundaries_) : dim;
+    }
   }
   return key;
 }
 
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
     const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const {
   int64_t key = CalculateMemoryPatternsKey(input_shapes);
 
@@ -164,7 +310,7 @@ const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
   auto it = mem_patterns_.find(key);
   if (it == mem_patterns_.end()) return nullptr;
 
-  return it->second.get();
+  return it->second;
 }
 
 Status SessionState::UpdateMemoryPatternGroupCache(
@@ -176,6 +322,9 @@ Status SessionState::UpdateMemoryPatternGroupCache(
   auto it = mem_patterns_.find(key);
   if (it == mem_patterns_.end()) {
     mem_patterns_[key] = std::move(mem_patterns);
+  } else if (enable_mem_pattern_bucketing_ && TotalPeakSize(*mem_patterns) > TotalPeakSize(*it->second)) {
+    // frames still using the previous pattern keep it alive through their shared_ptr
+    it->second = std::move(mem_patterns);
   }
 
   return Status::OK();
@@ -183,6 +332,13 @@ Status SessionState::UpdateMemoryPatternGroupCache(
 
 bool SessionState::GetEnableMemoryPattern() const { return enable_mem_pattern_; }
 
+void SessionState::EnableMemoryPatternBucketing(std::vector<int64_t> bucket_boundaries) {
+  ORT_ENFORCE(std::is_sorted(bucket_boundaries.cbegin(), bucket_boundaries.cend()),
+              "Memory pattern bucket boundaries must be in increasing order.");
+  enable_mem_pattern_bucketing_ = true;
+  mem_pattern_bucket_boundaries_ = std::move(bucket_boundaries);
+}
+
 common::Status SessionState::AddInputNameToNodeInfoMapping(const std::string& input_name, const NodeInfo& node_info) {
   // Graph partitioning should ensure an input is only consumed from one device. Copy nodes should have been inserted
   // to handle a scenario where an input is required on different devices by different nodes. Validate that.
@@ -14,6 +14,7 @@
 #include "core/common/profiler.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/data_transfer_manager.h"
+#include "core/framework/execution_frame.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/kernel_registry_manager.h"
@@ -22,6 +23,9 @@
 #include "core/framework/callback.h"
 #include "core/framework/ort_value_name_idx_map.h"
 #include "core/framework/node_index_info.h"
+#include "core/framework/op_stats.h"
+#include "core/framework/prepacked_weights_container.h"
+#include "core/framework/shared_initializer_store.h"
 #include "core/graph/graph_viewer.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/platform/threadpool.h"
@@ -119,6 +123,44 @@ class SessionState {
   void SetExecutionPlan(std::unique_ptr<SequentialExecutionPlan> p_seq_exec_plan);
   const SequentialExecutionPlan* GetExecutionPlan() const;
 
+  /**
+  What the sequential executor needs to run a node of the execution plan, resolved once the plan and the kernels are
+  created so the executor walks a flat array rather than looking them up per node and per run.
+  */
+  struct ExecutionStep {
+    const OpKernel* kernel;  // null if the node has no kernel
+    const Node* node;
+    NodeIndex node_index;
+    // the index of the first input of the node in the frame, followed by its implicit inputs and outputs
+    int node_input_start_index;
+    bool has_fence;
+    bool has_implicit_inputs;
+    // the values to release after the node runs, a range of the to_be_freed list of the plan
+    const OrtValueIndex* release_begin;
+    const OrtValueIndex* release_end;
+  };
+
+  // The names of the profiler events of a node, built with the steps rather than per run.
+  struct ExecutionStepEventNames {
+    std::string fence_before;
+    std::string kernel_time;
+    std::string fence_after;
+  };
+
+  /**
+  The steps of the execution plan in order, and the names of their profiler events. Empty until both the execution
+  plan and the kernels are created.
+  */
+  const std::vector<ExecutionStep>& GetExecutionSteps() const noexcept { return execution_steps_; }
+  const std::vector<ExecutionStepEventNames>& GetExecutionStepEventNames() const noexcept {
+    return execution_step_event_names_;
+  }
+
+  /**
+  The execution frames the sequential executor reuses across the runs of this session state.
+  */
+  ExecutionFramePool& GetExecutionFramePool() const noexcept { return execution_frame_pool_; }
+
   /**
   Set the logger to use for this session.
   */
@@ -141,15 +183,31 @@ class SessionState {
   */
   profiling::Profiler& Profiler() const;
 
+  /**
+  Set the collector of the per node counters of the session, shared with the subgraphs. The nodes are added to it
+  when the kernels are created. The executors record the calls into it if not null.
+  */
+  void SetOpStatsCollector(OpStatsCollector* op_stats) { op_stats_ = op_stats; }
+  OpStatsCollector* GetOpStatsCollector() const { return op_stats_; }
+
+  /**
+  Let the execution frames record the allocations and frees of the buffers of the values as memory events of the
+  profiler, when it is enabled.
+  */
+  void SetEnableMemoryProfiling(bool enable) { enable_memory_profiling_ = enable; }
+  bool GetEnableMemoryProfiling() const { return enable_memory_profiling_; }
+
   /**
   Get cached memory pattern based on input shapes
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
       const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const;
 
   /**
   Set generated memory pattern with a given input shapes.
   Const as it's an internal cache update only.
+  If memory pattern bucketing is enabled, an existing pattern for the bucket is replaced if the new one
+  needs more memory, so the cached pattern converges to the largest shape seen in the bucket.
   */
   Status UpdateMemoryPatternGroupCache(const std::vector<std::reference_wrapper<const TensorShape>>& input_shape,
                                        std::unique_ptr<MemoryPatternGroup> mem_patterns) const;
@@ -159,6 +217,50 @@ class SessionState {
   */
   bool GetEnableMemoryPattern() const;
 
+  /**
+  Enable rounding the input dimensions up to buckets when looking up memory patterns, so inputs with
+  different shapes in the same bucket share one pattern. A block of the pattern is then used for any
+  tensor that fits in it.
+  @param bucket_boundaries Upper bounds of the buckets in increasing order. If empty, dimensions are
+  rounded up to the next power of two. Dimensions larger than the last boundary are not rounded.
+  */
+  void EnableMemoryPatternBucketing(std::vector<int64_t> bucket_boundaries);
+
+  bool GetEnableMemoryPatternBucketing() const { return enable_mem_pattern_bucketing_; }
+
+  /**
+  Enable the kernels to pre-pack their constant initializers (see OpKernel::PrePack) once the kernels are created.
+  @param container If not null, the packed weights are looked up in and added to this container, so they are shared
+  with the other sessions using it. The container must outlive the session.
+  */
+  void EnablePrePacking(PrepackedWeightsContainer* container) {
+    enable_prepacking_ = true;
+    prepacked_weights_container_ = container;
+  }
+
+  bool GetEnablePrePacking() const { return enable_prepacking_; }
+  PrepackedWeightsContainer* GetPrepackedWeightsContainer() const { return prepacked_weights_container_; }
+
+  /**
+  Share the constant initializers in CPU memory with the other sessions using the store: an initializer with the same
+  type, shape and content as one of the store uses it in place of a copy of its own. The store must outlive the
+  session.
+  */
+  void SetSharedInitializerStore(SharedInitializerStore* store) { shared_initializer_store_ = store; }
+  SharedInitializerStore* GetSharedInitializerStore() const { return shared_initializer_store_; }
+
+  /**
+  Let the planner look for an execution order that lowers the peak memory of the intermediate tensors, in place of
+  the default topological order. Must be called before the execution plan is created.
+  */
+  void SetEnableMemoryEfficientExecutionOrder(bool enable) { enable_memory_efficient_execution_order_ = enable; }
+  bool GetEnableMemoryEfficientExecutionOrder() const { return enable_memory_efficient_execution_order_; }
+
+  /**
+  Let the CPU kernels pre-pack the constant initializers they consume. Must be called after the kernels are created.
+  */
+  Status PrePackInitializedConstantTensors();
+
   struct NodeInfo {
     /**
      *
@@ -220,9 +322,14 @@ class SessionState {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionState);
 
+  // builds execution_steps_ if both the execution plan and the kernels are created
+  void ResolveExecutionSteps();
+
   // cache of the constructed kernels to avoid spending construction
   // time per executor
   std::vector<OpKernel*> session_kernels_;
+  std::vector<ExecutionStep> execution_steps_;
+  std::vector<ExecutionStepEventNames> execution_step_event_names_;
   std::unique_ptr<GraphViewer> graph_viewer_;
 
   std::reference_wrapper<const ExecutionProviders> execution_providers_;  // owned by InferenceSession
@@ -241,13 +348,30 @@ class SessionState {
 
   const logging::Logger* logger_ = nullptr;
   profiling::Profiler* profiler_ = nullptr;
+  OpStatsCollector* op_stats_ = nullptr;
+  bool enable_memory_profiling_ = false;
 
   // switch for enable memory pattern optimization or not.
   const bool enable_mem_pattern_;
   // lock for the mem_patterns_
   mutable OrtMutex mem_patterns_lock_;
   // cache for the generated mem_patterns. key is calculated based on input shapes.
-  mutable std::map<int64_t, std::unique_ptr<MemoryPatternGroup>> mem_patterns_;
+  // shared with the execution frames using the pattern as an entry can be replaced when bucketing is enabled.
+  mutable std::map<int64_t, std::shared_ptr<const MemoryPatternGroup>> mem_patterns_;
+
+  int64_t CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& shapes) const;
+
+  bool enable_mem_pattern_bucketing_ = false;
+  std::vector<int64_t> mem_pattern_bucket_boundaries_;
+
+  bool enable_prepacking_ = false;
+  PrepackedWeightsContainer* prepacked_weights_container_ = nullptr;
+  // weights packed by the kernels of this session. shared with the container if there is one.
+  std::vector<std::shared_ptr<const PrePackedWeights>> prepacked_weights_;
+
+  SharedInitializerStore* shared_initializer_store_ = nullptr;
+
+  bool enable_memory_efficient_execution_order_ = false;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -281,6 +405,9 @@ class SessionState {
   }
 
 #endif
+
+  // last so the idle frames are destroyed before the state they refer to
+  mutable ExecutionFramePool execution_frame_pool_;
 };
 
 }  // namespace onnxruntime
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <limits>
+#include <unordered_set>
 #include <core/common/status.h>
 
 #include "core/common/common.h"
@@ -24,6 +25,7 @@
 #include "core/framework/utils.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/common/profiler.h"
 
 namespace onnxruntime {
 
@@ -32,9 +34,12 @@ template <typename T>
 static common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                                              const onnxruntime::Graph& graph, const ExecutionProviders& exec_providers,
                                              const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                             const ExecutionPlanBase& exec_plan,
                                              ITensorAllocator* planner, const T& save_tensor_func,
                                              const logging::Logger& logger,
-                                             const DataTransferManager& data_transfer_mgr);
+                                             const DataTransferManager& data_transfer_mgr,
+                                             concurrency::ThreadPool* thread_pool,
+                                             SharedInitializerStore* shared_initializer_store);
 
 static common::Status SaveInputOutputNamesToNodeMapping(
     const onnxruntime::Graph& graph,
@@ -77,33 +82,47 @@ common::Status SessionStateInitializer::CreatePlan(
                   });
   }
 
-  std::unique_ptr<SequentialExecutionPlan> exec_plan;
-  SequentialPlannerContext context(execution_mode);
-  ORT_RETURN_IF_ERROR(SequentialPlanner::CreatePlan(parent_node, *graph_viewer, valid_outer_scope_node_args,
-                                                    execution_providers_, kernel_registry_manager_,
-                                                    ort_value_name_idx_map, context, exec_plan));
-  session_state_.SetExecutionPlan(std::move(exec_plan));
+  {
+    profiling::ScopedSessionEvent event(profiler_, "allocation_planning");
+    std::unique_ptr<SequentialExecutionPlan> exec_plan;
+    SequentialPlannerContext context(execution_mode, session_state_.GetEnableMemoryEfficientExecutionOrder());
+    ORT_RETURN_IF_ERROR(SequentialPlanner::CreatePlan(parent_node, *graph_viewer, valid_outer_scope_node_args,
+                                                      execution_providers_, kernel_registry_manager_,
+                                                      ort_value_name_idx_map, context, exec_plan));
+    session_state_.SetExecutionPlan(std::move(exec_plan));
+  }
 
   const auto* exec_plan_ptr = session_state_.GetExecutionPlan();
   ORT_ENFORCE(exec_plan_ptr, "Execution plan was not found in SessionState. CreatePlan must be called first.");
 
-  std::unique_ptr<ITensorAllocator> tensor_allocator_(ITensorAllocator::Create(
-      enable_mem_pattern_, *exec_plan_ptr, execution_providers_, session_state_.GetMutableWeightsBuffers()));
-
-  // lambda to save initialized tensors into SessionState directly
-  const Env& env = Env::Default();
-  ORT_RETURN_IF_ERROR(SaveInitializedTensors(
-      env, graph_loc_, graph_, execution_providers_, ort_value_name_idx_map, tensor_allocator_.get(),
-      [this](int idx, const OrtValue& value, const OrtCallback& d, bool constant) -> Status {
-        return session_state_.AddInitializedTensor(idx, value, &d, constant);
-      },
-      logger_, session_state_.GetDataTransferMgr()));
-  // remove weights from the graph now to save memory but in many cases it won't save memory, if the tensor was
-  // preallocated with the some other tensors in a single 'allocate' call, which is very common.
-  // TODO: make it better
-  graph_.CleanAllInitializedTensors();
-
-  ORT_RETURN_IF_ERROR(session_state_.CreateKernels(kernel_registry_manager_));
+  {
+    profiling::ScopedSessionEvent event(profiler_, "initializer_loading");
+    std::unique_ptr<ITensorAllocator> tensor_allocator_(ITensorAllocator::Create(
+        enable_mem_pattern_, *exec_plan_ptr, execution_providers_, session_state_.GetMutableWeightsBuffers()));
+
+    // lambda to save initialized tensors into SessionState directly
+    const Env& env = Env::Default();
+    ORT_RETURN_IF_ERROR(SaveInitializedTensors(
+        env, graph_loc_, graph_, execution_providers_, ort_value_name_idx_map, *exec_plan_ptr, tensor_allocator_.get(),
+        [this](int idx, const OrtValue& value, const OrtCallback& d, bool constant) -> Status {
+          return session_state_.AddInitializedTensor(idx, value, &d, constant);
+        },
+        logger_, session_state_.GetDataTransferMgr(), session_state_.GetThreadPool(),
+        session_state_.GetSharedInitializerStore()));
+    // remove weights from the graph now to save memory but in many cases it won't save memory, if the tensor was
+    // preallocated with the some other tensors in a single 'allocate' call, which is very common.
+    // TODO: make it better
+    graph_.CleanAllInitializedTensors();
+  }
+
+  {
+    profiling::ScopedSessionEvent event(profiler_, "kernel_creation");
+    ORT_RETURN_IF_ERROR(session_state_.CreateKernels(kernel_registry_manager_));
+  }
+  if (session_state_.GetEnablePrePacking()) {
+    profiling::ScopedSessionEvent event(profiler_, "weight_prepacking");
+    ORT_RETURN_IF_ERROR(session_state_.PrePackInitializedConstantTensors());
+  }
   ORT_RETURN_IF_ERROR(
       SaveInputOutputNamesToNodeMapping(graph_, kernel_registry_manager_, session_state_, outer_scope_node_args));
   return Status::OK();
@@ -173,53 +192,140 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
 template <typename T>
 common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                                       const Graph& graph, const ExecutionProviders& exec_providers,
-                                      const OrtValueNameIdxMap& ort_value_name_idx_map, ITensorAllocator* planner,
+                                      const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                      const ExecutionPlanBase& exec_plan, ITensorAllocator* planner,
                                       const T& save_tensor_func, const logging::Logger& logger,
-                                      const DataTransferManager& data_transfer_mgr) {
+                                      const DataTransferManager& data_transfer_mgr,
+                                      concurrency::ThreadPool* thread_pool,
+                                      SharedInitializerStore* shared_initializer_store) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
   //1. first plan the memory
   const onnxruntime::InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   std::unordered_map<int, const ONNX_NAMESPACE::TensorProto*> id_to_initialized_tensor;
+  // initializers on CPU whose external data is used in place (wrapping the memory-mapped file) don't need a buffer
+  std::unordered_set<int> in_place_initializers;
+  // constant initializers on CPU which are looked up in the shared store get a buffer of the store
+  std::unordered_set<int> shared_initializers;
   for (const auto& entry : initialized_tensor_set) {
     int ort_value_index;
     ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(entry.first, ort_value_index));
     id_to_initialized_tensor[ort_value_index] = entry.second;
+
+    const auto& location = exec_plan.GetLocation(ort_value_index);
+    if (strcmp(location.name, CPU) == 0) {
+      if (utils::CanUseExternalDataInPlace(*entry.second)) {
+        in_place_initializers.insert(ort_value_index);
+      } else if (shared_initializer_store != nullptr &&
+                 entry.second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING &&
+                 graph_utils::IsConstantInitializer(graph, entry.first, /* check_outer_scope */ false)) {
+        shared_initializers.insert(ort_value_index);
+      }
+    }
   }
   for (const auto& entry : id_to_initialized_tensor) {
-    ORT_RETURN_IF_ERROR(planner->Trace(entry.first, entry.second));
+    if (in_place_initializers.count(entry.first) == 0 && shared_initializers.count(entry.first) == 0) {
+      ORT_RETURN_IF_ERROR(planner->Trace(entry.first, entry.second));
+    }
   }
 
   //2. allocate weight buffer on different locations
   ORT_RETURN_IF_ERROR(planner->FinalizePlan());
-  OrtCallback deleter;
-  //3. create weight tensors based on weights buffer
+  //3. get the buffer of each weight. the planner isn't thread safe, so this is done up front.
+  struct InitializerToLoad {
+    int ort_value_index;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    std::unique_ptr<MemBuffer> m;
+    std::unique_ptr<Tensor> shared_tensor;  // owns the buffer of an initializer looked up in the shared store
+    OrtValue ort_value;
+    OrtCallback deleter{nullptr, nullptr};
+    Status status;
+  };
+
+  std::vector<InitializerToLoad> initializers;
+  initializers.reserve(id_to_initialized_tensor.size());
   for (const auto& entry : id_to_initialized_tensor) {
     int ort_value_index = entry.first;
     const char* name = (entry.second->name().empty()) ? "" : entry.second->name().c_str();
-    const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
 
     std::unique_ptr<MemBuffer> m;
-    // TODO: if the tensor need be copied, does it have enough room?
-    ORT_RETURN_IF_ERROR(planner->GetPreallocatedBuffer(ort_value_index, name, m));
+    std::unique_ptr<Tensor> shared_tensor;
+    if (in_place_initializers.count(ort_value_index) != 0) {
+      m = onnxruntime::make_unique<MemBuffer>(nullptr, 0, exec_plan.GetLocation(ort_value_index));
+    } else if (shared_initializers.count(ort_value_index) != 0) {
+      const auto* type = DataTypeImpl::TensorTypeFromONNXEnum(entry.second->data_type())->GetElementType();
+      std::vector<int64_t> dims(entry.second->dims().begin(), entry.second->dims().end());
+      shared_tensor = onnxruntime::make_unique<Tensor>(type, TensorShape(dims),
+                                                       shared_initializer_store->GetAllocator());
+      m = onnxruntime::make_unique<MemBuffer>(shared_tensor->MutableDataRaw(), shared_tensor->SizeInBytes(),
+                                              shared_tensor->Location());
+    } else {
+      // TODO: if the tensor need be copied, does it have enough room?
+      ORT_RETURN_IF_ERROR(planner->GetPreallocatedBuffer(ort_value_index, name, m));
+    }
 #ifndef NDEBUG
     ORT_ENFORCE(m != nullptr);
     ORT_ENFORCE(m->GetBuffer() != nullptr || m->GetLen() == 0);
 #endif
-    OrtValue ort_value;
-    Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, *m, exec_providers, ort_value, deleter, data_transfer_mgr);
-    if (!st.IsOK()) {
-      std::ostringstream oss;
-      oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
-      return Status(st.Category(), st.Code(), oss.str());
+    initializers.push_back(InitializerToLoad{ort_value_index, entry.second, std::move(m), std::move(shared_tensor),
+                                             OrtValue(), {nullptr, nullptr}, Status::OK()});
+  }
+
+  //4. create weight tensors based on weights buffer.
+  // the weights on CPU are independent of each other, so they are unpacked in parallel. the ones on other devices
+  // are copied one at a time, as not every data transfer can be used from multiple threads.
+  auto deserialize = [&](InitializerToLoad& initializer) {
+    initializer.status = DeserializeTensorProto(env, graph_loc, *initializer.tensor_proto, *initializer.m,
+                                                exec_providers, initializer.ort_value, initializer.deleter,
+                                                data_transfer_mgr);
+  };
+  auto is_on_cpu = [](const InitializerToLoad& initializer) {
+    const OrtMemoryInfo& alloc_info = initializer.m->GetAllocInfo();
+    return strcmp(alloc_info.name, CPU) == 0 || alloc_info.mem_type == OrtMemTypeCPUOutput;
+  };
+
+  concurrency::ThreadPool::TryParallelFor(thread_pool, static_cast<int32_t>(initializers.size()), [&](int32_t i) {
+    if (is_on_cpu(initializers[i])) {
+      deserialize(initializers[i]);
     }
+  });
+  for (auto& initializer : initializers) {
+    if (!is_on_cpu(initializer)) {
+      deserialize(initializer);
+    }
+  }
 
-    bool constant = graph_utils::IsConstantInitializer(graph, name, /* check_outer_scope */ false);
-    ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, ort_value, deleter, constant));
+  //5. save the weights. on failure, release the weights that haven't been handed over to the session state.
+  Status status = Status::OK();
+  for (auto& initializer : initializers) {
+    const char* name = (initializer.tensor_proto->name().empty()) ? "" : initializer.tensor_proto->name().c_str();
+    if (status.IsOK()) {
+      if (!initializer.status.IsOK()) {
+        std::ostringstream oss;
+        oss << "Deserialize tensor " << name << " failed." << initializer.status.ErrorMessage();
+        status = Status(initializer.status.Category(), initializer.status.Code(), oss.str());
+      } else {
+        if (initializer.shared_tensor != nullptr) {
+          // the deserialized value wraps the buffer of the shared tensor, which the session then gets from the store
+          auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+          OrtValue owned_value(initializer.shared_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+          initializer.ort_value = shared_initializer_store->GetOrAdd(owned_value);
+        }
+        bool constant = graph_utils::IsConstantInitializer(graph, name, /* check_outer_scope */ false);
+        status = save_tensor_func(initializer.ort_value_index, initializer.ort_value, initializer.deleter, constant);
+        if (status.IsOK()) {
+          VLOGS(logger, 1) << "Added weight with name : " << name << " with index: " << initializer.ort_value_index;
+          continue;
+        }
+      }
+    }
 
-    VLOGS(logger, 1) << "Added weight with name : " << name << " with index: " << ort_value_index;
+    if (initializer.deleter.f != nullptr) {
+      initializer.deleter.f(initializer.deleter.param);
+    }
   }
+  ORT_RETURN_IF_ERROR(status);
 
   LOGS(logger, INFO) << "Done saving initialized tensors";
   return common::Status::OK();
@@ -25,6 +25,10 @@ namespace logging {
 class Logger;
 }
 
+namespace profiling {
+class Profiler;
+}
+
 // Don't use this class before graph partition is done
 class SessionStateInitializer {
  public:
@@ -42,6 +46,10 @@ class SessionStateInitializer {
                             _In_opt_ const ConstPointerContainer<std::vector<NodeArg*>>* outer_scope_node_args,
                             ExecutionMode execution_mode);
 
+  // Set the profiler that records the allocation planning, the initializer loading and the kernel creation of
+  // CreatePlan. Nothing is recorded unless the profiler is enabled.
+  void SetProfiler(profiling::Profiler* profiler) { profiler_ = profiler; }
+
  private:
   const std::basic_string<PATH_CHAR_TYPE>& graph_loc_;
   onnxruntime::Graph& graph_;
@@ -51,5 +59,6 @@ class SessionStateInitializer {
   KernelRegistryManager& kernel_registry_manager_;
   const logging::Logger& logger_;
   const bool enable_mem_pattern_;
+  profiling::Profiler* profiler_ = nullptr;
 };
 }  // namespace onnxruntime
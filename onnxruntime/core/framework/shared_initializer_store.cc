@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initializer_store.h"
+
+#include <cstring>
+#include <sstream>
+
+namespace onnxruntime {
+
+SharedInitializerStore::SharedInitializerStore() : allocator_(std::make_shared<CPUAllocator>()) {}
+
+// 64-bit FNV-1a over 8 byte words, which is fast enough to run over every weight of a model
+static uint64_t HashTensorData(const void* data, size_t len) {
+  constexpr uint64_t kPrime = 1099511628211ULL;
+  uint64_t hash = 14695981039346656037ULL;
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes + i, sizeof(word));
+    hash = (hash ^ word) * kPrime;
+  }
+  for (; i < len; ++i) {
+    hash = (hash ^ bytes[i]) * kPrime;
+  }
+  return hash;
+}
+
+OrtValue SharedInitializerStore::GetOrAdd(const OrtValue& value) {
+  const auto& tensor = value.Get<Tensor>();
+  ORT_ENFORCE(!tensor.IsDataTypeString(), "String initializers can't be shared.");
+
+  std::ostringstream key;
+  key << DataTypeImpl::ToString(tensor.DataType()) << ':' << tensor.Shape().ToString() << ':' << std::hex
+      << HashTensorData(tensor.DataRaw(), tensor.SizeInBytes());
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = initializers_.find(key.str());
+  if (it == initializers_.end()) {
+    initializers_.emplace(key.str(), value);
+    return value;
+  }
+
+  const auto& shared_tensor = it->second.Get<Tensor>();
+  if (tensor.SizeInBytes() > 0 && memcmp(shared_tensor.DataRaw(), tensor.DataRaw(), tensor.SizeInBytes()) != 0) {
+    // a hash collision, the first initializer keeps the entry and this one isn't shared
+    return value;
+  }
+  return it->second;
+}
+
+void SharedInitializerStore::ReleaseUnused() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  for (auto it = initializers_.begin(); it != initializers_.end();) {
+    if (it->second.IsShared()) {
+      ++it;
+    } else {
+      it = initializers_.erase(it);
+    }
+  }
+}
+
+size_t SharedInitializerStore::NumInitializers() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return initializers_.size();
+}
+
+}  // namespace onnxruntime
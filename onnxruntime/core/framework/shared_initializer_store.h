@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "core/framework/allocator.h"
+#include "core/framework/ml_value.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// Content-addressed store of the constant initializers of the sessions sharing it, so the sessions loading the same
+// weights, e.g. the same model with different execution providers or options, keep a single read-only copy of each.
+// Only the initializers in CPU memory are shared: they are allocated from an allocator owned by the store, so they
+// can outlive the session that loaded them.
+class SharedInitializerStore {
+ public:
+  SharedInitializerStore();
+
+  // allocator for the initializers added to the store
+  AllocatorPtr GetAllocator() const { return allocator_; }
+
+  // Returns the initializer of the store with the same type, shape and content as 'value', adding 'value' if there
+  // is none yet. 'value' must be a non-string tensor allocated from GetAllocator(), which isn't modified afterwards.
+  OrtValue GetOrAdd(const OrtValue& value);
+
+  // Releases the initializers that no session uses anymore.
+  void ReleaseUnused();
+
+  size_t NumInitializers() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedInitializerStore);
+
+  AllocatorPtr allocator_;
+
+  mutable OrtMutex mutex_;
+  // keyed by the type, the shape and a hash of the content, which is compared in full on a hit
+  std::unordered_map<std::string, OrtValue> initializers_;
+};
+
+}  // namespace onnxruntime
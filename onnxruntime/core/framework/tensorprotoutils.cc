@@ -362,6 +362,29 @@ static Status GetFileContent(
   return Status::OK();
 }
 
+// the data can only be used as the tensor buffer if it is aligned for the element type. the mapping starts at a page
+// boundary, so the alignment of the data is the alignment of its offset in the file.
+static bool IsAlignedForElementType(uint64_t offset_or_address, const DataTypeImpl& element_type) {
+  return offset_or_address % element_type.Size() == 0;
+}
+
+bool CanUseExternalDataInPlace(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  if (endian::native != endian::little ||
+      tensor_proto.data_location() != TensorProto_DataLocation_EXTERNAL ||
+      tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    return false;
+  }
+
+  const auto* tensor_type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type());
+  std::unique_ptr<ExternalDataInfo> external_data_info;
+  if (tensor_type == nullptr || !ExternalDataInfo::Create(tensor_proto.external_data(), external_data_info).IsOK()) {
+    return false;
+  }
+
+  return IsAlignedForElementType(static_cast<uint64_t>(external_data_info->GetOffset()),
+                                 *tensor_type->GetElementType());
+}
+
 static void MoveOrtCallback(OrtCallback& from, OrtCallback& to) {
   to.f = from.f;
   to.param = from.param;
@@ -412,7 +435,8 @@ Status TensorProtoToMLValue(const Env& env, const ORTCHAR_T* tensor_proto_path,
       //raw_data = buffer.release();
       raw_data_len = tensor_proto.raw_data().size();
     }
-    if (endian::native == endian::little && raw_data != nullptr && deleter_for_file_data.d.f != nullptr) {
+    if (endian::native == endian::little && raw_data != nullptr && deleter_for_file_data.d.f != nullptr &&
+        IsAlignedForElementType(reinterpret_cast<uintptr_t>(raw_data), *type)) {
       tensor_data = raw_data;
       MoveOrtCallback(deleter_for_file_data.d, deleter);
     } else {
@@ -542,6 +566,117 @@ ONNX_NAMESPACE::TensorProto TensorToTensorProto(const Tensor& tensor, const std:
   return tensor_proto;
 }
 
+// Writes the values of a sparse tensor at their positions in the raw data of a dense tensor of `dense_size` elements.
+template <typename T>
+static Status ScatterSparseValues(const ONNX_NAMESPACE::TensorProto& values, const std::vector<int64_t>& positions,
+                                  int64_t dense_size, ONNX_NAMESPACE::TensorProto& dense) {
+  const size_t nnz = positions.size();
+  std::unique_ptr<T[]> values_data{new T[nnz]};
+  const bool has_raw_data = HasRawData(values);
+  ORT_RETURN_IF_ERROR(UnpackTensor<T>(values, has_raw_data ? values.raw_data().data() : nullptr,
+                                      has_raw_data ? values.raw_data().size() : 0, values_data.get(), nnz));
+
+  std::string raw_data(static_cast<size_t>(dense_size) * sizeof(T), '\0');
+  T* dense_data = reinterpret_cast<T*>(&raw_data[0]);
+  for (size_t i = 0; i < nnz; ++i) {
+    dense_data[positions[i]] = values_data[i];
+  }
+  dense.set_raw_data(std::move(raw_data));
+  return Status::OK();
+}
+
+Status SparseTensorProtoToDenseTensorProto(const ONNX_NAMESPACE::SparseTensorProto& sparse,
+                                           ONNX_NAMESPACE::TensorProto& dense) {
+  // Given we are using the raw_data field in the protobuf, this will work only for little-endian format.
+  ORT_ENFORCE(endian::native == endian::little);
+
+  const auto& values = sparse.values();
+  const auto& indices = sparse.indices();
+  ORT_RETURN_IF_NOT(values.data_location() != ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL &&
+                        indices.data_location() != ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL,
+                    "Sparse initializer ", values.name(), " with external data is not supported");
+
+  int64_t dense_size = 1;
+  for (auto dim : sparse.dims()) {
+    ORT_RETURN_IF_NOT(dim >= 0, "Sparse initializer ", values.name(), " has a negative dimension");
+    dense_size *= dim;
+  }
+
+  // the indices are either the linear positions of the values, with shape [NNZ], or their coordinates, with shape
+  // [NNZ, rank].
+  const int64_t nnz = values.dims_size() == 1 ? values.dims(0) : 0;
+  const int rank = sparse.dims_size();
+  const bool is_linear = indices.dims_size() == 1;
+  ORT_RETURN_IF_NOT(values.dims_size() == 1 && indices.data_type() == ONNX_NAMESPACE::TensorProto_DataType_INT64 &&
+                        indices.dims_size() >= 1 && indices.dims(0) == nnz &&
+                        (is_linear || (indices.dims_size() == 2 && indices.dims(1) == rank)),
+                    "Sparse initializer ", values.name(), " has invalid values or indices");
+
+  const size_t num_indices = static_cast<size_t>(nnz * (is_linear ? 1 : rank));
+  std::vector<int64_t> indices_data(num_indices);
+  const bool has_raw_data = HasRawData(indices);
+  ORT_RETURN_IF_ERROR(UnpackTensor<int64_t>(indices, has_raw_data ? indices.raw_data().data() : nullptr,
+                                            has_raw_data ? indices.raw_data().size() : 0, indices_data.data(),
+                                            num_indices));
+
+  std::vector<int64_t> positions(static_cast<size_t>(nnz));
+  for (int64_t i = 0; i < nnz; ++i) {
+    int64_t position = 0;
+    if (is_linear) {
+      position = indices_data[i];
+    } else {
+      for (int d = 0; d < rank; ++d) {
+        const int64_t index = indices_data[i * rank + d];
+        ORT_RETURN_IF_NOT(index >= 0 && index < sparse.dims(d), "Sparse initializer ", values.name(),
+                          " has an index out of range");
+        position = position * sparse.dims(d) + index;
+      }
+    }
+    ORT_RETURN_IF_NOT(position >= 0 && position < dense_size, "Sparse initializer ", values.name(),
+                      " has an index out of range");
+    positions[i] = position;
+  }
+
+  dense.Clear();
+  dense.set_name(values.name());
+  dense.set_data_type(values.data_type());
+  for (auto dim : sparse.dims()) {
+    dense.add_dims(dim);
+  }
+
+  switch (values.data_type()) {
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT:
+      return ScatterSparseValues<float>(values, positions, dense_size, dense);
+    case ONNX_NAMESPACE::TensorProto_DataType_DOUBLE:
+      return ScatterSparseValues<double>(values, positions, dense_size, dense);
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16:
+      return ScatterSparseValues<MLFloat16>(values, positions, dense_size, dense);
+    case ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16:
+      return ScatterSparseValues<BFloat16>(values, positions, dense_size, dense);
+    case ONNX_NAMESPACE::TensorProto_DataType_BOOL:
+      return ScatterSparseValues<bool>(values, positions, dense_size, dense);
+    case ONNX_NAMESPACE::TensorProto_DataType_INT8:
+      return ScatterSparseValues<int8_t>(values, positions, dense_size, dense);
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT8:
+      return ScatterSparseValues<uint8_t>(values, positions, dense_size, dense);
+    case ONNX_NAMESPACE::TensorProto_DataType_INT16:
+      return ScatterSparseValues<int16_t>(values, positions, dense_size, dense);
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT16:
+      return ScatterSparseValues<uint16_t>(values, positions, dense_size, dense);
+    case ONNX_NAMESPACE::TensorProto_DataType_INT32:
+      return ScatterSparseValues<int32_t>(values, positions, dense_size, dense);
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT32:
+      return ScatterSparseValues<uint32_t>(values, positions, dense_size, dense);
+    case ONNX_NAMESPACE::TensorProto_DataType_INT64:
+      return ScatterSparseValues<int64_t>(values, positions, dense_size, dense);
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT64:
+      return ScatterSparseValues<uint64_t>(values, positions, dense_size, dense);
+    default:
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Sparse initializer ", values.name(),
+                             " has an unsupported data type ", values.data_type());
+  }
+}
+
 template common::Status GetSizeInBytesFromTensorProto<256>(const ONNX_NAMESPACE::TensorProto& tensor_proto,
                                                            size_t* out);
 template common::Status GetSizeInBytesFromTensorProto<0>(const ONNX_NAMESPACE::TensorProto& tensor_proto, size_t* out);
@@ -35,6 +35,13 @@ common::Status TensorProtoToMLValue(const Env& env, const ORTCHAR_T* tensor_prot
                                     const ONNX_NAMESPACE::TensorProto& input, const MemBuffer& m, OrtValue& value,
                                     OrtCallback& deleter);
 
+/**
+ * Returns true if TensorProtoToMLValue uses the external data of tensor_proto in place, which means it wraps the
+ * memory-mapped file (or a buffer the data was read into) rather than copying it into a preallocated buffer.
+ * Such a tensor doesn't need a preallocated buffer.
+ */
+bool CanUseExternalDataInPlace(const ONNX_NAMESPACE::TensorProto& tensor_proto);
+
 /** Creates a TensorProto from a Tensor.
     @param[in] tensor the Tensor whose data and shape will be used to create the TensorProto.
     @param[in] tensor_proto_name the name of the TensorProto.
@@ -47,6 +54,11 @@ common::Status TensorProtoToMLValue(const Env& env, const ORTCHAR_T* tensor_prot
 ONNX_NAMESPACE::TensorProto TensorToTensorProto(const Tensor& tensor, const std::string& tensor_proto_name,
                                                 const ONNX_NAMESPACE::TypeProto& tensor_proto_type);
 
+/** Converts a SparseTensorProto, such as a sparse initializer, to a dense TensorProto with the same name.
+    The dense data is stored in raw_data, so this requires little-endian format. */
+common::Status SparseTensorProtoToDenseTensorProto(const ONNX_NAMESPACE::SparseTensorProto& sparse,
+                                                   ONNX_NAMESPACE::TensorProto& dense);
+
 ONNXTensorElementDataType CApiElementTypeFromProtoType(int type);
 ONNXTensorElementDataType GetTensorElementType(const ONNX_NAMESPACE::TensorProto& tensor_proto);
 
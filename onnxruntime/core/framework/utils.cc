@@ -3,6 +3,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/framework/utils.h"
 
+#include <chrono>
 #include <iomanip>
 
 
@@ -19,6 +20,7 @@
 #include "core/framework/sequential_executor.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/tracing.h"
 
 namespace ONNX_NAMESPACE {
 std::ostream& operator<<(std::ostream& out, const TensorShapeProto& shape_proto) {
@@ -347,7 +349,8 @@ void FinalizeFeedFetchCopyInfo(const SessionState& session_state,
 static void FinalizeFeedFetchCopyInfo(const SessionState& session_state,
                                       FeedsFetchesManager& feeds_fetches_manager,
                                       const std::vector<OrtValue>& feeds,
-                                      std::vector<OrtValue>& fetches) {
+                                      std::vector<OrtValue>& fetches,
+                                      bool fetches_on_device) {
   if (feeds_fetches_manager.GetDeviceCopyChecks().status == DeviceCopyCheck::NoCopy)
     return;
 
@@ -367,27 +370,50 @@ static void FinalizeFeedFetchCopyInfo(const SessionState& session_state,
   // create default instances if needed
   fetches.resize(num_outputs);
 
+  auto& fetch_copy_info = feeds_fetches_manager.GetMutableFetchesDeviceCopyInfo();
   for (size_t i = 0; i < num_outputs; ++i) {
     const auto& fetch = fetches[i];
     if (fetch.IsAllocated() && fetch.IsTensor()) {
       fetch_alloc_info[i] = &fetch.Get<Tensor>().Location();
+    } else if (fetches_on_device) {
+      // return the output where it was produced
+      fetch_copy_info[i].target_device = fetch_copy_info[i].source_device;
     }
   }
 
   FinalizeFeedFetchCopyInfo(session_state, feeds_fetches_manager, feed_locations, fetch_alloc_info);
 }
 
+// bytes copied by CopyMLValue
+static int64_t CopiedBytes(const MLValueCopyInfo& copy_info, const OrtValue& source_mlvalue) {
+  if (copy_info.source_device == copy_info.target_device || !source_mlvalue.IsTensor()) {
+    return 0;
+  }
+  return static_cast<int64_t>(source_mlvalue.Get<Tensor>().SizeInBytes());
+}
+
+static int64_t ElapsedMicroseconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
 static common::Status CopyInputsAcrossDevices(const std::vector<OrtValue>& orig_feeds,
                                               std::vector<OrtValue>& new_feeds,
                                               const std::vector<MLValueCopyInfo>& copy_info,
-                                              const DataTransferManager& data_transfer_mgr) {
+                                              const DataTransferManager& data_transfer_mgr,
+                                              RunStats* run_stats) {
   size_t num_feeds = orig_feeds.size();
   ORT_ENFORCE(copy_info.size() == num_feeds);
 
   new_feeds.resize(num_feeds);
 
   for (size_t idx = 0; idx < num_feeds; ++idx) {
+    const int64_t bytes = CopiedBytes(copy_info[idx], orig_feeds[idx]);
+    ORT_TRACE_MEMCPY_START("feed", bytes);
     ORT_RETURN_IF_ERROR(CopyMLValue(data_transfer_mgr, copy_info[idx], orig_feeds[idx], new_feeds[idx]));
+    ORT_TRACE_MEMCPY_STOP("feed", bytes);
+    if (run_stats != nullptr) {
+      run_stats->bytes_copied += bytes;
+    }
   }
 
   return Status::OK();
@@ -414,14 +440,21 @@ common::Status CopyOneInputAcrossDevices(const SessionState& session_state, cons
 static common::Status CopyOutputsAcrossDevices(const SessionState& session_state,
                                                const std::vector<OrtValue>& fetches,
                                                std::vector<OrtValue>& user_fetches,
-                                               const std::vector<MLValueCopyInfo>& copy_info) {
+                                               const std::vector<MLValueCopyInfo>& copy_info,
+                                               RunStats* run_stats) {
   auto num_outputs = fetches.size();
   user_fetches.resize(num_outputs);
 
   const auto& data_transfer_mgr = session_state.GetDataTransferMgr();
 
   for (size_t idx = 0; idx < num_outputs; ++idx) {
+    const int64_t bytes = CopiedBytes(copy_info[idx], fetches[idx]);
+    ORT_TRACE_MEMCPY_START("fetch", bytes);
     ORT_RETURN_IF_ERROR(CopyMLValue(data_transfer_mgr, copy_info[idx], fetches[idx], user_fetches[idx]));
+    ORT_TRACE_MEMCPY_STOP("fetch", bytes);
+    if (run_stats != nullptr) {
+      run_stats->bytes_copied += bytes;
+    }
   }
 
   return Status::OK();
@@ -432,7 +465,7 @@ static common::Status ExecuteGraphImpl(const SessionState& session_state,
                                        const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                                        const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
                                        ExecutionMode execution_mode, const bool& terminate_flag,
-                                       const logging::Logger& logger) {
+                                       const logging::Logger& logger, RunStats* run_stats) {
   std::unique_ptr<IExecutor> p_exec;
   if (execution_mode == ExecutionMode::ORT_SEQUENTIAL) {
     p_exec = std::unique_ptr<IExecutor>(new SequentialExecutor(terminate_flag));
@@ -445,6 +478,8 @@ static common::Status ExecuteGraphImpl(const SessionState& session_state,
       p_exec = std::unique_ptr<IExecutor>(new ParallelExecutor(session_state, terminate_flag));
     }
   }
+  p_exec->SetRunStats(run_stats);
+  std::chrono::steady_clock::time_point start;
 
   const auto& feeds_fetches_info = feeds_fetches_manager.GetFeedsFetchesInfo();
   const auto& device_copy_checks = feeds_fetches_manager.GetDeviceCopyChecks();
@@ -452,10 +487,16 @@ static common::Status ExecuteGraphImpl(const SessionState& session_state,
   // see if we can skip copies due to the types of execution providers available
   if (device_copy_checks.status == DeviceCopyCheck::NoCopy) {
     // no device copies are needed so simple execute
+    if (run_stats != nullptr) {
+      start = std::chrono::steady_clock::now();
+    }
     ORT_RETURN_IF_ERROR(p_exec->Execute(session_state,
                                         feeds_fetches_info.feeds_mlvalue_idxs, feeds,
                                         feeds_fetches_info.fetches_mlvalue_idxs, fetches, fetch_allocators,
                                         logger));
+    if (run_stats != nullptr) {
+      run_stats->execution_time_us += ElapsedMicroseconds(start);
+    }
   } else {
     const std::vector<OrtValue>* p_feeds = &feeds;
     std::vector<OrtValue>* p_fetches = &fetches;
@@ -464,8 +505,14 @@ static common::Status ExecuteGraphImpl(const SessionState& session_state,
 
     if (device_copy_checks.input_copy_needed == DeviceCopyCheck::Copy) {
       const auto& feed_copy_info = feeds_fetches_manager.GetFeedsDeviceCopyInfo();
+      if (run_stats != nullptr) {
+        start = std::chrono::steady_clock::now();
+      }
       ORT_RETURN_IF_ERROR(CopyInputsAcrossDevices(feeds, device_feeds, feed_copy_info,
-                                                  session_state.GetDataTransferMgr()));
+                                                  session_state.GetDataTransferMgr(), run_stats));
+      if (run_stats != nullptr) {
+        run_stats->copy_time_us += ElapsedMicroseconds(start);
+      }
       p_feeds = &device_feeds;
     }
 
@@ -488,13 +535,25 @@ static common::Status ExecuteGraphImpl(const SessionState& session_state,
       p_fetches = &device_fetches;
     }
 
+    if (run_stats != nullptr) {
+      start = std::chrono::steady_clock::now();
+    }
     ORT_RETURN_IF_ERROR(p_exec->Execute(session_state,
                                         feeds_fetches_info.feeds_mlvalue_idxs, *p_feeds,
                                         feeds_fetches_info.fetches_mlvalue_idxs, *p_fetches, fetch_allocators,
                                         logger));
+    if (run_stats != nullptr) {
+      run_stats->execution_time_us += ElapsedMicroseconds(start);
+    }
 
     if (device_copy_checks.output_copy_needed == DeviceCopyCheck::Copy) {
-      ORT_RETURN_IF_ERROR(CopyOutputsAcrossDevices(session_state, *p_fetches, fetches, fetch_copy_info));
+      if (run_stats != nullptr) {
+        start = std::chrono::steady_clock::now();
+      }
+      ORT_RETURN_IF_ERROR(CopyOutputsAcrossDevices(session_state, *p_fetches, fetches, fetch_copy_info, run_stats));
+      if (run_stats != nullptr) {
+        run_stats->copy_time_us += ElapsedMicroseconds(start);
+      }
     }
   }
 
@@ -505,24 +564,48 @@ common::Status ExecuteGraph(const SessionState& session_state,
                             FeedsFetchesManager& feeds_fetches_manager,
                             const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                             ExecutionMode execution_mode, const bool& terminate_flag,
-                            const logging::Logger& logger) {
+                            const logging::Logger& logger, bool fetches_on_device) {
   ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(session_state, feeds_fetches_manager));
 
   // finalize the copy info using the provided feeds and fetches. will update device_copy_checks in the background
-  FinalizeFeedFetchCopyInfo(session_state, feeds_fetches_manager, feeds, fetches);
+  FinalizeFeedFetchCopyInfo(session_state, feeds_fetches_manager, feeds, fetches, fetches_on_device);
 
   auto status = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
-                                 execution_mode, terminate_flag, logger);
+                                 execution_mode, terminate_flag, logger, nullptr);
 
   return status;
 }
 
+common::Status ExecuteGraphWithInitializedCopyInfo(const SessionState& session_state,
+                                                   const FeedsFetchesManager& feeds_fetches_manager,
+                                                   const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                                                   ExecutionMode execution_mode, const bool& terminate_flag,
+                                                   const logging::Logger& logger, bool fetches_on_device,
+                                                   RunStats* run_stats) {
+  // with CPU based EPs only the copy info is final already
+  if (feeds_fetches_manager.GetDeviceCopyChecks().status == DeviceCopyCheck::NoCopy) {
+    return ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
+                            execution_mode, terminate_flag, logger, run_stats);
+  }
+
+  // the indices and the static copy info are copied, so no name is looked up again
+  FeedsFetchesInfo info = feeds_fetches_manager.GetFeedsFetchesInfo();
+  FeedsFetchesManager run_feeds_fetches_manager{std::move(info)};
+  run_feeds_fetches_manager.GetMutableFeedsDeviceCopyInfo() = feeds_fetches_manager.GetFeedsDeviceCopyInfo();
+  run_feeds_fetches_manager.GetMutableFetchesDeviceCopyInfo() = feeds_fetches_manager.GetFetchesDeviceCopyInfo();
+
+  FinalizeFeedFetchCopyInfo(session_state, run_feeds_fetches_manager, feeds, fetches, fetches_on_device);
+
+  return ExecuteGraphImpl(session_state, run_feeds_fetches_manager, feeds, fetches, {},
+                          execution_mode, terminate_flag, logger, run_stats);
+}
+
 common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
                                const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                                const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
                                ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger) {
   auto status = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
-                                 execution_mode, terminate_flag, logger);
+                                 execution_mode, terminate_flag, logger, nullptr);
   return status;
 }
 
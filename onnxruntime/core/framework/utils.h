@@ -68,7 +68,19 @@ void FinalizeFeedFetchCopyInfo(const SessionState& session_state,
 // Execute the main graph. The feed_fetches_manager will be finalized based on the provided feeds and fetches.
 common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
                             const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
-                            ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger);
+                            ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
+                            bool fetches_on_device = false);
+
+// Execute the main graph with a feeds_fetches_manager that InitializeFeedFetchCopyInfo was already called for, e.g. by
+// InferenceSession::PrepareRun. It isn't modified so it can be shared by concurrent calls: when device copies may be
+// needed, a copy of it is finalized based on the provided feeds and fetches.
+// If run_stats is not null, the allocations, copies and times of the execution are added to it.
+common::Status ExecuteGraphWithInitializedCopyInfo(const SessionState& session_state,
+                                                   const FeedsFetchesManager& feeds_fetches_manager,
+                                                   const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                                                   ExecutionMode execution_mode, const bool& terminate_flag,
+                                                   const logging::Logger& logger, bool fetches_on_device = false,
+                                                   RunStats* run_stats = nullptr);
 
 // Execute a subgraph. The feeds_fetches_manager should have been finalized prior to calling this function.
 // See IControlFlowNode::SetupSubgraphExecutionInfo usage in the control flow kernels.
@@ -296,21 +296,53 @@ void RegisterBertSchemas() {
       .SetSupportLevel(OpSchema::SupportType::EXPERIMENTAL)
       .SetDoc("Multi-Head Self Attention")
       .Attr("num_heads", "Number of attention heads", AttributeProto::INT)
+      .Attr("unidirectional",
+            "Whether every token can only attend to previous tokens, as in GPT-2. Default value is 0.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
       .Input(0, "input", "3D input tensor with shape (batch_size, sequence_length, hidden_size), hidden_size = num_heads * head_size", "T")
       .Input(1, "weight", "2D input tensor with shape (hidden_size, 3 * hidden_size)", "T")
       .Input(2, "bias", "1D input tensor with shape (3 * hidden_size)", "T")
-      .Input(3, "mask_index", "Attention mask index with shape (batch_size)", "M")
+      .Input(3, "mask_index", "Attention mask index with shape (batch_size)", "M", OpSchema::Optional)
+      .Input(4, "past", "Key and value state of the past tokens with shape (2, batch_size, num_heads, past_sequence_length, head_size). mask_index then counts the past tokens as well.", "T", OpSchema::Optional)
       .Output(0, "output", "3D output tensor with shape (batch_size, sequence_length, hidden_size)", "T")
+      .Output(1, "present", "Key and value state of the past and input tokens with shape (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size), to feed as past with the next tokens", "T", OpSchema::Optional)
       .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
       .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask index to integer types")
-      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput(ctx);
+        if (ctx.getNumOutputs() < 2) {
+          return;
+        }
+        propagateElemTypeFromInputToOutput(ctx, 0, 1);
+        if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 4)) {
+          return;
+        }
+        auto& input_shape = getInputShape(ctx, 0);
+        auto& past_shape = getInputShape(ctx, 4);
+        if (input_shape.dim_size() != 3 || past_shape.dim_size() != 5) {
+          fail_shape_inference("Inputs 0 and 4 shall have 3 and 5 dimensions");
+        }
+        // present is past with the input tokens appended to dimension 3
+        ONNX_NAMESPACE::TensorShapeProto present_shape = past_shape;
+        auto* present_length = present_shape.mutable_dim(3);
+        if (past_shape.dim(3).has_dim_value() && input_shape.dim(1).has_dim_value()) {
+          present_length->set_dim_value(past_shape.dim(3).dim_value() + input_shape.dim(1).dim_value());
+        } else {
+          present_length->clear_dim_value();
+          present_length->clear_dim_param();
+        }
+        updateOutputShape(ctx, 1, present_shape);
+      });
 
   static const char* EmbedLayerNormalization_ver1_doc = R"DOC(
 EmbedLayerNormalization is the fusion of embedding layer in BERT model, with optional mask processing.
 The embedding layer takes input_ids (word IDs) and segment_ids (sentence IDs) to look up word_embedding, position_embedding,
 and segment_emedding; the embeddings are added then applied layer normalization using gamma and beta tensors.
 The last input mask is optional. If mask is provided, mask index (that is position of first 0 in mask, or number of words)
-will be calculated.)DOC";
+will be calculated.
+The embedding tables may be stored in float16, or in int8 with a scale per row given by the optional scale inputs,
+to reduce the size of the model. They are converted to the type of gamma when gathered.)DOC";
 
   ONNX_CONTRIB_OPERATOR_SCHEMA(EmbedLayerNormalization)
       .SetDomain(kMSDomain)
@@ -319,18 +351,26 @@ will be calculated.)DOC";
       .SetDoc(EmbedLayerNormalization_ver1_doc)
       .Input(0, "input_ids", "2D words IDs with shape (batch_size, sequence_length)", "T1")
       .Input(1, "segment_ids", "2D segment IDs with shape (batch_size, sequence_length)", "T1")
-      .Input(2, "word_embedding", "2D with shape (,hidden_size)", "T")
-      .Input(3, "position_embedding", "2D with shape (, hidden_size)", "T")
-      .Input(4, "segment_embedding", "2D with shape (, hidden_size)", "T")
+      .Input(2, "word_embedding", "2D with shape (,hidden_size)", "T2")
+      .Input(3, "position_embedding", "2D with shape (, hidden_size)", "T2")
+      .Input(4, "segment_embedding", "2D with shape (, hidden_size)", "T2")
       .Input(5, "gamma", "1D gamma tensor for layer normalization with shape (hidden_size)", "T")
       .Input(6, "beta", "1D beta tensor for layer normalization  with shape (hidden_size)", "T")
       .Input(7, "mask", "2D attention mask with shape (batch_size, sequence_length)", "T1", OpSchema::Optional)
+      .Input(8, "word_embedding_scale", "1D scale of the rows of an int8 word_embedding", "tensor(float)",
+             OpSchema::Optional)
+      .Input(9, "position_embedding_scale", "1D scale of the rows of an int8 position_embedding", "tensor(float)",
+             OpSchema::Optional)
+      .Input(10, "segment_embedding_scale", "1D scale of the rows of an int8 segment_embedding", "tensor(float)",
+             OpSchema::Optional)
       .Output(0, "output", "3D output tensor with shape (batch_size, sequence_length, hidden_size)", "T")
       .Output(1, "mask_index", "1D mask_index tensor with shape (batch_size)", "T1")
       .TypeConstraint("T1", {"tensor(int32)"}, "Constrain input and output integer tensors types")
       .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output float tensors types.")
+      .TypeConstraint("T2", {"tensor(float)", "tensor(float16)", "tensor(int8)"},
+                      "Constrain embedding tables to float, float16 or int8 tensors.")
       .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
-        propagateElemTypeFromInputToOutput(ctx, 2, 0);
+        propagateElemTypeFromInputToOutput(ctx, 5, 0);
         propagateElemTypeFromInputToOutput(ctx, 0, 1);
         if (!hasInputShape(ctx, 0))
           return;
@@ -1480,6 +1520,96 @@ Matrix product that behaves like numpy.matmul: https://docs.scipy.org/doc/numpy-
         matmulShapeInference(ctx, 0, 1);
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(DynamicQuantizeMatMul)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Matrix product of a float A and a quantized B that behaves like numpy.matmul. A is quantized to uint8 with the scale
+and zero point computed by DynamicQuantizeLinear, multiplied with B in 32-bit integers, and the result is scaled back
+to float with A_scale * b_scale before the optional bias is added. This is equivalent to
+DynamicQuantizeLinear -> MatMulInteger -> Cast -> Mul (-> Add) without the intermediate tensors.)DOC")
+      .Input(0, "A", "N-dimensional matrix A", "T1")
+      .Input(1, "B", "N-dimensional quantized matrix B", "T2")
+      .Input(2, "b_scale", "Scale of B, a scalar or a 1-D tensor of size 1", "T1")
+      .Input(3, "b_zero_point", "Zero point of B, a scalar or a 1-D tensor of size 1. Defaults to 0.", "T2",
+             OpSchema::Optional)
+      .Input(4, "bias", "1-D bias of size N added to each row of the output", "T1", OpSchema::Optional)
+      .Output(0, "Y", "Matrix multiply results from A * B", "T1")
+      .TypeConstraint("T1", {"tensor(float)"}, "Constrain input A, b_scale, bias and output Y to float tensors.")
+      .TypeConstraint("T2", {"tensor(int8)", "tensor(uint8)"}, "Constrain input B data type to 8-bit integer tensor.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        matmulShapeInference(ctx, 0, 1);
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(DynamicQuantizeLSTM)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+LSTM with uint8 weights. It computes like the ONNX LSTM operator, except that W and R are quantized and transposed.
+At every GEMM the float input is quantized to uint8 with the scale and zero point computed by DynamicQuantizeLinear,
+multiplied with the weights in 32-bit integers, and the product is scaled back to float with the scale of the input
+and the scale of each column of the weights. The bias, peepholes and gate activations are computed in float.)DOC")
+      .Attr("activations",
+            "A list of 3 (or 6 if bidirectional) activation functions for input, output, forget, cell, and hidden, "
+            "as in LSTM.",
+            AttributeProto::STRINGS, OPTIONAL)
+      .Attr("activation_alpha", "Optional scaling values used by some activation functions, as in LSTM.",
+            AttributeProto::FLOATS, OPTIONAL)
+      .Attr("activation_beta", "Optional scaling values used by some activation functions, as in LSTM.",
+            AttributeProto::FLOATS, OPTIONAL)
+      .Attr("clip", "Cell clip threshold, as in LSTM. No clip if not specified.", AttributeProto::FLOAT, OPTIONAL)
+      .Attr("input_forget", "Couple the input and forget gates if 1, default 0.", AttributeProto::INT,
+            static_cast<int64_t>(0))
+      .Attr("hidden_size", "Number of neurons in the hidden layer.", AttributeProto::INT)
+      .Attr("direction",
+            "Specify if the RNN is forward, reverse, or bidirectional. Must be one of forward (default), reverse, "
+            "or bidirectional.",
+            AttributeProto::STRING, std::string("forward"))
+      .Input(0, "X", "The input sequences with shape `[seq_length, batch_size, input_size]`.", "T")
+      .Input(1, "W",
+             "The quantized weight tensor for the gates, `W[iofc]` transposed. It has shape "
+             "`[num_directions, input_size, 4*hidden_size]`.",
+             "T2")
+      .Input(2, "R",
+             "The quantized recurrence weight tensor, `R[iofc]` transposed. It has shape "
+             "`[num_directions, hidden_size, 4*hidden_size]`.",
+             "T2")
+      .Input(3, "B", "The bias tensor with shape `[num_directions, 8*hidden_size]`, as in LSTM.", "T",
+             OpSchema::Optional)
+      .Input(4, "sequence_lens", "Optional lengths of the sequences in a batch, with shape `[batch_size]`.", "T1",
+             OpSchema::Optional)
+      .Input(5, "initial_h",
+             "Optional initial value of the hidden, with shape `[num_directions, batch_size, hidden_size]`.", "T",
+             OpSchema::Optional)
+      .Input(6, "initial_c",
+             "Optional initial value of the cell, with shape `[num_directions, batch_size, hidden_size]`.", "T",
+             OpSchema::Optional)
+      .Input(7, "P", "The peephole weights with shape `[num_directions, 3*hidden_size]`, as in LSTM.", "T",
+             OpSchema::Optional)
+      .Input(8, "W_scale",
+             "Scale of W, with shape `[num_directions]`, or `[num_directions, 4*hidden_size]` for a scale per column.",
+             "T")
+      .Input(9, "W_zero_point", "Zero point of W, with shape `[num_directions]`. Defaults to 0.", "T2",
+             OpSchema::Optional)
+      .Input(10, "R_scale",
+             "Scale of R, with shape `[num_directions]`, or `[num_directions, 4*hidden_size]` for a scale per column.",
+             "T")
+      .Input(11, "R_zero_point", "Zero point of R, with shape `[num_directions]`. Defaults to 0.", "T2",
+             OpSchema::Optional)
+      .Output(0, "Y", "A tensor that concats all the intermediate output values of the hidden.", "T",
+              OpSchema::Optional)
+      .Output(1, "Y_h", "The last output value of the hidden.", "T", OpSchema::Optional)
+      .Output(2, "Y_c", "The last output value of the cell.", "T", OpSchema::Optional)
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+      .TypeConstraint("T1", {"tensor(int32)"}, "Constrain seq_lens to integral tensors.")
+      .TypeConstraint("T2", {"tensor(uint8)"}, "Constrain the weights and their zero points to uint8 tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+          propagateElemTypeFromInputToOutput(ctx, 0, i);
+        }
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(ReduceSumInteger)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -1824,6 +1954,12 @@ Output = Dequantize(Input) -> AveragePool on fp32 data -> Quantize(output)
           "If value is 1, output type is uint32_t, else int32_t. Default value is 1.",
           AttributeProto::INT,
           (int64_t)1LL)
+      .Attr(
+          "num_buckets",
+          "If positive, the output is the bucket of each hash for the hashing trick, i.e. the unsigned 32-bit hash "
+          "modulo num_buckets. Default value is 0, which outputs the hashes.",
+          AttributeProto::INT,
+          (int64_t)0LL)
       .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
         // type inference
         auto positive_attr = ctx.getAttribute("positive");
@@ -2253,7 +2389,7 @@ Example 4:
           {"tensor(float)"},
           "Constrain mean and inv_std_var to be float tensors.")
       .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
-        propagateShapeAndTypeFromFirstInput(ctx);
+        ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput(ctx);
         propagateElemTypeFromInputToOutput(ctx, 0, 0);
         if (!hasNInputShapes(ctx, 1)) {
           return;
@@ -2324,6 +2460,212 @@ It's an extension of Gelu. It takes the sum of input A and bias input B as the i
           "Constrain input and output types to float tensors.")
       .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
 
+  static const char* GatherSum_ver1_doc =
+      R"DOC(Gathers rows of 'data' along axis 0 and sums the rows selected by each row of 'indices', as done by an
+embedding bag. It's the fusion of Gather with axis 0 followed by ReduceSum over the last axis of 'indices' with
+keepdims=0. The output has the shape of 'indices' without its last axis, followed by the shape of 'data' without its
+first axis. Negative indices count back from the end of axis 0.)DOC";
+  ONNX_CONTRIB_OPERATOR_SCHEMA(GatherSum)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetSupportLevel(OpSchema::SupportType::EXPERIMENTAL)
+      .SetDoc(GatherSum_ver1_doc)
+      .Input(0, "data", "Tensor of rank r >= 1, usually an embedding table.", "T")
+      .Input(1, "indices", "Tensor of rank q >= 1. Each row of the last axis lists the rows of 'data' to sum.", "Tind")
+      .Output(0, "output", "Tensor of rank q - 1 + r - 1.", "T")
+      .TypeConstraint(
+          "T",
+          {"tensor(float)"},
+          "Constrain input and output types to float tensors.")
+      .TypeConstraint(
+          "Tind",
+          {"tensor(int32)", "tensor(int64)"},
+          "Constrain indices to integer types.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 1)) {
+          return;
+        }
+
+        const auto& data_shape = getInputShape(ctx, 0);
+        const auto& indices_shape = getInputShape(ctx, 1);
+        if (data_shape.dim_size() < 1 || indices_shape.dim_size() < 1) {
+          fail_shape_inference("data and indices must have rank 1 or more");
+        }
+
+        ONNX_NAMESPACE::TensorShapeProto output_shape;
+        for (int i = 0; i < indices_shape.dim_size() - 1; ++i) {
+          *output_shape.add_dim() = indices_shape.dim(i);
+        }
+        for (int i = 1; i < data_shape.dim_size(); ++i) {
+          *output_shape.add_dim() = data_shape.dim(i);
+        }
+        updateOutputShape(ctx, 0, output_shape);
+      });
+
+  static const char* FusedElementwise_ver1_doc =
+      R"DOC(Evaluates a chain of elementwise ops, as fused by the elementwise fusion, in a single pass over the output.
+The ops in 'ops' run in order and the result of the last one is the output. 'operands' lists two operands for each
+op: an index below the number of inputs refers to that input, and the index (number of inputs + k) refers to the
+result of op k, which must come before the op reading it. The second operand of a unary op is -1.
+The supported ops are Add, Sub, Mul, Div, Max and Min with two operands, and Abs, Neg, Sqrt, Exp, Erf, Relu, Sigmoid
+and Tanh with one. The inputs are broadcast with numpy rules, but only over the leading axes of the output: each
+input without its leading axes of size 1 must match the trailing axes of the output.)DOC";
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedElementwise)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetSupportLevel(OpSchema::SupportType::EXPERIMENTAL)
+      .SetDoc(FusedElementwise_ver1_doc)
+      .Input(0, "inputs", "The inputs of the fused ops.", "T", OpSchema::Variadic)
+      .Output(0, "Y", "The result of the last op.", "T")
+      .Attr("ops", "The op types of the fused ops, in evaluation order.", AttributeProto::STRINGS)
+      .Attr("operands", "The two operands of each op.", AttributeProto::INTS)
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        for (size_t i = 0; i < ctx.getNumInputs(); ++i) {
+          if (!hasInputShape(ctx, i)) {
+            return;
+          }
+        }
+
+        ONNX_NAMESPACE::TensorShapeProto output_shape = getInputShape(ctx, 0);
+        for (size_t i = 1; i < ctx.getNumInputs(); ++i) {
+          ONNX_NAMESPACE::TensorShapeProto broadcast_shape;
+          bidirectionalBroadcastShapeInference(output_shape, getInputShape(ctx, i), broadcast_shape);
+          output_shape = broadcast_shape;
+        }
+        updateOutputShape(ctx, 0, output_shape);
+      });
+
+  static const char* SparseMatMul_ver1_doc = R"DOC(
+Matrix product of a dense A and a sparse B, like MatMul with a 2-D B: Y = A * B (+ bias).
+B has K rows and 'N' columns, and is given in compressed sparse row (CSR) form: the values of the non-zero elements
+of row k are B_values[B_row_offsets[k]:B_row_offsets[k + 1]], and B_col_indices holds their columns.
+The last dimension of A is K, and Y has the shape of A with its last dimension replaced by N.)DOC";
+  ONNX_CONTRIB_OPERATOR_SCHEMA(SparseMatMul)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetSupportLevel(OpSchema::SupportType::EXPERIMENTAL)
+      .SetDoc(SparseMatMul_ver1_doc)
+      .Input(0, "A", "N-dimensional dense matrix A, with K as its last dimension", "T")
+      .Input(1, "B_values", "1-D tensor with the values of the non-zero elements of B, row by row", "T")
+      .Input(2, "B_col_indices", "1-D tensor with the column of each value in B_values", "tensor(int32)")
+      .Input(3, "B_row_offsets", "1-D tensor of size K + 1 with the offset of the first value of each row of B",
+             "tensor(int64)")
+      .Input(4, "bias", "1-D tensor of size N added to each row of the product", "T", OpSchema::Optional)
+      .Output(0, "Y", "Matrix multiply results", "T")
+      .Attr("N", "The number of columns of B.", AttributeProto::INT)
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasInputShape(ctx, 0)) {
+          return;
+        }
+
+        const auto& a_shape = getInputShape(ctx, 0);
+        if (a_shape.dim_size() < 1) {
+          fail_shape_inference("A must have at least one dimension");
+        }
+
+        ONNX_NAMESPACE::TensorShapeProto output_shape = a_shape;
+        output_shape.mutable_dim(a_shape.dim_size() - 1)->set_dim_value(getAttribute(ctx, "N", 0));
+        updateOutputShape(ctx, 0, output_shape);
+      });
+
+  static const char* FusedLinearClassifier_ver1_doc = R"DOC(
+A LinearClassifier (ai.onnx.ml) whose input first goes through a chain of Scaler, Normalizer and Binarizer
+(ai.onnx.ml) ops, as fused by the linear classifier fusion. 'steps' lists the preprocessing ops in order, each at most
+once, and the attributes of each op keep their names: 'scale' and 'offset' for Scaler, 'norm' for Normalizer and
+'threshold' for Binarizer. The other attributes and the outputs are those of LinearClassifier.)DOC";
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedLinearClassifier)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetSupportLevel(OpSchema::SupportType::EXPERIMENTAL)
+      .SetDoc(FusedLinearClassifier_ver1_doc)
+      .Input(0, "X", "Data to be classified, [N,C] or [C]", "T1")
+      .Output(0, "Y", "Classification outputs (one class per example).", "T2")
+      .Output(1, "Z", "Classification scores ([N,E] - one score for each class and example", "tensor(float)")
+      .Attr("steps", "The preprocessing ops, in order: Scaler, Normalizer or Binarizer.", AttributeProto::STRINGS)
+      .Attr("scale", "Scaler: multiply by this, after the offset.", AttributeProto::FLOATS, OPTIONAL)
+      .Attr("offset", "Scaler: subtract this first.", AttributeProto::FLOATS, OPTIONAL)
+      .Attr("norm", "Normalizer: one of 'MAX', 'L1', 'L2'.", std::string("MAX"))
+      .Attr("threshold", "Binarizer: values greater than this are mapped to 1, others to 0.", 1.f)
+      .Attr("coefficients", "A collection of weights of the model(s).", AttributeProto::FLOATS)
+      .Attr("intercepts", "A collection of intercepts.", AttributeProto::FLOATS, OPTIONAL)
+      .Attr("multi_class", "Indicates whether to do OvR or multinomial (0=OvR is the default).",
+            static_cast<int64_t>(0))
+      .Attr("classlabels_strings", "Class labels when using string labels.", AttributeProto::STRINGS, OPTIONAL)
+      .Attr("classlabels_ints", "Class labels when using integer labels.", AttributeProto::INTS, OPTIONAL)
+      .Attr("post_transform", "One of 'NONE,' 'SOFTMAX,' 'LOGISTIC,' 'SOFTMAX_ZERO,' or 'PROBIT'",
+            std::string("NONE"))
+      .TypeConstraint("T1", {"tensor(float)"}, "The input must be a float tensor.")
+      .TypeConstraint("T2", {"tensor(string)", "tensor(int64)"},
+                      "The output will be a tensor of strings or integers.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        std::vector<std::string> label_strs;
+        const bool using_strings = getRepeatedAttribute(ctx, "classlabels_strings", label_strs) &&
+                                   !label_strs.empty();
+        ctx.getOutputType(0)->mutable_tensor_type()->set_elem_type(
+            using_strings ? ONNX_NAMESPACE::TensorProto::STRING : ONNX_NAMESPACE::TensorProto::INT64);
+        ctx.getOutputType(1)->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto::FLOAT);
+      });
+
+  static const char* BeamSearch_ver1_doc = R"DOC(
+Generates sequences by beam search, or greedy search with num_beams equal to 1, running the 'decoder' subgraph once
+per generated token. The decoder has the inputs (input_ids, position_ids, past_0, ..., past_{L-1}) and the outputs
+(logits, present_0, ..., present_{L-1}). input_ids and position_ids are int64 tensors of shape
+(batch_size * num_beams, sequence_length), logits is a float tensor of shape
+(batch_size * num_beams, sequence_length, vocab_size), and past_i and present_i hold the key/value state of a layer
+like the past and present of Attention, with shapes (2, batch_size * num_beams, num_heads, past_sequence_length,
+head_size) and (2, batch_size * num_beams, num_heads, past_sequence_length + sequence_length, head_size). num_heads
+and head_size must be static in the declared shapes of the past inputs. The first step runs the decoder on the whole
+prompt with an empty past, and each following step on the last token of every beam with the state of the tokens
+before it. The score of a sequence is its sum of log probabilities divided by its length to the power of
+length_penalty.)DOC";
+  ONNX_CONTRIB_OPERATOR_SCHEMA(BeamSearch)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetSupportLevel(OpSchema::SupportType::EXPERIMENTAL)
+      .SetDoc(BeamSearch_ver1_doc)
+      .Attr("decoder", "The decoder subgraph run for each generated token.", AttributeProto::GRAPH)
+      .Attr("eos_token_id", "The id of the token ending a sequence.", AttributeProto::INT)
+      .Attr("pad_token_id", "The id of the token padding the sequences shorter than max_length. Defaults to "
+                            "eos_token_id.",
+            AttributeProto::INT, OPTIONAL)
+      .Attr("early_stopping", "Stop the search of a batch entry as soon as num_beams sequences are finished.",
+            static_cast<int64_t>(0))
+      .Input(0, "input_ids", "The prompts, of shape (batch_size, sequence_length).", "I")
+      .Input(1, "max_length", "Scalar. The length of the generated sequences, prompt included.", "I")
+      .Input(2, "num_beams", "Scalar. The number of beams. Defaults to 1, greedy search.", "I", OpSchema::Optional)
+      .Input(3, "num_return_sequences", "Scalar. The number of sequences returned for each prompt, at most num_beams. "
+             "Defaults to 1.", "I", OpSchema::Optional)
+      .Input(4, "length_penalty", "Scalar. The exponent of the length dividing the score of a sequence. "
+             "Defaults to 1.", "tensor(float)", OpSchema::Optional)
+      .Output(0, "sequences", "The generated sequences padded with pad_token_id, of shape "
+              "(batch_size, num_return_sequences, max_length).", "I")
+      .Output(1, "sequences_scores", "The scores of the sequences, of shape (batch_size, num_return_sequences).",
+              "tensor(float)", OpSchema::Optional)
+      .TypeConstraint("I", {"tensor(int64)"}, "Constrain the token ids to int64 tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        // flow the declared input types of the decoder through it, the kernel checks the actual shapes
+        auto* decoder = ctx.getAttribute("decoder");
+        auto* graph_inferencer = ctx.getGraphAttributeInferencer("decoder");
+        if (decoder != nullptr && decoder->has_g() && graph_inferencer != nullptr) {
+          std::vector<const ONNX_NAMESPACE::TypeProto*> subgraph_input_types;
+          for (const auto& input : decoder->g().input()) {
+            subgraph_input_types.push_back(&input.type());
+          }
+          std::vector<const ONNX_NAMESPACE::TensorProto*> subgraph_input_data(subgraph_input_types.size(), nullptr);
+          graph_inferencer->doInferencing(subgraph_input_types, subgraph_input_data);
+        }
+
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (ctx.getNumOutputs() > 1) {
+          ctx.getOutputType(1)->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto::FLOAT);
+        }
+      });
+
   RegisterBertSchemas();
 
 }
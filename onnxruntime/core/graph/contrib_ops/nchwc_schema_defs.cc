@@ -59,10 +59,39 @@ void RegisterNchwcSchemas() {
       .SetDomain(kMSNchwcDomain)
       .SinceVersion(1)
       .SetDoc(R"DOC(For internal use.)DOC")
+      .Attr("channels_last", "", AttributeProto::INT, static_cast<int64_t>(0))
       .Input(0, "X", "", "T")
       .Output(0, "Y", "", "T")
       .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
-      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasNInputShapes(ctx, 1)) {
+          return;
+        }
+
+        auto input_shape = ctx.getInputType(0)->tensor_type().shape();
+        auto channels_last = getAttribute(ctx, "channels_last", 0);
+        if (channels_last == 0) {
+          updateOutputShape(ctx, 0, input_shape);
+          return;
+        }
+
+        auto input_rank = input_shape.dim_size();
+        if (input_rank < 2) {
+          fail_shape_inference("tensor rank too small");
+        }
+
+        auto output_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+
+        // Copy batch dimension.
+        *output_shape->add_dim() = input_shape.dim(0);
+
+        // Move the channel dimension in front of the spatial dimensions.
+        *output_shape->add_dim() = input_shape.dim(input_rank - 1);
+        for (int i = 1; i < input_rank - 1; i++) {
+          *output_shape->add_dim() = input_shape.dim(i);
+        }
+      });
 
   ONNX_CONTRIB_OPERATOR_SCHEMA(ReorderOutput)
       .SetDomain(kMSNchwcDomain)
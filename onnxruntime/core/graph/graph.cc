@@ -172,14 +172,39 @@ const TensorShapeProto* NodeArg::Shape() const {
   }
 }
 
+static bool IsSameShape(const TensorShapeProto& a, const TensorShapeProto& b) {
+  if (a.dim_size() != b.dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < a.dim_size(); ++i) {
+    const auto& a_dim = a.dim(i);
+    const auto& b_dim = b.dim(i);
+    if (a_dim.value_case() != b_dim.value_case() || a_dim.denotation() != b_dim.denotation() ||
+        (utils::HasDimValue(a_dim) && a_dim.dim_value() != b_dim.dim_value()) ||
+        (utils::HasDimParam(a_dim) && a_dim.dim_param() != b_dim.dim_param())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 void NodeArg::SetShape(const TensorShapeProto& shape) {
+  const auto* current_shape = Shape();
+  if (current_shape != nullptr && IsSameShape(*current_shape, shape)) {
+    return;
+  }
+
   const auto type_case = node_arg_info_.type().value_case();
   switch (type_case) {
     case TypeProto::kTensorType:
       *(node_arg_info_.mutable_type()->mutable_tensor_type()->mutable_shape()) = shape;
+      ++version_;
       break;
     case TypeProto::kSparseTensorType:
       *(node_arg_info_.mutable_type()->mutable_sparse_tensor_type()->mutable_shape()) = shape;
+      ++version_;
       break;
     case TypeProto::kSequenceType:
     case TypeProto::kMapType:
@@ -191,6 +216,11 @@ void NodeArg::SetShape(const TensorShapeProto& shape) {
 }
 
 void NodeArg::ClearShape() {
+  if (Shape() == nullptr) {
+    return;
+  }
+
+  ++version_;
   const auto type_case = node_arg_info_.type().value_case();
   switch (type_case) {
     case TypeProto::kTensorType:
@@ -212,6 +242,7 @@ common::Status NodeArg::UpdateTypeAndShape(const ONNX_NAMESPACE::TypeProto& inpu
   if (!utils::HasType(node_arg_info_)) {
     *node_arg_info_.mutable_type() = input_type;
     type_ = DataTypeUtils::ToType(node_arg_info_.type());
+    ++version_;
     return Status::OK();
   }
 
@@ -237,9 +268,14 @@ common::Status NodeArg::UpdateTypeAndShape(const ONNX_NAMESPACE::TypeProto& inpu
       if (utils::HasShape(input_tensor_type)) {
         auto& current_tensor_type = *current_type.mutable_tensor_type();
         if (utils::HasShape(current_tensor_type)) {
+          const TensorShapeProto previous_shape = current_tensor_type.shape();
           ORT_RETURN_IF_ERROR(MergeShapeInfo(Name(), input_tensor_type, current_tensor_type, strict, logger));
+          if (!utils::HasShape(current_tensor_type) || !IsSameShape(previous_shape, current_tensor_type.shape())) {
+            ++version_;
+          }
         } else {
           current_tensor_type = input_tensor_type;
+          ++version_;
         }
       }
 
@@ -262,6 +298,7 @@ common::Status NodeArg::UpdateTypeAndShape(const ONNX_NAMESPACE::TypeProto& inpu
           // mergeInShapeInfo(input_tensor_type, current_tensor_type);
         } else {
           current_tensor_type = input_tensor_type;
+          ++version_;
         }
       }
     } break;
@@ -291,11 +328,13 @@ void NodeArg::SetType(DataType p_type) {
 
   type_ = p_type;
   *(node_arg_info_.mutable_type()) = DataTypeUtils::ToTypeProto(p_type);
+  ++version_;
 }
 
 void NodeArg::SetType(const TypeProto& type_proto) {
   type_ = DataTypeUtils::ToType(type_proto);
   *(node_arg_info_.mutable_type()) = type_proto;
+  ++version_;
 }
 
 bool NodeArg::Exists() const noexcept {
@@ -496,6 +535,7 @@ void Node::CreateSubgraph(const std::string& attr_name) {
 void Node::AddAttribute(const std::string& attr_name, const AttributeProto& value) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  ++attributes_version_;
   attributes_[attr_name] = value;
 }
 
@@ -503,6 +543,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
   void Node::AddAttribute(const std::string& attr_name, const type& value) { \
     graph_->SetGraphResolveNeeded();                                         \
     graph_->SetGraphProtoSyncNeeded();                                       \
+    ++attributes_version_;                                                   \
     AttributeProto a;                                                        \
     a.set_name(attr_name);                                                   \
     a.set_type(enumType);                                                    \
@@ -514,6 +555,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
   void Node::AddAttribute(const std::string& attr_name, const type& value) { \
     graph_->SetGraphResolveNeeded();                                         \
     graph_->SetGraphProtoSyncNeeded();                                       \
+    ++attributes_version_;                                                   \
     AttributeProto a;                                                        \
     a.set_name(attr_name);                                                   \
     a.set_type(enumType);                                                    \
@@ -526,6 +568,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
                           const std::vector<type>& values) { \
     graph_->SetGraphResolveNeeded();                         \
     graph_->SetGraphProtoSyncNeeded();                       \
+    ++attributes_version_;                                   \
     AttributeProto a;                                        \
     a.set_name(attr_name);                                   \
     a.set_type(enumType);                                    \
@@ -538,6 +581,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
 void Node::AddAttribute(const std::string& attr_name, const GraphProto& value) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  ++attributes_version_;
   AttributeProto a;
   a.set_name(attr_name);
   a.set_type(AttributeProto_AttributeType::AttributeProto_AttributeType_GRAPH);
@@ -562,6 +606,7 @@ ADD_LIST_ATTR_IMPL(SparseTensorProto, AttributeProto_AttributeType::AttributePro
 bool Node::ClearAttribute(const std::string& attr_name) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  ++attributes_version_;
   return attributes_.erase(attr_name) > 0;
 }
 
@@ -734,15 +779,28 @@ Graph::Graph(const Model& owning_model,
     // Copy constant nodes _value to name_to_initial_tensor_
     const gsl::not_null<TensorProto*> tensor{graph_proto_->add_initializer()};
     const AttributeProto& constant_attribute = node.attribute(0);
-    // TODO: Add support for parsing 'sparse_value' attribute from a 'Constant' node
-    // Discussion surrounding handling the SparseTensorProto must be had.
-    // An easy way is to implement a method that converts a SparseTensorproto into a TensorProto
-    // to use the same downstream flow, but that is going to impact peak memory usage and probably a smarter way is required.
-    ORT_ENFORCE(constant_attribute.has_t(), "Only 'value' attribute is supported within a 'Constant' node in ORT");
-    *tensor = constant_attribute.t();
+    if (constant_attribute.has_sparse_tensor()) {
+      // a sparse value is made dense like the sparse initializers below
+      auto status = utils::SparseTensorProtoToDenseTensorProto(constant_attribute.sparse_tensor(), *tensor);
+      ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+    } else {
+      ORT_ENFORCE(constant_attribute.has_t(),
+                  "Only 'value' and 'sparse_value' attributes are supported within a 'Constant' node in ORT");
+      *tensor = constant_attribute.t();
+    }
     *(tensor->mutable_name()) = node.output(0);
   }
 
+  // Sparse initializers are converted to dense ones so they go through the same flow as the other initializers.
+  // The kernels that benefit from sparse weights get them in their own sparse form from the transformers, e.g. the
+  // SparseMatMulTransformer, which looks for weights with mostly zeros whether they were sparse in the model or not.
+  for (const auto& sparse_tensor : graph_proto_->sparse_initializer()) {
+    const gsl::not_null<TensorProto*> tensor{graph_proto_->add_initializer()};
+    auto status = utils::SparseTensorProtoToDenseTensorProto(sparse_tensor, *tensor);
+    ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+  }
+  graph_proto_->clear_sparse_initializer();
+
   // Remove constant nodes as they're replaced with initializers above.
   const gsl::not_null<RepeatedPtrField<NodeProto>*> graph_mutable_nodes{graph_proto_->mutable_node()};
   graph_mutable_nodes->erase(
@@ -1786,6 +1844,15 @@ Status Graph::VerifyNodeAndOpMatch() {
     // Node verification.
     auto& node = *GetNode(node_index);
 
+    // a node was verified in a previous Resolve, and the types and shapes of its outputs are still valid if nothing
+    // it depends on has changed since then.
+    if (IsInferenceUpToDate(node)) {
+      for (const auto* output_def : node.OutputDefs()) {
+        lsc.output_names.insert(output_def->Name());
+      }
+      continue;
+    }
+
     NodeProto node_proto;
     node.ToProto(node_proto);
     auto& node_name = node.Name();
@@ -1859,6 +1926,7 @@ Status Graph::VerifyNodeAndOpMatch() {
     }
 
     NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op)));
+    SetInferenceUpToDate(node);
 
     // Accumulate output names of the iterated Node
     for (auto& output_name : node_proto.output()) {
@@ -1869,6 +1937,49 @@ Status Graph::VerifyNodeAndOpMatch() {
   return Status::OK();
 }
 
+bool Graph::IsInferenceUpToDate(const Node& node) const {
+  // subgraphs are inferred from their parent node, and the types of their outer scope values aren't tracked here,
+  // so nodes with subgraphs and the nodes of subgraphs are always inferred.
+  if (parent_graph_ != nullptr || node.ContainsSubgraph() || node.Op() == nullptr) {
+    return false;
+  }
+
+  auto entry = inferred_node_states_.find(node.Index());
+  if (entry == inferred_node_states_.cend()) {
+    return false;
+  }
+
+  const InferredNodeState& state = entry->second;
+  const auto& input_defs = node.GetDefinitions().input_defs;
+  if (state.op != node.Op() || state.attributes_version != node.attributes_version_ ||
+      state.inputs.size() != input_defs.size() || state.outputs != node.GetDefinitions().output_defs) {
+    return false;
+  }
+
+  for (size_t i = 0; i < input_defs.size(); ++i) {
+    if (state.inputs[i].first != input_defs[i] || state.inputs[i].second != input_defs[i]->version_) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void Graph::SetInferenceUpToDate(const Node& node) {
+  if (parent_graph_ != nullptr || node.ContainsSubgraph()) {
+    return;
+  }
+
+  InferredNodeState& state = inferred_node_states_[node.Index()];
+  state.op = node.Op();
+  state.attributes_version = node.attributes_version_;
+  state.inputs.clear();
+  for (const auto* input_def : node.InputDefs()) {
+    state.inputs.emplace_back(input_def, input_def->version_);
+  }
+  state.outputs = node.GetDefinitions().output_defs;
+}
+
 void Graph::FindAllSubgraphs(std::vector<Graph*>& subgraphs) {
   for (auto& node : Nodes()) {
     for (auto& subgraph : node.MutableSubgraphs()) {
@@ -2056,6 +2167,12 @@ void Graph::AddInitializedTensor(const TensorProto& tensor) {
   *(tensor_added) = tensor;
   name_to_initial_tensor_[tensor.name()] = tensor_added;
 
+  // the value is now known, which may improve the shapes inferred for its consumers
+  auto* node_arg = GetNodeArg(tensor.name());
+  if (node_arg != nullptr) {
+    ++node_arg->version_;
+  }
+
   if (!GraphLoadedFromModelFile(graph_proto_) && GetNodeArg(tensor.name()) == nullptr) {
     // make sure there is a NodeArg for the initializer as SetGraphInputsOutputs may add it to the graph inputs.
     // the shape will be set to the correct value in TypeCheckInputsAndInitializers as we don't yet know whether there
@@ -2089,6 +2206,11 @@ void Graph::RemoveInitializedTensor(const std::string& tensor_name) {
   if (found) {
     name_to_initial_tensor_.erase(tensor_name);
     SetGraphResolveNeeded();
+
+    auto* node_arg = GetNodeArg(tensor_name);
+    if (node_arg != nullptr) {
+      ++node_arg->version_;
+    }
   }
 
   auto& mutable_initializers = *(graph_proto_->mutable_initializer());
@@ -2137,6 +2259,12 @@ Status Graph::ReplaceInitializedTensor(const ONNX_NAMESPACE::TensorProto& new_in
 
   **existing_entry = new_initializer;
 
+  // shape inferencing of the consumers may have used the previous value
+  auto* node_arg = GetNodeArg(initializer_name);
+  if (node_arg != nullptr) {
+    ++node_arg->version_;
+  }
+
   return Status::OK();
 }
 
@@ -2716,6 +2844,7 @@ bool Graph::ReleaseNode(NodeIndex index) {
   // index is valid, but the entry may already be empty
   if (nodes_[index] != nullptr) {
     nodes_[index] = nullptr;
+    inferred_node_states_.erase(index);
     --num_of_nodes_;
     graph_proto_sync_needed_ = true;
     graph_resolve_needed_ = true;
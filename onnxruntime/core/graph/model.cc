@@ -3,6 +3,7 @@
 
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/model.h"
+#include <climits>
 #include <memory>
 #include "core/common/logging/logging.h"
 
@@ -19,6 +20,7 @@
 
 #include "gsl/gsl"
 
+#include "core/common/path.h"
 #include "core/platform/env.h"
 #include "core/graph/schema_registry.h"
 using namespace ONNX_NAMESPACE;
@@ -387,6 +389,177 @@ Status Model::Load(const PathString& file_path,
   return LoadModel(file_path, model_proto);
 }
 
+namespace {
+
+// a field of a serialized message: its number, its bytes with the tag, and the payload of a length-delimited field
+struct WireField {
+  uint32_t number;
+  const uint8_t* begin;
+  const uint8_t* end;
+  const uint8_t* payload;
+  size_t payload_size;
+};
+
+bool ReadVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+  value = 0;
+  for (int shift = 0; shift < 64 && p < end; shift += 7) {
+    const uint8_t byte = *p++;
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// splits a serialized message into its fields, without parsing them. false if it isn't well formed or has groups.
+bool SplitWireFields(const uint8_t* begin, const uint8_t* end, std::vector<WireField>& fields) {
+  const uint8_t* p = begin;
+  while (p < end) {
+    WireField field{};
+    field.begin = p;
+    uint64_t tag;
+    if (!ReadVarint(p, end, tag)) {
+      return false;
+    }
+    field.number = static_cast<uint32_t>(tag >> 3);
+    uint64_t value;
+    switch (tag & 7) {
+      case 0:  // varint
+        if (!ReadVarint(p, end, value)) return false;
+        break;
+      case 1:  // fixed64
+        if (end - p < 8) return false;
+        p += 8;
+        break;
+      case 2:  // length-delimited
+        if (!ReadVarint(p, end, value) || value > static_cast<uint64_t>(end - p)) return false;
+        field.payload = p;
+        field.payload_size = static_cast<size_t>(value);
+        p += value;
+        break;
+      case 5:  // fixed32
+        if (end - p < 4) return false;
+        p += 4;
+        break;
+      default:
+        return false;
+    }
+    field.end = p;
+    fields.push_back(field);
+  }
+  return true;
+}
+
+void AppendWireField(const WireField& field, std::string& out) {
+  out.append(reinterpret_cast<const char*>(field.begin), field.end - field.begin);
+}
+
+void AddExternalDataEntry(TensorProto& tensor, const std::string& key, const std::string& value) {
+  auto* entry = tensor.add_external_data();
+  entry->set_key(key);
+  entry->set_value(value);
+}
+
+// parses an initializer of the main graph, with its raw data of at least min_referenced_bytes left in the file
+bool ParseInitializer(const WireField& initializer, const uint8_t* file_begin, const std::string& location,
+                      size_t min_referenced_bytes, TensorProto& tensor) {
+  std::vector<WireField> fields;
+  if (!SplitWireFields(initializer.payload, initializer.payload + initializer.payload_size, fields)) {
+    return false;
+  }
+  std::string serialized_without_raw_data;
+  const WireField* raw_data = nullptr;
+  for (const auto& field : fields) {
+    if (field.number == TensorProto::kRawDataFieldNumber && field.payload != nullptr) {
+      raw_data = &field;  // the last one wins, like in a parse
+    } else {
+      AppendWireField(field, serialized_without_raw_data);
+    }
+  }
+  if (!tensor.ParseFromString(serialized_without_raw_data)) {
+    return false;
+  }
+  if (raw_data == nullptr) {
+    return true;
+  }
+  if (raw_data->payload_size < min_referenced_bytes || tensor.data_location() == TensorProto_DataLocation_EXTERNAL ||
+      tensor.data_type() == TensorProto_DataType_STRING) {
+    tensor.set_raw_data(raw_data->payload, raw_data->payload_size);
+    return true;
+  }
+  tensor.set_data_location(TensorProto_DataLocation_EXTERNAL);
+  AddExternalDataEntry(tensor, "location", location);
+  AddExternalDataEntry(tensor, "offset", std::to_string(raw_data->payload - file_begin));
+  AddExternalDataEntry(tensor, "length", std::to_string(raw_data->payload_size));
+  return true;
+}
+
+}  // namespace
+
+Status Model::LoadReferencingInitializerData(const PathString& file_path, ModelProto& model_proto,
+                                             size_t min_referenced_bytes) {
+  size_t file_length;
+  ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(file_path.c_str(), file_length));
+  Env::MappedMemoryPtr mapped_file;
+  if (file_length == 0 || file_length > static_cast<size_t>(INT_MAX) ||
+      !Env::Default().MapFileIntoMemory(file_path.c_str(), 0, file_length, mapped_file).IsOK()) {
+    return Load(file_path, model_proto);
+  }
+
+  Path path;
+  ORT_RETURN_IF_ERROR(Path::Parse(file_path, path));
+  ORT_RETURN_IF(path.GetComponents().empty(), "Invalid model path ", ToMBString(file_path));
+  // the external data is relative to the directory of the model
+  const std::string location = ToMBString(path.GetComponents().back());
+
+  // only the pages of the graph structure are read: the raw data of the large initializers stays in the file, where
+  // the session state maps or reads it when it creates the initializers
+  const auto* file_begin = reinterpret_cast<const uint8_t*>(mapped_file.get());
+  std::vector<WireField> model_fields;
+  ORT_RETURN_IF_NOT(SplitWireFields(file_begin, file_begin + file_length, model_fields),
+                    "Failed to load model because protobuf parsing failed.");
+  std::string serialized_model_without_graph;
+  const WireField* graph = nullptr;
+  for (const auto& field : model_fields) {
+    if (field.number == ModelProto::kGraphFieldNumber && field.payload != nullptr) {
+      if (graph != nullptr) {
+        // graphs in several fields are merged by the parse
+        return Load(file_path, model_proto);
+      }
+      graph = &field;
+    } else {
+      AppendWireField(field, serialized_model_without_graph);
+    }
+  }
+  ORT_RETURN_IF_NOT(model_proto.ParseFromString(serialized_model_without_graph),
+                    "Failed to load model because protobuf parsing failed.");
+  if (graph == nullptr) {
+    return Status::OK();
+  }
+
+  std::vector<WireField> graph_fields;
+  ORT_RETURN_IF_NOT(SplitWireFields(graph->payload, graph->payload + graph->payload_size, graph_fields),
+                    "Failed to load model because protobuf parsing failed.");
+  std::string serialized_graph_without_initializers;
+  for (const auto& field : graph_fields) {
+    if (field.number != GraphProto::kInitializerFieldNumber || field.payload == nullptr) {
+      AppendWireField(field, serialized_graph_without_initializers);
+    }
+  }
+  GraphProto* graph_proto = model_proto.mutable_graph();
+  ORT_RETURN_IF_NOT(graph_proto->ParseFromString(serialized_graph_without_initializers),
+                    "Failed to load model because protobuf parsing failed.");
+  for (const auto& field : graph_fields) {
+    if (field.number == GraphProto::kInitializerFieldNumber && field.payload != nullptr) {
+      ORT_RETURN_IF_NOT(ParseInitializer(field, file_begin, location, min_referenced_bytes,
+                                         *graph_proto->add_initializer()),
+                        "Failed to load model because protobuf parsing failed.");
+    }
+  }
+  return Status::OK();
+}
+
 GSL_SUPPRESS(r .30)  // spurious warnings. p_model is potentially reset in the internal call to Load
 GSL_SUPPRESS(r .35)
 Status Model::Load(const PathString& file_path, std::shared_ptr<Model>& p_model,
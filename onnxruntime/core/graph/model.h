@@ -129,6 +129,14 @@ class Model {
   static common::Status Load(const PathString& file_path,
                              /*out*/ ONNX_NAMESPACE::ModelProto& model_proto);
 
+  // Loads the model like Load(file_path, model_proto), except that the raw data of the initializers of the main graph
+  // of at least min_referenced_bytes isn't read: the initializers refer to it in the model file as external data.
+  // The peak memory of the load is then about the size of the graph structure rather than of the whole model.
+  // The model file has to stay in place until the session state is created, and while it maps the initializers.
+  static common::Status LoadReferencingInitializerData(const PathString& file_path,
+                                                       /*out*/ ONNX_NAMESPACE::ModelProto& model_proto,
+                                                       size_t min_referenced_bytes = 4096);
+
   // TODO(Task:132) Use of shared_ptr<X>* in Load/Save methods is confusing.
   static common::Status Load(const PathString& file_path,
                              /*out*/ std::shared_ptr<Model>& p_model,
@@ -78,6 +78,7 @@ enum MLAS_ACTIVATION_KIND {
     MlasTanhActivation,
     MlasLogisticActivation,
     MlasClipActivation,
+    MlasGeluActivation,
 };
 
 struct MLAS_ACTIVATION {
@@ -128,6 +129,130 @@ MlasGemm(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Matrix/matrix multiply epilogue that is applied to each tile of the output
+// matrix while the tile is still resident in the cache:
+//
+//     C = Activation(C + Bias) + Residual
+//
+// Bias is an optional vector of N elements that is added to every row, the
+// Activation is optional, and Residual is an optional M x N matrix with a
+// first dimension of ldr.
+//
+
+struct MLAS_GEMM_EPILOGUE {
+    const float* Bias;
+    const MLAS_ACTIVATION* Activation;
+    const float* Residual;
+    size_t ldr;
+};
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_GEMM_EPILOGUE* Epilogue,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Matrix/matrix multiply with a constant matrix B that was packed once by
+// MlasGemmPackB, so the packing cost is not paid on every call.
+//
+
+size_t
+MLASCALL
+MlasGemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+void
+MLASCALL
+MlasGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_GEMM_EPILOGUE* Epilogue,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Batch of matrix/matrix multiplies of the same shape with strided operands,
+// scheduled across the thread pool as a single operation.
+//
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    size_t StrideA,
+    const float* B,
+    size_t ldb,
+    size_t StrideB,
+    float beta,
+    float* C,
+    size_t ldc,
+    size_t StrideC,
+    size_t BatchCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasGemm(
@@ -189,6 +314,8 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmDepthwise,
+    MlasConvAlgorithmWinograd,
 };
 
 struct MLAS_CONV_PARAMETERS {
@@ -217,6 +344,12 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TileRowsPerBlock;
+            size_t ThreadBufferSize;
+            size_t FilterBufferSize;
+            const void* PackedFilter;
+        } Winograd;
     } u;
 };
 
@@ -240,6 +373,16 @@ MlasConvPrepare(
     MLAS_THREADPOOL* ThreadPool
     );
 
+bool
+MLASCALL
+MlasConvPrepareAlgorithm(
+    MLAS_CONV_PARAMETERS* Parameters,
+    MLAS_CONV_ALGORITHM Algorithm,
+    int32_t ThreadCount,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasConv(
@@ -252,6 +395,31 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd convolution filter packing routines.
+//
+// A filter packed by MlasConvWinogradPackFilter can be supplied through
+// MLAS_CONV_PARAMETERS::u.Winograd.PackedFilter when MlasConvPrepare selects
+// MlasConvAlgorithmWinograd. The working buffer can then be reduced by
+// u.Winograd.FilterBufferSize elements.
+//
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t FilterCount,
+    size_t InputChannels
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    void* PackedFilter
+    );
+
 //
 // Pooling routines.
 //
@@ -278,6 +446,56 @@ MlasPool(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Reduction routines.
+//
+
+enum MLAS_REDUCTION_KIND {
+    MlasSumReduction,
+    MlasSumSquareReduction,
+    MlasMeanReduction,
+    MlasMaximumReduction,
+    MlasMinimumReduction,
+};
+
+void
+MLASCALL
+MlasReduce(
+    MLAS_REDUCTION_KIND ReductionKind,
+    const float* Input,
+    float* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+enum MLAS_ARG_REDUCTION_KIND {
+    MlasArgMaximumReduction,
+    MlasArgMinimumReduction,
+};
+
+void
+MLASCALL
+MlasArgReduce(
+    MLAS_ARG_REDUCTION_KIND ReductionKind,
+    const float* Input,
+    int64_t* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasReduceSumAndSumSquare(
+    const float* Input,
+    size_t N,
+    float* Sum,
+    float* SumSquare
+    );
+
 //
 // Miscellaneous compute routines.
 //
@@ -306,6 +524,25 @@ MlasComputeErf(
     size_t N
     );
 
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -319,6 +556,82 @@ MlasConvertHalfToFloatBuffer(
     size_t Count
     );
 
+enum MLAS_HALF_FORMAT {
+    MlasFloat16Format,
+    MlasBFloat16Format,
+};
+
+void
+MLASCALL
+MlasConvertHalfToFloat(
+    MLAS_HALF_FORMAT Format,
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertFloatToHalf(
+    MLAS_HALF_FORMAT Format,
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    );
+
+//
+// Half precision matrix/matrix multiply routine. The products are accumulated
+// in single precision and the result is rounded to the half precision format
+// of the output.
+//
+
+void
+MLASCALL
+MlasHalfGemm(
+    MLAS_HALF_FORMAT Format,
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* B,
+    size_t ldb,
+    float beta,
+    uint16_t* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Transpose routines. Each of the BatchCount input matrices of M rows and N
+// columns is transposed to an output matrix of N rows and M columns.
+//
+
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    uint32_t* Output,
+    size_t BatchCount,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint64_t* Input,
+    uint64_t* Output,
+    size_t BatchCount,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Buffer reordering routines.
 //
@@ -331,6 +644,14 @@ MlasReorderInput(
     float* D
     );
 
+void
+MLASCALL
+MlasReorderInputNhwc(
+    const int64_t* InputShape,
+    const float* S,
+    float* D
+    );
+
 void
 MLASCALL
 MlasReorderOutputNchw(
@@ -364,6 +364,53 @@ Return Value:
     }
 }
 
+void
+MlasComputeGelu(
+    float* Buffer,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the Gaussian error linear unit in place:
+
+        Gelu(x) = 0.5 * x * (1 + erf(x / sqrt(2)))
+
+Arguments:
+
+    Buffer - Supplies the buffer to update.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = 64;
+    MLAS_DECLSPEC_ALIGN(float ErfBuffer[BlockSize], 16 * sizeof(float));
+
+    while (N > 0) {
+
+        size_t CountN = (N < BlockSize) ? N : BlockSize;
+
+        for (size_t n = 0; n < CountN; n++) {
+            ErfBuffer[n] = Buffer[n] * 0.70710678118654752440f;
+        }
+
+        MlasComputeErf(ErfBuffer, ErfBuffer, CountN);
+
+        for (size_t n = 0; n < CountN; n++) {
+            Buffer[n] = 0.5f * Buffer[n] * (1.0f + ErfBuffer[n]);
+        }
+
+        Buffer += CountN;
+        N -= CountN;
+    }
+}
+
 void
 MLASCALL
 MlasActivation(
@@ -463,5 +510,23 @@ Return Value:
             MlasActivationKernel<MlasClipActivation>(Activation, Buffer, Bias, M, N, ldc);
             break;
         }
+
+        case MlasGeluActivation:
+        {
+            if (Bias != nullptr) {
+                MlasActivationKernel<MlasIdentityActivation, true>(Activation, Buffer, Bias, M, N, ldc);
+            }
+
+            if (N == ldc) {
+                MlasComputeGelu(Buffer, M * N);
+            } else {
+                while (M-- > 0) {
+                    MlasComputeGelu(Buffer, N);
+                    Buffer += ldc;
+                }
+            }
+
+            break;
+        }
     }
 }
@@ -0,0 +1,139 @@
+;++
+;
+; Copyright (c) Microsoft Corporation. All rights reserved.
+;
+; Licensed under the MIT License.
+;
+; Module Name:
+;
+;   ConvertHalfKernelF16C.asm
+;
+; Abstract:
+;
+;   This module implements routines to convert between half precision and
+;   single precision floating point formats.
+;
+;   This implementation uses F16C instructions.
+;
+;--
+
+        .xlist
+INCLUDE mlasi.inc
+        .list
+
+        SUBTTL  "Convert buffer of half precision floats to single precision floats"
+;++
+;
+; Routine Description:
+;
+;   This routine converts the source buffer of half precision floats to the
+;   destination buffer of single precision floats.
+;
+; Arguments:
+;
+;   Source (rcx) - Supplies the address of the source buffer of half precision
+;       floats.
+;
+;   Destination (rdx) - Supplies the address of the destination buffer of
+;       single precision floats.
+;
+;   Count (r8) - Supplies the number of elements to convert.
+;
+; Return Value:
+;
+;   None.
+;
+;--
+
+        LEAF_ENTRY MlasConvertHalfToFloatKernelF16C, _TEXT
+
+        sub     r8,8
+        jb      ConvertHalfToFloat_ProcessRemainingCount
+
+ConvertHalfToFloat_ProcessEightElements:
+        vcvtph2ps ymm0,XMMWORD PTR [rcx]
+        vmovups YMMWORD PTR [rdx],ymm0
+        add     rcx,8*2                     ; advance Source by 8 elements
+        add     rdx,8*4                     ; advance Destination by 8 elements
+        sub     r8,8
+        jae     ConvertHalfToFloat_ProcessEightElements
+
+ConvertHalfToFloat_ProcessRemainingCount:
+        add     r8,8                        ; correct for over-subtract above
+        jz      ConvertHalfToFloat_ExitKernel
+
+ConvertHalfToFloat_ProcessOneElement:
+        movzx   eax,WORD PTR [rcx]
+        vmovd   xmm0,eax
+        vcvtph2ps xmm0,xmm0
+        vmovss  DWORD PTR [rdx],xmm0
+        add     rcx,2
+        add     rdx,4
+        dec     r8
+        jnz     ConvertHalfToFloat_ProcessOneElement
+
+ConvertHalfToFloat_ExitKernel:
+        vzeroupper
+        ret
+
+        LEAF_END MlasConvertHalfToFloatKernelF16C, _TEXT
+
+        SUBTTL  "Convert buffer of single precision floats to half precision floats"
+;++
+;
+; Routine Description:
+;
+;   This routine converts the source buffer of single precision floats to the
+;   destination buffer of half precision floats. Values are rounded to the
+;   nearest even representation.
+;
+; Arguments:
+;
+;   Source (rcx) - Supplies the address of the source buffer of single
+;       precision floats.
+;
+;   Destination (rdx) - Supplies the address of the destination buffer of half
+;       precision floats.
+;
+;   Count (r8) - Supplies the number of elements to convert.
+;
+; Return Value:
+;
+;   None.
+;
+;--
+
+        LEAF_ENTRY MlasConvertFloatToHalfKernelF16C, _TEXT
+
+        sub     r8,8
+        jb      ConvertFloatToHalf_ProcessRemainingCount
+
+ConvertFloatToHalf_ProcessEightElements:
+        vmovups ymm0,YMMWORD PTR [rcx]
+        vcvtps2ph XMMWORD PTR [rdx],ymm0,0
+        add     rcx,8*4                     ; advance Source by 8 elements
+        add     rdx,8*2                     ; advance Destination by 8 elements
+        sub     r8,8
+        jae     ConvertFloatToHalf_ProcessEightElements
+
+ConvertFloatToHalf_ProcessRemainingCount:
+        add     r8,8                        ; correct for over-subtract above
+        jz      ConvertFloatToHalf_ExitKernel
+
+ConvertFloatToHalf_ProcessOneElement:
+        vmovss  xmm0,DWORD PTR [rcx]
+        vcvtps2ph xmm0,xmm0,0
+        vmovd   eax,xmm0
+        mov     WORD PTR [rdx],ax
+        add     rcx,4
+        add     rdx,2
+        dec     r8
+        jnz     ConvertFloatToHalf_ProcessOneElement
+
+ConvertFloatToHalf_ExitKernel:
+        vzeroupper
+        ret
+
+        LEAF_END MlasConvertFloatToHalfKernelF16C, _TEXT
+
+        END
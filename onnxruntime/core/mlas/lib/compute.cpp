@@ -0,0 +1,657 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    compute.cpp
+
+Abstract:
+
+    This module implements miscellaneous computation routines.
+
+    Our usage requires building platform specific versions of the algorithm to
+    target different instruction sets. The implementation below targets the
+    base instruction set (typically SSE2) while assembly implementations target
+    newer instruction sets (such as FMA3).
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Bundles the constants for use by kernels written in assembly.
+//
+// The exponential function is computed by reducing the input to the range
+// [-ln(2)/2, ln(2)/2] and evaluating a polynomial that is then scaled by the
+// power of two removed during the range reduction. Inputs below LowerRange
+// produce zero so that the power of two stays a normal floating point value.
+//
+
+MLAS_INTERNAL_DATA const struct {
+    float LowerRange;
+    float UpperRange;
+    float Log2Reciprocal;
+    float log2_hi;
+    float log2_lo;
+    float P0;
+    float P1;
+    float P2;
+    float P3;
+    float P4;
+    float P5;
+    float P6;
+    float RoundingBias;
+} MlasExpConstants = {
+    -87.3365478515625f,
+    88.3762626647950f,
+    1.44269504088896341f,
+    -6.93145752e-1f,
+    -1.42860677e-6f,
+    1.38319808e-3f,
+    8.37550033e-3f,
+    4.16689515e-2f,
+    1.66664466e-1f,
+    4.99999851e-1f,
+    1.00000000e+0f,
+    1.00000000e+0f,
+    1.25829120e+7f,
+};
+
+//
+// Define the number of elements processed by each thread of the softmax
+// routine before another thread is used.
+//
+
+#define MLAS_SOFTMAX_THREAD_COMPLEXITY              (16 * 1024)
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasComputeExpVector(
+    MLAS_FLOAT32X4 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for a vector of elements.
+
+Arguments:
+
+    Vector - Supplies the values to operate on.
+
+Return Value:
+
+    Returns the exponential of each element.
+
+--*/
+{
+    MLAS_FLOAT32X4 InRangeMask = MlasGreaterThanFloat32x4(Vector,
+        MlasBroadcastFloat32x4(MlasExpConstants.LowerRange));
+
+    Vector = MlasMaximumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.LowerRange), Vector);
+    Vector = MlasMinimumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.UpperRange), Vector);
+
+    MLAS_FLOAT32X4 RoundingBias = MlasBroadcastFloat32x4(MlasExpConstants.RoundingBias);
+    MLAS_FLOAT32X4 r = MlasMultiplyAddFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.Log2Reciprocal), Vector, RoundingBias);
+    r = MlasSubtractFloat32x4(r, RoundingBias);
+
+    MLAS_FLOAT32X4 fx = MlasMultiplyAddFloat32x4(r, MlasBroadcastFloat32x4(MlasExpConstants.log2_hi), Vector);
+    fx = MlasMultiplyAddFloat32x4(r, MlasBroadcastFloat32x4(MlasExpConstants.log2_lo), fx);
+
+    MLAS_FLOAT32X4 y = MlasBroadcastFloat32x4(MlasExpConstants.P0);
+    y = MlasMultiplyAddFloat32x4(y, fx, MlasBroadcastFloat32x4(MlasExpConstants.P1));
+    y = MlasMultiplyAddFloat32x4(y, fx, MlasBroadcastFloat32x4(MlasExpConstants.P2));
+    y = MlasMultiplyAddFloat32x4(y, fx, MlasBroadcastFloat32x4(MlasExpConstants.P3));
+    y = MlasMultiplyAddFloat32x4(y, fx, MlasBroadcastFloat32x4(MlasExpConstants.P4));
+    y = MlasMultiplyAddFloat32x4(y, fx, MlasBroadcastFloat32x4(MlasExpConstants.P5));
+    y = MlasMultiplyAddFloat32x4(y, fx, MlasBroadcastFloat32x4(MlasExpConstants.P6));
+    y = MlasMultiplyFloat32x4(y, MlasPowerOf2Float32x4(r));
+
+    return MlasAndFloat32x4(y, InRangeMask);
+}
+
+MLAS_FORCEINLINE
+float
+MlasComputeExpScalar(
+    float Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for a single element.
+
+Arguments:
+
+    Value - Supplies the value to operate on.
+
+Return Value:
+
+    Returns the exponential of the element.
+
+--*/
+{
+    if (Value <= MlasExpConstants.LowerRange) {
+        return 0.0f;
+    }
+
+    Value = (std::min)(MlasExpConstants.UpperRange, Value);
+
+    float r = MlasExpConstants.Log2Reciprocal * Value + MlasExpConstants.RoundingBias;
+    r -= MlasExpConstants.RoundingBias;
+
+    float fx = r * MlasExpConstants.log2_hi + Value;
+    fx = r * MlasExpConstants.log2_lo + fx;
+
+    float y = MlasExpConstants.P0;
+    y = y * fx + MlasExpConstants.P1;
+    y = y * fx + MlasExpConstants.P2;
+    y = y * fx + MlasExpConstants.P3;
+    y = y * fx + MlasExpConstants.P4;
+    y = y * fx + MlasExpConstants.P5;
+    y = y * fx + MlasExpConstants.P6;
+
+    return ldexpf(y, int(r));
+}
+
+void
+MLASCALL
+MlasComputeExpF32Kernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasComputeExpVector(MlasLoadFloat32x4(Input)));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output++ = MlasComputeExpScalar(*Input++);
+
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasComputeExpF32Kernel(Input, Output, N);
+}
+
+float
+MLASCALL
+MlasReduceMaximumF32Kernel(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to find the maximum value of
+    the supplied buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the maximum value of the supplied buffer.
+
+--*/
+{
+    float Maximum = std::numeric_limits<float>::lowest();
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 MaximumVector0 = MlasBroadcastFloat32x4(Maximum);
+
+        if (N >= 16) {
+
+            MLAS_FLOAT32X4 MaximumVector1 = MaximumVector0;
+            MLAS_FLOAT32X4 MaximumVector2 = MaximumVector0;
+            MLAS_FLOAT32X4 MaximumVector3 = MaximumVector0;
+
+            while (N >= 16) {
+
+                MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MlasLoadFloat32x4(Input));
+                MaximumVector1 = MlasMaximumFloat32x4(MaximumVector1, MlasLoadFloat32x4(Input + 4));
+                MaximumVector2 = MlasMaximumFloat32x4(MaximumVector2, MlasLoadFloat32x4(Input + 8));
+                MaximumVector3 = MlasMaximumFloat32x4(MaximumVector3, MlasLoadFloat32x4(Input + 12));
+
+                Input += 16;
+                N -= 16;
+            }
+
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MaximumVector1);
+            MaximumVector2 = MlasMaximumFloat32x4(MaximumVector2, MaximumVector3);
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MaximumVector2);
+        }
+
+        while (N >= 4) {
+
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MlasLoadFloat32x4(Input));
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Maximum = MlasReduceMaximumFloat32x4(MaximumVector0);
+    }
+
+    while (N > 0) {
+
+        Maximum = (std::max)(Maximum, *Input);
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Maximum;
+}
+
+float
+MLASCALL
+MlasComputeSumExpF32Kernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to compute the exponential of
+    each element biased by the negative maximum and to return the sum of these
+    values. The biased exponentials are optionally stored to the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Optionally supplies the output buffer. The buffer may be the same
+        as the input buffer.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the negative of the maximum value of the input
+        buffer.
+
+Return Value:
+
+    Returns the sum of the biased exponentials.
+
+--*/
+{
+    MLAS_FLOAT32X4 NegativeMaximumVector = MlasBroadcastFloat32x4(NegativeMaximum);
+    MLAS_FLOAT32X4 Accumulator = MlasZeroFloat32x4();
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasAddFloat32x4(MlasLoadFloat32x4(Input), NegativeMaximumVector);
+
+        Vector = MlasComputeExpVector(Vector);
+
+        if (Output != nullptr) {
+            MlasStoreFloat32x4(Output, Vector);
+            Output += 4;
+        }
+
+        Accumulator = MlasAddFloat32x4(Accumulator, Vector);
+
+        Input += 4;
+        N -= 4;
+    }
+
+    float Accumulation = MlasReduceAddFloat32x4(Accumulator);
+
+    while (N > 0) {
+
+        float Value = MlasComputeExpScalar(*Input + NegativeMaximum);
+
+        if (Output != nullptr) {
+            *Output++ = Value;
+        }
+
+        Accumulation += Value;
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Accumulation;
+}
+
+void
+MLASCALL
+MlasComputeSoftmaxOutputF32Kernel(
+    float* Output,
+    size_t N,
+    float Scale
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to normalize the output of the
+    softmax operation by scaling the biased exponentials.
+
+Arguments:
+
+    Output - Supplies the buffer of biased exponentials to normalize in place.
+
+    N - Supplies the number of elements to process.
+
+    Scale - Supplies the reciprocal of the sum of the biased exponentials.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasMultiplyFloat32x4(MlasLoadFloat32x4(Output), ScaleVector));
+
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output++ *= Scale;
+
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeLogSoftmaxOutputF32Kernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum,
+    float Logarithm
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to produce the output of the
+    log softmax operation by biasing the input by the maximum value and the
+    logarithm of the sum of the biased exponentials.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer. The buffer may be the same as the
+        input buffer.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the negative of the maximum value of the input
+        buffer.
+
+    Logarithm - Supplies the logarithm of the sum of the biased exponentials.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 NegativeMaximumVector = MlasBroadcastFloat32x4(NegativeMaximum);
+    MLAS_FLOAT32X4 LogarithmVector = MlasBroadcastFloat32x4(Logarithm);
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasAddFloat32x4(MlasLoadFloat32x4(Input), NegativeMaximumVector);
+
+        MlasStoreFloat32x4(Output, MlasSubtractFloat32x4(Vector, LogarithmVector));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output++ = (*Input++ + NegativeMaximum) - Logarithm;
+
+        N -= 1;
+    }
+}
+
+struct MLAS_SOFTMAX_WORK_BLOCK {
+    int32_t ThreadCountN;
+    bool LogSoftmax;
+    const float* Input;
+    float* Output;
+    size_t N;
+    size_t D;
+};
+
+void
+MlasComputeSoftmaxThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    softmax or log softmax operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_SOFTMAX_WORK_BLOCK*)Context;
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t n;
+    size_t CountN;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+    const size_t D = WorkBlock->D;
+
+    const float* Input = WorkBlock->Input + n * D;
+    float* Output = WorkBlock->Output + n * D;
+
+    while (CountN > 0) {
+
+        //
+        // Find the maximum value for the row so that the exponentials cannot
+        // overflow.
+        //
+
+        const float Maximum = MlasReduceMaximumF32Kernel(Input, D);
+        const float NegativeMaximum = -Maximum;
+
+        if (WorkBlock->LogSoftmax) {
+
+            //
+            // Compute the sum of the biased exponentials without storing them
+            // and then bias the input by the logarithm of the sum.
+            //
+
+            const float Accumulation = MlasComputeSumExpF32Kernel(Input, nullptr, D, NegativeMaximum);
+
+            MlasComputeLogSoftmaxOutputF32Kernel(Input, Output, D, NegativeMaximum, logf(Accumulation));
+
+        } else {
+
+            //
+            // Store the biased exponentials and then normalize the row by
+            // the sum of these values.
+            //
+
+            const float Accumulation = MlasComputeSumExpF32Kernel(Input, Output, D, NegativeMaximum);
+
+            MlasComputeSoftmaxOutputF32Kernel(Output, D, 1.0f / Accumulation);
+        }
+
+        Input += D;
+        Output += D;
+        CountN--;
+    }
+}
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax operation for each row of
+    the input matrix.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer. The buffer may be the same as the
+        input buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns of each row to process.
+
+    LogSoftmax - Supplies true if this is a log softmax operation, else false
+        if this is a softmax operation.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SOFTMAX_WORK_BLOCK WorkBlock;
+
+    //
+    // Capture the softmax parameters to the work block.
+    //
+
+    WorkBlock.LogSoftmax = LogSoftmax;
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+
+    //
+    // Compute the number of target threads given the complexity of the softmax
+    // operation. Limit the number of threads to the number of rows and try to
+    // keep each thread processing a minimum number of elements before using
+    // another thread.
+    //
+
+    const double Complexity = double(N) * double(D);
+
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SOFTMAX_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SOFTMAX_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) >= N) {
+        TargetThreadCount = int32_t(N);
+    }
+
+    WorkBlock.ThreadCountN = TargetThreadCount;
+
+    MlasExecuteThreaded(MlasComputeSoftmaxThreaded, &WorkBlock, TargetThreadCount, ThreadPool);
+}
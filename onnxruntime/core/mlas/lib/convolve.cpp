@@ -23,6 +23,28 @@ Abstract:
 #define MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD \
     (MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK)
 
+//
+// Define the number of elements of a Winograd F(2x2, 3x3) tile, the number of
+// working buffer elements targeted by each block of tiles on a thread, and the
+// minimum number of tiles in a block to keep the GEMMs efficient.
+//
+
+#define MLAS_CONV_WINOGRAD_TILE_ELEMENTS 16
+
+#define MLAS_CONV_WINOGRAD_BLOCK_ELEMENTS 65536
+
+#define MLAS_CONV_WINOGRAD_MINIMUM_BLOCK_TILES 64
+
+//
+// Define the minimum number of input channels and filters and the minimum
+// number of output elements across the batch for which the Winograd algorithm
+// amortizes the cost of its transforms.
+//
+
+#define MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS 16
+
+#define MLAS_CONV_WINOGRAD_MINIMUM_OUTPUT_SIZE 256
+
 //
 // Define the parameters to execute segments of a convolution operation on
 // worker threads.
@@ -592,7 +614,7 @@ Return Value:
 
             MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, CountN,
                 CountK, 1.0f, Filter + k, K, ColumnBuffer, CountN, beta,
-                SegmentOutput, OutputSize);
+                SegmentOutput, OutputSize, nullptr);
 
             beta = 1.0f;
         }
@@ -719,7 +741,7 @@ Return Value:
 
         MlasSgemmOperation(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount,
             OutputSize, K, 1.0f, filter, K, input, Parameters->u.GemmDirect.ldb, 0.0f,
-            output, OutputSize);
+            output, OutputSize, nullptr);
 
         //
         // Apply the activation with optional bias.
@@ -737,130 +759,103 @@ Return Value:
 }
 
 inline
-bool
-MlasConvTryMultithread(
+float
+MlasConvDepthwiseFloatBorder(
     const MLAS_CONV_PARAMETERS* Parameters,
     const float* Input,
     const float* Filter,
-    const float* Bias,
-    float* WorkingBuffer,
-    float* Output,
-    MLAS_THREADPOOL* ThreadPool
+    ptrdiff_t ih,
+    size_t khStart,
+    size_t khEnd,
+    size_t ow
     )
 /*++
 
 Routine Description:
 
-    This routine attempts to launch a convolution operation across multiple
-    threads.
+    This routine computes one output element of a depthwise convolution where
+    some of the kernel columns fall into the padding of the input row.
 
 Arguments:
 
     Parameters - Supplies the structure that contains the convolution
         parameters.
 
-    Input - Supplies the input tensor.
+    Input - Supplies the input channel plane.
 
-    Filter - Supplies the filter tensor.
+    Filter - Supplies the filter for the channel.
 
-    Bias - Optionally supplies the bias vector.
+    ih - Supplies the input row that corresponds to the first kernel row.
 
-    WorkingBuffer - Supplies a working buffer sized to the number of elements
-        returned by MlasConvPrepare.
+    khStart - Supplies the first kernel row that is inside the input.
 
-    Output - Supplies the output tensor.
+    khEnd - Supplies the last kernel row (exclusive) that is inside the input.
 
-    ThreadPool - Supplies the thread pool object to use, else nullptr if the
-        base library threading support should be used.
+    ow - Supplies the output column to compute.
 
 Return Value:
 
-    Returns true if the operation was completed across multiple threads, else
-    false if the operation should fall back to a single thread.
+    Returns the output element.
 
 --*/
 {
-    MLAS_CONV_WORK_BLOCK WorkBlock;
-
-    const size_t OutputSize = Parameters->OutputSize;
-    const size_t ThreadStrideN = Parameters->u.ExpandThenGemmSegmented.ThreadStrideN;
-
-    if (ThreadStrideN >= OutputSize) {
-        return false;
-    }
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t KernelWidth = Parameters->KernelShape[1];
+    const size_t DilationHeight = Parameters->DilationShape[0];
+    const size_t DilationWidth = Parameters->DilationShape[1];
 
-    //
-    // Initialize the common fields of the work block.
-    //
+    const ptrdiff_t iw = ptrdiff_t(ow * Parameters->StrideShape[1]) - ptrdiff_t(Parameters->Padding[1]);
 
-    WorkBlock.Parameters = Parameters;
-    WorkBlock.Input = Input;
-    WorkBlock.Filter = Filter;
-    WorkBlock.Bias = Bias;
-    WorkBlock.WorkingBuffer = WorkingBuffer;
-    WorkBlock.Output = Output;
+    float Accumulator = 0.0f;
 
-    //
-    // Segment the operation across multiple threads.
-    //
+    for (size_t kh = khStart; kh < khEnd; kh++) {
 
-    int32_t Index = 0;
-    size_t SegmentCountN;
+        const float* row = Input + size_t(ih + ptrdiff_t(kh * DilationHeight)) * InputWidth;
+        const float* filter = Filter + kh * KernelWidth;
 
-    for (size_t SegmentStartN = 0; SegmentStartN < OutputSize; SegmentStartN += SegmentCountN) {
+        for (size_t kw = 0; kw < KernelWidth; kw++) {
 
-        SegmentCountN = OutputSize - SegmentStartN;
+            const ptrdiff_t InputColumn = iw + ptrdiff_t(kw * DilationWidth);
 
-        if (SegmentCountN > ThreadStrideN) {
-            SegmentCountN = ThreadStrideN;
+            if (InputColumn >= 0 && InputColumn < ptrdiff_t(InputWidth)) {
+                Accumulator += row[InputColumn] * filter[kw];
+            }
         }
-
-        WorkBlock.Segments[Index].StartN = SegmentStartN;
-        WorkBlock.Segments[Index].CountN = SegmentCountN;
-
-        Index++;
     }
 
-    MlasExecuteThreaded(MlasConvOperationThreaded, &WorkBlock, Index, ThreadPool);
-
-    return true;
+    return Accumulator;
 }
 
+template<size_t FixedStrideWidth, size_t FixedKernelWidth>
 void
-MLASCALL
-MlasConv(
+MlasConvDepthwiseFloatPlane(
     const MLAS_CONV_PARAMETERS* Parameters,
     const float* Input,
     const float* Filter,
-    const float* Bias,
-    float* WorkingBuffer,
-    float* Output,
-    MLAS_THREADPOOL* ThreadPool
+    float* Output
     )
 /*++
 
 Routine Description:
 
-    This routine implements the convolution operation.
+    This routine computes one output channel plane of a two dimensional
+    depthwise convolution directly from the input channel plane.
+
+    The interior of each output row is computed with vectors that hold the
+    accumulators for consecutive output columns in registers across all of the
+    kernel taps. A stride width of one or two and kernel widths of three and
+    five are specialized so that the kernel loop is fully unrolled.
 
 Arguments:
 
     Parameters - Supplies the structure that contains the convolution
         parameters.
 
-    Input - Supplies the input tensor.
-
-    Filter - Supplies the filter tensor.
-
-    Bias - Optionally supplies the bias vector.
-
-    WorkingBuffer - Supplies a working buffer sized to the number of elements
-        returned by MlasConvPrepare.
+    Input - Supplies the input channel plane.
 
-    Output - Supplies the output tensor.
+    Filter - Supplies the filter for the channel.
 
-    ThreadPool - Supplies the thread pool object to use, else nullptr if the
-        base library threading support should be used.
+    Output - Supplies the output channel plane.
 
 Return Value:
 
@@ -868,191 +863,1443 @@ Return Value:
 
 --*/
 {
-    const size_t FilterCount = Parameters->FilterCount;
-    const size_t OutputSize = Parameters->OutputSize;
-    const size_t K = Parameters->K;
-
-    const size_t InputGroupSize = Parameters->InputChannels * Parameters->InputSize;
-    const size_t OutputGroupSize = FilterCount * OutputSize;
-    const size_t FilterGroupSize = FilterCount * K;
-
-    const size_t BatchCount = Parameters->BatchCount;
-    const size_t GroupCount = Parameters->GroupCount;
-
-    const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t KernelHeight = Parameters->KernelShape[0];
+    const size_t KernelWidth = (FixedKernelWidth != 0) ? FixedKernelWidth : Parameters->KernelShape[1];
+    const size_t DilationHeight = Parameters->DilationShape[0];
+    const size_t DilationWidth = Parameters->DilationShape[1];
+    const size_t StrideHeight = Parameters->StrideShape[0];
+    const size_t StrideWidth = (FixedStrideWidth != 0) ? FixedStrideWidth : Parameters->StrideShape[1];
+    const ptrdiff_t PaddingTop = ptrdiff_t(Parameters->Padding[0]);
+    const ptrdiff_t PaddingLeft = ptrdiff_t(Parameters->Padding[1]);
 
     //
-    // Schedule batches of GEMMs across multiple threads.
+    // Compute the range of output columns where every kernel column reads from
+    // inside the input row. The vector loop also requires every element that it
+    // loads to be inside the input row: a stride width of two loads one element
+    // past the last kernel tap of the last output column.
     //
 
-    if (Algorithm == MlasConvAlgorithmGemmDirect && ((BatchCount > 1) || (GroupCount > 1))) {
+    const ptrdiff_t LastInputColumn =
+        ptrdiff_t(InputWidth) - 1 - ptrdiff_t((KernelWidth - 1) * DilationWidth) + PaddingLeft;
 
-        const size_t BatchGroupCount = BatchCount * GroupCount;
+    const size_t InteriorEnd = (LastInputColumn >= 0) ?
+        std::min(size_t(LastInputColumn) / StrideWidth + 1, OutputWidth) : 0;
+    const size_t InteriorStart = std::min((size_t(PaddingLeft) + StrideWidth - 1) / StrideWidth, InteriorEnd);
 
-        int32_t TargetThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+    size_t VectorEnd = InteriorStart;
 
-        if (size_t(TargetThreadCount) >= BatchGroupCount) {
-            TargetThreadCount = int32_t(BatchGroupCount);
-        }
+    if (FixedStrideWidth == 1) {
+        VectorEnd = InteriorEnd;
+    } else if (FixedStrideWidth == 2 && LastInputColumn >= 1) {
+        VectorEnd = std::max(std::min(size_t(LastInputColumn - 1) / 2 + 1, InteriorEnd), InteriorStart);
+    }
 
-        MLAS_CONV_WORK_BLOCK WorkBlock;
+    for (size_t oh = 0; oh < OutputHeight; oh++) {
 
-        WorkBlock.Parameters = Parameters;
-        WorkBlock.Input = Input;
-        WorkBlock.Filter = Filter;
-        WorkBlock.Bias = Bias;
-        WorkBlock.WorkingBuffer = nullptr;
-        WorkBlock.Output = Output;
-        WorkBlock.TargetThreadCount = TargetThreadCount;
+        //
+        // Compute the range of kernel rows that read from inside the input.
+        //
 
-        MlasExecuteThreaded(MlasConvGemmDirectThreaded, &WorkBlock, TargetThreadCount, ThreadPool);
+        const ptrdiff_t ih = ptrdiff_t(oh * StrideHeight) - PaddingTop;
 
-        return;
-    }
+        size_t khStart = 0;
+        size_t khEnd = KernelHeight;
 
-    //
-    // Iterate over each batch and group.
-    //
+        while (khStart < khEnd && ih + ptrdiff_t(khStart * DilationHeight) < 0) {
+            khStart++;
+        }
 
-    for (size_t batch = 0; batch < BatchCount; batch++) {
+        while (khEnd > khStart && ih + ptrdiff_t((khEnd - 1) * DilationHeight) >= ptrdiff_t(InputHeight)) {
+            khEnd--;
+        }
 
-        const float* filter = Filter;
-        const float* bias = Bias;
+        float* output = Output + oh * OutputWidth;
+        size_t ow = 0;
 
-        for (size_t group = 0; group < GroupCount; group++) {
+        //
+        // Compute the output columns where the kernel overlaps the left padding.
+        //
 
-            //
-            // Dispatch the convolution.
-            //
+        for (; ow < InteriorStart; ow++) {
+            output[ow] = MlasConvDepthwiseFloatBorder(Parameters, Input, Filter, ih, khStart, khEnd, ow);
+        }
 
-            switch (Algorithm) {
+        //
+        // Compute the interior output columns with vectors.
+        //
 
-                case MlasConvAlgorithmGemmDirect:
-                {
-                    //
-                    // Invoke the threaded GEMM directly with the input tensor.
-                    //
+        for (; ow + 8 <= VectorEnd; ow += 8) {
 
-                    MlasGemm(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount,
-                        OutputSize, K, 1.0f, filter, K, Input, Parameters->u.GemmDirect.ldb, 0.0f,
-                        Output, OutputSize, ThreadPool);
+            MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+            MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
 
-                    //
-                    // Apply the activation with optional bias.
-                    //
+            for (size_t kh = khStart; kh < khEnd; kh++) {
 
-                    MlasActivation(Parameters->Activation, Output, bias, FilterCount,
-                        OutputSize, OutputSize);
+                const float* row = Input + size_t(ih + ptrdiff_t(kh * DilationHeight)) * InputWidth +
+                    size_t(ptrdiff_t(ow * StrideWidth) - PaddingLeft);
+                const float* filter = Filter + kh * KernelWidth;
 
-                    break;
-                }
+                for (size_t kw = 0; kw < KernelWidth; kw++) {
 
-                case MlasConvAlgorithmExpandThenGemm:
-                {
-                    //
-                    // Expand the input tensor to the working buffer and then invoke the
-                    // threaded GEMM.
-                    //
+                    const float* input = row + kw * DilationWidth;
+                    MLAS_FLOAT32X4 FilterVector = MlasBroadcastFloat32x4(filter + kw);
+                    MLAS_FLOAT32X4 InputVector0;
+                    MLAS_FLOAT32X4 InputVector1;
 
-                    if (Parameters->Dimensions == 2) {
-                        MlasConvIm2Col(Parameters, Input, WorkingBuffer, 0, K, 0, OutputSize);
+                    if (FixedStrideWidth == 1) {
+                        InputVector0 = MlasLoadFloat32x4(input);
+                        InputVector1 = MlasLoadFloat32x4(input + 4);
                     } else {
-                        MlasConvVol2Col(Parameters, Input, WorkingBuffer, 0, K, 0, OutputSize);
+                        InputVector0 = MlasShuffleEvenFloat32x4(MlasLoadFloat32x4(input), MlasLoadFloat32x4(input + 4));
+                        InputVector1 = MlasShuffleEvenFloat32x4(MlasLoadFloat32x4(input + 8), MlasLoadFloat32x4(input + 12));
                     }
 
-                    MlasGemm(CblasNoTrans, CblasNoTrans, FilterCount, OutputSize, K, 1.0f, filter,
-                        K, WorkingBuffer, OutputSize, 0.0f, Output, OutputSize, ThreadPool);
+                    Accumulator0 = MlasMultiplyAddFloat32x4(InputVector0, FilterVector, Accumulator0);
+                    Accumulator1 = MlasMultiplyAddFloat32x4(InputVector1, FilterVector, Accumulator1);
+                }
+            }
 
-                    //
-                    // Apply the activation with optional bias.
-                    //
+            MlasStoreFloat32x4(output + ow, Accumulator0);
+            MlasStoreFloat32x4(output + ow + 4, Accumulator1);
+        }
 
-                    MlasActivation(Parameters->Activation, Output, bias, FilterCount,
-                        OutputSize, OutputSize);
+        for (; ow + 4 <= VectorEnd; ow += 4) {
 
-                    break;
-                }
+            MLAS_FLOAT32X4 Accumulator = MlasZeroFloat32x4();
 
-                case MlasConvAlgorithmExpandThenGemmSegmented:
-                {
-                    //
-                    // Attempt to launch the convolution across multiple threads or fall
-                    // back to a single thread.
-                    //
+            for (size_t kh = khStart; kh < khEnd; kh++) {
 
-                    if (!MlasConvTryMultithread(Parameters, Input, filter, bias, WorkingBuffer,
-                        Output, ThreadPool)) {
-                        MlasConvOperation(Parameters, Input, filter, bias, WorkingBuffer,
-                            Output, 0, OutputSize);
+                const float* row = Input + size_t(ih + ptrdiff_t(kh * DilationHeight)) * InputWidth +
+                    size_t(ptrdiff_t(ow * StrideWidth) - PaddingLeft);
+                const float* filter = Filter + kh * KernelWidth;
+
+                for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                    const float* input = row + kw * DilationWidth;
+                    MLAS_FLOAT32X4 InputVector;
+
+                    if (FixedStrideWidth == 1) {
+                        InputVector = MlasLoadFloat32x4(input);
+                    } else {
+                        InputVector = MlasShuffleEvenFloat32x4(MlasLoadFloat32x4(input), MlasLoadFloat32x4(input + 4));
                     }
 
-                    break;
+                    Accumulator = MlasMultiplyAddFloat32x4(InputVector, MlasBroadcastFloat32x4(filter + kw), Accumulator);
                 }
             }
 
-            //
-            // Advance the buffer pointers.
-            //
+            MlasStoreFloat32x4(output + ow, Accumulator);
+        }
 
-            if (bias != nullptr) {
-                bias += FilterCount;
+        //
+        // Compute the remaining interior output columns.
+        //
+
+        for (; ow < InteriorEnd; ow++) {
+
+            float Accumulator = 0.0f;
+
+            for (size_t kh = khStart; kh < khEnd; kh++) {
+
+                const float* row = Input + size_t(ih + ptrdiff_t(kh * DilationHeight)) * InputWidth +
+                    size_t(ptrdiff_t(ow * StrideWidth) - PaddingLeft);
+                const float* filter = Filter + kh * KernelWidth;
+
+                for (size_t kw = 0; kw < KernelWidth; kw++) {
+                    Accumulator += row[kw * DilationWidth] * filter[kw];
+                }
             }
 
-            filter += FilterGroupSize;
-            Input += InputGroupSize;
-            Output += OutputGroupSize;
+            output[ow] = Accumulator;
+        }
+
+        //
+        // Compute the output columns where the kernel overlaps the right padding.
+        //
+
+        for (; ow < OutputWidth; ow++) {
+            output[ow] = MlasConvDepthwiseFloatBorder(Parameters, Input, Filter, ih, khStart, khEnd, ow);
         }
     }
 }
 
+typedef
 void
-MLASCALL
-MlasConvPrepare(
-    MLAS_CONV_PARAMETERS* Parameters,
-    size_t Dimensions,
-    size_t BatchCount,
-    size_t GroupCount,
-    size_t InputChannels,
-    const int64_t* InputShape,
-    const int64_t* KernelShape,
-    const int64_t* DilationShape,
-    const int64_t* Padding,
-    const int64_t* StrideShape,
-    const int64_t* OutputShape,
-    size_t FilterCount,
-    const MLAS_ACTIVATION* Activation,
-    size_t* WorkingBufferSize,
-    MLAS_THREADPOOL* ThreadPool
+(MLAS_CONV_DEPTHWISE_FLOAT_PLANE_ROUTINE)(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    float* Output
+    );
+
+void
+MlasConvDepthwiseThreaded(
+    void* Context,
+    int32_t Index
     )
 /*++
 
 Routine Description:
 
-    This routine prepares for a convolution operation by computing required
-    parameters including the required working buffer size for intermediate
-    results.
+    This routine is invoked from a worker thread to execute a segment of a
+    depthwise convolution operation.
 
 Arguments:
 
-    Parameters - Supplies the structure that stores the provided and computed
-        parameters for the convolution operation.
+    Context - Supplies the pointer to the context for the threaded operation.
 
-    Dimensions - Supplies the number of dimensions (must be 2 or 3).
+    Index - Supplies the current index of the threaded operation.
 
-    BatchCount - Supplies the number of batches to the processed.
+Return Value:
 
-    GroupCount - Supplies the number of channel groups.
+    None.
 
-    InputChannels - Supplies the number of input channels per group.
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
 
-    InputShape - Supplies the shape of the input tensor.
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
 
-    KernelShape - Supplies the shape of the kernel transform.
+    //
+    // Select the plane routine specialized for the stride and kernel width.
+    //
 
-    DilationShape - Supplies the shape of the dilation.
+    const size_t StrideWidth = Parameters->StrideShape[1];
+    const size_t KernelWidth = Parameters->KernelShape[1];
 
-    Padding - Supplies the number of zero padding elements at the edge of the
-        input tensor.
+    MLAS_CONV_DEPTHWISE_FLOAT_PLANE_ROUTINE* PlaneRoutine;
+
+    if (StrideWidth == 1) {
+        PlaneRoutine = (KernelWidth == 3) ? MlasConvDepthwiseFloatPlane<1, 3> :
+            (KernelWidth == 5) ? MlasConvDepthwiseFloatPlane<1, 5> : MlasConvDepthwiseFloatPlane<1, 0>;
+    } else if (StrideWidth == 2) {
+        PlaneRoutine = (KernelWidth == 3) ? MlasConvDepthwiseFloatPlane<2, 3> :
+            (KernelWidth == 5) ? MlasConvDepthwiseFloatPlane<2, 5> : MlasConvDepthwiseFloatPlane<2, 0>;
+    } else {
+        PlaneRoutine = MlasConvDepthwiseFloatPlane<0, 0>;
+    }
+
+    //
+    // Partition the operation by output channel planes. Each group has a
+    // single input channel that is shared by the filters of the group.
+    //
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t GroupFilterCount = Parameters->GroupCount * FilterCount;
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t K = Parameters->K;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount, Parameters->BatchCount * GroupFilterCount,
+        &WorkIndex, &WorkRemaining);
+
+    while (WorkRemaining > 0) {
+
+        const size_t filter = WorkIndex % GroupFilterCount;
+
+        const float* input = WorkBlock->Input + (WorkIndex / FilterCount) * InputSize;
+        float* output = WorkBlock->Output + WorkIndex * OutputSize;
+
+        PlaneRoutine(Parameters, input, WorkBlock->Filter + filter * K, output);
+
+        //
+        // Apply the activation with optional bias.
+        //
+
+        const float* bias = WorkBlock->Bias;
+
+        if (bias != nullptr) {
+            bias += filter;
+        }
+
+        MlasActivation(Parameters->Activation, output, bias, 1, OutputSize, OutputSize);
+
+        WorkIndex++;
+        WorkRemaining--;
+    }
+}
+
+void
+MlasConvWinogradTransformFilter(
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* TransformedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a 3x3 filter for the Winograd F(2x2, 3x3)
+    algorithm by computing G * g * G^T for each filter and input channel.
+
+Arguments:
+
+    FilterCount - Supplies the number of filters.
+
+    InputChannels - Supplies the number of input channels.
+
+    Filter - Supplies the filter tensor in [FilterCount][InputChannels][3][3]
+        order.
+
+    TransformedFilter - Supplies the buffer that receives the transformed
+        filter in [16][FilterCount][InputChannels] order.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t TransformStride = FilterCount * InputChannels;
+
+    //
+    // Transform the filters in groups to a local buffer, which is then copied
+    // to the output in contiguous runs to avoid cache set conflicts between
+    // the widely strided transformed elements.
+    //
+
+    constexpr size_t GroupSize = 64;
+
+    float u[MLAS_CONV_WINOGRAD_TILE_ELEMENTS][GroupSize];
+
+    for (size_t start = 0; start < TransformStride; start += GroupSize) {
+
+        const size_t count = std::min(TransformStride - start, GroupSize);
+
+        for (size_t n = 0; n < count; n++) {
+
+            const float* g = Filter + (start + n) * 9;
+
+            //
+            // Compute G * g, where G = [1 0 0; .5 .5 .5; .5 -.5 .5; 0 0 1].
+            //
+
+            float t[4][3];
+
+            for (size_t j = 0; j < 3; j++) {
+                t[0][j] = g[j];
+                t[1][j] = 0.5f * (g[j] + g[3 + j] + g[6 + j]);
+                t[2][j] = 0.5f * (g[j] - g[3 + j] + g[6 + j]);
+                t[3][j] = g[6 + j];
+            }
+
+            //
+            // Compute (G * g) * G^T.
+            //
+
+            for (size_t i = 0; i < 4; i++) {
+                u[i * 4 + 0][n] = t[i][0];
+                u[i * 4 + 1][n] = 0.5f * (t[i][0] + t[i][1] + t[i][2]);
+                u[i * 4 + 2][n] = 0.5f * (t[i][0] - t[i][1] + t[i][2]);
+                u[i * 4 + 3][n] = t[i][2];
+            }
+        }
+
+        for (size_t k = 0; k < MLAS_CONV_WINOGRAD_TILE_ELEMENTS; k++) {
+            std::copy_n(u[k], count, TransformedFilter + k * TransformStride + start);
+        }
+    }
+}
+
+void
+MlasConvWinogradTransformInput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    size_t TileRowStart,
+    size_t TileRows,
+    float* TransformedInput
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a block of 4x4 input tiles for the Winograd
+    F(2x2, 3x3) algorithm by computing B^T * d * B for each tile and input
+    channel. Adjacent tiles overlap by two rows and two columns.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor for a batch.
+
+    TileRowStart - Supplies the index of the first row of tiles.
+
+    TileRows - Supplies the number of rows of tiles.
+
+    TransformedInput - Supplies the buffer that receives the transformed
+        input in [16][InputChannels][TileCount] order.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+
+    const size_t TileWidthCount = (Parameters->OutputShape[1] + 1) / 2;
+    const size_t TileCount = TileRows * TileWidthCount;
+    const size_t TransformStride = InputChannels * TileCount;
+
+    for (size_t c = 0; c < InputChannels; c++) {
+
+        const float* input = Input + c * InputSize;
+        float* output = TransformedInput + c * TileCount;
+
+        for (size_t tr = 0; tr < TileRows; tr++) {
+
+            const size_t ih = 2 * (TileRowStart + tr) - PaddingTop;
+            const bool RowsInside = (2 * (TileRowStart + tr) >= PaddingTop) && (ih + 4 <= InputHeight);
+
+            size_t tw = 0;
+
+            while (tw < TileWidthCount) {
+
+                const size_t iw = 2 * tw - PaddingLeft;
+                const size_t t = tr * TileWidthCount + tw;
+
+                //
+                // Transform four adjacent tiles with vector operations if the
+                // tiles do not touch the padding. The even lanes of the input
+                // rows starting at successive columns form the columns of
+                // each tile. The loads cover eleven input columns.
+                //
+
+                if (RowsInside && tw + 4 <= TileWidthCount && 2 * tw >= PaddingLeft &&
+                    iw + 11 <= InputWidth) {
+
+                    MLAS_FLOAT32X4 d[4][4];
+
+                    for (size_t i = 0; i < 4; i++) {
+
+                        const float* row = input + (ih + i) * InputWidth + iw;
+
+                        for (size_t j = 0; j < 4; j++) {
+                            d[i][j] = MlasShuffleEvenFloat32x4(MlasLoadFloat32x4(row + j),
+                                MlasLoadFloat32x4(row + j + 4));
+                        }
+                    }
+
+                    for (size_t i = 0; i < 4; i++) {
+
+                        MLAS_FLOAT32X4 t0;
+                        MLAS_FLOAT32X4 t1;
+                        MLAS_FLOAT32X4 t2;
+                        MLAS_FLOAT32X4 t3;
+
+                        if (i == 0) {
+                            t0 = MlasSubtractFloat32x4(d[0][0], d[2][0]);
+                            t1 = MlasSubtractFloat32x4(d[0][1], d[2][1]);
+                            t2 = MlasSubtractFloat32x4(d[0][2], d[2][2]);
+                            t3 = MlasSubtractFloat32x4(d[0][3], d[2][3]);
+                        } else if (i == 1) {
+                            t0 = MlasAddFloat32x4(d[1][0], d[2][0]);
+                            t1 = MlasAddFloat32x4(d[1][1], d[2][1]);
+                            t2 = MlasAddFloat32x4(d[1][2], d[2][2]);
+                            t3 = MlasAddFloat32x4(d[1][3], d[2][3]);
+                        } else if (i == 2) {
+                            t0 = MlasSubtractFloat32x4(d[2][0], d[1][0]);
+                            t1 = MlasSubtractFloat32x4(d[2][1], d[1][1]);
+                            t2 = MlasSubtractFloat32x4(d[2][2], d[1][2]);
+                            t3 = MlasSubtractFloat32x4(d[2][3], d[1][3]);
+                        } else {
+                            t0 = MlasSubtractFloat32x4(d[1][0], d[3][0]);
+                            t1 = MlasSubtractFloat32x4(d[1][1], d[3][1]);
+                            t2 = MlasSubtractFloat32x4(d[1][2], d[3][2]);
+                            t3 = MlasSubtractFloat32x4(d[1][3], d[3][3]);
+                        }
+
+                        float* v = output + (i * 4) * TransformStride + t;
+
+                        MlasStoreFloat32x4(v, MlasSubtractFloat32x4(t0, t2));
+                        MlasStoreFloat32x4(v + TransformStride, MlasAddFloat32x4(t1, t2));
+                        MlasStoreFloat32x4(v + 2 * TransformStride, MlasSubtractFloat32x4(t2, t1));
+                        MlasStoreFloat32x4(v + 3 * TransformStride, MlasSubtractFloat32x4(t1, t3));
+                    }
+
+                    tw += 4;
+                    continue;
+                }
+
+                //
+                // Load the tile with zero padding and transform it.
+                //
+
+                float d[4][4];
+
+                for (size_t i = 0; i < 4; i++) {
+                    for (size_t j = 0; j < 4; j++) {
+                        d[i][j] = (ih + i < InputHeight && iw + j < InputWidth) ?
+                            input[(ih + i) * InputWidth + iw + j] : 0.0f;
+                    }
+                }
+
+                float s[4][4];
+
+                for (size_t j = 0; j < 4; j++) {
+                    s[0][j] = d[0][j] - d[2][j];
+                    s[1][j] = d[1][j] + d[2][j];
+                    s[2][j] = d[2][j] - d[1][j];
+                    s[3][j] = d[1][j] - d[3][j];
+                }
+
+                float* v = output + t;
+
+                for (size_t i = 0; i < 4; i++) {
+                    v[(i * 4 + 0) * TransformStride] = s[i][0] - s[i][2];
+                    v[(i * 4 + 1) * TransformStride] = s[i][1] + s[i][2];
+                    v[(i * 4 + 2) * TransformStride] = s[i][2] - s[i][1];
+                    v[(i * 4 + 3) * TransformStride] = s[i][1] - s[i][3];
+                }
+
+                tw++;
+            }
+        }
+    }
+}
+
+void
+MlasConvWinogradTransformOutput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* TransformedOutput,
+    size_t TileRowStart,
+    size_t TileRows,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a block of tiles produced by the Winograd
+    F(2x2, 3x3) algorithm to the 2x2 output tiles by computing A^T * m * A
+    for each tile and filter.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    TransformedOutput - Supplies the transformed output in
+        [16][FilterCount][TileCount] order.
+
+    TileRowStart - Supplies the index of the first row of tiles.
+
+    TileRows - Supplies the number of rows of tiles.
+
+    Output - Supplies the output tensor for a batch.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+
+    const size_t TileWidthCount = (OutputWidth + 1) / 2;
+    const size_t TileCount = TileRows * TileWidthCount;
+    const size_t TransformStride = FilterCount * TileCount;
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        const float* input = TransformedOutput + f * TileCount;
+        float* output = Output + f * OutputSize;
+
+        for (size_t tr = 0; tr < TileRows; tr++) {
+
+            const size_t oh = 2 * (TileRowStart + tr);
+            const size_t RowCount = std::min(OutputHeight - oh, size_t(2));
+
+            size_t tw = 0;
+
+            while (tw < TileWidthCount) {
+
+                const size_t ow = 2 * tw;
+                const size_t t = tr * TileWidthCount + tw;
+
+                //
+                // Transform four adjacent tiles with vector operations and
+                // interleave the columns of the tiles if the tiles are fully
+                // inside the output.
+                //
+
+                if (RowCount == 2 && tw + 4 <= TileWidthCount && ow + 8 <= OutputWidth) {
+
+                    MLAS_FLOAT32X4 r[2][4];
+
+                    for (size_t j = 0; j < 4; j++) {
+
+                        MLAS_FLOAT32X4 m0 = MlasLoadFloat32x4(input + (0 * 4 + j) * TransformStride + t);
+                        MLAS_FLOAT32X4 m1 = MlasLoadFloat32x4(input + (1 * 4 + j) * TransformStride + t);
+                        MLAS_FLOAT32X4 m2 = MlasLoadFloat32x4(input + (2 * 4 + j) * TransformStride + t);
+                        MLAS_FLOAT32X4 m3 = MlasLoadFloat32x4(input + (3 * 4 + j) * TransformStride + t);
+
+                        r[0][j] = MlasAddFloat32x4(MlasAddFloat32x4(m0, m1), m2);
+                        r[1][j] = MlasSubtractFloat32x4(MlasSubtractFloat32x4(m1, m2), m3);
+                    }
+
+                    for (size_t i = 0; i < 2; i++) {
+
+                        MLAS_FLOAT32X4 y0 = MlasAddFloat32x4(MlasAddFloat32x4(r[i][0], r[i][1]), r[i][2]);
+                        MLAS_FLOAT32X4 y1 = MlasSubtractFloat32x4(MlasSubtractFloat32x4(r[i][1], r[i][2]), r[i][3]);
+
+                        float* y = output + (oh + i) * OutputWidth + ow;
+
+                        MlasStoreFloat32x4(y, MlasInterleaveLowFloat32x4(y0, y1));
+                        MlasStoreFloat32x4(y + 4, MlasInterleaveHighFloat32x4(y0, y1));
+                    }
+
+                    tw += 4;
+                    continue;
+                }
+
+                //
+                // Transform the tile and store the rows and columns that are
+                // inside the output.
+                //
+
+                float r[2][4];
+
+                for (size_t j = 0; j < 4; j++) {
+
+                    const float m0 = input[(0 * 4 + j) * TransformStride + t];
+                    const float m1 = input[(1 * 4 + j) * TransformStride + t];
+                    const float m2 = input[(2 * 4 + j) * TransformStride + t];
+                    const float m3 = input[(3 * 4 + j) * TransformStride + t];
+
+                    r[0][j] = m0 + m1 + m2;
+                    r[1][j] = m1 - m2 - m3;
+                }
+
+                const size_t ColumnCount = std::min(OutputWidth - ow, size_t(2));
+
+                for (size_t i = 0; i < RowCount; i++) {
+
+                    float* y = output + (oh + i) * OutputWidth + ow;
+
+                    y[0] = r[i][0] + r[i][1] + r[i][2];
+
+                    if (ColumnCount == 2) {
+                        y[1] = r[i][1] - r[i][2] - r[i][3];
+                    }
+                }
+
+                tw++;
+            }
+        }
+    }
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Winograd F(2x2, 3x3) convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+
+    const size_t TileHeightCount = (Parameters->OutputShape[0] + 1) / 2;
+    const size_t TileWidthCount = (OutputWidth + 1) / 2;
+    const size_t TileRowsPerBlock = Parameters->u.Winograd.TileRowsPerBlock;
+    const size_t BlockCount = (TileHeightCount + TileRowsPerBlock - 1) / TileRowsPerBlock;
+
+    //
+    // Partition the operation by blocks of tile rows and carve the thread's
+    // section of the working buffer into the transformed input and output.
+    //
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount, Parameters->BatchCount * BlockCount,
+        &WorkIndex, &WorkRemaining);
+
+    float* TransformedInput = WorkBlock->WorkingBuffer + Index * Parameters->u.Winograd.ThreadBufferSize;
+
+    while (WorkRemaining > 0) {
+
+        const size_t batch = WorkIndex / BlockCount;
+        const size_t TileRowStart = (WorkIndex % BlockCount) * TileRowsPerBlock;
+        const size_t TileRows = std::min(TileHeightCount - TileRowStart, TileRowsPerBlock);
+        const size_t TileCount = TileRows * TileWidthCount;
+
+        float* TransformedOutput = TransformedInput + MLAS_CONV_WINOGRAD_TILE_ELEMENTS *
+            InputChannels * TileCount;
+
+        MlasConvWinogradTransformInput(Parameters, WorkBlock->Input + batch * InputChannels *
+            Parameters->InputSize, TileRowStart, TileRows, TransformedInput);
+
+        //
+        // Multiply each element of the transformed filter by the matching
+        // element of the transformed input tiles.
+        //
+
+        for (size_t k = 0; k < MLAS_CONV_WINOGRAD_TILE_ELEMENTS; k++) {
+
+            MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, TileCount, InputChannels,
+                1.0f, WorkBlock->Filter + k * FilterCount * InputChannels, InputChannels,
+                TransformedInput + k * InputChannels * TileCount, TileCount, 0.0f,
+                TransformedOutput + k * FilterCount * TileCount, TileCount, nullptr);
+        }
+
+        float* output = WorkBlock->Output + batch * FilterCount * OutputSize;
+
+        MlasConvWinogradTransformOutput(Parameters, TransformedOutput, TileRowStart, TileRows, output);
+
+        //
+        // Apply the activation with optional bias to the output rows of the
+        // block.
+        //
+
+        const size_t OutputRowStart = 2 * TileRowStart;
+        const size_t OutputRows = std::min(Parameters->OutputShape[0] - OutputRowStart, 2 * TileRows);
+
+        MlasActivation(Parameters->Activation, output + OutputRowStart * OutputWidth,
+            WorkBlock->Bias, FilterCount, OutputRows * OutputWidth, OutputSize);
+
+        WorkIndex++;
+        WorkRemaining--;
+    }
+}
+
+inline
+bool
+MlasConvTryMultithread(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine attempts to launch a convolution operation across multiple
+    threads.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns true if the operation was completed across multiple threads, else
+    false if the operation should fall back to a single thread.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK WorkBlock;
+
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t ThreadStrideN = Parameters->u.ExpandThenGemmSegmented.ThreadStrideN;
+
+    if (ThreadStrideN >= OutputSize) {
+        return false;
+    }
+
+    //
+    // Initialize the common fields of the work block.
+    //
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.Filter = Filter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.Output = Output;
+
+    //
+    // Segment the operation across multiple threads.
+    //
+
+    int32_t Index = 0;
+    size_t SegmentCountN;
+
+    for (size_t SegmentStartN = 0; SegmentStartN < OutputSize; SegmentStartN += SegmentCountN) {
+
+        SegmentCountN = OutputSize - SegmentStartN;
+
+        if (SegmentCountN > ThreadStrideN) {
+            SegmentCountN = ThreadStrideN;
+        }
+
+        WorkBlock.Segments[Index].StartN = SegmentStartN;
+        WorkBlock.Segments[Index].CountN = SegmentCountN;
+
+        Index++;
+    }
+
+    MlasExecuteThreaded(MlasConvOperationThreaded, &WorkBlock, Index, ThreadPool);
+
+    return true;
+}
+
+void
+MLASCALL
+MlasConv(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t K = Parameters->K;
+
+    const size_t InputGroupSize = Parameters->InputChannels * Parameters->InputSize;
+    const size_t OutputGroupSize = FilterCount * OutputSize;
+    const size_t FilterGroupSize = FilterCount * K;
+
+    const size_t BatchCount = Parameters->BatchCount;
+    const size_t GroupCount = Parameters->GroupCount;
+
+    const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
+
+    //
+    // Schedule the channel planes of a depthwise convolution across multiple
+    // threads.
+    //
+
+    if (Algorithm == MlasConvAlgorithmDepthwise) {
+
+        MLAS_CONV_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Parameters = Parameters;
+        WorkBlock.Input = Input;
+        WorkBlock.Filter = Filter;
+        WorkBlock.Bias = Bias;
+        WorkBlock.WorkingBuffer = nullptr;
+        WorkBlock.Output = Output;
+        WorkBlock.TargetThreadCount = Parameters->ThreadCount;
+
+        MlasExecuteThreaded(MlasConvDepthwiseThreaded, &WorkBlock, Parameters->ThreadCount, ThreadPool);
+
+        return;
+    }
+
+    //
+    // Schedule blocks of Winograd tiles across multiple threads. Transform the
+    // filter to the end of the working buffer unless the caller supplied the
+    // filter packed by MlasConvWinogradPackFilter.
+    //
+
+    if (Algorithm == MlasConvAlgorithmWinograd) {
+
+        const float* TransformedFilter = (const float*)Parameters->u.Winograd.PackedFilter;
+
+        if (TransformedFilter == nullptr) {
+
+            float* FilterBuffer = WorkingBuffer + Parameters->ThreadCount * Parameters->u.Winograd.ThreadBufferSize;
+
+            MlasConvWinogradTransformFilter(FilterCount, Parameters->InputChannels, Filter, FilterBuffer);
+
+            TransformedFilter = FilterBuffer;
+        }
+
+        MLAS_CONV_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Parameters = Parameters;
+        WorkBlock.Input = Input;
+        WorkBlock.Filter = TransformedFilter;
+        WorkBlock.Bias = Bias;
+        WorkBlock.WorkingBuffer = WorkingBuffer;
+        WorkBlock.Output = Output;
+        WorkBlock.TargetThreadCount = Parameters->ThreadCount;
+
+        MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock, Parameters->ThreadCount, ThreadPool);
+
+        return;
+    }
+
+    //
+    // Schedule batches of GEMMs across multiple threads.
+    //
+
+    if (Algorithm == MlasConvAlgorithmGemmDirect && ((BatchCount > 1) || (GroupCount > 1))) {
+
+        const size_t BatchGroupCount = BatchCount * GroupCount;
+
+        int32_t TargetThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+        if (size_t(TargetThreadCount) >= BatchGroupCount) {
+            TargetThreadCount = int32_t(BatchGroupCount);
+        }
+
+        MLAS_CONV_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Parameters = Parameters;
+        WorkBlock.Input = Input;
+        WorkBlock.Filter = Filter;
+        WorkBlock.Bias = Bias;
+        WorkBlock.WorkingBuffer = nullptr;
+        WorkBlock.Output = Output;
+        WorkBlock.TargetThreadCount = TargetThreadCount;
+
+        MlasExecuteThreaded(MlasConvGemmDirectThreaded, &WorkBlock, TargetThreadCount, ThreadPool);
+
+        return;
+    }
+
+    //
+    // Iterate over each batch and group.
+    //
+
+    for (size_t batch = 0; batch < BatchCount; batch++) {
+
+        const float* filter = Filter;
+        const float* bias = Bias;
+
+        for (size_t group = 0; group < GroupCount; group++) {
+
+            //
+            // Dispatch the convolution.
+            //
+
+            switch (Algorithm) {
+
+                case MlasConvAlgorithmGemmDirect:
+                {
+                    //
+                    // Invoke the threaded GEMM directly with the input tensor.
+                    //
+
+                    MlasGemm(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount,
+                        OutputSize, K, 1.0f, filter, K, Input, Parameters->u.GemmDirect.ldb, 0.0f,
+                        Output, OutputSize, ThreadPool);
+
+                    //
+                    // Apply the activation with optional bias.
+                    //
+
+                    MlasActivation(Parameters->Activation, Output, bias, FilterCount,
+                        OutputSize, OutputSize);
+
+                    break;
+                }
+
+                case MlasConvAlgorithmExpandThenGemm:
+                {
+                    //
+                    // Expand the input tensor to the working buffer and then invoke the
+                    // threaded GEMM.
+                    //
+
+                    if (Parameters->Dimensions == 2) {
+                        MlasConvIm2Col(Parameters, Input, WorkingBuffer, 0, K, 0, OutputSize);
+                    } else {
+                        MlasConvVol2Col(Parameters, Input, WorkingBuffer, 0, K, 0, OutputSize);
+                    }
+
+                    MlasGemm(CblasNoTrans, CblasNoTrans, FilterCount, OutputSize, K, 1.0f, filter,
+                        K, WorkingBuffer, OutputSize, 0.0f, Output, OutputSize, ThreadPool);
+
+                    //
+                    // Apply the activation with optional bias.
+                    //
+
+                    MlasActivation(Parameters->Activation, Output, bias, FilterCount,
+                        OutputSize, OutputSize);
+
+                    break;
+                }
+
+                case MlasConvAlgorithmExpandThenGemmSegmented:
+                {
+                    //
+                    // Attempt to launch the convolution across multiple threads or fall
+                    // back to a single thread.
+                    //
+
+                    if (!MlasConvTryMultithread(Parameters, Input, filter, bias, WorkingBuffer,
+                        Output, ThreadPool)) {
+                        MlasConvOperation(Parameters, Input, filter, bias, WorkingBuffer,
+                            Output, 0, OutputSize);
+                    }
+
+                    break;
+                }
+            }
+
+            //
+            // Advance the buffer pointers.
+            //
+
+            if (bias != nullptr) {
+                bias += FilterCount;
+            }
+
+            filter += FilterGroupSize;
+            Input += InputGroupSize;
+            Output += OutputGroupSize;
+        }
+    }
+}
+
+int32_t
+MlasConvTargetThreadCount(
+    double Complexity,
+    int32_t ThreadCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of threads to use for a convolution
+    operation.
+
+Arguments:
+
+    Complexity - Supplies the number of multiply/accumulate operations of the
+        convolution operation.
+
+    ThreadCount - Supplies the number of threads requested by the caller, else
+        zero to compute the number of threads from the complexity of the
+        operation. Small requests should run using the single threaded path.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns the number of threads to use.
+
+--*/
+{
+    int32_t TargetThreadCount;
+
+    if (ThreadCount > 0) {
+        TargetThreadCount = std::min(ThreadCount, int32_t(MLAS_MAXIMUM_THREAD_COUNT));
+    } else if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    return TargetThreadCount;
+}
+
+void
+MlasConvPrepareDepthwise(
+    MLAS_CONV_PARAMETERS* Parameters,
+    int32_t ThreadCount,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a depthwise convolution operation, where each
+    group has a single input channel. The output channel planes are computed
+    directly from the input channel planes, so no working buffer is needed.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    ThreadCount - Supplies the number of threads requested by the caller, else
+        zero to compute the number of threads from the complexity of the
+        operation.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Limit the number of threads to the number of output channel planes.
+    //
+
+    const size_t PlaneCount = Parameters->BatchCount * Parameters->GroupCount * Parameters->FilterCount;
+
+    double Complexity = double(PlaneCount) * double(Parameters->OutputSize) * double(Parameters->K);
+
+    int32_t TargetThreadCount = MlasConvTargetThreadCount(Complexity, ThreadCount, ThreadPool);
+
+    if (size_t(TargetThreadCount) >= PlaneCount) {
+        TargetThreadCount = int32_t(PlaneCount);
+    }
+
+    Parameters->ThreadCount = TargetThreadCount;
+
+    Parameters->Algorithm = MlasConvAlgorithmDepthwise;
+
+    *WorkingBufferSize = 0;
+}
+
+void
+MlasConvPrepareWinograd(
+    MLAS_CONV_PARAMETERS* Parameters,
+    int32_t ThreadCount,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a Winograd F(2x2, 3x3) convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    ThreadCount - Supplies the number of threads requested by the caller, else
+        zero to compute the number of threads from the complexity of the
+        operation.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BatchCount = Parameters->BatchCount;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+
+    const size_t TileHeightCount = (Parameters->OutputShape[0] + 1) / 2;
+    const size_t TileWidthCount = (Parameters->OutputShape[1] + 1) / 2;
+
+    double Complexity = double(BatchCount) * double(FilterCount) *
+        double(Parameters->OutputSize) * double(Parameters->K);
+
+    int32_t TargetThreadCount = MlasConvTargetThreadCount(Complexity, ThreadCount, ThreadPool);
+
+    //
+    // Size the blocks of tile rows so that the transformed input and output
+    // of a block fit in the targeted working buffer size per thread, while
+    // providing a block for each thread.
+    //
+
+    const size_t TileElements = MLAS_CONV_WINOGRAD_TILE_ELEMENTS * (InputChannels + FilterCount);
+
+    size_t TileRowsPerBlock = MLAS_CONV_WINOGRAD_BLOCK_ELEMENTS / (TileElements * TileWidthCount);
+
+    const size_t BlocksPerBatch = (size_t(TargetThreadCount) + BatchCount - 1) / BatchCount;
+
+    TileRowsPerBlock = std::min(TileRowsPerBlock, (TileHeightCount + BlocksPerBatch - 1) / BlocksPerBatch);
+
+    const size_t MinimumTileRowsPerBlock = (MLAS_CONV_WINOGRAD_MINIMUM_BLOCK_TILES + TileWidthCount - 1) / TileWidthCount;
+
+    TileRowsPerBlock = std::min(std::max(TileRowsPerBlock, MinimumTileRowsPerBlock), TileHeightCount);
+
+    const size_t BlockCount = BatchCount * ((TileHeightCount + TileRowsPerBlock - 1) / TileRowsPerBlock);
+
+    if (size_t(TargetThreadCount) >= BlockCount) {
+        TargetThreadCount = int32_t(BlockCount);
+    }
+
+    Parameters->ThreadCount = TargetThreadCount;
+
+    Parameters->Algorithm = MlasConvAlgorithmWinograd;
+    Parameters->u.Winograd.TileRowsPerBlock = TileRowsPerBlock;
+    Parameters->u.Winograd.ThreadBufferSize = TileElements * TileRowsPerBlock * TileWidthCount;
+    Parameters->u.Winograd.FilterBufferSize = MLAS_CONV_WINOGRAD_TILE_ELEMENTS * FilterCount * InputChannels;
+    Parameters->u.Winograd.PackedFilter = nullptr;
+
+    *WorkingBufferSize = TargetThreadCount * Parameters->u.Winograd.ThreadBufferSize +
+        Parameters->u.Winograd.FilterBufferSize;
+}
+
+void
+MlasConvPrepareExpandThenGemmSegmented(
+    MLAS_CONV_PARAMETERS* Parameters,
+    int32_t ThreadCount,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a convolution operation that is segmented across
+    multiple threads by slicing the N dimension (see MlasSgemmTryMultithread).
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    ThreadCount - Supplies the number of threads requested by the caller, else
+        zero to compute the number of threads from the complexity of the
+        operation.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t OutputSize = Parameters->OutputSize;
+
+    double Complexity = double(Parameters->FilterCount) * double(OutputSize) * double(Parameters->K);
+
+    int32_t TargetThreadCount = MlasConvTargetThreadCount(Complexity, ThreadCount, ThreadPool);
+
+    //
+    // Compute the thread stride for slicing the N dimension.
+    //
+
+    size_t StrideN = OutputSize / TargetThreadCount;
+
+    if ((StrideN * TargetThreadCount) != OutputSize) {
+        StrideN++;
+    }
+
+    if (TargetThreadCount > 1) {
+
+        StrideN = (StrideN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+        if (StrideN >= OutputSize) {
+            TargetThreadCount = 1;
+        } else if (StrideN * (TargetThreadCount - 1) >= OutputSize) {
+            TargetThreadCount--;
+        }
+    }
+
+    Parameters->ThreadCount = TargetThreadCount;
+
+    Parameters->Algorithm = MlasConvAlgorithmExpandThenGemmSegmented;
+    Parameters->u.ExpandThenGemmSegmented.ThreadStrideN = StrideN;
+
+    *WorkingBufferSize = TargetThreadCount * MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD;
+}
+
+void
+MlasConvPrepareExpandThenGemm(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a convolution operation that performs the full
+    matrix expansion and then invokes the threaded GEMM.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    Parameters->Algorithm = MlasConvAlgorithmExpandThenGemm;
+
+    *WorkingBufferSize = Parameters->OutputSize * Parameters->K;
+}
+
+bool
+MlasConvIsWinogradSupported(
+    const MLAS_CONV_PARAMETERS* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine tests if the Winograd F(2x2, 3x3) algorithm can compute the
+    convolution operation: a 3x3 convolution with unit strides and dilations.
+    The channel counts must be large enough for the filter packing layout.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+Return Value:
+
+    Returns true if the Winograd algorithm is supported.
+
+--*/
+{
+    return Parameters->Dimensions == 2 && Parameters->GroupCount == 1 &&
+        Parameters->StrideShape[0] == 1 && Parameters->StrideShape[1] == 1 &&
+        Parameters->DilationShape[0] == 1 && Parameters->DilationShape[1] == 1 &&
+        Parameters->KernelShape[0] == 3 && Parameters->KernelShape[1] == 3 &&
+        Parameters->InputChannels >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS &&
+        Parameters->FilterCount >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS &&
+        Parameters->OutputShape[0] >= 4 && Parameters->OutputShape[1] >= 4;
+}
+
+void
+MLASCALL
+MlasConvPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t Dimensions,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t FilterCount,
+    const MLAS_ACTIVATION* Activation,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a convolution operation by computing required
+    parameters including the required working buffer size for intermediate
+    results.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    Dimensions - Supplies the number of dimensions (must be 2 or 3).
+
+    BatchCount - Supplies the number of batches to the processed.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    InputShape - Supplies the shape of the input tensor.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    Padding - Supplies the number of zero padding elements at the edge of the
+        input tensor.
 
     StrideShape - Supplies the shape of the stride.
 
@@ -1166,6 +2413,34 @@ Return Value:
         }
     }
 
+    if (Dimensions == 2 && GroupCount > 1 && InputChannels == 1) {
+
+        //
+        // Detect a depthwise convolution, where each group has a single input
+        // channel.
+        //
+
+        MlasConvPrepareDepthwise(Parameters, 0, WorkingBufferSize, ThreadPool);
+
+        return;
+    }
+
+    if (MlasConvIsWinogradSupported(Parameters) &&
+        BatchCount * OutputSize >= MLAS_CONV_WINOGRAD_MINIMUM_OUTPUT_SIZE) {
+
+        //
+        // Use the Winograd F(2x2, 3x3) algorithm for a 3x3 convolution with
+        // unit strides and dilations, which reduces the number of multiplies
+        // by 2.25x. Each 2x2 output tile is computed from a 4x4 input tile, so
+        // the channel counts and the output must be large enough to amortize
+        // the input, output and filter transforms.
+        //
+
+        MlasConvPrepareWinograd(Parameters, 0, WorkingBufferSize, ThreadPool);
+
+        return;
+    }
+
     if (FilterCount > OutputSize) {
 
         //
@@ -1173,9 +2448,7 @@ Return Value:
         // full matrix expansion and then invoke the threaded GEMM.
         //
 
-        Parameters->Algorithm = MlasConvAlgorithmExpandThenGemm;
-
-        *WorkingBufferSize = OutputSize * K;
+        MlasConvPrepareExpandThenGemm(Parameters, WorkingBufferSize);
 
     } else {
 
@@ -1183,52 +2456,179 @@ Return Value:
         // Segment the operation across multiple threads by slicing the N
         // dimension (see MlasSgemmTryMultithread).
         //
-        // Compute the number of target threads given the complexity of the
-        // convolution operation. Small requests should run using the single
-        // threaded path.
-        //
 
-        int32_t TargetThreadCount;
-        double Complexity = double(FilterCount) * double(OutputSize) * double(K);
+        MlasConvPrepareExpandThenGemmSegmented(Parameters, 0, WorkingBufferSize, ThreadPool);
+    }
+}
 
-        if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
-            TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
-        } else {
-            TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
-        }
+bool
+MLASCALL
+MlasConvPrepareAlgorithm(
+    MLAS_CONV_PARAMETERS* Parameters,
+    MLAS_CONV_ALGORITHM Algorithm,
+    int32_t ThreadCount,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine overrides the algorithm and the number of threads selected by
+    MlasConvPrepare for a convolution operation, for callers that measure the
+    candidate algorithms of a convolution shape and keep the fastest.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation, as initialized by
+        MlasConvPrepare.
+
+    Algorithm - Supplies the algorithm to use.
+
+        MlasConvAlgorithmGemmDirect can only be used if MlasConvPrepare
+        selected it.
+
+    ThreadCount - Supplies the number of threads to use, else zero to compute
+        the number of threads from the complexity of the operation. The
+        number of threads is limited to the number of available threads and
+        to the work available to the algorithm. The value is ignored for
+        MlasConvAlgorithmExpandThenGemm and MlasConvAlgorithmGemmDirect.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
 
-        int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns true if the algorithm can compute the convolution operation,
+    else false, in which case the parameters are not modified.
+
+--*/
+{
+    switch (Algorithm) {
 
-        if (TargetThreadCount >= MaximumThreadCount) {
-            TargetThreadCount = MaximumThreadCount;
+        case MlasConvAlgorithmGemmDirect:
+        {
+            if (Parameters->Algorithm != MlasConvAlgorithmGemmDirect) {
+                return false;
+            }
+
+            *WorkingBufferSize = 0;
+
+            return true;
         }
 
-        //
-        // Compute the thread stride for slicing the N dimension.
-        //
+        case MlasConvAlgorithmExpandThenGemm:
+        {
+            MlasConvPrepareExpandThenGemm(Parameters, WorkingBufferSize);
+
+            return true;
+        }
 
-        size_t StrideN = OutputSize / TargetThreadCount;
+        case MlasConvAlgorithmExpandThenGemmSegmented:
+        {
+            MlasConvPrepareExpandThenGemmSegmented(Parameters, ThreadCount, WorkingBufferSize, ThreadPool);
 
-        if ((StrideN * TargetThreadCount) != OutputSize) {
-            StrideN++;
+            return true;
         }
 
-        if (TargetThreadCount > 1) {
+        case MlasConvAlgorithmDepthwise:
+        {
+            if (Parameters->Dimensions != 2 || Parameters->GroupCount == 1 ||
+                Parameters->InputChannels != 1) {
+                return false;
+            }
+
+            MlasConvPrepareDepthwise(Parameters, ThreadCount, WorkingBufferSize, ThreadPool);
 
-            StrideN = (StrideN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+            return true;
+        }
 
-            if (StrideN >= OutputSize) {
-                TargetThreadCount = 1;
-            } else if (StrideN * (TargetThreadCount - 1) >= OutputSize) {
-                TargetThreadCount--;
+        case MlasConvAlgorithmWinograd:
+        {
+            if (!MlasConvIsWinogradSupported(Parameters)) {
+                return false;
             }
+
+            MlasConvPrepareWinograd(Parameters, ThreadCount, WorkingBufferSize, ThreadPool);
+
+            return true;
         }
+    }
+
+    return false;
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t FilterCount,
+    size_t InputChannels
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed filter buffer
+    of a 3x3 convolution that uses the Winograd algorithm.
+
+Arguments:
+
+    FilterCount - Supplies the number of filters.
 
-        Parameters->ThreadCount = TargetThreadCount;
+    InputChannels - Supplies the number of input channels.
+
+Return Value:
 
-        Parameters->Algorithm = MlasConvAlgorithmExpandThenGemmSegmented;
-        Parameters->u.ExpandThenGemmSegmented.ThreadStrideN = StrideN;
+    Returns the size in bytes for the packed filter buffer, else zero if
+    MlasConvPrepare does not select the Winograd algorithm for these channel
+    counts.
 
-        *WorkingBufferSize = TargetThreadCount * MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD;
+--*/
+{
+    if (InputChannels < MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS ||
+        FilterCount < MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS) {
+        return 0;
     }
+
+    return MLAS_CONV_WINOGRAD_TILE_ELEMENTS * FilterCount * InputChannels * sizeof(float);
+}
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    void* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the contents of a 3x3 filter tensor to the transformed
+    layout used by the Winograd algorithm of MlasConv.
+
+Arguments:
+
+    FilterCount - Supplies the number of filters.
+
+    InputChannels - Supplies the number of input channels.
+
+    Filter - Supplies the filter tensor in [FilterCount][InputChannels][3][3]
+        order.
+
+    PackedFilter - Supplies the address of the packed filter buffer, sized by
+        MlasConvWinogradPackFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasConvWinogradTransformFilter(FilterCount, InputChannels, Filter, (float*)PackedFilter);
 }
@@ -0,0 +1,786 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm.cpp
+
+Abstract:
+
+    This module implements the half precision (IEEE binary16 and bfloat16)
+    matrix/matrix multiply operation and the conversion routines between the
+    half precision and single precision floating point formats.
+
+    The matrix multiply converts tiles of the half precision source matrices to
+    single precision buffers and uses the single precision kernels to compute
+    the product, so the products are accumulated in single precision and the
+    result is rounded only once when the output tile is stored.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the parameters to tile the matrix multiply operation. The tiles of
+// matrices A, B, and C are converted to single precision buffers on the stack,
+// so these values bound the per thread stack usage.
+//
+
+#define MLAS_HALFGEMM_STRIDEM                       64
+#define MLAS_HALFGEMM_STRIDEN                       64
+#define MLAS_HALFGEMM_STRIDEK                       128
+
+//
+// Define the parameters to execute segments of a half precision matrix
+// multiply operation on worker threads.
+//
+
+struct MLAS_HALFGEMM_WORK_BLOCK {
+    MLAS_HALF_FORMAT Format;
+    CBLAS_TRANSPOSE TransA;
+    CBLAS_TRANSPOSE TransB;
+    size_t M;
+    size_t N;
+    size_t K;
+    float alpha;
+    const uint16_t* A;
+    size_t lda;
+    const uint16_t* B;
+    size_t ldb;
+    float beta;
+    uint16_t* C;
+    size_t ldc;
+    size_t TileCountN;
+    size_t TileCount;
+    int32_t ThreadCount;
+};
+
+MLAS_FORCEINLINE
+float
+MlasConvertHalfToFloatScalar(
+    uint16_t Value
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a half precision float to a single precision float.
+
+Arguments:
+
+    Value - Supplies the half precision value to convert.
+
+Return Value:
+
+    Returns the single precision value.
+
+--*/
+{
+    const uint32_t Sign = uint32_t(Value & 0x8000) << 16;
+    const uint32_t ExponentMantissa = Value & 0x7FFF;
+
+    union { uint32_t u32; float f32; } Result;
+
+    if (ExponentMantissa >= 0x7C00) {
+
+        //
+        // Infinity or NaN: widen the mantissa and force the maximum exponent.
+        // NaNs are quieted.
+        //
+
+        Result.u32 = 0x7F800000 | ((ExponentMantissa & 0x3FF) << 13);
+
+        if (ExponentMantissa != 0x7C00) {
+            Result.u32 |= 0x00400000;
+        }
+
+    } else if (ExponentMantissa >= 0x0400) {
+
+        //
+        // Normal value: rebias the exponent from 15 to 127.
+        //
+
+        Result.u32 = (ExponentMantissa << 13) + 0x38000000;
+
+    } else {
+
+        //
+        // Zero or denormal value: scale the mantissa by 2^-24.
+        //
+
+        Result.f32 = float(ExponentMantissa) * 5.9604644775390625e-8f;
+    }
+
+    Result.u32 |= Sign;
+
+    return Result.f32;
+}
+
+MLAS_FORCEINLINE
+uint16_t
+MlasConvertFloatToHalfScalar(
+    float Value
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a single precision float to a half precision float
+    using round to nearest even.
+
+Arguments:
+
+    Value - Supplies the single precision value to convert.
+
+Return Value:
+
+    Returns the half precision value.
+
+--*/
+{
+    union { uint32_t u32; float f32; } Input;
+
+    Input.f32 = Value;
+
+    const uint32_t Sign = Input.u32 & 0x80000000;
+    Input.u32 ^= Sign;
+
+    uint32_t Result;
+
+    if (Input.u32 >= 0x47800000) {
+
+        //
+        // Overflow to infinity or NaN. NaNs are quieted and keep the upper bits
+        // of the payload.
+        //
+
+        Result = (Input.u32 > 0x7F800000) ? (0x7E00 | ((Input.u32 >> 13) & 0x3FF)) : 0x7C00;
+
+    } else if (Input.u32 < 0x38800000) {
+
+        //
+        // Zero or denormal result: align the mantissa by adding 0.5 so that the
+        // floating point addition performs the rounding.
+        //
+
+        union { uint32_t u32; float f32; } Denormal;
+
+        Denormal.f32 = Input.f32 + 0.5f;
+        Result = Denormal.u32 - 0x3F000000;
+
+    } else {
+
+        //
+        // Normal result: rebias the exponent and round the mantissa to nearest
+        // even.
+        //
+
+        const uint32_t MantissaOdd = (Input.u32 >> 13) & 1;
+
+        Input.u32 += 0xC8000FFF;
+        Input.u32 += MantissaOdd;
+        Result = Input.u32 >> 13;
+    }
+
+    return uint16_t(Result | (Sign >> 16));
+}
+
+MLAS_FORCEINLINE
+float
+MlasConvertBFloat16ToFloatScalar(
+    uint16_t Value
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a bfloat16 float to a single precision float.
+
+Arguments:
+
+    Value - Supplies the bfloat16 value to convert.
+
+Return Value:
+
+    Returns the single precision value.
+
+--*/
+{
+    union { uint32_t u32; float f32; } Result;
+
+    Result.u32 = uint32_t(Value) << 16;
+
+    return Result.f32;
+}
+
+MLAS_FORCEINLINE
+uint16_t
+MlasConvertFloatToBFloat16Scalar(
+    float Value
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a single precision float to a bfloat16 float using
+    round to nearest even.
+
+Arguments:
+
+    Value - Supplies the single precision value to convert.
+
+Return Value:
+
+    Returns the bfloat16 value.
+
+--*/
+{
+    union { uint32_t u32; float f32; } Input;
+
+    Input.f32 = Value;
+
+    if ((Input.u32 & 0x7FFFFFFF) > 0x7F800000) {
+        return uint16_t((Input.u32 >> 16) | 0x0040);
+    }
+
+    Input.u32 += 0x7FFF + ((Input.u32 >> 16) & 1);
+
+    return uint16_t(Input.u32 >> 16);
+}
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernel(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of half precision floats to the
+    destination buffer of single precision floats.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of half precision floats.
+
+    Destination - Supplies the address of the destination buffer of single
+        precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_NEON64_INTRINSICS) && !defined(_MSC_VER)
+
+    while (Count >= 4) {
+
+        float16x4_t Vector = vreinterpret_f16_u16(vld1_u16(Source));
+        vst1q_f32(Destination, vcvt_f32_f16(Vector));
+
+        Source += 4;
+        Destination += 4;
+        Count -= 4;
+    }
+
+#endif
+
+    while (Count > 0) {
+
+        *Destination++ = MlasConvertHalfToFloatScalar(*Source++);
+        Count -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfKernel(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of single precision floats to the
+    destination buffer of half precision floats.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of single precision
+        floats.
+
+    Destination - Supplies the address of the destination buffer of half
+        precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_NEON64_INTRINSICS) && !defined(_MSC_VER)
+
+    while (Count >= 4) {
+
+        float16x4_t Vector = vcvt_f16_f32(vld1q_f32(Source));
+        vst1_u16(Destination, vreinterpret_u16_f16(Vector));
+
+        Source += 4;
+        Destination += 4;
+        Count -= 4;
+    }
+
+#endif
+
+    while (Count > 0) {
+
+        *Destination++ = MlasConvertFloatToHalfScalar(*Source++);
+        Count -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasConvertHalfToFloat(
+    MLAS_HALF_FORMAT Format,
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of half precision floats to the
+    destination buffer of single precision floats.
+
+Arguments:
+
+    Format - Supplies the format of the half precision floats.
+
+    Source - Supplies the address of the source buffer of half precision floats.
+
+    Destination - Supplies the address of the destination buffer of single
+        precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Format == MlasBFloat16Format) {
+
+        for (size_t n = 0; n < Count; n++) {
+            Destination[n] = MlasConvertBFloat16ToFloatScalar(Source[n]);
+        }
+
+    } else {
+
+#if defined(MLAS_TARGET_AMD64)
+        MlasPlatform.ConvertHalfToFloatRoutine(Source, Destination, Count);
+#else
+        MlasConvertHalfToFloatKernel(Source, Destination, Count);
+#endif
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalf(
+    MLAS_HALF_FORMAT Format,
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of single precision floats to the
+    destination buffer of half precision floats. Values are rounded to the
+    nearest even representation.
+
+Arguments:
+
+    Format - Supplies the format of the half precision floats.
+
+    Source - Supplies the address of the source buffer of single precision
+        floats.
+
+    Destination - Supplies the address of the destination buffer of half
+        precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Format == MlasBFloat16Format) {
+
+        for (size_t n = 0; n < Count; n++) {
+            Destination[n] = MlasConvertFloatToBFloat16Scalar(Source[n]);
+        }
+
+    } else {
+
+#if defined(MLAS_TARGET_AMD64)
+        MlasPlatform.ConvertFloatToHalfRoutine(Source, Destination, Count);
+#else
+        MlasConvertFloatToHalfKernel(Source, Destination, Count);
+#endif
+    }
+}
+
+void
+MlasHalfGemmConvertBlock(
+    MLAS_HALF_FORMAT Format,
+    const uint16_t* Source,
+    size_t ld,
+    size_t CountRows,
+    size_t CountColumns,
+    float* Destination
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a block of a half precision matrix to a packed single
+    precision buffer with a leading dimension of CountColumns.
+
+Arguments:
+
+    Format - Supplies the format of the half precision floats.
+
+    Source - Supplies the address of the first element of the block.
+
+    ld - Supplies the first dimension of the source matrix.
+
+    CountRows - Supplies the number of rows of the block.
+
+    CountColumns - Supplies the number of columns of the block.
+
+    Destination - Supplies the address of the single precision buffer.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (CountRows > 0) {
+
+        MlasConvertHalfToFloat(Format, Source, Destination, CountColumns);
+
+        Source += ld;
+        Destination += CountColumns;
+        CountRows -= 1;
+    }
+}
+
+void
+MlasHalfGemmTile(
+    const MLAS_HALFGEMM_WORK_BLOCK* WorkBlock,
+    size_t m,
+    size_t n,
+    size_t CountM,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine computes one tile of the output matrix of a half precision
+    matrix/matrix multiply operation.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the GEMM parameters.
+
+    m - Supplies the starting row of the output tile.
+
+    n - Supplies the starting column of the output tile.
+
+    CountM - Supplies the number of rows of the output tile.
+
+    CountN - Supplies the number of columns of the output tile.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float PanelA[MLAS_HALFGEMM_STRIDEM * MLAS_HALFGEMM_STRIDEK], 64);
+    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_HALFGEMM_STRIDEK * MLAS_HALFGEMM_STRIDEN], 64);
+    MLAS_DECLSPEC_ALIGN(float PanelC[MLAS_HALFGEMM_STRIDEM * MLAS_HALFGEMM_STRIDEN], 64);
+
+    const MLAS_HALF_FORMAT Format = WorkBlock->Format;
+    const CBLAS_TRANSPOSE TransA = WorkBlock->TransA;
+    const CBLAS_TRANSPOSE TransB = WorkBlock->TransB;
+    const size_t K = WorkBlock->K;
+    const size_t lda = WorkBlock->lda;
+    const size_t ldb = WorkBlock->ldb;
+
+    if (K == 0) {
+        std::fill_n(PanelC, CountM * CountN, 0.0f);
+    }
+
+    //
+    // Accumulate the products of the converted panels of matrices A and B in
+    // single precision.
+    //
+
+    size_t CountK;
+
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = std::min(K - k, size_t(MLAS_HALFGEMM_STRIDEK));
+
+        size_t ldPanelA;
+        size_t ldPanelB;
+
+        if (TransA == CblasNoTrans) {
+            MlasHalfGemmConvertBlock(Format, WorkBlock->A + m * lda + k, lda, CountM, CountK, PanelA);
+            ldPanelA = CountK;
+        } else {
+            MlasHalfGemmConvertBlock(Format, WorkBlock->A + k * lda + m, lda, CountK, CountM, PanelA);
+            ldPanelA = CountM;
+        }
+
+        if (TransB == CblasNoTrans) {
+            MlasHalfGemmConvertBlock(Format, WorkBlock->B + k * ldb + n, ldb, CountK, CountN, PanelB);
+            ldPanelB = CountN;
+        } else {
+            MlasHalfGemmConvertBlock(Format, WorkBlock->B + n * ldb + k, ldb, CountN, CountK, PanelB);
+            ldPanelB = CountK;
+        }
+
+        MlasSgemmOperation(TransA, TransB, CountM, CountN, CountK, WorkBlock->alpha,
+            PanelA, ldPanelA, PanelB, ldPanelB, (k == 0) ? 0.0f : 1.0f, PanelC, CountN, nullptr);
+    }
+
+    //
+    // Apply the beta scaled contents of the output matrix and round the result
+    // to half precision.
+    //
+
+    const float beta = WorkBlock->beta;
+    const size_t ldc = WorkBlock->ldc;
+
+    uint16_t* c = WorkBlock->C + m * ldc + n;
+    float* PanelCRow = PanelC;
+
+    for (size_t i = 0; i < CountM; i++) {
+
+        if (beta != 0.0f) {
+
+            float* RowC = PanelA;
+
+            MlasConvertHalfToFloat(Format, c, RowC, CountN);
+
+            for (size_t j = 0; j < CountN; j++) {
+                PanelCRow[j] += beta * RowC[j];
+            }
+        }
+
+        MlasConvertFloatToHalf(Format, PanelCRow, c, CountN);
+
+        c += ldc;
+        PanelCRow += CountN;
+    }
+}
+
+void
+MlasHalfGemmThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    half precision matrix/matrix multiply operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_HALFGEMM_WORK_BLOCK*)Context;
+
+    //
+    // Partition the operation by the tiles of the output matrix.
+    //
+
+    size_t TileIndex;
+    size_t TileRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, WorkBlock->TileCount, &TileIndex, &TileRemaining);
+
+    while (TileRemaining > 0) {
+
+        const size_t m = (TileIndex / WorkBlock->TileCountN) * MLAS_HALFGEMM_STRIDEM;
+        const size_t n = (TileIndex % WorkBlock->TileCountN) * MLAS_HALFGEMM_STRIDEN;
+
+        const size_t CountM = std::min(WorkBlock->M - m, size_t(MLAS_HALFGEMM_STRIDEM));
+        const size_t CountN = std::min(WorkBlock->N - n, size_t(MLAS_HALFGEMM_STRIDEN));
+
+        MlasHalfGemmTile(WorkBlock, m, n, CountM, CountN);
+
+        TileIndex += 1;
+        TileRemaining -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasHalfGemm(
+    MLAS_HALF_FORMAT Format,
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* B,
+    size_t ldb,
+    float beta,
+    uint16_t* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the half precision matrix/matrix multiply
+    operation (C = alpha * op(A) * op(B) + beta * C). The products are
+    accumulated in single precision.
+
+Arguments:
+
+    Format - Supplies the format of the half precision matrices.
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition). If beta
+        is zero, the prior contents of matrix C are not read.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    MLAS_HALFGEMM_WORK_BLOCK WorkBlock;
+
+    //
+    // Capture the GEMM parameters to the work block.
+    //
+
+    WorkBlock.Format = Format;
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = TransB;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.alpha = alpha;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.B = B;
+    WorkBlock.ldb = ldb;
+    WorkBlock.beta = beta;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+
+    WorkBlock.TileCountN = (N + MLAS_HALFGEMM_STRIDEN - 1) / MLAS_HALFGEMM_STRIDEN;
+    WorkBlock.TileCount = WorkBlock.TileCountN * ((M + MLAS_HALFGEMM_STRIDEM - 1) / MLAS_HALFGEMM_STRIDEM);
+
+    //
+    // Compute the number of target threads given the complexity of the GEMM
+    // operation. Limit the number of threads to the number of output tiles.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K);
+
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) >= WorkBlock.TileCount) {
+        TargetThreadCount = int32_t(WorkBlock.TileCount);
+    }
+
+    WorkBlock.ThreadCount = TargetThreadCount;
+
+    MlasExecuteThreaded(MlasHalfGemmThreaded, &WorkBlock, TargetThreadCount, ThreadPool);
+}
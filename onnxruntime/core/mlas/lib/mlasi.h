@@ -111,6 +111,14 @@ Abstract:
 
 #define MLAS_MAXIMUM_THREAD_COUNT                   16
 
+//
+// Define the maximum number of segments a threaded operation is split into,
+// which exceeds the number of threads on hybrid processors (see
+// MLAS_PLATFORM::ThreadSegmentsPerThread).
+//
+
+#define MLAS_MAXIMUM_SEGMENT_COUNT                  (MLAS_MAXIMUM_THREAD_COUNT * 4)
+
 //
 // Define the default strides to step through slices of the input matrices.
 //
@@ -451,6 +459,26 @@ void
 
 typedef MLAS_ELEMENTWISE_KERNEL_ROUTINE* PMLAS_ELEMENTWISE_KERNEL_ROUTINE;
 
+typedef
+void
+(MLASCALL MLAS_CONVERT_HALF_TO_FLOAT_ROUTINE)(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    );
+
+typedef MLAS_CONVERT_HALF_TO_FLOAT_ROUTINE* PMLAS_CONVERT_HALF_TO_FLOAT_ROUTINE;
+
+typedef
+void
+(MLASCALL MLAS_CONVERT_FLOAT_TO_HALF_ROUTINE)(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    );
+
+typedef MLAS_CONVERT_FLOAT_TO_HALF_ROUTINE* PMLAS_CONVERT_FLOAT_TO_HALF_ROUTINE;
+
 extern "C" {
 
 #if defined(MLAS_TARGET_AMD64_IX86)
@@ -550,6 +578,13 @@ extern "C" {
     MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasErfKernelFma3;
 #endif
 
+    MLAS_CONVERT_HALF_TO_FLOAT_ROUTINE MlasConvertHalfToFloatKernel;
+    MLAS_CONVERT_FLOAT_TO_HALF_ROUTINE MlasConvertFloatToHalfKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_CONVERT_HALF_TO_FLOAT_ROUTINE MlasConvertHalfToFloatKernelF16C;
+    MLAS_CONVERT_FLOAT_TO_HALF_ROUTINE MlasConvertFloatToHalfKernelF16C;
+#endif
+
 }
 
 //
@@ -596,7 +631,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_GEMM_EPILOGUE* Epilogue
     );
 
 //
@@ -631,9 +667,20 @@ struct MLAS_PLATFORM {
     PMLAS_ELEMENTWISE_KERNEL_ROUTINE LogisticKernelRoutine;
     PMLAS_ELEMENTWISE_KERNEL_ROUTINE TanhKernelRoutine;
     PMLAS_ELEMENTWISE_KERNEL_ROUTINE ErfKernelRoutine;
+    PMLAS_CONVERT_HALF_TO_FLOAT_ROUTINE ConvertHalfToFloatRoutine;
+    PMLAS_CONVERT_FLOAT_TO_HALF_ROUTINE ConvertFloatToHalfRoutine;
     uint32_t NchwcBlockSize;
     uint32_t PreferredBufferAlignment;
 #endif
+
+    //
+    // Number of segments per thread of the threaded operations. More than one
+    // on hybrid processors: the thread pool hands out the segments as the
+    // threads become idle, so the threads on the performance cores complete
+    // more of them than the threads on the efficiency cores.
+    //
+
+    uint32_t ThreadSegmentsPerThread;
 };
 
 extern MLAS_PLATFORM MlasPlatform;
@@ -713,6 +760,9 @@ MlasPartitionWork(
 #ifndef vmaxvq_f32
 #define vmaxvq_f32(src) neon_fmaxv(src)
 #endif
+#ifndef vminvq_f32
+#define vminvq_f32(src) neon_fminv(src)
+#endif
 #endif
 
 //
@@ -1014,6 +1064,47 @@ MlasXorFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
 #endif
 }
 
+// select the even numbered lanes of the concatenation of two vectors
+inline
+MLAS_FLOAT32X4
+MlasShuffleEvenFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vuzp1q_f32(Vector1, Vector2);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    return vuzpq_f32(Vector1, Vector2).val[0];
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_shuffle_ps(Vector1, Vector2, _MM_SHUFFLE(2, 0, 2, 0));
+#endif
+}
+
+// interleave the low or high halves of the lanes of two vectors
+inline
+MLAS_FLOAT32X4
+MlasInterleaveLowFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vzip1q_f32(Vector1, Vector2);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    return vzipq_f32(Vector1, Vector2).val[0];
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_unpacklo_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasInterleaveHighFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vzip2q_f32(Vector1, Vector2);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    return vzipq_f32(Vector1, Vector2).val[1];
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_unpackhi_ps(Vector1, Vector2);
+#endif
+}
+
 // calc 2^int(N)
 inline
 MLAS_FLOAT32X4
@@ -1028,6 +1119,60 @@ MlasPowerOf2Float32x4(MLAS_FLOAT32X4 Vector)
 #endif
 }
 
+// horizontal reductions of the four lanes of a vector
+inline
+float
+MlasReduceAddFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    Vector = vpaddq_f32(Vector, Vector);
+    Vector = vpaddq_f32(Vector, Vector);
+    return vgetq_lane_f32(Vector, 0);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    float32x2_t VectorLow = vpadd_f32(vget_low_f32(Vector), vget_high_f32(Vector));
+    VectorLow = vpadd_f32(VectorLow, VectorLow);
+    return vget_lane_f32(VectorLow, 0);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    Vector = _mm_add_ps(Vector, _mm_movehl_ps(Vector, Vector));
+    Vector = _mm_add_ss(Vector, _mm_shuffle_ps(Vector, Vector, 1));
+    return _mm_cvtss_f32(Vector);
+#endif
+}
+
+inline
+float
+MlasReduceMaximumFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vmaxvq_f32(Vector);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    float32x2_t VectorLow = vpmax_f32(vget_low_f32(Vector), vget_high_f32(Vector));
+    VectorLow = vpmax_f32(VectorLow, VectorLow);
+    return vget_lane_f32(VectorLow, 0);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    Vector = _mm_max_ps(Vector, _mm_movehl_ps(Vector, Vector));
+    Vector = _mm_max_ss(Vector, _mm_shuffle_ps(Vector, Vector, 1));
+    return _mm_cvtss_f32(Vector);
+#endif
+}
+
+inline
+float
+MlasReduceMinimumFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vminvq_f32(Vector);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    float32x2_t VectorLow = vpmin_f32(vget_low_f32(Vector), vget_high_f32(Vector));
+    VectorLow = vpmin_f32(VectorLow, VectorLow);
+    return vget_lane_f32(VectorLow, 0);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    Vector = _mm_min_ps(Vector, _mm_movehl_ps(Vector, Vector));
+    Vector = _mm_min_ss(Vector, _mm_shuffle_ps(Vector, Vector, 1));
+    return _mm_cvtss_f32(Vector);
+#endif
+}
+
 inline
 MLAS_INT32X4
 MlasBroadcastInt32x4(int32_t Value)
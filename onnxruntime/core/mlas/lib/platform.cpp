@@ -90,6 +90,8 @@ Return Value:
 --*/
 {
 
+    this->ThreadSegmentsPerThread = 1;
+
 #if defined(MLAS_TARGET_AMD64_IX86)
 
     //
@@ -118,6 +120,8 @@ Return Value:
     this->LogisticKernelRoutine = MlasLogisticKernel;
     this->TanhKernelRoutine = MlasTanhKernel;
     this->ErfKernelRoutine = MlasErfKernel;
+    this->ConvertHalfToFloatRoutine = MlasConvertHalfToFloatKernel;
+    this->ConvertFloatToHalfRoutine = MlasConvertFloatToHalfKernel;
     this->NchwcBlockSize = 8;
     this->PreferredBufferAlignment = MLAS_DEFAULT_PREFERRED_BUFFER_ALIGNMENT;
 
@@ -134,6 +138,32 @@ Return Value:
     __cpuid(1, Cpuid1[0], Cpuid1[1], Cpuid1[2], Cpuid1[3]);
 #endif
 
+    //
+    // Check if the processor is hybrid, with performance and efficiency cores
+    // running the same work at different speeds.
+    //
+
+    unsigned Cpuid0[4];
+#if defined(_WIN32)
+    __cpuid((int*)Cpuid0, 0);
+#else
+    __cpuid(0, Cpuid0[0], Cpuid0[1], Cpuid0[2], Cpuid0[3]);
+#endif
+
+    if (Cpuid0[0] >= 7) {
+
+        unsigned Cpuid7Hybrid[4];
+#if defined(_WIN32)
+        __cpuidex((int*)Cpuid7Hybrid, 7, 0);
+#else
+        __cpuid_count(7, 0, Cpuid7Hybrid[0], Cpuid7Hybrid[1], Cpuid7Hybrid[2], Cpuid7Hybrid[3]);
+#endif
+
+        if ((Cpuid7Hybrid[3] & 0x8000) != 0) {
+            this->ThreadSegmentsPerThread = 4;
+        }
+    }
+
     if ((Cpuid1[2] & 0x18000000) == 0x18000000) {
 
         //
@@ -160,6 +190,16 @@ Return Value:
             this->PoolFloatKernel[MlasAveragePoolingExcludePad] = MlasPoolAverageExcludePadFloatKernelAvx;
             this->PoolFloatKernel[MlasAveragePoolingIncludePad] = MlasPoolAverageIncludePadFloatKernelAvx;
 
+            //
+            // Check if the processor supports the F16C feature.
+            //
+
+            if ((Cpuid1[2] & 0x20000000) != 0) {
+
+                this->ConvertHalfToFloatRoutine = MlasConvertHalfToFloatKernelF16C;
+                this->ConvertFloatToHalfRoutine = MlasConvertFloatToHalfKernelF16C;
+            }
+
             //
             // Check if the processor supports AVX2/FMA3 features.
             //
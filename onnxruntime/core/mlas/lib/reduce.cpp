@@ -0,0 +1,979 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.cpp
+
+Abstract:
+
+    This module implements the reduction operations.
+
+    The input is viewed as a three dimensional tensor of shape [OuterCount,
+    ReduceCount, InnerCount] and is reduced along the middle dimension. This
+    covers any set of adjacent reduction axes, so a reduction does not need to
+    transpose the input into a temporary buffer. When InnerCount is one, each
+    output element is a reduction of a contiguous row. Otherwise, the kernels
+    vectorize across the contiguous inner dimension and stride through the
+    reduction dimension.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of input elements processed by each thread of the
+// reduction routines before another thread is used.
+//
+
+#define MLAS_REDUCE_THREAD_COMPLEXITY               (64 * 1024)
+
+//
+// Define the number of inner elements processed by a unit of work.
+//
+
+#define MLAS_REDUCE_INNER_BLOCK                     16
+
+//
+// Define the largest reduction count where an index is exactly representable
+// as a float, used by the vectorized arg reduction kernels.
+//
+
+#define MLAS_REDUCE_MAXIMUM_FLOAT_INDEX             (1 << 24)
+
+//
+// Structure to hold the reduction parameters.
+//
+
+struct MLAS_REDUCE_WORK_BLOCK {
+    int32_t ThreadCount;
+    const float* Input;
+    void* Output;
+    size_t OuterCount;
+    size_t ReduceCount;
+    size_t InnerCount;
+    size_t InnerBlockCount;
+    float Scale;
+};
+
+//
+// Abstraction for sum reduction.
+//
+
+struct MLAS_SUM_REDUCTION
+{
+    static float InitialValue()
+    {
+        return 0.0f;
+    }
+
+    static MLAS_FLOAT32X4 InitialVector()
+    {
+        return MlasZeroFloat32x4();
+    }
+
+    static float Reduce(float Reduction, float Value)
+    {
+        return Reduction + Value;
+    }
+
+    static MLAS_FLOAT32X4 Reduce(MLAS_FLOAT32X4 Reduction, MLAS_FLOAT32X4 Value)
+    {
+        return MlasAddFloat32x4(Reduction, Value);
+    }
+
+    static MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Reduction0, MLAS_FLOAT32X4 Reduction1)
+    {
+        return MlasAddFloat32x4(Reduction0, Reduction1);
+    }
+
+    static float ReduceFloat32x4(MLAS_FLOAT32X4 Reduction)
+    {
+        return MlasReduceAddFloat32x4(Reduction);
+    }
+
+    static float Finalize(float Reduction, float Scale)
+    {
+        MLAS_UNREFERENCED_PARAMETER(Scale);
+
+        return Reduction;
+    }
+
+    static MLAS_FLOAT32X4 Finalize(MLAS_FLOAT32X4 Reduction, MLAS_FLOAT32X4 Scale)
+    {
+        MLAS_UNREFERENCED_PARAMETER(Scale);
+
+        return Reduction;
+    }
+};
+
+//
+// Abstraction for sum of squares reduction.
+//
+
+struct MLAS_SUM_SQUARE_REDUCTION : MLAS_SUM_REDUCTION
+{
+    static float Reduce(float Reduction, float Value)
+    {
+        return Reduction + Value * Value;
+    }
+
+    static MLAS_FLOAT32X4 Reduce(MLAS_FLOAT32X4 Reduction, MLAS_FLOAT32X4 Value)
+    {
+        return MlasMultiplyAddFloat32x4(Value, Value, Reduction);
+    }
+};
+
+//
+// Abstraction for mean reduction. The scale is the reciprocal of the
+// reduction count.
+//
+
+struct MLAS_MEAN_REDUCTION : MLAS_SUM_REDUCTION
+{
+    static float Finalize(float Reduction, float Scale)
+    {
+        return Reduction * Scale;
+    }
+
+    static MLAS_FLOAT32X4 Finalize(MLAS_FLOAT32X4 Reduction, MLAS_FLOAT32X4 Scale)
+    {
+        return MlasMultiplyFloat32x4(Reduction, Scale);
+    }
+};
+
+//
+// Abstraction for maximum reduction.
+//
+
+struct MLAS_MAXIMUM_REDUCTION : MLAS_SUM_REDUCTION
+{
+    static float InitialValue()
+    {
+        return -std::numeric_limits<float>::infinity();
+    }
+
+    static MLAS_FLOAT32X4 InitialVector()
+    {
+        return MlasBroadcastFloat32x4(InitialValue());
+    }
+
+    static float Reduce(float Reduction, float Value)
+    {
+        return (std::max)(Reduction, Value);
+    }
+
+    static MLAS_FLOAT32X4 Reduce(MLAS_FLOAT32X4 Reduction, MLAS_FLOAT32X4 Value)
+    {
+        return MlasMaximumFloat32x4(Reduction, Value);
+    }
+
+    static MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Reduction0, MLAS_FLOAT32X4 Reduction1)
+    {
+        return MlasMaximumFloat32x4(Reduction0, Reduction1);
+    }
+
+    static float ReduceFloat32x4(MLAS_FLOAT32X4 Reduction)
+    {
+        return MlasReduceMaximumFloat32x4(Reduction);
+    }
+
+    static bool IsBetter(float Value, float Reduction)
+    {
+        return Value > Reduction;
+    }
+
+    static MLAS_FLOAT32X4 IsBetter(MLAS_FLOAT32X4 Value, MLAS_FLOAT32X4 Reduction)
+    {
+        return MlasGreaterThanFloat32x4(Value, Reduction);
+    }
+};
+
+//
+// Abstraction for minimum reduction.
+//
+
+struct MLAS_MINIMUM_REDUCTION : MLAS_SUM_REDUCTION
+{
+    static float InitialValue()
+    {
+        return std::numeric_limits<float>::infinity();
+    }
+
+    static MLAS_FLOAT32X4 InitialVector()
+    {
+        return MlasBroadcastFloat32x4(InitialValue());
+    }
+
+    static float Reduce(float Reduction, float Value)
+    {
+        return (std::min)(Reduction, Value);
+    }
+
+    static MLAS_FLOAT32X4 Reduce(MLAS_FLOAT32X4 Reduction, MLAS_FLOAT32X4 Value)
+    {
+        return MlasMinimumFloat32x4(Reduction, Value);
+    }
+
+    static MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Reduction0, MLAS_FLOAT32X4 Reduction1)
+    {
+        return MlasMinimumFloat32x4(Reduction0, Reduction1);
+    }
+
+    static float ReduceFloat32x4(MLAS_FLOAT32X4 Reduction)
+    {
+        return MlasReduceMinimumFloat32x4(Reduction);
+    }
+
+    static bool IsBetter(float Value, float Reduction)
+    {
+        return Value < Reduction;
+    }
+
+    static MLAS_FLOAT32X4 IsBetter(MLAS_FLOAT32X4 Value, MLAS_FLOAT32X4 Reduction)
+    {
+        return MlasGreaterThanFloat32x4(Reduction, Value);
+    }
+};
+
+template<typename ReductionType>
+float
+MlasReduceRow(
+    const float* Input,
+    size_t ReduceCount
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces a contiguous row of elements.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    ReduceCount - Supplies the number of elements to reduce.
+
+Return Value:
+
+    Returns the reduction of the row.
+
+--*/
+{
+    float Reduction = ReductionType::InitialValue();
+
+    if (ReduceCount >= 4) {
+
+        MLAS_FLOAT32X4 Reduction0 = ReductionType::InitialVector();
+
+        if (ReduceCount >= 16) {
+
+            MLAS_FLOAT32X4 Reduction1 = Reduction0;
+            MLAS_FLOAT32X4 Reduction2 = Reduction0;
+            MLAS_FLOAT32X4 Reduction3 = Reduction0;
+
+            while (ReduceCount >= 16) {
+
+                Reduction0 = ReductionType::Reduce(Reduction0, MlasLoadFloat32x4(Input));
+                Reduction1 = ReductionType::Reduce(Reduction1, MlasLoadFloat32x4(Input + 4));
+                Reduction2 = ReductionType::Reduce(Reduction2, MlasLoadFloat32x4(Input + 8));
+                Reduction3 = ReductionType::Reduce(Reduction3, MlasLoadFloat32x4(Input + 12));
+
+                Input += 16;
+                ReduceCount -= 16;
+            }
+
+            Reduction0 = ReductionType::Combine(Reduction0, Reduction1);
+            Reduction2 = ReductionType::Combine(Reduction2, Reduction3);
+            Reduction0 = ReductionType::Combine(Reduction0, Reduction2);
+        }
+
+        while (ReduceCount >= 4) {
+
+            Reduction0 = ReductionType::Reduce(Reduction0, MlasLoadFloat32x4(Input));
+
+            Input += 4;
+            ReduceCount -= 4;
+        }
+
+        Reduction = ReductionType::ReduceFloat32x4(Reduction0);
+    }
+
+    while (ReduceCount > 0) {
+
+        Reduction = ReductionType::Reduce(Reduction, *Input);
+
+        Input += 1;
+        ReduceCount -= 1;
+    }
+
+    return Reduction;
+}
+
+template<typename ReductionType>
+void
+MlasReduceColumns(
+    const float* Input,
+    float* Output,
+    size_t ReduceCount,
+    size_t InnerCount,
+    size_t ColumnCount,
+    float Scale
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces a block of columns, where each column is a strided
+    sequence of elements along the reduction dimension.
+
+Arguments:
+
+    Input - Supplies the address of the first element of the first column.
+
+    Output - Supplies the output buffer for the block of columns.
+
+    ReduceCount - Supplies the number of elements to reduce for each column.
+
+    InnerCount - Supplies the stride between elements of a column.
+
+    ColumnCount - Supplies the number of columns to reduce.
+
+    Scale - Supplies the scale applied to the final reduction.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+
+    while (ColumnCount >= 16) {
+
+        MLAS_FLOAT32X4 Reduction0 = ReductionType::InitialVector();
+        MLAS_FLOAT32X4 Reduction1 = Reduction0;
+        MLAS_FLOAT32X4 Reduction2 = Reduction0;
+        MLAS_FLOAT32X4 Reduction3 = Reduction0;
+
+        const float* input = Input;
+
+        for (size_t r = 0; r < ReduceCount; r++) {
+
+            Reduction0 = ReductionType::Reduce(Reduction0, MlasLoadFloat32x4(input));
+            Reduction1 = ReductionType::Reduce(Reduction1, MlasLoadFloat32x4(input + 4));
+            Reduction2 = ReductionType::Reduce(Reduction2, MlasLoadFloat32x4(input + 8));
+            Reduction3 = ReductionType::Reduce(Reduction3, MlasLoadFloat32x4(input + 12));
+
+            input += InnerCount;
+        }
+
+        MlasStoreFloat32x4(Output, ReductionType::Finalize(Reduction0, ScaleVector));
+        MlasStoreFloat32x4(Output + 4, ReductionType::Finalize(Reduction1, ScaleVector));
+        MlasStoreFloat32x4(Output + 8, ReductionType::Finalize(Reduction2, ScaleVector));
+        MlasStoreFloat32x4(Output + 12, ReductionType::Finalize(Reduction3, ScaleVector));
+
+        Input += 16;
+        Output += 16;
+        ColumnCount -= 16;
+    }
+
+    while (ColumnCount >= 4) {
+
+        MLAS_FLOAT32X4 Reduction0 = ReductionType::InitialVector();
+
+        const float* input = Input;
+
+        for (size_t r = 0; r < ReduceCount; r++) {
+            Reduction0 = ReductionType::Reduce(Reduction0, MlasLoadFloat32x4(input));
+            input += InnerCount;
+        }
+
+        MlasStoreFloat32x4(Output, ReductionType::Finalize(Reduction0, ScaleVector));
+
+        Input += 4;
+        Output += 4;
+        ColumnCount -= 4;
+    }
+
+    while (ColumnCount > 0) {
+
+        float Reduction = ReductionType::InitialValue();
+
+        const float* input = Input;
+
+        for (size_t r = 0; r < ReduceCount; r++) {
+            Reduction = ReductionType::Reduce(Reduction, *input);
+            input += InnerCount;
+        }
+
+        *Output = ReductionType::Finalize(Reduction, Scale);
+
+        Input += 1;
+        Output += 1;
+        ColumnCount -= 1;
+    }
+}
+
+template<typename ReductionType>
+int64_t
+MlasArgReduceRow(
+    const float* Input,
+    size_t ReduceCount
+    )
+/*++
+
+Routine Description:
+
+    This routine finds the index of the first extreme element of a contiguous
+    row of elements.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    ReduceCount - Supplies the number of elements to reduce.
+
+Return Value:
+
+    Returns the index of the first extreme element of the row.
+
+--*/
+{
+    //
+    // Find the extreme value with the vectorized reduction and then scan for
+    // the first element that matches the value. The scan usually terminates
+    // early, so this is cheaper than tracking the index of each lane.
+    //
+
+    const float Reduction = MlasReduceRow<ReductionType>(Input, ReduceCount);
+
+    for (size_t r = 0; r < ReduceCount; r++) {
+        if (Input[r] == Reduction) {
+            return int64_t(r);
+        }
+    }
+
+    return 0;
+}
+
+template<typename ReductionType>
+void
+MlasArgReduceColumns(
+    const float* Input,
+    int64_t* Output,
+    size_t ReduceCount,
+    size_t InnerCount,
+    size_t ColumnCount
+    )
+/*++
+
+Routine Description:
+
+    This routine finds the index of the first extreme element of each column
+    of a block of columns, where each column is a strided sequence of elements
+    along the reduction dimension.
+
+Arguments:
+
+    Input - Supplies the address of the first element of the first column.
+
+    Output - Supplies the output buffer for the block of columns.
+
+    ReduceCount - Supplies the number of elements to reduce for each column.
+
+    InnerCount - Supplies the stride between elements of a column.
+
+    ColumnCount - Supplies the number of columns to reduce.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Track the indices as floats in the vector path, which is exact as long
+    // as the reduction count is small enough.
+    //
+
+    if (ReduceCount <= MLAS_REDUCE_MAXIMUM_FLOAT_INDEX) {
+
+        while (ColumnCount >= 4) {
+
+            const float* input = Input;
+
+            MLAS_FLOAT32X4 Reduction = MlasLoadFloat32x4(input);
+            MLAS_FLOAT32X4 Index = MlasZeroFloat32x4();
+
+            for (size_t r = 1; r < ReduceCount; r++) {
+
+                input += InnerCount;
+
+                MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(input);
+                MLAS_FLOAT32X4 Mask = ReductionType::IsBetter(Value, Reduction);
+
+                Reduction = MlasOrFloat32x4(MlasAndFloat32x4(Mask, Value), MlasAndNotFloat32x4(Mask, Reduction));
+                Index = MlasOrFloat32x4(MlasAndFloat32x4(Mask, MlasBroadcastFloat32x4(float(r))),
+                    MlasAndNotFloat32x4(Mask, Index));
+            }
+
+            Output[0] = int64_t(MlasExtractLaneFloat32x4<0>(Index));
+            Output[1] = int64_t(MlasExtractLaneFloat32x4<1>(Index));
+            Output[2] = int64_t(MlasExtractLaneFloat32x4<2>(Index));
+            Output[3] = int64_t(MlasExtractLaneFloat32x4<3>(Index));
+
+            Input += 4;
+            Output += 4;
+            ColumnCount -= 4;
+        }
+    }
+
+    while (ColumnCount > 0) {
+
+        const float* input = Input;
+
+        float Reduction = *input;
+        int64_t Index = 0;
+
+        for (size_t r = 1; r < ReduceCount; r++) {
+
+            input += InnerCount;
+
+            if (ReductionType::IsBetter(*input, Reduction)) {
+                Reduction = *input;
+                Index = int64_t(r);
+            }
+        }
+
+        *Output = Index;
+
+        Input += 1;
+        Output += 1;
+        ColumnCount -= 1;
+    }
+}
+
+template<typename ReductionType>
+void
+MlasReduceThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    reduction operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_REDUCE_WORK_BLOCK*)Context;
+
+    const size_t ReduceCount = WorkBlock->ReduceCount;
+    const size_t InnerCount = WorkBlock->InnerCount;
+    const size_t InnerBlockCount = WorkBlock->InnerBlockCount;
+
+    //
+    // Partition the operation along the outer dimension and the blocks of the
+    // inner dimension.
+    //
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, WorkBlock->OuterCount * InnerBlockCount,
+        &WorkIndex, &WorkRemaining);
+
+    float* Output = (float*)WorkBlock->Output;
+
+    if (InnerCount == 1) {
+
+        const float* Input = WorkBlock->Input + WorkIndex * ReduceCount;
+
+        Output += WorkIndex;
+
+        while (WorkRemaining > 0) {
+
+            *Output++ = ReductionType::Finalize(MlasReduceRow<ReductionType>(Input, ReduceCount),
+                WorkBlock->Scale);
+
+            Input += ReduceCount;
+            WorkRemaining--;
+        }
+
+    } else {
+
+        while (WorkRemaining > 0) {
+
+            const size_t o = WorkIndex / InnerBlockCount;
+            const size_t i = (WorkIndex % InnerBlockCount) * MLAS_REDUCE_INNER_BLOCK;
+            const size_t ColumnCount = (std::min)(InnerCount - i, size_t(MLAS_REDUCE_INNER_BLOCK));
+
+            MlasReduceColumns<ReductionType>(WorkBlock->Input + o * ReduceCount * InnerCount + i,
+                Output + o * InnerCount + i, ReduceCount, InnerCount, ColumnCount, WorkBlock->Scale);
+
+            WorkIndex++;
+            WorkRemaining--;
+        }
+    }
+}
+
+template<typename ReductionType>
+void
+MlasArgReduceThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of an
+    arg reduction operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_REDUCE_WORK_BLOCK*)Context;
+
+    const size_t ReduceCount = WorkBlock->ReduceCount;
+    const size_t InnerCount = WorkBlock->InnerCount;
+    const size_t InnerBlockCount = WorkBlock->InnerBlockCount;
+
+    //
+    // Partition the operation along the outer dimension and the blocks of the
+    // inner dimension.
+    //
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, WorkBlock->OuterCount * InnerBlockCount,
+        &WorkIndex, &WorkRemaining);
+
+    int64_t* Output = (int64_t*)WorkBlock->Output;
+
+    if (InnerCount == 1) {
+
+        const float* Input = WorkBlock->Input + WorkIndex * ReduceCount;
+
+        Output += WorkIndex;
+
+        while (WorkRemaining > 0) {
+
+            *Output++ = MlasArgReduceRow<ReductionType>(Input, ReduceCount);
+
+            Input += ReduceCount;
+            WorkRemaining--;
+        }
+
+    } else {
+
+        while (WorkRemaining > 0) {
+
+            const size_t o = WorkIndex / InnerBlockCount;
+            const size_t i = (WorkIndex % InnerBlockCount) * MLAS_REDUCE_INNER_BLOCK;
+            const size_t ColumnCount = (std::min)(InnerCount - i, size_t(MLAS_REDUCE_INNER_BLOCK));
+
+            MlasArgReduceColumns<ReductionType>(WorkBlock->Input + o * ReduceCount * InnerCount + i,
+                Output + o * InnerCount + i, ReduceCount, InnerCount, ColumnCount);
+
+            WorkIndex++;
+            WorkRemaining--;
+        }
+    }
+}
+
+void
+MlasExecuteReduce(
+    PMLAS_THREADED_ROUTINE ThreadedRoutine,
+    MLAS_REDUCE_WORK_BLOCK* WorkBlock,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine partitions a reduction operation across the available threads
+    and executes the supplied threaded routine.
+
+Arguments:
+
+    ThreadedRoutine - Supplies the threaded routine that implements the
+        reduction.
+
+    WorkBlock - Supplies the reduction parameters. The thread count and the
+        inner block count are computed by this routine.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InnerCount = WorkBlock->InnerCount;
+
+    WorkBlock->InnerBlockCount = (InnerCount + MLAS_REDUCE_INNER_BLOCK - 1) / MLAS_REDUCE_INNER_BLOCK;
+
+    const size_t WorkCount = WorkBlock->OuterCount * WorkBlock->InnerBlockCount;
+
+    if (WorkCount == 0) {
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // reduction. Limit the number of threads to the number of units of work.
+    //
+
+    const double Complexity = double(WorkBlock->OuterCount) * double(WorkBlock->ReduceCount) * double(InnerCount);
+
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_REDUCE_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_REDUCE_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) >= WorkCount) {
+        TargetThreadCount = int32_t(WorkCount);
+    }
+
+    WorkBlock->ThreadCount = TargetThreadCount;
+
+    MlasExecuteThreaded(ThreadedRoutine, WorkBlock, TargetThreadCount, ThreadPool);
+}
+
+void
+MLASCALL
+MlasReduce(
+    MLAS_REDUCTION_KIND ReductionKind,
+    const float* Input,
+    float* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces the input along the middle dimension of the shape
+    [OuterCount, ReduceCount, InnerCount] to produce [OuterCount, InnerCount]
+    output elements.
+
+Arguments:
+
+    ReductionKind - Supplies the kind of reduction operation to perform.
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    OuterCount - Supplies the number of elements of the outer dimension.
+
+    ReduceCount - Supplies the number of elements of the reduction dimension.
+
+    InnerCount - Supplies the number of elements of the inner dimension.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    static const PMLAS_THREADED_ROUTINE MlasReduceRoutines[] = {
+        MlasReduceThreaded<MLAS_SUM_REDUCTION>,
+        MlasReduceThreaded<MLAS_SUM_SQUARE_REDUCTION>,
+        MlasReduceThreaded<MLAS_MEAN_REDUCTION>,
+        MlasReduceThreaded<MLAS_MAXIMUM_REDUCTION>,
+        MlasReduceThreaded<MLAS_MINIMUM_REDUCTION>,
+    };
+
+    MLAS_REDUCE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.OuterCount = OuterCount;
+    WorkBlock.ReduceCount = ReduceCount;
+    WorkBlock.InnerCount = InnerCount;
+    WorkBlock.Scale = (ReduceCount > 0) ? 1.0f / float(ReduceCount) : 0.0f;
+
+    MlasExecuteReduce(MlasReduceRoutines[ReductionKind], &WorkBlock, ThreadPool);
+}
+
+void
+MLASCALL
+MlasArgReduce(
+    MLAS_ARG_REDUCTION_KIND ReductionKind,
+    const float* Input,
+    int64_t* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine finds the index of the first maximum or minimum element along
+    the middle dimension of the shape [OuterCount, ReduceCount, InnerCount] to
+    produce [OuterCount, InnerCount] output indices.
+
+Arguments:
+
+    ReductionKind - Supplies the kind of arg reduction operation to perform.
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    OuterCount - Supplies the number of elements of the outer dimension.
+
+    ReduceCount - Supplies the number of elements of the reduction dimension.
+        This must not be zero.
+
+    InnerCount - Supplies the number of elements of the inner dimension.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    static const PMLAS_THREADED_ROUTINE MlasArgReduceRoutines[] = {
+        MlasArgReduceThreaded<MLAS_MAXIMUM_REDUCTION>,
+        MlasArgReduceThreaded<MLAS_MINIMUM_REDUCTION>,
+    };
+
+    MLAS_REDUCE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.OuterCount = OuterCount;
+    WorkBlock.ReduceCount = ReduceCount;
+    WorkBlock.InnerCount = InnerCount;
+    WorkBlock.Scale = 1.0f;
+
+    MlasExecuteReduce(MlasArgReduceRoutines[ReductionKind], &WorkBlock, ThreadPool);
+}
+
+void
+MLASCALL
+MlasReduceSumAndSumSquare(
+    const float* Input,
+    size_t N,
+    float* Sum,
+    float* SumSquare
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the sum and the sum of squares of a contiguous row of
+    elements in a single pass, as used by the normalization operators.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+    Sum - Receives the sum of the elements.
+
+    SumSquare - Receives the sum of the squares of the elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 SumVector0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumVector1 = SumVector0;
+    MLAS_FLOAT32X4 SumSquareVector0 = SumVector0;
+    MLAS_FLOAT32X4 SumSquareVector1 = SumVector0;
+
+    while (N >= 8) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasLoadFloat32x4(Input);
+        MLAS_FLOAT32X4 Vector1 = MlasLoadFloat32x4(Input + 4);
+
+        SumVector0 = MlasAddFloat32x4(SumVector0, Vector0);
+        SumVector1 = MlasAddFloat32x4(SumVector1, Vector1);
+        SumSquareVector0 = MlasMultiplyAddFloat32x4(Vector0, Vector0, SumSquareVector0);
+        SumSquareVector1 = MlasMultiplyAddFloat32x4(Vector1, Vector1, SumSquareVector1);
+
+        Input += 8;
+        N -= 8;
+    }
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasLoadFloat32x4(Input);
+
+        SumVector0 = MlasAddFloat32x4(SumVector0, Vector0);
+        SumSquareVector0 = MlasMultiplyAddFloat32x4(Vector0, Vector0, SumSquareVector0);
+
+        Input += 4;
+        N -= 4;
+    }
+
+    float SumValue = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumVector0, SumVector1));
+    float SumSquareValue = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumSquareVector0, SumSquareVector1));
+
+    while (N > 0) {
+
+        float Value = *Input++;
+
+        SumValue += Value;
+        SumSquareValue += Value * Value;
+
+        N -= 1;
+    }
+
+    *Sum = SumValue;
+    *SumSquare = SumSquareValue;
+}
@@ -267,6 +267,78 @@ Return Value:
     }
 }
 
+void
+MLASCALL
+MlasReorderInputNhwc(
+    const int64_t* InputShape,
+    const float* S,
+    float* D
+    )
+/*++
+
+Routine Description:
+
+    This routine reorders an input buffer from NHWC to NCHWc format.
+
+Arguments:
+
+    InputShape - Supplies the shape of the input tensor.
+
+    S - Supplies the address of the source tensor.
+
+    D - Supplies the address of the destination tensor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockSize = MlasNchwcGetBlockSize();
+
+    const size_t BatchCount = size_t(InputShape[0]);
+    const size_t InputChannels = size_t(InputShape[3]);
+    const size_t InputSize = size_t(InputShape[1]) * size_t(InputShape[2]);
+
+    //
+    // Copy the channels of each spatial position to the NCHWc blocks of the
+    // destination buffer, zero padding the last block.
+    //
+
+    for (size_t batch = 0; batch < BatchCount; batch++) {
+
+        for (size_t i = 0; i < InputChannels; i += BlockSize) {
+
+            const size_t InputChannelsThisIteration = (std::min)(InputChannels - i, BlockSize);
+            const size_t AlignedInputChannelsThisIteration = InputChannelsThisIteration & (~3);
+
+            const float* s = S + i;
+
+            for (size_t InputSizeRemaining = InputSize; InputSizeRemaining > 0; InputSizeRemaining--) {
+
+                size_t bc = 0;
+
+                for (; bc < AlignedInputChannelsThisIteration; bc += 4) {
+                    MlasStoreFloat32x4(&D[bc], MlasLoadFloat32x4(&s[bc]));
+                }
+
+                for (; bc < InputChannelsThisIteration; bc += 1) {
+                    D[bc] = s[bc];
+                }
+
+                for (; bc < BlockSize; bc += 1) {
+                    D[bc] = 0.0f;
+                }
+
+                s += InputChannels;
+                D += BlockSize;
+            }
+        }
+
+        S += InputChannels * InputSize;
+    }
+}
+
 void
 MLASCALL
 MlasReorderOutputNchw(
@@ -26,6 +26,16 @@ Abstract:
 
 #define MLAS_SGEMM_TRANSA_ROWS              12
 
+//
+// Define the number of rows of matrix B in each slice of a packed matrix B.
+//
+// N.B. The packing along the K dimension is fixed when the packed buffer is
+// created, so the stride cannot be adapted to the shape of matrix A as done
+// for an unpacked matrix B.
+//
+
+#define MLAS_SGEMM_PACKED_STRIDEK           256
+
 //
 // Define the parameters to execute segments of a SGEMM operation on worker
 // threads.
@@ -40,13 +50,45 @@ struct MLAS_SGEMM_WORK_BLOCK {
     size_t ldc;
     float alpha;
     float beta;
+    bool BIsPacked;
+    bool HasEpilogue;
     struct SEGMENT {
         size_t M;
         size_t N;
+        size_t StartN;
         const float* A;
         const float* B;
         float* C;
-    } Segments[MLAS_MAXIMUM_THREAD_COUNT];
+        MLAS_GEMM_EPILOGUE Epilogue;
+    } Segments[MLAS_MAXIMUM_SEGMENT_COUNT];
+};
+
+//
+// Define the parameters to execute a batch of SGEMM operations on worker
+// threads.
+//
+
+struct MLAS_SGEMM_BATCH_WORK_BLOCK {
+    CBLAS_TRANSPOSE TransA;
+    CBLAS_TRANSPOSE TransB;
+    size_t M;
+    size_t N;
+    size_t K;
+    const float* A;
+    size_t lda;
+    size_t StrideA;
+    const float* B;
+    size_t ldb;
+    size_t StrideB;
+    float* C;
+    size_t ldc;
+    size_t StrideC;
+    float alpha;
+    float beta;
+    size_t BatchCount;
+    int32_t ThreadCountBatch;
+    int32_t ThreadCountM;
+    int32_t ThreadCountN;
 };
 
 void
@@ -762,6 +804,304 @@ Return Value:
     }
 }
 
+inline
+MLAS_GEMM_EPILOGUE
+MlasSgemmOffsetEpilogue(
+    const MLAS_GEMM_EPILOGUE* Epilogue,
+    size_t StartM,
+    size_t StartN
+    )
+/*++
+
+Routine Description:
+
+    This routine returns a copy of the epilogue that is relative to the
+    element at the supplied row and column of the output matrix.
+
+Arguments:
+
+    Epilogue - Supplies the epilogue relative to the output matrix.
+
+    StartM - Supplies the row of the output matrix.
+
+    StartN - Supplies the column of the output matrix.
+
+Return Value:
+
+    Returns the offset epilogue.
+
+--*/
+{
+    MLAS_GEMM_EPILOGUE OffsetEpilogue = *Epilogue;
+
+    if (OffsetEpilogue.Bias != nullptr) {
+        OffsetEpilogue.Bias += StartN;
+    }
+
+    if (OffsetEpilogue.Residual != nullptr) {
+        OffsetEpilogue.Residual += StartM * OffsetEpilogue.ldr + StartN;
+    }
+
+    return OffsetEpilogue;
+}
+
+void
+MlasSgemmAddVector(
+    float* C,
+    const float* Vector,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine adds a vector to a row of the output matrix.
+
+Arguments:
+
+    C - Supplies the address of the row of the output matrix.
+
+    Vector - Supplies the vector to add.
+
+    CountN - Supplies the number of columns of the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (CountN >= 4) {
+
+        MLAS_FLOAT32X4 Sum = MlasAddFloat32x4(MlasLoadFloat32x4(C), MlasLoadFloat32x4(Vector));
+        MlasStoreFloat32x4(C, Sum);
+
+        C += 4;
+        Vector += 4;
+        CountN -= 4;
+    }
+
+    while (CountN > 0) {
+
+        *C++ += *Vector++;
+        CountN -= 1;
+    }
+}
+
+void
+MlasSgemmApplyEpilogue(
+    const MLAS_GEMM_EPILOGUE* Epilogue,
+    size_t StartM,
+    size_t CountM,
+    size_t CountN,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the epilogue to a completed tile of the output
+    matrix while the tile is still resident in the cache.
+
+Arguments:
+
+    Epilogue - Supplies the epilogue relative to the first column of the
+        tile and to the first row of the output matrix.
+
+    StartM - Supplies the row of the output matrix of the first row of the
+        tile.
+
+    CountM - Supplies the number of rows of the tile.
+
+    CountN - Supplies the number of columns of the tile.
+
+    C - Supplies the address of the tile.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Epilogue->Bias != nullptr) {
+        for (size_t m = 0; m < CountM; m++) {
+            MlasSgemmAddVector(C + m * ldc, Epilogue->Bias, CountN);
+        }
+    }
+
+    if (Epilogue->Activation != nullptr) {
+        MlasActivation(Epilogue->Activation, C, nullptr, CountM, CountN, ldc);
+    }
+
+    if (Epilogue->Residual != nullptr) {
+        const float* Residual = Epilogue->Residual + StartM * Epilogue->ldr;
+        for (size_t m = 0; m < CountM; m++) {
+            MlasSgemmAddVector(C + m * ldc, Residual + m * Epilogue->ldr, CountN);
+        }
+    }
+}
+
+void
+MlasSgemmMultiplyPanelB(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* PanelB,
+    float* C,
+    size_t ldc,
+    bool ZeroMode,
+    float* PanelA,
+    const MLAS_GEMM_EPILOGUE* Epilogue
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies the rows of matrix A with a packed panel of matrix
+    B and accumulates the product into matrix C.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    CountN - Supplies the number of columns of the panel of matrix B.
+
+    CountK - Supplies the number of rows of the panel of matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of the first element of matrix A that multiplies
+        the panel of matrix B.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PanelB - Supplies the address of the packed panel of matrix B.
+
+    C - Supplies the address of the first element of matrix C to update.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+    PanelA - Supplies the address of a buffer of MLAS_SGEMM_TRANSA_ROWS rows
+        of CountK elements that is used to transpose matrix A.
+
+    Epilogue - Supplies the optional epilogue relative to the first element
+        of matrix C to update, which is applied to the rows as they complete.
+        This must only be supplied for the last panel along the K dimension.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float* c = C;
+
+    size_t RowsRemaining = M;
+    size_t RowsHandled;
+    size_t RowsCompleted = 0;
+
+    if (TransA == CblasNoTrans) {
+
+        const float* a = A;
+
+        //
+        // Step through the rows of matrix A.
+        //
+
+        do {
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+            RowsHandled = MlasPlatform.GemmFloatKernel(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha, ZeroMode);
+#else
+            if (ZeroMode) {
+                RowsHandled = MlasSgemmKernelZero(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
+            } else {
+                RowsHandled = MlasSgemmKernelAdd(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
+            }
+#endif
+
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, RowsCompleted, RowsHandled, CountN, c, ldc);
+            }
+
+            RowsCompleted += RowsHandled;
+
+            c += ldc * RowsHandled;
+            a += lda * RowsHandled;
+
+            RowsRemaining -= RowsHandled;
+
+        } while (RowsRemaining > 0);
+
+    } else {
+
+        const float* a = A;
+
+        do {
+
+            //
+            // Transpose elements from matrix A into a local buffer.
+            //
+
+            size_t RowsTransposed = RowsRemaining;
+
+            if (RowsTransposed > MLAS_SGEMM_TRANSA_ROWS) {
+                RowsTransposed = MLAS_SGEMM_TRANSA_ROWS;
+            }
+
+            RowsRemaining -= RowsTransposed;
+
+            MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
+
+            a += RowsTransposed;
+
+            //
+            // Step through the rows of the local buffer.
+            //
+
+            const float* pa = PanelA;
+
+            do {
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+                RowsHandled = MlasPlatform.GemmFloatKernel(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+#else
+                if (ZeroMode) {
+                    RowsHandled = MlasSgemmKernelZero(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
+                } else {
+                    RowsHandled = MlasSgemmKernelAdd(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
+                }
+#endif
+
+                if (Epilogue != nullptr) {
+                    MlasSgemmApplyEpilogue(Epilogue, RowsCompleted, RowsHandled, CountN, c, ldc);
+                }
+
+                RowsCompleted += RowsHandled;
+
+                c += ldc * RowsHandled;
+                pa += CountK * RowsHandled;
+
+                RowsTransposed -= RowsHandled;
+
+            } while (RowsTransposed > 0);
+
+        } while (RowsRemaining > 0);
+    }
+}
+
 void
 MlasSgemmOperation(
     CBLAS_TRANSPOSE TransA,
@@ -776,7 +1116,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_GEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -814,6 +1155,8 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Supplies the optional epilogue to apply to matrix C.
+
 Return Value:
 
     None.
@@ -843,6 +1186,9 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, 0, M, N, C, ldc);
+            }
             return;
         }
 
@@ -870,6 +1216,9 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(B, A, C, K, M, lda, beta);
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, 0, M, N, C, ldc);
+            }
             return;
         }
 
@@ -952,96 +1301,152 @@ Return Value:
             }
 
             //
-            // Step through each slice of matrix A along the M dimension.
+            // Apply the epilogue with the last panel along the K dimension.
             //
 
-            float* c = C + n;
+            MLAS_GEMM_EPILOGUE OffsetEpilogue;
+            const MLAS_GEMM_EPILOGUE* PanelEpilogue = nullptr;
 
-            size_t RowsRemaining = M;
-            size_t RowsHandled;
+            if (Epilogue != nullptr && (k + CountK) == K) {
+                OffsetEpilogue = MlasSgemmOffsetEpilogue(Epilogue, 0, n);
+                PanelEpilogue = &OffsetEpilogue;
+            }
 
-            if (TransA == CblasNoTrans) {
+            MlasSgemmMultiplyPanelB(TransA, M, CountN, CountK, alpha,
+                (TransA == CblasNoTrans) ? A + k : A + k * lda, lda, PanelB,
+                C + n, ldc, ZeroMode, PanelA, PanelEpilogue);
+        }
+    }
+}
 
-                const float* a = A + k;
+void
+MlasSgemmPackedOperation(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* PackedB,
+    size_t AlignedN,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_GEMM_EPILOGUE* Epilogue
+    )
+/*++
 
-                //
-                // Step through the rows of matrix A.
-                //
+Routine Description:
 
-                do {
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) with a matrix B packed by MlasGemmPackB.
 
-#if defined(MLAS_TARGET_AMD64_IX86)
-                    RowsHandled = MlasPlatform.GemmFloatKernel(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha, ZeroMode);
-#else
-                    if (ZeroMode) {
-                        RowsHandled = MlasSgemmKernelZero(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
-                    } else {
-                        RowsHandled = MlasSgemmKernelAdd(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
-                    }
-#endif
+Arguments:
 
-                    c += ldc * RowsHandled;
-                    a += lda * RowsHandled;
+    TransA - Supplies the transpose operation for matrix A.
 
-                    RowsRemaining -= RowsHandled;
+    M - Supplies the number of rows of matrix A and matrix C.
 
-                } while (RowsRemaining > 0);
+    RangeStartN - Supplies the first column of matrix B and matrix C to
+        compute. This must be a multiple of MLAS_SGEMM_STRIDEN_THREAD_ALIGN.
 
-            } else {
+    RangeCountN - Supplies the number of columns of matrix B and matrix C to
+        compute.
 
-                const float* a = A + k * lda;
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
 
-                do {
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
 
-                    //
-                    // Transpose elements from matrix A into a local buffer.
-                    //
+    A - Supplies the address of matrix A.
 
-                    size_t RowsTransposed = RowsRemaining;
+    lda - Supplies the first dimension of matrix A.
 
-                    if (RowsTransposed > MLAS_SGEMM_TRANSA_ROWS) {
-                        RowsTransposed = MLAS_SGEMM_TRANSA_ROWS;
-                    }
+    PackedB - Supplies the address of the packed matrix B.
 
-                    RowsRemaining -= RowsTransposed;
+    AlignedN - Supplies the number of columns of the packed matrix B.
 
-                    MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
 
-                    a += RowsTransposed;
+    C - Supplies the address of the first column of matrix C to compute.
 
-                    //
-                    // Step through the rows of the local buffer.
-                    //
+    ldc - Supplies the first dimension of matrix C.
 
-                    const float* pa = PanelA;
+    Epilogue - Supplies the optional epilogue relative to the first column of
+        matrix C to compute.
 
-                    do {
+Return Value:
 
-#if defined(MLAS_TARGET_AMD64_IX86)
-                        RowsHandled = MlasPlatform.GemmFloatKernel(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
-#else
-                        if (ZeroMode) {
-                            RowsHandled = MlasSgemmKernelZero(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
-                        } else {
-                            RowsHandled = MlasSgemmKernelAdd(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
-                        }
-#endif
+    None.
+
+--*/
+{
+    float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_PACKED_STRIDEK];
+
+    //
+    // Step through each slice of matrix B along the N dimension.
+    //
 
-                        c += ldc * RowsHandled;
-                        pa += CountK * RowsHandled;
+    size_t CountN;
+    size_t CountK;
 
-                        RowsTransposed -= RowsHandled;
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
 
-                    } while (RowsTransposed > 0);
+        CountN = MLAS_SGEMM_STRIDEN;
 
-                } while (RowsRemaining > 0);
-            }
+        if (CountN > (RangeCountN - n)) {
+            CountN = RangeCountN - n;
         }
-    }
-}
 
-void
-MlasSgemmOperationThreaded(
+        //
+        // Multiply the output matrix by beta as needed.
+        //
+
+        if (beta != 0.0f && beta != 1.0f) {
+            MlasSgemmMultiplyBeta(C + n, M, CountN, ldc, beta);
+        }
+
+        //
+        // Step through each slice of matrix B along the K dimension. Each
+        // slice of the packed buffer holds CountK rows of all the columns of
+        // matrix B, so the panel for this range of columns is contiguous.
+        //
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            bool ZeroMode = (k == 0 && beta == 0.0f);
+
+            CountK = MLAS_SGEMM_PACKED_STRIDEK;
+
+            if (CountK > (K - k)) {
+                CountK = K - k;
+            }
+
+            const float* PanelB = PackedB + AlignedN * k + CountK * (RangeStartN + n);
+
+            //
+            // Apply the epilogue with the last panel along the K dimension.
+            //
+
+            MLAS_GEMM_EPILOGUE OffsetEpilogue;
+            const MLAS_GEMM_EPILOGUE* PanelEpilogue = nullptr;
+
+            if (Epilogue != nullptr && (k + CountK) == K) {
+                OffsetEpilogue = MlasSgemmOffsetEpilogue(Epilogue, 0, n);
+                PanelEpilogue = &OffsetEpilogue;
+            }
+
+            MlasSgemmMultiplyPanelB(TransA, M, CountN, CountK, alpha,
+                (TransA == CblasNoTrans) ? A + k : A + k * lda, lda, PanelB,
+                C + n, ldc, ZeroMode, PanelA, PanelEpilogue);
+        }
+    }
+}
+
+void
+MlasSgemmOperationThreaded(
     void* Context,
     int32_t Index
     )
@@ -1068,10 +1473,22 @@ Return Value:
 
     MLAS_SGEMM_WORK_BLOCK::SEGMENT* Segment = &WorkBlock->Segments[Index];
 
-    MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, Segment->M,
-        Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
-        Segment->B, WorkBlock->ldb, WorkBlock->beta, Segment->C,
-        WorkBlock->ldc);
+    const MLAS_GEMM_EPILOGUE* Epilogue = WorkBlock->HasEpilogue ? &Segment->Epilogue : nullptr;
+
+    if (WorkBlock->BIsPacked) {
+
+        MlasSgemmPackedOperation(WorkBlock->TransA, Segment->M, Segment->StartN,
+            Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A,
+            WorkBlock->lda, Segment->B, WorkBlock->ldb, WorkBlock->beta,
+            Segment->C, WorkBlock->ldc, Epilogue);
+
+    } else {
+
+        MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, Segment->M,
+            Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
+            Segment->B, WorkBlock->ldb, WorkBlock->beta, Segment->C,
+            WorkBlock->ldc, Epilogue);
+    }
 }
 
 inline
@@ -1087,9 +1504,11 @@ MlasSgemmTryMultithread(
     size_t lda,
     const float* B,
     size_t ldb,
+    bool BIsPacked,
     float beta,
     float* C,
     size_t ldc,
+    const MLAS_GEMM_EPILOGUE* Epilogue,
     MLAS_THREADPOOL* ThreadPool
     )
 /*++
@@ -1122,12 +1541,17 @@ Arguments:
 
     ldb - Supplies the first dimension of matrix B.
 
+    BIsPacked - Supplies true if matrix B was packed by MlasGemmPackB, in
+        which case ldb is the number of columns of the packed buffer.
+
     beta - Supplies the scalar beta multiplier (see SGEMM definition).
 
     C - Supplies the address of matrix C.
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Supplies the optional epilogue to apply to matrix C.
+
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
@@ -1164,6 +1588,12 @@ Return Value:
         return false;
     }
 
+    int32_t SegmentCount = TargetThreadCount * int32_t(MlasPlatform.ThreadSegmentsPerThread);
+
+    if (SegmentCount > MLAS_MAXIMUM_SEGMENT_COUNT) {
+        SegmentCount = MLAS_MAXIMUM_SEGMENT_COUNT;
+    }
+
     //
     // Initialize the common fields of the work block.
     //
@@ -1176,6 +1606,8 @@ Return Value:
     WorkBlock.ldc = ldc;
     WorkBlock.alpha = alpha;
     WorkBlock.beta = beta;
+    WorkBlock.BIsPacked = BIsPacked;
+    WorkBlock.HasEpilogue = (Epilogue != nullptr);
 
     //
     // Segment the operation across multiple threads.
@@ -1185,9 +1617,9 @@ Return Value:
 
     if (N > M) {
 
-        size_t StrideN = N / TargetThreadCount;
+        size_t StrideN = N / SegmentCount;
 
-        if ((StrideN * TargetThreadCount) != N) {
+        if ((StrideN * SegmentCount) != N) {
             StrideN++;
         }
 
@@ -1206,18 +1638,23 @@ Return Value:
 
             WorkBlock.Segments[Index].M = M;
             WorkBlock.Segments[Index].N = CountN;
+            WorkBlock.Segments[Index].StartN = n;
             WorkBlock.Segments[Index].A = A;
-            WorkBlock.Segments[Index].B = B + n * pldb;
+            WorkBlock.Segments[Index].B = BIsPacked ? B : B + n * pldb;
             WorkBlock.Segments[Index].C = C + n;
 
+            if (Epilogue != nullptr) {
+                WorkBlock.Segments[Index].Epilogue = MlasSgemmOffsetEpilogue(Epilogue, 0, n);
+            }
+
             Index++;
         }
 
     } else {
 
-        size_t StrideM = M / TargetThreadCount;
+        size_t StrideM = M / SegmentCount;
 
-        if ((StrideM * TargetThreadCount) != M) {
+        if ((StrideM * SegmentCount) != M) {
             StrideM++;
         }
 
@@ -1233,10 +1670,15 @@ Return Value:
 
             WorkBlock.Segments[Index].M = CountM;
             WorkBlock.Segments[Index].N = N;
+            WorkBlock.Segments[Index].StartN = 0;
             WorkBlock.Segments[Index].A = A + m * plda;
             WorkBlock.Segments[Index].B = B;
             WorkBlock.Segments[Index].C = C + m * ldc;
 
+            if (Epilogue != nullptr) {
+                WorkBlock.Segments[Index].Epilogue = MlasSgemmOffsetEpilogue(Epilogue, m, 0);
+            }
+
             Index++;
         }
     }
@@ -1307,6 +1749,76 @@ Return Value:
 
     None.
 
+--*/
+{
+    MlasGemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, nullptr, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_GEMM_EPILOGUE* Epilogue,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) followed by an epilogue that is applied to each tile of
+    the output matrix as the tile is completed.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Epilogue - Supplies the optional epilogue to apply to matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
 --*/
 {
     //
@@ -1314,7 +1826,517 @@ Return Value:
     // single thread based on the GEMM parameters and system configuration.
     //
 
-    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, ThreadPool)) {
-        MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, false, beta, C, ldc, Epilogue, ThreadPool)) {
+        MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, Epilogue);
     }
 }
+
+size_t
+MLASCALL
+MlasGemmPackBSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed matrix B buffer.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size in bytes for the packed matrix B buffer.
+
+--*/
+{
+    //
+    // Compute the number of bytes required to hold the packed buffer. Each
+    // slice along the K dimension has the columns of matrix B padded to a
+    // multiple of 16 elements.
+    //
+
+    const size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    return AlignedN * K * sizeof(float);
+}
+
+void
+MLASCALL
+MlasGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the contents of matrix B to the destination buffer. The
+    destination buffer should be sized based on MlasGemmPackBSize(). For best
+    performance, the destination buffer should be aligned to the value returned
+    from MlasGetPreferredBufferAlignment().
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    float* D = (float*)PackedB;
+
+    size_t CountK;
+
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = MLAS_SGEMM_PACKED_STRIDEK;
+
+        if (CountK > (K - k)) {
+            CountK = K - k;
+        }
+
+        if (TransB == CblasNoTrans) {
+            MlasSgemmCopyPackB(D, B + k * ldb, ldb, N, CountK);
+        } else {
+            MlasSgemmTransposePackB(D, B + k, ldb, N, CountK);
+        }
+
+        D += AlignedN * CountK;
+    }
+}
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) with a matrix B that was packed by MlasGemmPackB.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of the packed matrix B.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasGemm(TransA, M, N, K, alpha, A, lda, PackedB, beta, C, ldc, nullptr, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_GEMM_EPILOGUE* Epilogue,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) with a matrix B that was packed by MlasGemmPackB,
+    followed by an epilogue that is applied to each tile of the output matrix
+    as the tile is completed.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of the packed matrix B.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Epilogue - Supplies the optional epilogue to apply to matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    const float* B = (const float*)PackedB;
+
+    //
+    // Try to run the operation across multiple threads or fall back to a
+    // single thread based on the GEMM parameters and system configuration.
+    //
+
+    if (!MlasSgemmTryMultithread(TransA, CblasNoTrans, M, N, K, alpha, A, lda, B, AlignedN, true, beta, C, ldc, Epilogue, ThreadPool)) {
+        MlasSgemmPackedOperation(TransA, M, 0, N, K, alpha, A, lda, B, AlignedN, beta, C, ldc, Epilogue);
+    }
+}
+
+void
+MlasSgemmBatchThreaded(
+    void* Context,
+    int32_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    batched SGEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_SGEMM_BATCH_WORK_BLOCK*)Context;
+
+    const int32_t ThreadCountM = WorkBlock->ThreadCountM;
+    const int32_t ThreadCountN = WorkBlock->ThreadCountN;
+    const int32_t ThreadCountGemm = ThreadCountM * ThreadCountN;
+
+    const int32_t ThreadIdBatch = ThreadId / ThreadCountGemm;
+    const int32_t ThreadIdM = (ThreadId % ThreadCountGemm) / ThreadCountN;
+    const int32_t ThreadIdN = (ThreadId % ThreadCountGemm) % ThreadCountN;
+
+    //
+    // Partition the operation along the batch dimension.
+    //
+
+    size_t Batch;
+    size_t CountBatch;
+
+    MlasPartitionWork(ThreadIdBatch, WorkBlock->ThreadCountBatch,
+        WorkBlock->BatchCount, &Batch, &CountBatch);
+
+    //
+    // Partition each operation along the M dimension.
+    //
+
+    const size_t M = WorkBlock->M;
+    size_t m;
+    size_t CountM;
+
+    MlasPartitionWork(ThreadIdM, ThreadCountM, M, &m, &CountM);
+
+    //
+    // Partition each operation along the N dimension.
+    //
+
+    const size_t N = WorkBlock->N;
+    size_t n;
+    size_t CountN;
+
+    const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
+        MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+    MlasPartitionWork(ThreadIdN, ThreadCountN, BlockedN, &n, &CountN);
+
+    n *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+    CountN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+    if (CountN > N - n) {
+        CountN = N - n;
+    }
+
+    if (CountM == 0 || CountN == 0) {
+        return;
+    }
+
+    //
+    // Dispatch the partitioned operations.
+    //
+
+    const size_t lda = WorkBlock->lda;
+    const size_t ldb = WorkBlock->ldb;
+    const size_t ldc = WorkBlock->ldc;
+
+    const size_t plda = (WorkBlock->TransA == CblasNoTrans) ? lda : 1;
+    const size_t pldb = (WorkBlock->TransB == CblasNoTrans) ? 1 : ldb;
+
+    for (size_t BatchIndex = Batch; BatchIndex < Batch + CountBatch; BatchIndex++) {
+
+        const float* a = WorkBlock->A + BatchIndex * WorkBlock->StrideA + m * plda;
+        const float* b = WorkBlock->B + BatchIndex * WorkBlock->StrideB + n * pldb;
+        float* c = WorkBlock->C + BatchIndex * WorkBlock->StrideC + n + m * ldc;
+
+        MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, CountM,
+            CountN, WorkBlock->K, WorkBlock->alpha, a, lda, b, ldb,
+            WorkBlock->beta, c, ldc, nullptr);
+    }
+}
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    size_t StrideA,
+    const float* B,
+    size_t ldb,
+    size_t StrideB,
+    float beta,
+    float* C,
+    size_t ldc,
+    size_t StrideC,
+    size_t BatchCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a batch of single precision matrix/matrix multiply
+    operations (SGEMM) that share the same shape, where the matrices of each
+    batch are found at a fixed stride from the previous batch.
+
+    The batch is scheduled across the thread pool as a single operation, so
+    small matrices only pay the dispatch overhead once.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of the first matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    StrideA - Supplies the number of elements between each matrix A. A stride
+        of zero broadcasts matrix A to every batch.
+
+    B - Supplies the address of the first matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    StrideB - Supplies the number of elements between each matrix B. A stride
+        of zero broadcasts matrix B to every batch.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of the first matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    StrideC - Supplies the number of elements between each matrix C.
+
+    BatchCount - Supplies the number of matrix multiplications.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (BatchCount == 0 || M == 0 || N == 0) {
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the whole
+    // batch. Small requests should run using the single threaded path.
+    //
+
+    double Complexity = double(M) * double(N) * double(K) * double(BatchCount);
+
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    MLAS_SGEMM_BATCH_WORK_BLOCK WorkBlock;
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = TransB;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.StrideA = StrideA;
+    WorkBlock.B = B;
+    WorkBlock.ldb = ldb;
+    WorkBlock.StrideB = StrideB;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+    WorkBlock.StrideC = StrideC;
+    WorkBlock.alpha = alpha;
+    WorkBlock.beta = beta;
+    WorkBlock.BatchCount = BatchCount;
+    WorkBlock.ThreadCountM = 1;
+    WorkBlock.ThreadCountN = 1;
+
+    //
+    // Distribute whole operations to the threads while there are at least as
+    // many operations as threads, else additionally segment each operation
+    // along the M or N dimension to occupy the remaining threads.
+    //
+
+    if (BatchCount >= size_t(TargetThreadCount)) {
+
+        WorkBlock.ThreadCountBatch = TargetThreadCount;
+
+    } else {
+
+        WorkBlock.ThreadCountBatch = int32_t(BatchCount);
+
+        int32_t ThreadsPerGemm = (TargetThreadCount + int32_t(BatchCount) - 1) /
+            int32_t(BatchCount);
+
+        if (N > M) {
+
+            const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
+                MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+            if (size_t(ThreadsPerGemm) > BlockedN) {
+                ThreadsPerGemm = int32_t(BlockedN);
+            }
+
+            WorkBlock.ThreadCountN = ThreadsPerGemm;
+
+        } else {
+
+            if (size_t(ThreadsPerGemm) > M) {
+                ThreadsPerGemm = int32_t(M);
+            }
+
+            WorkBlock.ThreadCountM = ThreadsPerGemm;
+        }
+    }
+
+    int32_t Iterations = WorkBlock.ThreadCountBatch * WorkBlock.ThreadCountM *
+        WorkBlock.ThreadCountN;
+
+    MlasExecuteThreaded(MlasSgemmBatchThreaded, &WorkBlock, Iterations, ThreadPool);
+}
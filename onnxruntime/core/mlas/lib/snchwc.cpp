@@ -75,6 +75,12 @@ struct MLAS_NCHWC_POOL_WORK_BLOCK : MLAS_NCHWC_WORK_BLOCK
 #define MLAS_CONV_KERNEL_FLAG_RELU_ACTIVATION       0x00000004
 #define MLAS_CONV_KERNEL_FLAG_OTHER_ACTIVATION      0x00000008
 
+//
+// Define the NCHWc block size used by the vector intrinsic kernels.
+//
+
+#define MLAS_NCHWC_VECTOR_BLOCK_SIZE                8
+
 size_t
 MLASCALL
 MlasNchwcGetBlockSize(
@@ -103,6 +109,8 @@ Return Value:
 {
 #if defined(MLAS_TARGET_AMD64)
     return MlasPlatform.NchwcBlockSize;
+#elif defined(MLAS_TARGET_ARM64)
+    return MLAS_NCHWC_VECTOR_BLOCK_SIZE;
 #else
     return 1;
 #endif
@@ -1514,10 +1522,270 @@ Return Value:
 #if !defined(MLAS_TARGET_AMD64)
 
 //
-// Convolution and pooling kernel stubs for architectures that do not yet have
-// native support.
+// Convolution and pooling kernels for architectures without assembly kernels.
+// These kernels are built from the cross-platform vector intrinsics and
+// operate on NCHW8c blocks, where each block is held in two vectors.
+//
+
+//
+// Test if the input address is inside the valid input row rather than in the
+// left or right width padding.
 //
 
+MLAS_FORCEINLINE
+bool
+MlasNchwcIsInputInBounds(
+    const float* Input,
+    const float* InputBase,
+    size_t InputWidth
+    )
+{
+    return size_t(reinterpret_cast<const uint8_t*>(Input) -
+        reinterpret_cast<const uint8_t*>(InputBase)) < InputWidth;
+}
+
+template<size_t FilterCount>
+MLAS_FORCEINLINE
+void
+MlasConvPostProcessFloatVector(
+    MLAS_FLOAT32X4 Accumulators[FilterCount][2],
+    float* Output,
+    size_t OutputStride,
+    const float* Bias,
+    unsigned Flags
+    )
+/*++
+
+Routine Description:
+
+    This routine processes the accumulators of an output block after the inner
+    convolution kernel has executed and then stores the output block to the
+    output buffer.
+
+Arguments:
+
+    Accumulators - Supplies the accumulators for each filter.
+
+    Output - Supplies the address of the output block of the first filter.
+
+    OutputStride - Supplies the number of elements to advance the output
+        buffer to the output block of the next filter.
+
+    Bias - Supplies the address of the bias buffer.
+
+    Flags - Supplies additional flags controlling the convolution operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        float* output = Output + f * OutputStride;
+
+        MLAS_FLOAT32X4 Accumulator0 = Accumulators[f][0];
+        MLAS_FLOAT32X4 Accumulator1 = Accumulators[f][1];
+
+        if ((Flags & MLAS_CONV_KERNEL_FLAG_ACCUMULATE_OUTPUT) != 0) {
+            Accumulator0 = MlasAddFloat32x4(Accumulator0, MlasLoadFloat32x4(output));
+            Accumulator1 = MlasAddFloat32x4(Accumulator1, MlasLoadFloat32x4(output + 4));
+        }
+
+        if ((Flags & MLAS_CONV_KERNEL_FLAG_BIAS_ADDITION) != 0) {
+            Accumulator0 = MlasAddFloat32x4(Accumulator0, MlasLoadFloat32x4(Bias + f * MLAS_NCHWC_VECTOR_BLOCK_SIZE));
+            Accumulator1 = MlasAddFloat32x4(Accumulator1, MlasLoadFloat32x4(Bias + f * MLAS_NCHWC_VECTOR_BLOCK_SIZE + 4));
+        }
+
+        if ((Flags & MLAS_CONV_KERNEL_FLAG_RELU_ACTIVATION) != 0) {
+            Accumulator0 = MlasMaximumFloat32x4(Accumulator0, MlasZeroFloat32x4());
+            Accumulator1 = MlasMaximumFloat32x4(Accumulator1, MlasZeroFloat32x4());
+        }
+
+        MlasStoreFloat32x4(output, Accumulator0);
+        MlasStoreFloat32x4(output + 4, Accumulator1);
+    }
+}
+
+template<bool IsNchwcFormat, size_t FilterCount>
+void
+MlasConvFloatKernelVector(
+    const float* Input,
+    const float* Filter,
+    float* Output,
+    size_t StrideWidth,
+    size_t DilationWidth,
+    size_t InputStride,
+    size_t FilterStride,
+    size_t OutputStride,
+    size_t KernelHeight,
+    size_t KernelWidth,
+    const float* InputBase,
+    size_t InputWidth,
+    size_t DilatedInputWidth,
+    size_t OutputCountTotal,
+    const float* Bias,
+    unsigned Flags
+    )
+/*++
+
+Routine Description:
+
+    This routine is the inner kernel to compute a convolution for the elements
+    of an output row for a set of filter rows.
+
+    If IsNchwcFormat is true, then the input is in NCHWc format and each
+    filter tap is an 8i8o block. Otherwise, the input is in NCHW format and
+    each filter tap is an 8o block.
+
+Arguments:
+
+    See MlasConvNchwcFloatKernel. The stride, dilation and width arguments
+    are in bytes, except that OutputCountTotal supplies the total number of
+    output elements including those that use padding elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockSize = MLAS_NCHWC_VECTOR_BLOCK_SIZE;
+
+    const size_t StrideWidthElements = StrideWidth / sizeof(float);
+    const size_t DilationWidthElements = DilationWidth / sizeof(float);
+    const size_t InputStrideElements = InputStride / sizeof(float);
+    const size_t FilterStrideElements = FilterStride / sizeof(float);
+    const size_t OutputStrideElements = OutputStride / sizeof(float);
+    const size_t DilatedInputWidthElements = DilatedInputWidth / sizeof(float);
+
+    const size_t FilterTapSize = IsNchwcFormat ? BlockSize * BlockSize : BlockSize;
+
+    for (size_t o = 0; o < OutputCountTotal; o++) {
+
+        MLAS_FLOAT32X4 Accumulators[FilterCount][2];
+
+        for (size_t f = 0; f < FilterCount; f++) {
+            Accumulators[f][0] = MlasZeroFloat32x4();
+            Accumulators[f][1] = MlasZeroFloat32x4();
+        }
+
+        const float* input = Input + o * StrideWidthElements;
+        const float* input_base = InputBase;
+        const float* filter = Filter;
+
+        for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+            for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                //
+                // Skip over the filter tap if the input element is in the
+                // width padding.
+                //
+
+                if (MlasNchwcIsInputInBounds(input, input_base, InputWidth)) {
+
+                    if (IsNchwcFormat) {
+
+                        for (size_t i = 0; i < BlockSize; i++) {
+
+                            MLAS_FLOAT32X4 InputBroadcast = MlasBroadcastFloat32x4(input + i);
+
+                            for (size_t f = 0; f < FilterCount; f++) {
+
+                                const float* filter_block = filter + f * FilterStrideElements + i * BlockSize;
+
+                                Accumulators[f][0] = MlasMultiplyAddFloat32x4(InputBroadcast,
+                                    MlasLoadFloat32x4(filter_block), Accumulators[f][0]);
+                                Accumulators[f][1] = MlasMultiplyAddFloat32x4(InputBroadcast,
+                                    MlasLoadFloat32x4(filter_block + 4), Accumulators[f][1]);
+                            }
+                        }
+
+                    } else {
+
+                        MLAS_FLOAT32X4 InputBroadcast = MlasBroadcastFloat32x4(input);
+
+                        for (size_t f = 0; f < FilterCount; f++) {
+
+                            const float* filter_block = filter + f * FilterStrideElements;
+
+                            Accumulators[f][0] = MlasMultiplyAddFloat32x4(InputBroadcast,
+                                MlasLoadFloat32x4(filter_block), Accumulators[f][0]);
+                            Accumulators[f][1] = MlasMultiplyAddFloat32x4(InputBroadcast,
+                                MlasLoadFloat32x4(filter_block + 4), Accumulators[f][1]);
+                        }
+                    }
+                }
+
+                input += DilationWidthElements;
+                filter += FilterTapSize;
+            }
+
+            input += InputStrideElements;
+            input_base += DilatedInputWidthElements;
+        }
+
+        MlasConvPostProcessFloatVector<FilterCount>(Accumulators, Output + o * BlockSize,
+            OutputStrideElements, Bias, Flags);
+    }
+}
+
+template<bool IsNchwcFormat>
+void
+MlasConvFloatKernelVectorDispatch(
+    const float* Input,
+    const float* Filter,
+    float* Output,
+    size_t StrideWidth,
+    size_t DilationWidth,
+    size_t FilterCount,
+    size_t InputStride,
+    size_t FilterStride,
+    size_t OutputStride,
+    size_t KernelHeight,
+    size_t KernelWidth,
+    const float* InputBase,
+    size_t InputWidth,
+    size_t DilatedInputWidth,
+    size_t OutputCountTotal,
+    const float* Bias,
+    unsigned Flags
+    )
+{
+    switch (FilterCount) {
+
+        case 1:
+            MlasConvFloatKernelVector<IsNchwcFormat, 1>(Input, Filter, Output, StrideWidth,
+                DilationWidth, InputStride, FilterStride, OutputStride, KernelHeight,
+                KernelWidth, InputBase, InputWidth, DilatedInputWidth, OutputCountTotal,
+                Bias, Flags);
+            break;
+
+        case 2:
+            MlasConvFloatKernelVector<IsNchwcFormat, 2>(Input, Filter, Output, StrideWidth,
+                DilationWidth, InputStride, FilterStride, OutputStride, KernelHeight,
+                KernelWidth, InputBase, InputWidth, DilatedInputWidth, OutputCountTotal,
+                Bias, Flags);
+            break;
+
+        case 3:
+            MlasConvFloatKernelVector<IsNchwcFormat, 3>(Input, Filter, Output, StrideWidth,
+                DilationWidth, InputStride, FilterStride, OutputStride, KernelHeight,
+                KernelWidth, InputBase, InputWidth, DilatedInputWidth, OutputCountTotal,
+                Bias, Flags);
+            break;
+
+        default:
+            MlasConvFloatKernelVector<IsNchwcFormat, 4>(Input, Filter, Output, StrideWidth,
+                DilationWidth, InputStride, FilterStride, OutputStride, KernelHeight,
+                KernelWidth, InputBase, InputWidth, DilatedInputWidth, OutputCountTotal,
+                Bias, Flags);
+            break;
+    }
+}
+
 void
 MLASCALL
 MlasConvNchwFloatKernel(
@@ -1541,26 +1809,28 @@ MlasConvNchwFloatKernel(
     const float* Bias,
     unsigned Flags
     )
+/*++
+
+Routine Description:
+
+    This routine is the inner kernel to compute a convolution for the elements
+    of an output row for a set of filter rows, where the input is in NCHW
+    format.
+
+Arguments:
+
+    See MlasConvNchwcFloatKernel.
+
+Return Value:
+
+    None.
+
+--*/
 {
-    MLAS_UNREFERENCED_PARAMETER(Input);
-    MLAS_UNREFERENCED_PARAMETER(Filter);
-    MLAS_UNREFERENCED_PARAMETER(Output);
-    MLAS_UNREFERENCED_PARAMETER(StrideWidth);
-    MLAS_UNREFERENCED_PARAMETER(DilationWidth);
-    MLAS_UNREFERENCED_PARAMETER(FilterCount);
-    MLAS_UNREFERENCED_PARAMETER(InputStride);
-    MLAS_UNREFERENCED_PARAMETER(FilterStride);
-    MLAS_UNREFERENCED_PARAMETER(OutputStride);
-    MLAS_UNREFERENCED_PARAMETER(KernelHeight);
-    MLAS_UNREFERENCED_PARAMETER(KernelWidth);
-    MLAS_UNREFERENCED_PARAMETER(InputBase);
-    MLAS_UNREFERENCED_PARAMETER(InputWidth);
-    MLAS_UNREFERENCED_PARAMETER(DilatedInputWidth);
-    MLAS_UNREFERENCED_PARAMETER(OutputCountLeftPad);
-    MLAS_UNREFERENCED_PARAMETER(OutputCount);
-    MLAS_UNREFERENCED_PARAMETER(OutputCountRightPad);
-    MLAS_UNREFERENCED_PARAMETER(Bias);
-    MLAS_UNREFERENCED_PARAMETER(Flags);
+    MlasConvFloatKernelVectorDispatch<false>(Input, Filter, Output, StrideWidth, DilationWidth,
+        FilterCount, InputStride, FilterStride, OutputStride, KernelHeight, KernelWidth,
+        InputBase, InputWidth, DilatedInputWidth,
+        OutputCountLeftPad + OutputCount + OutputCountRightPad, Bias, Flags);
 }
 
 void
@@ -1586,26 +1856,85 @@ MlasConvNchwcFloatKernel(
     const float* Bias,
     unsigned Flags
     )
+/*++
+
+Routine Description:
+
+    This routine is the inner kernel to compute a convolution for the elements
+    of an output row for a set of filter rows.
+
+Arguments:
+
+    Input - Supplies the address of the input buffer.
+
+        The address is biased to include padding blocks for the left width
+        dimension. The address is not biased to include padding rows for the
+        left height dimension; these are accounted for in the outer kernel.
+
+    Filter - Supplies the address of the filter buffer.
+
+    Output - Supplies the address of the output buffer.
+
+    StrideWidth - Supplies the length in bytes of the blocked stride width.
+
+    DilationWidth - Supplies the length in bytes of the blocked dilation
+        width.
+
+    FilterCount - Supplies the number of filters to process in this
+        iteration.
+
+    InputStride - Supplies the length in bytes to advance the input buffer to
+        the next input row.
+
+    FilterStride - Supplies the length in bytes to advance the filter buffer
+        to the next set of filters.
+
+    OutputStride - Supplies the length in bytes to advance the output buffer
+        to the next output address associated with the next set of filters.
+
+    KernelHeight - Supplies the height of the kernel to apply. This height may
+        be less than the original kernel height after removing any padding
+        rows.
+
+    KernelWidth - Supplies the width of the kernel to apply.
+
+    InputBase - Supplies the address of the valid input buffer.
+
+        This parameter is similar to the Input parameter, but does not include
+        the padding blocks for the left width dimension. This parameter is used
+        with the following InputWidth parameter in order to validate that the
+        current input buffer address in bounds and not in the left or right
+        width padding region.
+
+    InputWidth - Supplies the length in bytes of the blocked input width.
+
+    DilatedInputWidth - Supplies the length in bytes to advance the input base
+        buffer to the next input row including dilation.
+
+    OutputCountLeftPad - Supplies the number of output elements that include
+        one or more padding elements from the left edge.
+
+    OutputCount - Supplies the number of output elements that do not include
+        any padding elements.
+
+    OutputCountRightPad - Supplies the number of output elements that include
+        one or more padding elements from the right edge.
+
+    Bias - Supplies the address of the bias buffer.
+
+    Flags - Supplies additional flags controlling the convolution operation,
+        especially post calculation options.
+
+Return Value:
+
+    None.
+
+--*/
 {
-    MLAS_UNREFERENCED_PARAMETER(Input);
-    MLAS_UNREFERENCED_PARAMETER(Filter);
-    MLAS_UNREFERENCED_PARAMETER(Output);
-    MLAS_UNREFERENCED_PARAMETER(StrideWidth);
-    MLAS_UNREFERENCED_PARAMETER(DilationWidth);
-    MLAS_UNREFERENCED_PARAMETER(FilterCount);
-    MLAS_UNREFERENCED_PARAMETER(InputStride);
-    MLAS_UNREFERENCED_PARAMETER(FilterStride);
-    MLAS_UNREFERENCED_PARAMETER(OutputStride);
-    MLAS_UNREFERENCED_PARAMETER(KernelHeight);
-    MLAS_UNREFERENCED_PARAMETER(KernelWidth);
-    MLAS_UNREFERENCED_PARAMETER(InputBase);
-    MLAS_UNREFERENCED_PARAMETER(InputWidth);
-    MLAS_UNREFERENCED_PARAMETER(DilatedInputWidth);
-    MLAS_UNREFERENCED_PARAMETER(OutputCountLeftPad);
-    MLAS_UNREFERENCED_PARAMETER(OutputCount);
-    MLAS_UNREFERENCED_PARAMETER(OutputCountRightPad);
-    MLAS_UNREFERENCED_PARAMETER(Bias);
-    MLAS_UNREFERENCED_PARAMETER(Flags);
+    MlasConvFloatKernelVectorDispatch<true>(Input, Filter, Output, StrideWidth, DilationWidth,
+        FilterCount, InputStride, FilterStride, OutputStride, KernelHeight, KernelWidth,
+        InputBase, InputWidth, DilatedInputWidth,
+        OutputCountLeftPad + OutputCount + OutputCountRightPad, Bias, Flags);
 }
 
 void
@@ -1628,23 +1957,145 @@ MlasConvDepthwiseFloatKernel(
     const float* Bias,
     unsigned Flags
     )
+/*++
+
+Routine Description:
+
+    This routine is the inner kernel to compute a convolution for the elements
+    of an output row for a set of filter rows.
+
+    Depthwise separable convolutions are a form of grouped convolution where
+    the number of input and output channels per group are one.
+
+Arguments:
+
+    See MlasConvNchwcFloatKernel.
+
+Return Value:
+
+    None.
+
+--*/
 {
-    MLAS_UNREFERENCED_PARAMETER(Input);
-    MLAS_UNREFERENCED_PARAMETER(Filter);
-    MLAS_UNREFERENCED_PARAMETER(Output);
-    MLAS_UNREFERENCED_PARAMETER(StrideWidth);
-    MLAS_UNREFERENCED_PARAMETER(DilationWidth);
-    MLAS_UNREFERENCED_PARAMETER(InputStride);
-    MLAS_UNREFERENCED_PARAMETER(KernelHeight);
-    MLAS_UNREFERENCED_PARAMETER(KernelWidth);
-    MLAS_UNREFERENCED_PARAMETER(InputBase);
-    MLAS_UNREFERENCED_PARAMETER(InputWidth);
-    MLAS_UNREFERENCED_PARAMETER(DilatedInputWidth);
-    MLAS_UNREFERENCED_PARAMETER(OutputCountLeftPad);
-    MLAS_UNREFERENCED_PARAMETER(OutputCount);
-    MLAS_UNREFERENCED_PARAMETER(OutputCountRightPad);
-    MLAS_UNREFERENCED_PARAMETER(Bias);
-    MLAS_UNREFERENCED_PARAMETER(Flags);
+    const size_t BlockSize = MLAS_NCHWC_VECTOR_BLOCK_SIZE;
+
+    const size_t StrideWidthElements = StrideWidth / sizeof(float);
+    const size_t DilationWidthElements = DilationWidth / sizeof(float);
+    const size_t InputStrideElements = InputStride / sizeof(float);
+    const size_t DilatedInputWidthElements = DilatedInputWidth / sizeof(float);
+
+    const size_t OutputCountTotal = OutputCountLeftPad + OutputCount + OutputCountRightPad;
+
+    for (size_t o = 0; o < OutputCountTotal; o++) {
+
+        MLAS_FLOAT32X4 Accumulators[1][2];
+
+        Accumulators[0][0] = MlasZeroFloat32x4();
+        Accumulators[0][1] = MlasZeroFloat32x4();
+
+        const float* input = Input + o * StrideWidthElements;
+        const float* input_base = InputBase;
+        const float* filter = Filter;
+
+        for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+            for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                if (MlasNchwcIsInputInBounds(input, input_base, InputWidth)) {
+
+                    Accumulators[0][0] = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input),
+                        MlasLoadFloat32x4(filter), Accumulators[0][0]);
+                    Accumulators[0][1] = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input + 4),
+                        MlasLoadFloat32x4(filter + 4), Accumulators[0][1]);
+                }
+
+                input += DilationWidthElements;
+                filter += BlockSize;
+            }
+
+            input += InputStrideElements;
+            input_base += DilatedInputWidthElements;
+        }
+
+        MlasConvPostProcessFloatVector<1>(Accumulators, Output + o * BlockSize, 0, Bias, Flags);
+    }
+}
+
+template<size_t FilterCount>
+void
+MlasConvPointwiseFloatKernelVector(
+    const float* Input,
+    const float* Filter,
+    float* Output,
+    size_t StrideWidth,
+    size_t InputChannels,
+    size_t InputStride,
+    size_t FilterStride,
+    size_t OutputStride,
+    size_t OutputCount,
+    const float* Bias,
+    unsigned Flags
+    )
+/*++
+
+Routine Description:
+
+    This routine is the inner kernel to compute a pointwise convolution for
+    the elements of an output row for a fixed number of filter rows.
+
+Arguments:
+
+    See MlasConvPointwiseFloatKernel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockSize = MLAS_NCHWC_VECTOR_BLOCK_SIZE;
+
+    const size_t StrideWidthElements = StrideWidth / sizeof(float);
+    const size_t InputStrideElements = InputStride / sizeof(float);
+    const size_t FilterStrideElements = FilterStride / sizeof(float);
+    const size_t OutputStrideElements = OutputStride / sizeof(float);
+
+    for (size_t o = 0; o < OutputCount; o++) {
+
+        MLAS_FLOAT32X4 Accumulators[FilterCount][2];
+
+        for (size_t f = 0; f < FilterCount; f++) {
+            Accumulators[f][0] = MlasZeroFloat32x4();
+            Accumulators[f][1] = MlasZeroFloat32x4();
+        }
+
+        const float* input = Input + o * StrideWidthElements;
+        const float* filter = Filter;
+
+        for (size_t ic = 0; ic < InputChannels; ic++) {
+
+            for (size_t i = 0; i < BlockSize; i++) {
+
+                MLAS_FLOAT32X4 InputBroadcast = MlasBroadcastFloat32x4(input + i);
+
+                for (size_t f = 0; f < FilterCount; f++) {
+
+                    const float* filter_block = filter + f * FilterStrideElements + i * BlockSize;
+
+                    Accumulators[f][0] = MlasMultiplyAddFloat32x4(InputBroadcast,
+                        MlasLoadFloat32x4(filter_block), Accumulators[f][0]);
+                    Accumulators[f][1] = MlasMultiplyAddFloat32x4(InputBroadcast,
+                        MlasLoadFloat32x4(filter_block + 4), Accumulators[f][1]);
+                }
+            }
+
+            input += InputStrideElements;
+            filter += BlockSize * BlockSize;
+        }
+
+        MlasConvPostProcessFloatVector<FilterCount>(Accumulators, Output + o * BlockSize,
+            OutputStrideElements, Bias, Flags);
+    }
 }
 
 void
@@ -1663,19 +2114,220 @@ MlasConvPointwiseFloatKernel(
     const float* Bias,
     unsigned Flags
     )
+/*++
+
+Routine Description:
+
+    This routine is the inner kernel to compute a convolution for the elements
+    of an output row for a set of filter rows.
+
+    Pointwise convolutions have a kernel size of one. To simplify this
+    implementation, no input padding is allowed, which matches typical usage in
+    models.
+
+Arguments:
+
+    Input - Supplies the address of the input buffer.
+
+    Filter - Supplies the address of the filter buffer.
+
+    Output - Supplies the address of the output buffer.
+
+    StrideWidth - Supplies the length in bytes of the blocked stride width.
+
+    InputChannels - Supplies the number of input channel blocks to process.
+
+    FilterCount - Supplies the number of rows from the filter to process.
+
+    InputStride - Supplies the length in bytes to advance the input buffer to
+        the next input channel of the same input row.
+
+    FilterStride - Supplies the length in bytes to advance the filter buffer
+        to the next set of filters.
+
+    OutputStride - Supplies the length in bytes to advance the output buffer
+        to the next output address associated with the next set of filters.
+
+    OutputCount - Supplies the number of output elements.
+
+    Bias - Supplies the address of the bias buffer.
+
+    Flags - Supplies additional flags controlling the convolution operation,
+        especially post calculation options.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (FilterCount) {
+
+        case 1:
+            MlasConvPointwiseFloatKernelVector<1>(Input, Filter, Output, StrideWidth,
+                InputChannels, InputStride, FilterStride, OutputStride, OutputCount,
+                Bias, Flags);
+            break;
+
+        case 2:
+            MlasConvPointwiseFloatKernelVector<2>(Input, Filter, Output, StrideWidth,
+                InputChannels, InputStride, FilterStride, OutputStride, OutputCount,
+                Bias, Flags);
+            break;
+
+        case 3:
+            MlasConvPointwiseFloatKernelVector<3>(Input, Filter, Output, StrideWidth,
+                InputChannels, InputStride, FilterStride, OutputStride, OutputCount,
+                Bias, Flags);
+            break;
+
+        default:
+            MlasConvPointwiseFloatKernelVector<4>(Input, Filter, Output, StrideWidth,
+                InputChannels, InputStride, FilterStride, OutputStride, OutputCount,
+                Bias, Flags);
+            break;
+    }
+}
+
+template<MLAS_POOLING_KIND PoolingKind>
+void
+MlasPoolFloatKernelVector(
+    const float* Input,
+    float* Output,
+    size_t StrideWidth,
+    size_t DilationWidth,
+    size_t InputStride,
+    size_t ActualKernelSize,
+    size_t KernelHeight,
+    size_t KernelWidth,
+    const float* InputBase,
+    size_t InputWidth,
+    size_t DilatedInputWidth,
+    size_t OutputCountLeftPad,
+    size_t OutputCount,
+    size_t OutputCountRightPad
+    )
+/*++
+
+Routine Description:
+
+    This routine is the inner kernel to compute pooling for the elements of an
+    output row.
+
+Arguments:
+
+    Input - Supplies the address of the input buffer.
+
+        The address is biased to include padding blocks for the left width
+        dimension. The address is not biased to include padding rows for the
+        left height dimension; these are accounted for in the outer kernel.
+
+    Output - Supplies the address of the output buffer.
+
+    StrideWidth - Supplies the length in bytes of the blocked stride width.
+
+    DilationWidth - Supplies the length in bytes of the blocked dilation
+        width.
+
+    InputStride - Supplies the length in bytes to advance the input buffer to
+        the next input row.
+
+    ActualKernelSize - Supplies the size of the kernel based on the original
+        kernel dimensions, used for PoolingKind=MlasAveragePoolingIncludePad.
+
+    KernelHeight - Supplies the height of the kernel to apply. This height may
+        be less than the original kernel height after removing any padding
+        rows.
+
+    KernelWidth - Supplies the width of the kernel to apply.
+
+    InputBase - Supplies the address of the valid input buffer.
+
+    InputWidth - Supplies the length in bytes of the blocked input width.
+
+    DilatedInputWidth - Supplies the length in bytes to advance the input base
+        buffer to the next input row including dilation.
+
+    OutputCountLeftPad - Supplies the number of output elements that include
+        one or more padding elements from the left edge.
+
+    OutputCount - Supplies the number of output elements that do not include
+        any padding elements.
+
+    OutputCountRightPad - Supplies the number of output elements that include
+        one or more padding elements from the right edge.
+
+Return Value:
+
+    None.
+
+--*/
 {
-    MLAS_UNREFERENCED_PARAMETER(Input);
-    MLAS_UNREFERENCED_PARAMETER(Filter);
-    MLAS_UNREFERENCED_PARAMETER(Output);
-    MLAS_UNREFERENCED_PARAMETER(StrideWidth);
-    MLAS_UNREFERENCED_PARAMETER(InputChannels);
-    MLAS_UNREFERENCED_PARAMETER(FilterCount);
-    MLAS_UNREFERENCED_PARAMETER(InputStride);
-    MLAS_UNREFERENCED_PARAMETER(FilterStride);
-    MLAS_UNREFERENCED_PARAMETER(OutputStride);
-    MLAS_UNREFERENCED_PARAMETER(OutputCount);
-    MLAS_UNREFERENCED_PARAMETER(Bias);
-    MLAS_UNREFERENCED_PARAMETER(Flags);
+    const size_t BlockSize = MLAS_NCHWC_VECTOR_BLOCK_SIZE;
+
+    const size_t StrideWidthElements = StrideWidth / sizeof(float);
+    const size_t DilationWidthElements = DilationWidth / sizeof(float);
+    const size_t InputStrideElements = InputStride / sizeof(float);
+    const size_t DilatedInputWidthElements = DilatedInputWidth / sizeof(float);
+
+    const size_t OutputCountTotal = OutputCountLeftPad + OutputCount + OutputCountRightPad;
+
+    const MLAS_FLOAT32X4 InitialValue = (PoolingKind == MlasMaximumPooling) ?
+        MlasBroadcastFloat32x4(std::numeric_limits<float>::lowest()) : MlasZeroFloat32x4();
+
+    for (size_t o = 0; o < OutputCountTotal; o++) {
+
+        MLAS_FLOAT32X4 Accumulator0 = InitialValue;
+        MLAS_FLOAT32X4 Accumulator1 = InitialValue;
+        size_t ValidCount = 0;
+
+        const float* input = Input + o * StrideWidthElements;
+        const float* input_base = InputBase;
+
+        for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+            for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                if (MlasNchwcIsInputInBounds(input, input_base, InputWidth)) {
+
+                    if (PoolingKind == MlasMaximumPooling) {
+                        Accumulator0 = MlasMaximumFloat32x4(Accumulator0, MlasLoadFloat32x4(input));
+                        Accumulator1 = MlasMaximumFloat32x4(Accumulator1, MlasLoadFloat32x4(input + 4));
+                    } else {
+                        Accumulator0 = MlasAddFloat32x4(Accumulator0, MlasLoadFloat32x4(input));
+                        Accumulator1 = MlasAddFloat32x4(Accumulator1, MlasLoadFloat32x4(input + 4));
+                    }
+
+                    ValidCount++;
+                }
+
+                input += DilationWidthElements;
+            }
+
+            input += InputStrideElements;
+            input_base += DilatedInputWidthElements;
+        }
+
+        //
+        // Divide the sum by the number of non-padding elements or by the
+        // actual kernel size for average pooling.
+        //
+
+        if (PoolingKind != MlasMaximumPooling) {
+
+            const size_t Divisor = (PoolingKind == MlasAveragePoolingExcludePad) ?
+                ValidCount : ActualKernelSize;
+            const MLAS_FLOAT32X4 DivisorVector = MlasBroadcastFloat32x4(float(Divisor));
+
+            Accumulator0 = MlasDivideFloat32x4(Accumulator0, DivisorVector);
+            Accumulator1 = MlasDivideFloat32x4(Accumulator1, DivisorVector);
+        }
+
+        float* output = Output + o * BlockSize;
+
+        MlasStoreFloat32x4(output, Accumulator0);
+        MlasStoreFloat32x4(output + 4, Accumulator1);
+    }
 }
 
 void
@@ -1697,20 +2349,10 @@ MlasPoolMaximumFloatKernel(
     size_t OutputCountRightPad
     )
 {
-    MLAS_UNREFERENCED_PARAMETER(Input);
-    MLAS_UNREFERENCED_PARAMETER(Output);
-    MLAS_UNREFERENCED_PARAMETER(StrideWidth);
-    MLAS_UNREFERENCED_PARAMETER(DilationWidth);
-    MLAS_UNREFERENCED_PARAMETER(InputStride);
-    MLAS_UNREFERENCED_PARAMETER(ActualKernelSize);
-    MLAS_UNREFERENCED_PARAMETER(KernelHeight);
-    MLAS_UNREFERENCED_PARAMETER(KernelWidth);
-    MLAS_UNREFERENCED_PARAMETER(InputBase);
-    MLAS_UNREFERENCED_PARAMETER(InputWidth);
-    MLAS_UNREFERENCED_PARAMETER(DilatedInputWidth);
-    MLAS_UNREFERENCED_PARAMETER(OutputCountLeftPad);
-    MLAS_UNREFERENCED_PARAMETER(OutputCount);
-    MLAS_UNREFERENCED_PARAMETER(OutputCountRightPad);
+    MlasPoolFloatKernelVector<MlasMaximumPooling>(Input, Output, StrideWidth,
+        DilationWidth, InputStride, ActualKernelSize, KernelHeight, KernelWidth,
+        InputBase, InputWidth, DilatedInputWidth, OutputCountLeftPad, OutputCount,
+        OutputCountRightPad);
 }
 
 void
@@ -1732,20 +2374,10 @@ MlasPoolAverageExcludePadFloatKernel(
     size_t OutputCountRightPad
     )
 {
-    MLAS_UNREFERENCED_PARAMETER(Input);
-    MLAS_UNREFERENCED_PARAMETER(Output);
-    MLAS_UNREFERENCED_PARAMETER(StrideWidth);
-    MLAS_UNREFERENCED_PARAMETER(DilationWidth);
-    MLAS_UNREFERENCED_PARAMETER(InputStride);
-    MLAS_UNREFERENCED_PARAMETER(ActualKernelSize);
-    MLAS_UNREFERENCED_PARAMETER(KernelHeight);
-    MLAS_UNREFERENCED_PARAMETER(KernelWidth);
-    MLAS_UNREFERENCED_PARAMETER(InputBase);
-    MLAS_UNREFERENCED_PARAMETER(InputWidth);
-    MLAS_UNREFERENCED_PARAMETER(DilatedInputWidth);
-    MLAS_UNREFERENCED_PARAMETER(OutputCountLeftPad);
-    MLAS_UNREFERENCED_PARAMETER(OutputCount);
-    MLAS_UNREFERENCED_PARAMETER(OutputCountRightPad);
+    MlasPoolFloatKernelVector<MlasAveragePoolingExcludePad>(Input, Output, StrideWidth,
+        DilationWidth, InputStride, ActualKernelSize, KernelHeight, KernelWidth,
+        InputBase, InputWidth, DilatedInputWidth, OutputCountLeftPad, OutputCount,
+        OutputCountRightPad);
 }
 
 void
@@ -1767,20 +2399,10 @@ MlasPoolAverageIncludePadFloatKernel(
     size_t OutputCountRightPad
     )
 {
-    MLAS_UNREFERENCED_PARAMETER(Input);
-    MLAS_UNREFERENCED_PARAMETER(Output);
-    MLAS_UNREFERENCED_PARAMETER(StrideWidth);
-    MLAS_UNREFERENCED_PARAMETER(DilationWidth);
-    MLAS_UNREFERENCED_PARAMETER(InputStride);
-    MLAS_UNREFERENCED_PARAMETER(ActualKernelSize);
-    MLAS_UNREFERENCED_PARAMETER(KernelHeight);
-    MLAS_UNREFERENCED_PARAMETER(KernelWidth);
-    MLAS_UNREFERENCED_PARAMETER(InputBase);
-    MLAS_UNREFERENCED_PARAMETER(InputWidth);
-    MLAS_UNREFERENCED_PARAMETER(DilatedInputWidth);
-    MLAS_UNREFERENCED_PARAMETER(OutputCountLeftPad);
-    MLAS_UNREFERENCED_PARAMETER(OutputCount);
-    MLAS_UNREFERENCED_PARAMETER(OutputCountRightPad);
+    MlasPoolFloatKernelVector<MlasAveragePoolingIncludePad>(Input, Output, StrideWidth,
+        DilationWidth, InputStride, ActualKernelSize, KernelHeight, KernelWidth,
+        InputBase, InputWidth, DilatedInputWidth, OutputCountLeftPad, OutputCount,
+        OutputCountRightPad);
 }
 
 #endif
@@ -55,7 +55,7 @@ MlasExecuteThreaded(
     //
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic)
 #endif
     for (int32_t tid = 0; tid < Iterations; tid++) {
         ThreadedRoutine(Context, tid);
@@ -0,0 +1,470 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transpose.cpp
+
+Abstract:
+
+    This module implements the matrix transpose routines.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of elements processed by each thread of the transpose
+// routine before another thread is used.
+//
+
+#define MLAS_TRANSPOSE_THREAD_COMPLEXITY            (64 * 1024)
+
+//
+// Define the number of rows and columns of the blocks that are transposed at a
+// time. The rows of a block read from the input and the rows of the block
+// written to the output stay in the cache while the block is processed.
+//
+
+#define MLAS_TRANSPOSE_BLOCK_SIZE                   32
+
+//
+// Stores the parameters for a threaded transpose operation.
+//
+
+struct MLAS_TRANSPOSE_WORK_BLOCK {
+    const void* Input;
+    void* Output;
+    size_t BatchCount;
+    size_t M;
+    size_t N;
+    int32_t ThreadCount;
+};
+
+MLAS_FORCEINLINE
+void
+MlasTranspose4x4Block(
+    const uint32_t* Input,
+    size_t InputStride,
+    uint32_t* Output,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a 4x4 block of 32-bit elements.
+
+Arguments:
+
+    Input - Supplies the address of the first row of the input block.
+
+    InputStride - Supplies the number of elements between rows of the input.
+
+    Output - Supplies the address of the first row of the output block.
+
+    OutputStride - Supplies the number of elements between rows of the output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+    __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 0]);
+    __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 1]);
+    __m128i a2 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 2]);
+    __m128i a3 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 3]);
+
+    __m128i b0 = _mm_unpacklo_epi32(a0, a1);
+    __m128i b1 = _mm_unpackhi_epi32(a0, a1);
+    __m128i b2 = _mm_unpacklo_epi32(a2, a3);
+    __m128i b3 = _mm_unpackhi_epi32(a2, a3);
+
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 0], _mm_unpacklo_epi64(b0, b2));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 1], _mm_unpackhi_epi64(b0, b2));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 2], _mm_unpacklo_epi64(b1, b3));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 3], _mm_unpackhi_epi64(b1, b3));
+#elif defined(MLAS_NEON_INTRINSICS)
+    uint32x4_t a0 = vld1q_u32(&Input[InputStride * 0]);
+    uint32x4_t a1 = vld1q_u32(&Input[InputStride * 1]);
+    uint32x4_t a2 = vld1q_u32(&Input[InputStride * 2]);
+    uint32x4_t a3 = vld1q_u32(&Input[InputStride * 3]);
+
+    uint32x4x2_t b01 = vtrnq_u32(a0, a1);
+    uint32x4x2_t b23 = vtrnq_u32(a2, a3);
+
+    vst1q_u32(&Output[OutputStride * 0], vcombine_u32(vget_low_u32(b01.val[0]), vget_low_u32(b23.val[0])));
+    vst1q_u32(&Output[OutputStride * 1], vcombine_u32(vget_low_u32(b01.val[1]), vget_low_u32(b23.val[1])));
+    vst1q_u32(&Output[OutputStride * 2], vcombine_u32(vget_high_u32(b01.val[0]), vget_high_u32(b23.val[0])));
+    vst1q_u32(&Output[OutputStride * 3], vcombine_u32(vget_high_u32(b01.val[1]), vget_high_u32(b23.val[1])));
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasTranspose2x2Block(
+    const uint64_t* Input,
+    size_t InputStride,
+    uint64_t* Output,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a 2x2 block of 64-bit elements.
+
+Arguments:
+
+    Input - Supplies the address of the first row of the input block.
+
+    InputStride - Supplies the number of elements between rows of the input.
+
+    Output - Supplies the address of the first row of the output block.
+
+    OutputStride - Supplies the number of elements between rows of the output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+    __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 0]);
+    __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 1]);
+
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 0], _mm_unpacklo_epi64(a0, a1));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 1], _mm_unpackhi_epi64(a0, a1));
+#elif defined(MLAS_NEON_INTRINSICS)
+    uint64x2_t a0 = vld1q_u64(&Input[InputStride * 0]);
+    uint64x2_t a1 = vld1q_u64(&Input[InputStride * 1]);
+
+    vst1q_u64(&Output[OutputStride * 0], vcombine_u64(vget_low_u64(a0), vget_low_u64(a1)));
+    vst1q_u64(&Output[OutputStride * 1], vcombine_u64(vget_high_u64(a0), vget_high_u64(a1)));
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasTranspose4x4Block(
+    const uint64_t* Input,
+    size_t InputStride,
+    uint64_t* Output,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a 4x4 block of 64-bit elements.
+
+Arguments:
+
+    Input - Supplies the address of the first row of the input block.
+
+    InputStride - Supplies the number of elements between rows of the input.
+
+    Output - Supplies the address of the first row of the output block.
+
+    OutputStride - Supplies the number of elements between rows of the output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasTranspose2x2Block(&Input[0], InputStride, &Output[0], OutputStride);
+    MlasTranspose2x2Block(&Input[2], InputStride, &Output[OutputStride * 2], OutputStride);
+    MlasTranspose2x2Block(&Input[InputStride * 2], InputStride, &Output[2], OutputStride);
+    MlasTranspose2x2Block(&Input[InputStride * 2 + 2], InputStride, &Output[OutputStride * 2 + 2], OutputStride);
+}
+
+template<typename ElementType>
+void
+MlasTransposeRowBlock(
+    const ElementType* Input,
+    ElementType* Output,
+    size_t CountM,
+    size_t N,
+    size_t InputStride,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a block of rows of the input matrix to a block of
+    columns of the output matrix.
+
+Arguments:
+
+    Input - Supplies the address of the first row of the input block.
+
+    Output - Supplies the address of the first column of the output block.
+
+    CountM - Supplies the number of rows of the input block.
+
+    N - Supplies the number of columns of the input block.
+
+    InputStride - Supplies the number of elements between rows of the input.
+
+    OutputStride - Supplies the number of elements between rows of the output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < N; n += MLAS_TRANSPOSE_BLOCK_SIZE) {
+
+        const size_t CountN = std::min(N - n, size_t(MLAS_TRANSPOSE_BLOCK_SIZE));
+
+        const ElementType* s = Input + n;
+        ElementType* d = Output + n * OutputStride;
+
+        size_t m = 0;
+
+        for (; m + 4 <= CountM; m += 4) {
+
+            size_t c = 0;
+
+            for (; c + 4 <= CountN; c += 4) {
+                MlasTranspose4x4Block(&s[m * InputStride + c], InputStride, &d[c * OutputStride + m], OutputStride);
+            }
+
+            for (; c < CountN; c++) {
+                d[c * OutputStride + m + 0] = s[(m + 0) * InputStride + c];
+                d[c * OutputStride + m + 1] = s[(m + 1) * InputStride + c];
+                d[c * OutputStride + m + 2] = s[(m + 2) * InputStride + c];
+                d[c * OutputStride + m + 3] = s[(m + 3) * InputStride + c];
+            }
+        }
+
+        for (; m < CountM; m++) {
+            for (size_t c = 0; c < CountN; c++) {
+                d[c * OutputStride + m] = s[m * InputStride + c];
+            }
+        }
+    }
+}
+
+template<typename ElementType>
+void
+MlasTransposeThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    transpose operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_TRANSPOSE_WORK_BLOCK*)Context;
+
+    const size_t M = WorkBlock->M;
+    const size_t N = WorkBlock->N;
+
+    //
+    // Partition the operation along the blocks of rows of all the matrices.
+    //
+
+    const size_t BlocksPerMatrix = (M + MLAS_TRANSPOSE_BLOCK_SIZE - 1) / MLAS_TRANSPOSE_BLOCK_SIZE;
+
+    size_t Block;
+    size_t CountBlocks;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, WorkBlock->BatchCount * BlocksPerMatrix,
+        &Block, &CountBlocks);
+
+    while (CountBlocks > 0) {
+
+        const size_t Batch = Block / BlocksPerMatrix;
+        const size_t m = (Block % BlocksPerMatrix) * MLAS_TRANSPOSE_BLOCK_SIZE;
+        const size_t CountM = std::min(M - m, size_t(MLAS_TRANSPOSE_BLOCK_SIZE));
+
+        const ElementType* Input = (const ElementType*)WorkBlock->Input + Batch * M * N;
+        ElementType* Output = (ElementType*)WorkBlock->Output + Batch * M * N;
+
+        MlasTransposeRowBlock(Input + m * N, Output + m, CountM, N, N, M);
+
+        Block++;
+        CountBlocks--;
+    }
+}
+
+template<typename ElementType>
+void
+MlasTransposeOperation(
+    const ElementType* Input,
+    ElementType* Output,
+    size_t BatchCount,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic form of the transpose operation.
+
+Arguments:
+
+    See MlasTranspose.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_TRANSPOSE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.BatchCount = BatchCount;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // transpose operation. Limit the number of threads to the number of blocks
+    // of rows.
+    //
+
+    const double Complexity = double(BatchCount) * double(M) * double(N);
+
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_TRANSPOSE_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_TRANSPOSE_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    const size_t BlockCount = BatchCount * ((M + MLAS_TRANSPOSE_BLOCK_SIZE - 1) / MLAS_TRANSPOSE_BLOCK_SIZE);
+
+    if (size_t(TargetThreadCount) >= BlockCount) {
+        TargetThreadCount = int32_t(BlockCount);
+    }
+
+    if (TargetThreadCount == 0) {
+        return;
+    }
+
+    WorkBlock.ThreadCount = TargetThreadCount;
+
+    MlasExecuteThreaded(MlasTransposeThreaded<ElementType>, &WorkBlock, TargetThreadCount, ThreadPool);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    uint32_t* Output,
+    size_t BatchCount,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a batch of matrices of 32-bit elements.
+
+Arguments:
+
+    Input - Supplies the input buffer, which holds BatchCount matrices of M
+        rows and N columns.
+
+    Output - Supplies the output buffer, which receives BatchCount matrices of
+        N rows and M columns.
+
+    BatchCount - Supplies the number of matrices to transpose.
+
+    M - Supplies the number of rows of each input matrix.
+
+    N - Supplies the number of columns of each input matrix.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasTransposeOperation(Input, Output, BatchCount, M, N, ThreadPool);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint64_t* Input,
+    uint64_t* Output,
+    size_t BatchCount,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a batch of matrices of 64-bit elements.
+
+Arguments:
+
+    Input - Supplies the input buffer, which holds BatchCount matrices of M
+        rows and N columns.
+
+    Output - Supplies the output buffer, which receives BatchCount matrices of
+        N rows and M columns.
+
+    BatchCount - Supplies the number of matrices to transpose.
+
+    M - Supplies the number of rows of each input matrix.
+
+    N - Supplies the number of columns of each input matrix.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasTransposeOperation(Input, Output, BatchCount, M, N, ThreadPool);
+}
@@ -263,6 +263,228 @@ static NodeArg* GetOrCreateMaskIndex(
   return output;
 }
 
+// Returns the pattern of the unidirectional self attention exported from GPT-2, where the scores are masked with a
+// causal (lower triangular) matrix as w * causal - 10000 * (1 - causal) and Q, K and V come from one MatMul.
+static std::vector<optimizer_utils::PatternNode> GetUnidirectionalAttentionPattern() {
+  return {
+      {"qkv_matmul", "MatMul", {1, 9}, {"input", "qkv_weights"}},
+      {"qkv_add", "Add", {7}, {"qkv_matmul", "qkv_bias"}, true},
+      {"split", "Split", {2, 11}, {"qkv_add"}},
+      {"q_reshape", "Reshape", {5}, {{"split", 0}, "q_shape"}},
+      {"q_transpose", "Transpose", {1}, {"q_reshape"}},
+      {"k_reshape", "Reshape", {5}, {{"split", 1}, "k_shape"}},
+      {"k_transpose", "Transpose", {1}, {"k_reshape"}},
+      {"v_reshape", "Reshape", {5}, {{"split", 2}, "v_shape"}},
+      {"v_transpose", "Transpose", {1}, {"v_reshape"}},
+      {"qk_matmul", "MatMul", {1, 9}, {"q_transpose", "k_transpose"}},
+      {"qk_div", "Div", {7}, {"qk_matmul", "head_size_sqrt"}},
+      {"mask_mul", "Mul", {7}, {"qk_div", "causal"}, true},
+      {"mask_sub", "Sub", {7}, {"one", "causal"}},
+      {"mask_scale", "Mul", {7}, {"mask_sub", "mask_value"}, true},
+      {"masked", "Sub", {7}, {"mask_mul", "mask_scale"}},
+      {"softmax", "Softmax", {1, 11}, {"masked"}},
+      {"qkv_matmul_2", "MatMul", {1, 9}, {"softmax", "v_transpose"}},
+      {"transpose", "Transpose", {1}, {"qkv_matmul_2"}},
+      {"reshape", "Reshape", {5}, {"transpose", "output_shape"}}};
+}
+
+static bool IsTransposeWithPerm(const Node& transpose, const std::vector<int64_t>& expected_perm) {
+  std::vector<int64_t> perm;
+  return graph_utils::GetRepeatedNodeAttributeValues(transpose, "perm", perm) && perm == expected_perm;
+}
+
+// Gets the number of heads from the shape (0, 0, N, H) given to the Reshape of Q, K or V. The shape is either a
+// constant, or a Concat whose third input is a constant as exported from the dynamic view in PyTorch.
+static int64_t GetNumHeads(const Graph& graph, const NodeArg& shape, const Node& reshape) {
+  std::vector<int64_t> shape_values;
+  if (optimizer_utils::AppendTensorFromInitializer(graph, shape, shape_values)) {
+    return shape_values.size() == 4 ? shape_values[2] : -1;
+  }
+
+  const Node* concat = graph_utils::GetInputNode(reshape, 1);
+  if (concat == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*concat, "Concat", {4, 11}) ||
+      concat->InputDefs().size() != 4) {
+    return -1;
+  }
+  const NodeArg* num_heads = concat->InputDefs()[2];
+  const Node* unsqueeze = graph_utils::GetInputNode(*concat, 2);
+  if (unsqueeze != nullptr && graph_utils::IsSupportedOptypeVersionAndDomain(*unsqueeze, "Unsqueeze", {1, 11})) {
+    num_heads = unsqueeze->InputDefs()[0];
+  }
+  if (!optimizer_utils::AppendTensorFromInitializer(graph, *num_heads, shape_values) || shape_values.size() != 1) {
+    return -1;
+  }
+  return shape_values[0];
+}
+
+static bool IsLowerTriangular(const ONNX_NAMESPACE::TensorProto& tensor, const Path& model_path) {
+  if (tensor.data_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT || tensor.dims_size() != 4 ||
+      tensor.dims(0) != 1 || tensor.dims(1) != 1 || tensor.dims(2) != tensor.dims(3)) {
+    return false;
+  }
+  Initializer values{tensor, model_path};
+  const int64_t size = tensor.dims(2);
+  for (int64_t i = 0; i < size; i++) {
+    for (int64_t j = 0; j < size; j++) {
+      if (values.data<float>()[i * size + j] != (j <= i ? 1.0f : 0.0f)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// The causal mask is a constant lower triangular matrix, or the Slice of one that GPT-2 takes for the sequence length.
+// The Slice of a mask of n_ctx tokens starts at 0 when there are no past states, which the pattern excludes.
+static bool IsCausalMask(const Graph& graph, const NodeArg& causal, const Node& mask_sub) {
+  const auto* tensor = graph_utils::GetConstantInitializer(graph, causal.Name());
+  if (tensor != nullptr) {
+    return IsLowerTriangular(*tensor, graph.ModelPath());
+  }
+
+  const Node* slice = graph_utils::GetInputNode(mask_sub, 1);
+  if (slice == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*slice, "Slice", {10, 11})) {
+    return false;
+  }
+  tensor = graph_utils::GetConstantInitializer(graph, slice->InputDefs()[0]->Name());
+  return tensor != nullptr && IsLowerTriangular(*tensor, graph.ModelPath());
+}
+
+// Removes the nodes that only computed inputs of a fused subgraph, like the shapes given to Reshape.
+static void RemoveUnusedProducers(Graph& graph, std::vector<NodeIndex> producers) {
+  while (!producers.empty()) {
+    Node* node = graph.GetNode(producers.back());
+    producers.pop_back();
+    if (node == nullptr || node->GetOutputEdgesCount() != 0 || !graph.GetNodeOutputsInGraphOutputs(*node).empty()) {
+      continue;
+    }
+    for (auto it = node->InputNodesBegin(); it != node->InputNodesEnd(); ++it) {
+      producers.push_back(it->Index());
+    }
+    graph.RemoveNode(node->Index());
+  }
+}
+
+/** Fuse the unidirectional attention of GPT-2 ending at the Reshape node `reshape`:
+                  [Input](BxSxW)
+                        |
+                MatMul [Weights](Wx3W) --> Add [Bias](3W) --> Split (axis=-1)
+                   /                         |                         \
+   Reshape(0,0,N,H)-Transpose(0,2,1,3)  Reshape-Transpose(0,2,3,1)  Reshape-Transpose(0,2,1,3)
+                   \                         /                          |
+                     qk_MatMul --> Div(sqrt(H)) --> Mul(causal)           |
+                                                      |                  |
+                                Sub <-- Mul(10000, Sub(1, causal))       |
+                                 |                                       |
+                              Softmax --------------------------> MatMul
+                                                                         |
+                                                Reshape(0,0,W) <-- Transpose(0,2,1,3)
+After Fusion:
+  [Input] --> Attention(unidirectional=1) <-- [Weights], [Bias]
+The weights and bias are used as is, since Split already lays Q, K and V out like the Attention kernel expects.
+Only the CPU kernel supports the unidirectional attribute and running without mask_index.
+*/
+static bool FuseUnidirectionalSubGraph(Node& reshape, Graph& graph, const logging::Logger& logger) {
+  if (reshape.GetExecutionProviderType() != kCpuExecutionProvider ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(reshape, "Reshape", {5})) {
+    return false;
+  }
+
+  static const auto pattern = GetUnidirectionalAttentionPattern();
+  optimizer_utils::PatternMatch match;
+  if (!optimizer_utils::MatchPattern(graph, reshape, pattern, match)) {
+    return false;
+  }
+
+  NodeArg& input = *match.values["input"];
+  NodeArg& qkv_weights = *match.values["qkv_weights"];
+  NodeArg& qkv_bias = *match.values["qkv_bias"];
+  if (!optimizer_utils::IsShapeKnownOnAllDims(qkv_weights, 2) ||
+      !graph_utils::IsInitializer(graph, qkv_weights.Name(), true) ||
+      !graph_utils::IsInitializer(graph, qkv_bias.Name(), true) ||
+      input.Shape() == nullptr || input.Shape()->dim_size() != 3) {
+    DEBUG_LOG("Unidirectional attention expects 3D input and constant weights and bias");
+    return false;
+  }
+  const int64_t hidden_size = qkv_weights.Shape()->dim(0).dim_value();
+  if (!optimizer_utils::ValidateShape(qkv_weights, {hidden_size, 3 * hidden_size}) ||
+      !optimizer_utils::ValidateShape(qkv_bias, {3 * hidden_size})) {
+    DEBUG_LOG("Unidirectional attention weights or bias shape not expected");
+    return false;
+  }
+
+  // Q, K and V are split evenly on the last axis
+  const Node& split = *match.nodes["split"];
+  std::vector<int64_t> split_sizes;
+  graph_utils::GetRepeatedNodeAttributeValues(split, "split", split_sizes);
+  if (split.OutputDefs().size() != 3 ||
+      (!optimizer_utils::IsAttributeWithExpectedValue(split, "axis", static_cast<int64_t>(-1)) &&
+       !optimizer_utils::IsAttributeWithExpectedValue(split, "axis", static_cast<int64_t>(2))) ||
+      (!split_sizes.empty() && split_sizes != std::vector<int64_t>(3, hidden_size))) {
+    DEBUG_LOG("Split not expected");
+    return false;
+  }
+
+  const std::vector<int64_t> heads_perm{0, 2, 1, 3};
+  if (!IsTransposeWithPerm(*match.nodes["q_transpose"], heads_perm) ||
+      !IsTransposeWithPerm(*match.nodes["k_transpose"], {0, 2, 3, 1}) ||
+      !IsTransposeWithPerm(*match.nodes["v_transpose"], heads_perm) ||
+      !IsTransposeWithPerm(*match.nodes["transpose"], heads_perm)) {
+    DEBUG_LOG("Transpose perm not expected");
+    return false;
+  }
+
+  const int64_t num_heads = GetNumHeads(graph, *match.values["q_shape"], *match.nodes["q_reshape"]);
+  if (num_heads <= 0 || hidden_size % num_heads != 0 ||
+      GetNumHeads(graph, *match.values["k_shape"], *match.nodes["k_reshape"]) != num_heads ||
+      GetNumHeads(graph, *match.values["v_shape"], *match.nodes["v_reshape"]) != num_heads) {
+    DEBUG_LOG("Number of heads not found");
+    return false;
+  }
+
+  const float head_size_sqrt = std::sqrt(static_cast<float>(hidden_size / num_heads));
+  if (!optimizer_utils::IsInitializerWithExpectedValue(graph, *match.values["head_size_sqrt"], head_size_sqrt, true) ||
+      !optimizer_utils::IsInitializerWithExpectedValue(graph, *match.values["one"], 1.0f, true) ||
+      !optimizer_utils::IsInitializerWithExpectedValue(graph, *match.values["mask_value"], 10000.0f, true) ||
+      !IsCausalMask(graph, *match.values["causal"], *match.nodes["mask_sub"])) {
+    DEBUG_LOG("Causal mask not expected");
+    return false;
+  }
+
+  const Node& softmax = *match.nodes["softmax"];
+  if (!optimizer_utils::IsAttributeWithExpectedValue(softmax, "axis", static_cast<int64_t>(3)) &&
+      !optimizer_utils::IsAttributeWithExpectedValue(softmax, "axis", static_cast<int64_t>(-1))) {
+    DEBUG_LOG("Softmax axis not expected");
+    return false;
+  }
+
+  // the shapes and the causal mask are computed by nodes that are not needed after the fusion
+  std::vector<NodeIndex> producers;
+  for (const auto& entry : match.nodes) {
+    for (auto it = entry.second->InputNodesBegin(); it != entry.second->InputNodesEnd(); ++it) {
+      producers.push_back(it->Index());
+    }
+  }
+
+  Node& attention_node = graph.AddNode(
+      graph.GenerateNodeName("Attention"),
+      "Attention",
+      "Fused unidirectional Attention subgraphs ",
+      {&input, &qkv_weights, &qkv_bias},
+      {},
+      nullptr,
+      kMSDomain);
+  attention_node.AddAttribute("num_heads", num_heads);
+  attention_node.AddAttribute("unidirectional", static_cast<int64_t>(1));
+  attention_node.SetExecutionProviderType(reshape.GetExecutionProviderType());
+
+  optimizer_utils::FinalizePatternFusion(graph, match, reshape, attention_node);
+  RemoveUnusedProducers(graph, producers);
+
+  DEBUG_LOG("Fused a unidirectional attention node.");
+  return true;
+}
+
 Status AttentionFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
   GraphViewer graph_viewer(graph);
   const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
@@ -279,6 +501,13 @@ Status AttentionFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     Node& node = *p_node;
     ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
 
+    if (graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) &&
+        FuseUnidirectionalSubGraph(node, graph, logger)) {
+      fused_count++;
+      modified = true;
+      continue;
+    }
+
     if (node.GetOutputEdgesCount() == 4 &&
         graph_utils::IsSupportedOptypeVersionAndDomain(node, "LayerNormalization", {1}, kOnnxDomain) &&
         graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
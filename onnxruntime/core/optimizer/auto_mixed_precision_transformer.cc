@@ -0,0 +1,202 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/auto_mixed_precision_transformer.h"
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+
+#include "core/framework/data_types.h"
+#include "core/framework/kernel_registry.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/optimizer/initializer.h"
+#include "core/util/math.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+AutoMixedPrecisionTransformer::AutoMixedPrecisionTransformer(const KernelRegistryManager& kernel_registry_manager,
+                                                             const std::unordered_set<std::string>& allow_ops,
+                                                             const std::unordered_set<std::string>& deny_ops)
+    : GraphTransformer("AutoMixedPrecisionTransformer", {kCudaExecutionProvider}),
+      kernel_registry_manager_(kernel_registry_manager),
+      allow_ops_(allow_ops.empty() ? DefaultAllowOps() : allow_ops),
+      deny_ops_(deny_ops.empty() ? DefaultDenyOps() : deny_ops) {
+}
+
+const std::unordered_set<std::string>& AutoMixedPrecisionTransformer::DefaultAllowOps() {
+  // the compute bound ops, which gain from the tensor cores, and the ops moving data between them, so the values
+  // flowing from one to the next stay in float16. all their float inputs share the type of the computation, unlike
+  // e.g. the scales of Resize or the ratio of Dropout.
+  static const std::unordered_set<std::string> allow_ops{
+      "Conv", "ConvTranspose", "MatMul", "Gemm", "FusedConv", "FusedGemm", "FusedMatMul", "Attention",
+      "Add", "Sub", "Mul", "Div", "Relu", "LeakyRelu", "Sigmoid", "Tanh", "Erf", "Gelu", "FastGelu", "BiasGelu",
+      "MaxPool", "AveragePool", "GlobalAveragePool", "GlobalMaxPool", "BatchNormalization", "Concat", "Split",
+      "Slice", "Transpose", "Reshape", "Flatten", "Squeeze", "Unsqueeze", "Identity", "Pad", "Tile", "Expand",
+      "Gather"};
+  return allow_ops;
+}
+
+const std::unordered_set<std::string>& AutoMixedPrecisionTransformer::DefaultDenyOps() {
+  static const std::unordered_set<std::string> deny_ops{
+      "Softmax", "LogSoftmax", "LayerNormalization", "SkipLayerNormalization", "EmbedLayerNormalization",
+      "InstanceNormalization", "LpNormalization", "ReduceMean", "ReduceSum", "ReduceSumSquare", "ReduceL1",
+      "ReduceL2", "ReduceLogSum", "ReduceLogSumExp", "ReduceProd", "Exp", "Log", "Pow", "CumSum"};
+  return deny_ops;
+}
+
+static bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() && type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+bool AutoMixedPrecisionTransformer::HasFloat16Kernel(const Node& node) const {
+  if (node.Op() == nullptr) {
+    return false;
+  }
+  const int version = node.Op()->since_version();
+  const auto key = KernelRegistry::GetMapKey(node.OpType(), node.Domain(), kCudaExecutionProvider);
+  const MLDataType float16_type = DataTypeImpl::GetTensorType<MLFloat16>();
+  for (const auto* registry : kernel_registry_manager_.GetKernelRegistriesByProviderType(kCudaExecutionProvider)) {
+    const auto range = registry->GetKernelCreateMap().equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+      const KernelDef& kernel_def = *it->second.kernel_def;
+      int start, end;
+      kernel_def.SinceVersion(&start, &end);
+      if (version < start || version > end) {
+        continue;
+      }
+      for (const auto& constraint : kernel_def.TypeConstraints()) {
+        if (std::find(constraint.second.begin(), constraint.second.end(), float16_type) != constraint.second.end()) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+bool AutoMixedPrecisionTransformer::CanConvert(const Node& node) const {
+  if (node.GetExecutionProviderType() != kCudaExecutionProvider || node.ContainsSubgraph() ||
+      allow_ops_.count(node.OpType()) == 0 || deny_ops_.count(node.OpType()) != 0) {
+    return false;
+  }
+
+  bool has_float_arg = false;
+  bool has_unknown_type = false;
+  auto check_args = [&has_float_arg, &has_unknown_type](ConstPointerContainer<std::vector<NodeArg*>> args) {
+    for (const NodeArg* arg : args) {
+      if (arg->Exists()) {
+        // the type of every value has to be known to tell the float ones
+        has_unknown_type = has_unknown_type || arg->TypeAsProto() == nullptr;
+        has_float_arg = has_float_arg || IsFloatTensor(*arg);
+      }
+    }
+  };
+  check_args(node.InputDefs());
+  check_args(node.OutputDefs());
+  return has_float_arg && !has_unknown_type && HasFloat16Kernel(node);
+}
+
+static NodeArg& AddFloat16Arg(Graph& graph, const NodeArg& arg) {
+  TypeProto float16_type(*arg.TypeAsProto());
+  float16_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT16);
+  return graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(arg.Name() + "_fp16"), &float16_type);
+}
+
+static void AddCast(Graph& graph, NodeArg& input, NodeArg& output, TensorProto_DataType to) {
+  Node& cast = graph.AddNode(graph.GenerateNodeName(output.Name() + "_cast"), "Cast",
+                             "cast inserted by the auto mixed precision", {&input}, {&output});
+  cast.AddAttribute("to", static_cast<int64_t>(to));
+  cast.SetExecutionProviderType(kCudaExecutionProvider);
+}
+
+Status AutoMixedPrecisionTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                                const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::vector<NodeIndex> converted_nodes;
+  std::unordered_set<NodeIndex> converted;
+  for (auto index : order) {
+    const Node* node = graph.GetNode(index);
+    if (node != nullptr && CanConvert(*node)) {
+      converted_nodes.push_back(index);
+      converted.insert(index);
+    }
+  }
+
+  // the values which have to stay available in float: read by other nodes, including from their subgraphs, or
+  // graph outputs
+  std::unordered_set<const NodeArg*> read_as_float(graph.GetOutputs().begin(), graph.GetOutputs().end());
+  for (const auto& node : graph.Nodes()) {
+    if (converted.count(node.Index()) == 0) {
+      read_as_float.insert(node.InputDefs().begin(), node.InputDefs().end());
+      read_as_float.insert(node.ImplicitInputDefs().begin(), node.ImplicitInputDefs().end());
+    }
+  }
+
+  // the float16 value standing for each float value read or produced by the converted nodes
+  std::unordered_map<const NodeArg*, NodeArg*> float16_args;
+  for (auto index : converted_nodes) {
+    Node& node = *graph.GetNode(index);
+    std::map<const NodeArg*, NodeArg*> replacement_defs;
+
+    for (NodeArg* input : node.MutableInputDefs()) {
+      if (!input->Exists() || !IsFloatTensor(*input)) {
+        continue;
+      }
+      auto it = float16_args.find(input);
+      if (it == float16_args.end()) {
+        NodeArg& float16_input = AddFloat16Arg(graph, *input);
+        const TensorProto* initializer = graph_utils::GetConstantInitializer(graph, input->Name(), false);
+        if (initializer != nullptr) {
+          // converted once: the float one is removed by Graph::Resolve if no other node reads it
+          Initializer float_values{*initializer, graph.ModelPath()};
+          TensorProto float16_initializer;
+          float16_initializer.set_name(float16_input.Name());
+          float16_initializer.set_data_type(TensorProto_DataType_FLOAT16);
+          float16_initializer.mutable_dims()->CopyFrom(initializer->dims());
+          std::vector<uint16_t> float16_values(float_values.size());
+          const float* values = float_values.data<float>();
+          for (size_t i = 0; i < float16_values.size(); ++i) {
+            float16_values[i] = math::floatToHalf(values[i]);
+          }
+          float16_initializer.set_raw_data(float16_values.data(), float16_values.size() * sizeof(uint16_t));
+          graph.AddInitializedTensor(float16_initializer);
+        } else {
+          AddCast(graph, *input, float16_input, TensorProto_DataType_FLOAT16);
+        }
+        it = float16_args.emplace(input, &float16_input).first;
+      }
+      replacement_defs[input] = it->second;
+    }
+
+    for (NodeArg* output : node.MutableOutputDefs()) {
+      if (!output->Exists() || !IsFloatTensor(*output)) {
+        continue;
+      }
+      NodeArg& float16_output = AddFloat16Arg(graph, *output);
+      if (read_as_float.count(output) != 0) {
+        AddCast(graph, float16_output, *output, TensorProto_DataType_FLOAT);
+      }
+      float16_args[output] = &float16_output;
+      replacement_defs[output] = &float16_output;
+    }
+
+    node.ReplaceDefs(replacement_defs);
+    modified = true;
+  }
+
+  if (!converted_nodes.empty()) {
+    LOGS(logger, INFO) << "Converted " << converted_nodes.size() << " nodes to float16 in graph level "
+                       << graph_level;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
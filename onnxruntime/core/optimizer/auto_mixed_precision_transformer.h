@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_set>
+
+#include "core/framework/kernel_registry_manager.h"
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class AutoMixedPrecisionTransformer
+
+Runs the float nodes assigned to the CUDA execution provider in float16, for the tensor cores. It applies after the
+graph partitioning, to the nodes whose op is in the allow list and not in the deny list, and which the CUDA execution
+provider has a float16 kernel for. All their float inputs and outputs become float16:
+  - a float16 copy of each float initializer they read is added; Graph::Resolve drops the float one once unused.
+  - a Cast to float16 is inserted once for each other value read by converted nodes.
+  - a Cast back to float is inserted once for each value a converted node produces that is also read by other nodes
+    or is a graph output, so the graph inputs and outputs keep their types.
+The ops with large reductions or a wide output range (Softmax, the normalizations, the reductions, Exp, Log, Pow)
+are in the default deny list and stay in float.
+*/
+class AutoMixedPrecisionTransformer : public GraphTransformer {
+ public:
+  // empty allow_ops or deny_ops stand for the default lists
+  AutoMixedPrecisionTransformer(const KernelRegistryManager& kernel_registry_manager,
+                                const std::unordered_set<std::string>& allow_ops = {},
+                                const std::unordered_set<std::string>& deny_ops = {});
+
+  static const std::unordered_set<std::string>& DefaultAllowOps();
+  static const std::unordered_set<std::string>& DefaultDenyOps();
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  bool CanConvert(const Node& node) const;
+  bool HasFloat16Kernel(const Node& node) const;
+
+  const KernelRegistryManager& kernel_registry_manager_;
+  std::unordered_set<std::string> allow_ops_;
+  std::unordered_set<std::string> deny_ops_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/common_subexpression_elimination.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Ops whose outputs differ between two nodes with the same inputs and attributes.
+const std::unordered_set<std::string> kNondeterministicOps = {"RandomNormal", "RandomUniform", "RandomNormalLike",
+                                                             "RandomUniformLike", "Multinomial", "Dropout",
+                                                             "TrainableDropout"};
+
+bool IsCandidate(const Node& node) {
+  const auto& domain = node.Domain();
+  if ((domain != kOnnxDomain && domain != kOnnxDomainAlias && domain != kMSDomain) ||
+      kNondeterministicOps.count(node.OpType()) != 0 || node.ContainsSubgraph() || node.OutputDefs().empty()) {
+    return false;
+  }
+  return true;
+}
+
+// Key that is the same for two nodes if and only if they compute the same outputs.
+std::string ComputeKey(const Node& node) {
+  std::string key = node.Domain() + '\n' + node.OpType() + '\n' + node.GetExecutionProviderType() + '\n';
+  for (const auto* input_def : node.InputDefs()) {
+    key += input_def->Exists() ? input_def->Name() : std::string();
+    key += '\n';
+  }
+  key += std::to_string(node.OutputDefs().size()) + '\n';
+
+  std::vector<const AttributeProto*> attributes;
+  for (const auto& attribute : node.GetAttributes()) {
+    attributes.push_back(&attribute.second);
+  }
+  std::sort(attributes.begin(), attributes.end(),
+            [](const AttributeProto* a, const AttributeProto* b) { return a->name() < b->name(); });
+  for (const auto* attribute : attributes) {
+    key += attribute->SerializeAsString();
+    key += '\n';
+  }
+  return key;
+}
+
+// A duplicate can be removed unless its outputs are graph outputs or are used by a subgraph, whose names we can't
+// safely rewrite.
+bool CanRemove(const Graph& graph, const Node& duplicate, const Node& original) {
+  if (!graph.GetNodeOutputsInGraphOutputs(duplicate).empty()) {
+    return false;
+  }
+  for (auto it = duplicate.OutputEdgesBegin(); it != duplicate.OutputEdgesEnd(); ++it) {
+    if (static_cast<size_t>(it->GetDstArgIndex()) >= it->GetNode().InputDefs().size()) {
+      return false;
+    }
+  }
+  // an output the original doesn't produce can't be replaced
+  const auto& original_outputs = original.OutputDefs();
+  const auto& duplicate_outputs = duplicate.OutputDefs();
+  for (size_t i = 0; i < duplicate_outputs.size(); ++i) {
+    if (duplicate_outputs[i]->Exists() && !original_outputs[i]->Exists()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                                 const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::unordered_map<std::string, NodeIndex> first_node_by_key;
+  int removed_count = 0;
+  for (auto node_index : node_topology_list) {
+    auto* node = graph.GetNode(node_index);
+    if (node == nullptr) {
+      continue;
+    }
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+
+    if (!IsCandidate(*node) || !graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    auto result = first_node_by_key.emplace(ComputeKey(*node), node_index);
+    if (result.second) {
+      continue;
+    }
+
+    auto& original = *graph.GetNode(result.first->second);
+    if (!CanRemove(graph, *node, original)) {
+      continue;
+    }
+
+    for (size_t i = 0; i < node->OutputDefs().size(); ++i) {
+      if (node->OutputDefs()[i]->Exists()) {
+        graph_utils::ReplaceDownstreamNodeInput(graph, *node, static_cast<int>(i), original, static_cast<int>(i));
+      }
+    }
+    graph.RemoveNode(node_index);
+
+    removed_count++;
+    modified = true;
+  }
+
+  LOGS(logger, INFO) << "Common subexpression elimination removed " << removed_count << " nodes";
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
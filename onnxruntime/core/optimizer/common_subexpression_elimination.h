@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class CommonSubexpressionElimination
+
+Merges nodes that compute the same value: nodes with the same op type, domain, execution provider, attributes and
+input NodeArgs. The consumers of a duplicate are moved to the outputs of the first such node in topological order and
+the duplicate is removed. As the inputs of a node are already merged when it's visited, whole chains of duplicates,
+e.g. the Shape -> Gather -> Unsqueeze chains repeated by every layer of a transformer model, collapse in a single pass.
+
+Nondeterministic ops such as RandomNormal, ops from custom domains, nodes with subgraphs and nodes producing graph
+outputs are left alone.
+*/
+class CommonSubexpressionElimination : public GraphTransformer {
+ public:
+  CommonSubexpressionElimination(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("CommonSubexpressionElimination", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/constant_folding.h"
+
+#include <algorithm>
+#include <map>
+
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/optimizer_execution_frame.h"
 #include "core/framework/op_kernel.h"
@@ -11,10 +15,106 @@ using namespace onnxruntime::common;
 
 namespace onnxruntime {
 
+namespace {
+
+// Size of an input of a folded node, either a constant initializer or a value computed by another folded node.
+size_t GetInputSizeInBytes(const Graph& graph, const std::unordered_map<std::string, OrtValue>& values,
+                           const NodeArg& input_def) {
+  auto value = values.find(input_def.Name());
+  if (value != values.end()) {
+    return value->second.IsTensor() ? value->second.Get<Tensor>().SizeInBytes() : 0;
+  }
+  const ONNX_NAMESPACE::TensorProto* tensor_proto = nullptr;
+  size_t size = 0;
+  if (graph.GetInitializedTensor(input_def.Name(), tensor_proto) &&
+      !utils::GetSizeInBytesFromTensorProto<0>(*tensor_proto, &size).IsOK()) {
+    size = 0;
+  }
+  return size;
+}
+
+// Replaces the uses of constant initializers that have the same type, shape and bytes as another one with that one.
+// The initializers left unused are removed by Graph::Resolve.
+int DeduplicateInitializers(Graph& graph) {
+  // group by type and shape first, so that only the initializers that may be equal are compared
+  std::map<std::string, std::vector<std::string>> candidates;
+  for (const auto& entry : graph.GetAllInitializedTensors()) {
+    const auto& tensor_proto = *entry.second;
+    if (tensor_proto.data_location() == ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL ||
+        graph_utils::GetConstantInitializer(graph, entry.first, false) == nullptr) {
+      continue;
+    }
+    std::string key = std::to_string(tensor_proto.data_type());
+    for (auto dim : tensor_proto.dims()) {
+      key += ',' + std::to_string(dim);
+    }
+    candidates[key].push_back(entry.first);
+  }
+
+  std::unordered_map<std::string, NodeArg*> replacements;
+  for (auto& entry : candidates) {
+    auto& names = entry.second;
+    if (names.size() < 2) {
+      continue;
+    }
+    std::sort(names.begin(), names.end());
+
+    // the contents of the initializers kept so far, without their names
+    using Contents = std::pair<std::string, const std::string*>;
+    std::vector<Contents> kept;
+    for (const auto& name : names) {
+      ONNX_NAMESPACE::TensorProto contents = *graph.GetAllInitializedTensors().at(name);
+      contents.clear_name();
+      std::string bytes = contents.SerializeAsString();
+      auto match = std::find_if(kept.begin(), kept.end(), [&bytes](const Contents& k) { return k.first == bytes; });
+      if (match == kept.end()) {
+        kept.emplace_back(std::move(bytes), &name);
+      } else {
+        replacements[name] = graph.GetNodeArg(*match->second);
+      }
+    }
+  }
+  if (replacements.empty()) {
+    return 0;
+  }
+
+  // graph outputs and values read by subgraphs keep their initializer
+  for (const auto* output : graph.GetOutputs()) {
+    replacements.erase(output->Name());
+  }
+  for (const auto& node : graph.Nodes()) {
+    for (const auto* implicit_input : node.ImplicitInputDefs()) {
+      replacements.erase(implicit_input->Name());
+    }
+  }
+
+  int replaced_count = 0;
+  for (auto& node : graph.Nodes()) {
+    auto& input_defs = node.MutableInputDefs();
+    for (size_t i = 0; i < input_defs.size(); ++i) {
+      auto replacement = replacements.find(input_defs[i]->Name());
+      if (replacement != replacements.end() && replacement->second != nullptr) {
+        graph_utils::ReplaceNodeInput(node, static_cast<int>(i), *replacement->second);
+        replaced_count++;
+      }
+    }
+  }
+  return replaced_count;
+}
+
+}  // namespace
+
 Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
   GraphViewer graph_viewer(graph);
   auto& order = graph_viewer.GetNodesInTopologicalOrder();
 
+  // the nodes to fold, in topological order, and the values they compute
+  std::vector<Node*> nodes_to_fold;
+  std::unordered_map<std::string, NodeIndex> folded_value_producers;
+  InitializedTensorSet constant_inputs;
+  // EPs of the nodes that are run with the CPU EP for folding
+  std::unordered_map<NodeIndex, std::string> overridden_eps;
+
   for (NodeIndex i : order) {
     auto* node = graph.GetNode(i);
     if (!node) {
@@ -23,8 +123,6 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
 
     ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
 
-    InitializedTensorSet constant_inputs;
-
     // we currently constant fold using the CPU EP only.
     // if the node is assigned to a different EP we can run it if it's an ONNX op as we have CPU based implementations
     // for all ONNX ops. if it's from a different domain we can't.
@@ -42,76 +140,197 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         // constant folding does not support executing a node that includes subgraphs (control flow operators,
         // such as If/Loop/Scan, fall into this category). individual nodes in the subgraph will be processed
         // by the Recurse call above
-        node->ContainsSubgraph() ||
-        !graph_utils::AllNodeInputsAreConstant(graph, *node, constant_inputs)) {
+        node->ContainsSubgraph()) {
       continue;
     }
 
-    // override the EP while setting up OptimizerExecutionFrame::Info so that it will use the CPU kernel for Compute.
-    if (!cpu_ep) {
-      node->SetExecutionProviderType(kCpuExecutionProvider);
+    // every input is a constant initializer or computed by a node that is folded as well
+    InitializedTensorSet node_constant_inputs;
+    bool all_inputs_constant = true;
+    for (const auto* input_def : node->InputDefs()) {
+      if (!input_def->Exists() || folded_value_producers.count(input_def->Name()) != 0) {
+        continue;
+      }
+      const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, input_def->Name());
+      if (tensor_proto == nullptr) {
+        all_inputs_constant = false;
+        break;
+      }
+      node_constant_inputs[input_def->Name()] = tensor_proto;
+    }
+    if (!all_inputs_constant) {
+      continue;
     }
 
-    // Create execution frame for executing constant nodes.
-    OptimizerExecutionFrame::Info info({node}, constant_inputs);
-
-    // undo the EP change in case something fails prior to node removal
+    constant_inputs.insert(node_constant_inputs.begin(), node_constant_inputs.end());
+    for (const auto* output_def : node->OutputDefs()) {
+      if (output_def->Exists()) {
+        folded_value_producers[output_def->Name()] = node->Index();
+      }
+    }
     if (!cpu_ep) {
-      node->SetExecutionProviderType(ep_type);
+      overridden_eps[node->Index()] = ep_type;
     }
+    nodes_to_fold.push_back(node);
+  }
 
-    std::vector<int> fetch_mlvalue_idxs;
+  if (!nodes_to_fold.empty()) {
+    ORT_RETURN_IF_ERROR(FoldNodes(graph, nodes_to_fold, folded_value_producers, constant_inputs, overridden_eps,
+                                  modified, logger));
+  }
+
+  const int deduplicated_count = DeduplicateInitializers(graph);
+  if (deduplicated_count > 0) {
+    LOGS(logger, INFO) << "Replaced " << deduplicated_count << " uses of duplicated initializers";
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+Status ConstantFolding::FoldNodes(Graph& graph, const std::vector<Node*>& nodes_to_fold,
+                                  const std::unordered_map<std::string, NodeIndex>& folded_value_producers,
+                                  const InitializedTensorSet& constant_inputs,
+                                  const std::unordered_map<NodeIndex, std::string>& overridden_eps, bool& modified,
+                                  const logging::Logger& logger) const {
+  // override the EP while setting up OptimizerExecutionFrame::Info so that it will use the CPU kernel for Compute.
+  for (const auto& entry : overridden_eps) {
+    graph.GetNode(entry.first)->SetExecutionProviderType(kCpuExecutionProvider);
+  }
+
+  // Create execution frame for executing constant nodes.
+  const std::vector<const Node*> nodes(nodes_to_fold.begin(), nodes_to_fold.end());
+  OptimizerExecutionFrame::Info info(nodes, constant_inputs);
+
+  // undo the EP change in case something fails prior to node removal
+  for (const auto& entry : overridden_eps) {
+    graph.GetNode(entry.first)->SetExecutionProviderType(entry.second);
+  }
+
+  std::vector<std::string> fetch_names;
+  std::vector<int> fetch_mlvalue_idxs;
+  for (const auto* node : nodes) {
     for (const auto* node_out : node->OutputDefs()) {
-      fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
+      if (node_out->Exists()) {
+        fetch_names.push_back(node_out->Name());
+        fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
+      }
     }
+  }
 
-    OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs);
+  OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs);
 
+  for (const auto* node : nodes) {
     auto* kernel = info.GetKernel(node->Index());
     OpKernelContext op_kernel_context(&frame, kernel, nullptr, onnxruntime::logging::LoggingManager::DefaultLogger());
-
     ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
+  }
 
-    std::vector<OrtValue> fetches;
-    ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
-
-    // Go over all output node args and substitute them with the newly computed tensors, which will be
-    // added to the graph as initializers.
-    ORT_ENFORCE(fetches.size() == node->OutputDefs().size());
-    bool unsupported_output_type = false;
-    for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
-      OrtValue& ort_value = fetches[fetch_idx];
+  std::vector<OrtValue> fetches;
+  ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
+  ORT_ENFORCE(fetches.size() == fetch_names.size());
+  std::unordered_map<std::string, OrtValue> values;
+  for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
+    values[fetch_names[fetch_idx]] = fetches[fetch_idx];
+  }
 
-      if (!ort_value.IsTensor()) {
-        LOGS(logger, WARNING) << "Unsupported output type of " << ort_value.Type()
-                              << ". Can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
-        unsupported_output_type = true;
-        break;
+  // The values read by nodes that aren't folded, or that are graph outputs, become initializers. A node is kept if
+  // one of them isn't a tensor or would make the model grow too much, after which its own inputs need to be kept.
+  std::unordered_set<NodeIndex> folded_nodes;
+  for (const auto* node : nodes) {
+    folded_nodes.insert(node->Index());
+  }
+  std::vector<const NodeArg*> values_to_check;
+  for (const auto* node : nodes) {
+    const auto graph_outputs = graph.GetNodeOutputsInGraphOutputs(*node);
+    for (size_t i = 0; i < node->OutputDefs().size(); ++i) {
+      bool read_outside = std::find(graph_outputs.begin(), graph_outputs.end(), static_cast<int>(i)) !=
+                          graph_outputs.end();
+      for (auto it = node->OutputEdgesBegin(); it != node->OutputEdgesEnd() && !read_outside; ++it) {
+        read_outside = it->GetSrcArgIndex() == static_cast<int>(i) &&
+                       folded_nodes.count(it->GetNode().Index()) == 0;
       }
+      if (read_outside) {
+        values_to_check.push_back(node->OutputDefs()[i]);
+      }
+    }
+  }
 
-      // Build the TensorProto that corresponds to the computed OrtValue and add it as initializer to the graph.
-      const auto* constant_arg_out = node->OutputDefs()[fetch_idx];
-      ORT_ENFORCE(ort_value.IsTensor());
-      const Tensor& out_tensor = ort_value.Get<Tensor>();
-      ONNX_NAMESPACE::TensorProto out_tensorproto =
-          utils::TensorToTensorProto(out_tensor, constant_arg_out->Name(), *constant_arg_out->TypeAsProto());
+  std::unordered_set<NodeIndex> kept_nodes;
+  std::vector<const NodeArg*> values_to_add;
+  while (!values_to_check.empty()) {
+    const auto* value_def = values_to_check.back();
+    values_to_check.pop_back();
+    const auto& node = *graph.GetNode(folded_value_producers.at(value_def->Name()));
+    if (kept_nodes.count(node.Index()) != 0) {
+      continue;
+    }
 
-      graph.AddInitializedTensor(out_tensorproto);
+    const OrtValue& value = values.at(value_def->Name());
+    bool keep_node = !value.IsTensor();
+    if (keep_node) {
+      LOGS(logger, WARNING) << "Unsupported output type of " << value.Type()
+                            << ". Can't constant fold " << node.OpType() << " node '" << node.Name() << "'";
+    } else {
+      size_t input_bytes = 0;
+      for (const auto* input_def : node.InputDefs()) {
+        if (input_def->Exists()) {
+          input_bytes += GetInputSizeInBytes(graph, values, *input_def);
+        }
+      }
+      const size_t output_bytes = value.Get<Tensor>().SizeInBytes();
+      if (output_bytes > input_bytes + max_output_growth_bytes_) {
+        LOGS(logger, INFO) << "Not constant folding " << node.OpType() << " node '" << node.Name() << "' as its "
+                           << output_bytes << " byte output would grow the model by more than "
+                           << max_output_growth_bytes_ << " bytes";
+        keep_node = true;
+      }
     }
 
-    if (unsupported_output_type)
+    if (!keep_node) {
+      values_to_add.push_back(value_def);
       continue;
+    }
+    kept_nodes.insert(node.Index());
+    for (const auto* input_def : node.InputDefs()) {
+      if (input_def->Exists() && folded_value_producers.count(input_def->Name()) != 0) {
+        values_to_check.push_back(input_def);
+      }
+    }
+  }
 
-    // Remove the output edges of the constant node and then remove the node itself.
+  // Go over the output node args to keep and substitute them with the newly computed tensors, which will be
+  // added to the graph as initializers.
+  for (const auto* constant_arg_out : values_to_add) {
+    if (kept_nodes.count(folded_value_producers.at(constant_arg_out->Name())) != 0) {
+      continue;
+    }
+    const Tensor& out_tensor = values.at(constant_arg_out->Name()).Get<Tensor>();
+    ONNX_NAMESPACE::TensorProto out_tensorproto =
+        utils::TensorToTensorProto(out_tensor, constant_arg_out->Name(), *constant_arg_out->TypeAsProto());
+
+    graph.AddInitializedTensor(out_tensorproto);
+  }
+
+  // Remove the output edges of the folded nodes and then remove the nodes themselves.
+  // The nodes left already have the right input args, since we used the same names for the initializers.
+  // We could remove unused graph initializers here, but Graph::Resolve() will take care of it.
+  int folded_count = 0;
+  for (auto* node : nodes_to_fold) {
+    if (kept_nodes.count(node->Index()) != 0) {
+      continue;
+    }
     graph_utils::RemoveNodeOutputEdges(graph, *node);
     graph.RemoveNode(node->Index());
+    folded_count++;
+  }
 
-    // The output nodes already have the right input arg, since we used the same name in the initializer.
-    // We could remove unused graph initializers here, but Graph::Resolve() will take care of it.
-
+  if (folded_count > 0) {
+    LOGS(logger, INFO) << "Constant folded " << folded_count << " nodes, " << kept_nodes.size() << " kept";
     modified = true;
   }
 
   return Status::OK();
 }
+
 }  // namespace onnxruntime
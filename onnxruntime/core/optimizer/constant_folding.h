@@ -13,19 +13,39 @@ namespace onnxruntime {
 
 Transformer that traverses the graph top-down and performs constant folding, i.e.,
 it statically computes parts of the graph that rely only on constant initializers.
+
+All the nodes that can be folded are run together in a single execution frame with the CPU kernels, and only the values
+read by the rest of the graph become initializers. A node whose such output is more than max_output_growth_bytes larger
+than its inputs, e.g. a Tile or Expand, is kept so that folding doesn't make the model bigger. Byte-identical constant
+initializers, such as weights shared by several nodes of an exported model, are then merged into one.
 */
 class ConstantFolding : public GraphTransformer {
  public:
-  ConstantFolding(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
-      : GraphTransformer("ConstantFolding", compatible_execution_providers) {}
+  static constexpr size_t kDefaultMaxOutputGrowthBytes = 4 * 1024 * 1024;
+
+  ConstantFolding(const std::unordered_set<std::string>& compatible_execution_providers = {},
+                  size_t max_output_growth_bytes = kDefaultMaxOutputGrowthBytes) noexcept
+      : GraphTransformer("ConstantFolding", compatible_execution_providers),
+        max_output_growth_bytes_(max_output_growth_bytes) {}
 
  private:
+  const size_t max_output_growth_bytes_;
+
   /** Constant folding will not be applied to nodes whose op_type is included in this set.
       All non-deterministic operators should be included in this set. */
   const std::unordered_set<std::string> excluded_op_types_ =
       {"RandomUniform", "RandomNormal", "RandomUniformLike", "RandomNormalLike", "Multinomial"};
 
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  /** Runs the nodes, which only depend on constant initializers and each other, and replaces them with initializers.
+      @param folded_value_producers The node computing each output of the nodes.
+      @param overridden_eps The original EP of the nodes not assigned to the CPU EP. */
+  Status FoldNodes(Graph& graph, const std::vector<Node*>& nodes_to_fold,
+                   const std::unordered_map<std::string, NodeIndex>& folded_value_producers,
+                   const InitializedTensorSet& constant_inputs,
+                   const std::unordered_map<NodeIndex, std::string>& overridden_eps, bool& modified,
+                   const logging::Logger& logger) const;
 };
 
 }  // namespace onnxruntime
@@ -0,0 +1,176 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+namespace onnxruntime {
+
+// Returns the node reading the only output edge of `node` if it has the given type and runs on the same provider.
+static Node* GetOnlyConsumer(Graph& graph, const Node& node, const std::string& op_type,
+                             const std::initializer_list<OperatorSetVersion>& versions) {
+  if (node.GetOutputEdgesCount() != 1 || !graph.GetNodeOutputsInGraphOutputs(node).empty()) {
+    return nullptr;
+  }
+  Node& consumer = *graph.GetNode(node.OutputNodesBegin()->Index());
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(consumer, op_type, versions) ||
+      consumer.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+    return nullptr;
+  }
+  return &consumer;
+}
+
+static bool IsSingleElement(const NodeArg& arg) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr || shape->dim_size() > 1) {
+    return false;
+  }
+  return shape->dim_size() == 0 || (utils::HasDimValue(shape->dim(0)) && shape->dim(0).dim_value() == 1);
+}
+
+// The bias can be fused if it's a constant 1-D float tensor with one value per column of B.
+static bool IsFusableBias(const Graph& graph, const NodeArg& bias, const NodeArg& b) {
+  const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, bias.Name());
+  const auto* b_shape = b.Shape();
+  if (tensor_proto == nullptr || tensor_proto->data_type() != TensorProto_DataType_FLOAT ||
+      tensor_proto->dims_size() != 1 || b_shape == nullptr || b_shape->dim_size() < 2) {
+    return false;
+  }
+  const auto& n = b_shape->dim(b_shape->dim_size() - 1);
+  return utils::HasDimValue(n) && n.dim_value() == tensor_proto->dims(0);
+}
+
+/*
+     This function fuses the subgraph below into one DynamicQuantizeMatMul node:
+
+                [A] --> DynamicQuantizeLinear --(A_quantized, A_zero_point)--> MatMulInteger(B, b_zero_point)
+                                 |                                                   |
+                                 | (A_scale)                                        Cast(to=float)
+                                 v                                                   |
+                                Mul(b_scale) -------------------------------------> Mul --> [Add(bias)] ==>
+
+       After Fusion:
+                [A] --> DynamicQuantizeMatMul(B, b_scale, b_zero_point, bias) ==>
+*/
+Status DynamicQuantizeMatMulFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                              const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* p_dql = graph.GetNode(node_index);
+    if (p_dql == nullptr)
+      continue;  // we removed the node as part of an earlier fusion
+
+    Node& dql = *p_dql;
+    ORT_RETURN_IF_ERROR(Recurse(dql, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(dql, "DynamicQuantizeLinear", {11}) ||
+        !graph_utils::IsSupportedProvider(dql, GetCompatibleExecutionProviders()) ||
+        dql.GetOutputEdgesCount() != 3 ||
+        !graph.GetNodeOutputsInGraphOutputs(dql).empty()) {
+      continue;
+    }
+
+    // the quantized A and its zero point must go to the same MatMulInteger, and the scale to a Mul
+    const Node* p_matmul_integer = nullptr;
+    const Node* p_scale_mul = nullptr;
+    bool is_pattern = true;
+    for (auto it = dql.OutputEdgesBegin(); it != dql.OutputEdgesEnd(); ++it) {
+      const Node& consumer = it->GetNode();
+      if (it->GetSrcArgIndex() == 1) {
+        is_pattern = is_pattern && p_scale_mul == nullptr;
+        p_scale_mul = &consumer;
+      } else {
+        is_pattern = is_pattern && it->GetSrcArgIndex() == it->GetDstArgIndex() &&
+                     (p_matmul_integer == nullptr || p_matmul_integer == &consumer);
+        p_matmul_integer = &consumer;
+      }
+    }
+    if (!is_pattern || p_matmul_integer == nullptr || p_scale_mul == nullptr) {
+      continue;
+    }
+
+    Node& matmul_integer = *graph.GetNode(p_matmul_integer->Index());
+    Node& scale_mul = *graph.GetNode(p_scale_mul->Index());
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(matmul_integer, "MatMulInteger", {10}) ||
+        matmul_integer.GetExecutionProviderType() != dql.GetExecutionProviderType() ||
+        !graph_utils::IsSupportedOptypeVersionAndDomain(scale_mul, "Mul", {7}) ||
+        scale_mul.GetExecutionProviderType() != dql.GetExecutionProviderType()) {
+      continue;
+    }
+
+    Node* p_cast = GetOnlyConsumer(graph, matmul_integer, "Cast", {6, 9});
+    if (p_cast == nullptr || !optimizer_utils::IsAttributeWithExpectedValue(
+                                 *p_cast, "to", static_cast<int64_t>(TensorProto_DataType_FLOAT))) {
+      continue;
+    }
+    Node& cast = *p_cast;
+
+    // the Cast output is scaled by A_scale * b_scale
+    Node* p_mul = GetOnlyConsumer(graph, cast, "Mul", {7});
+    if (p_mul == nullptr || GetOnlyConsumer(graph, scale_mul, "Mul", {7}) != p_mul ||
+        optimizer_utils::IndexOfNodeInput(*p_mul, *scale_mul.OutputDefs()[0]) < 0) {
+      continue;
+    }
+    Node& mul = *p_mul;
+    const auto a_scale_index = optimizer_utils::IndexOfNodeInput(scale_mul, *dql.OutputDefs()[1]);
+    NodeArg* b_scale = scale_mul.MutableInputDefs()[a_scale_index == 0 ? 1 : 0];
+    if (b_scale == dql.OutputDefs()[1] || !IsSingleElement(*b_scale)) {
+      continue;
+    }
+
+    NodeArg* b = matmul_integer.MutableInputDefs()[1];
+    NodeArg* b_zero_point = nullptr;
+    if (matmul_integer.InputDefs().size() > 3 && matmul_integer.InputDefs()[3]->Exists()) {
+      b_zero_point = matmul_integer.MutableInputDefs()[3];
+    }
+
+    // a constant bias added to every row can be fused as well
+    Node* p_add = GetOnlyConsumer(graph, mul, "Add", {7});
+    NodeArg* bias = nullptr;
+    if (p_add != nullptr) {
+      const auto mul_index = optimizer_utils::IndexOfNodeInput(*p_add, *mul.OutputDefs()[0]);
+      bias = p_add->MutableInputDefs()[mul_index == 0 ? 1 : 0];
+      if (!IsFusableBias(graph, *bias, *b)) {
+        p_add = nullptr;
+        bias = nullptr;
+      }
+    }
+
+    std::vector<NodeArg*> input_defs{dql.MutableInputDefs()[0], b, b_scale};
+    if (b_zero_point != nullptr || bias != nullptr) {
+      input_defs.push_back(b_zero_point != nullptr ? b_zero_point : &graph.GetOrCreateNodeArg("", nullptr));
+    }
+    if (bias != nullptr) {
+      input_defs.push_back(bias);
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("DynamicQuantizeMatMul"),
+                                     "DynamicQuantizeMatMul",
+                                     "fused DynamicQuantizeLinear and MatMulInteger",
+                                     input_defs,
+                                     {}, {}, kMSDomain);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(dql.GetExecutionProviderType());
+
+    // move input edges to dql (first in list) across to the fused node.
+    // move output definitions and output edges from mul or add (last in list) to the fused node.
+    // remove all the other nodes. The edges from the producers of B and b_scale are rebuilt by Graph::Resolve.
+    if (p_add != nullptr) {
+      graph_utils::FinalizeNodeFusion(graph, {dql, matmul_integer, scale_mul, cast, mul, *p_add}, fused_node);
+    } else {
+      graph_utils::FinalizeNodeFusion(graph, {dql, matmul_integer, scale_mul, cast, mul}, fused_node);
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class DynamicQuantizeMatMulFusion
+
+Rewrite graph fusing the dynamically quantized MatMul subgraph produced by the quantization tools to a single
+DynamicQuantizeMatMul node:
+
+    A -> DynamicQuantizeLinear -> MatMulInteger(B) -> Cast(float) -> Mul -> [Add(bias)]
+                     |                                                 ^
+                     +---- A_scale ----> Mul(b_scale) -----------------+
+
+*/
+class DynamicQuantizeMatMulFusion : public GraphTransformer {
+ public:
+  DynamicQuantizeMatMulFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("DynamicQuantizeMatMulFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
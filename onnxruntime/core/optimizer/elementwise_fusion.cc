@@ -0,0 +1,288 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_fusion.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+// The longest chain fused into one node. Each op of the chain uses a block of scratch memory in the kernel.
+static constexpr size_t kMaxFusedOps = 32;
+
+// Returns true if the node is a float elementwise op supported by the FusedElementwise kernel.
+static bool IsFusableOp(const Node& node) {
+  const bool is_supported_op =
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Max", {8, 12}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Min", {8, 12}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Exp", {6}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Erf", {9}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6});
+  if (!is_supported_op) {
+    return false;
+  }
+
+  // Max and Min are variadic, the kernel only supports two inputs
+  const bool is_binary = node.OpType() == "Add" || node.OpType() == "Sub" || node.OpType() == "Mul" ||
+                         node.OpType() == "Div" || node.OpType() == "Max" || node.OpType() == "Min";
+  if (node.InputDefs().size() != (is_binary ? 2u : 1u)) {
+    return false;
+  }
+
+  for (const auto* arg : node.InputDefs()) {
+    if (arg->Type() == nullptr || *arg->Type() != "tensor(float)" || arg->Shape() == nullptr) {
+      return false;
+    }
+  }
+  const auto* output = node.OutputDefs()[0];
+  return output->Type() != nullptr && *output->Type() == "tensor(float)" && output->Shape() != nullptr;
+}
+
+static bool IsSameDim(const TensorShapeProto_Dimension& a, const TensorShapeProto_Dimension& b) {
+  if (utils::HasDimValue(a) && utils::HasDimValue(b)) {
+    return a.dim_value() == b.dim_value();
+  }
+  return utils::HasDimParam(a) && utils::HasDimParam(b) && a.dim_param() == b.dim_param();
+}
+
+static bool IsSameShape(const TensorShapeProto& a, const TensorShapeProto& b) {
+  if (a.dim_size() != b.dim_size()) {
+    return false;
+  }
+  for (int i = 0; i < a.dim_size(); ++i) {
+    if (!IsSameDim(a.dim(i), b.dim(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if `input` without its leading axes of size 1 matches the trailing axes of `output`, which is the
+// broadcast the FusedElementwise kernel supports.
+static bool IsLeadingAxesBroadcast(const TensorShapeProto& input, const TensorShapeProto& output) {
+  int first_axis = 0;
+  while (first_axis < input.dim_size() && utils::HasDimValue(input.dim(first_axis)) &&
+         input.dim(first_axis).dim_value() == 1) {
+    ++first_axis;
+  }
+  if (input.dim_size() - first_axis > output.dim_size()) {
+    return false;
+  }
+  const int offset = output.dim_size() - input.dim_size();
+  for (int i = first_axis; i < input.dim_size(); ++i) {
+    if (!IsSameDim(input.dim(i), output.dim(offset + i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+namespace {
+// A chain of ops being fused, in evaluation order.
+struct FusedChain {
+  std::vector<Node*> nodes;
+  std::unordered_set<const Node*> node_set;
+  std::vector<NodeArg*> inputs;  // the values the chain reads that it doesn't compute
+
+  bool Computes(const NodeArg* arg) const {
+    for (const auto* node : nodes) {
+      if (node->OutputDefs()[0] == arg) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Add(Node& node) {
+    for (auto* arg : node.MutableInputDefs()) {
+      if (!Computes(arg) && std::find(inputs.begin(), inputs.end(), arg) == inputs.end()) {
+        inputs.push_back(arg);
+      }
+    }
+    nodes.push_back(&node);
+    node_set.insert(&node);
+  }
+
+  // Only the last value of the chain can be read outside of it.
+  bool IsValid(const Graph& graph) const {
+    for (size_t i = 0; i + 1 < nodes.size(); ++i) {
+      if (!graph.GetNodeOutputsInGraphOutputs(*nodes[i]).empty()) {
+        return false;
+      }
+      for (auto it = nodes[i]->OutputNodesBegin(); it != nodes[i]->OutputNodesEnd(); ++it) {
+        if (node_set.count(&*it) == 0) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+};
+}  // namespace
+
+// Returns true if `consumer` can be added to the chain. Its inputs must be computed by the chain, be already read by
+// the chain, or not be computed by any node (graph inputs and initializers), so the fused node can't depend on a node
+// that depends on the chain.
+static bool CanExtendChain(const Graph& graph, const FusedChain& chain, const Node& consumer,
+                           const TensorShapeProto& shape) {
+  if (!IsFusableOp(consumer) ||
+      consumer.GetExecutionProviderType() != chain.nodes[0]->GetExecutionProviderType() ||
+      !IsSameShape(*consumer.OutputDefs()[0]->Shape(), shape)) {
+    return false;
+  }
+
+  for (const auto* arg : consumer.InputDefs()) {
+    if (chain.Computes(arg) || std::find(chain.inputs.begin(), chain.inputs.end(), arg) != chain.inputs.end()) {
+      continue;
+    }
+    if (!graph_utils::IsGraphInput(graph, arg) && !graph_utils::IsInitializer(graph, arg->Name(), false)) {
+      return false;
+    }
+    if (!IsLeadingAxesBroadcast(*arg->Shape(), shape)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Replaces the nodes of the chain with one FusedElementwise node.
+static void FuseChain(Graph& graph, const FusedChain& chain) {
+  std::unordered_map<const NodeArg*, int64_t> value_index;
+  for (size_t i = 0; i < chain.inputs.size(); ++i) {
+    value_index[chain.inputs[i]] = static_cast<int64_t>(i);
+  }
+
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  for (size_t k = 0; k < chain.nodes.size(); ++k) {
+    const Node& node = *chain.nodes[k];
+    ops.push_back(node.OpType());
+    operands.push_back(value_index.at(node.InputDefs()[0]));
+    operands.push_back(node.InputDefs().size() > 1 ? value_index.at(node.InputDefs()[1]) : -1);
+    value_index[node.OutputDefs()[0]] = static_cast<int64_t>(chain.inputs.size() + k);
+  }
+
+  Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedElementwise"),
+                                   "FusedElementwise",
+                                   "fused elementwise ops",
+                                   chain.inputs,
+                                   {}, {}, kMSDomain);
+  fused_node.AddAttribute("ops", ops);
+  fused_node.AddAttribute("operands", operands);
+
+  // Assign provider to this new node. Provider should be same as the provider for old node.
+  fused_node.SetExecutionProviderType(chain.nodes[0]->GetExecutionProviderType());
+
+  // connect the inputs of the fused node to their producers
+  for (size_t i = 0; i < chain.inputs.size(); ++i) {
+    bool connected = false;
+    for (const Node* node : chain.nodes) {
+      for (auto it = node->InputEdgesBegin(); it != node->InputEdgesEnd(); ++it) {
+        if (chain.node_set.count(&it->GetNode()) == 0 && node->InputDefs()[it->GetDstArgIndex()] == chain.inputs[i]) {
+          graph.AddEdge(it->GetNode().Index(), fused_node.Index(), it->GetSrcArgIndex(), static_cast<int>(i));
+          connected = true;
+          break;
+        }
+      }
+      if (connected) {
+        break;
+      }
+    }
+  }
+
+  // remove the chain, moving the output of its last node to the fused node
+  for (size_t k = 0; k + 1 < chain.nodes.size(); ++k) {
+    graph_utils::RemoveNodeOutputEdges(graph, *chain.nodes[k]);
+    graph.RemoveNode(chain.nodes[k]->Index());
+  }
+  graph_utils::FinalizeNodeFusion(graph, fused_node, *chain.nodes.back());
+}
+
+Status ElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                    const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::unordered_map<NodeIndex, size_t> topological_position;
+  for (size_t i = 0; i < node_topology_list.size(); ++i) {
+    topological_position[node_topology_list[i]] = i;
+  }
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed as part of an earlier fusion
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!IsFusableOp(node) || !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const auto& shape = *node.OutputDefs()[0]->Shape();
+    bool is_fusable_start = true;
+    for (const auto* arg : node.InputDefs()) {
+      is_fusable_start = is_fusable_start && IsLeadingAxesBroadcast(*arg->Shape(), shape);
+    }
+    if (!is_fusable_start) {
+      continue;
+    }
+
+    // grow the chain with the first consumer of its values, in topological order, that can be added to it. keep the
+    // longest chain whose intermediate values aren't read elsewhere.
+    FusedChain chain;
+    chain.Add(node);
+    size_t valid_length = 1;
+    while (chain.nodes.size() < kMaxFusedOps) {
+      Node* next = nullptr;
+      for (const Node* chain_node : chain.nodes) {
+        for (auto it = chain_node->OutputNodesBegin(); it != chain_node->OutputNodesEnd(); ++it) {
+          const Node& consumer = *it;
+          if (chain.node_set.count(&consumer) != 0 || !CanExtendChain(graph, chain, consumer, shape)) {
+            continue;
+          }
+          if (next == nullptr || topological_position[consumer.Index()] < topological_position[next->Index()]) {
+            next = graph.GetNode(consumer.Index());
+          }
+        }
+      }
+      if (next == nullptr) {
+        break;
+      }
+
+      chain.Add(*next);
+      if (chain.IsValid(graph)) {
+        valid_length = chain.nodes.size();
+      }
+    }
+
+    if (valid_length < 2) {
+      continue;
+    }
+
+    FusedChain fused_chain;
+    for (size_t i = 0; i < valid_length; ++i) {
+      fused_chain.Add(*chain.nodes[i]);
+    }
+    FuseChain(graph, fused_chain);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
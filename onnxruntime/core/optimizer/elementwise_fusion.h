@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ElementwiseFusion
+
+Fuses chains of float elementwise ops, such as Mul -> Add -> Sigmoid -> Mul, into a single FusedElementwise node that
+computes the chain in one pass over its output instead of writing a full tensor for each op.
+A chain may read the values it computes more than once (e.g. x * Sigmoid(x)), but only its last value may be used
+outside of it. All the values of the chain must have the same shape, and the other inputs can only be broadcast over
+its leading axes.
+*/
+class ElementwiseFusion : public GraphTransformer {
+ public:
+  ElementwiseFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseFusion", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -21,8 +21,13 @@ static std::string ToLower(std::string s) {
 /*explicit*/ FreeDimensionOverrideTransformer::FreeDimensionOverrideTransformer(gsl::span<const FreeDimensionOverride> overrides_to_apply)
     : GraphTransformer("FreeDimensionOverrideTransformer") {
   for (const auto& o : overrides_to_apply) {
+    if (o.dimension_identifier_type == FreeDimensionOverrideType::Name) {
+      dimension_override_by_name_.emplace(o.dimension_identifier, o.dimension_override);
+      continue;
+    }
+
     // Convert to lowercase to perform case-insensitive comparisons later
-    std::string denotation = ToLower(o.dimension_denotation);
+    std::string denotation = ToLower(o.dimension_identifier);
 
     dimension_override_by_denotation_.emplace(denotation, o.dimension_override);
   }
@@ -47,6 +52,15 @@ Status FreeDimensionOverrideTransformer::ApplyImpl(Graph& graph, bool& modified,
       auto* new_dimension = new_shape.add_dim();
       *new_dimension = dimension;
 
+      if (dimension.has_dim_param()) {
+        auto it = dimension_override_by_name_.find(dimension.dim_param());
+        if (it != dimension_override_by_name_.end()) {
+          new_dimension->clear_dim_param();
+          new_dimension->set_dim_value(it->second);
+          continue;
+        }
+      }
+
       if (dimension.has_denotation()) {
         // Convert to lowercase to perform case-insensitive comparison
         auto it = dimension_override_by_denotation_.find(ToLower(dimension.denotation()));
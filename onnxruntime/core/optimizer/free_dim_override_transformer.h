@@ -16,7 +16,7 @@ struct FreeDimensionOverride;
 @Class FreeDimensionOverrideTransformer
 
 Transformer that overrides free dimensions in the graph with the specific value
-that matches the denotation for that dimension.
+that matches the denotation or the name (dim_param) for that dimension.
 */
 class FreeDimensionOverrideTransformer : public GraphTransformer {
  public:
@@ -26,6 +26,7 @@ class FreeDimensionOverrideTransformer : public GraphTransformer {
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
   std::map<std::string, int64_t> dimension_override_by_denotation_;
+  std::map<std::string, int64_t> dimension_override_by_name_;
 };
 
 }  // namespace onnxruntime
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/gather_sum_fusion.h"
+#include "core/optimizer/utils.h"
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+Status GatherSumFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gather", {1, 11}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        node.GetOutputEdgesCount() != 1 ||
+        !graph.GetNodeOutputsInGraphOutputs(node).empty()) {
+      continue;
+    }
+
+    // GatherSum gathers rows of 'data', so 'axis' must be 0
+    const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+    if (axis_attr != nullptr && !optimizer_utils::IsAttributeWithExpectedValue(node, "axis", 0)) {
+      continue;
+    }
+
+    const NodeArg& data_arg = *node.InputDefs()[0];
+    const NodeArg& indices_arg = *node.InputDefs()[1];
+    const TensorShapeProto* data_shape = data_arg.Shape();
+    const TensorShapeProto* indices_shape = indices_arg.Shape();
+    if (data_arg.Type() == nullptr || *data_arg.Type() != "tensor(float)" ||
+        data_shape == nullptr || indices_shape == nullptr ||
+        data_shape->dim_size() < 1 || indices_shape->dim_size() < 1) {
+      continue;
+    }
+
+    const Node& next_node = *node.OutputNodesBegin();
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "ReduceSum", {1, 11}) ||
+        next_node.GetExecutionProviderType() != node.GetExecutionProviderType() ||
+        !optimizer_utils::IsAttributeWithExpectedValue(next_node, "keepdims", 0)) {
+      continue;
+    }
+
+    // the ReduceSum must sum over the last axis of the indices, and only that axis
+    const auto* axes_attr = graph_utils::GetNodeAttribute(next_node, "axes");
+    if (axes_attr == nullptr || axes_attr->ints_size() != 1) {
+      continue;
+    }
+
+    const int64_t gathered_rank = indices_shape->dim_size() + data_shape->dim_size() - 1;
+    int64_t reduced_axis = axes_attr->ints(0);
+    if (reduced_axis < 0) {
+      reduced_axis += gathered_rank;
+    }
+    if (reduced_axis != indices_shape->dim_size() - 1) {
+      continue;
+    }
+
+    Node& gather_node = node;
+    Node& reduce_sum_node = const_cast<Node&>(next_node);
+
+    Node& gather_sum_node = graph.AddNode(graph.GenerateNodeName("GatherSum"),
+                                          "GatherSum",
+                                          "fused Gather and ReduceSum",
+                                          {gather_node.MutableInputDefs()[0], gather_node.MutableInputDefs()[1]},
+                                          {},
+                                          {},
+                                          kMSDomain);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    gather_sum_node.SetExecutionProviderType(gather_node.GetExecutionProviderType());
+
+    // move output definitions and edges from reduce_sum_node to gather_sum_node
+    // delete gather_node and reduce_sum_node.
+    graph_utils::FinalizeNodeFusion(graph, {gather_node, reduce_sum_node}, gather_sum_node);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
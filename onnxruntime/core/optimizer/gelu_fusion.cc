@@ -24,6 +24,85 @@ static bool IsSupportedDataType(const Node& node) {
   }
   return true;
 }
+// Returns the patterns matched in addition to the two handled by hand below: x / sqrt(2) computed as a Mul by
+// 1 / sqrt(2), and the product arranged as x * ((1 + erf) * 0.5).
+static std::vector<std::vector<optimizer_utils::PatternNode>> GetGeluPatterns() {
+  const optimizer_utils::PatternNode div{"scaled", "Div", {7}, {"x", "sqrt_two"}};
+  const optimizer_utils::PatternNode mul{"scaled", "Mul", {7}, {"x", "inv_sqrt_two"}, true};
+  const optimizer_utils::PatternNode erf{"erf", "Erf", {9}, {"scaled"}};
+  const optimizer_utils::PatternNode add{"add", "Add", {7}, {"erf", "one"}, true};
+
+  std::vector<std::vector<optimizer_utils::PatternNode>> patterns;
+  for (bool scale_by_mul : {false, true}) {
+    const auto& scale = scale_by_mul ? mul : div;
+    if (scale_by_mul) {
+      // x * 0.5 * (1 + erf) and x * (1 + erf) * 0.5
+      patterns.push_back({scale, erf, add,
+                          {"half_x", "Mul", {7}, {"x", "half"}, true},
+                          {"output", "Mul", {7}, {"half_x", "add"}, true}});
+      patterns.push_back({scale, erf, add,
+                          {"product", "Mul", {7}, {"x", "add"}, true},
+                          {"output", "Mul", {7}, {"product", "half"}, true}});
+    }
+    // x * ((1 + erf) * 0.5)
+    patterns.push_back({scale, erf, add,
+                        {"half_add", "Mul", {7}, {"add", "half"}, true},
+                        {"output", "Mul", {7}, {"x", "half_add"}, true}});
+  }
+  return patterns;
+}
+
+// Fuses the Gelu forms of GetGeluPatterns ending at the Mul node `mul`. Returns true if the graph was modified.
+static bool FuseGeluPattern(Graph& graph, Node& mul) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(mul, "Mul", {7}) || !IsSupportedDataType(mul)) {
+    return false;
+  }
+
+  static const auto patterns = GetGeluPatterns();
+  optimizer_utils::PatternMatch match;
+  bool matched = false;
+  for (const auto& pattern : patterns) {
+    match = optimizer_utils::PatternMatch();
+    if (optimizer_utils::MatchPattern(graph, mul, pattern, match)) {
+      matched = true;
+      break;
+    }
+  }
+  if (!matched) {
+    return false;
+  }
+
+  // Some Bert model uses this approximation of SQRT2 in the Gelu function
+  const float approximated_sqrt_two = 1.4142099618911743f;
+  if (match.values.count("sqrt_two") != 0) {
+    const NodeArg& sqrt_two = *match.values["sqrt_two"];
+    if (!optimizer_utils::IsInitializerWithExpectedValue(graph, sqrt_two, approximated_sqrt_two, true) &&
+        !optimizer_utils::IsInitializerWithExpectedValue(graph, sqrt_two, static_cast<float>(M_SQRT2), true)) {
+      return false;
+    }
+  } else {
+    const NodeArg& inv_sqrt_two = *match.values["inv_sqrt_two"];
+    if (!optimizer_utils::IsInitializerWithExpectedValue(graph, inv_sqrt_two, static_cast<float>(M_SQRT1_2), true) &&
+        !optimizer_utils::IsInitializerWithExpectedValue(graph, inv_sqrt_two, 1.0f / approximated_sqrt_two, true)) {
+      return false;
+    }
+  }
+  if (!optimizer_utils::IsInitializerWithExpectedValue(graph, *match.values["one"], 1.0f, true) ||
+      !optimizer_utils::IsInitializerWithExpectedValue(graph, *match.values["half"], 0.5f, true) ||
+      !IsSupportedDataType(*match.nodes["erf"])) {
+    return false;
+  }
+
+  Node& gelu_node = graph.AddNode(graph.GenerateNodeName("Gelu"),
+                                  "Gelu",
+                                  "fused Gelu subgraphs ",
+                                  {match.values["x"]},
+                                  {}, {}, kMSDomain);
+  gelu_node.SetExecutionProviderType(mul.GetExecutionProviderType());
+  optimizer_utils::FinalizePatternFusion(graph, match, mul, gelu_node);
+  return true;
+}
+
 /*
      This function fuses subgraph like the following into one Gelu node.
      Subgraph pattern 1:
@@ -42,6 +121,8 @@ static bool IsSupportedDataType(const Node& node) {
 
        After Fusion:
                 [root]--> Gelu ==>
+
+     The other forms exported for the same formula are matched with GetGeluPatterns.
 */
 Status GeluFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
   GraphViewer graph_viewer(graph);
@@ -55,6 +136,12 @@ Status GeluFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, cons
     Node& div = *p_div;
     ORT_RETURN_IF_ERROR(Recurse(div, modified, graph_level, logger));
 
+    // the node may also be the final Mul of one of the other forms
+    if (graph_utils::IsSupportedProvider(div, GetCompatibleExecutionProviders()) && FuseGeluPattern(graph, div)) {
+      modified = true;
+      continue;
+    }
+
     if (!graph_utils::IsSupportedOptypeVersionAndDomain(div, "Div", {7}) ||
         !graph_utils::IsSupportedProvider(div, GetCompatibleExecutionProviders()) ||
         div.GetOutputEdgesCount() != 1 ||
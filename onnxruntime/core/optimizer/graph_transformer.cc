@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/graph_transformer.h"
+#include "core/common/profiler.h"
 
 using namespace ::onnxruntime::common;
 
@@ -23,4 +24,8 @@ Status GraphTransformer::Apply(Graph& graph, bool& modified, const logging::Logg
   return status;
 }
 
+profiling::Profiler* GraphTransformer::EnabledProfiler() const noexcept {
+  return profiler_ != nullptr && profiler_->IsEnabled() ? profiler_ : nullptr;
+}
+
 }  // namespace onnxruntime
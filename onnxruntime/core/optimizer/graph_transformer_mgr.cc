@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/graph_transformer_mgr.h"
+#include "core/common/profiler.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 
 using namespace onnxruntime;
@@ -25,12 +26,45 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
     return Status::OK();
   }
 
+  const bool profiling = profiler_ != nullptr && profiler_->IsEnabled();
   for (unsigned step = 0; step < steps_; ++step) {
     bool graph_changed = false;
     for (const auto& transformer : transformers->second) {
+      TimePoint start_time;
+      int num_nodes = 0;
+      int max_node_index = 0;
+      if (profiling) {
+        start_time = profiler_->StartTime();
+        num_nodes = graph.NumberOfNodes();
+        max_node_index = graph.MaxNodeIndex();
+      }
+
       bool modified = false;
       ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
       graph_changed = graph_changed || modified;
+
+      if (profiling) {
+        // node indexes aren't reused, so the nodes added are the ones past the previous maximum index
+        size_t num_added = 0;
+        for (int i = max_node_index; i < graph.MaxNodeIndex(); ++i) {
+          num_added += graph.GetNode(i) != nullptr ? 1 : 0;
+        }
+        const size_t num_removed = static_cast<size_t>(num_nodes) + num_added - graph.NumberOfNodes();
+
+        auto& stats = stats_[transformer->Name()];
+        stats.duration_us += TimeDiffMicroSeconds(start_time);
+        ++stats.num_applied;
+        stats.num_modified += modified ? 1 : 0;
+        stats.num_nodes_added += num_added;
+        stats.num_nodes_removed += num_removed;
+
+        profiler_->EndTimeAndRecordEvent(profiling::SESSION_EVENT, transformer->Name(), start_time,
+                                         {{"level", std::to_string(static_cast<int>(level))},
+                                          {"step", std::to_string(step)},
+                                          {"modified", modified ? "true" : "false"},
+                                          {"nodes_added", std::to_string(num_added)},
+                                          {"nodes_removed", std::to_string(num_removed)}});
+      }
     }
     if (!graph_changed) {
       break;
@@ -46,8 +80,18 @@ common::Status GraphTransformerManager::Register(std::unique_ptr<GraphTransforme
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "This transformer is already registered " + name);
   }
 
+  transformer->SetProfiler(profiler_);
   transformers_info_[name] = transformer.get();
   level_to_transformer_map_[level].push_back(std::move(transformer));
   return Status::OK();
 }
+
+void GraphTransformerManager::SetProfiler(profiling::Profiler* profiler) {
+  profiler_ = profiler;
+  for (auto& entry : level_to_transformer_map_) {
+    for (auto& transformer : entry.second) {
+      transformer->SetProfiler(profiler);
+    }
+  }
+}
 }  // namespace onnxruntime
@@ -3,12 +3,31 @@
 
 #pragma once
 
+#include <map>
+
 #include "core/common/logging/logging.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/constant_folding.h"
 #include "core/optimizer/rewrite_rule.h"
 
 namespace onnxruntime {
+namespace profiling {
+class Profiler;
+}
+
+// Statistics of the applications of a graph transformer, collected while profiling is enabled.
+struct GraphTransformerStats {
+  // number of times the transformer was applied, and how many of those modified the graph
+  size_t num_applied = 0;
+  size_t num_modified = 0;
+
+  // nodes of the main graph added and removed by the transformer, e.g. a fusion of 3 nodes into 1 adds 1 and removes 3
+  size_t num_nodes_added = 0;
+  size_t num_nodes_removed = 0;
+
+  // total wall time of the applications in microseconds
+  long long duration_us = 0;
+};
 
 // Manages a list of graph transformers. It is initialized with a list of graph
 // transformers. Each inference session can further register additional ones.
@@ -29,6 +48,15 @@ class GraphTransformerManager {
   // Apply all transformers registered for the given level on the given graph
   common::Status ApplyTransformers(Graph& graph, TransformerLevel level, const logging::Logger& logger) const;
 
+  // Set the profiler that records an event for each transformer applied, and for each rewrite of the rules of the
+  // rule based transformers. Nothing is recorded unless the profiler is enabled.
+  void SetProfiler(profiling::Profiler* profiler);
+
+  // Get the statistics of each transformer applied while profiling was enabled, by transformer name.
+  const std::map<std::string, GraphTransformerStats>& GetStats() const noexcept {
+    return stats_;
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphTransformerManager);
 
@@ -47,5 +75,8 @@ class GraphTransformerManager {
 
   std::unordered_map<TransformerLevel, std::vector<std::unique_ptr<GraphTransformer>>, EnumHashKey> level_to_transformer_map_;
   std::unordered_map<std::string, GraphTransformer*> transformers_info_;
+
+  profiling::Profiler* profiler_ = nullptr;
+  mutable std::map<std::string, GraphTransformerStats> stats_;
 };
 }  // namespace onnxruntime
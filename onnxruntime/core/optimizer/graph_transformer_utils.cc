@@ -8,6 +8,8 @@
 #include "core/optimizer/conv_bn_fusion.h"
 #include "core/optimizer/conv_add_fusion.h"
 #include "core/optimizer/constant_folding.h"
+#include "core/optimizer/common_subexpression_elimination.h"
+#include "core/optimizer/loop_invariant_code_motion.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/conv_activation_fusion.h"
@@ -18,6 +20,7 @@
 #include "core/optimizer/shape_to_initializer.h"
 #include "core/optimizer/nchwc_transformer.h"
 #include "core/optimizer/free_dim_override_transformer.h"
+#include "core/optimizer/symbolic_shape_transformer.h"
 #include "core/optimizer/bias_gelu_fusion.h"
 #include "core/optimizer/gelu_fusion.h"
 #include "core/optimizer/gelu_approximation.h"
@@ -27,6 +30,13 @@
 #include "core/optimizer/embed_layer_norm_fusion.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/attention_fusion.h"
+#include "core/optimizer/gather_sum_fusion.h"
+#include "core/optimizer/transpose_optimizer.h"
+#include "core/optimizer/qdq_fusion.h"
+#include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
+#include "core/optimizer/sparse_matmul_transformer.h"
+#include "core/optimizer/linear_classifier_fusion.h"
 #include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
@@ -107,9 +117,13 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(TransformerL
       std::unordered_set<std::string> l1_execution_providers = {};
 
       transformers.emplace_back(onnxruntime::make_unique<ConstantFolding>(l1_execution_providers));
+      transformers.emplace_back(onnxruntime::make_unique<CommonSubexpressionElimination>(l1_execution_providers));
+      transformers.emplace_back(onnxruntime::make_unique<LoopInvariantCodeMotion>(l1_execution_providers));
       transformers.emplace_back(onnxruntime::make_unique<MatMulAddFusion>(l1_execution_providers));
+      transformers.emplace_back(onnxruntime::make_unique<TransposeOptimizer>(l1_execution_providers));
       transformers.emplace_back(onnxruntime::make_unique<ReshapeFusion>(l1_execution_providers));
       transformers.emplace_back(onnxruntime::make_unique<FreeDimensionOverrideTransformer>(free_dimension_overrides));
+      transformers.emplace_back(onnxruntime::make_unique<SymbolicShapeTransformer>(l1_execution_providers));
 
       rule_transformer = GenerateRuleBasedGraphTransformer(level, transformers_and_rules_to_enable, l1_execution_providers);
     } break;
@@ -120,9 +134,19 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(TransformerL
       // create rule based transformer consisting of all the level2 rewrite rules
       rule_transformer = GenerateRuleBasedGraphTransformer(level, transformers_and_rules_to_enable, cpu_execution_providers);
 
+      transformers.emplace_back(onnxruntime::make_unique<QDQFusion>(cpu_execution_providers));
+
 #ifndef DISABLE_CONTRIB_OPS
+      // before GemmActivationFusion, which hides the Gemm nodes in FusedGemm nodes
+      transformers.emplace_back(onnxruntime::make_unique<SparseMatMulTransformer>(cpu_execution_providers));
       transformers.emplace_back(onnxruntime::make_unique<GemmActivationFusion>(cpu_execution_providers));
-      transformers.emplace_back(onnxruntime::make_unique<ConvActivationFusion>(cpu_execution_providers));
+      // the ACL execution provider runs the activation in its convolution
+      std::unordered_set<std::string> cpu_acl_execution_providers = {onnxruntime::kCpuExecutionProvider,
+                                                                     onnxruntime::kAclExecutionProvider};
+      transformers.emplace_back(onnxruntime::make_unique<ConvActivationFusion>(cpu_acl_execution_providers));
+      transformers.emplace_back(onnxruntime::make_unique<GatherSumFusion>(cpu_execution_providers));
+      transformers.emplace_back(onnxruntime::make_unique<DynamicQuantizeMatMulFusion>(cpu_execution_providers));
+      transformers.emplace_back(onnxruntime::make_unique<LinearClassifierFusion>(cpu_execution_providers));
 
       std::unordered_set<std::string> cpu_cuda_execution_providers = {onnxruntime::kCpuExecutionProvider, onnxruntime::kCudaExecutionProvider};
       transformers.emplace_back(onnxruntime::make_unique<GeluFusion>(cpu_cuda_execution_providers));
@@ -145,6 +169,10 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(TransformerL
       if (MlasNchwcGetBlockSize() > 1) {
         transformers.emplace_back(onnxruntime::make_unique<NchwcTransformer>());
       }
+
+      // fuse the chains of elementwise ops left once the other fusions and layout changes are done
+      std::unordered_set<std::string> cpu_execution_providers = {onnxruntime::kCpuExecutionProvider};
+      transformers.emplace_back(onnxruntime::make_unique<ElementwiseFusion>(cpu_execution_providers));
 #endif
     } break;
 
@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
+#include "core/framework/tensorprotoutils.h"
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/layer_norm_fusion.h"
+#include "core/optimizer/utils.h"
 #include "core/graph/graph_utils.h"
 #include "float.h"
 #include <deque>
@@ -23,6 +25,97 @@ static bool IsSupportedDataType(const Node& node) {
   return true;
 }
 
+// Returns the pattern of the form exported from TF-Keras, which folds gamma into the normalization scale:
+//   mean = ReduceMean(X), variance = ReduceMean(Sub(X, mean) squared)
+//   scale = Reciprocal(Sqrt(variance + epsilon)) * gamma
+//   output = X * scale + (beta - mean * scale)
+// The square is either Mul(diff, diff) or Pow(diff, 2).
+static std::vector<optimizer_utils::PatternNode> GetKerasLayerNormPattern(bool square_with_pow) {
+  std::vector<optimizer_utils::PatternNode> pattern{
+      {"mean", "ReduceMean", {1, 11}, {"X"}},
+      {"diff", "Sub", {7}, {"X", "mean"}},
+      square_with_pow ? optimizer_utils::PatternNode{"square", "Pow", {7, 12}, {"diff", "two"}}
+                      : optimizer_utils::PatternNode{"square", "Mul", {7}, {"diff", "diff"}},
+      {"variance", "ReduceMean", {1, 11}, {"square"}},
+      {"add_epsilon", "Add", {7}, {"variance", "epsilon"}, true},
+      {"std", "Sqrt", {6}, {"add_epsilon"}},
+      {"inv_std", "Reciprocal", {6}, {"std"}},
+      {"scale", "Mul", {7}, {"inv_std", "gamma"}, true},
+      {"scaled_x", "Mul", {7}, {"X", "scale"}, true},
+      {"scaled_mean", "Mul", {7}, {"mean", "scale"}, true},
+      {"shift", "Sub", {7}, {"beta", "scaled_mean"}},
+      {"output", "Add", {7}, {"scaled_x", "shift"}, true}};
+  return pattern;
+}
+
+// Both ReduceMean nodes must keep the dims and reduce the last axis only.
+static bool ReducesLastAxis(const Node& reduce_mean, const NodeArg& input) {
+  if (!optimizer_utils::IsAttributeWithExpectedValue(reduce_mean, "keepdims", static_cast<int64_t>(1)) &&
+      graph_utils::GetNodeAttribute(reduce_mean, "keepdims") != nullptr) {
+    return false;
+  }
+  const auto* axes = graph_utils::GetNodeAttribute(reduce_mean, "axes");
+  if (axes == nullptr || axes->ints_size() != 1) {
+    return false;
+  }
+  return axes->ints(0) == -1 || (input.Shape() != nullptr && axes->ints(0) == input.Shape()->dim_size() - 1);
+}
+
+static bool IsOneDimensional(const Graph& graph, const NodeArg& arg) {
+  return (graph_utils::NodeArgIsConstant(graph, arg) || graph_utils::IsGraphInput(graph, &arg)) &&
+         arg.Shape() != nullptr && arg.Shape()->dim_size() == 1;
+}
+
+// Fuses the TF-Keras form of LayerNorm ending at the Add node `add`. Returns true if the graph was modified.
+static bool FuseKerasLayerNorm(Graph& graph, Node& add) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(add, "Add", {7})) {
+    return false;
+  }
+
+  optimizer_utils::PatternMatch match;
+  if (!optimizer_utils::MatchPattern(graph, add, GetKerasLayerNormPattern(false), match) &&
+      !optimizer_utils::MatchPattern(graph, add, GetKerasLayerNormPattern(true), match)) {
+    return false;
+  }
+
+  NodeArg& x = *match.values["X"];
+  NodeArg& gamma = *match.values["gamma"];
+  NodeArg& beta = *match.values["beta"];
+  Node& mean = *match.nodes["mean"];
+  if (!IsSupportedDataType(mean) || !IsSupportedDataType(add) ||
+      !ReducesLastAxis(mean, x) || !ReducesLastAxis(*match.nodes["variance"], x) ||
+      !IsOneDimensional(graph, gamma) || !IsOneDimensional(graph, beta) ||
+      !utils::HasDimValue(gamma.Shape()->dim(0)) ||
+      gamma.Shape()->dim(0).dim_value() != beta.Shape()->dim(0).dim_value()) {
+    return false;
+  }
+  if (match.values.count("two") != 0 &&
+      !optimizer_utils::IsInitializerWithExpectedValue(graph, *match.values["two"], 2.0f, true)) {
+    return false;
+  }
+
+  Node& layer_norm_node = graph.AddNode(graph.GenerateNodeName("LayerNormalization"),
+                                        "LayerNormalization",
+                                        "fused LayerNorm subgraphs ",
+                                        {&x, &gamma, &beta},
+                                        {}, {}, kOnnxDomain);
+
+  const auto* epsilon = graph_utils::GetConstantInitializer(graph, match.values["epsilon"]->Name());
+  if (epsilon != nullptr && epsilon->data_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+    Initializer initializer{*epsilon, graph.ModelPath()};
+    layer_norm_node.AddAttribute("epsilon", initializer.data<float>()[0]);
+  }
+  layer_norm_node.SetExecutionProviderType(add.GetExecutionProviderType());
+
+  optimizer_utils::FinalizePatternFusion(graph, match, add, layer_norm_node);
+
+  // add two extra output defs, so we have 3 output defs that match what gradient builder expected
+  auto& outputs = layer_norm_node.MutableOutputDefs();
+  outputs.push_back(&graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("saved_mean"), nullptr));
+  outputs.push_back(&graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("saved_inv_std_var"), nullptr));
+  return true;
+}
+
 /**
 Layer Normalization will fuse LayerNormalization into one node :
 +---------------------+
@@ -42,6 +135,8 @@ X --> ReduceMean --> Sub --> Pow --> ReduceMean --> Add --> Sqrt --> Div --> Mul
 |                     ^
 |                     |
 +---------------------+
+The TF-Keras form, which computes X * scale + (beta - mean * scale) with scale = gamma / sqrt(variance + epsilon), is
+matched with GetKerasLayerNormPattern.
 */
 Status LayerNormFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
   GraphViewer graph_viewer(graph);
@@ -56,6 +151,13 @@ Status LayerNormFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     Node& reduce_mean_node = *p_reduce_mean;
     ORT_RETURN_IF_ERROR(Recurse(reduce_mean_node, modified, graph_level, logger));
 
+    // the node may also be the final Add of the TF-Keras form
+    if (graph_utils::IsSupportedProvider(reduce_mean_node, GetCompatibleExecutionProviders()) &&
+        FuseKerasLayerNorm(graph, reduce_mean_node)) {
+      modified = true;
+      continue;
+    }
+
     if (!graph_utils::IsSupportedOptypeVersionAndDomain(reduce_mean_node, "ReduceMean", {1, 11}) ||
         !graph_utils::IsSupportedProvider(reduce_mean_node, GetCompatibleExecutionProviders()) ||
         (reduce_mean_node.GetOutputEdgesCount() != 1 && reduce_mean_node.GetOutputEdgesCount() != 2) ||
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/linear_classifier_fusion.h"
+#include "core/graph/graph_utils.h"
+
+#include <algorithm>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+static bool HasFloatInput(const Node& node) {
+  const auto* input = node.InputDefs()[0];
+  return input->Type() != nullptr && *input->Type() == "tensor(float)";
+}
+
+// Returns true if the node is a preprocessing op supported by the FusedLinearClassifier kernel.
+static bool IsFusableStep(const Node& node) {
+  return (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Scaler", {1}, kMLDomain) ||
+          graph_utils::IsSupportedOptypeVersionAndDomain(node, "Normalizer", {1}, kMLDomain) ||
+          graph_utils::IsSupportedOptypeVersionAndDomain(node, "Binarizer", {1}, kMLDomain)) &&
+         HasFloatInput(node);
+}
+
+Status LinearClassifierFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                         const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed as part of an earlier fusion
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "LinearClassifier", {1}, kMLDomain) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    // walk up the preprocessing ops feeding the classifier
+    std::vector<std::reference_wrapper<Node>> nodes;
+    std::vector<std::string> steps;
+    const Node* current = &node;
+    while (true) {
+      const Node* producer = graph_utils::GetInputNode(*current, 0);
+      if (producer == nullptr || !IsFusableStep(*producer) ||
+          producer->GetExecutionProviderType() != node.GetExecutionProviderType() ||
+          producer->GetOutputEdgesCount() != 1 || !graph.GetNodeOutputsInGraphOutputs(*producer).empty() ||
+          std::find(steps.begin(), steps.end(), producer->OpType()) != steps.end()) {
+        break;
+      }
+      nodes.push_back(*graph.GetNode(producer->Index()));
+      steps.push_back(producer->OpType());
+      current = producer;
+    }
+    if (nodes.empty()) {
+      continue;
+    }
+
+    std::reverse(nodes.begin(), nodes.end());
+    std::reverse(steps.begin(), steps.end());
+    nodes.push_back(node);
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedLinearClassifier"),
+                                     "FusedLinearClassifier",
+                                     "fused preprocessing and " + node.Name(),
+                                     {nodes.front().get().MutableInputDefs()[0]},
+                                     {},
+                                     &node.GetAttributes(),
+                                     kMSDomain);
+    fused_node.AddAttribute("steps", steps);
+
+    // the attributes of the preprocessing ops have distinct names, and keep them
+    for (size_t i = 0; i + 1 < nodes.size(); ++i) {
+      for (const auto& attr : nodes[i].get().GetAttributes()) {
+        fused_node.AddAttribute(attr.first, attr.second);
+      }
+    }
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, nodes, fused_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class LinearClassifierFusion
+
+Fuses the Scaler, Normalizer and Binarizer ops (ai.onnx.ml) feeding a LinearClassifier, as in the pipelines exported
+from scikit-learn, into a single FusedLinearClassifier node. The fused kernel preprocesses and scores the rows one block
+at a time instead of writing a full tensor for each op.
+Each preprocessing op can appear once in the chain and its output must only be read by the next op of the chain.
+*/
+class LinearClassifierFusion : public GraphTransformer {
+ public:
+  LinearClassifierFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("LinearClassifierFusion", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
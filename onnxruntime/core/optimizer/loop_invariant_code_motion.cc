@@ -0,0 +1,152 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/loop_invariant_code_motion.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Ops whose outputs differ between two runs with the same inputs and attributes.
+const std::unordered_set<std::string> kNondeterministicOps = {"RandomNormal", "RandomUniform", "RandomNormalLike",
+                                                             "RandomUniformLike", "Multinomial", "Dropout",
+                                                             "TrainableDropout"};
+
+bool IsCandidate(const Node& node) {
+  const auto& domain = node.Domain();
+  if ((domain != kOnnxDomain && domain != kOnnxDomainAlias && domain != kMSDomain) ||
+      kNondeterministicOps.count(node.OpType()) != 0 || node.ContainsSubgraph() || node.OutputDefs().empty()) {
+    return false;
+  }
+  return true;
+}
+
+// Returns true if the name refers to a value in `graph` or in any of its outer scopes.
+bool IsVisibleName(const Graph& graph, const std::string& name) {
+  for (const Graph* scope = &graph; scope != nullptr; scope = scope->ParentGraph()) {
+    if (scope->GetNodeArg(name) != nullptr) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Moves the invariant nodes of `body` to `graph`. Returns the number of nodes moved.
+int HoistInvariantNodes(Graph& graph, Graph& body, const std::unordered_set<std::string>& compatible_providers) {
+  // the values of the body that change between iterations: its inputs and the outputs of the nodes left in it
+  std::unordered_set<std::string> variant_values;
+  for (const auto* input : body.GetInputs()) {
+    variant_values.insert(input->Name());
+  }
+  std::unordered_set<std::string> body_outputs;
+  for (const auto* output : body.GetOutputs()) {
+    body_outputs.insert(output->Name());
+  }
+
+  GraphViewer body_viewer(body);
+  int hoisted_count = 0;
+  for (auto node_index : body_viewer.GetNodesInTopologicalOrder()) {
+    auto* node = body.GetNode(node_index);
+    if (node == nullptr) {
+      continue;
+    }
+
+    bool is_invariant = IsCandidate(*node) && graph_utils::IsSupportedProvider(*node, compatible_providers);
+    for (const auto* input_def : node->InputDefs()) {
+      is_invariant = is_invariant && (!input_def->Exists() || variant_values.count(input_def->Name()) == 0);
+    }
+    // the outputs become values of `graph`, so their names must not be used there or in its outer scopes.
+    // outputs of the body must be produced by a node of the body.
+    for (const auto* output_def : node->OutputDefs()) {
+      is_invariant = is_invariant && (!output_def->Exists() || (body_outputs.count(output_def->Name()) == 0 &&
+                                                                !IsVisibleName(graph, output_def->Name())));
+    }
+
+    if (!is_invariant) {
+      for (const auto* output_def : node->OutputDefs()) {
+        if (output_def->Exists()) {
+          variant_values.insert(output_def->Name());
+        }
+      }
+      continue;
+    }
+
+    // initializers of the body are copied to `graph` under a new name, the other inputs are outer scope values or
+    // outputs of the nodes moved before this one, which `graph` already sees with the same name.
+    std::vector<NodeArg*> input_defs;
+    for (const auto* input_def : node->InputDefs()) {
+      const TensorProto* initializer = nullptr;
+      if (input_def->Exists() && body.GetInitializedTensor(input_def->Name(), initializer)) {
+        TensorProto hoisted_initializer(*initializer);
+        hoisted_initializer.set_name(graph.GenerateNodeArgName(input_def->Name()));
+        graph.AddInitializedTensor(hoisted_initializer);
+        input_defs.push_back(&graph.GetOrCreateNodeArg(hoisted_initializer.name(), input_def->TypeAsProto()));
+      } else {
+        input_defs.push_back(&graph.GetOrCreateNodeArg(input_def->Name(), input_def->TypeAsProto()));
+      }
+    }
+    std::vector<NodeArg*> output_defs;
+    for (const auto* output_def : node->OutputDefs()) {
+      output_defs.push_back(&graph.GetOrCreateNodeArg(output_def->Name(), output_def->TypeAsProto()));
+    }
+
+    Node& hoisted_node = graph.AddNode(graph.GenerateNodeName(node->Name()),
+                                       node->OpType(),
+                                       node->Description(),
+                                       input_defs,
+                                       output_defs,
+                                       &node->GetAttributes(),
+                                       node->Domain());
+    hoisted_node.SetExecutionProviderType(node->GetExecutionProviderType());
+
+    // the consumers in the body keep their NodeArgs, which now resolve to the outer scope values
+    graph_utils::RemoveNodeOutputEdges(body, *node);
+    body.RemoveNode(node_index);
+    hoisted_count++;
+  }
+
+  return hoisted_count;
+}
+
+}  // namespace
+
+Status LoopInvariantCodeMotion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                          const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  int hoisted_count = 0;
+  for (auto node_index : node_topology_list) {
+    auto* node = graph.GetNode(node_index);
+    if (node == nullptr) {
+      continue;
+    }
+
+    // the nodes of nested loops are moved to the body of this node first, so they can be moved out of it as well
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(*node, "Loop", {1, 11}) &&
+        !graph_utils::IsSupportedOptypeVersionAndDomain(*node, "Scan", {8, 9, 11})) {
+      continue;
+    }
+
+    for (auto& body : node->MutableSubgraphs()) {
+      hoisted_count += HoistInvariantNodes(graph, *body, GetCompatibleExecutionProviders());
+    }
+  }
+
+  if (hoisted_count > 0) {
+    LOGS(logger, INFO) << "Loop invariant code motion moved " << hoisted_count << " nodes out of loop bodies";
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
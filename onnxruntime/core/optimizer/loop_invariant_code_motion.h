@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class LoopInvariantCodeMotion
+
+Moves the nodes of Loop and Scan bodies that compute the same value on every iteration into the graph containing the
+Loop or Scan node, so they run once instead of once per iteration. A node is invariant if all its inputs are outer
+scope values, initializers of the body or outputs of other invariant nodes. The body then reads the values computed
+by the moved nodes from the outer scope.
+
+Nondeterministic ops such as RandomNormal, ops from custom domains, nodes with subgraphs and nodes producing outputs of
+the body are left alone. Nodes of If branches aren't moved either, as the branch that isn't taken doesn't run them.
+*/
+class LoopInvariantCodeMotion : public GraphTransformer {
+ public:
+  LoopInvariantCodeMotion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("LoopInvariantCodeMotion", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
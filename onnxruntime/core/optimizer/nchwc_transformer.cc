@@ -106,7 +106,7 @@ class NchwcTransformerImpl {
   size_t RemoveOutputEdges(Node& node);
   void CreateNchwcArgument(Node& node, Node& nchwc_node, int64_t channels, const NchwcArgument::Shape& shape);
   void FuseNchwcArgument(Node& node, const NchwcArgument& nchwc_arg);
-  void InsertReorderInput(Node& node);
+  void InsertReorderInput(Node& nchwc_node, const Node& node);
 
   void ConvPoolShapeInference(const Node& node,
                               const NchwcArgument::Shape& input_shape,
@@ -135,6 +135,11 @@ class NchwcTransformerImpl {
   // multiple nodes can share the NCHWc input.
   std::unordered_map<NodeArg*, NodeArg*> reorder_inputs_;
 
+  // Stores the number of uses of each NHWC to NCHW Transpose output that now
+  // reorder directly from the NHWC input. The Transpose is removed if all of
+  // its uses have been replaced.
+  std::unordered_map<NodeIndex, size_t> nhwc_transpose_uses_;
+
   // Stores a mapping of NodeArg filters that have already been reordered, so
   // multiple nodes can share the NCHWc filter.
   std::unordered_map<NodeArg*, NodeArg*> filters_OIHWBo_;
@@ -185,23 +190,55 @@ void NchwcTransformerImpl::FuseNchwcArgument(Node& node, const NchwcArgument& nc
       onnxruntime::make_unique<NchwcArgument>(nchwc_node, output_nchwc_arg, original_uses, nchwc_arg.channels_, nchwc_arg.shape_);
 }
 
-void NchwcTransformerImpl::InsertReorderInput(Node& node) {
-  auto& input_defs = node.MutableInputDefs();
+// Returns true if the node transposes from NHWC to NCHW layout order.
+static bool IsTransposeFromNhwc(const Node& node) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Transpose", {1}) ||
+      node.GetExecutionProviderType() != kCpuExecutionProvider) {
+    return false;
+  }
+
+  const auto* perm_attr = graph_utils::GetNodeAttribute(node, "perm");
+  if (perm_attr == nullptr || perm_attr->ints_size() != 4) {
+    return false;
+  }
+
+  const int64_t* perm_data = perm_attr->ints().data();
+  return perm_data[0] == 0 && perm_data[1] == 3 && perm_data[2] == 1 && perm_data[3] == 2;
+}
+
+void NchwcTransformerImpl::InsertReorderInput(Node& nchwc_node, const Node& node) {
+  auto& input_defs = nchwc_node.MutableInputDefs();
   auto* input_original_arg = input_defs[0];
 
+  // Models converted from NHWC frameworks transpose the input of the first
+  // convolution to NCHW. Reorder directly from the NHWC tensor instead, so
+  // that the Transpose can be removed.
+  const Node* input_node = graph_utils::GetInputNode(node, 0);
+  const bool is_nhwc_input = input_node != nullptr && IsTransposeFromNhwc(*input_node);
+  if (is_nhwc_input) {
+    nhwc_transpose_uses_[input_node->Index()]++;
+  }
+
   auto it = reorder_inputs_.find(input_original_arg);
   if (it == reorder_inputs_.end()) {
     std::string input_reorder_def_name = graph_.GenerateNodeArgName("reorder");
     auto* input_nchwc_arg = &graph_.GetOrCreateNodeArg(input_reorder_def_name, nullptr);
     reorder_inputs_[input_original_arg] = input_nchwc_arg;
+    auto* input_source_arg = input_original_arg;
+    if (is_nhwc_input) {
+      input_source_arg = graph_.GetNode(input_node->Index())->MutableInputDefs()[0];
+    }
     Node& reorder_input_node = graph_.AddNode(graph_.GenerateNodeName("ReorderInput"),
                                               "ReorderInput",
                                               "ReorderInput",
-                                              {input_original_arg},
+                                              {input_source_arg},
                                               {input_nchwc_arg},
                                               nullptr,
                                               kMSNchwcDomain);
     reorder_input_node.SetExecutionProviderType(kCpuExecutionProvider);
+    if (is_nhwc_input) {
+      reorder_input_node.AddAttribute("channels_last", static_cast<int64_t>(1));
+    }
     input_defs[0] = input_nchwc_arg;
   } else {
     input_defs[0] = it->second;
@@ -441,7 +478,7 @@ void NchwcTransformerImpl::TransformConv(Node& node) {
   if (do_reorder_input) {
     auto it = nchwc_args_.find(input_defs[0]);
     if (it == nchwc_args_.end()) {
-      InsertReorderInput(nchwc_node);
+      InsertReorderInput(nchwc_node, node);
     } else {
       auto* nchwc_input = it->second.get();
       nchwc_node.MutableInputDefs()[0] = nchwc_input->nchwc_arg_;
@@ -493,7 +530,7 @@ void NchwcTransformerImpl::TransformPool(Node& node) {
 
   auto it = nchwc_args_.find(input_defs[0]);
   if (it == nchwc_args_.end()) {
-    InsertReorderInput(nchwc_node);
+    InsertReorderInput(nchwc_node, node);
   } else {
     auto* nchwc_input = it->second.get();
     nchwc_node.MutableInputDefs()[0] = nchwc_input->nchwc_arg_;
@@ -982,6 +1019,17 @@ void NchwcTransformerImpl::Finalize(bool& modified) {
     }
   }
 
+  // Remove the NHWC to NCHW Transpose nodes whose uses all reorder directly
+  // from the NHWC input.
+  for (auto& nhwc_transpose : nhwc_transpose_uses_) {
+    auto& transpose_node = *graph_.GetNode(nhwc_transpose.first);
+    if (transpose_node.GetOutputEdgesCount() == nhwc_transpose.second &&
+        graph_.GetNodeOutputsInGraphOutputs(transpose_node).empty()) {
+      graph_utils::RemoveNodeOutputEdges(graph_, transpose_node);
+      removed_nodes_.push_front(transpose_node.Index());
+    }
+  }
+
   for (auto index : removed_nodes_) {
     graph_.RemoveNode(index);
   }
@@ -0,0 +1,373 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/qdq_fusion.h"
+
+#include <cmath>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// An input of the node replacing a pattern, with the node output it is read from if any.
+struct FusedInput {
+  NodeArg* arg{nullptr};
+  bool has_producer{false};
+  NodeIndex producer{0};
+  int producer_output{0};
+};
+
+FusedInput GetFusedInput(Node& node, int index) {
+  FusedInput input;
+  input.arg = node.MutableInputDefs()[index];
+  const auto* edge = graph_utils::GetInputEdge(node, index);
+  if (edge != nullptr) {
+    input.has_producer = true;
+    input.producer = edge->GetNode().Index();
+    input.producer_output = edge->GetSrcArgIndex();
+  }
+  return input;
+}
+
+FusedInput AddInitializerInput(Graph& graph, const TensorProto& tensor_proto) {
+  FusedInput input;
+  input.arg = &graph_utils::AddInitializer(graph, tensor_proto);
+  return input;
+}
+
+int32_t GetElementType(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() ? type->tensor_type().elem_type()
+                                                    : TensorProto_DataType_UNDEFINED;
+}
+
+bool IsSingleElement(const NodeArg& arg) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return false;
+  }
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim) || dim.dim_value() != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HasZeroPoint(const Node& node) {
+  return node.InputDefs().size() > 2 && node.InputDefs()[2]->Exists();
+}
+
+// Per-tensor quantization has a single scale and zero point.
+bool IsPerTensor(const Node& node) {
+  return IsSingleElement(*node.InputDefs()[1]) && (!HasZeroPoint(node) || IsSingleElement(*node.InputDefs()[2]));
+}
+
+bool GetConstantScalar(const Graph& graph, const NodeArg& arg, float& value) {
+  const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, arg.Name());
+  if (tensor_proto == nullptr || tensor_proto->data_type() != TensorProto_DataType_FLOAT) {
+    return false;
+  }
+  Initializer initializer{*tensor_proto, graph.ModelPath()};
+  if (initializer.size() != 1) {
+    return false;
+  }
+  value = initializer.data<float>()[0];
+  return true;
+}
+
+// The per-tensor DequantizeLinear node computing input `index` of the node, nullptr if there's none.
+Node* GetDequantizeInput(Graph& graph, const Node& node, int index,
+                         const std::unordered_set<std::string>& compatible_providers) {
+  const auto* input_node = graph_utils::GetInputNode(node, index);
+  if (input_node == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*input_node, "DequantizeLinear", {10}) ||
+      !graph_utils::IsSupportedProvider(*input_node, compatible_providers) || !IsPerTensor(*input_node)) {
+    return nullptr;
+  }
+  return graph.GetNode(input_node->Index());
+}
+
+// The per-tensor uint8 QuantizeLinear node which is the only reader of the node's output, nullptr if there's none.
+Node* GetQuantizeOutput(Graph& graph, const Node& node, const std::unordered_set<std::string>& compatible_providers) {
+  if (node.GetOutputEdgesCount() != 1 || node.OutputEdgesBegin()->GetDstArgIndex() != 0 ||
+      !graph.GetNodeOutputsInGraphOutputs(node).empty()) {
+    return nullptr;
+  }
+  const auto& output_node = node.OutputEdgesBegin()->GetNode();
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(output_node, "QuantizeLinear", {10}) ||
+      !graph_utils::IsSupportedProvider(output_node, compatible_providers) || !IsPerTensor(output_node) ||
+      GetElementType(*output_node.OutputDefs()[0]) != TensorProto_DataType_UINT8) {
+    return nullptr;
+  }
+  return graph.GetNode(output_node.Index());
+}
+
+// The zero point input of a DequantizeLinear or QuantizeLinear node, which defaults to 0.
+FusedInput GetZeroPoint(Graph& graph, Node& node, int32_t quantized_type) {
+  if (HasZeroPoint(node)) {
+    return GetFusedInput(node, 2);
+  }
+  TensorProto zero_point;
+  zero_point.set_name(graph.GenerateNodeArgName(node.Name() + "_zero_point"));
+  zero_point.set_data_type(quantized_type);
+  zero_point.set_raw_data(std::string(1, '\0'));
+  return AddInitializerInput(graph, zero_point);
+}
+
+FusedInput AddFloatScalar(Graph& graph, const std::string& name, float value) {
+  TensorProto scalar;
+  scalar.set_name(graph.GenerateNodeArgName(name));
+  scalar.set_data_type(TensorProto_DataType_FLOAT);
+  scalar.add_float_data(value);
+  return AddInitializerInput(graph, scalar);
+}
+
+// The (node, input index) pairs reading the first output of the node.
+std::vector<std::pair<NodeIndex, int>> GetConsumers(const Node& node) {
+  std::vector<std::pair<NodeIndex, int>> consumers;
+  for (auto it = node.OutputEdgesBegin(); it != node.OutputEdgesEnd(); ++it) {
+    if (it->GetSrcArgIndex() == 0) {
+      consumers.emplace_back(it->GetNode().Index(), it->GetDstArgIndex());
+    }
+  }
+  return consumers;
+}
+
+void RemoveNodes(Graph& graph, const std::vector<Node*>& nodes) {
+  for (auto* node : nodes) {
+    graph_utils::RemoveNodeOutputEdges(graph, *node);
+    graph.RemoveNode(node->Index());
+  }
+}
+
+void RemoveIfUnused(Graph& graph, const std::vector<NodeIndex>& node_indexes) {
+  for (auto node_index : node_indexes) {
+    auto* node = graph.GetNode(node_index);
+    if (node != nullptr && node->GetOutputEdgesCount() == 0 && graph.GetNodeOutputsInGraphOutputs(*node).empty()) {
+      graph.RemoveNode(node_index);
+    }
+  }
+}
+
+Node& AddFusedNode(Graph& graph, const std::string& base_name, const std::string& op_type,
+                   const std::vector<FusedInput>& inputs, NodeArg& output, const NodeAttributes* attributes,
+                   const std::string& provider) {
+  std::vector<NodeArg*> input_args;
+  for (const auto& input : inputs) {
+    input_args.push_back(input.arg);
+  }
+  auto& node = graph.AddNode(graph.GenerateNodeName(base_name), op_type, "Fused " + op_type + " from QDQ pattern",
+                             input_args, {&output}, attributes);
+  node.SetExecutionProviderType(provider);
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (inputs[i].has_producer) {
+      graph.AddEdge(inputs[i].producer, node.Index(), inputs[i].producer_output, static_cast<int>(i));
+    }
+  }
+  return node;
+}
+
+void ConnectConsumers(Graph& graph, const Node& node, const std::vector<std::pair<NodeIndex, int>>& consumers) {
+  for (const auto& consumer : consumers) {
+    graph.AddEdge(node.Index(), consumer.first, 0, consumer.second);
+  }
+}
+
+// The int32 bias of a QLinearConv: either the input of a DequantizeLinear or a float constant quantized with
+// x_scale * w_scale. Returns false if the bias can't be given in int32.
+bool GetQuantizedBias(Graph& graph, const Node& conv, const Node& dq_x, const Node& dq_w,
+                      const std::unordered_set<std::string>& compatible_providers, Node*& dq_bias,
+                      std::vector<int32_t>& quantized_bias) {
+  dq_bias = GetDequantizeInput(graph, conv, 2, compatible_providers);
+  if (dq_bias != nullptr) {
+    if (GetElementType(*dq_bias->InputDefs()[0]) != TensorProto_DataType_INT32) {
+      return false;
+    }
+    if (!HasZeroPoint(*dq_bias)) {
+      return true;
+    }
+    const auto* zero_point = graph_utils::GetConstantInitializer(graph, dq_bias->InputDefs()[2]->Name());
+    return zero_point != nullptr && Initializer{*zero_point, graph.ModelPath()}.data<int32_t>()[0] == 0;
+  }
+
+  const auto* bias = graph_utils::GetConstantInitializer(graph, conv.InputDefs()[2]->Name());
+  float x_scale;
+  float w_scale;
+  if (bias == nullptr || bias->data_type() != TensorProto_DataType_FLOAT ||
+      !GetConstantScalar(graph, *dq_x.InputDefs()[1], x_scale) ||
+      !GetConstantScalar(graph, *dq_w.InputDefs()[1], w_scale) || x_scale * w_scale == 0.f) {
+    return false;
+  }
+  Initializer bias_values{*bias, graph.ModelPath()};
+  const float bias_scale = x_scale * w_scale;
+  quantized_bias.resize(bias_values.size());
+  for (size_t i = 0; i < quantized_bias.size(); ++i) {
+    quantized_bias[i] = static_cast<int32_t>(std::nearbyint(bias_values.data<float>()[i] / bias_scale));
+  }
+  return true;
+}
+
+bool FuseConv(Graph& graph, Node& conv, const std::unordered_set<std::string>& compatible_providers) {
+  auto* dq_x = GetDequantizeInput(graph, conv, 0, compatible_providers);
+  auto* dq_w = GetDequantizeInput(graph, conv, 1, compatible_providers);
+  auto* q = GetQuantizeOutput(graph, conv, compatible_providers);
+  if (dq_x == nullptr || dq_w == nullptr || q == nullptr ||
+      GetElementType(*dq_x->InputDefs()[0]) != TensorProto_DataType_UINT8 ||
+      GetElementType(*dq_w->InputDefs()[0]) != TensorProto_DataType_UINT8) {
+    return false;
+  }
+
+  const bool has_bias = conv.InputDefs().size() > 2 && conv.InputDefs()[2]->Exists();
+  Node* dq_bias = nullptr;
+  std::vector<int32_t> quantized_bias;
+  if (has_bias && !GetQuantizedBias(graph, conv, *dq_x, *dq_w, compatible_providers, dq_bias, quantized_bias)) {
+    return false;
+  }
+
+  std::vector<FusedInput> inputs{GetFusedInput(*dq_x, 0),
+                                 GetFusedInput(*dq_x, 1),
+                                 GetZeroPoint(graph, *dq_x, TensorProto_DataType_UINT8),
+                                 GetFusedInput(*dq_w, 0),
+                                 GetFusedInput(*dq_w, 1),
+                                 GetZeroPoint(graph, *dq_w, TensorProto_DataType_UINT8),
+                                 GetFusedInput(*q, 1),
+                                 GetZeroPoint(graph, *q, TensorProto_DataType_UINT8)};
+  std::vector<NodeIndex> dq_nodes{dq_x->Index(), dq_w->Index()};
+  if (dq_bias != nullptr) {
+    inputs.push_back(GetFusedInput(*dq_bias, 0));
+    dq_nodes.push_back(dq_bias->Index());
+  } else if (has_bias) {
+    TensorProto bias;
+    bias.set_name(graph.GenerateNodeArgName(conv.InputDefs()[2]->Name() + "_quantized"));
+    bias.set_data_type(TensorProto_DataType_INT32);
+    bias.add_dims(static_cast<int64_t>(quantized_bias.size()));
+    bias.set_raw_data(quantized_bias.data(), quantized_bias.size() * sizeof(int32_t));
+    inputs.push_back(AddInitializerInput(graph, bias));
+  }
+
+  const auto consumers = GetConsumers(*q);
+  auto& output = *q->MutableOutputDefs()[0];
+  const std::string name = conv.Name();
+  const std::string provider = conv.GetExecutionProviderType();
+  const NodeAttributes attributes = conv.GetAttributes();
+  RemoveNodes(graph, {&conv, q});
+
+  auto& qlinear_conv = AddFusedNode(graph, name + "_quant", "QLinearConv", inputs, output, &attributes, provider);
+  ConnectConsumers(graph, qlinear_conv, consumers);
+  RemoveIfUnused(graph, dq_nodes);
+  return true;
+}
+
+bool FuseMatMul(Graph& graph, Node& matmul, const std::unordered_set<std::string>& compatible_providers) {
+  auto* dq_a = GetDequantizeInput(graph, matmul, 0, compatible_providers);
+  auto* dq_b = GetDequantizeInput(graph, matmul, 1, compatible_providers);
+  if (dq_a == nullptr || dq_b == nullptr || GetElementType(*dq_a->InputDefs()[0]) != TensorProto_DataType_UINT8) {
+    return false;
+  }
+  const int32_t b_type = GetElementType(*dq_b->InputDefs()[0]);
+  if (b_type != TensorProto_DataType_UINT8 && b_type != TensorProto_DataType_INT8) {
+    return false;
+  }
+
+  const std::string name = matmul.Name();
+  const std::string provider = matmul.GetExecutionProviderType();
+  const std::vector<NodeIndex> dq_nodes{dq_a->Index(), dq_b->Index()};
+
+  auto* q = GetQuantizeOutput(graph, matmul, compatible_providers);
+  if (q != nullptr) {
+    const std::vector<FusedInput> inputs{GetFusedInput(*dq_a, 0),
+                                         GetFusedInput(*dq_a, 1),
+                                         GetZeroPoint(graph, *dq_a, TensorProto_DataType_UINT8),
+                                         GetFusedInput(*dq_b, 0),
+                                         GetFusedInput(*dq_b, 1),
+                                         GetZeroPoint(graph, *dq_b, b_type),
+                                         GetFusedInput(*q, 1),
+                                         GetZeroPoint(graph, *q, TensorProto_DataType_UINT8)};
+    const auto consumers = GetConsumers(*q);
+    auto& output = *q->MutableOutputDefs()[0];
+    RemoveNodes(graph, {&matmul, q});
+
+    auto& qlinear_matmul = AddFusedNode(graph, name + "_quant", "QLinearMatMul", inputs, output, nullptr, provider);
+    ConnectConsumers(graph, qlinear_matmul, consumers);
+    RemoveIfUnused(graph, dq_nodes);
+    return true;
+  }
+
+  // The float output is kept, so the int32 result is scaled back with the constant input scales.
+  float a_scale;
+  float b_scale;
+  if (!GetConstantScalar(graph, *dq_a->InputDefs()[1], a_scale) ||
+      !GetConstantScalar(graph, *dq_b->InputDefs()[1], b_scale)) {
+    return false;
+  }
+  const std::vector<FusedInput> inputs{GetFusedInput(*dq_a, 0), GetFusedInput(*dq_b, 0),
+                                       GetZeroPoint(graph, *dq_a, TensorProto_DataType_UINT8),
+                                       GetZeroPoint(graph, *dq_b, b_type)};
+  const FusedInput scale = AddFloatScalar(graph, name + "_scale", a_scale * b_scale);
+  const auto consumers = GetConsumers(matmul);
+  auto& output = *matmul.MutableOutputDefs()[0];
+  RemoveNodes(graph, {&matmul});
+
+  TypeProto int32_type;
+  int32_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  auto& int32_output = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(name + "_int32"), &int32_type);
+  auto& matmul_integer = AddFusedNode(graph, name + "_quant", "MatMulInteger", inputs, int32_output, nullptr, provider);
+
+  TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto& float_output = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(name + "_float"), &float_type);
+  FusedInput cast_input{&int32_output, true, matmul_integer.Index(), 0};
+  auto& cast = AddFusedNode(graph, name + "_cast", "Cast", {cast_input}, float_output, nullptr, provider);
+  cast.AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_FLOAT));
+
+  FusedInput mul_input{&float_output, true, cast.Index(), 0};
+  auto& mul = AddFusedNode(graph, name + "_rescale", "Mul", {mul_input, scale}, output, nullptr, provider);
+  ConnectConsumers(graph, mul, consumers);
+  RemoveIfUnused(graph, dq_nodes);
+  return true;
+}
+
+}  // namespace
+
+Status QDQFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  int fused_count = 0;
+  for (auto node_index : node_topology_list) {
+    auto* node = graph.GetNode(node_index);
+    if (node == nullptr) {
+      continue;  // node was removed
+    }
+
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    bool fused = false;
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(*node, "Conv", {1, 11})) {
+      fused = FuseConv(graph, *node, GetCompatibleExecutionProviders());
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(*node, "MatMul", {1, 9})) {
+      fused = FuseMatMul(graph, *node, GetCompatibleExecutionProviders());
+    }
+
+    if (fused) {
+      fused_count++;
+      modified = true;
+    }
+  }
+
+  LOGS(logger, INFO) << "Fused " << fused_count << " QDQ patterns into integer kernels";
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class QDQFusion
+
+Rewrites the DequantizeLinear -> op -> QuantizeLinear patterns of models quantized with QDQ pairs so that the op runs
+with integer kernels instead of float ones:
+  - DQ(x), DQ(w) -> Conv [-> bias] -> Q becomes QLinearConv, with a float constant bias quantized to int32.
+  - DQ(a), DQ(b) -> MatMul -> Q becomes QLinearMatMul.
+  - DQ(a), DQ(b) -> MatMul whose float output isn't quantized becomes MatMulInteger -> Cast -> Mul by the product of
+    the constant scales.
+The inputs must be per-tensor quantized with the types supported by the CPU kernels (uint8 inputs, uint8 or int8
+MatMul weights). The DequantizeLinear nodes are removed once nothing else reads them.
+*/
+class QDQFusion : public GraphTransformer {
+ public:
+  QDQFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("QDQFusion", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/rule_based_graph_transformer.h"
+#include "core/common/profiler.h"
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/rewrite_rule.h"
 
@@ -29,8 +30,31 @@ Status RuleBasedGraphTransformer::Register(std::unique_ptr<RewriteRule> rule) {
 Status RuleBasedGraphTransformer::ApplyRulesOnNode(Graph& graph, Node& node,
                                                    const std::vector<std::reference_wrapper<const RewriteRule>>& rules,
                                                    RuleEffect& rule_effect, const logging::Logger& logger) const {
+  auto* profiler = EnabledProfiler();
   for (const RewriteRule& rule : rules) {
-    ORT_RETURN_IF_ERROR(rule.CheckConditionAndApply(graph, node, rule_effect, logger));
+    // the node may be removed by the rule so take its name first
+    TimePoint start_time;
+    std::string node_name;
+    int num_nodes = 0;
+    if (profiler != nullptr) {
+      start_time = profiler->StartTime();
+      node_name = node.Name();
+      num_nodes = graph.NumberOfNodes();
+    }
+
+    auto effect = RuleEffect::kNone;
+    ORT_RETURN_IF_ERROR(rule.CheckConditionAndApply(graph, node, effect, logger));
+    if (effect == RuleEffect::kNone) {
+      continue;
+    }
+    rule_effect = effect;
+
+    if (profiler != nullptr) {
+      profiler->EndTimeAndRecordEvent(profiling::SESSION_EVENT, Name() + "/" + rule.Name(), start_time,
+                                      {{"node_name", node_name},
+                                       {"node_count_change", std::to_string(graph.NumberOfNodes() - num_nodes)}});
+    }
+
     // If the current node was removed as a result of a rule, stop rule application for that node.
     if (rule_effect == RuleEffect::kRemovedCurrentNode) {
       break;
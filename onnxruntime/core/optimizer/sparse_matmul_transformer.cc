@@ -0,0 +1,185 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/sparse_matmul_transformer.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+// Minimum fraction of zeros in a weight for the SparseMatMul kernel to be faster than the dense GEMM of MLAS.
+static constexpr float kMinSparsity = 0.8f;
+
+static float GetFloatAttribute(const Node& node, const std::string& name, float default_value) {
+  const auto& attributes = node.GetAttributes();
+  auto it = attributes.find(name);
+  return it != attributes.end() ? it->second.f() : default_value;
+}
+
+static int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto& attributes = node.GetAttributes();
+  auto it = attributes.find(name);
+  return it != attributes.end() ? it->second.i() : default_value;
+}
+
+// A float weight in CSR form. The rows are the rows of B as used by the product, so a transposed B is transposed back.
+struct CsrWeight {
+  int64_t num_rows = 0;
+  int64_t num_cols = 0;
+  std::vector<float> values;
+  std::vector<int32_t> col_indices;
+  std::vector<int64_t> row_offsets;
+};
+
+// Converts `weight` to CSR form if it's a 2-D float matrix with enough zeros. The values are scaled by `alpha`.
+static bool ToSparseWeight(const Graph& graph, const TensorProto& weight, bool transposed, float alpha,
+                           CsrWeight& csr) {
+  if (weight.data_type() != TensorProto_DataType_FLOAT || weight.dims_size() != 2) {
+    return false;
+  }
+
+  const int64_t rows = weight.dims(0);
+  const int64_t cols = weight.dims(1);
+  const int64_t size = rows * cols;
+  if (size == 0 || (transposed ? rows : cols) > std::numeric_limits<int32_t>::max()) {
+    return false;
+  }
+
+  Initializer initializer{weight, graph.ModelPath()};
+  const float* data = initializer.data<float>();
+  const auto num_zeros = std::count(data, data + size, 0.0f);
+  if (static_cast<float>(num_zeros) < kMinSparsity * static_cast<float>(size)) {
+    return false;
+  }
+
+  csr.num_rows = transposed ? cols : rows;
+  csr.num_cols = transposed ? rows : cols;
+  csr.values.reserve(static_cast<size_t>(size - num_zeros));
+  csr.col_indices.reserve(static_cast<size_t>(size - num_zeros));
+  csr.row_offsets.reserve(static_cast<size_t>(csr.num_rows + 1));
+  csr.row_offsets.push_back(0);
+  for (int64_t row = 0; row < csr.num_rows; ++row) {
+    for (int64_t col = 0; col < csr.num_cols; ++col) {
+      const float value = transposed ? data[col * cols + row] : data[row * cols + col];
+      if (value != 0.0f) {
+        csr.values.push_back(alpha * value);
+        csr.col_indices.push_back(static_cast<int32_t>(col));
+      }
+    }
+    csr.row_offsets.push_back(static_cast<int64_t>(csr.values.size()));
+  }
+
+  return true;
+}
+
+template <typename T>
+static NodeArg& AddVectorInitializer(Graph& graph, const std::string& name, TensorProto_DataType data_type,
+                                     const std::vector<T>& data) {
+  TensorProto initializer;
+  initializer.set_name(graph.GenerateNodeArgName(name));
+  initializer.set_data_type(data_type);
+  initializer.add_dims(static_cast<int64_t>(data.size()));
+  initializer.set_raw_data(data.data(), data.size() * sizeof(T));
+  return graph_utils::AddInitializer(graph, initializer);
+}
+
+// Gets the bias of a Gemm scaled by beta, if it's a constant with a value per column or a single value.
+static bool GetGemmBias(const Graph& graph, const Node& gemm, int64_t num_cols, std::vector<float>& bias) {
+  const auto& input_defs = gemm.InputDefs();
+  const float beta = GetFloatAttribute(gemm, "beta", 1.0f);
+  if (input_defs.size() < 3 || !input_defs[2]->Exists() || beta == 0.0f) {
+    return true;
+  }
+
+  const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, input_defs[2]->Name());
+  if (tensor_proto == nullptr || tensor_proto->data_type() != TensorProto_DataType_FLOAT) {
+    return false;
+  }
+
+  Initializer initializer{*tensor_proto, graph.ModelPath()};
+  const int64_t size = initializer.size();
+  const bool is_row = tensor_proto->dims_size() <= 2 && size == num_cols &&
+                      (tensor_proto->dims_size() < 2 || tensor_proto->dims(0) == 1);
+  if (size != 1 && !is_row) {
+    return false;
+  }
+
+  const float* data = initializer.data<float>();
+  bias.resize(static_cast<size_t>(num_cols));
+  for (int64_t i = 0; i < num_cols; ++i) {
+    bias[i] = beta * data[size == 1 ? 0 : i];
+  }
+  return true;
+}
+
+Status SparseMatMulTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                          const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    const bool is_matmul = graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9});
+    const bool is_gemm = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gemm", {7, 9, 11});
+    if ((!is_matmul && !is_gemm) || !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const auto* a_type = node.InputDefs()[0]->TypeAsProto();
+    if (a_type == nullptr || a_type->tensor_type().elem_type() != TensorProto_DataType_FLOAT) {
+      continue;
+    }
+
+    const auto* weight = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+    if (weight == nullptr || (is_gemm && GetIntAttribute(node, "transA", 0) != 0)) {
+      continue;
+    }
+
+    const bool transposed = is_gemm && GetIntAttribute(node, "transB", 0) != 0;
+    const float alpha = is_gemm ? GetFloatAttribute(node, "alpha", 1.0f) : 1.0f;
+    CsrWeight csr;
+    std::vector<float> bias;
+    if (!ToSparseWeight(graph, *weight, transposed, alpha, csr) ||
+        (is_gemm && !GetGemmBias(graph, node, csr.num_cols, bias))) {
+      continue;
+    }
+
+    const auto& weight_name = node.InputDefs()[1]->Name();
+    std::vector<NodeArg*> input_defs{
+        node.MutableInputDefs()[0],
+        &AddVectorInitializer(graph, weight_name + "_values", TensorProto_DataType_FLOAT, csr.values),
+        &AddVectorInitializer(graph, weight_name + "_col_indices", TensorProto_DataType_INT32, csr.col_indices),
+        &AddVectorInitializer(graph, weight_name + "_row_offsets", TensorProto_DataType_INT64, csr.row_offsets)};
+    if (!bias.empty()) {
+      input_defs.push_back(&AddVectorInitializer(graph, weight_name + "_bias", TensorProto_DataType_FLOAT, bias));
+    }
+
+    Node& sparse_matmul = graph.AddNode(graph.GenerateNodeName(node.Name() + "_sparse"),
+                                        "SparseMatMul",
+                                        "MatMul with a sparse weight",
+                                        input_defs,
+                                        {}, {}, kMSDomain);
+    sparse_matmul.AddAttribute("N", csr.num_cols);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    sparse_matmul.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    // the dense weight is removed with the other unused initializers if nothing else reads it
+    graph_utils::FinalizeNodeFusion(graph, {node}, sparse_matmul);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class SparseMatMulTransformer
+
+Replaces the MatMul and Gemm nodes whose weight is a constant matrix with mostly zeros, such as a pruned weight, with
+a SparseMatMul node. The weight is converted to compressed sparse row (CSR) form, the alpha of a Gemm is folded into
+its values and a constant bias of a Gemm becomes the bias of the SparseMatMul.
+*/
+class SparseMatMulTransformer : public GraphTransformer {
+ public:
+  SparseMatMulTransformer(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("SparseMatMulTransformer", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
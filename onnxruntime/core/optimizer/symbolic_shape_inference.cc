@@ -0,0 +1,783 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/symbolic_shape_inference.h"
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <unordered_set>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+
+namespace {
+
+// integer values with more elements are not tracked, they are not shapes
+constexpr size_t kMaxValueSize = 64;
+
+const std::unordered_set<std::string> kUnaryOps{
+    "Abs", "BatchNormalization", "Cast", "Ceil", "Clip", "Dropout", "Elu", "Erf", "Exp", "Floor", "HardSigmoid",
+    "Identity", "InstanceNormalization", "LeakyRelu", "Log", "LogSoftmax", "LRN", "Neg", "Not", "Reciprocal", "Relu",
+    "Selu", "Sigmoid", "Sign", "Softmax", "Softplus", "Softsign", "Sqrt", "Tanh"};
+
+const std::unordered_set<std::string> kBroadcastOps{
+    "Add", "And", "Div", "Equal", "Greater", "Less", "Max", "Mean", "Min", "Mod", "Mul", "Or", "Pow", "PRelu", "Sub",
+    "Sum", "Where", "Xor"};
+
+const std::unordered_set<std::string> kReduceOps{
+    "ReduceL1", "ReduceL2", "ReduceLogSum", "ReduceLogSumExp", "ReduceMax", "ReduceMean", "ReduceMin", "ReduceProd",
+    "ReduceSum", "ReduceSumSquare"};
+
+bool ParseInt(const std::string& text, int64_t& value) {
+  size_t begin = (!text.empty() && text[0] == '-') ? 1 : 0;
+  if (begin == text.size() || text.size() - begin > 18) {
+    return false;
+  }
+  value = 0;
+  for (size_t i = begin; i < text.size(); ++i) {
+    if (text[i] < '0' || text[i] > '9') {
+      return false;
+    }
+    value = value * 10 + (text[i] - '0');
+  }
+  if (begin == 1) {
+    value = -value;
+  }
+  return true;
+}
+
+// symbol names are anything that isn't an operator or an integer
+bool IsSymbol(const std::string& text) {
+  if (text.empty() || text[0] == '-' || (text[0] >= '0' && text[0] <= '9')) {
+    return false;
+  }
+  return std::none_of(text.begin(), text.end(), [](char c) {
+    return c == '+' || c == '*' || ::isspace(static_cast<unsigned char>(c));
+  });
+}
+
+bool MultiplyOverflows(int64_t a, int64_t b) {
+  if (a == 0 || b == 0) {
+    return false;
+  }
+  const auto max_value = std::numeric_limits<int64_t>::max();
+  return (a > 0 ? a : -a) > max_value / (b > 0 ? b : -b);
+}
+
+SymbolicShape ToSymbolicShape(const TensorShapeProto& shape_proto) {
+  SymbolicShape shape;
+  shape.reserve(shape_proto.dim_size());
+  for (const auto& dim : shape_proto.dim()) {
+    shape.push_back(DimExpr::FromDimension(dim));
+  }
+  return shape;
+}
+
+bool NormalizeAxis(int64_t axis, size_t rank, size_t& result) {
+  const auto signed_rank = static_cast<int64_t>(rank);
+  if (axis < -signed_rank || axis >= signed_rank) {
+    return false;
+  }
+  result = static_cast<size_t>(axis < 0 ? axis + signed_rank : axis);
+  return true;
+}
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, name);
+  return (attr != nullptr && attr->has_i()) ? attr->i() : default_value;
+}
+
+bool GetConstantInts(const std::vector<DimExpr>* value, std::vector<int64_t>& ints) {
+  if (value == nullptr) {
+    return false;
+  }
+  ints.clear();
+  for (const auto& element : *value) {
+    if (!element.IsConstant()) {
+      return false;
+    }
+    ints.push_back(element.ConstantValue());
+  }
+  return true;
+}
+
+DimExpr Product(const SymbolicShape& shape, size_t begin, size_t end) {
+  DimExpr product(int64_t{1});
+  for (size_t i = begin; i < end; ++i) {
+    product = product * shape[i];
+  }
+  return product;
+}
+
+// Numpy style broadcasting. A dimension is unknown when it depends on which of two symbols is 1.
+SymbolicShape Broadcast(const SymbolicShape& a, const SymbolicShape& b) {
+  const size_t rank = std::max(a.size(), b.size());
+  SymbolicShape result(rank);
+  const DimExpr one(int64_t{1});
+  for (size_t i = 0; i < rank; ++i) {
+    const DimExpr& dim_a = i < rank - a.size() ? one : a[i - (rank - a.size())];
+    const DimExpr& dim_b = i < rank - b.size() ? one : b[i - (rank - b.size())];
+    if (dim_a == one) {
+      result[i] = dim_b;
+    } else if (dim_b == one || dim_a == dim_b) {
+      result[i] = dim_a;
+    } else if (dim_a.IsConstant() && !dim_b.IsConstant()) {
+      result[i] = dim_a;
+    } else if (dim_b.IsConstant() && !dim_a.IsConstant()) {
+      result[i] = dim_b;
+    }
+  }
+  return result;
+}
+
+// Number of elements of a slice of a dimension of the given size, clamping start and end as ONNX does.
+int64_t SliceCount(int64_t dim, int64_t start, int64_t end, int64_t step) {
+  if (start < 0) start += dim;
+  if (end < 0) end += dim;
+  if (step > 0) {
+    start = std::max<int64_t>(0, std::min(start, dim));
+    end = std::max<int64_t>(0, std::min(end, dim));
+    return end > start ? (end - start + step - 1) / step : 0;
+  }
+  start = std::max<int64_t>(0, std::min(start, dim - 1));
+  end = std::max<int64_t>(-1, std::min(end, dim - 1));
+  return start > end ? (start - end - step - 1) / -step : 0;
+}
+
+int64_t SliceStart(int64_t dim, int64_t start, int64_t step) {
+  if (start < 0) start += dim;
+  return step > 0 ? std::max<int64_t>(0, std::min(start, dim)) : std::max<int64_t>(0, std::min(start, dim - 1));
+}
+
+}  // namespace
+
+DimExpr::DimExpr(int64_t value) : known_(true) {
+  AddTerm({}, value);
+}
+
+DimExpr::DimExpr(const std::string& symbol) : known_(true) {
+  AddTerm({symbol}, 1);
+}
+
+DimExpr DimExpr::FromDimParam(const std::string& dim_param) {
+  if (dim_param.empty()) {
+    return DimExpr();
+  }
+
+  DimExpr result(int64_t{0});
+  size_t term_begin = 0;
+  while (true) {
+    size_t term_end = dim_param.find('+', term_begin);
+    if (term_end == std::string::npos) {
+      term_end = dim_param.size();
+    }
+
+    int64_t coefficient = 1;
+    Monomial monomial;
+    size_t factor_begin = term_begin;
+    while (true) {
+      size_t factor_end = dim_param.find('*', factor_begin);
+      if (factor_end == std::string::npos || factor_end > term_end) {
+        factor_end = term_end;
+      }
+      const std::string factor = dim_param.substr(factor_begin, factor_end - factor_begin);
+      int64_t factor_value;
+      if (ParseInt(factor, factor_value) && !MultiplyOverflows(coefficient, factor_value)) {
+        coefficient *= factor_value;
+      } else if (IsSymbol(factor)) {
+        monomial.push_back(factor);
+      } else {
+        // not an expression, the whole dim_param is the name of a symbol
+        return DimExpr(dim_param);
+      }
+      if (factor_end == term_end) {
+        break;
+      }
+      factor_begin = factor_end + 1;
+    }
+
+    std::sort(monomial.begin(), monomial.end());
+    result.AddTerm(monomial, coefficient);
+    if (term_end == dim_param.size()) {
+      break;
+    }
+    term_begin = term_end + 1;
+  }
+  return result;
+}
+
+DimExpr DimExpr::FromDimension(const TensorShapeProto_Dimension& dim) {
+  if (utils::HasDimValue(dim)) {
+    return dim.dim_value() >= 0 ? DimExpr(dim.dim_value()) : DimExpr();
+  }
+  if (utils::HasDimParam(dim)) {
+    return FromDimParam(dim.dim_param());
+  }
+  return DimExpr();
+}
+
+bool DimExpr::IsConstant() const {
+  return known_ && (terms_.empty() || (terms_.size() == 1 && terms_.begin()->first.empty()));
+}
+
+int64_t DimExpr::ConstantValue() const {
+  return terms_.empty() ? 0 : terms_.begin()->second;
+}
+
+void DimExpr::AddTerm(const Monomial& monomial, int64_t coefficient) {
+  if (coefficient == 0) {
+    return;
+  }
+  auto it = terms_.emplace(monomial, 0).first;
+  it->second += coefficient;
+  if (it->second == 0) {
+    terms_.erase(it);
+  }
+}
+
+DimExpr DimExpr::operator+(const DimExpr& other) const {
+  if (!known_ || !other.known_) {
+    return DimExpr();
+  }
+  DimExpr result = *this;
+  for (const auto& term : other.terms_) {
+    result.AddTerm(term.first, term.second);
+  }
+  return result;
+}
+
+DimExpr DimExpr::operator-(const DimExpr& other) const {
+  return *this + other * DimExpr(int64_t{-1});
+}
+
+DimExpr DimExpr::operator*(const DimExpr& other) const {
+  if (!known_ || !other.known_) {
+    return DimExpr();
+  }
+  DimExpr result(int64_t{0});
+  for (const auto& term : terms_) {
+    for (const auto& other_term : other.terms_) {
+      if (MultiplyOverflows(term.second, other_term.second)) {
+        return DimExpr();
+      }
+      Monomial monomial = term.first;
+      monomial.insert(monomial.end(), other_term.first.begin(), other_term.first.end());
+      std::sort(monomial.begin(), monomial.end());
+      result.AddTerm(monomial, term.second * other_term.second);
+    }
+  }
+  return result;
+}
+
+DimExpr DimExpr::operator/(const DimExpr& other) const {
+  if (!known_ || !other.known_ || other.terms_.size() != 1) {
+    return DimExpr();
+  }
+  const auto& divisor = *other.terms_.begin();
+  DimExpr result(int64_t{0});
+  for (const auto& term : terms_) {
+    if (term.second % divisor.second != 0 ||
+        !std::includes(term.first.begin(), term.first.end(), divisor.first.begin(), divisor.first.end())) {
+      return DimExpr();
+    }
+    Monomial monomial;
+    std::set_difference(term.first.begin(), term.first.end(), divisor.first.begin(), divisor.first.end(),
+                        std::back_inserter(monomial));
+    result.AddTerm(monomial, term.second / divisor.second);
+  }
+  return result;
+}
+
+std::string DimExpr::ToString() const {
+  if (!known_) {
+    return std::string();
+  }
+  if (IsConstant()) {
+    return std::to_string(ConstantValue());
+  }
+
+  std::string text;
+  auto append_term = [&text](const Monomial& monomial, int64_t coefficient) {
+    if (!text.empty()) {
+      text += '+';
+    }
+    if (coefficient != 1 || monomial.empty()) {
+      text += std::to_string(coefficient);
+      if (!monomial.empty()) {
+        text += '*';
+      }
+    }
+    for (size_t i = 0; i < monomial.size(); ++i) {
+      if (i > 0) {
+        text += '*';
+      }
+      text += monomial[i];
+    }
+  };
+
+  // the constant term, which sorts first, goes last
+  for (const auto& term : terms_) {
+    if (!term.first.empty()) {
+      append_term(term.first, term.second);
+    }
+  }
+  auto constant = terms_.find(Monomial());
+  if (constant != terms_.end()) {
+    append_term(constant->first, constant->second);
+  }
+  return text;
+}
+
+SymbolicShapeInference::SymbolicShapeInference(const Graph& graph) : graph_(graph) {
+  for (const auto* input : graph.GetInputsIncludingInitializers()) {
+    if (input->Shape() != nullptr) {
+      shapes_[input->Name()] = ToSymbolicShape(*input->Shape());
+    }
+  }
+  for (const auto& initializer : graph.GetAllInitializedTensors()) {
+    AddInitializer(*initializer.second);
+  }
+
+  GraphViewer graph_viewer(graph);
+  for (auto node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+    const auto* node = graph.GetNode(node_index);
+    if (node != nullptr) {
+      InferNode(*node);
+    }
+  }
+}
+
+const SymbolicShape* SymbolicShapeInference::GetShape(const std::string& name) const {
+  auto it = shapes_.find(name);
+  return it != shapes_.end() ? &it->second : nullptr;
+}
+
+const std::vector<DimExpr>* SymbolicShapeInference::GetValue(const std::string& name) const {
+  auto it = values_.find(name);
+  return it != values_.end() ? &it->second : nullptr;
+}
+
+void SymbolicShapeInference::AddInitializer(const TensorProto& tensor_proto) {
+  SymbolicShape shape;
+  for (auto dim : tensor_proto.dims()) {
+    shape.push_back(DimExpr(dim));
+  }
+  shapes_[tensor_proto.name()] = shape;
+
+  // the value of an initializer that is also a graph input may be overridden
+  if (tensor_proto.dims_size() > 1 || !graph_utils::IsConstantInitializer(graph_, tensor_proto.name(), false)) {
+    return;
+  }
+  const auto data_type = tensor_proto.data_type();
+  if (data_type != TensorProto_DataType_INT64 && data_type != TensorProto_DataType_INT32) {
+    return;
+  }
+  Initializer initializer{tensor_proto, graph_.ModelPath()};
+  if (static_cast<size_t>(initializer.size()) > kMaxValueSize) {
+    return;
+  }
+  auto& value = values_[tensor_proto.name()];
+  for (int64_t i = 0; i < initializer.size(); ++i) {
+    value.emplace_back(data_type == TensorProto_DataType_INT64 ? initializer.data<int64_t>()[i]
+                                                               : static_cast<int64_t>(initializer.data<int32_t>()[i]));
+  }
+}
+
+const SymbolicShape* SymbolicShapeInference::GetInputShape(const NodeArg* input_def) {
+  if (input_def == nullptr || !input_def->Exists()) {
+    return nullptr;
+  }
+  auto it = shapes_.find(input_def->Name());
+  if (it != shapes_.end()) {
+    return &it->second;
+  }
+  // a value of an outer scope
+  if (input_def->Shape() != nullptr) {
+    return &(shapes_[input_def->Name()] = ToSymbolicShape(*input_def->Shape()));
+  }
+  return nullptr;
+}
+
+void SymbolicShapeInference::InferNode(const Node& node) {
+  const auto& input_defs = node.InputDefs();
+  const auto& output_defs = node.OutputDefs();
+  if (output_defs.empty() || !output_defs[0]->Exists()) {
+    return;
+  }
+
+  std::vector<const SymbolicShape*> input_shapes;
+  std::vector<const std::vector<DimExpr>*> input_values;
+  for (const auto* input_def : input_defs) {
+    input_shapes.push_back(GetInputShape(input_def));
+    input_values.push_back(input_def->Exists() ? GetValue(input_def->Name()) : nullptr);
+  }
+  auto input_shape = [&input_shapes](size_t i) { return i < input_shapes.size() ? input_shapes[i] : nullptr; };
+  auto input_value = [&input_values](size_t i) { return i < input_values.size() ? input_values[i] : nullptr; };
+
+  bool has_shape = false;
+  SymbolicShape shape;
+  bool has_value = false;
+  std::vector<DimExpr> value;
+
+  const auto& op_type = node.OpType();
+  const auto* in0 = input_shape(0);
+  const auto* value0 = input_value(0);
+  if (node.Domain() != kOnnxDomain && node.Domain() != kOnnxDomainAlias) {
+    // only the shapes on the NodeArgs
+  } else if (op_type == "Shape") {
+    if (in0 != nullptr) {
+      has_shape = true;
+      shape = {DimExpr(static_cast<int64_t>(in0->size()))};
+      has_value = true;
+      value = *in0;
+    }
+  } else if (op_type == "Size") {
+    if (in0 != nullptr) {
+      has_shape = true;
+      has_value = true;
+      value = {Product(*in0, 0, in0->size())};
+    }
+  } else if (kUnaryOps.count(op_type) != 0) {
+    if (in0 != nullptr) {
+      has_shape = true;
+      shape = *in0;
+    }
+    const auto to = GetIntAttribute(node, "to", TensorProto_DataType_INT64);
+    if (value0 != nullptr && (op_type == "Identity" ||
+                              (op_type == "Cast" && (to == TensorProto_DataType_INT64 ||
+                                                     to == TensorProto_DataType_INT32)))) {
+      has_value = true;
+      value = *value0;
+    }
+  } else if (kBroadcastOps.count(op_type) != 0) {
+    has_shape = std::all_of(input_shapes.begin(), input_shapes.end(),
+                            [](const SymbolicShape* s) { return s != nullptr; });
+    for (const auto* s : input_shapes) {
+      if (has_shape) {
+        shape = Broadcast(shape, *s);
+      }
+    }
+    const auto* value1 = input_value(1);
+    if (value0 != nullptr && value1 != nullptr && input_defs.size() == 2 &&
+        (value0->size() == value1->size() || value0->size() == 1 || value1->size() == 1) &&
+        (op_type == "Add" || op_type == "Sub" || op_type == "Mul" || op_type == "Div")) {
+      has_value = true;
+      const size_t size = std::max(value0->size(), value1->size());
+      for (size_t i = 0; i < size; ++i) {
+        const auto& a = (*value0)[value0->size() == 1 ? 0 : i];
+        const auto& b = (*value1)[value1->size() == 1 ? 0 : i];
+        if (op_type == "Add") {
+          value.push_back(a + b);
+        } else if (op_type == "Sub") {
+          value.push_back(a - b);
+        } else if (op_type == "Mul") {
+          value.push_back(a * b);
+        } else if (a.IsConstant() && b.IsConstant()) {
+          value.push_back(b.ConstantValue() != 0 ? DimExpr(a.ConstantValue() / b.ConstantValue()) : DimExpr());
+        } else {
+          value.push_back(a / b);
+        }
+      }
+    }
+  } else if (op_type == "MatMul") {
+    const auto* in1 = input_shape(1);
+    if (in0 != nullptr && in1 != nullptr) {
+      const auto& a = *in0;
+      const auto& b = *in1;
+      if (a.size() >= 2 && b.size() >= 2) {
+        has_shape = true;
+        shape = Broadcast(SymbolicShape(a.begin(), a.end() - 2), SymbolicShape(b.begin(), b.end() - 2));
+        shape.push_back(a[a.size() - 2]);
+        shape.push_back(b.back());
+      } else if (a.size() == 1 && b.size() >= 2) {
+        has_shape = true;
+        shape.assign(b.begin(), b.end() - 2);
+        shape.push_back(b.back());
+      } else if (a.size() >= 2 && b.size() == 1) {
+        has_shape = true;
+        shape.assign(a.begin(), a.end() - 1);
+      }
+    }
+  } else if (op_type == "Gemm") {
+    const auto* in1 = input_shape(1);
+    if (in0 != nullptr && in1 != nullptr && in0->size() == 2 && in1->size() == 2) {
+      has_shape = true;
+      shape = {(*in0)[GetIntAttribute(node, "transA", 0) != 0 ? 1 : 0],
+               (*in1)[GetIntAttribute(node, "transB", 0) != 0 ? 0 : 1]};
+    }
+  } else if (op_type == "Transpose") {
+    if (in0 != nullptr) {
+      std::vector<int64_t> perm;
+      if (!graph_utils::GetRepeatedNodeAttributeValues(node, "perm", perm)) {
+        for (size_t i = in0->size(); i > 0; --i) {
+          perm.push_back(static_cast<int64_t>(i - 1));
+        }
+      }
+      has_shape = perm.size() == in0->size();
+      for (size_t i = 0; has_shape && i < perm.size(); ++i) {
+        size_t axis;
+        has_shape = NormalizeAxis(perm[i], in0->size(), axis);
+        if (has_shape) {
+          shape.push_back((*in0)[axis]);
+        }
+      }
+    }
+  } else if (op_type == "Reshape") {
+    const auto* value1 = input_value(1);
+    if (in0 != nullptr && value1 != nullptr) {
+      has_shape = true;
+      int64_t inferred_axis = -1;
+      for (size_t i = 0; has_shape && i < value1->size(); ++i) {
+        const auto& dim = (*value1)[i];
+        if (dim.IsConstant() && dim.ConstantValue() == 0) {
+          // copy the dimension of the input
+          has_shape = i < in0->size();
+          shape.push_back(has_shape ? (*in0)[i] : DimExpr());
+        } else if (dim.IsConstant() && dim.ConstantValue() == -1) {
+          has_shape = inferred_axis < 0;
+          inferred_axis = static_cast<int64_t>(i);
+          shape.push_back(DimExpr());
+        } else {
+          shape.push_back(dim);
+        }
+      }
+      if (has_shape && inferred_axis >= 0) {
+        DimExpr known_size(int64_t{1});
+        for (size_t i = 0; i < shape.size(); ++i) {
+          if (static_cast<int64_t>(i) != inferred_axis) {
+            known_size = known_size * shape[i];
+          }
+        }
+        shape[inferred_axis] = Product(*in0, 0, in0->size()) / known_size;
+      }
+    }
+    if (value0 != nullptr) {
+      has_value = true;
+      value = *value0;
+    }
+  } else if (op_type == "Unsqueeze") {
+    std::vector<int64_t> axes;
+    if (in0 != nullptr && graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes)) {
+      const size_t rank = in0->size() + axes.size();
+      std::vector<bool> is_new_axis(rank, false);
+      has_shape = true;
+      for (auto axis : axes) {
+        size_t normalized;
+        has_shape = has_shape && NormalizeAxis(axis, rank, normalized);
+        if (has_shape) {
+          is_new_axis[normalized] = true;
+        }
+      }
+      for (size_t i = 0, j = 0; has_shape && i < rank; ++i) {
+        shape.push_back(is_new_axis[i] ? DimExpr(int64_t{1}) : (*in0)[j++]);
+      }
+    }
+    if (value0 != nullptr) {
+      has_value = true;
+      value = *value0;
+    }
+  } else if (op_type == "Squeeze") {
+    std::vector<int64_t> axes;
+    if (in0 != nullptr) {
+      std::vector<bool> is_squeezed(in0->size(), false);
+      has_shape = true;
+      if (graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes)) {
+        for (auto axis : axes) {
+          size_t normalized;
+          has_shape = has_shape && NormalizeAxis(axis, in0->size(), normalized);
+          if (has_shape) {
+            is_squeezed[normalized] = true;
+          }
+        }
+      } else {
+        // every dimension of size 1, which must all be known
+        for (size_t i = 0; has_shape && i < in0->size(); ++i) {
+          has_shape = (*in0)[i].IsConstant();
+          is_squeezed[i] = has_shape && (*in0)[i].ConstantValue() == 1;
+        }
+      }
+      for (size_t i = 0; has_shape && i < in0->size(); ++i) {
+        if (!is_squeezed[i]) {
+          shape.push_back((*in0)[i]);
+        }
+      }
+    }
+    if (value0 != nullptr) {
+      has_value = true;
+      value = *value0;
+    }
+  } else if (op_type == "Concat") {
+    has_shape = in0 != nullptr;
+    size_t axis = 0;
+    if (has_shape) {
+      has_shape = NormalizeAxis(GetIntAttribute(node, "axis", 0), in0->size(), axis);
+    }
+    if (has_shape) {
+      shape = *in0;
+      for (size_t i = 1; has_shape && i < input_shapes.size(); ++i) {
+        const auto* s = input_shapes[i];
+        has_shape = s != nullptr && s->size() == shape.size();
+        for (size_t j = 0; has_shape && j < shape.size(); ++j) {
+          if (j == axis) {
+            shape[j] = shape[j] + (*s)[j];
+          } else if (!shape[j].IsKnown()) {
+            shape[j] = (*s)[j];
+          }
+        }
+      }
+    }
+    has_value = axis == 0 && std::all_of(input_values.begin(), input_values.end(),
+                                         [](const std::vector<DimExpr>* v) { return v != nullptr; });
+    for (size_t i = 0; has_value && i < input_values.size(); ++i) {
+      value.insert(value.end(), input_values[i]->begin(), input_values[i]->end());
+    }
+  } else if (op_type == "Gather") {
+    const auto* in1 = input_shape(1);
+    size_t axis = 0;
+    if (in0 != nullptr && in1 != nullptr && NormalizeAxis(GetIntAttribute(node, "axis", 0), in0->size(), axis)) {
+      has_shape = true;
+      shape.assign(in0->begin(), in0->begin() + axis);
+      shape.insert(shape.end(), in1->begin(), in1->end());
+      shape.insert(shape.end(), in0->begin() + axis + 1, in0->end());
+    }
+    std::vector<int64_t> indices;
+    if (value0 != nullptr && in0 != nullptr && in0->size() == 1 && GetConstantInts(input_value(1), indices)) {
+      has_value = true;
+      const auto size = static_cast<int64_t>(value0->size());
+      for (auto index : indices) {
+        if (index < -size || index >= size) {
+          has_value = false;
+          break;
+        }
+        value.push_back((*value0)[static_cast<size_t>(index < 0 ? index + size : index)]);
+      }
+    }
+  } else if (op_type == "Slice") {
+    std::vector<int64_t> starts, ends, axes, steps;
+    bool has_slice;
+    if (node.Op() != nullptr && node.Op()->SinceVersion() < 10) {
+      has_slice = graph_utils::GetRepeatedNodeAttributeValues(node, "starts", starts) &&
+                  graph_utils::GetRepeatedNodeAttributeValues(node, "ends", ends);
+      graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes);
+    } else {
+      has_slice = GetConstantInts(input_value(1), starts) && GetConstantInts(input_value(2), ends) &&
+                  (input_defs.size() < 4 || !input_defs[3]->Exists() || GetConstantInts(input_value(3), axes)) &&
+                  (input_defs.size() < 5 || !input_defs[4]->Exists() || GetConstantInts(input_value(4), steps));
+    }
+    has_slice = has_slice && in0 != nullptr && starts.size() == ends.size() &&
+                (axes.empty() || axes.size() == starts.size()) && (steps.empty() || steps.size() == starts.size());
+    if (has_slice) {
+      has_shape = true;
+      shape = *in0;
+      for (size_t i = 0; has_shape && i < starts.size(); ++i) {
+        size_t axis = i;
+        has_shape = NormalizeAxis(axes.empty() ? static_cast<int64_t>(i) : axes[i], in0->size(), axis);
+        const int64_t step = steps.empty() ? 1 : steps[i];
+        has_shape = has_shape && step != 0;
+        if (!has_shape) {
+          break;
+        }
+        auto& dim = shape[axis];
+        if (dim.IsConstant()) {
+          dim = DimExpr(SliceCount(dim.ConstantValue(), starts[i], ends[i], step));
+        } else if (!(step == 1 && starts[i] == 0 && ends[i] >= std::numeric_limits<int32_t>::max())) {
+          dim = DimExpr();
+        }
+      }
+      // slice of a 1-D value along its only axis
+      if (has_shape && value0 != nullptr && in0->size() == 1 && starts.size() == 1) {
+        has_value = true;
+        const auto size = static_cast<int64_t>(value0->size());
+        const int64_t step = steps.empty() ? 1 : steps[0];
+        const int64_t count = SliceCount(size, starts[0], ends[0], step);
+        for (int64_t i = 0, index = SliceStart(size, starts[0], step); i < count; ++i, index += step) {
+          value.push_back((*value0)[static_cast<size_t>(index)]);
+        }
+      }
+    }
+  } else if (op_type == "Expand") {
+    const auto* value1 = input_value(1);
+    if (in0 != nullptr && value1 != nullptr) {
+      has_shape = true;
+      shape = Broadcast(*in0, *value1);
+    }
+  } else if (op_type == "ConstantOfShape") {
+    if (value0 != nullptr) {
+      has_shape = true;
+      shape = *value0;
+    }
+  } else if (op_type == "Flatten") {
+    size_t axis = 0;
+    if (in0 != nullptr) {
+      const auto attr_axis = GetIntAttribute(node, "axis", 1);
+      const auto rank = static_cast<int64_t>(in0->size());
+      if (attr_axis == rank) {
+        axis = in0->size();
+        has_shape = true;
+      } else {
+        has_shape = NormalizeAxis(attr_axis, in0->size(), axis);
+      }
+      if (has_shape) {
+        shape = {Product(*in0, 0, axis), Product(*in0, axis, in0->size())};
+      }
+    }
+  } else if (kReduceOps.count(op_type) != 0) {
+    if (in0 != nullptr) {
+      std::vector<int64_t> axes;
+      std::vector<bool> is_reduced(in0->size(), true);
+      has_shape = true;
+      if (graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes) && !axes.empty()) {
+        is_reduced.assign(in0->size(), false);
+        for (auto axis : axes) {
+          size_t normalized;
+          has_shape = has_shape && NormalizeAxis(axis, in0->size(), normalized);
+          if (has_shape) {
+            is_reduced[normalized] = true;
+          }
+        }
+      }
+      const bool keep_dims = GetIntAttribute(node, "keepdims", 1) != 0;
+      for (size_t i = 0; has_shape && i < in0->size(); ++i) {
+        if (!is_reduced[i]) {
+          shape.push_back((*in0)[i]);
+        } else if (keep_dims) {
+          shape.push_back(DimExpr(int64_t{1}));
+        }
+      }
+    }
+  }
+
+  // the shape on the NodeArg, from the ONNX shape inference, has precedence
+  const auto& output_name = output_defs[0]->Name();
+  const auto* output_shape_proto = output_defs[0]->Shape();
+  if (output_shape_proto != nullptr) {
+    SymbolicShape output_shape = ToSymbolicShape(*output_shape_proto);
+    if (has_shape && shape.size() == output_shape.size()) {
+      for (size_t i = 0; i < shape.size(); ++i) {
+        if (!output_shape[i].IsKnown()) {
+          output_shape[i] = shape[i];
+        }
+      }
+    }
+    shapes_[output_name] = std::move(output_shape);
+  } else if (has_shape) {
+    shapes_[output_name] = std::move(shape);
+  }
+  for (size_t i = 1; i < output_defs.size(); ++i) {
+    if (output_defs[i]->Exists() && output_defs[i]->Shape() != nullptr) {
+      shapes_[output_defs[i]->Name()] = ToSymbolicShape(*output_defs[i]->Shape());
+    }
+  }
+
+  if (has_value && value.size() <= kMaxValueSize) {
+    values_[output_name] = std::move(value);
+  }
+}
+
+}  // namespace onnxruntime
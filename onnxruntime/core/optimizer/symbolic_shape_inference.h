@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+
+/**
+@Class DimExpr
+
+A dimension as a polynomial with integer coefficients over the symbolic dimensions of the graph, e.g. batch*seq or
+2*seq+1. Two dimensions are equal if their polynomials are. A dimension that can't be expressed this way is unknown,
+and is not equal to any dimension, including itself.
+*/
+class DimExpr {
+ public:
+  // unknown dimension
+  DimExpr() = default;
+  explicit DimExpr(int64_t value);
+  explicit DimExpr(const std::string& symbol);
+
+  // Parse a dim_param, either an expression written by ToString or the name of a symbol.
+  static DimExpr FromDimParam(const std::string& dim_param);
+  static DimExpr FromDimension(const ONNX_NAMESPACE::TensorShapeProto_Dimension& dim);
+
+  bool IsKnown() const { return known_; }
+  bool IsConstant() const;
+  // value of a constant dimension
+  int64_t ConstantValue() const;
+
+  DimExpr operator+(const DimExpr& other) const;
+  DimExpr operator-(const DimExpr& other) const;
+  DimExpr operator*(const DimExpr& other) const;
+  // Exact division by a constant or a single term, e.g. batch*seq*768 / (seq*12). Unknown if a term isn't divisible.
+  DimExpr operator/(const DimExpr& other) const;
+
+  bool operator==(const DimExpr& other) const { return known_ && other.known_ && terms_ == other.terms_; }
+  bool operator!=(const DimExpr& other) const { return !(*this == other); }
+
+  // Canonical form, e.g. "2*seq+1", used as the dim_param of the dimension.
+  std::string ToString() const;
+
+ private:
+  // symbols multiplied in a term, sorted
+  using Monomial = std::vector<std::string>;
+
+  void AddTerm(const Monomial& monomial, int64_t coefficient);
+
+  bool known_{false};
+  // nonzero coefficient of each term
+  std::map<Monomial, int64_t> terms_;
+};
+
+using SymbolicShape = std::vector<DimExpr>;
+
+/**
+@Class SymbolicShapeInference
+
+Propagates symbolic shapes through a graph in topological order, starting from the shapes of the graph inputs and the
+shapes on the NodeArgs. Besides shapes, it propagates the values of the small integer tensors computed from shapes,
+e.g. by Shape -> Gather -> Concat chains, so that the shapes that depend on them, like the output of a Reshape, are
+known as well. Values from outer scopes are treated as unknown.
+*/
+class SymbolicShapeInference {
+ public:
+  explicit SymbolicShapeInference(const Graph& graph);
+
+  // Shape of a value of the graph. nullptr if its rank is unknown.
+  const SymbolicShape* GetShape(const std::string& name) const;
+
+  // Elements of a 0-D or 1-D integer value of the graph, some of which may be unknown. nullptr if the number of
+  // elements is unknown.
+  const std::vector<DimExpr>* GetValue(const std::string& name) const;
+
+ private:
+  void AddInitializer(const ONNX_NAMESPACE::TensorProto& tensor_proto);
+  void InferNode(const Node& node);
+  const SymbolicShape* GetInputShape(const NodeArg* input_def);
+
+  const Graph& graph_;
+  std::unordered_map<std::string, SymbolicShape> shapes_;
+  std::unordered_map<std::string, std::vector<DimExpr>> values_;
+};
+
+}  // namespace onnxruntime
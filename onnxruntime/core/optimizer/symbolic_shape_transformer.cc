@@ -0,0 +1,169 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/symbolic_shape_transformer.h"
+
+#include <algorithm>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/symbolic_shape_inference.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Sets the inferred dimensions that are unknown on the NodeArg. Returns true if its shape changed.
+bool RecordShape(NodeArg& node_arg, const SymbolicShape& inferred) {
+  const auto* type = node_arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type()) {
+    return false;
+  }
+  const auto* current = node_arg.Shape();
+  if (current != nullptr && static_cast<size_t>(current->dim_size()) != inferred.size()) {
+    return false;
+  }
+
+  TensorShapeProto new_shape;
+  bool changed = current == nullptr;
+  for (size_t i = 0; i < inferred.size(); ++i) {
+    auto* dim = new_shape.add_dim();
+    if (current != nullptr) {
+      *dim = current->dim(static_cast<int>(i));
+    }
+    if (utils::HasDimValue(*dim) || (utils::HasDimParam(*dim) && !dim->dim_param().empty()) ||
+        !inferred[i].IsKnown()) {
+      continue;
+    }
+    if (inferred[i].IsConstant()) {
+      dim->set_dim_value(inferred[i].ConstantValue());
+    } else {
+      dim->set_dim_param(inferred[i].ToString());
+    }
+    changed = true;
+  }
+
+  if (changed) {
+    node_arg.SetShape(new_shape);
+  }
+  return changed;
+}
+
+// Constant equivalent of the shape input of the Reshape, if there is one.
+bool GetConstantReshapeShape(const SymbolicShapeInference& inference, const Node& reshape,
+                             std::vector<int64_t>& shape) {
+  const auto* value = inference.GetValue(reshape.InputDefs()[1]->Name());
+  const auto* input_shape = inference.GetShape(reshape.InputDefs()[0]->Name());
+  if (value == nullptr || input_shape == nullptr) {
+    return false;
+  }
+
+  bool has_inferred_dim = std::any_of(value->begin(), value->end(), [](const DimExpr& dim) {
+    return dim.IsConstant() && dim.ConstantValue() == -1;
+  });
+  shape.clear();
+  for (size_t i = 0; i < value->size(); ++i) {
+    const auto& dim = (*value)[i];
+    if (dim.IsConstant()) {
+      shape.push_back(dim.ConstantValue());
+    } else if (i < input_shape->size() && dim == (*input_shape)[i]) {
+      shape.push_back(0);
+    } else if (!has_inferred_dim) {
+      // the size of the input determines the only dimension left
+      has_inferred_dim = true;
+      shape.push_back(-1);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Removes the node if nothing reads its outputs anymore, and then the nodes producing its inputs in turn.
+void RemoveUnusedNodes(Graph& graph, NodeIndex node_index) {
+  std::vector<NodeIndex> nodes_to_check{node_index};
+  while (!nodes_to_check.empty()) {
+    auto* node = graph.GetNode(nodes_to_check.back());
+    nodes_to_check.pop_back();
+    if (node == nullptr || node->GetOutputEdgesCount() != 0 || !graph.GetNodeOutputsInGraphOutputs(*node).empty()) {
+      continue;
+    }
+    for (auto it = node->InputEdgesBegin(); it != node->InputEdgesEnd(); ++it) {
+      nodes_to_check.push_back(it->GetNode().Index());
+    }
+    graph.RemoveNode(node->Index());
+  }
+}
+
+}  // namespace
+
+Status SymbolicShapeTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                           const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* node = graph.GetNode(node_index);
+    if (node != nullptr) {
+      ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+    }
+  }
+
+  SymbolicShapeInference inference(graph);
+
+  int recorded_count = 0;
+  for (auto node_index : node_topology_list) {
+    auto* node = graph.GetNode(node_index);
+    if (node == nullptr) {
+      continue;
+    }
+    for (auto* output_def : node->MutableOutputDefs()) {
+      const auto* shape = output_def->Exists() ? inference.GetShape(output_def->Name()) : nullptr;
+      if (shape != nullptr && RecordShape(*output_def, *shape)) {
+        recorded_count++;
+      }
+    }
+  }
+
+  int reshape_count = 0;
+  for (auto node_index : node_topology_list) {
+    auto* reshape = graph.GetNode(node_index);
+    if (reshape == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*reshape, "Reshape", {5}) ||
+        !graph_utils::IsSupportedProvider(*reshape, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    // only shapes computed by nodes, a constant initializer is already as simple as it gets
+    const auto* shape_edge = graph_utils::GetInputEdge(*reshape, 1);
+    std::vector<int64_t> shape;
+    if (shape_edge == nullptr || !GetConstantReshapeShape(inference, *reshape, shape)) {
+      continue;
+    }
+
+    TensorProto shape_initializer_proto;
+    shape_initializer_proto.set_name(graph.GenerateNodeArgName(reshape->Name() + "_shape"));
+    shape_initializer_proto.add_dims(static_cast<int64_t>(shape.size()));
+    shape_initializer_proto.set_data_type(TensorProto_DataType_INT64);
+    shape_initializer_proto.set_raw_data(shape.data(), shape.size() * sizeof(int64_t));
+    auto& shape_arg = graph_utils::AddInitializer(graph, shape_initializer_proto);
+
+    const NodeIndex shape_producer_index = shape_edge->GetNode().Index();
+    graph.RemoveEdge(shape_producer_index, reshape->Index(), shape_edge->GetSrcArgIndex(), 1);
+    graph_utils::ReplaceNodeInput(*reshape, 1, shape_arg);
+    RemoveUnusedNodes(graph, shape_producer_index);
+
+    reshape_count++;
+    modified = true;
+  }
+
+  if (recorded_count > 0) {
+    modified = true;
+  }
+  LOGS(logger, INFO) << "Symbolic shapes recorded on " << recorded_count << " values, constant shapes set on "
+                     << reshape_count << " Reshape nodes";
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
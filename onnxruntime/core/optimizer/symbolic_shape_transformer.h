@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class SymbolicShapeTransformer
+
+Runs SymbolicShapeInference on the graph and records the inferred dimensions on the NodeArgs, as a dim_value when
+constant and otherwise as a dim_param expression such as "2*seq", so that later transformers and the allocation
+planner can compare shapes that ONNX shape inference leaves unknown.
+
+It also replaces the shape input of a Reshape that is computed from shapes, e.g. by a Shape -> Gather -> Unsqueeze ->
+Concat chain, with a constant initializer when every element is either a constant, equal to the dimension of the input
+at the same index (0) or the only element left (-1), and removes the chain once it is unused.
+*/
+class SymbolicShapeTransformer : public GraphTransformer {
+ public:
+  SymbolicShapeTransformer(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("SymbolicShapeTransformer", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
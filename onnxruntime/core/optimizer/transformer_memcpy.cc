@@ -18,6 +18,12 @@ class TransformerMemcpyImpl {
   bool ModifyGraph(const KernelRegistryManager& schema_registries);
 
  private:
+  bool IsProviderNode(const onnxruntime::Node& node) const;
+  bool IsOnHost(const onnxruntime::Node& node, const onnxruntime::NodeArg& arg,
+                const KernelRegistryManager& kernel_registries) const;
+  bool ReadsOnHost(const onnxruntime::Node& node, int input_index,
+                   const KernelRegistryManager& kernel_registries) const;
+  bool PinIndexNodesToHost(const KernelRegistryManager& kernel_registries);
   void ProcessDefs(onnxruntime::Node& node, const KernelRegistryManager& kernel_registries, InitializedTensorSet& initializers_consumed);
   void BuildDefsMapping(const onnxruntime::NodeArg* arg, const KernelRegistryManager& kernel_registries);
   void AddCopyNode(onnxruntime::NodeArg* arg, bool is_input);
@@ -123,7 +129,7 @@ This transformer does not currently optimize copies between, e.g., two different
 */
 
 bool TransformerMemcpyImpl::ModifyGraph(const KernelRegistryManager& kernel_registries) {
-  bool modified = false;
+  bool modified = PinIndexNodesToHost(kernel_registries);
   InitializedTensorSet initializers_consumed;
   // find defs that require copy
   for (auto& node : graph_.Nodes()) {
@@ -167,6 +173,99 @@ bool TransformerMemcpyImpl::ModifyGraph(const KernelRegistryManager& kernel_regi
   return modified;
 }
 
+bool TransformerMemcpyImpl::IsProviderNode(const onnxruntime::Node& node) const {
+  const auto& node_provider_type = node.GetExecutionProviderType();
+  return node_provider_type == provider_ ||
+         (node_provider_type == kCudaExecutionProvider && kTensorrtExecutionProvider == provider_);
+}
+
+// whether the value is on the host when the node consumes it: produced by a node on the host or in a CPU output of a
+// provider kernel, an initializer, which isn't copied on each run, or a graph input, which is fed from the host
+bool TransformerMemcpyImpl::IsOnHost(const onnxruntime::Node& node, const onnxruntime::NodeArg& arg,
+                                     const KernelRegistryManager& kernel_registries) const {
+  for (auto edge = node.InputEdgesBegin(); edge != node.InputEdgesEnd(); ++edge) {
+    const auto& producer = edge->GetNode();
+    if (producer.OutputDefs()[edge->GetSrcArgIndex()] != &arg) continue;
+    if (!IsProviderNode(producer)) return true;
+    const KernelCreateInfo* kci = nullptr;
+    kernel_registries.SearchKernelRegistry(producer, &kci);
+    return kci != nullptr && kci->kernel_def->IsOutputOnCpu(edge->GetSrcArgIndex());
+  }
+  if (GetInitializer(graph_, arg.Name(), true) != nullptr) return true;
+  const auto& graph_inputs = graph_.GetInputs();
+  return !graph_.IsSubgraph() && std::find(graph_inputs.begin(), graph_inputs.end(), &arg) != graph_inputs.end();
+}
+
+bool TransformerMemcpyImpl::ReadsOnHost(const onnxruntime::Node& node, int input_index,
+                                        const KernelRegistryManager& kernel_registries) const {
+  if (!IsProviderNode(node)) return true;
+  // implicit inputs are read from the provider, see ProcessDefs
+  if (input_index >= static_cast<int>(node.InputDefs().size())) return false;
+  const KernelCreateInfo* kci = nullptr;
+  kernel_registries.SearchKernelRegistry(node, &kci);
+  return kci != nullptr && kci->kernel_def->IsInputOnCpu(input_index);
+}
+
+// Shape computations, e.g. Shape -> Gather -> Unsqueeze -> Concat -> Reshape, produce small int64 or int32 tensors
+// that are read on the host. The provider may still have claimed nodes of the chain, which then bounce the values to
+// the device and back with a copy and a sync on each round trip. A provider node whose outputs are index tensors only
+// read on the host, and whose inputs are already on the host, is moved to the CPU provider when it has a kernel there:
+// it removes the copies of the node and adds none. This is repeated until no node moves, as a move can let its
+// producers or its consumers move as well.
+bool TransformerMemcpyImpl::PinIndexNodesToHost(const KernelRegistryManager& kernel_registries) {
+  const auto& graph_outputs = graph_.GetOutputs();
+  bool modified = false;
+  bool moved = true;
+  while (moved) {
+    moved = false;
+    for (auto& node : graph_.Nodes()) {
+      if (!IsProviderNode(node) || node.ContainsSubgraph() || node.OpType() == "MemcpyFromHost" ||
+          node.OpType() == "MemcpyToHost") {
+        continue;
+      }
+
+      bool index_outputs = true;
+      for (const auto* output : node.OutputDefs()) {
+        const auto* type = output->TypeAsProto();
+        index_outputs = index_outputs && output->Exists() && type != nullptr && type->has_tensor_type() &&
+                        (type->tensor_type().elem_type() == TensorProto_DataType_INT64 ||
+                         type->tensor_type().elem_type() == TensorProto_DataType_INT32);
+      }
+      if (!index_outputs || node.GetOutputEdgesCount() == 0) continue;
+
+      bool read_on_host = true;
+      for (auto edge = node.OutputEdgesBegin(); read_on_host && edge != node.OutputEdgesEnd(); ++edge) {
+        read_on_host = ReadsOnHost(edge->GetNode(), edge->GetDstArgIndex(), kernel_registries);
+      }
+      bool inputs_on_host = node.ImplicitInputDefs().empty();
+      for (const auto* input : node.InputDefs()) {
+        inputs_on_host = inputs_on_host && (!input->Exists() || IsOnHost(node, *input, kernel_registries));
+      }
+      if (!read_on_host || !inputs_on_host) continue;
+
+      // the graph outputs are fetched from any device, and the ones of a subgraph are read by its parent node
+      if (graph_.IsSubgraph()) {
+        bool graph_output = false;
+        for (const auto* output : node.OutputDefs()) {
+          graph_output = graph_output ||
+                         std::find(graph_outputs.begin(), graph_outputs.end(), output) != graph_outputs.end();
+        }
+        if (graph_output) continue;
+      }
+
+      const std::string provider_type = node.GetExecutionProviderType();
+      node.SetExecutionProviderType(kCpuExecutionProvider);
+      if (!kernel_registries.HasImplementationOf(node, kCpuExecutionProvider)) {
+        node.SetExecutionProviderType(provider_type);
+        continue;
+      }
+      moved = true;
+      modified = true;
+    }
+  }
+  return modified;
+}
+
 void TransformerMemcpyImpl::ProcessDefs(onnxruntime::Node& node, const KernelRegistryManager& kernel_registries, InitializedTensorSet& initializers_consumed) {
   auto node_provider_type = node.GetExecutionProviderType();
   if ((node_provider_type == provider_) || (node_provider_type == kCudaExecutionProvider && kTensorrtExecutionProvider == provider_)) {
@@ -0,0 +1,680 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/transpose_optimizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <numeric>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+using Perm = std::vector<int64_t>;
+
+// Ops computing each output element from the input elements at the same (broadcast) index.
+const std::unordered_set<std::string> kElementwiseOps = {
+    "Abs", "Acos", "Acosh", "Add", "And", "Asin", "Asinh", "Atan", "Atanh", "BitShift", "Cast", "Ceil", "Clip",
+    "Cos", "Cosh", "Div", "Elu", "Equal", "Erf", "Exp", "Floor", "Greater", "HardSigmoid", "Identity", "IsInf",
+    "IsNaN", "LeakyRelu", "Less", "Log", "Max", "Mean", "Min", "Mod", "Mul", "Neg", "Not", "Or", "Pow", "PRelu",
+    "Reciprocal", "Relu", "Round", "Selu", "Shrink", "Sigmoid", "Sign", "Sin", "Sinh", "Softplus", "Softsign",
+    "Sqrt", "Sub", "Sum", "Tan", "Tanh", "ThresholdedRelu", "Where", "Xor"};
+
+// Reductions with an axes attribute.
+const std::unordered_set<std::string> kReduceOps = {"ReduceL1", "ReduceL2", "ReduceLogSum", "ReduceLogSumExp",
+                                                    "ReduceMax", "ReduceMean", "ReduceMin", "ReduceProd",
+                                                    "ReduceSum", "ReduceSumSquare"};
+
+bool IsOnnxOp(const Node& node) {
+  return node.Domain() == kOnnxDomain || node.Domain() == kOnnxDomainAlias;
+}
+
+bool IsTranspose(const Node& node) {
+  return node.OpType() == "Transpose" && IsOnnxOp(node);
+}
+
+// Perm of a Transpose node. Empty if it's the default one and the rank of the input is unknown.
+Perm GetPerm(const Node& transpose) {
+  Perm perm;
+  if (graph_utils::GetRepeatedNodeAttributeValues(transpose, "perm", perm)) {
+    return perm;
+  }
+  // the default perm reverses the dimensions
+  const auto* shape = transpose.InputDefs()[0]->Shape();
+  if (shape != nullptr) {
+    for (int i = shape->dim_size() - 1; i >= 0; --i) {
+      perm.push_back(i);
+    }
+  }
+  return perm;
+}
+
+bool IsIdentity(const Perm& perm) {
+  for (size_t i = 0; i < perm.size(); ++i) {
+    if (perm[i] != static_cast<int64_t>(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Perm InvertPerm(const Perm& perm) {
+  Perm inverse(perm.size());
+  for (size_t i = 0; i < perm.size(); ++i) {
+    inverse[static_cast<size_t>(perm[i])] = static_cast<int64_t>(i);
+  }
+  return inverse;
+}
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, name);
+  return attr != nullptr ? attr->i() : default_value;
+}
+
+AttributeProto MakeAttribute(const std::string& name, int64_t value) {
+  AttributeProto attr;
+  attr.set_name(name);
+  attr.set_type(AttributeProto_AttributeType_INT);
+  attr.set_i(value);
+  return attr;
+}
+
+AttributeProto MakeAttribute(const std::string& name, const std::vector<int64_t>& values) {
+  AttributeProto attr;
+  attr.set_name(name);
+  attr.set_type(AttributeProto_AttributeType_INTS);
+  for (auto value : values) {
+    attr.add_ints(value);
+  }
+  return attr;
+}
+
+// Maps axes of the output of a Transpose to the axes of its input.
+bool RemapAxes(std::vector<int64_t>& axes, const Perm& perm) {
+  const auto rank = static_cast<int64_t>(perm.size());
+  for (auto& axis : axes) {
+    if (axis < 0) {
+      axis += rank;
+    }
+    if (axis < 0 || axis >= rank) {
+      return false;
+    }
+    axis = perm[static_cast<size_t>(axis)];
+  }
+  return true;
+}
+
+size_t GetElementSize(int data_type) {
+  switch (data_type) {
+    case TensorProto_DataType_FLOAT16:
+      return sizeof(uint16_t);
+    case TensorProto_DataType_FLOAT:
+    case TensorProto_DataType_INT32:
+      return sizeof(int32_t);
+    case TensorProto_DataType_DOUBLE:
+    case TensorProto_DataType_INT64:
+      return sizeof(int64_t);
+    default:
+      return 0;
+  }
+}
+
+// Transposes a constant with `perm` after prepending 1s to its shape up to the rank of the perm, so that it
+// broadcasts against the transposed inputs of the node like the original constant did against the original inputs.
+bool TransposeConstant(const Graph& graph, const TensorProto& tensor_proto, const Perm& perm, TensorProto& result) {
+  const size_t element_size = GetElementSize(tensor_proto.data_type());
+  if (element_size == 0 || static_cast<size_t>(tensor_proto.dims_size()) > perm.size()) {
+    return false;
+  }
+
+  Initializer initializer{tensor_proto, graph.ModelPath()};
+  const size_t rank = perm.size();
+  std::vector<int64_t> dims(rank - initializer.dims().size(), 1);
+  dims.insert(dims.end(), initializer.dims().begin(), initializer.dims().end());
+
+  std::vector<int64_t> strides(rank, 1);
+  for (size_t i = rank - 1; i > 0; --i) {
+    strides[i - 1] = strides[i] * dims[i];
+  }
+
+  result.set_name(tensor_proto.name() + "_transposed");
+  result.set_data_type(tensor_proto.data_type());
+  std::vector<int64_t> result_dims(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    result_dims[i] = dims[static_cast<size_t>(perm[i])];
+    result.add_dims(result_dims[i]);
+  }
+
+  const auto* src = initializer.data<uint8_t>();
+  std::vector<uint8_t> data(static_cast<size_t>(initializer.size()) * element_size);
+  std::vector<int64_t> index(rank, 0);
+  for (int64_t n = 0; n < initializer.size(); ++n) {
+    int64_t offset = 0;
+    for (size_t i = 0; i < rank; ++i) {
+      offset += index[i] * strides[static_cast<size_t>(perm[i])];
+    }
+    std::memcpy(data.data() + n * element_size, src + offset * element_size, element_size);
+    for (size_t i = rank; i > 0 && ++index[i - 1] == result_dims[i - 1]; --i) {
+      index[i - 1] = 0;
+    }
+  }
+  result.set_raw_data(data.data(), data.size());
+  return true;
+}
+
+bool ReadIndices(const Graph& graph, const TensorProto& tensor_proto, std::vector<int64_t>& values) {
+  Initializer initializer{tensor_proto, graph.ModelPath()};
+  if (tensor_proto.data_type() == TensorProto_DataType_INT64) {
+    values.assign(initializer.data<int64_t>(), initializer.data<int64_t>() + initializer.size());
+  } else if (tensor_proto.data_type() == TensorProto_DataType_INT32) {
+    values.assign(initializer.data<int32_t>(), initializer.data<int32_t>() + initializer.size());
+  } else {
+    return false;
+  }
+  return true;
+}
+
+TensorProto MakeIndices(const std::string& name, const std::vector<int64_t>& values, int data_type) {
+  TensorProto tensor_proto;
+  tensor_proto.set_name(name);
+  tensor_proto.set_data_type(data_type);
+  tensor_proto.add_dims(static_cast<int64_t>(values.size()));
+  if (data_type == TensorProto_DataType_INT32) {
+    std::vector<int32_t> data(values.begin(), values.end());
+    tensor_proto.set_raw_data(data.data(), data.size() * sizeof(int32_t));
+  } else {
+    tensor_proto.set_raw_data(values.data(), values.size() * sizeof(int64_t));
+  }
+  return tensor_proto;
+}
+
+// True if the Transpose only feeds `node`, so that it can be removed once `node` reads its input instead.
+bool OnlyFeeds(const Graph& graph, const Node& transpose, const Node& node) {
+  if (!graph.GetNodeOutputsInGraphOutputs(transpose).empty()) {
+    return false;
+  }
+  for (auto it = transpose.OutputEdgesBegin(); it != transpose.OutputEdgesEnd(); ++it) {
+    if (&it->GetNode() != &node || static_cast<size_t>(it->GetDstArgIndex()) >= node.InputDefs().size()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** How pushing a Transpose through a node changes it. */
+struct PushPlan {
+  // inputs read from a Transpose with the perm being pushed, which read the input of the Transpose instead
+  std::vector<int> transposed_inputs;
+  // inputs replaced by new initializers, e.g. transposed constants or remapped Slice axes
+  std::vector<std::pair<int, TensorProto>> new_initializers;
+  std::vector<AttributeProto> new_attributes;
+  // perm of the Transpose added after each output, empty if none is needed
+  std::vector<Perm> output_perms;
+};
+
+// Adds the input of the node to the plan if it's produced by a Transpose with the perm, or can be made to match the
+// inputs that are: a constant that is transposed instead, or, if `allow_broadcast`, a value whose dimensions are all 1.
+bool PlanInput(const Graph& graph, const Node& node, int input_index, const Perm& perm, bool allow_broadcast,
+               const std::unordered_set<std::string>& compatible_providers, PushPlan& plan) {
+  const auto* input_def = node.InputDefs()[input_index];
+  if (!input_def->Exists()) {
+    return true;
+  }
+
+  const auto* input_node = graph_utils::GetInputNode(node, input_index);
+  if (input_node != nullptr && IsTranspose(*input_node) && GetPerm(*input_node) == perm &&
+      graph_utils::IsSupportedProvider(*input_node, compatible_providers) && OnlyFeeds(graph, *input_node, node)) {
+    plan.transposed_inputs.push_back(input_index);
+    return true;
+  }
+
+  const auto* shape = input_def->Shape();
+  if (allow_broadcast && shape != nullptr && static_cast<size_t>(shape->dim_size()) <= perm.size() &&
+      std::all_of(shape->dim().begin(), shape->dim().end(), [](const TensorShapeProto_Dimension& dim) {
+        return utils::HasDimValue(dim) && dim.dim_value() == 1;
+      })) {
+    return true;
+  }
+
+  const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, input_def->Name());
+  if (tensor_proto == nullptr || (!allow_broadcast && static_cast<size_t>(tensor_proto->dims_size()) != perm.size())) {
+    return false;
+  }
+  TensorProto transposed;
+  if (!TransposeConstant(graph, *tensor_proto, InvertPerm(perm), transposed)) {
+    return false;
+  }
+  plan.new_initializers.emplace_back(input_index, std::move(transposed));
+  return true;
+}
+
+bool PlanReduce(const Node& node, const Perm& perm, PushPlan& plan) {
+  const bool is_arg_reduce = node.OpType() == "ArgMax" || node.OpType() == "ArgMin";
+  if (!graph_utils::MatchesOpSinceVersion(node, {1, 11, 12})) {
+    return false;
+  }
+  const bool keepdims = GetIntAttribute(node, "keepdims", 1) != 0;
+
+  std::vector<int64_t> axes;
+  if (is_arg_reduce) {
+    axes.push_back(GetIntAttribute(node, "axis", 0));
+  } else if (!graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes)) {
+    // reduces all the dimensions, the output is the same whatever their order
+    plan.output_perms.emplace_back();
+    return true;
+  }
+  if (!RemapAxes(axes, perm)) {
+    return false;
+  }
+  plan.new_attributes.push_back(is_arg_reduce ? MakeAttribute("axis", axes[0]) : MakeAttribute("axes", axes));
+
+  Perm output_perm = perm;
+  if (!keepdims) {
+    // renumber the dimensions that are left
+    std::vector<bool> reduced(perm.size(), false);
+    for (auto axis : axes) {
+      reduced[static_cast<size_t>(axis)] = true;
+    }
+    std::vector<int64_t> output_axis(perm.size(), -1);
+    int64_t output_rank = 0;
+    for (size_t i = 0; i < perm.size(); ++i) {
+      if (!reduced[i]) {
+        output_axis[i] = output_rank++;
+      }
+    }
+    output_perm.clear();
+    for (auto axis : perm) {
+      if (!reduced[static_cast<size_t>(axis)]) {
+        output_perm.push_back(output_axis[static_cast<size_t>(axis)]);
+      }
+    }
+  }
+  plan.output_perms.push_back(IsIdentity(output_perm) ? Perm{} : output_perm);
+  return true;
+}
+
+bool PlanSlice(const Graph& graph, const Node& node, const Perm& perm, PushPlan& plan) {
+  std::vector<int64_t> axes;
+  if (graph_utils::MatchesOpSinceVersion(node, {1})) {
+    std::vector<int64_t> starts;
+    if (!graph_utils::GetRepeatedNodeAttributeValues(node, "starts", starts)) {
+      return false;
+    }
+    if (!graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes)) {
+      axes.resize(starts.size());
+      std::iota(axes.begin(), axes.end(), int64_t{0});
+    }
+    if (!RemapAxes(axes, perm)) {
+      return false;
+    }
+    plan.new_attributes.push_back(MakeAttribute("axes", axes));
+  } else if (graph_utils::MatchesOpSinceVersion(node, {10, 11})) {
+    // the axes are an input, with the same type as the starts
+    const auto& input_defs = node.InputDefs();
+    const auto* starts = graph_utils::GetConstantInitializer(graph, input_defs[1]->Name());
+    if (starts == nullptr) {
+      return false;
+    }
+    if (input_defs.size() > 3 && input_defs[3]->Exists()) {
+      const auto* axes_proto = graph_utils::GetConstantInitializer(graph, input_defs[3]->Name());
+      if (axes_proto == nullptr || !ReadIndices(graph, *axes_proto, axes)) {
+        return false;
+      }
+    } else {
+      std::vector<int64_t> start_values;
+      if (!ReadIndices(graph, *starts, start_values)) {
+        return false;
+      }
+      axes.resize(start_values.size());
+      std::iota(axes.begin(), axes.end(), int64_t{0});
+    }
+    if (!RemapAxes(axes, perm)) {
+      return false;
+    }
+    plan.new_initializers.emplace_back(3, MakeIndices(node.Name() + "_axes", axes, starts->data_type()));
+  } else {
+    return false;
+  }
+  plan.output_perms.push_back(perm);
+  return true;
+}
+
+// Works out how to move the Transposes with the perm from the inputs of the node to its outputs.
+bool PlanPush(const Graph& graph, const Node& node, const Perm& perm,
+              const std::unordered_set<std::string>& compatible_providers, PushPlan& plan) {
+  const auto& op_type = node.OpType();
+  const int input_count = static_cast<int>(node.InputDefs().size());
+
+  if (kElementwiseOps.count(op_type) != 0) {
+    for (int i = 0; i < input_count; ++i) {
+      if (!PlanInput(graph, node, i, perm, true, compatible_providers, plan)) {
+        return false;
+      }
+    }
+    plan.output_perms.push_back(perm);
+    return true;
+  }
+
+  if (op_type == "Concat") {
+    int64_t axis = GetIntAttribute(node, "axis", 0);
+    std::vector<int64_t> axes{axis};
+    for (int i = 0; i < input_count; ++i) {
+      if (!PlanInput(graph, node, i, perm, false, compatible_providers, plan)) {
+        return false;
+      }
+    }
+    if (!RemapAxes(axes, perm)) {
+      return false;
+    }
+    plan.new_attributes.push_back(MakeAttribute("axis", axes[0]));
+    plan.output_perms.push_back(perm);
+    return true;
+  }
+
+  // the other ops only have their data input transposed
+  if (!PlanInput(graph, node, 0, perm, false, compatible_providers, plan) || plan.transposed_inputs.empty()) {
+    return false;
+  }
+
+  if (kReduceOps.count(op_type) != 0 || op_type == "ArgMax" || op_type == "ArgMin") {
+    return input_count == 1 && PlanReduce(node, perm, plan);
+  }
+
+  if (op_type == "Split") {
+    std::vector<int64_t> axes{GetIntAttribute(node, "axis", 0)};
+    if (input_count != 1 || !RemapAxes(axes, perm)) {
+      return false;
+    }
+    plan.new_attributes.push_back(MakeAttribute("axis", axes[0]));
+    plan.output_perms.assign(node.OutputDefs().size(), perm);
+    return true;
+  }
+
+  if (op_type == "Slice") {
+    return PlanSlice(graph, node, perm, plan);
+  }
+
+  return false;
+}
+
+// Makes input `input_index` of the node, which reads the output of the Transpose, read the input of it instead.
+void BypassTranspose(Graph& graph, Node& node, int input_index, Node& transpose) {
+  graph.RemoveEdge(transpose.Index(), node.Index(), 0, input_index);
+  graph_utils::ReplaceNodeInput(node, input_index, *transpose.MutableInputDefs()[0]);
+  const auto* input_edge = graph_utils::GetInputEdge(transpose, 0);
+  if (input_edge != nullptr) {
+    graph.AddEdge(input_edge->GetNode().Index(), node.Index(), input_edge->GetSrcArgIndex(), input_index);
+  }
+}
+
+void RemoveIfUnused(Graph& graph, NodeIndex node_index) {
+  auto* node = graph.GetNode(node_index);
+  if (node != nullptr && node->GetOutputEdgesCount() == 0 && graph.GetNodeOutputsInGraphOutputs(*node).empty()) {
+    graph.RemoveNode(node_index);
+  }
+}
+
+// Inserts a Transpose between output `output_index` of the node and the nodes reading it.
+NodeIndex AddTransposeAfter(Graph& graph, Node& node, int output_index, const Perm& perm) {
+  NodeArg* output = node.MutableOutputDefs()[output_index];
+  TypeProto type;
+  const auto* output_type = output->TypeAsProto();
+  if (output_type != nullptr && output_type->has_tensor_type()) {
+    type.mutable_tensor_type()->set_elem_type(output_type->tensor_type().elem_type());
+  }
+  auto& transpose_input = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(output->Name()),
+                                                   output_type != nullptr ? &type : nullptr);
+  auto& transpose = graph.AddNode(graph.GenerateNodeName(node.Name() + "_transpose"), "Transpose",
+                                  "Transpose pushed down by the TransposeOptimizer", {&transpose_input}, {output});
+  transpose.AddAttribute("perm", perm);
+  transpose.SetExecutionProviderType(node.GetExecutionProviderType());
+
+  std::vector<std::pair<NodeIndex, int>> consumers;
+  for (auto it = node.OutputEdgesBegin(); it != node.OutputEdgesEnd(); ++it) {
+    if (it->GetSrcArgIndex() == output_index) {
+      consumers.emplace_back(it->GetNode().Index(), it->GetDstArgIndex());
+    }
+  }
+  for (const auto& consumer : consumers) {
+    graph.RemoveEdge(node.Index(), consumer.first, output_index, consumer.second);
+    graph.AddEdge(transpose.Index(), consumer.first, 0, consumer.second);
+  }
+
+  node.MutableOutputDefs()[output_index] = &transpose_input;
+  graph.AddEdge(node.Index(), transpose.Index(), output_index, 0);
+  return transpose.Index();
+}
+
+void ApplyPlan(Graph& graph, Node& node, const PushPlan& plan, std::deque<NodeIndex>& transposes) {
+  std::vector<NodeIndex> bypassed;
+  for (auto input_index : plan.transposed_inputs) {
+    auto& transpose = *graph.GetNode(graph_utils::GetInputNode(node, input_index)->Index());
+    BypassTranspose(graph, node, input_index, transpose);
+    bypassed.push_back(transpose.Index());
+  }
+
+  for (const auto& entry : plan.new_initializers) {
+    TensorProto tensor_proto = entry.second;
+    tensor_proto.set_name(graph.GenerateNodeArgName(tensor_proto.name()));
+    auto& initializer_arg = graph_utils::AddInitializer(graph, tensor_proto);
+    if (static_cast<size_t>(entry.first) < node.InputDefs().size()) {
+      graph_utils::ReplaceNodeInput(node, entry.first, initializer_arg);
+    } else {
+      graph_utils::AddNodeInput(node, entry.first, initializer_arg);
+    }
+  }
+
+  for (const auto& attr : plan.new_attributes) {
+    node.AddAttribute(attr.name(), attr);
+  }
+
+  for (size_t i = 0; i < plan.output_perms.size(); ++i) {
+    if (!plan.output_perms[i].empty() && node.OutputDefs()[i]->Exists()) {
+      transposes.push_back(AddTransposeAfter(graph, node, static_cast<int>(i), plan.output_perms[i]));
+    }
+  }
+
+  for (auto index : bypassed) {
+    RemoveIfUnused(graph, index);
+  }
+}
+
+// Removes a Transpose with an identity perm producing a graph output, which CanRemoveNode doesn't allow, by making the
+// node producing its input produce the graph output instead.
+bool ProduceOutputInstead(Graph& graph, Node& transpose) {
+  const auto* input_edge = graph_utils::GetInputEdge(transpose, 0);
+  if (input_edge == nullptr) {
+    return false;
+  }
+  auto& producer = *graph.GetNode(input_edge->GetNode().Index());
+  const int output_index = input_edge->GetSrcArgIndex();
+  const auto graph_outputs = graph.GetNodeOutputsInGraphOutputs(producer);
+  if (std::find(graph_outputs.begin(), graph_outputs.end(), output_index) != graph_outputs.end()) {
+    return false;
+  }
+  for (auto it = producer.OutputEdgesBegin(); it != producer.OutputEdgesEnd(); ++it) {
+    if (it->GetSrcArgIndex() == output_index && &it->GetNode() != &transpose) {
+      return false;
+    }
+  }
+
+  std::vector<std::pair<NodeIndex, int>> consumers;
+  for (auto it = transpose.OutputEdgesBegin(); it != transpose.OutputEdgesEnd(); ++it) {
+    consumers.emplace_back(it->GetNode().Index(), it->GetDstArgIndex());
+  }
+  graph.RemoveEdge(producer.Index(), transpose.Index(), output_index, 0);
+  for (const auto& consumer : consumers) {
+    graph.RemoveEdge(transpose.Index(), consumer.first, 0, consumer.second);
+  }
+  producer.MutableOutputDefs()[output_index] = transpose.MutableOutputDefs()[0];
+  for (const auto& consumer : consumers) {
+    graph.AddEdge(producer.Index(), consumer.first, output_index, consumer.second);
+  }
+  graph.RemoveNode(transpose.Index());
+  return true;
+}
+
+// Folds a Transpose swapping the two dimensions of an input of a Gemm into its transA/transB attribute.
+void FoldIntoGemm(Graph& graph, Node& gemm, Node& transpose) {
+  std::vector<int> input_indices;
+  for (auto it = transpose.OutputEdgesBegin(); it != transpose.OutputEdgesEnd(); ++it) {
+    input_indices.push_back(it->GetDstArgIndex());
+  }
+  for (auto input_index : input_indices) {
+    const std::string attr_name = input_index == 0 ? "transA" : "transB";
+    gemm.AddAttribute(attr_name, 1 - GetIntAttribute(gemm, attr_name, 0));
+    BypassTranspose(graph, gemm, input_index, transpose);
+  }
+  RemoveIfUnused(graph, transpose.Index());
+}
+
+// Replaces a 2-D MatMul with a Gemm reading the input of the Transpose swapping the dimensions of its input(s).
+void FoldMatMulIntoGemm(Graph& graph, Node& matmul, Node& transpose) {
+  std::vector<int> input_indices;
+  for (auto it = transpose.OutputEdgesBegin(); it != transpose.OutputEdgesEnd(); ++it) {
+    input_indices.push_back(it->GetDstArgIndex());
+  }
+  for (auto input_index : input_indices) {
+    BypassTranspose(graph, matmul, input_index, transpose);
+  }
+  RemoveIfUnused(graph, transpose.Index());
+
+  auto& gemm = graph.AddNode(graph.GenerateNodeName(matmul.Name() + "_gemm"), "Gemm",
+                             "MatMul with transposed inputs", matmul.MutableInputDefs(), matmul.MutableOutputDefs());
+  for (auto input_index : input_indices) {
+    gemm.AddAttribute(input_index == 0 ? "transA" : "transB", int64_t{1});
+  }
+  gemm.SetExecutionProviderType(matmul.GetExecutionProviderType());
+  graph_utils::FinalizeNodeFusion(graph, {matmul}, gemm);
+}
+
+// The MatMul can become a Gemm if both inputs are float matrices and the model has Gemm without C (opset 11).
+bool CanFoldMatMul(const Graph& graph, const Node& matmul) {
+  const auto& versions = graph.DomainToVersionMap();
+  const auto onnx_version = versions.find(kOnnxDomain);
+  if (onnx_version == versions.end() || onnx_version->second < 11) {
+    return false;
+  }
+  for (const auto* input_def : matmul.InputDefs()) {
+    const auto* type = input_def->TypeAsProto();
+    const auto* shape = input_def->Shape();
+    if (type == nullptr || type->tensor_type().elem_type() != TensorProto_DataType_FLOAT || shape == nullptr ||
+        shape->dim_size() != 2) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+Status TransposeOptimizer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::deque<NodeIndex> transposes;
+  for (auto node_index : node_topology_list) {
+    auto* node = graph.GetNode(node_index);
+    if (node == nullptr) {
+      continue;
+    }
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+    if (IsTranspose(*node) && graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders())) {
+      transposes.push_back(node_index);
+    }
+  }
+
+  const size_t original_count = transposes.size();
+  int pushed_count = 0;
+  while (!transposes.empty()) {
+    auto* transpose = graph.GetNode(transposes.front());
+    transposes.pop_front();
+    if (transpose == nullptr) {
+      continue;
+    }
+    Perm perm = GetPerm(*transpose);
+    if (perm.empty()) {
+      continue;
+    }
+
+    // merge with a Transpose producing the input
+    const auto* input_node = graph_utils::GetInputNode(*transpose, 0);
+    if (input_node != nullptr && IsTranspose(*input_node) &&
+        graph_utils::IsSupportedProvider(*input_node, GetCompatibleExecutionProviders())) {
+      const Perm input_perm = GetPerm(*input_node);
+      if (input_perm.size() == perm.size()) {
+        const NodeIndex input_index = input_node->Index();
+        for (auto& axis : perm) {
+          axis = input_perm[static_cast<size_t>(axis)];
+        }
+        BypassTranspose(graph, *transpose, 0, *graph.GetNode(input_index));
+        transpose->AddAttribute("perm", perm);
+        RemoveIfUnused(graph, input_index);
+        modified = true;
+      }
+    }
+
+    if (IsIdentity(perm)) {
+      if (graph_utils::CanRemoveNode(graph, *transpose, logger)) {
+        graph_utils::RemoveNode(graph, *transpose);
+        modified = true;
+      } else if (ProduceOutputInstead(graph, *transpose)) {
+        modified = true;
+      }
+      continue;
+    }
+
+    // push it through the node reading it
+    if (transpose->GetOutputEdgesCount() == 0) {
+      continue;
+    }
+    auto& consumer = *graph.GetNode(transpose->OutputEdgesBegin()->GetNode().Index());
+    if (!OnlyFeeds(graph, *transpose, consumer) || !IsOnnxOp(consumer) ||
+        !graph_utils::IsSupportedProvider(consumer, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+    if (IsTranspose(consumer)) {
+      // merged when the consumer is processed again
+      transposes.push_back(consumer.Index());
+      continue;
+    }
+
+    if (perm == Perm{1, 0} && (consumer.OpType() == "Gemm" || consumer.OpType() == "MatMul")) {
+      bool feeds_c = false;
+      for (auto it = transpose->OutputEdgesBegin(); it != transpose->OutputEdgesEnd(); ++it) {
+        feeds_c = feeds_c || it->GetDstArgIndex() > 1;
+      }
+      if (consumer.OpType() == "Gemm" && !feeds_c) {
+        FoldIntoGemm(graph, consumer, *transpose);
+        modified = true;
+      } else if (consumer.OpType() == "MatMul" && CanFoldMatMul(graph, consumer)) {
+        FoldMatMulIntoGemm(graph, consumer, *transpose);
+        modified = true;
+      }
+      continue;
+    }
+
+    PushPlan plan;
+    if (PlanPush(graph, consumer, perm, GetCompatibleExecutionProviders(), plan)) {
+      ApplyPlan(graph, consumer, plan, transposes);
+      pushed_count++;
+      modified = true;
+    }
+  }
+
+  LOGS(logger, INFO) << "Transposes pushed through " << pushed_count << " nodes, " << original_count
+                     << " Transposes before optimization";
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
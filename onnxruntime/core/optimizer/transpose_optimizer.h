@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class TransposeOptimizer
+
+Removes the Transpose nodes that models converted from NHWC frameworks place around layout-agnostic ops.
+
+A Transpose is pushed down through the node consuming it when the node doesn't depend on the layout of its input:
+elementwise ops (the other inputs being Transposes with the same perm, constants that are transposed instead or
+broadcast scalars), Reduce and ArgMax/ArgMin ops (remapping the axes), Concat, Split and Slice. The Transpose then
+ends up after the node, where it meets and cancels with its inverse, is merged with the next Transpose, or is folded
+into the transA/transB attributes of a Gemm, or of a 2-D MatMul that is turned into one.
+*/
+class TransposeOptimizer : public GraphTransformer {
+ public:
+  TransposeOptimizer(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("TransposeOptimizer", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
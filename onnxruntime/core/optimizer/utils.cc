@@ -208,5 +208,153 @@ bool IsSupportedDataType(const Node& node, const std::vector<std::string>& suppo
   return true;
 }
 
+static bool MatchPatternNode(Graph& graph, const std::vector<PatternNode>& pattern,
+                             const std::unordered_map<std::string, size_t>& pattern_index, size_t index, Node& node,
+                             PatternMatch& match);
+
+static bool MatchPatternInput(Graph& graph, const std::vector<PatternNode>& pattern,
+                              const std::unordered_map<std::string, size_t>& pattern_index, Node& node, int input_index,
+                              const PatternInput& input, PatternMatch& match) {
+  if (input.name.empty()) {
+    return true;
+  }
+
+  auto producer_index = pattern_index.find(input.name);
+  if (producer_index == pattern_index.end()) {
+    // a leaf value
+    NodeArg* arg = node.MutableInputDefs()[input_index];
+    auto bound = match.values.find(input.name);
+    if (bound != match.values.end()) {
+      return bound->second == arg;
+    }
+    match.values[input.name] = arg;
+    return true;
+  }
+
+  for (auto it = node.InputEdgesBegin(); it != node.InputEdgesEnd(); ++it) {
+    if (it->GetDstArgIndex() == input_index) {
+      return it->GetSrcArgIndex() == input.output &&
+             MatchPatternNode(graph, pattern, pattern_index, producer_index->second,
+                              *graph.GetNode(it->GetNode().Index()), match);
+    }
+  }
+  return false;
+}
+
+static bool MatchPatternInputs(Graph& graph, const std::vector<PatternNode>& pattern,
+                               const std::unordered_map<std::string, size_t>& pattern_index, Node& node,
+                               const std::vector<PatternInput>& inputs, PatternMatch& match) {
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (!MatchPatternInput(graph, pattern, pattern_index, node, static_cast<int>(i), inputs[i], match)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool MatchPatternNode(Graph& graph, const std::vector<PatternNode>& pattern,
+                             const std::unordered_map<std::string, size_t>& pattern_index, size_t index, Node& node,
+                             PatternMatch& match) {
+  const PatternNode& pattern_node = pattern[index];
+  auto bound = match.nodes.find(pattern_node.name);
+  if (bound != match.nodes.end()) {
+    return bound->second == &node;
+  }
+
+  if (node.OpType() != pattern_node.op_type || node.Op() == nullptr || node.Op()->Deprecated() ||
+      !graph_utils::MatchesOpSinceVersion(node, pattern_node.versions) ||
+      !graph_utils::MatchesOpSetDomain(node, pattern_node.domain) ||
+      node.InputDefs().size() != pattern_node.inputs.size()) {
+    return false;
+  }
+  match.nodes[pattern_node.name] = &node;
+
+  // try the inputs of a commutative node in both orders, on a copy of the bindings so a failed order leaves no trace
+  PatternMatch candidate = match;
+  if (MatchPatternInputs(graph, pattern, pattern_index, node, pattern_node.inputs, candidate)) {
+    match = std::move(candidate);
+    return true;
+  }
+  if (pattern_node.commutative && pattern_node.inputs.size() == 2) {
+    const std::vector<PatternInput> swapped{pattern_node.inputs[1], pattern_node.inputs[0]};
+    return MatchPatternInputs(graph, pattern, pattern_index, node, swapped, match);
+  }
+  return false;
+}
+
+bool MatchPattern(Graph& graph, Node& root, const std::vector<PatternNode>& pattern, PatternMatch& match) {
+  if (pattern.empty()) {
+    return false;
+  }
+
+  std::unordered_map<std::string, size_t> pattern_index;
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    pattern_index[pattern[i].name] = i;
+  }
+
+  PatternMatch candidate;
+  if (!MatchPatternNode(graph, pattern, pattern_index, pattern.size() - 1, root, candidate)) {
+    return false;
+  }
+
+  // the intermediate results must not be needed once the matched nodes are replaced
+  std::unordered_set<const Node*> matched_nodes;
+  for (const auto& entry : candidate.nodes) {
+    matched_nodes.insert(entry.second);
+  }
+  for (const Node* node : matched_nodes) {
+    if (node == &root) {
+      continue;
+    }
+    if (node->GetExecutionProviderType() != root.GetExecutionProviderType() ||
+        !graph.GetNodeOutputsInGraphOutputs(*node).empty()) {
+      return false;
+    }
+    for (auto it = node->OutputEdgesBegin(); it != node->OutputEdgesEnd(); ++it) {
+      if (matched_nodes.count(&it->GetNode()) == 0) {
+        return false;
+      }
+    }
+  }
+
+  match = std::move(candidate);
+  return true;
+}
+
+void FinalizePatternFusion(Graph& graph, const PatternMatch& match, Node& root, Node& fused_node) {
+  std::unordered_set<NodeIndex> matched_nodes;
+  for (const auto& entry : match.nodes) {
+    matched_nodes.insert(entry.second->Index());
+  }
+
+  // connect the inputs of the fused node to the producers outside of the match
+  const auto& fused_inputs = fused_node.InputDefs();
+  for (size_t i = 0; i < fused_inputs.size(); ++i) {
+    bool connected = false;
+    for (auto node_index : matched_nodes) {
+      const Node& node = *graph.GetNode(node_index);
+      for (auto it = node.InputEdgesBegin(); it != node.InputEdgesEnd() && !connected; ++it) {
+        if (matched_nodes.count(it->GetNode().Index()) == 0 &&
+            static_cast<size_t>(it->GetDstArgIndex()) < node.InputDefs().size() &&
+            node.InputDefs()[it->GetDstArgIndex()] == fused_inputs[i]) {
+          graph.AddEdge(it->GetNode().Index(), fused_node.Index(), it->GetSrcArgIndex(), static_cast<int>(i));
+          connected = true;
+        }
+      }
+      if (connected) {
+        break;
+      }
+    }
+  }
+
+  for (auto node_index : matched_nodes) {
+    if (node_index != root.Index()) {
+      graph_utils::RemoveNodeOutputEdges(graph, *graph.GetNode(node_index));
+      graph.RemoveNode(node_index);
+    }
+  }
+  graph_utils::FinalizeNodeFusion(graph, fused_node, root);
+}
+
 }  // namespace optimizer_utils
 }  // namespace onnxruntime
@@ -62,5 +62,47 @@ int32_t IndexOfNodeInput(const Node& node, const NodeArg& node_arg);
 */
 bool IsSupportedDataType(const Node& node, const std::vector<std::string>& supported_data_types);
 
+/** One input of a PatternNode: either the name of another PatternNode (optionally with the index of the output that
+    is consumed), or the name of a leaf value that is captured in PatternMatch::values. An empty name matches any
+    input without capturing it.
+*/
+struct PatternInput {
+  PatternInput(const char* name, int output = 0) : name(name), output(output) {}
+  std::string name;
+  int output;
+};
+
+/** A node of a subgraph pattern. Nodes are referenced by name from the inputs of later nodes, and the last node of the
+    pattern is its root. When commutative is true the two inputs may be matched in either order.
+*/
+struct PatternNode {
+  std::string name;
+  std::string op_type;
+  std::vector<ONNX_NAMESPACE::OperatorSetVersion> versions;
+  std::vector<PatternInput> inputs;
+  bool commutative = false;
+  std::string domain = kOnnxDomain;
+};
+
+/** The nodes and leaf values bound by MatchPattern, keyed by their names in the pattern. */
+struct PatternMatch {
+  std::unordered_map<std::string, Node*> nodes;
+  std::unordered_map<std::string, NodeArg*> values;
+};
+
+/** Match a subgraph pattern whose root is the last PatternNode against the subgraph ending at root.
+    The pattern is matched upwards through the input edges of root. A leaf name used more than once must be bound to
+    the same NodeArg each time, and a pattern node used more than once to the same Node.
+@returns true if the pattern matches, and every matched node other than root runs on the provider of root and has
+         no consumers outside of the match, so the matched nodes can be replaced by a fused node.
+*/
+bool MatchPattern(Graph& graph, Node& root, const std::vector<PatternNode>& pattern, PatternMatch& match);
+
+/** Replace the nodes of a match by fused_node, which must have been created with the inputs it reads from the match.
+    The input edges of fused_node are connected to the producers outside of the match, the outputs of root are moved
+    to fused_node, and all the matched nodes are removed.
+*/
+void FinalizePatternFusion(Graph& graph, const PatternMatch& match, Node& root, Node& fused_node);
+
 }  // namespace optimizer_utils
 }  // namespace onnxruntime
@@ -67,6 +67,19 @@ class Env {
 
   virtual int GetNumCpuCores() const = 0;
 
+  /// \brief Restricts the calling thread to run on the given logical processors.
+  virtual common::Status SetCurrentThreadAffinity(const std::vector<size_t>& logical_processors) const = 0;
+
+  /// \brief Gets the logical processors that belong to the given NUMA node.
+  virtual common::Status GetNumaNodeProcessors(int numa_node, std::vector<size_t>& logical_processors) const = 0;
+
+  /// \brief Allocates page aligned memory that is placed on the given NUMA node when possible.
+  /// \return the allocated memory, or nullptr on failure. It must be released with FreeNumaMemory.
+  virtual void* AllocateNumaMemory(size_t size, int numa_node) const = 0;
+
+  /// \brief Releases memory returned by AllocateNumaMemory. size must be the size that was allocated.
+  virtual void FreeNumaMemory(void* p, size_t size) const = 0;
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const { return env_time_->NowMicros(); }
 
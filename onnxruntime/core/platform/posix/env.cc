@@ -17,6 +17,11 @@ limitations under the License.
 #include "core/platform/env.h"
 
 #include <unistd.h>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <stdio.h>
@@ -26,7 +31,10 @@ limitations under the License.
 #include <fcntl.h>
 #include <dlfcn.h>
 #include <string.h>
+#include <fstream>
+#include <string>
 #include <thread>
+#include <unordered_set>
 #include <utility>  // for std::forward
 #include <vector>
 #include <assert.h>
@@ -91,10 +99,99 @@ class PosixEnv : public Env {
   }
 
   int GetNumCpuCores() const override {
-    // TODO if you need the number of physical cores you'll need to parse
-    // /proc/cpuinfo and grep for "cpu cores".
-    //However, that information is not always available(output of 'grep -i core /proc/cpuinfo' is empty)
-    return std::thread::hardware_concurrency();
+    const int num_logical_processors = static_cast<int>(std::thread::hardware_concurrency());
+#if defined(__linux__)
+    // the physical cores, each listing the logical processors it runs in the same thread_siblings_list. A core with
+    // simultaneous multithreading, e.g. Hyper-Threading, runs two of them, and the efficiency cores of hybrid
+    // processors one. The logical processors are counted instead if the topology isn't available, e.g. in some
+    // containers.
+    std::unordered_set<std::string> cores;
+    for (int processor = 0; processor < num_logical_processors; ++processor) {
+      std::ifstream siblings{"/sys/devices/system/cpu/cpu" + std::to_string(processor) +
+                             "/topology/thread_siblings_list"};
+      std::string sibling_list;
+      if (!siblings || !std::getline(siblings, sibling_list)) {
+        return num_logical_processors;
+      }
+      cores.insert(sibling_list);
+    }
+    if (!cores.empty()) {
+      return static_cast<int>(cores.size());
+    }
+#endif
+    return num_logical_processors;
+  }
+
+  common::Status SetCurrentThreadAffinity(const std::vector<size_t>& logical_processors) const override {
+#if defined(__linux__) && !defined(__ANDROID__)
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (auto processor : logical_processors) {
+      if (processor >= CPU_SETSIZE) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Logical processor ", processor, " is out of range");
+      }
+      CPU_SET(processor, &cpuset);
+    }
+
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    if (ret != 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "pthread_setaffinity_np failed with error code ", ret);
+    }
+    return Status::OK();
+#else
+    ORT_UNUSED_PARAMETER(logical_processors);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Thread affinity is not supported on this platform");
+#endif
+  }
+
+  common::Status GetNumaNodeProcessors(int numa_node, std::vector<size_t>& logical_processors) const override {
+    logical_processors.clear();
+    // the list is in the form '0-3,8-11'
+    std::ifstream cpulist{"/sys/devices/system/node/node" + std::to_string(numa_node) + "/cpulist"};
+    if (numa_node < 0 || !cpulist) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "NUMA node ", numa_node, " was not found");
+    }
+
+    std::string range;
+    while (std::getline(cpulist, range, ',')) {
+      size_t first = 0, last = 0;
+      auto dash = range.find('-');
+      try {
+        first = std::stoul(range.substr(0, dash));
+        last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+      } catch (const std::exception&) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to parse the processors of NUMA node ", numa_node);
+      }
+      for (size_t processor = first; processor <= last; ++processor) {
+        logical_processors.push_back(processor);
+      }
+    }
+    return Status::OK();
+  }
+
+  void* AllocateNumaMemory(size_t size, int numa_node) const override {
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+      return nullptr;
+    }
+#if defined(__linux__) && defined(SYS_mbind)
+    // the pages are not touched yet, so setting the policy now places them on the node whichever thread
+    // touches them first. MPOL_PREFERRED (1) falls back to other nodes instead of failing when the node is full.
+    constexpr int kMpolPreferred = 1;
+    constexpr size_t kMaskBits = sizeof(unsigned long) * 8;
+    if (numa_node >= 0 && static_cast<size_t>(numa_node) < kMaskBits) {
+      unsigned long node_mask = 1UL << numa_node;
+      // the placement is only an optimization, so a kernel without NUMA support just gets the default policy
+      syscall(SYS_mbind, p, size, kMpolPreferred, &node_mask, kMaskBits, 0);
+    }
+#else
+    ORT_UNUSED_PARAMETER(numa_node);
+#endif
+    return p;
+  }
+
+  void FreeNumaMemory(void* p, size_t size) const override {
+    munmap(p, size);
   }
 
   void SleepForMicroseconds(int64_t micros) const override {
@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+// Trace points of the sessions, their runs and the work inside a run, to correlate the latency of onnxruntime with
+// system-wide traces in production without turning on the JSON profiler. They are built in with
+// onnxruntime_ENABLE_INSTRUMENT, and cost nothing while no tracer listens to them:
+//  - on Windows they are TraceLogging events of the Microsoft.ML.ONNXRuntime provider (see ort.wprp), which
+//    TraceLoggingWrite skips while no ETW session enables the provider. A span is a pair of events of the same name
+//    with the start and stop opcodes.
+//  - on Linux they are USDT probes of the onnxruntime provider (sys/sdt.h), a nop instruction until a tracer such as
+//    perf, bpftrace, SystemTap or LTTng attaches to them. A span is a pair of <name>_start and <name>_stop probes.
+// Without onnxruntime_ENABLE_INSTRUMENT the macros expand to nothing.
+//
+// The spans and their fields:
+//   session   session_id                                      from Initialize to the destruction of the session
+//   run       session_id, run_tag, status code (stop only)   InferenceSession::Run
+//   node      node name, op type, execution provider          the Compute of a kernel by the sequential executor
+//   memcpy    "feed" or "fetch", bytes                        the copy of a feed or a fetch across devices
+//   compile   execution provider, number of fused nodes       IExecutionProvider::Compile during the partitioning
+// The strings are const char*.
+
+#ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
+
+#ifdef _WIN32
+
+#include <Windows.h>
+#include <TraceLoggingProvider.h>
+#include <winmeta.h>
+
+namespace onnxruntime {
+// defined by core/platform/windows/telemetry.cc, registered by the telemetry of the default Env
+TRACELOGGING_DECLARE_PROVIDER(telemetry_provider_handle);
+}  // namespace onnxruntime
+
+#define ORT_TRACE_SPAN_(name, opcode, ...)                                                                   \
+  TraceLoggingWrite(::onnxruntime::telemetry_provider_handle, name, TraceLoggingOpcode(opcode), __VA_ARGS__)
+
+#define ORT_TRACE_SESSION_START(session_id)                                                                           \
+  ORT_TRACE_SPAN_("OrtInferenceSessionActivity", WINEVENT_OPCODE_START, TraceLoggingUInt32(session_id, "session_id"))
+#define ORT_TRACE_SESSION_STOP(session_id)                                                                           \
+  ORT_TRACE_SPAN_("OrtInferenceSessionActivity", WINEVENT_OPCODE_STOP, TraceLoggingUInt32(session_id, "session_id"))
+
+#define ORT_TRACE_RUN_START(session_id, run_tag)                                                 \
+  ORT_TRACE_SPAN_("OrtRun", WINEVENT_OPCODE_START, TraceLoggingUInt32(session_id, "session_id"), \
+                  TraceLoggingUtf8String(run_tag, "run_tag"))
+#define ORT_TRACE_RUN_STOP(session_id, run_tag, status_code)                                            \
+  ORT_TRACE_SPAN_("OrtRun", WINEVENT_OPCODE_STOP, TraceLoggingUInt32(session_id, "session_id"),         \
+                  TraceLoggingUtf8String(run_tag, "run_tag"), TraceLoggingInt32(status_code, "status"))
+
+#define ORT_TRACE_NODE_START(node_name, op_type, provider_type)                                                  \
+  ORT_TRACE_SPAN_("OrtNode", WINEVENT_OPCODE_START, TraceLoggingUtf8String(node_name, "node_name"),              \
+                  TraceLoggingUtf8String(op_type, "op_type"), TraceLoggingUtf8String(provider_type, "provider"))
+#define ORT_TRACE_NODE_STOP(node_name, op_type, provider_type)                                                   \
+  ORT_TRACE_SPAN_("OrtNode", WINEVENT_OPCODE_STOP, TraceLoggingUtf8String(node_name, "node_name"),               \
+                  TraceLoggingUtf8String(op_type, "op_type"), TraceLoggingUtf8String(provider_type, "provider"))
+
+#define ORT_TRACE_MEMCPY_START(kind, bytes)                                                 \
+  ORT_TRACE_SPAN_("OrtMemcpy", WINEVENT_OPCODE_START, TraceLoggingUtf8String(kind, "kind"), \
+                  TraceLoggingUInt64(bytes, "bytes"))
+#define ORT_TRACE_MEMCPY_STOP(kind, bytes)                                                 \
+  ORT_TRACE_SPAN_("OrtMemcpy", WINEVENT_OPCODE_STOP, TraceLoggingUtf8String(kind, "kind"), \
+                  TraceLoggingUInt64(bytes, "bytes"))
+
+#define ORT_TRACE_COMPILE_START(provider_type, num_nodes)                                                 \
+  ORT_TRACE_SPAN_("OrtCompile", WINEVENT_OPCODE_START, TraceLoggingUtf8String(provider_type, "provider"), \
+                  TraceLoggingUInt64(num_nodes, "num_nodes"))
+#define ORT_TRACE_COMPILE_STOP(provider_type, num_nodes)                                                 \
+  ORT_TRACE_SPAN_("OrtCompile", WINEVENT_OPCODE_STOP, TraceLoggingUtf8String(provider_type, "provider"), \
+                  TraceLoggingUInt64(num_nodes, "num_nodes"))
+
+#else
+
+#include <sys/sdt.h>
+
+#define ORT_TRACE_SESSION_START(session_id) DTRACE_PROBE1(onnxruntime, session_start, session_id)
+#define ORT_TRACE_SESSION_STOP(session_id) DTRACE_PROBE1(onnxruntime, session_stop, session_id)
+
+#define ORT_TRACE_RUN_START(session_id, run_tag) DTRACE_PROBE2(onnxruntime, run_start, session_id, run_tag)
+#define ORT_TRACE_RUN_STOP(session_id, run_tag, status_code)             \
+  DTRACE_PROBE3(onnxruntime, run_stop, session_id, run_tag, status_code)
+
+#define ORT_TRACE_NODE_START(node_name, op_type, provider_type)             \
+  DTRACE_PROBE3(onnxruntime, node_start, node_name, op_type, provider_type)
+#define ORT_TRACE_NODE_STOP(node_name, op_type, provider_type)             \
+  DTRACE_PROBE3(onnxruntime, node_stop, node_name, op_type, provider_type)
+
+#define ORT_TRACE_MEMCPY_START(kind, bytes) DTRACE_PROBE2(onnxruntime, memcpy_start, kind, bytes)
+#define ORT_TRACE_MEMCPY_STOP(kind, bytes) DTRACE_PROBE2(onnxruntime, memcpy_stop, kind, bytes)
+
+#define ORT_TRACE_COMPILE_START(provider_type, num_nodes)             \
+  DTRACE_PROBE2(onnxruntime, compile_start, provider_type, num_nodes)
+#define ORT_TRACE_COMPILE_STOP(provider_type, num_nodes)             \
+  DTRACE_PROBE2(onnxruntime, compile_stop, provider_type, num_nodes)
+
+#endif
+
+#else
+
+#define ORT_TRACE_SESSION_START(session_id)
+#define ORT_TRACE_SESSION_STOP(session_id)
+#define ORT_TRACE_RUN_START(session_id, run_tag)
+#define ORT_TRACE_RUN_STOP(session_id, run_tag, status_code)
+#define ORT_TRACE_NODE_START(node_name, op_type, provider_type)
+#define ORT_TRACE_NODE_STOP(node_name, op_type, provider_type)
+#define ORT_TRACE_MEMCPY_START(kind, bytes)
+#define ORT_TRACE_MEMCPY_STOP(kind, bytes)
+#define ORT_TRACE_COMPILE_START(provider_type, num_nodes)
+#define ORT_TRACE_COMPILE_STOP(provider_type, num_nodes)
+
+#endif
@@ -51,6 +51,27 @@ struct FileHandleTraits {
 //       If that's important, consider using another cleanup method.
 using ScopedFileHandle = ScopedResource<FileHandleTraits>;
 
+// CreateFileMapping returns NULL rather than INVALID_HANDLE_VALUE on failure
+struct FileMappingHandleTraits {
+  using Handle = HANDLE;
+  static Handle GetInvalidHandleValue() noexcept { return NULL; }
+  static void CleanUp(Handle h) noexcept {
+    if (!CloseHandle(h)) {
+      const int err = GetLastError();
+      LOGS_DEFAULT(ERROR) << "Failed to close file mapping handle - error code: " << err;
+    }
+  }
+};
+
+using ScopedFileMappingHandle = ScopedResource<FileMappingHandleTraits>;
+
+static void UnmapFile(void* param) noexcept {
+  if (!UnmapViewOfFile(param)) {
+    const int err = GetLastError();
+    LOGS_DEFAULT(ERROR) << "UnmapViewOfFile failed. error code: " << err;
+  }
+}
+
 class WindowsEnv : public Env {
  public:
   void SleepForMicroseconds(int64_t micros) const override { Sleep(static_cast<DWORD>(micros) / 1000); }
@@ -79,6 +100,56 @@ class WindowsEnv : public Env {
     return processorCoreCount;
   }
 
+  common::Status SetCurrentThreadAffinity(const std::vector<size_t>& logical_processors) const override {
+    // processors are numbered across groups, with 64 processors per group. a thread can only be affine to
+    // processors of one group.
+    GROUP_AFFINITY group_affinity{};
+    bool have_group = false;
+    for (auto processor : logical_processors) {
+      const auto group = static_cast<WORD>(processor / 64);
+      if (have_group && group != group_affinity.Group) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "All logical processors must be in the same processor group");
+      }
+      group_affinity.Group = group;
+      group_affinity.Mask |= KAFFINITY{1} << (processor % 64);
+      have_group = true;
+    }
+
+    if (!have_group) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "No logical processors were provided");
+    }
+
+    if (!SetThreadGroupAffinity(GetCurrentThread(), &group_affinity, nullptr)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "SetThreadGroupAffinity failed with error code ", GetLastError());
+    }
+    return Status::OK();
+  }
+
+  common::Status GetNumaNodeProcessors(int numa_node, std::vector<size_t>& logical_processors) const override {
+    logical_processors.clear();
+    GROUP_AFFINITY group_affinity{};
+    if (numa_node < 0 || !GetNumaNodeProcessorMaskEx(static_cast<USHORT>(numa_node), &group_affinity)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "NUMA node ", numa_node, " was not found");
+    }
+
+    for (size_t bit = 0; bit < 64; ++bit) {
+      if (group_affinity.Mask & (KAFFINITY{1} << bit)) {
+        logical_processors.push_back(static_cast<size_t>(group_affinity.Group) * 64 + bit);
+      }
+    }
+    return Status::OK();
+  }
+
+  void* AllocateNumaMemory(size_t size, int numa_node) const override {
+    return VirtualAllocExNuma(GetCurrentProcess(), nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE,
+                              static_cast<DWORD>(numa_node));
+  }
+
+  void FreeNumaMemory(void* p, size_t) const override {
+    VirtualFree(p, 0, MEM_RELEASE);
+  }
+
   static WindowsEnv& Instance() {
     static WindowsEnv default_env;
     return default_env;
@@ -152,9 +223,57 @@ class WindowsEnv : public Env {
   }
 
   Status MapFileIntoMemory(
-      const ORTCHAR_T*, FileOffsetType, size_t,
-      MappedMemoryPtr&) const override {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "MapFileIntoMemory is not implemented on Windows.");
+      const ORTCHAR_T* file_path, FileOffsetType offset, size_t length,
+      MappedMemoryPtr& mapped_memory) const override {
+    ORT_RETURN_IF_NOT(file_path);
+    ORT_RETURN_IF_NOT(offset >= 0);
+
+    ScopedFileHandle file_handle{CreateFileW(
+        file_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL)};
+    if (!file_handle.IsValid()) {
+      const int err = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "open file ", ToMBString(file_path), " fail, errcode = ", err);
+    }
+
+    if (length == 0) {
+      mapped_memory = MappedMemoryPtr{};
+      return Status::OK();
+    }
+
+    // the view has to start at a multiple of the allocation granularity
+    static const DWORD allocation_granularity = []() {
+      SYSTEM_INFO system_info;
+      GetSystemInfo(&system_info);
+      return system_info.dwAllocationGranularity;
+    }();
+    const FileOffsetType offset_to_granularity = offset % static_cast<FileOffsetType>(allocation_granularity);
+    const size_t mapped_length = length + static_cast<size_t>(offset_to_granularity);
+    const ULONGLONG mapped_offset = static_cast<ULONGLONG>(offset - offset_to_granularity);
+
+    // this is a copy-on-write mapping so the pages are shared with other processes mapping the file until written
+    ScopedFileMappingHandle file_mapping_handle{
+        CreateFileMappingW(file_handle.Get(), NULL, PAGE_WRITECOPY, 0, 0, NULL)};
+    if (!file_mapping_handle.IsValid()) {
+      const int err = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "CreateFileMapping ", ToMBString(file_path),
+                             " fail, errcode = ", err);
+    }
+
+    void* const mapped_base = MapViewOfFile(file_mapping_handle.Get(), FILE_MAP_COPY,
+                                            static_cast<DWORD>(mapped_offset >> 32),
+                                            static_cast<DWORD>(mapped_offset & 0xFFFFFFFF),
+                                            mapped_length);
+    if (mapped_base == nullptr) {
+      const int err = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "MapViewOfFile ", ToMBString(file_path), " fail, errcode = ", err);
+    }
+
+    // the view keeps the file mapping alive after its handle is closed
+    mapped_memory = MappedMemoryPtr{
+        reinterpret_cast<char*>(mapped_base) + offset_to_granularity,
+        OrtCallbackInvoker{OrtCallback{UnmapFile, mapped_base}}};
+
+    return Status::OK();
   }
 
   common::Status FileOpenRd(const std::wstring& path, /*out*/ int& fd) const override {
@@ -43,12 +43,11 @@
 
 namespace onnxruntime {
 
-namespace {
+// also written to by the trace points of core/platform/tracing.h
 TRACELOGGING_DEFINE_PROVIDER(telemetry_provider_handle, "Microsoft.ML.ONNXRuntime",
                              // {3a26b1ff-7484-7484-7484-15261f42614d}
                              (0x3a26b1ff, 0x7484, 0x7484, 0x74, 0x84, 0x15, 0x26, 0x1f, 0x42, 0x61, 0x4d),
                              TraceLoggingOptionMicrosoftTelemetry());
-}  // namespace
 
 #ifdef _MSC_VER
 #pragma warning(pop)
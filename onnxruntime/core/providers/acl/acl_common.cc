@@ -8,6 +8,7 @@
 
 #include "core/providers/acl/acl_common.h"
 
+#include "arm_compute/runtime/Allocator.h"
 #include "arm_compute/runtime/PoolManager.h"
 #include "arm_compute/runtime/BlobLifetimeManager.h"
 
@@ -50,6 +51,41 @@ std::shared_ptr<arm_compute::MemoryManagerOnDemand> ACLCreateMemoryManager() {
   return mm;
 }
 
+void ACLPopulateMemoryManager(arm_compute::MemoryManagerOnDemand& mm) {
+  // the pools keep a pointer to the allocator
+  static arm_compute::Allocator allocator;
+  mm.populate(allocator, 1);
+}
+
+bool ACLActivationInfo(const MLAS_ACTIVATION& activation, arm_compute::ActivationLayerInfo& info) {
+  using ActivationFunction = arm_compute::ActivationLayerInfo::ActivationFunction;
+  switch (activation.ActivationKind) {
+    case MlasIdentityActivation:
+      info = arm_compute::ActivationLayerInfo();
+      return true;
+    case MlasReluActivation:
+      info = arm_compute::ActivationLayerInfo(ActivationFunction::RELU);
+      return true;
+    case MlasLeakyReluActivation:
+      info = arm_compute::ActivationLayerInfo(ActivationFunction::LEAKY_RELU, activation.Parameters.LeakyRelu.alpha);
+      return true;
+    case MlasTanhActivation:
+      // a * tanh(b * x)
+      info = arm_compute::ActivationLayerInfo(ActivationFunction::TANH, 1.0f, 1.0f);
+      return true;
+    case MlasLogisticActivation:
+      info = arm_compute::ActivationLayerInfo(ActivationFunction::LOGISTIC);
+      return true;
+    case MlasClipActivation:
+      // min(a, max(b, x))
+      info = arm_compute::ActivationLayerInfo(ActivationFunction::LU_BOUNDED_RELU, activation.Parameters.Clip.maximum,
+                                              activation.Parameters.Clip.minimum);
+      return true;
+    default:
+      return false;
+  }
+}
+
 arm_compute::Status ACLImportMemory(arm_compute::TensorAllocator* allocator, void* memory, size_t size) {
 #ifdef ACL_1902
   return allocator->import_memory(memory, size);
@@ -5,8 +5,10 @@
 #pragma once
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 
 // ACL
+#include "arm_compute/core/Types.h"
 #include "arm_compute/runtime/Tensor.h"
 #include "arm_compute/runtime/TensorAllocator.h"
 #include "arm_compute/runtime/MemoryManagerOnDemand.h"
@@ -17,6 +19,11 @@ namespace acl {
 arm_compute::TensorShape ACLTensorShape(const TensorShape& tensorShape, unsigned int extDim = 0);
 void ACLPrintTensorShape(const char*, arm_compute::Tensor& t);
 std::shared_ptr<arm_compute::MemoryManagerOnDemand> ACLCreateMemoryManager();
+// Allocates the working memory of the functions of a memory manager, once they are configured. It's kept until the
+// memory manager is released, so the functions run without allocating it again.
+void ACLPopulateMemoryManager(arm_compute::MemoryManagerOnDemand& mm);
+// The ACL activation of a fused activation of MLAS, false if ACL has none, e.g. for Gelu.
+bool ACLActivationInfo(const MLAS_ACTIVATION& activation, arm_compute::ActivationLayerInfo& info);
 arm_compute::Status ACLImportMemory(arm_compute::TensorAllocator* allocator, void* memory, size_t size);
 
 }  // namespace acl
@@ -35,7 +35,9 @@ typedef struct {
   std::shared_ptr<arm_compute::MemoryManagerOnDemand> mm_layer;
 } ACLNEGEMM;
 
-typedef std::map<OpKernel*, ACLNEGEMM>::iterator GEMMLayersIterator;
+// the layers of a kernel, configured for each shape of its first input it has run with
+typedef std::map<std::vector<int64_t>, ACLNEGEMM> ACLNEGEMMLayers;
+typedef ACLNEGEMMLayers::iterator GEMMLayersIterator;
 
 template <typename T>
 class Gemm : public onnxruntime::Gemm<T> {
@@ -67,6 +69,11 @@ class Gemm : public onnxruntime::Gemm<T> {
     auto Y = context->Output(0, TensorShape({M, N}));
 
     bool FC = ((alpha_ == 1 && beta_ == 1) || (alpha_ == 1 && beta_ == 0));
+#ifndef GEMM_ACL
+    if (!FC) {
+      return onnxruntime::Gemm<T>::Compute(context);
+    }
+#endif
 
     int64_t K = helper.K();
     LOGS_DEFAULT(VERBOSE) << "Gemm ACL:" << std::endl;
@@ -81,8 +88,9 @@ class Gemm : public onnxruntime::Gemm<T> {
     LOGS_DEFAULT(VERBOSE) << std::endl;
 
     ACLNEGEMM* pGEMM;
-    GEMMLayersIterator it = gemmLayers.find((OpKernel*)this);
-    if (it == gemmLayers.end()) {
+    ACLNEGEMMLayers& layers = gemmLayers[(OpKernel*)this];
+    GEMMLayersIterator it = layers.find(X->Shape().GetDims());
+    if (it == layers.end()) {
       ACLNEGEMM tGEMM;
       tGEMM.a = std::make_shared<arm_compute::Tensor>();
       tGEMM.b = std::make_shared<arm_compute::Tensor>();
@@ -125,11 +133,12 @@ class Gemm : public onnxruntime::Gemm<T> {
         auto layer = std::make_shared<arm_compute::NEGEMM>(tGEMM.mm_layer);
         layer->configure(tGEMM.a.get(), tGEMM.b.get(), (B != nullptr && beta_ != 0) ? tGEMM.c.get() : nullptr, tGEMM.d.get(), alpha_, beta_, arm_compute::GEMMInfo());
         tGEMM.layer = std::move(layer);
-#else
-        return onnxruntime::Gemm<T>::Compute(context);
 #endif
       }
 
+      // the working memory of the layer is kept for the next runs
+      ACLPopulateMemoryManager(*tGEMM.mm_layer);
+
       // non-transpose
       if (FC || trans_B_ != CblasTrans) {
         const T* b_data = W->template Data<T>();
@@ -137,10 +146,9 @@ class Gemm : public onnxruntime::Gemm<T> {
       }
 
       std::pair<GEMMLayersIterator, bool> ret;
-      ret = gemmLayers.insert(std::pair<OpKernel*, ACLNEGEMM>((OpKernel*)this, tGEMM));
+      ret = layers.insert(std::make_pair(X->Shape().GetDims(), tGEMM));
       pGEMM = &ret.first->second;
     } else {
-      //TODO: valildate shapes
       pGEMM = &it->second;
 
       // transpose
@@ -183,10 +191,7 @@ class Gemm : public onnxruntime::Gemm<T> {
     ACLPrintTensorShape("c", *pGEMM->c);
     ACLPrintTensorShape("d", *pGEMM->d);
 
-    arm_compute::Allocator alloc_mm{};
-    pGEMM->mm_layer->populate(alloc_mm, 1);
     pGEMM->layer->run();
-    pGEMM->mm_layer->clear();
 
     pGEMM->a->allocator()->free();
 #ifdef CACHE_TRANSPOSED_DATA
@@ -206,7 +211,7 @@ class Gemm : public onnxruntime::Gemm<T> {
   }
 
  private:
-  static thread_local std::map<OpKernel*, ACLNEGEMM> gemmLayers;
+  static thread_local std::map<OpKernel*, ACLNEGEMMLayers> gemmLayers;
 
   CBLAS_TRANSPOSE trans_A_;
   CBLAS_TRANSPOSE trans_B_;
@@ -215,7 +220,7 @@ class Gemm : public onnxruntime::Gemm<T> {
 };
 
 template <typename T>
-thread_local std::map<OpKernel*, ACLNEGEMM> onnxruntime::acl::Gemm<T>::gemmLayers;
+thread_local std::map<OpKernel*, ACLNEGEMMLayers> onnxruntime::acl::Gemm<T>::gemmLayers;
 
 }  // namespace acl
 }  // namespace onnxruntime
@@ -39,7 +39,7 @@ namespace onnxruntime {
 namespace acl {
 
 template <typename T>
-thread_local std::map<OpKernel*, ACLNEConv> Conv<T>::convLayers;
+thread_local std::map<OpKernel*, ACLNEConvLayers> Conv<T>::convLayers;
 
 template <typename T>
 arm_compute::TensorShape Conv<T>::ACLReshapeWeightsDepthwise(arm_compute::Tensor* kernel) const {
@@ -55,20 +55,21 @@ template <typename T>
 Status Conv<T>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
 
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* B = num_inputs == 3 ? context->Input<Tensor>(2) : nullptr;
+
   ACLNEConv* pConv;
-  ConvLayersIterator it = Conv::convLayers.find((OpKernel*)this);
-  if (it != Conv::convLayers.end()) {
+  ACLNEConvLayers& layers = Conv::convLayers[(OpKernel*)this];
+  ConvLayersIterator it = layers.find(X->Shape().GetDims());
+  if (it != layers.end()) {
     pConv = &it->second;
-    if(pConv->isDepthwiseCPU == true) {
+    if(pConv->isCPU == true) {
       Status s = onnxruntime::Conv<T>::Compute(context);
       return s;
     }
   }
 
-  const Tensor* X = context->Input<Tensor>(0);
-  const Tensor* W = context->Input<Tensor>(1);
-  const Tensor* B = num_inputs == 3 ? context->Input<Tensor>(2) : nullptr;
-
   const int64_t N = X->Shape()[0];
   const int64_t M = W->Shape()[0];
 
@@ -106,26 +107,14 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   Tensor* Y = context->Output(0, TensorShape(Y_dims));
   LOGS_DEFAULT(VERBOSE) << "Y " << Y->Shape().ToString().c_str() << std::endl;
 
-  arm_compute::ActivationLayerInfo::ActivationFunction acl_activ_func;
-  bool acl_activ_enabled = false;
-
-  if (conv_attrs_.activation == "Relu") {
-    acl_activ_func = arm_compute::ActivationLayerInfo::ActivationFunction::RELU;
-    acl_activ_enabled = true;
-  } else if (conv_attrs_.activation == "LeakyRelu") {
-    acl_activ_func = arm_compute::ActivationLayerInfo::ActivationFunction::LEAKY_RELU;
-    acl_activ_enabled = true;
-  } else if (conv_attrs_.activation == "Tanh") {
-    acl_activ_func = arm_compute::ActivationLayerInfo::ActivationFunction::TANH;
-    acl_activ_enabled = true;
-  } else if (conv_attrs_.activation == "Sigmoid") {
-    acl_activ_func = arm_compute::ActivationLayerInfo::ActivationFunction::LOGISTIC;
-    acl_activ_enabled = true;
-  } else if (!conv_attrs_.activation.empty()) {
-    ORT_NOT_IMPLEMENTED("Not implemented fused activation: ", conv_attrs_.activation);
+  // the activation fused by FusedConv, if any
+  arm_compute::ActivationLayerInfo acl_activ_info;
+  if (!ACLActivationInfo(this->activation_, acl_activ_info)) {
+    Status s = onnxruntime::Conv<T>::Compute(context);
+    return s;
   }
 
-  if (it == Conv::convLayers.end()) {
+  if (it == layers.end()) {
 
     auto mm_layer = ACLCreateMemoryManager();
 
@@ -148,7 +137,7 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
     const arm_compute::DataLayout data_layout = tconv.in->info()->data_layout();
     const int idx_channel = arm_compute::get_data_layout_dimension_index(data_layout, arm_compute::DataLayoutDimension::CHANNEL);
     bool isDepthwise = (1 == tconv.k->info()->tensor_shape()[idx_channel]);
-    tconv.isDepthwiseCPU = isDepthwise;
+    tconv.isCPU = isDepthwise;
 
     std::vector<int64_t> aclStrides(2);
     aclStrides[0] = (strides.size() == 2) ? strides[1] : 1;
@@ -181,8 +170,7 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
     if (isDepthwise) {
 #ifdef DEPTHWISE_CPU
       Status s = onnxruntime::Conv<T>::Compute(context);
-      std::pair<ConvLayersIterator, bool> ret;
-      ret = Conv::convLayers.insert(std::pair<OpKernel*, ACLNEConv>((OpKernel*)this, tconv));
+      layers.insert(std::make_pair(X->Shape().GetDims(), tconv));
       return s;
 #else
       tconv.k->info()->set_tensor_shape(ACLReshapeWeightsDepthwise(tconv.k.get()));
@@ -209,20 +197,19 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
 #ifdef ACL_1902
         layer->configure(tconv.in.get(), tconv.k.get(), (B != nullptr) ? tconv.b.get() : nullptr, tconv.out.get(),
                          aclPadStride, 1 /* depth multiplier */,
-                         acl_activ_enabled ? arm_compute::ActivationLayerInfo(acl_activ_func, conv_attrs_.alpha) : arm_compute::ActivationLayerInfo());
+                         acl_activ_info);
 #else
         layer->configure(tconv.in.get(), tconv.k.get(), (B != nullptr) ? tconv.b.get() : nullptr, tconv.out.get(),
                          aclPadStride, 1 /* depth multiplier */,
-                         acl_activ_enabled ? arm_compute::ActivationLayerInfo(acl_activ_func, conv_attrs_.alpha) : arm_compute::ActivationLayerInfo(),
+                         acl_activ_info,
                          arm_compute::Size2D(aclDilation0, dilations[0]));
 #endif
         tconv.layer = std::move(layer);
-        tconv.isDepthwiseCPU = false;
+        tconv.isCPU = false;
       } else {
         // cpu depthwise convolution
         Status s = onnxruntime::Conv<T>::Compute(context);
-        std::pair<ConvLayersIterator, bool> ret;
-        ret = Conv::convLayers.insert(std::pair<OpKernel*, ACLNEConv>((OpKernel*)this, tconv));
+        layers.insert(std::make_pair(X->Shape().GetDims(), tconv));
         return s;
       }
 #endif
@@ -230,6 +217,8 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
       if(tconv.k->info()->tensor_shape()[0] == 1 && tconv.k->info()->tensor_shape()[1] == 1) {
         //pointwise convolution
         Status s = onnxruntime::Conv<T>::Compute(context);
+        tconv.isCPU = true;
+        layers.insert(std::make_pair(X->Shape().GetDims(), tconv));
         return s;
       } else {
         //convolution
@@ -237,7 +226,7 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
         layer->configure(tconv.in.get(), tconv.k.get(), (B != nullptr) ? tconv.b.get() : nullptr, tconv.out.get(),
                          aclPadStride,
                          arm_compute::WeightsInfo(), arm_compute::Size2D(aclDilation0, dilations[0]),
-                         acl_activ_enabled ? arm_compute::ActivationLayerInfo(acl_activ_func, conv_attrs_.alpha) : arm_compute::ActivationLayerInfo(),
+                         acl_activ_info,
                          false, conv_attrs_.group);
         tconv.layer = std::move(layer);
       }
@@ -245,15 +234,17 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
 
     tconv.out->info()->set_format(tconv.in->info()->format());
 
+    // the working memory of the layer is kept for the next runs
+    ACLPopulateMemoryManager(*tconv.mm_layer);
+
     std::pair<ConvLayersIterator, bool> ret;
-    ret = Conv::convLayers.insert(std::pair<OpKernel*, ACLNEConv>((OpKernel*)this, tconv));
+    ret = layers.insert(std::make_pair(X->Shape().GetDims(), tconv));
     pConv = &ret.first->second;
 
     ACLPrintTensorShape("X", *tconv.in.get());
     ACLPrintTensorShape("Y", *tconv.out.get());
 
   } else {
-    //TODO: valildate shapes
     pConv = &it->second;
   }
 
@@ -271,10 +262,7 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   T* y_data = Y->template MutableData<T>();
   ACLImportMemory(pConv->out->allocator(), (void*)y_data, Y->Shape().Size() * 4);
 
-  arm_compute::Allocator alloc_mm{};
-  pConv->mm_layer->populate(alloc_mm, 1);
   pConv->layer->run();
-  pConv->mm_layer->clear();
 
   pConv->in->allocator()->free();
   pConv->k->allocator()->free();
@@ -312,5 +300,16 @@ ONNX_OPERATOR_KERNEL_EX(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Conv<float>);
 
+#ifndef DISABLE_CONTRIB_OPS
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    FusedConv,
+    kMSDomain,
+    1,
+    float,
+    kAclExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedConv);
+#endif
+
 }  // namespace acl
 }  // namespace onnxruntime
@@ -6,6 +6,9 @@
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/nn/conv.h"
 #include "core/providers/acl/acl_execution_provider.h"
+#ifndef DISABLE_CONTRIB_OPS
+#include "contrib_ops/cpu/fused_activation.h"
+#endif
 
 // ACL
 #include "arm_compute/core/TensorInfo.h"
@@ -30,13 +33,15 @@ typedef struct
   std::shared_ptr<arm_compute::Tensor> k;
   std::shared_ptr<arm_compute::Tensor> b;
   std::shared_ptr<arm_compute::Tensor> out;
-  bool isDepthwiseCPU;
+  bool isCPU;
 } ACLNEConv;
 
-typedef std::map<OpKernel*, ACLNEConv>::iterator ConvLayersIterator;
+// the layers of a kernel, configured for each input shape it has run with
+typedef std::map<std::vector<int64_t>, ACLNEConv> ACLNEConvLayers;
+typedef ACLNEConvLayers::iterator ConvLayersIterator;
 
 template <typename T>
-class Conv final : public onnxruntime::Conv<T> {
+class Conv : public onnxruntime::Conv<T> {
  public:
   explicit Conv(const OpKernelInfo& info) : onnxruntime::Conv<T>(info), conv_attrs_(info) {
     provider_ = (const_cast<ACLExecutionProvider*>(
@@ -50,11 +55,21 @@ class Conv final : public onnxruntime::Conv<T> {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  static thread_local std::map<OpKernel*, ACLNEConv> convLayers;
+  static thread_local std::map<OpKernel*, ACLNEConvLayers> convLayers;
   ConvAttributes conv_attrs_;
   ACLExecutionProvider* provider_;
 
   arm_compute::TensorShape ACLReshapeWeightsDepthwise(arm_compute::Tensor* kernel) const;
 };
-}  // namespace mkl_dnn
+
+#ifndef DISABLE_CONTRIB_OPS
+// Conv followed by an activation, fused by ConvActivationFusion. The activation runs in the ACL convolution.
+class FusedConv final : public Conv<float> {
+ public:
+  explicit FusedConv(const OpKernelInfo& info) : Conv<float>(info) {
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
+  }
+};
+#endif
+}  // namespace acl
 }  // namespace onnxruntime
@@ -151,7 +151,8 @@ class LoopImpl {
   LoopImpl(OpKernelContextInternal& context,
            const SessionState& session_state,
            const Loop::Info& info,
-           const Loop::ConcatOutput& concat_output_func);
+           const Loop::ConcatOutput& concat_output_func,
+           const Loop::StartConditionRead& start_condition_read_func);
 
   // Initialize by validating all the inputs, and allocating the output tensors
   Status Initialize();
@@ -163,6 +164,15 @@ class LoopImpl {
  private:
   void CreateInitialFeeds(std::vector<OrtValue>& feeds);
   void SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
+  void SaveOutputs(const std::vector<OrtValue>& last_outputs);
+  void UpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
+
+  Status ExecuteSubgraph(const FeedsFetchesManager& ffm, const std::vector<OrtValue>& feeds,
+                         std::vector<OrtValue>& fetches);
+
+  // run the iterations, reading the condition of each one while the next one runs
+  Status RunIterationsSpeculatively(const FeedsFetchesManager& ffm, std::vector<OrtValue>& feeds,
+                                    std::vector<OrtValue>& fetches);
 
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
@@ -184,6 +194,7 @@ class LoopImpl {
   std::vector<std::vector<OrtValue>> loop_output_tensors_;
 
   const Loop::ConcatOutput& concat_output_func_;
+  const Loop::StartConditionRead& start_condition_read_func_;
 };
 
 static Status ConcatenateCpuOutput(std::vector<OrtValue>& per_iteration_output,
@@ -283,12 +294,18 @@ common::Status Loop::SetupSubgraphExecutionInfo(const SessionState& session_stat
   std::vector<const OrtMemoryInfo*> fetch_locations;
   fetch_locations.reserve(info_->num_subgraph_outputs);
 
-  // 'cond' is first output and we need it to be on CPU so we can read the latest value
+  // 'cond' is first output and we need it to be on CPU so we can read the latest value, unless the derived class
+  // reads it where the subgraph produces it
   const auto& cpu_allocator_info = session_state.GetExecutionProviders()
                                        .Get(onnxruntime::kCpuExecutionProvider)
                                        ->GetAllocator(0, OrtMemTypeDefault)
                                        ->Info();
-  fetch_locations.push_back(&cpu_allocator_info);
+  if (start_condition_read_func_) {
+    fetch_locations.push_back(&utils::FindMemoryInfoForValue(subgraph_session_state,
+                                                             info_->subgraph_output_names[0]));
+  } else {
+    fetch_locations.push_back(&cpu_allocator_info);
+  }
 
   // Loop state variables need to be where we can feed them in to the next iteration, so set the fetch location
   // to match the feed location.
@@ -318,7 +335,7 @@ Status Loop::Compute(OpKernelContext* ctx) const {
   ORT_ENFORCE(session_state, "Subgraph SessionState was not found for 'body' attribute.");
   ORT_ENFORCE(feeds_fetches_manager_, "CreateFeedsFetchesManager must be called prior to execution of graph.");
 
-  LoopImpl loop_impl{*ctx_internal, *session_state, *info_, concat_output_func_};
+  LoopImpl loop_impl{*ctx_internal, *session_state, *info_, concat_output_func_, start_condition_read_func_};
 
   auto status = loop_impl.Initialize();
   ORT_RETURN_IF_ERROR(status);
@@ -331,12 +348,14 @@ Status Loop::Compute(OpKernelContext* ctx) const {
 LoopImpl::LoopImpl(OpKernelContextInternal& context,
                    const SessionState& session_state,
                    const Loop::Info& subgraph_info,
-                   const Loop::ConcatOutput& concat_output_func)
+                   const Loop::ConcatOutput& concat_output_func,
+                   const Loop::StartConditionRead& start_condition_read_func)
     : context_(context),
       session_state_(session_state),
       info_(subgraph_info),
       implicit_inputs_(context_.GetImplicitInputs()),
-      concat_output_func_(concat_output_func) {
+      concat_output_func_(concat_output_func),
+      start_condition_read_func_(start_condition_read_func) {
   auto* max_trip_count_tensor = context.Input<Tensor>(0);
   max_trip_count_ = max_trip_count_tensor ? *max_trip_count_tensor->Data<int64_t>() : INT64_MAX;
 
@@ -415,6 +434,11 @@ void LoopImpl::CreateInitialFeeds(std::vector<OrtValue>& feeds) {
 
 void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs,
                                          std::vector<OrtValue>& next_inputs) {
+  UpdateFeeds(last_outputs, next_inputs);
+  SaveOutputs(last_outputs);
+}
+
+void LoopImpl::UpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs) {
   // last_output: cond, loop vars..., loop output...
   // next_input: iter_num, cond, loop_vars. iter_num is re-used
 
@@ -422,13 +446,60 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
   for (int i = 1; i < info_.num_subgraph_inputs; ++i) {
     next_inputs[i] = last_outputs[i - 1];
   }
+}
 
+void LoopImpl::SaveOutputs(const std::vector<OrtValue>& last_outputs) {
   // save loop outputs as we have to concatenate at the end
   for (int j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
     loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(last_outputs[j + 1]);  // skip 'cond' in output
   }
 }
 
+Status LoopImpl::ExecuteSubgraph(const FeedsFetchesManager& ffm, const std::vector<OrtValue>& feeds,
+                                 std::vector<OrtValue>& fetches) {
+  return utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
+                                ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger());
+}
+
+Status LoopImpl::RunIterationsSpeculatively(const FeedsFetchesManager& ffm, std::vector<OrtValue>& feeds,
+                                            std::vector<OrtValue>& fetches) {
+  auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
+  if (iter_num_value >= max_trip_count_ || !condition_) {
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_ERROR(ExecuteSubgraph(ffm, feeds, fetches));
+  ++iter_num_value;
+
+  while (iter_num_value < max_trip_count_) {
+    std::function<Status(bool&)> wait_for_condition;
+    ORT_RETURN_IF_ERROR(start_condition_read_func_(fetches[0].Get<Tensor>(), wait_for_condition));
+
+    // the next iteration only counts if the condition is true, so it gets the initial true 'cond' on CPU
+    // instead of the 'cond' output on the device
+    std::vector<OrtValue> next_feeds{feeds};
+    UpdateFeeds(fetches, next_feeds);
+    next_feeds[1] = condition_mlvalue_;
+    std::vector<OrtValue> next_fetches;
+    auto next_status = ExecuteSubgraph(ffm, next_feeds, next_fetches);
+
+    bool condition = false;
+    ORT_RETURN_IF_ERROR(wait_for_condition(condition));
+    if (!condition) {
+      // the loop ended before the next iteration, which is dropped along with any error it ran into
+      break;
+    }
+    ORT_RETURN_IF_ERROR(next_status);
+
+    SaveOutputs(fetches);
+    feeds = std::move(next_feeds);
+    fetches = std::move(next_fetches);
+    ++iter_num_value;
+  }
+
+  return Status::OK();
+}
+
 Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index) {
   const auto& first_output = per_iteration_output.front().Get<Tensor>();
   const auto& per_iteration_dims = first_output.Shape().GetDims();
@@ -458,20 +529,23 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
-  while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
-    if (iter_num_value != 0) {
-      SaveOutputsAndUpdateFeeds(fetches, feeds);
-      fetches.clear();
-    }
+  if (start_condition_read_func_) {
+    ORT_RETURN_IF_ERROR(RunIterationsSpeculatively(ffm, feeds, fetches));
+  } else {
+    while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
+      if (iter_num_value != 0) {
+        SaveOutputsAndUpdateFeeds(fetches, feeds);
+        fetches.clear();
+      }
 
-    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
-                                    ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger());
+      status = ExecuteSubgraph(ffm, feeds, fetches);
 
-    ORT_RETURN_IF_ERROR(status);
+      ORT_RETURN_IF_ERROR(status);
 
-    condition_mlvalue_ = fetches[0];
+      condition_mlvalue_ = fetches[0];
 
-    ++iter_num_value;
+      ++iter_num_value;
+    }
   }
 
   // As the loop carried variables may change shape across iterations there's no way to avoid a copy
@@ -32,14 +32,25 @@ class Loop : public OpKernel, public controlflow::IControlFlowKernel {
   using ConcatOutput = std::function<Status(std::vector<OrtValue>& per_iteration_output,
                                             void* output, size_t output_size_in_bytes)>;
 
+  // function to start reading the 'cond' output of an iteration, left on the device that produced it.
+  // @param cond 'cond' output of the subgraph.
+  // @param wait Set to a function which blocks until the value is read and returns it.
+  using StartConditionRead = std::function<Status(const Tensor& cond, std::function<Status(bool& value)>& wait)>;
+
  protected:
   // derived class can provide implementation for handling concatenation of Loop output on a different device
   void SetConcatOutputFunc(const ConcatOutput& concat_output_func) { concat_output_func_ = concat_output_func; }
 
+  // derived class can read the 'cond' output on its device without blocking. Each iteration is then run before the
+  // condition of the previous one is known, and dropped if it was false, so the host doesn't wait for the device
+  // between the iterations. The subgraph must be safe to run once more after the last iteration.
+  void SetStartConditionReadFunc(const StartConditionRead& func) { start_condition_read_func_ = func; }
+
  private:
   // Info and FeedsFetchesManager re-used for each subgraph execution.
   std::unique_ptr<Info> info_;
   std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager_;
   ConcatOutput concat_output_func_;
+  StartConditionRead start_condition_read_func_;
 };
 }  // namespace onnxruntime
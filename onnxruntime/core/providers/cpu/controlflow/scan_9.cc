@@ -112,7 +112,8 @@ class ScanImpl {
            const std::vector<int64_t>& output_directions,
            const std::vector<int64_t>& input_axes,
            const std::vector<int64_t>& output_axes,
-           const scan::detail::DeviceHelpers& device_helpers);
+           const scan::detail::DeviceHelpers& device_helpers,
+           concurrency::ThreadPool* thread_pool);
 
   // Initialize by validating all the inputs, and allocating the output tensors
   Status Initialize();
@@ -156,6 +157,9 @@ class ScanImpl {
   const std::vector<const OrtValue*>& implicit_inputs_;
 
   const scan::detail::DeviceHelpers& device_helpers_;
+
+  // runs the iterations in parallel if the subgraph has no loop state variables. null to run them in order.
+  concurrency::ThreadPool* const thread_pool_;
 };
 
 template <>
@@ -191,7 +195,9 @@ Scan<9>::Scan(const OpKernelInfo& info) : OpKernel(info) {
     output_axes_ = std::vector<int64_t>(num_scan_outputs, 0);
   }
 
-  device_helpers_.transpose_func = TransposeBase::DoTranspose;
+  device_helpers_.transpose_func = [](const std::vector<size_t>& permutations, const Tensor& input, Tensor& output) {
+    return TransposeBase::DoTranspose(permutations, input, output);
+  };
   device_helpers_.set_data_to_zero_func = [](void* data, size_t size_in_bytes) -> Status {
     memset(data, 0, size_in_bytes);
     return Status::OK();
@@ -228,8 +234,12 @@ Status Scan<9>::Compute(OpKernelContext* ctx) const {
   auto* session_state = ctx_internal->SubgraphSessionState("body");
   ORT_ENFORCE(session_state, "Subgraph SessionState was not found for 'body' attribute.");
 
+  // only the subgraphs run by the CPU provider execute iterations in parallel
+  concurrency::ThreadPool* thread_pool =
+      Node().GetExecutionProviderType() == kCpuExecutionProvider ? ctx->GetOperatorThreadPool() : nullptr;
+
   ScanImpl scan_impl{*ctx_internal, *session_state, *info_, input_directions_, output_directions_,
-                     input_axes_, output_axes_, device_helpers_};
+                     input_axes_, output_axes_, device_helpers_, thread_pool};
 
   auto status = scan_impl.Initialize();
   ORT_RETURN_IF_ERROR(status);
@@ -246,7 +256,8 @@ ScanImpl::ScanImpl(OpKernelContextInternal& context,
                    const std::vector<int64_t>& output_directions,
                    const std::vector<int64_t>& input_axes,
                    const std::vector<int64_t>& output_axes,
-                   const scan::detail::DeviceHelpers& device_helpers)
+                   const scan::detail::DeviceHelpers& device_helpers,
+                   concurrency::ThreadPool* thread_pool)
     : context_(context),
       session_state_(session_state),
       info_(info),
@@ -255,7 +266,8 @@ ScanImpl::ScanImpl(OpKernelContextInternal& context,
       input_axes_from_attribute_(input_axes),
       output_axes_from_attribute_(output_axes),
       implicit_inputs_(context_.GetImplicitInputs()),
-      device_helpers_(device_helpers) {
+      device_helpers_(device_helpers),
+      thread_pool_(thread_pool) {
   inputs_.reserve(info_.num_scan_inputs);
   input_axes_.reserve(info_.num_scan_inputs);
 }
@@ -455,7 +467,7 @@ Status ScanImpl::Execute(const FeedsFetchesManager& ffm) {
   // Call the subgraph for each item in the sequence
   status = IterateSequence(context_, session_state_, loop_state_variables, scan_input_stream_iterators,
                            sequence_len_, info_.num_loop_state_variables, info_.num_inputs, info_.num_outputs,
-                           implicit_inputs_, output_iterators_, ffm);
+                           implicit_inputs_, output_iterators_, ffm, thread_pool_);
 
   ORT_RETURN_IF_ERROR(status);
 
@@ -18,6 +18,7 @@
 #include "core/framework/sequential_executor.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/framework/session_options.h"
 
@@ -182,15 +183,74 @@ Status CreateFeedsFetchesManager(const Node& node,
   return Status::OK();
 }
 
+// Runs the iterations [first_seq_no, seq_length) of a subgraph without loop state variables across the thread pool.
+// The iterations are independent, so each one reads its own slices of the inputs and writes its own slices of the
+// outputs, which must already be allocated.
+static Status IterateIndependentSequence(
+    OpKernelContextInternal& context, const SessionState& session_state,
+    std::vector<OrtValueTensorSlicer<const OrtValue>::Iterator>& scan_input_stream_iterators,
+    int64_t first_seq_no, int64_t seq_length, int num_variadic_inputs, int num_variadic_outputs,
+    const std::vector<OrtValue>& feeds, std::vector<std::unique_ptr<OutputIterator>>& output_iterators,
+    const FeedsFetchesManager& ffm, concurrency::ThreadPool* thread_pool) {
+  const auto num_iterations = static_cast<int32_t>(seq_length - first_seq_no);
+  std::vector<Status> statuses(num_iterations);
+  const std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+
+  concurrency::ThreadPool::TryBatchParallelFor(
+      thread_pool, num_iterations,
+      [&](int32_t i) {
+        std::vector<OrtValue> iteration_feeds(feeds);
+        std::vector<OrtValue> iteration_fetches;
+        iteration_fetches.reserve(num_variadic_outputs);
+
+        for (int input = 0; input < num_variadic_inputs; ++input) {
+          auto iterator = scan_input_stream_iterators[input];
+          iterator += i;
+          iteration_feeds[input] = *iterator;
+        }
+
+        for (int output = 0; output < num_variadic_outputs; ++output) {
+          iteration_fetches.push_back(*output_iterators[output]->IteratorAt(i));
+        }
+
+        statuses[i] = utils::ExecuteSubgraph(session_state, ffm, iteration_feeds, iteration_fetches, fetch_allocators,
+                                             ExecutionMode::ORT_SEQUENTIAL, context.GetTerminateFlag(),
+                                             context.Logger());
+      },
+      0);
+
+  for (const auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  // move the iterators past the iterations that were run
+  for (int64_t seq_no = first_seq_no; seq_no < seq_length; ++seq_no) {
+    for (auto& iterator : scan_input_stream_iterators) {
+      ++iterator;
+    }
+    for (auto& iterator : output_iterators) {
+      ++(*iterator);
+    }
+  }
+
+  return Status::OK();
+}
+
 Status IterateSequence(OpKernelContextInternal& context, const SessionState& session_state,
                        std::vector<LoopStateVariable>& loop_state_variables,
                        std::vector<OrtValueTensorSlicer<const OrtValue>::Iterator>& scan_input_stream_iterators,
                        int64_t seq_length, int num_loop_state_variables, int num_variadic_inputs,
                        int num_variadic_outputs, const std::vector<const OrtValue*>& implicit_inputs,
                        std::vector<std::unique_ptr<OutputIterator>>& output_iterators,
-                       const FeedsFetchesManager& ffm) {
+                       const FeedsFetchesManager& ffm,
+                       concurrency::ThreadPool* thread_pool) {
   Status status = Status::OK();
 
+  // without loop state variables no iteration depends on another, so they can run in parallel once the first one
+  // has run and the outputs with symbolic dimensions are allocated
+  const bool parallel_iterations = thread_pool != nullptr && thread_pool->NumThreads() > 0 &&
+                                   num_loop_state_variables == 0 && seq_length > 2;
+
   auto num_implicit_inputs = implicit_inputs.size();
   auto num_inputs = num_variadic_inputs + num_implicit_inputs;
 
@@ -209,6 +269,14 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
 
   int64_t seq_no = 0;
   for (; seq_no < seq_length; ++seq_no) {
+    if (parallel_iterations && seq_no == 1 &&
+        std::all_of(output_iterators.cbegin(), output_iterators.cend(),
+                    [](const std::unique_ptr<OutputIterator>& iterator) { return iterator->FinalOutputAllocated(); })) {
+      return IterateIndependentSequence(context, session_state, scan_input_stream_iterators, seq_no, seq_length,
+                                        num_variadic_inputs, num_variadic_outputs, feeds, output_iterators, ffm,
+                                        thread_pool);
+    }
+
     for (int input = 0; input < num_variadic_inputs; ++input) {
       if (input < num_loop_state_variables) {
         // add loop state variable input
@@ -274,6 +342,12 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
 
     ORT_RETURN_IF_ERROR(status);
 
+    // release the slices so the iterators can move them to the next position instead of creating new ones
+    for (int input = num_loop_state_variables; input < num_variadic_inputs; ++input) {
+      feeds[input] = OrtValue();
+    }
+    fetches.clear();
+
     // cycle the LoopStateVariable input/output in preparation for the next iteration
     std::for_each(loop_state_variables.begin(), loop_state_variables.end(), [](LoopStateVariable& v) { v.Next(); });
 
@@ -548,6 +622,16 @@ OrtValue& OutputIterator::operator*() {
   return *final_output_mlvalue_;
 }
 
+OrtValueTensorSlicer<OrtValue>::Iterator OutputIterator::IteratorAt(int64_t offset) const {
+  ORT_ENFORCE(!is_v8_ && !is_loop_state_var_ && is_concrete_shape_,
+              "Out of order iteration is only supported for the allocated scan outputs of Scan 9.");
+  ORT_ENFORCE(cur_iteration_ + offset < num_iterations_);
+
+  auto iterator = *cur_slicer_iterator_;
+  iterator += offset;
+  return iterator;
+}
+
 OutputIterator& OutputIterator::operator++() {
   if (cur_iteration_ < num_iterations_) {
     ORT_ENFORCE(is_concrete_shape_,
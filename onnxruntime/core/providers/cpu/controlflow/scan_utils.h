@@ -15,6 +15,9 @@
 #include "core/providers/cpu/controlflow/scan.h"
 
 namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}
 class GraphViewer;
 class OrtValueNameIdxMap;
 class OpKernelContextInternal;
@@ -118,6 +121,10 @@ class OutputIterator {
   OrtValue& operator*();
   OutputIterator& operator++();
 
+  // slicer for the output of the iteration that is `offset` iterations after the current one, so iterations can be
+  // written out of order. only valid for the scan outputs of Scan 9 once the final output is allocated.
+  OrtValueTensorSlicer<OrtValue>::Iterator IteratorAt(int64_t offset) const;
+
   bool FinalOutputAllocated() const { return is_concrete_shape_; }
 
   // custom fetch allocator that can be used when the final shape is not concrete.
@@ -206,7 +213,8 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
                        int64_t seq_length, int num_loop_state_variables, int num_variadic_inputs,
                        int num_variadic_outputs, const std::vector<const OrtValue*>& implicit_inputs,
                        std::vector<std::unique_ptr<OutputIterator>>& output_iterators,
-                       const FeedsFetchesManager& ffm);
+                       const FeedsFetchesManager& ffm,
+                       concurrency::ThreadPool* thread_pool = nullptr);
 
 OrtValue AllocateTensorInMLValue(MLDataType data_type, const TensorShape& shape, AllocatorPtr& allocator);
 
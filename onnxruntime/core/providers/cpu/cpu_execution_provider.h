@@ -5,7 +5,9 @@
 
 #include "core/framework/allocatormgr.h"
 #include "core/framework/execution_provider.h"
+#include "core/framework/numa_allocator.h"
 #include "core/graph/constants.h"
+#include "core/providers/cpu/cpu_tuning_cache.h"
 
 namespace onnxruntime {
 
@@ -13,8 +15,11 @@ namespace onnxruntime {
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
 
-  explicit CPUExecutionProviderInfo(bool use_arena)
-      : create_arena(use_arena) {}
+  // NUMA node the memory of the provider is placed on. -1 leaves the placement to the OS.
+  int numa_node{-1};
+
+  explicit CPUExecutionProviderInfo(bool use_arena, int numa_node = -1)
+      : create_arena(use_arena), numa_node(numa_node) {}
 
   CPUExecutionProviderInfo() = default;
 };
@@ -27,8 +32,13 @@ class CPUExecutionProvider : public IExecutionProvider {
  public:
   explicit CPUExecutionProvider(const CPUExecutionProviderInfo& info)
       : IExecutionProvider{onnxruntime::kCpuExecutionProvider} {
+    const int numa_node = info.numa_node;
     DeviceAllocatorRegistrationInfo device_info{OrtMemTypeDefault,
-                                                [](int) { return onnxruntime::make_unique<TAllocator>(); },
+                                                [numa_node](int) -> std::unique_ptr<IDeviceAllocator> {
+                                                  if (numa_node >= 0)
+                                                    return onnxruntime::make_unique<NumaCPUAllocator>(numa_node);
+                                                  return onnxruntime::make_unique<TAllocator>();
+                                                },
                                                 std::numeric_limits<size_t>::max()};
 
 #ifdef USE_JEMALLOC
@@ -55,7 +65,13 @@ class CPUExecutionProvider : public IExecutionProvider {
   std::shared_ptr<KernelRegistry> GetKernelRegistry() const override;
   std::unique_ptr<IDataTransfer> GetDataTransfer() const override;
 
+  // The kernels that autotune record the configurations they measure in this cache.
+  // Autotuning is disabled if there's no cache. Must be set before the kernels are created.
+  void SetTuningCache(std::shared_ptr<CpuTuningCache> tuning_cache) { tuning_cache_ = std::move(tuning_cache); }
+  CpuTuningCache* GetTuningCache() const { return tuning_cache_.get(); }
+
  private:
   std::vector<FuseRuleFn> fuse_rules_;
+  std::shared_ptr<CpuTuningCache> tuning_cache_;
 };
 }  // namespace onnxruntime
@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/cpu_tuning_cache.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "core/common/cpuid_info.h"
+
+namespace onnxruntime {
+
+namespace {
+std::string GetCpuModel() {
+  const auto& cpu_model = CPUIDInfo::GetCPUIDInfo().GetCPUModel();
+  return cpu_model.empty() ? std::string("unknown") : cpu_model;
+}
+}  // namespace
+
+CpuTuningCache::CpuTuningCache(const std::basic_string<ORTCHAR_T>& file_path)
+    : file_path_(file_path), cpu_model_(GetCpuModel()) {
+}
+
+Status CpuTuningCache::Load() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (file_path_.empty()) {
+    return Status::OK();
+  }
+
+  std::ifstream file(file_path_);
+  if (!file) {
+    return Status::OK();
+  }
+
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty()) {
+      continue;
+    }
+
+    const auto model_end = line.find('\t');
+    const auto key_end = model_end == std::string::npos ? std::string::npos : line.find('\t', model_end + 1);
+    if (key_end == std::string::npos) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Invalid entry in the CPU tuning cache ", ToMBString(file_path_),
+                             ": ", line);
+    }
+
+    if (line.compare(0, model_end, cpu_model_) != 0) {
+      other_lines_.push_back(line);
+      continue;
+    }
+
+    std::vector<int64_t> config;
+    std::istringstream values(line.substr(key_end + 1));
+    int64_t value;
+    while (values >> value) {
+      config.push_back(value);
+    }
+
+    entries_[line.substr(model_end + 1, key_end - model_end - 1)] = std::move(config);
+  }
+
+  return Status::OK();
+}
+
+bool CpuTuningCache::Lookup(const std::string& key, std::vector<int64_t>& config) const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto entry = entries_.find(key);
+  if (entry == entries_.end()) {
+    return false;
+  }
+
+  config = entry->second;
+  return true;
+}
+
+Status CpuTuningCache::Insert(const std::string& key, const std::vector<int64_t>& config) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  entries_[key] = config;
+  return Save();
+}
+
+Status CpuTuningCache::Save() const {
+  if (file_path_.empty()) {
+    return Status::OK();
+  }
+
+  std::ofstream file(file_path_, std::ios::out | std::ios::trunc);
+  for (const auto& line : other_lines_) {
+    file << line << '\n';
+  }
+
+  for (const auto& entry : entries_) {
+    file << cpu_model_ << '\t' << entry.first << '\t';
+    for (size_t i = 0; i < entry.second.size(); ++i) {
+      file << (i == 0 ? "" : " ") << entry.second[i];
+    }
+    file << '\n';
+  }
+
+  file.close();
+  if (!file) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write the CPU tuning cache ", ToMBString(file_path_));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+#include "core/session/onnxruntime_c_api.h"
+
+namespace onnxruntime {
+
+/**
+ * Cache of the configurations picked by the CPU kernels that autotune, such as the algorithm and the number of
+ * threads MlasConv uses for a convolution shape. A kernel measures its candidate configurations the first time it
+ * sees a problem and records the fastest one under a key that describes the problem.
+ *
+ * If the cache has a file, the entries recorded in it for this processor model are loaded when the cache is created
+ * and the file is rewritten whenever an entry is added, so later processes on identical hosts skip the measurements.
+ * The file is a text file with one entry per line: <processor model> <tab> <key> <tab> <space separated values>.
+ * The entries of other processor models are kept when the file is rewritten.
+ */
+class CpuTuningCache {
+ public:
+  // An empty file path keeps the entries in memory only.
+  explicit CpuTuningCache(const std::basic_string<ORTCHAR_T>& file_path);
+
+  // Loads the entries recorded in the file for this processor model. A missing file is not an error.
+  Status Load();
+
+  // Returns true and the recorded configuration if there's an entry for 'key'.
+  bool Lookup(const std::string& key, std::vector<int64_t>& config) const;
+
+  // Records the configuration for 'key' and rewrites the file.
+  Status Insert(const std::string& key, const std::vector<int64_t>& config);
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CpuTuningCache);
+
+  // Writes the file. Called with the mutex held.
+  Status Save() const;
+
+  const std::basic_string<ORTCHAR_T> file_path_;
+  const std::string cpu_model_;
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, std::vector<int64_t>> entries_;
+
+  // lines of the file recorded on other processor models, written back unchanged
+  std::vector<std::string> other_lines_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/generator/philox.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace onnxruntime {
+namespace philox {
+
+namespace {
+// counters generated per block by one thread. the random bits of a block are generated first and then transformed,
+// so both loops run over independent lanes and can be vectorized.
+constexpr int64_t kCountersPerBlock = 1024;
+
+// Runs fn(first_counter_index, bits, num_counters) for each block of the num_counters counters from counter, with
+// the random bits of the counters of the block.
+template <typename F>
+void ForEachBlock(uint64_t key, uint64_t counter, int64_t num_counters, concurrency::ThreadPool* tp, F&& fn) {
+  const int64_t counters_per_block =
+      std::max<int64_t>(kCountersPerBlock, num_counters / std::numeric_limits<int32_t>::max() + 1);
+  const int64_t num_blocks = (num_counters + counters_per_block - 1) / counters_per_block;
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t block) {
+    const int64_t begin = block * counters_per_block;
+    const int64_t count = std::min(counters_per_block, num_counters - begin);
+    std::vector<uint32_t> bits(static_cast<size_t>(count) * 4);
+    for (int64_t i = 0; i < count; ++i) {
+      PhiloxGenerator::Generate(key, counter + begin + i, &bits[i * 4]);
+    }
+    fn(begin, bits.data(), count);
+  });
+}
+
+// the uniform values in [0, 1) of the random bits of a counter
+inline void CounterToUniform(const uint32_t* bits, float* values) {
+  for (int i = 0; i < 4; ++i) {
+    values[i] = ToUniform(bits[i]);
+  }
+}
+
+inline void CounterToUniform(const uint32_t* bits, double* values) {
+  for (int i = 0; i < 2; ++i) {
+    values[i] = ToUniform(static_cast<uint64_t>(bits[2 * i]) | static_cast<uint64_t>(bits[2 * i + 1]) << 32);
+  }
+}
+
+// Writes the values of the counters of a block. The last counter of the output may have fewer values to write.
+template <typename T, typename F>
+void WriteValues(int64_t first_counter_index, const uint32_t* bits, int64_t num_counters, T* output, int64_t size,
+                 F&& transform) {
+  constexpr int64_t values_per_counter = ValuesPerCounter<T>();
+  std::vector<T> values(static_cast<size_t>(num_counters * values_per_counter));
+  for (int64_t i = 0; i < num_counters; ++i) {
+    CounterToUniform(bits + i * 4, &values[i * values_per_counter]);
+  }
+  transform(values.data(), static_cast<int64_t>(values.size()));
+
+  const int64_t begin = first_counter_index * values_per_counter;
+  const int64_t end = std::min(size, begin + static_cast<int64_t>(values.size()));
+  std::copy(values.begin(), values.begin() + (end - begin), output + begin);
+}
+}  // namespace
+
+template <typename T>
+void GenerateUniform(uint64_t key, uint64_t counter, float low, float high, T* output, int64_t size,
+                     concurrency::ThreadPool* tp) {
+  const T offset = static_cast<T>(low);
+  const T range = static_cast<T>(high) - static_cast<T>(low);
+  ForEachBlock(key, counter, NumCounters<T>(size), tp,
+               [&](int64_t first_counter_index, const uint32_t* bits, int64_t num_counters) {
+                 WriteValues(first_counter_index, bits, num_counters, output, size, [&](T* values, int64_t count) {
+                   for (int64_t i = 0; i < count; ++i) {
+                     values[i] = offset + range * values[i];
+                   }
+                 });
+               });
+}
+
+template <typename T>
+void GenerateNormal(uint64_t key, uint64_t counter, float mean, float scale, T* output, int64_t size,
+                    concurrency::ThreadPool* tp) {
+  const T mean_value = static_cast<T>(mean);
+  const T scale_value = static_cast<T>(scale);
+  ForEachBlock(key, counter, NumCounters<T>(size), tp,
+               [&](int64_t first_counter_index, const uint32_t* bits, int64_t num_counters) {
+                 WriteValues(first_counter_index, bits, num_counters, output, size, [&](T* values, int64_t count) {
+                   // the values per counter are even, so they pair up within each counter
+                   for (int64_t i = 0; i < count; i += 2) {
+                     T z0, z1;
+                     BoxMuller(values[i], values[i + 1], z0, z1);
+                     values[i] = mean_value + scale_value * z0;
+                     values[i + 1] = mean_value + scale_value * z1;
+                   }
+                 });
+               });
+}
+
+template void GenerateUniform<float>(uint64_t, uint64_t, float, float, float*, int64_t, concurrency::ThreadPool*);
+template void GenerateUniform<double>(uint64_t, uint64_t, float, float, double*, int64_t, concurrency::ThreadPool*);
+template void GenerateNormal<float>(uint64_t, uint64_t, float, float, float*, int64_t, concurrency::ThreadPool*);
+template void GenerateNormal<double>(uint64_t, uint64_t, float, float, double*, int64_t, concurrency::ThreadPool*);
+
+}  // namespace philox
+}  // namespace onnxruntime
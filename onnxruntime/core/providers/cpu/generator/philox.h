@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+#include "core/common/common.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+/**
+Philox4x32-10 counter based random number generator (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+
+Each 64 bit counter maps to 4 random uint32 for the 64 bit key, without any state carried from one counter to the
+next, so the values of a tensor are generated in parallel from a range of counters and are the same for any number
+of threads. The generator only keeps the next counter, which every Compute call advances past the counters it uses,
+so a kernel with a fixed seed produces the same sequence of outputs, as it did with std::default_random_engine.
+*/
+class PhiloxGenerator {
+ public:
+  explicit PhiloxGenerator(uint64_t seed) : key_(seed) {}
+
+  uint64_t Key() const { return key_; }
+
+  // Reserves num_counters counters for the caller and returns the first one. Thread-safe.
+  uint64_t NextCounters(uint64_t num_counters) { return next_counter_.fetch_add(num_counters); }
+
+  // The 4 random values of the counter for the key.
+  static void Generate(uint64_t key, uint64_t counter, uint32_t result[4]) {
+    uint32_t c0 = static_cast<uint32_t>(counter), c1 = static_cast<uint32_t>(counter >> 32), c2 = 0, c3 = 0;
+    uint32_t k0 = static_cast<uint32_t>(key), k1 = static_cast<uint32_t>(key >> 32);
+    for (int round = 0; round < 10; ++round) {
+      const uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+      const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+      c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+      c1 = static_cast<uint32_t>(p1);
+      c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+      c3 = static_cast<uint32_t>(p0);
+      k0 += 0x9E3779B9u;
+      k1 += 0xBB67AE85u;
+    }
+    result[0] = c0;
+    result[1] = c1;
+    result[2] = c2;
+    result[3] = c3;
+  }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PhiloxGenerator);
+
+  const uint64_t key_;
+  std::atomic<uint64_t> next_counter_{0};
+};
+
+namespace philox {
+
+// The values of type T generated per counter: 4 float from 4 uint32, or 2 double from 2 uint64.
+template <typename T>
+constexpr int64_t ValuesPerCounter() { return 16 / static_cast<int64_t>(sizeof(T)); }
+
+template <typename T>
+int64_t NumCounters(int64_t num_values) {
+  return (num_values + ValuesPerCounter<T>() - 1) / ValuesPerCounter<T>();
+}
+
+// Uniform in [0, 1), from the 24 or 53 high bits of the random bits.
+inline float ToUniform(uint32_t bits) { return static_cast<float>(bits >> 8) * (1.0f / 16777216.0f); }
+inline double ToUniform(uint64_t bits) { return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0); }
+
+// Box-Muller transform of two uniform values in [0, 1) into two independent standard normal values.
+template <typename T>
+void BoxMuller(T u0, T u1, T& z0, T& z1) {
+  // 1 - u0 is in (0, 1], which keeps the log finite
+  const T radius = std::sqrt(T(-2) * std::log(T(1) - u0));
+  const T theta = T(6.283185307179586476925) * u1;
+  z0 = radius * std::cos(theta);
+  z1 = radius * std::sin(theta);
+}
+
+// Fills output with size uniform values in [low, high), or normal values of mean and scale, from the counters
+// starting at counter, i.e. the value i comes from the counter counter + i / ValuesPerCounter<T>(). Runs in
+// parallel on tp.
+template <typename T>
+void GenerateUniform(uint64_t key, uint64_t counter, float low, float high, T* output, int64_t size,
+                     concurrency::ThreadPool* tp);
+
+template <typename T>
+void GenerateNormal(uint64_t key, uint64_t counter, float mean, float scale, T* output, int64_t size,
+                    concurrency::ThreadPool* tp);
+
+}  // namespace philox
+}  // namespace onnxruntime
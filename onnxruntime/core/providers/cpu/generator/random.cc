@@ -72,11 +72,10 @@ ONNX_CPU_OPERATOR_KERNEL(
     KernelDefBuilder().TypeConstraint("T1", DataTypeImpl::GetTensorType<float>()).TypeConstraint("T2", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}),
     Multinomial);
 
-template <typename T, typename TDistribution>
-void GenerateData(std::default_random_engine& generator, TDistribution distribution, Tensor& tensor);
-
-static Status RandomNormalCompute(float mean, float scale, std::default_random_engine& generator, TensorProto::DataType dtype, Tensor& Y);
-static Status RandomUniformCompute(float high, float low, std::default_random_engine& generator, TensorProto::DataType dtype, Tensor& Y);
+static Status RandomNormalCompute(float mean, float scale, PhiloxGenerator& generator, TensorProto::DataType dtype,
+                                  concurrency::ThreadPool* tp, Tensor& Y);
+static Status RandomUniformCompute(float low, float high, PhiloxGenerator& generator, TensorProto::DataType dtype,
+                                   concurrency::ThreadPool* tp, Tensor& Y);
 
 static Status CreateOutputTensorFromTensorShape(OpKernelContext* ctx, const Tensor& X, Tensor** Y);
 static TensorProto::DataType InferDataType(const Tensor& tensor);
@@ -84,8 +83,7 @@ static TensorProto::DataType InferDataType(const Tensor& tensor);
 Status RandomNormal::Compute(OpKernelContext* ctx) const {
   Tensor& Y = *ctx->Output(0, shape_);
 
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  auto status = RandomNormalCompute(mean_, scale_, generator_, dtype_, Y);
+  auto status = RandomNormalCompute(mean_, scale_, generator_, dtype_, ctx->GetOperatorThreadPool(), Y);
 
   return status;
 }
@@ -93,8 +91,7 @@ Status RandomNormal::Compute(OpKernelContext* ctx) const {
 Status RandomUniform::Compute(OpKernelContext* ctx) const {
   Tensor& Y = *ctx->Output(0, shape_);
 
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  auto status = RandomUniformCompute(low_, high_, generator_, dtype_, Y);
+  auto status = RandomUniformCompute(low_, high_, generator_, dtype_, ctx->GetOperatorThreadPool(), Y);
 
   return status;
 }
@@ -115,8 +112,7 @@ Status RandomNormalLike::Compute(OpKernelContext* ctx) const {
                            "Could not infer data type from input tensor with data type ",
                            X.DataType());
 
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  status = RandomNormalCompute(mean_, scale_, generator_, dtype, *Y);
+  status = RandomNormalCompute(mean_, scale_, generator_, dtype, ctx->GetOperatorThreadPool(), *Y);
 
   return status;
 }
@@ -136,8 +132,7 @@ Status RandomUniformLike::Compute(OpKernelContext* ctx) const {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
                            "Could not infer data type from input tensor with data type ",
                            X.DataType());
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  status = RandomUniformCompute(low_, high_, generator_, dtype, *Y);
+  status = RandomUniformCompute(low_, high_, generator_, dtype, ctx->GetOperatorThreadPool(), *Y);
 
   return status;
 }
@@ -278,21 +273,37 @@ static TensorProto::DataType InferDataType(const Tensor& tensor) {
   return static_cast<TensorProto::DataType>(dtype);
 }
 
+// The values of Y come from the next counters of generator, so a kernel with a given seed produces the same
+// sequence of outputs whatever the number of threads.
+template <typename T>
+static void GenerateNormal(float mean, float scale, PhiloxGenerator& generator, concurrency::ThreadPool* tp,
+                           Tensor& Y) {
+  const int64_t size = Y.Shape().Size();
+  const uint64_t counter = generator.NextCounters(philox::NumCounters<T>(size));
+  philox::GenerateNormal<T>(generator.Key(), counter, mean, scale, Y.MutableData<T>(), size, tp);
+}
+
+template <typename T>
+static void GenerateUniform(float low, float high, PhiloxGenerator& generator, concurrency::ThreadPool* tp,
+                            Tensor& Y) {
+  const int64_t size = Y.Shape().Size();
+  const uint64_t counter = generator.NextCounters(philox::NumCounters<T>(size));
+  philox::GenerateUniform<T>(generator.Key(), counter, low, high, Y.MutableData<T>(), size, tp);
+}
+
 static Status RandomNormalCompute(float mean, float scale,
-                                  std::default_random_engine& generator,
-                                  TensorProto::DataType dtype, Tensor& Y) {
+                                  PhiloxGenerator& generator,
+                                  TensorProto::DataType dtype, concurrency::ThreadPool* tp, Tensor& Y) {
   switch (dtype) {
     case TensorProto::FLOAT: {
-      GenerateData<float, std::normal_distribution<float>>(
-          generator, std::normal_distribution<float>{mean, scale}, Y);
+      GenerateNormal<float>(mean, scale, generator, tp, Y);
       break;
     }
     case TensorProto::FLOAT16: {
       ORT_NOT_IMPLEMENTED("FLOAT16 is not supported");
     }
     case TensorProto::DOUBLE: {
-      GenerateData<double, std::normal_distribution<double>>(
-          generator, std::normal_distribution<double>{mean, scale}, Y);
+      GenerateNormal<double>(mean, scale, generator, tp, Y);
       break;
     }
     default:
@@ -303,21 +314,20 @@ static Status RandomNormalCompute(float mean, float scale,
 }
 
 static Status RandomUniformCompute(float low, float high,
-                                   std::default_random_engine& generator,
+                                   PhiloxGenerator& generator,
                                    TensorProto::DataType dtype,
+                                   concurrency::ThreadPool* tp,
                                    Tensor& Y) {
   switch (dtype) {
     case TensorProto::FLOAT: {
-      GenerateData<float, std::uniform_real_distribution<float>>(
-          generator, std::uniform_real_distribution<float>{low, high}, Y);
+      GenerateUniform<float>(low, high, generator, tp, Y);
       break;
     }
     case TensorProto::FLOAT16: {
       ORT_NOT_IMPLEMENTED("FLOAT16 is not supported");
     }
     case TensorProto::DOUBLE: {
-      GenerateData<double, std::uniform_real_distribution<double>>(
-          generator, std::uniform_real_distribution<double>{low, high}, Y);
+      GenerateUniform<double>(low, high, generator, tp, Y);
       break;
     }
     default:
@@ -327,13 +337,4 @@ static Status RandomUniformCompute(float low, float high,
   return Status::OK();
 }
 
-template <typename T, typename TDistribution>
-void GenerateData(std::default_random_engine& generator, TDistribution distribution, Tensor& tensor) {
-  T* out = tensor.MutableData<T>();
-  for (int64_t i = 0, end = tensor.Shape().Size(); i < end; ++i) {
-    *out = distribution(generator);
-    ++out;
-  }
-}
-
 }  // namespace onnxruntime
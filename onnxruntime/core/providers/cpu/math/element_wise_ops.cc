@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/element_wise_ops.h"
+#include "core/providers/cpu/tensor/tile.h"
 #include <unsupported/Eigen/SpecialFunctions>
 #include "core/util/math.h"
 #include "core/mlas/inc/mlas.h"
@@ -18,6 +19,16 @@ namespace onnxruntime {
       KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
       KERNEL_CLASS<TYPE>);
 
+// unary element-wise ops compute each output element only from the input element at the same index, so the
+// output can always be written into the input buffer if the planner finds the input is no longer needed.
+#define REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS)                  \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                                   \
+      OP_TYPE,                                                                                      \
+      VERSION,                                                                                      \
+      TYPE,                                                                                         \
+      KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
+      KERNEL_CLASS<TYPE>);
+
 #define REG_ELEMENTWISE_LOGICALOP_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS) \
   ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                    \
       OP_TYPE,                                                                       \
@@ -66,39 +77,39 @@ REG_ELEMENTWISE_TYPED_KERNEL(Div, 7, double, Div);
 REG_ELEMENTWISE_TYPED_KERNEL(Div, 7, int32_t, Div);
 REG_ELEMENTWISE_TYPED_KERNEL(Div, 7, int64_t, Div);
 
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 6, float, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 6, double, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 6, int8_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 6, int16_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 6, int32_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 6, int64_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 6, uint8_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 6, uint16_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 6, uint32_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 6, uint64_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 6, float, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 6, double, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 6, int8_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 6, int16_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 6, int32_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 6, int64_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 6, uint8_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 6, uint16_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 6, uint32_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 6, uint64_t, Abs);
 
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 6, float, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 6, double, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 6, int8_t, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 6, int32_t, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 6, int64_t, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 6, float, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 6, double, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 6, int8_t, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 6, int32_t, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 6, int64_t, Neg);
 
-REG_ELEMENTWISE_TYPED_KERNEL(Floor, 6, float, Floor);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Floor, 6, float, Floor);
 
-REG_ELEMENTWISE_TYPED_KERNEL(Ceil, 6, float, Ceil);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Ceil, 6, float, Ceil);
 
-REG_ELEMENTWISE_TYPED_KERNEL(Reciprocal, 6, float, Reciprocal);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Reciprocal, 6, float, Reciprocal);
 
-REG_ELEMENTWISE_TYPED_KERNEL(Sqrt, 6, float, Sqrt);
-REG_ELEMENTWISE_TYPED_KERNEL(Sqrt, 6, double, Sqrt);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sqrt, 6, float, Sqrt);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sqrt, 6, double, Sqrt);
 
 REG_ELEMENTWISE_TYPED_KERNEL(Pow, 7, float, Pow);
 REG_ELEMENTWISE_TYPED_KERNEL(Pow, 7, double, Pow);
 
-REG_ELEMENTWISE_TYPED_KERNEL(Exp, 6, float, Exp);
-REG_ELEMENTWISE_TYPED_KERNEL(Exp, 6, double, Exp);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Exp, 6, float, Exp);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Exp, 6, double, Exp);
 
-REG_ELEMENTWISE_TYPED_KERNEL(Log, 6, float, Log);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Log, 6, float, Log);
 
 REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sum, 6, 7, float, Sum_6);
 REG_ELEMENTWISE_TYPED_KERNEL(Sum, 8, float, Sum_8);
@@ -135,7 +146,7 @@ REG_ELEMENTWISE_TYPED_KERNEL(BitShift, 11, uint8_t, BitShift);
 REG_ELEMENTWISE_TYPED_KERNEL(BitShift, 11, uint32_t, BitShift);
 REG_ELEMENTWISE_TYPED_KERNEL(BitShift, 11, uint64_t, BitShift);
 
-REG_ELEMENTWISE_TYPED_KERNEL(Erf, 9, float, Erf);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Erf, 9, float, Erf);
 
 // REG_ELEMENTWISE_LOGICALOP_TYPED_KERNEL(Not, 1, bool, Not);
 // REG_ELEMENTWISE_LOGICALOP_TYPED_KERNEL(And, 7, bool, And);
@@ -146,6 +157,7 @@ ONNX_CPU_OPERATOR_KERNEL(
     Not,
     1,
     KernelDefBuilder()
+        .MayInplace(0, 0)
         .TypeConstraint("T", DataTypeImpl::GetTensorType<bool>())
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>()),
     Not);
@@ -595,14 +607,14 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Sin,
     7,
     float,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Sin<float>);
 
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Sin,
     7,
     double,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Sin<double>);
 
 template <typename T>
@@ -622,7 +634,7 @@ class Cos final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Cos,
     7,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Cos<float>);
 
 template <typename T>
@@ -642,7 +654,7 @@ class Tan final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Tan,
     7,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Tan<float>);
 
 template <typename T>
@@ -662,7 +674,7 @@ class Asin final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Asin,
     7,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Asin<float>);
 
 template <typename T>
@@ -682,7 +694,7 @@ class Acos final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Acos,
     7,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Acos<float>);
 
 template <typename T>
@@ -702,7 +714,7 @@ class Atan final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Atan,
     7,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Atan<float>);
 
 template <typename T>
@@ -722,7 +734,7 @@ class Sinh final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Sinh,
     9,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Sinh<float>);
 
 template <typename T>
@@ -742,7 +754,7 @@ class Cosh final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Cosh,
     9,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Cosh<float>);
 
 template <typename T>
@@ -774,7 +786,7 @@ class Asinh final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Asinh,
     9,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Asinh<float>);
 
 template <typename T>
@@ -806,7 +818,7 @@ class Acosh final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Acosh,
     9,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Acosh<float>);
 
 template <typename T>
@@ -838,7 +850,7 @@ class Atanh final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Atanh,
     9,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Atanh<float>);
 
 template <>
@@ -866,35 +878,11 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     PRelu<float>);
 
-// This is a special case version of TBroadcaster just for Expand that only has a shape as the second parameter
-template <typename T>
-struct TBroadcasterExpand {
-  TBroadcasterExpand(const Tensor& input, const std::vector<int64_t>& shape)
-      : input_tensor_(input),
-        broadcaster_(input.Shape().GetDims(), shape) {
-  }
-
-  TensorShape GetOutputShape() const { return TensorShape(broadcaster_.output_shape_); }
-  size_t GetSpanSize() const { return span_size_; }
-
-  bool IsInput0Scalar() const { return broadcaster_.iterator1_.deltas_.front() == 0; }
-
-  T NextScalar() { return *Next(); }
-
-  ConstEigenVectorMap<T> NextEigen() { return ConstEigenVectorMap<T>(Next(), span_size_); }
-
- private:
-  const T* Next() { return input_ + broadcaster_.iterator1_.AdvanceBy(span_size_); }
-
-  const Tensor& input_tensor_;
-  Broadcaster broadcaster_;
-  size_t span_size_{broadcaster_.GetSpanSize()};
-
-  const T* input_{input_tensor_.template Data<T>()};
-};
-
+// Expand is a Tile of the input, with leading dims of 1 added to it, where each dim of 1 is repeated to the dim of
+// the output.
 template <typename T>
 Status Expand_8<T>::Compute(OpKernelContext* context) const {
+  const auto& input_tensor = *context->Input<Tensor>(0);
   auto& tensor_shape = *context->Input<Tensor>(1);
   ORT_ENFORCE(tensor_shape.Shape().GetDims().size() == 1, "Shape must be 1 dimensional as it's tensor data is a shape");
 
@@ -902,19 +890,33 @@ Status Expand_8<T>::Compute(OpKernelContext* context) const {
   const auto* p_shape = tensor_shape.template Data<int64_t>();
   std::vector<int64_t> shape{p_shape, p_shape + tensor_shape.Shape().Size()};
 
-  TBroadcasterExpand<T> bc(*context->Input<Tensor>(0), shape);
-  TBroadcastOutput<T> output(bc.GetSpanSize(), *context->Output(0, bc.GetOutputShape()));
+  const auto& input_dims = input_tensor.Shape().GetDims();
+  const size_t rank = std::max(input_dims.size(), shape.size());
+  std::vector<int64_t> expanded_input_dims(rank, 1);
+  std::vector<int64_t> output_dims(rank, 1);
+  std::vector<int64_t> repeats(rank, 1);
+  std::copy(input_dims.begin(), input_dims.end(), expanded_input_dims.end() - input_dims.size());
+  std::copy(shape.begin(), shape.end(), output_dims.end() - shape.size());
+  for (size_t axis = 0; axis < rank; ++axis) {
+    const int64_t input_dim = expanded_input_dims[axis];
+    if (input_dim == 1) {
+      repeats[axis] = output_dims[axis];
+    } else if (output_dims[axis] == 1 || output_dims[axis] == input_dim) {
+      output_dims[axis] = input_dim;
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Expand: the input of shape ", input_tensor.Shape(),
+                             " can't be broadcast to the shape ", TensorShape(shape));
+    }
+  }
 
-  // This doesn't use BroadcastLoop since there is no second tensor, just duplicating the first
-  if (bc.IsInput0Scalar()) {
-    // Input0 being a scalar is the only special case here, since we're duplicating a single value
-    while (output)
-      output.NextEigenOutput().array() = bc.NextScalar();
-  } else {
-    // Input1 being a scalar doesn't matter (as there's no actual input1). We're still duplicating Input0 in the same sized chunks
-    while (output)
-      output.NextEigenOutput() = bc.NextEigen();
+  TensorShape output_shape(output_dims);
+  auto& output_tensor = *context->Output(0, output_shape);
+  if (output_shape.Size() == 0) {
+    return Status::OK();
   }
+
+  TileFixedSizeTypes(expanded_input_dims, input_tensor.DataRaw(), repeats.data(), sizeof(T),
+                     output_tensor.MutableDataRaw(), context->GetOperatorThreadPool());
   return Status::OK();
 }
 
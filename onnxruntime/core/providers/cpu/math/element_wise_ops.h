@@ -3,8 +3,12 @@
 
 #pragma once
 
+#include <limits>
+
 #include "core/common/common.h"
+#include "core/framework/kernel_cost.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -16,6 +20,10 @@ class Add final : public OpKernel {
   }
 
   Status Compute(OpKernelContext* context) const override;
+  bool GetCost(OpKernelContext& context, KernelCost& cost) const override {
+    cost = kernel_cost::Elementwise(context);
+    return true;
+  }
 };
 
 template <typename T>
@@ -25,6 +33,10 @@ class Sub final : public OpKernel {
   }
 
   Status Compute(OpKernelContext* context) const override;
+  bool GetCost(OpKernelContext& context, KernelCost& cost) const override {
+    cost = kernel_cost::Elementwise(context);
+    return true;
+  }
 };
 
 template <typename T>
@@ -34,6 +46,10 @@ class Mul final : public OpKernel {
   }
 
   Status Compute(OpKernelContext* context) const override;
+  bool GetCost(OpKernelContext& context, KernelCost& cost) const override {
+    cost = kernel_cost::Elementwise(context);
+    return true;
+  }
 };
 
 template <typename T>
@@ -43,6 +59,10 @@ class Div final : public OpKernel {
   }
 
   Status Compute(OpKernelContext* context) const override;
+  bool GetCost(OpKernelContext& context, KernelCost& cost) const override {
+    cost = kernel_cost::Elementwise(context);
+    return true;
+  }
 };
 
 template <typename T>
@@ -330,6 +350,18 @@ struct BroadcastIterator {
     return index;
   }
 
+  // Positions the iterator on the entry used for element 'offset' of the output
+  void Seek(int64_t offset) {
+    auto block_size = offset;
+    index_ = 0;
+    for (size_t counterIndex = 0; counterIndex < counters_.size(); counterIndex++) {
+      // 'block_size' is the number of times this counter has been advanced to reach 'offset'
+      index_ += deltas_[counterIndex] * block_size;
+      counters_[counterIndex] = block_size % counts_[counterIndex];
+      block_size /= counts_[counterIndex];
+    }
+  }
+
   void Reserve(int64_t max_dims) {
     deltas_.reserve(static_cast<size_t>(max_dims));
     counts_.reserve(static_cast<size_t>(max_dims));
@@ -509,9 +541,25 @@ struct TBroadcaster {
   ConstEigenVectorMap<T0> NextEigen0() { return ConstEigenVectorMap<T0>(Next0(), span_size_); }
   ConstEigenVectorMap<T1> NextEigen1() { return ConstEigenVectorMap<T1>(Next1(), span_size_); }
 
+  // Positions both inputs on the entries used for element 'offset' of the output. The Next* overloads taking a
+  // count can then walk the output from there in pieces that don't cross the end of a span.
+  void Seek(size_t offset) {
+    broadcaster_.iterator1_.Seek(static_cast<int64_t>(offset));
+    broadcaster_.iterator2_.Seek(static_cast<int64_t>(offset));
+  }
+
+  const T0& NextScalar0(size_t count) { return *Next0(count); }
+  const T1& NextScalar1(size_t count) { return *Next1(count); }
+
+  ConstEigenVectorMap<T0> NextEigen0(size_t count) { return ConstEigenVectorMap<T0>(Next0(count), count); }
+  ConstEigenVectorMap<T1> NextEigen1(size_t count) { return ConstEigenVectorMap<T1>(Next1(count), count); }
+
  private:
-  const T0* Next0() { return input0_ + broadcaster_.iterator1_.AdvanceBy(span_size_); }
-  const T1* Next1() { return input1_ + broadcaster_.iterator2_.AdvanceBy(span_size_); }
+  const T0* Next0() { return Next0(span_size_); }
+  const T1* Next1() { return Next1(span_size_); }
+
+  const T0* Next0(size_t count) { return input0_ + broadcaster_.iterator1_.AdvanceBy(count); }
+  const T1* Next1(size_t count) { return input1_ + broadcaster_.iterator2_.AdvanceBy(count); }
 
   const Tensor& input_tensor0_;
   const Tensor& input_tensor1_;
@@ -610,11 +658,60 @@ void BroadcastLoopSpan(TBroadcaster& bc, Output& output, Input0Scalar input0scal
   }
 }
 
+// Number of output elements computed by each task of ParallelBroadcastLoop
+constexpr int64_t kParallelBroadcastBlockSize = 16384;
+
+// Parallel version of BroadcastLoop, taking the same functions. The output is split into blocks of
+// kParallelBroadcastBlockSize elements that are computed on the thread pool. Each block positions its own copy of
+// the broadcaster at the start of the block and walks the spans overlapping it, so a span can be split between
+// blocks and the functions are called with the part of the span that falls in the block. The functions must not
+// modify shared state.
+template <typename TOutput, typename TBroadcaster, typename Input0Scalar, typename Input1Scalar, typename General>
+void ParallelBroadcastLoop(concurrency::ThreadPool* tp, TBroadcaster& bc, Tensor& output_tensor,
+                           Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
+  const int64_t output_size = output_tensor.Shape().Size();
+  const int64_t block_size = std::max<int64_t>(kParallelBroadcastBlockSize,
+                                               output_size / std::numeric_limits<int32_t>::max() + 1);
+  const int64_t num_blocks = (output_size + block_size - 1) / block_size;
+
+  if (num_blocks <= 1) {
+    TBroadcastOutput<TOutput> output(bc.GetSpanSize(), output_tensor);
+    BroadcastLoop(bc, output, input0scalar, input1scalar, general);
+    return;
+  }
+
+  TOutput* output = output_tensor.template MutableData<TOutput>();
+  const int64_t span_size = static_cast<int64_t>(bc.GetSpanSize());
+  const bool input0_scalar = bc.IsInput0Scalar();
+  const bool input1_scalar = bc.IsInput1Scalar();
+
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t block) {
+    int64_t offset = block * block_size;
+    const int64_t end = std::min(offset + block_size, output_size);
+
+    TBroadcaster block_bc(bc);
+    block_bc.Seek(static_cast<size_t>(offset));
+
+    while (offset < end) {
+      const auto count = static_cast<size_t>(std::min(span_size - offset % span_size, end - offset));
+      EigenVectorMap<TOutput> block_output(output + offset, count);
+      if (input0_scalar) {
+        input0scalar(block_output, block_bc.NextScalar0(count), block_bc.NextEigen1(count));
+      } else if (input1_scalar) {
+        input1scalar(block_output, block_bc.NextEigen0(count), block_bc.NextScalar1(count));
+      } else {
+        general(block_output, block_bc.NextEigen0(count), block_bc.NextEigen1(count));
+      }
+      offset += count;
+    }
+  });
+}
+
 template <typename TInput, typename TOutput, typename Input0Scalar, typename Input1Scalar, typename General>
 Status BroadcastTwo(OpKernelContext& context, Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
   TBroadcaster<TInput, TInput> bc(*context.Input<Tensor>(0), *context.Input<Tensor>(1));
-  TBroadcastOutput<TOutput> output(bc.GetSpanSize(), *context.Output(0, bc.GetOutputShape()));
-  BroadcastLoop(bc, output, input0scalar, input1scalar, general);
+  Tensor& output = *context.Output(0, bc.GetOutputShape());
+  ParallelBroadcastLoop<TOutput>(context.GetOperatorThreadPool(), bc, output, input0scalar, input1scalar, general);
 
   return Status::OK();
 }
@@ -651,9 +748,7 @@ Status BroadcastVariadic(const Node& node, OpKernelContext& context, Input0Scala
       p_output = tempOutput.get();
     }
 
-    TBroadcastOutput<TOutput> output(bc.GetSpanSize(), *p_output);
-
-    BroadcastLoop(bc, output, input0scalar, input1scalar, general);
+    ParallelBroadcastLoop<TOutput>(context.GetOperatorThreadPool(), bc, *p_output, input0scalar, input1scalar, general);
 
     tempInput = std::move(tempOutput);
   }
@@ -5,25 +5,116 @@
 
 namespace onnxruntime {
 
-ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     Gemm,
     7,
     8,
+    float,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Gemm<float>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    7,
+    8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+
 // opset 9 added support for additional types (int32, uint32, int64, uint64), however we haven't enabled those yet.
-ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     Gemm,
-    9, 
+    9,
     10,
+    float,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Gemm<float>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    9,
+    10,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+
 // opset 11 made bias input 'C' optional
-ONNX_CPU_OPERATOR_KERNEL(
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Gemm,
     11,
+    float,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Gemm<float>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Gemm,
+    11,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+
+template <>
+Status Gemm<MLFloat16>::Compute(OpKernelContext* context) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const auto* X = context->Input<Tensor>(0);
+  const auto* W = context->Input<Tensor>(1);
+  const auto* B = context->Input<Tensor>(2);
+  // Bias could be missing. Treat as scalar 0 if that is the case.
+  GemmHelper helper(X->Shape(), trans_A_ != CblasNoTrans, W->Shape(), trans_B_ != CblasNoTrans,
+                    B != nullptr ? B->Shape() : TensorShape({}));
+
+  if (!helper.State().IsOK())
+    return helper.State();
+
+  int64_t M = helper.M();
+  int64_t N = helper.N();
+  int64_t K = helper.K();
+
+  auto Y = context->Output(0, {M, N});
+
+  // if input is empty tensor, return as nothing need to be calculated and we've set the shape for the output
+  if (M == 0 || N == 0)
+    return Status::OK();
+
+  auto* y_data = reinterpret_cast<uint16_t*>(Y->MutableData<MLFloat16>());
+
+  // Broadcast the bias into the output. MlasHalfGemm scales it by beta in single precision, so the bias is only
+  // rounded once together with the product.
+  const bool use_bias = B != nullptr && beta_ != 0;
+  if (use_bias) {
+    const auto* b_data = reinterpret_cast<const uint16_t*>(B->Data<MLFloat16>());
+    const TensorShape& b_shape = B->Shape();
+    for (int64_t m = 0; m < M; m++) {
+      uint16_t* y_row = y_data + m * N;
+      if (b_shape.Size() == 1) {
+        // C is (), (1,) or (1, 1), set the scalar
+        std::fill_n(y_row, N, b_data[0]);
+      } else if (b_shape.NumDimensions() == 1 || b_shape[0] == 1) {
+        // C is (N,) or (1, N)
+        std::copy_n(b_data, N, y_row);
+      } else if (b_shape[1] == 1) {
+        // C is (M, 1)
+        std::fill_n(y_row, N, b_data[m]);
+      } else {
+        // C is (M, N), no broadcast needed.
+        std::copy_n(b_data + m * N, N, y_row);
+      }
+    }
+  }
+
+  MlasHalfGemm(MlasFloat16Format, trans_A_, trans_B_,
+               static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+               alpha_,
+               reinterpret_cast<const uint16_t*>(X->Data<MLFloat16>()),
+               static_cast<size_t>(trans_A_ == CblasNoTrans ? K : M),
+               reinterpret_cast<const uint16_t*>(W->Data<MLFloat16>()),
+               static_cast<size_t>(trans_B_ == CblasNoTrans ? N : K),
+               use_bias ? beta_ : 0.0f,
+               y_data, static_cast<size_t>(N),
+               thread_pool);
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
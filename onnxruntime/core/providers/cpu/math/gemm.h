@@ -4,7 +4,10 @@
 #pragma once
 
 #include "core/common/common.h"
+#include "core/framework/kernel_cost.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
@@ -26,6 +29,19 @@ class Gemm : public OpKernel {
     ORT_ENFORCE(info.GetAttr<float>("beta", &beta_).IsOK());
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights& prepacked_weights) override {
+    is_packed = input_idx == 1 && GemmPackBFp32(alloc, tensor, trans_B_ != CblasNoTrans, prepacked_weights);
+    return Status::OK();
+  }
+
+  Status UseSharedPrePackedBuffers(const PrePackedWeights& prepacked_weights, int input_idx) override {
+    if (input_idx == 1) {
+      packed_b_ = prepacked_weights.buffers_[0].get();
+    }
+    return Status::OK();
+  }
+
   static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           int64_t M, int64_t N, int64_t K,
                           float alpha,
@@ -38,24 +54,7 @@ class Gemm : public OpKernel {
     if (M == 0 || N == 0)
       return;
 
-    // Broadcast the bias as needed if bias is given
-    if (beta != 0 && c_data != nullptr) {
-      ORT_ENFORCE(c_shape != nullptr, "c_shape is required if c_data is provided");
-      auto output_mat = EigenMatrixMapRowMajor<T>(y_data, M, N);
-      if (c_shape->Size() == 1) {
-        // C is (), (1,) or (1, 1), set the scalar
-        output_mat.setConstant(*c_data);
-      } else if (c_shape->NumDimensions() == 1 || (*c_shape)[0] == 1) {
-        // C is (N,) or (1, N)
-        output_mat.rowwise() = ConstEigenVectorMap<T>(c_data, N).transpose();
-      } else if ((*c_shape)[1] == 1) {
-        // C is (M, 1)
-        output_mat.colwise() = ConstEigenVectorMap<T>(c_data, M);
-      } else {
-        // C is (M, N), no broadcast needed.
-        output_mat = ConstEigenMatrixMapRowMajor<T>(c_data, M, N);
-      }
-    }
+    BroadcastBias(M, N, beta, c_data, c_shape, y_data);
 
     math::Gemm<T>(trans_a, trans_b,
                   M, N, K,
@@ -69,6 +68,46 @@ class Gemm : public OpKernel {
                   thread_pool);
   }
 
+  // ComputeGemm with MlasGemm, using packed_b instead of b_data if it was packed by MlasGemmPackB, and applying
+  // the optional epilogue to the output
+  static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                          int64_t M, int64_t N, int64_t K,
+                          float alpha,
+                          const T* a_data, const T* b_data, const void* packed_b,
+                          float beta,
+                          const T* c_data, const TensorShape* c_shape,
+                          T* y_data,
+                          const MLAS_GEMM_EPILOGUE* epilogue,
+                          concurrency::ThreadPool* thread_pool) {
+    if (M == 0 || N == 0)
+      return;
+
+    BroadcastBias(M, N, beta, c_data, c_shape, y_data);
+
+    const size_t lda = static_cast<size_t>(trans_a == CblasNoTrans ? K : M);
+    if (packed_b != nullptr) {
+      MlasGemm(trans_a,
+               static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+               alpha,
+               a_data, lda,
+               packed_b,
+               c_data != nullptr ? beta : 0,
+               y_data, static_cast<size_t>(N),
+               epilogue,
+               thread_pool);
+    } else {
+      MlasGemm(trans_a, trans_b,
+               static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+               alpha,
+               a_data, lda,
+               b_data, static_cast<size_t>(trans_b == CblasNoTrans ? N : K),
+               c_data != nullptr ? beta : 0,
+               y_data, static_cast<size_t>(N),
+               epilogue,
+               thread_pool);
+    }
+  }
+
   Status Compute(OpKernelContext* context) const override {
     concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
@@ -97,26 +136,105 @@ class Gemm : public OpKernel {
 
     T* y_data = Y->MutableData<T>();
 
-    ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, X->Data<T>(), W->Data<T>(), beta_,
-                b_data, b_shape,
-                y_data,
-                thread_pool);
+    // A bias row vector and the fused activation are applied by the epilogue of MlasGemm while the output is still
+    // in cache. Other bias shapes are broadcast into the output before the GEMM.
+    MLAS_ACTIVATION activation;
+    const bool fuse_activation = GetMlasActivation(activation);
+    const bool fuse_bias = b_data != nullptr && beta_ == 1.0f && b_shape->Size() == N &&
+                           (b_shape->NumDimensions() == 1 || (b_shape->NumDimensions() == 2 && (*b_shape)[0] == 1));
+    const bool use_epilogue = K > 0 && (fuse_activation || fuse_bias);
+
+    MLAS_GEMM_EPILOGUE epilogue;
+    epilogue.Bias = fuse_bias ? b_data : nullptr;
+    epilogue.Activation = fuse_activation ? &activation : nullptr;
+    epilogue.Residual = nullptr;
+    epilogue.ldr = 0;
+
+    if (use_epilogue || packed_b_ != nullptr) {
+      ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, X->Data<T>(), W->Data<T>(), packed_b_, beta_,
+                  use_epilogue && fuse_bias ? nullptr : b_data, b_shape,
+                  y_data,
+                  use_epilogue ? &epilogue : nullptr,
+                  thread_pool);
+    } else {
+      ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, X->Data<T>(), W->Data<T>(), beta_,
+                  b_data, b_shape,
+                  y_data,
+                  thread_pool);
+    }
 
-    FuseActivation<T>(activation_, y_data, M * N, leaky_relu_alpha_);
+    if (!(use_epilogue && fuse_activation)) {
+      FuseActivation<T>(activation_, y_data, M * N, leaky_relu_alpha_);
+    }
 
     return Status::OK();
   }
 
+  // each output element is a dot product over the K columns of op(A)
+  bool GetCost(OpKernelContext& context, KernelCost& cost) const override {
+    const auto& a_shape = context.Input<Tensor>(0)->Shape();
+    const int64_t K = a_shape.NumDimensions() == 2 ? a_shape[trans_A_ != CblasNoTrans ? 0 : 1] : 0;
+    cost = kernel_cost::DotProducts(context, K);
+    return true;
+  }
+
  private:
   CBLAS_TRANSPOSE trans_A_;
   CBLAS_TRANSPOSE trans_B_;
   float alpha_;
   float beta_;
 
+  // W in the layout of MlasGemm if it is a constant 2D matrix
+  const void* packed_b_ = nullptr;
+
+  // Maps the fused activation to the MLAS activation applied by the GEMM epilogue
+  bool GetMlasActivation(MLAS_ACTIVATION& activation) const {
+    if (activation_ == "Relu") {
+      activation.ActivationKind = MlasReluActivation;
+    } else if (activation_ == "Sigmoid") {
+      activation.ActivationKind = MlasLogisticActivation;
+    } else if (activation_ == "Tanh") {
+      activation.ActivationKind = MlasTanhActivation;
+    } else if (activation_ == "LeakyRelu") {
+      activation.ActivationKind = MlasLeakyReluActivation;
+      activation.Parameters.LeakyRelu.alpha = leaky_relu_alpha_;
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  // Broadcast the bias into y_data as needed if bias is given
+  static void BroadcastBias(int64_t M, int64_t N, float beta,
+                            const T* c_data, const TensorShape* c_shape,
+                            T* y_data) {
+    if (beta != 0 && c_data != nullptr) {
+      ORT_ENFORCE(c_shape != nullptr, "c_shape is required if c_data is provided");
+      auto output_mat = EigenMatrixMapRowMajor<T>(y_data, M, N);
+      if (c_shape->Size() == 1) {
+        // C is (), (1,) or (1, 1), set the scalar
+        output_mat.setConstant(*c_data);
+      } else if (c_shape->NumDimensions() == 1 || (*c_shape)[0] == 1) {
+        // C is (N,) or (1, N)
+        output_mat.rowwise() = ConstEigenVectorMap<T>(c_data, N).transpose();
+      } else if ((*c_shape)[1] == 1) {
+        // C is (M, 1)
+        output_mat.colwise() = ConstEigenVectorMap<T>(c_data, M);
+      } else {
+        // C is (M, N), no broadcast needed.
+        output_mat = ConstEigenMatrixMapRowMajor<T>(c_data, M, N);
+      }
+    }
+  }
+
  protected:
   // For fused gemm + activation
   std::string activation_;
   float leaky_relu_alpha_;
 };
 
+// MLFloat16 is multiplied by MlasHalfGemm, which accumulates in single precision
+template <>
+Status Gemm<MLFloat16>::Compute(OpKernelContext* context) const;
+
 }  // namespace onnxruntime
@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/math/gemm_matmul_common.h"
+
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+
+bool GemmPackBFp32(const AllocatorPtr& alloc, const Tensor& tensor_b, bool trans_b,
+                   PrePackedWeights& prepacked_weights) {
+  const auto& b_shape = tensor_b.Shape();
+  if (!tensor_b.IsDataType<float>() || b_shape.NumDimensions() != 2) {
+    return false;
+  }
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+
+  const size_t packed_b_size = MlasGemmPackBSize(N, K);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  void* packed_b_data = alloc->Alloc(packed_b_size);
+  BufferUniquePtr packed_b(packed_b_data, BufferDeleter(alloc));
+  MlasGemmPackB(trans_b ? CblasTrans : CblasNoTrans, N, K, tensor_b.Data<float>(), static_cast<size_t>(b_shape[1]),
+                packed_b_data);
+
+  prepacked_weights.buffers_.push_back(std::move(packed_b));
+  prepacked_weights.buffer_sizes_.push_back(packed_b_size);
+  return true;
+}
+
+}  // namespace onnxruntime
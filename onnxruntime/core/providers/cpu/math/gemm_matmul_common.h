@@ -0,0 +1,17 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/framework/allocator.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+// Packs the constant matrix B of a float GEMM into the layout MlasGemm computes with, so the kernel doesn't pack
+// it again on every run. Returns false if B is not a non-empty float 2D matrix.
+bool GemmPackBFp32(const AllocatorPtr& alloc, const Tensor& tensor_b, bool trans_b,
+                   /*out*/ PrePackedWeights& prepacked_weights);
+
+}  // namespace onnxruntime
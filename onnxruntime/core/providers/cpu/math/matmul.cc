@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/matmul.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "matmul_helper.h"
@@ -22,6 +24,13 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     MatMul<double>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    1, 8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
 // opset 9 supports more types
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     MatMul,
@@ -37,6 +46,13 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     MatMul<double>);
 
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    9,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     MatMul,
     9,
@@ -92,4 +108,114 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+template <>
+Status MatMul<MLFloat16>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const auto* left_X = ctx->Input<Tensor>(0);
+  const auto* right_X = ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(left_X->Shape(), right_X->Shape()));
+
+  Tensor* Y = ctx->Output(0, helper.OutputShape());
+
+  const auto* a_data = reinterpret_cast<const uint16_t*>(left_X->Data<MLFloat16>());
+  const auto* b_data = reinterpret_cast<const uint16_t*>(right_X->Data<MLFloat16>());
+  auto* y_data = reinterpret_cast<uint16_t*>(Y->MutableData<MLFloat16>());
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  size_t max_len = helper.OutputOffsets().size();
+  for (size_t i = 0; i < max_len; i++) {
+    MlasHalfGemm(MlasFloat16Format, CblasNoTrans, CblasNoTrans, M, N, K, 1.0f,
+                 a_data + helper.LeftOffsets()[i], K,
+                 b_data + helper.RightOffsets()[i], N,
+                 0.0f, y_data + helper.OutputOffsets()[i], N, thread_pool);
+  }
+
+  return Status::OK();
+}
+
+namespace {
+
+// Returns true if the matrices selected by the broadcast offsets sit at a fixed stride from each other, which
+// includes a stride of zero for a broadcasted operand.
+bool GetMatrixStride(const std::vector<size_t>& offsets, size_t& stride) {
+  stride = offsets.size() > 1 ? offsets[1] - offsets[0] : 0;
+  for (size_t i = 0; i < offsets.size(); i++) {
+    if (offsets[i] != offsets[0] + i * stride) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                              bool& is_packed, PrePackedWeights& prepacked_weights) {
+  is_packed = input_idx == 1 && GemmPackBFp32(alloc, tensor, false, prepacked_weights);
+  return Status::OK();
+}
+
+Status MatMul<float>::UseSharedPrePackedBuffers(const PrePackedWeights& prepacked_weights, int input_idx) {
+  if (input_idx == 1) {
+    packed_b_ = prepacked_weights.buffers_[0].get();
+  }
+  return Status::OK();
+}
+
+Status MatMul<float>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const auto* left_X = ctx->Input<Tensor>(0);
+  const auto* right_X = ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(left_X->Shape(), right_X->Shape()));
+
+  Tensor* Y = ctx->Output(0, helper.OutputShape());
+
+  // the packed B is a single 2D matrix, so only A and Y move between the output matrices
+  const float* a_data = left_X->Data<float>();
+  const float* b_data = right_X->Data<float>();
+  float* y_data = Y->MutableData<float>();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  size_t max_len = helper.OutputOffsets().size();
+
+  // multiply all the matrices in one scheduling pass if the broadcast is expressible as strides
+  size_t stride_a;
+  size_t stride_b;
+  size_t stride_y;
+  if (packed_b_ == nullptr && max_len > 1 &&
+      GetMatrixStride(helper.LeftOffsets(), stride_a) &&
+      GetMatrixStride(helper.RightOffsets(), stride_b) &&
+      GetMatrixStride(helper.OutputOffsets(), stride_y)) {
+    MlasGemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f,
+                  a_data + helper.LeftOffsets()[0], K, stride_a,
+                  b_data + helper.RightOffsets()[0], N, stride_b,
+                  0.0f, y_data + helper.OutputOffsets()[0], N, stride_y,
+                  max_len, thread_pool);
+    return Status::OK();
+  }
+
+  for (size_t i = 0; i < max_len; i++) {
+    if (packed_b_ != nullptr) {
+      MlasGemm(CblasNoTrans, M, N, K, 1.0f, a_data + helper.LeftOffsets()[i], K, packed_b_, 0.0f,
+               y_data + helper.OutputOffsets()[i], N, thread_pool);
+    } else {
+      math::MatMul<float>(static_cast<int>(M), static_cast<int>(N), static_cast<int>(K),
+                          a_data + helper.LeftOffsets()[i], b_data + helper.RightOffsets()[i],
+                          y_data + helper.OutputOffsets()[i], thread_pool);
+    }
+  }
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
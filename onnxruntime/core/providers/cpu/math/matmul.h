@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/common.h"
+#include "core/framework/kernel_cost.h"
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
@@ -16,6 +17,40 @@ class MatMul final : public OpKernel {
   }
 
   Status Compute(OpKernelContext* context) const override;
+
+  // each output element is a dot product over the last dimension of A
+  bool GetCost(OpKernelContext& context, KernelCost& cost) const override {
+    cost = kernel_cost::DotProducts(context, context.Input<Tensor>(0)->Shape().GetDims().back());
+    return true;
+  }
+};
+
+template <>
+class MatMul<float> final : public OpKernel {
+ public:
+  MatMul(const OpKernelInfo& info)
+      : OpKernel(info) {
+  }
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights& prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(const PrePackedWeights& prepacked_weights, int input_idx) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+  bool GetCost(OpKernelContext& context, KernelCost& cost) const override {
+    cost = kernel_cost::DotProducts(context, context.Input<Tensor>(0)->Shape().GetDims().back());
+    return true;
+  }
+
+ private:
+  // B in the layout of MlasGemm if it is a constant 2D matrix
+  const void* packed_b_ = nullptr;
 };
 
+// MLFloat16 is multiplied by MlasHalfGemm, which accumulates in single precision
+template <>
+Status MatMul<MLFloat16>::Compute(OpKernelContext* context) const;
+
 }  // namespace onnxruntime
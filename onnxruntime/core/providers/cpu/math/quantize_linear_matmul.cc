@@ -20,7 +20,8 @@ ONNX_OPERATOR_KERNEL_EX(
     kCpuExecutionProvider,
     KernelDefBuilder()
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
-        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(),
+                               DataTypeImpl::GetTensorType<int8_t>()})
         .TypeConstraint("T3", DataTypeImpl::GetTensorType<uint8_t>()),
     QLinearMatMul<uint8_t, uint8_t, uint8_t>);
 
@@ -62,9 +63,14 @@ Status QLinearMatMul<uint8_t, uint8_t, uint8_t>::Compute(OpKernelContext* ctx) c
 
   const float real_multiplier = (a_scale_data * b_scale_data) / y_scale_data;
 
-#ifdef MLAS_SUPPORTS_GEMM_U8X8
+  // Signed weights are passed to the u8s8 GEMM as is. Without MLAS, they are shifted into the unsigned
+  // domain together with their zero point (w + 128 - (zp + 128) == w - zp) for the u8u8 GEMMLOWP path.
+  const bool b_is_signed = b->IsDataType<int8_t>();
+
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
   auto gemm_output_data = alloc->Alloc(SafeInt<size_t>(sizeof(int32_t)) *
                                        static_cast<size_t>(helper.M()) * static_cast<size_t>(helper.N()));
   BufferUniquePtr gemm_output_buffer(gemm_output_data, BufferDeleter(alloc));
@@ -74,22 +80,55 @@ Status QLinearMatMul<uint8_t, uint8_t, uint8_t>::Compute(OpKernelContext* ctx) c
   int32_t integer_multiplier;
   int right_shift;
   QuantizeMultiplier(real_multiplier, &integer_multiplier, &right_shift);
+
+  const uint8_t* b_data = nullptr;
+  uint8_t b_zero_point = 0;
+  BufferUniquePtr b_unsigned_buffer;
+  if (!b_is_signed) {
+    b_data = b->template Data<uint8_t>();
+    b_zero_point = *b_offset->template Data<uint8_t>();
+  } else {
+    const auto b_size = static_cast<size_t>(b->Shape().Size());
+    auto* b_unsigned = static_cast<uint8_t*>(alloc->Alloc(SafeInt<size_t>(sizeof(uint8_t)) * b_size));
+    b_unsigned_buffer = BufferUniquePtr(b_unsigned, BufferDeleter(alloc));
+    const auto* b_signed = b->template Data<int8_t>();
+    for (size_t i = 0; i < b_size; i++) {
+      b_unsigned[i] = static_cast<uint8_t>(b_signed[i] ^ 0x80);
+    }
+    b_data = b_unsigned;
+    b_zero_point = static_cast<uint8_t>(*b_offset->template Data<int8_t>() ^ 0x80);
+  }
 #endif
 
   for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
 #ifdef MLAS_SUPPORTS_GEMM_U8X8
-    QGemmu8u8_s32(static_cast<int>(helper.M()),
-                  static_cast<int>(helper.N()),
-                  static_cast<int>(helper.K()),
-                  a->template Data<uint8_t>() + helper.LeftOffsets()[i],
-                  static_cast<int>(helper.K()),
-                  *a_offset->template Data<uint8_t>(),
-                  b->template Data<uint8_t>() + helper.RightOffsets()[i],
-                  static_cast<int>(helper.N()),
-                  *b_offset->template Data<uint8_t>(),
-                  gemm_output,
-                  static_cast<int>(helper.N()),
-                  ctx->GetOperatorThreadPool());
+    if (b_is_signed) {
+      QGemmu8s8_s32(static_cast<int>(helper.M()),
+                    static_cast<int>(helper.N()),
+                    static_cast<int>(helper.K()),
+                    a->template Data<uint8_t>() + helper.LeftOffsets()[i],
+                    static_cast<int>(helper.K()),
+                    *a_offset->template Data<uint8_t>(),
+                    b->template Data<int8_t>() + helper.RightOffsets()[i],
+                    static_cast<int>(helper.N()),
+                    *b_offset->template Data<int8_t>(),
+                    gemm_output,
+                    static_cast<int>(helper.N()),
+                    ctx->GetOperatorThreadPool());
+    } else {
+      QGemmu8u8_s32(static_cast<int>(helper.M()),
+                    static_cast<int>(helper.N()),
+                    static_cast<int>(helper.K()),
+                    a->template Data<uint8_t>() + helper.LeftOffsets()[i],
+                    static_cast<int>(helper.K()),
+                    *a_offset->template Data<uint8_t>(),
+                    b->template Data<uint8_t>() + helper.RightOffsets()[i],
+                    static_cast<int>(helper.N()),
+                    *b_offset->template Data<uint8_t>(),
+                    gemm_output,
+                    static_cast<int>(helper.N()),
+                    ctx->GetOperatorThreadPool());
+    }
 
     MlasRequantizeOutput(gemm_output,
                          y->template MutableData<uint8_t>() + helper.OutputOffsets()[i],
@@ -100,10 +139,10 @@ Status QLinearMatMul<uint8_t, uint8_t, uint8_t>::Compute(OpKernelContext* ctx) c
                          *y_offset->template Data<uint8_t>());
 #else
     GemmlowpMultiplyu8u8_u8(a->template Data<uint8_t>() + helper.LeftOffsets()[i],
-                            b->template Data<uint8_t>() + helper.RightOffsets()[i],
+                            b_data + helper.RightOffsets()[i],
                             y->template MutableData<uint8_t>() + helper.OutputOffsets()[i],
                             *a_offset->template Data<uint8_t>(),
-                            *b_offset->template Data<uint8_t>(),
+                            b_zero_point,
                             *y_offset->template Data<uint8_t>(),
                             static_cast<int>(helper.M()),
                             static_cast<int>(helper.N()),
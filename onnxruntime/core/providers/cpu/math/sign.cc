@@ -24,18 +24,18 @@ class Sign final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Sign,
     9,
-    KernelDefBuilder().TypeConstraint("T", {DataTypeImpl::GetTensorType<float>(),
-                                            DataTypeImpl::GetTensorType<double>(),
-                                            DataTypeImpl::GetTensorType<int64_t>(),
-                                            DataTypeImpl::GetTensorType<uint64_t>(),
-                                            DataTypeImpl::GetTensorType<int32_t>(),
-                                            DataTypeImpl::GetTensorType<uint32_t>(),
-                                            DataTypeImpl::GetTensorType<int16_t>(),
-                                            DataTypeImpl::GetTensorType<uint16_t>(),
-                                            DataTypeImpl::GetTensorType<int8_t>(),
-                                            DataTypeImpl::GetTensorType<uint8_t>(),
-                                            DataTypeImpl::GetTensorType<MLFloat16>(),
-                                            DataTypeImpl::GetTensorType<BFloat16>()}),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", {DataTypeImpl::GetTensorType<float>(),
+                                                             DataTypeImpl::GetTensorType<double>(),
+                                                             DataTypeImpl::GetTensorType<int64_t>(),
+                                                             DataTypeImpl::GetTensorType<uint64_t>(),
+                                                             DataTypeImpl::GetTensorType<int32_t>(),
+                                                             DataTypeImpl::GetTensorType<uint32_t>(),
+                                                             DataTypeImpl::GetTensorType<int16_t>(),
+                                                             DataTypeImpl::GetTensorType<uint16_t>(),
+                                                             DataTypeImpl::GetTensorType<int8_t>(),
+                                                             DataTypeImpl::GetTensorType<uint8_t>(),
+                                                             DataTypeImpl::GetTensorType<MLFloat16>(),
+                                                             DataTypeImpl::GetTensorType<BFloat16>()}),
     Sign);
 
 namespace sign_internal {
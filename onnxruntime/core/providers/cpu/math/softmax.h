@@ -20,6 +20,7 @@ limitations under the License.
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/op_kernel_context_internal.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 #include "core/util/softmax.h"
 #include "core/providers/common.h"
@@ -39,9 +40,7 @@ class Softmax final : public OpKernel {
   }
 
   Status Compute(OpKernelContext* ctx) const override {
-#ifndef USE_OPENMP
     concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
-#endif
     const auto* tensor_pointer = ctx->Input<Tensor>(0);
     if (tensor_pointer == nullptr)
       return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
@@ -61,6 +60,12 @@ class Softmax final : public OpKernel {
     int N = static_cast<int>(input_shape.SizeToDimension(axis));
     int D = static_cast<int>(input_shape.SizeFromDimension(axis));
 
+    // MLAS fuses the maximum reduction, the exponentials and the normalization of each row.
+    if (std::is_same<T, float>::value) {
+      MlasComputeSoftmax(X.Data<float>(), Y->MutableData<float>(), N, D, use_log, tp);
+      return Status::OK();
+    }
+
     Eigen::TensorMap<Eigen::Tensor<const T, 2, Eigen::RowMajor, Eigen::DenseIndex>, Eigen::Aligned> X_tensor(
         X.Data<T>(), N, D);
     Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor, Eigen::DenseIndex>, Eigen::Aligned> Y_tensor(
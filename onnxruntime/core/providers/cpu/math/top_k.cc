@@ -20,10 +20,8 @@
 #include "core/common/exceptions.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
-#include "core/util/math_cpuonly.h"
-#include <queue>
+#include "core/platform/threadpool.h"
 #include <algorithm>
-#include <cmath>
 
 using namespace std;
 namespace onnxruntime {
@@ -52,124 +50,109 @@ struct LesserValueCmp {
 
 // Static helpers that implement the core logic for each of the 'TopK' operator flavor
 
-// Selects the top k elements (largest or smallest based on template parameter)
-template <class Comparator>
-static vector<pair<typename Comparator::DataType, int64_t>> select_top_k(
-    const ConstEigenMatrixMapRowMajor<typename Comparator::DataType>& raw_data, int64_t row_num, int64_t num_blocks,
-    int64_t block_slice, int64_t inter_block_offset, const unsigned k,
-    bool sort_top_k) {
-  // create a data holder and insert elements
-  vector<pair<typename Comparator::DataType, int64_t>> data_holder;
-  data_holder.reserve(num_blocks);
-  for (int64_t l = 0; l < num_blocks; ++l) {
-    data_holder.push_back({raw_data(row_num, l * block_slice + inter_block_offset), l});
+// Minimum number of candidates kept while selecting the top k elements of a row. Holding more than k candidates lets
+// the scan below compare most values against the threshold only, with a selection over the candidates once the
+// buffer is full.
+static constexpr size_t kMinTopKCandidates = 64;
+
+// Selects the top k elements (largest or smallest based on template parameter) of the n values of a row, read with a
+// stride, into the first k entries of 'candidates'.
+// The values are compared to the k-th best value found so far, and only the ones beating it are kept, so a row is
+// read once with a single comparison per value. As the row is scanned in order of its indices, a value equal to the
+// threshold has a higher index than the threshold element and is never selected, which matches the comparators.
+template <bool largest, class Comparator>
+static void select_top_k(const typename Comparator::DataType* data, int64_t n, int64_t stride, const unsigned k,
+                         bool sort_top_k, vector<pair<typename Comparator::DataType, int64_t>>& candidates) {
+  using T = typename Comparator::DataType;
+  const size_t capacity = std::max<size_t>(2 * static_cast<size_t>(k), kMinTopKCandidates);
+  candidates.clear();
+  candidates.reserve(std::min<size_t>(capacity, static_cast<size_t>(n)));
+
+  int64_t l = 0;
+  for (; l < n && candidates.size() < capacity; ++l) {
+    candidates.push_back({data[l * stride], l});
   }
 
-  // find the top k (largest or smallest) elements in the data holder - O(n)
-  nth_element(data_holder.begin(), data_holder.begin() + (k - 1), data_holder.end(), Comparator());
+  while (l < n) {
+    // keep the top k candidates - O(capacity), and scan the rest of the row for values beating the k-th one
+    nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end(), Comparator());
+    candidates.resize(k);
+    const T threshold = candidates[k - 1].first;
+    for (; l < n && candidates.size() < capacity; ++l) {
+      const T value = data[l * stride];
+      // the optimizer will clean-up the redundant condition based on the template parameter 'largest'
+      if (largest ? value > threshold : value < threshold) {
+        candidates.push_back({value, l});
+      }
+    }
+  }
+
+  // find the top k (largest or smallest) elements in the candidates - O(capacity)
+  nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end(), Comparator());
 
   // sort the top k elements if needed - O (k log k)
   if (sort_top_k) {
-    std::sort(data_holder.begin(), data_holder.begin() + k, Comparator());
+    std::sort(candidates.begin(), candidates.begin() + k, Comparator());
   }
-
-  // the data_holder now contains the top k elements in the first k indices
-  return data_holder;
 }
 
+// Number of values from which the rows are split across the threads of the thread pool
+static constexpr int64_t kParallelTopKMinValues = 1 << 16;
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
 template <bool largest, bool sorted, class Comparator>
 static void extract_top_k_elements(const Tensor* input, const TensorShape& input_shape, Tensor* values,
                                    Tensor* indices, const TensorShape& output_shape, const unsigned k,
-                                   const unsigned axis_parsed) {
+                                   const unsigned axis_parsed, concurrency::ThreadPool* tp) {
+  using T = typename Comparator::DataType;
+
   // Cache some values that will be used in the implementation below
   const int64_t rows = input_shape.SizeToDimension(static_cast<size_t>(axis_parsed));
   const int64_t cols = input->Shape().Size() / rows;
-  auto input_map =
-      ConstEigenMatrixMapRowMajor<typename Comparator::DataType>(
-          static_cast<const typename Comparator::DataType*>(input->template Data<typename Comparator::DataType>()), rows, cols);
+  const T* input_data = input->template Data<T>();
 
-  // Use Eigen maps to allow indexing into the 2d tensors like Values_map(i,j)
   const int64_t reduced_cols = output_shape.SizeFromDimension(static_cast<size_t>(axis_parsed));
-  auto values_map = EigenMatrixMapRowMajor<typename Comparator::DataType>(
-      values->template MutableData<typename Comparator::DataType>(), rows, reduced_cols);
-  auto indices_map = EigenMatrixMapRowMajor<int64_t>(indices->template MutableData<int64_t>(), rows, reduced_cols);
+  T* values_data = values->template MutableData<T>();
+  int64_t* indices_data = indices->template MutableData<int64_t>();
 
   // This is basically the number of elements within each of the "k" rows
   const int64_t block_slice = reduced_cols / k;
   const int64_t num_blocks = input_shape[axis_parsed];
 
-  for (int64_t i = 0; i < rows; ++i) {
-    for (int64_t j = 0; j < block_slice; ++j) {
-      // Since sorted == true, we will use a Heap to hold the top K values in sorted fashion
-      if (sorted) {  // The optimizer will clean-up the redundant condition based on the template parameter 'sorted'
-        auto n_casted = static_cast<double>(num_blocks);
-        auto k_casted = static_cast<double>(k);
-        if ((n_casted + k_casted * log(k_casted)) < (n_casted * log(k_casted))) {
-          // Select first  - O(n), then sort O(k * ln(k))
-          // Overall complexity =  O (n + k * ln(k))
-          const auto& data_holder = select_top_k<Comparator>(input_map, i, num_blocks, block_slice, j, k, true);
-          for (int64_t l = 0; l < k; ++l) {
-            const auto& elem = data_holder[l];
-            auto col_index = l * block_slice + j;
-            values_map(i, col_index) = elem.first;
-            indices_map(i, col_index) = elem.second;
-          }
-        } else {
-          // Perform sorted selection by passing 'n' elements over a heap of size 'k'
-          // overall complexity =  O (n * ln(k))
-
-          // Build a min-heap/max-heap, the heap element is pair of (value, idx)
-          // The top of the heap is the smallest/largest value depending on whether it is a min-heap/max-heap
-          // This is a min-heap if largest == true, this is a max-heap if largest == false
-          priority_queue<pair<typename Comparator::DataType, int64_t>, vector<pair<typename Comparator::DataType, int64_t>>, Comparator> heap;
-
-          // Maintain the size of heap to be less or equal to k, so the
-          // heap will hold the k largest/smallest values
-          for (int64_t l = 0; l < num_blocks; ++l) {
-            const auto value = input_map(i, l * block_slice + j);
-            // largest == true: insert into the min-heap if the size is < k or if the new
-            // element is greater than the min element in the min-heap
-
-            // largest == false: insert into the min-heap if the size is < k or if the new
-            // element is lesser than the max element in the max-heap
-            if ((heap.size() < k) || (largest && value > heap.top().first) ||
-                (!largest && value < heap.top().first)) {  // the optimizer will clean-up the redundant condition based
-                                                           // on the template parameter 'largest'
-              heap.push({value, l});
-            }
-            if (heap.size() > k) {
-              heap.pop();
-            }
-          }
-          // Extract these k elements and place them in the results placeholder
-          for (int64_t l = 0; l < k; ++l) {
-            const auto& elem = heap.top();
-            auto col_index = (k - l - 1) * block_slice + j;
-            values_map(i, col_index) = elem.first;
-            indices_map(i, col_index) = elem.second;
-            heap.pop();
-          }
-        }
-      } else {  // sorted == false
-        // The optimizer will clean-up the redundant condition based on the template parameter 'sorted'
-
-        // If the top K values are not required to be sorted, we use a more optimal selection algorithm
-        // Average - O(n). Worst - O(n * ln(n)) or O(n^2) depending on the implementation, where 'n' is the number of input
-
-        const auto& data_holder = select_top_k<Comparator>(input_map, i, num_blocks, block_slice, j, k, false);
-
-        // Insert the top 'k' (largest or smallest) elements into the final output buffers
-        for (int64_t l = 0; l < k; ++l) {
-          const auto& elem = data_holder[l];
-          auto col_index = l * block_slice + j;
-          values_map(i, col_index) = elem.first;
-          indices_map(i, col_index) = elem.second;
-        }
+  // each (row, offset in the block) pair selects its top k independently, they are split in batches across the threads
+  const int64_t num_tasks = rows * block_slice;
+  const auto num_batches = static_cast<int32_t>(
+      tp == nullptr || num_tasks * num_blocks < kParallelTopKMinValues
+          ? 1
+          : std::min<int64_t>(num_tasks, tp->NumThreads() + 1));
+
+  auto compute_batch = [&](int32_t batch) {
+    vector<pair<T, int64_t>> candidates;
+    for (int64_t task = num_tasks * batch / num_batches, end = num_tasks * (batch + 1) / num_batches; task < end;
+         ++task) {
+      const int64_t i = task / block_slice;
+      const int64_t j = task % block_slice;
+
+      // If the top K values are not required to be sorted, the selection is enough - O(n).
+      // Otherwise the k selected values are sorted too - O (n + k * ln(k)).
+      select_top_k<largest, Comparator>(input_data + i * cols + j, num_blocks, block_slice, k, sorted, candidates);
+
+      // Insert the top 'k' (largest or smallest) elements into the final output buffers
+      for (int64_t l = 0; l < k; ++l) {
+        const auto& elem = candidates[l];
+        auto output_index = i * reduced_cols + l * block_slice + j;
+        values_data[output_index] = elem.first;
+        indices_data[output_index] = elem.second;
       }
     }
+  };
+
+  if (num_batches == 1) {
+    compute_batch(0);
+  } else {
+    concurrency::ThreadPool::TryBatchParallelFor(tp, num_batches, compute_batch, num_batches);
   }
 }
 
@@ -200,26 +183,28 @@ static Status TopKImpl(OpKernelContext* p_op_kernel_context, const Tensor* input
   }
 
   // no-op - no output buffers to fill - return silently
-  if (k == 0) {
+  if (k == 0 || output_shape.Size() == 0) {
     return Status::OK();
   }
 
+  concurrency::ThreadPool* tp = p_op_kernel_context->GetOperatorThreadPool();
+
   if (sorted && largest) {
     // extract sorted largest TopK elements
     extract_top_k_elements<true, true, GreaterValueCmp<T>>(input, input_shape, values, indices, output_shape, k,
-                                                           gsl::narrow_cast<unsigned>(axis_parsed));
+                                                           gsl::narrow_cast<unsigned>(axis_parsed), tp);
   } else if (sorted && !largest) {
     // extract sorted smallest TopK elements
     extract_top_k_elements<false, true, LesserValueCmp<T>>(input, input_shape, values, indices, output_shape, k,
-                                                           gsl::narrow_cast<unsigned>(axis_parsed));
+                                                           gsl::narrow_cast<unsigned>(axis_parsed), tp);
   } else if (largest) {
     // extract unsorted (order undefined) largest TopK elements
     extract_top_k_elements<true, false, GreaterValueCmp<T>>(input, input_shape, values, indices, output_shape, k,
-                                                            gsl::narrow_cast<unsigned>(axis_parsed));
+                                                            gsl::narrow_cast<unsigned>(axis_parsed), tp);
   } else {
     // extract unsorted (order undefined) smallest TopK elements
     extract_top_k_elements<false, false, LesserValueCmp<T>>(input, input_shape, values, indices, output_shape, k,
-                                                            gsl::narrow_cast<unsigned>(axis_parsed));
+                                                            gsl::narrow_cast<unsigned>(axis_parsed), tp);
   }
 
   return Status::OK();
@@ -66,6 +66,9 @@ SVMClassifier<T>::SVMClassifier(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.size() > 0 || classlabels_ints_.size() > 0);
   ORT_ENFORCE(proba_.size() == probb_.size());
   ORT_ENFORCE(coefficients_.size() > 0);
+  if (mode_ == SVM_TYPE::SVM_SVC && get_kernel_type() == KERNEL::RBF) {
+    support_vector_norms_ = squared_norms(support_vectors_, vector_count_, feature_count_);
+  }
   weights_are_all_positive_ = true;
   for (int64_t i = 0; i < static_cast<int64_t>(coefficients_.size()); i++) {
     if (coefficients_[i] < 0) {
@@ -120,130 +123,158 @@ Status SVMClassifier<T>::Compute(OpKernelContext* ctx) const {
 
   std::vector<int64_t> dims{N, nb_columns};
   Tensor* Z = ctx->Output(1, TensorShape(dims));
+  if (N == 0) {
+    return Status::OK();
+  }
 
-  const T* x_data = X->template Data<T>();
-  int64_t zindex = 0;
-
-  std::vector<float> scores;
-  std::vector<float> kernels;
-  std::vector<int64_t> votes;
-  std::vector<float> probsp2;
+  if (vector_count_ == 0 && mode_ != SVM_TYPE::SVM_LINEAR)
+    return Status(common::ONNXRUNTIME, common::FAIL, "No support vectors.");
 
+  const T* x_data = X->template Data<T>();
+  const bool is_linear = vector_count_ == 0 && mode_ == SVM_TYPE::SVM_LINEAR;
+
+  // every row writes the same number of scores: one per class, or one per pair of classes. write_scores adds the
+  // score of the second class when there's a single score, except with PROBIT.
+  const int64_t scores_per_row = is_linear || proba_.size() > 0 ? class_count_
+                                                                 : class_count_ * (class_count_ - 1) / 2;
+  const int64_t num_labels = using_strings_ ? static_cast<int64_t>(classlabels_strings_.size())
+                                            : static_cast<int64_t>(classlabels_ints_.size());
+  const int64_t z_stride = scores_per_row == 1 && post_transform_ != POST_EVAL_TRANSFORM::PROBIT &&
+                                   rho_.size() == 1 && num_labels == 2
+                               ? 2
+                               : scores_per_row;
+
+  // the kernels of each row against the support vectors, or the class coefficients in linear mode
+  const int64_t kernel_count = is_linear ? class_count_ : vector_count_;
   const int64_t class_count_squared = class_count_ * class_count_;
-  probsp2.reserve(class_count_squared);
-  scores.reserve(class_count_squared);
-
-  for (int64_t n = 0; n < N; n++)  //for each example
-  {
-    scores.clear();
-    kernels.clear();
-
-    int64_t current_weight_0 = n * stride;
-    int64_t maxclass = -1;
-
-    if (vector_count_ == 0 && mode_ == SVM_TYPE::SVM_LINEAR) {
-      for (int64_t j = 0; j < class_count_; j++) {  //for each class
-        auto val = kernel_dot(x_data, current_weight_0, coefficients_, feature_count_ * j,
-                              feature_count_, get_kernel_type());
-        val += rho_[0];
-        scores.push_back(val);
-      }
-    } else {
-      if (vector_count_ == 0)
-        return Status(common::ONNXRUNTIME, common::FAIL, "No support vectors.");
-      int evals = 0;
-
-      for (int64_t j = 0; j < vector_count_; j++) {
-        auto val = kernel_dot(x_data, current_weight_0, support_vectors_, feature_count_ * j,
-                              feature_count_, get_kernel_type());
-        kernels.push_back(val);
-      }
 
-      votes.assign(class_count_, 0);
-      for (int64_t i = 0; i < class_count_; i++) {        // for each class
-        for (int64_t j = i + 1; j < class_count_; j++) {  // for each class
-          double sum = 0;
-          int64_t start_index_i = starting_vector_[i];  // *feature_count_;
-          int64_t start_index_j = starting_vector_[j];  // *feature_count_;
-
-          int64_t class_i_support_count = vectors_per_class_[i];
-          int64_t class_j_support_count = vectors_per_class_[j];
-
-          int64_t pos1 = (vector_count_) * (j - 1);
-          int64_t pos2 = (vector_count_) * (i);
-          const float* val1 = &(coefficients_[pos1 + start_index_i]);
-          const float* val2 = &(kernels[start_index_i]);
-          for (int64_t m = 0; m < class_i_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
-          val1 = &(coefficients_[pos2 + start_index_j]);
-          val2 = &(kernels[start_index_j]);
-          for (int64_t m = 0; m < class_j_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
-          sum += rho_[evals];
-          scores.push_back((float)sum);
-          ++(votes[sum > 0 ? i : j]);
-          ++evals;  //index into rho
+  // the rows are split in blocks whose kernels are computed by one GEMM, and the blocks are split across the
+  // threads. the GEMM only uses the thread pool when there's a single batch.
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const int64_t n_blocks = (N + kSVMRowBlock - 1) / kSVMRowBlock;
+  const auto n_batches = static_cast<int32_t>(tp == nullptr ? 1 : std::min<int64_t>(n_blocks, tp->NumThreads() + 1));
+
+  auto compute_batch = [&](int32_t batch) {
+    std::vector<float> scores;
+    std::vector<float> kernels(static_cast<size_t>(std::min(kSVMRowBlock, N) * kernel_count));
+    std::vector<float> x_buffer;
+    std::vector<int64_t> votes;
+    std::vector<float> probsp2;
+    probsp2.reserve(class_count_squared);
+    scores.reserve(class_count_squared);
+
+    for (int64_t block = n_blocks * batch / n_batches, end = n_blocks * (batch + 1) / n_batches; block < end;
+         ++block) {
+      const int64_t first_row = block * kSVMRowBlock;
+      const int64_t n_rows = std::min(kSVMRowBlock, N - first_row);
+      batched_kernel_dot(x_data + first_row * stride, n_rows, stride, is_linear ? coefficients_ : support_vectors_,
+                         support_vector_norms_, kernel_count, feature_count_, get_kernel_type(), x_buffer,
+                         kernels.data(), n_batches == 1 ? tp : nullptr);
+
+      for (int64_t r = 0; r < n_rows; ++r) {
+        const int64_t n = first_row + r;
+        const float* row_kernels = kernels.data() + r * kernel_count;
+        scores.clear();
+        int64_t maxclass = -1;
+
+        if (is_linear) {
+          for (int64_t j = 0; j < class_count_; j++) {  //for each class
+            scores.push_back(row_kernels[j] + rho_[0]);
+          }
+        } else {
+          int evals = 0;
+          votes.assign(class_count_, 0);
+          for (int64_t i = 0; i < class_count_; i++) {        // for each class
+            for (int64_t j = i + 1; j < class_count_; j++) {  // for each class
+              double sum = 0;
+              int64_t start_index_i = starting_vector_[i];  // *feature_count_;
+              int64_t start_index_j = starting_vector_[j];  // *feature_count_;
+
+              int64_t class_i_support_count = vectors_per_class_[i];
+              int64_t class_j_support_count = vectors_per_class_[j];
+
+              int64_t pos1 = (vector_count_) * (j - 1);
+              int64_t pos2 = (vector_count_) * (i);
+              const float* val1 = &(coefficients_[pos1 + start_index_i]);
+              const float* val2 = row_kernels + start_index_i;
+              for (int64_t m = 0; m < class_i_support_count; ++m, ++val1, ++val2)
+                sum += *val1 * *val2;
+
+              val1 = &(coefficients_[pos2 + start_index_j]);
+              val2 = row_kernels + start_index_j;
+              for (int64_t m = 0; m < class_j_support_count; ++m, ++val1, ++val2)
+                sum += *val1 * *val2;
+
+              sum += rho_[evals];
+              scores.push_back((float)sum);
+              ++(votes[sum > 0 ? i : j]);
+              ++evals;  //index into rho
+            }
+          }
         }
-      }
-    }
 
-    if (proba_.size() > 0 && mode_ == SVM_TYPE::SVM_SVC) {
-      //compute probabilities from the scores
-      probsp2.assign(class_count_squared, 0.f);
-      int64_t index = 0;
-      for (int64_t i = 0; i < class_count_; ++i) {
-        int64_t p1 = i * class_count_ + i + 1;
-        int64_t p2 = (i + 1) * class_count_ + i;
-        for (int64_t j = i + 1; j < class_count_; ++j, ++index) {
-          float val1 = sigmoid_probability(scores[index], proba_[index], probb_[index]);
-          float val2 = std::max(val1, 1.0e-7f);
-          val2 = std::min(val2, 1 - 1.0e-7f);
-          probsp2[p1] = val2;
-          probsp2[p2] = 1 - val2;
-          ++p1;
-          p2 += class_count_;
+        if (proba_.size() > 0 && mode_ == SVM_TYPE::SVM_SVC) {
+          //compute probabilities from the scores
+          probsp2.assign(class_count_squared, 0.f);
+          int64_t index = 0;
+          for (int64_t i = 0; i < class_count_; ++i) {
+            int64_t p1 = i * class_count_ + i + 1;
+            int64_t p2 = (i + 1) * class_count_ + i;
+            for (int64_t j = i + 1; j < class_count_; ++j, ++index) {
+              float val1 = sigmoid_probability(scores[index], proba_[index], probb_[index]);
+              float val2 = std::max(val1, 1.0e-7f);
+              val2 = std::min(val2, 1 - 1.0e-7f);
+              probsp2[p1] = val2;
+              probsp2[p2] = 1 - val2;
+              ++p1;
+              p2 += class_count_;
+            }
+          }
+
+          scores.assign(class_count_, 0.f);
+          multiclass_probability(class_count_, probsp2, scores);
         }
-      }
 
-      scores.assign(class_count_, 0.f);
-      multiclass_probability(class_count_, probsp2, scores);
-    }
+        float max_weight = 0;
+        if (votes.size() > 0) {
+          auto it_maxvotes = std::max_element(votes.begin(), votes.end());
+          maxclass = std::distance(votes.begin(), it_maxvotes);
+        } else {
+          auto it_max_weight = std::max_element(scores.begin(), scores.end());
+          maxclass = std::distance(scores.begin(), it_max_weight);
+          max_weight = *it_max_weight;
+        }
 
-    float max_weight = 0;
-    if (votes.size() > 0) {
-      auto it_maxvotes = std::max_element(votes.begin(), votes.end());
-      maxclass = std::distance(votes.begin(), it_maxvotes);
-    } else {
-      auto it_max_weight = std::max_element(scores.begin(), scores.end());
-      maxclass = std::distance(scores.begin(), it_max_weight);
-      max_weight = *it_max_weight;
-    }
+        // write top class
+        // onnx specs expects one column per class.
+        int write_additional_scores = -1;
+        if (rho_.size() == 1) {
+          if (using_strings_) {
+            write_additional_scores = _set_score_svm<std::string>(
+                Y, max_weight, maxclass, n, post_transform_, proba_,
+                weights_are_all_positive_, classlabels_strings_, "1", "0");
+          } else {
+            write_additional_scores = _set_score_svm<int64_t>(
+                Y, max_weight, maxclass, n, post_transform_, proba_,
+                weights_are_all_positive_, classlabels_ints_, 1, 0);
+          }
+        } else {  //multiclass
+          if (using_strings_) {
+            Y->template MutableData<std::string>()[n] = classlabels_strings_[maxclass];
+          } else {
+            Y->template MutableData<int64_t>()[n] = classlabels_ints_[maxclass];
+          }
+        }
 
-    // write top class
-    // onnx specs expects one column per class.
-    int write_additional_scores = -1;
-    if (rho_.size() == 1) {
-      if (using_strings_) {
-        write_additional_scores = _set_score_svm<std::string>(
-            Y, max_weight, maxclass, n, post_transform_, proba_,
-            weights_are_all_positive_, classlabels_strings_, "1", "0");
-      } else {
-        write_additional_scores = _set_score_svm<int64_t>(
-            Y, max_weight, maxclass, n, post_transform_, proba_,
-            weights_are_all_positive_, classlabels_ints_, 1, 0);
-      }
-    } else {  //multiclass
-      if (using_strings_) {
-        Y->template MutableData<std::string>()[n] = classlabels_strings_[maxclass];
-      } else {
-        Y->template MutableData<int64_t>()[n] = classlabels_ints_[maxclass];
+        write_scores(scores, post_transform_, n * z_stride, Z, write_additional_scores);
       }
     }
+  };
 
-    write_scores(scores, post_transform_, zindex, Z, write_additional_scores);
-    zindex += scores.size();
+  if (n_batches == 1) {
+    compute_batch(0);
+  } else {
+    concurrency::ThreadPool::TryBatchParallelFor(tp, n_batches, compute_batch, n_batches);
   }
 
   return Status::OK();
@@ -3,14 +3,21 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 #include "ml_common.h"
 
 namespace onnxruntime {
 namespace ml {
 
+// Number of rows whose kernels are computed by one GEMM.
+static constexpr int64_t kSVMRowBlock = 128;
+
 // stuffs shared by SVMClassifier and SVMRegressor
 template <typename T>
 class SVMCommon {
@@ -29,36 +36,67 @@ class SVMCommon {
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
-  float kernel_dot(const T* A, int64_t a, const std::vector<float>& B, int64_t b, int64_t len, KERNEL k) const {
-    double sum = 0;
-    const T* pA = A + a;
-    const float* pB = B.data() + b;
-    switch(k) {
-        case KERNEL::POLY:
-            for (int64_t i = len; i > 0; --i)
-                sum += *pA++ * *pB++;
-            sum = gamma_ * sum + coef0_;
-            sum = std::pow(sum, degree_);
-            break;
-        case KERNEL::SIGMOID:
-            for (int64_t i = len; i > 0; --i)
-                sum += *pA++ * *pB++;
-            sum = gamma_ * sum + coef0_;
-            sum = std::tanh(sum);
-            break;
-        case KERNEL::RBF:
-            for (int64_t i = len; i > 0; --i) {
-                double val = *pA++ - *pB++;
-                sum += val * val;
-            }
-            sum = std::exp(-gamma_ * sum);
-            break;
-        case KERNEL::LINEAR:
-            for (int64_t i = len; i > 0; --i)
-                sum += *pA++ * *pB++;
-            break;
+  // Squared norms of the `count` vectors of length `len` stored in `vectors`, used by the RBF kernel.
+  static std::vector<float> squared_norms(const std::vector<float>& vectors, int64_t count, int64_t len) {
+    std::vector<float> norms(count);
+    for (int64_t j = 0; j < count; ++j) {
+      norms[j] = ConstEigenVectorArrayMap<float>(vectors.data() + j * len, len).square().sum();
+    }
+    return norms;
+  }
+
+  // Computes the kernels between `rows` rows of X, `stride` elements apart, and the `count` vectors of length `len`
+  // stored in `vectors`. out[r * count + j] is the kernel between row r and vector j.
+  // The dot products of all the pairs are a single GEMM, the kernel is then applied to the whole block.
+  // `vector_norms` are the squared norms of the vectors and are only read by the RBF kernel, which uses
+  // ||x - v||^2 = ||x||^2 + ||v||^2 - 2 x.v. Inputs which aren't float are converted in `x_buffer`.
+  void batched_kernel_dot(const T* X, int64_t rows, int64_t stride, const std::vector<float>& vectors,
+                          const std::vector<float>& vector_norms, int64_t count, int64_t len, KERNEL k,
+                          std::vector<float>& x_buffer, float* out, concurrency::ThreadPool* tp) const {
+    const float* x;
+    int64_t ldx;
+    if (std::is_same<T, float>::value) {
+      x = reinterpret_cast<const float*>(X);
+      ldx = stride;
+    } else {
+      x_buffer.resize(rows * len);
+      for (int64_t r = 0; r < rows; ++r) {
+        for (int64_t i = 0; i < len; ++i) {
+          x_buffer[r * len + i] = static_cast<float>(X[r * stride + i]);
+        }
+      }
+      x = x_buffer.data();
+      ldx = len;
+    }
+
+    MlasGemm(CblasNoTrans, CblasTrans, static_cast<size_t>(rows), static_cast<size_t>(count),
+             static_cast<size_t>(len), 1.f, x, static_cast<size_t>(ldx), vectors.data(), static_cast<size_t>(len),
+             0.f, out, static_cast<size_t>(count), tp);
+
+    // one column per row
+    EigenArrayMap<float> kernels(out, count, rows);
+    const size_t size = static_cast<size_t>(rows * count);
+    switch (k) {
+      case KERNEL::POLY:
+        kernels = (kernels * gamma_ + coef0_).pow(degree_);
+        break;
+      case KERNEL::SIGMOID:
+        kernels = kernels * gamma_ + coef0_;
+        MlasComputeTanh(out, out, size);
+        break;
+      case KERNEL::RBF: {
+        ConstEigenVectorArrayMap<float> norms(vector_norms.data(), count);
+        for (int64_t r = 0; r < rows; ++r) {
+          const float x_norm = ConstEigenVectorArrayMap<float>(x + r * ldx, len).square().sum();
+          // rounding can make the distance of a row to itself slightly negative
+          kernels.col(r) = (norms + x_norm - 2.f * kernels.col(r)).max(0.f) * -gamma_;
+        }
+        MlasComputeExp(out, out, size);
+        break;
+      }
+      case KERNEL::LINEAR:
+        break;
     }
-    return (float)sum;
   }
 
  private:
@@ -70,7 +108,8 @@ class SVMCommon {
 
 template <typename T>
 class SVMClassifier final : public OpKernel, private SVMCommon<T> {
-  using SVMCommon<T>::kernel_dot;
+  using SVMCommon<T>::batched_kernel_dot;
+  using SVMCommon<T>::squared_norms;
   using SVMCommon<T>::set_kernel_type;
   using SVMCommon<T>::get_kernel_type;
 
@@ -91,6 +130,7 @@ class SVMClassifier final : public OpKernel, private SVMCommon<T> {
   std::vector<float> probb_;
   std::vector<float> coefficients_;
   std::vector<float> support_vectors_;
+  std::vector<float> support_vector_norms_;
   std::vector<int64_t> classlabels_ints_;
   std::vector<std::string> classlabels_strings_;
   POST_EVAL_TRANSFORM post_transform_;
@@ -34,6 +34,9 @@ SVMRegressor<T>::SVMRegressor(const OpKernelInfo& info)
     mode_ = SVM_TYPE::SVM_LINEAR;
     set_kernel_type(KERNEL::LINEAR);
   }
+  if (mode_ == SVM_TYPE::SVM_SVC && get_kernel_type() == KERNEL::RBF) {
+    support_vector_norms_ = squared_norms(support_vectors_, vector_count_, feature_count_);
+  }
 }
 
 template <typename T>
@@ -44,25 +47,55 @@ Status SVMRegressor<T>::Compute(OpKernelContext* ctx) const {
   int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
 
   Tensor* Y = ctx->Output(0, TensorShape({N, 1}));  // this op outputs for one target only
+  if (N == 0) {
+    return Status::OK();
+  }
+
   const auto* x_data = X->template Data<T>();
-  int64_t current_weight_0;
-  float sum;
-
-  for (int64_t n = 0; n < N; n++) {  //for each example
-    current_weight_0 = n * stride;
-    sum = 0.f;
-    if (mode_ == SVM_TYPE::SVM_SVC) {
-      for (int64_t j = 0; j < vector_count_; j++) {
-        sum += kernel_dot(x_data, current_weight_0, support_vectors_, feature_count_ * j,
-                          feature_count_, get_kernel_type()) * coefficients_[j];
+  float* y_data = Y->template MutableData<float>();
+
+  // in SVC mode the kernels of each row against the support vectors are weighted by the coefficients, in linear mode
+  // the single kernel is the prediction.
+  const bool is_svc = mode_ == SVM_TYPE::SVM_SVC;
+  const int64_t kernel_count = is_svc ? vector_count_ : 1;
+
+  // the rows are split in blocks whose kernels are computed by one GEMM, and the blocks are split across the
+  // threads. the GEMM only uses the thread pool when there's a single batch.
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const int64_t n_blocks = (N + kSVMRowBlock - 1) / kSVMRowBlock;
+  const auto n_batches = static_cast<int32_t>(tp == nullptr ? 1 : std::min<int64_t>(n_blocks, tp->NumThreads() + 1));
+
+  auto compute_batch = [&](int32_t batch) {
+    std::vector<float> kernels(static_cast<size_t>(std::min(kSVMRowBlock, N) * kernel_count));
+    std::vector<float> x_buffer;
+
+    for (int64_t block = n_blocks * batch / n_batches, end = n_blocks * (batch + 1) / n_batches; block < end;
+         ++block) {
+      const int64_t first_row = block * kSVMRowBlock;
+      const int64_t n_rows = std::min(kSVMRowBlock, N - first_row);
+      batched_kernel_dot(x_data + first_row * stride, n_rows, stride, is_svc ? support_vectors_ : coefficients_,
+                         support_vector_norms_, kernel_count, feature_count_, get_kernel_type(), x_buffer,
+                         kernels.data(), n_batches == 1 ? tp : nullptr);
+
+      EigenVectorArrayMap<float> sums(y_data + first_row, n_rows);
+      if (is_svc) {
+        sums = (ConstEigenMatrixMap<float>(kernels.data(), kernel_count, n_rows).transpose() *
+                ConstEigenVectorMap<float>(coefficients_.data(), kernel_count))
+                   .array();
+      } else {
+        sums = ConstEigenVectorArrayMap<float>(kernels.data(), n_rows);
+      }
+      sums += rho_[0];
+      if (one_class_) {
+        sums = (sums > 0.f).template cast<float>() * 2.f - 1.f;
       }
-      sum += rho_[0];
-    } else if (mode_ == SVM_TYPE::SVM_LINEAR) {  //liblinear
-      sum = kernel_dot(x_data, current_weight_0, coefficients_, 0,
-                       feature_count_, get_kernel_type());
-      sum += rho_[0];
     }
-    Y->template MutableData<float>()[n] = one_class_ ? (sum > 0 ? 1.f : -1.f) : sum;
+  };
+
+  if (n_batches == 1) {
+    compute_batch(0);
+  } else {
+    concurrency::ThreadPool::TryBatchParallelFor(tp, n_batches, compute_batch, n_batches);
   }
 
   return Status::OK();
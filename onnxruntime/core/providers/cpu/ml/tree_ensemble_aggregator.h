@@ -62,6 +62,25 @@ struct TreeNodeElement {
   bool is_missing_track_true;
 };
 
+enum TreeNodeCompactFlags : uint8_t {
+  kTreeNodeLeaf = 1,
+  kTreeNodeMissingTrackTrue = 2,
+};
+
+// A node of the compiled trees used for the evaluation. The nodes of a tree are stored in depth-first order with the
+// true child right after its parent, so a node only holds the index of its false child. The weights of the leaves stay
+// in the TreeNodeElement a leaf refers to, which keeps the nodes at 16 bytes with float thresholds.
+template <typename T>
+struct TreeNodeCompact {
+  T value;
+  int32_t feature_id;
+  int32_t next;  // index of the false child in the compiled nodes, or of the leaf in the TreeNodeElement nodes
+  uint8_t mode;  // NODE_MODE
+  uint8_t flags;
+};
+
+static_assert(sizeof(TreeNodeCompact<float>) == 16, "TreeNodeCompact<float> is expected to take 16 bytes");
+
 template <typename ITYPE, typename OTYPE>
 class TreeAggregator {
  protected:
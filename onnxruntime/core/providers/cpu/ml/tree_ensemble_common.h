@@ -21,6 +21,11 @@ class TreeEnsembleCommon {
   std::vector<TreeNodeElement<OTYPE>> nodes_;
   std::vector<TreeNodeElement<OTYPE>*> roots_;
 
+  // compiled trees the evaluation runs on, see TreeNodeCompact
+  std::vector<TreeNodeCompact<OTYPE>> compact_nodes_;
+  std::vector<int32_t> compact_roots_;
+  NODE_MODE compact_mode_;  // the mode of all the branches, or LEAF if they have different modes
+
   int64_t max_tree_depth_;
   int64_t n_trees_;
   bool same_mode_;
@@ -49,16 +54,62 @@ class TreeEnsembleCommon {
                      const std::vector<int64_t>& target_class_treeids,
                      const std::vector<OTYPE>& target_class_weights);
 
-  void compute(const Tensor* X, Tensor* Z, Tensor* label) const;
+  void compute(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Z, Tensor* label) const;
 
  protected:
-  TreeNodeElement<OTYPE>* ProcessTreeNodeLeave(
-      TreeNodeElement<OTYPE>* root, const ITYPE* x_data) const;
+  void CompileTrees();
+
+  // Finds the leaves of tree j for n_rows <= kTreeEnsembleRowBlock consecutive rows.
+  void FindLeaves(size_t j, const ITYPE* x_data, int64_t stride, int64_t n_rows,
+                  const TreeNodeElement<OTYPE>** leaves) const;
+
+  template <NODE_MODE mode>
+  void FindLeavesWithMode(size_t j, const ITYPE* x_data, int64_t stride, int64_t n_rows,
+                          const TreeNodeElement<OTYPE>** leaves) const;
 
   template <typename AGG>
-  void compute_agg(const Tensor* X, Tensor* Z, Tensor* label, const AGG& agg) const;
+  void compute_agg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Z, Tensor* label, const AGG& agg) const;
 };
 
+// Number of rows whose paths through a tree are followed together. The paths are independent, so the latency of
+// loading the nodes of one row is hidden by the loads of the other rows.
+static constexpr int64_t kTreeEnsembleRowBlock = 8;
+
+inline bool _isnan_(float x) { return std::isnan(x); }
+inline bool _isnan_(double x) { return std::isnan(x); }
+inline bool _isnan_(int64_t) { return false; }
+inline bool _isnan_(int32_t) { return false; }
+
+// Returns true if val takes the true branch of the node. mode is the mode of the node, or LEAF to read it from the
+// node when the branches have different modes.
+template <NODE_MODE mode, typename ITYPE, typename OTYPE>
+inline bool IsTrueBranch(ITYPE val, const TreeNodeCompact<OTYPE>& node) {
+  bool is_true = false;
+  switch (mode == NODE_MODE::LEAF ? static_cast<NODE_MODE>(node.mode) : mode) {
+    case NODE_MODE::BRANCH_LEQ:
+      is_true = val <= node.value;
+      break;
+    case NODE_MODE::BRANCH_LT:
+      is_true = val < node.value;
+      break;
+    case NODE_MODE::BRANCH_GTE:
+      is_true = val >= node.value;
+      break;
+    case NODE_MODE::BRANCH_GT:
+      is_true = val > node.value;
+      break;
+    case NODE_MODE::BRANCH_EQ:
+      is_true = val == node.value;
+      break;
+    case NODE_MODE::BRANCH_NEQ:
+      is_true = val != node.value;
+      break;
+    case NODE_MODE::LEAF:
+      break;
+  }
+  return is_true || ((node.flags & kTreeNodeMissingTrackTrue) && _isnan_(val));
+}
+
 template <typename ITYPE, typename OTYPE>
 TreeEnsembleCommon<ITYPE, OTYPE>::TreeEnsembleCommon(int parallel_tree, int parallel_N,
                                                      const std::string& aggregate_function,
@@ -210,35 +261,97 @@ TreeEnsembleCommon<ITYPE, OTYPE>::TreeEnsembleCommon(int parallel_tree, int para
       break;
     }
   }
+
+  CompileTrees();
 }
 
 template <typename ITYPE, typename OTYPE>
-void TreeEnsembleCommon<ITYPE, OTYPE>::compute(const Tensor* X, Tensor* Z, Tensor* label) const {
+void TreeEnsembleCommon<ITYPE, OTYPE>::CompileTrees() {
+  compact_mode_ = NODE_MODE::LEAF;
+  if (same_mode_) {
+    for (const auto& node : nodes_) {
+      if (node.is_not_leaf) {
+        compact_mode_ = node.mode;
+        break;
+      }
+    }
+  }
+
+  // the nodes waiting to be added, with the index of the node they are the false child of, or -1
+  struct PendingNode {
+    const TreeNodeElement<OTYPE>* node;
+    int32_t parent;
+    int64_t depth;
+  };
+  std::vector<PendingNode> pending_nodes;
+
+  compact_nodes_.clear();
+  compact_nodes_.reserve(nodes_.size());
+  compact_roots_.clear();
+  compact_roots_.reserve(roots_.size());
+  for (const auto* root : roots_) {
+    compact_roots_.push_back(static_cast<int32_t>(compact_nodes_.size()));
+    pending_nodes.push_back({root, -1, 0});
+    while (!pending_nodes.empty()) {
+      const PendingNode pending = pending_nodes.back();
+      pending_nodes.pop_back();
+      ORT_ENFORCE(pending.node != nullptr, "A branch of tree ", root->id.tree_id, " has no child node.");
+      ORT_ENFORCE(pending.depth <= max_tree_depth_, "Tree ", root->id.tree_id, " is deeper than ", max_tree_depth_,
+                  " levels.");
+
+      const auto index = static_cast<int32_t>(compact_nodes_.size());
+      if (pending.parent >= 0) {
+        compact_nodes_[pending.parent].next = index;
+      }
+
+      const auto& node = *pending.node;
+      TreeNodeCompact<OTYPE> compact_node;
+      compact_node.value = node.value;
+      compact_node.feature_id = node.feature_id;
+      compact_node.mode = static_cast<uint8_t>(node.mode);
+      compact_node.flags = static_cast<uint8_t>(node.is_missing_track_true ? kTreeNodeMissingTrackTrue : 0);
+      if (node.is_not_leaf) {
+        compact_node.next = -1;
+        // the true child is added first, right after this node
+        pending_nodes.push_back({node.falsenode, index, pending.depth + 1});
+        pending_nodes.push_back({node.truenode, -1, pending.depth + 1});
+      } else {
+        compact_node.flags = static_cast<uint8_t>(compact_node.flags | kTreeNodeLeaf);
+        compact_node.next = static_cast<int32_t>(pending.node - nodes_.data());
+      }
+      compact_nodes_.push_back(compact_node);
+    }
+  }
+}
+
+template <typename ITYPE, typename OTYPE>
+void TreeEnsembleCommon<ITYPE, OTYPE>::compute(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Z,
+                                               Tensor* label) const {
   switch (aggregate_function_) {
     case AGGREGATE_FUNCTION::AVERAGE:
       compute_agg(
-          X, Z, label,
+          ttp, X, Z, label,
           TreeAggregatorAverage<ITYPE, OTYPE>(
               roots_.size(), n_targets_or_classes_,
               post_transform_, base_values_));
       return;
     case AGGREGATE_FUNCTION::SUM:
       compute_agg(
-          X, Z, label,
+          ttp, X, Z, label,
           TreeAggregatorSum<ITYPE, OTYPE>(
               roots_.size(), n_targets_or_classes_,
               post_transform_, base_values_));
       return;
     case AGGREGATE_FUNCTION::MIN:
       compute_agg(
-          X, Z, label,
+          ttp, X, Z, label,
           TreeAggregatorMin<ITYPE, OTYPE>(
               roots_.size(), n_targets_or_classes_,
               post_transform_, base_values_));
       return;
     case AGGREGATE_FUNCTION::MAX:
       compute_agg(
-          X, Z, label,
+          ttp, X, Z, label,
           TreeAggregatorMax<ITYPE, OTYPE>(
               roots_.size(), n_targets_or_classes_,
               post_transform_, base_values_));
@@ -248,9 +361,69 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::compute(const Tensor* X, Tensor* Z, Tenso
   }
 }
 
+template <typename ITYPE, typename OTYPE>
+template <NODE_MODE mode>
+void TreeEnsembleCommon<ITYPE, OTYPE>::FindLeavesWithMode(size_t j, const ITYPE* x_data, int64_t stride,
+                                                          int64_t n_rows,
+                                                          const TreeNodeElement<OTYPE>** leaves) const {
+  const TreeNodeCompact<OTYPE>* compact_nodes = compact_nodes_.data();
+  const TreeNodeCompact<OTYPE>* current[kTreeEnsembleRowBlock];
+  for (int64_t r = 0; r < n_rows; ++r) {
+    current[r] = compact_nodes + compact_roots_[j];
+  }
+
+  // move every row one level down the tree at a time
+  bool all_leaves;
+  do {
+    all_leaves = true;
+    for (int64_t r = 0; r < n_rows; ++r) {
+      const TreeNodeCompact<OTYPE>* node = current[r];
+      if (node->flags & kTreeNodeLeaf) {
+        continue;
+      }
+      all_leaves = false;
+      const ITYPE val = x_data[r * stride + node->feature_id];
+      current[r] = IsTrueBranch<mode>(val, *node) ? node + 1 : compact_nodes + node->next;
+    }
+  } while (!all_leaves);
+
+  for (int64_t r = 0; r < n_rows; ++r) {
+    leaves[r] = &nodes_[current[r]->next];
+  }
+}
+
+template <typename ITYPE, typename OTYPE>
+void TreeEnsembleCommon<ITYPE, OTYPE>::FindLeaves(size_t j, const ITYPE* x_data, int64_t stride, int64_t n_rows,
+                                                  const TreeNodeElement<OTYPE>** leaves) const {
+  switch (compact_mode_) {
+    case NODE_MODE::BRANCH_LEQ:
+      FindLeavesWithMode<NODE_MODE::BRANCH_LEQ>(j, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::BRANCH_LT:
+      FindLeavesWithMode<NODE_MODE::BRANCH_LT>(j, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::BRANCH_GTE:
+      FindLeavesWithMode<NODE_MODE::BRANCH_GTE>(j, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::BRANCH_GT:
+      FindLeavesWithMode<NODE_MODE::BRANCH_GT>(j, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::BRANCH_EQ:
+      FindLeavesWithMode<NODE_MODE::BRANCH_EQ>(j, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::BRANCH_NEQ:
+      FindLeavesWithMode<NODE_MODE::BRANCH_NEQ>(j, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::LEAF:  // different modes
+      FindLeavesWithMode<NODE_MODE::LEAF>(j, x_data, stride, n_rows, leaves);
+      break;
+  }
+}
+
 template <typename ITYPE, typename OTYPE>
 template <typename AGG>
-void TreeEnsembleCommon<ITYPE, OTYPE>::compute_agg(const Tensor* X, Tensor* Z, Tensor* label, const AGG& agg) const {
+void TreeEnsembleCommon<ITYPE, OTYPE>::compute_agg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Z,
+                                                   Tensor* label, const AGG& agg) const {
   int64_t stride = X->Shape().NumDimensions() == 1 ? X->Shape()[0] : X->Shape()[1];
   int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
 
@@ -258,222 +431,92 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::compute_agg(const Tensor* X, Tensor* Z, T
   OTYPE* z_data = Z->template MutableData<OTYPE>();
   int64_t* label_data = label == NULL ? NULL : label->template MutableData<int64_t>();
 
-  if (n_targets_or_classes_ == 1) {
-    if (N == 1) {
-      ScoreValue<OTYPE> score = {0, 0};
-      if (n_trees_ <= parallel_tree_) {
-        for (int64_t j = 0; j < n_trees_; ++j)
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data));
-      } else {
-        std::vector<ScoreValue<OTYPE>> scores_t(n_trees_, {0, 0});
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-        for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction1(scores_t[j], *ProcessTreeNodeLeave(roots_[j], x_data));
-        }
-        for (auto it = scores_t.cbegin(); it != scores_t.cend(); ++it)
-          agg.MergePrediction1(score, *it);
-      }
+  if (N == 1 && n_trees_ > parallel_tree_ && ttp != nullptr) {
+    // a single row is parallelized over the trees, each batch of trees accumulates its own scores
+    const auto n_batches = static_cast<int32_t>(std::min<int64_t>(n_trees_, ttp->NumThreads() + 1));
+    if (n_targets_or_classes_ == 1) {
+      std::vector<ScoreValue<OTYPE>> scores_t(n_batches, {0, 0});
+      concurrency::ThreadPool::TryBatchParallelFor(
+          ttp, n_batches,
+          [&](int32_t batch) {
+            const TreeNodeElement<OTYPE>* batch_leaf;
+            for (int64_t j = n_trees_ * batch / n_batches, end = n_trees_ * (batch + 1) / n_batches; j < end; ++j) {
+              FindLeaves(static_cast<size_t>(j), x_data, stride, 1, &batch_leaf);
+              agg.ProcessTreeNodePrediction1(scores_t[batch], *batch_leaf);
+            }
+          },
+          n_batches);
 
+      ScoreValue<OTYPE> score = {0, 0};
+      for (auto& batch_score : scores_t)
+        agg.MergePrediction1(score, batch_score);
       agg.FinalizeScores1(z_data, score, label_data);
     } else {
-      if (N <= parallel_N_) {
-        ScoreValue<OTYPE> score;
-        size_t j;
-
-        for (int64_t i = 0; i < N; ++i) {
-          score = {0, 0};
-          for (j = 0; j < static_cast<size_t>(n_trees_); ++j)
-            agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-          agg.FinalizeScores1(z_data + i * n_targets_or_classes_, score,
-                              label_data == NULL ? NULL : (label_data + i));
-        }
-      } else {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-        for (int64_t i = 0; i < N; ++i) {
-          ScoreValue<OTYPE> score = {0, 0};
-          for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j)
-            agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-          agg.FinalizeScores1(z_data + i * n_targets_or_classes_, score,
-                              label_data == NULL ? NULL : (label_data + i));
-        }
-      }
-    }
-  } else {
-    if (N == 1) {
-      std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_, {0, 0});
+      std::vector<std::vector<ScoreValue<OTYPE>>> scores_t(
+          n_batches, std::vector<ScoreValue<OTYPE>>(n_targets_or_classes_, {0, 0}));
+      concurrency::ThreadPool::TryBatchParallelFor(
+          ttp, n_batches,
+          [&](int32_t batch) {
+            const TreeNodeElement<OTYPE>* batch_leaf;
+            for (int64_t j = n_trees_ * batch / n_batches, end = n_trees_ * (batch + 1) / n_batches; j < end; ++j) {
+              FindLeaves(static_cast<size_t>(j), x_data, stride, 1, &batch_leaf);
+              agg.ProcessTreeNodePrediction(scores_t[batch], *batch_leaf);
+            }
+          },
+          n_batches);
 
-      if (n_trees_ <= parallel_tree_) {
-        for (int64_t j = 0; j < n_trees_; ++j)
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data));
-        agg.FinalizeScores(scores, z_data, -1, label_data);
-      } else {
-#ifdef USE_OPENMP
-#pragma omp parallel
-#endif
-        {
-          std::vector<ScoreValue<OTYPE>> private_scores(n_targets_or_classes_, {0, 0});
-#ifdef USE_OPENMP
-#pragma omp for
-#endif
-          for (int64_t j = 0; j < n_trees_; ++j) {
-            agg.ProcessTreeNodePrediction(private_scores, *ProcessTreeNodeLeave(roots_[j], x_data));
-          }
-
-#ifdef USE_OPENMP
-#pragma omp critical
-#endif
-          agg.MergePrediction(scores, private_scores);
-        }
-
-        agg.FinalizeScores(scores, z_data, -1, label_data);
-      }
-    } else {
-      if (N <= parallel_N_) {
-        std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_);
-        size_t j;
-
-        for (int64_t i = 0; i < N; ++i) {
-          std::fill(scores.begin(), scores.end(), ScoreValue<OTYPE>({0, 0}));
-          for (j = 0; j < roots_.size(); ++j)
-            agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-          agg.FinalizeScores(scores,
-                             z_data + i * n_targets_or_classes_, -1,
-                             label_data == NULL ? NULL : (label_data + i));
-          ORT_ENFORCE((int64_t)scores.size() == n_targets_or_classes_);
-        }
-      } else {
-#ifdef USE_OPENMP
-#pragma omp parallel
-#endif
-        {
-          std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_);
-          size_t j;
-
-#ifdef USE_OPENMP
-#pragma omp for
-#endif
-          for (int64_t i = 0; i < N; ++i) {
-            std::fill(scores.begin(), scores.end(), ScoreValue<OTYPE>({0, 0}));
-            for (j = 0; j < roots_.size(); ++j)
-              agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-            agg.FinalizeScores(scores,
-                               z_data + i * n_targets_or_classes_, -1,
-                               label_data == NULL ? NULL : (label_data + i));
-          }
-        }
-      }
+      std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_, {0, 0});
+      for (const auto& batch_scores : scores_t)
+        agg.MergePrediction(scores, batch_scores);
+      agg.FinalizeScores(scores, z_data, -1, label_data);
     }
+    return;
   }
-}
 
-#define TREE_FIND_VALUE(CMP)                                         \
-  if (has_missing_tracks_) {                                         \
-    while (root->is_not_leaf) {                                      \
-      val = x_data[root->feature_id];                                \
-      root = (val CMP root->value ||                                 \
-              (root->is_missing_track_true && _isnan_(val)))         \
-                 ? root->truenode                                    \
-                 : root->falsenode;                                  \
-    }                                                                \
-  } else {                                                           \
-    while (root->is_not_leaf) {                                      \
-      val = x_data[root->feature_id];                                \
-      root = val CMP root->value ? root->truenode : root->falsenode; \
-    }                                                                \
-  }
-
-inline bool _isnan_(float x) { return std::isnan(x); }
-inline bool _isnan_(double x) { return std::isnan(x); }
-inline bool _isnan_(int64_t) { return false; }
-inline bool _isnan_(int32_t) { return false; }
-
-template <typename ITYPE, typename OTYPE>
-TreeNodeElement<OTYPE>*
-TreeEnsembleCommon<ITYPE, OTYPE>::ProcessTreeNodeLeave(
-    TreeNodeElement<OTYPE>* root, const ITYPE* x_data) const {
-  ITYPE val;
-  if (same_mode_) {
-    switch (root->mode) {
-      case NODE_MODE::BRANCH_LEQ:
-        if (has_missing_tracks_) {
-          while (root->is_not_leaf) {
-            val = x_data[root->feature_id];
-            root = (val <= root->value ||
-                    (root->is_missing_track_true && _isnan_(val)))
-                       ? root->truenode
-                       : root->falsenode;
-          }
-        } else {
-          while (root->is_not_leaf) {
-            val = x_data[root->feature_id];
-            root = val <= root->value ? root->truenode : root->falsenode;
+  // the rows are evaluated by blocks of kTreeEnsembleRowBlock rows, and in parallel over ranges of blocks once there
+  // are enough of them.
+  const int64_t n_blocks = (N + kTreeEnsembleRowBlock - 1) / kTreeEnsembleRowBlock;
+  const auto n_batches = static_cast<int32_t>(
+      N <= parallel_N_ || ttp == nullptr ? 1 : std::min<int64_t>(n_blocks, ttp->NumThreads() + 1));
+
+  concurrency::ThreadPool::TryBatchParallelFor(
+      ttp, n_batches,
+      [&](int32_t batch) {
+        const TreeNodeElement<OTYPE>* leaves[kTreeEnsembleRowBlock];
+        ScoreValue<OTYPE> scores1[kTreeEnsembleRowBlock];
+        std::vector<std::vector<ScoreValue<OTYPE>>> scores(n_targets_or_classes_ == 1 ? 0 : kTreeEnsembleRowBlock);
+
+        for (int64_t block = n_blocks * batch / n_batches, end = n_blocks * (batch + 1) / n_batches; block < end;
+             ++block) {
+          const int64_t first_row = block * kTreeEnsembleRowBlock;
+          const int64_t n_rows = std::min(kTreeEnsembleRowBlock, N - first_row);
+          const ITYPE* block_x_data = x_data + first_row * stride;
+
+          if (n_targets_or_classes_ == 1) {
+            std::fill_n(scores1, n_rows, ScoreValue<OTYPE>({0, 0}));
+            for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+              FindLeaves(j, block_x_data, stride, n_rows, leaves);
+              for (int64_t r = 0; r < n_rows; ++r)
+                agg.ProcessTreeNodePrediction1(scores1[r], *leaves[r]);
+            }
+            for (int64_t r = 0; r < n_rows; ++r)
+              agg.FinalizeScores1(z_data + (first_row + r) * n_targets_or_classes_, scores1[r],
+                                  label_data == NULL ? NULL : (label_data + first_row + r));
+          } else {
+            for (int64_t r = 0; r < n_rows; ++r)
+              scores[r].assign(n_targets_or_classes_, {0, 0});
+            for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+              FindLeaves(j, block_x_data, stride, n_rows, leaves);
+              for (int64_t r = 0; r < n_rows; ++r)
+                agg.ProcessTreeNodePrediction(scores[r], *leaves[r]);
+            }
+            for (int64_t r = 0; r < n_rows; ++r)
+              agg.FinalizeScores(scores[r], z_data + (first_row + r) * n_targets_or_classes_, -1,
+                                 label_data == NULL ? NULL : (label_data + first_row + r));
           }
         }
-        break;
-      case NODE_MODE::BRANCH_LT:
-        TREE_FIND_VALUE(<)
-        break;
-      case NODE_MODE::BRANCH_GTE:
-        TREE_FIND_VALUE(>=)
-        break;
-      case NODE_MODE::BRANCH_GT:
-        TREE_FIND_VALUE(>)
-        break;
-      case NODE_MODE::BRANCH_EQ:
-        TREE_FIND_VALUE(==)
-        break;
-      case NODE_MODE::BRANCH_NEQ:
-        TREE_FIND_VALUE(!=)
-        break;
-      case NODE_MODE::LEAF:
-        break;
-    }
-  } else {  // Different rules to compare to node thresholds.
-    OTYPE threshold;
-    while (root->is_not_leaf) {
-      val = x_data[root->feature_id];
-      threshold = root->value;
-      switch (root->mode) {
-        case NODE_MODE::BRANCH_LEQ:
-          root = val <= threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_LT:
-          root = val < threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_GTE:
-          root = val >= threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_GT:
-          root = val > threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_EQ:
-          root = val == threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_NEQ:
-          root = val != threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::LEAF:
-          break;
-      }
-    }
-  }
-  return root;
+      },
+      n_batches);
 }
 
 template <typename ITYPE, typename OTYPE>
@@ -509,7 +552,7 @@ class TreeEnsembleCommonClassifier : TreeEnsembleCommon<ITYPE, OTYPE> {
 
   int64_t get_class_count() const { return this->n_targets_or_classes_; }
 
-  void compute(const Tensor* X, Tensor* Z, Tensor* label) const;
+  void compute(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Z, Tensor* label) const;
 };
 
 template <typename ITYPE, typename OTYPE>
@@ -571,10 +614,11 @@ TreeEnsembleCommonClassifier<ITYPE, OTYPE>::TreeEnsembleCommonClassifier(
 }
 
 template <typename ITYPE, typename OTYPE>
-void TreeEnsembleCommonClassifier<ITYPE, OTYPE>::compute(const Tensor* X, Tensor* Z, Tensor* label) const {
+void TreeEnsembleCommonClassifier<ITYPE, OTYPE>::compute(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Z,
+                                                         Tensor* label) const {
   if (classlabels_strings_.size() == 0) {
     this->compute_agg(
-        X, Z, label,
+        ttp, X, Z, label,
         TreeAggregatorClassifier<ITYPE, OTYPE>(
             this->roots_.size(), this->n_targets_or_classes_,
             this->post_transform_, this->base_values_,
@@ -585,7 +629,7 @@ void TreeEnsembleCommonClassifier<ITYPE, OTYPE>::compute(const Tensor* X, Tensor
     std::shared_ptr<IAllocator> allocator = std::make_shared<CPUAllocator>();
     Tensor label_int64(DataTypeImpl::GetType<int64_t>(), TensorShape({N}), allocator);
     this->compute_agg(
-        X, Z, &label_int64,
+        ttp, X, Z, &label_int64,
         TreeAggregatorClassifier<ITYPE, OTYPE>(
             this->roots_.size(), this->n_targets_or_classes_,
             this->post_transform_, this->base_values_,
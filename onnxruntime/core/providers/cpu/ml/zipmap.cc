@@ -2,7 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/zipmap.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
+
+#include <algorithm>
 /**
 https://github.com/onnx/onnx/blob/master/onnx/defs/traditionalml/defs.cc
 ONNX_OPERATOR_SCHEMA(ZipMap)
@@ -35,6 +38,59 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
                                             DataTypeImpl::GetType<std::vector<std::map<std::int64_t, float>>>()}),
     ZipMapOp);
 
+// Returns the indices of the labels sorted by key. Only the last index of a repeated key is kept, as it's the value
+// written last to the map.
+template <typename TKey>
+static std::vector<size_t> GetKeyOrder(const std::vector<TKey>& labels) {
+  std::vector<size_t> order(labels.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&labels](size_t a, size_t b) { return labels[a] < labels[b]; });
+
+  std::vector<size_t> unique_order;
+  for (size_t i = 0; i < order.size(); ++i) {
+    if (i + 1 < order.size() && !(labels[order[i]] < labels[order[i + 1]])) {
+      continue;
+    }
+    unique_order.push_back(order[i]);
+  }
+  return unique_order;
+}
+
+// Minimum number of rows each thread converts before another thread is used.
+static constexpr int64_t kMinRowsPerThread = 256;
+
+// Builds the map of each row. The keys are appended in order with a hint, so each insertion is constant time, and
+// the rows are split across the threads.
+template <typename TKey>
+static void ZipRows(const std::vector<TKey>& labels, const std::vector<size_t>& key_order, const float* x_data,
+                    int64_t batch_size, int64_t features_per_batch, std::vector<std::map<TKey, float>>& y_data,
+                    concurrency::ThreadPool* tp) {
+  y_data.resize(batch_size);
+  auto zip_rows = [&](int64_t first, int64_t last) {
+    for (int64_t n = first; n < last; ++n) {
+      std::map<TKey, float>& row_map = y_data[n];
+      const float* row = x_data + n * features_per_batch;
+      for (size_t j : key_order) {
+        row_map.emplace_hint(row_map.end(), labels[j], row[j]);
+      }
+    }
+  };
+
+  int64_t num_batches = 1;
+  if (tp != nullptr) {
+    num_batches = std::min<int64_t>(batch_size / kMinRowsPerThread, tp->NumThreads() + 1);
+  }
+  if (num_batches <= 1) {
+    zip_rows(0, batch_size);
+  } else {
+    tp->ParallelFor(static_cast<int32_t>(num_batches), [&](int32_t batch) {
+      zip_rows(batch_size * batch / num_batches, batch_size * (batch + 1) / num_batches);
+    });
+  }
+}
+
 ZipMapOp::ZipMapOp(const OpKernelInfo& info)
     : OpKernel(info),
       classlabels_int64s_(info.GetAttrsOrDefault<int64_t>("classlabels_int64s")),
@@ -42,6 +98,11 @@ ZipMapOp::ZipMapOp(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.empty() ^ classlabels_int64s_.empty(),
               "Must provide classlabels_strings or classlabels_int64s but not both.");
   using_strings_ = !classlabels_strings_.empty();
+  if (using_strings_) {
+    key_order_ = GetKeyOrder(classlabels_strings_);
+  } else {
+    key_order_ = GetKeyOrder(classlabels_int64s_);
+  }
 }
 
 common::Status ZipMapOp::Compute(OpKernelContext* context) const {
@@ -67,6 +128,7 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
   }
 
   const auto* x_data = X.template Data<float>();
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
 
   if (using_strings_) {
     if (features_per_batch != static_cast<int64_t>(classlabels_strings_.size())) {
@@ -78,17 +140,7 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     auto* y_data = context->Output<std::vector<std::map<std::string, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
 
-    //auto* y_data = Y->template MutableData<std::vector<std::map<std::string, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int64_t n = 0; n < batch_size; n++) {
-      std::map<std::string, float> map1;
-      for (int64_t j = 0; j < features_per_batch; j++) {
-        map1[classlabels_strings_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map1);
-    }
+    ZipRows(classlabels_strings_, key_order_, x_data, batch_size, features_per_batch, *y_data, tp);
   } else {
     if (features_per_batch != static_cast<int64_t>(classlabels_int64s_.size())) {
       return Status(ONNXRUNTIME,
@@ -98,17 +150,8 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     }
     auto* y_data = context->Output<std::vector<std::map<std::int64_t, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-    //auto* y_data = Y->template MutableData<std::vector<std::map<int64_t, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int n = 0; n < batch_size; n++) {
-      std::map<int64_t, float> map2;
-      for (int j = 0; j < features_per_batch; j++) {
-        map2[classlabels_int64s_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map2);
-    }
+
+    ZipRows(classlabels_int64s_, key_order_, x_data, batch_size, features_per_batch, *y_data, tp);
   }
   return common::Status::OK();
 }
@@ -16,6 +16,9 @@ class ZipMapOp final : public OpKernel {
   bool using_strings_;
   std::vector<int64_t> classlabels_int64s_;
   std::vector<std::string> classlabels_strings_;
+  // the indices of the labels in key order, without the earlier duplicates of a key. the maps of the rows are built
+  // by appending in this order, without searching for the position of each key.
+  std::vector<size_t> key_order_;
 };
 
 }  // namespace ml
@@ -17,7 +17,12 @@
 
 #include "core/providers/cpu/nn/conv.h"
 
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
 #include "core/common/safeint.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -160,6 +165,172 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+namespace {
+
+// Uses the filter prepacked for the Winograd algorithm, which does not need to transform the filter to the working
+// buffer then.
+void UsePackedFilter(MLAS_CONV_PARAMETERS& parameters, size_t& working_buffer_size, const void* packed_W) {
+  if (parameters.Algorithm == MlasConvAlgorithmWinograd && packed_W != nullptr) {
+    parameters.u.Winograd.PackedFilter = packed_W;
+    working_buffer_size -= parameters.u.Winograd.FilterBufferSize;
+  }
+}
+
+std::string MakeTuningKey(const MLAS_CONV_PARAMETERS& parameters, bool has_packed_W, int num_threads) {
+  std::ostringstream key;
+  auto add_dims = [&key](const char* name, const size_t* dims, size_t count) {
+    key << ' ' << name;
+    for (size_t i = 0; i < count; ++i) {
+      key << (i == 0 ? "" : "x") << dims[i];
+    }
+  };
+
+  const size_t rank = parameters.Dimensions;
+  key << "Conv N" << parameters.BatchCount << " G" << parameters.GroupCount << " C" << parameters.InputChannels
+      << " M" << parameters.FilterCount;
+  add_dims("I", parameters.InputShape, rank);
+  add_dims("K", parameters.KernelShape, rank);
+  add_dims("D", parameters.DilationShape, rank);
+  add_dims("P", parameters.Padding, rank * 2);
+  add_dims("S", parameters.StrideShape, rank);
+  key << (has_packed_W ? " Wpacked" : "") << " T" << num_threads;
+  return key.str();
+}
+
+}  // namespace
+
+CpuTuningCache* Conv<float>::GetTuningCache(const OpKernelInfo& info) {
+  const auto* provider = info.GetExecutionProvider();
+  if (provider->Type() != kCpuExecutionProvider) {
+    return nullptr;
+  }
+  return static_cast<const CPUExecutionProvider*>(provider)->GetTuningCache();
+}
+
+Status Conv<float>::ApplyTuning(MLAS_CONV_PARAMETERS& parameters, size_t& working_buffer_size, const float* Xdata,
+                                const float* Wdata, const float* Bdata, float* Ydata, const AllocatorPtr& alloc,
+                                concurrency::ThreadPool* thread_pool) const {
+  const int num_threads = thread_pool != nullptr ? thread_pool->NumThreads() : 1;
+  const std::string key = MakeTuningKey(parameters, packed_W_ != nullptr, num_threads);
+
+  // the config is the algorithm and the number of threads
+  std::vector<int64_t> config;
+  if (!tuning_cache_->Lookup(key, config)) {
+    static const MLAS_CONV_ALGORITHM algorithms[] = {
+        MlasConvAlgorithmGemmDirect,
+        MlasConvAlgorithmExpandThenGemm,
+        MlasConvAlgorithmExpandThenGemmSegmented,
+        MlasConvAlgorithmDepthwise,
+        MlasConvAlgorithmWinograd,
+    };
+    constexpr int kMeasuredRuns = 3;
+
+    // 0 lets MLAS pick the thread count from the complexity of the convolution
+    std::vector<int32_t> thread_counts{0};
+    for (int32_t count = 1; count < num_threads; count *= 2) {
+      thread_counts.push_back(count);
+    }
+    thread_counts.push_back(num_threads);
+
+    std::vector<std::pair<MLAS_CONV_ALGORITHM, int32_t>> measured;
+    auto best_time = std::chrono::steady_clock::duration::max();
+
+    for (const auto algorithm : algorithms) {
+      for (const auto thread_count : thread_counts) {
+        MLAS_CONV_PARAMETERS candidate = parameters;
+        size_t candidate_buffer_size;
+        if (!MlasConvPrepareAlgorithm(&candidate, algorithm, thread_count, &candidate_buffer_size, thread_pool)) {
+          break;
+        }
+
+        // thread counts beyond the work available to the algorithm are clamped to the same configuration
+        const auto measured_config = std::make_pair(candidate.Algorithm, candidate.ThreadCount);
+        if (std::find(measured.begin(), measured.end(), measured_config) != measured.end()) {
+          continue;
+        }
+        measured.push_back(measured_config);
+
+        UsePackedFilter(candidate, candidate_buffer_size, packed_W_);
+        auto* working_data = candidate_buffer_size > 0
+                                 ? alloc->Alloc(SafeInt<size_t>(sizeof(float)) * candidate_buffer_size)
+                                 : nullptr;
+        BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
+
+        // the first run warms up the caches and the working buffer
+        auto candidate_time = std::chrono::steady_clock::duration::max();
+        for (int run = 0; run <= kMeasuredRuns; ++run) {
+          const auto start = std::chrono::steady_clock::now();
+          MlasConv(&candidate, Xdata, Wdata, Bdata, static_cast<float*>(working_buffer.get()), Ydata, thread_pool);
+          if (run > 0) {
+            candidate_time = std::min(candidate_time, std::chrono::steady_clock::now() - start);
+          }
+        }
+
+        if (candidate_time < best_time) {
+          best_time = candidate_time;
+          config = {static_cast<int64_t>(algorithm), static_cast<int64_t>(thread_count)};
+        }
+      }
+    }
+
+    // failing to write the cache file only costs the next session the measurements
+    auto status = tuning_cache_->Insert(key, config);
+    if (!status.IsOK()) {
+      LOGS_DEFAULT(WARNING) << status.ErrorMessage();
+    }
+  }
+
+  if (config.size() == 2 && config[0] >= MlasConvAlgorithmGemmDirect && config[0] <= MlasConvAlgorithmWinograd) {
+    MlasConvPrepareAlgorithm(&parameters, static_cast<MLAS_CONV_ALGORITHM>(config[0]),
+                             static_cast<int32_t>(config[1]), &working_buffer_size, thread_pool);
+  }
+
+  return Status::OK();
+}
+
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed, /*out*/ PrePackedWeights& prepacked_weights) {
+  is_packed = false;
+
+  // Only the filter of an ungrouped 3x3 convolution with unit strides and dilations can be used by the Winograd
+  // algorithm. MlasConvPrepare makes the final choice once the input shape is known.
+  const auto& w_shape = tensor.Shape();
+  if (input_idx != 1 || !tensor.IsDataType<float>() || conv_attrs_.group != 1 ||
+      w_shape.NumDimensions() != 4 || w_shape[2] != 3 || w_shape[3] != 3) {
+    return Status::OK();
+  }
+
+  auto is_one = [](int64_t value) { return value == 1; };
+  if (!std::all_of(conv_attrs_.strides.begin(), conv_attrs_.strides.end(), is_one) ||
+      !std::all_of(conv_attrs_.dilations.begin(), conv_attrs_.dilations.end(), is_one)) {
+    return Status::OK();
+  }
+
+  const size_t filter_count = static_cast<size_t>(w_shape[0]);
+  const size_t input_channels = static_cast<size_t>(w_shape[1]);
+
+  const size_t packed_w_size = MlasConvWinogradPackFilterSize(filter_count, input_channels);
+  if (packed_w_size == 0) {
+    return Status::OK();
+  }
+
+  void* packed_w_data = alloc->Alloc(packed_w_size);
+  BufferUniquePtr packed_w(packed_w_data, BufferDeleter(alloc));
+  MlasConvWinogradPackFilter(filter_count, input_channels, tensor.Data<float>(), packed_w_data);
+
+  prepacked_weights.buffers_.push_back(std::move(packed_w));
+  prepacked_weights.buffer_sizes_.push_back(packed_w_size);
+  is_packed = true;
+  return Status::OK();
+}
+
+Status Conv<float>::UseSharedPrePackedBuffers(const PrePackedWeights& prepacked_weights, int input_idx) {
+  if (input_idx == 1) {
+    packed_W_ = prepacked_weights.buffers_[0].get();
+  }
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const auto* X = context->Input<Tensor>(0);
@@ -226,6 +397,14 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     &WorkingBufferSize,
                     thread_pool);
 
+    if (tuning_cache_ != nullptr) {
+      ORT_RETURN_IF_ERROR(ApplyTuning(Parameters, WorkingBufferSize, Xdata, W->template Data<float>(), Bdata, Ydata,
+                                      alloc, thread_pool));
+    }
+
+    // The Winograd algorithm does not need to transform the filter to the working buffer if it was prepacked.
+    UsePackedFilter(Parameters, WorkingBufferSize, packed_W_);
+
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(SafeInt<size_t>(sizeof(float)) * WorkingBufferSize)
                                                : nullptr;
     BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
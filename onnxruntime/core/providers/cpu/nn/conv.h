@@ -3,12 +3,15 @@
 
 #pragma once
 
+#include "core/framework/kernel_cost.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/nn/conv_attributes.h"
 #include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
+class CpuTuningCache;
+
 template <typename T>
 class Conv : public OpKernel {
  public:
@@ -17,6 +20,11 @@ class Conv : public OpKernel {
 
   Status Compute(OpKernelContext* context) const override;
 
+  bool GetCost(OpKernelContext& context, KernelCost& cost) const override {
+    cost = kernel_cost::Convolution(context);
+    return true;
+  }
+
  private:
   ConvAttributes conv_attrs_;
 };
@@ -24,16 +32,40 @@ class Conv : public OpKernel {
 template <>
 class Conv<float> : public OpKernel {
  public:
-  Conv<float>(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
+  Conv<float>(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info), tuning_cache_(GetTuningCache(info)) {
     activation_.ActivationKind = MlasIdentityActivation;
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights& prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(const PrePackedWeights& prepacked_weights, int input_idx) override;
+
   Status Compute(OpKernelContext* context) const override;
 
+  bool GetCost(OpKernelContext& context, KernelCost& cost) const override {
+    cost = kernel_cost::Convolution(context);
+    return true;
+  }
+
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+ private:
+  static CpuTuningCache* GetTuningCache(const OpKernelInfo& info);
+
+  // Replaces the algorithm and thread count picked by MlasConvPrepare with the fastest ones measured for the shape.
+  Status ApplyTuning(MLAS_CONV_PARAMETERS& parameters, size_t& working_buffer_size, const float* Xdata,
+                     const float* Wdata, const float* Bdata, float* Ydata, const AllocatorPtr& alloc,
+                     concurrency::ThreadPool* thread_pool) const;
+
+  // W transformed for the Winograd algorithm of MlasConv if it is a constant 3x3 filter
+  const void* packed_W_ = nullptr;
+
+  // nullptr unless autotuning is enabled for the session
+  CpuTuningCache* const tuning_cache_;
 };
 
 }  // namespace onnxruntime
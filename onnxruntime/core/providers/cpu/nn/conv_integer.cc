@@ -18,7 +18,8 @@ ONNX_OPERATOR_KERNEL_EX(
     kCpuExecutionProvider,
     KernelDefBuilder()
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
-        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(),
+                               DataTypeImpl::GetTensorType<int8_t>()})
         .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
     ConvInteger);
 
@@ -26,6 +27,7 @@ Status ConvInteger::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const auto* X = context->Input<Tensor>(0);
   const auto* W = context->Input<Tensor>(1);
+  const bool is_W_signed = W->IsDataType<int8_t>();
   uint8_t input_offset = 0;
   uint8_t filter_offset = 0;
   if (num_inputs >= 3) {
@@ -36,7 +38,13 @@ Status ConvInteger::Compute(OpKernelContext* context) const {
   if (num_inputs >= 4) {
     const auto* W_Zero_Point = context->Input<Tensor>(3);
     ORT_ENFORCE(IsScalarOr1ElementVector(W_Zero_Point), "Non per-tensor quantization is not supported now.");
-    filter_offset = *(W_Zero_Point->Data<uint8_t>());
+    if (is_W_signed) {
+      filter_offset = static_cast<uint8_t>(*(W_Zero_Point->Data<int8_t>()) ^ 0x80);
+    } else {
+      filter_offset = *(W_Zero_Point->Data<uint8_t>());
+    }
+  } else if (is_W_signed) {
+    filter_offset = 0x80;
   }
 
   const int64_t N = X->Shape()[0];
@@ -104,10 +112,30 @@ Status ConvInteger::Compute(OpKernelContext* context) const {
 
   auto* col_buffer_data = static_cast<uint8_t*>(col_buffer.get());
 
+  // The filter is the left hand side of the GEMM, which must be unsigned, so signed filters are shifted into the
+  // unsigned domain together with their zero point: (w + 128) - (zp + 128) == w - zp.
+  const uint8_t* Wdata = nullptr;
+  BufferUniquePtr filter_buffer;
+  if (is_W_signed) {
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+    const auto filter_size = static_cast<size_t>(W->Shape().Size());
+    auto* filter_data = static_cast<uint8_t*>(alloc->Alloc(SafeInt<size_t>(sizeof(uint8_t)) * filter_size));
+    filter_buffer = BufferUniquePtr(filter_data, BufferDeleter(alloc));
+
+    const auto* signed_filter_data = W->template Data<int8_t>();
+    for (size_t i = 0; i < filter_size; i++) {
+      filter_data[i] = static_cast<uint8_t>(signed_filter_data[i] ^ 0x80);
+    }
+    Wdata = filter_data;
+  } else {
+    Wdata = W->template Data<uint8_t>();
+  }
+
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
   const auto* Xdata = X->template Data<uint8_t>();
-  const auto* Wdata = W->template Data<uint8_t>();
   auto* Ydata = Y->template MutableData<int32_t>();
 
   for (int image_id = 0; image_id < N; ++image_id) {
@@ -18,6 +18,7 @@
 #include "core/providers/cpu/nn/conv_transpose.h"
 
 #include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -40,6 +41,9 @@ Status ConvTranspose<T>::Compute(OpKernelContext* context) const {
   return ConvTranspose<T>::DoConvTranspose(context, false);
 }
 
+// Output images below this size are scattered from the columns on the calling thread
+static constexpr int64_t kParallelCol2imMinOutputs = 1 << 14;
+
 template <typename T>
 Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_padding) const {
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
@@ -54,7 +58,8 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
   const int64_t Y_offset = p.Y->Shape().Size() / p.Y->Shape()[0] / conv_transpose_attrs_.group;
   const int64_t W_offset = p.F->Shape().Size() / conv_transpose_attrs_.group;
   const int64_t kernel_size = TensorShape(p.kernel_shape).Size();
-  const int64_t kernel_dim = p.num_output_channels / conv_transpose_attrs_.group * kernel_size;
+  const int64_t group_output_channels = p.num_output_channels / conv_transpose_attrs_.group;
+  const int64_t kernel_dim = group_output_channels * kernel_size;
   const int64_t output_size = (p.Y->Shape().Slice(2)).Size();
 
   AllocatorPtr alloc;
@@ -67,102 +72,105 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
 
   const T* Xdata = p.X->template Data<T>();
   const T* filter_data = p.F->template Data<T>();
+  const T* Bdata = p.B != nullptr ? p.B->template Data<T>() : nullptr;
   T* Ydata = p.Y->template MutableData<T>();
 
+  const bool is_2d = p.X->Shape().NumDimensions() == 4;
+  std::vector<int64_t> output_shape = p.Y->Shape().Slice(1).GetDims();
   std::vector<int64_t> col_buffer_shape{kernel_dim};
   col_buffer_shape.insert(col_buffer_shape.end(), p.input_shape.GetDims().begin(), p.input_shape.GetDims().end());
 
-  if (p.X->Shape().NumDimensions() == 4) {
-    for (auto image_id = 0; image_id < p.N; ++image_id) {
-      for (int group_id = 0; group_id < conv_transpose_attrs_.group; ++group_id) {
-        // Weight term
-        math::Gemm<T>(
-            CblasTrans,
-            CblasNoTrans,
-            kernel_dim,
-            input_image_size,
-            p.num_input_channels / conv_transpose_attrs_.group,
-            1,
-            filter_data + group_id * W_offset,
-            Xdata + group_id * X_offset,
-            0,
-            col_buffer_data,
-            thread_pool);
-
-        // Col2im
-        math::Col2im<T, CPUMathUtil, StorageOrder::NCHW>(
-            col_buffer_data,
-            p.num_output_channels / conv_transpose_attrs_.group,
-            p.Y->Shape()[2],
-            p.Y->Shape()[3],
-            p.kernel_shape[0],
-            p.kernel_shape[1],
-            p.dilations[0],
-            p.dilations[1],
-            p.pads[0],
-            p.pads[1],
-            p.pads[2],
-            p.pads[3],
-            p.strides[0],
-            p.strides[1],
-            Ydata + group_id * Y_offset,
-            &CPUMathUtil::Instance());
-      }
+  // scatters the columns of the output channels [first_channel, first_channel + num_channels) of the group into the
+  // output image, then adds their bias while the image is still in cache. the channels don't overlap in the output
+  // so ranges of them are scattered in parallel.
+  auto col2im_channels = [&](int group_id, const T* col, T* y, int64_t first_channel, int64_t num_channels) {
+    col += first_channel * kernel_size * input_image_size;
+    y += first_channel * output_size;
+    if (is_2d) {
+      math::Col2im<T, CPUMathUtil, StorageOrder::NCHW>(
+          col,
+          num_channels,
+          p.Y->Shape()[2],
+          p.Y->Shape()[3],
+          p.kernel_shape[0],
+          p.kernel_shape[1],
+          p.dilations[0],
+          p.dilations[1],
+          p.pads[0],
+          p.pads[1],
+          p.pads[2],
+          p.pads[3],
+          p.strides[0],
+          p.strides[1],
+          y,
+          &CPUMathUtil::Instance());
+    } else {
+      std::vector<int64_t> image_shape(output_shape);
+      std::vector<int64_t> col_shape(col_buffer_shape);
+      image_shape[0] = num_channels;
+      col_shape[0] = num_channels * kernel_size;
+      math::Col2imNd<T, CPUMathUtil, StorageOrder::NCHW>(
+          col,
+          image_shape.data(),
+          col_shape.data(),
+          num_channels * output_size,
+          num_channels * kernel_size * input_image_size,
+          p.kernel_shape.data(),
+          p.strides.data(),
+          p.dilations.data(),
+          p.pads.data(),
+          static_cast<int>(p.kernel_shape.size()),
+          y,
+          &CPUMathUtil::Instance());
+    }
 
-      if (p.B != nullptr) {
-        auto Ymatrix = EigenMatrixMap<T>(Ydata, output_size, p.num_output_channels);
-        auto Bvec = ConstEigenVectorMap<T>(p.B->template Data<T>(), p.num_output_channels);
-        Ymatrix.rowwise() += Bvec.transpose();
+    if (Bdata != nullptr) {
+      const T* bias = Bdata + group_id * group_output_channels + first_channel;
+      for (int64_t c = 0; c < num_channels; ++c) {
+        EigenVectorArrayMap<T>(y + c * output_size, output_size) += bias[c];
       }
-
-      Xdata += X_offset * conv_transpose_attrs_.group;
-      Ydata += Y_offset * conv_transpose_attrs_.group;
     }
-  } else {
-    TensorShape output_shape = p.Y->Shape().Slice(1);
-    output_shape[0] = output_shape[0] / conv_transpose_attrs_.group;
-
-    for (auto image_id = 0; image_id < p.N; ++image_id) {
-      for (int group_id = 0; group_id < conv_transpose_attrs_.group; ++group_id) {
-        // Weight term
-        math::Gemm<T>(
-            CblasTrans,
-            CblasNoTrans,
-            kernel_dim,
-            input_image_size,
-            p.num_input_channels / conv_transpose_attrs_.group,
-            1,
-            filter_data + group_id * W_offset,
-            Xdata + group_id * X_offset,
-            0,
-            col_buffer_data,
-            thread_pool);
-
-        // Col2im
-        math::Col2imNd<T, CPUMathUtil, StorageOrder::NCHW>(
-            col_buffer_data,
-            output_shape.GetDims().data(),
-            col_buffer_shape.data(),
-            output_shape.Size(),
-            col_buffer_size,
-            p.kernel_shape.data(),
-            p.strides.data(),
-            p.dilations.data(),
-            p.pads.data(),
-            static_cast<int>(p.kernel_shape.size()),
-            Ydata + group_id * Y_offset,
-            &CPUMathUtil::Instance());
+  };
+
+  const int64_t num_batches =
+      thread_pool == nullptr || group_output_channels * output_size < kParallelCol2imMinOutputs
+          ? 1
+          : std::min<int64_t>(group_output_channels, thread_pool->NumThreads() + 1);
+
+  for (auto image_id = 0; image_id < p.N; ++image_id) {
+    for (int group_id = 0; group_id < conv_transpose_attrs_.group; ++group_id) {
+      // Weight term
+      math::Gemm<T>(
+          CblasTrans,
+          CblasNoTrans,
+          kernel_dim,
+          input_image_size,
+          p.num_input_channels / conv_transpose_attrs_.group,
+          1,
+          filter_data + group_id * W_offset,
+          Xdata + group_id * X_offset,
+          0,
+          col_buffer_data,
+          thread_pool);
+
+      // Col2im and bias
+      T* group_Ydata = Ydata + group_id * Y_offset;
+      if (num_batches == 1) {
+        col2im_channels(group_id, col_buffer_data, group_Ydata, 0, group_output_channels);
+      } else {
+        concurrency::ThreadPool::TryBatchParallelFor(
+            thread_pool, static_cast<int32_t>(num_batches),
+            [&](int32_t batch) {
+              const int64_t first_channel = group_output_channels * batch / num_batches;
+              const int64_t end_channel = group_output_channels * (batch + 1) / num_batches;
+              col2im_channels(group_id, col_buffer_data, group_Ydata, first_channel, end_channel - first_channel);
+            },
+            static_cast<int32_t>(num_batches));
       }
-
-      if (p.B != nullptr) {
-        auto Ymatrix = EigenMatrixMap<T>(Ydata, output_size, p.num_output_channels);
-        auto Bvec = ConstEigenVectorMap<T>(p.B->template Data<T>(), p.num_output_channels);
-        Ymatrix.rowwise() += Bvec.transpose();
-      }
-
-      Xdata += X_offset * conv_transpose_attrs_.group;
-      Ydata += Y_offset * conv_transpose_attrs_.group;
     }
+
+    Xdata += X_offset * conv_transpose_attrs_.group;
+    Ydata += Y_offset * conv_transpose_attrs_.group;
   }
 
   return Status::OK();
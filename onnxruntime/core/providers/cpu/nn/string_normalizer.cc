@@ -4,7 +4,10 @@
 #include "string_normalizer.h"
 #include "onnx/defs/schema.h"
 #include "core/common/common.h"
+#include "core/common/make_unique.h"
+#include "core/framework/packed_strings.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
 
 #ifdef _MSC_VER
 #include <codecvt>
@@ -16,6 +19,7 @@
 #include <iconv.h>
 #endif  // _MSC_VER
 
+#include <algorithm>
 #include <locale>
 #include <functional>
 #include <unordered_set>
@@ -188,12 +192,8 @@ const std::string default_locale("en_US.UTF-8"); // All non-MS
 
 #endif // MS_VER
 
-template <class ForwardIter>
-Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
-                      const Locale& loc,
-                      Utf8Converter& converter,
-                      size_t N, size_t C,
-                      StringNormalizer::CaseAction caseaction) {
+// Creates the output for C strings. Returns nullptr if C is 0, in which case the output is one empty string.
+Tensor* CreateOutput(OpKernelContext* ctx, size_t N, size_t C) {
   std::vector<int64_t> output_dims;
   if (N == 1) {
     output_dims.push_back(1);
@@ -205,37 +205,48 @@ Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
     TensorShape output_shape(output_dims);
     // This will create one empty string
     ctx->Output(0, output_shape);
-    return Status::OK();
+    return nullptr;
   }
 
   output_dims.push_back(C);
 
   TensorShape output_shape(output_dims);
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
+  return ctx->Output(0, output_shape);
+}
 
-  size_t output_idx = 0;
-  while (first != end) {
-    auto& s = *first;
-    if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
-      std::wstring wstr = converter.from_bytes(s);
-      if (wstr == wconv_error) {
-        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                      "Input contains invalid utf8 chars at: " + static_cast<const std::string&>(s));
-      }
-      // In place transform
-      loc.ChangeCase(caseaction, wstr);
-      *(output_data + output_idx) = converter.to_bytes(wstr);
-    } else {
-      assert(caseaction == StringNormalizer::NONE);
-      // Simple copy or move if the iterator points to a non-const string
-      *(output_data + output_idx) = std::move(s);
-    }
-    ++output_idx;
-    ++first;
+inline bool IsAscii(const std::string& s) {
+  unsigned char bits = 0;
+  for (const char c : s) {
+    bits |= static_cast<unsigned char>(c);
+  }
+  return bits < 0x80;
+}
+
+// Changes the case of the ASCII letters of s into out. The loop is branch free so compilers vectorize it.
+inline void AsciiChangeCase(StringNormalizer::CaseAction caseaction, const std::string& s, std::string& out) {
+  assert(caseaction != StringNormalizer::NONE);
+  out.resize(s.size());
+  const unsigned char first = caseaction == StringNormalizer::LOWER ? 'A' : 'a';
+  const char* in = s.data();
+  char* o = &out[0];
+  for (size_t i = 0, size = s.size(); i < size; ++i) {
+    const auto c = static_cast<unsigned char>(in[i]);
+    o[i] = static_cast<char>(c ^ ((static_cast<unsigned char>(c - first) < 26) << 5));
   }
-  return Status::OK();
 }
+
+// The strings normalized by a task: the kept input strings when the case doesn't change, otherwise the kept
+// strings with their case changed, packed in a single buffer.
+struct NormalizedBatch {
+  explicit NormalizedBatch(AllocatorPtr allocator) : cased_strings(std::move(allocator)) {}
+
+  std::vector<const std::string*> kept_strings;
+  PackedStrings cased_strings;
+  Status status;
+};
+
+// The input strings are normalized in parallel in batches of at least this many strings
+constexpr size_t kMinStringsPerBatch = 64;
 }  // namespace string_normalizer
 
 using namespace string_normalizer;
@@ -283,6 +294,22 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
       locale.ChangeCase(compare_caseaction_, wstr);
       auto p = wstopwords_.insert(wstr);
       ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
+      ascii_stopwords_.insert(converter.to_bytes(wstr));
+    }
+  }
+
+  // The ASCII strings skip the conversion to wide strings if the locale changes the case of the ASCII chars as
+  // the C locale does, e.g. not for the dotless i of Turkish locales
+  ascii_fast_path_ = true;
+  for (int c = 0; c < 0x80 && ascii_fast_path_; ++c) {
+    for (const auto caseaction : {LOWER, UPPER}) {
+      std::wstring wstr(1, static_cast<wchar_t>(c));
+      locale.ChangeCase(caseaction, wstr);
+      std::string expected;
+      AsciiChangeCase(caseaction, std::string(1, static_cast<char>(c)), expected);
+      if (wstr.size() != 1 || wstr[0] != static_cast<wchar_t>(expected[0])) {
+        ascii_fast_path_ = false;
+      }
     }
   }
 }
@@ -314,70 +341,112 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
                   "Input dimensions are either[C > 0] or [1][C > 0] allowed");
   }
 
-  Status status;
   Locale locale(locale_name_);
-  Utf8Converter converter(conv_error, wconv_error);
   auto const input_data = X->template Data<std::string>();
-  using StrRef = std::reference_wrapper<const std::string>;
-  if (is_case_sensitive_) {
-    if (!stopwords_.empty()) {
-      std::vector<StrRef> filtered_strings;
-      filtered_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        if (0 == stopwords_.count(s)) {
-          filtered_strings.push_back(std::cref(s));
-        }
-        ++first;
-      }
-      status = CopyCaseAction(filtered_strings.cbegin(), filtered_strings.cend(), ctx, locale, converter,
-                              N, filtered_strings.size(), case_change_action_);
-    } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
-    }
-  } else {
-    if (!wstopwords_.empty()) {
-      // Filter input. When no case action is required
-      // we simply store original string references.
-      // Otherwise, we store converted strings.
-      std::vector<StrRef> filtered_orignal_strings;
-      std::vector<std::string> filtered_cased_strings;
-      filtered_orignal_strings.reserve(C);
-      filtered_cased_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        std::wstring wstr = converter.from_bytes(s);
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+
+  // Filters the input string s and changes its case, adding it to batch if it's kept
+  auto normalize = [this, &locale](const std::string& s, Utf8Converter& converter, std::string& ascii_buffer,
+                                   NormalizedBatch& batch) -> Status {
+    const bool ascii = ascii_fast_path_ && IsAscii(s);
+    std::wstring wstr;
+    bool keep = true;
+    if (is_case_sensitive_) {
+      keep = stopwords_.empty() || stopwords_.count(s) == 0;
+    } else if (!wstopwords_.empty()) {
+      if (ascii) {
+        AsciiChangeCase(compare_caseaction_, s, ascii_buffer);
+        keep = ascii_stopwords_.count(ascii_buffer) == 0;
+      } else {
+        wstr = converter.from_bytes(s);
         if (wstr == wconv_error) {
           return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
                         "Input contains invalid utf8 chars at: " + s);
         }
         locale.ChangeCase(compare_caseaction_, wstr);
-        if (0 == wstopwords_.count(wstr)) {
-          if (case_change_action_ == NONE) {
-            filtered_orignal_strings.push_back(std::cref(s));
-          } else {
-            filtered_cased_strings.push_back(converter.to_bytes(wstr));
-          }
-        }
-        ++first;
+        keep = wstopwords_.count(wstr) == 0;
       }
-      if (case_change_action_ == NONE) {
-        status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale, converter,
-                                N, filtered_orignal_strings.size(), NONE);
-      } else {
-        status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale, converter,
-                                N, filtered_cased_strings.size(), NONE);
+      // the case of the compare is the one of the case change, if any
+      if (keep && case_change_action_ != NONE) {
+        if (ascii) {
+          batch.cased_strings.Append(ascii_buffer);
+        } else {
+          batch.cased_strings.Append(converter.to_bytes(wstr));
+        }
+        return Status::OK();
       }
+    }
+    if (!keep) {
+      return Status::OK();
+    }
+    if (case_change_action_ == NONE) {
+      batch.kept_strings.push_back(&s);
+    } else if (ascii) {
+      AsciiChangeCase(case_change_action_, s, ascii_buffer);
+      batch.cased_strings.Append(ascii_buffer);
     } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
+      wstr = converter.from_bytes(s);
+      if (wstr == wconv_error) {
+        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                      "Input contains invalid utf8 chars at: " + s);
+      }
+      locale.ChangeCase(case_change_action_, wstr);
+      batch.cased_strings.Append(converter.to_bytes(wstr));
     }
+    return Status::OK();
+  };
+
+  // Normalize batches of consecutive strings in parallel, then write the kept strings of each batch in order
+  auto* tp = ctx->GetOperatorThreadPool();
+  const size_t max_batches = tp != nullptr ? static_cast<size_t>(tp->NumThreads()) + 1 : 1;
+  const size_t num_batches = std::max<size_t>(1, std::min(max_batches, C / kMinStringsPerBatch));
+  const size_t batch_size = (C + num_batches - 1) / num_batches;
+  std::vector<std::unique_ptr<NormalizedBatch>> batches;
+  batches.reserve(num_batches);
+  for (size_t b = 0; b < num_batches; ++b) {
+    batches.push_back(onnxruntime::make_unique<NormalizedBatch>(allocator));
   }
-  return status;
+
+  concurrency::ThreadPool::TryBatchParallelFor(
+      tp, static_cast<int32_t>(num_batches),
+      [&](int32_t b) {
+        auto& batch = *batches[b];
+        Utf8Converter converter(conv_error, wconv_error);
+        std::string ascii_buffer;
+        const size_t end = std::min(C, (b + 1) * batch_size);
+        for (size_t i = b * batch_size; i < end && batch.status.IsOK(); ++i) {
+          batch.status = normalize(input_data[i], converter, ascii_buffer, batch);
+        }
+      },
+      static_cast<int32_t>(num_batches));
+
+  std::vector<size_t> output_offsets(num_batches + 1, 0);
+  for (size_t b = 0; b < num_batches; ++b) {
+    ORT_RETURN_IF_ERROR(batches[b]->status);
+    output_offsets[b + 1] = output_offsets[b] + batches[b]->kept_strings.size() + batches[b]->cased_strings.Size();
+  }
+
+  auto output_tensor = CreateOutput(ctx, N, output_offsets.back());
+  if (output_tensor == nullptr) {
+    return Status::OK();
+  }
+  auto const output_data = output_tensor->template MutableData<std::string>();
+  concurrency::ThreadPool::TryBatchParallelFor(
+      tp, static_cast<int32_t>(num_batches),
+      [&](int32_t b) {
+        const auto& batch = *batches[b];
+        auto* output = output_data + output_offsets[b];
+        for (const auto* kept : batch.kept_strings) {
+          *output++ = *kept;
+        }
+        for (size_t i = 0; i < batch.cased_strings.Size(); ++i) {
+          const auto cased = batch.cased_strings[i];
+          (output++)->assign(cased.data(), cased.size());
+        }
+      },
+      static_cast<int32_t>(num_batches));
+
+  return Status::OK();
 }
 }  // namespace onnxruntime
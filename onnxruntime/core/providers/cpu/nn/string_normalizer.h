@@ -32,6 +32,10 @@ class StringNormalizer : public OpKernel {
   // Either if these are populated but not both
   std::unordered_set<std::string> stopwords_;
   std::unordered_set<std::wstring> wstopwords_;
+  // wstopwords_ in utf8, to filter the ASCII strings without converting them
+  std::unordered_set<std::string> ascii_stopwords_;
+  // whether the case of the ASCII strings can be changed without converting them to wide strings
+  bool ascii_fast_path_ = false;
 };
 
 }  // namespace onnxruntime
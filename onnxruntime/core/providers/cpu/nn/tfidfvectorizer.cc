@@ -4,11 +4,11 @@
 #include "tfidfvectorizer.h"
 #include "onnx/defs/schema.h"
 #include "core/common/common.h"
+#include "core/common/flat_hash_table.h"
 #include "core/framework/tensor.h"
 #include "core/platform/threadpool.h"
 
 #include <functional>
-#include <unordered_map>
 
 namespace onnxruntime {
 
@@ -24,61 +24,55 @@ ONNX_CPU_OPERATOR_KERNEL(
 
 namespace ngram_details {
 
-// NgrampPart implements a Trie like structure
-// for a unigram (1) it would insert into a root map with a valid id.
-// for (1,2,3) node 2 would be a child of 1 but have id == 0
-// because (1,2) does not exists. Node 3 would have a valid id.
-template <class T>
-struct NgramPart;
+// The n-grams of the pool as a trie of numbered nodes, node 0 being the root. The items of the pool are mapped to
+// token ids, and the children of the nodes are found in a single flat hash table keyed by the node and the token of
+// the child. For (1,2,3) node 2 would be a child of 1 but have n-gram id 0 because (1,2) does not exist, while node 3
+// would have a valid id.
+struct NgramTrie {
+  FlatHashTable<uint64_t, uint32_t> children_;
+  std::vector<size_t> ngram_ids_{0};  // 0 - means no entry, search for a bigger N
 
-template <>
-struct NgramPart<int64_t>;
+  static uint64_t ChildKey(uint32_t node, uint32_t token) { return (uint64_t{node} << 32) | token; }
 
-template <>
-struct NgramPart<std::string>;
+  bool Empty() const { return ngram_ids_.size() == 1; }
 
-using NgramPartInt = NgramPart<int64_t>;
-using NgramPartString = NgramPart<std::string>;
-
-// Avoid recursive class definitions using unique_ptr + forward declaration
-using IntMap = std::unordered_map<int64_t, std::unique_ptr<NgramPartInt>>;
-
-using StrMap = std::unordered_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                  std::hash<std::string>, std::equal_to<std::string>>;
+  uint32_t AddChild(uint32_t node, uint32_t token) {
+    const auto next_node = static_cast<uint32_t>(ngram_ids_.size());
+    const auto child = *children_.Emplace(ChildKey(node, token), next_node).first;
+    if (child == next_node) {
+      ngram_ids_.push_back(0);
+    }
+    return child;
+  }
 
-template <>
-struct NgramPart<int64_t> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  IntMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
+  const uint32_t* FindChild(uint32_t node, uint32_t token) const {
+    return children_.Find(ChildKey(node, token));
+  }
 };
 
-template <>
-struct NgramPart<std::string> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  StrMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
+// Token ids of the items of the pool
+using IntTokens = FlatHashTable<int64_t, uint32_t>;
+// This table contains references to pool_string_ entries
+using StrTokens = FlatHashTable<std::reference_wrapper<const std::string>, uint32_t,
+                                std::hash<std::string>, std::equal_to<std::string>>;
+
+// Token id of the items of the input which aren't in the pool
+constexpr uint32_t kNoToken = UINT32_MAX;
 
 // Returns next ngram_id
-template <class K, class ForwardIter, class Map>
+template <class ForwardIter, class Tokens>
 inline size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id,
-                            Map& c) {
+                            Tokens& tokens, NgramTrie& trie) {
   for (; ngrams > 0; --ngrams) {
-    size_t n = 1;
-    Map* m = &c;
-    while (true) {
-      auto p = m->emplace(*first, onnxruntime::make_unique<NgramPart<K>>(0));
-      ++first;
-      if (n == ngram_size) {
-        ORT_ENFORCE(p.first->second->id_ == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
-        p.first->second->id_ = ngram_id;
-        ++ngram_id;
-        break;
-      }
-      ++n;
-      m = &p.first->second->leafs_;
+    uint32_t node = 0;
+    for (size_t n = 1; n <= ngram_size; ++n, ++first) {
+      const auto next_token = static_cast<uint32_t>(tokens.Size());
+      const auto token = *tokens.Emplace(*first, next_token).first;
+      node = trie.AddChild(node, token);
     }
+    ORT_ENFORCE(trie.ngram_ids_[node] == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
+    trie.ngram_ids_[node] = ngram_id;
+    ++ngram_id;
   }
   return ngram_id;
 }
@@ -90,10 +84,6 @@ using namespace onnxruntime::ngram_details;
 
 namespace onnxruntime {
 
-inline const void* AdvanceElementPtr(const void* p, size_t elements, size_t element_size) {
-  return reinterpret_cast<const uint8_t*>(p) + elements * element_size;
-}
-
 // The weighting criteria.
 // "TF"(term frequency),
 //    the counts are propagated to output
@@ -129,11 +119,10 @@ struct TfIdfVectorizer::Impl {
   std::vector<float> weights_;
 
   std::vector<std::string> pool_strings_;
-  // This map contains references to pool_string_ entries
-  // of pool_strings attribute
-  StrMap str_map_;
-  // This map contains pool_int64s entries
-  IntMap int64_map_;
+  // The tokens of the pool_strings or of the pool_int64s attribute
+  StrTokens str_tokens_;
+  IntTokens int64_tokens_;
+  NgramTrie trie_;
 
   size_t output_size_ = 0;
 
@@ -238,9 +227,11 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
         if (impl_->pool_strings_.empty()) {
-          ngram_id = PopulateGrams<int64_t>(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
+          ngram_id = PopulateGrams(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id,
+                                   impl_->int64_tokens_, impl_->trie_);
         } else {
-          ngram_id = PopulateGrams<std::string>(impl_->pool_strings_.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_map_);
+          ngram_id = PopulateGrams(impl_->pool_strings_.cbegin() + start_idx, ngrams, ngram_size, ngram_id,
+                                   impl_->str_tokens_, impl_->trie_);
         }
       } else {
         ngram_id += ngrams;
@@ -314,65 +305,63 @@ void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::ve
 void TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx, int32_t row_num, size_t row_size,
                                   std::vector<uint32_t>& frequencies) const {
   auto X = ctx->Input<Tensor>(0);
-  const auto elem_size = X->DataType()->Size();
-
-  const void* row_begin = AdvanceElementPtr(X->DataRaw(), row_num * row_size, elem_size);
-  const void* const row_end = AdvanceElementPtr(row_begin, row_size, elem_size);
+  const size_t row_offset = row_num * row_size;
 
   const auto& impl = *impl_;
+  const auto& trie = impl.trie_;
+
+  // Look up the token of every item of the row once, rather than once for every n-gram it is part of
+  std::vector<uint32_t> row_tokens(row_size);
+  if (X->IsDataTypeString()) {
+    const auto* items = X->template Data<std::string>() + row_offset;
+    for (size_t i = 0; i < row_size; ++i) {
+      const auto* token = impl.str_tokens_.Find(items[i]);
+      row_tokens[i] = token != nullptr ? *token : kNoToken;
+    }
+  } else if (X->IsDataType<int32_t>()) {
+    const auto* items = X->template Data<int32_t>() + row_offset;
+    for (size_t i = 0; i < row_size; ++i) {
+      const auto* token = impl.int64_tokens_.Find(int64_t{items[i]});
+      row_tokens[i] = token != nullptr ? *token : kNoToken;
+    }
+  } else {
+    const auto* items = X->template Data<int64_t>() + row_offset;
+    for (size_t i = 0; i < row_size; ++i) {
+      const auto* token = impl.int64_tokens_.Find(items[i]);
+      row_tokens[i] = token != nullptr ? *token : kNoToken;
+    }
+  }
+
   const auto max_gram_length = impl.max_gram_length_;
   const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
   auto start_ngram_size = impl.min_gram_length_;
 
   for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
-    auto ngram_start = row_begin;
-    auto const ngram_row_end = row_end;
-
-    while (ngram_start < ngram_row_end) {
+    for (size_t ngram_start = 0; ngram_start < row_size; ++ngram_start) {
       // We went far enough so no n-grams of any size can be gathered
-      auto at_least_this = AdvanceElementPtr(ngram_start, skip_distance * (start_ngram_size - 1), elem_size);
-      if (at_least_this >= ngram_row_end) {
+      if (ngram_start + skip_distance * (start_ngram_size - 1) >= row_size) {
         break;
       }
 
-      auto ngram_item = ngram_start;
-      if (X->IsDataTypeString()) {
-        const std::string* str_item = reinterpret_cast<const std::string*>(ngram_item);
-        const StrMap* str_map = &impl.str_map_;
-        for (auto ngram_size = 1;
-             !str_map->empty() &&
-             ngram_size <= max_gram_length &&
-             str_item < ngram_row_end;
-             ++ngram_size, str_item += skip_distance) {
-          auto hit = str_map->find(*str_item);
-          if (hit == str_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          str_map = &hit->second->leafs_;
+      uint32_t node = 0;
+      size_t ngram_item = ngram_start;
+      for (auto ngram_size = 1;
+           ngram_size <= max_gram_length &&
+           ngram_item < row_size;
+           ++ngram_size, ngram_item += skip_distance) {
+        const auto token = row_tokens[ngram_item];
+        if (token == kNoToken) {
+          break;
         }
-      } else {
-        const IntMap* int_map = &impl.int64_map_;
-        for (auto ngram_size = 1;
-             !int_map->empty() &&
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item = AdvanceElementPtr(ngram_item, skip_distance, elem_size)) {
-          int64_t val = (X->IsDataType<int32_t>()) ? int64_t{*reinterpret_cast<const int32_t*>(ngram_item)} : *reinterpret_cast<const int64_t*>(ngram_item);
-          auto hit = int_map->find(val);
-          if (hit == int_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          int_map = &hit->second->leafs_;
+        const auto* child = trie.FindChild(node, token);
+        if (child == nullptr) {
+          break;
+        }
+        node = *child;
+        if (ngram_size >= start_ngram_size && trie.ngram_ids_[node] != 0) {
+          impl.IncrementCount(trie.ngram_ids_[node], row_num, frequencies);
         }
       }
-      // Sliding window shift
-      ngram_start = AdvanceElementPtr(ngram_start, 1, elem_size);
     }
     // We count UniGrams only once since they are not affected
     // by skip distance
@@ -418,8 +407,8 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   frequencies.resize(num_rows * impl_->output_size_, 0);
 
   if (total_items == 0 ||
-      (X->IsDataTypeString() && impl_->str_map_.empty()) ||
-      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_map_.empty())) {
+      (X->IsDataTypeString() && impl_->str_tokens_.Empty()) ||
+      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_tokens_.Empty())) {
     // TfidfVectorizer may receive an empty input when it follows a Tokenizer
     // (for example for a string containing only stopwords).
     // TfidfVectorizer returns a zero tensor of shape
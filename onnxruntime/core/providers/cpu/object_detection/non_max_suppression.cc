@@ -13,7 +13,8 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 #include "non_max_suppression_helper.h"
-#include <queue>
+#include "core/platform/threadpool.h"
+#include <algorithm>
 
 namespace onnxruntime {
 
@@ -110,6 +111,101 @@ Status NonMaxSuppressionBase::GetThresholdsFromInputs(const PrepareContext& pc,
   return Status::OK();
 }
 
+namespace {
+struct ScoreIndexPair {
+  float score_;
+  int64_t index_;
+};
+
+// The corners and areas of a set of boxes, each in its own array, so the IoU of a box with all of them is computed by
+// a loop the compiler vectorizes.
+struct BoxCorners {
+  std::vector<float> x_min;
+  std::vector<float> y_min;
+  std::vector<float> x_max;
+  std::vector<float> y_max;
+  std::vector<float> area;
+
+  void Init(const float* boxes_data, int64_t num_boxes, int64_t center_point_box) {
+    const auto n = static_cast<size_t>(num_boxes);
+    x_min.resize(n);
+    y_min.resize(n);
+    x_max.resize(n);
+    y_max.resize(n);
+    area.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+      const float* box = boxes_data + 4 * i;
+      // center_point_box_ only support 0 or 1
+      if (0 == center_point_box) {
+        // boxes data format [y1, x1, y2, x2],
+        MaxMin(box[1], box[3], x_min[i], x_max[i]);
+        MaxMin(box[0], box[2], y_min[i], y_max[i]);
+      } else {
+        // 1 == center_point_box_ => boxes data format [x_center, y_center, width, height]
+        const float box_width_half = box[2] / 2;
+        const float box_height_half = box[3] / 2;
+        x_min[i] = box[0] - box_width_half;
+        x_max[i] = box[0] + box_width_half;
+        y_min[i] = box[1] - box_height_half;
+        y_max[i] = box[1] + box_height_half;
+      }
+      area[i] = (x_max[i] - x_min[i]) * (y_max[i] - y_min[i]);
+    }
+  }
+
+  void Clear() {
+    x_min.clear();
+    y_min.clear();
+    x_max.clear();
+    y_max.clear();
+    area.clear();
+  }
+
+  void Append(const BoxCorners& boxes, int64_t index) {
+    x_min.push_back(boxes.x_min[index]);
+    y_min.push_back(boxes.y_min[index]);
+    x_max.push_back(boxes.x_max[index]);
+    y_max.push_back(boxes.y_max[index]);
+    area.push_back(boxes.area[index]);
+  }
+
+  // Returns true if one of the boxes suppresses the box 'index' of 'boxes', with the same test as SuppressByIOU.
+  // The boxes are tested in blocks without branches, the first block with a suppressing box ends the search.
+  bool SuppressesBox(const BoxCorners& boxes, int64_t index, float iou_threshold) const {
+    constexpr size_t kBlockSize = 16;
+    const float box_x_min = boxes.x_min[index];
+    const float box_y_min = boxes.y_min[index];
+    const float box_x_max = boxes.x_max[index];
+    const float box_y_max = boxes.y_max[index];
+    const float box_area = boxes.area[index];
+
+    const size_t n = area.size();
+    for (size_t begin = 0; begin < n; begin += kBlockSize) {
+      const size_t end = std::min(begin + kBlockSize, n);
+      bool suppressed = false;
+      for (size_t i = begin; i < end; ++i) {
+        const float intersection_x_min = std::max(x_min[i], box_x_min);
+        const float intersection_y_min = std::max(y_min[i], box_y_min);
+        const float intersection_x_max = std::min(x_max[i], box_x_max);
+        const float intersection_y_max = std::min(y_max[i], box_y_max);
+        const float intersection_area = std::max(intersection_x_max - intersection_x_min, .0f) *
+                                        std::max(intersection_y_max - intersection_y_min, .0f);
+        const float union_area = area[i] + box_area - intersection_area;
+        suppressed |= (intersection_area > .0f) & (area[i] > .0f) & (box_area > .0f) & (union_area > .0f) &
+                      (intersection_area / union_area > iou_threshold);
+      }
+      if (suppressed) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+}  // namespace
+
+// Number of scores from which the (batch, class) pairs are split across the threads of the thread pool
+static constexpr int64_t kParallelNmsMinBoxes = 1 << 14;
+
 Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   PrepareContext pc;
   auto ret = PrepareCompute(ctx, pc);
@@ -129,69 +225,73 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
 
   const auto* const boxes_data = pc.boxes_data_;
   const auto* const scores_data = pc.scores_data_;
-
-  struct ScoreIndexPair {
-    float score_{};
-    int64_t index_{};
-
-    ScoreIndexPair() = default;
-    explicit ScoreIndexPair(float score, int64_t idx) : score_(score), index_(idx) {}
-
-    bool operator<(const ScoreIndexPair& rhs) const {
-      return score_ < rhs.score_;
-    }
-  };
-
   const auto center_point_box = GetCenterPointBox();
+  const int64_t num_boxes = pc.num_boxes_;
 
-  std::vector<SelectedIndex> selected_indices;
+  // the corners and areas of the boxes of each batch, shared by its classes
+  std::vector<BoxCorners> batch_corners(static_cast<size_t>(pc.num_batches_));
   for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      int64_t box_offset = batch_index * pc.num_boxes_ * 4;
-      // Filter by score_threshold_
-      std::priority_queue<ScoreIndexPair, std::deque<ScoreIndexPair>> sorted_scores_with_index;
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            sorted_scores_with_index.push(ScoreIndexPair(*class_scores, box_index));
-          }
+    batch_corners[batch_index].Init(boxes_data + batch_index * num_boxes * 4, num_boxes, center_point_box);
+  }
+
+  // each (batch, class) pair is selected independently, they are split in batches across the threads
+  const int64_t num_tasks = pc.num_batches_ * pc.num_classes_;
+  std::vector<std::vector<int64_t>> selected_boxes(static_cast<size_t>(num_tasks));
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const auto num_task_batches = static_cast<int32_t>(
+      tp == nullptr || num_tasks * num_boxes < kParallelNmsMinBoxes
+          ? 1
+          : std::min<int64_t>(num_tasks, tp->NumThreads() + 1));
+
+  auto compute_batch = [&](int32_t task_batch) {
+    std::vector<ScoreIndexPair> candidates;
+    BoxCorners selected;
+    for (int64_t task = num_tasks * task_batch / num_task_batches,
+                 end = num_tasks * (task_batch + 1) / num_task_batches;
+         task < end; ++task) {
+      const int64_t batch_index = task / pc.num_classes_;
+      const BoxCorners& corners = batch_corners[batch_index];
+
+      // Filter by score_threshold_, then sort the candidates once by descending score. Boxes with the same score are
+      // taken in order of their indices.
+      const auto* class_scores = scores_data + task * num_boxes;
+      candidates.clear();
+      for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+        if (pc.score_threshold_ == nullptr || class_scores[box_index] > score_threshold) {
+          candidates.push_back({class_scores[box_index], box_index});
         }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          sorted_scores_with_index.push(ScoreIndexPair(*class_scores, box_index));
+      }
+      std::stable_sort(candidates.begin(), candidates.end(),
+                       [](const ScoreIndexPair& lhs, const ScoreIndexPair& rhs) { return lhs.score_ > rhs.score_; });
+
+      // Take the boxes in order of their scores, filter by iou_threshold against the boxes already selected
+      auto& selected_indices_inside_class = selected_boxes[task];
+      selected.Clear();
+      for (const auto& candidate : candidates) {
+        if (max_output_boxes_per_class > 0 &&
+            static_cast<int64_t>(selected_indices_inside_class.size()) >= max_output_boxes_per_class) {
+          break;
+        }
+        if (!selected.SuppressesBox(corners, candidate.index_, iou_threshold)) {
+          selected.Append(corners, candidate.index_);
+          selected_indices_inside_class.push_back(candidate.index_);
         }
       }
+    }
+  };
 
-      ScoreIndexPair next_top_score;
-      std::vector<int64_t> selected_indices_inside_class;
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_scores_with_index.empty()) {
-        next_top_score = sorted_scores_with_index.top();
-        sorted_scores_with_index.pop();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (int64_t selected_index : selected_indices_inside_class) {
-          if (SuppressByIOU(boxes_data + box_offset, selected_index, next_top_score.index_,
-                            center_point_box, iou_threshold)) {
-            selected = false;
-            break;
-          }
-        }
+  if (num_task_batches == 1) {
+    compute_batch(0);
+  } else {
+    concurrency::ThreadPool::TryBatchParallelFor(tp, num_task_batches, compute_batch, num_task_batches);
+  }
 
-        if (selected) {
-          if (max_output_boxes_per_class > 0 &&
-              static_cast<int64_t>(selected_indices_inside_class.size()) >= max_output_boxes_per_class) {
-            break;
-          }
-          selected_indices_inside_class.push_back(next_top_score.index_);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-      }  //while
-    }    //for class_index
-  }      //for batch_index
+  std::vector<SelectedIndex> selected_indices;
+  for (int64_t task = 0; task < num_tasks; ++task) {
+    for (int64_t box_index : selected_boxes[task]) {
+      selected_indices.emplace_back(task / pc.num_classes_, task % pc.num_classes_, box_index);
+    }
+  }
 
   const auto last_dim = 3;
   const auto num_selected = selected_indices.size();
@@ -5,6 +5,7 @@
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/cpu/containers.h"
+#include "core/mlas/inc/mlas.h"
 using namespace std;
 namespace onnxruntime {
 
@@ -321,6 +322,120 @@ bool PrepareForReduce(OpKernelContext* ctx,
   return false;
 }
 
+// When the reduced axes are adjacent, the input can be viewed as [outer_count, reduce_count, inner_count] and
+// reduced by MLAS directly from the input instead of from the transposed copy made by PrepareForReduce.
+// return value: true means the output tensor is allocated and the input can be reduced by MLAS. false means the
+//               output is not allocated and PrepareForReduce should be used instead.
+static bool PrepareForMlasReduce(OpKernelContext* ctx,
+                                 Tensor** reducedTensor,
+                                 size_t& outer_count,
+                                 size_t& reduce_count,
+                                 size_t& inner_count,
+                                 const std::vector<int64_t>& axes_,
+                                 bool keepdims_) {
+  const auto* input_tensor_ptr = ctx->Input<Tensor>(0);
+  ORT_ENFORCE(input_tensor_ptr != nullptr);
+  const TensorShape& input_shape = input_tensor_ptr->Shape();
+
+  // scalars and empty tensors are left to PrepareForReduce.
+  size_t ndim = input_shape.NumDimensions();
+  if (ndim == 0 || input_shape.Size() == 0) {
+    return false;
+  }
+
+  std::vector<int64_t> axes;
+  axes.reserve(axes_.size());
+  for (int64_t axis : axes_) {
+    axes.push_back(HandleNegativeAxis(axis, static_cast<int64_t>(ndim)));
+  }
+
+  if (axes.empty()) {
+    for (size_t i = 0; i < ndim; i++) {
+      axes.push_back(i);
+    }
+  }
+
+  std::sort(axes.begin(), axes.end());
+
+  for (size_t i = 1; i < axes.size(); i++) {
+    if (axes[i] != axes[0] + static_cast<int64_t>(i)) {
+      return false;
+    }
+  }
+
+  const auto first_axis = static_cast<size_t>(axes.front());
+  const auto last_axis = static_cast<size_t>(axes.back());
+
+  outer_count = static_cast<size_t>(input_shape.SizeToDimension(first_axis));
+  reduce_count = static_cast<size_t>(input_shape.Slice(first_axis, last_axis + 1).Size());
+  inner_count = static_cast<size_t>(input_shape.SizeFromDimension(last_axis + 1));
+
+  std::vector<int64_t> reduced_dims;
+  reduced_dims.reserve(ndim);
+  for (size_t i = 0; i < ndim; i++) {
+    if (i < first_axis || i > last_axis) {
+      reduced_dims.push_back(input_shape[i]);
+    } else if (keepdims_) {
+      reduced_dims.push_back(1);
+    }
+  }
+
+  *reducedTensor = ctx->Output(0, std::move(reduced_dims));
+  return true;
+}
+
+template <typename T>
+bool TryMlasReduce(OpKernelContext* /*ctx*/,
+                   MLAS_REDUCTION_KIND /*kind*/,
+                   const std::vector<int64_t>& /*axes_*/,
+                   bool /*keepdims_*/) {
+  return false;
+}
+
+template <>
+bool TryMlasReduce<float>(OpKernelContext* ctx,
+                          MLAS_REDUCTION_KIND kind,
+                          const std::vector<int64_t>& axes_,
+                          bool keepdims_) {
+  Tensor* reduced;
+  size_t outer_count;
+  size_t reduce_count;
+  size_t inner_count;
+  if (!PrepareForMlasReduce(ctx, &reduced, outer_count, reduce_count, inner_count, axes_, keepdims_)) {
+    return false;
+  }
+
+  MlasReduce(kind, ctx->Input<Tensor>(0)->Data<float>(), reduced->MutableData<float>(),
+             outer_count, reduce_count, inner_count, ctx->GetOperatorThreadPool());
+  return true;
+}
+
+template <typename T>
+bool TryMlasArgReduce(OpKernelContext* /*ctx*/,
+                      MLAS_ARG_REDUCTION_KIND /*kind*/,
+                      const std::vector<int64_t>& /*axes_*/,
+                      bool /*keepdims_*/) {
+  return false;
+}
+
+template <>
+bool TryMlasArgReduce<float>(OpKernelContext* ctx,
+                             MLAS_ARG_REDUCTION_KIND kind,
+                             const std::vector<int64_t>& axes_,
+                             bool keepdims_) {
+  Tensor* reduced;
+  size_t outer_count;
+  size_t reduce_count;
+  size_t inner_count;
+  if (!PrepareForMlasReduce(ctx, &reduced, outer_count, reduce_count, inner_count, axes_, keepdims_)) {
+    return false;
+  }
+
+  MlasArgReduce(kind, ctx->Input<Tensor>(0)->Data<float>(), reduced->MutableData<int64_t>(),
+                outer_count, reduce_count, inner_count, ctx->GetOperatorThreadPool());
+  return true;
+}
+
 template <typename T>
 Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
   FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
@@ -427,6 +542,10 @@ Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
 
 template <typename T>
 Status ReduceMax<T>::Compute(OpKernelContext* ctx) const {
+  if (TryMlasReduce<T>(ctx, MlasMaximumReduction, axes_, keepdims_)) {
+    return Status::OK();
+  }
+
   FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
   int64_t block_size;
   int64_t blocks;
@@ -451,6 +570,10 @@ Status ReduceMax<T>::Compute(OpKernelContext* ctx) const {
 
 template <typename T>
 Status ReduceMean<T>::Compute(OpKernelContext* ctx) const {
+  if (TryMlasReduce<T>(ctx, MlasMeanReduction, axes_, keepdims_)) {
+    return Status::OK();
+  }
+
   FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
   int64_t block_size;
   int64_t blocks;
@@ -478,6 +601,10 @@ Status ReduceMean<T>::Compute(OpKernelContext* ctx) const {
 
 template <typename T>
 Status ReduceMin<T>::Compute(OpKernelContext* ctx) const {
+  if (TryMlasReduce<T>(ctx, MlasMinimumReduction, axes_, keepdims_)) {
+    return Status::OK();
+  }
+
   FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
   int64_t block_size;
   int64_t blocks;
@@ -527,6 +654,10 @@ Status ReduceProd<T>::Compute(OpKernelContext* ctx) const {
 
 template <typename T>
 Status ReduceSum<T>::Compute(OpKernelContext* ctx) const {
+  if (TryMlasReduce<T>(ctx, MlasSumReduction, axes_, keepdims_)) {
+    return Status::OK();
+  }
+
   FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
   int64_t block_size;
   int64_t blocks;
@@ -554,6 +685,10 @@ Status ReduceSum<T>::Compute(OpKernelContext* ctx) const {
 
 template <typename T>
 Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
+  if (TryMlasReduce<T>(ctx, MlasSumSquareReduction, axes_, keepdims_)) {
+    return Status::OK();
+  }
+
   FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
   int64_t block_size;
   int64_t blocks;
@@ -579,6 +714,10 @@ Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
 
 template <typename T>
 Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
+  if (TryMlasArgReduce<T>(ctx, MlasArgMaximumReduction, axes_, keepdims_)) {
+    return Status::OK();
+  }
+
   FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
   int64_t block_size;
   int64_t blocks;
@@ -599,6 +738,10 @@ Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
 
 template <typename T>
 Status ArgMin<T>::Compute(OpKernelContext* ctx) const {
+  if (TryMlasArgReduce<T>(ctx, MlasArgMinimumReduction, axes_, keepdims_)) {
+    return Status::OK();
+  }
+
   FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
   int64_t block_size;
   int64_t blocks;
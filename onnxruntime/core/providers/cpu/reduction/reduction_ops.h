@@ -6,6 +6,7 @@
 
 #include "core/common/common.h"
 #include "core/common/optional.h"
+#include "core/framework/kernel_cost.h"
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
@@ -35,6 +36,14 @@ class ReduceKernelBase {
 
 template <bool allow_multi_axes>
 class ReduceKernel : public OpKernel, public ReduceKernelBase<allow_multi_axes> {
+ public:
+  // one operation per element of the input
+  bool GetCost(OpKernelContext& context, KernelCost& cost) const override {
+    cost.flops = context.Input<Tensor>(0)->Shape().Size();
+    cost.bytes = kernel_cost::TensorBytes(context);
+    return true;
+  }
+
  protected:
   ReduceKernel(const OpKernelInfo& info) : OpKernel(info), ReduceKernelBase<allow_multi_axes>(info) {}
 };
@@ -172,8 +172,12 @@ class UniDirectionalGru {
                     const ActivationFuncs::Entry& activation_func_g, float clip,
                     onnxruntime::concurrency::ThreadPool* ttp);
 
+  // the packed weights are the ones packed by PackWeightsPerDirection, or nullptr to compute with input_weights and
+  // recurrent_weights.
   void Compute(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths, int num_directions,
                const gsl::span<const T>& input_weights, const gsl::span<const T>& recurrent_weights,
+               const void* packed_input_weights, const void* packed_recurrent_weightsZR,
+               const void* packed_recurrent_weightsH,
                gsl::span<T>& outputs, gsl::span<T>& final_hidden_state);
 
   ~UniDirectionalGru() = default;
@@ -248,6 +252,45 @@ class UniDirectionalGru {
 #define DumpMatrix(...) ((void)0)
 #endif
 
+Status DeepCpuGruOp::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                             bool& is_packed, PrePackedWeights& prepacked_weights) {
+  is_packed = false;
+
+  // W and R have shape [num_directions, 3*hidden_size, input_size or hidden_size]. leave any other shape to
+  // ValidateCommonRnnInputs to report.
+  const auto& shape = tensor.Shape();
+  if ((input_idx != 1 && input_idx != 2) ||
+      shape.NumDimensions() != 3 || shape[0] != num_directions_ || shape[1] != 3 * hidden_size_) {
+    return Status::OK();
+  }
+
+  if (input_idx == 1) {
+    is_packed = PackWeightsPerDirection(alloc, tensor, 0, 3 * hidden_size_, prepacked_weights);
+  } else {
+    // the R[zr] buffers of all the directions, followed by the R[h] ones
+    is_packed = PackWeightsPerDirection(alloc, tensor, 0, 2 * hidden_size_, prepacked_weights) &&
+                PackWeightsPerDirection(alloc, tensor, 2 * hidden_size_, hidden_size_, prepacked_weights);
+  }
+  return Status::OK();
+}
+
+Status DeepCpuGruOp::UseSharedPrePackedBuffers(const PrePackedWeights& prepacked_weights, int input_idx) {
+  const auto& buffers = prepacked_weights.buffers_;
+  if (input_idx == 1) {
+    packed_W_.clear();
+    for (const auto& buffer : buffers) {
+      packed_W_.push_back(buffer.get());
+    }
+  } else {
+    packed_R_zr_.clear();
+    packed_R_h_.clear();
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      (i < buffers.size() / 2 ? packed_R_zr_ : packed_R_h_).push_back(buffers[i].get());
+    }
+  }
+  return Status::OK();
+}
+
 Status DeepCpuGruOp::Compute(OpKernelContext* context) const {
   const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
 
@@ -350,6 +393,11 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
 
   gsl::span<T> hidden_output_1 = hidden_output.subspan(0, hidden_output_size_per_direction);
 
+  // the packed weights of a direction, or nullptr if PrePack didn't pack them
+  auto packed_weights = [](const std::vector<const void*>& packed, size_t direction) -> const void* {
+    return direction < packed.size() ? packed[direction] : nullptr;
+  };
+
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
     gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
@@ -375,6 +423,7 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
                                     activation_funcs_.Entries()[1],
                                     clip_, thread_pool);
     fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+               packed_weights(packed_W_, 0), packed_weights(packed_R_zr_, 0), packed_weights(packed_R_h_, 0),
                output_1, hidden_output_1);
 
     detail::UniDirectionalGru<T> bw(alloc, seq_length, batch_size, input_size, hidden_size_,
@@ -383,6 +432,7 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
                                     activation_funcs_.Entries()[3],
                                     clip_, thread_pool);
     bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2,
+               packed_weights(packed_W_, 1), packed_weights(packed_R_zr_, 1), packed_weights(packed_R_h_, 1),
                output_2, hidden_output_2);
   } else {
     detail::UniDirectionalGru<T> gru_p(alloc, seq_length, batch_size, input_size, hidden_size_,
@@ -391,6 +441,7 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
                                        activation_funcs_.Entries()[1],
                                        clip_, thread_pool);
     gru_p.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+                  packed_weights(packed_W_, 0), packed_weights(packed_R_zr_, 0), packed_weights(packed_R_h_, 0),
                   output_1, hidden_output_1);
   }
 
@@ -492,6 +543,9 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
                                    const int num_directions,
                                    const gsl::span<const T>& input_weights,
                                    const gsl::span<const T>& recurrent_weights,
+                                   const void* packed_input_weights,
+                                   const void* packed_recurrent_weightsZR,
+                                   const void* packed_recurrent_weightsH,
                                    gsl::span<T>& outputs,
                                    gsl::span<T>& final_hidden_state) {
   using span_T_const_iter = typename gsl::span<T>::const_iterator;
@@ -541,13 +595,23 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   float beta = 0.0f;  // zero out outputZRH_ when calling ComputeGemm.
 
   // apply weights to all the inputs
-  ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
-              inputs.cbegin(), inputs.cend(),
-              input_size_,
-              input_weights.cbegin(), input_weights.cend(),
-              input_size_, beta,
-              outputZRH_.begin(), outputZRH_.end(),
-              hidden_size_x3, ttp_);
+  if (packed_input_weights != nullptr) {
+    ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
+                inputs.cbegin(), inputs.cend(),
+                input_size_,
+                packed_input_weights,
+                beta,
+                outputZRH_.begin(), outputZRH_.end(),
+                hidden_size_x3, ttp_);
+  } else {
+    ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
+                inputs.cbegin(), inputs.cend(),
+                input_size_,
+                input_weights.cbegin(), input_weights.cend(),
+                input_size_, beta,
+                outputZRH_.begin(), outputZRH_.end(),
+                hidden_size_x3, ttp_);
+  }
 
   DumpMatrix("inputs with weights applied", outputZRH_.data(), seq_length_ * batch_size_ * 3, hidden_size_);
 
@@ -607,13 +671,23 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
 
     // calculate Ht-1*R[zr], and add to the weighted inputs that are in outputZRH_
     // Ht-1 * R[zr] + Xt*(W[zr]^T)
-    ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
-                prev_Ht, prev_Ht_end,
-                hidden_size_,
-                recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
-                hidden_size_, beta,
-                outputZRH_.begin() + out_added_offset, outputZRH_.end(),
-                hidden_size_x3, ttp_);
+    if (packed_recurrent_weightsZR != nullptr) {
+      ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
+                  prev_Ht, prev_Ht_end,
+                  hidden_size_,
+                  packed_recurrent_weightsZR,
+                  beta,
+                  outputZRH_.begin() + out_added_offset, outputZRH_.end(),
+                  hidden_size_x3, ttp_);
+    } else {
+      ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
+                  prev_Ht, prev_Ht_end,
+                  hidden_size_,
+                  recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
+                  hidden_size_, beta,
+                  outputZRH_.begin() + out_added_offset, outputZRH_.end(),
+                  hidden_size_x3, ttp_);
+    }
 
     DumpMatrix("Ht-1 * R[zr] + Xt*(W[zr]^T)" + seqno_str,
                outputZRH_.data() + out_added_offset, batch_size_, hidden_size_x2, 0, hidden_size_x3);
@@ -623,13 +697,23 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
       gsl::copy(batched_bias_Rh_.subspan(batched_bias_Rh_local - batched_bias_Rh_.begin(), batched_bias_Rh_local_end - batched_bias_Rh_local), linear_output_);
 
       // compute Ht-1 * (Rh^T) + Rbh
-      ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
-                  prev_Ht, prev_Ht_end,  // Ht-1
-                  hidden_size_,
-                  recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                  hidden_size_, beta,
-                  linear_output_.begin(), linear_output_.end(),  // pre: Rbh, post:output
-                  hidden_size_, ttp_);
+      if (packed_recurrent_weightsH != nullptr) {
+        ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
+                    prev_Ht, prev_Ht_end,  // Ht-1
+                    hidden_size_,
+                    packed_recurrent_weightsH,  // Rh^T
+                    beta,
+                    linear_output_.begin(), linear_output_.end(),  // pre: Rbh, post:output
+                    hidden_size_, ttp_);
+      } else {
+        ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
+                    prev_Ht, prev_Ht_end,  // Ht-1
+                    hidden_size_,
+                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
+                    hidden_size_, beta,
+                    linear_output_.begin(), linear_output_.end(),  // pre: Rbh, post:output
+                    hidden_size_, ttp_);
+      }
 
       DumpMatrix("Ht-1 * (Rh^T) + Rbh " + seqno_str, linear_output_.data(), batch_size_, hidden_size_);
     }
@@ -694,13 +778,23 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
       auto out_H = outputZRH_.begin() + out_added_offset + hidden_size_x2;
 
       // Calculate Xt*(Wh^T) + rt (.) Ht-1 * Rh
-      ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
-                  cur_h_local, cur_h_local_end,  // rt (.) Ht-1
-                  hidden_size_,
-                  recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                  hidden_size_, beta,
-                  out_H, outputZRH_.end(),
-                  hidden_size_x3, ttp_);
+      if (packed_recurrent_weightsH != nullptr) {
+        ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
+                    cur_h_local, cur_h_local_end,  // rt (.) Ht-1
+                    hidden_size_,
+                    packed_recurrent_weightsH,  // Rh^T
+                    beta,
+                    out_H, outputZRH_.end(),
+                    hidden_size_x3, ttp_);
+      } else {
+        ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
+                    cur_h_local, cur_h_local_end,  // rt (.) Ht-1
+                    hidden_size_,
+                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
+                    hidden_size_, beta,
+                    out_H, outputZRH_.end(),
+                    hidden_size_x3, ttp_);
+      }
     }
 
     DumpMatrix("Xt*(Wh^T) + (" + label + ")" + seqno_str, outputZRH_.data() + out_added_offset,
@@ -54,6 +54,12 @@ class DeepCpuGruOp final : public OpKernel {
 
   Status Compute(OpKernelContext* context) const override;
 
+  // packs the W and R weights of each direction once, so the GEMMs run on every step don't pack them again
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights& prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(const PrePackedWeights& prepacked_weights, int input_idx) override;
+
   ~DeepCpuGruOp() override = default;
 
  private:
@@ -66,6 +72,12 @@ class DeepCpuGruOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
+  // W, R[zr] and R[h] packed by PrePack, one buffer per direction. empty if they are not constant initializers.
+  // R[zr] and R[h] are packed separately as Ht-1 is multiplied by R[zr] before the reset gate and by R[h] after it.
+  std::vector<const void*> packed_W_;
+  std::vector<const void*> packed_R_zr_;
+  std::vector<const void*> packed_R_h_;
+
   template <typename T>
   Status ComputeImpl(OpKernelContext& context) const;
 };
@@ -199,8 +199,13 @@ class UniDirectionalLstm {
                      concurrency::ThreadPool& lstm_tp_,
                      concurrency::ThreadPool* mlas_tp_);
 
+  // packed_input_weights and packed_recurrent_weights are the weights packed by PackWeightsPerDirection, or nullptr
+  // to compute with input_weights and recurrent_weights. If the quantized weights of DynamicQuantizeLSTM are set, the
+  // GEMMs use them instead.
   void Compute(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths, int num_directions,
                const gsl::span<const T>& input_weights, const gsl::span<const T>& recurrent_weights,
+               const void* packed_input_weights, const void* packed_recurrent_weights,
+               const QuantizedWeights& quantized_input_weights, const QuantizedWeights& quantized_recurrent_weights,
                gsl::span<T>& outputs, gsl::span<T>& final_hidden_state, gsl::span<T>& final_cell_state);
 
   ~UniDirectionalLstm() = default;
@@ -273,6 +278,12 @@ class UniDirectionalLstm {
   IAllocatorUniquePtr<int> sequence_lengths_ptr_;
   gsl::span<int> sequence_lengths_;
 
+  // scratch of the quantized GEMMs, large enough for the rows of all the steps
+  IAllocatorUniquePtr<uint8_t> quantized_gemm_input_ptr_;
+  IAllocatorUniquePtr<int32_t> quantized_gemm_output_ptr_;
+  gsl::span<uint8_t> quantized_gemm_input_;
+  gsl::span<int32_t> quantized_gemm_output_;
+
   deepcpu::ClipWithBiasFuncPtr clip_with_bias_ptr_;
 
   ActivationInfo<deepcpu::ActivationFuncPtr> activation_f_;
@@ -285,6 +296,29 @@ class UniDirectionalLstm {
 
 }  // namespace detail
 
+Status DeepCpuLstmOp::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                              bool& is_packed, PrePackedWeights& prepacked_weights) {
+  // W and R have shape [num_directions, 4*hidden_size, input_size or hidden_size]. leave any other shape to
+  // ValidateInputs to report.
+  // the uint8 weights of DynamicQuantizeLSTM are used as they are
+  is_packed = !quantized_ &&
+              (input_idx == 1 || input_idx == 2) &&
+              tensor.Shape().NumDimensions() == 3 &&
+              tensor.Shape()[0] == num_directions_ &&
+              tensor.Shape()[1] == 4 * hidden_size_ &&
+              PackWeightsPerDirection(alloc, tensor, 0, 4 * hidden_size_, prepacked_weights);
+  return Status::OK();
+}
+
+Status DeepCpuLstmOp::UseSharedPrePackedBuffers(const PrePackedWeights& prepacked_weights, int input_idx) {
+  std::vector<const void*>& packed = input_idx == 1 ? packed_W_ : packed_R_;
+  packed.clear();
+  for (const auto& buffer : prepacked_weights.buffers_) {
+    packed.push_back(buffer.get());
+  }
+  return Status::OK();
+}
+
 Status
 DeepCpuLstmOp::Compute(OpKernelContext* context) const {
   const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
@@ -337,6 +371,33 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   Status status = ValidateInputs(X, W, R, B, sequence_lens, initial_h, initial_c, P, batch_size);
   ORT_RETURN_IF_ERROR(status);
 
+  // the uint8 weights of DynamicQuantizeLSTM, per direction
+  QuantizedWeights quantized_W[2];
+  QuantizedWeights quantized_R[2];
+  if (quantized_) {
+    const Tensor& W_scale = *context.Input<Tensor>(8);       // [num_directions] or [num_directions, 4*hidden_size]
+    const Tensor* W_zero_point = context.Input<Tensor>(9);   // [num_directions]
+    const Tensor& R_scale = *context.Input<Tensor>(10);      // [num_directions] or [num_directions, 4*hidden_size]
+    const Tensor* R_zero_point = context.Input<Tensor>(11);  // [num_directions]
+    ORT_RETURN_IF_ERROR(ValidateQuantizedWeights(W_scale, R_scale, W_zero_point, R_zero_point));
+
+    auto quantized_weights = [](const Tensor& weights, const Tensor& scale, const Tensor* zero_point,
+                                int64_t direction) {
+      const auto& shape = weights.Shape();
+      QuantizedWeights quantized;
+      quantized.weights = weights.Data<uint8_t>() + direction * shape[1] * shape[2];
+      quantized.per_channel = scale.Shape().NumDimensions() == 2;
+      quantized.scales = scale.Data<float>() + direction * (quantized.per_channel ? shape[2] : 1);
+      quantized.zero_point = zero_point != nullptr ? zero_point->Data<uint8_t>()[direction] : 0;
+      return quantized;
+    };
+
+    for (int direction = 0; direction < num_directions_; ++direction) {
+      quantized_W[direction] = quantized_weights(W, W_scale, W_zero_point, direction);
+      quantized_R[direction] = quantized_weights(R, R_scale, R_zero_point, direction);
+    }
+  }
+
   // LSTM outputs are optional but must be in the same order
   TensorShape Y_dims{seq_length, num_directions_, batch_size, hidden_size_};
   Tensor* Y = context.Output(/*index*/ 0, Y_dims);
@@ -362,8 +423,8 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
 
-  gsl::span<const T> input_weights = W.DataAsSpan<T>();
-  gsl::span<const T> recurrent_weights = R.DataAsSpan<T>();
+  gsl::span<const T> input_weights = quantized_ ? gsl::span<const T>() : W.DataAsSpan<T>();
+  gsl::span<const T> recurrent_weights = quantized_ ? gsl::span<const T>() : R.DataAsSpan<T>();
   gsl::span<const T> bias = B != nullptr ? B->DataAsSpan<T>() : gsl::span<const T>();
   gsl::span<const T> peephole_weights = P != nullptr ? P->DataAsSpan<T>() : gsl::span<const T>();
 
@@ -373,8 +434,10 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   const size_t bias_size_per_direction = 8 * hidden_size_;
   const size_t peephole_weights_size_per_direction = 3 * hidden_size_;
 
-  gsl::span<const T> input_weights_1 = input_weights.subspan(0, input_weights_size_per_direction);
-  gsl::span<const T> recurrent_weights_1 = recurrent_weights.subspan(0, hidden_weights_size_per_direction);
+  gsl::span<const T> input_weights_1 =
+      input_weights.empty() ? input_weights : input_weights.subspan(0, input_weights_size_per_direction);
+  gsl::span<const T> recurrent_weights_1 =
+      recurrent_weights.empty() ? recurrent_weights : recurrent_weights.subspan(0, hidden_weights_size_per_direction);
   gsl::span<const T> bias_1 = bias.empty() ? bias : bias.subspan(0, bias_size_per_direction);
   gsl::span<const T> peephole_weights_1 =
       peephole_weights.empty() ? peephole_weights
@@ -424,12 +487,21 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
 
   gsl::span<T> last_cell_1 = last_cell.subspan(0, last_cell_size_per_direction);
 
+  // the packed weights of a direction, or nullptr if PrePack didn't pack them
+  auto packed_weights = [](const std::vector<const void*>& packed, size_t direction) -> const void* {
+    return direction < packed.size() ? packed[direction] : nullptr;
+  };
+
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
-    gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
-                                                               input_weights_size_per_direction);
-    gsl::span<const T> hidden_weights_2 = recurrent_weights.subspan(hidden_weights_size_per_direction,
-                                                                    hidden_weights_size_per_direction);
+    gsl::span<const T> input_weights_2 =
+        input_weights.empty() ? input_weights
+                              : input_weights.subspan(input_weights_size_per_direction,
+                                                      input_weights_size_per_direction);
+    gsl::span<const T> hidden_weights_2 =
+        recurrent_weights.empty() ? recurrent_weights
+                                  : recurrent_weights.subspan(hidden_weights_size_per_direction,
+                                                              hidden_weights_size_per_direction);
     gsl::span<const T> bias_2 = bias.empty() ? bias : bias.subspan(bias_size_per_direction, bias_size_per_direction);
     gsl::span<const T> peephole_weights_2 =
         peephole_weights.empty() ? peephole_weights
@@ -469,8 +541,10 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                      clip_, lstm_tp_, mlas_thread_pool);
 
     fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+               packed_weights(packed_W_, 0), packed_weights(packed_R_, 0), quantized_W[0], quantized_R[0],
                output_1, hidden_output_1, last_cell_1);
     bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2,
+               packed_weights(packed_W_, 1), packed_weights(packed_R_, 1), quantized_W[1], quantized_R[1],
                output_2, hidden_output_2, last_cell_2);
   } else {
     detail::UniDirectionalLstm<T> fw(alloc, logger, seq_length, batch_size, input_size,
@@ -482,6 +556,7 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                      clip_, lstm_tp_, mlas_thread_pool);
 
     fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+               packed_weights(packed_W_, 0), packed_weights(packed_R_, 0), quantized_W[0], quantized_R[0],
                output_1, hidden_output_1, last_cell_1);
   }
 
@@ -499,7 +574,7 @@ Status DeepCpuLstmOp::ValidateInputs(const Tensor& X, const Tensor& W, const Ten
                                      const Tensor* sequence_lens, const Tensor* initial_h, const Tensor* initial_c,
                                      const Tensor* P, int batch_size) const {
   auto status = rnn::detail::ValidateCommonRnnInputs(X, W, R, B, 4, sequence_lens, initial_h,
-                                                     num_directions_, hidden_size_);
+                                                     num_directions_, hidden_size_, /*weights_transposed*/ quantized_);
   ORT_RETURN_IF_ERROR(status);
 
   if (initial_c != nullptr) {
@@ -528,6 +603,29 @@ Status DeepCpuLstmOp::ValidateInputs(const Tensor& X, const Tensor& W, const Ten
   return Status::OK();
 }
 
+Status DeepCpuLstmOp::ValidateQuantizedWeights(const Tensor& W_scale, const Tensor& R_scale,
+                                               const Tensor* W_zero_point, const Tensor* R_zero_point) const {
+  for (const Tensor* scale : {&W_scale, &R_scale}) {
+    auto& scale_shape = scale->Shape();
+    const bool per_direction = scale_shape.NumDimensions() == 1 && scale_shape[0] == num_directions_;
+    const bool per_channel = scale_shape.NumDimensions() == 2 && scale_shape[0] == num_directions_ &&
+                             scale_shape[1] == 4 * hidden_size_;
+    if (!per_direction && !per_channel)
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Inputs W_scale and R_scale must have shape {",
+                             num_directions_, "} or {", num_directions_, ",", 4 * hidden_size_, "}. Actual:",
+                             scale_shape);
+  }
+
+  for (const Tensor* zero_point : {W_zero_point, R_zero_point}) {
+    if (zero_point != nullptr &&
+        (zero_point->Shape().NumDimensions() != 1 || zero_point->Shape()[0] != num_directions_))
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Inputs W_zero_point and R_zero_point must have shape {",
+                             num_directions_, "}. Actual:", zero_point->Shape());
+  }
+
+  return Status::OK();
+}
+
 /*************************************
 *
 * Implementation of UniDirectionalLstm
@@ -720,6 +818,10 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
                                     const int num_directions,
                                     const gsl::span<const T>& input_weights,
                                     const gsl::span<const T>& recurrent_weights,
+                                    const void* packed_input_weights,
+                                    const void* packed_recurrent_weights,
+                                    const QuantizedWeights& quantized_input_weights,
+                                    const QuantizedWeights& quantized_recurrent_weights,
                                     gsl::span<T>& outputs,
                                     gsl::span<T>& final_hidden_state,
                                     gsl::span<T>& final_cell_state) {
@@ -775,14 +877,38 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
   const int hidden_size_x4 = 4 * hidden_size_;
   const int total_rows = max_sequence_length * batch_size_;
 
+  if (quantized_input_weights.weights != nullptr) {
+    quantized_gemm_input_ = Allocate(allocator_, total_rows * std::max(input_size_, hidden_size_),
+                                     quantized_gemm_input_ptr_);
+    quantized_gemm_output_ = Allocate(allocator_, total_rows * hidden_size_x4, quantized_gemm_output_ptr_);
+  }
+
   // apply the weights to all the inputs and save to output_IOFC
-  ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha,
-              inputs.cbegin(), inputs.cend(),
-              input_size_,
-              input_weights.cbegin(), input_weights.cend(),  // W[iofc]
-              input_size_, beta,
-              output_iofc_.begin(), output_iofc_.end(),
-              hidden_size_x4, mlas_tp_);
+  if (quantized_input_weights.weights != nullptr) {
+    ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha,
+                inputs.cbegin(), inputs.cend(),
+                input_size_,
+                quantized_input_weights,  // W[iofc]
+                beta,
+                output_iofc_.begin(), output_iofc_.end(),
+                hidden_size_x4, quantized_gemm_input_, quantized_gemm_output_, mlas_tp_);
+  } else if (packed_input_weights != nullptr) {
+    ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha,
+                inputs.cbegin(), inputs.cend(),
+                input_size_,
+                packed_input_weights,  // W[iofc]
+                beta,
+                output_iofc_.begin(), output_iofc_.end(),
+                hidden_size_x4, mlas_tp_);
+  } else {
+    ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha,
+                inputs.cbegin(), inputs.cend(),
+                input_size_,
+                input_weights.cbegin(), input_weights.cend(),  // W[iofc]
+                input_size_, beta,
+                output_iofc_.begin(), output_iofc_.end(),
+                hidden_size_x4, mlas_tp_);
+  }
 
   DumpMatrix("Xt*(W[iofc]^T)", output_iofc_.data(), total_rows, hidden_size_x4);
 
@@ -826,13 +952,34 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
         span_T_iter step_out_IOFC = output_iofc_.begin() + (step * batch_size_ + row) * hidden_size_x4;
 
         // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
-        ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
-                    previous_state, previous_state_end,  // Ht-1
-                    hidden_size_,
-                    recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
-                    hidden_size_, beta,
-                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                    hidden_size_x4, mlas_tp_);
+        if (quantized_recurrent_weights.weights != nullptr) {
+          // the rows of each task use their own part of the scratch
+          ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
+                      previous_state, previous_state_end,  // Ht-1
+                      hidden_size_,
+                      quantized_recurrent_weights,  // R[iofc]
+                      beta,
+                      step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                      hidden_size_x4,
+                      quantized_gemm_input_.subspan(row * hidden_size_),
+                      quantized_gemm_output_.subspan(row * hidden_size_x4), mlas_tp_);
+        } else if (packed_recurrent_weights != nullptr) {
+          ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
+                      previous_state, previous_state_end,  // Ht-1
+                      hidden_size_,
+                      packed_recurrent_weights,  // R[iofc]
+                      beta,
+                      step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                      hidden_size_x4, mlas_tp_);
+        } else {
+          ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
+                      previous_state, previous_state_end,  // Ht-1
+                      hidden_size_,
+                      recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
+                      hidden_size_, beta,
+                      step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                      hidden_size_x4, mlas_tp_);
+        }
 
         DumpMatrix("Xt*(W[iofc]^T) + Ht-t*R[iofc]" + row_str,
                    &*step_out_IOFC, local_fused_hidden_rows, hidden_size_x4);
@@ -906,13 +1053,31 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
       span_T_iter step_out_IOFC = output_iofc_.begin() + (step * batch_size_) * hidden_size_x4;
 
       // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
-      ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
-                  previous_state, previous_state_end,  // Ht-1
-                  hidden_size_,
-                  recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
-                  hidden_size_, beta,
-                  step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4, mlas_tp_);
+      if (quantized_recurrent_weights.weights != nullptr) {
+        ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
+                    previous_state, previous_state_end,  // Ht-1
+                    hidden_size_,
+                    quantized_recurrent_weights,  // R[iofc]
+                    beta,
+                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4, quantized_gemm_input_, quantized_gemm_output_, mlas_tp_);
+      } else if (packed_recurrent_weights != nullptr) {
+        ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
+                    previous_state, previous_state_end,  // Ht-1
+                    hidden_size_,
+                    packed_recurrent_weights,  // R[iofc]
+                    beta,
+                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4, mlas_tp_);
+      } else {
+        ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
+                    previous_state, previous_state_end,  // Ht-1
+                    hidden_size_,
+                    recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
+                    hidden_size_, beta,
+                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4, mlas_tp_);
+      }
 
       span_T_iter batched_output;
       span_T_iter batched_output_end;
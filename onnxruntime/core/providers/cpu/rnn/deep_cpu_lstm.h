@@ -13,10 +13,14 @@ namespace onnxruntime {
 
 /// The class represents DeepCPU implementation of a long short term memory (LSTM) operator.
 /// For details, refer to http://aka.ms/dl-optimization/.
+/// It also implements the DynamicQuantizeLSTM contrib operator, which takes uint8 weights and runs the GEMMs with
+/// them in integers while the gates are computed in float.
 class DeepCpuLstmOp final : public OpKernel {
  public:
   DeepCpuLstmOp(const OpKernelInfo& info)
-      : OpKernel(info), clip_(info.GetAttrOrDefault<float>("clip", std::numeric_limits<float>::max())) {
+      : OpKernel(info),
+        clip_(info.GetAttrOrDefault<float>("clip", std::numeric_limits<float>::max())),
+        quantized_(info.node().OpType() == "DynamicQuantizeLSTM") {
     std::string direction;
     ORT_ENFORCE(info.GetAttr("direction", &direction).IsOK());
 
@@ -53,6 +57,12 @@ class DeepCpuLstmOp final : public OpKernel {
 
   Status Compute(OpKernelContext* context) const override;
 
+  // packs the W and R weights of each direction once, so the GEMMs run on every step don't pack them again
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights& prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(const PrePackedWeights& prepacked_weights, int input_idx) override;
+
   ~DeepCpuLstmOp() override = default;
 
  private:
@@ -69,15 +79,24 @@ class DeepCpuLstmOp final : public OpKernel {
                         const Tensor* P,
                         int batch_size) const;
 
+  // validates the scales and zero points of the uint8 W and R of DynamicQuantizeLSTM
+  Status ValidateQuantizedWeights(const Tensor& W_scale, const Tensor& R_scale,
+                                  const Tensor* W_zero_point, const Tensor* R_zero_point) const;
+
   rnn::detail::Direction direction_;
   int num_directions_;
 
   int hidden_size_ = 0;
   float clip_;
   bool input_forget_ = false;
+  const bool quantized_;
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
+  // W and R packed by PrePack, one buffer per direction. empty if they are not constant initializers.
+  std::vector<const void*> packed_W_;
+  std::vector<const void*> packed_R_;
+
   // Threadpool for operator. If concurrent Compute calls are possible, it will be shared
   // across them. mutable due to this.
   // The alternative would be to create a threadpool in each call to Compute but that would incur thread creation
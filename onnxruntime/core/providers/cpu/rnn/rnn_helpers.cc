@@ -7,15 +7,18 @@
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <stdlib.h>
 #include <string>
 #include <unordered_map>
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/tensor.h"
 #include "core/providers/cpu/rnn/rnn_activation_functors.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
+#include "core/util/qmath.h"
 
 namespace onnxruntime {
 namespace rnn {
@@ -31,7 +34,8 @@ Status ValidateCommonRnnInputs(const Tensor& X,
                                const Tensor* sequence_lens,
                                const Tensor* initial_h,
                                int64_t num_directions,
-                               int64_t hidden_size) {
+                               int64_t hidden_size,
+                               bool weights_transposed) {
   auto& X_shape = X.Shape();
   auto& W_shape = W.Shape();
   auto& R_shape = R.Shape();
@@ -43,21 +47,35 @@ Status ValidateCommonRnnInputs(const Tensor& X,
   if (X_shape.NumDimensions() != 3)
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input X must have 3 dimensions only. Actual:", X_shape);
 
+  // the dimensions of the gates and of the input in W and R
+  const size_t gates_dim = weights_transposed ? 2 : 1;
+  const size_t input_dim = weights_transposed ? 1 : 2;
+
   if (W_shape.NumDimensions() != 3 ||
       W_shape[0] != num_directions ||
-      W_shape[1] != hidden_size * WRB_dim_1_multipler ||
-      W_shape[2] != input_size)
+      W_shape[gates_dim] != hidden_size * WRB_dim_1_multipler ||
+      W_shape[input_dim] != input_size) {
+    if (weights_transposed)
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input W must have shape {",
+                             num_directions, ",", input_size, ",", WRB_dim_1_multipler, "*", hidden_size,
+                             "}. Actual:", W_shape);
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input W must have shape {",
                            num_directions, ",", WRB_dim_1_multipler, "*", hidden_size, ",",
                            input_size, "}. Actual:", W_shape);
+  }
 
   if (R_shape.NumDimensions() != 3 ||
       R_shape[0] != num_directions ||
-      R_shape[1] != hidden_size * WRB_dim_1_multipler ||
-      R_shape[2] != hidden_size)
+      R_shape[gates_dim] != hidden_size * WRB_dim_1_multipler ||
+      R_shape[input_dim] != hidden_size) {
+    if (weights_transposed)
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input R must have shape {",
+                             num_directions, ",", hidden_size, ",", WRB_dim_1_multipler, "*", hidden_size,
+                             "}. Actual:", R_shape);
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input R must have shape {",
                            num_directions, ",", WRB_dim_1_multipler, "*", hidden_size, ",",
                            hidden_size, "}. Actual:", R_shape);
+  }
 
   if (B != nullptr) {
     auto& B_shape = B->Shape();
@@ -101,6 +119,72 @@ Status ValidateCommonRnnInputs(const Tensor& X,
   return Status::OK();
 }  // namespace detail
 
+bool PackWeightsPerDirection(const AllocatorPtr& alloc, const Tensor& weights, int64_t first_row, int64_t num_rows,
+                             PrePackedWeights& prepacked_weights) {
+  const auto& shape = weights.Shape();
+  if (!weights.IsDataType<float>() || shape.NumDimensions() != 3 || first_row + num_rows > shape[1]) {
+    return false;
+  }
+
+  const size_t N = static_cast<size_t>(num_rows);
+  const size_t K = static_cast<size_t>(shape[2]);
+  const size_t packed_size = MlasGemmPackBSize(N, K);
+  if (packed_size == 0) {
+    return false;
+  }
+
+  const float* data = weights.Data<float>();
+  for (int64_t direction = 0; direction < shape[0]; ++direction) {
+    void* packed_data = alloc->Alloc(packed_size);
+    BufferUniquePtr packed(packed_data, BufferDeleter(alloc));
+    MlasGemmPackB(CblasTrans, N, K, data + (direction * shape[1] + first_row) * shape[2], K, packed_data);
+
+    prepacked_weights.buffers_.push_back(std::move(packed));
+    prepacked_weights.buffer_sizes_.push_back(packed_size);
+  }
+
+  return true;
+}
+
+void ComputeQuantizedGemm(int M, int N, int K, float alpha, const float* A, int lda, const QuantizedWeights& B,
+                          float beta, float* C, int ldc, uint8_t* quantized_A, int32_t* C_int32,
+                          concurrency::ThreadPool* tp) {
+  // the range of A, including zero so that 0 is exactly representable
+  float min = 0.0f;
+  float max = 0.0f;
+  for (int m = 0; m < M; ++m) {
+    const auto row_minmax = std::minmax_element(A + m * lda, A + m * lda + K);
+    min = std::min(min, *row_minmax.first);
+    max = std::max(max, *row_minmax.second);
+  }
+
+  const float qmax = std::numeric_limits<uint8_t>::max();
+  const float A_scale = (max - min) / qmax;
+  uint8_t A_zero_point = 0;
+  if (A_scale > 0.0f) {
+    A_zero_point = static_cast<uint8_t>(std::nearbyintf(std::max(0.0f, std::min(qmax, -min / A_scale))));
+    for (int m = 0; m < M; ++m) {
+      MlasQuantizeLinear(A + m * lda, quantized_A + m * K, static_cast<size_t>(K), A_scale, A_zero_point);
+    }
+  } else {
+    // A is all zeros
+    std::fill_n(quantized_A, static_cast<size_t>(M) * K, uint8_t{0});
+  }
+
+  QGemmu8u8_s32(M, N, K, quantized_A, K, A_zero_point, B.weights, N, B.zero_point, C_int32, N, tp);
+
+  const float multiplier = alpha * A_scale;
+  for (int m = 0; m < M; ++m) {
+    float* C_row = C + m * ldc;
+    const int32_t* C_int32_row = C_int32 + m * N;
+    for (int n = 0; n < N; ++n) {
+      const float product = multiplier * B.scales[B.per_channel ? n : 0] * static_cast<float>(C_int32_row[n]);
+      // C may be uninitialized when beta is 0
+      C_row[n] = beta == 0.0f ? product : product + beta * C_row[n];
+    }
+  }
+}
+
 // map of arg name and whether the alpha and/or beta arguments are required
 static std::unordered_map<std::string, std::pair<bool, bool>>
     NameToArgUsageMap{{"affine", {1, 1}},
@@ -8,8 +8,9 @@
 #endif
 
 #include <algorithm>
+#include <exception>
 #include <functional>
-#include <future>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,8 @@
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocator.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -74,7 +77,9 @@ gsl::span<TAlloc> Allocate(std::shared_ptr<IAllocator> allocator,
   return span;
 }
 
-// validate the common inputs to RNN, LSTM and GRU operators
+// validate the common inputs to RNN, LSTM and GRU operators.
+// W and R have shape [num_directions, WRB_dim_1_multipler * hidden_size, input_size or hidden_size], or the last two
+// dimensions swapped if weights_transposed, as the quantized weights of DynamicQuantizeLSTM are.
 Status ValidateCommonRnnInputs(const Tensor& X,
                                const Tensor& W,
                                const Tensor& R,
@@ -83,7 +88,15 @@ Status ValidateCommonRnnInputs(const Tensor& X,
                                const Tensor* sequence_lens,
                                const Tensor* initial_h,
                                int64_t num_directions,
-                               int64_t hidden_size);
+                               int64_t hidden_size,
+                               bool weights_transposed = false);
+
+// Packs rows [first_row, first_row + num_rows) of each direction of the constant weight tensor, which has shape
+// [num_directions, rows, K], into the layout MlasGemm computes with when the rows are the transposed B operand of
+// ComputeGemm. One buffer per direction is appended to prepacked_weights.
+// Returns false if the tensor is not a float 3D tensor or packing is not supported.
+bool PackWeightsPerDirection(const AllocatorPtr& alloc, const Tensor& weights, int64_t first_row, int64_t num_rows,
+                             /*out*/ PrePackedWeights& prepacked_weights);
 
 /// Copy an input array repeatedly to an output array
 /// @param input_begin Beginning of input
@@ -174,6 +187,70 @@ void ComputeGemm(const int M,
       &*C, ldc, tp);
 }
 
+// As above, with B packed by PackWeightsPerDirection so the weights aren't packed again on every call.
+template <typename TSpanAIter, typename TSpanCIter>
+void ComputeGemm(const int M,
+                 const int N,
+                 const int K,
+                 const float alpha,
+                 TSpanAIter A,
+                 TSpanAIter A_end,
+                 const int lda,
+                 const void* packed_B,
+                 const float beta,
+                 TSpanCIter C,
+                 TSpanCIter C_end,
+                 const int ldc, concurrency::ThreadPool* tp) {
+  ORT_ENFORCE(lda >= K && ldc >= N);
+  ORT_ENFORCE(A + (M * lda - (lda - K)) <= A_end);
+  ORT_ENFORCE(C + (M * ldc - (ldc - N)) <= C_end);
+
+  MlasGemm(CblasNoTrans, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K), alpha,
+           &*A, static_cast<size_t>(lda), packed_B, beta, &*C, static_cast<size_t>(ldc), tp);
+}
+
+// The uint8 weights of a direction of DynamicQuantizeLSTM. Unlike the float weights they have size K x N, the layout
+// the integer GEMM takes, and each of the N output channels may have its own scale.
+struct QuantizedWeights {
+  const uint8_t* weights = nullptr;
+  const float* scales = nullptr;  // N values if per_channel, else 1
+  bool per_channel = false;
+  uint8_t zero_point = 0;
+};
+
+// C = alpha * A * dequantize(B) + beta * C. A is quantized to uint8 with a scale and zero point computed from its
+// M x K values like DynamicQuantizeLinear, multiplied with B in 32-bit integers, and the product is scaled back to
+// float. quantized_A and C_int32 are scratch buffers of at least M * K and M * N values.
+void ComputeQuantizedGemm(int M, int N, int K, float alpha, const float* A, int lda, const QuantizedWeights& B,
+                          float beta, float* C, int ldc, uint8_t* quantized_A, int32_t* C_int32,
+                          concurrency::ThreadPool* tp);
+
+// As above, with the quantized weights of DynamicQuantizeLSTM.
+template <typename TSpanAIter, typename TSpanCIter>
+void ComputeGemm(const int M,
+                 const int N,
+                 const int K,
+                 const float alpha,
+                 TSpanAIter A,
+                 TSpanAIter A_end,
+                 const int lda,
+                 const QuantizedWeights& B,
+                 const float beta,
+                 TSpanCIter C,
+                 TSpanCIter C_end,
+                 const int ldc,
+                 gsl::span<uint8_t> quantized_A,
+                 gsl::span<int32_t> C_int32,
+                 concurrency::ThreadPool* tp) {
+  ORT_ENFORCE(lda >= K && ldc >= N);
+  ORT_ENFORCE(A + (M * lda - (lda - K)) <= A_end);
+  ORT_ENFORCE(C + (M * ldc - (ldc - N)) <= C_end);
+  ORT_ENFORCE(static_cast<size_t>(quantized_A.size()) >= static_cast<size_t>(M) * K &&
+              static_cast<size_t>(C_int32.size()) >= static_cast<size_t>(M) * N);
+
+  ComputeQuantizedGemm(M, N, K, alpha, &*A, lda, B, beta, &*C, ldc, quantized_A.data(), C_int32.data(), tp);
+}
+
 // helper to convert a span to a raw pointer
 // after validating the memory covered by the span supports the size required
 template <typename T>
@@ -229,55 +306,24 @@ void ExecuteLambdaInParallel(const std::string& name, TLambda lambda, int max, i
   ORT_UNUSED_PARAMETER(name);
   ORT_UNUSED_PARAMETER(logger);
 
-  // ORT_ENFORCE may and does throw at times from within the tasks that run
-  // on a thread-pool. Without propagating exceptions the process exits silently
-  // which will make diagnosing bugs more difficult.
-
-  // \! UGLY
-  // We have a problem here with the current thread-pool is that it takes std::function
-  // by value and copies it more than once (even though it is movable).
-  //
-  // To report status and exceptions properly it's better to use
-  // futures and promises but they are not copyable, so we can't come up with a functor
-  // with a promise member and we are downgrading to C++11 where we can't have captures that moved in.
-  //
-  // At the same time promises MUST live in the child thread so if we throw from the main thread
-  // we don't destroy any promises that are on the main thread stack which children threads may still be using.
-  //
-  // The only solution with the current Eigen that comes to mind is to have shared_ptr to with std::promise.
-  //
+  // ORT_ENFORCE may and does throw at times from within the tasks that run on the thread pool. Without propagating
+  // exceptions the process exits silently which makes diagnosing bugs more difficult, so the first one is stored
+  // and re-thrown once all the tasks have finished. ParallelFor runs the tasks on the calling thread too and returns
+  // once they have all completed, so nothing is allocated per task.
   const int total_tasks = max / (step > 0 ? step : 1) + (max % step > 0 ? 1 : 0);
-  std::vector<std::future<void> > futures;
-  futures.reserve(total_tasks);
-
-  for (int i = 0, t = 0; i < max; i += step, ++t) {
-    auto p_ptr = std::make_shared<std::promise<void> >();
-    futures.push_back(p_ptr->get_future());
-    ttp.Schedule([p_ptr, lambda, i]() {
-      try {
-        lambda(i);
-        p_ptr->set_value();
-      } catch (...) {
-        p_ptr->set_exception(std::current_exception());
-      }
-    });
-  }
-
-  // We'd like to wait until all of the tasks have finished
-  // even though one or more have already thrown. We will store
-  // the first exception and then will re-throw at the end.
   std::exception_ptr pending_exception;
-  for (auto& fut : futures) {
+  std::mutex pending_exception_mutex;
+
+  ttp.ParallelFor(total_tasks, [&](int32_t t) {
     try {
-      // get() will re-throw any exceptions
-      // the running task may throw
-      fut.get();
+      lambda(t * step);
     } catch (...) {
+      std::lock_guard<std::mutex> lock(pending_exception_mutex);
       if (!pending_exception) {
         pending_exception = std::current_exception();
       }
     }
-  }
+  });
 
   if (pending_exception) {
     std::rethrow_exception(pending_exception);
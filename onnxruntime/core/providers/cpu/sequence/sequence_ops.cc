@@ -13,8 +13,9 @@ using namespace onnxruntime::common;
 
 namespace onnxruntime {
 
-// TODO: The current implementation of sequence ops relies on tensor copies. Ideally we should try to avoid
-// these copies. This has been postponed due to lack of time.
+// The sequences built from another sequence share its tensors (see TensorSeq), so only the tensors entering a
+// sequence from a tensor input are copied: the buffers of the tensor inputs belong to the execution frame, which may
+// reuse them for other values once the node has run.
 
 // SequenceLength
 ONNX_CPU_OPERATOR_KERNEL(
@@ -94,6 +95,8 @@ Status SequenceAt::Compute(OpKernelContext* context) const {
   if (input_seq_idx < 0) {
     input_seq_idx = static_cast<int64_t>(X->Size()) + input_seq_idx;
   }
+  // the output is copied rather than pointing to the tensor of the sequence, as the allocation planner may place
+  // other values in the buffer of the output
   const Tensor& indexed_tensor = X->Get(input_seq_idx);
   auto* Y = context->Output(0, indexed_tensor.Shape().GetDims());
   ORT_ENFORCE(Y != nullptr, "SequenceAt: Got nullptr for output tensor");
@@ -182,11 +185,12 @@ ONNX_CPU_OPERATOR_KERNEL(
                                  DataTypeImpl::GetTensorType<int64_t>()}),
     SequenceInsert);
 
-Status CreateCopyAndAppendCpuTensor(const Tensor& in_tensor, OpKernelContext* context, std::vector<Tensor>& tensors) {
+Status CreateCopyAndAppendCpuTensor(const Tensor& in_tensor, OpKernelContext* context,
+                                    std::vector<TensorSeq::ElementPtr>& tensors) {
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
-  Tensor tmp(in_tensor.DataType(), onnxruntime::TensorShape(in_tensor.Shape()), alloc);
-  CopyCpuTensor(&in_tensor, &tmp);
+  auto tmp = std::make_shared<Tensor>(in_tensor.DataType(), onnxruntime::TensorShape(in_tensor.Shape()), alloc);
+  CopyCpuTensor(&in_tensor, tmp.get());
   tensors.push_back(std::move(tmp));
   return Status::OK();
 }
@@ -222,18 +226,16 @@ Status SequenceInsert::Compute(OpKernelContext* context) const {
 
   auto* Y = context->Output<TensorSeq>(0);
   ORT_ENFORCE(Y != nullptr, "SequenceInsert: Got nullptr for output sequence");
-  std::vector<Tensor> tensors;
+  std::vector<TensorSeq::ElementPtr> tensors;
   tensors.reserve(num_tensors_input_seq + 1);
   for (int i = 0; i < num_tensors_input_seq; ++i) {
     if (i == input_seq_idx) {
-      CreateCopyAndAppendCpuTensor(*X, context, tensors);
-      CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors);
-    } else {
-      CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors);
+      ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, tensors));
     }
+    tensors.push_back(S->GetElement(i));
   }
   if (input_seq_idx == num_tensors_input_seq + 1) {
-    CreateCopyAndAppendCpuTensor(*X, context, tensors);
+    ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, tensors));
   }
 
   Y->SetType(S->DataType());
@@ -275,13 +277,13 @@ Status SequenceErase::Compute(OpKernelContext* context) const {
   auto* Y = context->Output<TensorSeq>(0);
   ORT_ENFORCE(Y != nullptr, "SequenceErase: Got nullptr for output sequence");
   Y->SetType(S->DataType());
-  std::vector<Tensor> tensors;
+  std::vector<TensorSeq::ElementPtr> tensors;
   tensors.reserve(num_tensors_input_seq - 1);
   for (int i = 0; i < num_tensors_input_seq; ++i) {
     if (i == input_seq_idx) {
       continue;
     }
-    CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors);
+    tensors.push_back(S->GetElement(i));
   }
   Y->SetElements(std::move(tensors));
   return Status::OK();
@@ -315,11 +317,11 @@ Status SequenceConstruct::Compute(OpKernelContext* context) const {
 
   // now copy the tensors to the output sequence
   Y->SetType(first_dtype);
-  std::vector<Tensor> tensors;
+  std::vector<TensorSeq::ElementPtr> tensors;
   tensors.reserve(num_inputs);
   for (int input_idx = 0; input_idx < num_inputs; ++input_idx) {
     const auto* X = context->Input<Tensor>(input_idx);
-    CreateCopyAndAppendCpuTensor(*X, context, tensors);
+    ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, tensors));
   }
   Y->SetElements(std::move(tensors));
   return Status::OK();
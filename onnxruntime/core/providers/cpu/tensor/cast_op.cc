@@ -1,165 +1,141 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#include <iomanip>
-#include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
-#include "Eigen/src/Core/arch/Default/Half.h"
-#include "core/common/common.h"
-
-#if defined(_M_AMD64)
-#include "core/mlas/inc/mlas.h"
-#endif
 
 using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
 
+// Casts of at least this many elements are split across the threads. Formatting and parsing strings is much slower,
+// so string casts are split from fewer elements.
+static constexpr int64_t kParallelCastMinElements = 1 << 16;
+static constexpr int64_t kParallelStringCastMinElements = 1 << 10;
+
+// The casts between MLFloat16 and the types other than float go through a block of floats on the stack.
+static constexpr int64_t kCastThroughFloatBlockSize = 256;
+
 template <typename SrcType,
           typename DstType>
-inline void CastData(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  auto shape_size = shape.Size();
-  auto in_vector = ConstEigenVectorMap<SrcType>(in->template Data<SrcType>(), shape_size);
-  auto output_vector = EigenVectorMap<DstType>(out->template MutableData<DstType>(), shape_size);
+inline void CastData(const SrcType* in, DstType* out, int64_t count) {
+  auto in_vector = ConstEigenVectorMap<SrcType>(in, count);
+  auto output_vector = EigenVectorMap<DstType>(out, count);
   output_vector = in_vector.template cast<DstType>();
 }
 
+// MLAS converts with F16C on x64 and the NEON conversions on ARM64, when they are available.
 template <>
-inline void CastData<float, MLFloat16>(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  auto out_data = out->template MutableData<MLFloat16>();
-  auto shape_size = shape.Size();
-  auto in_vector = ConstEigenVectorMap<float>(in->template Data<float>(), shape_size);
-  auto output_vector = EigenVectorMap<Eigen::half>(static_cast<Eigen::half*>(static_cast<void*>(out_data)), shape_size);
-  output_vector = in_vector.template cast<Eigen::half>();
+inline void CastData<float, MLFloat16>(const float* in, MLFloat16* out, int64_t count) {
+  MlasConvertFloatToHalf(MlasFloat16Format, in, &out[0].val, static_cast<size_t>(count));
 }
 
 template <>
-inline void CastData<MLFloat16, float>(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  auto out_data = out->template MutableData<float>();
-  auto in_data = in->template Data<MLFloat16>();
-  auto shape_size = shape.Size();
-#if defined(_M_AMD64)
-  MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
-#else
-  auto in_vector = ConstEigenVectorMap<Eigen::half>(static_cast<const Eigen::half*>(static_cast<const void*>(in_data)), shape_size);
-  auto output_vector = EigenVectorMap<float>(out_data, shape_size);
-  output_vector = in_vector.template cast<float>();
-#endif
+inline void CastData<MLFloat16, float>(const MLFloat16* in, float* out, int64_t count) {
+  MlasConvertHalfToFloat(MlasFloat16Format, &in[0].val, out, static_cast<size_t>(count));
 }
 
 template <typename SrcType,
           typename DstType>
-inline void CastFloat16Data(const Tensor* in, Tensor* out, const TensorShape& shape, const AllocatorPtr& allocator) {
-  ORT_ENFORCE(allocator != nullptr);
-  const int64_t len = shape.Size();
-  ORT_ENFORCE(len > 0);
-  void* buffer = allocator->AllocArray(sizeof(float), len);
-  ORT_ENFORCE(buffer);
-  Tensor tmp_tensor(DataTypeImpl::GetType<float>(), shape, buffer, allocator->Info());
-  if (std::is_same<SrcType, MLFloat16>::value) {
-    CastData<MLFloat16, float>(in, &tmp_tensor, shape);  // first cast to float
-    CastData<float, DstType>(&tmp_tensor, out, shape);   // then cast to the destination type.
-  } else if (std::is_same<DstType, MLFloat16>::value) {
-    CastData<SrcType, float>(in, &tmp_tensor, shape);
-    CastData<float, MLFloat16>(&tmp_tensor, out, shape);
+inline void CastThroughFloat(const SrcType* in, DstType* out, int64_t count) {
+  float buffer[kCastThroughFloatBlockSize];
+  for (int64_t i = 0; i < count; i += kCastThroughFloatBlockSize) {
+    const int64_t n = std::min(kCastThroughFloatBlockSize, count - i);
+    CastData<SrcType, float>(in + i, buffer, n);
+    CastData<float, DstType>(buffer, out + i, n);
   }
-  allocator->Free(buffer);
 }
 
 template <typename SrcType>
-inline void CastToStringData(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  const int64_t len = shape.Size();
-  ORT_ENFORCE(len > 0);
-  auto input_data = in->DataAsSpan<SrcType>();
-  auto output_data = out->MutableDataAsSpan<std::string>();
-
-  for (int i = 0; i < len; ++i) {
-    if (std::is_floating_point<SrcType>::value && std::isnan(input_data[i])) {
-      output_data[i] = "NaN";
-    } else if (std::is_floating_point<SrcType>::value && std::isinf(input_data[i])) {
-      if (input_data[i] < std::numeric_limits<SrcType>::lowest()) {
-        output_data[i] = "-INF";
-      } else {
-        output_data[i] = "INF";
-      }
-    } else {
-      std::ostringstream convert;
-      if (std::is_floating_point<SrcType>::value) {
-        // match numpy default behavior
-        convert << std::setprecision(8);
-      }
+inline void CastToString(SrcType input, std::string& output) {
+  output = std::to_string(input);
+}
 
-      convert << input_data[i];
-      output_data[i] = convert.str();
-    }
+// a stream writes the 8-bit integers as characters
+template <>
+inline void CastToString<int8_t>(int8_t input, std::string& output) {
+  output.assign(1, static_cast<char>(input));
+}
+
+template <>
+inline void CastToString<uint8_t>(uint8_t input, std::string& output) {
+  output.assign(1, static_cast<char>(input));
+}
+
+template <>
+inline void CastToString<bool>(bool input, std::string& output) {
+  output = input ? "1" : "0";
+}
+
+inline void CastFloatingPointToString(double input, std::string& output) {
+  if (std::isnan(input)) {
+    output = "NaN";
+  } else if (std::isinf(input)) {
+    output = input < 0 ? "-INF" : "INF";
+  } else {
+    // match numpy default behavior, which prints 8 significant digits
+    char buffer[32];
+    const int length = snprintf(buffer, sizeof(buffer), "%.8g", input);
+    output.assign(buffer, static_cast<size_t>(length));
   }
 }
 
+template <>
+inline void CastToString<float>(float input, std::string& output) {
+  CastFloatingPointToString(input, output);
+}
+
+template <>
+inline void CastToString<double>(double input, std::string& output) {
+  CastFloatingPointToString(input, output);
+}
+
 template <typename DstType>
-inline void CastFromStringData(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  if (std::is_same<DstType, std::string>::value) return;
-  const int64_t len = shape.Size();
-  ORT_ENFORCE(len > 0);
-  if (std::is_same<DstType, float>::value) {
-    auto* mutable_data = out->MutableData<float>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stof(in->Data<std::string>()[i]);
-    }
-  } else if (std::is_same<DstType, double>::value) {
-    auto* mutable_data = out->MutableData<double>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stod(in->Data<std::string>()[i]);
-    }
-  } else if (std::is_same<DstType, int8_t>::value) {
-    auto* mutable_data = out->MutableData<int8_t>();
-    for (int i = 0; i < len; ++i) {
-      int temp_i = std::stoi(in->Data<std::string>()[i]);
-      mutable_data[i] = static_cast<int8_t>(temp_i);
-    }
-  } else if (std::is_same<DstType, uint8_t>::value) {
-    auto* mutable_data = out->MutableData<uint8_t>();
-    for (int i = 0; i < len; ++i) {
-      unsigned long temp_ui = std::stoul(in->Data<std::string>()[i]);
-      mutable_data[i] = static_cast<uint8_t>(temp_ui);
-    }
-  } else if (std::is_same<DstType, int16_t>::value) {
-    auto* mutable_data = out->MutableData<int16_t>();
-    for (int i = 0; i < len; ++i) {
-      int temp_i = std::stoi(in->Data<std::string>()[i]);
-      mutable_data[i] = static_cast<int16_t>(temp_i);
-    }
-  } else if (std::is_same<DstType, uint16_t>::value) {
-    auto* mutable_data = out->MutableData<uint16_t>();
-    for (int i = 0; i < len; ++i) {
-      unsigned long temp_ui = std::stoul(in->Data<std::string>()[i]);
-      mutable_data[i] = static_cast<uint16_t>(temp_ui);
-    }
-  } else if (std::is_same<DstType, int32_t>::value) {
-    auto* mutable_data = out->MutableData<int32_t>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stol(in->Data<std::string>()[i]);
-    }
-  } else if (std::is_same<DstType, uint32_t>::value) {
-    auto* mutable_data = out->MutableData<uint32_t>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stoul(in->Data<std::string>()[i]);
-    }
-  } else if (std::is_same<DstType, int64_t>::value) {
-    auto* mutable_data = out->MutableData<int64_t>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stoll(in->Data<std::string>()[i]);
-    }
-  } else if (std::is_same<DstType, uint64_t>::value) {
-    auto* mutable_data = out->MutableData<uint64_t>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stoull(in->Data<std::string>()[i]);
-    }
+inline DstType CastFromString(const std::string& input);
+
+template <>
+inline float CastFromString<float>(const std::string& input) { return std::stof(input); }
+template <>
+inline double CastFromString<double>(const std::string& input) { return std::stod(input); }
+template <>
+inline int8_t CastFromString<int8_t>(const std::string& input) { return static_cast<int8_t>(std::stoi(input)); }
+template <>
+inline uint8_t CastFromString<uint8_t>(const std::string& input) { return static_cast<uint8_t>(std::stoul(input)); }
+template <>
+inline int16_t CastFromString<int16_t>(const std::string& input) { return static_cast<int16_t>(std::stoi(input)); }
+template <>
+inline uint16_t CastFromString<uint16_t>(const std::string& input) { return static_cast<uint16_t>(std::stoul(input)); }
+template <>
+inline int32_t CastFromString<int32_t>(const std::string& input) { return static_cast<int32_t>(std::stol(input)); }
+template <>
+inline uint32_t CastFromString<uint32_t>(const std::string& input) { return static_cast<uint32_t>(std::stoul(input)); }
+template <>
+inline int64_t CastFromString<int64_t>(const std::string& input) { return std::stoll(input); }
+template <>
+inline uint64_t CastFromString<uint64_t>(const std::string& input) { return std::stoull(input); }
+
+// Calls cast(begin, end) for the ranges of [0, count), which are split across the thread pool for large tensors.
+template <typename CastFn>
+void ParallelCast(concurrency::ThreadPool* tp, int64_t count, int64_t min_parallel_count, const CastFn& cast) {
+  const auto num_batches = static_cast<int32_t>(
+      tp == nullptr || count < min_parallel_count ? 1 : std::min<int64_t>(count, tp->NumThreads() + 1));
+  auto compute_batch = [&](int32_t batch) {
+    cast(count * batch / num_batches, count * (batch + 1) / num_batches);
+  };
+
+  if (num_batches == 1) {
+    compute_batch(0);
   } else {
-    ORT_THROW("Unsupported type in cast op: from String to ", typeid(DstType).name());
+    concurrency::ThreadPool::TryBatchParallelFor(tp, num_batches, compute_batch, num_batches);
   }
-}  // namespace onnxruntime
+}
 
 template <typename T>
 class Cast final : public OpKernel {
@@ -176,29 +152,44 @@ class Cast final : public OpKernel {
  private:
   template <typename SrcType,
             typename DstType>
-  void CastData(const Tensor* in, Tensor* out, const TensorShape& shape) const {
-    ::onnxruntime::CastData<SrcType, DstType>(in, out, shape);
+  void CastData(const Tensor* in, Tensor* out, concurrency::ThreadPool* tp) const {
+    const auto* in_data = in->template Data<SrcType>();
+    auto* out_data = out->template MutableData<DstType>();
+    ParallelCast(tp, in->Shape().Size(), kParallelCastMinElements, [&](int64_t begin, int64_t end) {
+      ::onnxruntime::CastData<SrcType, DstType>(in_data + begin, out_data + begin, end - begin);
+    });
   }
 
   template <typename SrcType,
             typename DstType>
-  Status CastFloat16Data(const Tensor* in, Tensor* out, const TensorShape& shape, OpKernelContext* context) const {
-    AllocatorPtr allocator;
-    ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
-    ::onnxruntime::CastFloat16Data<SrcType, DstType>(in, out, shape, allocator);
-    return Status::OK();
+  void CastFloat16Data(const Tensor* in, Tensor* out, concurrency::ThreadPool* tp) const {
+    const auto* in_data = in->template Data<SrcType>();
+    auto* out_data = out->template MutableData<DstType>();
+    ParallelCast(tp, in->Shape().Size(), kParallelCastMinElements, [&](int64_t begin, int64_t end) {
+      ::onnxruntime::CastThroughFloat<SrcType, DstType>(in_data + begin, out_data + begin, end - begin);
+    });
   }
 
   template <typename SrcType>
-  Status CastToStringData(const Tensor* in, Tensor* out, const TensorShape& shape) const {
-    ::onnxruntime::CastToStringData<SrcType>(in, out, shape);
-    return Status::OK();
+  void CastToStringData(const Tensor* in, Tensor* out, concurrency::ThreadPool* tp) const {
+    const auto* in_data = in->template Data<SrcType>();
+    auto* out_data = out->template MutableData<std::string>();
+    ParallelCast(tp, in->Shape().Size(), kParallelStringCastMinElements, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        ::onnxruntime::CastToString<SrcType>(in_data[i], out_data[i]);
+      }
+    });
   }
 
   template <typename DstType>
-  Status CastFromStringData(const Tensor* in, Tensor* out, const TensorShape& shape) const {
-    ::onnxruntime::CastFromStringData<DstType>(in, out, shape);
-    return Status::OK();
+  void CastFromStringData(const Tensor* in, Tensor* out, concurrency::ThreadPool* tp) const {
+    const auto* in_data = in->template Data<std::string>();
+    auto* out_data = out->template MutableData<DstType>();
+    ParallelCast(tp, in->Shape().Size(), kParallelStringCastMinElements, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        out_data[i] = ::onnxruntime::CastFromString<DstType>(in_data[i]);
+      }
+    });
   }
 
   ONNX_NAMESPACE::TensorProto_DataType to_;
@@ -233,51 +224,51 @@ const std::vector<MLDataType> castOpTypeConstraints{
     const Tensor* X = context->Input<Tensor>(0);                                                                                   \
     const TensorShape& shape = X->Shape();                                                                                         \
     Tensor* Y = context->Output(0, TensorShape(shape));                                                                            \
+    concurrency::ThreadPool* tp = context->GetOperatorThreadPool();                                                                \
                                                                                                                                    \
     switch (to_) {                                                                                                                 \
       case TensorProto_DataType_BOOL:                                                                                              \
-        CastData<in_type, bool>(X, Y, shape);                                                                                      \
+        CastData<in_type, bool>(X, Y, tp);                                                                                         \
         break;                                                                                                                     \
       case TensorProto_DataType_INT16:                                                                                             \
-        CastData<in_type, int16_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, int16_t>(X, Y, tp);                                                                                      \
         break;                                                                                                                     \
       case TensorProto_DataType_INT32:                                                                                             \
-        CastData<in_type, int32_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, int32_t>(X, Y, tp);                                                                                      \
         break;                                                                                                                     \
       case TensorProto_DataType_INT64:                                                                                             \
-        CastData<in_type, int64_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, int64_t>(X, Y, tp);                                                                                      \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT8:                                                                                             \
-        CastData<in_type, uint8_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, uint8_t>(X, Y, tp);                                                                                      \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT16:                                                                                            \
-        CastData<in_type, uint16_t>(X, Y, shape);                                                                                  \
+        CastData<in_type, uint16_t>(X, Y, tp);                                                                                     \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT32:                                                                                            \
-        CastData<in_type, uint32_t>(X, Y, shape);                                                                                  \
+        CastData<in_type, uint32_t>(X, Y, tp);                                                                                     \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT64:                                                                                            \
-        CastData<in_type, uint64_t>(X, Y, shape);                                                                                  \
+        CastData<in_type, uint64_t>(X, Y, tp);                                                                                     \
         break;                                                                                                                     \
       case TensorProto_DataType_FLOAT:                                                                                             \
-        CastData<in_type, float>(X, Y, shape);                                                                                     \
+        CastData<in_type, float>(X, Y, tp);                                                                                        \
         break;                                                                                                                     \
       case TensorProto_DataType_DOUBLE:                                                                                            \
-        CastData<in_type, double>(X, Y, shape);                                                                                    \
+        CastData<in_type, double>(X, Y, tp);                                                                                       \
         break;                                                                                                                     \
       case TensorProto_DataType_INT8:                                                                                              \
-        CastData<in_type, int8_t>(X, Y, shape);                                                                                    \
+        CastData<in_type, int8_t>(X, Y, tp);                                                                                       \
         break;                                                                                                                     \
       case TensorProto_DataType_FLOAT16:                                                                                           \
         if (std::is_same<in_type, float>::value) {                                                                                 \
-          CastData<float, MLFloat16>(X, Y, shape);                                                                                 \
+          CastData<float, MLFloat16>(X, Y, tp);                                                                                    \
         } else {                                                                                                                   \
-          auto st = CastFloat16Data<in_type, MLFloat16>(X, Y, shape, context);                                                     \
-          if (!st.IsOK()) return st;                                                                                               \
+          CastFloat16Data<in_type, MLFloat16>(X, Y, tp);                                                                           \
         }                                                                                                                          \
         break;                                                                                                                     \
       case TensorProto_DataType_STRING:                                                                                            \
-        CastToStringData<in_type>(X, Y, shape);                                                                                    \
+        CastToStringData<in_type>(X, Y, tp);                                                                                       \
         break;                                                                                                                     \
       case TensorProto_DataType_UNDEFINED:                                                                                         \
         ORT_THROW("Cast op must have 'to' argument of type DataType"); /*break;*/                                                  \
@@ -312,34 +303,34 @@ Status Cast<MLFloat16>::Compute(OpKernelContext* context) const {
   const auto* X = context->Input<Tensor>(0);
   const TensorShape& shape = X->Shape();
   Tensor* Y = context->Output(0, TensorShape(shape));
-  Status st;
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
   switch (to_) {
     case TensorProto_DataType_BOOL:
-      st = CastFloat16Data<MLFloat16, bool>(X, Y, shape, context);
+      CastFloat16Data<MLFloat16, bool>(X, Y, tp);
       break;
     case TensorProto_DataType_INT16:
-      st = CastFloat16Data<MLFloat16, int16_t>(X, Y, shape, context);
+      CastFloat16Data<MLFloat16, int16_t>(X, Y, tp);
       break;
     case TensorProto_DataType_INT32:
-      st = CastFloat16Data<MLFloat16, int32_t>(X, Y, shape, context);
+      CastFloat16Data<MLFloat16, int32_t>(X, Y, tp);
       break;
     case TensorProto_DataType_INT64:
-      st = CastFloat16Data<MLFloat16, int64_t>(X, Y, shape, context);
+      CastFloat16Data<MLFloat16, int64_t>(X, Y, tp);
       break;
     case TensorProto_DataType_UINT8:
-      st = CastFloat16Data<MLFloat16, uint8_t>(X, Y, shape, context);
+      CastFloat16Data<MLFloat16, uint8_t>(X, Y, tp);
       break;
     case TensorProto_DataType_UINT16:
-      st = CastFloat16Data<MLFloat16, uint16_t>(X, Y, shape, context);
+      CastFloat16Data<MLFloat16, uint16_t>(X, Y, tp);
       break;
     case TensorProto_DataType_UINT32:
-      st = CastFloat16Data<MLFloat16, uint32_t>(X, Y, shape, context);
+      CastFloat16Data<MLFloat16, uint32_t>(X, Y, tp);
       break;
     case TensorProto_DataType_UINT64:
-      st = CastFloat16Data<MLFloat16, uint64_t>(X, Y, shape, context);
+      CastFloat16Data<MLFloat16, uint64_t>(X, Y, tp);
       break;
     case TensorProto_DataType_FLOAT:
-      CastData<MLFloat16, float>(X, Y, shape);
+      CastData<MLFloat16, float>(X, Y, tp);
       break;
     case TensorProto_DataType_FLOAT16: {
       auto X_type = X->DataType();
@@ -349,14 +340,13 @@ Status Cast<MLFloat16>::Compute(OpKernelContext* context) const {
       if (target != source) {
         memcpy(target, source, shape.Size() * X_type->Size());
       }
-      st = Status::OK();
       break;
     }
     case TensorProto_DataType_DOUBLE:
-      st = CastFloat16Data<MLFloat16, double>(X, Y, shape, context);
+      CastFloat16Data<MLFloat16, double>(X, Y, tp);
       break;
     case TensorProto_DataType_INT8:
-      st = CastFloat16Data<MLFloat16, int8_t>(X, Y, shape, context);
+      CastFloat16Data<MLFloat16, int8_t>(X, Y, tp);
       break;
     case TensorProto_DataType_STRING:
       ORT_THROW("Casting from 'float16' to 'string' is not supported yet."); /*break;*/
@@ -365,7 +355,7 @@ Status Cast<MLFloat16>::Compute(OpKernelContext* context) const {
     default:
       ORT_THROW("Unexpected 'to' argument value: ", to_);
   }
-  return st;
+  return Status::OK();
 }
 
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
@@ -382,43 +372,43 @@ Status Cast<std::string>::Compute(OpKernelContext* context) const {
                                   "Input is missing. The operator Cast expects one and only one input");
   const TensorShape& shape = X->Shape();
   Tensor* Y = context->Output(0, TensorShape(shape));
-  Status st;
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
   switch (to_) {
     case TensorProto_DataType_INT16:
-      st = CastFromStringData<int16_t>(X, Y, shape);
+      CastFromStringData<int16_t>(X, Y, tp);
       break;
     case TensorProto_DataType_INT32:
-      st = CastFromStringData<int32_t>(X, Y, shape);
+      CastFromStringData<int32_t>(X, Y, tp);
       break;
     case TensorProto_DataType_INT64:
-      st = CastFromStringData<int64_t>(X, Y, shape);
+      CastFromStringData<int64_t>(X, Y, tp);
       break;
     case TensorProto_DataType_UINT8:
-      st = CastFromStringData<uint8_t>(X, Y, shape);
+      CastFromStringData<uint8_t>(X, Y, tp);
       break;
     case TensorProto_DataType_UINT16:
-      st = CastFromStringData<uint16_t>(X, Y, shape);
+      CastFromStringData<uint16_t>(X, Y, tp);
       break;
     case TensorProto_DataType_UINT32:
-      st = CastFromStringData<uint32_t>(X, Y, shape);
+      CastFromStringData<uint32_t>(X, Y, tp);
       break;
     case TensorProto_DataType_UINT64:
-      st = CastFromStringData<uint64_t>(X, Y, shape);
+      CastFromStringData<uint64_t>(X, Y, tp);
       break;
     case TensorProto_DataType_FLOAT:
-      st = CastFromStringData<float>(X, Y, shape);
+      CastFromStringData<float>(X, Y, tp);
       break;
     case TensorProto_DataType_DOUBLE:
-      st = CastFromStringData<double>(X, Y, shape);
+      CastFromStringData<double>(X, Y, tp);
       break;
     case TensorProto_DataType_INT8:
-      st = CastFromStringData<int8_t>(X, Y, shape);
+      CastFromStringData<int8_t>(X, Y, tp);
       break;
     case TensorProto_DataType_UNDEFINED:
       ORT_THROW("Cast op must have 'to' argument of type DataType");
     default:
       ORT_THROW("Unexpected 'to' argument value: ", to_);
   }
-  return st;
+  return Status::OK();
 }
 }  //namespace onnxruntime
@@ -2,6 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/compress.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 using namespace ::onnxruntime::common;
 
@@ -25,6 +30,12 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>()),
     Compress);
 
+namespace {
+// elements of the condition per block, and bytes copied per block along an axis
+constexpr int64_t kCompressBlockSize = 16 * 1024;
+constexpr int64_t kCompressBlockBytes = 64 * 1024;
+}  // namespace
+
 Status Compress::Compute(OpKernelContext* ctx) const {
   const auto* input_tensor = ctx->Input<Tensor>(0);
   size_t rank = input_tensor->Shape().NumDimensions();
@@ -37,18 +48,25 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   const auto* condition = ctx->Input<Tensor>(1);
   auto condition_length = condition->Shape().Size();
   auto condition_data = condition->template Data<bool>();
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
 
-  int64_t positive_condition_count = 0;
   // if has axis, we need to compress on dimension[axis], otherwise compress on the flattened input data
   int64_t compress_input_length = has_axis_ ? input_dimensions[axis] : input_tensor->Shape().Size();
   int64_t valid_condition_length = compress_input_length < condition_length ? compress_input_length : condition_length;
 
-  // Figure out output shape
-  for (int i = 0; i < valid_condition_length; ++i) {
-    if (condition_data[i]) {
-      ++positive_condition_count;
-    }
-  }
+  // Figure out output shape. The condition is split into blocks, each one counted by one thread, and the elements
+  // selected by a block are written from the number of the ones selected by the blocks before it.
+  const int64_t block_size =
+      std::max<int64_t>(kCompressBlockSize, valid_condition_length / std::numeric_limits<int32_t>::max() + 1);
+  const int64_t num_blocks = (valid_condition_length + block_size - 1) / block_size;
+  std::vector<int64_t> block_offsets(static_cast<size_t>(num_blocks) + 1, 0);
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t block) {
+    const bool* begin = condition_data + block * block_size;
+    const bool* end = condition_data + std::min(valid_condition_length, (block + 1) * block_size);
+    block_offsets[block + 1] = std::count(begin, end, true);
+  });
+  std::partial_sum(block_offsets.begin(), block_offsets.end(), block_offsets.begin());
+  const int64_t positive_condition_count = block_offsets.back();
 
   std::vector<int64_t> output_dims(input_dimensions);
   if (has_axis_) {
@@ -68,7 +86,6 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto* output_data = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   auto element_bytes = input_tensor->DataType()->Size();
   bool is_string_type = input_tensor->IsDataTypeString();
-  int64_t output_index = 0;
 
   if (has_axis_) {
     int64_t axes_left_stride = 1;
@@ -81,42 +98,62 @@ Status Compress::Compute(OpKernelContext* ctx) const {
       axes_right_stride *= input_dimensions[i];
     }
     int64_t axes_included_right_stride = axes_right_stride * input_dimensions[axis];
-    int64_t axes_included_right_stride_bytes = axes_included_right_stride * element_bytes;
     ORT_ENFORCE(axes_right_stride >= 0 &&
                 static_cast<uint64_t>(axes_right_stride) < std::numeric_limits<size_t>::max());
     size_t axes_right_stride_bytes = 0;
     if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(axes_right_stride), element_bytes,
                                          &axes_right_stride_bytes))
       return Status(ONNXRUNTIME, FAIL, "size overflow");
-    for (int i = 0; i < axes_left_stride; ++i) {
-      for (int j = 0; j < valid_condition_length; ++j) {
-        if (!condition_data[j]) {
-          continue;
-        }
+
+    // the output is made of the slices selected along the axis, for each index before the axis
+    std::vector<int64_t> selected_indices;
+    selected_indices.reserve(static_cast<size_t>(positive_condition_count));
+    for (int64_t j = 0; j < valid_condition_length; ++j) {
+      if (condition_data[j]) {
+        selected_indices.push_back(j);
+      }
+    }
+
+    const int64_t num_slices = axes_left_stride * positive_condition_count;
+    const int64_t slices_per_block = std::max<int64_t>(
+        {1, kCompressBlockBytes / std::max<int64_t>(1, static_cast<int64_t>(axes_right_stride_bytes)),
+         num_slices / std::numeric_limits<int32_t>::max() + 1});
+    const int64_t num_slice_blocks = (num_slices + slices_per_block - 1) / slices_per_block;
+    concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_slice_blocks), [&](int32_t block) {
+      const int64_t begin = block * slices_per_block;
+      const int64_t end = std::min(begin + slices_per_block, num_slices);
+      for (int64_t slice = begin; slice < end; ++slice) {
+        const int64_t i = slice / positive_condition_count;
+        const int64_t j = selected_indices[slice % positive_condition_count];
+        const int64_t input_offset = i * axes_included_right_stride + j * axes_right_stride;
+        const int64_t output_offset = slice * axes_right_stride;
         if (is_string_type) {
-          for (int idxItem = 0; idxItem < axes_right_stride; ++idxItem) {
-            reinterpret_cast<std::string*>(output_data)[output_index + idxItem] =
-                reinterpret_cast<const std::string*>(input_data)[i * axes_included_right_stride + j * axes_right_stride + idxItem];
-          }
-          output_index += axes_right_stride;
+          const auto* input_strings = reinterpret_cast<const std::string*>(input_data) + input_offset;
+          std::copy(input_strings, input_strings + axes_right_stride,
+                    reinterpret_cast<std::string*>(output_data) + output_offset);
         } else {
-          memcpy(output_data + output_index, input_data + i * axes_included_right_stride_bytes + j * axes_right_stride_bytes, axes_right_stride_bytes);
-          output_index += axes_right_stride_bytes;
+          memcpy(output_data + output_offset * element_bytes, input_data + input_offset * element_bytes,
+                 axes_right_stride_bytes);
         }
       }
-    }
+    });
   } else {
-    for (int i = 0; i < valid_condition_length; ++i) {
-      if (!condition_data[i]) {
-        continue;
-      }
-      if (is_string_type) {
-        reinterpret_cast<std::string*>(output_data)[output_index] = reinterpret_cast<const std::string*>(input_data)[i];
-      } else {
-        memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes, element_bytes);
+    concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t block) {
+      int64_t output_index = block_offsets[block];
+      const int64_t end = std::min(valid_condition_length, (block + 1) * block_size);
+      for (int64_t i = block * block_size; i < end; ++i) {
+        if (!condition_data[i]) {
+          continue;
+        }
+        if (is_string_type) {
+          reinterpret_cast<std::string*>(output_data)[output_index] =
+              reinterpret_cast<const std::string*>(input_data)[i];
+        } else {
+          memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes, element_bytes);
+        }
+        ++output_index;
       }
-      ++output_index;
-    }
+    });
   }
 
   return Status::OK();
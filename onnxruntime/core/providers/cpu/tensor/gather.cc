@@ -4,6 +4,7 @@
 //https://github.com/onnx/onnx/blob/master/docs/Operators.md#Gather
 #include "core/providers/cpu/tensor/gather.h"
 #include "core/common/common.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
@@ -57,11 +58,12 @@ template <typename Tin>
 Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uint8_t* dst_base, bool is_string_type,
                       const size_t element_bytes, const int64_t block_size, const int64_t M,
                       const int64_t N, const int64_t data_batch_bytes, const int64_t gathered_batch_bytes,
-                      const TensorShape& input_data_shape, const int64_t axis) {
+                      const TensorShape& input_data_shape, const int64_t axis,
+                      concurrency::ThreadPool* tp) {
   const Tin* indices_data = indices_tensor->template Data<Tin>();
 
   // Check the indices first in case there's a out of bound index.
-  // We can't merge this code in the omp loop below as omp does not allow return in the loop
+  // This can't be done in the parallel loop below as it can't return an error.
   auto axis_dim_limit = input_data_shape[axis];
 
   for (int64_t i = 0; i < N; ++i) {
@@ -73,27 +75,39 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
     }
   }
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t index = 0; index < M * N; ++index) {
-    int64_t batch = index / N;
-    int64_t i = index % N;
-
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
+  auto src_row = [&](int64_t index) {
+    const int64_t batch = index / N;
+    const int64_t i = index % N;
     Tin idx = indices_data[i];
     idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
-    const int64_t src_offset = src_offset_batch + idx * block_size;
-    const int64_t dst_offset = dst_offset_batch + i * block_size;
-
-    if (is_string_type) {
-      reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-          reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
-    } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, block_size);
+    return src_base + batch * data_batch_bytes + idx * block_size;
+  };
+
+  const int64_t total_rows = M * N;
+  const int64_t rows_per_block = GatherRowsPerBlock(total_rows, block_size);
+  const int64_t num_blocks = (total_rows + rows_per_block - 1) / rows_per_block;
+
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t block) {
+    const int64_t begin = block * rows_per_block;
+    const int64_t end = std::min(begin + rows_per_block, total_rows);
+
+    for (int64_t index = begin; index < end; ++index) {
+      if (index + kGatherPrefetchDistance < end) {
+        PrefetchGatherRow(src_row(index + kGatherPrefetchDistance), static_cast<size_t>(block_size));
+      }
+
+      const uint8_t* src = src_row(index);
+      uint8_t* dst = dst_base + (index / N) * gathered_batch_bytes + (index % N) * block_size;
+
+      if (is_string_type) {
+        const auto* src_str = reinterpret_cast<const std::string*>(src);
+        auto* dst_str = reinterpret_cast<std::string*>(dst);
+        std::copy(src_str, src_str + block_size / element_bytes, dst_str);
+      } else {
+        memcpy(dst, src, block_size);
+      }
     }
-  }
+  });
 
   return Status::OK();
 }
@@ -119,11 +133,13 @@ Status Gather::Compute(OpKernelContext* context) const {
 
   if (p.indices_tensor->IsDataType<int32_t>()) {
     return GatherCopyData<int32_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis);
+                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis,
+                                   context->GetOperatorThreadPool());
   }
   if (p.indices_tensor->IsDataType<int64_t>()) {
     return GatherCopyData<int64_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis);
+                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis,
+                                   context->GetOperatorThreadPool());
   }
 
   return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Type for Tind not supported yet in Gather.");
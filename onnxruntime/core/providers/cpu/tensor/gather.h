@@ -3,12 +3,49 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/common.h"
 
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif
+
 namespace onnxruntime {
 
+// Number of rows ahead of the current row that the gather kernels prefetch. Gathered rows are read at data
+// dependent addresses, which the hardware prefetcher can't predict.
+constexpr int64_t kGatherPrefetchDistance = 8;
+
+// Minimum number of bytes copied by each thread pool task of the gather kernels.
+constexpr int64_t kGatherParallelBlockBytes = 16384;
+
+// Issues software prefetches for the leading cache lines of a row that will be read soon. Long rows only have
+// their start prefetched as the hardware prefetcher picks up the rest of a sequential read.
+inline void PrefetchGatherRow(const void* row, size_t row_bytes) {
+  const auto* p = static_cast<const char*>(row);
+  const size_t prefetch_bytes = std::min<size_t>(row_bytes, 256);
+  for (size_t offset = 0; offset < prefetch_bytes; offset += 64) {
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    _mm_prefetch(p + offset, _MM_HINT_T0);
+#elif defined(__GNUC__)
+    __builtin_prefetch(p + offset);
+#else
+    (void)p;
+#endif
+  }
+}
+
+// Returns the number of rows copied by each thread pool task when gathering 'row_count' rows of 'row_bytes' bytes.
+// The count of tasks is kept within the range of the thread pool's int32_t total.
+inline int64_t GatherRowsPerBlock(int64_t row_count, int64_t row_bytes) {
+  const int64_t rows_per_block = std::max<int64_t>(1, kGatherParallelBlockBytes / std::max<int64_t>(1, row_bytes));
+  return std::max<int64_t>(rows_per_block, row_count / std::numeric_limits<int32_t>::max() + 1);
+}
+
 class GatherBase {
  protected:
   GatherBase(const OpKernelInfo& info) {
@@ -2,7 +2,11 @@
 // Licensed under the MIT License.
 
 #include "gather_elements.h"
-#include "onnxruntime_config.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
@@ -114,32 +118,29 @@ static std::vector<int64_t> parse_and_validate_indices_tensor(const Tensor* indi
   return indices_data;
 }
 
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#ifdef HAS_CLASS_MEMACCESS
-#pragma GCC diagnostic ignored "-Wclass-memaccess"
-#endif
-#endif
-template <bool is_string, typename T>
-static void core_impl(const Tensor* input_tensor, const Tensor* indices_tensor,
-                      Tensor* output_tensor, int64_t axis) {
-  // get pointer to input data
-  // optimizer will remove the redundant if/else block based on 'is_string' template parameter
-  const T* input_data = nullptr;
-  if (is_string) {
-    input_data = input_tensor->Data<T>();
-  } else {
-    input_data = reinterpret_cast<const T*>(input_tensor->DataRaw());
-  }
+// Minimum number of output elements written by each thread pool task
+constexpr int64_t kGatherElementsParallelBlockSize = 16384;
 
-  // get pointer to output data
-  // optimizer will remove the redundant if/else block based on 'is_string' template parameter
-  T* output_data = nullptr;
-  if (is_string) {
-    output_data = output_tensor->MutableData<T>();
-  } else {
-    output_data = reinterpret_cast<T*>(output_tensor->MutableDataRaw());
+// Sets 'current_dims' to the position of 'inner_dim_index'th 'inner_dimension' chunk of 'tensor_dims'.
+// The innermost dimension value is set to 0.
+static void seek_inner_dim(std::vector<int64_t>& current_dims, const TensorShape& tensor_dims, int64_t inner_dim_index) {
+  int64_t rank = static_cast<int64_t>(current_dims.size());
+
+  current_dims[rank - 1] = 0;
+
+  for (int64_t current_axis = rank - 2; current_axis >= 0; --current_axis) {
+    current_dims[current_axis] = inner_dim_index % tensor_dims[current_axis];
+    inner_dim_index /= tensor_dims[current_axis];
   }
+}
+
+// 'T' is std::string or an unsigned integer type with the same size as the tensor element type, so that
+// the copies below are plain assignments the compiler can vectorize instead of memcpy calls of a runtime size.
+template <typename T>
+static void core_impl(const Tensor* input_tensor, const Tensor* indices_tensor,
+                      Tensor* output_tensor, int64_t axis, concurrency::ThreadPool* tp) {
+  const T* input_data = reinterpret_cast<const T*>(input_tensor->DataRaw());
+  T* output_data = reinterpret_cast<T*>(output_tensor->MutableDataRaw());
 
   const int64_t input_rank = static_cast<int64_t>(input_tensor->Shape().NumDimensions());
   const TensorPitches input_shape_pitches(*input_tensor);
@@ -147,60 +148,47 @@ static void core_impl(const Tensor* input_tensor, const Tensor* indices_tensor,
   const std::vector<int64_t>& indices_data = parse_and_validate_indices_tensor(indices_tensor, axis, input_tensor->Shape());
   const TensorShape& indices_shape = indices_tensor->Shape();
 
-  int64_t num_inner_dim = calculate_num_inner_dim(indices_shape);
-  int64_t inner_dim_size = indices_shape[input_rank - 1];
-  bool processing_inner_dim = (axis == input_rank - 1) ? true : false;
+  const int64_t num_inner_dim = calculate_num_inner_dim(indices_shape);
+  const int64_t inner_dim_size = indices_shape[input_rank - 1];
+  const bool processing_inner_dim = (axis == input_rank - 1) ? true : false;
+  const int64_t axis_pitch = input_shape_pitches[axis];
 
-  int64_t base_offset = 0;
-  int64_t indices_counter = -1;
-  int64_t output_counter = -1;
-  size_t element_size = input_tensor->DataType()->Size();
+  // each task processes a range of 'inner_dimension' chunks
+  const int64_t chunks_per_block = std::max<int64_t>(
+      std::max<int64_t>(1, kGatherElementsParallelBlockSize / std::max<int64_t>(1, inner_dim_size)),
+      num_inner_dim / std::numeric_limits<int32_t>::max() + 1);
+  const int64_t num_blocks = (num_inner_dim + chunks_per_block - 1) / chunks_per_block;
 
-  std::vector<int64_t> process_dims(input_rank, 0);
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t block) {
+    const int64_t begin = block * chunks_per_block;
+    const int64_t end = std::min(begin + chunks_per_block, num_inner_dim);
 
-  if (!processing_inner_dim) {
-    while (num_inner_dim-- != 0) {
-      base_offset = compute_base_offset(process_dims, input_shape_pitches, axis);
+    std::vector<int64_t> process_dims(input_rank, 0);
+    seek_inner_dim(process_dims, indices_shape, begin);
 
-      // process 1 chunk of 'inner dimension' length
-      for (int64_t i = 0; i < inner_dim_size; ++i) {
-        // optimizer will remove the redundant if/else block based on 'is_string' template parameter
-        if (is_string) {
-          output_data[++output_counter] = input_data[base_offset + (indices_data[++indices_counter] * input_shape_pitches[axis]) + i];
-        } else {
-          memcpy(output_data,
-                 input_data + (base_offset + (indices_data[++indices_counter] * input_shape_pitches[axis]) + i) * element_size, element_size);
-          output_data += element_size;
-        }
-      }
-
-      increment_over_inner_dim(process_dims, indices_shape);
-    }
-  }
-  // we special-case inner dim as we can weed-out some unnecessary computations in element offset calculations
-  else {
-    while (num_inner_dim-- != 0) {
-      base_offset = compute_base_offset(process_dims, input_shape_pitches, axis);
+    for (int64_t chunk = begin; chunk < end; ++chunk) {
+      const int64_t base_offset = compute_base_offset(process_dims, input_shape_pitches, axis);
+      const int64_t* chunk_indices = indices_data.data() + chunk * inner_dim_size;
+      const T* chunk_input = input_data + base_offset;
+      T* chunk_output = output_data + chunk * inner_dim_size;
 
       // process 1 chunk of 'inner dimension' length
-      for (int64_t i = 0; i < inner_dim_size; ++i) {
+      // we special-case inner dim as we can weed-out some unnecessary computations in element offset calculations
+      if (processing_inner_dim) {
         // for innermost axis, input_shape_pitches[axis] = 1 (so no need to multiply)
-        // optimizer will remove the redundant if/else block based on 'is_string' template parameter
-        if (is_string) {
-          output_data[++output_counter] = input_data[base_offset + indices_data[++indices_counter]];
-        } else {
-          memcpy(output_data, input_data + (base_offset + indices_data[++indices_counter]) * element_size, element_size);
-          output_data += element_size;
+        for (int64_t i = 0; i < inner_dim_size; ++i) {
+          chunk_output[i] = chunk_input[chunk_indices[i]];
+        }
+      } else {
+        for (int64_t i = 0; i < inner_dim_size; ++i) {
+          chunk_output[i] = chunk_input[chunk_indices[i] * axis_pitch + i];
         }
       }
 
       increment_over_inner_dim(process_dims, indices_shape);
     }
-  }
+  });
 }
-#ifdef __GNUC__
-#pragma GCC diagnostic pop
-#endif
 
 Status GatherElements::ValidateInputShapes(const TensorShape& input_data_shape,
                                            const TensorShape& indices_shape,
@@ -260,12 +248,29 @@ Status GatherElements::Compute(OpKernelContext* context) const {
   if (indices_shape.Size() == 0)
     return Status::OK();
 
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
 
-  if (input_tensor->IsDataTypeString())
-    core_impl<true, std::string>(input_tensor, indices_tensor, output_tensor, axis);
-
-  else
-    core_impl<false, int8_t>(input_tensor, indices_tensor, output_tensor, axis);
+  if (input_tensor->IsDataTypeString()) {
+    core_impl<std::string>(input_tensor, indices_tensor, output_tensor, axis, tp);
+  } else {
+    switch (input_data_type->Size()) {
+      case sizeof(uint8_t):
+        core_impl<uint8_t>(input_tensor, indices_tensor, output_tensor, axis, tp);
+        break;
+      case sizeof(uint16_t):
+        core_impl<uint16_t>(input_tensor, indices_tensor, output_tensor, axis, tp);
+        break;
+      case sizeof(uint32_t):
+        core_impl<uint32_t>(input_tensor, indices_tensor, output_tensor, axis, tp);
+        break;
+      case sizeof(uint64_t):
+        core_impl<uint64_t>(input_tensor, indices_tensor, output_tensor, axis, tp);
+        break;
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                               "GatherElements op: Element size of ", input_data_type->Size(), " is not supported");
+    }
+  }
 
   return Status::OK();
 }
@@ -3,6 +3,10 @@
 
 #include "gather_nd.h"
 
+#include <atomic>
+
+#include "core/providers/cpu/tensor/gather.h"
+
 namespace onnxruntime {
 
 // Register a kernel for kMsDomain (contrib op) GatherND
@@ -56,14 +60,11 @@ Status GatherNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) con
   std::vector<int64_t> element_counts(last_indices_dimension,
                                       0LL);  // Number of elements for each input dimension
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
   for (int64_t i = 0; i < last_indices_dimension; ++i) {
     element_counts[i] = input_shape.SizeFromDimension(i + 1);
   }
 
-  int64_t err_index = 0;
+  std::atomic<int64_t> err_index{0};
   p.element_bytes = input_tensor->DataType()->Size();
   p.element_to_copy = input_shape.SizeFromDimension(last_indices_dimension);
   p.bytes_to_copy = p.element_bytes * p.element_to_copy;
@@ -79,26 +80,33 @@ Status GatherNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) con
     p.output_base = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   }
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < offset_count; ++i) {
-    for (int64_t j = 0; j < last_indices_dimension; ++j) {
-      auto index = *(indices_data + i * last_indices_dimension + j);
-      auto upper_limit = input_shape[j];
-      auto lower_limit = -upper_limit;
-      if (index < lower_limit || index >= upper_limit) {
-        err_index = index;
-      }
-      if (index < 0) {
-        index += static_cast<Tind>(upper_limit);
-      }
-      p.element_offsets[i] += index * element_counts[j];
-    }
-  }
-
-  return err_index == 0 ? Status::OK()
-                        : ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid index found, index = ", err_index);
+  // each task computes the offsets of enough slices to copy kGatherParallelBlockBytes
+  const int64_t offsets_per_block = GatherRowsPerBlock(offset_count, static_cast<int64_t>(p.bytes_to_copy));
+  const int64_t num_blocks = (offset_count + offsets_per_block - 1) / offsets_per_block;
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<int32_t>(num_blocks), [&](int32_t block) {
+        const int64_t begin = block * offsets_per_block;
+        const int64_t end = std::min(begin + offsets_per_block, offset_count);
+        for (int64_t i = begin; i < end; ++i) {
+          for (int64_t j = 0; j < last_indices_dimension; ++j) {
+            auto index = *(indices_data + i * last_indices_dimension + j);
+            auto upper_limit = input_shape[j];
+            auto lower_limit = -upper_limit;
+            if (index < lower_limit || index >= upper_limit) {
+              err_index.store(index, std::memory_order_relaxed);
+            }
+            if (index < 0) {
+              index += static_cast<Tind>(upper_limit);
+            }
+            p.element_offsets[i] += index * element_counts[j];
+          }
+        }
+      });
+
+  const int64_t invalid_index = err_index.load();
+  return invalid_index == 0 ? Status::OK()
+                            : ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid index found, index = ", invalid_index);
 }
 
 template Status GatherNDBase::PrepareForCompute<int32_t>(OpKernelContext*, Prepare&) const;
@@ -110,30 +118,45 @@ Status GatherND::Compute(OpKernelContext* context) const {
                           ? PrepareForCompute<int32_t>(context, p)
                           : PrepareForCompute<int64_t>(context, p));
 
-  return nullptr == p.input_str_base ? GatherNumber(p) : GatherString(p);
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  return nullptr == p.input_str_base ? GatherNumber(p, tp) : GatherString(p, tp);
 }
 
-Status GatherND::GatherNumber(const Prepare& p) const {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    memcpy(p.output_base + i * p.bytes_to_copy, p.input_base + p.element_offsets[i] * p.element_bytes,
-           p.bytes_to_copy);
-  }
+Status GatherND::GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
+  const auto offset_count = static_cast<int64_t>(p.element_offsets.size());
+  const int64_t slices_per_block = GatherRowsPerBlock(offset_count, static_cast<int64_t>(p.bytes_to_copy));
+  const int64_t num_blocks = (offset_count + slices_per_block - 1) / slices_per_block;
+
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t block) {
+    const int64_t begin = block * slices_per_block;
+    const int64_t end = std::min(begin + slices_per_block, offset_count);
+    for (int64_t i = begin; i < end; ++i) {
+      if (i + kGatherPrefetchDistance < end) {
+        PrefetchGatherRow(p.input_base + p.element_offsets[i + kGatherPrefetchDistance] * p.element_bytes,
+                          static_cast<size_t>(p.bytes_to_copy));
+      }
+      memcpy(p.output_base + i * p.bytes_to_copy, p.input_base + p.element_offsets[i] * p.element_bytes,
+             p.bytes_to_copy);
+    }
+  });
 
   return Status::OK();
 }
 
-Status GatherND::GatherString(const Prepare& p) const {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    for (int64_t j = 0; j < static_cast<int64_t>(p.element_to_copy); ++j) {
-      p.output_str_base[i * p.element_to_copy + j] = p.input_str_base[p.element_offsets[i] + j];
+Status GatherND::GatherString(const Prepare& p, concurrency::ThreadPool* tp) const {
+  const auto offset_count = static_cast<int64_t>(p.element_offsets.size());
+  const int64_t slices_per_block = GatherRowsPerBlock(offset_count, static_cast<int64_t>(p.bytes_to_copy));
+  const int64_t num_blocks = (offset_count + slices_per_block - 1) / slices_per_block;
+
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t block) {
+    const int64_t begin = block * slices_per_block;
+    const int64_t end = std::min(begin + slices_per_block, offset_count);
+    for (int64_t i = begin; i < end; ++i) {
+      for (int64_t j = 0; j < static_cast<int64_t>(p.element_to_copy); ++j) {
+        p.output_str_base[i * p.element_to_copy + j] = p.input_str_base[p.element_offsets[i] + j];
+      }
     }
-  }
+  });
 
   return Status::OK();
 }
@@ -3,10 +3,13 @@
 
 #include "core/providers/cpu/tensor/nonzero_op.h"
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
+#include <numeric>
 #include <vector>
 
-#include "core/util/math_cpuonly.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 // kernel builder functions
@@ -40,32 +43,76 @@ NONZERO_TYPED_KERNEL(float)
 #undef NONZERO_TYPED_KERNEL_WITH_TYPE_NAME
 #undef NONZERO_TYPED_KERNEL
 
+namespace {
+// elements of X per block, scanned by one thread in each of the two passes
+constexpr int64_t kNonZeroBlockSize = 16 * 1024;
+}  // namespace
+
 template <typename T>
 Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto X = context->Input<Tensor>(0);
   ORT_ENFORCE(X, "X input is required!");
 
-  const auto X_shape = X->Shape();
+  const auto& X_shape = X->Shape();
   assert(X_shape.Size() >= 0);
 
-  const Eigen::Index coordinate_size = X_shape.IsScalar() ? 1 : X_shape.NumDimensions();
-  std::vector<int64_t> non_zero_indices_buffer{};
-  // reserve enough space for indices for every element of X
-  non_zero_indices_buffer.reserve(X_shape.Size() * coordinate_size);
-
+  const int64_t coordinate_size = X_shape.IsScalar() ? 1 : static_cast<int64_t>(X_shape.NumDimensions());
   const T* data = X->Data<T>();
 
   if (X_shape.IsScalar()) {
-    const T& value = *data;
-    if (value != T{}) {
-      non_zero_indices_buffer.push_back(0);
+    const int64_t num_non_zero_values = *data != T{} ? 1 : 0;
+    Tensor* const Y = context->Output(0, TensorShape{coordinate_size, num_non_zero_values});
+    ORT_ENFORCE(Y, "failed to get first output!");
+    if (num_non_zero_values != 0) {
+      *Y->MutableData<int64_t>() = 0;
+    }
+    return Status::OK();
+  }
+
+  // first pass: count the non-zero values of each block. second pass: write the coordinates of the non-zero values
+  // of each block from the offset of the block, i.e. the number of non-zero values in the blocks before it.
+  const int64_t size = X_shape.Size();
+  const int64_t block_size =
+      std::max<int64_t>(kNonZeroBlockSize, size / std::numeric_limits<int32_t>::max() + 1);
+  const int64_t num_blocks = (size + block_size - 1) / block_size;
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+
+  std::vector<int64_t> block_offsets(static_cast<size_t>(num_blocks) + 1, 0);
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t block) {
+    const T* begin = data + block * block_size;
+    const T* end = data + std::min(size, (block + 1) * block_size);
+    block_offsets[block + 1] = std::count_if(begin, end, [](const T& value) { return value != T{}; });
+  });
+  std::partial_sum(block_offsets.begin(), block_offsets.end(), block_offsets.begin());
+  const int64_t num_non_zero_values = block_offsets.back();
+
+  // the output is the transposed list of coordinates: the row d holds the coordinates along the dimension d
+  Tensor* const Y = context->Output(0, TensorShape{coordinate_size, num_non_zero_values});
+  ORT_ENFORCE(Y, "failed to get first output!");
+  if (num_non_zero_values == 0) {
+    return Status::OK();
+  }
+  int64_t* const y_data = Y->MutableData<int64_t>();
+
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t block) {
+    int64_t output_index = block_offsets[block];
+    if (output_index == block_offsets[block + 1]) {
+      return;
+    }
+
+    const int64_t begin = block * block_size;
+    const int64_t end = std::min(size, begin + block_size);
+
+    // the coordinate of the first entry of the block
+    std::vector<int64_t> coordinate(static_cast<size_t>(coordinate_size), 0);
+    for (int64_t idx = coordinate_size - 1, remainder = begin; idx >= 0 && remainder != 0; --idx) {
+      coordinate[idx] = remainder % X_shape[idx];
+      remainder /= X_shape[idx];
     }
-  } else {
-    std::vector<int64_t> coordinate(coordinate_size, 0);
 
     // as we iterate the entries, increment the coordinate for the current entry
     // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
-    auto increment_coordinate = [&coordinate, &coordinate_size, &X_shape]() {
+    auto increment_coordinate = [&coordinate, coordinate_size, &X_shape]() {
       for (int64_t idx = coordinate_size - 1; idx >= 0; --idx) {
         int64_t& cur_coord = coordinate[idx];
         if (cur_coord != X_shape[idx] - 1) {
@@ -76,32 +123,18 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
       }
     };
 
-    for (size_t i = 0, end = X_shape.Size(); i < end; ++i) {
-      const T& value = *data++;
-      if (value != T{}) {
-        non_zero_indices_buffer.insert(non_zero_indices_buffer.end(),
-                                       coordinate.begin(), coordinate.end());
+    for (int64_t i = begin; i < end; ++i) {
+      if (data[i] != T{}) {
+        for (int64_t idx = 0; idx < coordinate_size; ++idx) {
+          y_data[idx * num_non_zero_values + output_index] = coordinate[idx];
+        }
+        ++output_index;
       }
 
       increment_coordinate();
     }
-  }
-
-  const Eigen::Index num_non_zero_values = non_zero_indices_buffer.size() / coordinate_size;
-
-  // transpose result for output
-  ConstEigenMatrixMapRowMajor<int64_t> non_zero_indices_matrix{
-      non_zero_indices_buffer.data(),
-      num_non_zero_values, coordinate_size};
-
-  Tensor* const Y = context->Output(0, TensorShape{coordinate_size, num_non_zero_values});
-  ORT_ENFORCE(Y, "failed to get first output!");
-
-  EigenMatrixMapRowMajor<int64_t> y_matrix{
-      Y->MutableData<int64_t>(),
-      coordinate_size, num_non_zero_values};
-  y_matrix = non_zero_indices_matrix.transpose();
+  });
 
   return Status::OK();
-}  // namespace onnxruntime
+}
 }  // namespace onnxruntime
@@ -15,12 +15,12 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #include "core/providers/cpu/tensor/onehot.h"
-#include "core/util/eigen_common_wrapper.h"
-#include "core/platform/env.h"
 
-#ifndef EIGEN_USE_THREADS
-#define EIGEN_USE_THREADS
-#endif
+#include <algorithm>
+#include <limits>
+
+#include "core/platform/threadpool.h"
+
 using namespace ::onnxruntime::common;
 using namespace std;
 
@@ -85,39 +85,10 @@ Status ValidateInputs(const Tensor* depth,
   return Status::OK();
 }
 
-// Helper to define Tensor types given that the scalar is of type T.
-template <typename T, int NDIMS = 1, typename IndexType = Eigen::DenseIndex>
-struct EigenTensorTypes {
-  using EigenTensorMap = Eigen::TensorMap<Eigen::Tensor<T, NDIMS, Eigen::RowMajor, IndexType>, Eigen::Aligned>;
-  using ConstEigenTensorMap = Eigen::TensorMap<Eigen::Tensor<const T, NDIMS, Eigen::RowMajor, IndexType>, Eigen::Aligned>;
-  using Scalar = Eigen::TensorMap<Eigen::TensorFixedSize<T, Eigen::Sizes<>, Eigen::RowMajor, IndexType>, Eigen::Aligned>;
-  using ConstScalar = Eigen::TensorMap<Eigen::TensorFixedSize<const T, Eigen::Sizes<>, Eigen::RowMajor, IndexType>, Eigen::Aligned>;
-  using ConstMatrix = Eigen::TensorMap<Eigen::Tensor<const T, 2, Eigen::RowMajor, IndexType>, Eigen::Aligned>;
-};
-
-namespace generator {
-template <typename in_type, typename out_type>
-class OneGenerator {
- public:
-  EIGEN_DEVICE_FUNC EIGEN_ALWAYS_INLINE
-  OneGenerator(const typename EigenTensorTypes<in_type>::ConstMatrix& indices,
-               const typename EigenTensorTypes<out_type>::ConstScalar& on_value,
-               const typename EigenTensorTypes<out_type>::ConstScalar& off_value)
-      : indices_(indices), on_value_(on_value), off_value_(off_value) {}
-
-  EIGEN_DEVICE_FUNC EIGEN_ALWAYS_INLINE out_type
-  operator()(const Eigen::array<Eigen::DenseIndex, 3>& pre_depth_suff) const {
-    return (indices_(pre_depth_suff[0], pre_depth_suff[2]) == pre_depth_suff[1])
-               ? on_value_()
-               : off_value_();
-  }
-
- private:
-  const typename EigenTensorTypes<in_type>::ConstMatrix indices_;
-  const typename EigenTensorTypes<out_type>::ConstScalar on_value_;
-  const typename EigenTensorTypes<out_type>::ConstScalar off_value_;
-};
-}  // namespace generator
+namespace {
+// output elements written per block by one thread
+constexpr int64_t kOneHotBlockSize = 16 * 1024;
+}  // namespace
 
 template <typename in_type, typename out_type, typename depth_type>
 Status OneHotOp<in_type, out_type, depth_type>::Compute(OpKernelContext* p_op_kernel_context) const {
@@ -169,41 +140,54 @@ Status OneHotOp<in_type, out_type, depth_type>::Compute(OpKernelContext* p_op_ke
   }
   const int64_t suffix_dim_size = indices_shape.Size() / prefix_dim_size;
 
-  // Split indices into matrix of size prefix_dim_size x suffix_dim_size
-  Eigen::array<Eigen::DenseIndex, 2> indices_dims_e = {
-      {static_cast<Eigen::DenseIndex>(prefix_dim_size), static_cast<Eigen::DenseIndex>(suffix_dim_size)}};
-
-  // Handle negative indices. It's faster to create a new indices instead of comparing in generator
-  // since generator has much larger loops.
+  // The output is a prefix_dim_size x depth x suffix_dim_size tensor. Each work item fills a range of the suffix of
+  // one prefix with the off value for the whole depth and then writes the on value of each index of the range,
+  // so every output element is written once or twice instead of being compared to the index for each depth.
+  // Negative indices count from the end of the depth, and the indices out of [-depth, depth) select nothing.
   const auto* indices_data = indices->Data<in_type>();
-  const auto indices_size = indices_shape.Size();
-  std::vector<in_type> adjusted_indices;
-  adjusted_indices.reserve(indices_size);
-  for (int64_t i = 0; i < indices_size; ++i) {
-    if (indices_data[i] < 0)
-      adjusted_indices.push_back(indices_data[i] + static_cast<in_type>(depth_val));
-    else
-      adjusted_indices.push_back(indices_data[i]);
-  }
-  indices_data = adjusted_indices.data();
-
-  typename EigenTensorTypes<in_type, 2>::ConstEigenTensorMap indices_tensor_e(indices_data, indices_dims_e);
-
-  // Split output into 3-Tensor of size:
-  //   prefix_dim_size x depth x suffix_dim_size.
-  Eigen::array<Eigen::DenseIndex, 3> output_dims_e = {
-      {static_cast<Eigen::DenseIndex>(prefix_dim_size), static_cast<Eigen::DenseIndex>(depth_val), static_cast<Eigen::DenseIndex>(suffix_dim_size)}};
   auto* output_data = output->MutableData<out_type>();
-  typename EigenTensorTypes<out_type, 3>::EigenTensorMap output_tensor_e(output_data, output_dims_e);
-
-  typename EigenTensorTypes<out_type>::ConstScalar on_value_e(values_data + 1);
-  typename EigenTensorTypes<out_type>::ConstScalar off_value_e(values_data);
-
-  generator::OneGenerator<in_type, out_type> generator(indices_tensor_e, on_value_e, off_value_e);
-
-  // TODO potential optimization opportunity
-  // TODO figure out the eigen threadpool stuff for use here
-  output_tensor_e = output_tensor_e.generate(generator);
+  const out_type& off_value = values_data[0];
+  const out_type& on_value = values_data[1];
+
+  const int64_t suffix_block_size = std::min(suffix_dim_size, std::max<int64_t>(1, kOneHotBlockSize / depth_val));
+  const int64_t num_suffix_blocks = (suffix_dim_size + suffix_block_size - 1) / suffix_block_size;
+  const int64_t num_items = prefix_dim_size * num_suffix_blocks;
+  const int64_t items_per_block = std::max<int64_t>(
+      {1, kOneHotBlockSize / (depth_val * suffix_block_size), num_items / std::numeric_limits<int32_t>::max() + 1});
+  const int64_t num_blocks = (num_items + items_per_block - 1) / items_per_block;
+
+  concurrency::ThreadPool::TryParallelFor(
+      p_op_kernel_context->GetOperatorThreadPool(), static_cast<int32_t>(num_blocks), [&](int32_t block) {
+        const int64_t end_item = std::min(num_items, (block + 1) * items_per_block);
+        for (int64_t item = block * items_per_block; item < end_item; ++item) {
+          const int64_t prefix = item / num_suffix_blocks;
+          const int64_t suffix_begin = (item % num_suffix_blocks) * suffix_block_size;
+          const int64_t suffix_end = std::min(suffix_dim_size, suffix_begin + suffix_block_size);
+          out_type* output_prefix = output_data + prefix * depth_val * suffix_dim_size;
+
+          if (suffix_begin == 0 && suffix_end == suffix_dim_size) {
+            std::fill(output_prefix, output_prefix + depth_val * suffix_dim_size, off_value);
+          } else {
+            for (int64_t d = 0; d < depth_val; ++d) {
+              std::fill(output_prefix + d * suffix_dim_size + suffix_begin,
+                        output_prefix + d * suffix_dim_size + suffix_end, off_value);
+            }
+          }
+
+          const in_type* indices_prefix = indices_data + prefix * suffix_dim_size;
+          for (int64_t s = suffix_begin; s < suffix_end; ++s) {
+            in_type index = indices_prefix[s];
+            if (index < 0) {
+              index += static_cast<in_type>(depth_val);
+            }
+            // a non-integral index matches no position of the depth
+            if (index >= 0 && index < static_cast<in_type>(depth_val) &&
+                static_cast<in_type>(static_cast<int64_t>(index)) == index) {
+              output_prefix[static_cast<int64_t>(index) * suffix_dim_size + s] = on_value;
+            }
+          }
+        }
+      });
 
   return Status::OK();
 }
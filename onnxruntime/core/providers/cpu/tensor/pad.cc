@@ -9,6 +9,9 @@
 #endif
 #include "core/providers/cpu/tensor/pad.h"
 #include "core/providers/cpu/tensor/utils.h"
+#include "core/platform/threadpool.h"
+
+#include <algorithm>
 
 namespace onnxruntime {
 
@@ -191,65 +194,19 @@ static void ReshapePads(const std::vector<int64_t>& src_pad, size_t src_dim_coun
   reshaped_pad[inner_axis + new_dim_count] = src_pad[inner_axis + src_dim_count] * inner_no_pad_size;
 }
 
-template <typename T>
-Status PadCpuImpl(OpKernelContext* ctx,
-                  const std::vector<int64_t>& pads,
-                  const std::vector<int64_t>& slices,
-                  const Mode& mode,
-                  T value) {
-  const auto& input_tensor = *ctx->Input<Tensor>(0);
-  const auto& orig_input_shape = input_tensor.Shape();
-  std::vector<int64_t> output_dims(orig_input_shape.GetDims());
-  size_t data_rank = output_dims.size();
-
-  // make copy of raw_pads as it may be mutated below
-  ORT_ENFORCE(data_rank > 0, "Input tensor has no dimensions");
-  ORT_ENFORCE(data_rank * 2 == pads.size(), "'pads' has wrong number of values");
-
-  // Reshape input dims
-  std::vector<int64_t> reshaped_input_dims;
-  FlattenInnerShape(output_dims, pads, slices, reshaped_input_dims);
-
-  // Reshape padding
-  size_t new_dims_count = reshaped_input_dims.size();
-  size_t inner_axis = new_dims_count - 1;
-  size_t inner_no_pad_size = output_dims[inner_axis] > 0 ? reshaped_input_dims[inner_axis] / output_dims[inner_axis] : 0;
-  std::vector<int64_t> reshaped_pad(2 * new_dims_count), reshaped_slice(2 * new_dims_count);
-  ReshapePads(pads, data_rank, new_dims_count, inner_no_pad_size, reshaped_pad);
-  ReshapePads(slices, data_rank, new_dims_count, inner_no_pad_size, reshaped_slice);
-
-  std::vector<int64_t> reshaped_output_dims = reshaped_input_dims;
-  std::vector<int64_t> input_starts;
-  std::vector<int64_t> input_extents;
-
-  // Calculate output dimensions, and handle any negative padding
-  input_starts.reserve(new_dims_count);
-  input_extents.reserve(new_dims_count);
-  for (size_t i = 0; i < new_dims_count; i++) {
-    input_starts.push_back(-1 * reshaped_slice[i]);
-    input_extents.push_back(reshaped_input_dims[i] + reshaped_slice[i] + reshaped_slice[i + new_dims_count]);
-    reshaped_output_dims[i] += reshaped_pad[i] + reshaped_pad[i + new_dims_count] + reshaped_slice[i] + reshaped_slice[i + new_dims_count];
-  }
-
-  for (size_t i = 0; i < data_rank; i++) {
-    output_dims[i] += pads[i] + pads[i + data_rank] + slices[i] + slices[i + data_rank];
-  }
-
-  // special case an input with one or more dim values of 0. edge case that is easier to handle
-  // separately than to complicate all the code for normal usage.
-  if (orig_input_shape.Size() == 0) {
-    return PadInputWithDimValueOfZero(ctx, mode, orig_input_shape, output_dims, value);
-  }
+// Outputs above this size are padded across the thread pool, one slab of the outermost axis at a time
+static constexpr int64_t kParallelPadMinOutputs = 1 << 15;
 
-  TensorShape input_shape(reshaped_input_dims);
+// Pads the input into the output, streaming over the blocks of the input given by input_starts and input_extents.
+template <typename T>
+static void PadAxes(T* output, const Tensor& input_tensor, const TensorShape& input_shape,
+                    const std::vector<int64_t>& input_starts, const std::vector<int64_t>& input_extents,
+                    const std::vector<int64_t>& reshaped_pad, const TensorPitches& output_pitches,
+                    const Mode& mode, T value) {
+  const size_t new_dims_count = input_extents.size();
+  const size_t inner_axis = new_dims_count - 1;
   SliceIterator<T> input(input_tensor, input_shape, input_starts, input_extents, {});
 
-  // output_shape need to keep original.
-  TensorShape output_shape(output_dims);
-  auto& output_tensor = *ctx->Output(0, output_shape);
-  auto* output = output_tensor.template MutableData<T>();
-
-  TensorPitches output_pitches(reshaped_output_dims);
   size_t alignSkip = 0;  // Amount to skip to align to where the next input tensor data needs to be written
 
   // Initial skip, sum up the begin padding on each axis
@@ -352,6 +309,124 @@ Status PadCpuImpl(OpKernelContext* ctx,
       }
       break;
   }
+}
+
+template <typename T>
+Status PadCpuImpl(OpKernelContext* ctx,
+                  const std::vector<int64_t>& pads,
+                  const std::vector<int64_t>& slices,
+                  const Mode& mode,
+                  T value) {
+  const auto& input_tensor = *ctx->Input<Tensor>(0);
+  const auto& orig_input_shape = input_tensor.Shape();
+  std::vector<int64_t> output_dims(orig_input_shape.GetDims());
+  size_t data_rank = output_dims.size();
+
+  // make copy of raw_pads as it may be mutated below
+  ORT_ENFORCE(data_rank > 0, "Input tensor has no dimensions");
+  ORT_ENFORCE(data_rank * 2 == pads.size(), "'pads' has wrong number of values");
+
+  // Reshape input dims
+  std::vector<int64_t> reshaped_input_dims;
+  FlattenInnerShape(output_dims, pads, slices, reshaped_input_dims);
+
+  // Reshape padding
+  size_t new_dims_count = reshaped_input_dims.size();
+  size_t inner_axis = new_dims_count - 1;
+  size_t inner_no_pad_size = output_dims[inner_axis] > 0 ? reshaped_input_dims[inner_axis] / output_dims[inner_axis] : 0;
+  std::vector<int64_t> reshaped_pad(2 * new_dims_count), reshaped_slice(2 * new_dims_count);
+  ReshapePads(pads, data_rank, new_dims_count, inner_no_pad_size, reshaped_pad);
+  ReshapePads(slices, data_rank, new_dims_count, inner_no_pad_size, reshaped_slice);
+
+  std::vector<int64_t> reshaped_output_dims = reshaped_input_dims;
+  std::vector<int64_t> input_starts;
+  std::vector<int64_t> input_extents;
+
+  // Calculate output dimensions, and handle any negative padding
+  input_starts.reserve(new_dims_count);
+  input_extents.reserve(new_dims_count);
+  for (size_t i = 0; i < new_dims_count; i++) {
+    input_starts.push_back(-1 * reshaped_slice[i]);
+    input_extents.push_back(reshaped_input_dims[i] + reshaped_slice[i] + reshaped_slice[i + new_dims_count]);
+    reshaped_output_dims[i] += reshaped_pad[i] + reshaped_pad[i + new_dims_count] + reshaped_slice[i] + reshaped_slice[i + new_dims_count];
+  }
+
+  for (size_t i = 0; i < data_rank; i++) {
+    output_dims[i] += pads[i] + pads[i + data_rank] + slices[i] + slices[i + data_rank];
+  }
+
+  // special case an input with one or more dim values of 0. edge case that is easier to handle
+  // separately than to complicate all the code for normal usage.
+  if (orig_input_shape.Size() == 0) {
+    return PadInputWithDimValueOfZero(ctx, mode, orig_input_shape, output_dims, value);
+  }
+
+  TensorShape input_shape(reshaped_input_dims);
+
+  // output_shape need to keep original.
+  TensorShape output_shape(output_dims);
+  auto& output_tensor = *ctx->Output(0, output_shape);
+  auto* output = output_tensor.template MutableData<T>();
+
+  TensorPitches output_pitches(reshaped_output_dims);
+
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const int64_t num_slabs = input_extents[0];
+  if (new_dims_count == 1 || tp == nullptr || num_slabs < 2 || output_shape.Size() < kParallelPadMinOutputs) {
+    PadAxes(output, input_tensor, input_shape, input_starts, input_extents, reshaped_pad, output_pitches, mode, value);
+    return Status::OK();
+  }
+
+  // pad each slab of the input along the outermost axis into its slab of the output, across the threads. then pad
+  // the outermost axis, whose slabs are copies of the padded slabs or the constant.
+  const ptrdiff_t slab_size = output_pitches[0];
+  const int64_t pre_pad = reshaped_pad[0];
+  const int64_t post_pad = reshaped_pad[new_dims_count];
+  std::vector<int64_t> slab_pad(reshaped_pad);
+  slab_pad[0] = 0;
+  slab_pad[new_dims_count] = 0;
+
+  const auto num_batches = static_cast<int32_t>(std::min<int64_t>(num_slabs, tp->NumThreads() + 1));
+  concurrency::ThreadPool::TryBatchParallelFor(
+      tp, num_batches,
+      [&](int32_t batch) {
+        std::vector<int64_t> slab_starts(input_starts);
+        std::vector<int64_t> slab_extents(input_extents);
+        slab_extents[0] = 1;
+        for (int64_t slab = num_slabs * batch / num_batches, end = num_slabs * (batch + 1) / num_batches; slab < end;
+             ++slab) {
+          slab_starts[0] = input_starts[0] + slab;
+          PadAxes(output + (pre_pad + slab) * slab_size, input_tensor, input_shape, slab_starts, slab_extents,
+                  slab_pad, output_pitches, mode, value);
+        }
+      },
+      num_batches);
+
+  // the slab of the output that each slab of the padding of the outermost axis copies
+  auto source_slab = [&](int64_t slab) -> int64_t {
+    if (slab < pre_pad) {
+      return mode == Mode::Edge ? pre_pad : 2 * pre_pad - slab;
+    }
+    const int64_t last = pre_pad + num_slabs - 1;
+    return mode == Mode::Edge ? last : 2 * last - slab;
+  };
+
+  const auto num_pad_slabs = static_cast<int32_t>(pre_pad + post_pad);
+  if (num_pad_slabs == 0) {
+    return Status::OK();
+  }
+  concurrency::ThreadPool::TryBatchParallelFor(
+      tp, num_pad_slabs,
+      [&](int32_t i) {
+        const int64_t slab = i < pre_pad ? i : pre_pad + num_slabs + (i - pre_pad);
+        T* slab_output = output + slab * slab_size;
+        if (mode == Mode::Constant) {
+          PadAxisConstant(slab_output, value, slab_size);
+        } else {
+          std::copy_n(output + source_slab(slab) * slab_size, slab_size, slab_output);
+        }
+      },
+      0);
 
   return Status::OK();
 }
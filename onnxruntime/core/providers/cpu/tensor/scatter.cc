@@ -2,8 +2,12 @@
 // Licensed under the MIT License.
 
 //https://github.com/onnx/onnx/blob/master/docs/Operators.md#Scatter
+#include <algorithm>
+#include <limits>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 
 namespace onnxruntime {
@@ -40,9 +44,12 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("Tind", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}),
     Scatter);
 
+// updates written per block by one thread
+constexpr int64_t kScatterBlockSize = 16 * 1024;
+
 template <class Tin, class Tdata>
 Status CopyScatterData(const Tensor* data_input, const Tensor* indices_input, const Tensor* updates_input,
-                       const int64_t axis, Tensor* data_output) {
+                       const int64_t axis, Tensor* data_output, concurrency::ThreadPool* tp) {
   const TensorShape& input_data_shape = data_input->Shape();
   const Tin* indices_data_raw = indices_input->template Data<Tin>();
   const auto num_indices = indices_input->Shape().Size();
@@ -91,29 +98,14 @@ Status CopyScatterData(const Tensor* data_input, const Tensor* indices_input, co
   const auto num_dims = input_data_shape.NumDimensions();
   assert(num_dims > 0);
 
-  // Allocate and zero out counts. The input/output is of the same rank as
-  // indices/updates but the actual dimensions of indices/updates must be less or equal
-  // than that of input/output because we can update no more elements than
-  // the input contains. As we walk through the indices/updates
-  // we maintain dimension count as we will need to use it
-  // to compute output offset but using input/output dim values.
-  // We treat the whole array as a number where each element having
-  // different cardinality according to the upd_shape dimensions.
-  // As each counter reaches its max (upd_shape) it resets to zero
-  // and we carry to the more significant dim (right to left)
-  std::vector<int64_t> dim_counters(num_dims);
-
   // This vector contains number of elements under the dimension.
   // For example, for the dimensions of [4, 2, 3] the vector
   // would contain [6, 3, 1] since for each count of dim 1 it
   // contains 3 elements of dim 2.
   // For each count of dim 0 we would have 2x3=6 elements.
   // The last value is always 1.
-  // We use it to compute output element offset. For a given value of
-  // counters we multiple each counter value per corresponding entry of dim_block_size value
-  // and add up resulting the output element offset. However, for dimensions
-  // that are equal to the specified axis value we take indices_data[index]
-  // instead of the counter value.
+  // The output offset of an update is the sum of its coordinates, in the updates, multiplied by these values,
+  // except for the axis, where indices_data of the update replaces the coordinate.
   // E.g. for 3-dim and axis=0
   //    output[indices[i][j][k]][j][k] = updates[i][j][k]
   // for axis 1
@@ -130,42 +122,71 @@ Status CopyScatterData(const Tensor* data_input, const Tensor* indices_input, co
     }
   }
 
-  const auto* update_data = static_cast<const Tdata*>(updates_input->DataRaw());
-  // For every update we compute the destination offset and copy it there
-  for (int64_t index = 0; index < num_indices;) {
-    const Tin axis_idx = indices_data[index];
-
-    // Compute the offset
-    // See comments above for dim_block_size
-    size_t dst_offset = 0;
-    for (size_t i = 0; i < num_dims; ++i) {
-      if (i == size_t(axis)) {
-        // replace the counter with the update index for this dim
-        dst_offset += axis_idx * dim_block_size[i];
-      } else {
-        dst_offset += dim_counters[i] * dim_block_size[i];
+  // The updates are seen as a [outer_size, axis_size, inner_size] tensor. Only the updates of the same outer and
+  // inner coordinates can go to the same output element, so the work is split over the outer coordinates and ranges
+  // of the inner ones, and each work item writes its updates in the order of the axis, as a sequential loop would.
+  int64_t outer_size = 1;
+  for (int64_t i = 0; i < axis; ++i) {
+    outer_size *= upd_shape[i];
+  }
+  const int64_t axis_size = upd_shape[axis];
+  const int64_t inner_size = upd_shape.SizeFromDimension(axis + 1);
+  if (outer_size * axis_size * inner_size == 0) {
+    return Status::OK();
+  }
+
+  // the output offset of each inner coordinate, computed once with a counter over the inner dimensions
+  std::vector<int64_t> inner_offsets(inner_size);
+  {
+    std::vector<int64_t> dim_counters(num_dims, 0);
+    int64_t offset = 0;
+    for (int64_t s = 0; s < inner_size; ++s) {
+      inner_offsets[s] = offset;
+      for (auto i = int64_t(num_dims - 1); i > axis; --i) {
+        offset += dim_block_size[i];
+        if (++dim_counters[i] < upd_shape[i]) {
+          break;
+        }
+        offset -= dim_counters[i] * dim_block_size[i];
+        dim_counters[i] = 0;
       }
     }
+  }
 
-    dst_base[dst_offset] = update_data[index];
+  const int64_t inner_block_size = std::min(inner_size, std::max<int64_t>(1, kScatterBlockSize / axis_size));
+  const int64_t num_inner_blocks = (inner_size + inner_block_size - 1) / inner_block_size;
+  const int64_t num_items = outer_size * num_inner_blocks;
+  const int64_t items_per_block = std::max<int64_t>(
+      {1, kScatterBlockSize / (axis_size * inner_block_size),
+       num_items / std::numeric_limits<int32_t>::max() + 1});
+  const int64_t num_blocks = (num_items + items_per_block - 1) / items_per_block;
 
-    if (++index == num_indices) {
-      break;
-    }
-    // Increment counters
-    // See comments for dim_counters above
-    for (auto i = int64_t(num_dims - 1); i >= 0; --i) {
-      auto v = ++dim_counters[i];
-      assert(v <= upd_shape[i]);
-      if (v < upd_shape[i]) {
-        // No carry, done
-        break;
+  const auto* update_data = static_cast<const Tdata*>(updates_input->DataRaw());
+  const int64_t axis_block_size = dim_block_size[axis];
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t block) {
+    const int64_t end_item = std::min(num_items, (block + 1) * items_per_block);
+    for (int64_t item = block * items_per_block; item < end_item; ++item) {
+      const int64_t outer = item / num_inner_blocks;
+      const int64_t inner_begin = (item % num_inner_blocks) * inner_block_size;
+      const int64_t inner_end = std::min(inner_size, inner_begin + inner_block_size);
+
+      // the output offset of the outer coordinates
+      int64_t outer_offset = 0;
+      for (int64_t i = axis - 1, remainder = outer; i >= 0; --i) {
+        outer_offset += remainder % upd_shape[i] * dim_block_size[i];
+        remainder /= upd_shape[i];
+      }
+
+      for (int64_t k = 0; k < axis_size; ++k) {
+        const int64_t index = (outer * axis_size + k) * inner_size;
+        const Tin* axis_indices = indices_data.data() + index;
+        const Tdata* updates = update_data + index;
+        for (int64_t s = inner_begin; s < inner_end; ++s) {
+          dst_base[outer_offset + axis_indices[s] * axis_block_size + inner_offsets[s]] = updates[s];
+        }
       }
-      // No carry for the most significant dim
-      assert(i > 0);
-      dim_counters[i] = 0;
     }
-  }
+  });
   return Status::OK();
 }
 
@@ -226,9 +247,11 @@ Status Scatter::Compute(OpKernelContext* context) const {
   MLDataType Tdata_type = data_input->DataType();
   Status status;
   if (indices_input->IsDataType<int32_t>()) {
-    DispatchOnTensorTypeWithReturn(Tdata_type, status, CopyInt32Index, data_input, indices_input, updates_input, axis, data_output);
+    DispatchOnTensorTypeWithReturn(Tdata_type, status, CopyInt32Index, data_input, indices_input, updates_input, axis,
+                                   data_output, context->GetOperatorThreadPool());
   } else if (indices_input->IsDataType<int64_t>()) {
-    DispatchOnTensorTypeWithReturn(Tdata_type, status, CopyInt64Index, data_input, indices_input, updates_input, axis, data_output);
+    DispatchOnTensorTypeWithReturn(Tdata_type, status, CopyInt64Index, data_input, indices_input, updates_input, axis,
+                                   data_output, context->GetOperatorThreadPool());
   } else {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Expecting indices to be either int32_t or int64_t");
   }
@@ -3,6 +3,10 @@
 
 #include "scatter_nd.h"
 
+#include <atomic>
+
+#include "core/providers/cpu/tensor/gather.h"
+
 namespace onnxruntime {
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -83,14 +87,12 @@ Status ScatterNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) co
 
   std::vector<int64_t> element_counts(last_indice_dimension, 0LL); // Number of elements for each input dimension
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
   for (int64_t i = 0; i < last_indice_dimension; ++i) {
     element_counts[i] = input_shape.SizeFromDimension(i + 1);
   }
 
-  int64_t err_indice = 0;
+  std::atomic<bool> has_invalid_indice{false};
+  std::atomic<int64_t> err_indice{0};
   p.element_bytes    = input_tensor->DataType()->Size();
   p.element_to_copy  = input_shape.SizeFromDimension(last_indice_dimension);
   p.bytes_to_copy    = p.element_bytes * p.element_to_copy;
@@ -106,20 +108,43 @@ Status ScatterNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) co
     p.output_base     = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   }
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < offset_count; ++i) {
-    for (int64_t j = 0; j < last_indice_dimension; ++j) {
-      auto indice = *(indice_offset + i * last_indice_dimension + j);
-      if (indice < 0 || indice >= input_shape[j]) {
-        err_indice = indice;
+  // each task computes the offsets of enough slices to copy kGatherParallelBlockBytes
+  const int64_t offsets_per_block = GatherRowsPerBlock(offset_count, static_cast<int64_t>(p.bytes_to_copy));
+  const int64_t num_blocks = (offset_count + offsets_per_block - 1) / offsets_per_block;
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<int32_t>(num_blocks), [&](int32_t block) {
+        const int64_t begin = block * offsets_per_block;
+        const int64_t end = std::min(begin + offsets_per_block, offset_count);
+        for (int64_t i = begin; i < end; ++i) {
+          for (int64_t j = 0; j < last_indice_dimension; ++j) {
+            auto indice = *(indice_offset + i * last_indice_dimension + j);
+            if (indice < 0 || indice >= input_shape[j]) {
+              err_indice.store(indice, std::memory_order_relaxed);
+              has_invalid_indice.store(true, std::memory_order_relaxed);
+            }
+            p.element_offsets[i] += indice * element_counts[j];
+          }
+        }
+      });
+
+  if (has_invalid_indice.load()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid indice found, indice = ", err_indice.load());
+  }
+
+  // The slices all have p.element_to_copy elements, so two updates either go to the same slice or don't overlap.
+  if (p.element_to_copy != 0 && offset_count > 1) {
+    std::vector<bool> is_updated(static_cast<size_t>(input_shape.Size() / p.element_to_copy), false);
+    for (const auto offset : p.element_offsets) {
+      const auto slice = static_cast<size_t>(offset / p.element_to_copy);
+      if (is_updated[slice]) {
+        p.has_duplicate_offsets = true;
+        break;
       }
-      p.element_offsets[i] += indice * element_counts[j];
+      is_updated[slice] = true;
     }
   }
-  return err_indice == 0 ? Status::OK() :
-    ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid indice found, indice = ", err_indice);
+  return Status::OK();
 }
 
 template Status ScatterNDBase::PrepareForCompute<int64_t>(OpKernelContext*, Prepare&) const;
@@ -127,31 +152,60 @@ template Status ScatterNDBase::PrepareForCompute<int64_t>(OpKernelContext*, Prep
 Status ScatterND::Compute(OpKernelContext* context) const {
   Prepare p;
   ORT_RETURN_IF_ERROR(PrepareForCompute<int64_t>(context, p));
-  return nullptr == p.input_str_base ? ScatterNumber(p) : ScatterString(p);
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  return nullptr == p.input_str_base ? ScatterNumber(p, tp) : ScatterString(p, tp);
 }
 
-Status ScatterND::ScatterNumber(const Prepare& p) const {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    memcpy(p.output_base + p.element_offsets[i] * p.element_bytes,
-           p.input_base + i * p.bytes_to_copy,
-           p.bytes_to_copy);
+namespace {
+// Runs copy_slices(begin, end) on parallel blocks of the slices to update. With duplicate offsets they are all
+// copied in order on the calling thread instead, so the last update of a slice wins, as in the reference
+// implementation of the spec.
+template <typename F>
+void ForEachSliceBlock(int64_t num_slices, uint64_t bytes_per_slice, bool has_duplicate_offsets,
+                       concurrency::ThreadPool* tp, F&& copy_slices) {
+  if (has_duplicate_offsets) {
+    copy_slices(0, num_slices);
+    return;
   }
+
+  const int64_t slices_per_block = GatherRowsPerBlock(num_slices, static_cast<int64_t>(bytes_per_slice));
+  const int64_t num_blocks = (num_slices + slices_per_block - 1) / slices_per_block;
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t block) {
+    const int64_t begin = block * slices_per_block;
+    copy_slices(begin, std::min(begin + slices_per_block, num_slices));
+  });
+}
+}  // namespace
+
+Status ScatterND::ScatterNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
+  ForEachSliceBlock(static_cast<int64_t>(p.element_offsets.size()), p.bytes_to_copy, p.has_duplicate_offsets, tp,
+                    [&p](int64_t begin, int64_t end) {
+                      for (int64_t i = begin; i < end;) {
+                        // the updates are contiguous, so a run of updates to consecutive slices is one copy
+                        int64_t run_end = i + 1;
+                        while (run_end < end &&
+                               p.element_offsets[run_end] == p.element_offsets[run_end - 1] + p.element_to_copy) {
+                          ++run_end;
+                        }
+                        memcpy(p.output_base + p.element_offsets[i] * p.element_bytes,
+                               p.input_base + i * p.bytes_to_copy,
+                               (run_end - i) * p.bytes_to_copy);
+                        i = run_end;
+                      }
+                    });
   return Status::OK();
 }
 
-Status ScatterND::ScatterString(const Prepare& p) const {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    for (int64_t j = 0; j < static_cast<int64_t>(p.element_to_copy); ++j) {
-      p.output_str_base[p.element_offsets[i] + j] = p.input_str_base[i * p.element_to_copy + j];
-    }
-  }
+Status ScatterND::ScatterString(const Prepare& p, concurrency::ThreadPool* tp) const {
+  ForEachSliceBlock(static_cast<int64_t>(p.element_offsets.size()), p.bytes_to_copy, p.has_duplicate_offsets, tp,
+                    [&p](int64_t begin, int64_t end) {
+                      for (int64_t i = begin; i < end; ++i) {
+                        for (int64_t j = 0; j < static_cast<int64_t>(p.element_to_copy); ++j) {
+                          p.output_str_base[p.element_offsets[i] + j] = p.input_str_base[i * p.element_to_copy + j];
+                        }
+                      }
+                    });
   return Status::OK();
 }
 
-}
\ No newline at end of file
+}
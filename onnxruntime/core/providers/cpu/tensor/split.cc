@@ -133,6 +133,19 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
     output_dimensions[axis] = split_size;
 
     Tensor* output = context.Output(i, TensorShape{output_dimensions});
+
+    // the planner makes the output a view of its block of the input when all the dims before the axis are 1. it's
+    // created at the start of the input buffer and only needs to be moved to its block.
+    if (output->Shape().Size() > 0 && output->DataRaw() == input.DataRaw()) {
+      if (before_dims != 1) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Output ", i, " of Split is a view of the input but its data isn't "
+                               "contiguous in the input. Input shape=", input_shape, " Axis=", axis_);
+      }
+      output->SetByteOffset(input_offset * static_cast<ptrdiff_t>(sizeof(T)));
+      input_offset += split_size * after_dims_excluding_split;
+      continue;
+    }
+
     T* output_data = output->template MutableData<T>();
 
     ::onnxruntime::math::CopyMatrix<T>(
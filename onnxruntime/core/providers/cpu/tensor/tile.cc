@@ -10,9 +10,14 @@
 #endif
 
 #include "gsl/gsl"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/tile.h"
 #include "core/providers/cpu/tensor/utils.h"
 
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -38,47 +43,107 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<int64_t>()),
     Tile);
 
-Status TileCoreForFixedSizeTypes(const Tensor& input_tensor, Tensor& output_tensor, const int64_t* repeats, TensorAxisCounters& input_counters, const TensorPitches& output_pitches, size_t element_size) {
-  const auto& input_shape = input_tensor.Shape().GetDims();
-  const size_t dimension_count = input_shape.size();
-
-  const auto* input = reinterpret_cast<const uint8_t*>(input_tensor.DataRaw());
-  auto* output = reinterpret_cast<uint8_t*>(output_tensor.MutableDataRaw());
-
-  // some helper variables that will be used along the way
-  size_t block_size = 0;
-  int64_t num_repeats = 0;
-  const uint8_t* copy = nullptr;
-  const int64_t innermost_dim = input_shape[dimension_count - 1];
-
-  while (input_counters) {
-    // Copy the input data over
-    block_size = innermost_dim * element_size;
-    memcpy(output, input, block_size);
-    output += block_size;
-    input += block_size;
-
-    // Tile data for the innermost axis
-    copy = output - block_size;
-    num_repeats = repeats[dimension_count - 1] - 1;
-    for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-      memcpy(output, copy, block_size);
-      output += block_size;
+// Copies of at least this many bytes are split across the threads, in chunks of around kTileChunkBytes.
+static constexpr size_t kParallelTileMinBytes = 1 << 20;
+static constexpr size_t kTileChunkBytes = 1 << 16;
+
+// Fills the `num_copies * block_size` bytes after the block at `data` with copies of it. The copied bytes double with
+// every memcpy, so a small block repeated many times takes few calls.
+static void ReplicateBlock(uint8_t* data, size_t block_size, size_t num_copies) {
+  const size_t total = block_size * (num_copies + 1);
+  for (size_t filled = block_size; filled < total;) {
+    const size_t n = std::min(filled, total - filled);
+    memcpy(data + filled, data, n);
+    filled += n;
+  }
+}
+
+template <typename TaskFn>
+static void RunTileTasks(concurrency::ThreadPool* tp, int64_t num_tasks, size_t total_bytes, const TaskFn& task_fn) {
+  const auto num_batches = static_cast<int32_t>(tp == nullptr || total_bytes < kParallelTileMinBytes
+                                                    ? 1
+                                                    : std::min<int64_t>(num_tasks, tp->NumThreads() + 1));
+  auto compute_batch = [&](int32_t batch) {
+    for (int64_t task = num_tasks * batch / num_batches, end = num_tasks * (batch + 1) / num_batches; task < end;
+         ++task) {
+      task_fn(task);
     }
+  };
+
+  if (num_batches == 1) {
+    compute_batch(0);
+  } else {
+    concurrency::ThreadPool::TryBatchParallelFor(tp, num_batches, compute_batch, num_batches);
+  }
+}
 
-    // Tile data for other axes
-    while (input_counters.Increment()) {
-      ptrdiff_t pitch = output_pitches[input_counters.Axis()] * input_shape[input_counters.Axis()];
-      block_size = pitch * element_size;
-      copy = output - block_size;
-      num_repeats = repeats[input_counters.Axis()] - 1;
-      for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-        memcpy(output, copy, block_size);
-        output += block_size;
-      }
+void TileFixedSizeTypes(const std::vector<int64_t>& input_dims, const void* input, const int64_t* repeats,
+                        size_t element_size, void* output, concurrency::ThreadPool* tp) {
+  // drop the axes of size 1 that aren't repeated, and merge each axis that isn't repeated into the previous one, so
+  // the rows copied and the blocks replicated are as large as possible.
+  std::vector<int64_t> dims;
+  std::vector<int64_t> reps;
+  for (size_t axis = 0; axis < input_dims.size(); ++axis) {
+    if (repeats[axis] == 1 && (input_dims[axis] == 1 || !dims.empty())) {
+      if (!dims.empty()) dims.back() *= input_dims[axis];
+      continue;
     }
+    dims.push_back(input_dims[axis]);
+    reps.push_back(repeats[axis]);
+  }
+  if (dims.empty()) {
+    dims.push_back(1);
+    reps.push_back(1);
+  }
+
+  const size_t rank = dims.size();
+  std::vector<int64_t> output_pitches(rank);
+  output_pitches[rank - 1] = 1;
+  for (size_t axis = rank - 1; axis > 0; --axis) {
+    output_pitches[axis - 1] = output_pitches[axis] * dims[axis] * reps[axis];
+  }
+
+  // the offset in the output of the first copy of the block of the input at `index`, over the axes before `axis`
+  auto output_offset = [&](int64_t index, size_t axis) {
+    int64_t offset = 0;
+    for (size_t i = axis; i-- > 0;) {
+      offset += (index % dims[i]) * output_pitches[i];
+      index /= dims[i];
+    }
+    return static_cast<size_t>(offset) * element_size;
+  };
+
+  const auto* input_bytes = static_cast<const uint8_t*>(input);
+  auto* output_bytes = static_cast<uint8_t*>(output);
+
+  // copy the rows of the input to their first copy in the output
+  const int64_t num_rows = std::accumulate(dims.begin(), dims.end() - 1, int64_t{1}, std::multiplies<int64_t>());
+  const size_t row_size = static_cast<size_t>(dims[rank - 1]) * element_size;
+  RunTileTasks(tp, num_rows, num_rows * row_size, [&](int64_t row) {
+    memcpy(output_bytes + output_offset(row, rank - 1), input_bytes + row * row_size, row_size);
+  });
+
+  // then replicate the blocks of each axis, from the innermost one, so each block holds all the copies of its inner
+  // axes when it's replicated
+  for (size_t axis = rank; axis-- > 0;) {
+    if (reps[axis] == 1) continue;
+
+    const int64_t num_blocks = std::accumulate(dims.begin(), dims.begin() + axis, int64_t{1},
+                                               std::multiplies<int64_t>());
+    const size_t block_size = static_cast<size_t>(output_pitches[axis] * dims[axis]) * element_size;
+    const auto num_copies = static_cast<size_t>(reps[axis] - 1);
+    const size_t copies_per_chunk = std::max<size_t>(1, kTileChunkBytes / block_size);
+    const auto chunks_per_block = static_cast<int64_t>((num_copies + copies_per_chunk - 1) / copies_per_chunk);
+
+    RunTileTasks(tp, num_blocks * chunks_per_block, num_blocks * block_size * num_copies, [&](int64_t task) {
+      uint8_t* block = output_bytes + output_offset(task / chunks_per_block, axis);
+      const size_t first_copy = 1 + static_cast<size_t>(task % chunks_per_block) * copies_per_chunk;
+      const size_t chunk_copies = std::min(copies_per_chunk, num_copies + 1 - first_copy);
+      uint8_t* chunk = block + first_copy * block_size;
+      memcpy(chunk, block, block_size);
+      ReplicateBlock(chunk, block_size, chunk_copies - 1);
+    });
   }
-  return Status::OK();
 }
 
 Status Tile::Compute(OpKernelContext* ctx) const {
@@ -114,33 +179,13 @@ Status Tile::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
-  TensorAxisCounters input_counters(input_tensor);
-  TensorPitches output_pitches(output_tensor);
-
-  static_assert(sizeof(float) == sizeof(int32_t), "Float and Int32 are of different sizes");
-  static_assert(sizeof(double) == sizeof(int64_t), "Double and Int64 are of different sizes");
-
-  if (input_tensor.IsDataType<float>() ||
-      input_tensor.IsDataType<int32_t>() ||
-      input_tensor.IsDataType<uint32_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(float));
-
-  if (input_tensor.IsDataType<double>() || input_tensor.IsDataType<int64_t>() ||
-      input_tensor.IsDataType<uint64_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(double));
-
-  else if (input_tensor.IsDataType<int8_t>() ||
-           input_tensor.IsDataType<uint8_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int8_t));
-
-  if (input_tensor.IsDataType<int16_t>() || input_tensor.IsDataType<uint16_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int16_t));
-
-  else if (input_tensor.IsDataType<bool>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(bool));
-
-  // TODO: Support 'string' and 'float16' types for completeness
-  else
+  if (input_tensor.IsDataTypeString()) {
+    // TODO: Support 'string' and 'float16' types for completeness
     ORT_THROW("Tile doesn't have an implementation yet for the type: ", input_tensor.DataType());
+  }
+
+  TileFixedSizeTypes(input_shape.GetDims(), input_tensor.DataRaw(), repeats, input_tensor.DataType()->Size(),
+                     output_tensor.MutableDataRaw(), ctx->GetOperatorThreadPool());
+  return Status::OK();
 }
 }  // namespace onnxruntime
@@ -1,11 +1,21 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#pragma once
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}
+
+// Tiles the input, whose elements are `element_size` bytes, into the output. `repeats` has one entry per dimension of
+// the input. Expand uses it too, as a Tile of its input with the rank of the output.
+void TileFixedSizeTypes(const std::vector<int64_t>& input_dims, const void* input, const int64_t* repeats,
+                        size_t element_size, void* output, concurrency::ThreadPool* tp);
 
 struct Tile final : OpKernel {
   Tile(const OpKernelInfo& info) : OpKernel(info) {
@@ -2,7 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/transpose.h"
+
+#include <numeric>
+
 #include "core/framework/utils.h"
+#include "core/mlas/inc/mlas.h"
 namespace onnxruntime {
 
 /* A permutation [a,b,c,...] indicates that 
@@ -12,6 +16,78 @@ namespace onnxruntime {
    etc.
    */
 
+// Minimum number of bytes of the output each thread writes before another thread is used.
+static constexpr int64_t kMinBytesPerThread = 64 * 1024;
+
+// ParallelForRanges: split [0, total) into contiguous ranges and call fn(first, last) for each range on the thread
+// pool. bytes_per_item is the number of bytes of the output written for each item, and is used to keep the ranges
+// large enough to be worth a thread.
+template <typename F>
+static void ParallelForRanges(concurrency::ThreadPool* tp, int64_t total, int64_t bytes_per_item, const F& fn) {
+  int64_t num_ranges = 1;
+  if (tp != nullptr) {
+    num_ranges = std::min<int64_t>({static_cast<int64_t>(tp->NumThreads()) + 1, total,
+                                    total * bytes_per_item / kMinBytesPerThread});
+  }
+
+  if (num_ranges <= 1) {
+    fn(0, total);
+    return;
+  }
+
+  tp->ParallelFor(static_cast<int32_t>(num_ranges), [&](int32_t range) {
+    fn(total * range / num_ranges, total * (range + 1) / num_ranges);
+  });
+}
+
+// CollapseAxes: remove the axes of size 1 and merge the axes that are adjacent and in the same order in both the
+// input and the output, so the transpose is done over the fewest and largest dimensions.
+// e.g. permutations {0, 2, 3, 1} of input dims {N, C, H, W} become permutations {0, 2, 1} of dims {N, C, H*W}.
+static void CollapseAxes(const std::vector<int64_t>& input_dims, const std::vector<size_t>& permutations,
+                         std::vector<int64_t>& collapsed_dims, std::vector<size_t>& collapsed_permutations) {
+  const size_t rank = input_dims.size();
+
+  // group the output axes, skipping the axes of size 1. each group is a run of consecutive input axes.
+  std::vector<std::pair<size_t, size_t>> groups;  // first input axis and number of input axes of each group
+  for (size_t i = 0; i < rank; ++i) {
+    size_t input_axis = permutations[i];
+    if (input_dims[input_axis] == 1) {
+      continue;
+    }
+
+    if (!groups.empty()) {
+      // the previous group can be extended if it ends at the input axis just before this one, ignoring axes of size 1
+      size_t next = groups.back().first + groups.back().second;
+      while (next < input_axis && input_dims[next] == 1) {
+        ++next;
+      }
+
+      if (next == input_axis) {
+        groups.back().second = input_axis - groups.back().first + 1;
+        continue;
+      }
+    }
+
+    groups.emplace_back(input_axis, 1);
+  }
+
+  // order the groups as they appear in the input to get the collapsed input dims and permutations
+  std::vector<size_t> input_order(groups.size());
+  std::iota(input_order.begin(), input_order.end(), size_t{0});
+  std::sort(input_order.begin(), input_order.end(),
+            [&groups](size_t a, size_t b) { return groups[a].first < groups[b].first; });
+
+  collapsed_dims.resize(groups.size());
+  collapsed_permutations.resize(groups.size());
+  for (size_t i = 0; i < groups.size(); ++i) {
+    const auto& group = groups[input_order[i]];
+    collapsed_dims[i] = std::accumulate(input_dims.begin() + group.first,
+                                        input_dims.begin() + group.first + group.second,
+                                        int64_t{1}, std::multiplies<int64_t>());
+    collapsed_permutations[input_order[i]] = i;
+  }
+}
+
 // ComputeOffset: compute offset into a tensor. This is essentially the dot-product of
 // index and stride, restricted to the specified number of axes.
 static inline size_t ComputeOffset(const std::vector<int64_t>& index, const std::vector<size_t>& stride, int64_t num_axes) {
@@ -22,6 +98,18 @@ static inline size_t ComputeOffset(const std::vector<int64_t>& index, const std:
   return offset;
 }
 
+// ComputeIndex: compute the index of the entry at 'position' of the iteration-space with the specified
+// upper_bound (in lexicographic ordering), restricted to the specified number of axes.
+static inline std::vector<int64_t> ComputeIndex(int64_t position, const std::vector<int64_t>& upper_bound,
+                                                int64_t num_axes) {
+  std::vector<int64_t> index(num_axes, 0);
+  for (int64_t k = num_axes - 1; k >= 0; --k) {
+    index[k] = position % upper_bound[k];
+    position /= upper_bound[k];
+  }
+  return index;
+}
+
 // IncrementIndex: Increment an index into a tensor (in lexicographic ordering), wrapping
 // around the specified upper_bound.
 static inline void IncrementIndex(std::vector<int64_t>& index, const std::vector<int64_t>& upper_bound, int64_t num_axes) {
@@ -50,132 +138,107 @@ static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const std::s
 // The stride vector indicates the transposition.
 static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
                             size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
-                            const uint8_t* source, uint8_t* target, size_t element_size) {
+                            const uint8_t* source, uint8_t* target, size_t element_size,
+                            concurrency::ThreadPool* tp) {
   size_t blocksize = num_elts_in_block * element_size;
-  // index used to iterate over target iteration-space
-  std::vector<int64_t> target_index(num_axes, 0);
-  for (size_t i = 0; i < num_blocks; ++i) {
-    // convert target_index into an offset in source data
-    size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-    // copy
-    memcpy(target, source + source_offset * element_size, blocksize);
-
-    // increment target_index:
-    IncrementIndex(target_index, target_dims, num_axes);
-    target += blocksize;
-  }
+  ParallelForRanges(tp, num_blocks, blocksize, [&](int64_t first, int64_t last) {
+    // index used to iterate over target iteration-space
+    std::vector<int64_t> target_index = ComputeIndex(first, target_dims, num_axes);
+    uint8_t* target_block = target + first * blocksize;
+    for (int64_t i = first; i < last; ++i) {
+      // convert target_index into an offset in source data
+      size_t source_offset = ComputeOffset(target_index, stride, num_axes);
+
+      // copy
+      memcpy(target_block, source + source_offset * element_size, blocksize);
+
+      // increment target_index:
+      IncrementIndex(target_index, target_dims, num_axes);
+      target_block += blocksize;
+    }
+  });
 }
 
 static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
                             size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
-                            const std::string* source, std::string* target) {
+                            const std::string* source, std::string* target, concurrency::ThreadPool* tp) {
+  ParallelForRanges(tp, num_blocks, num_elts_in_block * sizeof(std::string), [&](int64_t first, int64_t last) {
+    // index used to iterate over target iteration-space
+    std::vector<int64_t> target_index = ComputeIndex(first, target_dims, num_axes);
+    std::string* target_block = target + first * num_elts_in_block;
+    for (int64_t i = first; i < last; ++i) {
+      // convert target_index into an offset in source data
+      size_t source_offset = ComputeOffset(target_index, stride, num_axes);
+
+      // copy
+      DoTransposeSingleBlock(num_elts_in_block, source + source_offset, target_block);
+
+      // increment target_index:
+      IncrementIndex(target_index, target_dims, num_axes);
+      target_block += num_elts_in_block;
+    }
+  });
+}
+
+// TypedDoTransposeEltWise: copies the elements [first, last) of the target, transposing elements.
+template <typename T>
+static void TypedDoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& target_dims,
+                                    int64_t first, int64_t last, const std::vector<size_t>& stride,
+                                    const T* source, T* target) {
   // index used to iterate over target iteration-space
-  std::vector<int64_t> target_index(num_axes, 0);
-  for (size_t i = 0; i < num_blocks; ++i) {
+  std::vector<int64_t> target_index = ComputeIndex(first, target_dims, num_axes);
+  target += first;
+  for (int64_t i = first; i < last; ++i) {
     // convert target_index into an offset in source data
     size_t source_offset = ComputeOffset(target_index, stride, num_axes);
 
     // copy
-    DoTransposeSingleBlock(num_elts_in_block, source + source_offset, target);
+    *target++ = source[source_offset];
 
     // increment target_index:
     IncrementIndex(target_index, target_dims, num_axes);
-    target += num_elts_in_block;
   }
 }
 
-template <class T>
-inline void CopyPrim(uint8_t* target, const uint8_t* source) {
-  *reinterpret_cast<T*>(target) = *reinterpret_cast<const T*>(source);
-}
-
 // DoTransposeEltWise: specialization of DoTranspose for the num_elts_in_block=1 case.
 // copies source tensor to target, transposing elements.
 // The stride vector indicates the transposition.
 static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& target_dims, size_t num_blocks,
                                const std::vector<size_t>& stride, const uint8_t* source, uint8_t* target,
-                               size_t element_size) {
-  // index used to iterate over target iteration-space
-  std::vector<int64_t> target_index(num_axes, 0);
-
-  switch (element_size) {
-    case sizeof(uint64_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        CopyPrim<uint64_t>(target, source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
-      break;
-    case sizeof(uint32_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        CopyPrim<uint32_t>(target, source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
-      break;
-    case sizeof(uint16_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        CopyPrim<uint16_t>(target, source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
-      break;
-    case sizeof(uint8_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        *target = *(source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
-      break;
-    default:
-      assert(false);
-  }
+                               size_t element_size, concurrency::ThreadPool* tp) {
+  ParallelForRanges(tp, num_blocks, element_size, [&](int64_t first, int64_t last) {
+    switch (element_size) {
+      case sizeof(uint64_t):
+        TypedDoTransposeEltWise(num_axes, target_dims, first, last, stride,
+                                reinterpret_cast<const uint64_t*>(source), reinterpret_cast<uint64_t*>(target));
+        break;
+      case sizeof(uint32_t):
+        TypedDoTransposeEltWise(num_axes, target_dims, first, last, stride,
+                                reinterpret_cast<const uint32_t*>(source), reinterpret_cast<uint32_t*>(target));
+        break;
+      case sizeof(uint16_t):
+        TypedDoTransposeEltWise(num_axes, target_dims, first, last, stride,
+                                reinterpret_cast<const uint16_t*>(source), reinterpret_cast<uint16_t*>(target));
+        break;
+      case sizeof(uint8_t):
+        TypedDoTransposeEltWise(num_axes, target_dims, first, last, stride, source, target);
+        break;
+      default:
+        assert(false);
+    }
+  });
 }
 
 static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& target_dims, size_t num_blocks,
-                               const std::vector<size_t>& stride, const std::string* source, std::string* target) {
-  // index used to iterate over target iteration-space
-  std::vector<int64_t> target_index(num_axes, 0);
-  for (size_t i = 0; i < num_blocks; ++i) {
-    // convert target_index into an offset in source data
-    size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-    // copy
-    *target = *(source + source_offset);
-
-    // increment target_index:
-    IncrementIndex(target_index, target_dims, num_axes);
-    target++;
-  }
+                               const std::vector<size_t>& stride, const std::string* source, std::string* target,
+                               concurrency::ThreadPool* tp) {
+  ParallelForRanges(tp, num_blocks, sizeof(std::string), [&](int64_t first, int64_t last) {
+    TypedDoTransposeEltWise(num_axes, target_dims, first, last, stride, source, target);
+  });
 }
 
-static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output) {
-  const auto& input_shape = input.Shape();
+static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const TensorShape& input_shape,
+                                 const Tensor& input, Tensor& output, concurrency::ThreadPool* tp) {
   const auto& input_dims = input_shape.GetDims();
   auto rank = input_shape.NumDimensions();
 
@@ -183,12 +246,14 @@ static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const
   const bool is_string_type = input.IsDataTypeString();
 
   std::vector<size_t> stride(rank);
+  std::vector<int64_t> target_dims(rank);
   for (size_t i = 0; i < rank; i++) {
     size_t inpdim = permutations[i];
     if (inpdim + 1 < rank)
       stride[i] = input_shape.SizeFromDimension(inpdim + 1);
     else
       stride[i] = 1;
+    target_dims[i] = input_dims[inpdim];
   }
 
   // Partition the permutation into a prefix and the largest suffix such that
@@ -215,11 +280,11 @@ static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const
     if (1 == prefix_blocksize) {
       DoTransposeSingleBlock(suffix_blocksize, input_data, output_data);
     } else if (1 == suffix_blocksize) {
-      DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                         input_data, output_data);
+      DoTransposeEltWise(num_axes_in_prefix, target_dims, prefix_blocksize, stride,
+                         input_data, output_data, tp);
     } else {
-      DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                      input_data, output_data);
+      DoTransposeImpl(num_axes_in_prefix, target_dims, prefix_blocksize, suffix_blocksize, stride,
+                      input_data, output_data, tp);
     }
   } else {
     const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
@@ -227,11 +292,11 @@ static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const
     if (1 == prefix_blocksize) {
       DoTransposeSingleBlock(suffix_blocksize, input_data, output_data, element_size);
     } else if (1 == suffix_blocksize) {
-      DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                         input_data, output_data, element_size);
+      DoTransposeEltWise(num_axes_in_prefix, target_dims, prefix_blocksize, stride,
+                         input_data, output_data, element_size, tp);
     } else {
-      DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                      input_data, output_data, element_size);
+      DoTransposeImpl(num_axes_in_prefix, target_dims, prefix_blocksize, suffix_blocksize, stride,
+                      input_data, output_data, element_size, tp);
     }
   }
 
@@ -258,42 +323,41 @@ to the value of the axis being moved.
 This can be generalized for any input where only one axis is being moved, with the block size for each read/write
 being dependent on which axis is moving, what direction it's moving in, and where it's moving to.
 
-We use simple pointer arithmetic if the size of each read/write is a power of 2 and between 8 and 64 bits. 
-We use memcpy if the block size is larger.
+If the size of each read/write is 32 or 64 bits, each loop is a transpose of a matrix of these elements and we use
+the blocked MLAS transpose. We use simple pointer arithmetic if the size is 8 or 16 bits, and memcpy if the block
+size is larger. The work is split across the threads of the thread pool if one is provided.
 
 We fall back to the default implementation in all other cases, and if the input is std::string.
 */
 
-// moving a single axis outwards where the read/write size is a power of 2 and between 8 and 64 bits.
+// moving a single axis outwards where the read/write size is 8 or 16 bits.
+// each item of [first, last) is one read of num_writers entries from the input.
 template <typename T>
 static void SimpleTransposeSingleAxisOutwards(const T* input_data, T* output_data,
-                                              int64_t num_loops, int64_t num_writers,
-                                              int64_t writes_per_loop, int64_t writes_per_writer_per_loop) {
-  for (int64_t l = 0; l < num_loops; ++l) {
-    T* output_for_first_writer = output_data;
+                                              int64_t num_writers, int64_t writes_per_writer_per_loop,
+                                              int64_t first, int64_t last) {
+  const int64_t writes_per_loop = num_writers * writes_per_writer_per_loop;
+  input_data += first * num_writers;
 
-    for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-      T* output_for_current_writer = output_for_first_writer;
+  for (int64_t i = first; i < last; ++i) {
+    const int64_t l = i / writes_per_writer_per_loop;
+    const int64_t wwpl = i % writes_per_writer_per_loop;
+    T* output_for_current_writer = output_data + l * writes_per_loop + wwpl;
 
-      for (int64_t w = 0; w < num_writers; ++w) {
-        *output_for_current_writer = *input_data++;
+    for (int64_t w = 0; w < num_writers; ++w) {
+      *output_for_current_writer = *input_data++;
 
-        // skip to output position for next writer
-        output_for_current_writer += writes_per_writer_per_loop;
-      }
-
-      ++output_for_first_writer;
+      // skip to output position for next writer
+      output_for_current_writer += writes_per_writer_per_loop;
     }
-
-    output_data += writes_per_loop;
   }
 }
 
-static void TransposeSingleAxisOutwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                        int64_t from, int64_t to) {
+static void TransposeSingleAxisOutwards(const std::vector<size_t>& permutations, const TensorShape& input_shape,
+                                        const Tensor& input, Tensor& output, int64_t from, int64_t to,
+                                        concurrency::ThreadPool* tp) {
   ORT_UNUSED_PARAMETER(permutations);
 
-  const auto& input_shape = input.Shape();
   const auto& input_dims = input_shape.GetDims();
 
   const auto element_size = input.DataType()->Size();
@@ -308,83 +372,85 @@ static void TransposeSingleAxisOutwards(const std::vector<size_t>& permutations,
   auto writes_per_writer_per_loop = int64_t(writes_per_loop / num_writers);
   const int64_t bytes_per_write = block_size * element_size;
 
+  // each loop reads a matrix of writes_per_writer_per_loop rows and num_writers columns and writes its transpose
+  const int64_t num_reads = num_loops * writes_per_writer_per_loop;
+  const int64_t bytes_per_read = num_writers * bytes_per_write;
+
   switch (bytes_per_write) {
     case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisOutwards(input_data, output_data,
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
+      ParallelForRanges(tp, num_reads, bytes_per_read, [&](int64_t first, int64_t last) {
+        SimpleTransposeSingleAxisOutwards(input_data, output_data,
+                                          num_writers, writes_per_writer_per_loop, first, last);
+      });
       break;
     }
     case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint16_t*>(input_data),
-                                        reinterpret_cast<uint16_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
+      ParallelForRanges(tp, num_reads, bytes_per_read, [&](int64_t first, int64_t last) {
+        SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint16_t*>(input_data),
+                                          reinterpret_cast<uint16_t*>(output_data),
+                                          num_writers, writes_per_writer_per_loop, first, last);
+      });
       break;
     }
     case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint32_t*>(input_data),
-                                        reinterpret_cast<uint32_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
+      MlasTranspose(reinterpret_cast<const uint32_t*>(input_data), reinterpret_cast<uint32_t*>(output_data),
+                    num_loops, writes_per_writer_per_loop, num_writers, tp);
       break;
     }
     case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint64_t*>(input_data),
-                                        reinterpret_cast<uint64_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
+      MlasTranspose(reinterpret_cast<const uint64_t*>(input_data), reinterpret_cast<uint64_t*>(output_data),
+                    num_loops, writes_per_writer_per_loop, num_writers, tp);
       break;
     }
     default: {
       // we need to use memcpy for each block
-      for (int64_t l = 0; l < num_loops; ++l) {
-        uint8_t* output_for_first_writer = output_data;
+      ParallelForRanges(tp, num_reads, bytes_per_read, [&](int64_t first, int64_t last) {
+        const uint8_t* input_for_read = input_data + first * bytes_per_read;
 
-        for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-          uint8_t* output_for_current_writer = output_for_first_writer;
+        for (int64_t i = first; i < last; ++i) {
+          const int64_t l = i / writes_per_writer_per_loop;
+          const int64_t wwpl = i % writes_per_writer_per_loop;
+          uint8_t* output_for_current_writer = output_data + (l * writes_per_loop + wwpl) * bytes_per_write;
 
           for (int64_t w = 0; w < num_writers; ++w) {
-            memcpy(output_for_current_writer, input_data, bytes_per_write);
+            memcpy(output_for_current_writer, input_for_read, bytes_per_write);
             // skip to output position for next writer
             output_for_current_writer += (writes_per_writer_per_loop * bytes_per_write);
-            input_data += bytes_per_write;
+            input_for_read += bytes_per_write;
           }
-
-          output_for_first_writer += bytes_per_write;
         }
-
-        output_data += writes_per_loop * bytes_per_write;
-      }
+      });
     }
   }
 }
 
+// moving a single axis inwards where the read/write size is 8 or 16 bits.
+// each item of [first, last) is one write of num_readers entries to the output.
 template <typename T>
 static void SimpleTransposeSingleAxisInwards(const T* input_data, T* output_data,
-                                             int64_t num_loops, int64_t num_readers,
-                                             int64_t reads_per_loop, int64_t reads_per_reader_per_loop) {
-  for (int64_t l = 0; l < num_loops; ++l) {
-    const T* input_for_first_reader = input_data;
-
-    for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-      const T* input_for_current_reader = input_for_first_reader;
-
-      for (int64_t r = 0; r < num_readers; ++r) {
-        *output_data++ = *input_for_current_reader;
-        // skip to input position for next reader
-        input_for_current_reader += reads_per_reader_per_loop;
-      }
-
-      ++input_for_first_reader;
+                                             int64_t num_readers, int64_t reads_per_reader_per_loop,
+                                             int64_t first, int64_t last) {
+  const int64_t reads_per_loop = num_readers * reads_per_reader_per_loop;
+  output_data += first * num_readers;
+
+  for (int64_t i = first; i < last; ++i) {
+    const int64_t l = i / reads_per_reader_per_loop;
+    const int64_t rrpl = i % reads_per_reader_per_loop;
+    const T* input_for_current_reader = input_data + l * reads_per_loop + rrpl;
+
+    for (int64_t r = 0; r < num_readers; ++r) {
+      *output_data++ = *input_for_current_reader;
+      // skip to input position for next reader
+      input_for_current_reader += reads_per_reader_per_loop;
     }
-
-    input_data += reads_per_loop;
   }
 }
 
-// moving a single axis inwards where the read/write size is a power of 2 and between 8 and 64 bits.
-static void TransposeSingleAxisInwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                       int64_t from, int64_t to) {
+static void TransposeSingleAxisInwards(const std::vector<size_t>& permutations, const TensorShape& input_shape,
+                                       const Tensor& input, Tensor& output, int64_t from, int64_t to,
+                                       concurrency::ThreadPool* tp) {
   ORT_UNUSED_PARAMETER(permutations);
 
-  const auto& input_shape = input.Shape();
   const auto& input_dims = input_shape.GetDims();
 
   const auto element_size = input.DataType()->Size();
@@ -399,61 +465,66 @@ static void TransposeSingleAxisInwards(const std::vector<size_t>& permutations,
   auto reads_per_reader_per_loop = int64_t(reads_per_loop / num_readers);
   const int64_t bytes_per_read = block_size * element_size;
 
+  // each loop reads a matrix of num_readers rows and reads_per_reader_per_loop columns and writes its transpose
+  const int64_t num_writes = num_loops * reads_per_reader_per_loop;
+  const int64_t bytes_per_write = num_readers * bytes_per_read;
+
   switch (bytes_per_read) {
     case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisInwards(input_data, output_data,
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+      ParallelForRanges(tp, num_writes, bytes_per_write, [&](int64_t first, int64_t last) {
+        SimpleTransposeSingleAxisInwards(input_data, output_data,
+                                         num_readers, reads_per_reader_per_loop, first, last);
+      });
       break;
     }
     case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint16_t*>(input_data),
-                                       reinterpret_cast<uint16_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+      ParallelForRanges(tp, num_writes, bytes_per_write, [&](int64_t first, int64_t last) {
+        SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint16_t*>(input_data),
+                                         reinterpret_cast<uint16_t*>(output_data),
+                                         num_readers, reads_per_reader_per_loop, first, last);
+      });
       break;
     }
     case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint32_t*>(input_data),
-                                       reinterpret_cast<uint32_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+      MlasTranspose(reinterpret_cast<const uint32_t*>(input_data), reinterpret_cast<uint32_t*>(output_data),
+                    num_loops, num_readers, reads_per_reader_per_loop, tp);
       break;
     }
     case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint64_t*>(input_data),
-                                       reinterpret_cast<uint64_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+      MlasTranspose(reinterpret_cast<const uint64_t*>(input_data), reinterpret_cast<uint64_t*>(output_data),
+                    num_loops, num_readers, reads_per_reader_per_loop, tp);
       break;
     }
     default: {
       // we need to use memcpy for each block
-      for (int64_t l = 0; l < num_loops; ++l) {
-        const uint8_t* input_for_first_reader = input_data;
+      ParallelForRanges(tp, num_writes, bytes_per_write, [&](int64_t first, int64_t last) {
+        uint8_t* output_for_write = output_data + first * bytes_per_write;
 
-        for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-          const uint8_t* input_for_current_reader = input_for_first_reader;
+        for (int64_t i = first; i < last; ++i) {
+          const int64_t l = i / reads_per_reader_per_loop;
+          const int64_t rrpl = i % reads_per_reader_per_loop;
+          const uint8_t* input_for_current_reader = input_data + (l * reads_per_loop + rrpl) * bytes_per_read;
 
           for (int64_t r = 0; r < num_readers; ++r) {
-            memcpy(output_data, input_for_current_reader, bytes_per_read);
-            output_data += bytes_per_read;
+            memcpy(output_for_write, input_for_current_reader, bytes_per_read);
+            output_for_write += bytes_per_read;
 
             // skip to input position for next reader
             input_for_current_reader += (reads_per_reader_per_loop * bytes_per_read);
           }
-
-          input_for_first_reader += bytes_per_read;
         }
-
-        input_data += reads_per_loop * bytes_per_read;
-      }
+      });
     }
   }
 }
 
-static void SingleAxisTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                size_t from, size_t to) {
+static void SingleAxisTranspose(const std::vector<size_t>& permutations, const TensorShape& input_shape,
+                                const Tensor& input, Tensor& output, size_t from, size_t to,
+                                concurrency::ThreadPool* tp) {
   if (from > to) {
-    TransposeSingleAxisOutwards(permutations, input, output, from, to);
+    TransposeSingleAxisOutwards(permutations, input_shape, input, output, from, to, tp);
   } else {
-    TransposeSingleAxisInwards(permutations, input, output, from, to);
+    TransposeSingleAxisInwards(permutations, input_shape, input, output, from, to, tp);
   }
 }
 
@@ -526,7 +597,8 @@ static bool IsMovingSingleAxis(const std::vector<size_t>& permutations, size_t&
   return single_axis_moved;
 }
 
-Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output) {
+Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
+                                  concurrency::ThreadPool* tp) {
   Status status = Status::OK();
 
   auto input_type = input.DataType();
@@ -535,15 +607,27 @@ Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const
   if (input_type != output_type) {
     status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Mismatched data types between input and output Tensors. ",
                              input_type, " != ", output_type);
-  } else {
+  } else if (input.Shape().Size() != 0) {
+    std::vector<int64_t> collapsed_dims;
+    std::vector<size_t> collapsed_permutations;
+    CollapseAxes(input.Shape().GetDims(), permutations, collapsed_dims, collapsed_permutations);
+
+    if (collapsed_dims.size() <= 1) {
+      // the order of the data doesn't change, so copy it as a single axis
+      collapsed_dims.assign(1, input.Shape().Size());
+      collapsed_permutations.assign(1, 0);
+    }
+
+    const TensorShape collapsed_shape(collapsed_dims);
+
     size_t from = 0, to = 0;
-    bool moving_single_axis = IsMovingSingleAxis(permutations, from, to);
+    bool moving_single_axis = IsMovingSingleAxis(collapsed_permutations, from, to);
 
     if (moving_single_axis && !input.IsDataTypeString()) {
-      SingleAxisTranspose(permutations, input, output, from, to);
+      SingleAxisTranspose(collapsed_permutations, collapsed_shape, input, output, from, to, tp);
     } else {
       // fall back to default implementation
-      status = DoUntypedTranspose(permutations, input, output);
+      status = DoUntypedTranspose(collapsed_permutations, collapsed_shape, input, output, tp);
     }
   }
 
@@ -571,17 +655,7 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
   if (output_shape.Size() == 0)
     return Status::OK();
 
-  size_t from = 0, to = 0;
-  bool moving_single_axis = IsMovingSingleAxis(*p_perm, from, to);
-
-  if (moving_single_axis && !X.IsDataTypeString()) {
-    SingleAxisTranspose(*p_perm, X, Y, from, to);
-  } else {
-    // fall back to default implementation
-    status = DoUntypedTranspose(*p_perm, X, Y);
-  }
-
-  return status;
+  return DoTranspose(*p_perm, X, Y, ctx->GetOperatorThreadPool());
 }
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -6,6 +6,7 @@
 #include <map>
 #include "gsl/gsl"
 #include "core/providers/common.h"
+#include "core/providers/cpu/tensor/unique_impl.h"
 
 namespace onnxruntime {
 
@@ -130,61 +131,30 @@ class Subtensor {
 };
 
 template <typename T>
-static void CreateFlattenedOutput(OpKernelContext& context,
-                                  const std::map<const T, int64_t>& offsets,         // map sorted key to unsorted idx
-                                  const std::vector<std::vector<int64_t>>& indices,  // unsorted
-                                  const std::vector<int64_t>& inverse_index,         // unsorted
-                                  bool sorted) {
-  int64_t num_unique = static_cast<int64_t>(indices.size());
+static void CreateFlattenedOutput(OpKernelContext& context, gsl::span<const T> data,
+                                  const unique_detail::FlatUniques& uniques) {
+  int64_t num_unique = static_cast<int64_t>(uniques.first_indices.size());
   Tensor& Y = *context.Output(0, TensorShape({num_unique}));
   Tensor* indices_out = context.Output(1, TensorShape({num_unique}));
-  Tensor* inverse_indices = context.Output(2, TensorShape({static_cast<int64_t>(inverse_index.size())}));
+  Tensor* inverse_indices = context.Output(2, TensorShape({static_cast<int64_t>(uniques.inverse_indices.size())}));
   Tensor* counts = context.Output(3, TensorShape({num_unique}));
 
   auto Y_data = Y.MutableDataAsSpan<T>();
-  gsl::span<int64_t> indices_data = indices_out != nullptr ? indices_out->MutableDataAsSpan<int64_t>()
-                                                           : gsl::span<int64_t>();
-  gsl::span<int64_t> inverse_indices_data = inverse_indices != nullptr ? inverse_indices->MutableDataAsSpan<int64_t>()
-                                                                       : gsl::span<int64_t>();
-  gsl::span<int64_t> counts_data = counts != nullptr ? counts->MutableDataAsSpan<int64_t>()
-                                                     : gsl::span<int64_t>();
-
-  // iterate using 'offsets' which is sorted, but contains the offset of the unsorted entry
-  auto offsets_iter = offsets.begin();
-  for (int64_t i = 0, end = num_unique; i < end; ++i, ++offsets_iter) {
-    // write sequentially if we want sorted output, use the unsorted_idx if not
-    auto unsorted_idx = offsets_iter->second;
-    auto output_idx = sorted ? i : unsorted_idx;
-
-    Y_data[output_idx] = offsets_iter->first;
-
-    if (indices_out) {
-      indices_data[output_idx] = indices[unsorted_idx].front();
-    }
+  for (int64_t i = 0; i < num_unique; ++i) {
+    Y_data[i] = data[uniques.first_indices[i]];
+  }
 
-    if (counts) {
-      counts_data[output_idx] = indices[unsorted_idx].size();
-    }
+  if (indices_out) {
+    std::copy(uniques.first_indices.cbegin(), uniques.first_indices.cend(), indices_out->MutableData<int64_t>());
   }
 
   if (inverse_indices) {
-    if (sorted) {
-      // need to convert unsorted entries in the inverse index to their sorted values
-      std::vector<int64_t> unsorted_to_sorted;
-      unsorted_to_sorted.resize(num_unique);
-      int64_t sorted_idx = 0;
-      for (const auto& offset : offsets) {
-        unsorted_to_sorted[offset.second] = sorted_idx++;
-      }
+    std::copy(uniques.inverse_indices.cbegin(), uniques.inverse_indices.cend(),
+              inverse_indices->MutableData<int64_t>());
+  }
 
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[i] = unsorted_to_sorted[inverse_index[i]];
-      }
-    } else {
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[i] = inverse_index[i];
-      }
-    }
+  if (counts) {
+    std::copy(uniques.counts.cbegin(), uniques.counts.cend(), counts->MutableData<int64_t>());
   }
 }
 
@@ -289,30 +259,9 @@ Status Unique::ComputeImpl(OpKernelContext& context) const {
   auto data = input.DataAsSpan<T>();
 
   if (flatten_) {
-    std::map<const T, int64_t> offsets;  // offset of entry in indices. provides map between sorted and unsorted values
-    std::vector<std::vector<int64_t>> indices;
-    std::vector<int64_t> inverse_index;
-
-    indices.reserve(data.size() / 2);  // arbitrary value. at worst 1 realloc but could be too large
-    inverse_index.reserve(data.size());
-
-    int64_t num_unique = 0;
-
-    for (int64_t i = 0, end = input.Shape().Size(); i < end; ++i) {
-      auto entry = offsets.find(data[i]);
-      if (entry == offsets.end()) {
-        offsets[data[i]] = num_unique;
-        inverse_index.push_back({num_unique});
-        indices.push_back({i});
-        ++num_unique;
-      } else {
-        size_t indices_idx = entry->second;
-        indices[indices_idx].push_back(i);
-        inverse_index.push_back(indices_idx);
-      }
-    }
-
-    CreateFlattenedOutput(context, offsets, indices, inverse_index, sort_);
+    unique_detail::FlatUniques uniques;
+    unique_detail::FindUniques<T>(data, sort_, context.GetOperatorThreadPool(), uniques);
+    CreateFlattenedOutput(context, data, uniques);
   } else {
     const auto& input_shape = input.Shape();
     const int64_t input_dims = static_cast<int64_t>(input_shape.NumDimensions());
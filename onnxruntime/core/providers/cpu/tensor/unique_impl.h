@@ -0,0 +1,194 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "gsl/gsl"
+#include "core/common/common.h"
+#include "core/common/flat_hash_table.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace unique_detail {
+
+// The unique values of a flat tensor, each identified by the index of its first occurrence.
+struct FlatUniques {
+  std::vector<int64_t> first_indices;    // per unique value
+  std::vector<int64_t> counts;           // per unique value
+  std::vector<int64_t> inverse_indices;  // per element, the unique value it is equal to
+};
+
+// Inputs with fewer elements are deduplicated by a single thread.
+constexpr int64_t kParallelUniqueMinElements = 65536;
+// Elements handled by each task of the passes over the whole input.
+constexpr int64_t kParallelUniqueBlockSize = 16384;
+
+// Hash table from a value of the input to the id of its unique value. Strings are referenced, not copied.
+template <typename T>
+struct UniqueTable {
+  using Key = T;
+  using Hash = std::hash<T>;
+  using Type = FlatHashTable<T, int64_t>;
+};
+
+template <>
+struct UniqueTable<std::string> {
+  using Key = std::reference_wrapper<const std::string>;
+  using Hash = std::hash<std::string>;
+  using Type = FlatHashTable<Key, int64_t, std::hash<std::string>, std::equal_to<std::string>>;
+};
+
+// Order of the sorted output. NaN isn't ordered, so it's placed after all the other floating point values.
+template <typename T>
+inline bool UniqueLess(const T& a, const T& b) {
+  return a < b;
+}
+
+inline bool UniqueLess(const float& a, const float& b) {
+  return a < b || (std::isnan(b) && !std::isnan(a));
+}
+
+inline bool UniqueLess(const double& a, const double& b) {
+  return a < b || (std::isnan(b) && !std::isnan(a));
+}
+
+// Deduplicates the elements of data whose partition is `partition` (all of them if partitions is empty),
+// appending their first indices and counts. inverse_indices are set to the ids of the uniques within the call.
+template <typename T>
+void DeduplicateRange(gsl::span<const T> data, const std::vector<uint8_t>& partitions, uint8_t partition,
+                      std::vector<int64_t>& first_indices, std::vector<int64_t>& counts,
+                      std::vector<int64_t>& inverse_indices) {
+  typename UniqueTable<T>::Type table;
+  const int64_t num_elements = static_cast<int64_t>(data.size());
+  for (int64_t i = 0; i < num_elements; ++i) {
+    if (!partitions.empty() && partitions[i] != partition) {
+      continue;
+    }
+
+    const auto result = table.Emplace(data[i], static_cast<int64_t>(first_indices.size()));
+    const int64_t id = *result.first;
+    if (result.second) {
+      first_indices.push_back(i);
+      counts.push_back(1);
+    } else {
+      ++counts[id];
+    }
+    inverse_indices[i] = id;
+  }
+}
+
+// Deduplicates data with an open-addressing hash table, so each element costs a hash and usually a single probe
+// instead of a search in a tree. The uniques are in the order of their first occurrence, or sorted if `sorted`.
+//
+// Large inputs are partitioned by hash, and each partition is deduplicated by a task of tp into its own table. As
+// a partition is scanned in order, the uniques of all the partitions are then merged by their first indices.
+template <typename T>
+void FindUniques(gsl::span<const T> data, bool sorted, concurrency::ThreadPool* tp, FlatUniques& uniques) {
+  const int64_t num_elements = static_cast<int64_t>(data.size());
+  uniques.first_indices.clear();
+  uniques.counts.clear();
+  uniques.inverse_indices.resize(data.size());
+
+  const int32_t num_blocks =
+      static_cast<int32_t>((num_elements + kParallelUniqueBlockSize - 1) / kParallelUniqueBlockSize);
+  auto for_each_block = [&](const std::function<void(int64_t, int64_t)>& fn) {
+    concurrency::ThreadPool::TryParallelFor(tp, num_blocks, [&](int32_t block) {
+      const int64_t begin = block * kParallelUniqueBlockSize;
+      fn(begin, std::min(num_elements, begin + kParallelUniqueBlockSize));
+    });
+  };
+
+  const int num_partitions = tp == nullptr || num_elements < kParallelUniqueMinElements
+                                 ? 1
+                                 : std::min(tp->NumThreads(), 256);
+  if (num_partitions <= 1) {
+    DeduplicateRange(data, {}, 0, uniques.first_indices, uniques.counts, uniques.inverse_indices);
+  } else {
+    // equal values hash to the same partition
+    std::vector<uint8_t> partitions(data.size());
+    typename UniqueTable<T>::Hash hasher;
+    for_each_block([&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        const uint64_t hash = static_cast<uint64_t>(hasher(data[i])) * 0x9E3779B97F4A7C15ULL;
+        partitions[i] = static_cast<uint8_t>((hash >> 32) % static_cast<uint64_t>(num_partitions));
+      }
+    });
+
+    std::vector<std::vector<int64_t>> partition_first_indices(num_partitions);
+    std::vector<std::vector<int64_t>> partition_counts(num_partitions);
+    concurrency::ThreadPool::TryParallelFor(tp, num_partitions, [&](int32_t p) {
+      DeduplicateRange(data, partitions, static_cast<uint8_t>(p), partition_first_indices[p], partition_counts[p],
+                       uniques.inverse_indices);
+    });
+
+    // the uniques of partition p have the ids [offsets[p], offsets[p + 1]) before the merge
+    std::vector<int64_t> offsets(num_partitions + 1, 0);
+    for (int p = 0; p < num_partitions; ++p) {
+      offsets[p + 1] = offsets[p] + static_cast<int64_t>(partition_first_indices[p].size());
+    }
+    const int64_t num_unique = offsets[num_partitions];
+
+    std::vector<std::pair<int64_t, int64_t>> first_index_and_id;
+    first_index_and_id.reserve(num_unique);
+    for (int p = 0; p < num_partitions; ++p) {
+      for (size_t u = 0; u < partition_first_indices[p].size(); ++u) {
+        first_index_and_id.emplace_back(partition_first_indices[p][u], offsets[p] + static_cast<int64_t>(u));
+      }
+    }
+    std::sort(first_index_and_id.begin(), first_index_and_id.end());
+
+    std::vector<int64_t> merged_ids(num_unique);
+    uniques.first_indices.resize(num_unique);
+    uniques.counts.resize(num_unique);
+    for (int64_t u = 0; u < num_unique; ++u) {
+      const int64_t id = first_index_and_id[u].second;
+      const auto p = std::upper_bound(offsets.begin(), offsets.end(), id) - offsets.begin() - 1;
+      merged_ids[id] = u;
+      uniques.first_indices[u] = first_index_and_id[u].first;
+      uniques.counts[u] = partition_counts[p][id - offsets[p]];
+    }
+
+    for_each_block([&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        uniques.inverse_indices[i] = merged_ids[offsets[partitions[i]] + uniques.inverse_indices[i]];
+      }
+    });
+  }
+
+  if (sorted) {
+    // only the uniques are sorted, then the ids of the elements are updated
+    const int64_t num_unique = static_cast<int64_t>(uniques.first_indices.size());
+    std::vector<int64_t> order(num_unique);
+    std::iota(order.begin(), order.end(), int64_t{0});
+    std::sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+      return UniqueLess(data[uniques.first_indices[a]], data[uniques.first_indices[b]]);
+    });
+
+    std::vector<int64_t> sorted_ids(num_unique);
+    std::vector<int64_t> sorted_first_indices(num_unique);
+    std::vector<int64_t> sorted_counts(num_unique);
+    for (int64_t u = 0; u < num_unique; ++u) {
+      sorted_ids[order[u]] = u;
+      sorted_first_indices[u] = uniques.first_indices[order[u]];
+      sorted_counts[u] = uniques.counts[order[u]];
+    }
+    uniques.first_indices.swap(sorted_first_indices);
+    uniques.counts.swap(sorted_counts);
+
+    for_each_block([&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        uniques.inverse_indices[i] = sorted_ids[uniques.inverse_indices[i]];
+      }
+    });
+  }
+}
+
+}  // namespace unique_detail
+}  // namespace onnxruntime
@@ -2,7 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/upsample.h"
-#include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
 #include <sstream>
 
 using namespace onnxruntime::common;
@@ -278,6 +278,67 @@ Status UpsampleLinear(const T* input,
   return Status::OK();
 }
 
+// Number of output values from which the rows of the output are split across the threads of the thread pool
+static constexpr int64_t kParallelResizeMinOutputs = 1 << 15;
+
+// Runs fn(first_row, end_row) over the 'num_rows' rows of the output, split in contiguous ranges across the threads
+// of the thread pool when there are enough output values.
+template <typename F>
+static void ForEachOutputRows(concurrency::ThreadPool* tp, int64_t num_rows, int64_t row_size, F&& fn) {
+  const int64_t num_batches = tp == nullptr || num_rows * row_size < kParallelResizeMinOutputs
+                                  ? 1
+                                  : std::min<int64_t>(num_rows, tp->NumThreads() + 1);
+  if (num_batches == 1) {
+    fn(0, num_rows);
+    return;
+  }
+
+  concurrency::ThreadPool::TryBatchParallelFor(
+      tp, static_cast<int32_t>(num_batches),
+      [&](int32_t batch) { fn(num_rows * batch / num_batches, num_rows * (batch + 1) / num_batches); },
+      static_cast<int32_t>(num_batches));
+}
+
+// The input coordinates each output coordinate of an axis is linearly interpolated from, with their weights.
+// Computed once per call, so the per pixel work is reduced to table lookups.
+struct LinearAxisTable {
+  std::vector<int64_t> in1;
+  std::vector<int64_t> in2;
+  std::vector<float> d1;  // distance to in1, the weight of in2
+  std::vector<float> d2;  // distance to in2, the weight of in1
+  // the output coordinates outside of the input when use_extrapolation is set
+  std::vector<int64_t> extrapolated;
+
+  void Init(int64_t input_size, int64_t output_size, float scale, float roi_start, float roi_end,
+            bool use_extrapolation, const GetOriginalCoordinateFunc& get_original_coordinate) {
+    in1.resize(output_size);
+    in2.resize(output_size);
+    d1.resize(output_size);
+    d2.resize(output_size);
+    extrapolated.clear();
+    for (int64_t o = 0; o < output_size; ++o) {
+      float in = get_original_coordinate(static_cast<float>(o), scale,
+                                         static_cast<float>(output_size), static_cast<float>(input_size),
+                                         roi_start, roi_end);
+      // when use_extrapolation is set and original index is out of the dim range
+      // then use extrapolation_value as the output value.
+      if (use_extrapolation && (in < 0 || in > static_cast<float>(input_size - 1))) {
+        extrapolated.push_back(o);
+      }
+      in = std::max(0.0f, std::min(in, static_cast<float>(input_size - 1)));
+
+      in1[o] = std::min(static_cast<int64_t>(in), input_size - 1);
+      in2[o] = std::min(in1[o] + 1, input_size - 1);
+      d1[o] = std::fabs(in - in1[o]);
+      d2[o] = std::fabs(in - in2[o]);
+      if (in1[o] == in2[o]) {
+        d1[o] = 0.5f;
+        d2[o] = 0.5f;
+      }
+    }
+  }
+};
+
 // The following method supports a 4-D input in 'Linear mode'
 // that amounts to 'Bilinear' Upsampling/Resizing in the sense that it assumes
 // the scale values for the outermost 2 dimensions are 1.
@@ -297,98 +358,115 @@ void UpsampleBilinear(int64_t batch_size,
                       float extrapolation_value,
                       const T* Xdata,
                       T* Ydata,
-                      AllocatorPtr& alloc,
+                      concurrency::ThreadPool* tp,
                       GetOriginalCoordinateFunc get_original_coordinate) {
-  std::vector<float> y_original;
-  std::vector<float> x_original;
-
-  SafeInt<size_t> idx_buffer_size = SafeInt<size_t>(2) * sizeof(int64_t) * (output_height + output_width);
-  SafeInt<size_t> scale_buffer_size = SafeInt<size_t>(2) * sizeof(float_t) * (output_height + output_width);
-  auto inx_scale_data_buffer = alloc->Alloc(idx_buffer_size + scale_buffer_size);
-  BufferUniquePtr idx_scale_data_buffer_holder(inx_scale_data_buffer, BufferDeleter(alloc));
-  auto* idx_data = static_cast<int64_t*>(idx_scale_data_buffer_holder.get());
-  int64_t* input_width_mul_y1 = idx_data;
-  int64_t* input_width_mul_y2 = idx_data + output_height;
-  int64_t* in_x1 = idx_data + 2 * output_height;
-  int64_t* in_x2 = idx_data + 2 * output_height + output_width;
-
-  auto* scale_data = reinterpret_cast<float*>(in_x2 + output_width);
-  float* dy1 = scale_data;
-  float* dy2 = scale_data + output_height;
-  float* dx1 = scale_data + 2 * output_height;
-  float* dx2 = scale_data + 2 * output_height + output_width;
-
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = get_original_coordinate(static_cast<float>(y), height_scale,
-                                         static_cast<float>(output_height), static_cast<float>(input_height),
-                                         roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    in_y = std::max(0.0f, std::min(in_y, static_cast<float>(input_height - 1)));
-
-    const int64_t in_y1 = std::min(static_cast<int64_t>(in_y), input_height - 1);
-    const int64_t in_y2 = std::min(in_y1 + 1, input_height - 1);
-    dy1[y] = std::fabs(in_y - in_y1);
-    dy2[y] = std::fabs(in_y - in_y2);
-
-    if (in_y1 == in_y2) {
-      dy1[y] = 0.5f;
-      dy2[y] = 0.5f;
-    }
-
-    input_width_mul_y1[y] = input_width * in_y1;
-    input_width_mul_y2[y] = input_width * in_y2;
+  LinearAxisTable y_table;
+  LinearAxisTable x_table;
+  y_table.Init(input_height, output_height, height_scale, roi[roi.size() / 2 - 2], roi[roi.size() - 2],
+               use_extrapolation, get_original_coordinate);
+  x_table.Init(input_width, output_width, width_scale, roi[roi.size() / 2 - 1], roi[roi.size() - 1],
+               use_extrapolation, get_original_coordinate);
+  std::vector<bool> y_extrapolated(output_height, false);
+  for (int64_t y : y_table.extrapolated) {
+    y_extrapolated[y] = true;
   }
 
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = get_original_coordinate(static_cast<float>(x), width_scale,
-                                         static_cast<float>(output_width), static_cast<float>(input_width),
-                                         roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    in_x = std::max(0.0f, std::min(in_x, static_cast<float>(input_width - 1)));
-
-    in_x1[x] = std::min(static_cast<int64_t>(in_x), input_width - 1);
-    in_x2[x] = std::min(in_x1[x] + 1, input_width - 1);
-
-    dx1[x] = std::abs(in_x - in_x1[x]);
-    dx2[x] = std::abs(in_x - in_x2[x]);
-    if (in_x1[x] == in_x2[x]) {
-      dx1[x] = 0.5f;
-      dx2[x] = 0.5f;
+  // the rows of all the images are split across the threads
+  ForEachOutputRows(tp, batch_size * num_channels * output_height, output_width, [&](int64_t first, int64_t last) {
+    for (int64_t row = first; row < last; ++row) {
+      const int64_t plane = row / output_height;
+      const int64_t y = row % output_height;
+      T* Yrow = Ydata + row * output_width;
+      if (y_extrapolated[y]) {
+        std::fill_n(Yrow, output_width, static_cast<T>(extrapolation_value));
+        continue;
+      }
+
+      const T* Xrow1 = Xdata + (plane * input_height + y_table.in1[y]) * input_width;
+      const T* Xrow2 = Xdata + (plane * input_height + y_table.in2[y]) * input_width;
+      const float dy1 = y_table.d1[y];
+      const float dy2 = y_table.d2[y];
+      const int64_t* in_x1 = x_table.in1.data();
+      const int64_t* in_x2 = x_table.in2.data();
+      const float* dx1 = x_table.d1.data();
+      const float* dx2 = x_table.d2.data();
+      for (int64_t x = 0; x < output_width; ++x) {
+        Yrow[x] = static_cast<T>(dx2[x] * dy2 * Xrow1[in_x1[x]] +
+                                 dx1[x] * dy2 * Xrow1[in_x2[x]] +
+                                 dx2[x] * dy1 * Xrow2[in_x1[x]] +
+                                 dx1[x] * dy1 * Xrow2[in_x2[x]]);
+      }
+      for (int64_t x : x_table.extrapolated) {
+        Yrow[x] = static_cast<T>(extrapolation_value);
+      }
     }
-  }
+  });
+}
 
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        for (int64_t x = 0; x < output_width; ++x) {
-          // when use_extrapolation is set and original index of x or y is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation &&
-              ((y_original[y] < 0 || y_original[y] > static_cast<float>(input_height - 1)) ||
-               (x_original[x] < 0 || x_original[x] > static_cast<float>(input_width - 1)))) {
-            Ydata[output_width * y + x] = static_cast<T>(extrapolation_value);
-            continue;
-          }
+// 'Bilinear' Upsampling/Resizing of a 4-D input of shape [N, H, W, C] with the scales
+// [1.0, height_scale, width_scale, 1.0]. The channels of a pixel are contiguous, so they are interpolated together
+// with the same weights.
+template <typename T>
+void UpsampleBilinearNhwc(int64_t batch_size,
+                          int64_t num_channels,
+                          int64_t input_height,
+                          int64_t input_width,
+                          int64_t output_height,
+                          int64_t output_width,
+                          float height_scale,
+                          float width_scale,
+                          const std::vector<float>& roi,
+                          bool use_extrapolation,
+                          float extrapolation_value,
+                          const T* Xdata,
+                          T* Ydata,
+                          concurrency::ThreadPool* tp,
+                          GetOriginalCoordinateFunc get_original_coordinate) {
+  LinearAxisTable y_table;
+  LinearAxisTable x_table;
+  y_table.Init(input_height, output_height, height_scale, roi[1], roi[roi.size() / 2 + 1],
+               use_extrapolation, get_original_coordinate);
+  x_table.Init(input_width, output_width, width_scale, roi[2], roi[roi.size() / 2 + 2],
+               use_extrapolation, get_original_coordinate);
+  std::vector<bool> y_extrapolated(output_height, false);
+  for (int64_t y : y_table.extrapolated) {
+    y_extrapolated[y] = true;
+  }
 
-          T X11 = Xdata[input_width_mul_y1[y] + in_x1[x]];
-          T X21 = Xdata[input_width_mul_y1[y] + in_x2[x]];
-          T X12 = Xdata[input_width_mul_y2[y] + in_x1[x]];
-          T X22 = Xdata[input_width_mul_y2[y] + in_x2[x]];
+  const int64_t output_row_size = output_width * num_channels;
+  ForEachOutputRows(tp, batch_size * output_height, output_row_size, [&](int64_t first, int64_t last) {
+    for (int64_t row = first; row < last; ++row) {
+      const int64_t n = row / output_height;
+      const int64_t y = row % output_height;
+      T* Yrow = Ydata + row * output_row_size;
+      if (y_extrapolated[y]) {
+        std::fill_n(Yrow, output_row_size, static_cast<T>(extrapolation_value));
+        continue;
+      }
 
-          Ydata[output_width * y + x] = static_cast<T>(dx2[x] * dy2[y] * X11 +
-                                                       dx1[x] * dy2[y] * X21 +
-                                                       dx2[x] * dy1[y] * X12 +
-                                                       dx1[x] * dy1[y] * X22);
+      const T* Xrow1 = Xdata + (n * input_height + y_table.in1[y]) * input_width * num_channels;
+      const T* Xrow2 = Xdata + (n * input_height + y_table.in2[y]) * input_width * num_channels;
+      const float dy1 = y_table.d1[y];
+      const float dy2 = y_table.d2[y];
+      for (int64_t x = 0; x < output_width; ++x) {
+        const T* X11 = Xrow1 + x_table.in1[x] * num_channels;
+        const T* X21 = Xrow1 + x_table.in2[x] * num_channels;
+        const T* X12 = Xrow2 + x_table.in1[x] * num_channels;
+        const T* X22 = Xrow2 + x_table.in2[x] * num_channels;
+        const float w11 = x_table.d2[x] * dy2;
+        const float w21 = x_table.d1[x] * dy2;
+        const float w12 = x_table.d2[x] * dy1;
+        const float w22 = x_table.d1[x] * dy1;
+        T* Ypixel = Yrow + x * num_channels;
+        for (int64_t c = 0; c < num_channels; ++c) {
+          Ypixel[c] = static_cast<T>(w11 * X11[c] + w21 * X21[c] + w12 * X12[c] + w22 * X22[c]);
         }
       }
-      Xdata += input_height * input_width;
-      Ydata += output_width * output_height;
+      for (int64_t x : x_table.extrapolated) {
+        std::fill_n(Yrow + x * num_channels, num_channels, static_cast<T>(extrapolation_value));
+      }
     }
-  }
+  });
 }
 
 // Calculates cubic coeff based on Robert Keys approach
@@ -403,45 +481,54 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
+// The 4 input coordinates each output coordinate of an axis is interpolated from, clamped to the input, with their
+// cubic coefficients. When exclude_outside is set the coefficients of the coordinates outside of the input are 0 and
+// the others are renormalized so that their sum is 1.0.
+struct CubicAxisTable {
+  std::vector<std::array<int64_t, CubicModeGridLength>> in;
+  std::vector<std::array<float, CubicModeGridLength>> coeffs;
+  // the output coordinates outside of the input when use_extrapolation is set
+  std::vector<int64_t> extrapolated;
+
+  void Init(int64_t input_size, int64_t output_size, float scale, float roi_start, float roi_end, float cubic_coeff_a,
+            bool exclude_outside, bool use_extrapolation, const GetOriginalCoordinateFunc& get_original_coordinate) {
+    in.resize(output_size);
+    coeffs.resize(output_size);
+    extrapolated.clear();
+    std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
+    for (int64_t o = 0; o < output_size; ++o) {
+      const float in_o = get_original_coordinate(static_cast<float>(o), scale,
+                                                 static_cast<float>(output_size), static_cast<float>(input_size),
+                                                 roi_start, roi_end);
+      if (use_extrapolation && (in_o < 0 || in_o > static_cast<float>(input_size - 1))) {
+        extrapolated.push_back(o);
+      }
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
+      const auto o_int = static_cast<int64_t>(std::floor(in_o));
+      const auto s = static_cast<float>(in_o - o_int);
+      auto cached = cubic_coeffs.find(s);
+      if (cached == cubic_coeffs.end()) {
+        cached = cubic_coeffs.emplace(s, GetCubicCoeffs(s, cubic_coeff_a)).first;
+      }
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[i] / coeff_sum * orig_data;
-  }
-  cache[grid_start_pos] = result;
+      float coeff_sum = 1;
+      auto& coeff = coeffs[o];
+      coeff = cached->second;
+      if (exclude_outside) {
+        coeff_sum = 0;
+        for (int64_t i = 0, val = o_int - 1; val <= o_int + 2; val++, i++) {
+          coeff[i] = (val < 0 || val >= input_size) ? 0.0f : coeff[i];
+          coeff_sum += coeff[i];
+        }
+      }
 
-  return result;
-}
+      for (int64_t i = 0, val = o_int - 1; val <= o_int + 2; val++, i++) {
+        in[o][i] = std::max(static_cast<int64_t>(0), std::min(val, input_size - 1));
+        coeff[i] /= coeff_sum;
+      }
+    }
+  }
+};
 
 template <typename T>
 void ResizeBiCubic(
@@ -460,125 +547,57 @@ void ResizeBiCubic(
     const std::vector<float>& roi,
     const T* Xdata,
     T* Ydata,
+    concurrency::ThreadPool* tp,
     GetOriginalCoordinateFunc get_original_coordinate) {
-  std::vector<float> y_original;
-  std::vector<float> x_original;
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-
-  // generate coefficients in y direction
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = get_original_coordinate(static_cast<float>(y), height_scale,
-                                         static_cast<float>(output_height), static_cast<float>(input_height),
-                                         roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[y] - std::floor(y_original[y]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
+  CubicAxisTable y_table;
+  CubicAxisTable x_table;
+  y_table.Init(input_height, output_height, height_scale, roi[roi.size() / 2 - 2], roi[roi.size() - 2], cubic_coeff_a,
+               exclude_outside, use_extrapolation, get_original_coordinate);
+  x_table.Init(input_width, output_width, width_scale, roi[roi.size() / 2 - 1], roi[roi.size() - 1], cubic_coeff_a,
+               exclude_outside, use_extrapolation, get_original_coordinate);
+  std::vector<bool> y_extrapolated(output_height, false);
+  for (int64_t y : y_table.extrapolated) {
+    y_extrapolated[y] = true;
   }
 
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = get_original_coordinate(static_cast<float>(x), width_scale,
-                                         static_cast<float>(output_width), static_cast<float>(input_width),
-                                         roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[x] - std::floor(x_original[x]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
-
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[y];
-
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
-
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[i] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[i];
-            y_coeff_sum += y_coeff_holder[i];
-          }
-        }
+  // the rows of all the images are split across the threads
+  ForEachOutputRows(tp, batch_size * num_channels * output_height, output_width, [&](int64_t first, int64_t last) {
+    // the cubic interpolation in x dimension of the 4 input rows of an output row
+    std::vector<float> x_interpolation(CubicModeGridLength * output_width);
+    for (int64_t row = first; row < last; ++row) {
+      const int64_t plane = row / output_height;
+      const int64_t y = row % output_height;
+      T* Yrow = Ydata + row * output_width;
+      if (y_extrapolated[y]) {
+        std::fill_n(Yrow, output_width, static_cast<T>(extrapolation_value));
+        continue;
+      }
 
+      // Compute cubic interpolation in x dimension using the x coefficients.
+      // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
+      for (size_t i = 0; i < CubicModeGridLength; ++i) {
+        const T* Xrow = Xdata + (plane * input_height + y_table.in[y][i]) * input_width;
+        float* x_result = x_interpolation.data() + i * output_width;
         for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[x];
-
-          // when use_extrapolation is set and original index is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
-            continue;
-          }
-
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[i] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[i];
-              x_coeff_sum += x_coeff_holder[i];
-            }
-          }
-
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[i] / y_coeff_sum;
-          }
-
-          Ydata[y * output_width + x] = static_cast<T>(result);
+          const auto& in_x = x_table.in[x];
+          const auto& coeff_x = x_table.coeffs[x];
+          x_result[x] = coeff_x[0] * Xrow[in_x[0]] + coeff_x[1] * Xrow[in_x[1]] +
+                        coeff_x[2] * Xrow[in_x[2]] + coeff_x[3] * Xrow[in_x[3]];
         }
       }
 
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
-
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
+      const auto& coeff_y = y_table.coeffs[y];
+      for (int64_t x = 0; x < output_width; ++x) {
+        Yrow[x] = static_cast<T>(coeff_y[0] * x_interpolation[x] +
+                                 coeff_y[1] * x_interpolation[output_width + x] +
+                                 coeff_y[2] * x_interpolation[2 * output_width + x] +
+                                 coeff_y[3] * x_interpolation[3 * output_width + x]);
+      }
+      for (int64_t x : x_table.extrapolated) {
+        Yrow[x] = static_cast<T>(extrapolation_value);
+      }
     }
-  }
+  });
 }
 
 template <typename T>
@@ -619,7 +638,8 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                                 get_original_coordinate_, get_nearest_pixel_);
     case UpsampleMode::LINEAR: {
       //The correct behavior of 'linear' mode for an N-D input is not clear right now,
-      //so only support 'bilinear' with 2-D or 4-D input tensor with outermost 2 scales as 1 in the 4-D case
+      //so only support 'bilinear' with 2-D or 4-D input tensor with outermost 2 scales as 1 in the 4-D case,
+      //or with the outermost and innermost scales as 1 for a 4-D input in NHWC layout
       if (dims.size() != 2 && dims.size() != 4) {
         std::ostringstream oss;
         oss << "'Linear' mode only support 2-D inputs ('Bilinear') or 4-D inputs "
@@ -628,6 +648,14 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
         return Status(ONNXRUNTIME, FAIL, oss.str());
       }
 
+      concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+      if (dims.size() == 4 && IsNhwcBilinearScales(scales)) {
+        UpsampleBilinearNhwc(dims[0], dims[3], dims[1], dims[2], output_dims[1], output_dims[2], scales[1], scales[2],
+                             roi, use_extrapolation_, extrapolation_value_, X->template Data<T>(),
+                             Y->template MutableData<T>(), tp, get_original_coordinate_);
+        return Status::OK();
+      }
+
       bool is_2D = dims.size() == 2;
       const int64_t batch_size = is_2D ? 1 : dims[0];
       const int64_t num_channels = is_2D ? 1 : dims[1];
@@ -636,12 +664,10 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
       const int64_t output_height = is_2D ? output_dims[0] : output_dims[2];
       const int64_t output_width = is_2D ? output_dims[1] : output_dims[3];
 
-      AllocatorPtr alloc;
-      ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
       UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width,
                        is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], roi,
                        use_extrapolation_, extrapolation_value_, X->template Data<T>(),
-                       Y->template MutableData<T>(), alloc, get_original_coordinate_);
+                       Y->template MutableData<T>(), tp, get_original_coordinate_);
       return Status::OK();
     }
     case UpsampleMode::CUBIC: {
@@ -656,7 +682,7 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
       ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
                     is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], cubic_coeff_a_, use_extrapolation_,
                     extrapolation_value_, exclude_outside_, roi, X->template Data<float>(), Y->template MutableData<float>(),
-                    get_original_coordinate_);
+                    context->GetOperatorThreadPool(), get_original_coordinate_);
       return Status::OK();
     }
     default:
@@ -19,6 +19,12 @@ const size_t CubicModeGridLength = 4;
 using GetNearestPixelFunc = std::function<int64_t(float, bool)>;
 using GetOriginalCoordinateFunc = std::function<float(float, float, float, float, float, float)>;
 
+// Returns true if the scales of a 4-D input in 'Linear' mode resize its 2 middle axes, as for images in NHWC layout.
+// Scales resizing the 2 innermost axes only are handled as the NCHW layout.
+inline bool IsNhwcBilinearScales(const std::vector<float>& scales) {
+  return scales.size() == 4 && scales[0] == 1 && scales[1] != 1 && scales[3] == 1;
+}
+
 enum UpsampleMode {
   NN = 0,      // nearest neighbour
   LINEAR = 1,  // linear interpolation
@@ -274,6 +280,10 @@ class UpsampleBase {
       }
     }
 
+    if (UpsampleMode::LINEAR == mode && IsNhwcBilinearScales(scales)) {
+      return;
+    }
+
     if (UpsampleMode::LINEAR == mode || UpsampleMode::CUBIC == mode) {
       ORT_ENFORCE(scales.size() == 2 || (scales.size() == 4 && scales[0] == 1 && scales[1] == 1),
                   "'Linear' mode and 'Cubic' mode only support 2-D inputs ('Bilinear', 'Bicubic') or 4-D inputs "
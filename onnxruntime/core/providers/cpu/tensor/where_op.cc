@@ -4,8 +4,10 @@
 #include "core/providers/cpu/tensor/where_op.h"
 
 #include <algorithm>
+#include <limits>
 #include <type_traits>
 
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/math/element_wise_ops.h"  // for broadcast utilities
 
 namespace onnxruntime {
@@ -164,6 +166,92 @@ MergeBroadcastLoop(TBroadcaster<T, T>* merge_broadcaster, TBroadcastOutput<T>* m
                        [](const T& x, const T& y) { return !x.empty() ? x : y; });
       });
 }
+// output elements per block of the single pass selection
+constexpr int64_t kWhereBlockSize = 16 * 1024;
+
+// Whether each input either has the shape of the output or holds a single element of a rank not above it, e.g. a
+// condition and an X of the same shape with a scalar Y. If so the output shape is set.
+bool HasElementwiseShapes(const TensorShape& condition_shape, const TensorShape& X_shape, const TensorShape& Y_shape,
+                          TensorShape& output_shape) {
+  const TensorShape* shapes[] = {&condition_shape, &X_shape, &Y_shape};
+  const TensorShape* full_shape = nullptr;
+  for (const TensorShape* shape : shapes) {
+    if (shape->Size() != 1) {
+      full_shape = shape;
+      break;
+    }
+    if (full_shape == nullptr || shape->NumDimensions() > full_shape->NumDimensions()) {
+      full_shape = shape;
+    }
+  }
+
+  for (const TensorShape* shape : shapes) {
+    if (*shape != *full_shape &&
+        (shape->Size() != 1 || shape->NumDimensions() > full_shape->NumDimensions())) {
+      return false;
+    }
+  }
+  output_shape = *full_shape;
+  return true;
+}
+
+// The indices are compile time constants for the single element inputs, so the loop compiles to vector blends for
+// the arithmetic types.
+template <typename T, bool X_is_scalar, bool Y_is_scalar>
+void SelectElementwise(const bool* condition, const T* X, const T* Y, T* output, int64_t begin, int64_t end) {
+  for (int64_t i = begin; i < end; ++i) {
+    output[i] = condition[i] ? X[X_is_scalar ? 0 : i] : Y[Y_is_scalar ? 0 : i];
+  }
+}
+
+// Writes the output in a single parallel pass when no input needs broadcasting beyond a single element.
+template <typename T>
+bool TrySelectElementwise(const Tensor& condition, const Tensor& X, const Tensor& Y, OpKernelContext& context) {
+  TensorShape output_shape;
+  if (!HasElementwiseShapes(condition.Shape(), X.Shape(), Y.Shape(), output_shape)) {
+    return false;
+  }
+
+  Tensor* const output = context.Output(0, output_shape);
+  ORT_ENFORCE(output, "failed to get first output!");
+  const int64_t size = output_shape.Size();
+  if (size == 0) {
+    return true;
+  }
+
+  const bool* condition_data = condition.template Data<bool>();
+  const T* X_data = X.template Data<T>();
+  const T* Y_data = Y.template Data<T>();
+  T* output_data = output->template MutableData<T>();
+  const bool condition_is_scalar = condition.Shape().Size() == 1 && size != 1;
+  const bool X_is_scalar = X.Shape().Size() == 1;
+  const bool Y_is_scalar = Y.Shape().Size() == 1;
+
+  const int64_t block_size = std::max<int64_t>(kWhereBlockSize, size / std::numeric_limits<int32_t>::max() + 1);
+  const int64_t num_blocks = (size + block_size - 1) / block_size;
+  concurrency::ThreadPool::TryParallelFor(
+      context.GetOperatorThreadPool(), static_cast<int32_t>(num_blocks), [&](int32_t block) {
+        const int64_t begin = block * block_size;
+        const int64_t end = std::min(size, begin + block_size);
+        if (condition_is_scalar) {
+          const T* source = *condition_data ? X_data : Y_data;
+          if (*condition_data ? X_is_scalar : Y_is_scalar) {
+            std::fill(output_data + begin, output_data + end, *source);
+          } else {
+            std::copy(source + begin, source + end, output_data + begin);
+          }
+        } else if (X_is_scalar && Y_is_scalar) {
+          SelectElementwise<T, true, true>(condition_data, X_data, Y_data, output_data, begin, end);
+        } else if (X_is_scalar) {
+          SelectElementwise<T, true, false>(condition_data, X_data, Y_data, output_data, begin, end);
+        } else if (Y_is_scalar) {
+          SelectElementwise<T, false, true>(condition_data, X_data, Y_data, output_data, begin, end);
+        } else {
+          SelectElementwise<T, false, false>(condition_data, X_data, Y_data, output_data, begin, end);
+        }
+      });
+  return true;
+}
 }  // namespace
 
 template <typename T>
@@ -173,7 +261,11 @@ Status Where<T>::Compute(OpKernelContext* context) const {
   const auto* const Y = context->Input<Tensor>(2);
   ORT_ENFORCE(condition && X && Y, "condition, X, and Y inputs are required!");
 
-  // The current implementation is limited to broadcasting over two tensors at once.
+  if (TrySelectElementwise<T>(*condition, *X, *Y, *context)) {
+    return Status::OK();
+  }
+
+  // Otherwise the implementation is limited to broadcasting over two tensors at once.
   // So, we first broadcast over condition and X to select the values from X:
   //   X_selection = condition ? X : default value
   // Similarly, we broadcast over condition and Y to select the values from Y:
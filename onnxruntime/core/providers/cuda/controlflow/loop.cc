@@ -3,6 +3,7 @@
 
 #include "core/providers/cuda/controlflow/loop.h"
 #include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/cuda_execution_provider.h"
 
 using namespace ONNX_NAMESPACE;
 using namespace onnxruntime::common;
@@ -64,8 +65,58 @@ static Status ConcatenateGpuOutput(std::vector<OrtValue>& per_iteration_output,
   return Status::OK();
 }
 
+namespace {
+// the copy of a 'cond' output to pinned memory, done when the event recorded after it is
+struct ConditionCopy {
+  IAllocatorUniquePtr<bool> host_value;
+  cudaEvent_t event = nullptr;
+
+  ~ConditionCopy() {
+    if (event != nullptr) {
+      cudaEventDestroy(event);
+    }
+  }
+};
+}  // namespace
+
+// copies 'cond' on the stream of the kernels, so waiting for it doesn't wait for the kernels launched after it,
+// i.e. the next iteration
+static Status StartConditionRead(const AllocatorPtr& pinned_allocator, const Tensor& cond,
+                                 std::function<Status(bool& value)>& wait) {
+  if (cond.Location().device.Type() == OrtDevice::CPU) {
+    const bool value = *cond.Data<bool>();
+    wait = [value](bool& result) {
+      result = value;
+      return Status::OK();
+    };
+    return Status::OK();
+  }
+
+  auto copy = std::make_shared<ConditionCopy>();
+  copy->host_value = IAllocator::MakeUniquePtr<bool>(pinned_allocator, 1);
+  CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&copy->event, cudaEventDisableTiming));
+  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(copy->host_value.get(), cond.Data<bool>(), sizeof(bool),
+                                       cudaMemcpyDeviceToHost, cudaStreamPerThread));
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(copy->event, cudaStreamPerThread));
+
+  wait = [copy](bool& result) {
+    CUDA_RETURN_IF_ERROR(cudaEventSynchronize(copy->event));
+    result = *copy->host_value;
+    return Status::OK();
+  };
+  return Status::OK();
+}
+
 Loop::Loop(const OpKernelInfo& info) : onnxruntime::Loop(info) {
   SetConcatOutputFunc(ConcatenateGpuOutput);
+
+  const auto* provider = static_cast<const CUDAExecutionProvider*>(info.GetExecutionProvider());
+  if (provider->IsSpeculativeLoopEnabled()) {
+    auto pinned_allocator = provider->GetAllocator(CPU_ALLOCATOR_DEVICE_ID, OrtMemTypeCPUOutput);
+    SetStartConditionReadFunc([pinned_allocator](const Tensor& cond, std::function<Status(bool& value)>& wait) {
+      return StartConditionRead(pinned_allocator, cond, wait);
+    });
+  }
 }
 
 Status Loop::Compute(OpKernelContext* ctx) const {
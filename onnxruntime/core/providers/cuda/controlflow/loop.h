@@ -9,7 +9,8 @@
 namespace onnxruntime {
 namespace cuda {
 
-// Use the CPU implementation for the logic
+// Use the CPU implementation for the logic. With CUDAExecutionProviderInfo::enable_speculative_loop, the 'cond'
+// output of the body stays on the device and is read while the next iteration runs.
 class Loop final : public onnxruntime::Loop {
  public:
   Loop(const OpKernelInfo& info);
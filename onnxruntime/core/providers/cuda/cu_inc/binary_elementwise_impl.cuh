@@ -177,6 +177,157 @@ __global__ void _BinaryElementWiseRhsPerChannelBatchN(
   }
 }
 
+// The vectorized kernels: each thread handles VecSize consecutive output elements, read and written with 16 byte
+// vector instructions, see AlignedVector. The pointers read or written as vectors must be aligned to the vector size.
+
+// for scalar broadcast or non-broadcast case. the partial vector at the end is handled element by element.
+template <bool IncL, bool IncR, typename T, typename FuncT, int NumThreadsPerBlock, int VecSize>
+__global__ void _BinaryElementWiseSimpleVectorized(
+    const T* lhs_data,
+    const T* rhs_data,
+    T* output_data,
+    FuncT func,
+    CUDA_LONG N) {
+  using VecT = AlignedVector<T, VecSize>;
+  CUDA_LONG id = (NumThreadsPerBlock * blockIdx.x + threadIdx.x) * VecSize;
+  if (id >= N)
+    return;
+
+  if (id + VecSize <= N) {
+    const T lscalar = IncL ? T() : lhs_data[0];
+    const T rscalar = IncR ? T() : rhs_data[0];
+    const VecT lvalue = IncL ? *reinterpret_cast<const VecT*>(&lhs_data[id]) : VecT();
+    const VecT rvalue = IncR ? *reinterpret_cast<const VecT*>(&rhs_data[id]) : VecT();
+    VecT output;
+#pragma unroll
+    for (int i = 0; i < VecSize; i++) {
+      output.val[i] = func(IncL ? lvalue.val[i] : lscalar, IncR ? rvalue.val[i] : rscalar);
+    }
+    *reinterpret_cast<VecT*>(&output_data[id]) = output;
+  } else {
+    for (; id < N; id++) {
+      output_data[id] = func(lhs_data[IncL ? id : 0], rhs_data[IncR ? id : 0]);
+    }
+  }
+}
+
+// for rhs broadcast along the last axis, out[id] = op(lhs[id], rhs[id % C]). C is a multiple of VecSize, so a vector
+// doesn't cross the end of rhs and N has no partial vector.
+template <typename T, typename FuncT, int NumThreadsPerBlock, int VecSize>
+__global__ void _BinaryElementWiseRhsRowVectorized(
+    const T* lhs_data,
+    const T* rhs_data,
+    const fast_divmod fdm_C,
+    T* output_data,
+    FuncT func,
+    CUDA_LONG N) {
+  using VecT = AlignedVector<T, VecSize>;
+  CUDA_LONG id = (NumThreadsPerBlock * blockIdx.x + threadIdx.x) * VecSize;
+  if (id >= N)
+    return;
+
+  int q, r;
+  fdm_C.divmod(id, q, r);
+  const VecT lvalue = *reinterpret_cast<const VecT*>(&lhs_data[id]);
+  const VecT rvalue = *reinterpret_cast<const VecT*>(&rhs_data[r]);
+  VecT output;
+#pragma unroll
+  for (int i = 0; i < VecSize; i++) {
+    output.val[i] = func(lvalue.val[i], rvalue.val[i]);
+  }
+  *reinterpret_cast<VecT*>(&output_data[id]) = output;
+}
+
+// for rhs per-channel broadcast case. H is a multiple of VecSize, so all the elements of a vector share the rhs
+// element, and N has no partial vector.
+template <typename T, typename FuncT, bool BatchN, int NumThreadsPerBlock, int VecSize>
+__global__ void _BinaryElementWiseRhsPerChannelVectorized(
+    const T* lhs_data,
+    const T* rhs_data,
+    const fast_divmod fdm_H,
+    const fast_divmod fdm_C,
+    T* output_data,
+    FuncT func,
+    CUDA_LONG N) {
+  using VecT = AlignedVector<T, VecSize>;
+  CUDA_LONG id = (NumThreadsPerBlock * blockIdx.x + threadIdx.x) * VecSize;
+  if (id >= N)
+    return;
+
+  CUDA_LONG rhs_id = fdm_H.div(id);
+  if (BatchN) {
+    int q, r;
+    fdm_C.divmod(rhs_id, q, r);
+    rhs_id = r;
+  }
+  const T rvalue = rhs_data[rhs_id];
+  const VecT lvalue = *reinterpret_cast<const VecT*>(&lhs_data[id]);
+  VecT output;
+#pragma unroll
+  for (int i = 0; i < VecSize; i++) {
+    output.val[i] = func(lvalue.val[i], rvalue);
+  }
+  *reinterpret_cast<VecT*>(&output_data[id]) = output;
+}
+
+template <int VecSize, typename T>
+bool IsVectorAligned(const T* data) {
+  return reinterpret_cast<uintptr_t>(data) % (sizeof(T) * VecSize) == 0;
+}
+
+// launches the vectorized kernel of the simple broadcast cases it applies to, returns false for the others
+template <typename T, typename FuncT>
+bool TryBinaryElementWiseVectorized(
+    int32_t output_rank_or_simple_broadcast,
+    const T* lhs_data,
+    const T* rhs_data,
+    const fast_divmod& fdm_H,
+    const fast_divmod& fdm_C,
+    T* output_data,
+    const FuncT& func,
+    CUDA_LONG N) {
+  constexpr int vec_size = 16 / sizeof(T);
+  if (vec_size == 1 || !IsVectorAligned<vec_size>(output_data)) {
+    return false;
+  }
+
+  const int blocksPerGrid = static_cast<int>(CeilDiv(N, GridDim::maxThreadsPerBlock * vec_size));
+  const auto simple_broadcast = static_cast<SimpleBroadcast>(output_rank_or_simple_broadcast);
+  if (simple_broadcast == SimpleBroadcast::LeftScalar) {
+    if (!IsVectorAligned<vec_size>(rhs_data)) {
+      return false;
+    }
+    _BinaryElementWiseSimpleVectorized<false, true, T, FuncT, GridDim::maxThreadsPerBlock, vec_size>
+        <<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0>>>(lhs_data, rhs_data, output_data, func, N);
+    return true;
+  }
+
+  // the other cases read lhs like the output
+  if (!IsVectorAligned<vec_size>(lhs_data)) {
+    return false;
+  }
+  if (simple_broadcast == SimpleBroadcast::NoBroadcast && IsVectorAligned<vec_size>(rhs_data)) {
+    _BinaryElementWiseSimpleVectorized<true, true, T, FuncT, GridDim::maxThreadsPerBlock, vec_size>
+        <<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0>>>(lhs_data, rhs_data, output_data, func, N);
+  } else if (simple_broadcast == SimpleBroadcast::RightScalar) {
+    _BinaryElementWiseSimpleVectorized<true, false, T, FuncT, GridDim::maxThreadsPerBlock, vec_size>
+        <<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0>>>(lhs_data, rhs_data, output_data, func, N);
+  } else if (simple_broadcast == SimpleBroadcast::RightPerChannelBatchN && fdm_H.d_ == 1 &&
+             fdm_C.d_ % vec_size == 0 && IsVectorAligned<vec_size>(rhs_data)) {
+    _BinaryElementWiseRhsRowVectorized<T, FuncT, GridDim::maxThreadsPerBlock, vec_size>
+        <<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0>>>(lhs_data, rhs_data, fdm_C, output_data, func, N);
+  } else if (simple_broadcast == SimpleBroadcast::RightPerChannelBatch1 && fdm_H.d_ % vec_size == 0) {
+    _BinaryElementWiseRhsPerChannelVectorized<T, FuncT, false, GridDim::maxThreadsPerBlock, vec_size>
+        <<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0>>>(lhs_data, rhs_data, fdm_H, fdm_C, output_data, func, N);
+  } else if (simple_broadcast == SimpleBroadcast::RightPerChannelBatchN && fdm_H.d_ % vec_size == 0) {
+    _BinaryElementWiseRhsPerChannelVectorized<T, FuncT, true, GridDim::maxThreadsPerBlock, vec_size>
+        <<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0>>>(lhs_data, rhs_data, fdm_H, fdm_C, output_data, func, N);
+  } else {
+    return false;
+  }
+  return true;
+}
+
 template <typename T, typename FuncT>
 void BinaryElementWiseNoBroadcastImpl(
     const T* lhs_data,
@@ -189,6 +340,10 @@ void BinaryElementWiseNoBroadcastImpl(
 
   int blocksPerGrid = static_cast<int>(CeilDiv(count, GridDim::maxThreadsPerBlock * GridDim::maxElementsPerThread));
   CUDA_LONG N = static_cast<CUDA_LONG>(count);
+  if (TryBinaryElementWiseVectorized(static_cast<int32_t>(SimpleBroadcast::NoBroadcast), lhs_data, rhs_data,
+                                     fast_divmod(), fast_divmod(), output_data, func, N)) {
+    return;
+  }
   _BinaryElementWiseSimple<true, true, T, FuncT, GridDim::maxThreadsPerBlock, GridDim::maxElementsPerThread><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0>>>(
       lhs_data,
       rhs_data,
@@ -215,6 +370,12 @@ void BinaryElementWiseImpl(
 
   int blocksPerGrid = static_cast<int>(CeilDiv(count, GridDim::maxThreadsPerBlock * GridDim::maxElementsPerThread));
   CUDA_LONG N = static_cast<CUDA_LONG>(count);
+  if (output_rank_or_simple_broadcast < 0 &&
+      TryBinaryElementWiseVectorized(output_rank_or_simple_broadcast, lhs_data, rhs_data, fdm_H, fdm_C,
+                                     output_data, func, N)) {
+    return;
+  }
+
   if (output_rank_or_simple_broadcast == static_cast<int32_t>(SimpleBroadcast::NoBroadcast)) {
     _BinaryElementWiseSimple<true, true, T, FuncT, GridDim::maxThreadsPerBlock, GridDim::maxElementsPerThread><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0>>>(
         lhs_data,
@@ -286,6 +286,13 @@ struct GridDim {
   }
 };
 
+// A group of vec_size elements that is read or written with a single vector memory instruction, e.g.
+// *reinterpret_cast<const AlignedVector<half, 8>*>(p) loads 16 bytes at once. p must be aligned to the vector size.
+template <typename T, int vec_size>
+struct alignas(sizeof(T) * vec_size) AlignedVector {
+  T val[vec_size];
+};
+
 #define CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, N) \
   CUDA_LONG id = GridDim::GetLinearThreadId();     \
   if (id >= N)                                     \
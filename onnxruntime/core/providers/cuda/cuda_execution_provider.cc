@@ -5,7 +5,10 @@
 #include "cuda_execution_provider.h"
 #include "cuda_fence.h"
 #include "cuda_allocator.h"
+#include "cuda_stream_arena.h"
+#include "cupti_profiler.h"
 #include "core/framework/kernel_registry.h"
+#include "core/common/profiler.h"
 #include "core/framework/compute_capability.h"
 #include "core/framework/memcpy.h"
 #include "core/graph/graph_utils.h"
@@ -53,10 +56,14 @@ CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId de
   CUDNN_CALL_THROW(cudnnCreate(&cudnn_handle_));
   CURAND_CALL_THROW(curandCreateGenerator(&curand_generator_, CURAND_RNG_PSEUDO_DEFAULT));
 
-  DeviceAllocatorRegistrationInfo default_memory_info(
-      {OrtMemTypeDefault,
-       [](OrtDevice::DeviceId id) { return onnxruntime::make_unique<CUDAAllocator>(id, CUDA); }, cuda_mem_limit});
-  allocator_ = CreateAllocator(default_memory_info, device_id);
+  // keep the library calls on the same stream as the kernels of this thread so that concurrent
+  // Run() calls from different threads don't serialize on the legacy default stream
+  CUBLAS_CALL_THROW(cublasSetStream(cublas_handle_, cudaStreamPerThread));
+  CUDNN_CALL_THROW(cudnnSetStream(cudnn_handle_, cudaStreamPerThread));
+  CURAND_CALL_THROW(curandSetStream(curand_generator_, cudaStreamPerThread));
+  CUDA_CALL_THROW(cudaEventCreateWithFlags(&join_event_, cudaEventDisableTiming));
+
+  allocator_ = std::make_shared<CUDAStreamArena>(onnxruntime::make_unique<CUDAAllocator>(device_id, CUDA), cuda_mem_limit);
 }
 
 CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
@@ -75,24 +82,33 @@ CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
     LOGS_DEFAULT(ERROR) << "cudnnDestroy threw:" << ex.what();
   }
   CURAND_CALL_THROW(curandDestroyGenerator(curand_generator_));
+
+  try {
+    CUDA_CALL(cudaEventDestroy(join_event_));
+  } catch (const std::exception& ex) {
+    LOGS_DEFAULT(ERROR) << "cudaEventDestroy threw:" << ex.what();
+  }
 }
 
 CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& info)
-    : IExecutionProvider{onnxruntime::kCudaExecutionProvider}, device_id_(info.device_id), cuda_mem_limit_(info.cuda_mem_limit) {
+    : IExecutionProvider{onnxruntime::kCudaExecutionProvider},
+      device_id_(info.device_id),
+      cuda_mem_limit_(info.cuda_mem_limit),
+      enable_speculative_loop_(info.enable_speculative_loop),
+      enable_cuda_graph_(info.enable_cuda_graph) {
   CUDA_CALL_THROW(cudaSetDevice(device_id_));
+  if (enable_cuda_graph_) {
+    CUDA_CALL_THROW(cudaEventCreateWithFlags(&cuda_graph_event_, cudaEventDisableTiming));
+  }
 
   size_t free = 0;
   size_t total = 0;
   CUDA_CALL_THROW(cudaMemGetInfo(&free, &total));
 
-  DeviceAllocatorRegistrationInfo default_memory_info(
-      {OrtMemTypeDefault,
-       [](OrtDevice::DeviceId device_id) {
-         return onnxruntime::make_unique<CUDAAllocator>(device_id, CUDA);
-       },
-       cuda_mem_limit_});
-
-  InsertAllocator(CreateAllocator(default_memory_info, device_id_));
+  // the device memory is cached per stream, so memory freed by one Run can be reused by a concurrent one
+  // without synchronizing the device
+  InsertAllocator(std::make_shared<CUDAStreamArena>(onnxruntime::make_unique<CUDAAllocator>(device_id_, CUDA),
+                                                    cuda_mem_limit_));
 
   DeviceAllocatorRegistrationInfo pinned_memory_info(
       {OrtMemTypeCPUOutput,
@@ -132,6 +148,17 @@ CUDAExecutionProvider::~CUDAExecutionProvider() {
     CUDA_CALL_THROW(cudaEventDestroy(e));
     it = deferred_release_cpu_ptr_.erase(it);
   }
+
+  if (cuda_graph_event_) {
+    CUDA_CALL_THROW(cudaEventSynchronize(cuda_graph_event_));
+    for (auto& graph : cuda_graphs_) {
+      CUDA_CALL_THROW(cudaGraphExecDestroy(graph.second));
+    }
+    for (auto p : graph_cpu_ptrs_) {
+      cpu_alloc->Free(p);
+    }
+    CUDA_CALL_THROW(cudaEventDestroy(cuda_graph_event_));
+  }
 }
 
 CUDAExecutionProvider::PerThreadContext& CUDAExecutionProvider::GetPerThreadContext() const {
@@ -188,7 +215,14 @@ void CUDAExecutionProvider::AddDeferredReleaseCPUPtr(void* p) {
   // when not running in InferenceSession (e.g. Test)
   // it's OK to not remember the deferred release ptr
   // as the actual memory will be cleaned in arena allocator dtor
-  auto current_deferred_release_event = GetPerThreadContext().GetCurrentDeferredReleaseEvent();
+  auto& per_thread_context = GetPerThreadContext();
+  if (per_thread_context.IsCapturing()) {
+    // the recorded copy reads the buffer again on every replay
+    graph_cpu_ptrs_.push_back(p);
+    return;
+  }
+
+  auto current_deferred_release_event = per_thread_context.GetCurrentDeferredReleaseEvent();
   if (current_deferred_release_event) {
     std::lock_guard<OrtMutex> lock(deferred_release_cpu_ptr_mutex_);
     auto iter = deferred_release_cpu_ptr_.find(current_deferred_release_event);
@@ -197,7 +231,7 @@ void CUDAExecutionProvider::AddDeferredReleaseCPUPtr(void* p) {
   }
 }
 
-Status CUDAExecutionProvider::OnRunStart() {
+Status CUDAExecutionProvider::OnRunStart(const RunOptions& run_options) {
   auto cpu_alloc = GetAllocator(0, OrtMemTypeCPU);
   // check if cudaEvents has passed for deferred release
   // note that we need to take a mutex in case of multi-threaded Run()
@@ -219,22 +253,160 @@ Status CUDAExecutionProvider::OnRunStart() {
     }
   }
 
-  auto& current_deferred_release_event = GetPerThreadContext().GetCurrentDeferredReleaseEvent();
+  auto& per_thread_context = GetPerThreadContext();
+  auto& current_deferred_release_event = per_thread_context.GetCurrentDeferredReleaseEvent();
   CUDA_RETURN_IF_ERROR(cudaEventCreate(&current_deferred_release_event, cudaEventDisableTiming));
   deferred_release_cpu_ptr_.emplace(current_deferred_release_event, DeferredReleaseCPUPtrs());
+
+  // make the work of this Run wait for what the caller already queued on its stream
+  auto user_stream = static_cast<cudaStream_t>(run_options.compute_stream);
+  per_thread_context.GetUserStream() = user_stream;
+  per_thread_context.GetSynchronizeOnRunEnd() = run_options.fetches_on_device;
+  if (user_stream != nullptr) {
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(per_thread_context.GetJoinEvent(), user_stream));
+    CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(cudaStreamPerThread, per_thread_context.GetJoinEvent(), 0));
+  }
   return Status::OK();
 }
 
 Status CUDAExecutionProvider::OnRunEnd() {
-  // record deferred release event on default stream, and release per_thread_context
-  auto current_deferred_release_event = GetPerThreadContext().GetCurrentDeferredReleaseEvent();
-  CUDA_RETURN_IF_ERROR(cudaEventRecord(current_deferred_release_event, nullptr));
+  // record deferred release event on the per-thread stream, and release per_thread_context
+  auto& per_thread_context = GetPerThreadContext();
+  auto current_deferred_release_event = per_thread_context.GetCurrentDeferredReleaseEvent();
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(current_deferred_release_event, cudaStreamPerThread));
+
+  // hand the results over to the caller's stream without blocking the host
+  auto& user_stream = per_thread_context.GetUserStream();
+  if (user_stream != nullptr) {
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(per_thread_context.GetJoinEvent(), cudaStreamPerThread));
+    CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(user_stream, per_thread_context.GetJoinEvent(), 0));
+    user_stream = nullptr;
+  }
+
+  // outputs left on the device may be read by another thread's stream or another device right after the Run
+  if (per_thread_context.GetSynchronizeOnRunEnd()) {
+    CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(cudaStreamPerThread));
+    per_thread_context.GetSynchronizeOnRunEnd() = false;
+  }
+
   ReleasePerThreadStuffs();
   std::lock_guard<OrtMutex> lock(deferred_release_cpu_ptr_mutex_);
   deferred_release_cpu_ptr_[current_deferred_release_event].recorded = true;
   return Status::OK();
 }
 
+Status CUDAExecutionProvider::ReplayGraph(const std::string& graph_key, bool& replayed) {
+  replayed = false;
+  std::lock_guard<OrtMutex> lock(cuda_graph_mutex_);
+  auto it = cuda_graphs_.find(graph_key);
+  if (it == cuda_graphs_.end()) {
+    return Status::OK();
+  }
+
+  CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(cudaStreamPerThread, cuda_graph_event_, 0));
+  CUDA_RETURN_IF_ERROR(cudaGraphLaunch(it->second, cudaStreamPerThread));
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(cuda_graph_event_, cudaStreamPerThread));
+  replayed = true;
+  return Status::OK();
+}
+
+void CUDAExecutionProvider::SwapGraphContext(bool lend) {
+  // the run scoped state moves with the Run between its own context and graph_context_
+  auto& run_context = per_thread_context_map_->at(this);
+  auto& to = lend ? graph_context_ : graph_run_context_;
+  to->GetCurrentDeferredReleaseEvent() = run_context->GetCurrentDeferredReleaseEvent();
+  to->GetUserStream() = run_context->GetUserStream();
+  if (lend) {
+    graph_run_context_ = run_context;
+    run_context = graph_context_;
+  } else {
+    run_context = graph_run_context_;
+    graph_run_context_.reset();
+  }
+}
+
+Status CUDAExecutionProvider::BeginGraphCapture(const std::string& graph_key, bool& capturing) {
+  capturing = false;
+  bool record = false;
+  {
+    std::lock_guard<OrtMutex> lock(cuda_graph_mutex_);
+    if (uncapturable_graph_keys_.count(graph_key) != 0 || cuda_graphs_.size() >= kMaxCudaGraphs) {
+      return Status::OK();
+    }
+    record = ++cuda_graph_runs_[graph_key] > kCudaGraphWarmupRuns;
+  }
+
+  // Both the warm up and the recording Run use graph_context_, so the memory the recorded kernels
+  // touch is already in its arena when recording and isn't handed to any other Run afterwards.
+  graph_capture_mutex_.lock();
+  if (!graph_context_) {
+    graph_context_ = std::make_shared<PerThreadContext>(device_id_, cuda_mem_limit_);
+  }
+  SwapGraphContext(true);
+
+  cudaError_t result = cudaSuccess;
+  {
+    std::lock_guard<OrtMutex> lock(cuda_graph_mutex_);
+    result = cudaStreamWaitEvent(cudaStreamPerThread, cuda_graph_event_, 0);
+  }
+  if (result == cudaSuccess && record) {
+    result = cudaStreamBeginCapture(cudaStreamPerThread, cudaStreamCaptureModeThreadLocal);
+    graph_context_->SetCapturing(result == cudaSuccess);
+  }
+
+  if (result != cudaSuccess) {
+    SwapGraphContext(false);
+    graph_capture_mutex_.unlock();
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "CUDA error starting the graph capture: ", cudaGetErrorString(result));
+  }
+
+  capturing = true;
+  return Status::OK();
+}
+
+Status CUDAExecutionProvider::EndGraphCapture(const std::string& graph_key, const Status& run_status, bool& rerun) {
+  rerun = false;
+  cudaGraphExec_t graph_exec = nullptr;
+  cudaError_t result = cudaSuccess;
+  if (graph_context_->IsCapturing()) {
+    graph_context_->SetCapturing(false);
+    cudaGraph_t graph = nullptr;
+    result = cudaStreamEndCapture(cudaStreamPerThread, &graph);
+    if (run_status.IsOK() && result == cudaSuccess) {
+      result = cudaGraphInstantiate(&graph_exec, graph, nullptr, nullptr, 0);
+    }
+    if (graph != nullptr) {
+      cudaGraphDestroy(graph);
+    }
+    // nothing ran while recording, so a failed recording leaves the Run to be executed again
+    rerun = !run_status.IsOK() || result != cudaSuccess;
+    if (rerun) {
+      // clear the error the invalidated capture left behind
+      cudaGetLastError();
+    }
+  }
+
+  {
+    std::lock_guard<OrtMutex> lock(cuda_graph_mutex_);
+    if (graph_exec != nullptr) {
+      result = cudaGraphLaunch(graph_exec, cudaStreamPerThread);
+      cuda_graphs_.emplace(graph_key, graph_exec);
+    } else if (!run_status.IsOK() || rerun) {
+      uncapturable_graph_keys_.insert(graph_key);
+      cuda_graph_runs_.erase(graph_key);
+    }
+    CUDA_CALL(cudaEventRecord(cuda_graph_event_, cudaStreamPerThread));
+  }
+
+  SwapGraphContext(false);
+  graph_capture_mutex_.unlock();
+
+  if (graph_exec != nullptr && result != cudaSuccess) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "CUDA error launching the captured graph: ", cudaGetErrorString(result));
+  }
+  return Status::OK();
+}
+
 namespace cuda {
 // opset 1 to 9
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyFromHost);
@@ -259,6 +431,7 @@ class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain,
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, double, MatMul);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, MLFloat16, MatMul);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, int8_t, MatMulInteger);
+class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, QLinearMatMul);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, float, Tile);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, double, Tile);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, MLFloat16, Tile);
@@ -730,6 +903,7 @@ static void RegisterCudaKernels(KernelRegistry& kernel_registry) {
       BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, double, MatMul)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, MLFloat16, MatMul)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, int8_t, MatMulInteger)>,
+      BuildKernelCreateInfo<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, QLinearMatMul)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, 10, float, Clip)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, float, Tile)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, double, Tile)>,
@@ -1303,6 +1477,14 @@ std::unique_ptr<onnxruntime::IDataTransfer> CUDAExecutionProvider::GetDataTransf
   return onnxruntime::make_unique<onnxruntime::GPUDataTransfer>();
 }
 
+std::unique_ptr<profiling::DeviceProfiler> CUDAExecutionProvider::GetProfiler() {
+#ifdef ENABLE_CUDA_PROFILING
+  return onnxruntime::make_unique<cuda::CuptiProfiler>();
+#else
+  return nullptr;
+#endif
+}
+
 std::vector<std::unique_ptr<ComputeCapability>>
 CUDAExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph,
                                      const std::vector<const KernelRegistry*>& kernel_registries) const {
@@ -10,6 +10,7 @@
 #include "core/providers/cuda/gpu_data_transfer.h"
 #include "shared_inc/cuda_utils.h"
 #include <deque>
+#include <unordered_set>
 
 namespace onnxruntime {
 
@@ -19,6 +20,13 @@ const int CPU_ALLOCATOR_DEVICE_ID = 0;
 struct CUDAExecutionProviderInfo {
   OrtDevice::DeviceId device_id{0};
   size_t cuda_mem_limit{std::numeric_limits<size_t>::max()};
+  // record the kernels of a Run into a CUDA graph and replay it when the inputs and outputs are bound
+  // to the same device buffers again, see InferenceSession::Run
+  bool enable_cuda_graph{false};
+  // run each Loop iteration before the condition of the previous one is copied back to the host, dropping it if the
+  // loop had ended, so the host doesn't wait for the device between the iterations. Only for Loop bodies which are
+  // safe to run once more after the last iteration, e.g. don't index out of range then.
+  bool enable_speculative_loop{false};
 };
 
 // Logical device representation.
@@ -31,10 +39,24 @@ class CUDAExecutionProvider : public IExecutionProvider {
 
   Status Sync() const override;
 
-  Status OnRunStart() override;
+  Status OnRunStart(const RunOptions& run_options) override;
 
   Status OnRunEnd() override;
 
+  bool IsGraphCaptureEnabled() const override {
+    return enable_cuda_graph_;
+  }
+
+  bool IsSpeculativeLoopEnabled() const {
+    return enable_speculative_loop_;
+  }
+
+  Status ReplayGraph(const std::string& graph_key, bool& replayed) override;
+
+  Status BeginGraphCapture(const std::string& graph_key, bool& capturing) override;
+
+  Status EndGraphCapture(const std::string& graph_key, const Status& run_status, bool& rerun) override;
+
   const void* GetExecutionHandle() const noexcept override {
     // The CUDA interface does not return anything interesting.
     return nullptr;
@@ -68,6 +90,7 @@ class CUDAExecutionProvider : public IExecutionProvider {
 
   virtual std::shared_ptr<KernelRegistry> GetKernelRegistry() const override;
   std::unique_ptr<onnxruntime::IDataTransfer> GetDataTransfer() const override;
+  std::unique_ptr<profiling::DeviceProfiler> GetProfiler() override;
 
   virtual std::vector<std::unique_ptr<ComputeCapability>>
   GetCapability(const onnxruntime::GraphViewer& graph,
@@ -78,6 +101,7 @@ class CUDAExecutionProvider : public IExecutionProvider {
  private:
   OrtDevice::DeviceId device_id_;
   size_t cuda_mem_limit_;
+  bool enable_speculative_loop_;
 
   struct DeferredReleaseCPUPtrs {
     bool recorded = false;
@@ -86,6 +110,23 @@ class CUDAExecutionProvider : public IExecutionProvider {
   std::unordered_map<cudaEvent_t, DeferredReleaseCPUPtrs> deferred_release_cpu_ptr_;
   OrtMutex deferred_release_cpu_ptr_mutex_;
 
+  // CUDA graphs keyed by the bindings of the Run they were recorded from.
+  // The first Run of a key only warms up, the second one is recorded, the later ones are replayed.
+  static constexpr int kCudaGraphWarmupRuns = 1;
+  static constexpr size_t kMaxCudaGraphs = 64;
+  bool enable_cuda_graph_;
+  std::unordered_map<std::string, cudaGraphExec_t> cuda_graphs_;
+  std::unordered_map<std::string, int> cuda_graph_runs_;
+  std::unordered_set<std::string> uncapturable_graph_keys_;
+  // the recorded graphs share the memory of one context, so their launches, the warm up runs and the
+  // recording runs are kept in order on the device with this event
+  cudaEvent_t cuda_graph_event_ = nullptr;
+  OrtMutex cuda_graph_mutex_;
+  // held from BeginGraphCapture to EndGraphCapture, the Run borrows graph_context_ meanwhile
+  OrtMutex graph_capture_mutex_;
+  // pinned buffers the recorded graphs copy from, released with the provider
+  std::vector<void*> graph_cpu_ptrs_;
+
   class PerThreadContext final {
    public:
     PerThreadContext(OrtDevice::DeviceId device_id, size_t cuda_mem_limit);
@@ -107,6 +148,20 @@ class CUDAExecutionProvider : public IExecutionProvider {
       return current_deferred_release_event_;
     }
 
+    // caller supplied stream of the current Run, see RunOptions::compute_stream
+    cudaStream_t& GetUserStream() {
+      return user_stream_;
+    }
+
+    cudaEvent_t GetJoinEvent() const {
+      return join_event_;
+    }
+
+    // set when the current Run leaves its outputs on the device, see RunOptions::fetches_on_device
+    bool& GetSynchronizeOnRunEnd() {
+      return synchronize_on_run_end_;
+    }
+
     template <typename T>
     const T* GetConstOnes(size_t count) {
       if (std::is_same<T, float>::value) {
@@ -133,6 +188,15 @@ class CUDAExecutionProvider : public IExecutionProvider {
       return allocator_;
     }
 
+    // set while the kernels of the thread are recorded into a CUDA graph
+    bool IsCapturing() const {
+      return is_capturing_;
+    }
+
+    void SetCapturing(bool is_capturing) {
+      is_capturing_ = is_capturing;
+    }
+
    private:
     cublasHandle_t cublas_handle_ = nullptr;
     cudnnHandle_t cudnn_handle_ = nullptr;
@@ -143,6 +207,14 @@ class CUDAExecutionProvider : public IExecutionProvider {
     // so the ownership is passed to deferred_release_cpu_ptr_
     cudaEvent_t current_deferred_release_event_ = nullptr;
 
+    // the kernels of a thread run on its per-thread default stream (the provider is built with
+    // --default-stream per-thread), this event joins that stream with the caller supplied one
+    cudaStream_t user_stream_ = nullptr;
+    cudaEvent_t join_event_ = nullptr;
+    bool synchronize_on_run_end_ = false;
+
+    bool is_capturing_ = false;
+
     std::unique_ptr<cuda::IConstantBuffer<float>> constant_ones_float_;
     std::unique_ptr<cuda::IConstantBuffer<double>> constant_ones_double_;
     std::unique_ptr<cuda::IConstantBuffer<half>> constant_ones_half_;
@@ -158,8 +230,13 @@ class CUDAExecutionProvider : public IExecutionProvider {
   mutable std::deque<std::shared_ptr<PerThreadContext>> retired_context_pool_;
   mutable OrtMutex context_pool_mutex_;
 
+  // context lent to the Runs that warm up or record a CUDA graph, and the contexts it replaces meanwhile
+  std::shared_ptr<PerThreadContext> graph_context_;
+  std::shared_ptr<PerThreadContext> graph_run_context_;
+
   PerThreadContext& GetPerThreadContext() const;
   void ReleasePerThreadStuffs() const;
+  void SwapGraphContext(bool lend);
 };
 
 }  // namespace onnxruntime
@@ -5,6 +5,8 @@
 #include <atomic>
 #include "core/graph/onnx_protobuf.h"
 #include "cuda_execution_provider.h"
+#include "cudnn_algo_cache.h"
+#include "core/framework/error_code_helper.h"
 #include "core/session/abi_session_options_impl.h"
 
 using namespace onnxruntime;
@@ -12,23 +14,27 @@ using namespace onnxruntime;
 namespace onnxruntime {
 
 struct CUDAProviderFactory : IExecutionProviderFactory {
-  CUDAProviderFactory(OrtDevice::DeviceId device_id) : device_id_(device_id) {}
+  CUDAProviderFactory(const CUDAExecutionProviderInfo& info) : info_(info) {}
   ~CUDAProviderFactory() override {}
 
   std::unique_ptr<IExecutionProvider> CreateProvider() override;
 
  private:
-  OrtDevice::DeviceId device_id_;
+  CUDAExecutionProviderInfo info_;
 };
 
 std::unique_ptr<IExecutionProvider> CUDAProviderFactory::CreateProvider() {
-  CUDAExecutionProviderInfo info;
-  info.device_id = device_id_;
-  return onnxruntime::make_unique<CUDAExecutionProvider>(info);
+  return onnxruntime::make_unique<CUDAExecutionProvider>(info_);
 }
 
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CUDA(OrtDevice::DeviceId device_id) {
-  return std::make_shared<onnxruntime::CUDAProviderFactory>(device_id);
+  CUDAExecutionProviderInfo info;
+  info.device_id = device_id;
+  return std::make_shared<onnxruntime::CUDAProviderFactory>(info);
+}
+
+std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CUDA(const CUDAExecutionProviderInfo& info) {
+  return std::make_shared<onnxruntime::CUDAProviderFactory>(info);
 }
 
 }  // namespace onnxruntime
@@ -37,3 +43,26 @@ ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProvider_CUDA, _In_ OrtSessi
   options->provider_factories.push_back(onnxruntime::CreateExecutionProviderFactory_CUDA(static_cast<OrtDevice::DeviceId>(device_id)));
   return nullptr;
 }
+
+ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProviderEx_CUDA, _In_ OrtSessionOptions* options, int device_id,
+                    int enable_cuda_graph) {
+  CUDAExecutionProviderInfo info;
+  info.device_id = static_cast<OrtDevice::DeviceId>(device_id);
+  info.enable_cuda_graph = enable_cuda_graph != 0;
+  options->provider_factories.push_back(onnxruntime::CreateExecutionProviderFactory_CUDA(info));
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtSaveCudnnAlgoCache_CUDA, int device_id, _In_ const ORTCHAR_T* file_path) {
+  API_IMPL_BEGIN
+  auto& cache = cuda::CudnnAlgoCache::Get(static_cast<OrtDevice::DeviceId>(device_id));
+  return onnxruntime::ToOrtStatus(cache.Save(file_path));
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtLoadCudnnAlgoCache_CUDA, int device_id, _In_ const ORTCHAR_T* file_path) {
+  API_IMPL_BEGIN
+  auto& cache = cuda::CudnnAlgoCache::Get(static_cast<OrtDevice::DeviceId>(device_id));
+  return onnxruntime::ToOrtStatus(cache.Load(file_path));
+  API_IMPL_END
+}
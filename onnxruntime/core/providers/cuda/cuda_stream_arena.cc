@@ -0,0 +1,219 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "cuda_stream_arena.h"
+#include <algorithm>
+#include "cuda_common.h"
+
+namespace onnxruntime {
+
+CUDAStreamArena::CUDAStreamArena(std::unique_ptr<IDeviceAllocator> device_allocator, size_t memory_limit)
+    : device_allocator_(std::move(device_allocator)),
+      memory_limit_(memory_limit),
+      info_(device_allocator_->Info().name, OrtAllocatorType::OrtArenaAllocator,
+            device_allocator_->Info().device, device_allocator_->Info().id, device_allocator_->Info().mem_type) {
+  stats_.bytes_limit = static_cast<int64_t>(memory_limit_);
+}
+
+CUDAStreamArena::~CUDAStreamArena() {
+  ReleaseCachedBlocks();
+  for (auto& block : blocks_in_use_) {
+    device_allocator_->Free(block.second.ptr);
+  }
+  for (auto event : free_events_) {
+    cudaEventDestroy(event);  // do not throw error since it's OK for the destroy to fail during shutdown
+  }
+}
+
+size_t CUDAStreamArena::RoundedSize(size_t size) {
+  const size_t rounding = size < kLargeBlockSize ? kSmallRounding : kLargeRounding;
+  return (size + rounding - 1) / rounding * rounding;
+}
+
+bool CUDAStreamArena::TakeCachedBlock(std::multimap<size_t, Block>& blocks, size_t size, bool cross_stream,
+                                      Block& block) {
+  const size_t max_size = size + size / kMaxWasteFraction;
+  for (auto it = blocks.lower_bound(size); it != blocks.end() && it->first <= max_size; ++it) {
+    // only the stream that freed the block during a capture knows when it is done with it
+    if (cross_stream && it->second.free_event == nullptr) {
+      continue;
+    }
+    block = it->second;
+    blocks.erase(it);
+    return true;
+  }
+  return false;
+}
+
+void CUDAStreamArena::ReleaseCachedBlocks() {
+  // cudaFree waits for the device to be done with the memory
+  for (auto& stream_blocks : free_blocks_) {
+    for (auto& entry : stream_blocks.second) {
+      auto& block = entry.second;
+      if (block.free_event != nullptr) {
+        free_events_.push_back(block.free_event);
+      }
+      device_allocator_->Free(block.ptr);
+      stats_.total_allocated_bytes -= static_cast<int64_t>(block.size);
+    }
+  }
+  free_blocks_.clear();
+}
+
+cudaEvent_t CUDAStreamArena::GetEvent() {
+  cudaEvent_t event = nullptr;
+  if (free_events_.empty()) {
+    CUDA_CALL_THROW(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+  } else {
+    event = free_events_.back();
+    free_events_.pop_back();
+  }
+  return event;
+}
+
+void* CUDAStreamArena::Alloc(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+
+  const size_t rounded_size = RoundedSize(size);
+  const auto stream_id = std::this_thread::get_id();
+  cudaStreamCaptureStatus capture_status = cudaStreamCaptureStatusNone;
+  CUDA_CALL_THROW(cudaStreamIsCapturing(cudaStreamPerThread, &capture_status));
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  Block block;
+  bool found = TakeCachedBlock(free_blocks_[stream_id], rounded_size, false, block);
+  if (found) {
+    // the stream orders the new use after the previous one
+    if (block.free_event != nullptr) {
+      free_events_.push_back(block.free_event);
+    }
+  } else if (capture_status == cudaStreamCaptureStatusNone) {
+    // a capture can't depend on work outside of it, so only a stream that isn't captured reuses
+    // the blocks of the other streams
+    for (auto& stream_blocks : free_blocks_) {
+      if (stream_blocks.first != stream_id && TakeCachedBlock(stream_blocks.second, rounded_size, true, block)) {
+        found = true;
+        break;
+      }
+    }
+    if (found) {
+      free_events_.push_back(block.free_event);
+      CUDA_CALL_THROW(cudaStreamWaitEvent(cudaStreamPerThread, block.free_event, 0));
+      ++stats_.num_cross_stream_reuses;
+    }
+  }
+
+  if (!found) {
+    if (static_cast<size_t>(stats_.total_allocated_bytes) + rounded_size > memory_limit_) {
+      ReleaseCachedBlocks();
+    }
+    if (static_cast<size_t>(stats_.total_allocated_bytes) + rounded_size > memory_limit_) {
+      ORT_THROW("Failed to allocate ", size, " bytes. ", stats_.bytes_in_use, " of the ", memory_limit_,
+                " bytes the CUDA arena may use are in use.");
+    }
+
+    void* p = nullptr;
+    try {
+      p = device_allocator_->Alloc(rounded_size);
+    } catch (const OnnxRuntimeException&) {
+      // clear the error, give the cached blocks back and try once more
+      cudaGetLastError();
+      ReleaseCachedBlocks();
+    }
+    if (p == nullptr) {
+      p = device_allocator_->Alloc(rounded_size);
+    }
+
+    block.ptr = p;
+    block.size = rounded_size;
+    block.free_event = nullptr;
+    stats_.total_allocated_bytes += static_cast<int64_t>(rounded_size);
+    stats_.max_total_allocated_bytes = std::max(stats_.max_total_allocated_bytes, stats_.total_allocated_bytes);
+    ++stats_.num_extends;
+  }
+
+  block.free_event = nullptr;
+  blocks_in_use_.emplace(block.ptr, block);
+  ++stats_.num_allocs;
+  stats_.bytes_in_use += static_cast<int64_t>(block.size);
+  stats_.max_bytes_in_use = std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+  stats_.max_alloc_size = std::max(stats_.max_alloc_size, static_cast<int64_t>(size));
+  return block.ptr;
+}
+
+void* CUDAStreamArena::Reserve(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  Block block;
+  block.ptr = device_allocator_->Alloc(size);
+  block.size = size;
+  block.reserved = true;
+  blocks_in_use_.emplace(block.ptr, block);
+  ++stats_.num_allocs;
+  stats_.bytes_in_use += static_cast<int64_t>(size);
+  stats_.total_allocated_bytes += static_cast<int64_t>(size);
+  stats_.max_bytes_in_use = std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+  stats_.max_total_allocated_bytes = std::max(stats_.max_total_allocated_bytes, stats_.total_allocated_bytes);
+  return block.ptr;
+}
+
+void CUDAStreamArena::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  cudaStreamCaptureStatus capture_status = cudaStreamCaptureStatusNone;
+  CUDA_CALL(cudaStreamIsCapturing(cudaStreamPerThread, &capture_status));
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  auto it = blocks_in_use_.find(p);
+  ORT_ENFORCE(it != blocks_in_use_.end(), "Freeing a pointer that was not allocated by the CUDA arena.");
+  Block block = it->second;
+  blocks_in_use_.erase(it);
+  stats_.bytes_in_use -= static_cast<int64_t>(block.size);
+
+  if (block.reserved) {
+    device_allocator_->Free(block.ptr);
+    stats_.total_allocated_bytes -= static_cast<int64_t>(block.size);
+    return;
+  }
+
+  // an event recorded during a capture belongs to the captured graph, so it can't order other streams
+  if (capture_status == cudaStreamCaptureStatusNone) {
+    block.free_event = GetEvent();
+    if (!CUDA_CALL(cudaEventRecord(block.free_event, cudaStreamPerThread))) {
+      free_events_.push_back(block.free_event);
+      block.free_event = nullptr;
+    }
+  }
+  free_blocks_[std::this_thread::get_id()].emplace(block.size, block);
+}
+
+Status CUDAStreamArena::Shrink() {
+  std::lock_guard<OrtMutex> lock(lock_);
+  ReleaseCachedBlocks();
+  return Status::OK();
+}
+
+size_t CUDAStreamArena::Used() const {
+  std::lock_guard<OrtMutex> lock(lock_);
+  return static_cast<size_t>(stats_.bytes_in_use);
+}
+
+void CUDAStreamArena::GetStats(AllocatorStats* stats) {
+  std::lock_guard<OrtMutex> lock(lock_);
+  *stats = stats_;
+  for (const auto& stream_blocks : free_blocks_) {
+    if (!stream_blocks.second.empty()) {
+      stats->largest_free_chunk =
+          std::max(stats->largest_free_chunk, static_cast<int64_t>(stream_blocks.second.rbegin()->first));
+    }
+  }
+}
+
+}  // namespace onnxruntime
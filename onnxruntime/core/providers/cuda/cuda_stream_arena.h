@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <map>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "cuda_pch.h"
+#include "core/framework/arena.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// Caching arena for device memory that knows which stream the cached blocks were last used on.
+// The kernels of the CUDA provider run on the per-thread default stream of the thread that
+// executes them, so the stream of a block is the one of the thread that freed it.
+// A block is handed out again right away to the same stream, as the stream orders the new use
+// after the old one. Another stream first waits on the event recorded when the block was freed,
+// so reusing memory across streams never needs a device synchronization.
+class CUDAStreamArena : public IArenaAllocator {
+ public:
+  CUDAStreamArena(std::unique_ptr<IDeviceAllocator> device_allocator, size_t memory_limit);
+  ~CUDAStreamArena() override;
+
+  void* Alloc(size_t size) override;
+
+  void Free(void* p) override;
+
+  // the block is never cached, it goes back to the device allocator when it is freed
+  void* Reserve(size_t size) override;
+
+  // returns the cached blocks to the device allocator
+  Status Shrink() override;
+
+  size_t Used() const override;
+
+  size_t Max() const override {
+    return memory_limit_;
+  }
+
+  const OrtMemoryInfo& Info() const override {
+    return info_;
+  }
+
+  FencePtr CreateFence(const SessionState* session_state) override {
+    return device_allocator_->CreateFence(session_state);
+  }
+
+  void GetStats(AllocatorStats* stats) override;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CUDAStreamArena);
+
+  struct Block {
+    void* ptr = nullptr;
+    size_t size = 0;
+    bool reserved = false;
+    // recorded on the stream of the block when it was freed, null if the stream was being captured
+    cudaEvent_t free_event = nullptr;
+  };
+
+  // requests below kLargeBlockSize are rounded to kSmallRounding, the others to kLargeRounding
+  static constexpr size_t kSmallRounding = 512;
+  static constexpr size_t kLargeRounding = 128 * 1024;
+  static constexpr size_t kLargeBlockSize = 1024 * 1024;
+  // a cached block is reused for a request if it is at most 1/kMaxWasteFraction larger
+  static constexpr size_t kMaxWasteFraction = 8;
+
+  static size_t RoundedSize(size_t size);
+
+  // both need lock_ to be held
+  bool TakeCachedBlock(std::multimap<size_t, Block>& blocks, size_t size, bool cross_stream, Block& block);
+  void ReleaseCachedBlocks();
+
+  cudaEvent_t GetEvent();
+
+  std::unique_ptr<IDeviceAllocator> device_allocator_;
+  const size_t memory_limit_;
+  const OrtMemoryInfo info_;
+
+  mutable OrtMutex lock_;
+  std::unordered_map<void*, Block> blocks_in_use_;
+  std::unordered_map<std::thread::id, std::multimap<size_t, Block>> free_blocks_;
+  std::vector<cudaEvent_t> free_events_;
+  AllocatorStats stats_;
+};
+
+}  // namespace onnxruntime
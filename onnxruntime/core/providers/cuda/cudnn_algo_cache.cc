@@ -0,0 +1,163 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cudnn_algo_cache.h"
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+#include "core/providers/cuda/cuda_common.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+namespace {
+std::string GetDeviceModel(OrtDevice::DeviceId device_id) {
+  const auto& props = DeviceProp::GetCachedDeviceProps();
+  ORT_ENFORCE(device_id >= 0 && static_cast<size_t>(device_id) < props.size(), "Invalid CUDA device id ", device_id);
+  std::ostringstream model;
+  model << props[device_id].name << " cudnn " << cudnnGetVersion();
+  return model.str();
+}
+
+void AppendDims(std::ostringstream& key, const char* name, const std::vector<int64_t>& dims) {
+  key << name;
+  for (size_t i = 0; i < dims.size(); ++i) {
+    key << (i == 0 ? "" : ",") << dims[i];
+  }
+  key << ';';
+}
+}  // namespace
+
+CudnnAlgoCache::CudnnAlgoCache(const std::string& device_model) : device_model_(device_model) {
+}
+
+CudnnAlgoCache& CudnnAlgoCache::Get(OrtDevice::DeviceId device_id) {
+  static OrtMutex caches_mutex;
+  static std::unordered_map<OrtDevice::DeviceId, std::unique_ptr<CudnnAlgoCache>> caches;
+
+  std::lock_guard<OrtMutex> lock(caches_mutex);
+  auto& cache = caches[device_id];
+  if (cache == nullptr) {
+    cache = onnxruntime::make_unique<CudnnAlgoCache>(GetDeviceModel(device_id));
+  }
+  return *cache;
+}
+
+std::string CudnnAlgoCache::MakeKey(const char* direction, int data_type,
+                                    const std::vector<int64_t>& x_dims, const std::vector<int64_t>& w_dims,
+                                    const std::vector<int64_t>& pads, const std::vector<int64_t>& strides,
+                                    const std::vector<int64_t>& dilations, int64_t group) {
+  std::ostringstream key;
+  key << direction << ";t" << data_type << ';';
+  AppendDims(key, "x", x_dims);
+  AppendDims(key, "w", w_dims);
+  AppendDims(key, "p", pads);
+  AppendDims(key, "s", strides);
+  AppendDims(key, "d", dilations);
+  key << 'g' << group;
+  return key.str();
+}
+
+bool CudnnAlgoCache::Lookup(const std::string& key, Entry& entry) const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+
+  entry = it->second;
+  return true;
+}
+
+void CudnnAlgoCache::Insert(const std::string& key, const Entry& entry) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  entries_[key] = entry;
+}
+
+size_t CudnnAlgoCache::Size() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return entries_.size();
+}
+
+Status CudnnAlgoCache::Load(const std::basic_string<ORTCHAR_T>& file_path) {
+  std::ifstream file(file_path);
+  if (!file) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NO_SUCHFILE, "Failed to open the cuDNN algorithm cache ",
+                           ToMBString(file_path));
+  }
+
+  std::unordered_map<std::string, Entry> entries;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty()) {
+      continue;
+    }
+
+    const auto model_end = line.find('\t');
+    const auto key_end = model_end == std::string::npos ? std::string::npos : line.find('\t', model_end + 1);
+    if (key_end == std::string::npos) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Invalid entry in the cuDNN algorithm cache ", ToMBString(file_path),
+                             ": ", line);
+    }
+
+    if (line.compare(0, model_end, device_model_) != 0) {
+      continue;
+    }
+
+    Entry entry;
+    std::istringstream values(line.substr(key_end + 1));
+    if (!(values >> entry.algo >> entry.workspace_bytes >> entry.math_type)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Invalid entry in the cuDNN algorithm cache ", ToMBString(file_path),
+                             ": ", line);
+    }
+
+    entries[line.substr(model_end + 1, key_end - model_end - 1)] = entry;
+  }
+
+  // a file that can't be parsed leaves the cache untouched
+  std::lock_guard<OrtMutex> lock(mutex_);
+  for (const auto& entry : entries) {
+    entries_[entry.first] = entry.second;
+  }
+
+  return Status::OK();
+}
+
+Status CudnnAlgoCache::Save(const std::basic_string<ORTCHAR_T>& file_path) const {
+  std::vector<std::string> other_lines;
+  {
+    std::ifstream file(file_path);
+    std::string line;
+    while (file && std::getline(file, line)) {
+      const auto model_end = line.find('\t');
+      if (!line.empty() && model_end != std::string::npos && line.compare(0, model_end, device_model_) != 0) {
+        other_lines.push_back(line);
+      }
+    }
+  }
+
+  std::ofstream file(file_path, std::ios::out | std::ios::trunc);
+  for (const auto& line : other_lines) {
+    file << line << '\n';
+  }
+
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    for (const auto& entry : entries_) {
+      file << device_model_ << '\t' << entry.first << '\t' << entry.second.algo << ' '
+           << entry.second.workspace_bytes << ' ' << entry.second.math_type << '\n';
+    }
+  }
+
+  file.close();
+  if (!file) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write the cuDNN algorithm cache ", ToMBString(file_path));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+#include "core/session/onnxruntime_c_api.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+/**
+ * Cache of the cuDNN convolution algorithms picked by cudnnFind*AlgorithmEx, shared by the kernels of all the
+ * sessions that run on a device. Entries are keyed by a string that describes the convolution problem, see MakeKey.
+ *
+ * The cache can be saved to a file and loaded back by a later process, so that a fresh process skips the algorithm
+ * search for the shapes it has already seen. The file is a text file with one entry per line:
+ * <device model> <tab> <key> <tab> <algo> <workspace bytes> <math type>.
+ * The device model is the GPU name and the cuDNN version, as the algorithm measurements don't carry over to another
+ * GPU or cuDNN build. Entries of other device models in the file are ignored when loading and kept when saving.
+ */
+class CudnnAlgoCache {
+ public:
+  struct Entry {
+    int64_t algo;
+    int64_t workspace_bytes;
+    int64_t math_type;
+  };
+
+  explicit CudnnAlgoCache(const std::string& device_model);
+
+  // Returns the cache shared by the kernels that run on the device.
+  static CudnnAlgoCache& Get(OrtDevice::DeviceId device_id);
+
+  // Describes a convolution problem: the direction (e.g. "fwd" or "bwd_data"), the cuDNN data type, the padded
+  // input and filter dims as passed to cuDNN, and the convolution parameters.
+  static std::string MakeKey(const char* direction, int data_type,
+                             const std::vector<int64_t>& x_dims, const std::vector<int64_t>& w_dims,
+                             const std::vector<int64_t>& pads, const std::vector<int64_t>& strides,
+                             const std::vector<int64_t>& dilations, int64_t group);
+
+  const std::string& DeviceModel() const { return device_model_; }
+
+  bool Lookup(const std::string& key, Entry& entry) const;
+
+  void Insert(const std::string& key, const Entry& entry);
+
+  // Adds the entries recorded in the file for this device model. Existing entries are overwritten.
+  Status Load(const std::basic_string<ORTCHAR_T>& file_path);
+
+  // Writes the entries to the file, keeping the lines of other device models the file already has.
+  Status Save(const std::basic_string<ORTCHAR_T>& file_path) const;
+
+  size_t Size() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudnnAlgoCache);
+
+  const std::string device_model_;
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -0,0 +1,251 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#ifdef ENABLE_CUDA_PROFILING
+
+#include "core/providers/cuda/cupti_profiler.h"
+
+#include <cupti.h>
+
+#include <memory>
+#include <unordered_map>
+
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+namespace {
+
+constexpr size_t kActivityBufferSize = 1 << 20;
+constexpr size_t kActivityRecordAlignment = 8;
+
+const CUpti_ActivityKind kActivityKinds[] = {CUPTI_ACTIVITY_KIND_CONCURRENT_KERNEL,
+                                             CUPTI_ACTIVITY_KIND_MEMCPY,
+                                             CUPTI_ACTIVITY_KIND_EXTERNAL_CORRELATION};
+
+struct DeviceActivity {
+  bool is_kernel;
+  std::string name;
+  uint64_t start;
+  uint64_t end;
+  uint32_t device_id;
+  uint32_t stream_id;
+  uint32_t correlation_id;
+  int32_t grid[3];
+  int32_t block[3];
+  uint64_t bytes;
+};
+
+// The CUPTI buffer callbacks have no user data, so the activities go to process wide state.
+struct ActivityState {
+  OrtMutex mutex;
+  bool active = false;
+  std::vector<DeviceActivity> activities;
+  // external correlation id of the CUPTI correlation id of each launch made while one was pushed
+  std::unordered_map<uint32_t, uint64_t> external_ids;
+  // allocations of the buffers handed to CUPTI, by their aligned address
+  std::unordered_map<uint8_t*, std::unique_ptr<uint8_t[]>> buffers;
+};
+
+ActivityState& GetActivityState() {
+  static ActivityState state;
+  return state;
+}
+
+bool CuptiCall(CUptiResult result, const char* call) {
+  if (result == CUPTI_SUCCESS) {
+    return true;
+  }
+  const char* message = nullptr;
+  cuptiGetResultString(result, &message);
+  LOGS_DEFAULT(WARNING) << call << " failed: " << (message ? message : "unknown error");
+  return false;
+}
+
+#define CUPTI_CALL(expr) CuptiCall((expr), #expr)
+
+const char* MemcpyName(uint8_t copy_kind) {
+  switch (copy_kind) {
+    case CUPTI_ACTIVITY_MEMCPY_KIND_HTOD:
+      return "MemcpyHtoD";
+    case CUPTI_ACTIVITY_MEMCPY_KIND_DTOH:
+      return "MemcpyDtoH";
+    case CUPTI_ACTIVITY_MEMCPY_KIND_DTOD:
+      return "MemcpyDtoD";
+    case CUPTI_ACTIVITY_MEMCPY_KIND_PTOP:
+      return "MemcpyPtoP";
+    default:
+      return "Memcpy";
+  }
+}
+
+void CUPTIAPI BufferRequested(uint8_t** buffer, size_t* size, size_t* max_num_records) {
+  std::unique_ptr<uint8_t[]> allocation(new uint8_t[kActivityBufferSize + kActivityRecordAlignment]);
+  auto address = reinterpret_cast<uintptr_t>(allocation.get());
+  auto* aligned = allocation.get() + (kActivityRecordAlignment - address % kActivityRecordAlignment) %
+                                         kActivityRecordAlignment;
+  auto& state = GetActivityState();
+  {
+    std::lock_guard<OrtMutex> lock(state.mutex);
+    state.buffers.emplace(aligned, std::move(allocation));
+  }
+  *buffer = aligned;
+  *size = kActivityBufferSize;
+  *max_num_records = 0;
+}
+
+void CUPTIAPI BufferCompleted(CUcontext /*context*/, uint32_t /*stream_id*/, uint8_t* buffer, size_t /*size*/,
+                              size_t valid_size) {
+  auto& state = GetActivityState();
+  std::lock_guard<OrtMutex> lock(state.mutex);
+  CUpti_Activity* record = nullptr;
+  while (cuptiActivityGetNextRecord(buffer, valid_size, &record) == CUPTI_SUCCESS) {
+    if (!state.active) {
+      break;
+    }
+    switch (record->kind) {
+      case CUPTI_ACTIVITY_KIND_CONCURRENT_KERNEL:
+      case CUPTI_ACTIVITY_KIND_KERNEL: {
+        const auto* kernel = reinterpret_cast<const CUpti_ActivityKernel4*>(record);
+        state.activities.push_back({true, kernel->name, kernel->start, kernel->end, kernel->deviceId,
+                                    kernel->streamId, kernel->correlationId,
+                                    {kernel->gridX, kernel->gridY, kernel->gridZ},
+                                    {kernel->blockX, kernel->blockY, kernel->blockZ},
+                                    0});
+        break;
+      }
+      case CUPTI_ACTIVITY_KIND_MEMCPY: {
+        const auto* memcpy = reinterpret_cast<const CUpti_ActivityMemcpy*>(record);
+        state.activities.push_back({false, MemcpyName(memcpy->copyKind), memcpy->start, memcpy->end,
+                                    memcpy->deviceId, memcpy->streamId, memcpy->correlationId,
+                                    {0, 0, 0}, {0, 0, 0}, memcpy->bytes});
+        break;
+      }
+      case CUPTI_ACTIVITY_KIND_EXTERNAL_CORRELATION: {
+        const auto* correlation = reinterpret_cast<const CUpti_ActivityExternalCorrelation*>(record);
+        if (correlation->externalKind == CUPTI_EXTERNAL_CORRELATION_KIND_CUSTOM0) {
+          state.external_ids[correlation->correlationId] = correlation->externalId;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  state.buffers.erase(buffer);
+}
+
+std::string Dims(const int32_t dims[3]) {
+  return std::to_string(dims[0]) + "," + std::to_string(dims[1]) + "," + std::to_string(dims[2]);
+}
+
+}  // namespace
+
+CuptiProfiler::~CuptiProfiler() {
+  if (active_) {
+    Stop();
+  }
+}
+
+void CuptiProfiler::Start(TimePoint profiling_start_time) {
+  if (active_) {
+    return;
+  }
+  auto& state = GetActivityState();
+  {
+    std::lock_guard<OrtMutex> lock(state.mutex);
+    if (state.active) {
+      LOGS_DEFAULT(WARNING) << "CUDA activities are already profiled by another session, "
+                               "the profile of this session has no CUDA kernel events.";
+      return;
+    }
+    state.active = true;
+  }
+
+  uint64_t timestamp = 0;
+  CUPTI_CALL(cuptiGetTimestamp(&timestamp));
+  const auto since_start = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::high_resolution_clock::now() - profiling_start_time);
+  start_timestamp_ = timestamp - static_cast<uint64_t>(since_start.count());
+
+  bool enabled = CUPTI_CALL(cuptiActivityRegisterCallbacks(BufferRequested, BufferCompleted));
+  for (auto kind : kActivityKinds) {
+    enabled = enabled && CUPTI_CALL(cuptiActivityEnable(kind));
+  }
+  if (!enabled) {
+    for (auto kind : kActivityKinds) {
+      cuptiActivityDisable(kind);
+    }
+    std::lock_guard<OrtMutex> lock(state.mutex);
+    state.active = false;
+    return;
+  }
+  active_ = true;
+}
+
+void CuptiProfiler::PushCorrelation(uint64_t correlation_id) {
+  if (active_) {
+    CUPTI_CALL(cuptiActivityPushExternalCorrelationId(CUPTI_EXTERNAL_CORRELATION_KIND_CUSTOM0, correlation_id));
+  }
+}
+
+void CuptiProfiler::PopCorrelation() {
+  if (active_) {
+    uint64_t correlation_id;
+    CUPTI_CALL(cuptiActivityPopExternalCorrelationId(CUPTI_EXTERNAL_CORRELATION_KIND_CUSTOM0, &correlation_id));
+  }
+}
+
+std::vector<std::pair<uint64_t, profiling::EventRecord>> CuptiProfiler::Stop() {
+  std::vector<std::pair<uint64_t, profiling::EventRecord>> events;
+  if (!active_) {
+    return events;
+  }
+  active_ = false;
+
+  // the activities are only complete once the devices are done with the work launched so far
+  cudaDeviceSynchronize();
+  CUPTI_CALL(cuptiActivityFlushAll(0));
+  for (auto kind : kActivityKinds) {
+    CUPTI_CALL(cuptiActivityDisable(kind));
+  }
+
+  std::vector<DeviceActivity> activities;
+  std::unordered_map<uint32_t, uint64_t> external_ids;
+  {
+    auto& state = GetActivityState();
+    std::lock_guard<OrtMutex> lock(state.mutex);
+    activities.swap(state.activities);
+    external_ids.swap(state.external_ids);
+    state.active = false;
+  }
+
+  const int pid = logging::GetProcessId();
+  events.reserve(activities.size());
+  for (const auto& activity : activities) {
+    std::unordered_map<std::string, std::string> args{{"device", std::to_string(activity.device_id)},
+                                                      {"stream", std::to_string(activity.stream_id)}};
+    if (activity.is_kernel) {
+      args.emplace("grid_size", Dims(activity.grid));
+      args.emplace("block_size", Dims(activity.block));
+    } else {
+      args.emplace("bytes", std::to_string(activity.bytes));
+    }
+    // activities launched before the profiling start time are clamped to it
+    const long long ts = activity.start > start_timestamp_
+                             ? static_cast<long long>((activity.start - start_timestamp_) / 1000)
+                             : 0;
+    const long long dur = static_cast<long long>((activity.end - activity.start) / 1000);
+    auto external_id = external_ids.find(activity.correlation_id);
+    events.emplace_back(external_id != external_ids.end() ? external_id->second : 0,
+                        profiling::EventRecord(profiling::DEVICE_EVENT, pid, static_cast<int>(activity.stream_id),
+                                               activity.name, ts, dur, std::move(args)));
+  }
+  return events;
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
+
+#endif
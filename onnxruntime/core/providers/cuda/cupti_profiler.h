@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#ifdef ENABLE_CUDA_PROFILING
+
+#include "core/common/profiler.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+// Collects the kernels and the memory copies that run on the CUDA devices with the CUPTI activity API.
+// Each activity is correlated with the node that launched it through a CUPTI external correlation id,
+// and is reported with its device time: the stream it ran on as the thread id, and the launch
+// configuration of kernels or the size of copies as arguments.
+// CUPTI collects the activities of the whole process, so only one profiler is active at a time; the
+// others started while it is report nothing.
+class CuptiProfiler final : public profiling::DeviceProfiler {
+ public:
+  CuptiProfiler() = default;
+  ~CuptiProfiler() override;
+
+  void Start(TimePoint profiling_start_time) override;
+  void PushCorrelation(uint64_t correlation_id) override;
+  void PopCorrelation() override;
+  std::vector<std::pair<uint64_t, profiling::EventRecord>> Stop() override;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CuptiProfiler);
+
+  bool active_{false};
+  // CUPTI timestamp, in nanoseconds, of the profiling start time
+  uint64_t start_timestamp_{0};
+};
+
+}  // namespace cuda
+}  // namespace onnxruntime
+
+#endif
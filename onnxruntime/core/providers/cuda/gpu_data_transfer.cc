@@ -2,21 +2,131 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cuda/gpu_data_transfer.h"
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <utility>
 #include "cuda_common.h"
 
 namespace onnxruntime {
+namespace {
+// Lets device access_device read the memory of peer_device, once per pair. Without peer access
+// cudaMemcpyPeerAsync still works but goes through host memory.
+void EnablePeerAccess(OrtDevice::DeviceId access_device, OrtDevice::DeviceId peer_device) {
+  static OrtMutex mutex;
+  static std::set<std::pair<OrtDevice::DeviceId, OrtDevice::DeviceId>> enabled;
+
+  std::lock_guard<OrtMutex> lock(mutex);
+  if (!enabled.insert({access_device, peer_device}).second) {
+    return;
+  }
+
+  int can_access = 0;
+  if (cudaDeviceCanAccessPeer(&can_access, access_device, peer_device) != cudaSuccess || !can_access) {
+    cudaGetLastError();
+    return;
+  }
+
+  int current_device = 0;
+  CUDA_CALL(cudaGetDevice(&current_device));
+  CUDA_CALL(cudaSetDevice(access_device));
+  // cudaErrorPeerAccessAlreadyEnabled if another component enabled it already
+  if (cudaDeviceEnablePeerAccess(peer_device, 0) != cudaSuccess) {
+    cudaGetLastError();
+  }
+  CUDA_CALL(cudaSetDevice(current_device));
+}
+}  // namespace
+
 GPUDataTransfer::GPUDataTransfer() {
-  // create streams, default is nullptr
-  streams_[kCudaStreamDefault] = nullptr;
+  // create streams; kernels run on the per-thread default stream, keep the default queue copies in order with them
+  streams_[kCudaStreamDefault] = cudaStreamPerThread;
   CUDA_CALL_THROW(cudaStreamCreateWithFlags(&streams_[kCudaStreamCopyIn], cudaStreamNonBlocking));
   CUDA_CALL_THROW(cudaStreamCreateWithFlags(&streams_[kCudaStreamCopyOut], cudaStreamNonBlocking));
 }
 
 GPUDataTransfer::~GPUDataTransfer() {
+  for (auto& buffer : staging_buffers_) {
+    if (buffer.data != nullptr) {
+      CUDA_CALL(cudaEventSynchronize(buffer.done));
+      CUDA_CALL(cudaEventDestroy(buffer.done));
+      CUDA_CALL(cudaFreeHost(buffer.data));
+    }
+  }
   CUDA_CALL(cudaStreamDestroy(streams_[kCudaStreamCopyIn]));
   CUDA_CALL(cudaStreamDestroy(streams_[kCudaStreamCopyOut]));
 }
 
+common::Status GPUDataTransfer::GetStagingBuffer(StagingBuffer*& buffer) const {
+  buffer = &staging_buffers_[next_staging_buffer_];
+  next_staging_buffer_ = (next_staging_buffer_ + 1) % kNumStagingBuffers;
+  if (buffer->data == nullptr) {
+    CUDA_RETURN_IF_ERROR(cudaMallocHost(&buffer->data, kStagingChunkBytes));
+    CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&buffer->done, cudaEventDisableTiming));
+  } else {
+    // the buffer is free once the DMA that used it last is done
+    CUDA_RETURN_IF_ERROR(cudaEventSynchronize(buffer->done));
+  }
+  return Status::OK();
+}
+
+common::Status GPUDataTransfer::StagedCopyToDevice(void* dst, const void* src, size_t bytes,
+                                                   cudaStream_t stream) const {
+  std::lock_guard<OrtMutex> lock(staging_mutex_);
+  for (size_t offset = 0; offset < bytes; offset += kStagingChunkBytes) {
+    const size_t chunk_bytes = std::min(bytes - offset, size_t{kStagingChunkBytes});
+    StagingBuffer* buffer = nullptr;
+    ORT_RETURN_IF_ERROR(GetStagingBuffer(buffer));
+    memcpy(buffer->data, static_cast<const char*>(src) + offset, chunk_bytes);
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(static_cast<char*>(dst) + offset, buffer->data, chunk_bytes,
+                                         cudaMemcpyHostToDevice, stream));
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(buffer->done, stream));
+  }
+  // the last chunks are still in flight, the kernels that read them are ordered after them on the stream
+  return Status::OK();
+}
+
+common::Status GPUDataTransfer::StagedCopyToHost(void* dst, const void* src, size_t bytes,
+                                                 cudaStream_t stream) const {
+  std::lock_guard<OrtMutex> lock(staging_mutex_);
+  struct PendingChunk {
+    StagingBuffer* buffer;
+    size_t offset;
+    size_t bytes;
+  };
+  PendingChunk pending[kNumStagingBuffers];
+  int num_pending = 0;
+  int first_pending = 0;
+
+  auto drain_one = [&]() {
+    auto& chunk = pending[first_pending];
+    CUDA_RETURN_IF_ERROR(cudaEventSynchronize(chunk.buffer->done));
+    memcpy(static_cast<char*>(dst) + chunk.offset, chunk.buffer->data, chunk.bytes);
+    first_pending = (first_pending + 1) % kNumStagingBuffers;
+    --num_pending;
+    return Status::OK();
+  };
+
+  // keep up to kNumStagingBuffers DMAs in flight while the host copies the finished chunks out
+  for (size_t offset = 0; offset < bytes; offset += kStagingChunkBytes) {
+    if (num_pending == kNumStagingBuffers) {
+      ORT_RETURN_IF_ERROR(drain_one());
+    }
+    const size_t chunk_bytes = std::min(bytes - offset, size_t{kStagingChunkBytes});
+    StagingBuffer* buffer = nullptr;
+    ORT_RETURN_IF_ERROR(GetStagingBuffer(buffer));
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(buffer->data, static_cast<const char*>(src) + offset, chunk_bytes,
+                                         cudaMemcpyDeviceToHost, stream));
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(buffer->done, stream));
+    pending[(first_pending + num_pending) % kNumStagingBuffers] = {buffer, offset, chunk_bytes};
+    ++num_pending;
+  }
+  while (num_pending > 0) {
+    ORT_RETURN_IF_ERROR(drain_one());
+  }
+  return Status::OK();
+}
+
 bool GPUDataTransfer::CanCopy(const OrtDevice& src_device, const OrtDevice& dst_device) const {
   return src_device.Type() == OrtDevice::GPU || src_device.MemType() == OrtDevice::MemType::CUDA_PINNED
          || dst_device.Type() == OrtDevice::GPU || dst_device.MemType() == OrtDevice::MemType::CUDA_PINNED;
@@ -34,9 +144,17 @@ common::Status GPUDataTransfer::CopyTensor(const Tensor& src, Tensor& dst, int e
     if (src_device.Type() == OrtDevice::CPU && src_device.MemType() == OrtDevice::MemType::CUDA_PINNED) {
       // copy from pinned memory to GPU, this is non-blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyHostToDevice, streams_[exec_queue_id]));
+    } else if (src_device.Type() == OrtDevice::GPU && src_device.Id() != dst_device.Id()) {
+      // copying between two GPUs, directly over the peer link when the devices support it, this is non-blocking
+      EnablePeerAccess(dst_device.Id(), src_device.Id());
+      CUDA_RETURN_IF_ERROR(cudaMemcpyPeerAsync(dst_data, dst_device.Id(), src_data, src_device.Id(), bytes,
+                                               streams_[kCudaStreamDefault]));
     } else if (src_device.Type() == OrtDevice::GPU) {
       // copying between GPU, this is non-blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToDevice, streams_[kCudaStreamDefault]));
+    } else if (bytes >= kMinStagedCopyBytes) {
+      // copy from other CPU memory to GPU through the pinned staging buffers, this returns before the last DMAs finish
+      ORT_RETURN_IF_ERROR(StagedCopyToDevice(dst_data, src_data, bytes, streams_[exec_queue_id]));
     } else {
       // copy from other CPU memory to GPU, this is blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpy(dst_data, src_data, bytes, cudaMemcpyHostToDevice));
@@ -45,6 +163,9 @@ common::Status GPUDataTransfer::CopyTensor(const Tensor& src, Tensor& dst, int e
     if (dst_device.Type() == OrtDevice::CPU && dst_device.MemType() == OrtDevice::MemType::CUDA_PINNED) {
       // copying from GPU to pinned memory, this is non-blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToHost, streams_[exec_queue_id]));
+    } else if (bytes >= kMinStagedCopyBytes) {
+      // copying from GPU to CPU memory through the pinned staging buffers, this is blocking
+      ORT_RETURN_IF_ERROR(StagedCopyToHost(dst_data, src_data, bytes, streams_[exec_queue_id]));
     } else {
       // copying from GPU to CPU memory, this is blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpy(dst_data, src_data, bytes, cudaMemcpyDeviceToHost));
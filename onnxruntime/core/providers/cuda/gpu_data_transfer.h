@@ -5,6 +5,7 @@
 
 #include "cuda_pch.h"
 #include "core/framework/data_transfer.h"
+#include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
 
@@ -30,7 +31,29 @@ class GPUDataTransfer : public IDataTransfer {
   }
 
  private:
+  // Copies between pageable host memory and the device go through a ring of pinned staging buffers,
+  // so the host copy of one chunk overlaps the DMA of the previous ones. Copies smaller than
+  // kMinStagedCopyBytes are left to the driver.
+  static constexpr size_t kMinStagedCopyBytes = 256 * 1024;
+  static constexpr size_t kStagingChunkBytes = 4 * 1024 * 1024;
+  static constexpr int kNumStagingBuffers = 4;
+
+  struct StagingBuffer {
+    void* data = nullptr;
+    // recorded after the DMA that uses the buffer
+    cudaEvent_t done = nullptr;
+  };
+
+  // both need staging_mutex_ to be held
+  common::Status GetStagingBuffer(StagingBuffer*& buffer) const;
+  common::Status StagedCopyToDevice(void* dst, const void* src, size_t bytes, cudaStream_t stream) const;
+  common::Status StagedCopyToHost(void* dst, const void* src, size_t bytes, cudaStream_t stream) const;
+
   cudaStream_t streams_[kTotalCudaStreams];
+
+  mutable OrtMutex staging_mutex_;
+  mutable StagingBuffer staging_buffers_[kNumStagingBuffers];
+  mutable int next_staging_buffer_ = 0;
 };
 
 }  // namespace onnxruntime
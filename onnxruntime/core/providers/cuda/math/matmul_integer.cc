@@ -25,8 +25,7 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
         .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
     MatMulInteger<int8_t, int8_t>);
 
-template <>
-Status MatMulInteger<int8_t, int8_t>::PadMatrix(
+Status MatMulIntegerBase::PadMatrix(
     int64_t row,
     int64_t col,
     int64_t align_size,
@@ -75,6 +74,17 @@ Status MatMulInteger<int8_t, int8_t>::ComputeInternal(OpKernelContext* ctx) cons
     b_offset = *(b_zero_point->template Data<int8_t>());
   }
 
+  return ComputeInt32(a_ptr, a->Shape().Size(), a_offset, b_ptr, b->Shape().Size(), b_offset, helper, output_ptr);
+}
+
+Status MatMulIntegerBase::ComputeInt32(const int8_t* a_ptr,
+                                       int64_t a_size,
+                                       int8_t a_offset,
+                                       const int8_t* b_ptr,
+                                       int64_t b_size,
+                                       int8_t b_offset,
+                                       const MatMulComputeHelper& helper,
+                                       int32_t* output_ptr) const {
   // offset output c[i,j] to
   // k*a_offset*b_offset -
   // b_offset * (a[i,0] + a[i,1] ...+a[i,k]) -
@@ -115,13 +125,13 @@ Status MatMulInteger<int8_t, int8_t>::ComputeInternal(OpKernelContext* ctx) cons
   int64_t b_pad_size = 0;
   IAllocatorUniquePtr<int8_t> a_padded;
   IAllocatorUniquePtr<int8_t> b_padded;
-  ORT_RETURN_IF_ERROR(PadMatrix(a->Shape().Size() / helper.K(),
+  ORT_RETURN_IF_ERROR(PadMatrix(a_size / helper.K(),
                                 helper.K(),
                                 align_size,
                                 a_ptr,
                                 a_pad_size,
                                 a_padded));
-  ORT_RETURN_IF_ERROR(PadMatrix(b->Shape().Size() / helper.N(),
+  ORT_RETURN_IF_ERROR(PadMatrix(b_size / helper.N(),
                                 helper.N(),
                                 align_size,
                                 b_ptr,
@@ -130,7 +140,7 @@ Status MatMulInteger<int8_t, int8_t>::ComputeInternal(OpKernelContext* ctx) cons
 
   for (size_t batch = 0; batch < helper.OutputOffsets().size(); batch++) {
     CUBLAS_RETURN_IF_ERROR(cublasGemmEx(
-        Base::CublasHandle(),
+        CublasHandle(),
         CUBLAS_OP_N,
         CUBLAS_OP_N,
         static_cast<int>(helper.N()),
@@ -4,6 +4,7 @@
 #include "matmul_integer.cuh"
 
 #include <cub/cub.cuh>
+#include <limits>
 #include "core/providers/cuda/cu_inc/common.cuh"
 
 namespace onnxruntime {
@@ -144,5 +145,46 @@ Status PadMatrixInLeadingDimension(const int8_t* src, int8_t* dst, int64_t row,
   return CUDA_CALL(cudaPeekAtLastError()) ? Status::OK() : Status(common::ONNXRUNTIME, common::FAIL);
   ;
 }
+
+__global__ void ShiftUint8ToInt8Kernel(const uint8_t* src, int8_t* dst, CUDA_LONG N) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, N);
+  dst[id] = static_cast<int8_t>(src[id] ^ 0x80);
+}
+
+Status ShiftUint8ToInt8(const uint8_t* src, int8_t* dst, size_t count) {
+  if (count == 0)
+    return Status::OK();
+
+  int blocksPerGrid = static_cast<int>(CeilDiv(count, GridDim::maxThreadsPerBlock));
+  ShiftUint8ToInt8Kernel<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0>>>(src, dst, static_cast<CUDA_LONG>(count));
+
+  return CUDA_CALL(cudaPeekAtLastError()) ? Status::OK() : Status(common::ONNXRUNTIME, common::FAIL);
+}
+
+template <typename T>
+__global__ void RequantizeKernel(const int32_t* src, T* dst, float multiplier, int zero_point, int lowest,
+                                 int highest, CUDA_LONG N) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, N);
+  int value = __float2int_rn(static_cast<float>(src[id]) * multiplier) + zero_point;
+  dst[id] = static_cast<T>(max(lowest, min(highest, value)));
+}
+
+template <typename T>
+Status Requantize(const int32_t* src, T* dst, float multiplier, T zero_point, size_t count) {
+  if (count == 0)
+    return Status::OK();
+
+  int blocksPerGrid = static_cast<int>(CeilDiv(count, GridDim::maxThreadsPerBlock));
+  RequantizeKernel<T><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0>>>(
+      src, dst, multiplier, static_cast<int>(zero_point), static_cast<int>(std::numeric_limits<T>::lowest()),
+      static_cast<int>(std::numeric_limits<T>::max()), static_cast<CUDA_LONG>(count));
+
+  return CUDA_CALL(cudaPeekAtLastError()) ? Status::OK() : Status(common::ONNXRUNTIME, common::FAIL);
+}
+
+template Status Requantize<int8_t>(const int32_t* src, int8_t* dst, float multiplier, int8_t zero_point, size_t count);
+template Status Requantize<uint8_t>(const int32_t* src, uint8_t* dst, float multiplier, uint8_t zero_point,
+                                    size_t count);
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -22,5 +22,12 @@ Status OffsetOutput(const int32_t* row_sum,
 
 Status PadMatrixInLeadingDimension(const int8_t* src, int8_t* dst, int64_t row, int64_t col, int64_t pad_size);
 
+// dst = src - 128, the int8 value with the same offset to a zero point shifted by 128
+Status ShiftUint8ToInt8(const uint8_t* src, int8_t* dst, size_t count);
+
+// dst = saturate(round(src * multiplier) + zero_point), for int8_t and uint8_t dst
+template <typename T>
+Status Requantize(const int32_t* src, T* dst, float multiplier, T zero_point, size_t count);
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -4,15 +4,43 @@
 #pragma once
 
 #include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cpu/math/matmul_helper.h"
 
 namespace onnxruntime {
 namespace cuda {
-template <typename T1, typename T2>
-class MatMulInteger final : public CudaKernel {
-  using Base = CudaKernel;
 
+// the int8 GEMM shared by MatMulInteger and QLinearMatMul
+class MatMulIntegerBase : public CudaKernel {
  public:
-  MatMulInteger(const OpKernelInfo& info) : CudaKernel(info) {
+  MatMulIntegerBase(const OpKernelInfo& info) : CudaKernel(info) {}
+
+ protected:
+  // compute output = (a - a_offset) * (b - b_offset) in int32 with cublasGemmEx, which uses the int8 tensor cores of
+  // the GPUs having them. a_size and b_size are the numbers of elements of a and b.
+  Status ComputeInt32(const int8_t* a_ptr,
+                      int64_t a_size,
+                      int8_t a_offset,
+                      const int8_t* b_ptr,
+                      int64_t b_size,
+                      int8_t b_offset,
+                      const MatMulComputeHelper& helper,
+                      int32_t* output_ptr) const;
+
+ private:
+  // pad matrix and B to make their leading dimension be multiples of *align_size*
+  Status PadMatrix(
+      int64_t row,
+      int64_t col,
+      int64_t align_size,
+      const int8_t*& src,
+      int64_t& pad_size,
+      IAllocatorUniquePtr<int8_t>& temp_mem_holder) const;
+};
+
+template <typename T1, typename T2>
+class MatMulInteger final : public MatMulIntegerBase {
+ public:
+  MatMulInteger(const OpKernelInfo& info) : MatMulIntegerBase(info) {
     has_a_zero_point_ = false;
     has_b_zero_point_ = false;
     if (info.GetInputCount() > 2) {
@@ -25,16 +53,6 @@ class MatMulInteger final : public CudaKernel {
 
   Status ComputeInternal(OpKernelContext* context) const override;
 
- private:
-  // pad matrix and B to make their leading dimension be multiples of *align_size*
-  Status PadMatrix(
-      int64_t row,
-      int64_t col,
-      int64_t align_size,
-      const int8_t*& src,
-      int64_t& pad_size,
-      IAllocatorUniquePtr<int8_t>& temp_mem_holder) const;
-
  private:
   bool has_a_zero_point_;
   bool has_b_zero_point_;
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "quantize_linear_matmul.h"
+#include "matmul_integer.cuh"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+ONNX_OPERATOR_KERNEL_EX(
+    QLinearMatMul,
+    kOnnxDomain,
+    10,
+    kCudaExecutionProvider,
+    KernelDefBuilder()
+        .InputMemoryType<OrtMemTypeCPUInput>(1)
+        .InputMemoryType<OrtMemTypeCPUInput>(2)
+        .InputMemoryType<OrtMemTypeCPUInput>(4)
+        .InputMemoryType<OrtMemTypeCPUInput>(5)
+        .InputMemoryType<OrtMemTypeCPUInput>(6)
+        .InputMemoryType<OrtMemTypeCPUInput>(7)
+        .TypeConstraint("T1", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()})
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()})
+        .TypeConstraint("T3", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()}),
+    QLinearMatMul);
+
+Status QLinearMatMul::GetInt8Input(const Tensor& input,
+                                   const Tensor& zero_point,
+                                   const int8_t*& data,
+                                   int8_t& offset,
+                                   IAllocatorUniquePtr<int8_t>& shifted_holder) const {
+  if (input.IsDataType<int8_t>()) {
+    data = input.template Data<int8_t>();
+    offset = *zero_point.template Data<int8_t>();
+    return Status::OK();
+  }
+
+  // x - zp == (x - 128) - (zp - 128), both of which fit in int8
+  const auto size = static_cast<size_t>(input.Shape().Size());
+  shifted_holder = GetScratchBuffer<int8_t>(size);
+  ORT_RETURN_IF_ERROR(ShiftUint8ToInt8(input.template Data<uint8_t>(), shifted_holder.get(), size));
+  data = shifted_holder.get();
+  offset = static_cast<int8_t>(*zero_point.template Data<uint8_t>() ^ 0x80);
+  return Status::OK();
+}
+
+Status QLinearMatMul::ComputeInternal(OpKernelContext* ctx) const {
+  auto a = ctx->Input<Tensor>(0);
+  auto b = ctx->Input<Tensor>(3);
+  ORT_ENFORCE(a != nullptr && b != nullptr);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+  if (y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  // validate offsets
+  auto a_zero_point = ctx->Input<Tensor>(2);
+  auto b_zero_point = ctx->Input<Tensor>(5);
+  auto y_zero_point = ctx->Input<Tensor>(7);
+  ORT_ENFORCE(IsScalarOr1ElementVector(a_zero_point),
+              "QLinearMatmul : input zero point must be a scalar or 1D tensor of size 1");
+  ORT_ENFORCE(IsScalarOr1ElementVector(b_zero_point),
+              "QLinearMatmul : weight zero point must be a scalar or 1D tensor of size 1");
+  ORT_ENFORCE(IsScalarOr1ElementVector(y_zero_point),
+              "QLinearMatmul : result zero point must be a scalar or 1D tensor of size 1");
+
+  // validate scale
+  auto a_scale = ctx->Input<Tensor>(1);
+  auto b_scale = ctx->Input<Tensor>(4);
+  auto y_scale = ctx->Input<Tensor>(6);
+  ORT_ENFORCE(IsScalarOr1ElementVector(a_scale),
+              "QLinearMatmul : input scale must be a scalar or 1D tensor of size 1");
+  ORT_ENFORCE(IsScalarOr1ElementVector(b_scale),
+              "QLinearMatmul : weight scale must be a scalar or 1D tensor of size 1");
+  ORT_ENFORCE(IsScalarOr1ElementVector(y_scale),
+              "QLinearMatmul : result scale must be a scalar or 1D tensor of size 1");
+
+  const float real_multiplier =
+      (*a_scale->template Data<float>() * *b_scale->template Data<float>()) / *y_scale->template Data<float>();
+
+  const int8_t* a_ptr = nullptr;
+  const int8_t* b_ptr = nullptr;
+  int8_t a_offset = 0;
+  int8_t b_offset = 0;
+  IAllocatorUniquePtr<int8_t> a_shifted;
+  IAllocatorUniquePtr<int8_t> b_shifted;
+  ORT_RETURN_IF_ERROR(GetInt8Input(*a, *a_zero_point, a_ptr, a_offset, a_shifted));
+  ORT_RETURN_IF_ERROR(GetInt8Input(*b, *b_zero_point, b_ptr, b_offset, b_shifted));
+
+  const auto output_size = static_cast<size_t>(y->Shape().Size());
+  auto gemm_output = GetScratchBuffer<int32_t>(output_size);
+  ORT_RETURN_IF_ERROR(ComputeInt32(a_ptr, a->Shape().Size(), a_offset, b_ptr, b->Shape().Size(), b_offset, helper,
+                                   gemm_output.get()));
+
+  if (y->IsDataType<int8_t>()) {
+    return Requantize(gemm_output.get(), y->template MutableData<int8_t>(), real_multiplier,
+                      *y_zero_point->template Data<int8_t>(), output_size);
+  }
+  return Requantize(gemm_output.get(), y->template MutableData<uint8_t>(), real_multiplier,
+                    *y_zero_point->template Data<uint8_t>(), output_size);
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/math/matmul_integer.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+// QLinearMatMul on the int8 GEMM of MatMulInteger. uint8 inputs are shifted to int8, with their zero points, and the
+// int32 product is requantized to the output type.
+class QLinearMatMul final : public MatMulIntegerBase {
+ public:
+  QLinearMatMul(const OpKernelInfo& info) : MatMulIntegerBase(info) {}
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  // the int8 data and zero point of a quantized input. uint8 data is shifted into shifted_holder.
+  Status GetInt8Input(const Tensor& input,
+                      const Tensor& zero_point,
+                      const int8_t*& data,
+                      int8_t& offset,
+                      IAllocatorUniquePtr<int8_t>& shifted_holder) const;
+};
+
+}  // namespace cuda
+}  // namespace onnxruntime
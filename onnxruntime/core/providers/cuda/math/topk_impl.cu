@@ -8,6 +8,7 @@
 #include "cub/util_type.cuh"
 #include "cub/util_allocator.cuh"
 #include "cub/device/device_radix_sort.cuh"
+#include <algorithm>
 #include <limits>
 
 namespace onnxruntime {
@@ -175,7 +176,7 @@ __device__ int32_t Radix(const float* f, int64_t skip) {
 }
 
 __device__ int32_t Radix(const double* d, int64_t skip) {
-  return Radix((const double*)d, skip);
+  return Radix((const int64_t*)d, skip);
 }
 
 template<typename T>
@@ -341,33 +342,48 @@ __global__ void RadixTopK(const T* X, T* V, int64_t* I, const int64_t* elem_nums
   }
 }
 
+// the rows first_row.. of the input one after the other, with the index of each element in its row
 template <typename T>
-__global__ void FillInput(const T* input_x, T* output_v, int64_t* output_i, const int64_t* elem_nums, size_t size, int64_t axis, int64_t K, int64_t offset, int64_t dimension) {
-  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, dimension);
-  auto left = offset / (axis == size - 1 ? 1 : elem_nums[axis + 1]) * elem_nums[axis];
-  auto right = axis == size - 1 ? 0 : offset % elem_nums[axis + 1];
-  auto input_offset = left + id * (axis == size - 1 ? 1 : elem_nums[axis + 1]) + right;
+__global__ void FillInput(const T* input_x, T* output_v, int64_t* output_i, const int64_t* elem_nums, size_t size, int64_t axis, int64_t first_row, int64_t dimension, int64_t num_elements) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, num_elements);
+  auto row = first_row + id / dimension;
+  auto elem = id % dimension;
+  auto left = row / (axis == size - 1 ? 1 : elem_nums[axis + 1]) * elem_nums[axis];
+  auto right = axis == size - 1 ? 0 : row % elem_nums[axis + 1];
+  auto input_offset = left + elem * (axis == size - 1 ? 1 : elem_nums[axis + 1]) + right;
   output_v[id] = input_x[input_offset];
-  output_i[id] = id;
+  output_i[id] = elem;
 }
 
+// the first K elements of each of the sorted rows from first_row
 template <typename T>
-__global__ void FillOutput(const T* input_v, const int64_t* input_i, T* output_v, int64_t* output_i, const int64_t* elem_nums, size_t size, int64_t axis, int64_t K, int64_t offset, int64_t dimension) {
-  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, K);
-  auto left = offset / (axis == size - 1 ? 1 : elem_nums[axis + 1]) * elem_nums[axis] * K / dimension;
-  auto right = axis == size - 1 ? 0 : offset % elem_nums[axis + 1];
-  auto output_offset = left + id * (axis == size - 1 ? 1 : elem_nums[axis + 1]) + right;
-  output_v[output_offset] = input_v[id];
-  output_i[output_offset] = input_i[id];
+__global__ void FillOutput(const T* input_v, const int64_t* input_i, T* output_v, int64_t* output_i, const int64_t* elem_nums, size_t size, int64_t axis, int64_t K, int64_t first_row, int64_t dimension, int64_t num_elements) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, num_elements);
+  auto row = first_row + id / K;
+  auto k = id % K;
+  auto input_offset = id / K * dimension + k;
+  auto left = row / (axis == size - 1 ? 1 : elem_nums[axis + 1]) * elem_nums[axis] * K / dimension;
+  auto right = axis == size - 1 ? 0 : row % elem_nums[axis + 1];
+  auto output_offset = left + k * (axis == size - 1 ? 1 : elem_nums[axis + 1]) + right;
+  output_v[output_offset] = input_v[input_offset];
+  output_i[output_offset] = input_i[input_offset];
 }
 
-__global__ void ExcludeOutput(int64_t* output_i, int64_t K, int64_t dimension) {
-  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, dimension);
-  if (id >= K) {
+__global__ void ExcludeOutput(int64_t* output_i, int64_t K, int64_t dimension, int64_t num_elements) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, num_elements);
+  if (id % dimension >= K) {
     output_i[id] = dimension;
   }
 }
 
+__global__ void RowOffsets(int* offsets, int64_t dimension, int64_t num_rows) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, num_rows + 1);
+  offsets[id] = static_cast<int>(id * dimension);
+}
+
+// bound of the elements sorted together by the segmented sort of the rows
+constexpr int64_t kMaxSortElements = 1 << 22;
+
 template <typename T>
 Status TopKImpl(const CudaKernel* kernel, const T* input_x, T* output_v, int64_t* output_i, const int64_t* elem_nums, size_t size, int64_t axis, int64_t K, int64_t largest, int64_t sorted, int64_t N, int64_t dimension) {
   auto aligned_K = ALIGN(K);
@@ -386,31 +402,45 @@ Status TopKImpl(const CudaKernel* kernel, const T* input_x, T* output_v, int64_t
       RadixTopK<T,BT,16><<<N,BT,256*sizeof(uint32_t)>>>(input_x, output_v, output_i, elem_nums, size, axis, K, largest, sorted, dimension, XPT, std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max());
     }
   } else {
-    auto input_key_buffer = kernel->GetScratchBuffer<T>(dimension);
-    auto output_key_buffer = kernel->GetScratchBuffer<T>(dimension);
-    auto input_value_buffer = kernel->GetScratchBuffer<int64_t>(dimension);
-    auto output_value_buffer = kernel->GetScratchBuffer<int64_t>(dimension);
+    // sort the rows with a segmented sort, as many rows at once as fit in kMaxSortElements
+    auto rows_per_sort = std::max<int64_t>(1, std::min<int64_t>(N, kMaxSortElements / dimension));
+    auto max_elements = rows_per_sort * dimension;
+    auto input_key_buffer = kernel->GetScratchBuffer<T>(max_elements);
+    auto output_key_buffer = kernel->GetScratchBuffer<T>(max_elements);
+    auto input_value_buffer = kernel->GetScratchBuffer<int64_t>(max_elements);
+    auto output_value_buffer = kernel->GetScratchBuffer<int64_t>(max_elements);
+    auto offsets_buffer = kernel->GetScratchBuffer<int>(rows_per_sort + 1);
     auto* input_key = input_key_buffer.get();
     auto* output_key = output_key_buffer.get();
     auto* input_value = input_value_buffer.get();
     auto* output_value = output_value_buffer.get();
+    auto* offsets = offsets_buffer.get();
     size_t temp_bytes = 0;
-    CUDA_RETURN_IF_ERROR(cub::DeviceRadixSort::SortPairs(nullptr, temp_bytes, input_key, output_key, input_value, output_value, dimension));
+    CUDA_RETURN_IF_ERROR(cub::DeviceSegmentedRadixSort::SortPairs(nullptr, temp_bytes, input_key, output_key, input_value, output_value, static_cast<int>(max_elements), static_cast<int>(rows_per_sort), offsets, offsets + 1));
+    if (0 == sorted) {
+      size_t index_sort_temp_bytes = 0;
+      CUDA_RETURN_IF_ERROR(cub::DeviceSegmentedRadixSort::SortPairs(nullptr, index_sort_temp_bytes, output_value, input_value, output_key, input_key, static_cast<int>(max_elements), static_cast<int>(rows_per_sort), offsets, offsets + 1));
+      temp_bytes = std::max(temp_bytes, index_sort_temp_bytes);
+    }
     auto temp_storage_buffer = kernel->GetScratchBuffer<char>(temp_bytes);
     auto* temp_storage = temp_storage_buffer.get();
-    auto blocks_per_grid_D = (int)(ceil(static_cast<float>(dimension) / BT));
-    auto blocks_per_grid_K = (int)(ceil(static_cast<float>(K) / BT));
-    for (int64_t i = 0; i < N; i++) {
-      FillInput<T><<<blocks_per_grid_D, BT, 0>>>(input_x, input_key, input_value, elem_nums, size, axis, K, i, dimension);
-      CUDA_RETURN_IF_ERROR(1 == largest ? cub::DeviceRadixSort::SortPairsDescending(temp_storage, temp_bytes, input_key, output_key, input_value, output_value, dimension) : cub::DeviceRadixSort::SortPairs(temp_storage, temp_bytes, input_key, output_key, input_value, output_value, dimension));
+    RowOffsets<<<(int)(ceil(static_cast<float>(rows_per_sort + 1) / BT)), BT, 0>>>(offsets, dimension, rows_per_sort);
+    for (int64_t first_row = 0; first_row < N; first_row += rows_per_sort) {
+      auto rows = std::min(rows_per_sort, N - first_row);
+      auto num_elements = static_cast<int>(rows * dimension);
+      auto num_outputs = rows * K;
+      auto blocks_per_grid_D = (int)(ceil(static_cast<float>(num_elements) / BT));
+      auto blocks_per_grid_K = (int)(ceil(static_cast<float>(num_outputs) / BT));
+      FillInput<T><<<blocks_per_grid_D, BT, 0>>>(input_x, input_key, input_value, elem_nums, size, axis, first_row, dimension, num_elements);
+      CUDA_RETURN_IF_ERROR(1 == largest ? cub::DeviceSegmentedRadixSort::SortPairsDescending(temp_storage, temp_bytes, input_key, output_key, input_value, output_value, num_elements, static_cast<int>(rows), offsets, offsets + 1) : cub::DeviceSegmentedRadixSort::SortPairs(temp_storage, temp_bytes, input_key, output_key, input_value, output_value, num_elements, static_cast<int>(rows), offsets, offsets + 1));
       if (1 == sorted) {
-        FillOutput<T><<<blocks_per_grid_K, BT, 0>>>(output_key, output_value, output_v, output_i, elem_nums, size, axis, K, i, dimension);
+        FillOutput<T><<<blocks_per_grid_K, BT, 0>>>(output_key, output_value, output_v, output_i, elem_nums, size, axis, K, first_row, dimension, num_outputs);
       } else {  //reorder by ascending index
-        ExcludeOutput<<<blocks_per_grid_D, BT, 0>>>(output_value, K, dimension);
-        CUDA_RETURN_IF_ERROR(cub::DeviceRadixSort::SortPairs(temp_storage, temp_bytes, output_value, input_value, output_key, input_key, dimension));
-        FillOutput<T><<<blocks_per_grid_K, BT, 0>>>(input_key, input_value, output_v, output_i, elem_nums, size, axis, K, i, dimension);
+        ExcludeOutput<<<blocks_per_grid_D, BT, 0>>>(output_value, K, dimension, num_elements);
+        CUDA_RETURN_IF_ERROR(cub::DeviceSegmentedRadixSort::SortPairs(temp_storage, temp_bytes, output_value, input_value, output_key, input_key, num_elements, static_cast<int>(rows), offsets, offsets + 1));
+        FillOutput<T><<<blocks_per_grid_K, BT, 0>>>(input_key, input_value, output_v, output_i, elem_nums, size, axis, K, first_row, dimension, num_outputs);
       }
-    } 
+    }
   }
   return Status::OK();
 }
@@ -54,17 +54,14 @@ Status Conv<T>::ComputeInternal(OpKernelContext* context) const {
 
   {
     std::lock_guard<OrtMutex> lock(s_.mutex);
-    // TODO: add a global cache if need to handle cases for multiple frames running simultaneuously with different batch_size
     bool input_dims_changed = (s_.last_x_dims != x_dims);
     bool w_dims_changed = (s_.last_w_dims != w_dims);
     if (input_dims_changed || w_dims_changed) {
       if (input_dims_changed)
         s_.last_x_dims = x_dims;
 
-      if (w_dims_changed) {
+      if (w_dims_changed)
         s_.last_w_dims = w_dims;
-        s_.cached_benchmark_results.clear();
-      }
 
       const int64_t N = X->Shape()[0];
       const int64_t M = W->Shape()[0];
@@ -135,7 +132,12 @@ Status Conv<T>::ComputeInternal(OpKernelContext* context) const {
         ORT_RETURN_IF_ERROR(s_.b_tensor.Set(b_dims, CudnnTensor::GetDataType<CudaT>()));
       }
 
-      if (!s_.cached_benchmark_results.contains(x_dims_cudnn)) {
+      // the algorithms are searched once per problem on a device, see CudnnAlgoCache
+      auto& algo_cache = CudnnAlgoCache::Get(GetDeviceId());
+      const auto algo_key = CudnnAlgoCache::MakeKey("fwd", CudnnTensor::GetDataType<CudaT>(), x_dims_cudnn, w_dims,
+                                                    pads, strides, dilations, conv_attrs_.group);
+      CudnnAlgoCache::Entry perf_entry;
+      if (!algo_cache.Lookup(algo_key, perf_entry)) {
         IAllocatorUniquePtr<void> algo_search_workspace = GetScratchBuffer<void>(AlgoSearchWorkspaceSize);
 
         // set math type to tensor core before algorithm search
@@ -158,13 +160,14 @@ Status Conv<T>::ComputeInternal(OpKernelContext* context) const {
             &perf,
             algo_search_workspace.get(),
             AlgoSearchWorkspaceSize));
-        s_.cached_benchmark_results.insert(x_dims_cudnn, {perf.algo, perf.memory, perf.mathType});
+        perf_entry = {perf.algo, static_cast<int64_t>(perf.memory), perf.mathType};
+        algo_cache.Insert(algo_key, perf_entry);
       }
 
-      const auto& perf = s_.cached_benchmark_results.at(x_dims_cudnn);
-      CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, perf.mathType));
-      s_.algo = perf.algo;
-      s_.workspace_bytes = perf.memory;
+      CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc,
+                                                        static_cast<cudnnMathType_t>(perf_entry.math_type)));
+      s_.algo = static_cast<cudnnConvolutionFwdAlgo_t>(perf_entry.algo);
+      s_.workspace_bytes = static_cast<size_t>(perf_entry.workspace_bytes);
     }
   }
 
@@ -63,17 +63,14 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
 
   {
     std::lock_guard<OrtMutex> lock(s_.mutex);
-    // TODO: add a global cache if need to handle cases for multiple frames running simultaneuously with different batch_size
     bool input_dims_changed = (s_.last_x_dims != x_dims);
     bool w_dims_changed = (s_.last_w_dims != w_dims);
     if (input_dims_changed || w_dims_changed) {
       if (input_dims_changed)
         s_.last_x_dims = x_dims;
 
-      if (w_dims_changed) {
+      if (w_dims_changed)
         s_.last_w_dims = w_dims;
-        s_.cached_benchmark_results.clear();
-      }
 
       ConvTransposeAttributes::Prepare p;
       ORT_RETURN_IF_ERROR(conv_transpose_attrs_.PrepareForCompute(context, has_bias, p, dynamic_padding));
@@ -107,7 +104,12 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
 
       y_data = reinterpret_cast<CudaT*>(p.Y->template MutableData<T>());
 
-      if (!s_.cached_benchmark_results.contains(x_dims)) {
+      // the algorithms are searched once per problem on a device, see CudnnAlgoCache
+      auto& algo_cache = CudnnAlgoCache::Get(GetDeviceId());
+      const auto algo_key = CudnnAlgoCache::MakeKey("bwd_data", CudnnTensor::GetDataType<CudaT>(), x_dims, w_dims,
+                                                    p.pads, p.strides, p.dilations, conv_transpose_attrs_.group);
+      CudnnAlgoCache::Entry perf_entry;
+      if (!algo_cache.Lookup(algo_key, perf_entry)) {
         IAllocatorUniquePtr<void> algo_search_workspace = GetScratchBuffer<void>(AlgoSearchWorkspaceSize);
 
         // set math type to tensor core before algorithm search
@@ -130,13 +132,14 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
             &perf,
             algo_search_workspace.get(),
             AlgoSearchWorkspaceSize));
-        s_.cached_benchmark_results.insert(x_dims, {perf.algo, perf.memory, perf.mathType});
+        perf_entry = {perf.algo, static_cast<int64_t>(perf.memory), perf.mathType};
+        algo_cache.Insert(algo_key, perf_entry);
       }
 
-      const auto& perf = s_.cached_benchmark_results.at(x_dims);
-      CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, perf.mathType));
-      s_.algo = perf.algo;
-      s_.workspace_bytes = perf.memory;
+      CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc,
+                                                        static_cast<cudnnMathType_t>(perf_entry.math_type)));
+      s_.algo = static_cast<cudnnConvolutionBwdDataAlgo_t>(perf_entry.algo);
+      s_.workspace_bytes = static_cast<size_t>(perf_entry.workspace_bytes);
     }
   }
 
@@ -21,11 +21,11 @@ limitations under the License.
 
 #include "core/framework/tensor.h"
 
-#include <thrust/device_vector.h>
-#include <thrust/execution_policy.h>
-
 #include <cub/cub.cuh>
 
+#include <algorithm>
+#include <vector>
+
 namespace onnxruntime {
 namespace cuda {
 
@@ -86,38 +86,56 @@ __device__ inline bool CheckBit(T* bit_mask, int bit) {
   return (bit_mask[bin] >> (bit & kRemainderMask)) & 1;
 }
 
-// Produce a global bitmask (result_mask) of selected boxes from bitmask
-// generated by NMSKernel Abort early if max_boxes boxes are selected. Bitmask
-// is num_boxes*bit_mask_len bits indicating whether to keep or remove a box.
-__global__ void NMSReduce(const int* bitmask, const int bit_mask_len,
-                          const int num_boxes, const int max_boxes,
-                          char* result_mask) {
-  extern __shared__ int local[];
+template <typename T>
+__global__ void SetZero(const int count, T* __restrict__ ptr) {
+  // Check that the grid is one dimensional and index doesn't overflow.
+  assert(blockDim.y == 1);
+  assert(blockDim.z == 1);
+  assert(blockDim.x * gridDim.x / blockDim.x == gridDim.x);
+  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < count; i += blockDim.x * gridDim.x) {
+    ptr[i] = T(0);
+  }
+}
+
+// A segment is the boxes of a (batch, class) pair, sorted by descending score; segment s is at s * num_boxes in the
+// sorted arrays. The segments are processed together, each launch handling all of them or a chunk of them.
 
-  // set global mask to accept all boxes
-  for (int box = blockIdx.x * blockDim.x + threadIdx.x; box < bit_mask_len; box += blockDim.x * gridDim.x) {
-    local[box] = 0xFFFFFFFF;
+__global__ void SegmentOffsets(const int num_segments, const int num_boxes, int* offsets) {
+  for (int idx = blockIdx.x * blockDim.x + threadIdx.x; idx <= num_segments; idx += blockDim.x * gridDim.x) {
+    offsets[idx] = idx * num_boxes;
   }
-  __syncthreads();
-  int accepted_boxes = 0;
-  for (int box = 0; box < num_boxes - 1; ++box) {
-    // if current box is masked by an earlier box, skip it.
-    if (!CheckBit(local, box)) {
-      continue;
-    }
-    accepted_boxes += 1;
-    int offset = box * bit_mask_len;
-    // update global mask with current box's mask
-    for (int b = blockIdx.x * blockDim.x + threadIdx.x; b < bit_mask_len; b += blockDim.x * gridDim.x) {
-      local[b] &= ~bitmask[offset + b];
-    }
-    __syncthreads();
-    if (accepted_boxes > max_boxes) break;
+}
+
+// the index of each box in its batch, the sorting values
+__global__ void SegmentIota(const int num_elements, const int num_boxes, int* to_fill) {
+  for (int idx = blockIdx.x * blockDim.x + threadIdx.x; idx < num_elements; idx += blockDim.x * gridDim.x) {
+    to_fill[idx] = idx % num_boxes;
   }
-  // copy global mask to result_max char array. char array is needed for
-  // cub::DeviceSelect later.
-  for (int box = blockIdx.x * blockDim.x + threadIdx.x; box < num_boxes; box += blockDim.x * gridDim.x) {
-    result_mask[box] = CheckBit(local, box);
+}
+
+__global__ void GatherSortedBoxes(const int num_elements, const int num_boxes, const int64_t num_classes,
+                                  const int* sorted_indices, const Box* boxes, Box* sorted_boxes) {
+  for (int idx = blockIdx.x * blockDim.x + threadIdx.x; idx < num_elements; idx += blockDim.x * gridDim.x) {
+    const int64_t batch_index = idx / num_boxes / num_classes;
+    sorted_boxes[idx] = boxes[batch_index * num_boxes + sorted_indices[idx]];
+  }
+}
+
+// the number of boxes of each segment over the score threshold, found by a binary search of the sorted scores
+__global__ void CountOverThreshold(const int num_segments, const int num_boxes, const float* sorted_scores,
+                                   const float score_threshold, int* segment_num_boxes) {
+  for (int s = blockIdx.x * blockDim.x + threadIdx.x; s < num_segments; s += blockDim.x * gridDim.x) {
+    const float* scores = sorted_scores + s * num_boxes;
+    int low = 0, high = num_boxes;
+    while (low < high) {
+      const int mid = (low + high) / 2;
+      if (scores[mid] > score_threshold) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    segment_num_boxes[s] = low;
   }
 }
 
@@ -126,194 +144,122 @@ __global__ void NMSReduce(const int* bitmask, const int bit_mask_len,
 //
 // Starting from highes scoring box, mark any box which has IoU>threshold with
 // given box. Each thread processes a kNmsBoxesPerThread boxes per stride, and
-// each box has bitmask of overlaps of length bit_mask_len.
+// each box has bitmask of overlaps of length bit_mask_len. The segments are along
+// the z axis of the grid, each with a mask of max_num_boxes * bit_mask_len.
 //
 __launch_bounds__(kNmsBlockDim* kNmsBlockDim, 4) __global__
     void NMSKernel(
         const int64_t center_point_box,
         const Box* d_desc_sorted_boxes,
-        const int num_boxes,
+        const int* segment_num_boxes,
+        const int num_segments,
+        const int boxes_stride,
+        const int max_num_boxes,
         const float iou_threshold,
         const int bit_mask_len,
         int* d_delete_mask) {
-  for (int i_block_offset = blockIdx.x * blockDim.x; i_block_offset < num_boxes;
-       i_block_offset += blockDim.x * gridDim.x) {
-    const int i = i_block_offset + threadIdx.x;
-    if (i < num_boxes) {
-      for (int j_thread_offset =
-               kNmsBoxesPerThread * (blockIdx.y * blockDim.y + threadIdx.y);
-           j_thread_offset < num_boxes;
-           j_thread_offset += kNmsBoxesPerThread * blockDim.y * gridDim.y) {
-        // Note : We can do everything using multiplication,
-        // and use fp16 - we are comparing against a low precision
-        // threshold.
-        int above_threshold = 0;
-        // Make sure that threads are within valid domain.
-        bool valid = false;
-        // Loop over the next kNmsBoxesPerThread boxes and set corresponding bit
-        // if it is overlapping with current box
-        for (int ib = 0; ib < kNmsBoxesPerThread; ++ib) {
-          // This thread will compare Box i and Box j.
-          const int j = j_thread_offset + ib;
-          if (i >= j || i >= num_boxes || j >= num_boxes) continue;
-          valid = true;
-          if (SuppressByIOU(reinterpret_cast<const float*>(d_desc_sorted_boxes),
-                            i, j, center_point_box, iou_threshold)) {
-            // we have score[j] <= score[i].
-            above_threshold |= (1U << ib);
+  for (int s = blockIdx.z; s < num_segments; s += gridDim.z) {
+    const int num_boxes = segment_num_boxes[s];
+    const Box* boxes = d_desc_sorted_boxes + s * boxes_stride;
+    int* delete_mask = d_delete_mask + s * max_num_boxes * bit_mask_len;
+    for (int i_block_offset = blockIdx.x * blockDim.x; i_block_offset < num_boxes;
+         i_block_offset += blockDim.x * gridDim.x) {
+      const int i = i_block_offset + threadIdx.x;
+      if (i < num_boxes) {
+        for (int j_thread_offset =
+                 kNmsBoxesPerThread * (blockIdx.y * blockDim.y + threadIdx.y);
+             j_thread_offset < num_boxes;
+             j_thread_offset += kNmsBoxesPerThread * blockDim.y * gridDim.y) {
+          // Note : We can do everything using multiplication,
+          // and use fp16 - we are comparing against a low precision
+          // threshold.
+          int above_threshold = 0;
+          // Make sure that threads are within valid domain.
+          bool valid = false;
+          // Loop over the next kNmsBoxesPerThread boxes and set corresponding bit
+          // if it is overlapping with current box
+          for (int ib = 0; ib < kNmsBoxesPerThread; ++ib) {
+            // This thread will compare Box i and Box j.
+            const int j = j_thread_offset + ib;
+            if (i >= j || i >= num_boxes || j >= num_boxes) continue;
+            valid = true;
+            if (SuppressByIOU(reinterpret_cast<const float*>(boxes),
+                              i, j, center_point_box, iou_threshold)) {
+              // we have score[j] <= score[i].
+              above_threshold |= (1U << ib);
+            }
+          }
+          if (valid) {
+            delete_mask[i * bit_mask_len + j_thread_offset / kNmsBoxesPerThread] =
+                above_threshold;
           }
-        }
-        if (valid) {
-          d_delete_mask[i * bit_mask_len + j_thread_offset / kNmsBoxesPerThread] =
-              above_threshold;
         }
       }
     }
   }
 }
-// Variadic template helpers for Index selecting multiple arrays at the same
-// time
-template <typename Index>
-__device__ inline void SelectHelper(const Index i_selected,
-                                    const Index i_original) {}
-
-template <typename Index, typename T, typename... Args>
-__device__ inline void SelectHelper(const Index i_selected,
-                                    const Index i_original,
-                                    const T* original, T* selected,
-                                    Args... args) {
-  selected[i_selected] = original[i_original];
-  SelectHelper(i_selected, i_original, args...);
-}
 
-// Helper template to select elements from original arrays using the index
-// mapping and store into selected array. Each array sharing same mapping need
-// to be passed as pairs of pointers to original and selected arrays. For
-// selecting 2 arrays call would be
-// IndexMultiSelect(num_elements, indices, original1 ,selected1, original2,
-// selected2).
-template <typename Index, typename T, typename... Args>
-__global__ void IndexMultiSelect(const int num_elements, const Index* indices,
-                                 const T* original, T* selected, Args... args) {
-  for (int idx = blockIdx.x * blockDim.x + threadIdx.x; idx < num_elements; idx += blockDim.x * gridDim.x) {
-    SelectHelper(idx, indices[idx], original, selected, args...);
-  }
-}
+// Select the boxes of each segment from the bitmasks generated by NMSKernel, a block per segment. A box is selected
+// unless masked by an earlier selected box; stops once max_boxes are selected. Writes the index in its batch of each
+// selected box, in order of descending score, at s * max_boxes, and their number.
+__global__ void NMSReduce(const int* bitmask, const int bit_mask_len, const int max_num_boxes,
+                          const int* segment_num_boxes, const int* sorted_indices, const int boxes_stride,
+                          const int max_boxes, int* selected_indices, int* num_selected) {
+  extern __shared__ int local[];
+  const int s = blockIdx.x;
+  const int num_boxes = segment_num_boxes[s];
+  const int* segment_bitmask = bitmask + s * max_num_boxes * bit_mask_len;
 
-template <typename T>
-__global__ void SetZero(const int count, T* __restrict__ ptr) {
-  // Check that the grid is one dimensional and index doesn't overflow.
-  assert(blockDim.y == 1);
-  assert(blockDim.z == 1);
-  assert(blockDim.x * gridDim.x / blockDim.x == gridDim.x);
-  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < count; i += blockDim.x * gridDim.x) {
-    ptr[i] = T(0);
+  // set the mask to accept all boxes
+  for (int b = threadIdx.x; b < bit_mask_len; b += blockDim.x) {
+    local[b] = 0xFFFFFFFF;
+  }
+  __syncthreads();
+  int accepted_boxes = 0;
+  for (int box = 0; box < num_boxes && accepted_boxes < max_boxes; ++box) {
+    // if current box is masked by an earlier box, skip it.
+    if (!CheckBit(local, box)) {
+      continue;
+    }
+    accepted_boxes += 1;
+    int offset = box * bit_mask_len;
+    // update the mask with current box's mask
+    for (int b = threadIdx.x; b < bit_mask_len; b += blockDim.x) {
+      local[b] &= ~segment_bitmask[offset + b];
+    }
+    __syncthreads();
   }
-}
 
-template <typename T>
-__global__ void Iota(const int num_elements, const T offset, T* to_fill) {
-  for (int idx = blockIdx.x * blockDim.x + threadIdx.x; idx < num_elements; idx += blockDim.x * gridDim.x) {
-    to_fill[idx] = static_cast<T>(idx) + offset;
+  if (threadIdx.x == 0) {
+    int count = 0;
+    for (int box = 0; box < num_boxes && count < max_boxes; ++box) {
+      if (CheckBit(local, box)) {
+        selected_indices[s * max_boxes + count] = sorted_indices[s * boxes_stride + box];
+        ++count;
+      }
+    }
+    num_selected[s] = count;
   }
 }
 
-__global__ void NormalizeOutput(const int num_elements, const int* original, int64_t* to_normalize, int64_t batch_index, int64_t class_index) {
+// writes the (batch, class, box) triplets of the selected boxes of the segments one after the other
+__global__ void WriteSelectedIndices(const int num_elements, const int max_boxes, const int64_t num_classes,
+                                     const int* selected_indices, const int* num_selected, const int* output_offsets,
+                                     int64_t* output) {
   for (int idx = blockIdx.x * blockDim.x + threadIdx.x; idx < num_elements; idx += blockDim.x * gridDim.x) {
-    to_normalize[idx * 3] = batch_index;
-    to_normalize[idx * 3 + 1] = class_index;
-    to_normalize[idx * 3 + 2] = static_cast<int64_t>(original[idx]);
+    const int s = idx / max_boxes;
+    const int k = idx % max_boxes;
+    if (k < num_selected[s]) {
+      int64_t* triplet = output + (output_offsets[s] + k) * 3;
+      triplet[0] = s / num_classes;
+      triplet[1] = s % num_classes;
+      triplet[2] = static_cast<int64_t>(selected_indices[idx]);
+    }
   }
 }
 
-Status NmsGpu(std::function<IAllocatorUniquePtr<void>(size_t)> allocator,
-              const int64_t center_point_box,
-              const float* d_sorted_boxes_float_ptr,
-              const int num_boxes,
-              const float iou_threshold,
-              int* d_selected_indices,
-              int* h_nkeep,
-              const int max_boxes) {
-  // Making sure we respect the __align(16)__
-  // we promised to the compiler.
-  auto iptr = reinterpret_cast<std::uintptr_t>(d_sorted_boxes_float_ptr);
-  ORT_ENFORCE((iptr & 15) == 0);
-
-  const int bit_mask_len =
-      (num_boxes + kNmsBoxesPerThread - 1) / kNmsBoxesPerThread;
-  int max_nms_mask_size = num_boxes * bit_mask_len;
-
-  IAllocatorUniquePtr<void> d_nms_mask_ptr{allocator(max_nms_mask_size * sizeof(int))};
-  auto* d_nms_mask = static_cast<int*>(d_nms_mask_ptr.get());
-
-  int blocksPerGrid = (int)(ceil(static_cast<float>(max_nms_mask_size) / GridDim::maxThreadsPerBlock));
-  SetZero<int><<<blocksPerGrid, GridDim::maxThreadsPerBlock>>>(max_nms_mask_size, d_nms_mask);
-
-  int* d_delete_mask = d_nms_mask;
-  int* h_selected_count = h_nkeep;
-  const Box* d_sorted_boxes =
-      reinterpret_cast<const Box*>(d_sorted_boxes_float_ptr);
-  dim3 block_dim, thread_block;
-  int num_blocks = (num_boxes + kNmsBlockDim - 1) / kNmsBlockDim;
-  num_blocks = std::max(std::min(num_blocks, kNmsBlockDimMax), 1);
-  block_dim.x = num_blocks;
-  block_dim.y = num_blocks;
-  block_dim.z = 1;
-  thread_block.x = kNmsBlockDim;
-  thread_block.y = kNmsBlockDim;
-  thread_block.z = 1;
-  NMSKernel<<<block_dim, thread_block>>>(center_point_box,
-                                         d_sorted_boxes,
-                                         num_boxes,
-                                         iou_threshold,
-                                         bit_mask_len,
-                                         d_delete_mask);
-
-  IAllocatorUniquePtr<void> d_selected_boxes_ptr{allocator(num_boxes * sizeof(char))};
-  auto* d_selected_boxes = static_cast<char*>(d_selected_boxes_ptr.get());
-  IAllocatorUniquePtr<void> d_indices_ptr{allocator(num_boxes * sizeof(int))};
-  auto* d_indices = static_cast<int*>(d_indices_ptr.get());
-
-  blocksPerGrid = (int)(ceil(static_cast<float>(num_boxes) / GridDim::maxThreadsPerBlock));
-  Iota<int><<<blocksPerGrid, GridDim::maxThreadsPerBlock>>>(num_boxes, 0, d_indices);
-
-  NMSReduce<<<1, 1024, bit_mask_len * sizeof(int)>>>(d_delete_mask, bit_mask_len, num_boxes, max_boxes, d_selected_boxes);
-
-  size_t flagged_buffer_size = 0;
-  CUDA_RETURN_IF_ERROR(cub::DeviceSelect::Flagged(static_cast<void*>(nullptr),  // temp_storage
-                                                  flagged_buffer_size,
-                                                  static_cast<int*>(nullptr),   // input
-                                                  static_cast<char*>(nullptr),  // selection flag
-                                                  static_cast<int*>(nullptr),   // selected items
-                                                  static_cast<int*>(nullptr),   // num_selected
-                                                  num_boxes));
-
-  IAllocatorUniquePtr<void> d_cub_scratch_buffer_ptr{allocator(flagged_buffer_size)};
-  auto* d_cub_scratch_buffer = static_cast<uint8_t*>(d_cub_scratch_buffer_ptr.get());
-  IAllocatorUniquePtr<void> d_num_selected_ptr{allocator(sizeof(int))};
-  auto* d_num_selected = static_cast<int*>(d_num_selected_ptr.get());
-
-  CUDA_RETURN_IF_ERROR(cub::DeviceSelect::Flagged(
-      d_cub_scratch_buffer,  // temp_storage
-      flagged_buffer_size,
-      d_indices,           // input
-      d_selected_boxes,    // selection flag
-      d_selected_indices,  // selected items
-      d_num_selected, num_boxes));
-  CUDA_RETURN_IF_ERROR(cudaMemcpy(h_selected_count, d_num_selected, sizeof(int), cudaMemcpyDeviceToHost));
-
-  return Status::OK();
-}
-
-struct DeviceGreaterThan {
-  float threshold_;
-  __host__ __device__ __forceinline__ DeviceGreaterThan(float threshold)
-      : threshold_(threshold) {}
-
-  __host__ __device__ __forceinline__ bool operator()(const float& val) const {
-    return (val > threshold_);
-  }
-};
+// bound of the bitmasks of a launch of NMSKernel, the segments are processed in chunks to stay under it
+constexpr size_t kNmsMaxMaskBytes = 64 * 1024 * 1024;
 
 }  // namespace
 
@@ -321,112 +267,158 @@ Status NonMaxSuppressionImpl(
     std::function<IAllocatorUniquePtr<void>(size_t)> allocator,
     const PrepareContext& pc,
     const int64_t center_point_box,
-    int64_t batch_index,
-    int64_t class_index,
     int max_output_boxes_per_class,
     float iou_threshold,
     float score_threshold,
     IAllocatorUniquePtr<void>& selected_indices,
     int* h_number_selected) {
-  // STEP 1. Prepare data
-  int num_boxes = pc.num_boxes_;
-  const float* boxes_data = pc.boxes_data_ + batch_index * num_boxes * 4;
-  const float* scores_data = pc.scores_data_ + (batch_index * pc.num_classes_ + class_index) * num_boxes;
+  // STEP 1. Sort the scores of all the segments at once
+  const int num_boxes = static_cast<int>(pc.num_boxes_);
+  const int num_segments = static_cast<int>(pc.num_batches_ * pc.num_classes_);
+  const int num_elements = num_segments * num_boxes;
+
+  IAllocatorUniquePtr<void> d_offsets_ptr{allocator((num_segments + 1) * sizeof(int))};
+  auto* d_offsets = static_cast<int*>(d_offsets_ptr.get());
+  IAllocatorUniquePtr<void> d_indices_ptr{allocator(num_elements * sizeof(int))};
+  auto* d_indices = static_cast<int*>(d_indices_ptr.get());
+  IAllocatorUniquePtr<void> d_sorted_indices_ptr{allocator(num_elements * sizeof(int))};
+  auto* d_sorted_indices = static_cast<int*>(d_sorted_indices_ptr.get());
+  IAllocatorUniquePtr<void> d_sorted_scores_ptr{allocator(num_elements * sizeof(float))};
+  auto* d_sorted_scores = static_cast<float*>(d_sorted_scores_ptr.get());
+  IAllocatorUniquePtr<void> d_sorted_boxes_ptr{allocator(num_elements * 4 * sizeof(float))};
+  auto* d_sorted_boxes = static_cast<Box*>(d_sorted_boxes_ptr.get());
 
-  // prepare temporary memory for sorting scores
+  int blocksPerGrid = (int)(ceil(static_cast<float>(num_segments + 1) / GridDim::maxThreadsPerBlock));
+  SegmentOffsets<<<blocksPerGrid, GridDim::maxThreadsPerBlock>>>(num_segments, num_boxes, d_offsets);
+  blocksPerGrid = (int)(ceil(static_cast<float>(num_elements) / GridDim::maxThreadsPerBlock));
+  SegmentIota<<<blocksPerGrid, GridDim::maxThreadsPerBlock>>>(num_elements, num_boxes, d_indices);
+  CUDA_RETURN_IF_ERROR(cudaGetLastError());
 
-  // calculate temporary size that used for sorting
   size_t cub_sort_temp_storage_bytes = 0;
-  CUDA_RETURN_IF_ERROR(cub::DeviceRadixSort::SortPairsDescending(
+  CUDA_RETURN_IF_ERROR(cub::DeviceSegmentedRadixSort::SortPairsDescending(
       nullptr, cub_sort_temp_storage_bytes,
       static_cast<float*>(nullptr),  // scores
       static_cast<float*>(nullptr),  // sorted scores
       static_cast<int*>(nullptr),    // input indices
       static_cast<int*>(nullptr),    // sorted indices
-      num_boxes,                     // num items
-      0, 8 * sizeof(float)           // sort all bits
+      num_elements,                  // num items
+      num_segments,
+      d_offsets, d_offsets + 1,
+      0, 8 * sizeof(float)  // sort all bits
       ));
-
-  // allocate temporary memory
   IAllocatorUniquePtr<void> d_cub_sort_buffer_ptr{allocator(cub_sort_temp_storage_bytes)};
-  auto* d_cub_sort_buffer = static_cast<uint8_t*>(d_cub_sort_buffer_ptr.get());
-  IAllocatorUniquePtr<void> d_indices_ptr{allocator(num_boxes * sizeof(int))};
-  auto* d_indices = static_cast<int*>(d_indices_ptr.get());
-  IAllocatorUniquePtr<void> d_sorted_indices_ptr{allocator(num_boxes * sizeof(int))};
-  auto* d_sorted_indices = static_cast<int*>(d_sorted_indices_ptr.get());
-  IAllocatorUniquePtr<void> d_selected_indices_ptr{allocator(num_boxes * sizeof(int))};
-  auto* d_selected_indices = static_cast<int*>(d_selected_indices_ptr.get());
-  IAllocatorUniquePtr<void> d_sorted_scores_ptr{allocator(num_boxes * sizeof(float))};
-  auto* d_sorted_scores = static_cast<float*>(d_sorted_scores_ptr.get());
-  IAllocatorUniquePtr<void> d_sorted_boxes_ptr{allocator(num_boxes * 4 * sizeof(float))};
-  auto* d_sorted_boxes = static_cast<float*>(d_sorted_boxes_ptr.get());
-
-  // create sequense of indices
-  int blocksPerGrid = (int)(ceil(static_cast<float>(num_boxes) / GridDim::maxThreadsPerBlock));
-  Iota<int><<<blocksPerGrid, GridDim::maxThreadsPerBlock>>>(num_boxes, 0, d_indices);
-  CUDA_RETURN_IF_ERROR(cudaGetLastError());
-
-  // sort scores
-  CUDA_RETURN_IF_ERROR(cub::DeviceRadixSort::SortPairsDescending(
-      d_cub_sort_buffer,
-      cub_sort_temp_storage_bytes,
-      scores_data,
-      d_sorted_scores,
-      d_indices,
-      d_sorted_indices,
-      num_boxes,
-      0,
-      8 * sizeof(float)  // sort all bits
+  CUDA_RETURN_IF_ERROR(cub::DeviceSegmentedRadixSort::SortPairsDescending(
+      d_cub_sort_buffer_ptr.get(), cub_sort_temp_storage_bytes,
+      pc.scores_data_, d_sorted_scores,
+      d_indices, d_sorted_indices,
+      num_elements, num_segments,
+      d_offsets, d_offsets + 1,
+      0, 8 * sizeof(float)  // sort all bits
       ));
 
-  // pick sorted scores
-  const Box* original_boxes = reinterpret_cast<const Box*>(boxes_data);
-  Box* sorted_boxes = reinterpret_cast<Box*>(d_sorted_boxes);
-  IndexMultiSelect<int, Box><<<blocksPerGrid, GridDim::maxThreadsPerBlock>>>(num_boxes, d_sorted_indices, original_boxes, sorted_boxes);
+  GatherSortedBoxes<<<blocksPerGrid, GridDim::maxThreadsPerBlock>>>(num_elements, num_boxes, pc.num_classes_,
+                                                                    d_sorted_indices,
+                                                                    reinterpret_cast<const Box*>(pc.boxes_data_),
+                                                                    d_sorted_boxes);
   CUDA_RETURN_IF_ERROR(cudaGetLastError());
 
   // STEP 2. filter boxes by scores
-  int limited_num_boxes = num_boxes;
+  IAllocatorUniquePtr<void> d_segment_num_boxes_ptr{allocator(num_segments * sizeof(int))};
+  auto* d_segment_num_boxes = static_cast<int*>(d_segment_num_boxes_ptr.get());
+  int max_num_boxes = num_boxes;
   if (pc.score_threshold_ != nullptr) {
-    thrust::device_ptr<float> sorted_scores_device_ptr(d_sorted_scores);
-    limited_num_boxes = thrust::count_if(
-        sorted_scores_device_ptr,
-        sorted_scores_device_ptr + num_boxes,
-        DeviceGreaterThan(score_threshold));
-    CUDA_RETURN_IF_ERROR(cudaGetLastError());
-
-    if (limited_num_boxes == 0) {
+    blocksPerGrid = (int)(ceil(static_cast<float>(num_segments) / GridDim::maxThreadsPerBlock));
+    CountOverThreshold<<<blocksPerGrid, GridDim::maxThreadsPerBlock>>>(num_segments, num_boxes, d_sorted_scores,
+                                                                       score_threshold, d_segment_num_boxes);
+    std::vector<int> segment_num_boxes(num_segments);
+    CUDA_RETURN_IF_ERROR(cudaMemcpy(segment_num_boxes.data(), d_segment_num_boxes, num_segments * sizeof(int),
+                                    cudaMemcpyDeviceToHost));
+    max_num_boxes = *std::max_element(segment_num_boxes.begin(), segment_num_boxes.end());
+    if (max_num_boxes == 0) {
       *h_number_selected = 0;
       return Status::OK();
     }
+  } else {
+    std::vector<int> segment_num_boxes(num_segments, num_boxes);
+    CUDA_RETURN_IF_ERROR(cudaMemcpy(d_segment_num_boxes, segment_num_boxes.data(), num_segments * sizeof(int),
+                                    cudaMemcpyHostToDevice));
   }
 
-  // STEP 3. launch NMS kernels
-  ORT_RETURN_IF_ERROR(NmsGpu(allocator,
-                             center_point_box,
-                             d_sorted_boxes,
-                             limited_num_boxes,
-                             iou_threshold,
-                             d_selected_indices,
-                             h_number_selected,
-                             max_output_boxes_per_class));
-  CUDA_RETURN_IF_ERROR(cudaGetLastError());
+  // STEP 3. launch NMS kernels, on as many segments at once as the bitmasks allow
+  const int max_boxes = std::min(max_output_boxes_per_class, max_num_boxes);
+  const int bit_mask_len = (max_num_boxes + kNmsBoxesPerThread - 1) / kNmsBoxesPerThread;
+  const size_t segment_mask_size = static_cast<size_t>(max_num_boxes) * bit_mask_len;
+  const int chunk_segments = static_cast<int>(
+      std::min<size_t>(num_segments, std::max<size_t>(1, kNmsMaxMaskBytes / (segment_mask_size * sizeof(int)))));
 
-  // STEP 4. map back to sorted indices
-  *h_number_selected = std::min(*h_number_selected, max_output_boxes_per_class);
-  int num_to_keep = *h_number_selected;
-  if (num_to_keep > 0) {
-    IAllocatorUniquePtr<void> d_output_indices_ptr{allocator(num_to_keep * sizeof(int))};
-    auto* d_output_indices = static_cast<int*>(d_output_indices_ptr.get());
-    IAllocatorUniquePtr<void> d_normalized_output_indices_ptr{allocator(num_to_keep * 3 * sizeof(int64_t))};
-    auto* d_normalized_output_indices = static_cast<int64_t*>(d_normalized_output_indices_ptr.get());
-
-    int blocksPerGrid = (int)(ceil(static_cast<float>(num_to_keep) / GridDim::maxThreadsPerBlock));
-    IndexMultiSelect<int, int><<<blocksPerGrid, GridDim::maxThreadsPerBlock>>>(num_to_keep, d_selected_indices, d_sorted_indices, d_output_indices);
-    NormalizeOutput<<<blocksPerGrid, GridDim::maxThreadsPerBlock>>>(num_to_keep, d_output_indices, d_normalized_output_indices, batch_index, class_index);
+  IAllocatorUniquePtr<void> d_nms_mask_ptr{allocator(chunk_segments * segment_mask_size * sizeof(int))};
+  auto* d_nms_mask = static_cast<int*>(d_nms_mask_ptr.get());
+  IAllocatorUniquePtr<void> d_selected_indices_ptr{allocator(num_segments * max_boxes * sizeof(int))};
+  auto* d_selected_indices = static_cast<int*>(d_selected_indices_ptr.get());
+  IAllocatorUniquePtr<void> d_num_selected_ptr{allocator(num_segments * sizeof(int))};
+  auto* d_num_selected = static_cast<int*>(d_num_selected_ptr.get());
+
+  dim3 block_dim, thread_block;
+  int num_blocks = (max_num_boxes + kNmsBlockDim - 1) / kNmsBlockDim;
+  num_blocks = std::max(std::min(num_blocks, kNmsBlockDimMax), 1);
+  block_dim.x = num_blocks;
+  block_dim.y = num_blocks;
+  block_dim.z = std::min(chunk_segments, 65535);
+  thread_block.x = kNmsBlockDim;
+  thread_block.y = kNmsBlockDim;
+  thread_block.z = 1;
+  for (int first_segment = 0; first_segment < num_segments; first_segment += chunk_segments) {
+    const int segments = std::min(chunk_segments, num_segments - first_segment);
+    const int mask_size = static_cast<int>(segments * segment_mask_size);
+    blocksPerGrid = (int)(ceil(static_cast<float>(mask_size) / GridDim::maxThreadsPerBlock));
+    SetZero<int><<<blocksPerGrid, GridDim::maxThreadsPerBlock>>>(mask_size, d_nms_mask);
+
+    const int boxes_offset = first_segment * num_boxes;
+    NMSKernel<<<block_dim, thread_block>>>(center_point_box,
+                                           d_sorted_boxes + boxes_offset,
+                                           d_segment_num_boxes + first_segment,
+                                           segments,
+                                           num_boxes,
+                                           max_num_boxes,
+                                           iou_threshold,
+                                           bit_mask_len,
+                                           d_nms_mask);
+    NMSReduce<<<segments, 1024, bit_mask_len * sizeof(int)>>>(d_nms_mask, bit_mask_len, max_num_boxes,
+                                                               d_segment_num_boxes + first_segment,
+                                                               d_sorted_indices + boxes_offset, num_boxes,
+                                                               max_boxes,
+                                                               d_selected_indices + first_segment * max_boxes,
+                                                               d_num_selected + first_segment);
+    CUDA_RETURN_IF_ERROR(cudaGetLastError());
+  }
+
+  // STEP 4. write the (batch, class, box) triplets of all the segments one after the other
+  std::vector<int> num_selected(num_segments);
+  CUDA_RETURN_IF_ERROR(cudaMemcpy(num_selected.data(), d_num_selected, num_segments * sizeof(int),
+                                  cudaMemcpyDeviceToHost));
+  std::vector<int> output_offsets(num_segments);
+  int total_selected = 0;
+  for (int s = 0; s < num_segments; ++s) {
+    output_offsets[s] = total_selected;
+    total_selected += num_selected[s];
+  }
+  *h_number_selected = total_selected;
+  if (total_selected > 0) {
+    IAllocatorUniquePtr<void> d_output_offsets_ptr{allocator(num_segments * sizeof(int))};
+    auto* d_output_offsets = static_cast<int*>(d_output_offsets_ptr.get());
+    CUDA_RETURN_IF_ERROR(cudaMemcpy(d_output_offsets, output_offsets.data(), num_segments * sizeof(int),
+                                    cudaMemcpyHostToDevice));
+    IAllocatorUniquePtr<void> d_output_ptr{allocator(total_selected * 3 * sizeof(int64_t))};
+
+    const int num_candidates = num_segments * max_boxes;
+    blocksPerGrid = (int)(ceil(static_cast<float>(num_candidates) / GridDim::maxThreadsPerBlock));
+    WriteSelectedIndices<<<blocksPerGrid, GridDim::maxThreadsPerBlock>>>(num_candidates, max_boxes, pc.num_classes_,
+                                                                         d_selected_indices, d_num_selected,
+                                                                         d_output_offsets,
+                                                                         static_cast<int64_t*>(d_output_ptr.get()));
     CUDA_RETURN_IF_ERROR(cudaGetLastError());
 
-    selected_indices = std::move(d_normalized_output_indices_ptr);
+    selected_indices = std::move(d_output_ptr);
   }
 
   return Status::OK();
@@ -13,12 +13,12 @@
 namespace onnxruntime {
 namespace cuda {
 
+// Runs the NMS of all the batches and classes together. selected_indices is set to the [h_number_selected, 3]
+// selected (batch, class, box) indices, in order of batch, class and descending score.
 Status NonMaxSuppressionImpl(
     std::function<IAllocatorUniquePtr<void>(size_t)> allocator,
     const PrepareContext& pc,
     const int64_t center_point_box,
-    int64_t batch_index,
-    int64_t class_index,
     int max_output_boxes_per_class,
     float iou_threshold,
     float score_threshold,
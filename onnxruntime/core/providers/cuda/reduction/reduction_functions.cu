@@ -283,7 +283,7 @@ bool is_matrix_row_reduction(
   if (rank < 2)
     return false;
 
-  if (cudnn_reduce_op != CUDNN_REDUCE_TENSOR_ADD)
+  if (cudnn_reduce_op != CUDNN_REDUCE_TENSOR_ADD && cudnn_reduce_op != CUDNN_REDUCE_TENSOR_AVG)
     return false;
 
   // Check if all but the last axis are reduced. For example, reducing
@@ -301,7 +301,7 @@ bool is_matrix_row_reduction(
   return true;
 }
 
-template<typename TIn, typename TOut, typename TBuf>
+template<typename TIn, typename TOut, typename TBuf, bool DivideResultBySize>
 __global__ void reduce_matrix_rows_kernel(const TIn *input, TOut *output, int m, int n) {
   constexpr int x_load_count_per_thread = 1;
   constexpr int y_load_count_per_thread = 4;
@@ -351,7 +351,12 @@ __global__ void reduce_matrix_rows_kernel(const TIn *input, TOut *output, int m,
     }
 
     if (threadIdx.y == 0) {
-      atomic_add(output + col, TOut(shared_memory[threadIdx.x]));
+      // Each block adds its share of the mean, so no pass over the output is needed.
+      if (DivideResultBySize) {
+        atomic_add(output + col, TOut(shared_memory[threadIdx.x] / TBuf(m)));
+      } else {
+        atomic_add(output + col, TOut(shared_memory[threadIdx.x]));
+      }
     }
 
     // Make sure all values in shared memory have been written into the output memory.
@@ -363,7 +368,7 @@ __global__ void reduce_matrix_rows_kernel(const TIn *input, TOut *output, int m,
 // For example, [N, C, H, W]-tensor may lead to a output [W]-tensor.
 // It's implementation is in reduction_ops.cu and called in reduction_ops.cc.
 template<typename TIn, typename TOut, typename TBuf>
-void call_reduce_matrix_rows(const TIn *input, TOut *output, int m, int n) {
+void call_reduce_matrix_rows(const TIn *input, TOut *output, int m, int n, bool divide_by_m) {
   constexpr int max_num_threads_in_block = 512;
   constexpr int max_num_blocks_in_grid = 512;
   constexpr int warp_size = 32;
@@ -377,25 +382,158 @@ void call_reduce_matrix_rows(const TIn *input, TOut *output, int m, int n) {
   const dim3 grid(grid_x_dim, grid_y_dim, 1);
   const dim3 block(block_x_dim, block_y_dim, 1);
 
-  reduce_matrix_rows_kernel<TIn, TOut, TBuf><<<grid, block, block.y * block.x * sizeof(TBuf)>>>(
-      input, output, m, n);
+  const int shared_mem_size = block.y * block.x * sizeof(TBuf);
+  if (divide_by_m) {
+    reduce_matrix_rows_kernel<TIn, TOut, TBuf, true><<<grid, block, shared_mem_size>>>(input, output, m, n);
+  } else {
+    reduce_matrix_rows_kernel<TIn, TOut, TBuf, false><<<grid, block, shared_mem_size>>>(input, output, m, n);
+  }
 }
 
 template<typename TIn, typename TOut>
-void reduce_matrix_rows(const TIn* data, TOut* output, int m, int n)
+void reduce_matrix_rows(const TIn* data, TOut* output, int m, int n, bool divide_by_m)
 {
-  call_reduce_matrix_rows<TIn, TOut, TOut>(data, output, m, n);
+  call_reduce_matrix_rows<TIn, TOut, TOut>(data, output, m, n, divide_by_m);
 }
 
-template<> void reduce_matrix_rows<half, half>(const half* data, half* output, int m, int n)
+template<> void reduce_matrix_rows<half, half>(const half* data, half* output, int m, int n, bool divide_by_m)
 {
-  call_reduce_matrix_rows<half, half, float>(data, output, m, n);
+  call_reduce_matrix_rows<half, half, float>(data, output, m, n, divide_by_m);
 }
 
 template void reduce_matrix_rows<float, float>(
-  const float* data, float* output, int m, int n);
+  const float* data, float* output, int m, int n, bool divide_by_m);
 template void reduce_matrix_rows<double, double>(
-  const double* data, double* output, int m, int n);
+  const double* data, double* output, int m, int n, bool divide_by_m);
+
+bool is_matrix_column_reduction(
+    const cudnnReduceTensorOp_t cudnn_reduce_op,
+    const int m,
+    const int n,
+    const size_t rank,
+    std::vector<int64_t> axes) {
+  if (m < 1 || n < 1)
+    return false;
+
+  if (cudnn_reduce_op != CUDNN_REDUCE_TENSOR_ADD && cudnn_reduce_op != CUDNN_REDUCE_TENSOR_AVG &&
+      cudnn_reduce_op != CUDNN_REDUCE_TENSOR_NORM1 && cudnn_reduce_op != CUDNN_REDUCE_TENSOR_NORM2)
+    return false;
+
+  // Reducing all the axes is left to cuDNN: a single row is better spread over the whole grid.
+  if (axes.empty() || axes.size() >= rank)
+    return false;
+
+  // The reduced axes should be the last ones. For [N, C, H, W]-input, the sorted axes should be [2, 3] or [3].
+  for (auto& axis : axes) {
+    if (axis < 0)
+      axis += static_cast<int64_t>(rank);
+  }
+  std::sort(axes.begin(), axes.end());
+  for (size_t i = 0; i < axes.size(); ++i) {
+    if (axes[i] != static_cast<int64_t>(rank - axes.size() + i))
+      return false;
+  }
+
+  return true;
+}
+
+// A row is reduced by the blockDim.x threads of the same threadIdx.y, a multiple of the warp size, so each warp lies
+// within a row: the values of a warp are summed up by shuffles, then the ones of the warps of a row, if there are
+// several, by the first warp of the row through the shared memory.
+template<typename TIn, typename TOut, typename TBuf, typename TOp, typename TFinalOp, bool DivideResultBySize>
+__global__ void reduce_matrix_columns_kernel(const TIn *input, TOut *output, int m, int n) {
+  extern __shared__ unsigned char shared_memory_[];
+  TBuf *shared_memory = reinterpret_cast<TBuf*>(shared_memory_);
+  const int row = blockIdx.x * blockDim.y + threadIdx.y;
+
+  // Thread-level reduction, strided over the row so a warp reads consecutive elements.
+  TBuf value = TBuf(0.0f);
+  if (row < m) {
+    const TIn* row_input = input + static_cast<int64_t>(row) * n;
+    for (int col = threadIdx.x; col < n; col += blockDim.x) {
+      value += TOp()(row_input[col]);
+    }
+  }
+
+  // Warp-level reduction. The threads of the rows past m hold 0 and take part, so the whole warp is active.
+#pragma unroll
+  for (int stride = NUM_THREADS_PER_WARP / 2; stride > 0; stride /= 2) {
+    value += __shfl_down_sync(ALL_ONE_MASK, value, stride);
+  }
+
+  // Row-level reduction, when a row spans several warps.
+  const int num_warps_in_row = blockDim.x / NUM_THREADS_PER_WARP;
+  if (num_warps_in_row > 1) {
+    TBuf* row_shared_memory = shared_memory + threadIdx.y * num_warps_in_row;
+    if (threadIdx.x % NUM_THREADS_PER_WARP == 0) {
+      row_shared_memory[threadIdx.x / NUM_THREADS_PER_WARP] = value;
+    }
+    __syncthreads();
+    if (threadIdx.x < NUM_THREADS_PER_WARP) {
+      value = threadIdx.x < num_warps_in_row ? row_shared_memory[threadIdx.x] : TBuf(0.0f);
+#pragma unroll
+      for (int stride = NUM_THREADS_PER_WARP / 2; stride > 0; stride /= 2) {
+        value += __shfl_down_sync(ALL_ONE_MASK, value, stride);
+      }
+    }
+  }
+
+  if (threadIdx.x == 0 && row < m) {
+    // Compilation time if-else branch controlled by template argument can be
+    // optimized out, so there will be no branch in real computation phase.
+    if (DivideResultBySize) {
+      output[row] = TOut(TFinalOp()(value / TBuf(n)));
+    } else {
+      output[row] = TOut(TFinalOp()(value));
+    }
+  }
+}
+
+template<typename TIn, typename TOut, typename TBuf, typename TOp, typename TFinalOp, bool DivideResultBySize>
+void call_reduce_matrix_columns(const TIn *input, TOut *output, int m, int n) {
+  constexpr int max_num_threads_in_row = 512;
+  constexpr int num_threads_in_block = 256;
+
+  // A warp for the short rows, up to max_num_threads_in_row threads loading NUM_ELEMENTS_PER_THREAD elements each
+  // for the long ones. Short rows are packed into a block, so it keeps num_threads_in_block threads.
+  const int num_threads_in_row = std::min(
+      max_num_threads_in_row,
+      std::max(NUM_THREADS_PER_WARP, least_pow2_bound((n + NUM_ELEMENTS_PER_THREAD - 1) / NUM_ELEMENTS_PER_THREAD)));
+  const int num_rows_in_block = std::max(1, num_threads_in_block / num_threads_in_row);
+
+  const dim3 grid((m + num_rows_in_block - 1) / num_rows_in_block, 1, 1);
+  const dim3 block(num_threads_in_row, num_rows_in_block, 1);
+  const int shared_mem_size = num_rows_in_block * (num_threads_in_row / NUM_THREADS_PER_WARP) * sizeof(TBuf);
+
+  reduce_matrix_columns_kernel<TIn, TOut, TBuf, TOp, TFinalOp, DivideResultBySize><<<grid, block, shared_mem_size>>>(
+      input, output, m, n);
+}
+
+template<typename TIn, typename TOut>
+void reduce_matrix_columns(const TIn* data, TOut* output, int m, int n, cudnnReduceTensorOp_t cudnn_reduce_op) {
+  typedef typename ToBuffer<TIn>::Type TBuf;
+  switch (cudnn_reduce_op) {
+    case CUDNN_REDUCE_TENSOR_AVG:
+      call_reduce_matrix_columns<TIn, TOut, TBuf, Cast<TBuf, TIn>, Identity<TBuf>, true>(data, output, m, n);
+      break;
+    case CUDNN_REDUCE_TENSOR_NORM1:
+      call_reduce_matrix_columns<TIn, TOut, TBuf, Abs<TBuf, TIn>, Identity<TBuf>, false>(data, output, m, n);
+      break;
+    case CUDNN_REDUCE_TENSOR_NORM2:
+      call_reduce_matrix_columns<TIn, TOut, TBuf, Square<TBuf, TIn>, Sqrt<TBuf>, false>(data, output, m, n);
+      break;
+    default:
+      call_reduce_matrix_columns<TIn, TOut, TBuf, Cast<TBuf, TIn>, Identity<TBuf>, false>(data, output, m, n);
+      break;
+  }
+}
+
+template void reduce_matrix_columns<half, half>(
+  const half* data, half* output, int m, int n, cudnnReduceTensorOp_t cudnn_reduce_op);
+template void reduce_matrix_columns<float, float>(
+  const float* data, float* output, int m, int n, cudnnReduceTensorOp_t cudnn_reduce_op);
+template void reduce_matrix_columns<double, double>(
+  const double* data, double* output, int m, int n, cudnnReduceTensorOp_t cudnn_reduce_op);
 
 }  // namespace cuda
 }  // namespace onnxruntime
\ No newline at end of file
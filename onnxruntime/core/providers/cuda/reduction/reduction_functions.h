@@ -29,8 +29,23 @@ bool is_matrix_row_reduction(
     const size_t rank,
     std::vector<int64_t> axes);
 
+// Reduces the rows of the m-by-n matrix, accumulating into output, which must be zeroed. Divides by m if
+// divide_by_m, for a mean.
 template <typename TIn, typename TOut>
-void reduce_matrix_rows(const TIn* data, TOut* output, int m, int n);
+void reduce_matrix_rows(const TIn* data, TOut* output, int m, int n, bool divide_by_m = false);
+
+// Determine if a CUDNN reduction can be computed by reduce_matrix_columns, i.e. it reduces the trailing axes only.
+bool is_matrix_column_reduction(
+    const cudnnReduceTensorOp_t cudnn_reduce_op,
+    const int m,
+    const int n,
+    const size_t rank,
+    std::vector<int64_t> axes);
+
+// Reduces each row of the m-by-n matrix to one value with CUDNN_REDUCE_TENSOR_ADD, AVG, NORM1 or NORM2. A row is
+// reduced by a warp, or by a block for long rows, with warp shuffles. half is accumulated in float.
+template <typename TIn, typename TOut>
+void reduce_matrix_columns(const TIn* data, TOut* output, int m, int n, cudnnReduceTensorOp_t cudnn_reduce_op);
 
 }  // namespace cuda
 }  // namespace onnxruntime
\ No newline at end of file
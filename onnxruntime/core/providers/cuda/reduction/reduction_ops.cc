@@ -71,6 +71,42 @@ class CudnnReduceDescriptor final {
   cudnnReduceTensorDescriptor_t desc_;
 };
 
+// Computes the reduction with the kernels of reduction_functions.cu if they cover its op and axes: the leading axes
+// (reduce_matrix_rows, which accumulates into Y) or the trailing ones (reduce_matrix_columns). Returns false to leave
+// it to cuDNN, whose descriptor setup and workspace cost more than the small reductions themselves.
+template <typename CudaT>
+static bool TryFastReduction(const CudaT* X, const TensorShape& input_shape, CudaT* Y,
+                             cudnnReduceTensorOp_t cudnn_reduce_op, const std::vector<int64_t>& axes) {
+  const auto rank = input_shape.NumDimensions();
+  if (rank == 0 || input_shape.Size() == 0) {
+    return false;
+  }
+
+  const auto stride = input_shape[rank - 1];
+  const auto reduction_size = input_shape.Size() / stride;
+  if (reduction_size <= std::numeric_limits<int>::max() && stride <= std::numeric_limits<int>::max() &&
+      is_matrix_row_reduction(cudnn_reduce_op, static_cast<int>(reduction_size), static_cast<int>(stride), rank,
+                              axes)) {
+    reduce_matrix_rows(X, Y, static_cast<int>(reduction_size), static_cast<int>(stride),
+                       cudnn_reduce_op == CUDNN_REDUCE_TENSOR_AVG);
+    return true;
+  }
+
+  if (axes.empty() || axes.size() >= rank) {
+    return false;
+  }
+  const auto num_rows = input_shape.SizeToDimension(rank - axes.size());
+  const auto row_size = input_shape.SizeFromDimension(rank - axes.size());
+  if (num_rows <= std::numeric_limits<int>::max() && row_size <= std::numeric_limits<int>::max() &&
+      is_matrix_column_reduction(cudnn_reduce_op, static_cast<int>(num_rows), static_cast<int>(row_size), rank,
+                                 axes)) {
+    reduce_matrix_columns(X, Y, static_cast<int>(num_rows), static_cast<int>(row_size), cudnn_reduce_op);
+    return true;
+  }
+
+  return false;
+}
+
 // TODO ReduceKernel::ReduceKernelShared() is still used by some other training classes though it's not used here - this should be refactored.
 template <bool allow_multi_axes>
 template <typename T, typename OutT, cudnnReduceTensorIndices_t ReduceTensorIndices>
@@ -85,19 +121,9 @@ Status ReduceKernel<allow_multi_axes>::ReduceKernelShared(
   cudnnDataType_t cudnn_type_X = CudnnTensor::GetDataType<CudaT>();
   const auto rank = input_shape.NumDimensions();
 
-// Block of fast matrix row reduction.
-  const auto stride = input_shape[input_shape.NumDimensions() - 1];
-  const auto reduction_size = input_shape.Size() / stride;
-  if (fast_reduction_ && reduction_size <= std::numeric_limits<int>::max() && stride <= std::numeric_limits<int>::max() &&
-      is_matrix_row_reduction(cudnn_reduce_op,
-        static_cast<int>(reduction_size),
-        static_cast<int>(stride), rank, axes_)) {
-
-    reduce_matrix_rows(
-      reinterpret_cast<const CudaT*>(X),
-      reinterpret_cast<CudaT*>(Y),
-      static_cast<int>(reduction_size),
-      static_cast<int>(stride));
+  if (fast_reduction_ && std::is_same<T, OutT>::value &&
+      TryFastReduction(reinterpret_cast<const CudaT*>(X), input_shape, reinterpret_cast<CudaT*>(Y), cudnn_reduce_op,
+                       axes_)) {
     return Status::OK();
   }
 
@@ -399,19 +425,9 @@ Status ReduceKernel<allow_multi_axes>::ComputeImpl(OpKernelContext* ctx, cudnnRe
   IAllocatorUniquePtr<float> temp_X;
   cudnnDataType_t cudnn_type_X = CudnnTensor::GetDataType<CudaT>();
 
-  // Block of fast matrix row reduction.
-  // It relies on new atomicAdd for half type, so old CUDA can't use it.
-  const auto reduction_size = input_count / stride;
-  if (fast_reduction_ && reduction_size <= std::numeric_limits<int>::max() && stride <= std::numeric_limits<int>::max() &&
-      is_matrix_row_reduction(cudnn_reduce_op,
-        static_cast<int>(reduction_size),
-        static_cast<int>(stride), rank, axes_)) {
-
-    reduce_matrix_rows(
-      reinterpret_cast<const CudaT*>(X->template Data<T>()),
-      reinterpret_cast<CudaT*>(Y->template MutableData<T>()),
-      static_cast<int>(reduction_size),
-      static_cast<int>(stride));
+  if (fast_reduction_ && ReduceTensorIndices == CUDNN_REDUCE_TENSOR_NO_INDICES &&
+      TryFastReduction(reinterpret_cast<const CudaT*>(X->template Data<T>()), X->Shape(),
+                       reinterpret_cast<CudaT*>(Y->template MutableData<T>()), cudnn_reduce_op, axes_)) {
     return Status::OK();
   }
 
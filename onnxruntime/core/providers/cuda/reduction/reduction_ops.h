@@ -71,7 +71,9 @@ class ArgMin final : public ReduceKernel<false> {
 template <typename T>
 class ReduceL1 final : public ReduceKernel<true> {
  public:
-  ReduceL1(const OpKernelInfo& info) : ReduceKernel<true>(info) {}
+  ReduceL1(const OpKernelInfo& info) : ReduceKernel<true>(info) {
+    fast_reduction_ = true;
+  }
 
   Status ComputeInternal(OpKernelContext* ctx) const override {
     return ComputeImpl<T>(ctx, CUDNN_REDUCE_TENSOR_NORM1);
@@ -81,7 +83,9 @@ class ReduceL1 final : public ReduceKernel<true> {
 template <typename T>
 class ReduceL2 final : public ReduceKernel<true> {
  public:
-  ReduceL2(const OpKernelInfo& info) : ReduceKernel<true>(info) {}
+  ReduceL2(const OpKernelInfo& info) : ReduceKernel<true>(info) {
+    fast_reduction_ = true;
+  }
 
   Status ComputeInternal(OpKernelContext* ctx) const override {
     return ComputeImpl<T>(ctx, CUDNN_REDUCE_TENSOR_NORM2);
@@ -101,7 +105,9 @@ class ReduceMax final : public ReduceKernel<true> {
 template <typename T>
 class ReduceMean final : public ReduceKernel<true> {
  public:
-  ReduceMean(const OpKernelInfo& info) : ReduceKernel<true>(info) {}
+  ReduceMean(const OpKernelInfo& info) : ReduceKernel<true>(info) {
+    fast_reduction_ = true;
+  }
 
   Status ComputeInternal(OpKernelContext* ctx) const override {
     return ComputeImpl<T>(ctx, CUDNN_REDUCE_TENSOR_AVG);
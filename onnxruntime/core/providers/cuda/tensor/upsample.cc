@@ -49,6 +49,10 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
   if (roi.size() != 2 * X->Shape().GetDims().size())
     return Status(ONNXRUNTIME, INVALID_ARGUMENT,
                   "Resize: size of roi array should be 2 * N where N is the rank of input tensor X.");
+  if (UpsampleMode::LINEAR == mode_ && IsNhwcBilinearScales(scales))
+    return Status(ONNXRUNTIME, NOT_IMPLEMENTED,
+                  is_resize_ ? "Resize: 'Linear' mode of an input in NHWC layout is not supported."
+                             : "Upsample: 'Linear' mode of an input in NHWC layout is not supported.");
 
   Tensor* Y = context->Output(0, output_dims);
   typedef typename ToCudaType<T>::MappedType CudaT;
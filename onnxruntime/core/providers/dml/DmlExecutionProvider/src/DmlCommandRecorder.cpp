@@ -167,6 +167,8 @@ void DmlCommandRecorder::ExecuteOperator(
 
     // Barrier all outputs.
     m_currentCommandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::UAV(nullptr));
+
+    FlushIfBatchFull();
 }
 
 void DmlCommandRecorder::CopyBufferRegion(
@@ -265,6 +267,7 @@ void DmlCommandRecorder::ExecuteCommandList(
     auto heap = m_currentDescriptorHeap;
     m_currentDescriptorHeap = nullptr;
     Open();
+    SetDescriptorHeap(heap);
 
     // The caller can re-use relevant resources after the next set of work to be
     // flushed has completed.  Its command list hasn't been executed yet, just batched.
@@ -272,13 +275,10 @@ void DmlCommandRecorder::ExecuteCommandList(
     gpuEvent.fence.CopyTo(fence);
     *completionValue = gpuEvent.fenceValue;
 
-    // Trigger a flush of the command list, with the assumption that it contains enough GPU work that this
-    // will help parallelize GPU work with subsequent CPU work.  This policy is related to the choice of
-    // minNodeCountToReuseCommandList within FusedGraphKernel, so both should be tuned together.
-    CloseAndExecute();
-    Open();
-
-    SetDescriptorHeap(heap);
+    // The command list is submitted along with the work batched before it once the batch is large enough to
+    // keep the GPU busy while the CPU records subsequent work.  This policy is related to the choice of
+    // minNodeCountToReuseCommandList within GraphDescBuilder, so both should be tuned together.
+    FlushIfBatchFull();
 }
 
 ComPtr<ID3D12GraphicsCommandList> DmlCommandRecorder::GetCommandList()
@@ -363,6 +363,8 @@ void DmlCommandRecorder::CloseAndExecute()
         m_pendingCommandListsCacheable.clear();
     }
 
+    m_batchedWorkCount = 0;
+
     // The descriptor heap must be set on the command list the next time it's opened.
     m_currentDescriptorHeap = nullptr;
 
@@ -380,4 +382,19 @@ void DmlCommandRecorder::SetDescriptorHeap(ID3D12DescriptorHeap* descriptorHeap)
         ID3D12DescriptorHeap* descriptorHeaps[] = { descriptorHeap };
         m_currentCommandList->SetDescriptorHeaps(ARRAYSIZE(descriptorHeaps), descriptorHeaps);
     }
-}
\ No newline at end of file
+}
+
+void DmlCommandRecorder::FlushIfBatchFull()
+{
+    if (++m_batchedWorkCount < c_maxBatchedWorkCount)
+    {
+        return;
+    }
+
+    // Submit the batch and continue recording into a new command list from the allocator ring, with the
+    // same descriptor heap.
+    auto heap = m_currentDescriptorHeap;
+    CloseAndExecute();
+    Open();
+    SetDescriptorHeap(heap);
+}
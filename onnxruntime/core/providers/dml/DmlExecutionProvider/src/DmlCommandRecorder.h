@@ -88,7 +88,13 @@ namespace Dml
         // A pool of cached command lists which may be re-used.
         std::deque<ComPtr<ID3D12GraphicsCommandList>> m_cachedCommandLists;
 
+        // Number of operator dispatches and command lists recorded since the last submission.  Work is
+        // submitted to the queue in batches of this size rather than after each command list.
+        static constexpr uint32_t c_maxBatchedWorkCount = 16;
+        uint32_t m_batchedWorkCount = 0;
+
         void SetDescriptorHeap(ID3D12DescriptorHeap* descriptorHeap);
+        void FlushIfBatchFull();
     };
 
 } // namespace Dml
@@ -376,12 +376,19 @@ namespace Dml
     {
         assert(!m_closed);
 
+        CopyTensorImpl(dst, src, false);
+        return S_OK;
+    }
+    CATCH_RETURN();
+
+    void ExecutionProviderImpl::CopyTensorImpl(IMLOperatorTensor* dst, IMLOperatorTensor* src, bool deferReadback) const
+    {
         const size_t dataSizeInBytes = ComputeByteSizeFromTensor(*dst);
         THROW_HR_IF(E_INVALIDARG, dataSizeInBytes != ComputeByteSizeFromTensor(*src)); // Tensors must be the same size
 
         if (dataSizeInBytes == 0)
         {
-            return S_OK;
+            return;
         }
 
         if (src->IsCpuData() && !dst->IsCpuData())
@@ -413,8 +420,16 @@ namespace Dml
             const uint64_t srcOffset = 0;
             const auto srcState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS; // GPU resources are always kept in UAV state
 
-            // Performs a blocking call to synchronize and read back data from the GPU into the destination buffer
-            m_readbackHeap->ReadbackFromGpu(AsByteSpan(dstData, dataSizeInBytes), srcData, srcOffset, srcState);
+            if (deferReadback)
+            {
+                // The data is copied into the destination buffer by the caller's call to CompleteReadbacks
+                m_readbackHeap->BeginReadbackFromGpu(AsByteSpan(dstData, dataSizeInBytes), srcData, srcOffset, srcState);
+            }
+            else
+            {
+                // Performs a blocking call to synchronize and read back data from the GPU into the destination buffer
+                m_readbackHeap->ReadbackFromGpu(AsByteSpan(dstData, dataSizeInBytes), srcData, srcOffset, srcState);
+            }
         }
         else if (!src->IsCpuData() && !dst->IsCpuData())
         {
@@ -433,10 +448,7 @@ namespace Dml
             // CPU -> CPU copies not supported
             THROW_HR(E_INVALIDARG);
         }
-
-        return S_OK;
     }
-    CATCH_RETURN();
 
     HRESULT STDMETHODCALLTYPE ExecutionProviderImpl::FillTensorWithPattern(
         IMLOperatorTensor* dst,
@@ -509,29 +521,46 @@ namespace Dml
         );
     }
 
+    static bool IsGpuTensor(const onnxruntime::Tensor& tensor)
+    {
+        return strcmp(tensor.Location().name, onnxruntime::CPU) &&
+            !(tensor.Location().mem_type == ::OrtMemType::OrtMemTypeCPUOutput || tensor.Location().mem_type == ::OrtMemType::OrtMemTypeCPUInput);
+    }
+
     Status ExecutionProviderImpl::CopyTensor(const onnxruntime::Tensor& src, onnxruntime::Tensor& dst) const
     {
         assert(!m_closed);
 
         auto provider = const_cast<ExecutionProviderImpl*>(this);
 
-        TensorWrapper destInternal(
-            &dst, 
-            strcmp(dst.Location().name, onnxruntime::CPU) && !(dst.Location().mem_type == ::OrtMemType::OrtMemTypeCPUOutput || dst.Location().mem_type == ::OrtMemType::OrtMemTypeCPUInput), 
-            provider,
-            true);
-
-        TensorWrapper srcInternal(
-            const_cast<onnxruntime::Tensor*>(&src), 
-            strcmp(src.Location().name, onnxruntime::CPU) && !(src.Location().mem_type == ::OrtMemType::OrtMemTypeCPUOutput || src.Location().mem_type == ::OrtMemType::OrtMemTypeCPUInput),
-            provider,
-            true);
+        TensorWrapper destInternal(&dst, IsGpuTensor(dst), provider, true);
+        TensorWrapper srcInternal(const_cast<onnxruntime::Tensor*>(&src), IsGpuTensor(src), provider, true);
 
         THROW_IF_FAILED(CopyTensor(&destInternal, &srcInternal));
 
         return onnxruntime::common::Status::OK();
     }
 
+    Status ExecutionProviderImpl::CopyTensors(const onnxruntime::Tensor* src, onnxruntime::Tensor* dst, int count) const
+    {
+        assert(!m_closed);
+
+        auto provider = const_cast<ExecutionProviderImpl*>(this);
+
+        // Record all the copies before waiting, so the readbacks share a single flush and wait on the GPU.
+        for (int i = 0; i < count; ++i)
+        {
+            TensorWrapper destInternal(&dst[i], IsGpuTensor(dst[i]), provider, true);
+            TensorWrapper srcInternal(const_cast<onnxruntime::Tensor*>(&src[i]), IsGpuTensor(src[i]), provider, true);
+
+            CopyTensorImpl(&destInternal, &srcInternal, true);
+        }
+
+        m_readbackHeap->CompleteReadbacks();
+
+        return onnxruntime::common::Status::OK();
+    }
+
     Status ExecutionProviderImpl::WaitForGpuCompletion()
     {
         assert(!m_closed);
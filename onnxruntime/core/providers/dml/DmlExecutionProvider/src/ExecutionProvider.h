@@ -92,6 +92,7 @@ namespace Dml
         uint32_t GetSuppportedDeviceDataTypeMask() const;
 
         onnxruntime::common::Status CopyTensor(const onnxruntime::Tensor& src, onnxruntime::Tensor& dst) const;
+        onnxruntime::common::Status CopyTensors(const onnxruntime::Tensor* src, onnxruntime::Tensor* dst, int count) const;
         onnxruntime::common::Status WaitForGpuCompletion();
 
         // IWinmlExecutionProvider methods
@@ -162,6 +163,10 @@ namespace Dml
     private:
         void Initialize(ID3D12CommandQueue* queue, ExecutionProvider& executionProvider);
 
+        // When deferReadback is set, GPU -> CPU copies are only recorded, and complete on the next
+        // call to ReadbackHeap::CompleteReadbacks.
+        void CopyTensorImpl(IMLOperatorTensor* dst, IMLOperatorTensor* src, bool deferReadback) const;
+
         ComPtr<ID3D12Device> m_d3d12Device;
         ComPtr<IDMLDevice> m_dmlDevice;
         bool m_isMcdmDevice = false;
@@ -199,6 +204,11 @@ namespace Dml
             return m_impl->CopyTensor(src, dst);
         }
 
+        onnxruntime::common::Status CopyTensors(const onnxruntime::Tensor* src, onnxruntime::Tensor* dst, int size) const final
+        {
+            return m_impl->CopyTensors(src, dst, size);
+        }
+
         bool CanCopy(const OrtDevice& srcDevice, const OrtDevice& dstDevice) const final
         {
               return (srcDevice.Type() == OrtDevice::GPU) ||
@@ -252,6 +262,14 @@ namespace Dml
         {
             return m_impl->Flush();
         }    
+
+        // Operator dispatches are submitted to the queue in batches, so submit the remainder of the
+        // last batch once the run has recorded all of its work.
+        onnxruntime::common::Status OnRunEnd() final
+        {
+            m_impl->Flush();
+            return onnxruntime::common::Status::OK();
+        }
         
         void SetDefaultRoundingMode(AllocatorRoundingMode roundingMode)
         {
@@ -1549,61 +1549,54 @@ onnxruntime::Status AbiOpKernel::Compute(onnxruntime::OpKernelContext* context)
 
     if (RequiresLazyInitialization()) {
       m_inputShapesOfKernelInference = GetInputShapes(context);
-
-      m_constantInputTensorContentsOfKernel.resize(context->InputCount());
-      for (uint32_t index : m_requiredConstantCpuInputs) {
-        MLOperatorTensor tensor = MLOperatorTensor(constantInputGetter(index).Get());
-
-        if (index >= static_cast<uint32_t>(context->InputCount())) {
-          continue;
-        }
-        m_constantInputTensorContentsOfKernel[index].isValid = (tensor.GetInterface() != nullptr);
-
-        if (tensor.GetInterface() != nullptr) {
-          m_constantInputTensorContentsOfKernel[index].shape = tensor.GetShape();
-          m_constantInputTensorContentsOfKernel[index].type = tensor.GetTensorDataType();
-          m_constantInputTensorContentsOfKernel[index].data.resize(tensor.GetUnalignedTensorByteSize());
-        }
-        m_constantInputTensorContentsOfKernel[index].data.assign(
-            reinterpret_cast<const std::byte*>(tensor.GetByteData()),
-            reinterpret_cast<const std::byte*>(tensor.GetByteData()) + tensor.GetUnalignedTensorByteSize());
-      }
+      m_constantInputTensorContentsOfKernel = GetConstantInputTensorContents(constantInputGetter, context->InputCount());
 
       m_kernel = inferShapesAndCreateKernel(m_inputShapesOfKernelInference, m_inferredOutputShapes);
       SetLazyInitialized();
     }
   } else if (m_inputShapesOfKernelInference.EdgeCount() > 0) {
     EdgeShapes local_input_shapes = GetInputShapes(context);
+    std::vector<TensorContent> localConstantInputContents = GetConstantInputTensorContents(constantInputGetter, context->InputCount());
 
-    bool requiredCpuInputsChanged = false;
-    for (uint32_t index : m_requiredConstantCpuInputs) {
-      if (index >= m_constantInputTensorContentsOfKernel.size()) {
-        continue;
+    // In the edge case that the input size is changing across invocations and the kernel requires
+    // its input size at construction, use a kernel specialized for the current inputs.  Kernels are
+    // cached by their input shapes and constant CPU inputs so that recurring shapes aren't recompiled.
+    if (local_input_shapes != m_inputShapesOfKernelInference ||
+        !TensorContentsMatch(m_constantInputTensorContentsOfKernel, localConstantInputContents)) {
+      ComPtr<IMLOperatorKernel> localKernel;
+      EdgeShapes localInferredOutputShapes;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto cachedKernel = std::find_if(
+            m_shapeSpecializedKernels.begin(),
+            m_shapeSpecializedKernels.end(),
+            [&](const ShapeSpecializedKernel& entry) {
+              return !(entry.inputShapes != local_input_shapes) &&
+                     TensorContentsMatch(entry.constantInputTensorContents, localConstantInputContents);
+            });
+
+        if (cachedKernel != m_shapeSpecializedKernels.end()) {
+          localKernel = cachedKernel->kernel;
+          localInferredOutputShapes = cachedKernel->inferredOutputShapes;
+
+          // Move the entry to the front so the least recently used kernel is evicted first.
+          if (cachedKernel != m_shapeSpecializedKernels.begin()) {
+            ShapeSpecializedKernel entry = std::move(*cachedKernel);
+            m_shapeSpecializedKernels.erase(cachedKernel);
+            m_shapeSpecializedKernels.push_front(std::move(entry));
+          }
+        }
       }
 
-      const TensorContent& lastValue = m_constantInputTensorContentsOfKernel[index];
-      MLOperatorTensor currentValue(constantInputGetter(index).Get());
-
-      if (lastValue.isValid != (currentValue.GetInterface() != nullptr)) {
-        break;
-      }
+      if (!localKernel) {
+        localKernel = inferShapesAndCreateKernel(local_input_shapes, localInferredOutputShapes);
 
-      if (lastValue.isValid) {
-        if (lastValue.shape != currentValue.GetShape() ||
-            lastValue.type != currentValue.GetTensorDataType() ||
-            currentValue.GetUnalignedTensorByteSize() != lastValue.data.size() ||
-            (memcmp(lastValue.data.data(), currentValue.GetByteData(), lastValue.data.size()) != 0)) {
-          requiredCpuInputsChanged = true;
-          break;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shapeSpecializedKernels.push_front({local_input_shapes, std::move(localConstantInputContents), localInferredOutputShapes, localKernel});
+        if (m_shapeSpecializedKernels.size() > c_maxShapeSpecializedKernels) {
+          m_shapeSpecializedKernels.pop_back();
         }
       }
-    }
-
-    // In the edge case that the input size is changing across invocations and the kernel requires
-    // its input size at construction, use a local instance of the kernel.
-    if (local_input_shapes != m_inputShapesOfKernelInference || requiredCpuInputsChanged) {
-      EdgeShapes localInferredOutputShapes;
-      ComPtr<IMLOperatorKernel> localKernel = inferShapesAndCreateKernel(local_input_shapes, localInferredOutputShapes);
 
       ComPtr<OpKernelContextWrapper> kernelContextWrapper = wil::MakeOrThrow<OpKernelContextWrapper>(
           context,
@@ -1641,6 +1634,56 @@ onnxruntime::Status AbiOpKernel::Compute(onnxruntime::OpKernelContext* context)
   return onnxruntime::Status();
 }
 
+std::vector<AbiOpKernel::TensorContent> AbiOpKernel::GetConstantInputTensorContents(
+    MLOperatorTensorGetter& constantInputGetter,
+    uint32_t inputCount) const {
+  std::vector<TensorContent> contents(inputCount);
+  for (uint32_t index : m_requiredConstantCpuInputs) {
+    if (index >= inputCount) {
+      continue;
+    }
+
+    MLOperatorTensor tensor = MLOperatorTensor(constantInputGetter(index).Get());
+    contents[index].isValid = (tensor.GetInterface() != nullptr);
+
+    if (tensor.GetInterface() != nullptr) {
+      contents[index].shape = tensor.GetShape();
+      contents[index].type = tensor.GetTensorDataType();
+      contents[index].data.assign(
+          reinterpret_cast<const std::byte*>(tensor.GetByteData()),
+          reinterpret_cast<const std::byte*>(tensor.GetByteData()) + tensor.GetUnalignedTensorByteSize());
+    }
+  }
+
+  return contents;
+}
+
+bool AbiOpKernel::TensorContentsMatch(
+    const std::vector<TensorContent>& lastContents,
+    const std::vector<TensorContent>& currentContents) {
+  if (lastContents.size() != currentContents.size()) {
+    return false;
+  }
+
+  for (size_t index = 0; index < lastContents.size(); ++index) {
+    const TensorContent& lastValue = lastContents[index];
+    const TensorContent& currentValue = currentContents[index];
+
+    if (lastValue.isValid != currentValue.isValid) {
+      return false;
+    }
+
+    if (lastValue.isValid &&
+        (lastValue.shape != currentValue.shape ||
+         lastValue.type != currentValue.type ||
+         lastValue.data != currentValue.data)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 bool AbiOpKernel::InputTensorShapesDefined() const {
   onnxruntime::ProtoHelperNodeContext protoContext(Node());
   onnxruntime::OpNodeProtoHelper<onnxruntime::ProtoHelperNodeContext> info(&protoContext);
@@ -539,6 +539,27 @@ class AbiOpKernel : public onnxruntime::OpKernel
 
     mutable std::vector<TensorContent> m_constantInputTensorContentsOfKernel;
 
+    std::vector<TensorContent> GetConstantInputTensorContents(
+        MLOperatorTensorGetter& constantInputGetter,
+        uint32_t inputCount) const;
+
+    static bool TensorContentsMatch(
+        const std::vector<TensorContent>& lastContents,
+        const std::vector<TensorContent>& currentContents);
+
+    // Kernels created for input shapes or constant CPU inputs other than those of m_kernel, most
+    // recently used first.  This avoids recompiling the operator when a small set of shapes recurs.
+    struct ShapeSpecializedKernel
+    {
+        EdgeShapes inputShapes;
+        std::vector<TensorContent> constantInputTensorContents;
+        EdgeShapes inferredOutputShapes;
+        ComPtr<IMLOperatorKernel> kernel;
+    };
+
+    static constexpr size_t c_maxShapeSpecializedKernels = 8;
+    mutable std::deque<ShapeSpecializedKernel> m_shapeSpecializedKernels;
+
     mutable std::mutex m_mutex;
     mutable EdgeShapes m_inferredOutputShapes;
 
@@ -104,7 +104,12 @@ namespace Dml
             nullptr,
             IID_PPV_ARGS(&uploadBuffer)));
 
-        return Chunk{ sizeInBytes, std::move(uploadBuffer) };
+        // The CPU never reads from the upload heap, so pass an empty read range
+        void* uploadHeapData = nullptr;
+        D3D12_RANGE readRange = { 0, 0 };
+        THROW_IF_FAILED(uploadBuffer->Map(0, &readRange, &uploadHeapData));
+
+        return Chunk{ sizeInBytes, std::move(uploadBuffer), static_cast<std::byte*>(uploadHeapData) };
     }
 
     std::pair<PooledUploadHeap::Chunk*, size_t> PooledUploadHeap::Reserve(size_t sizeInBytes)
@@ -168,11 +173,8 @@ namespace Dml
         assert(chunk != nullptr);
         assert(offsetInChunk + src.size() <= chunk->capacityInBytes);
 
-        // Map the upload heap and copy the source data into it at the specified offset
-        void* uploadHeapData = nullptr;
-        THROW_IF_FAILED(chunk->resource->Map(0, nullptr, &uploadHeapData));
-        memcpy(static_cast<byte*>(uploadHeapData) + offsetInChunk, src.data(), src.size());
-        chunk->resource->Unmap(0, nullptr);
+        // Copy the source data into the mapped upload heap at the specified offset
+        memcpy(chunk->cpuData + offsetInChunk, src.data(), src.size());
 
         // Copy from the upload heap into the destination resource
         m_executionContext->CopyBufferRegion(
@@ -236,6 +238,7 @@ namespace Dml
         for (const auto& chunk : m_chunks)
         {
             assert(chunk.resource != nullptr);
+            assert(chunk.cpuData != nullptr);
             assert(chunk.capacityInBytes == chunk.resource->GetDesc().Width);
         }
 
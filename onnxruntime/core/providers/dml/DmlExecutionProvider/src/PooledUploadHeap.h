@@ -52,6 +52,9 @@ namespace Dml
             size_t capacityInBytes; // The total size of the upload heap, in bytes
             ComPtr<ID3D12Resource> resource;
 
+            // Upload heaps stay mapped for their lifetime, so each upload is a single memcpy
+            std::byte* cpuData;
+
             // Allocations are sorted by ascending fence value - that is, least to most recently allocated
             std::list<Allocation> allocations;
         };
@@ -45,52 +45,104 @@ namespace Dml
         return newCapacity;
     }
 
+    static size_t Align(size_t offset, size_t alignment)
+    {
+        assert(alignment != 0);
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
     void ReadbackHeap::ReadbackFromGpu(
         gsl::span<std::byte> dst,
         ID3D12Resource* src,
         uint64_t srcOffset,
         D3D12_RESOURCE_STATES srcState)
+    {
+        BeginReadbackFromGpu(dst, src, srcOffset, srcState);
+        CompleteReadbacks();
+    }
+
+    GpuEvent ReadbackHeap::BeginReadbackFromGpu(
+        gsl::span<std::byte> dst,
+        ID3D12Resource* src,
+        uint64_t srcOffset,
+        D3D12_RESOURCE_STATES srcState)
     {
         assert(!dst.empty());
 
+        size_t offsetInHeap = Align(m_pendingSize, c_allocationAlignment);
+        if (offsetInHeap + dst.size() < offsetInHeap)
+        {
+            // Overflow
+            THROW_HR(E_OUTOFMEMORY);
+        }
+
         if (!m_readbackHeap)
         {
             // Initialize the readback heap for the first time
             assert(m_capacity == 0);
-            m_capacity = ComputeNewCapacity(c_initialCapacity, dst.size());
+            m_capacity = ComputeNewCapacity(c_initialCapacity, offsetInHeap + dst.size());
             m_readbackHeap = CreateReadbackHeap(m_device.Get(), m_capacity);
         }
-        else if (m_capacity < dst.size())
+        else if (m_capacity < offsetInHeap + dst.size())
         {
+            // The pending readbacks are copied out of the heap before it's reallocated
+            CompleteReadbacks();
+            offsetInHeap = 0;
+
             // Ensure there's sufficient capacity
-            m_capacity = ComputeNewCapacity(m_capacity, dst.size());
+            if (m_capacity < dst.size())
+            {
+                m_capacity = ComputeNewCapacity(m_capacity, dst.size());
 
-            m_readbackHeap = nullptr;
-            m_readbackHeap = CreateReadbackHeap(m_device.Get(), m_capacity);
+                m_readbackHeap = nullptr;
+                m_readbackHeap = CreateReadbackHeap(m_device.Get(), m_capacity);
+            }
         }
 
-        assert(m_readbackHeap->GetDesc().Width >= dst.size());
+        assert(m_readbackHeap->GetDesc().Width >= offsetInHeap + dst.size());
 
         // Copy from the source resource into the readback heap
         m_executionContext->CopyBufferRegion(
             m_readbackHeap.Get(),
-            0,
+            offsetInHeap,
             D3D12_RESOURCE_STATE_COPY_DEST,
             src,
             srcOffset,
             srcState,
             dst.size());
 
+        m_pendingReadbacks.push_back(PendingReadback{ dst, offsetInHeap });
+        m_pendingSize = offsetInHeap + dst.size();
+
+        return m_executionContext->GetCurrentCompletionEvent();
+    }
+
+    void ReadbackHeap::CompleteReadbacks()
+    {
+        if (m_pendingReadbacks.empty())
+        {
+            return;
+        }
+
         // Wait for completion and map the result
         m_executionContext->Flush();
         m_executionContext->GetCurrentCompletionEvent().WaitForSignal();
         m_executionContext->ReleaseCompletedReferences();
 
-        // Map the readback heap and copy it into the destination
+        // Map the readback heap and copy it into the destinations
         void* readbackHeapData = nullptr;
-        THROW_IF_FAILED(m_readbackHeap->Map(0, nullptr, &readbackHeapData));
-        memcpy(dst.data(), readbackHeapData, dst.size());
-        m_readbackHeap->Unmap(0, nullptr);
+        D3D12_RANGE readRange = { 0, m_pendingSize };
+        THROW_IF_FAILED(m_readbackHeap->Map(0, &readRange, &readbackHeapData));
+        for (const PendingReadback& readback : m_pendingReadbacks)
+        {
+            memcpy(readback.dst.data(), static_cast<const std::byte*>(readbackHeapData) + readback.offsetInHeap, readback.dst.size());
+        }
+
+        D3D12_RANGE writtenRange = { 0, 0 };
+        m_readbackHeap->Unmap(0, &writtenRange);
+
+        m_pendingReadbacks.clear();
+        m_pendingSize = 0;
     }
 
 } // namespace Dml
@@ -3,33 +3,58 @@
 
 #pragma once
 
+#include "GpuEvent.h"
+
 namespace Dml
 {
     class ExecutionContext;
 
-    // Because we never perform more than one readback at a time, we don't need anything fancy for managing the
-    // readback heap - just maintain a single resource and reallocate it if it's not big enough.
+    // Readbacks are batched into a single readback heap which is reallocated if it's not big enough. Copies into the
+    // heap are recorded as they are requested, and the CPU waits once for all of them when the batch is completed.
     class ReadbackHeap
     {
     public:
         ReadbackHeap(ID3D12Device* device, std::shared_ptr<ExecutionContext> executionContext);
 
         // Copies data from the specified GPU resource into CPU memory pointed-to by the span. This method will block
-        // until the copy is complete.
+        // until the copy is complete, along with any readbacks begun before it.
         void ReadbackFromGpu(
             gsl::span<std::byte> dst,
             ID3D12Resource* src,
             uint64_t srcOffset,
             D3D12_RESOURCE_STATES srcState);
 
+        // Records a copy from the specified GPU resource into the readback heap without waiting for it, and returns
+        // a GpuEvent which will become signaled when the copy is complete once the work has been flushed. The CPU
+        // memory pointed-to by the span must stay valid until CompleteReadbacks returns.
+        GpuEvent BeginReadbackFromGpu(
+            gsl::span<std::byte> dst,
+            ID3D12Resource* src,
+            uint64_t srcOffset,
+            D3D12_RESOURCE_STATES srcState);
+
+        // Flushes the pending readbacks, waits for them and copies their data into the destination spans.
+        void CompleteReadbacks();
+
     private:
         static constexpr size_t c_initialCapacity = 1024 * 1024; // 1MB
+        static constexpr size_t c_allocationAlignment = 512; // In bytes; as per D3D12 requirement for buffers
+
+        struct PendingReadback
+        {
+            gsl::span<std::byte> dst;
+            size_t offsetInHeap;
+        };
 
         ComPtr<ID3D12Device> m_device;
         std::shared_ptr<ExecutionContext> m_executionContext;
 
         ComPtr<ID3D12Resource> m_readbackHeap;
         size_t m_capacity = 0;
+
+        // Readbacks recorded into the heap since the last call to CompleteReadbacks, and the end of the last one
+        std::vector<PendingReadback> m_pendingReadbacks;
+        size_t m_pendingSize = 0;
     };
 
 } // namespace Dml
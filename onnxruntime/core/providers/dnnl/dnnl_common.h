@@ -3,9 +3,11 @@
 
 #pragma once
 #include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
 #include "dnnl.hpp"
 #include <unordered_map>
 #include <list>
+#include <vector>
 
 namespace onnxruntime {
 namespace ort_dnnl {
@@ -33,41 +35,69 @@ static void AddDimsToKey(std::string& key, const dnnl::memory::dims& dims) {
   key.append(1, '#');
 }
 
+// Appends the layout of a memory descriptor, i.e. its data type, padded dims and blocking, to a key.
+static void AddLayoutToKey(std::string& key, const dnnl::memory::desc& desc) {
+  const dnnl_memory_desc_t& md = desc.data;
+  key.append(1, '#');
+  key.append(std::to_string(md.data_type));
+  key.append(1, '_');
+  for (int i = 0; i < md.ndims; i++) {
+    key.append(std::to_string(md.padded_dims[i]));
+    key.append(1, '_');
+  }
+  if (md.format_kind == dnnl_blocked) {
+    const auto& blocking = md.format_desc.blocking;
+    for (int i = 0; i < md.ndims; i++) {
+      key.append(std::to_string(blocking.strides[i]));
+      key.append(1, '_');
+    }
+    for (int i = 0; i < blocking.inner_nblks; i++) {
+      key.append(std::to_string(blocking.inner_idxs[i]));
+      key.append(1, ':');
+      key.append(std::to_string(blocking.inner_blks[i]));
+      key.append(1, '_');
+    }
+  } else {
+    key.append(std::to_string(md.format_kind));
+  }
+  key.append(1, '#');
+}
+
 class PrimitiveBase {
  public:
   virtual ~PrimitiveBase() = default;
 };
 
+// Pool of the primitives, which are expensive to create, shared by the threads of the process. A primitive binds the
+// buffers of the run using it, so it serves one run at a time: AcquirePrimitive takes an idle primitive of the key
+// out of the pool, and ReleasePrimitive puts it back once the run is done. A key ends up with as many primitives as
+// it had concurrent runs, rather than one per thread that ever ran it.
 template <typename T>
 class PrimitivePool {
  public:
   PrimitivePool() = default;
   ~PrimitivePool() = default;
 
-  void SetPrimitive(const std::string& key, std::unique_ptr<PrimitiveBase> primitive) {
-    auto& map = PrimitivePool<T>::GetMap();
-    auto iter = map.find(key);
-    // We should not find a primitive already using this key.
-    ORT_ENFORCE(iter == map.end(), "duplicate key: " + key);
-    map.insert(std::make_pair(key, std::move(primitive)));
-  }
-
-  PrimitiveBase* GetPrimitive(const std::string& key) {
-    const auto& map = PrimitivePool<T>::GetMap();
-    auto iter = map.find(key);
-    if (iter != map.end()) {
-      return iter->second.get();
-    } else {
+  // Returns nullptr if no primitive of the key is idle.
+  std::unique_ptr<PrimitiveBase> AcquirePrimitive(const std::string& key) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto iter = map_.find(key);
+    if (iter == map_.end() || iter->second.empty()) {
       return nullptr;
     }
+    std::unique_ptr<PrimitiveBase> primitive = std::move(iter->second.back());
+    iter->second.pop_back();
+    return primitive;
   }
 
- private:
-  // For thread safety, the map needs to be kept in thread local storage.
-  static inline std::unordered_map<std::string, std::unique_ptr<PrimitiveBase>>& GetMap() {
-    static thread_local std::unordered_map<std::string, std::unique_ptr<PrimitiveBase>> map;
-    return map;
+  void ReleasePrimitive(const std::string& key, std::unique_ptr<PrimitiveBase> primitive) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    map_[key].push_back(std::move(primitive));
   }
+
+ private:
+  OrtMutex mutex_;
+  std::unordered_map<std::string, std::vector<std::unique_ptr<PrimitiveBase>>> map_;
 };
 }  // namespace ort_dnnl
 }  // namespace onnxruntime
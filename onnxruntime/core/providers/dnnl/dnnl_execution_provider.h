@@ -143,6 +143,34 @@ class DNNLExecutionProvider : public IExecutionProvider {
       if (node->OutputDefs().size() > 1)
         supported = false;
     }
+    if (node->OpType() == "Add" || node->OpType() == "Mul" || node->OpType() == "Softmax") {
+      // float tensors of rank 1 to 5 only, which leaves the shape computations to the CPU
+      auto node_inputs = node->InputDefs();
+      const auto* type = node_inputs[0]->TypeAsProto();
+      const auto* shape = node_inputs[0]->Shape();
+      if (type == nullptr || !type->has_tensor_type() ||
+          type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT ||
+          shape == nullptr || shape->dim_size() == 0 || shape->dim_size() > 5) {
+        return false;
+      }
+      if (node->OpType() == "Softmax") {
+        // the ONNX Softmax flattens the dims from its axis: only the last axis is a single axis of DNNL
+        int64_t axis = 1;
+        auto attr = node->GetAttributes().find("axis");
+        if (attr != node->GetAttributes().end()) {
+          axis = attr->second.i();
+        }
+        supported = axis == shape->dim_size() - 1 || axis == -1;
+      } else {
+        // no broadcasting: both inputs of the same, known shape
+        const auto* other_shape = node_inputs[1]->Shape();
+        supported = other_shape != nullptr && other_shape->dim_size() == shape->dim_size();
+        for (int i = 0; supported && i < shape->dim_size(); i++) {
+          supported = shape->dim(i).has_dim_value() && other_shape->dim(i).has_dim_value() &&
+                      shape->dim(i).dim_value() == other_shape->dim(i).dim_value();
+        }
+      }
+    }
     return supported;
   }
 
@@ -171,7 +199,8 @@ class DNNLExecutionProvider : public IExecutionProvider {
 
   // supported Dnnl Operators
   std::set<std::string> dnnl_ops_ = {"Conv", "BatchNormalization", "Relu", "Sum",
-                                       "AveragePool", "GlobalMaxPool", "GlobalAveragePool", "MaxPool", "LRN"};
+                                       "AveragePool", "GlobalMaxPool", "GlobalAveragePool", "MaxPool", "LRN",
+                                       "Add", "Mul", "Softmax"};
 
   mutable std::unordered_map<std::string, std::shared_ptr<ort_dnnl::Subgraph>> mkl_subgraphs_;
 };
@@ -0,0 +1,171 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License
+
+#pragma once
+#include "core/framework/op_kernel.h"
+#include "core/providers/dnnl/dnnl_fwd.h"
+#include "core/providers/dnnl/dnnl_common.h"
+#include "core/providers/dnnl/subgraph/dnnl_kernel.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+namespace ort_dnnl {
+
+// Add and Mul of two inputs of the same shape. The provider only claims the nodes whose input shapes are known to be
+// equal, see DNNLExecutionProvider::IsDimensionSupported. The first input comes from the previous node of the
+// subgraph, except in the first node; the second one comes from another node of the subgraph, in its layout, or from
+// an input of the subgraph, in the ONNX Runtime layout. The output keeps the layout of the first input, so a chain of
+// blocked nodes isn't reordered.
+template <typename T>
+class DnnlBinary : public DnnlKernel {
+ public:
+  DnnlBinary(const DnnlNode& node,
+             DNNLExecutionProvider* provider,
+             const NodeAttributes& attributes,
+             const std::string attributes_prefix = "") : DnnlKernel(node, provider) {
+    ORT_UNUSED_PARAMETER(attributes);
+    ORT_UNUSED_PARAMETER(attributes_prefix);
+    algorithm_ = node.name == "Mul" ? dnnl::algorithm::binary_mul : dnnl::algorithm::binary_add;
+  }
+
+  void CreatePrimitives(const OrtCustomOpApi* api,
+                        OrtKernelContext* context,
+                        dnnl::engine& cpu_engine,
+                        std::vector<dnnl::primitive>& net,
+                        std::vector<std::unordered_map<int, dnnl::memory>>& net_args) override {
+    Ort::CustomOpApi ort{*api};
+    int input_index = mklnode_ptr_->input_start_index < 0 ? 0 : mklnode_ptr_->input_start_index;
+
+    TensorShape x_shape;
+    if (mklnode_ptr_->parent_nodes.empty()) {
+      x_shape = GetInputShape(ort, context, input_index);
+      if (x_shape.NumDimensions() == 0) {
+        primitive_created_status_ = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Shape of size zero ",
+                                                    x_shape.ToString());
+        return;
+      }
+      ort_source_format_ = GetSourceFormat(static_cast<int>(x_shape.NumDimensions()));
+      dnnl::memory::dims src_dims(x_shape.GetDims().begin(), x_shape.GetDims().end());
+      ort_source_desc_ = dnnl::memory::desc({src_dims}, DnnnType<T>(), ort_source_format_);
+      source_desc_ = ort_source_desc_;
+      src0_mem_ = std::make_shared<dnnl::memory>(dnnl::memory(ort_source_desc_, cpu_engine, nullptr));
+    } else {
+      x_shape = parents_[0].get()->primitive_dst_shape_;
+      ort_source_format_ = parents_[0].get()->ort_source_format_;
+      ort_source_desc_ = parents_[0].get()->ort_source_desc_;
+      source_desc_ = parents_[0].get()->primitive_dst_desc_;
+      src0_mem_ = parents_[0].get()->primitive_dst_mem_;
+    }
+    primitive_dst_shape_ = TensorShape(x_shape);
+
+    // the second input: from another node of the subgraph, or from the input after the first one
+    if (mklnode_ptr_->parent_nodes.size() > 1) {
+      src1_mem_ = parents_[1].get()->primitive_dst_mem_;
+    } else {
+      src1_input_index_ = input_index + 1;
+      src1_mem_ = std::make_shared<dnnl::memory>(dnnl::memory(ort_source_desc_, cpu_engine, nullptr));
+    }
+    if (!SameDims(src1_mem_->get_desc(), source_desc_)) {
+      primitive_created_status_ = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, mklnode_ptr_->name,
+                                                  " inputs of different shapes aren't supported");
+      return;
+    }
+    // both inputs in the layout of the first one
+    if (src1_mem_->get_desc() != source_desc_) {
+      src1_reordered_mem_ = std::make_shared<dnnl::memory>(dnnl::memory(source_desc_, cpu_engine));
+      net.push_back(dnnl::reorder(*src1_mem_, *src1_reordered_mem_));
+      net_args.push_back({{DNNL_ARG_FROM, *src1_mem_},
+                          {DNNL_ARG_TO, *src1_reordered_mem_}});
+    }
+
+    binary_desc_ = onnxruntime::make_unique<dnnl::binary::desc>(
+        dnnl::binary::desc(algorithm_, source_desc_, source_desc_, source_desc_));
+    binary_pd_ = onnxruntime::make_unique<dnnl::binary::primitive_desc>(
+        dnnl::binary::primitive_desc(*binary_desc_, cpu_engine));
+
+    primitive_src_desc_ = binary_pd_->src_desc(0);
+    primitive_dst_desc_ = binary_pd_->dst_desc();
+
+    if (mklnode_ptr_->output_index >= 0 && primitive_dst_desc_ == ort_source_desc_) {
+      // last node of the subgraph in the ONNX Runtime layout: the output buffer is bound on each run
+      primitive_dst_mem_ = std::make_shared<dnnl::memory>(dnnl::memory(primitive_dst_desc_, cpu_engine, nullptr));
+    } else {
+      // intermediate node, or last node reordered to the output buffer
+      primitive_dst_mem_ = std::make_shared<dnnl::memory>(dnnl::memory(primitive_dst_desc_, cpu_engine));
+    }
+
+    net.push_back(dnnl::binary(*binary_pd_));
+    net_args.push_back({{DNNL_ARG_SRC_0, *src0_mem_},
+                        {DNNL_ARG_SRC_1, src1_reordered_mem_ ? *src1_reordered_mem_ : *src1_mem_},
+                        {DNNL_ARG_DST, *primitive_dst_mem_}});
+
+    if (mklnode_ptr_->output_index >= 0) {
+      // one of the end nodes. Allocate output buffer memory and
+      // reorder is necessary
+      dnnl::memory::data_type t = DnnnType<T>();
+      InitDstReorderOutput(cpu_engine, t, net, net_args);
+    }
+  }
+
+  Status Bind(const OrtCustomOpApi* api, OrtKernelContext* context) override {
+    Ort::CustomOpApi ort{*api};
+
+    ORT_RETURN_IF_ERROR(primitive_created_status_);
+
+    int input_index = mklnode_ptr_->input_start_index < 0 ? 0 : mklnode_ptr_->input_start_index;
+
+    if (mklnode_ptr_->parent_nodes.empty()) {
+      // Sub-graph's first node. Read input from input buffer
+      const OrtValue* input_tensor = ort.KernelContext_GetInput(context, input_index);
+      const T* src_data = ort.GetTensorData<T>(input_tensor);
+      src0_mem_->set_data_handle(static_cast<void*>(const_cast<T*>(src_data)));
+    }
+    if (src1_input_index_ >= 0) {
+      const OrtValue* input_tensor = ort.KernelContext_GetInput(context, src1_input_index_);
+      const T* src_data = ort.GetTensorData<T>(input_tensor);
+      src1_mem_->set_data_handle(static_cast<void*>(const_cast<T*>(src_data)));
+    }
+
+    if (mklnode_ptr_->output_index >= 0) {
+      auto& y_dims = primitive_dst_shape_.GetDims();
+      // Allocate memory for output bufffer
+      OrtValue* output = ort.KernelContext_GetOutput(context, mklnode_ptr_->output_index, &y_dims[0],
+                                                     static_cast<int>(primitive_dst_shape_.GetDims().size()));
+      T* dst_data = ort.GetTensorMutableData<T>(output);
+
+      if (primitive_dst_desc_ != ort_source_desc_) {
+        reorder_dst_mem_to_->set_data_handle(dst_data);
+      } else {
+        primitive_dst_mem_->set_data_handle(dst_data);
+      }
+    }
+
+    return Status::OK();
+  }
+
+ private:
+  static bool SameDims(const dnnl::memory::desc& a, const dnnl::memory::desc& b) {
+    return a.data.ndims == b.data.ndims && std::equal(a.data.dims, a.data.dims + a.data.ndims, b.data.dims);
+  }
+
+  static TensorShape GetInputShape(Ort::CustomOpApi& ort, OrtKernelContext* context, int index) {
+    const OrtValue* input_tensor = ort.KernelContext_GetInput(context, index);
+    auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
+    auto tensor_shape = ort.GetTensorShape(tensor_info);
+    ort.ReleaseTensorTypeAndShapeInfo(tensor_info);
+    return TensorShape(tensor_shape);
+  }
+
+  dnnl::algorithm algorithm_;
+  int src1_input_index_ = -1;
+
+  std::shared_ptr<dnnl::memory> src0_mem_;
+  std::shared_ptr<dnnl::memory> src1_mem_;
+  std::shared_ptr<dnnl::memory> src1_reordered_mem_;
+
+  std::unique_ptr<dnnl::binary::desc> binary_desc_;
+  std::unique_ptr<dnnl::binary::primitive_desc> binary_pd_;
+};
+}  // namespace ort_dnnl
+}  // namespace onnxruntime
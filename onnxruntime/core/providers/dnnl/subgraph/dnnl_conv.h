@@ -287,6 +287,10 @@ class DnnlConv : public DnnlKernel {
 
     src_size_ = conv_fwd_pd_.get()->src_desc().get_size();
     filter_size_ = conv_fwd_pd_.get()->weights_desc().get_size();
+    // the layout of the weights may depend on the shapes of the other inputs: the shape variants of the subgraph
+    // share the weights reordered to the same layout
+    weights_key_ = mklnode_ptr_->weight_name;
+    AddLayoutToKey(weights_key_, conv_fwd_pd_->weights_desc());
     dst_size_ = conv_fwd_pd_.get()->dst_desc().get_size();
 
     filter_mem_ = onnxruntime::make_unique<dnnl::memory>(
@@ -385,7 +389,7 @@ class DnnlConv : public DnnlKernel {
     {
       // lock to make sure reordering is done only once
       std::lock_guard<OrtMutex> lock(provider_->GetMutex());
-      std::shared_ptr<dnnl::memory> filter_dst_mem = provider_->GetWeightsMemoryBuffer(mklnode_ptr_->weight_name);
+      std::shared_ptr<dnnl::memory> filter_dst_mem = provider_->GetWeightsMemoryBuffer(weights_key_);
 
       if (filter_dst_mem == nullptr) {
         dnnl::memory src = dnnl::memory({{filter_dims_mkl}, DnnnType<T>(), filter_format_}, cpu_engine, (void*)filter_data);
@@ -399,7 +403,7 @@ class DnnlConv : public DnnlKernel {
 
         provider_->SaveAllocatedMemory(std::move(filter_reorder_buffer));
         filter_data = static_cast<T*>(filter_dst_mem->get_data_handle());
-        provider_->SetWeightsMemoryBuffer(mklnode_ptr_->weight_name, filter_dst_mem);
+        provider_->SetWeightsMemoryBuffer(weights_key_, filter_dst_mem);
       }
     }
   }
@@ -418,10 +422,10 @@ class DnnlConv : public DnnlKernel {
       const OrtValue* binput_tensor = ort.KernelContext_GetInput(context, input_index + 2);
       bias_data = const_cast<T*>(ort.GetTensorData<T>(binput_tensor));
     }
-    std::shared_ptr<dnnl::memory> filter_dst_mem = provider_->GetWeightsMemoryBuffer(mklnode_ptr_->weight_name);
+    std::shared_ptr<dnnl::memory> filter_dst_mem = provider_->GetWeightsMemoryBuffer(weights_key_);
     if (filter_dst_mem == nullptr) {
       ReorderWeights(api, context, GetEngine());
-      filter_dst_mem = provider_->GetWeightsMemoryBuffer(mklnode_ptr_->weight_name);
+      filter_dst_mem = provider_->GetWeightsMemoryBuffer(weights_key_);
     }
     filter_data = static_cast<T*>(filter_dst_mem->get_data_handle());
 
@@ -548,6 +552,8 @@ class DnnlConv : public DnnlKernel {
   std::unique_ptr<dnnl::memory::desc> bias_md_;
 
   std::unique_ptr<dnnl::convolution_forward::primitive_desc> conv_fwd_pd_;
+  // key of the reordered weights in the provider
+  std::string weights_key_;
   std::unique_ptr<dnnl::primitive> conv_fwd_;
 
  private:
@@ -239,6 +239,10 @@ class DnnlConvBatchNorm : public DnnlKernel {
 
     src_size_ = conv_fwd_pd_.get()->src_desc().get_size();
     filter_size_ = conv_fwd_pd_.get()->weights_desc().get_size();
+    // the layout of the weights may depend on the shapes of the other inputs: the shape variants of the subgraph
+    // share the weights reordered to the same layout
+    weights_key_ = mklnode_ptr_->weight_name;
+    AddLayoutToKey(weights_key_, conv_fwd_pd_->weights_desc());
     dst_size_ = conv_fwd_pd_.get()->dst_desc().get_size();
 
     filter_mem_ = onnxruntime::make_unique<dnnl::memory>(
@@ -368,6 +372,15 @@ class DnnlConvBatchNorm : public DnnlKernel {
     auto xdim = tensor_shape.size();
     TensorShape W(xshape, xdim);
 
+    {
+      // the weights scaled by the batch normalization were already reordered for another instance of the subgraph
+      std::lock_guard<OrtMutex> lock(provider_->GetMutex());
+      if (provider_->GetWeightsMemoryBuffer(weights_key_) != nullptr &&
+          provider_->GetBiasMemoryBuffer(mklnode_ptr_->weight_name) != nullptr) {
+        return;
+      }
+    }
+
     const int group_mkl = static_cast<int>(group_);
     dnnl::memory::dims filter_dims_mkl;
     if (group_mkl == 1) {
@@ -393,7 +406,7 @@ class DnnlConvBatchNorm : public DnnlKernel {
     {
       // lock to make sure reordering is done only once
       std::lock_guard<OrtMutex> lock(provider_->GetMutex());
-      std::shared_ptr<dnnl::memory> filter_dst_mem = provider_->GetWeightsMemoryBuffer(mklnode_ptr_->weight_name);
+      std::shared_ptr<dnnl::memory> filter_dst_mem = provider_->GetWeightsMemoryBuffer(weights_key_);
 
       if (filter_dst_mem == nullptr) {
         dnnl::memory src = dnnl::memory({{filter_dims_mkl}, DnnnType<T>(), filter_format_}, cpu_engine, (void*)weights_scaled_by_axis.data());
@@ -406,7 +419,7 @@ class DnnlConvBatchNorm : public DnnlKernel {
             .execute(cpu_engine, src, *filter_dst_mem);
 
         provider_->SaveAllocatedMemory(std::move(filter_reorder_buffer));
-        provider_->SetWeightsMemoryBuffer(mklnode_ptr_->weight_name, filter_dst_mem);
+        provider_->SetWeightsMemoryBuffer(weights_key_, filter_dst_mem);
       }
 
       std::shared_ptr<dnnl::memory> bias_mem = provider_->GetBiasMemoryBuffer(mklnode_ptr_->weight_name);
@@ -460,10 +473,10 @@ class DnnlConvBatchNorm : public DnnlKernel {
     const OrtValue* winput_tensor = ort.KernelContext_GetInput(context, input_index + 1);
     const T* filter_data = const_cast<T*>(ort.GetTensorData<T>(winput_tensor));
 
-    std::shared_ptr<dnnl::memory> filter_dst_mem = provider_->GetWeightsMemoryBuffer(mklnode_ptr_->weight_name);
+    std::shared_ptr<dnnl::memory> filter_dst_mem = provider_->GetWeightsMemoryBuffer(weights_key_);
     if (filter_dst_mem == nullptr) {
       ReorderWeights(api, context, GetEngine());
-      filter_dst_mem = provider_->GetWeightsMemoryBuffer(mklnode_ptr_->weight_name);
+      filter_dst_mem = provider_->GetWeightsMemoryBuffer(weights_key_);
     }
     filter_data = static_cast<T*>(filter_dst_mem->get_data_handle());
     filter_mem_->set_data_handle(static_cast<void*>(const_cast<T*>(filter_data)));
@@ -595,6 +608,8 @@ class DnnlConvBatchNorm : public DnnlKernel {
   std::unique_ptr<dnnl::memory::desc> bias_md_;
 
   std::unique_ptr<dnnl::convolution_forward::primitive_desc> conv_fwd_pd_;
+  // key of the reordered weights in the provider
+  std::string weights_key_;
   std::unique_ptr<dnnl::primitive> conv_fwd_;
 
  private:
@@ -15,6 +15,8 @@
 #include "core/providers/dnnl/subgraph/dnnl_pool.h"
 #include "core/providers/dnnl/subgraph/dnnl_sum.h"
 #include "core/providers/dnnl/subgraph/dnnl_lrn.h"
+#include "core/providers/dnnl/subgraph/dnnl_binary.h"
+#include "core/providers/dnnl/subgraph/dnnl_softmax.h"
 #include "core/session/onnxruntime_cxx_api.h"
 
 namespace onnxruntime {
@@ -171,6 +173,24 @@ class SubgraphPrimitive : public PrimitiveBase {
           kernel->parents_.push_back(context_.kernels[index]);
         }
         context_.kernels.push_back(kernel);
+      } else if (dnnl_node.name == "Add" || dnnl_node.name == "Mul") {
+        std::ostringstream os;
+        os << dnnl_node.name << "-" << dnnl_node.node_index << "-";
+        std::shared_ptr<DnnlBinary<T>> kernel;
+        kernel = std::make_shared<DnnlBinary<T>>(dnnl_node, params.provider, params.attributes, os.str());
+        for (auto index : dnnl_node.parent_nodes) {
+          kernel->parents_.push_back(context_.kernels[index]);
+        }
+        context_.kernels.push_back(kernel);
+      } else if (dnnl_node.name == "Softmax") {
+        std::ostringstream os;
+        os << "Softmax-" << dnnl_node.node_index << "-";
+        std::shared_ptr<DnnlSoftmax<T>> kernel;
+        kernel = std::make_shared<DnnlSoftmax<T>>(dnnl_node, params.provider, params.attributes, os.str());
+        for (auto index : dnnl_node.parent_nodes) {
+          kernel->parents_.push_back(context_.kernels[index]);
+        }
+        context_.kernels.push_back(kernel);
       } else if (dnnl_node.name == "Sum") {
         std::ostringstream os;
         os << "Sum-" << dnnl_node.node_index << "-";
@@ -208,14 +228,14 @@ class SubgraphPrimitive : public PrimitiveBase {
   dnnl::engine& cpu_engine_;
 };
 
-// Pool which allows for reuse of DNNL Conv primitives which are expensive to instantiate.
-// To address thread safety, the primitives are stored in a map on thread local storage.
+// Pool which allows for reuse of DNNL subgraph primitives which are expensive to instantiate, across the threads and
+// the sessions of the process. The primitives are keyed by the subgraph, its attributes and the shapes of its inputs.
 template <typename T>
 class SubgraphPrimitivePool : public PrimitivePool<T> {
  public:
-  static SubgraphPrimitive<T>* Get(const OrtCustomOpApi* api,
-                                   OrtKernelContext* context,
-                                   const SubgraphParams& params) {
+  static std::string GetKey(const OrtCustomOpApi* api,
+                            OrtKernelContext* context,
+                            const SubgraphParams& params) {
     Ort::CustomOpApi ort{*api};
     std::string dims_str;
     for (auto i = 0; i < params.subgraph->dnnl_nodes[0].num_inputs; i++) {
@@ -230,26 +250,17 @@ class SubgraphPrimitivePool : public PrimitivePool<T> {
       dnnl::memory::dims src_dims(x_shape.GetDims().begin(), x_shape.GetDims().end());
       AddDimsToKey(dims_str, src_dims);
     }
-
-    SubgraphPrimitive<T>* primitive = dynamic_cast<SubgraphPrimitive<T>*>(
-        SubgraphPrimitivePool<T>::GetInstance().GetPrimitive(params.subgraph_key + dims_str));
-
-    if (primitive == nullptr) {
-      auto subgraph_primitive = onnxruntime::make_unique<SubgraphPrimitive<T>>(api, context, params);
-      primitive = subgraph_primitive.get();
-      SubgraphPrimitivePool<T>::GetInstance().SetPrimitive(params.subgraph_key + dims_str, std::move(subgraph_primitive));
-    }
-    return primitive;
+    return params.subgraph_key + dims_str;
   }
 
- private:
-  SubgraphPrimitivePool() = default;
-  ~SubgraphPrimitivePool() = default;
-
   static SubgraphPrimitivePool& GetInstance() {
     static SubgraphPrimitivePool pool;
     return pool;
   }
+
+ private:
+  SubgraphPrimitivePool() = default;
+  ~SubgraphPrimitivePool() = default;
 };
 }  // namespace
 
@@ -257,9 +268,17 @@ template <typename T>
 Status DnnlFuncKernel<T>::Compute(const OrtCustomOpApi* api, OrtKernelContext* context) const {
   Status status;
   try {
-    SubgraphPrimitive<T>* primitive = SubgraphPrimitivePool<T>::Get(api, context, params_);
-    primitive->UpdateProvider(params_);
-    status = primitive->Compute(api, context);
+    auto& pool = SubgraphPrimitivePool<T>::GetInstance();
+    const std::string key = SubgraphPrimitivePool<T>::GetKey(api, context, params_);
+    std::unique_ptr<PrimitiveBase> primitive = pool.AcquirePrimitive(key);
+    if (primitive == nullptr) {
+      primitive = onnxruntime::make_unique<SubgraphPrimitive<T>>(api, context, params_);
+    }
+    auto* subgraph_primitive = static_cast<SubgraphPrimitive<T>*>(primitive.get());
+    subgraph_primitive->UpdateProvider(params_);
+    status = subgraph_primitive->Compute(api, context);
+    // a primitive whose run threw is dropped rather than put back
+    pool.ReleasePrimitive(key, std::move(primitive));
   } catch (const dnnl::error& e) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Status: ", e.status,
                            ", message: ", e.what());
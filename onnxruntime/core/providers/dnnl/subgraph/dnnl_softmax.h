@@ -0,0 +1,138 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License
+
+#pragma once
+#include "core/framework/op_kernel.h"
+#include "core/providers/dnnl/dnnl_fwd.h"
+#include "core/providers/dnnl/dnnl_common.h"
+#include "core/providers/dnnl/subgraph/dnnl_kernel.h"
+
+namespace onnxruntime {
+namespace ort_dnnl {
+
+// Softmax over the last axis, the only one on which the ONNX Softmax, which flattens the dims from its axis, is a
+// softmax over a single axis of DNNL. The provider only claims those nodes, see
+// DNNLExecutionProvider::IsDimensionSupported. It runs in the ONNX Runtime layout.
+template <typename T>
+class DnnlSoftmax : public DnnlKernel {
+ public:
+  DnnlSoftmax(const DnnlNode& node,
+              DNNLExecutionProvider* provider,
+              const NodeAttributes& attributes,
+              const std::string attributes_prefix = "") : DnnlKernel(node, provider) {
+    ORT_UNUSED_PARAMETER(attributes);
+    ORT_UNUSED_PARAMETER(attributes_prefix);
+  }
+
+  void CreatePrimitives(const OrtCustomOpApi* api,
+                        OrtKernelContext* context,
+                        dnnl::engine& cpu_engine,
+                        std::vector<dnnl::primitive>& net,
+                        std::vector<std::unordered_map<int, dnnl::memory>>& net_args) override {
+    Ort::CustomOpApi ort{*api};
+    int input_index = mklnode_ptr_->input_start_index < 0 ? 0 : mklnode_ptr_->input_start_index;
+
+    TensorShape x_shape;
+    if (mklnode_ptr_->parent_nodes.empty()) {
+      const OrtValue* input_tensor = ort.KernelContext_GetInput(context, input_index);
+      auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
+      auto tensor_shape = ort.GetTensorShape(tensor_info);
+      ort.ReleaseTensorTypeAndShapeInfo(tensor_info);
+      x_shape = TensorShape(tensor_shape);
+      if (x_shape.NumDimensions() == 0) {
+        primitive_created_status_ = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Shape of size zero ",
+                                                    x_shape.ToString());
+        return;
+      }
+
+      ort_source_format_ = GetSourceFormat(static_cast<int>(x_shape.NumDimensions()));
+      dnnl::memory::dims src_dims(x_shape.GetDims().begin(), x_shape.GetDims().end());
+      ort_source_desc_ = dnnl::memory::desc({src_dims}, DnnnType<T>(), ort_source_format_);
+      source_desc_ = ort_source_desc_;
+      src_mem_ = std::make_shared<dnnl::memory>(dnnl::memory(ort_source_desc_, cpu_engine, nullptr));
+    } else {
+      x_shape = parents_[0].get()->primitive_dst_shape_;
+      ort_source_format_ = parents_[0].get()->ort_source_format_;
+      ort_source_desc_ = parents_[0].get()->ort_source_desc_;
+      source_desc_ = parents_[0].get()->primitive_dst_desc_;
+      src_mem_ = parents_[0].get()->primitive_dst_mem_;
+    }
+    primitive_dst_shape_ = TensorShape(x_shape);
+
+    // a blocked input, e.g. from a Conv, is reordered as the axis may be split across blocks
+    if (source_desc_ != ort_source_desc_) {
+      src_reordered_mem_ = std::make_shared<dnnl::memory>(dnnl::memory(ort_source_desc_, cpu_engine));
+      net.push_back(dnnl::reorder(*src_mem_, *src_reordered_mem_));
+      net_args.push_back({{DNNL_ARG_FROM, *src_mem_},
+                          {DNNL_ARG_TO, *src_reordered_mem_}});
+    }
+
+    const int axis = static_cast<int>(x_shape.NumDimensions()) - 1;
+    fwd_desc_ = onnxruntime::make_unique<dnnl::softmax_forward::desc>(
+        dnnl::softmax_forward::desc(dnnl::prop_kind::forward_inference, ort_source_desc_, axis));
+    softmax_fwd_pd_ = onnxruntime::make_unique<dnnl::softmax_forward::primitive_desc>(
+        dnnl::softmax_forward::primitive_desc(*fwd_desc_, cpu_engine));
+
+    primitive_src_desc_ = softmax_fwd_pd_->src_desc();
+    primitive_dst_desc_ = softmax_fwd_pd_->dst_desc();
+
+    if (mklnode_ptr_->output_index >= 0 && primitive_dst_desc_ == ort_source_desc_) {
+      // last node of the subgraph in the ONNX Runtime layout: the output buffer is bound on each run
+      primitive_dst_mem_ = std::make_shared<dnnl::memory>(dnnl::memory(primitive_dst_desc_, cpu_engine, nullptr));
+    } else {
+      // intermediate node, or last node reordered to the output buffer
+      primitive_dst_mem_ = std::make_shared<dnnl::memory>(dnnl::memory(primitive_dst_desc_, cpu_engine));
+    }
+
+    net.push_back(dnnl::softmax_forward(*softmax_fwd_pd_));
+    net_args.push_back({{DNNL_ARG_SRC, src_reordered_mem_ ? *src_reordered_mem_ : *src_mem_},
+                        {DNNL_ARG_DST, *primitive_dst_mem_}});
+
+    if (mklnode_ptr_->output_index >= 0) {
+      // one of the end nodes. Allocate output buffer memory and
+      // reorder is necessary
+      dnnl::memory::data_type t = DnnnType<T>();
+      InitDstReorderOutput(cpu_engine, t, net, net_args);
+    }
+  }
+
+  Status Bind(const OrtCustomOpApi* api, OrtKernelContext* context) override {
+    Ort::CustomOpApi ort{*api};
+
+    ORT_RETURN_IF_ERROR(primitive_created_status_);
+
+    int input_index = mklnode_ptr_->input_start_index < 0 ? 0 : mklnode_ptr_->input_start_index;
+
+    if (mklnode_ptr_->parent_nodes.empty()) {
+      // Sub-graph's first node. Read input from input buffer
+      const OrtValue* input_tensor = ort.KernelContext_GetInput(context, input_index);
+      const T* src_data = ort.GetTensorData<T>(input_tensor);
+      src_mem_->set_data_handle(static_cast<void*>(const_cast<T*>(src_data)));
+    }
+
+    if (mklnode_ptr_->output_index >= 0) {
+      auto& y_dims = primitive_dst_shape_.GetDims();
+      // Allocate memory for output bufffer
+      OrtValue* output = ort.KernelContext_GetOutput(context, mklnode_ptr_->output_index, &y_dims[0],
+                                                     static_cast<int>(primitive_dst_shape_.GetDims().size()));
+      T* dst_data = ort.GetTensorMutableData<T>(output);
+
+      if (primitive_dst_desc_ != ort_source_desc_) {
+        reorder_dst_mem_to_->set_data_handle(dst_data);
+      } else {
+        primitive_dst_mem_->set_data_handle(dst_data);
+      }
+    }
+
+    return Status::OK();
+  }
+
+ private:
+  std::shared_ptr<dnnl::memory> src_mem_;
+  std::shared_ptr<dnnl::memory> src_reordered_mem_;
+
+  std::unique_ptr<dnnl::softmax_forward::desc> fwd_desc_;
+  std::unique_ptr<dnnl::softmax_forward::primitive_desc> softmax_fwd_pd_;
+};
+}  // namespace ort_dnnl
+}  // namespace onnxruntime
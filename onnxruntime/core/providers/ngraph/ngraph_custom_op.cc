@@ -1,6 +1,7 @@
 // Copyright(C) 2019 Intel Corporation
 // Licensed under the MIT License
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -45,6 +46,22 @@ NGRAPHCustomOp::NGRAPHCustomOp(const ComputeContext* context,
   allocator_ = context->allocator_handle;
   name_ = context->node_name;
 
+  // Get cache size from environment
+  std::string tempSize;
+#ifdef _WIN32
+  char* buf{nullptr};
+  size_t bufSize = 0;
+  if (!_dupenv_s(&buf, &bufSize, "ONNXRUNTIME_NGRAPH_LRU_CACHE_SIZE") && buf) {
+    tempSize = buf;
+    free(buf);
+  }
+#else
+  if (std::getenv("ONNXRUNTIME_NGRAPH_LRU_CACHE_SIZE")) {
+    tempSize = std::getenv("ONNXRUNTIME_NGRAPH_LRU_CACHE_SIZE");
+  }
+#endif
+  cache_size_ = tempSize.empty() ? NGRAPH_EP_LRU_CACHE_DEFAULT_SIZE : std::max(1, std::stoi(tempSize));
+
   if (check_ngraph_dump_ops()) {
     std::fstream dump(name_ + ".onnx", std::ios::out | std::ios::trunc | std::ios::binary);
     model_proto_.SerializeToOstream(&dump);
@@ -52,13 +69,14 @@ NGRAPHCustomOp::NGRAPHCustomOp(const ComputeContext* context,
 }
 
 NGRAPHCustomOp::~NGRAPHCustomOp() {
-  for (const auto& compiled_exe : ng_exe_map_) {
-    ng_backend_->remove_compiled_function(compiled_exe.second);
+  for (const auto& compiled : lru_list_) {
+    ng_backend_->remove_compiled_function(compiled.second->exe);
   }
 }
 
 //This method gets called in critical path of execution: Optimize
-Status NGRAPHCustomOp::Initialize(const OrtApi* api, OrtKernelContext* context) const {
+Status NGRAPHCustomOp::Initialize(const OrtApi* api, OrtKernelContext* context,
+                                  std::shared_ptr<CompiledFunction>& compiled) const {
   Ort::CustomOpApi ort{*api};
 
   size_t num_inputs = ort.KernelContext_GetInputCount(context);
@@ -80,50 +98,12 @@ Status NGRAPHCustomOp::Initialize(const OrtApi* api, OrtKernelContext* context)
     uniq_input_shape.append(reinterpret_cast<const char*>(tensor_shape.data()), ndim * sizeof(int64_t));
   }
 
-  // Get cache size from environment
-  std::string tempSize;
-#ifdef _WIN32
-  char* buf{nullptr};
-  size_t bufSize = 0;
-  if (!_dupenv_s(&buf, &bufSize, "ONNXRUNTIME_NGRAPH_LRU_CACHE_SIZE") && buf) {
-    tempSize = buf;
-    free(buf);
-  }
-#else
-  if (std::getenv("ONNXRUNTIME_NGRAPH_LRU_CACHE_SIZE")) {
-    tempSize = std::getenv("ONNXRUNTIME_NGRAPH_LRU_CACHE_SIZE");
-  }
-#endif
-  size_t cacheSize = tempSize.empty() ? NGRAPH_EP_LRU_CACHE_DEFAULT_SIZE : std::stoi(tempSize);
-
-  // Not in cache
-  if (ng_exe_map_.find(uniq_input_shape) == ng_exe_map_.end()) {
-    // Check if full
-    if (keyCache.size() == cacheSize) {
-      // Delete least recently used element
-      std::string last = keyCache.back();
-
-      // Pop the last elmeent
-      keyCache.pop_back();
-
-      // Erase the last element from cache
-      ng_exe_map_.erase(ng_exe_map_.find(last));
-    }
-  }
-
-  // Found in cache
-  else {
-    keyCache.remove(uniq_input_shape);
-  }
-
-  // update reference
-  keyCache.push_front(uniq_input_shape);
-  auto it = ng_exe_map_.insert({uniq_input_shape, nullptr});
+  auto it = ng_exe_map_.find(uniq_input_shape);
 
-  //ng_exe with current shape already exists
-  if (!it.second) {
-    ng_curr_exe_ = it.first->second;
-    return Status::OK();
+  //ng_exe with current shape already exists: update reference
+  if (it != ng_exe_map_.end()) {
+    lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
+    compiled = it->second->second;
   } else {
     auto graph_proto = model_proto_.mutable_graph();
 
@@ -162,7 +142,8 @@ Status NGRAPHCustomOp::Initialize(const OrtApi* api, OrtKernelContext* context)
 
     // Finally compile nGraph with backend.
     try {
-      ng_curr_exe_ = ng_backend_->compile(ng_function);
+      compiled = std::make_shared<CompiledFunction>();
+      compiled->exe = ng_backend_->compile(ng_function);
     } catch (const std::exception& exp) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
                              "[NGRAPHCustomOp] - " + name_ + " - Exception while compiling ngraph::Function: " + std::string(exp.what()));
@@ -170,7 +151,15 @@ Status NGRAPHCustomOp::Initialize(const OrtApi* api, OrtKernelContext* context)
       return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
                              "[NGRAPHCustomOp] - " + name_ + " - Unknown exception while compiling ngraph::Function");
     }
-    it.first->second = ng_curr_exe_;
+
+    // Delete least recently used element if full. A Compute still running it keeps it alive.
+    if (lru_list_.size() >= cache_size_) {
+      ng_backend_->remove_compiled_function(lru_list_.back().second->exe);
+      ng_exe_map_.erase(lru_list_.back().first);
+      lru_list_.pop_back();
+    }
+    lru_list_.emplace_front(uniq_input_shape, compiled);
+    ng_exe_map_[uniq_input_shape] = lru_list_.begin();
   }
   return Status::OK();
 }
@@ -180,12 +169,14 @@ Status NGRAPHCustomOp::Compute(const OrtApi* api, OrtKernelContext* context) con
   Ort::CustomOpApi ort{*api};
 
   // Initialize nGraph function if it is not already initialized.
+  std::shared_ptr<CompiledFunction> compiled;
   {
     std::lock_guard<std::mutex> lock(compute_lock_);
-    ORT_RETURN_IF_ERROR(Initialize(api, context));
+    ORT_RETURN_IF_ERROR(Initialize(api, context, compiled));
   }
 
-  ORT_ENFORCE(ng_curr_exe_ != nullptr);
+  ORT_ENFORCE(compiled != nullptr && compiled->exe != nullptr);
+  const auto& ng_exe = compiled->exe;
 
   std::vector<std::shared_ptr<ngraph::runtime::Tensor>> ng_inputs;
   std::vector<std::shared_ptr<ngraph::runtime::Tensor>> ng_outputs;
@@ -193,7 +184,7 @@ Status NGRAPHCustomOp::Compute(const OrtApi* api, OrtKernelContext* context) con
   // Write ONNXR input data to nGraph input tensors.
   try {
     unsigned input_index = 0;
-    for (const auto& ng_param : ng_curr_exe_->get_parameters()) {
+    for (const auto& ng_param : ng_exe->get_parameters()) {
       const OrtValue* input_tensor = ort.KernelContext_GetInput(context, input_index++);
       void* input_data = const_cast<void*>(ort.GetTensorData<void>(input_tensor));
       std::lock_guard<std::mutex> lock(compute_lock_);
@@ -209,7 +200,7 @@ Status NGRAPHCustomOp::Compute(const OrtApi* api, OrtKernelContext* context) con
   try {
     //TODO: Optimize
     unsigned output_index = 0;
-    for (auto& ng_result : ng_curr_exe_->get_results()) {
+    for (auto& ng_result : ng_exe->get_results()) {
       const auto& dtype = ng_result->get_element_type();
       const auto& shape = ng_result->get_shape();
 
@@ -227,8 +218,8 @@ Status NGRAPHCustomOp::Compute(const OrtApi* api, OrtKernelContext* context) con
 
   // Run the graph through nGraph.
   try {
-    std::lock_guard<std::mutex> lock(compute_lock_);
-    if (!ng_curr_exe_->call(ng_outputs, ng_inputs))
+    std::lock_guard<std::mutex> lock(compiled->call_lock);
+    if (!ng_exe->call(ng_outputs, ng_inputs))
       return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, name_ + ": Error while executing nGraph computation");
   } catch (const std::exception& exp) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, name_ + ": Exception while executing nGraph computation: " + std::string(exp.what()));
@@ -16,6 +16,10 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
 #include "core/session/onnxruntime_c_api.h"
 #include "core/framework/func_api.h"
 #include "core/graph/onnx_protobuf.h"
@@ -34,11 +38,16 @@ class NGRAPHCustomOp {
   ~NGRAPHCustomOp();
 
  private:
-  Status Initialize(const OrtApi* api, OrtKernelContext* context) const;
+  // An nGraph::Executable with the lock of its calls. The calls of an executable aren't reentrant, but the concurrent
+  // Computes with different input shapes run their executables in parallel.
+  struct CompiledFunction {
+    std::shared_ptr<ngraph::runtime::Executable> exe;
+    std::mutex call_lock;
+  };
 
-  std::shared_ptr<ngraph::runtime::Backend> ng_backend_;
+  Status Initialize(const OrtApi* api, OrtKernelContext* context, std::shared_ptr<CompiledFunction>& compiled) const;
 
-  mutable std::shared_ptr<ngraph::runtime::Executable> ng_curr_exe_ = nullptr;
+  std::shared_ptr<ngraph::runtime::Backend> ng_backend_;
 
   AllocateFunc allocate_func_ = nullptr;
 
@@ -50,14 +59,18 @@ class NGRAPHCustomOp {
 
   /*
   nGraph::Executable objects are specific to input shapes.
-  Here we keep of a cache of nGraph::Executable objects with key as input shapes. TODO: Configure size of this cache.
+  Here we keep an LRU cache of nGraph::Executable objects with key as input shapes, of at most cache_size_ entries
+  (ONNXRUNTIME_NGRAPH_LRU_CACHE_SIZE). The most recently used entry is at the front of lru_list_.
   Logically, key = [i0.rank,[i0.dims],i1.rank,[i1.dims] ... iN.rank,[iN.dims]] raw bytes enclosed inside a string.
   Example: input0.shape(1,2,3) input1.shape(4,5)
   key = [3,1,2,3,2,4,5]
 */
-  mutable std::unordered_map<std::string, std::shared_ptr<ngraph::runtime::Executable>> ng_exe_map_;
-  mutable std::list<std::string> keyCache;
+  using LruList = std::list<std::pair<std::string, std::shared_ptr<CompiledFunction>>>;
+  mutable LruList lru_list_;
+  mutable std::unordered_map<std::string, LruList::iterator> ng_exe_map_;
+  size_t cache_size_;
 
+  // guards the cache and the backend
   mutable std::mutex compute_lock_;
 
   mutable ONNX_NAMESPACE::ModelProto model_proto_;
@@ -14,8 +14,8 @@ namespace onnxruntime {
 
 constexpr const char* NNAPI = "Nnapi";
 
-NnapiExecutionProvider::NnapiExecutionProvider()
-    : IExecutionProvider{onnxruntime::kNnapiExecutionProvider} {
+NnapiExecutionProvider::NnapiExecutionProvider(const NnapiExecutionProviderInfo& info)
+    : IExecutionProvider{onnxruntime::kNnapiExecutionProvider}, info_(info) {
   DeviceAllocatorRegistrationInfo device_info{OrtMemTypeDefault,
                                               [](int) { return onnxruntime::make_unique<CPUAllocator>(
                                                             onnxruntime::make_unique<OrtMemoryInfo>(NNAPI,
@@ -216,8 +216,8 @@ common::Status NnapiExecutionProvider::Compile(const std::vector<onnxruntime::No
     dnn::OnnxReader onnx_reader;
     dnn::ModelBuilder model_builder;
     onnx_reader.ReadOnnx(model_proto, model_builder);
-    model_builder.AllowFp16(true);
-    auto dnn_model = model_builder.Compile(model_builder.PREFERENCE_SUSTAINED_SPEED);
+    model_builder.AllowFp16(info_.use_fp16);
+    auto dnn_model = model_builder.Compile(info_.execution_preference);
     dnn_models_.emplace(fused_node->Name(), std::move(dnn_model));
 
     NodeComputeInfo compute_info;
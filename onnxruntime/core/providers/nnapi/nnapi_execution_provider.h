@@ -7,9 +7,18 @@
 #include "dnnlibrary/Model.h"
 
 namespace onnxruntime {
+
+// Information needed to construct the NNAPI execution provider.
+struct NnapiExecutionProviderInfo {
+  // float32 models computed in float16
+  bool use_fp16{true};
+  // ANEURALNETWORKS_PREFER_SUSTAINED_SPEED
+  uint32_t execution_preference{2};
+};
+
 class NnapiExecutionProvider : public IExecutionProvider {
  public:
-  NnapiExecutionProvider();
+  explicit NnapiExecutionProvider(const NnapiExecutionProviderInfo& info = NnapiExecutionProviderInfo());
   virtual ~NnapiExecutionProvider();
 
   std::vector<std::unique_ptr<ComputeCapability>>
@@ -19,6 +28,7 @@ class NnapiExecutionProvider : public IExecutionProvider {
                          std::vector<NodeComputeInfo>& node_compute_funcs) override;
 
  private:
+  NnapiExecutionProviderInfo info_;
   std::unordered_map<std::string, std::unique_ptr<dnn::Model>> dnn_models_;
   std::vector<std::vector<int>> GetSupportedNodes(const ONNX_NAMESPACE::ModelProto& model_proto) const;
 };
@@ -3,24 +3,33 @@
 #include "core/providers/nnapi/nnapi_provider_factory.h"
 #include "nnapi_execution_provider.h"
 #include "core/session/abi_session_options_impl.h"
+#include "core/framework/error_code_helper.h"
 
 using namespace onnxruntime;
 
 namespace onnxruntime {
 
 struct NnapiProviderFactory : IExecutionProviderFactory {
-  NnapiProviderFactory() {}
+  NnapiProviderFactory(const NnapiExecutionProviderInfo& info) : info_(info) {}
   ~NnapiProviderFactory() override {}
 
   std::unique_ptr<IExecutionProvider> CreateProvider() override;
+
+ private:
+  NnapiExecutionProviderInfo info_;
 };
 
 std::unique_ptr<IExecutionProvider> NnapiProviderFactory::CreateProvider() {
-  return onnxruntime::make_unique<NnapiExecutionProvider>();
+  return onnxruntime::make_unique<NnapiExecutionProvider>(info_);
 }
 
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Nnapi() {
-  return std::make_shared<onnxruntime::NnapiProviderFactory>();
+  return std::make_shared<onnxruntime::NnapiProviderFactory>(NnapiExecutionProviderInfo());
+}
+
+std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Nnapi(
+    const NnapiExecutionProviderInfo& info) {
+  return std::make_shared<onnxruntime::NnapiProviderFactory>(info);
 }
 }  // namespace onnxruntime
 
@@ -29,4 +38,17 @@ ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProvider_Nnapi, _In_ OrtSess
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProviderEx_Nnapi, _In_ OrtSessionOptions* options, int use_fp16,
+                    int execution_preference) {
+  if (execution_preference < 0 || execution_preference > 2) {
+    return onnxruntime::ToOrtStatus(ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                                    "Invalid NNAPI execution preference: ", execution_preference));
+  }
+  NnapiExecutionProviderInfo info;
+  info.use_fp16 = use_fp16 != 0;
+  info.execution_preference = static_cast<uint32_t>(execution_preference);
+  options->provider_factories.push_back(onnxruntime::CreateExecutionProviderFactory_Nnapi(info));
+  return nullptr;
+}
+
 
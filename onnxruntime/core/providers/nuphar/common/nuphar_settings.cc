@@ -37,8 +37,12 @@ static const std::unordered_set<std::string> valid_keys = {
     kNupharCacheSoName,
     kNupharCacheModelChecksum,
     kNupharCacheForceNoJIT,
+    kNupharCacheAuto,
     kNupharCodeGenTarget,
-    kNupharParallelMinWorkloads};
+    kNupharParallelMinWorkloads,
+    kNupharCompileThreads,
+    kNupharTuning,
+    kNupharTuningLog};
 
 void SetDefaultOptions(std::map<std::string, std::string>& options) {
   // create two temporary strings to get rid of the odr-use issue introduced
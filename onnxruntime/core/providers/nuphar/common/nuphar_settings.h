@@ -17,6 +17,8 @@ constexpr static const char* kNupharCachePath = "nuphar_cache_path";
 constexpr static const char* kNupharCacheSoName = "nuphar_cache_so_name";
 constexpr static const char* kNupharCacheModelChecksum = "nuphar_cache_model_checksum";
 constexpr static const char* kNupharCacheForceNoJIT = "nuphar_cache_force_no_jit";
+// save the JIT-compiled funcs to nuphar_cache_path, under nuphar_cache_model_checksum, and load them from there
+constexpr static const char* kNupharCacheAuto = "nuphar_cache_auto";
 // force to use IMatMulExternMKL/IMatMul16ExternMKL
 constexpr static const char* kNupharIMatMulForceMkl = "nuphar_imatmul_force_mkl";
 
@@ -47,6 +49,14 @@ constexpr static const char* kNupharCodeGenTarget = "nuphar_codegen_target";
 // Option to control nuphar code to run with parallel schedule
 constexpr static const char* kNupharParallelMinWorkloads = "nuphar_parallel_min_workloads";
 
+// Option to control the number of threads compiling the subgraphs of a fused node, 0 for the default of
+// concurrency::CreateThreadPool and 1 to compile them sequentially
+constexpr static const char* kNupharCompileThreads = "nuphar_compile_threads";
+
+// Options to tune the schedules of the subgraphs, see nuphar_schedule_tuning.h
+constexpr static const char* kNupharTuning = "nuphar_tuning";
+constexpr static const char* kNupharTuningLog = "nuphar_tuning_log";
+
 constexpr static const char* kNupharCacheSoName_Default = "jit.so";
 
 void CreateNupharCodeGenSettings(const NupharExecutionProviderInfo& info);
@@ -20,6 +20,11 @@
 #undef _SILENCE_EXPERIMENTAL_FILESYSTEM_DEPRECATION_WARNING
 #include <atomic>
 #include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
 namespace fs = std::experimental::filesystem;
 
 namespace onnxruntime {
@@ -35,8 +40,9 @@ static bool GetOrCreateTVMModuleCacheDirectory(fs::path& path, bool create) {
   if (!create && !fs::is_directory(path))
     return false;
 
+  // another process sharing the cache path may create it first
   if (!fs::is_directory(path))
-    if (!fs::create_directory(path)) {
+    if (!fs::create_directory(path) && !fs::is_directory(path)) {
       throw std::runtime_error("Failed to create directory " + path.string());
     }
 
@@ -44,8 +50,9 @@ static bool GetOrCreateTVMModuleCacheDirectory(fs::path& path, bool create) {
   if (!create && !fs::is_directory(path))
     return false;
 
+  // another process sharing the cache path may create it first
   if (!fs::is_directory(path))
-    if (!fs::create_directory(path)) {
+    if (!fs::create_directory(path) && !fs::is_directory(path)) {
       throw std::runtime_error("Failed to create directory " + path.string());
     }
 
@@ -204,6 +211,214 @@ void SaveTVMModuleToCache(const std::string& filename, tvm::runtime::Module& mod
   }
 }
 
+static bool GetOrCreateAutoCacheDirectory(fs::path& path, bool create) {
+  codegen::CodeGenSettings& settings = codegen::CodeGenSettings::Instance();
+
+  if (!settings.HasOption(kNupharCacheModelChecksum)) {
+    static std::once_flag warn_once;
+    std::call_once(warn_once, []() {
+      LOGS_DEFAULT(WARNING) << kNupharCacheAuto << " is ignored without " << kNupharCacheModelChecksum;
+    });
+    return false;
+  }
+
+  if (!GetOrCreateTVMModuleCacheDirectory(path, create))
+    return false;
+
+  path.append(settings.GetOptionValue(kNupharCacheModelChecksum));
+  if (!create && !fs::is_directory(path))
+    return false;
+
+  if (!fs::is_directory(path))
+    if (!fs::create_directory(path) && !fs::is_directory(path)) {
+      throw std::runtime_error("Failed to create directory " + path.string());
+    }
+
+  return true;
+}
+
+// the options changing the code generated for the same subgraph are part of the key of a cached func
+static std::string GetAutoCacheFileName(const std::string& func_name, const std::string& signature) {
+  codegen::CodeGenSettings& settings = codegen::CodeGenSettings::Instance();
+
+  std::string key = signature;
+  for (const char* option : {kNupharFastMath,
+                             kNupharFastActivation,
+                             kNupharForceNoTensorize,
+                             kNupharTensorize_IGEMM_Tile_M,
+                             kNupharTensorize_IGEMM_Tile_N,
+                             kNupharTensorize_IGEMM_Tile_K,
+                             kNupharTensorize_IGEMM_Permute,
+                             kNupharTensorize_IGEMM_Split_Last_Tile,
+                             kNupharIMatMulForceMkl,
+                             kNupharMatmulExec}) {
+    if (settings.HasOption(option))
+      key += std::string(";") + option + "=" + settings.GetOptionValue(option);
+  }
+
+  std::ostringstream file_name;
+  file_name << func_name << "_" << std::hex << std::hash<std::string>()(key) << ".ll";
+  return file_name.str();
+}
+
+CacheStatus LoadTVMPackedFuncFromAutoCache(const std::string& func_name,
+                                           const std::string& signature,
+                                           tvm::runtime::PackedFunc& func) {
+  codegen::CodeGenSettings& settings = codegen::CodeGenSettings::Instance();
+  if (!settings.OptionMatches(kNupharCacheAuto, "on") || !settings.HasOption(kNupharCachePath))
+    return CacheStatus::NotInUse;
+
+  fs::path path;
+  if (!GetOrCreateAutoCacheDirectory(path, /*create*/ false))
+    return settings.HasOption(kNupharCacheModelChecksum) ? CacheStatus::Missing : CacheStatus::NotInUse;
+
+  path.append(GetAutoCacheFileName(func_name, signature));
+  if (!fs::is_regular_file(path))
+    return CacheStatus::Missing;
+
+  try {
+    tvm::runtime::Module module = tvm::runtime::Module::LoadFromFile(path.string(), "ll");
+    func = module.GetFunction(func_name);
+  } catch (const std::exception& ex) {
+    LOGS_DEFAULT(WARNING) << "Failed to load " << path.string() << ", using JIT... " << ex.what();
+    return CacheStatus::Mismatch;
+  }
+
+  if (func == nullptr) {
+    LOGS_DEFAULT(CODEGEN_SETTINGS_LOG_LEVEL) << "Cannot find " << func_name << " in " << path.string()
+                                             << ", using JIT...";
+    return CacheStatus::Mismatch;
+  }
+  return CacheStatus::Found;
+}
+
+// writes a cache file under a temporary name and renames it, so another process never reads a partial file
+static void PublishCacheFile(const fs::path& path, const std::function<void(const std::string&)>& write_file) {
+  std::ostringstream tmp_name;
+  tmp_name << path.filename().string() << "." << Env::Default().GetSelfPid() << "."
+           << std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+  fs::path tmp_path = path.parent_path();
+  tmp_path.append(tmp_name.str());
+
+  std::error_code ec;
+  try {
+    write_file(tmp_path.string());
+  } catch (const std::exception& ex) {
+    LOGS_DEFAULT(WARNING) << "Failed to save " << path.string() << ": " << ex.what();
+    fs::remove(tmp_path, ec);
+    return;
+  }
+
+  // fails when another process published the same file in the meantime, its file is kept
+  fs::rename(tmp_path, path, ec);
+  if (ec)
+    fs::remove(tmp_path, ec);
+}
+
+void SaveTVMModuleToAutoCache(const std::string& func_name,
+                              const std::string& signature,
+                              tvm::runtime::Module& module) {
+  fs::path path;
+  if (!GetOrCreateAutoCacheDirectory(path, /*create*/ true))
+    return;
+
+  path.append(GetAutoCacheFileName(func_name, signature));
+  if (fs::exists(path))
+    return;
+
+  PublishCacheFile(path, [&module](const std::string& file_path) { module->SaveToFile(file_path, "ll"); });
+}
+
+static bool GetOrCreateWeightCacheDirectory(fs::path& path, bool create) {
+  if (!GetOrCreateTVMModuleCacheDirectory(path, create))
+    return false;
+
+  path.append("weights");
+  if (!create && !fs::is_directory(path))
+    return false;
+
+  if (!fs::is_directory(path))
+    if (!fs::create_directory(path) && !fs::is_directory(path)) {
+      throw std::runtime_error("Failed to create directory " + path.string());
+    }
+
+  return true;
+}
+
+// the file of a marshalled weight is named after its layout and a hash of the original weight, so the same weight
+// in several models, or several versions of a model, share it
+static std::string GetWeightCacheFileName(const std::string& layout_name, const Tensor& initializer) {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  const auto* bytes = static_cast<const uint8_t*>(initializer.DataRaw());
+  for (size_t i = 0; i < initializer.SizeInBytes(); ++i) {
+    hash = (hash ^ bytes[i]) * 1099511628211ULL;
+  }
+
+  std::ostringstream file_name;
+  file_name << layout_name << "_" << initializer.DataType()->Size();
+  for (auto dim : initializer.Shape().GetDims())
+    file_name << "x" << dim;
+  file_name << "_" << std::hex << hash;
+  return NormalizeCppName(file_name.str()) + ".bin";
+}
+
+void* LoadMarshalledWeightFromCache(const std::string& layout_name, const Tensor& initializer, size_t byte_size) {
+  fs::path path;
+  if (byte_size == 0 || !GetOrCreateWeightCacheDirectory(path, /*create*/ false))
+    return nullptr;
+
+  path.append(GetWeightCacheFileName(layout_name, initializer));
+  std::string file_path = path.string();
+
+  // the mappings live as long as the process, like the marshalled weights allocated by the sessions,
+  // and a weight loaded by several sessions is mapped once
+  static std::mutex mapped_weights_mutex;
+  static std::unordered_map<std::string, Env::MappedMemoryPtr> mapped_weights;
+  std::lock_guard<std::mutex> lock(mapped_weights_mutex);
+
+  auto iter = mapped_weights.find(file_path);
+  if (iter != mapped_weights.end())
+    return iter->second.get();
+
+  size_t file_size = 0;
+  if (!fs::is_regular_file(path) || !Env::Default().GetFileLength(path.c_str(), file_size).IsOK() ||
+      file_size != byte_size)
+    return nullptr;
+
+  Env::MappedMemoryPtr mapped_memory;
+  Status status = Env::Default().MapFileIntoMemory(path.c_str(), 0, byte_size, mapped_memory);
+  if (!status.IsOK()) {
+    LOGS_DEFAULT(WARNING) << "Failed to map " << file_path << ", marshalling the weight... " << status.ErrorMessage();
+    return nullptr;
+  }
+
+  void* data = mapped_memory.get();
+  mapped_weights.emplace(file_path, std::move(mapped_memory));
+  return data;
+}
+
+void SaveMarshalledWeightToCache(const std::string& layout_name,
+                                 const Tensor& initializer,
+                                 const void* data,
+                                 size_t byte_size) {
+  fs::path path;
+  if (byte_size == 0 || !GetOrCreateWeightCacheDirectory(path, /*create*/ true))
+    return;
+
+  path.append(GetWeightCacheFileName(layout_name, initializer));
+  if (fs::exists(path))
+    return;
+
+  PublishCacheFile(path, [data, byte_size](const std::string& file_path) {
+    std::ofstream file(file_path, std::ios::binary);
+    file.write(static_cast<const char*>(data), byte_size);
+    file.close();
+    if (!file)
+      throw std::runtime_error("Failed to write " + file_path);
+  });
+}
+
 std::string GetPackedFuncName(const nuphar::NupharSubgraphUnit& subgraph, const CodeGenTarget& codegen_target, int64_t parallel_min_workloads) {
   // in C, a function does not allow its name starting with a digit.
   return NormalizeCppName("_" + subgraph.UniqueId() + "_" + codegen_target.GetTargetName() + "_p" + std::to_string(parallel_min_workloads));
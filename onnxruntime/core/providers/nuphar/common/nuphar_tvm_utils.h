@@ -30,6 +30,27 @@ enum class CacheStatus {
 CacheStatus LoadTVMPackedFuncFromCache(const std::string& func_name, tvm::runtime::PackedFunc& func);
 void SaveTVMModuleToCache(const std::string& filename, tvm::runtime::Module& module);
 
+// Helper functions of the automatic cache (nuphar_cache_auto), which needs no offline step:
+// the module of each func built by JIT is saved as LLVM IR, one file per func and signature, i.e. the types and shapes
+// of its args, under the directory of the model checksum, so several models and processes can share a cache path.
+// A file is written under a temporary name and then renamed, so another process never loads a partial file.
+CacheStatus LoadTVMPackedFuncFromAutoCache(const std::string& func_name,
+                                           const std::string& signature,
+                                           tvm::runtime::PackedFunc& func);
+void SaveTVMModuleToAutoCache(const std::string& func_name,
+                              const std::string& signature,
+                              tvm::runtime::Module& module);
+
+// Helper functions of the cache of marshalled weights, in use with nuphar_cache_path:
+// a weight marshalled to a layout is saved to the weights directory of the cache, and later sessions, including those
+// of other processes, map the file instead of marshalling the weight again, sharing its pages.
+// LoadMarshalledWeightFromCache returns nullptr when the weight isn't cached.
+void* LoadMarshalledWeightFromCache(const std::string& layout_name, const Tensor& initializer, size_t byte_size);
+void SaveMarshalledWeightToCache(const std::string& layout_name,
+                                 const Tensor& initializer,
+                                 const void* data,
+                                 size_t byte_size);
+
 std::string GetPackedFuncName(const nuphar::NupharSubgraphUnit& subgraph, const CodeGenTarget& codegen_target, int64_t parallel_min_workloads);
 
 bool TryCreateConstantScalar(tvm::Expr& scalar, const Tensor* tensor);
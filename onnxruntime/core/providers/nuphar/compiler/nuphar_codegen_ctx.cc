@@ -13,6 +13,8 @@
 
 #include "core/providers/nuphar/common/nuphar_tvm_utils.h"
 
+#include <mutex>
+
 namespace onnxruntime {
 namespace nuphar {
 
@@ -82,22 +84,25 @@ static const Tensor* Marshalling(
     const tvm_codegen::WeightLayout* layout_ptr,
     WeightLayoutCtx& ctx_layout,
     AllocatorPtr allocator) {
-  tvm::runtime::PackedFunc packed_func;
+  // the subgraphs of a fused node, which share global_generated_initializers, may be compiled concurrently
+  static std::mutex marshalling_mutex;
+  std::lock_guard<std::mutex> lock(marshalling_mutex);
 
   const std::string& layout_key = layout_ptr->Name();
-  if (ctx_layout.weight_layout_to_packed_func.count(layout_key) == 0) {
-    packed_func = LowerLayoutFunc(layout_ptr);
-    ctx_layout.weight_layout_to_packed_func.insert(std::make_pair(layout_key, packed_func));
-  } else {
-    packed_func = ctx_layout.weight_layout_to_packed_func[layout_key];
-  }
 
   std::vector<int64_t> marshalled_shape = layout_ptr->ToActualShape(original_initializer);
   auto marshalled_size = TotalSize(marshalled_shape);
   auto byte_size = original_initializer->DataType()->Size();
+  size_t marshalled_bytes = SafeInt<size_t>(marshalled_size) * byte_size;
+
+  // a weight marshalled by a previous session is mapped from the cache, with no need of the layout func
+  void* p_data = LoadMarshalledWeightFromCache(layout_key, *original_initializer, marshalled_bytes);
+  const bool is_cached = (nullptr != p_data);
+  if (!is_cached) {
+    p_data = allocator->Alloc(marshalled_bytes);
+  }
 
   std::unique_ptr<Tensor> out_ptr;
-  void* p_data = allocator->Alloc(SafeInt<size_t>(marshalled_size) * byte_size);
   out_ptr = onnxruntime::make_unique<Tensor>(
       original_initializer->DataType(),
       TensorShape(marshalled_shape),
@@ -106,6 +111,18 @@ static const Tensor* Marshalling(
 
   global_generated_initializers.emplace(initializer_name, std::move(out_ptr));
 
+  if (is_cached) {
+    return global_generated_initializers.at(initializer_name).get();
+  }
+
+  tvm::runtime::PackedFunc packed_func;
+  if (ctx_layout.weight_layout_to_packed_func.count(layout_key) == 0) {
+    packed_func = LowerLayoutFunc(layout_ptr);
+    ctx_layout.weight_layout_to_packed_func.insert(std::make_pair(layout_key, packed_func));
+  } else {
+    packed_func = ctx_layout.weight_layout_to_packed_func[layout_key];
+  }
+
   int num_args = 2;
   DLContext tvm_ctx{kDLCPU, 0};
   std::vector<TVMValue> lvalues(num_args);
@@ -134,6 +151,7 @@ static const Tensor* Marshalling(
   tvm::TVMArgs tvm_args(lvalues.data(), types_code.data(), num_args);
   tvm::TVMRetValue rvalue;
   packed_func.CallPacked(tvm_args, &rvalue);
+  SaveMarshalledWeightToCache(layout_key, *original_initializer, p_data, marshalled_bytes);
   return global_generated_initializers.at(initializer_name).get();
 }
 
@@ -7,6 +7,7 @@
 #include "core/codegen/common/settings.h"
 #include "core/codegen/mti/mti_tvm_utils.h"
 #include "core/codegen/passes/utils/ort_tvm_utils.h"
+#include "core/common/safeint.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/providers/nuphar/common/analysis/subgraph_codegen_stats.h"
 #include "core/providers/nuphar/common/nuphar_settings.h"
@@ -14,6 +15,13 @@
 #include "core/providers/nuphar/compiler/nuphar_handle.h"
 #include "core/providers/nuphar/compiler/nuphar_op_ir_builder.h"
 #include "core/providers/nuphar/compiler/nuphar_schedule_builder.h"
+#include "core/providers/nuphar/compiler/nuphar_schedule_tuning.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <sstream>
 
 namespace onnxruntime {
 namespace nuphar {
@@ -153,43 +161,153 @@ tvm::runtime::PackedFunc NupharCompiler::GetLoweredPackedFunc(
   // In AOT, there should be another member func explicitly loading
   tvm::runtime::PackedFunc cached_func;
   auto cache_status = nuphar::LoadTVMPackedFuncFromCache(func_name, cached_func);
+  codegen::CodeGenSettings& settings = codegen::CodeGenSettings::Instance();
+
+  // the automatic cache and the tuning log key a func by its args as well,
+  // since the shapes of a subgraph may differ across runs
+  auto auto_cache_status = nuphar::CacheStatus::NotInUse;
+  std::ostringstream signature;
+  std::string tuning_key;
+  int vector_width_factor = 1;
+  bool tune = false;
   if (cache_status != nuphar::CacheStatus::Found) {
-    codegen::CodeGenSettings& settings = codegen::CodeGenSettings::Instance();
+    for (const auto& arg : tvm_args_)
+      signature << arg->dtype << arg->shape << ";";
+
+    std::ostringstream key;
+    if (settings.HasOption(kNupharCacheModelChecksum))
+      key << settings.GetOptionValue(kNupharCacheModelChecksum) << ":";
+    key << func_name << ":" << std::hex << std::hash<std::string>()(signature.str());
+    tuning_key = key.str();
+    tune = !nuphar::LookupTunedVectorWidthFactor(tuning_key, vector_width_factor) &&
+           nuphar::IsScheduleTuningEnabled() && HasStaticArgs();
+
+    if (vector_width_factor != 1)
+      signature << "vector_width_factor=" << vector_width_factor;
+    // a func cached without tuning isn't loaded when it is about to be tuned
+    if (!tune)
+      auto_cache_status = nuphar::LoadTVMPackedFuncFromAutoCache(func_name, signature.str(), cached_func);
+    if (auto_cache_status == nuphar::CacheStatus::Found)
+      cache_status = nuphar::CacheStatus::Found;
+  }
 
+  if (cache_status != nuphar::CacheStatus::Found) {
     if (settings.HasOption(kNupharCacheForceNoJIT)) {
       if (settings.OptionMatches(kNupharCacheForceNoJIT, "on")) {
         ORT_THROW("Force not using JIT code!");
       }
     }
 
-    tvm::Schedule tvm_schedule = CreateSchedule(tvm_outputs_, context_);
-    std::unordered_map<tvm::Tensor, tvm::Buffer> binds;
-    tvm::Array<tvm::LoweredFunc> lowered = tvm::lower(tvm_schedule, tvm_args_, func_name, binds, config);
-
-    if (settings.HasOption(codegen::CodeGenSettings::kCodeGenDumpLower)) {
-      if (settings.OptionMatches(codegen::CodeGenSettings::kCodeGenDumpLower, "verbose") ||
-          settings.OptionMatches(codegen::CodeGenSettings::kCodeGenDumpLower, subgraph_type)) {
-        for (const auto& func : lowered)
-          LOGS_DEFAULT(CODEGEN_SETTINGS_LOG_LEVEL) << "[CODEGEN_DUMP_LOWER] Dumping lowered func: " << func << std::endl
-                                                   << func->body;
-      } else if (settings.OptionMatches(codegen::CodeGenSettings::kCodeGenDumpLower, "concise")) {
-        LOGS_DEFAULT(CODEGEN_SETTINGS_LOG_LEVEL) << "[CODEGEN_DUMP_LOWER] Subgraph Type: "
-                                                 << subgraph_type << ", name: " << subgraph_name
-                                                 << " #lowered funcs: " << lowered.size() << std::endl;
+    auto build_module = [&](int factor) {
+      tvm::Schedule tvm_schedule = CreateSchedule(tvm_outputs_, context_, factor);
+      std::unordered_map<tvm::Tensor, tvm::Buffer> binds;
+      tvm::Array<tvm::LoweredFunc> lowered = tvm::lower(tvm_schedule, tvm_args_, func_name, binds, config);
+
+      if (settings.HasOption(codegen::CodeGenSettings::kCodeGenDumpLower)) {
+        if (settings.OptionMatches(codegen::CodeGenSettings::kCodeGenDumpLower, "verbose") ||
+            settings.OptionMatches(codegen::CodeGenSettings::kCodeGenDumpLower, subgraph_type)) {
+          for (const auto& func : lowered)
+            LOGS_DEFAULT(CODEGEN_SETTINGS_LOG_LEVEL) << "[CODEGEN_DUMP_LOWER] Dumping lowered func: " << func
+                                                     << std::endl
+                                                     << func->body;
+        } else if (settings.OptionMatches(codegen::CodeGenSettings::kCodeGenDumpLower, "concise")) {
+          LOGS_DEFAULT(CODEGEN_SETTINGS_LOG_LEVEL) << "[CODEGEN_DUMP_LOWER] Subgraph Type: "
+                                                   << subgraph_type << ", name: " << subgraph_name
+                                                   << " #lowered funcs: " << lowered.size() << std::endl;
+        }
       }
+
+      return tvm::build(lowered, tvm_target, tvm_host_target, config);
+    };
+
+    tvm::runtime::Module module;
+    if (tune) {
+      // each candidate is built and timed, and the fastest one is kept and logged
+      double best_time_us = std::numeric_limits<double>::max();
+      for (int candidate : nuphar::GetVectorWidthFactorCandidates()) {
+        tvm::runtime::Module candidate_module = build_module(candidate);
+        double time_us = MeasureLoweredFunc(candidate_module.GetFunction(func_name));
+        if (time_us < best_time_us) {
+          best_time_us = time_us;
+          vector_width_factor = candidate;
+          module = candidate_module;
+        }
+      }
+      nuphar::RecordTunedVectorWidthFactor(tuning_key, vector_width_factor, best_time_us);
+    } else {
+      module = build_module(vector_width_factor);
     }
 
-    tvm::runtime::Module module = tvm::build(lowered, tvm_target, tvm_host_target, config);
     tvm_codegen::DumpTVMModuleToFile(func_name, module);
     if (cache_status == nuphar::CacheStatus::Missing) {
       nuphar::SaveTVMModuleToCache(func_name, module);
     }
+    if (auto_cache_status == nuphar::CacheStatus::Missing) {
+      nuphar::SaveTVMModuleToAutoCache(func_name, signature.str(), module);
+    }
     cached_func = module.GetFunction(func_name);
   }
 
   return cached_func;
 }
 
+bool NupharCompiler::HasStaticArgs() const {
+  for (const auto& arg : tvm_args_) {
+    for (const auto& dim : arg->shape) {
+      if (nullptr == tvm::as_const_int(dim))
+        return false;
+    }
+  }
+  return true;
+}
+
+// the number of calls timed for each candidate, after a warm-up call
+constexpr int kTuningRuns = 10;
+
+double NupharCompiler::MeasureLoweredFunc(const tvm::runtime::PackedFunc& func) {
+  const size_t num_args = tvm_args_.size();
+  std::vector<std::vector<int64_t>> shapes(num_args);
+  std::vector<IAllocatorUniquePtr<void>> buffers;
+  std::vector<DLTensor> tvm_tensors(num_args);
+  std::vector<TVMValue> lvalues(num_args);
+  DLContext tvm_ctx{kDLCPU, 0};
+
+  // the args are filled with zeros, the data doesn't change the time of the funcs
+  for (size_t i = 0; i < num_args; ++i) {
+    const tvm::Tensor& arg = tvm_args_[i];
+    size_t num_bytes = (arg->dtype.bits() * arg->dtype.lanes() + 7) / 8;
+    for (const auto& dim : arg->shape) {
+      shapes[i].push_back(*tvm::as_const_int(dim));
+      num_bytes = SafeInt<size_t>(num_bytes) * shapes[i].back();
+    }
+    if (shapes[i].empty())
+      shapes[i].push_back(1);
+
+    buffers.push_back(context_.Allocate(std::max<size_t>(num_bytes, 1)));
+    memset(buffers.back().get(), 0, num_bytes);
+
+    DLDataType tvm_dtype{static_cast<uint8_t>(arg->dtype.code()),
+                         static_cast<uint8_t>(arg->dtype.bits()),
+                         static_cast<uint16_t>(arg->dtype.lanes())};
+    tvm_tensors[i] = {buffers.back().get(), tvm_ctx,
+                      gsl::narrow_cast<int>(shapes[i].size()), tvm_dtype,
+                      shapes[i].data(), nullptr, 0};
+    lvalues[i].v_handle = &(tvm_tensors[i]);
+  }
+
+  auto types_code = std::vector<int>(num_args, kNDArrayContainer);
+  tvm::TVMArgs tvm_args(lvalues.data(), types_code.data(), gsl::narrow_cast<int>(num_args));
+  tvm::TVMRetValue rvalue;
+  func.CallPacked(tvm_args, &rvalue);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int run = 0; run < kTuningRuns; ++run) {
+    func.CallPacked(tvm_args, &rvalue);
+  }
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / kTuningRuns;
+}
+
 static tvm::BuildConfig CreateConfig(const Node& node,
                                      bool allow_unaligned_buffers) {
   tvm::BuildConfig config = tvm::build_config();
@@ -211,20 +329,35 @@ Status NupharCompiler::Lower(const nuphar::NupharSubgraphUnit& subgraph,
                              tvm::Target tvm_host_target,
                              NupharFuncInfo* func_info,
                              nuphar::OrtSubgraphAllocationInfo* partition_info) {
+  ORT_RETURN_IF_ERROR(LowerFunc(subgraph, tvm_target, tvm_host_target));
+  return FillFuncInfo(subgraph, tvm_target, func_info, partition_info);
+}
+
+Status NupharCompiler::LowerFunc(const nuphar::NupharSubgraphUnit& subgraph,
+                                 tvm::Target tvm_target,
+                                 tvm::Target tvm_host_target) {
   const auto& codegen_handle = context_.GetCodeGenHandle();
   const auto& target_codegen = *codegen_handle->codegen_target;
-  std::string func_name = nuphar::GetPackedFuncName(subgraph, target_codegen, codegen_handle->parallel_min_workloads);
+  func_name_ = nuphar::GetPackedFuncName(subgraph, target_codegen, codegen_handle->parallel_min_workloads);
   tvm::BuildConfig config = CreateConfig(*subgraph.nodes.front(),
                                          context_.GetCodeGenHandle()->allow_unaligned_buffers);
 
   // using "subgraph" for type and name for now
   // TODO: change name
-  tvm::runtime::PackedFunc cached_func =
+  lowered_func_ =
       GetLoweredPackedFunc(
-          func_name, tvm_target, tvm_host_target,
+          func_name_, tvm_target, tvm_host_target,
           config, "subgraph", "subgraph");
 
-  FillNupharFuncInfo(func_info, partition_info, subgraph, context_, tvm_target, cached_func, func_name);
+  return Status::OK();
+}
+
+Status NupharCompiler::FillFuncInfo(const nuphar::NupharSubgraphUnit& subgraph,
+                                    tvm::Target tvm_target,
+                                    NupharFuncInfo* func_info,
+                                    nuphar::OrtSubgraphAllocationInfo* partition_info) {
+  ORT_ENFORCE(lowered_func_ != nullptr, "LowerFunc must be called before FillFuncInfo");
+  FillNupharFuncInfo(func_info, partition_info, subgraph, context_, tvm_target, lowered_func_, func_name_);
 
   return Status::OK();
 }
@@ -41,6 +41,18 @@ class NupharCompiler {
                NupharFuncInfo* ctx_func,
                nuphar::OrtSubgraphAllocationInfo* partition_info);
 
+  // Lower in two steps, so the subgraphs of a fused node can be compiled concurrently:
+  // LowerFunc lowers the built tvm IR to llvm ir and compiles it, FillFuncInfo then fills ctx_func with the compiled
+  // func and its allocations in partition_info, which is shared by the subgraphs.
+  Status LowerFunc(const nuphar::NupharSubgraphUnit& subgraph,
+                   tvm::Target tvm_target,
+                   tvm::Target tvm_host_target);
+
+  Status FillFuncInfo(const nuphar::NupharSubgraphUnit& subgraph,
+                      tvm::Target tvm_target,
+                      NupharFuncInfo* ctx_func,
+                      nuphar::OrtSubgraphAllocationInfo* partition_info);
+
   tvm::runtime::PackedFunc GetLoweredPackedFunc(
       const std::string& func_name,
       tvm::Target tvm_target,
@@ -55,10 +67,20 @@ class NupharCompiler {
   // BuildSubgraph builds tvm IR and apply passes for a subgraph
   Status BuildSubgraph(const Node& node);
 
+  // whether the shapes of all args are known at compile time, which tuning needs to time the func
+  bool HasStaticArgs() const;
+
+  // returns the average time in us of a call of func, built from the args, on zero-filled args
+  double MeasureLoweredFunc(const tvm::runtime::PackedFunc& func);
+
   NupharCodeGenCtx context_;
 
   tvm::Array<tvm::Tensor> tvm_args_;
   tvm::Array<tvm::Tensor> tvm_outputs_;
+
+  // the result of LowerFunc
+  std::string func_name_;
+  tvm::runtime::PackedFunc lowered_func_;
 };
 
 }  // namespace nuphar
@@ -56,7 +56,8 @@ static void Traverse(const tvm::Tensor& tensor,
 }
 
 tvm::Schedule CreateSchedule(const tvm::Array<tvm::Tensor>& outs,
-                             NupharCodeGenCtx& ctx_codegen) {
+                             NupharCodeGenCtx& ctx_codegen,
+                             int vector_width_factor) {
   // Create scheudule object
   tvm::Array<tvm::Operation> out_ops;
   for (auto& t : outs) {
@@ -67,6 +68,7 @@ tvm::Schedule CreateSchedule(const tvm::Array<tvm::Tensor>& outs,
     ctx_codegen.GetCodeGenHandle()->schedule_builder->DumpAllSchedulers();
 
   tvm_codegen::ScheduleContext ctx_schedule(out_ops);
+  ctx_schedule.vector_width_factor = vector_width_factor;
 
   // Schedule all outputs
   for (const auto& t : outs) {
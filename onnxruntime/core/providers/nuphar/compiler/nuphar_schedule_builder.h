@@ -13,8 +13,10 @@ namespace nuphar {
 
 // Traverse iterates tvm::Array<tvm::Tensor> a single node
 // and builds the whole schedule (in CodeGenContext)
+// vector_width_factor multiplies the natural vector width, see nuphar_schedule_tuning.h
 tvm::Schedule CreateSchedule(const tvm::Array<tvm::Tensor>& outs,
-                             NupharCodeGenCtx& ctx_codegen);
+                             NupharCodeGenCtx& ctx_codegen,
+                             int vector_width_factor = 1);
 
 }  // namespace nuphar
 }  // namespace onnxruntime
@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/nuphar/compiler/nuphar_schedule_tuning.h"
+
+#include "core/codegen/common/settings.h"
+#include "core/common/logging/logging.h"
+#include "core/providers/nuphar/common/nuphar_settings.h"
+
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace onnxruntime {
+namespace nuphar {
+
+namespace {
+
+// the tuning log of the process, loaded on first use
+struct TuningLog {
+  std::mutex mutex;
+  std::string path;
+  std::unordered_map<std::string, std::pair<int, double>> entries;  // key to factor and time
+
+  // loads the log of the current settings, if it isn't the one loaded, and returns false when none is in use
+  bool Load() {
+    codegen::CodeGenSettings& settings = codegen::CodeGenSettings::Instance();
+    if (!settings.HasOption(kNupharTuningLog))
+      return false;
+
+    const std::string& log_path = settings.GetOptionValue(kNupharTuningLog);
+    if (log_path == path)
+      return true;
+
+    path = log_path;
+    entries.clear();
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+      std::istringstream fields(line);
+      std::string key;
+      int factor;
+      double time_us;
+      if (!(fields >> key >> factor >> time_us) || factor <= 0) {
+        LOGS_DEFAULT(WARNING) << "Skipping invalid line of tuning log " << path << ": " << line;
+        continue;
+      }
+      // a func tuned several times, e.g. by concurrent processes, keeps its fastest factor
+      auto iter = entries.find(key);
+      if (iter == entries.end() || iter->second.second > time_us)
+        entries[key] = std::make_pair(factor, time_us);
+    }
+    return true;
+  }
+};
+
+TuningLog& GetTuningLog() {
+  static TuningLog log;
+  return log;
+}
+
+}  // namespace
+
+const std::vector<int>& GetVectorWidthFactorCandidates() {
+  static const std::vector<int> candidates = {1, 2, 4};
+  return candidates;
+}
+
+bool IsScheduleTuningEnabled() {
+  codegen::CodeGenSettings& settings = codegen::CodeGenSettings::Instance();
+  return settings.OptionMatches(kNupharTuning, "on") && settings.HasOption(kNupharTuningLog);
+}
+
+bool LookupTunedVectorWidthFactor(const std::string& key, int& factor) {
+  TuningLog& log = GetTuningLog();
+  std::lock_guard<std::mutex> lock(log.mutex);
+  if (!log.Load())
+    return false;
+
+  auto iter = log.entries.find(key);
+  if (iter == log.entries.end())
+    return false;
+
+  factor = iter->second.first;
+  return true;
+}
+
+void RecordTunedVectorWidthFactor(const std::string& key, int factor, double time_us) {
+  TuningLog& log = GetTuningLog();
+  std::lock_guard<std::mutex> lock(log.mutex);
+  if (!log.Load())
+    return;
+
+  log.entries[key] = std::make_pair(factor, time_us);
+  std::ofstream file(log.path, std::ios::app);
+  file << key << " " << factor << " " << time_us << std::endl;
+  if (!file)
+    LOGS_DEFAULT(WARNING) << "Failed to append to tuning log " << log.path;
+}
+
+}  // namespace nuphar
+}  // namespace onnxruntime
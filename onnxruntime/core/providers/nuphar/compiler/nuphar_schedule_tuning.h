@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace onnxruntime {
+namespace nuphar {
+
+// Tuning of the rule-based schedules.
+// The rule-based schedules vectorize with the natural vector width of the target, while the best width of a subgraph
+// depends on the microarchitecture running it. With nuphar_tuning on, a func missing from the tuning log
+// (nuphar_tuning_log) is compiled with each candidate factor of the vector width and timed on its shapes, and the
+// fastest factor is appended to the log as a line "<key> <factor> <time in us>".
+// Later compiles reuse the factors of the log, and funcs missing from it keep the rule-based schedules.
+
+// The candidate factors, the first one being the rule-based schedule
+const std::vector<int>& GetVectorWidthFactorCandidates();
+
+// Whether funcs missing from the tuning log are tuned
+bool IsScheduleTuningEnabled();
+
+// Returns false when no tuning log is in use, or the log has no factor for key
+bool LookupTunedVectorWidthFactor(const std::string& key, int& factor);
+
+void RecordTunedVectorWidthFactor(const std::string& key, int factor, double time_us);
+
+}  // namespace nuphar
+}  // namespace onnxruntime
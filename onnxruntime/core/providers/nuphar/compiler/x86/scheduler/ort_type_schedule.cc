@@ -89,7 +89,7 @@ bool TryVectorizationX86(
 
   CodeGenTargetX86* target = dynamic_cast<CodeGenTargetX86*>(ctx_codegen.GetCodeGenHandle()->codegen_target);
   ORT_ENFORCE(target != nullptr);
-  int64_t natural_vector_size = target->NaturalVectorWidth(tensor->dtype.bits());
+  int64_t natural_vector_size = target->NaturalVectorWidth(tensor->dtype.bits()) * ctx_sched.vector_width_factor;
 
   // try to use parallel schedule when vectorizing
   // note that we don't do logic-or in return value here
@@ -8,11 +8,14 @@
 #include "core/framework/tensorprotoutils.h"
 #include "core/providers/nuphar/common/analysis/subgraph_codegen_stats.h"
 #include "core/providers/nuphar/compiler/initializer_info.h"
+#include "core/providers/nuphar/compiler/nuphar_schedule_tuning.h"
 #include "core/providers/nuphar/nuphar_execution_provider.h"
 #include "core/providers/nuphar/partition/subgraph_partitioner.h"
 #include "core/providers/nuphar/runtime/sequential/basic.h"
 #include "core/providers/nuphar/runtime/sequential/loop.h"
 
+#include <exception>
+
 namespace onnxruntime {
 namespace nuphar {
 
@@ -35,8 +38,42 @@ NupharKernelState::NupharKernelState(
       subgraphs,
       [&](const std::string& name) { return provider_.GetConstantInitializer(name); });
 
-  for (auto& subgraph : subgraphs) {
-    Compile(subgraph);
+  // the subgraphs are compiled concurrently, then their func infos are filled in order,
+  // as they share the allocations of partition_info_
+  std::vector<std::unique_ptr<NupharCompiler>> compilers(subgraphs.size());
+  std::vector<Status> statuses(subgraphs.size());
+  std::vector<std::exception_ptr> exceptions(subgraphs.size());
+  auto compile = [&](int32_t idx) {
+    try {
+      statuses[idx] = Compile(subgraphs[idx], compilers[idx]);
+    } catch (...) {
+      exceptions[idx] = std::current_exception();
+    }
+  };
+
+  // tuning times the subgraphs as they are compiled, so they are compiled sequentially not to disturb each other
+  concurrency::ThreadPool* thread_pool = provider_.GetCompileThreadPool();
+  if (thread_pool != nullptr && subgraphs.size() > 1 && !IsScheduleTuningEnabled()) {
+    thread_pool->ParallelFor(gsl::narrow<int32_t>(subgraphs.size()), compile);
+  } else {
+    for (int32_t idx = 0; idx < gsl::narrow<int32_t>(subgraphs.size()); ++idx) {
+      compile(idx);
+    }
+  }
+
+  for (size_t idx = 0; idx < subgraphs.size(); ++idx) {
+    if (exceptions[idx]) {
+      std::rethrow_exception(exceptions[idx]);
+    }
+    codegen_status_ = statuses[idx];
+    if (!codegen_status_.IsOK()) {
+      return;  // early return
+    }
+    func_infos_.emplace_back(onnxruntime::make_unique<NupharFuncInfo>());
+    codegen_status_ = compilers[idx]->FillFuncInfo(subgraphs[idx],
+                                                   provider_.GetTVMTarget(),
+                                                   func_infos_.back().get(),
+                                                   partition_info_.get());
     if (!codegen_status_.IsOK()) {
       return;  // early return
     }
@@ -47,24 +84,20 @@ NupharKernelState::NupharKernelState(
   BuildExecBlocksAndCalls(subgraphs);
 }
 
-void NupharKernelState::Compile(const NupharSubgraphUnit& subgraph) {
+Status NupharKernelState::Compile(const NupharSubgraphUnit& subgraph, std::unique_ptr<NupharCompiler>& compiler) {
+  CODEGEN_PROFILER_EVENT("compile_" + subgraph.UniqueId());
+
   // TODO: rename tvm_target to a proper name
   auto tvm_target = provider_.GetTVMTarget();
 
-  NupharCompiler tvm_compiler(subgraph,
-                              generated_initailizers_,
-                              provider_.GetNupharCodeGenHandle());
+  compiler = onnxruntime::make_unique<NupharCompiler>(subgraph,
+                                                      generated_initailizers_,
+                                                      provider_.GetNupharCodeGenHandle());
 
-  codegen_status_ = tvm_compiler.Build(subgraph);
-
-  if (codegen_status_.IsOK()) {
-    func_infos_.emplace_back(onnxruntime::make_unique<NupharFuncInfo>());
-    codegen_status_ = tvm_compiler.Lower(subgraph,
-                                         tvm_target,
-                                         provider_.GetTVMHostTarget(),
-                                         func_infos_.back().get(),
-                                         partition_info_.get());
-  }
+  ORT_RETURN_IF_ERROR(compiler->Build(subgraph));
+  return compiler->LowerFunc(subgraph,
+                             tvm_target,
+                             provider_.GetTVMHostTarget());
 }
 
 void NupharKernelState::BuildExecBlocksAndCalls(const std::vector<NupharSubgraphUnit>& subgraphs) {
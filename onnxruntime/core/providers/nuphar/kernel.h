@@ -38,7 +38,8 @@ class NupharKernelState {
 
   Status Compute(OpKernelContext* op_kernel_context) const;
 
-  void Compile(const NupharSubgraphUnit& subgraph);
+  // builds and lowers a subgraph, may run concurrently for the subgraphs of the fused node
+  Status Compile(const NupharSubgraphUnit& subgraph, std::unique_ptr<NupharCompiler>& compiler);
 
   void BuildExecBlocksAndCalls(const std::vector<NupharSubgraphUnit>& subgraphs);
 
@@ -15,6 +15,7 @@
 #include "core/providers/nuphar/kernel.h"
 #include "core/providers/nuphar/partition/graph_partitioner.h"
 #include "core/framework/onnxruntime_typeinfo.h"
+#include "core/util/thread_utils.h"
 
 #include <tvm/runtime/device_api.h>  // TODO remove this after removing tvm::runtime
 
@@ -139,6 +140,12 @@ NupharExecutionProvider::NupharExecutionProvider(const NupharExecutionProviderIn
   runtime_handle_->allocator = GetAllocator(tvm_ctx_.device_id, OrtMemTypeDefault);
   runtime_handle_->allow_unaligned_buffers = info.allow_unaligned_buffers;
   runtime_handle_->enable_model_parallelism = false;
+
+  int compile_threads = 0;
+  if (settings.HasOption(kNupharCompileThreads)) {
+    compile_threads = std::stoi(settings.GetOptionValue(kNupharCompileThreads));
+  }
+  compile_thread_pool_ = concurrency::CreateThreadPool("nuphar_compile_thread_pool", compile_threads);
 }
 
 void NupharExecutionProvider::CreateTVMTarget() {
@@ -7,6 +7,7 @@
 #include "core/framework/allocatormgr.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/kernel_registry.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/nuphar/common/analysis/graph_stats.h"
 #include "core/providers/nuphar/compiler/codegen_manager.h"
 #include "core/providers/nuphar/compiler/traverse_shape_infer.h"
@@ -64,7 +65,7 @@ class NupharExecutionProvider : public IExecutionProvider {
     return nullptr;
   }
 
-  Status OnRunStart() override {
+  Status OnRunStart(const RunOptions& /*run_options*/) override {
     if (tls_realized_dims_ != nullptr) {
       // at frame start, reset realized_dims since new execution frame may have different dynamic value
       for (auto& pair : *(tls_realized_dims_.get())) {
@@ -111,6 +112,11 @@ class NupharExecutionProvider : public IExecutionProvider {
     return domain_versions_[name];
   }
 
+  // the pool compiling the subgraphs of a fused node concurrently, nullptr to compile them sequentially
+  concurrency::ThreadPool* GetCompileThreadPool() const {
+    return compile_thread_pool_.get();
+  }
+
   const Tensor* GetConstantInitializer(const std::string& name) const {
     auto iter = constant_initializers_used_in_compiled_nodes_.find(name);
     if (iter == constant_initializers_used_in_compiled_nodes_.end())
@@ -149,6 +155,8 @@ class NupharExecutionProvider : public IExecutionProvider {
 
   std::unique_ptr<nuphar::NupharRuntimeHandle> runtime_handle_;
 
+  std::unique_ptr<concurrency::ThreadPool> compile_thread_pool_;
+
   mutable std::shared_ptr<KernelRegistry> kernel_registry_;
 
   mutable std::unordered_map<std::string, std::unique_ptr<Tensor>> constant_initializers_used_in_compiled_nodes_;
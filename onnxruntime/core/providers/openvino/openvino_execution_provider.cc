@@ -640,7 +640,8 @@ common::Status OpenVINOExecutionProvider::Compile(
   for (auto fused_node : fused_nodes) {
     std::shared_ptr<openvino_ep::OpenVINOGraph> openvino_graph;
     try {
-      openvino_graph = std::make_shared<openvino_ep::OpenVINOGraph>(fused_node);
+      openvino_graph = std::make_shared<openvino_ep::OpenVINOGraph>(fused_node, info_.num_streams,
+                                                                    info_.blob_cache_dir);
 
     } catch (const char* msg) {
       LOGS_DEFAULT(ERROR) << openvino_ep::OpenVINOGraph::log_tag << "Compilation error: " << msg;
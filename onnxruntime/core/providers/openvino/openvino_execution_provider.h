@@ -17,6 +17,10 @@ constexpr const char* OPENVINO = "OpenVINO";
 // Information needed to construct OpenVINO execution providers.
 struct OpenVINOExecutionProviderInfo {
   const char* device{"CPU_FP32"};
+  // throughput streams of the device, 0 for the default of the plugin
+  size_t num_streams{0};
+  // directory of the exported compiled networks, no cache if empty
+  std::string blob_cache_dir;
 
   explicit OpenVINOExecutionProviderInfo(const char* dev) : device(dev) {
   }
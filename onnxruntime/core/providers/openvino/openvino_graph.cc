@@ -1,9 +1,11 @@
 // Copyright(C) 2019 Intel Corporation
 // Licensed under the MIT License
 
+#include <algorithm>
 #include <iostream>
 #include <cstdlib>
 #include <map>
+#include <sstream>
 #include <string>
 #include <memory>
 #include <cstdlib>
@@ -35,7 +37,8 @@ const std::string OpenVINOGraph::log_tag = "[OpenVINO-EP] ";
 
 InferenceEngine::Core ie;
 
-OpenVINOGraph::OpenVINOGraph(const onnxruntime::Node* fused_node) {
+OpenVINOGraph::OpenVINOGraph(const onnxruntime::Node* fused_node, size_t num_streams,
+                             const std::string& blob_cache_dir) {
   device_id_ = "CPU";
   precision_ = InferenceEngine::Precision::FP32;
   std::string precision_str = "FP32";
@@ -125,15 +128,28 @@ OpenVINOGraph::OpenVINOGraph(const onnxruntime::Node* fused_node) {
   GetExecutableHandle(openvino_network_);
 
   //Loading model to the plugin
-  auto exeNetwork = ie.LoadNetwork(*openvino_network_, device_id_);
+  auto exeNetwork = LoadExecutableNetwork(GetDeviceConfig(num_streams), blob_cache_dir);
 
   LOGS_DEFAULT(INFO) << log_tag << "Network loaded into accelerator plug-in succesfully";
 
+  // With throughput streams, one infer request per stream at least, or as many as the plugin needs to keep its
+  // streams busy
+  if (num_streams > 0) {
+    num_inf_reqs_ = std::max(num_inf_reqs_, num_streams);
+    try {
+      size_t optimal_num_inf_reqs =
+          exeNetwork.GetMetric(METRIC_KEY(OPTIMAL_NUMBER_OF_INFER_REQUESTS)).as<unsigned int>();
+      num_inf_reqs_ = std::max(num_inf_reqs_, optimal_num_inf_reqs);
+    } catch (const std::exception& ex) {
+      LOGS_DEFAULT(INFO) << log_tag << "No optimal number of infer requests: " << ex.what();
+    }
+  }
+
   //Create infer request
   for (size_t i = 0; i < num_inf_reqs_; i++) {
     auto infRequest = exeNetwork.CreateInferRequestPtr();
 
-    infer_requests_.push_back(infRequest);
+    idle_infer_requests_.push_back(infRequest);
   }
   LOGS_DEFAULT(INFO) << log_tag << "Infer requests created: " << num_inf_reqs_;
 }
@@ -316,6 +332,87 @@ void OpenVINOGraph::GetExecutableHandle(
   }
 }
 
+std::map<std::string, std::string> OpenVINOGraph::GetDeviceConfig(size_t num_streams) const {
+  std::map<std::string, std::string> config;
+  if (num_streams == 0) {
+    return config;
+  }
+  if (device_id_ == "CPU") {
+    config[CONFIG_KEY(CPU_THROUGHPUT_STREAMS)] = std::to_string(num_streams);
+  } else if (device_id_ == "GPU") {
+    config[CONFIG_KEY(GPU_THROUGHPUT_STREAMS)] = std::to_string(num_streams);
+  }
+  // MYRIAD and HDDL have no streams, they run the infer requests in parallel on their devices
+  return config;
+}
+
+// Compiles the network for the device. With a blob cache directory, the compiled network is imported from the
+// directory if an earlier session exported it, and exported to it otherwise. The blob is named after a hash of the
+// IR, the device and its config, so a model changed or compiled with other options isn't mistaken for it.
+InferenceEngine::ExecutableNetwork OpenVINOGraph::LoadExecutableNetwork(
+    const std::map<std::string, std::string>& config, const std::string& blob_cache_dir) {
+  if (blob_cache_dir.empty()) {
+    return ie.LoadNetwork(*openvino_network_, device_id_, config);
+  }
+
+  const auto& attributes = fused_node_->GetAttributes();
+  std::hash<std::string> hasher;
+  size_t hash = 0;
+  auto combine = [&hash, &hasher](const std::string& value) {
+    hash ^= hasher(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  };
+  combine(attributes.at("xml_str").s());
+  combine(attributes.at("weights_str").s());
+  combine(device_id_);
+  for (const auto& entry : config) {
+    combine(entry.first);
+    combine(entry.second);
+  }
+  std::ostringstream blob_path;
+  blob_path << blob_cache_dir << "/openvino_" << std::hex << hash << ".blob";
+
+  if (std::ifstream(blob_path.str()).good()) {
+    try {
+      auto exeNetwork = ie.ImportNetwork(blob_path.str(), device_id_, config);
+      LOGS_DEFAULT(INFO) << log_tag << "Network imported from " << blob_path.str();
+      return exeNetwork;
+    } catch (const std::exception& ex) {
+      LOGS_DEFAULT(WARNING) << log_tag << "Compiling the network again, import of " << blob_path.str()
+                            << " failed: " << ex.what();
+    }
+  }
+
+  auto exeNetwork = ie.LoadNetwork(*openvino_network_, device_id_, config);
+  try {
+    exeNetwork.Export(blob_path.str());
+    LOGS_DEFAULT(INFO) << log_tag << "Network exported to " << blob_path.str();
+  } catch (const std::exception& ex) {
+    // e.g. the plugin can't export its networks
+    LOGS_DEFAULT(INFO) << log_tag << "Network not exported: " << ex.what();
+  }
+  return exeNetwork;
+}
+
+// Checks out count idle infer requests, waiting for the concurrent Infers to return theirs if needed.
+// count is at most num_inf_reqs_, so the wait ends once the Infers running return their requests.
+std::vector<InferenceEngine::InferRequest::Ptr> OpenVINOGraph::AcquireInferRequests(size_t count) {
+  std::unique_lock<std::mutex> lock(infer_requests_lock_);
+  infer_requests_cv_.wait(lock, [this, count]() { return idle_infer_requests_.size() >= count; });
+  std::vector<InferenceEngine::InferRequest::Ptr> infer_requests(idle_infer_requests_.end() - count,
+                                                                 idle_infer_requests_.end());
+  idle_infer_requests_.resize(idle_infer_requests_.size() - count);
+  return infer_requests;
+}
+
+void OpenVINOGraph::ReleaseInferRequests(std::vector<InferenceEngine::InferRequest::Ptr>& infer_requests) {
+  {
+    std::lock_guard<std::mutex> lock(infer_requests_lock_);
+    idle_infer_requests_.insert(idle_infer_requests_.end(), infer_requests.begin(), infer_requests.end());
+  }
+  infer_requests.clear();
+  infer_requests_cv_.notify_all();
+}
+
 size_t OpenVINOGraph::DeduceBatchSize(Ort::CustomOpApi ort, const OrtValue* input_tensor,
                                       InferenceEngine::SizeVector graph_dims) {
   size_t batch_size = 1;
@@ -334,11 +431,10 @@ size_t OpenVINOGraph::DeduceBatchSize(Ort::CustomOpApi ort, const OrtValue* inpu
 }
 
 // Starts an asynchronous inference request for data in slice indexed by batch_slice_idx on
-// an Infer Request indexed by infer_req_idx
+// an Infer Request
 void OpenVINOGraph::StartAsyncInference(Ort::CustomOpApi ort, std::vector<const OrtValue*> input_tensors,
                                         size_t batch_slice_idx,
-                                        size_t infer_req_idx) {
-  auto infer_request = infer_requests_[infer_req_idx];
+                                        InferenceEngine::InferRequest::Ptr infer_request) {
   auto graph_input_info = openvino_network_->getInputsInfo();
 
   size_t i = 0;
@@ -361,13 +457,11 @@ void OpenVINOGraph::StartAsyncInference(Ort::CustomOpApi ort, std::vector<const
   infer_request->StartAsync();
 }
 
-// Wait for asynchronous inference completion on an Infer Request object indexed by infer_req_idx
+// Wait for asynchronous inference completion on an Infer Request object
 // and copy the results into a slice location within the batched output buffer indexed by batch_slice_idx
 void OpenVINOGraph::CompleteAsyncInference(Ort::CustomOpApi ort, std::vector<OrtValue*> output_tensors,
                                            size_t batch_slice_idx,
-                                           size_t infer_req_idx) {
-  auto infer_request = infer_requests_[infer_req_idx];
-
+                                           InferenceEngine::InferRequest::Ptr infer_request) {
   // Wait for Async inference completion
   infer_request->Wait(InferenceEngine::IInferRequest::WaitMode::RESULT_READY);
   auto graph_output_info = openvino_network_->getOutputsInfo();
@@ -399,13 +493,14 @@ std::vector<const OrtValue*> OpenVINOGraph::GetInputTensors(Ort::CustomOpApi ort
   return input_tensors;
 }
 
-std::vector<OrtValue*> OpenVINOGraph::GetOutputTensors(Ort::CustomOpApi ort, OrtKernelContext* context, size_t batch_size) {
+std::vector<OrtValue*> OpenVINOGraph::GetOutputTensors(Ort::CustomOpApi ort, OrtKernelContext* context,
+                                                       size_t batch_size,
+                                                       InferenceEngine::InferRequest::Ptr infer_request) {
   std::vector<OrtValue*> output_tensors;
   auto graph_output_info = openvino_network_->getOutputsInfo();
 
   // All infer_requests process identical tensor slices from the batch.
-  // So using info from first infer_request to allocate all output tensors.
-  auto infer_request = infer_requests_[0];
+  // So using info from any infer_request to allocate all output tensors.
 
   size_t i = 0;
   for (auto output_info_iter = graph_output_info.begin();
@@ -431,10 +526,6 @@ std::vector<OrtValue*> OpenVINOGraph::GetOutputTensors(Ort::CustomOpApi ort, Ort
 }
 
 void OpenVINOGraph::Infer(Ort::CustomOpApi ort, OrtKernelContext* context) {
-  // Preliminary Thread safety mechanism
-  // Currently allows only one Infer execution at a time
-  std::lock_guard<std::mutex> lock(compute_lock_);
-
   LOGS_DEFAULT(INFO) << log_tag << "Starting inference";
 
   auto input_tensors = GetInputTensors(ort, context);
@@ -443,35 +534,46 @@ void OpenVINOGraph::Infer(Ort::CustomOpApi ort, OrtKernelContext* context) {
   auto batch_size = DeduceBatchSize(ort, input_tensors[0],
                                     openvino_network_->getInputsInfo().begin()->second->getTensorDesc().getDims());
 
-  size_t full_parallel_runs = batch_size / num_inf_reqs_;
-  size_t remainder_parallel_runs = batch_size % num_inf_reqs_;
-
-  auto output_tensors = GetOutputTensors(ort, context, batch_size);
-
-  // Distribute the batched inputs among available Infer Requests
-  // for parallel inference.
+  // Only the Infer Requests the batch needs are checked out, the others stay available
+  // to the concurrent Infers, whose inferences then overlap with these ones.
+  size_t num_inf_reqs = std::max<size_t>(1, std::min(batch_size, num_inf_reqs_));
+  auto infer_requests = AcquireInferRequests(num_inf_reqs);
+
+  try {
+    size_t full_parallel_runs = batch_size / num_inf_reqs;
+    size_t remainder_parallel_runs = batch_size % num_inf_reqs;
+
+    auto output_tensors = GetOutputTensors(ort, context, batch_size, infer_requests[0]);
+
+    // Distribute the batched inputs among the checked out Infer Requests
+    // for parallel inference.
+
+    // Run parallel inferences as sets of num_inf_reqs
+    for (size_t set = 0; set < full_parallel_runs; set++) {
+      for (size_t inf_req_idx = 0; inf_req_idx < num_inf_reqs; inf_req_idx++) {
+        size_t batch_slice_idx = set * num_inf_reqs + inf_req_idx;
+        StartAsyncInference(ort, input_tensors, batch_slice_idx, infer_requests[inf_req_idx]);
+      }
+      for (size_t inf_req_idx = 0; inf_req_idx < num_inf_reqs; inf_req_idx++) {
+        size_t batch_slice_idx = set * num_inf_reqs + inf_req_idx;
+        CompleteAsyncInference(ort, output_tensors, batch_slice_idx, infer_requests[inf_req_idx]);
+      }
+    }
 
-  // Run parallel inferences as sets of num_inf_reqs_
-  for (size_t set = 0; set < full_parallel_runs; set++) {
-    for (size_t inf_req_idx = 0; inf_req_idx < num_inf_reqs_; inf_req_idx++) {
-      size_t batch_slice_idx = set * num_inf_reqs_ + inf_req_idx;
-      StartAsyncInference(ort, input_tensors, batch_slice_idx, inf_req_idx);
+    // Run parallel inferences for remaining batch slices
+    for (size_t inf_req_idx = 0; inf_req_idx < remainder_parallel_runs; inf_req_idx++) {
+      size_t batch_slice_idx = full_parallel_runs * num_inf_reqs + inf_req_idx;
+      StartAsyncInference(ort, input_tensors, batch_slice_idx, infer_requests[inf_req_idx]);
     }
-    for (size_t inf_req_idx = 0; inf_req_idx < num_inf_reqs_; inf_req_idx++) {
-      size_t batch_slice_idx = set * num_inf_reqs_ + inf_req_idx;
-      CompleteAsyncInference(ort, output_tensors, batch_slice_idx, inf_req_idx);
+    for (size_t inf_req_idx = 0; inf_req_idx < remainder_parallel_runs; inf_req_idx++) {
+      size_t batch_slice_idx = full_parallel_runs * num_inf_reqs + inf_req_idx;
+      CompleteAsyncInference(ort, output_tensors, batch_slice_idx, infer_requests[inf_req_idx]);
     }
+  } catch (...) {
+    ReleaseInferRequests(infer_requests);
+    throw;
   }
-
-  // Run parallel inferences for remaining batch slices
-  for (size_t inf_req_idx = 0; inf_req_idx < remainder_parallel_runs; inf_req_idx++) {
-    size_t batch_slice_idx = full_parallel_runs * num_inf_reqs_ + inf_req_idx;
-    StartAsyncInference(ort, input_tensors, batch_slice_idx, inf_req_idx);
-  }
-  for (size_t inf_req_idx = 0; inf_req_idx < remainder_parallel_runs; inf_req_idx++) {
-    size_t batch_slice_idx = full_parallel_runs * num_inf_reqs_ + inf_req_idx;
-    CompleteAsyncInference(ort, output_tensors, batch_slice_idx, inf_req_idx);
-  }
+  ReleaseInferRequests(infer_requests);
 
   LOGS_DEFAULT(INFO) << log_tag << "Inference successful";
 }
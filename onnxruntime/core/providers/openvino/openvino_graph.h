@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include <inference_engine.hpp>
 #include <ie_utils.hpp>
@@ -20,7 +22,7 @@ namespace openvino_ep {
 
 class OpenVINOGraph {
  public:
-  OpenVINOGraph(const onnxruntime::Node* fused_node);
+  OpenVINOGraph(const onnxruntime::Node* fused_node, size_t num_streams, const std::string& blob_cache_dir);
 
   void Infer(Ort::CustomOpApi ort, OrtKernelContext* context);
 
@@ -36,25 +38,40 @@ class OpenVINOGraph {
   void GetExecutableHandle(
       std::shared_ptr<InferenceEngine::CNNNetwork> network);
 
+  std::map<std::string, std::string> GetDeviceConfig(size_t num_streams) const;
+
+  InferenceEngine::ExecutableNetwork LoadExecutableNetwork(const std::map<std::string, std::string>& config,
+                                                           const std::string& blob_cache_dir);
+
+  std::vector<InferenceEngine::InferRequest::Ptr> AcquireInferRequests(size_t count);
+
+  void ReleaseInferRequests(std::vector<InferenceEngine::InferRequest::Ptr>& infer_requests);
+
   size_t DeduceBatchSize(Ort::CustomOpApi ort, const OrtValue* input_tensor,
                          InferenceEngine::SizeVector graph_dims);
 
   std::vector<const OrtValue*> GetInputTensors(Ort::CustomOpApi ort, OrtKernelContext* context);
 
-  std::vector<OrtValue*> GetOutputTensors(Ort::CustomOpApi ort, OrtKernelContext* context, size_t batch_size);
+  std::vector<OrtValue*> GetOutputTensors(Ort::CustomOpApi ort, OrtKernelContext* context, size_t batch_size,
+                                          InferenceEngine::InferRequest::Ptr infer_request);
 
-  void StartAsyncInference(Ort::CustomOpApi ort, std::vector<const OrtValue*> input_tensors, size_t batch_slice_idx, size_t infer_req_idx);
+  void StartAsyncInference(Ort::CustomOpApi ort, std::vector<const OrtValue*> input_tensors, size_t batch_slice_idx,
+                           InferenceEngine::InferRequest::Ptr infer_request);
 
-  void CompleteAsyncInference(Ort::CustomOpApi ort, std::vector<OrtValue*> output_tensors, size_t batch_slice_idx, size_t infer_req_idx);
+  void CompleteAsyncInference(Ort::CustomOpApi ort, std::vector<OrtValue*> output_tensors, size_t batch_slice_idx,
+                              InferenceEngine::InferRequest::Ptr infer_request);
 
   std::vector<std::string> GetEnvLdLibraryPath() const;
 
   const onnxruntime::Node* fused_node_;
   std::shared_ptr<InferenceEngine::CNNNetwork> openvino_network_;
   size_t num_inf_reqs_;
-  std::vector<InferenceEngine::InferRequest::Ptr> infer_requests_;
+  // the infer requests no Infer is using. The concurrent Infers check out the ones they need, so their inferences
+  // are queued together on the device.
+  std::vector<InferenceEngine::InferRequest::Ptr> idle_infer_requests_;
+  std::mutex infer_requests_lock_;
+  std::condition_variable infer_requests_cv_;
   std::string device_id_;
-  mutable std::mutex compute_lock_;
   std::vector<int> input_indexes_;
   InferenceEngine::Precision precision_;
   const onnxruntime::Graph* onnx_graph_;
@@ -7,7 +7,7 @@
 
 namespace onnxruntime {
 struct OpenVINOProviderFactory : IExecutionProviderFactory {
-  OpenVINOProviderFactory(const char* device) : device_(device) {
+  OpenVINOProviderFactory(const OpenVINOExecutionProviderInfo& info) : info_(info) {
   }
   ~OpenVINOProviderFactory() override {
   }
@@ -15,18 +15,21 @@ struct OpenVINOProviderFactory : IExecutionProviderFactory {
   std::unique_ptr<IExecutionProvider> CreateProvider() override;
 
  private:
-  const char* device_;
+  OpenVINOExecutionProviderInfo info_;
 };
 
 std::unique_ptr<IExecutionProvider> OpenVINOProviderFactory::CreateProvider() {
-  OpenVINOExecutionProviderInfo info;
-  info.device = device_;
-  return onnxruntime::make_unique<OpenVINOExecutionProvider>(info);
+  return onnxruntime::make_unique<OpenVINOExecutionProvider>(info_);
 }
 
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_OpenVINO(
     const char* device_id) {
-  return std::make_shared<onnxruntime::OpenVINOProviderFactory>(device_id);
+  return std::make_shared<onnxruntime::OpenVINOProviderFactory>(OpenVINOExecutionProviderInfo(device_id));
+}
+
+std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_OpenVINO(
+    const OpenVINOExecutionProviderInfo& info) {
+  return std::make_shared<onnxruntime::OpenVINOProviderFactory>(info);
 }
 
 }  // namespace onnxruntime
@@ -37,3 +40,14 @@ ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProvider_OpenVINO,
       onnxruntime::CreateExecutionProviderFactory_OpenVINO(device_id));
   return nullptr;
 }
+
+ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProviderEx_OpenVINO, _In_ OrtSessionOptions* options,
+                    const char* device_id, int num_streams, _In_opt_ const char* blob_cache_dir) {
+  onnxruntime::OpenVINOExecutionProviderInfo info(device_id);
+  info.num_streams = num_streams > 0 ? static_cast<size_t>(num_streams) : 0;
+  if (blob_cache_dir != nullptr) {
+    info.blob_cache_dir = blob_cache_dir;
+  }
+  options->provider_factories.push_back(onnxruntime::CreateExecutionProviderFactory_OpenVINO(info));
+  return nullptr;
+}
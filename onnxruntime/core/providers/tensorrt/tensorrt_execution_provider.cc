@@ -23,6 +23,11 @@
 #include "gsl/gsl"
 #include "core/graph/model.h"
 #include "core/providers/cuda/gpu_data_transfer.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 
 using namespace ONNX_NAMESPACE;
 using namespace ::onnxruntime::logging;
@@ -83,6 +88,202 @@ TensorrtLogger& GetTensorrtLogger() {
   return trt_logger;
 }
 
+namespace {
+// FNV-1a, the cache file names must not change between builds
+uint64_t HashString(const std::string& str, uint64_t hash = 14695981039346656037ull) {
+  for (const char c : str) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+std::string ToHexString(uint64_t value) {
+  std::ostringstream stream;
+  stream << std::hex << std::setw(16) << std::setfill('0') << value;
+  return stream.str();
+}
+
+bool HasDynamicDims(const nvinfer1::Dims& dims) {
+  for (int j = 0; j < dims.nbDims; ++j) {
+    if (dims.d[j] == -1) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void AppendDims(std::string& profile, const nvinfer1::Dims& dims) {
+  for (int j = 0; j < dims.nbDims; ++j) {
+    profile += (j == 0 ? "" : "x") + std::to_string(dims.d[j]);
+  }
+  profile += ';';
+}
+
+// Describes the min/opt/max dims of a dynamic input of an optimization profile
+void AppendProfileDims(std::string& profile, const char* input_name, const nvinfer1::Dims& dims_min,
+                       const nvinfer1::Dims& dims_opt, const nvinfer1::Dims& dims_max) {
+  profile += input_name;
+  profile += ':';
+  AppendDims(profile, dims_min);
+  AppendDims(profile, dims_opt);
+  AppendDims(profile, dims_max);
+}
+
+// Identifies the engines built from a subgraph: the TensorRT version, the GPU and the precision flags are part
+// of it as an engine only runs on the GPU model and the TensorRT version it was built with
+std::string GetEngineCacheKey(const std::string& model_string, int device_id, const std::string& precision) {
+  cudaDeviceProp prop;
+  CUDA_CALL_THROW(cudaGetDeviceProperties(&prop, device_id));
+  std::string key = ToHexString(HashString(model_string));
+  key += "_trt" + std::to_string(getInferLibVersion());
+  key += "_sm" + std::to_string(prop.major) + std::to_string(prop.minor);
+  key += "_" + ToHexString(HashString(prop.name));
+  key += "_" + precision;
+  return key;
+}
+
+std::string GetEngineCacheFile(const std::string& cache_path, const std::string& cache_key,
+                               const std::string& profile) {
+  return cache_path + "/trt_" + cache_key + "_" + ToHexString(HashString(profile)) + ".engine";
+}
+
+// Returns nullptr if there's no usable engine in the file
+nvinfer1::ICudaEngine* LoadEngine(nvinfer1::IRuntime& runtime, const std::string& file_path) {
+  std::ifstream file(file_path, std::ios::binary | std::ios::in);
+  if (!file) {
+    return nullptr;
+  }
+
+  std::string engine_data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  nvinfer1::ICudaEngine* engine = runtime.deserializeCudaEngine(engine_data.data(), engine_data.size(), nullptr);
+  if (engine == nullptr) {
+    LOGS_DEFAULT(WARNING) << "TensorRT EP could not deserialize the cached engine " << file_path;
+  }
+  return engine;
+}
+
+void SaveEngine(nvinfer1::ICudaEngine& engine, const std::string& file_path) {
+  auto serialized_engine = engine.serialize();
+  if (serialized_engine == nullptr) {
+    return;
+  }
+
+  // write to a temporary file first, so that a concurrent load never sees a partial engine
+  const std::string temp_file_path = file_path + ".tmp" + std::to_string(Env::Default().GetSelfPid());
+  {
+    std::ofstream file(temp_file_path, std::ios::binary | std::ios::out | std::ios::trunc);
+    file.write(static_cast<const char*>(serialized_engine->data()), serialized_engine->size());
+  }
+  serialized_engine->destroy();
+
+  if (std::rename(temp_file_path.c_str(), file_path.c_str()) != 0) {
+    std::remove(temp_file_path.c_str());
+    LOGS_DEFAULT(WARNING) << "TensorRT EP could not save the engine to " << file_path;
+  }
+}
+
+// Enables the reduced precisions the GPU has fast kernels for, TensorRT still picks the fastest kernel of each layer
+// among those precisions and FP32. Returns a description of the precisions for the engine cache key.
+std::string SetBuilderPrecision(nvinfer1::IBuilder& builder, nvinfer1::IBuilderConfig& config, bool fp16, bool int8) {
+  std::string precision = "fp32";
+  if (fp16 && builder.platformHasFastFp16()) {
+    config.setFlag(nvinfer1::BuilderFlag::kFP16);
+    precision = "fp16";
+  }
+  if (int8 && builder.platformHasFastInt8()) {
+    config.setFlag(nvinfer1::BuilderFlag::kINT8);
+    precision += "_int8";
+  }
+  return precision;
+}
+
+// Loads the engine from the cache if it has one, otherwise builds it and adds it to the cache
+nvinfer1::ICudaEngine* BuildOrLoadEngine(nvinfer1::IBuilder& builder, nvinfer1::INetworkDefinition& network,
+                                         nvinfer1::IBuilderConfig& config, nvinfer1::IRuntime* runtime,
+                                         const std::string& cache_path, const std::string& cache_key,
+                                         const std::string& profile) {
+  std::string cache_file;
+  if (runtime != nullptr) {
+    cache_file = GetEngineCacheFile(cache_path, cache_key, profile);
+    auto engine = LoadEngine(*runtime, cache_file);
+    if (engine != nullptr) {
+      return engine;
+    }
+  }
+
+  auto engine = builder.buildEngineWithConfig(network, config);
+  if (engine != nullptr && runtime != nullptr) {
+    SaveEngine(*engine, cache_file);
+  }
+  return engine;
+}
+}  // namespace
+
+static std::vector<std::string> SplitString(const std::string& str, char delimiter) {
+  std::vector<std::string> parts;
+  std::istringstream stream(str);
+  std::string part;
+  while (std::getline(stream, part, delimiter)) {
+    parts.push_back(part);
+  }
+  return parts;
+}
+
+// Parses the optimization profiles, see TensorrtExecutionProviderInfo::profile_shapes
+static std::vector<TensorrtProfileShapes> ParseProfileShapes(const std::string& profile_shapes) {
+  std::vector<TensorrtProfileShapes> profiles;
+  for (const auto& profile_string : SplitString(profile_shapes, '|')) {
+    TensorrtProfileShapes profile;
+    for (const auto& input_string : SplitString(profile_string, ';')) {
+      const auto name_end = input_string.rfind(':');
+      ORT_ENFORCE(name_end != std::string::npos && name_end > 0, "Invalid TensorRT profile shape: ", input_string);
+      const auto shapes = SplitString(input_string.substr(name_end + 1), ',');
+      ORT_ENFORCE(shapes.size() == 3, "TensorRT profile shape needs the min, opt and max shapes: ", input_string);
+
+      auto& dims = profile[input_string.substr(0, name_end)];
+      for (const auto& shape : shapes) {
+        std::vector<int64_t> shape_dims;
+        for (const auto& dim : SplitString(shape, 'x')) {
+          shape_dims.push_back(std::stoll(dim));
+        }
+        ORT_ENFORCE(dims.empty() || dims[0].size() == shape_dims.size(),
+                    "TensorRT profile shapes of different ranks: ", input_string);
+        dims.push_back(std::move(shape_dims));
+      }
+      for (size_t j = 0; j < dims[0].size(); ++j) {
+        ORT_ENFORCE(dims[0][j] <= dims[1][j] && dims[1][j] <= dims[2][j],
+                    "TensorRT profile shapes must satisfy min <= opt <= max: ", input_string);
+      }
+    }
+    profiles.push_back(std::move(profile));
+  }
+  return profiles;
+}
+
+// Reads the "<tensor name> <max abs value>" lines of an INT8 calibration table
+static bool ReadDynamicRanges(const std::string& file_path, std::unordered_map<std::string, float>& dynamic_ranges,
+                              std::string& file_hash) {
+  std::ifstream file(file_path);
+  if (!file) {
+    return false;
+  }
+
+  std::string contents;
+  std::string line;
+  while (std::getline(file, line)) {
+    contents += line + '\n';
+    const auto name_end = line.find_last_of(" \t");
+    if (line.empty() || line[0] == '#' || name_end == std::string::npos) {
+      continue;
+    }
+    dynamic_ranges[line.substr(0, line.find_last_not_of(" \t", name_end) + 1)] = std::stof(line.substr(name_end + 1));
+  }
+
+  file_hash = ToHexString(HashString(contents));
+  return true;
+}
+
 TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProviderInfo& info)
     : IExecutionProvider{onnxruntime::kTensorrtExecutionProvider}, device_id_(info.device_id) {
   CUDA_CALL_THROW(cudaSetDevice(device_id_));
@@ -117,6 +318,52 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
   if (!fp16_enable_env.empty()) {
     fp16_enable_ = (std::stoi(fp16_enable_env) == 0 ? false : true);
   }
+  fp16_enable_ = fp16_enable_ || info.fp16_enable;
+
+  const std::string int8_enable_env = env_instance.GetEnvironmentVar(tensorrt_env_vars::kINT8Enable);
+  if (!int8_enable_env.empty()) {
+    int8_enable_ = (std::stoi(int8_enable_env) == 0 ? false : true);
+  }
+  int8_enable_ = int8_enable_ || info.int8_enable;
+
+  if (int8_enable_) {
+    const std::string calibration_table = info.int8_calibration_table.empty()
+                                              ? env_instance.GetEnvironmentVar(tensorrt_env_vars::kINT8CalibrationTable)
+                                              : info.int8_calibration_table;
+    if (calibration_table.empty() || !ReadDynamicRanges(calibration_table, dynamic_ranges_, dynamic_ranges_hash_)) {
+      // without ranges TensorRT would have to calibrate, which needs data the provider doesn't have
+      LOGS_DEFAULT(WARNING) << "TensorRT EP INT8 mode is disabled as the calibration table '" << calibration_table
+                            << "' could not be read.";
+      int8_enable_ = false;
+    }
+  }
+
+  const std::string engine_cache_enable_env = env_instance.GetEnvironmentVar(tensorrt_env_vars::kEngineCacheEnable);
+  if (!engine_cache_enable_env.empty()) {
+    engine_cache_enable_ = (std::stoi(engine_cache_enable_env) == 0 ? false : true);
+  }
+
+  if (engine_cache_enable_) {
+    engine_cache_path_ = env_instance.GetEnvironmentVar(tensorrt_env_vars::kEngineCachePath);
+    if (engine_cache_path_.empty()) {
+      engine_cache_path_ = ".";
+    }
+    runtime_ = unique_pointer<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(GetTensorrtLogger()));
+  }
+
+  const std::string context_pool_size_env = env_instance.GetEnvironmentVar(tensorrt_env_vars::kContextPoolSize);
+  if (info.context_pool_size > 0) {
+    context_pool_size_ = info.context_pool_size;
+  } else if (!context_pool_size_env.empty()) {
+    context_pool_size_ = std::max(std::stoi(context_pool_size_env), 1);
+  }
+
+  const std::string profile_shapes = info.profile_shapes.empty()
+                                         ? env_instance.GetEnvironmentVar(tensorrt_env_vars::kProfileShapes)
+                                         : info.profile_shapes;
+  if (!profile_shapes.empty()) {
+    profile_shapes_ = ParseProfileShapes(profile_shapes);
+  }
 }
 
 TensorrtExecutionProvider::~TensorrtExecutionProvider() {}
@@ -133,6 +380,53 @@ std::unique_ptr<onnxruntime::IDataTransfer> TensorrtExecutionProvider::GetDataTr
   return onnxruntime::make_unique<onnxruntime::GPUDataTransfer>();
 }
 
+TensorrtContextPool::TensorrtContextPool(int num_user_profiles, int pool_size)
+    : num_user_profiles_(num_user_profiles), pool_size_(pool_size) {
+}
+
+TensorrtContextPool::~TensorrtContextPool() {
+  // do not throw error since it's OK for the destroy to fail during shutdown
+  for (auto& slot : slots_) {
+    cudaStreamDestroy(slot.stream);
+    cudaEventDestroy(slot.event);
+  }
+}
+
+Status TensorrtContextPool::AddContext(nvinfer1::IExecutionContext* context, int profile_index) {
+  Slot slot{context, profile_index, nullptr, nullptr, false};
+  CUDA_RETURN_IF_ERROR(cudaStreamCreateWithFlags(&slot.stream, cudaStreamNonBlocking));
+  if (cudaEventCreateWithFlags(&slot.event, cudaEventDisableTiming) != cudaSuccess) {
+    cudaStreamDestroy(slot.stream);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP could not create the event of a pooled context.");
+  }
+  slots_.push_back(slot);
+  return Status::OK();
+}
+
+TensorrtContextPool::Slot& TensorrtContextPool::Acquire(int user_profile) {
+  std::unique_lock<OrtMutex> lock(mutex_);
+  Slot* free_slot = nullptr;
+  cv_.wait(lock, [this, user_profile, &free_slot]() {
+    for (int c = user_profile * pool_size_, end = (user_profile + 1) * pool_size_; c < end; ++c) {
+      if (!slots_[c].busy) {
+        free_slot = &slots_[c];
+        return true;
+      }
+    }
+    return false;
+  });
+  free_slot->busy = true;
+  return *free_slot;
+}
+
+void TensorrtContextPool::Release(Slot& slot) {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    slot.busy = false;
+  }
+  cv_.notify_all();
+}
+
 // Convert GraphViewer graph to GraphProto
 void ToGraphProtoInternal(const onnxruntime::GraphViewer& graph, ONNX_NAMESPACE::GraphProto& graph_proto) {
   for (const auto* input_arg : graph.GetInputs()) {
@@ -657,53 +951,132 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<onnxruntime:
     trt_parser->parse(string_buf.data(), string_buf.size());
     trt_config->setMaxWorkspaceSize(max_workspace_size_);
 
-    // Set optimization profile for dynamic shapes
-    auto trt_profile = trt_builder->createOptimizationProfile();
-    for (unsigned int i = 0, end = trt_network->getNbInputs(); i < end; ++i) {
-      auto input = trt_network->getInput(i);
-      nvinfer1::Dims dims = input->getDimensions();
-      nvinfer1::Dims dims_min = dims;
-      nvinfer1::Dims dims_opt = dims;
-      nvinfer1::Dims dims_max = dims;
+    // Set the dynamic ranges for INT8. TensorRT runs the layers with a tensor that has no range in a higher
+    // precision, prefer FP16 for them if it's enabled.
+    if (int8_enable_ && trt_builder->platformHasFastInt8()) {
+      for (int i = 0, end = trt_network->getNbInputs(); i < end; ++i) {
+        auto input = trt_network->getInput(i);
+        auto range = dynamic_ranges_.find(input->getName());
+        if (range != dynamic_ranges_.end()) {
+          input->setDynamicRange(-range->second, range->second);
+        }
+      }
 
-      int nb_dims = dims.nbDims;
-      if (input->isShapeTensor()) {  // Shape tensor
-        std::vector<int32_t> shapes_min(nb_dims), shapes_opt(nb_dims), shapes_max(nb_dims);
-        for (int j = 0, end = nb_dims; j < end; ++j) {
-          shapes_min[j] = 1;
-          shapes_opt[j] = 1;
-          shapes_max[j] = 1000;
-        }
-        trt_profile->setShapeValues(input->getName(), nvinfer1::OptProfileSelector::kMIN, &shapes_min[0], nb_dims);
-        trt_profile->setShapeValues(input->getName(), nvinfer1::OptProfileSelector::kOPT, &shapes_opt[0], nb_dims);
-        trt_profile->setShapeValues(input->getName(), nvinfer1::OptProfileSelector::kMAX, &shapes_max[0], nb_dims);
-      } else {  // Execution tensor
-        bool is_dynamic_shape = false;
-        for (int j = 0, end = nb_dims; j < end; ++j) {
-          // For dynamic shape subgraph, a dummy engine is created at compile phase.
-          // Real engine will be created at compute phase based on input data
-          if (dims.d[j] == -1) {  // Dynamic shape
-            dims_min.d[j] = 1;
-            dims_opt.d[j] = 1;
-            dims_max.d[j] = 1;
-            is_dynamic_shape = true;
+      for (int i = 0, end = trt_network->getNbLayers(); i < end; ++i) {
+        auto layer = trt_network->getLayer(i);
+        bool has_ranges = true;
+        for (int j = 0, end_j = layer->getNbOutputs(); j < end_j; ++j) {
+          auto output = layer->getOutput(j);
+          auto range = dynamic_ranges_.find(output->getName());
+          if (range != dynamic_ranges_.end()) {
+            output->setDynamicRange(-range->second, range->second);
+          } else {
+            has_ranges = false;
+          }
+        }
+        for (int j = 0, end_j = layer->getNbInputs(); j < end_j; ++j) {
+          auto input = layer->getInput(j);
+          if (input != nullptr && dynamic_ranges_.find(input->getName()) == dynamic_ranges_.end()) {
+            has_ranges = false;
           }
         }
+        if (!has_ranges && fp16_enable_ && trt_builder->platformHasFastFp16()) {
+          layer->setPrecision(nvinfer1::DataType::kHALF);
+        }
+      }
+    }
+
+    // Set optimization profiles for dynamic shapes. Each user profile is added once per context of the pool.
+    std::string profile_string;
+    bool has_dynamic_shapes = false;
+    const int num_user_profiles = profile_shapes_.empty() ? 1 : static_cast<int>(profile_shapes_.size());
+    const int profile_copies = profile_shapes_.empty() ? 1 : context_pool_size_;
+    const int num_profiles = num_user_profiles * profile_copies;
+    for (int profile = 0; profile < num_profiles; ++profile) {
+      const size_t k = profile / profile_copies;
+      auto trt_profile = trt_builder->createOptimizationProfile();
+      for (unsigned int i = 0, end = trt_network->getNbInputs(); i < end; ++i) {
+        auto input = trt_network->getInput(i);
+        nvinfer1::Dims dims = input->getDimensions();
+        nvinfer1::Dims dims_min = dims;
+        nvinfer1::Dims dims_opt = dims;
+        nvinfer1::Dims dims_max = dims;
+
+        int nb_dims = dims.nbDims;
+        if (input->isShapeTensor()) {  // Shape tensor
+          std::vector<int32_t> shapes_min(nb_dims), shapes_opt(nb_dims), shapes_max(nb_dims);
+          for (int j = 0, end = nb_dims; j < end; ++j) {
+            shapes_min[j] = 1;
+            shapes_opt[j] = 1;
+            shapes_max[j] = 1000;
+          }
+          trt_profile->setShapeValues(input->getName(), nvinfer1::OptProfileSelector::kMIN, &shapes_min[0], nb_dims);
+          trt_profile->setShapeValues(input->getName(), nvinfer1::OptProfileSelector::kOPT, &shapes_opt[0], nb_dims);
+          trt_profile->setShapeValues(input->getName(), nvinfer1::OptProfileSelector::kMAX, &shapes_max[0], nb_dims);
+          profile_string += input->getName();
+          profile_string += ":1;1;1000;";
+          has_dynamic_shapes = true;
+        } else {  // Execution tensor
+          bool is_dynamic_shape = false;
+          for (int j = 0, end = nb_dims; j < end; ++j) {
+            if (dims.d[j] == -1) {  // Dynamic shape
+              is_dynamic_shape = true;
+              has_dynamic_shapes = true;
+            }
+          }
+
+          if (is_dynamic_shape && profile_shapes_.empty()) {
+            // For dynamic shape subgraph, a dummy engine is created at compile phase.
+            // Real engine will be created at compute phase based on input data
+            for (int j = 0, end = nb_dims; j < end; ++j) {
+              if (dims.d[j] == -1) {
+                dims_min.d[j] = 1;
+                dims_opt.d[j] = 1;
+                dims_max.d[j] = 1;
+              }
+            }
+          } else if (is_dynamic_shape) {
+            auto shapes = profile_shapes_[k].find(input->getName());
+            if (shapes == profile_shapes_[k].end()) {
+              return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT profile ", k, " has no shape for the dynamic input ",
+                                     input->getName(), " of fused node: ", fused_node->Name());
+            }
+            if (shapes->second[0].size() != static_cast<size_t>(nb_dims)) {
+              return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT profile ", k, " has shapes of rank ",
+                                     shapes->second[0].size(), " for the input ", input->getName(), " of rank ", nb_dims);
+            }
+            for (int j = 0, end = nb_dims; j < end; ++j) {
+              dims_min.d[j] = static_cast<int>(shapes->second[0][j]);
+              dims_opt.d[j] = static_cast<int>(shapes->second[1][j]);
+              dims_max.d[j] = static_cast<int>(shapes->second[2][j]);
+            }
+          }
 
-        if (is_dynamic_shape) {
-          trt_profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMIN, dims_min);
-          trt_profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kOPT, dims_opt);
-          trt_profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMAX, dims_max);
+          if (is_dynamic_shape) {
+            trt_profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMIN, dims_min);
+            trt_profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kOPT, dims_opt);
+            trt_profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMAX, dims_max);
+            AppendProfileDims(profile_string, input->getName(), dims_min, dims_opt, dims_max);
+          }
         }
       }
+
+      trt_config->addOptimizationProfile(trt_profile);
+      profile_string += '|';
     }
 
-    trt_config->addOptimizationProfile(trt_profile);
-    if (fp16_enable_ && trt_builder->platformHasFastFp16()) {
-      trt_config->setFlag(nvinfer1::BuilderFlag::kFP16);
+    std::string precision = SetBuilderPrecision(*trt_builder, *trt_config, fp16_enable_, int8_enable_);
+    if (precision.find("int8") != std::string::npos) {
+      precision += "_" + dynamic_ranges_hash_;
     }
 
-    auto trt_engine = unique_pointer<nvinfer1::ICudaEngine>(trt_builder->buildEngineWithConfig(*trt_network, *trt_config));
+    std::string engine_cache_key;
+    if (engine_cache_enable_) {
+      engine_cache_key = GetEngineCacheKey(string_buf, device_id_, precision);
+    }
+    auto trt_engine = unique_pointer<nvinfer1::ICudaEngine>(
+        BuildOrLoadEngine(*trt_builder, *trt_network, *trt_config, runtime_.get(), engine_cache_path_,
+                          engine_cache_key, profile_string));
     if (trt_engine == nullptr) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
                              "TensorRT EP could not build Engine for fused node: " + fused_node->Name());
@@ -764,7 +1137,26 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<onnxruntime:
       output_types[bindingIndex] = tensor_type.elem_type();
     }
 
-    ORT_ENFORCE(trt_engine->getNbBindings() == (num_inputs + num_outputs));
+    ORT_ENFORCE(trt_engine->getNbBindings() == num_profiles * (num_inputs + num_outputs));
+
+    // Build the context pool, unless the engine is rebuilt for new input shapes at compute time.
+    // The first context uses the first profile, each of the others is bound to its own profile.
+    std::unique_ptr<TensorrtContextPool> context_pool;
+    std::vector<unique_pointer<nvinfer1::IExecutionContext>> pool_contexts;
+    if (!profile_shapes_.empty() || !has_dynamic_shapes) {
+      context_pool = onnxruntime::make_unique<TensorrtContextPool>(num_user_profiles, context_pool_size_);
+      ORT_RETURN_IF_ERROR(context_pool->AddContext(trt_context.get(), 0));
+      for (int c = 1, end = num_user_profiles * context_pool_size_; c < end; ++c) {
+        const int profile_index = profile_shapes_.empty() ? 0 : c;
+        auto pool_context = unique_pointer<nvinfer1::IExecutionContext>(trt_engine->createExecutionContext());
+        if (pool_context == nullptr || (profile_index > 0 && !pool_context->setOptimizationProfile(profile_index))) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP could not build the Execution Context of profile ",
+                                 profile_index, " for fused node: ", fused_node->Name());
+        }
+        ORT_RETURN_IF_ERROR(context_pool->AddContext(pool_context.get(), profile_index));
+        pool_contexts.push_back(std::move(pool_context));
+      }
+    }
 
     // Save engine, context and input/output info to map
     parsers_.emplace(fused_node->Name(), std::move(trt_parser));
@@ -777,6 +1169,11 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<onnxruntime:
     output_info_[fused_node->Name()].push_back(output_types);
     input_shape_ranges_[fused_node->Name()] = input_shape_ranges;
     output_shapes_[fused_node->Name()] = output_shapes;
+    engine_cache_keys_[fused_node->Name()] = engine_cache_key;
+    if (context_pool != nullptr) {
+      pool_contexts_[fused_node->Name()] = std::move(pool_contexts);
+      context_pools_[fused_node->Name()] = std::move(context_pool);
+    }
 
     // Create function state
     // TODO: remove default capture
@@ -787,7 +1184,11 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<onnxruntime:
             engines_[context->node_name].get(), contexts_[context->node_name].get(), builders_[context->node_name].get(),
             networks_[context->node_name].get(), input_info_[context->node_name], output_info_[context->node_name],
             input_shape_ranges_[context->node_name], output_shapes_[context->node_name], &tensorrt_mu_, &fp16_enable_,
-            &max_workspace_size_};
+            &int8_enable_, &max_workspace_size_, runtime_.get(), engine_cache_path_, engine_cache_keys_[context->node_name]};
+      auto context_pool = context_pools_.find(context->node_name);
+      if (context_pool != context_pools_.end()) {
+        p->context_pool = context_pool->second.get();
+      }
       *state = p.release();
       return 0;
     };
@@ -802,7 +1203,6 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<onnxruntime:
     compute_info.compute_func = [](FunctionState state, const OrtCustomOpApi* api, OrtKernelContext* context) {
       Ort::CustomOpApi ort{*api};
       TensorrtFuncState* trt_state = reinterpret_cast<TensorrtFuncState*>(state);
-      std::lock_guard<OrtMutex> lock(*(trt_state->tensorrt_mu_ptr));
       const std::vector<int>& input_indexes = (trt_state->input_info)[0];
       const std::vector<int>& output_indexes = (trt_state->output_info)[0];
       const std::vector<int>& output_types = (trt_state->output_info)[1];
@@ -810,67 +1210,118 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<onnxruntime:
       int num_binding_inputs = input_indexes.size();
       int num_binding_outputs = output_indexes.size();
       int total_bindings = num_binding_inputs + num_binding_outputs;
-      std::vector<void*> buffers(total_bindings);
+
+      // Pick the first of the user's optimization profiles that covers the input shapes and take a free context
+      // of it from the pool, or serialize the Runs if the engine is rebuilt for new shapes
+      auto context_pool = trt_state->context_pool;
+      TensorrtContextPool::Slot* slot = nullptr;
+      std::unique_lock<OrtMutex> lock;
+      if (context_pool != nullptr) {
+        const auto& engine = *trt_state->engine;
+        int user_profile = -1;
+        for (int k = 0; k < context_pool->NumUserProfiles() && user_profile < 0; ++k) {
+          bool covered = true;
+          for (int i = 0; i < num_binding_inputs && covered; ++i) {
+            if (engine.isShapeBinding(i)) {
+              continue;
+            }
+            const OrtValue* input_tensor = ort.KernelContext_GetInput(context, input_indexes[i]);
+            auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
+            const auto& tensor_shape = ort.GetTensorShape(tensor_info);
+            ort.ReleaseTensorTypeAndShapeInfo(tensor_info);
+            const int engine_profile = k * context_pool->PoolSize();
+            nvinfer1::Dims dims_min = engine.getProfileDimensions(i, engine_profile, nvinfer1::OptProfileSelector::kMIN);
+            nvinfer1::Dims dims_max = engine.getProfileDimensions(i, engine_profile, nvinfer1::OptProfileSelector::kMAX);
+            for (int j = 0; j < dims_min.nbDims && covered; ++j) {
+              covered = tensor_shape[j] >= dims_min.d[j] && tensor_shape[j] <= dims_max.d[j];
+            }
+          }
+          if (covered) {
+            user_profile = k;
+          }
+        }
+        if (user_profile < 0) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                                 "TensorRT EP input shapes are not covered by any of the optimization profiles.");
+        }
+        slot = &context_pool->Acquire(user_profile);
+      } else {
+        lock = std::unique_lock<OrtMutex>(*(trt_state->tensorrt_mu_ptr));
+      }
+      auto release_slot = gsl::finally([context_pool, slot]() {
+        if (slot != nullptr) {
+          context_pool->Release(*slot);
+        }
+      });
+
+      // the bindings of profile k come after those of the k first profiles
+      const int binding_offset = slot != nullptr ? slot->profile_index * total_bindings : 0;
+      std::vector<void*> all_buffers(trt_state->engine->getNbBindings());
+      void** buffers = all_buffers.data() + binding_offset;
 
       // Update shape ranges
       bool dimension_update = false;
-      auto trt_context = trt_state->context;
+      auto trt_context = slot != nullptr ? slot->context : trt_state->context;
       auto trt_builder = trt_state->builder;
       nvinfer1::IOptimizationProfile* trt_profile = nullptr;
-      for (int i = 0, end = num_binding_inputs; i < end; ++i) {
-        // TODO: check if getInput indexing is same with binding index
-        auto input = trt_state->network->getInput(i);
-        nvinfer1::Dims dims = input->getDimensions();
-        nvinfer1::Dims dims_min = dims;
-        nvinfer1::Dims dims_opt = dims;
-        nvinfer1::Dims dims_max = dims;
-
-        // Check and update shape ranges for dynamic shape inputs
-        auto& shape_ranges = trt_state->input_shape_ranges;
-        if (shape_ranges.find(i) != shape_ranges.end()) {
-          const OrtValue* input_tensor = ort.KernelContext_GetInput(context, input_indexes[i]);
-          auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
-          const auto& tensor_shape = ort.GetTensorShape(tensor_info);
-          auto& engine = trt_context->getEngine();
-          nvinfer1::Dims dimensions = engine.getBindingDimensions(static_cast<int>(i));
-          int nb_dims = dimensions.nbDims;
-          for (int j = 0, end = nb_dims; j < end; ++j) {
-            auto& shape_range = shape_ranges[i];
-            if (shape_range.find(j) != shape_range.end()) {
-              // Update minimum dimension
-              if (tensor_shape[j] < shape_range[j].first) {
-                shape_range[j].first = tensor_shape[j];
-                dims_min.d[j] = tensor_shape[j];
-                dimension_update = true;
-              }
-              // Update maximum dimension
-              if (tensor_shape[j] > shape_range[j].second) {
-                shape_range[j].second = tensor_shape[j];
-                dims_max.d[j] = tensor_shape[j];
-                dims_opt.d[j] = tensor_shape[j];
-                dimension_update = true;
+      std::string profile_string;
+      if (slot == nullptr) {
+        for (int i = 0, end = num_binding_inputs; i < end; ++i) {
+          // TODO: check if getInput indexing is same with binding index
+          auto input = trt_state->network->getInput(i);
+          nvinfer1::Dims dims = input->getDimensions();
+          nvinfer1::Dims dims_min = dims;
+          nvinfer1::Dims dims_opt = dims;
+          nvinfer1::Dims dims_max = dims;
+
+          // Check and update shape ranges for dynamic shape inputs
+          auto& shape_ranges = trt_state->input_shape_ranges;
+          if (shape_ranges.find(i) != shape_ranges.end()) {
+            const OrtValue* input_tensor = ort.KernelContext_GetInput(context, input_indexes[i]);
+            auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
+            const auto& tensor_shape = ort.GetTensorShape(tensor_info);
+            auto& engine = trt_context->getEngine();
+            nvinfer1::Dims dimensions = engine.getBindingDimensions(static_cast<int>(i));
+            int nb_dims = dimensions.nbDims;
+            for (int j = 0, end = nb_dims; j < end; ++j) {
+              auto& shape_range = shape_ranges[i];
+              if (shape_range.find(j) != shape_range.end()) {
+                // Update minimum dimension
+                if (tensor_shape[j] < shape_range[j].first) {
+                  shape_range[j].first = tensor_shape[j];
+                  dims_min.d[j] = tensor_shape[j];
+                  dimension_update = true;
+                }
+                // Update maximum dimension
+                if (tensor_shape[j] > shape_range[j].second) {
+                  shape_range[j].second = tensor_shape[j];
+                  dims_max.d[j] = tensor_shape[j];
+                  dims_opt.d[j] = tensor_shape[j];
+                  dimension_update = true;
+                }
               }
             }
-          }
 
-          if (dimension_update) {
-            if (trt_profile == nullptr) {
-              trt_profile = trt_builder->createOptimizationProfile();
-            }
-            if (engine.isShapeBinding(i)) {
-              std::vector<int32_t> shapes_min(nb_dims), shapes_opt(nb_dims), shapes_max(nb_dims);
-              for (int j = 0, end = nb_dims; j < end; ++j) {
-                shapes_min[j] = dims_min.d[j];
-                shapes_opt[j] = dims_opt.d[j];
-                shapes_max[j] = dims_max.d[j];
+            if (dimension_update) {
+              if (trt_profile == nullptr) {
+                trt_profile = trt_builder->createOptimizationProfile();
               }
-              trt_profile->setShapeValues(input->getName(), nvinfer1::OptProfileSelector::kMIN, &shapes_min[0], nb_dims);
-              trt_profile->setShapeValues(input->getName(), nvinfer1::OptProfileSelector::kOPT, &shapes_opt[0], nb_dims);
-              trt_profile->setShapeValues(input->getName(), nvinfer1::OptProfileSelector::kMAX, &shapes_max[0], nb_dims);
-            } else {
-              trt_profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMIN, dims_min);
-              trt_profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kOPT, dims_opt);
-              trt_profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMAX, dims_max);
+              if (engine.isShapeBinding(i)) {
+                std::vector<int32_t> shapes_min(nb_dims), shapes_opt(nb_dims), shapes_max(nb_dims);
+                for (int j = 0, end = nb_dims; j < end; ++j) {
+                  shapes_min[j] = dims_min.d[j];
+                  shapes_opt[j] = dims_opt.d[j];
+                  shapes_max[j] = dims_max.d[j];
+                }
+                trt_profile->setShapeValues(input->getName(), nvinfer1::OptProfileSelector::kMIN, &shapes_min[0], nb_dims);
+                trt_profile->setShapeValues(input->getName(), nvinfer1::OptProfileSelector::kOPT, &shapes_opt[0], nb_dims);
+                trt_profile->setShapeValues(input->getName(), nvinfer1::OptProfileSelector::kMAX, &shapes_max[0], nb_dims);
+              } else {
+                trt_profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMIN, dims_min);
+                trt_profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kOPT, dims_opt);
+                trt_profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMAX, dims_max);
+              }
+              AppendProfileDims(profile_string, input->getName(), dims_min, dims_opt, dims_max);
             }
           }
         }
@@ -882,10 +1333,10 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<onnxruntime:
         auto trt_config = unique_pointer<nvinfer1::IBuilderConfig>(trt_builder->createBuilderConfig());
         trt_config->setMaxWorkspaceSize(*(trt_state->max_workspace_size_ptr));
         trt_config->addOptimizationProfile(trt_profile);
-        if (*(trt_state->fp16_enable_ptr) && trt_builder->platformHasFastFp16()) {
-          trt_config->setFlag(nvinfer1::BuilderFlag::kFP16);
-        }
-        trt_state->engine = trt_builder->buildEngineWithConfig(*trt_state->network, *trt_config);
+        SetBuilderPrecision(*trt_builder, *trt_config, *(trt_state->fp16_enable_ptr), *(trt_state->int8_enable_ptr));
+        trt_state->engine = BuildOrLoadEngine(*trt_builder, *trt_state->network, *trt_config, trt_state->runtime,
+                                              trt_state->engine_cache_path, trt_state->engine_cache_key,
+                                              profile_string);
         if (trt_state->engine == nullptr) {
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP Failed to Build Engine.");
         }
@@ -903,12 +1354,13 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<onnxruntime:
         const auto& tensor_shape = ort.GetTensorShape(tensor_info);
 
         // Set dynamic shapes
-        nvinfer1::Dims dimensions = trt_context->getBindingDimensions(static_cast<int>(i));
+        nvinfer1::Dims dimensions = trt_context->getBindingDimensions(binding_offset + i);
         int nb_dims = dimensions.nbDims;
-        if (dimension_update) {
+        if (dimension_update || (slot != nullptr && !trt_state->engine->isShapeBinding(i) &&
+                                 HasDynamicDims(trt_state->engine->getBindingDimensions(i)))) {
           for (int j = 0, end = nb_dims; j < end; ++j)
             dimensions.d[j] = tensor_shape[j];
-          trt_context->setBindingDimensions(i, dimensions);
+          trt_context->setBindingDimensions(binding_offset + i, dimensions);
         }
 
         auto tensor_type = ort.GetTensorElementType(tensor_info);
@@ -942,14 +1394,15 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<onnxruntime:
       std::vector<OrtValue*> output_tensor(num_binding_outputs, nullptr);
       for (int i = 0, end = num_binding_outputs; i < end; ++i) {
         // Set dynamic shapes
-        nvinfer1::Dims dimensions = trt_context->getBindingDimensions(static_cast<int>(i + num_binding_inputs));
+        nvinfer1::Dims dimensions = trt_context->getBindingDimensions(binding_offset + i + num_binding_inputs);
         int nb_dims = dimensions.nbDims;
+        std::vector<int64_t> output_shape(nb_dims);
         for (int j = 0, end = nb_dims; j < end; ++j) {
-          trt_state->output_shapes[i][j] = dimensions.d[j];
+          output_shape[j] = dimensions.d[j];
         }
 
         int output_index = output_indexes[i];
-        output_tensor[i] = ort.KernelContext_GetOutput(context, output_index, trt_state->output_shapes[i].data(), trt_state->output_shapes[i].size());
+        output_tensor[i] = ort.KernelContext_GetOutput(context, output_index, output_shape.data(), output_shape.size());
 
         if (output_types[i] == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
           buffers[i + num_binding_inputs] = ort.GetTensorMutableData<float>(output_tensor[i]);
@@ -975,10 +1428,19 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<onnxruntime:
         }
       }
 
-      // Run TRT inference
-      if (!trt_context->enqueueV2(&buffers[0], nullptr, nullptr)) {
+      // Run TRT inference. A context of the pool runs on its own stream, forked from and joined back to the
+      // stream of the thread the inputs were produced on.
+      if (slot != nullptr) {
+        CUDA_RETURN_IF_ERROR(cudaEventRecord(slot->event, cudaStreamPerThread));
+        CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(slot->stream, slot->event, 0));
+      }
+      if (!trt_context->enqueueV2(all_buffers.data(), slot != nullptr ? slot->stream : nullptr, nullptr)) {
         return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "TensorRT EP Execution Context Enqueue Failed.");
       }
+      if (slot != nullptr) {
+        CUDA_RETURN_IF_ERROR(cudaEventRecord(slot->event, slot->stream));
+        CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(cudaStreamPerThread, slot->event, 0));
+      }
 
       // Cast INT64 input to INT32 because TensorRT doesn't fully support INT64
       for (int i = 0, end = num_binding_outputs; i < end; ++i) {
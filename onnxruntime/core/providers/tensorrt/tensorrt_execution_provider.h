@@ -7,6 +7,7 @@
 #include "core/framework/op_kernel.h"
 #include "NvInfer.h"
 #include "NvOnnxParser.h"
+#include "cuda_runtime_api.h"
 #include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
@@ -16,6 +17,12 @@ static const std::string kMaxPartitionIterations = "ORT_TENSORRT_MAX_PARTITION_I
 static const std::string kMinSubgraphSize = "ORT_TENSORRT_MIN_SUBGRAPH_SIZE";
 static const std::string kMaxWorkspaceSize = "ORT_TENSORRT_MAX_WORKSPACE_SIZE";
 static const std::string kFP16Enable = "ORT_TENSORRT_FP16_ENABLE";
+static const std::string kEngineCacheEnable = "ORT_TENSORRT_ENGINE_CACHE_ENABLE";
+static const std::string kEngineCachePath = "ORT_TENSORRT_ENGINE_CACHE_PATH";
+static const std::string kProfileShapes = "ORT_TENSORRT_PROFILE_SHAPES";
+static const std::string kINT8Enable = "ORT_TENSORRT_INT8_ENABLE";
+static const std::string kINT8CalibrationTable = "ORT_TENSORRT_INT8_CALIBRATION_TABLE";
+static const std::string kContextPoolSize = "ORT_TENSORRT_CONTEXT_POOL_SIZE";
 }  // namespace tensorrt_env_vars
 
 class TensorrtLogger : public nvinfer1::ILogger {
@@ -40,8 +47,67 @@ class TensorrtLogger : public nvinfer1::ILogger {
 // Information needed to construct trt execution providers.
 struct TensorrtExecutionProviderInfo {
   int device_id{0};
+  // Shape ranges of the dynamic inputs, one optimization profile each. Overrides ORT_TENSORRT_PROFILE_SHAPES.
+  // The profiles are separated by '|', the inputs of a profile by ';', an input is <name>:<min>,<opt>,<max>
+  // and the dims of a shape are separated by 'x', e.g. "ids:1x16,1x64,1x128;mask:1x16,1x64,1x128|ids:8x16,...".
+  std::string profile_shapes;
+  // Build the engines with FP16 and/or INT8 kernels where the GPU has fast ones, in addition to the environment
+  // variables ORT_TENSORRT_FP16_ENABLE and ORT_TENSORRT_INT8_ENABLE.
+  bool fp16_enable{false};
+  bool int8_enable{false};
+  // INT8 needs the dynamic range of the tensors, given by a text file with one "<tensor name> <max abs value>" line
+  // per tensor. The file is either written by tools/quantization/trt_calibration_table.py from sample feeds or
+  // supplied by the user. Overrides ORT_TENSORRT_INT8_CALIBRATION_TABLE.
+  std::string int8_calibration_table;
+  // Number of execution contexts per optimization profile of an engine, the Runs that use different contexts
+  // execute concurrently. Overrides ORT_TENSORRT_CONTEXT_POOL_SIZE, 0 keeps the environment variable or default.
+  int context_pool_size{0};
 };
 
+// Execution contexts of an engine that concurrent Runs use. Each context has its own device memory and its own
+// CUDA stream, and is bound to one of the optimization profiles of the engine: the contexts of user profile p are
+// bound to the engine profiles [p * pool size, (p + 1) * pool size), as TensorRT doesn't let two contexts use the
+// same profile of an engine with dynamic shapes. An engine without dynamic shapes has a single profile that all
+// its contexts share.
+class TensorrtContextPool {
+ public:
+  struct Slot {
+    nvinfer1::IExecutionContext* context;
+    int profile_index;
+    cudaStream_t stream;
+    // orders the work of the context after its inputs and the work of the Run after its outputs
+    cudaEvent_t event;
+    bool busy;
+  };
+
+  TensorrtContextPool(int num_user_profiles, int pool_size);
+  ~TensorrtContextPool();
+
+  // Adds a context, the contexts are added in the order of their profiles
+  Status AddContext(nvinfer1::IExecutionContext* context, int profile_index);
+
+  int NumUserProfiles() const { return num_user_profiles_; }
+
+  int PoolSize() const { return pool_size_; }
+
+  // Blocks until a context of the user profile is free
+  Slot& Acquire(int user_profile);
+
+  void Release(Slot& slot);
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(TensorrtContextPool);
+
+  const int num_user_profiles_;
+  const int pool_size_;
+  OrtMutex mutex_;
+  OrtCondVar cv_;
+  std::vector<Slot> slots_;
+};
+
+// min, opt and max dims of the inputs of an optimization profile, by input name
+using TensorrtProfileShapes = std::unordered_map<std::string, std::vector<std::vector<int64_t>>>;
+
 // Information to construct kernel function state.
 struct TensorrtFuncState {
   AllocateFunc test_allocate_func = nullptr;
@@ -58,7 +124,16 @@ struct TensorrtFuncState {
   std::vector<std::vector<int64_t>> output_shapes;
   OrtMutex* tensorrt_mu_ptr = nullptr;
   bool* fp16_enable_ptr = nullptr;
+  bool* int8_enable_ptr = nullptr;
   size_t* max_workspace_size_ptr = nullptr;
+  // engines are loaded from and saved to the cache if runtime is set, see TensorrtExecutionProvider::engine_cache_path_
+  nvinfer1::IRuntime* runtime = nullptr;
+  std::string engine_cache_path;
+  std::string engine_cache_key;
+  // Set if the engine was built with the user's optimization profiles or has no dynamic shapes. A Run takes a free
+  // context of the first user profile that covers the shapes of its inputs. Otherwise there's a single context
+  // with a single profile, rebuilt when an input shape exceeds it, and the Runs are serialized by tensorrt_mu_ptr.
+  TensorrtContextPool* context_pool = nullptr;
 };
 
 // Logical device representation.
@@ -86,6 +161,19 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   int max_partition_iterations_ = 1000;
   int min_subgraph_size_ = 1;
   bool fp16_enable_ = false;
+  bool int8_enable_ = false;
+  // dynamic range of the tensors for INT8, by tensor name. A layer with a tensor that has no range runs in FP16 or
+  // FP32 instead.
+  std::unordered_map<std::string, float> dynamic_ranges_;
+  // identifies the dynamic ranges in the engine cache key
+  std::string dynamic_ranges_hash_;
+  // Serialized engines are kept in engine_cache_path_, in files named after a hash of the fused subgraph, the
+  // TensorRT version, the GPU, the precision flags and the optimization profile. A later session that builds the
+  // same engine deserializes it instead.
+  bool engine_cache_enable_ = false;
+  std::string engine_cache_path_;
+  std::vector<TensorrtProfileShapes> profile_shapes_;
+  int context_pool_size_ = 1;
 
   struct InferDeleter {
     template <typename T>
@@ -100,6 +188,7 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   using unique_pointer = std::unique_ptr<T, InferDeleter>;
 
   OrtMutex tensorrt_mu_;
+  unique_pointer<nvinfer1::IRuntime> runtime_;
   int device_id_;
   std::unordered_map<std::string, unique_pointer<nvonnxparser::IParser>> parsers_;
   std::unordered_map<std::string, unique_pointer<nvinfer1::ICudaEngine>> engines_;
@@ -110,6 +199,10 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   std::unordered_map<std::string, std::vector<std::vector<int>>> output_info_;
   std::unordered_map<std::string, std::unordered_map<int, std::unordered_map<int, std::pair<int64_t, int64_t>>>> input_shape_ranges_;
   std::unordered_map<std::string, std::vector<std::vector<int64_t>>> output_shapes_;
+  std::unordered_map<std::string, std::string> engine_cache_keys_;
+  // the contexts of the pool other than the one in contexts_
+  std::unordered_map<std::string, std::vector<unique_pointer<nvinfer1::IExecutionContext>>> pool_contexts_;
+  std::unordered_map<std::string, std::unique_ptr<TensorrtContextPool>> context_pools_;
 
   /**Get IndexedSubGraph based on node list of the subgraph*/
   std::unique_ptr<IndexedSubGraph> GetSubGraph(SubGraph_t graph_nodes_index, int& kernels_index,
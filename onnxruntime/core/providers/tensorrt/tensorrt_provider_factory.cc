@@ -5,29 +5,34 @@
 #include <atomic>
 #include "tensorrt_execution_provider.h"
 #include "core/session/abi_session_options_impl.h"
+#include "core/framework/error_code_helper.h"
 
 using namespace onnxruntime;
 
 namespace onnxruntime {
 
 struct TensorrtProviderFactory : IExecutionProviderFactory {
-  TensorrtProviderFactory(int device_id) : device_id_(device_id) {}
+  TensorrtProviderFactory(const TensorrtExecutionProviderInfo& info) : info_(info) {}
   ~TensorrtProviderFactory() override {}
 
   std::unique_ptr<IExecutionProvider> CreateProvider() override;
 
  private:
-  int device_id_;
+  TensorrtExecutionProviderInfo info_;
 };
 
 std::unique_ptr<IExecutionProvider> TensorrtProviderFactory::CreateProvider() {
-  TensorrtExecutionProviderInfo info;
-  info.device_id = device_id_;
-  return onnxruntime::make_unique<TensorrtExecutionProvider>(info);
+  return onnxruntime::make_unique<TensorrtExecutionProvider>(info_);
 }
 
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Tensorrt(int device_id) {
-  return std::make_shared<onnxruntime::TensorrtProviderFactory>(device_id);
+  TensorrtExecutionProviderInfo info;
+  info.device_id = device_id;
+  return std::make_shared<onnxruntime::TensorrtProviderFactory>(info);
+}
+
+std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Tensorrt(const TensorrtExecutionProviderInfo& info) {
+  return std::make_shared<onnxruntime::TensorrtProviderFactory>(info);
 }
 }  // namespace onnxruntime
 
@@ -36,3 +41,29 @@ ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProvider_Tensorrt, _In_ OrtS
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProviderEx_Tensorrt, _In_ OrtSessionOptions* options, int device_id,
+                    _In_ const char* const* option_keys,
+                    _In_ const char* const* option_values, size_t num_options) {
+  TensorrtExecutionProviderInfo info;
+  info.device_id = device_id;
+  for (size_t i = 0; i < num_options; ++i) {
+    const std::string key = option_keys[i];
+    const std::string value = option_values[i];
+    if (key == "profile_shapes") {
+      info.profile_shapes = value;
+    } else if (key == "fp16_enable") {
+      info.fp16_enable = value != "0";
+    } else if (key == "int8_enable") {
+      info.int8_enable = value != "0";
+    } else if (key == "int8_calibration_table") {
+      info.int8_calibration_table = value;
+    } else if (key == "context_pool_size") {
+      info.context_pool_size = std::stoi(value);
+    } else {
+      return onnxruntime::ToOrtStatus(ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                                      "Unknown TensorRT provider option: ", key));
+    }
+  }
+  options->provider_factories.push_back(onnxruntime::CreateExecutionProviderFactory_Tensorrt(info));
+  return nullptr;
+}
@@ -7,6 +7,8 @@
 #include "core/framework/op_kernel.h"
 #include "core/framework/utils.h"
 
+#include <algorithm>
+
 namespace onnxruntime {
 IOBinding::IOBinding(const SessionState& session_state) : session_state_(session_state) {
 }
@@ -74,23 +76,95 @@ common::Status IOBinding::SynchronizeOutputs() {
 }
 
 common::Status IOBinding::BindOutput(const std::string& name, const OrtValue& ml_value) {
+  // a preallocated tensor stays where it is, Run() writes it in place
+  const OrtMemoryInfo location = ml_value.IsAllocated() && ml_value.IsTensor() ? ml_value.Get<Tensor>().Location()
+                                                                               : OrtMemoryInfo();
+
   auto rc = Contains(output_names_, name);
   if (rc.first) {
     outputs_[rc.second] = ml_value;
+    output_locations_[rc.second] = location;
     return Status::OK();
   }
 
   output_names_.push_back(name);
   outputs_.push_back(ml_value);
+  output_locations_.push_back(location);
+  return Status::OK();
+}
+
+common::Status IOBinding::BindOutput(const std::string& name, const OrtMemoryInfo& location) {
+  const auto& execution_providers = session_state_.GetExecutionProviders();
+  AllocatorPtr allocator = execution_providers.GetAllocator(location);
+  if (allocator == nullptr) {
+    // the arena and device allocators of a provider allocate on the same device
+    OrtMemoryInfo other_location = location;
+    other_location.alloc_type = location.alloc_type == OrtArenaAllocator ? OrtDeviceAllocator : OrtArenaAllocator;
+    allocator = execution_providers.GetAllocator(other_location);
+  }
+  if (allocator == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Can't bind output ", name, " to ", location,
+                           ". None of the execution providers of the session allocates there.");
+  }
+
+  ORT_RETURN_IF_ERROR(BindOutput(name, OrtValue()));
+  // keep the info of the allocator, whose name outlives the one of the caller
+  output_locations_[Contains(output_names_, name).second] = allocator->Info();
+  return Status::OK();
+}
+
+common::Status IOBinding::CopyOutputsToBoundLocations() {
+  const auto& execution_providers = session_state_.GetExecutionProviders();
+  const OrtMemoryInfo cpu_location = execution_providers.GetDefaultCpuMemoryInfo();
+
+  for (size_t i = 0; i < outputs_.size(); ++i) {
+    OrtValue& output = outputs_[i];
+    if (!output.IsTensor()) {
+      continue;
+    }
+
+    const OrtMemoryInfo& location = output_locations_[i].name != nullptr ? output_locations_[i] : cpu_location;
+    const Tensor& tensor = output.Get<Tensor>();
+    if (tensor.Location().device == location.device) {
+      continue;
+    }
+
+    auto new_tensor = onnxruntime::make_unique<Tensor>(tensor.DataType(), tensor.Shape(),
+                                                       execution_providers.GetAllocator(location));
+    ORT_RETURN_IF_ERROR(session_state_.GetDataTransferMgr().CopyTensor(tensor, *new_tensor));
+
+    auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+    output.Init(new_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+  }
+
   return Status::OK();
 }
 
+bool IOBinding::HasOutputsBoundToDevice() const {
+  return std::any_of(output_locations_.cbegin(), output_locations_.cend(), [](const OrtMemoryInfo& location) {
+    return location.name != nullptr && location.device.Type() != OrtDevice::CPU;
+  });
+}
+
+void IOBinding::ClearInputs() {
+  feed_names_.clear();
+  feeds_.clear();
+}
+
+void IOBinding::ClearOutputs() {
+  output_names_.clear();
+  outputs_.clear();
+  output_locations_.clear();
+}
+
 const std::vector<std::string>& IOBinding::GetOutputNames() const {
   return output_names_;
 }
 
 std::vector<OrtValue>& IOBinding::GetOutputs() { return outputs_; }
 
+const std::vector<OrtValue>& IOBinding::GetOutputs() const { return outputs_; }
+
 const std::vector<std::string>& IOBinding::GetInputNames() const {
   return feed_names_;
 }
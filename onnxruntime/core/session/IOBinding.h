@@ -63,11 +63,30 @@ class IOBinding {
     */
   common::Status BindOutput(const std::string& name, const OrtValue& ml_value);
 
+  /**
+    * Binds the output to a device instead of a value. Run() leaves the output on the device of the given location
+    * rather than copying it to CPU memory, and keeps it so the next Run() writes an output of the same shape in place.
+    */
+  common::Status BindOutput(const std::string& name, const OrtMemoryInfo& location);
+
+  /**
+    * Moves the outputs of Run() that are not at the location they are bound to there: the location given to
+    * BindOutput, or CPU memory for the outputs bound to a value that Run() allocated.
+    */
+  common::Status CopyOutputsToBoundLocations();
+
+  // true if an output is bound to a device other than CPU
+  bool HasOutputsBoundToDevice() const;
+
+  void ClearInputs();
+  void ClearOutputs();
+
   /**
     * This simply collects the outputs obtained after calling Run() inside the @param outputs.
     */
   const std::vector<std::string>& GetOutputNames() const;
   std::vector<OrtValue>& GetOutputs();
+  const std::vector<OrtValue>& GetOutputs() const;
 
   const std::vector<std::string>& GetInputNames() const;
   const std::vector<OrtValue>& GetInputs() const;
@@ -88,6 +107,9 @@ class IOBinding {
   std::vector<OrtValue> feeds_;
   std::vector<std::string> output_names_;
   std::vector<OrtValue> outputs_;
+  // location of each output: the device it's bound to or the location of its preallocated tensor. default
+  // constructed (null name) for the outputs bound to an empty value, which are returned in CPU memory.
+  std::vector<OrtMemoryInfo> output_locations_;
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBinding);
 };
@@ -160,3 +160,173 @@ ORT_API_STATUS_IMPL(OrtApis::DisablePerSessionThreads, _In_ OrtSessionOptions* o
   options->value.use_per_session_threads = false;
   return nullptr;
 }
+
+ORT_API_STATUS_IMPL(OrtApis::EnableEnvAllocators, _In_ OrtSessionOptions* options) {
+  options->value.use_env_allocators = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::EnableMemPatternBucketing, _In_ OrtSessionOptions* options,
+                    _In_opt_ const int64_t* bucket_boundaries, size_t num_boundaries) {
+  if (num_boundaries > 0 && bucket_boundaries == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "bucket_boundaries cannot be null if num_boundaries > 0");
+  }
+  for (size_t i = 0; i < num_boundaries; ++i) {
+    if (bucket_boundaries[i] <= 0 || (i > 0 && bucket_boundaries[i] <= bucket_boundaries[i - 1])) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                   "bucket_boundaries must be positive and in strictly increasing order");
+    }
+  }
+  options->value.enable_mem_pattern = true;
+  options->value.enable_mem_pattern_bucketing = true;
+  options->value.mem_pattern_bucket_boundaries.assign(bucket_boundaries, bucket_boundaries + num_boundaries);
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetThreadPoolSpinning, _In_ OrtSessionOptions* options, unsigned int spin_duration_us,
+                    int allow_worker_spinning) {
+  options->value.thread_pool_spin_duration_us = spin_duration_us;
+  options->value.allow_thread_pool_worker_spinning = allow_worker_spinning != 0;
+  return nullptr;
+}
+
+static OrtStatus* SetThreadAffinity(std::vector<size_t>& affinity, const size_t* logical_processors, size_t len) {
+  if (len > 0 && logical_processors == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "logical_processors cannot be null if len > 0");
+  }
+  affinity.assign(logical_processors, logical_processors + len);
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetIntraOpThreadAffinity, _In_ OrtSessionOptions* options,
+                    _In_ const size_t* logical_processors, size_t len) {
+  return SetThreadAffinity(options->value.intra_op_thread_affinity, logical_processors, len);
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetInterOpThreadAffinity, _In_ OrtSessionOptions* options,
+                    _In_ const size_t* logical_processors, size_t len) {
+  return SetThreadAffinity(options->value.inter_op_thread_affinity, logical_processors, len);
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetThreadPoolNumaNode, _In_ OrtSessionOptions* options, int numa_node) {
+  options->value.thread_pool_numa_node = numa_node < 0 ? -1 : numa_node;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetSessionStateCacheFilePath, _In_ OrtSessionOptions* options,
+                    _In_ const ORTCHAR_T* cache_file_path) {
+  options->value.session_state_cache_filepath = cache_file_path;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::DisablePrePacking, _In_ OrtSessionOptions* options) {
+  options->value.disable_prepacking = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::EnableEnvPrePackedWeights, _In_ OrtSessionOptions* options) {
+  options->value.use_env_prepacked_weights = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::EnableEnvSharedInitializers, _In_ OrtSessionOptions* options) {
+  options->value.use_env_shared_initializers = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::EnableOpStats, _In_ OrtSessionOptions* options) {
+  options->value.enable_op_stats = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::EnableMemoryProfiling, _In_ OrtSessionOptions* options) {
+  options->value.enable_memory_profiling = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::EnableCpuTuning, _In_ OrtSessionOptions* options,
+                    _In_opt_ const ORTCHAR_T* cache_file_path) {
+  options->value.enable_cpu_tuning = true;
+  options->value.cpu_tuning_cache_filepath = cache_file_path != nullptr ? cache_file_path : ORT_TSTR("");
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::EnableMemoryEfficientExecutionOrder, _In_ OrtSessionOptions* options) {
+  options->value.enable_memory_efficient_execution_order = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::AddFreeDimensionOverrideByName, _Inout_ OrtSessionOptions* options,
+                    _In_ const char* dim_name, _In_ int64_t dim_value) {
+  options->value.free_dimension_overrides.push_back(
+      onnxruntime::FreeDimensionOverride{dim_name, dim_value, onnxruntime::FreeDimensionOverrideType::Name});
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::EnableShapeSpecialization, _In_ OrtSessionOptions* options, int max_variants,
+                    int min_runs) {
+  if (max_variants < 0 || min_runs < 1) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "max_variants must be >= 0 and min_runs must be >= 1");
+  }
+  options->value.shape_specialization_max_variants = max_variants;
+  options->value.shape_specialization_min_runs = min_runs;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::EnableRunResultCache, _Inout_ OrtSessionOptions* options, size_t max_bytes) {
+  options->value.run_result_cache_max_bytes = max_bytes;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::AddStateBinding, _Inout_ OrtSessionOptions* options, _In_ const char* output_name,
+                    _In_ const char* input_name) {
+  if (output_name == nullptr || output_name[0] == '\0' || input_name == nullptr || input_name[0] == '\0') {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output_name and input_name cannot be empty");
+  }
+  options->value.state_bindings.emplace_back(output_name, input_name);
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::EnableCostBasedPartitioning, _Inout_ OrtSessionOptions* options, double host_gflops,
+                    double device_gflops, double copy_gbps) {
+  if (host_gflops < 0 || device_gflops < 0 || copy_gbps < 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "host_gflops, device_gflops and copy_gbps must be >= 0");
+  }
+  auto& cost_model = options->value.partitioning_cost_model;
+  if (host_gflops > 0) cost_model.host_gflops = host_gflops;
+  if (device_gflops > 0) cost_model.device_gflops = device_gflops;
+  if (copy_gbps > 0) cost_model.copy_gbps = copy_gbps;
+  options->value.enable_cost_based_partitioning = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::EnableLazyInitializerLoading, _In_ OrtSessionOptions* options) {
+  options->value.enable_lazy_initializer_loading = true;
+  return nullptr;
+}
+
+// the non empty items of a comma separated list
+static std::vector<std::string> SplitOpTypes(const char* op_types) {
+  std::vector<std::string> result;
+  std::string op_type;
+  for (const char* p = op_types;; ++p) {
+    if (*p == ',' || *p == '\0') {
+      if (!op_type.empty()) result.push_back(op_type);
+      op_type.clear();
+      if (*p == '\0') break;
+    } else if (*p != ' ') {
+      op_type.push_back(*p);
+    }
+  }
+  return result;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::EnableCudaMixedPrecision, _Inout_ OrtSessionOptions* options,
+                    _In_opt_ const char* allow_ops, _In_opt_ const char* deny_ops) {
+  API_IMPL_BEGIN
+  options->value.enable_cuda_mixed_precision = true;
+  options->value.mixed_precision_allow_ops = allow_ops ? SplitOpTypes(allow_ops) : std::vector<std::string>{};
+  options->value.mixed_precision_deny_ops = deny_ops ? SplitOpTypes(deny_ops) : std::vector<std::string>{};
+  return nullptr;
+  API_IMPL_END
+}
@@ -13,6 +13,9 @@
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/error_code_helper.h"
 #include "core/framework/tensor_type_and_shape.h"
+#include "core/platform/threadpool.h"
+
+#include <limits>
 
 ONNXTensorElementDataType MLDataTypeToOnnxRuntimeTensorElementDataType(const onnxruntime::DataTypeImpl* cpp_type);
 
@@ -51,6 +54,59 @@ ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetOutput, _Inout_ OrtKernelContext*
   return nullptr;
 };
 
+ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetThreadPool, _In_ const OrtKernelContext* context,
+                    _Outptr_result_maybenull_ OrtThreadPool** out) {
+  *out = reinterpret_cast<OrtThreadPool*>(
+      reinterpret_cast<const onnxruntime::OpKernelContextInternal*>(context)->GetOperatorThreadPool());
+  return nullptr;
+};
+
+ORT_API_STATUS_IMPL(OrtApis::ThreadPool_GetDegreeOfParallelism, _In_opt_ const OrtThreadPool* pool, _Out_ int* out) {
+  auto* tp = reinterpret_cast<const onnxruntime::concurrency::ThreadPool*>(pool);
+  // the calling thread takes part in ParallelFor
+  *out = tp == nullptr ? 1 : tp->NumThreads() + 1;
+  return nullptr;
+};
+
+ORT_API_STATUS_IMPL(OrtApis::ThreadPool_ParallelFor, _In_opt_ OrtThreadPool* pool, size_t total,
+                    _In_ void(ORT_API_CALL* fn)(void* user_data, size_t index), _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  if (total > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "ThreadPool_ParallelFor: total is larger than INT32_MAX");
+  onnxruntime::concurrency::ThreadPool::TryParallelFor(
+      reinterpret_cast<onnxruntime::concurrency::ThreadPool*>(pool), static_cast<int32_t>(total),
+      [fn, user_data](int32_t i) { fn(user_data, static_cast<size_t>(i)); });
+  return nullptr;
+  API_IMPL_END
+};
+
+ORT_API_STATUS_IMPL(OrtApis::KernelContext_Allocate, _In_ const OrtKernelContext* context, size_t size,
+                    _Outptr_ void** out) {
+  API_IMPL_BEGIN
+  onnxruntime::AllocatorPtr allocator;
+  auto status = reinterpret_cast<const onnxruntime::OpKernelContextInternal*>(context)->GetTempSpaceAllocator(
+      &allocator);
+  if (!status.IsOK())
+    return onnxruntime::ToOrtStatus(status);
+  *out = allocator->Alloc(size);
+  return nullptr;
+  API_IMPL_END
+};
+
+ORT_API_STATUS_IMPL(OrtApis::KernelContext_Free, _In_ const OrtKernelContext* context, _In_opt_ void* p) {
+  API_IMPL_BEGIN
+  if (p == nullptr)
+    return nullptr;
+  onnxruntime::AllocatorPtr allocator;
+  auto status = reinterpret_cast<const onnxruntime::OpKernelContextInternal*>(context)->GetTempSpaceAllocator(
+      &allocator);
+  if (!status.IsOK())
+    return onnxruntime::ToOrtStatus(status);
+  allocator->Free(p);
+  return nullptr;
+  API_IMPL_END
+};
+
 ORT_API_STATUS_IMPL(OrtApis::KernelInfoGetAttribute_string, _In_ const OrtKernelInfo* info, _In_ const char* name, _Out_ char* out, _Inout_ size_t* size) {
   std::string value;
   auto status = reinterpret_cast<const onnxruntime::OpKernelInfo*>(info)->GetAttr<std::string>(name, &value);
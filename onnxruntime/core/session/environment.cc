@@ -3,6 +3,8 @@
 
 #include "core/session/environment.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/prepacked_weights_container.h"
+#include "core/framework/shared_initializer_store.h"
 #include "core/graph/constants.h"
 #include "core/graph/op.h"
 #include "onnx/defs/operator_sets.h"
@@ -39,20 +41,59 @@ Status Environment::Create(std::unique_ptr<logging::LoggingManager> logging_mana
   return status;
 }
 
+Status Environment::RegisterAllocator(AllocatorPtr allocator) {
+  ORT_RETURN_IF_NOT(allocator != nullptr, "allocator is null");
+  const auto& info = allocator->Info();
+  for (const auto& registered : shared_allocators_) {
+    if (registered->Info() == info) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, info, " allocator already registered.");
+    }
+  }
+
+  shared_allocators_.push_back(std::move(allocator));
+  return Status::OK();
+}
+
 Status Environment::Initialize(std::unique_ptr<logging::LoggingManager> logging_manager,
                                const ThreadingOptions* tp_options,
                                bool create_global_thread_pools) {
   auto status = Status::OK();
 
   logging_manager_ = std::move(logging_manager);
+  prepacked_weights_container_ = std::make_shared<PrepackedWeightsContainer>();
+  shared_initializer_store_ = std::make_shared<SharedInitializerStore>();
 
   // create thread pools
   if (create_global_thread_pools) {
     create_global_thread_pools_ = true;
+    const int numa_node = tp_options->pin_to_numa_node ? tp_options->numa_node : -1;
+
+    concurrency::ThreadOptions intra_op_thread_options;
+    intra_op_thread_options.allow_spinning = tp_options->disable_worker_spinning == 0;
+    intra_op_thread_options.spin_duration_us = tp_options->spin_duration_us;
+    if (tp_options->intra_op_thread_affinity != nullptr) {
+      intra_op_thread_options.affinity.assign(tp_options->intra_op_thread_affinity,
+                                              tp_options->intra_op_thread_affinity +
+                                                  tp_options->intra_op_thread_affinity_len);
+    }
+    ORT_RETURN_IF_ERROR(concurrency::SetNumaNodeAffinity(numa_node, intra_op_thread_options));
+
+    concurrency::ThreadOptions inter_op_thread_options;
+    inter_op_thread_options.allow_spinning = intra_op_thread_options.allow_spinning;
+    inter_op_thread_options.spin_duration_us = tp_options->spin_duration_us;
+    if (tp_options->inter_op_thread_affinity != nullptr) {
+      inter_op_thread_options.affinity.assign(tp_options->inter_op_thread_affinity,
+                                              tp_options->inter_op_thread_affinity +
+                                                  tp_options->inter_op_thread_affinity_len);
+    }
+    ORT_RETURN_IF_ERROR(concurrency::SetNumaNodeAffinity(numa_node, inter_op_thread_options));
+
     intra_op_thread_pool_ = concurrency::CreateThreadPool("env_global_intra_op_thread_pool",
-                                                          tp_options->intra_op_num_threads);
+                                                          tp_options->intra_op_num_threads,
+                                                          intra_op_thread_options);
     inter_op_thread_pool_ = concurrency::CreateThreadPool("env_global_inter_op_thread_pool",
-                                                          tp_options->inter_op_num_threads);
+                                                          tp_options->inter_op_num_threads,
+                                                          inter_op_thread_options);
   }
 
   try {
@@ -4,6 +4,8 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <sstream>
 #include <unordered_set>
@@ -14,6 +16,7 @@
 #include "core/common/logging/logging.h"
 #include "core/platform/notification.h"
 #include "core/platform/threadpool.h"
+#include "core/platform/tracing.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/graph_utils.h"
 #include "core/graph/model.h"
@@ -32,12 +35,14 @@
 #include "core/framework/sequential_executor.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/parallel_executor.h"
+#include "core/framework/run_scheduler.h"
 #include "core/framework/session_state_initializer.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/tensor_type_and_shape.h"
 #include "core/framework/utils.h"
 #include "core/optimizer/transformer_memcpy.h"
+#include "core/optimizer/auto_mixed_precision_transformer.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/insert_cast_transformer.h"
 #include "core/optimizer/transformer_memcpy.h"
@@ -53,6 +58,7 @@
 #include "core/optimizer/graph_transformer_utils.h"
 #include "core/util/thread_utils.h"
 #include "core/session/inference_session_utils.h"
+#include "core/session/session_state_cache.h"
 #include "core/platform/ort_mutex.h"
 
 using namespace ONNX_NAMESPACE;
@@ -170,6 +176,7 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
   // after the invocation of FinalizeSessionOptions.
   logging_manager_ = session_env.GetLoggingManager();
   InitLogger(logging_manager_);  // this sets session_logger_ so that it can be used for logging after this point.
+  session_env_ = &session_env;
 
   // Update the number of steps for the graph transformer manager using the "finalized" session options
   graph_transformation_mgr_.SetSteps(session_options_.max_num_graph_transformation_steps);
@@ -177,13 +184,33 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
 
   if (use_per_session_threads_) {
     LOGS(*session_logger_, INFO) << "Creating and using per session threadpools since use_per_session_threads_ is true";
+    concurrency::ThreadOptions intra_op_thread_options;
+    intra_op_thread_options.allow_spinning = session_options_.allow_thread_pool_worker_spinning;
+    intra_op_thread_options.spin_duration_us = session_options_.thread_pool_spin_duration_us;
+    intra_op_thread_options.affinity = session_options_.intra_op_thread_affinity;
+    ORT_THROW_IF_ERROR(concurrency::SetNumaNodeAffinity(session_options_.thread_pool_numa_node,
+                                                        intra_op_thread_options));
     thread_pool_ = concurrency::CreateThreadPool("intra_op_thread_pool",
-                                                 session_options_.intra_op_num_threads);
-
-    inter_op_thread_pool_ = session_options_.execution_mode == ExecutionMode::ORT_PARALLEL
-                                ? concurrency::CreateThreadPool("inter_op_thread_pool",
-                                                                session_options_.inter_op_num_threads)
-                                : nullptr;
+                                                 session_options_.intra_op_num_threads,
+                                                 intra_op_thread_options);
+
+    if (session_options_.execution_mode == ExecutionMode::ORT_PARALLEL) {
+      concurrency::ThreadOptions inter_op_thread_options;
+      inter_op_thread_options.allow_spinning = session_options_.allow_thread_pool_worker_spinning;
+      inter_op_thread_options.spin_duration_us = session_options_.thread_pool_spin_duration_us;
+      inter_op_thread_options.affinity = session_options_.inter_op_thread_affinity;
+      ORT_THROW_IF_ERROR(concurrency::SetNumaNodeAffinity(session_options_.thread_pool_numa_node,
+                                                          inter_op_thread_options));
+      inter_op_thread_pool_ = concurrency::CreateThreadPool("inter_op_thread_pool",
+                                                            session_options_.inter_op_num_threads,
+                                                            inter_op_thread_options);
+    } else {
+      inter_op_thread_pool_ = nullptr;
+    }
+  } else if (parent_session_ != nullptr) {
+    LOGS(*session_logger_, INFO) << "Using the threadpools of the session this shape-specialized variant belongs to";
+    intra_op_thread_pool_from_env_ = parent_session_->GetIntraOpThreadPoolToUse();
+    inter_op_thread_pool_from_env_ = parent_session_->GetInterOpThreadPoolToUse();
   } else {
     LOGS(*session_logger_, INFO) << "Using global/env threadpools since use_per_session_threads_ is false";
     intra_op_thread_pool_from_env_ = session_env.GetIntraOpThreadPool();
@@ -193,17 +220,59 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
                 " threadpools, the env must be created with the the CreateEnvWithGlobalThreadPools API.");
   }
 
+  if (session_options_.use_env_allocators) {
+    env_allocators_ = session_env.GetRegisteredSharedAllocators();
+  }
+
+  if (session_options_.use_env_prepacked_weights) {
+    prepacked_weights_container_ = session_env.GetPrepackedWeightsContainer();
+  }
+
+  if (session_options_.use_env_shared_initializers) {
+    shared_initializer_store_ = session_env.GetSharedInitializerStore();
+  }
+
+  if (session_options_.enable_cpu_tuning) {
+    cpu_tuning_cache_ = std::make_shared<CpuTuningCache>(session_options_.cpu_tuning_cache_filepath);
+    // a cache that can't be read only costs the measurements
+    auto cache_status = cpu_tuning_cache_->Load();
+    if (!cache_status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Failed to read the CPU tuning cache: " << cache_status.ErrorMessage();
+    }
+  }
+
   session_state_ = onnxruntime::make_unique<SessionState>(execution_providers_,
                                                           session_options_.enable_mem_pattern &&
                                                               session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL,
                                                           GetIntraOpThreadPoolToUse(),
                                                           GetInterOpThreadPoolToUse());
 
+  if (session_options_.enable_mem_pattern_bucketing) {
+    session_state_->EnableMemoryPatternBucketing(session_options_.mem_pattern_bucket_boundaries);
+  }
+
+  if (!session_options_.disable_prepacking) {
+    session_state_->EnablePrePacking(prepacked_weights_container_.get());
+  }
+
+  session_state_->SetSharedInitializerStore(shared_initializer_store_.get());
+
+  session_state_->SetEnableMemoryEfficientExecutionOrder(session_options_.enable_memory_efficient_execution_order);
+
   session_state_->SetLogger(*session_logger_);
   session_state_->SetDataTransferMgr(&data_transfer_mgr_);
   session_profiler_.Initialize(session_logger_);
   session_state_->SetProfiler(session_profiler_);
+  if (session_options_.enable_op_stats) {
+    op_stats_collector_ = onnxruntime::make_unique<OpStatsCollector>();
+    session_state_->SetOpStatsCollector(op_stats_collector_.get());
+  }
+  session_state_->SetEnableMemoryProfiling(session_options_.enable_memory_profiling);
   if (session_options_.enable_profiling) {
+    if (session_options_.profiling_sampling_interval > 0) {
+      session_profiler_.EnableSampling(session_options_.profiling_sampling_interval,
+                                       std::chrono::milliseconds(session_options_.profiling_flush_interval_ms));
+    }
     StartProfiling(session_options_.profile_file_prefix);
   }
 
@@ -226,7 +295,9 @@ InferenceSession::InferenceSession(const SessionOptions& session_options,
     : graph_transformation_mgr_(session_options.max_num_graph_transformation_steps),
       insert_cast_transformer_("CastFloat16Transformer") {
   model_location_ = ToWideString(model_uri);
-  auto status = Model::Load(model_location_, model_proto_);
+  auto status = session_options.enable_lazy_initializer_loading
+                    ? Model::LoadReferencingInitializerData(model_location_, model_proto_)
+                    : Model::Load(model_location_, model_proto_);
   ORT_ENFORCE(status.IsOK(), "Given model could not be parsed while creating inference session. Error message: ",
               status.ErrorMessage());
   model_loaded_ = true;
@@ -241,7 +312,9 @@ InferenceSession::InferenceSession(const SessionOptions& session_options,
     : graph_transformation_mgr_(session_options.max_num_graph_transformation_steps),
       insert_cast_transformer_("CastFloat16Transformer") {
   model_location_ = ToWideString(model_uri);
-  auto status = Model::Load(model_location_, model_proto_);
+  auto status = session_options.enable_lazy_initializer_loading
+                    ? Model::LoadReferencingInitializerData(model_location_, model_proto_)
+                    : Model::Load(model_location_, model_proto_);
   ORT_ENFORCE(status.IsOK(), "Given model could not be parsed while creating inference session. Error message: ",
               status.ErrorMessage());
   model_loaded_ = true;
@@ -276,7 +349,22 @@ InferenceSession::InferenceSession(const SessionOptions& session_options,
   ConstructorCommon(session_options, session_env);
 }
 
+InferenceSession::InferenceSession(const SessionOptions& session_options,
+                                   const Environment& session_env,
+                                   const InferenceSession& parent_session)
+    : graph_transformation_mgr_(session_options.max_num_graph_transformation_steps),
+      insert_cast_transformer_("CastFloat16Transformer") {
+  parent_session_ = &parent_session;
+  ConstructorCommon(session_options, session_env);
+}
+
 InferenceSession::~InferenceSession() {
+  // the pending RunAsync calls use the session until their callback returns
+  {
+    std::unique_lock<OrtMutex> lock(async_runs_mutex_);
+    async_runs_done_.wait(lock, [this]() { return num_async_runs_ == 0; });
+  }
+
   if (session_options_.enable_profiling) {
     try {
       EndProfiling();
@@ -292,8 +380,14 @@ InferenceSession::~InferenceSession() {
     }
   }
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
-  if (session_activity_started_) TraceLoggingWriteStop(session_activity, "OrtInferenceSessionActivity");
+  if (session_activity_started_) ORT_TRACE_SESSION_STOP(session_id_);
 #endif
+
+  if (shared_initializer_store_ != nullptr) {
+    // release the initializers of this session so the ones no other session uses are freed
+    session_state_.reset();
+    shared_initializer_store_->ReleaseUnused();
+  }
 }
 
 common::Status InferenceSession::RegisterExecutionProvider(std::unique_ptr<IExecutionProvider> p_exec_provider) {
@@ -322,6 +416,19 @@ common::Status InferenceSession::RegisterExecutionProvider(std::unique_ptr<IExec
     }
   }
 
+  if (session_options_.use_env_allocators) {
+    for (const auto& allocator : env_allocators_) {
+      if (p_exec_provider->ReplaceAllocator(allocator)) {
+        LOGS(*session_logger_, INFO) << "Using allocator registered on the env for " << allocator->Info()
+                                     << " in execution provider " << provider_type;
+      }
+    }
+  }
+
+  if (provider_type == onnxruntime::kCpuExecutionProvider && cpu_tuning_cache_ != nullptr) {
+    static_cast<CPUExecutionProvider*>(p_exec_provider.get())->SetTuningCache(cpu_tuning_cache_);
+  }
+
   p_exec_provider->SetLogger(session_logger_);
   return execution_providers_.Add(provider_type, std::move(p_exec_provider));
 }
@@ -385,6 +492,11 @@ common::Status InferenceSession::Load(std::function<common::Status(std::shared_p
     status = DoPostLoadProcessing(*model_);
     ORT_RETURN_IF_ERROR_SESSIONID_(status);
 
+    // the shape-specialized variants load the model as it is before the graph transformations
+    if (session_options_.shape_specialization_max_variants > 0 && model_location_.empty()) {
+      model_data_for_variants_ = model_->ToProto().SerializeAsString();
+    }
+
     // all steps complete, mark the model as loaded.
     is_model_loaded_ = true;
 
@@ -414,8 +526,16 @@ common::Status InferenceSession::Load(const std::basic_string<T>& model_uri) {
       AddCustomOpDomains({domain.get()});
     }
 #endif
-    return onnxruntime::Model::Load(model_location_, model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
-                                    *session_logger_);
+    ModelProto model_proto;
+    {
+      profiling::ScopedSessionEvent event(&session_profiler_, "model_protobuf_parsing");
+      ORT_RETURN_IF_ERROR(session_options_.enable_lazy_initializer_loading
+                              ? onnxruntime::Model::LoadReferencingInitializerData(model_location_, model_proto)
+                              : onnxruntime::Model::Load(model_location_, model_proto));
+    }
+    profiling::ScopedSessionEvent event(&session_profiler_, "graph_building");
+    return onnxruntime::Model::Load(std::move(model_proto), model_location_, model,
+                                    HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_);
   };
 
   common::Status st = Load(loader, "model_loading_uri");
@@ -463,6 +583,7 @@ common::Status InferenceSession::Load(const ModelProto& model_proto) {
       AddCustomOpDomains({domain.get()});
     }
 #endif
+    profiling::ScopedSessionEvent event(&session_profiler_, "graph_building");
     // This call will create a copy of model_proto and the constructed model instance will own the copy thereafter
     return onnxruntime::Model::Load(model_proto, PathString(), model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
                                     *session_logger_);
@@ -485,6 +606,7 @@ common::Status InferenceSession::Load(std::unique_ptr<ModelProto> p_model_proto)
       AddCustomOpDomains({domain.get()});
     }
 #endif
+    profiling::ScopedSessionEvent event(&session_profiler_, "graph_building");
     return onnxruntime::Model::Load(std::move(*p_model_proto), PathString(), model,
                                     HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_);
   };
@@ -502,8 +624,12 @@ common::Status InferenceSession::Load(std::istream& model_istream) {
   auto loader = [this, &model_istream](std::shared_ptr<onnxruntime::Model>& model) {
     ModelProto model_proto;
 
-    google::protobuf::io::IstreamInputStream zero_copy_input(&model_istream);
-    const bool result = model_proto.ParseFromZeroCopyStream(&zero_copy_input) && model_istream.eof();
+    bool result;
+    {
+      profiling::ScopedSessionEvent event(&session_profiler_, "model_protobuf_parsing");
+      google::protobuf::io::IstreamInputStream zero_copy_input(&model_istream);
+      result = model_proto.ParseFromZeroCopyStream(&zero_copy_input) && model_istream.eof();
+    }
     if (!result) {
       return Status(common::ONNXRUNTIME, common::INVALID_PROTOBUF,
                     "Failed to load model because protobuf parsing failed.");
@@ -514,6 +640,7 @@ common::Status InferenceSession::Load(std::istream& model_istream) {
       AddCustomOpDomains({domain.get()});
     }
 #endif
+    profiling::ScopedSessionEvent event(&session_profiler_, "graph_building");
     return onnxruntime::Model::Load(std::move(model_proto), PathString(), model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
                                     *session_logger_);
   };
@@ -531,7 +658,11 @@ common::Status InferenceSession::Load(const void* model_data, int model_data_len
   auto loader = [this, model_data, model_data_len](std::shared_ptr<onnxruntime::Model>& model) {
     ModelProto model_proto;
 
-    const bool result = model_proto.ParseFromArray(model_data, model_data_len);
+    bool result;
+    {
+      profiling::ScopedSessionEvent event(&session_profiler_, "model_protobuf_parsing");
+      result = model_proto.ParseFromArray(model_data, model_data_len);
+    }
     if (!result) {
       return Status(common::ONNXRUNTIME, common::INVALID_PROTOBUF,
                     "Failed to load model because protobuf parsing failed.");
@@ -543,6 +674,7 @@ common::Status InferenceSession::Load(const void* model_data, int model_data_len
     }
 #endif
 
+    profiling::ScopedSessionEvent event(&session_profiler_, "graph_building");
     return onnxruntime::Model::Load(std::move(model_proto), PathString(), model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
                                     *session_logger_);
   };
@@ -564,6 +696,7 @@ common::Status InferenceSession::Load() {
       AddCustomOpDomains({domain.get()});
     }
 #endif
+    profiling::ScopedSessionEvent event(&session_profiler_, "graph_building");
     // Pass on ownership of the parsed ModelProto to the Model instance (its job here is done by this stage)
     return Model::Load(std::move(this->model_proto_), model_location_, model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
                        *session_logger_);
@@ -586,7 +719,11 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph,
   // 5. insert cast nodes.
 
   // first apply global(execution provider independent),  level 1(default/system/basic) graph to graph optimizations
-  ORT_RETURN_IF_ERROR_SESSIONID_(graph_transformer_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *session_logger_));
+  {
+    profiling::ScopedSessionEvent event(&session_profiler_, "graph_transformers_level_1_before_partitioning");
+    ORT_RETURN_IF_ERROR_SESSIONID_(graph_transformer_mgr.ApplyTransformers(graph, TransformerLevel::Level1,
+                                                                           *session_logger_));
+  }
 
 #ifdef USE_DML
   // TODO: this is a temporary workaround to apply the DML EP's custom graph transformer prior to partitioning. This
@@ -606,17 +743,38 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph,
 
   // Do partitioning based on execution providers' capability.
   GraphPartitioner partitioner(kernel_registry_manager, providers);
-  ORT_RETURN_IF_ERROR_SESSIONID_(partitioner.Partition(graph, session_state.ExportDll(), session_state.GetMutableFuncMgr()));
+  partitioner.SetProfiler(&session_profiler_);
+  if (session_options_.enable_cost_based_partitioning) {
+    partitioner.SetCostModel(&session_options_.partitioning_cost_model);
+  }
+  {
+    profiling::ScopedSessionEvent event(&session_profiler_, "graph_partitioning");
+    ORT_RETURN_IF_ERROR_SESSIONID_(partitioner.Partition(graph, session_state.ExportDll(),
+                                                         session_state.GetMutableFuncMgr()));
+  }
 
   // apply transformers except default transformers
   // Default transformers are required for correctness and they are owned and run by inference session
   for (int i = static_cast<int>(TransformerLevel::Level1); i <= static_cast<int>(TransformerLevel::MaxLevel); i++) {
+    profiling::ScopedSessionEvent event(&session_profiler_, "graph_transformers_level_" + std::to_string(i));
     ORT_RETURN_IF_ERROR_SESSIONID_(graph_transformer_mgr.ApplyTransformers(graph, static_cast<TransformerLevel>(i), *session_logger_));
   }
 
   bool modified = false;
+  if (session_options_.enable_cuda_mixed_precision && providers.Get(kCudaExecutionProvider) != nullptr) {
+    profiling::ScopedSessionEvent event(&session_profiler_, "auto_mixed_precision");
+    AutoMixedPrecisionTransformer mixed_precision_transformer(
+        kernel_registry_manager,
+        {session_options_.mixed_precision_allow_ops.begin(), session_options_.mixed_precision_allow_ops.end()},
+        {session_options_.mixed_precision_deny_ops.begin(), session_options_.mixed_precision_deny_ops.end()});
+    ORT_RETURN_IF_ERROR_SESSIONID_(mixed_precision_transformer.Apply(graph, modified, *session_logger_));
+  }
+
   // Insert cast node/s.
-  ORT_RETURN_IF_ERROR_SESSIONID_(insert_cast_transformer.Apply(graph, modified, *session_logger_));
+  {
+    profiling::ScopedSessionEvent event(&session_profiler_, "cast_insertion");
+    ORT_RETURN_IF_ERROR_SESSIONID_(insert_cast_transformer.Apply(graph, modified, *session_logger_));
+  }
 
   // Now every node should be already assigned to an execution provider
   std::unordered_map<std::string, std::vector<std::string>> node_placements;
@@ -665,6 +823,7 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph,
 
   // Insert copy node/s.
   MemcpyTransformer copy_transformer{provider_types, kernel_registry_manager};
+  profiling::ScopedSessionEvent event(&session_profiler_, "copy_insertion");
   ORT_RETURN_IF_ERROR_SESSIONID_(copy_transformer.Apply(graph, modified, *session_logger_));
 
   return common::Status::OK();
@@ -684,11 +843,19 @@ common::Status InferenceSession::CreateSubgraphSessionState(Graph& graph, Sessio
                                                                            session_state.GetThreadPool(),
                                                                            session_state.GetInterOpThreadPool());
       subgraph_session_state->SetProfiler(session_profiler_);
+      subgraph_session_state->SetOpStatsCollector(session_state.GetOpStatsCollector());
+      subgraph_session_state->SetEnableMemoryProfiling(session_state.GetEnableMemoryProfiling());
       subgraph_session_state->SetLogger(*session_logger_);
       // Pass data transfer manager to subgraph.
       subgraph_session_state->SetDataTransferMgr(&session_state.GetDataTransferMgr());
       // Pass fused function manager to subgraph
       subgraph_session_state->GetMutableFuncMgr().SetFusedFuncs(session_state.GetFuncMgr());
+      if (session_state.GetEnablePrePacking()) {
+        subgraph_session_state->EnablePrePacking(session_state.GetPrepackedWeightsContainer());
+      }
+      subgraph_session_state->SetSharedInitializerStore(session_state.GetSharedInitializerStore());
+      subgraph_session_state->SetEnableMemoryEfficientExecutionOrder(
+          session_state.GetEnableMemoryEfficientExecutionOrder());
 
       // recurse
       ORT_RETURN_IF_ERROR_SESSIONID_(CreateSubgraphSessionState(*subgraph, *subgraph_session_state));
@@ -792,6 +959,17 @@ static bool ModelHasFP16Inputs(const Graph& graph) {
   return false;
 }
 
+// The device work of a Run can only be recorded and replayed if no part of it runs on the host.
+static bool CanCaptureWholeGraph(const Graph& graph, const std::string& provider_type) {
+  for (const auto& node : graph.Nodes()) {
+    if (node.GetExecutionProviderType() != provider_type || node.ContainsSubgraph() ||
+        node.OpType() == "MemcpyFromHost" || node.OpType() == "MemcpyToHost") {
+      return false;
+    }
+  }
+  return true;
+}
+
 common::Status InferenceSession::Initialize() {
   Status status = Status::OK();
   TimePoint tp;
@@ -813,13 +991,14 @@ common::Status InferenceSession::Initialize() {
       return common::Status::OK();
     }
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
-    TraceLoggingWriteStart(session_activity, "OrtInferenceSessionActivity");
+    ORT_TRACE_SESSION_START(session_id_);
     session_activity_started_ = true;
 #endif
     // Register default CPUExecutionProvider if user didn't provide it through the Register() calls
     if (!execution_providers_.Get(onnxruntime::kCpuExecutionProvider)) {
       LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
-      CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+      // keep the weights and the scratch memory on the NUMA node the session threads are pinned to
+      CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena, session_options_.thread_pool_numa_node};
       auto p_cpu_exec_provider = onnxruntime::make_unique<CPUExecutionProvider>(epi);
       ORT_RETURN_IF_ERROR_SESSIONID_(RegisterExecutionProvider(std::move(p_cpu_exec_provider)));
     }
@@ -833,11 +1012,18 @@ common::Status InferenceSession::Initialize() {
                             "for the registered CUDA Execution Provider.");
     }
 
+    // merge the device events of the providers into the session profile
+    for (const auto& execution_provider : execution_providers_) {
+      auto device_profiler = execution_provider->GetProfiler();
+      if (device_profiler) {
+        session_profiler_.AddDeviceProfiler(std::move(device_profiler));
+      }
+    }
+
     // add predefined transformers
     AddPredefinedTransformers(graph_transformation_mgr_, session_options_.graph_optimization_level,
                               transformers_to_enable_);
-
-    onnxruntime::Graph& graph = model_->MainGraph();
+    graph_transformation_mgr_.SetProfiler(&session_profiler_);
 
     // Collect the kernel registries from execution provider instances;
     // There are 2 kinds of kernel registries with priority from high to low as below,
@@ -849,20 +1035,67 @@ common::Status InferenceSession::Initialize() {
     // Register 2nd registries into KernelRegistryManager.
     ORT_RETURN_IF_ERROR_SESSIONID_(kernel_registry_manager_.RegisterKernels(execution_providers_));
 
-    SessionStateInitializer session_initializer(session_options_.enable_mem_pattern, model_location_, graph,
+    // replace the model with the transformed and partitioned graph from the cache if there's one for this model
+    std::string session_state_cache_key;
+    bool loaded_from_cache = false;
+    if (!session_options_.session_state_cache_filepath.empty()) {
+      session_state_cache_key = session_state_cache::ComputeKey(*model_, session_options_, execution_providers_.GetIds(),
+                                                                transformers_to_enable_);
+      ORT_RETURN_IF_ERROR_SESSIONID_(session_state_cache::Load(
+          session_options_.session_state_cache_filepath, session_state_cache_key,
+          HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_, model_, loaded_from_cache));
+      if (loaded_from_cache) {
+        LOGS(*session_logger_, INFO) << "Using the transformed graph from the session state cache.";
+      }
+    }
+
+    onnxruntime::Graph& graph = model_->MainGraph();
+
+    // the initializers of a graph from the cache are in the data file of the cache
+    const auto& initializers_location =
+        loaded_from_cache ? session_options_.session_state_cache_filepath : model_location_;
+    SessionStateInitializer session_initializer(session_options_.enable_mem_pattern, initializers_location, graph,
                                                 *session_state_, execution_providers_, kernel_registry_manager_);
 
     // create SessionState for subgraphs as it's needed by the transformers
     ORT_RETURN_IF_ERROR_SESSIONID_(CreateSubgraphSessionState(graph, *session_state_));
 
-    // apply any transformations to the main graph and any subgraphs
-    ORT_RETURN_IF_ERROR_SESSIONID_(TransformGraph(graph, graph_transformation_mgr_,
-                                                  execution_providers_, kernel_registry_manager_,
-                                                  insert_cast_transformer_,
-                                                  *session_state_));
+    if (!loaded_from_cache) {
+      // apply any transformations to the main graph and any subgraphs
+      ORT_RETURN_IF_ERROR_SESSIONID_(TransformGraph(graph, graph_transformation_mgr_,
+                                                    execution_providers_, kernel_registry_manager_,
+                                                    insert_cast_transformer_,
+                                                    *session_state_));
+
+      // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
+      {
+        profiling::ScopedSessionEvent event(&session_profiler_, "graph_resolve");
+        ORT_RETURN_IF_ERROR_SESSIONID_(graph.Resolve());
+      }
 
-    // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
-    ORT_RETURN_IF_ERROR_SESSIONID_(graph.Resolve());
+      for (const auto& entry : graph_transformation_mgr_.GetStats()) {
+        const auto& stats = entry.second;
+        LOGS(*session_logger_, INFO) << "Graph transformer " << entry.first << " applied " << stats.num_applied
+                                     << " times in " << stats.duration_us << "us, modified the graph "
+                                     << stats.num_modified << " times, added " << stats.num_nodes_added
+                                     << " nodes and removed " << stats.num_nodes_removed << " nodes.";
+      }
+
+      if (!session_state_cache_key.empty()) {
+        if (session_state_cache::CanCache(graph)) {
+          // failing to write the cache only costs the next session its start up time
+          auto cache_status = session_state_cache::Save(*model_, session_state_cache_key, model_location_,
+                                                        session_options_.session_state_cache_filepath);
+          if (!cache_status.IsOK()) {
+            LOGS(*session_logger_, WARNING) << "Failed to write the session state cache: "
+                                            << cache_status.ErrorMessage();
+          }
+        } else {
+          LOGS(*session_logger_, INFO) << "The session state isn't cached as the graph has subgraphs or nodes "
+                                          "compiled by an execution provider.";
+        }
+      }
+    }
 
     if (!session_options_.optimized_model_filepath.empty()) {
       // Serialize optimized ONNX model.
@@ -876,10 +1109,44 @@ common::Status InferenceSession::Initialize() {
       }
     }
 
+    session_initializer.SetProfiler(&session_profiler_);
     ORT_RETURN_IF_ERROR_SESSIONID_(session_initializer.CreatePlan(nullptr, nullptr, session_options_.execution_mode));
 
     // handle any subgraphs
-    ORT_RETURN_IF_ERROR_SESSIONID_(InitializeSubgraphSessions(graph, *session_state_));
+    {
+      profiling::ScopedSessionEvent event(&session_profiler_, "subgraph_session_initialization");
+      ORT_RETURN_IF_ERROR_SESSIONID_(InitializeSubgraphSessions(graph, *session_state_));
+    }
+
+    for (auto& xp : execution_providers_) {
+      if (xp->IsGraphCaptureEnabled()) {
+        if (CanCaptureWholeGraph(graph, xp->Type())) {
+          graph_capture_provider_ = xp.get();
+        } else {
+          LOGS(*session_logger_, WARNING) << "Graph capture is enabled for " << xp->Type()
+                                          << " but not all the nodes are assigned to it. Runs won't be captured.";
+        }
+      }
+    }
+
+    if (session_options_.run_result_cache_max_bytes > 0) {
+      if (RunResultCache::IsDeterministic(graph)) {
+        run_result_cache_ = onnxruntime::make_unique<RunResultCache>(session_options_.run_result_cache_max_bytes);
+      } else {
+        LOGS(*session_logger_, WARNING) << "The run result cache is enabled but the graph has random or custom ops, "
+                                           "which may not be deterministic. Runs won't be cached.";
+      }
+    }
+
+    for (const auto& binding : session_options_.state_bindings) {
+      if (model_output_names_.find(binding.first) == model_output_names_.end() ||
+          input_def_map_.find(binding.second) == input_def_map_.end()) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "State binding of '",
+                                                       binding.first, "' to '", binding.second,
+                                                       "' must bind an output of the model to one of its inputs."));
+      }
+    }
+
     is_inited_ = true;
 
     // and log telemetry
@@ -964,60 +1231,45 @@ static common::Status CheckTypes(MLDataType actual, MLDataType expected) {
                 "Unexpected input data type. Actual: (" + actual_name + ") , expected: (" + expected_name + ")");
 }
 
-common::Status InferenceSession::ValidateInputs(const std::vector<std::string>& feed_names,
-                                                const std::vector<OrtValue>& feeds) const {
-  if (feed_names.size() != feeds.size()) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Size mismatch: feed_names has ", feed_names.size(),
-                           "elements, but feeds has ", feeds.size(), " elements.");
-  }
-
-  for (size_t i = 0; i < feeds.size(); ++i) {
-    const auto& feed_name = feed_names[i];
-
-    auto iter = input_def_map_.find(feed_name);
-    if (input_def_map_.end() == iter) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid Feed Input Name:", feed_name);
+common::Status InferenceSession::ValidateInput(const std::string& feed_name, const InputDefMetaData& input_def,
+                                               const OrtValue& input_ml_value) const {
+  auto expected_type = input_def.ml_data_type;
+  if (input_ml_value.IsTensor()) {
+    // check for type
+    if (!expected_type->IsTensorType()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
+                             " is not expected to be of type tensor.");
     }
-
-    auto expected_type = iter->second.ml_data_type;
-    auto& input_ml_value = feeds.at(i);
-    if (input_ml_value.IsTensor()) {
-      // check for type
-      if (!expected_type->IsTensorType()) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
-                               " is not expected to be of type tensor.");
-      }
-      auto expected_element_type = expected_type->AsTensorType()->GetElementType();
-      auto input_element_type = input_ml_value.Get<Tensor>().DataType();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type));
-
-      // check for shape
-      const auto& expected_shape = iter->second.tensor_shape;
-      if (expected_shape.NumDimensions() > 0) {
-        const auto& input_shape = input_ml_value.Get<Tensor>().Shape();
-        ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(feed_name, input_shape, expected_shape));
-      }
-    } else if (input_ml_value.IsSparseTensor()) {
-      if (!expected_type->IsSparseTensorType()) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
-                               " is not expected to be of type sparse tensor.");
-      }
-      auto expected_element_type = expected_type->AsSparseTensorType()->GetElementType();
-      auto input_element_type = input_ml_value.Get<SparseTensor>().Values().DataType();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type));
-      // TODO: In the future, when sparsetensors are in use, find out how to properly verify the shape
-    } else if (input_ml_value.IsTensorSequence()) {
-      if (!expected_type->IsTensorSequenceType()) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
-                               " is not expected to be of type tensor sequence.");
-      }
-      auto expected_element_type = expected_type->AsSequenceTensorBase()->GetElementType();
-      auto input_element_type = input_ml_value.Get<TensorSeq>().DataType();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type));
-    } else {
-      auto input_type = input_ml_value.Type();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_type, expected_type));
+    auto expected_element_type = expected_type->AsTensorType()->GetElementType();
+    auto input_element_type = input_ml_value.Get<Tensor>().DataType();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type));
+
+    // check for shape
+    const auto& expected_shape = input_def.tensor_shape;
+    if (expected_shape.NumDimensions() > 0) {
+      const auto& input_shape = input_ml_value.Get<Tensor>().Shape();
+      ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(feed_name, input_shape, expected_shape));
+    }
+  } else if (input_ml_value.IsSparseTensor()) {
+    if (!expected_type->IsSparseTensorType()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
+                             " is not expected to be of type sparse tensor.");
     }
+    auto expected_element_type = expected_type->AsSparseTensorType()->GetElementType();
+    auto input_element_type = input_ml_value.Get<SparseTensor>().Values().DataType();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type));
+    // TODO: In the future, when sparsetensors are in use, find out how to properly verify the shape
+  } else if (input_ml_value.IsTensorSequence()) {
+    if (!expected_type->IsTensorSequenceType()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
+                             " is not expected to be of type tensor sequence.");
+    }
+    auto expected_element_type = expected_type->AsSequenceTensorBase()->GetElementType();
+    auto input_element_type = input_ml_value.Get<TensorSeq>().DataType();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type));
+  } else {
+    auto input_type = input_ml_value.Type();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_type, expected_type));
   }
 
   return Status::OK();
@@ -1040,42 +1292,196 @@ common::Status InferenceSession::ValidateOutputs(const std::vector<std::string>&
     return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, ostr.str());
   }
 
+  // TODO add more validation here like checking shape of the allocated buffers
+
+  return common::Status::OK();
+}
+
+// A recorded Run reads and writes the buffers it was recorded with, so it can only be replayed
+// if all the inputs and outputs are device tensors at the same addresses and with the same shapes.
+static bool MakeGraphCaptureKey(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                                const std::vector<std::string>& output_names, const std::vector<OrtValue>& fetches,
+                                std::string& graph_key) {
+  if (fetches.size() != output_names.size()) {
+    return false;
+  }
+
+  std::ostringstream key;
+  auto add_value = [&key](const std::string& name, const OrtValue& value) {
+    if (!value.IsAllocated() || !value.IsTensor()) {
+      return false;
+    }
+    const auto& tensor = value.Get<Tensor>();
+    if (tensor.Location().device.Type() != OrtDevice::GPU) {
+      return false;
+    }
+    key << name << '@' << tensor.DataRaw() << tensor.Shape() << ';';
+    return true;
+  };
+
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (!add_value(feed_names[i], feeds[i])) {
+      return false;
+    }
+  }
+  key << "->";
+  for (size_t i = 0; i < fetches.size(); ++i) {
+    if (!add_value(output_names[i], fetches[i])) {
+      return false;
+    }
+  }
+
+  graph_key = key.str();
+  return true;
+}
+
+Status InferenceSession::Run(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                             const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                             std::vector<OrtValue>* p_fetches) {
+  if (run_options.state_stream_id >= 0 && !session_options_.state_bindings.empty()) {
+    return RunWithStateStream(run_options, feed_names, feeds, output_names, p_fetches);
+  }
+
+  return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, run_options.fetches_on_device);
+}
+
+common::Status InferenceSession::RunAsync(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                                          const std::vector<OrtValue>& feeds,
+                                          const std::vector<std::string>& output_names, std::vector<OrtValue> fetches,
+                                          RunAsyncCallback callback) {
+  auto* thread_pool = GetIntraOpThreadPoolToUse();
+  if (thread_pool == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "RunAsync requires an intra-op thread pool. "
+                           "Set the number of intra-op threads to more than 1.");
+  }
+
+  {
+    std::lock_guard<OrtMutex> lock(async_runs_mutex_);
+    ++num_async_runs_;
+  }
+
+  // the task owns copies of the names and the feeds, so the caller doesn't have to keep them
+  thread_pool->Schedule([this, &run_options, feed_names, feeds = feeds, output_names, fetches = std::move(fetches),
+                         callback = std::move(callback)]() mutable {
+    auto status = Run(run_options, feed_names, feeds, output_names, &fetches);
+    try {
+      callback(status, fetches);
+    } catch (const std::exception& e) {
+      LOGS(*session_logger_, ERROR) << "Exception in the callback of RunAsync: " << e.what();
+    } catch (...) {
+      LOGS(*session_logger_, ERROR) << "Unknown exception in the callback of RunAsync";
+    }
+
+    // the values may be allocated by the session, so they're released before it can be destroyed
+    feeds.clear();
+    fetches.clear();
+    callback = nullptr;
+
+    std::lock_guard<OrtMutex> lock(async_runs_mutex_);
+    if (--num_async_runs_ == 0) {
+      async_runs_done_.notify_all();
+    }
+  });
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::PrepareRun(const std::vector<std::string>& feed_names,
+                                            const std::vector<std::string>& output_names,
+                                            std::unique_ptr<PreparedRun>* prepared_run) {
+  if (!is_inited_) {
+    LOGS(*session_logger_, ERROR) << "Session was not initialized";
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+
+  if (output_names.empty()) {
+    return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "At least one output should be requested.");
+  }
+
+  std::unique_ptr<PreparedRun> run(new PreparedRun());
+  run->session_ = this;
+
+  run->feed_defs_.reserve(feed_names.size());
+  for (const auto& feed_name : feed_names) {
+    auto iter = input_def_map_.find(feed_name);
+    if (input_def_map_.end() == iter) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid Feed Input Name:", feed_name);
+    }
+    run->feed_defs_.push_back(&iter->second);
+  }
+
   for (const auto& name : output_names) {
     if (model_output_names_.find(name) == model_output_names_.end()) {
       return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Invalid Output Name:" + name);
     }
   }
 
-  // TODO add more validation here like checking shape of the allocated buffers
+  FeedsFetchesInfo info;
+  info.feed_names = feed_names;
+  info.output_names = output_names;
+  ORT_RETURN_IF_ERROR_SESSIONID_(info.SetMLValueIdxs(session_state_->GetOrtValueNameIdxMap()));
+  run->feeds_fetches_manager_ = onnxruntime::make_unique<FeedsFetchesManager>(std::move(info));
+  ORT_RETURN_IF_ERROR_SESSIONID_(utils::InitializeFeedFetchCopyInfo(*session_state_, *run->feeds_fetches_manager_));
 
-  return common::Status::OK();
+  *prepared_run = std::move(run);
+  return Status::OK();
 }
 
-Status InferenceSession::Run(const RunOptions& run_options, const std::vector<std::string>& feed_names,
-                             const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
-                             std::vector<OrtValue>* p_fetches) {
+Status InferenceSession::Run(const RunOptions& run_options, const PreparedRun& prepared_run,
+                             const std::vector<OrtValue>& feeds, std::vector<OrtValue>* p_fetches) {
+  if (run_options.state_stream_id >= 0 && !session_options_.state_bindings.empty()) {
+    return Run(run_options, prepared_run.GetFeedNames(), feeds, prepared_run.GetOutputNames(), p_fetches);
+  }
+
+  return RunImpl(run_options, prepared_run, feeds, p_fetches, run_options.fetches_on_device);
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                                 const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                                 std::vector<OrtValue>* p_fetches, bool fetches_on_device) {
+  std::unique_ptr<PreparedRun> prepared_run;
+  ORT_RETURN_IF_ERROR_SESSIONID_(PrepareRun(feed_names, output_names, &prepared_run));
+  return RunImpl(run_options, *prepared_run, feeds, p_fetches, fetches_on_device);
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options, const PreparedRun& prepared_run,
+                                 const std::vector<OrtValue>& feeds, std::vector<OrtValue>* p_fetches,
+                                 bool fetches_on_device) {
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.StartTime();
   }
 
-#ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
-  TraceLoggingActivity<telemetry_provider_handle> ortrun_activity;
-  ortrun_activity.SetRelatedActivity(session_activity);
-  TraceLoggingWriteStart(ortrun_activity, "OrtRun");
-#endif
+  ORT_TRACE_RUN_START(session_id_, run_options.run_tag.c_str());
   Status retval = Status::OK();
   const Env& env = Env::Default();
 
   std::vector<IExecutionProvider*> exec_providers_to_stop;
   exec_providers_to_stop.reserve(execution_providers_.NumProviders());
 
+  const auto& feed_names = prepared_run.GetFeedNames();
+  const auto& output_names = prepared_run.GetOutputNames();
+  std::string result_cache_key;  // set if the outputs of the run can be cached
+  RunStats run_stats;
+
   try {
     if (!is_inited_) {
       LOGS(*session_logger_, ERROR) << "Session was not initialized";
       return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
     }
 
+    if (prepared_run.session_ != this) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The prepared run was created by another session.");
+    }
+
+    if (session_options_.shape_specialization_max_variants > 0) {
+      auto* variant = GetShapeSpecializedVariant(feed_names, feeds);
+      if (variant != nullptr) {
+        // the values of the prepared run are the ones of this session's graph, so the variant resolves the names
+        return variant->RunImpl(run_options, feed_names, feeds, output_names, p_fetches, fetches_on_device);
+      }
+    }
+
     // check the frequency to send Evalutaion Stop event
     if (TimeDiffMicroSeconds(telemetry_.time_sent_last_evalutation_start_) > telemetry_.kDurationBetweenSendingEvaluationStart) {
       env.GetTelemetryProvider().LogEvaluationStart();
@@ -1084,18 +1490,36 @@ Status InferenceSession::Run(const RunOptions& run_options, const std::vector<st
       telemetry_.isEvaluationStart = true;
     }
 
-    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
+    if (feed_names.size() != feeds.size()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Size mismatch: feed_names has ", feed_names.size(),
+                             "elements, but feeds has ", feeds.size(), " elements.");
+    }
+    for (size_t i = 0; i < feeds.size(); ++i) {
+      ORT_RETURN_IF_ERROR(ValidateInput(feed_names[i], *prepared_run.feed_defs_[i], feeds[i]));
+    }
     ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
 
-    FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
-    FeedsFetchesManager feeds_fetches_manager{std::move(info)};
-
     if (!run_options.run_tag.empty()) {
       LOGS(*session_logger_, INFO) << "Running with tag: " << run_options.run_tag;
     }
 
+    // the cached outputs are in CPU memory, so the runs which pre-allocate their outputs aren't cached
+    if (run_result_cache_ != nullptr && !fetches_on_device &&
+        std::none_of(p_fetches->begin(), p_fetches->end(),
+                     [](const OrtValue& fetch) { return fetch.IsAllocated(); }) &&
+        RunResultCache::MakeKey(feed_names, feeds, output_names, result_cache_key) &&
+        run_result_cache_->Lookup(result_cache_key, *p_fetches)) {
+      if (run_options.collect_run_stats) {
+        run_options.run_stats = RunStats();
+      }
+      return Status::OK();
+    }
+
     ++current_num_runs_;
 
+    // orders this Run with the ones of the other sessions sharing the global thread pools
+    RunScheduler::ScopedRun scheduled_run(run_options, !use_per_session_threads_);
+
     // TODO should we add this exec to the list of executors? i guess its not needed now?
 
     // scope of owned_run_logger is just the call to Execute.
@@ -1107,8 +1531,8 @@ Status InferenceSession::Run(const RunOptions& run_options, const std::vector<st
     // TODO: only call OnRunStart for all providers in-use
     for (auto& xp : execution_providers_) {
       // call OnRunStart and add to exec_providers_to_stop if successful
-      auto start_func = [&xp, &exec_providers_to_stop]() {
-        auto status = xp->OnRunStart();
+      auto start_func = [&xp, &exec_providers_to_stop, &run_options]() {
+        auto status = xp->OnRunStart(run_options);
         if (status.IsOK())
           exec_providers_to_stop.push_back(xp.get());
 
@@ -1118,11 +1542,60 @@ Status InferenceSession::Run(const RunOptions& run_options, const std::vector<st
       ORT_CHECK_AND_SET_RETVAL(start_func());
     }
 
-    // execute the graph
-    ORT_CHECK_AND_SET_RETVAL(
-        utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
-                            session_options_.execution_mode,
-                            run_options.terminate, run_logger));
+    // replay the recorded device work if the inputs and outputs are bound as when it was recorded
+    std::string graph_key;
+    bool replayed = false;
+    if (graph_capture_provider_ != nullptr &&
+        MakeGraphCaptureKey(feed_names, feeds, output_names, *p_fetches, graph_key)) {
+      ORT_CHECK_AND_SET_RETVAL(graph_capture_provider_->ReplayGraph(graph_key, replayed));
+    }
+
+    if (!replayed && retval.IsOK()) {
+      bool capturing = false;
+      if (!graph_key.empty()) {
+        ORT_CHECK_AND_SET_RETVAL(graph_capture_provider_->BeginGraphCapture(graph_key, capturing));
+      }
+
+      // execute the graph
+      auto execute_graph = [&]() {
+        run_stats = RunStats();
+        run_stats.num_runs = 1;
+        return utils::ExecuteGraphWithInitializedCopyInfo(*session_state_, *prepared_run.feeds_fetches_manager_,
+                                                          feeds, *p_fetches, session_options_.execution_mode,
+                                                          run_options.terminate, run_logger, fetches_on_device,
+                                                          &run_stats);
+      };
+      auto run_status = retval.IsOK() ? execute_graph() : Status::OK();
+
+      if (capturing) {
+        bool rerun = false;
+        ORT_CHECK_AND_SET_RETVAL(graph_capture_provider_->EndGraphCapture(graph_key, run_status, rerun));
+        if (rerun) {
+          // nothing was executed while recording, e.g. a kernel needed a result on the host
+          LOGS(run_logger, WARNING) << "Graph capture failed, running without it: " << run_status.ErrorMessage();
+          run_status = retval.IsOK() ? execute_graph() : Status::OK();
+        }
+      }
+
+      ORT_CHECK_AND_SET_RETVAL(run_status);
+    }
+
+    if (!result_cache_key.empty() && retval.IsOK()) {
+      run_result_cache_->Insert(result_cache_key, *p_fetches);
+    }
+
+    if (retval.IsOK()) {
+      // a replayed run only counts as a run
+      run_stats.num_runs = 1;
+      const auto* root_session = parent_session_ != nullptr ? parent_session_ : this;
+      {
+        std::lock_guard<OrtMutex> lock(root_session->run_stats_mutex_);
+        root_session->cumulative_run_stats_.Add(run_stats);
+      }
+      if (run_options.collect_run_stats) {
+        run_options.run_stats = run_stats;
+      }
+    }
 
   } catch (const std::exception& e) {
     retval = Status(common::ONNXRUNTIME, common::FAIL, e.what());
@@ -1136,6 +1609,10 @@ Status InferenceSession::Run(const RunOptions& run_options, const std::vector<st
     ORT_CHECK_AND_SET_RETVAL(status);
   }
 
+  if (run_options.shrink_memory_arenas && is_inited_) {
+    ORT_CHECK_AND_SET_RETVAL(ShrinkMemoryArenas());
+  }
+
   --current_num_runs_;
 
   // keep track of telemetry
@@ -1161,12 +1638,391 @@ Status InferenceSession::Run(const RunOptions& run_options, const std::vector<st
   if (session_profiler_.IsEnabled()) {
     session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "model_run", tp);
   }
-#ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
-  TraceLoggingWriteStop(ortrun_activity, "OrtRun");
-#endif
+  ORT_TRACE_RUN_STOP(session_id_, run_options.run_tag.c_str(), static_cast<int>(retval.Code()));
   return retval;
 }
 
+// Replaces a fetch that isn't in CPU memory with a copy in CPU memory, which is where Run returns the outputs that
+// aren't pre-allocated.
+static Status CopyFetchToCpu(const DataTransferManager& data_transfer_mgr, const AllocatorPtr& cpu_allocator,
+                             OrtValue& fetch) {
+  if (!fetch.IsTensor() || fetch.Get<Tensor>().Location().device.Type() == OrtDevice::CPU) {
+    return Status::OK();
+  }
+
+  const Tensor& tensor = fetch.Get<Tensor>();
+  auto cpu_tensor = onnxruntime::make_unique<Tensor>(tensor.DataType(), tensor.Shape(), cpu_allocator);
+  ORT_RETURN_IF_ERROR(data_transfer_mgr.CopyTensor(tensor, *cpu_tensor));
+
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  fetch.Init(cpu_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+  return Status::OK();
+}
+
+// Returns true if the state value of the last Run can be written in place by the next one in place of its output.
+static bool IsSameTensorLayout(const OrtValue& a, const OrtValue& b) {
+  if (!a.IsAllocated() || !b.IsAllocated() || !a.IsTensor() || !b.IsTensor()) {
+    return false;
+  }
+  const Tensor& tensor_a = a.Get<Tensor>();
+  const Tensor& tensor_b = b.Get<Tensor>();
+  return tensor_a.DataType() == tensor_b.DataType() && tensor_a.Shape() == tensor_b.Shape() &&
+         tensor_a.Location().device == tensor_b.Location().device;
+}
+
+Status InferenceSession::RunWithStateStream(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                                            const std::vector<OrtValue>& feeds,
+                                            const std::vector<std::string>& output_names,
+                                            std::vector<OrtValue>* p_fetches) {
+  if (!is_inited_) {
+    LOGS(*session_logger_, ERROR) << "Session was not initialized";
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+
+  const auto& bindings = session_options_.state_bindings;
+  const size_t num_bindings = bindings.size();
+
+  std::shared_ptr<StateStream> stream;
+  {
+    std::lock_guard<OrtMutex> lock(state_streams_mutex_);
+    auto& entry = state_streams_[run_options.state_stream_id];
+    if (entry == nullptr) {
+      entry = std::make_shared<StateStream>();
+      entry->values.resize(num_bindings);
+      entry->spare_values.resize(num_bindings);
+      entry->values_returned.resize(num_bindings, false);
+    }
+    stream = entry;
+  }
+
+  std::lock_guard<OrtMutex> stream_lock(stream->mutex);
+
+  // feed the state to the bound inputs the caller doesn't feed. a fed input resets the state.
+  std::vector<std::string> run_feed_names = feed_names;
+  std::vector<OrtValue> run_feeds = feeds;
+  for (size_t i = 0; i < num_bindings; ++i) {
+    const bool fed = std::find(feed_names.begin(), feed_names.end(), bindings[i].second) != feed_names.end();
+    if (!fed && stream->values[i].IsAllocated()) {
+      run_feed_names.push_back(bindings[i].second);
+      run_feeds.push_back(stream->values[i]);
+    }
+  }
+
+  // fetch the bound outputs the caller doesn't. they are written in place to the state of the Run before, if it
+  // can be reused, so the state doesn't need a new buffer on every Run.
+  const size_t num_outputs = output_names.size();
+  std::vector<std::string> run_output_names = output_names;
+  std::vector<OrtValue> run_fetches = *p_fetches;
+  run_fetches.resize(num_outputs);
+  std::vector<bool> preallocated(num_outputs);
+  for (size_t i = 0; i < num_outputs; ++i) {
+    preallocated[i] = run_fetches[i].IsAllocated();
+  }
+
+  std::vector<size_t> state_fetch_index(num_bindings);
+  for (size_t i = 0; i < num_bindings; ++i) {
+    auto it = std::find(output_names.begin(), output_names.end(), bindings[i].first);
+    if (it != output_names.end()) {
+      state_fetch_index[i] = static_cast<size_t>(it - output_names.begin());
+      continue;
+    }
+
+    state_fetch_index[i] = run_output_names.size();
+    run_output_names.push_back(bindings[i].first);
+    run_fetches.push_back(IsSameTensorLayout(stream->spare_values[i], stream->values[i]) ? stream->spare_values[i]
+                                                                                          : OrtValue());
+  }
+
+  // the fetches stay on the device that produced them, so the state does too. the ones returned are copied to CPU
+  // memory below as Run would.
+  ORT_RETURN_IF_ERROR(RunImpl(run_options, run_feed_names, run_feeds, run_output_names, &run_fetches, true));
+
+  for (size_t i = 0; i < num_bindings; ++i) {
+    OrtValue& new_value = run_fetches[state_fetch_index[i]];
+    const bool returned = state_fetch_index[i] < num_outputs;
+    if (!stream->values_returned[i] && IsSameTensorLayout(stream->values[i], new_value)) {
+      stream->spare_values[i] = stream->values[i];
+    } else {
+      stream->spare_values[i] = OrtValue();
+    }
+    stream->values[i] = new_value;
+    stream->values_returned[i] = returned;
+  }
+
+  if (!run_options.fetches_on_device) {
+    const auto* cpu_provider = execution_providers_.Get(onnxruntime::kCpuExecutionProvider);
+    AllocatorPtr cpu_allocator = cpu_provider->GetAllocator(0, OrtMemTypeDefault);
+    for (size_t i = 0; i < num_outputs; ++i) {
+      if (!preallocated[i]) {
+        ORT_RETURN_IF_ERROR(CopyFetchToCpu(data_transfer_mgr_, cpu_allocator, run_fetches[i]));
+      }
+    }
+  }
+
+  run_fetches.resize(num_outputs);
+  *p_fetches = std::move(run_fetches);
+  return Status::OK();
+}
+
+void InferenceSession::ReleaseStateStream(int64_t stream_id) {
+  std::lock_guard<OrtMutex> lock(state_streams_mutex_);
+  state_streams_.erase(stream_id);
+}
+
+// Maximum number of free dimension values counted before the shape-specialized variants are created, which bounds the
+// memory used by values that are rarely seen.
+static constexpr size_t kMaxShapeSpecializationRunCounts = 1024;
+
+InferenceSession* InferenceSession::GetShapeSpecializedVariant(const std::vector<std::string>& feed_names,
+                                                               const std::vector<OrtValue>& feeds) {
+  // the variants create their own CPU execution provider, other providers can't be duplicated
+  if (execution_providers_.NumProviders() != 1 ||
+      execution_providers_.Get(onnxruntime::kCpuExecutionProvider) == nullptr) {
+    return nullptr;
+  }
+
+  // bind the named free dimensions of the inputs to their values in the feeds
+  std::map<std::string, int64_t> dim_values;
+  for (size_t i = 0, end = feed_names.size(); i < end; ++i) {
+    auto it = input_def_map_.find(feed_names[i]);
+    if (it == input_def_map_.end() || !feeds[i].IsTensor()) {
+      continue;
+    }
+
+    const auto* shape = it->second.node_arg->Shape();
+    const auto& dims = feeds[i].Get<Tensor>().Shape().GetDims();
+    if (shape == nullptr || shape->dim_size() != static_cast<int>(dims.size())) {
+      return nullptr;  // the generic graph reports the invalid input
+    }
+    for (int d = 0; d < shape->dim_size(); ++d) {
+      if (!utils::HasDimParam(shape->dim(d))) {
+        continue;
+      }
+      auto inserted = dim_values.emplace(shape->dim(d).dim_param(), dims[d]);
+      if (!inserted.second && inserted.first->second != dims[d]) {
+        return nullptr;  // the inputs disagree on the value of a free dimension
+      }
+    }
+  }
+
+  if (dim_values.empty()) {
+    return nullptr;
+  }
+
+  std::ostringstream key_stream;
+  for (const auto& dim_value : dim_values) {
+    key_stream << dim_value.first << '=' << dim_value.second << ';';
+  }
+  const std::string key = key_stream.str();
+
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(shape_specialization_mutex_);
+    auto variant_it = shape_specialized_variants_.find(key);
+    if (variant_it != shape_specialized_variants_.end()) {
+      return variant_it->second.get();
+    }
+
+    if (shape_specialized_variants_.size() >= static_cast<size_t>(session_options_.shape_specialization_max_variants)) {
+      return nullptr;
+    }
+
+    auto count_it = shape_specialization_run_counts_.find(key);
+    if (count_it == shape_specialization_run_counts_.end()) {
+      if (shape_specialization_run_counts_.size() >= kMaxShapeSpecializationRunCounts) {
+        return nullptr;
+      }
+      count_it = shape_specialization_run_counts_.emplace(key, 0).first;
+    }
+    if (++count_it->second < session_options_.shape_specialization_min_runs) {
+      return nullptr;
+    }
+
+    // hold the slot of the variant while it's created, so the other runs with these values use the generic graph
+    shape_specialization_run_counts_.erase(count_it);
+    shape_specialized_variants_.emplace(key, nullptr);
+  }
+
+  std::unique_ptr<InferenceSession> variant;
+  auto status = CreateShapeSpecializedVariant(dim_values, variant);
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Failed to create the shape-specialized variant for " << key << " "
+                                    << status.ErrorMessage();
+    return nullptr;
+  }
+
+  LOGS(*session_logger_, INFO) << "Created the shape-specialized variant for " << key;
+  std::lock_guard<onnxruntime::OrtMutex> l(shape_specialization_mutex_);
+  auto& slot = shape_specialized_variants_[key];
+  slot = std::move(variant);
+  return slot.get();
+}
+
+common::Status InferenceSession::CreateShapeSpecializedVariant(const std::map<std::string, int64_t>& dim_values,
+                                                               std::unique_ptr<InferenceSession>& variant) const {
+  SessionOptions variant_options = session_options_;
+  variant_options.shape_specialization_max_variants = 0;
+  variant_options.use_per_session_threads = false;  // see the threadpools in ConstructorCommon
+  variant_options.enable_profiling = false;
+  variant_options.optimized_model_filepath.clear();
+  variant_options.session_state_cache_filepath.clear();
+  for (const auto& dim_value : dim_values) {
+    variant_options.free_dimension_overrides.push_back(
+        FreeDimensionOverride{dim_value.first, dim_value.second, FreeDimensionOverrideType::Name});
+  }
+
+  variant.reset(new InferenceSession(variant_options, *session_env_, *this));
+  for (const auto& custom_registry : custom_registries_) {
+    ORT_RETURN_IF_ERROR(variant->RegisterCustomRegistry(custom_registry));
+  }
+  if (!transformers_to_enable_.empty()) {
+    ORT_RETURN_IF_ERROR(variant->AddCustomTransformerList(transformers_to_enable_));
+  }
+
+  if (model_location_.empty()) {
+    ORT_RETURN_IF_ERROR(variant->Load(model_data_for_variants_.data(),
+                                      static_cast<int>(model_data_for_variants_.size())));
+  } else {
+    ORT_RETURN_IF_ERROR(variant->Load(model_location_));
+  }
+  return variant->Initialize();
+}
+
+common::Status InferenceSession::ShrinkMemoryArenas() {
+  for (const auto& xp : execution_providers_) {
+    for (const auto* allocator : xp->GetAllocators()) {
+      const auto& info = allocator->Info();
+      if (info.alloc_type != OrtArenaAllocator) {
+        continue;
+      }
+
+      auto arena = std::dynamic_pointer_cast<IArenaAllocator>(xp->GetAllocator(info.id, info.mem_type));
+      if (arena) {
+        ORT_RETURN_IF_ERROR(arena->Shrink());
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::WarmUp(const std::unordered_map<std::string, TensorShape>& input_shapes) {
+  if (!is_inited_) {
+    LOGS(*session_logger_, ERROR) << "Session was not initialized";
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+
+  for (const auto& pair : input_shapes) {
+    if (input_def_map_.find(pair.first) == input_def_map_.end()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid input name for the warm-up: ", pair.first);
+    }
+  }
+
+  AllocatorPtr cpu_allocator = execution_providers_.Get(onnxruntime::kCpuExecutionProvider)
+                                   ->GetAllocator(0, OrtMemTypeDefault);
+  const auto& graph_inputs = model_->MainGraph().GetInputs();
+  std::vector<std::string> feed_names;
+  std::vector<OrtValue> feeds;
+  feed_names.reserve(graph_inputs.size());
+  feeds.reserve(graph_inputs.size());
+  for (const auto* input : graph_inputs) {
+    const auto& input_def = input_def_map_.at(input->Name());
+    if (!input_def.ml_data_type->IsTensorType()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The input ", input->Name(),
+                             " isn't a tensor, the session can't be warmed up.");
+    }
+
+    auto shape_it = input_shapes.find(input->Name());
+    TensorShape shape;
+    if (shape_it != input_shapes.end()) {
+      shape = shape_it->second;
+    } else {
+      const auto& dims = input_def.tensor_shape.GetDims();
+      if (input->Shape() == nullptr ||
+          std::any_of(dims.begin(), dims.end(), [](int64_t dim) { return dim < 0; })) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The shape of the input ", input->Name(),
+                               " isn't fully known, it must be given for the warm-up.");
+      }
+      shape = input_def.tensor_shape;
+    }
+
+    // the constructor initializes the strings, the other types are zero-filled
+    const auto element_type = input_def.ml_data_type->AsTensorType()->GetElementType();
+    auto tensor = onnxruntime::make_unique<Tensor>(element_type, shape, cpu_allocator);
+    if (!tensor->IsDataTypeString() && tensor->SizeInBytes() > 0) {
+      memset(tensor->MutableDataRaw(), 0, tensor->SizeInBytes());
+    }
+    OrtValue feed;
+    auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+    feed.Init(tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+    feed_names.push_back(input->Name());
+    feeds.push_back(feed);
+  }
+
+  std::vector<std::string> output_names;
+  output_names.reserve(output_def_list_.size());
+  for (const auto* output : output_def_list_) {
+    output_names.push_back(output->Name());
+  }
+
+  // the first run creates the memory patterns and grows the arenas, the second one runs as the next runs will.
+  // the outputs are left on their devices, which also keeps them out of the run result cache.
+  RunOptions run_options;
+  run_options.run_tag = "warm-up";
+  for (int i = 0; i < 2; ++i) {
+    std::vector<OrtValue> fetches;
+    ORT_RETURN_IF_ERROR(RunImpl(run_options, feed_names, feeds, output_names, &fetches, true));
+  }
+  return Status::OK();
+}
+
+RunStats InferenceSession::GetCumulativeRunStats() const {
+  std::lock_guard<OrtMutex> lock(run_stats_mutex_);
+  return cumulative_run_stats_;
+}
+
+std::vector<OpStats> InferenceSession::GetOpStats(bool by_op_type) const {
+  return op_stats_collector_ != nullptr ? op_stats_collector_->GetStats(by_op_type) : std::vector<OpStats>{};
+}
+
+RunResultCacheStats InferenceSession::GetRunResultCacheStats() const {
+  return run_result_cache_ != nullptr ? run_result_cache_->GetStats() : RunResultCacheStats{};
+}
+
+void InferenceSession::GetMemoryArenaStats(AllocatorStats& stats) const {
+  stats.Clear();
+  for (const auto& xp : execution_providers_) {
+    for (const auto* allocator : xp->GetAllocators()) {
+      const auto& info = allocator->Info();
+      if (info.alloc_type != OrtArenaAllocator) {
+        continue;
+      }
+
+      auto arena = std::dynamic_pointer_cast<IArenaAllocator>(xp->GetAllocator(info.id, info.mem_type));
+      if (arena) {
+        AllocatorStats arena_stats;
+        arena->GetStats(&arena_stats);
+        stats.num_allocs += arena_stats.num_allocs;
+        stats.bytes_in_use += arena_stats.bytes_in_use;
+        stats.total_allocated_bytes += arena_stats.total_allocated_bytes;
+        stats.max_bytes_in_use += arena_stats.max_bytes_in_use;
+        stats.max_alloc_size = std::max(stats.max_alloc_size, arena_stats.max_alloc_size);
+        stats.bytes_limit += arena_stats.bytes_limit;
+        stats.num_thread_cache_hits += arena_stats.num_thread_cache_hits;
+        stats.num_thread_cache_misses += arena_stats.num_thread_cache_misses;
+        stats.max_total_allocated_bytes += arena_stats.max_total_allocated_bytes;
+        stats.num_cross_stream_reuses += arena_stats.num_cross_stream_reuses;
+        stats.num_extends += arena_stats.num_extends;
+        stats.largest_free_chunk = std::max(stats.largest_free_chunk, arena_stats.largest_free_chunk);
+      }
+    }
+  }
+}
+
+concurrency::ThreadPoolStats InferenceSession::GetThreadPoolStats(bool inter_op) const {
+  const concurrency::ThreadPool* pool = inter_op ? GetInterOpThreadPoolToUse() : GetIntraOpThreadPoolToUse();
+  return pool != nullptr ? pool->GetStats() : concurrency::ThreadPoolStats{};
+}
+
 common::Status InferenceSession::Run(const NameMLValMap& feeds, const std::vector<std::string>& output_names,
                                      std::vector<OrtValue>* p_fetches) {
   return Run(RunOptions(), feeds, output_names, p_fetches);
@@ -1257,8 +2113,18 @@ common::Status InferenceSession::NewIOBinding(std::unique_ptr<IOBinding>* io_bin
 common::Status InferenceSession::Run(const RunOptions& run_options, IOBinding& io_binding) {
   // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
   // io_binding.SynchronizeInputs();
-  return Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(),
-             io_binding.GetOutputNames(), &io_binding.GetOutputs());
+  const bool has_state_stream = run_options.state_stream_id >= 0 && !session_options_.state_bindings.empty();
+  if (io_binding.HasOutputsBoundToDevice() && !has_state_stream) {
+    // leave the outputs on the device that produced them rather than copying them all to CPU memory first.
+    // RunOptions can't be copied, so set fetches_on_device by calling RunImpl directly.
+    ORT_RETURN_IF_ERROR(RunImpl(run_options, io_binding.GetInputNames(), io_binding.GetInputs(),
+                                io_binding.GetOutputNames(), &io_binding.GetOutputs(), true));
+  } else {
+    ORT_RETURN_IF_ERROR(Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(),
+                            io_binding.GetOutputNames(), &io_binding.GetOutputs()));
+  }
+
+  return io_binding.CopyOutputsToBoundLocations();
 }
 
 common::Status InferenceSession::Run(IOBinding& io_binding) {
@@ -1287,6 +2153,10 @@ void InferenceSession::StartProfiling(const logging::Logger* logger_ptr) {
   session_profiler_.StartProfiling(logger_ptr);
 }
 
+std::unordered_map<std::string, profiling::LatencyHistogram> InferenceSession::GetProfilingHistograms() {
+  return session_profiler_.GetLatencyHistograms();
+}
+
 std::string InferenceSession::EndProfiling() {
   if (is_model_loaded_) {
     if (session_profiler_.IsEnabled()) {
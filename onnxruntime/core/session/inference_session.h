@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
 #include <string>
 #include <unordered_map>
 
@@ -20,15 +22,11 @@
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
 #include "core/framework/session_options.h"
+#include "core/session/run_result_cache.h"
 
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 #include "core/language_interop_ops/language_interop_ops.h"
 #endif
-#ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
-#include "core/platform/tracing.h"
-#include <TraceLoggingActivity.h>
-#endif
-
 namespace onnxruntime {  // forward declarations
 class GraphTransformer;
 class Environment;
@@ -44,8 +42,10 @@ struct OrtCustomOpDomain {
 };
 
 namespace onnxruntime {
+struct AllocatorStats;
 class IExecutionProvider;  // forward decl
 class IOBinding;
+class CpuTuningCache;
 class CustomRegistry;
 class Notification;
 
@@ -272,6 +272,108 @@ class InferenceSession {
   common::Status Run(const RunOptions& run_options, IOBinding& io_binding);
   common::Status Run(IOBinding& io_binding);
 
+  /**
+    * Called by RunAsync on the thread of the Run when it's done. The fetches are only set if the status is OK.
+    */
+  using RunAsyncCallback = std::function<void(const common::Status& status, std::vector<OrtValue>& fetches)>;
+
+  /**
+    * Schedules the Run on the intra-op thread pool of the session and returns without waiting for it, so that a few
+    * threads can keep many Runs in flight. run_options must stay valid until callback is called, and the session
+    * waits for its pending Runs when it's destroyed. This API is thread-safe.
+    * @param fetches see Run(const NameMLValMap& feeds, const std::vector<std::string>& output_names,
+    * std::vector<OrtValue>* p_fetches). They're passed to callback.
+    * @return OK if the Run was scheduled, in which case callback will be called. The session must have an intra-op
+    * thread pool.
+    */
+  common::Status RunAsync(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                          const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                          std::vector<OrtValue> fetches, RunAsyncCallback callback);
+
+  class PreparedRun;
+
+  /**
+    * Resolves the graph values and the device copies of the feeds and fetches of a Run with the given names once,
+    * so that the Run calls with the returned prepared run skip the name lookups.
+    * @param feed_names the names of the inputs that will be fed, in the order of the feeds of the Run calls.
+    * @param output_names the names of the outputs that will be fetched, in the order of the fetches.
+    * @return OK if the session is initialized and all the names are valid.
+    */
+  common::Status PrepareRun(const std::vector<std::string>& feed_names, const std::vector<std::string>& output_names,
+                            std::unique_ptr<PreparedRun>* prepared_run);
+
+  /**
+    * Run with the feeds and fetches of a prepared run. This API is thread-safe, and a prepared run can be used by
+    * concurrent Run calls.
+    * @param feeds the input values, in the order of the feed names of the prepared run.
+    * @param p_fetches see Run(const NameMLValMap& feeds, const std::vector<std::string>& output_names,
+    * std::vector<OrtValue>* p_fetches).
+    */
+  common::Status Run(const RunOptions& run_options, const PreparedRun& prepared_run,
+                     const std::vector<OrtValue>& feeds, std::vector<OrtValue>* p_fetches);
+
+  /**
+    * Run the model twice with zero-filled inputs of the given shapes and discard the outputs, so that the kernels,
+    * the memory patterns and the arenas are initialized before the first real Run. Call it once per representative
+    * set of input shapes, e.g. the largest batch size, as the arenas keep the memory of the largest run.
+    * The results of these runs aren't cached.
+    * @param input_shapes the shapes of the inputs. The inputs which aren't listed use the shapes of the model, which
+    * must not have free dimensions.
+    * @return OK if the runs succeed. INVALID_ARGUMENT if an input isn't a tensor, or if its shape is unknown.
+    */
+  common::Status WarmUp(const std::unordered_map<std::string, TensorShape>& input_shapes);
+
+  /**
+    * Release the memory regions of all the arena allocators used by this session that have no allocation in use
+    * back to the underlying device allocators. Can be called by servers when the session is idle.
+    * This API is thread-safe.
+    * @return OK if success.
+    */
+  common::Status ShrinkMemoryArenas();
+
+  /**
+    * Get the statistics of the arena allocators used by this session, summed over the arenas. The maxima are the sums
+    * of the maxima of each arena, except the largest free chunk, which is the largest of them.
+    * Arenas which don't track their usage count as empty.
+    * This API is thread-safe.
+    */
+  void GetMemoryArenaStats(AllocatorStats& stats) const;
+
+  /**
+    * Get the utilization counters of the intra-op, or the inter-op, thread pool used by this session, which is the
+    * one of the environment when the session doesn't use per session threads. All 0 if the session has no such pool.
+    * This API is thread-safe and can be called while the session runs.
+    */
+  concurrency::ThreadPoolStats GetThreadPoolStats(bool inter_op) const;
+
+  /**
+    * Get the hits and misses of the cache of the Run results, and its size.
+    * The statistics are all 0 if SessionOptions::run_result_cache_max_bytes is 0 or the graph can't be cached.
+    * This API is thread-safe.
+    */
+  RunResultCacheStats GetRunResultCacheStats() const;
+
+  /**
+    * Get the memory and time statistics summed over the Run calls of this session that succeeded, see RunStats.
+    * The runs returned from the run result cache execute nothing and aren't counted.
+    * This API is thread-safe.
+    */
+  RunStats GetCumulativeRunStats() const;
+
+  /**
+    * Get the counters of the kernel calls of each node of the graph and its subgraphs, or summed per op type, when
+    * SessionOptions::enable_op_stats is set. Empty otherwise. The calls run by shape-specialized variants aren't
+    * included. This API is thread-safe and can be called while the session runs.
+    */
+  std::vector<OpStats> GetOpStats(bool by_op_type) const;
+
+  /**
+    * Release the state kept for a stream by the Run calls with RunOptions::state_stream_id set to stream_id.
+    * The next Run of the stream starts without state. Does nothing if the stream has no state.
+    * This API is thread-safe.
+    */
+  void ReleaseStateStream(int64_t stream_id);
+
   /**
     * @return pair.first = OK; FAIL otherwise. pair.second is non-NULL when pair.first = OK.
     * @note lifetime of the returned pointer is valid as long as the Session object is live.
@@ -318,6 +420,11 @@ class InferenceSession {
    */
   const SessionOptions& GetSessionOptions() const;
 
+  /*
+   * Get the manager of the data transfers between the devices of the registered execution providers.
+   */
+  const DataTransferManager& GetDataTransferManager() const { return data_transfer_mgr_; }
+
   /**
     * Start profiling on this inference session. This simply turns on profiling events to be
     * recorded. A corresponding EndProfiling has to follow to write profiling data to a file.
@@ -335,7 +442,13 @@ class InferenceSession {
   void StartProfiling(const logging::Logger* logger_ptr);
 
   /**
-    * Write captured profile events in chromium format.
+    * Get the latency histograms per event recorded so far when profiling in sampling mode, see
+    * SessionOptions::profiling_sampling_interval. They can be read periodically while the session runs.
+    */
+  std::unordered_map<std::string, profiling::LatencyHistogram> GetProfilingHistograms();
+
+  /**
+    * Write captured profile events in chromium format, or the latency histograms in sampling mode.
     @return the name of the profile file.
     */
   std::string EndProfiling();
@@ -376,6 +489,11 @@ class InferenceSession {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(InferenceSession);
 
+  // Creates a shape-specialized variant of parent_session, which runs on the threadpools of parent_session.
+  InferenceSession(const SessionOptions& session_options,
+                   const Environment& session_env,
+                   const InferenceSession& parent_session);
+
   void ConstructorCommon(const SessionOptions& session_options,
                          const Environment& session_env);
 
@@ -416,12 +534,39 @@ class InferenceSession {
                              const TensorShape& input_shape,
                              const TensorShape& expected_shape) const;
 
-  common::Status ValidateInputs(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds) const;
+  struct InputDefMetaData;
+
+  common::Status ValidateInput(const std::string& feed_name, const InputDefMetaData& input_def,
+                               const OrtValue& feed) const;
 
   common::Status ValidateOutputs(const std::vector<std::string>& output_names, const std::vector<OrtValue>* p_fetches) const;
 
   common::Status WaitForNotification(Notification* p_executor_done, int64_t timeout_in_ms);
 
+  // Run with the values in the feeds and fetches as given, leaving the fetches that aren't pre-allocated on the
+  // device that produced them if fetches_on_device is true.
+  common::Status RunImpl(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                         const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                         std::vector<OrtValue>* p_fetches, bool fetches_on_device);
+
+  common::Status RunImpl(const RunOptions& run_options, const PreparedRun& prepared_run,
+                         const std::vector<OrtValue>& feeds, std::vector<OrtValue>* p_fetches,
+                         bool fetches_on_device);
+
+  // Run that feeds the state of the stream run_options.state_stream_id to the bound inputs and keeps the bound
+  // outputs as its new state.
+  common::Status RunWithStateStream(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                                    const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                                    std::vector<OrtValue>* p_fetches);
+
+  // Returns the shape-specialized variant to run for the free dimension values of the feeds, creating it if the
+  // values have been seen often enough, or nullptr to run the generic graph.
+  InferenceSession* GetShapeSpecializedVariant(const std::vector<std::string>& feed_names,
+                                               const std::vector<OrtValue>& feeds);
+
+  common::Status CreateShapeSpecializedVariant(const std::map<std::string, int64_t>& dim_values,
+                                               std::unique_ptr<InferenceSession>& variant) const;
+
   template <typename T>
   common::Status Load(const std::basic_string<T>& model_uri);
 
@@ -446,9 +591,64 @@ class InferenceSession {
   // Profiler for this session.
   profiling::Profiler session_profiler_;
 
+  // Per node counters of the kernel calls. Only created if session_options_.enable_op_stats is true.
+  std::unique_ptr<OpStatsCollector> op_stats_collector_;
+
   // The list of execution providers.
   ExecutionProviders execution_providers_;
 
+  // Allocators registered on the env that replace the matching execution provider allocators.
+  // Only populated if session_options_.use_env_allocators is true.
+  std::vector<AllocatorPtr> env_allocators_;
+
+  // Store of the pre-packed weights shared with the other sessions of the env.
+  // Only set if session_options_.use_env_prepacked_weights is true.
+  std::shared_ptr<PrepackedWeightsContainer> prepacked_weights_container_;
+  // Only set if session_options_.use_env_shared_initializers is true.
+  std::shared_ptr<SharedInitializerStore> shared_initializer_store_;
+
+  // Configurations measured by the CPU kernels that autotune.
+  // Only set if session_options_.enable_cpu_tuning is true.
+  std::shared_ptr<CpuTuningCache> cpu_tuning_cache_;
+
+  const Environment* session_env_ = nullptr;
+
+  // Set for a shape-specialized variant to the session that created it.
+  const InferenceSession* parent_session_ = nullptr;
+
+  // State of the shape-specialized variants. Only used if session_options_.shape_specialization_max_variants > 0.
+  // The variants are keyed by the free dimension values they're created for. A null variant runs the generic graph,
+  // either because it's being created or because its creation failed.
+  std::string model_data_for_variants_;  // the model as loaded, if it wasn't loaded from a file
+  OrtMutex shape_specialization_mutex_;
+  std::unordered_map<std::string, int> shape_specialization_run_counts_;
+  std::unordered_map<std::string, std::unique_ptr<InferenceSession>> shape_specialized_variants_;
+
+  // State of a stream of Run calls, for each of session_options_.state_bindings. Only used if there are bindings.
+  struct StateStream {
+    OrtMutex mutex;  // held by the Run of the stream, so its Runs are serialized
+    std::vector<OrtValue> values;  // bound outputs of the last Run, fed to the next one. unallocated if there's none
+    // output buffers of the Run before, written in place by the next Run. unallocated if the value can't be reused,
+    // e.g. because it was returned to the caller.
+    std::vector<OrtValue> spare_values;
+    std::vector<bool> values_returned;  // whether values[i] was returned to the caller, so it can't be reused
+  };
+  OrtMutex state_streams_mutex_;
+  std::unordered_map<int64_t, std::shared_ptr<StateStream>> state_streams_;
+
+  // Outputs of the previous runs. Only set if session_options_.run_result_cache_max_bytes > 0 and the graph is
+  // deterministic.
+  std::unique_ptr<RunResultCache> run_result_cache_;
+
+  // Sums of the statistics of the runs, including the runs of the shape-specialized variants.
+  mutable OrtMutex run_stats_mutex_;
+  mutable RunStats cumulative_run_stats_;
+
+  // Number of RunAsync calls whose callback hasn't returned yet. The destructor waits for them to complete.
+  OrtMutex async_runs_mutex_;
+  OrtCondVar async_runs_done_;
+  int num_async_runs_ = 0;
+
  protected:
   // Immutable state for each op in the model. Shared by all executors.
   // It has a dependency on execution_providers_.
@@ -507,6 +707,10 @@ class InferenceSession {
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_;
 
+  // Provider that records the device work of a Run and replays it when the inputs and outputs are
+  // bound to the same device buffers again. Set in Initialize if every node is assigned to it.
+  IExecutionProvider* graph_capture_provider_ = nullptr;
+
   mutable onnxruntime::OrtMutex session_mutex_;  // to ensure only one thread can invoke Load/Initialize
   bool is_model_loaded_ = false;                 // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;                       // GUARDED_BY(session_mutex_)
@@ -541,7 +745,6 @@ class InferenceSession {
 
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   bool session_activity_started_ = false;
-  TraceLoggingActivity<telemetry_provider_handle> session_activity;
 #endif
 
   // used to hold the ModelProto parsed in an applicable ctor to be used while calling parameter-less Load()
@@ -549,4 +752,27 @@ class InferenceSession {
 
   bool model_loaded_ = false;
 };
+
+/**
+ * The feeds and fetches of a Run resolved by InferenceSession::PrepareRun: the indices of their graph values, the
+ * static part of their device copy info, and the definitions the feeds are validated against.
+ */
+class InferenceSession::PreparedRun {
+ public:
+  const std::vector<std::string>& GetFeedNames() const {
+    return feeds_fetches_manager_->GetFeedsFetchesInfo().feed_names;
+  }
+
+  const std::vector<std::string>& GetOutputNames() const {
+    return feeds_fetches_manager_->GetFeedsFetchesInfo().output_names;
+  }
+
+ private:
+  friend class InferenceSession;
+  PreparedRun() = default;
+
+  const InferenceSession* session_ = nullptr;
+  std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager_;
+  std::vector<const InputDefMetaData*> feed_defs_;
+};
 }  // namespace onnxruntime
@@ -3,18 +3,21 @@
 
 #include "core/session/onnxruntime_c_api.h"
 #include "core/session/allocator_impl.h"
+#include "core/framework/allocatormgr.h"
 #include "core/framework/error_code_helper.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/utils.h"
 #include <cassert>
 #include <cstring>
 #include <functional>
+#include <limits>
 #include <sstream>
 
 #include "core/common/logging/logging.h"
 #include "core/common/status.h"
 #include "core/graph/graph.h"
 #include "core/framework/allocator.h"
+#include "core/framework/arena.h"
 #include "core/framework/tensor.h"
 #include "core/framework/ml_value.h"
 #include "core/session/environment.h"
@@ -22,6 +25,7 @@
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/onnxruntime_typeinfo.h"
 #include "core/session/inference_session.h"
+#include "core/session/IOBinding.h"
 #include "core/session/ort_apis.h"
 #include "core/session/ort_env.h"
 #include "core/framework/data_types.h"
@@ -90,6 +94,22 @@ ORT_API_STATUS_IMPL(OrtApis::CreateEnvWithGlobalThreadPools, OrtLoggingLevel def
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateAndRegisterAllocator, _Inout_ OrtEnv* env, _In_ const OrtMemoryInfo* mem_info) {
+  API_IMPL_BEGIN
+  if (strcmp(mem_info->name, onnxruntime::CPU) != 0 || mem_info->alloc_type != OrtArenaAllocator ||
+      mem_info->mem_type != OrtMemTypeDefault) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                 "Only CPU arena allocators with OrtMemTypeDefault can be registered on the env.");
+  }
+
+  DeviceAllocatorRegistrationInfo device_info{OrtMemTypeDefault,
+                                              [](int) { return onnxruntime::make_unique<TAllocator>(); },
+                                              std::numeric_limits<size_t>::max()};
+  auto status = env->RegisterAllocator(CreateAllocator(device_info, mem_info->id));
+  return ToOrtStatus(status);
+  API_IMPL_END
+}
+
 // enable platform telemetry
 ORT_API_STATUS_IMPL(OrtApis::EnableTelemetryEvents, _In_ const OrtEnv* ort_env) {
   API_IMPL_BEGIN
@@ -509,6 +529,192 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_ const char* const* input_names, _In_ const OrtValue* const* input, size_t input_len,
+                    _In_ const char* const* output_names1, size_t output_names_len, _Inout_ OrtValue** output,
+                    _In_ RunAsyncCallbackFn callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  const int queue_id = 0;
+
+  std::vector<std::string> feed_names(input_len);
+  std::vector<OrtValue> feeds(input_len);
+
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+
+    feed_names[i] = input_names[i];
+    auto& ort_value = feeds[i] = *reinterpret_cast<const ::OrtValue*>(input[i]);
+
+    if (ort_value.Fence()) ort_value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+  }
+
+  std::vector<std::string> output_names(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    output_names[i] = output_names1[i];
+  }
+
+  std::vector<OrtValue> fetches(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output[i] != nullptr) {
+      ::OrtValue& value = *(output[i]);
+      if (value.Fence())
+        value.Fence()->BeforeUsingAsOutput(onnxruntime::kCpuExecutionProvider, queue_id);
+      fetches[i] = value;
+    }
+  }
+
+  // without run options the run uses default ones, which live until its callback is released
+  std::shared_ptr<OrtRunOptions> default_run_options;
+  if (run_options == nullptr) {
+    default_run_options = std::make_shared<OrtRunOptions>();
+    run_options = default_run_options.get();
+  }
+
+  auto on_done = [default_run_options, output, output_names_len, callback, user_data](
+                     const Status& status, std::vector<OrtValue>& fetches) {
+    if (!status.IsOK()) {
+      callback(user_data, output, output_names_len, ToOrtStatus(status));
+      return;
+    }
+    for (size_t i = 0; i != output_names_len; ++i) {
+      ::OrtValue& value = fetches[i];
+      if (value.Fence())
+        value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+      if (output[i] == nullptr) {
+        output[i] = new OrtValue(value);
+      }
+    }
+    callback(user_data, output, output_names_len, nullptr);
+  };
+
+  return ToOrtStatus(session->RunAsync(*run_options, feed_names, feeds, output_names, std::move(fetches), on_done));
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::ReleaseStateStream, _Inout_ OrtSession* sess, int64_t stream_id) {
+  API_IMPL_BEGIN
+  reinterpret_cast<::onnxruntime::InferenceSession*>(sess)->ReleaseStateStream(stream_id);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetMemoryArenaStats, _In_ const OrtSession* sess,
+                    _Out_opt_ int64_t* bytes_in_use, _Out_opt_ int64_t* total_allocated_bytes,
+                    _Out_opt_ int64_t* max_bytes_in_use, _Out_opt_ int64_t* num_allocs) {
+  API_IMPL_BEGIN
+  ::onnxruntime::AllocatorStats stats;
+  reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess)->GetMemoryArenaStats(stats);
+  if (bytes_in_use != nullptr) *bytes_in_use = stats.bytes_in_use;
+  if (total_allocated_bytes != nullptr) *total_allocated_bytes = stats.total_allocated_bytes;
+  if (max_bytes_in_use != nullptr) *max_bytes_in_use = stats.max_bytes_in_use;
+  if (num_allocs != nullptr) *num_allocs = stats.num_allocs;
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetMemoryArenaUtilization, _In_ const OrtSession* sess,
+                    _Out_opt_ int64_t* bytes_in_use, _Out_opt_ int64_t* bytes_reserved,
+                    _Out_opt_ int64_t* largest_free_chunk, _Out_opt_ int64_t* num_extends) {
+  API_IMPL_BEGIN
+  ::onnxruntime::AllocatorStats stats;
+  reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess)->GetMemoryArenaStats(stats);
+  if (bytes_in_use != nullptr) *bytes_in_use = stats.bytes_in_use;
+  if (bytes_reserved != nullptr) *bytes_reserved = stats.total_allocated_bytes;
+  if (largest_free_chunk != nullptr) *largest_free_chunk = stats.largest_free_chunk;
+  if (num_extends != nullptr) *num_extends = stats.num_extends;
+  return nullptr;
+  API_IMPL_END
+}
+
+static void GetThreadPoolStatsOutputs(const onnxruntime::concurrency::ThreadPoolStats& stats, int* num_threads,
+                                      int64_t* queued_tasks, int64_t* active_workers, int64_t* num_tasks,
+                                      int64_t* num_steals) {
+  if (num_threads != nullptr) *num_threads = stats.num_threads;
+  if (queued_tasks != nullptr) *queued_tasks = stats.queued_tasks;
+  if (active_workers != nullptr) *active_workers = stats.active_workers;
+  if (num_tasks != nullptr) *num_tasks = stats.num_tasks;
+  if (num_steals != nullptr) *num_steals = stats.num_steals;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetThreadPoolStats, _In_ const OrtSession* sess, int inter_op,
+                    _Out_opt_ int* num_threads, _Out_opt_ int64_t* queued_tasks, _Out_opt_ int64_t* active_workers,
+                    _Out_opt_ int64_t* num_tasks, _Out_opt_ int64_t* num_steals) {
+  API_IMPL_BEGIN
+  const auto stats = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess)->GetThreadPoolStats(inter_op != 0);
+  GetThreadPoolStatsOutputs(stats, num_threads, queued_tasks, active_workers, num_tasks, num_steals);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::GetEnvThreadPoolStats, _In_ const OrtEnv* env, int inter_op, _Out_opt_ int* num_threads,
+                    _Out_opt_ int64_t* queued_tasks, _Out_opt_ int64_t* active_workers, _Out_opt_ int64_t* num_tasks,
+                    _Out_opt_ int64_t* num_steals) {
+  API_IMPL_BEGIN
+  const auto& environment = env->GetEnvironment();
+  const auto* pool = inter_op != 0 ? environment.GetInterOpThreadPool() : environment.GetIntraOpThreadPool();
+  const auto stats = pool != nullptr ? pool->GetStats() : onnxruntime::concurrency::ThreadPoolStats{};
+  GetThreadPoolStatsOutputs(stats, num_threads, queued_tasks, active_workers, num_tasks, num_steals);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetRunResultCacheStats, _In_ const OrtSession* sess, _Out_opt_ int64_t* hits,
+                    _Out_opt_ int64_t* misses, _Out_opt_ int64_t* num_entries, _Out_opt_ int64_t* bytes) {
+  API_IMPL_BEGIN
+  const auto stats = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess)->GetRunResultCacheStats();
+  if (hits != nullptr) *hits = stats.hits;
+  if (misses != nullptr) *misses = stats.misses;
+  if (num_entries != nullptr) *num_entries = stats.num_entries;
+  if (bytes != nullptr) *bytes = stats.bytes;
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetCumulativeRunStats, _In_ const OrtSession* sess, _Out_opt_ int64_t* num_runs,
+                    _Out_opt_ int64_t* num_allocations, _Out_opt_ int64_t* bytes_allocated,
+                    _Out_opt_ int64_t* peak_bytes, _Out_opt_ int64_t* bytes_copied,
+                    _Out_opt_ int64_t* execution_time_us, _Out_opt_ int64_t* copy_time_us,
+                    _Out_opt_ int64_t* memory_pattern_hits) {
+  API_IMPL_BEGIN
+  const auto stats = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess)->GetCumulativeRunStats();
+  if (num_runs != nullptr) *num_runs = stats.num_runs;
+  if (num_allocations != nullptr) *num_allocations = stats.num_allocations;
+  if (bytes_allocated != nullptr) *bytes_allocated = stats.bytes_allocated;
+  if (peak_bytes != nullptr) *peak_bytes = stats.peak_bytes;
+  if (bytes_copied != nullptr) *bytes_copied = stats.bytes_copied;
+  if (execution_time_us != nullptr) *execution_time_us = stats.execution_time_us;
+  if (copy_time_us != nullptr) *copy_time_us = stats.copy_time_us;
+  if (memory_pattern_hits != nullptr) *memory_pattern_hits = stats.num_memory_pattern_hits;
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionWarmUp, _Inout_ OrtSession* sess,
+                    _In_reads_(input_count) const char* const* input_names,
+                    _In_reads_(input_count) const int64_t* const* input_shapes,
+                    _In_reads_(input_count) const size_t* input_shape_lengths, size_t input_count) {
+  API_IMPL_BEGIN
+  std::unordered_map<std::string, ::onnxruntime::TensorShape> shapes;
+  for (size_t i = 0; i != input_count; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+    shapes[input_names[i]] = ::onnxruntime::TensorShape(input_shapes[i], input_shape_lengths[i]);
+  }
+  auto status = reinterpret_cast<::onnxruntime::InferenceSession*>(sess)->WarmUp(shapes);
+  if (!status.IsOK()) {
+    return ToOrtStatus(status);
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::IsTensor, _In_ const OrtValue* value, int* out) {
   auto v = reinterpret_cast<const ::OrtValue*>(value);
   *out = v->IsTensor() ? 1 : 0;
@@ -681,6 +887,38 @@ ORT_API_STATUS_IMPL(OrtApis::SessionEndProfiling, _In_ OrtSession* sess, _Inout_
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetOpStatsCount, _In_ const OrtSession* sess, int by_op_type,
+                    _Out_ size_t* count) {
+  API_IMPL_BEGIN
+  *count = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess)->GetOpStats(by_op_type != 0).size();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetOpStats, _In_ const OrtSession* sess, int by_op_type, size_t index,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** name, _Outptr_opt_ char** op_type,
+                    _Out_opt_ int64_t* num_calls, _Out_opt_ int64_t* total_time_us, _Out_opt_ int64_t* min_time_us,
+                    _Out_opt_ int64_t* max_time_us, _Out_opt_ int64_t* p99_time_us, _Out_opt_ int64_t* bytes_read,
+                    _Out_opt_ int64_t* bytes_written, _Out_opt_ int64_t* flops) {
+  API_IMPL_BEGIN
+  const auto all_stats = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess)->GetOpStats(by_op_type != 0);
+  if (index >= all_stats.size())
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "index out of range");
+  const auto& stats = all_stats[index];
+  *name = StrDup(stats.name, allocator);
+  if (op_type != nullptr) *op_type = StrDup(stats.op_type, allocator);
+  if (num_calls != nullptr) *num_calls = stats.num_calls;
+  if (total_time_us != nullptr) *total_time_us = stats.total_time_us;
+  if (min_time_us != nullptr) *min_time_us = stats.min_time_us;
+  if (max_time_us != nullptr) *max_time_us = stats.max_time_us;
+  if (p99_time_us != nullptr) *p99_time_us = stats.p99_time_us;
+  if (bytes_read != nullptr) *bytes_read = stats.bytes_read;
+  if (bytes_written != nullptr) *bytes_written = stats.bytes_written;
+  if (flops != nullptr) *flops = stats.flops;
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::SessionGetModelMetadata, _In_ const OrtSession* sess,
                     _Outptr_ OrtModelMetadata** out) {
   API_IMPL_BEGIN
@@ -764,6 +1002,174 @@ ORT_API_STATUS_IMPL(OrtApis::ModelMetadataGetVersion,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateIoBinding, _Inout_ OrtSession* sess, _Outptr_ OrtIoBinding** out) {
+  API_IMPL_BEGIN
+  std::unique_ptr<::onnxruntime::IOBinding> binding;
+  ORT_C_API_RETURN_IF_ERROR(reinterpret_cast<::onnxruntime::InferenceSession*>(sess)->NewIOBinding(&binding));
+  *out = reinterpret_cast<OrtIoBinding*>(binding.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::BindInput, _Inout_ OrtIoBinding* binding, _In_ const char* name,
+                    _In_ const OrtValue* value) {
+  API_IMPL_BEGIN
+  return ToOrtStatus(reinterpret_cast<::onnxruntime::IOBinding*>(binding)->BindInput(name, *value));
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::BindOutput, _Inout_ OrtIoBinding* binding, _In_ const char* name,
+                    _In_ const OrtValue* value) {
+  API_IMPL_BEGIN
+  return ToOrtStatus(reinterpret_cast<::onnxruntime::IOBinding*>(binding)->BindOutput(name, *value));
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::BindOutputToDevice, _Inout_ OrtIoBinding* binding, _In_ const char* name,
+                    _In_ const OrtMemoryInfo* mem_info) {
+  API_IMPL_BEGIN
+  return ToOrtStatus(reinterpret_cast<::onnxruntime::IOBinding*>(binding)->BindOutput(name, *mem_info));
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunWithBinding, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _Inout_ OrtIoBinding* binding) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  auto& io_binding = *reinterpret_cast<::onnxruntime::IOBinding*>(binding);
+  Status status;
+  if (run_options == nullptr) {
+    OrtRunOptions op;
+    status = session->Run(op, io_binding);
+  } else {
+    status = session->Run(*run_options, io_binding);
+  }
+  return ToOrtStatus(status);
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::GetBoundOutputNames, _In_ const OrtIoBinding* binding, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char*** names, _Out_ size_t* count) {
+  API_IMPL_BEGIN
+  const auto& output_names = reinterpret_cast<const ::onnxruntime::IOBinding*>(binding)->GetOutputNames();
+  *names = nullptr;
+  *count = output_names.size();
+  if (output_names.empty()) {
+    return nullptr;
+  }
+
+  auto** result = reinterpret_cast<char**>(allocator->Alloc(allocator, output_names.size() * sizeof(char*)));
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    result[i] = StrDup(output_names[i], allocator);
+  }
+  *names = result;
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::GetBoundOutputValues, _In_ const OrtIoBinding* binding, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ OrtValue*** values, _Out_ size_t* count) {
+  API_IMPL_BEGIN
+  const auto& outputs = reinterpret_cast<const ::onnxruntime::IOBinding*>(binding)->GetOutputs();
+  *values = nullptr;
+  *count = outputs.size();
+  if (outputs.empty()) {
+    return nullptr;
+  }
+
+  auto** result = reinterpret_cast<OrtValue**>(allocator->Alloc(allocator, outputs.size() * sizeof(OrtValue*)));
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    result[i] = new OrtValue(outputs[i]);
+  }
+  *values = result;
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::ClearBoundInputs, _Inout_ OrtIoBinding* binding) {
+  reinterpret_cast<::onnxruntime::IOBinding*>(binding)->ClearInputs();
+}
+
+ORT_API(void, OrtApis::ClearBoundOutputs, _Inout_ OrtIoBinding* binding) {
+  reinterpret_cast<::onnxruntime::IOBinding*>(binding)->ClearOutputs();
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CreatePreparedRun, _In_ OrtSession* sess, _In_ const char* const* input_names,
+                    size_t input_len, _In_ const char* const* output_names1, size_t output_names_len,
+                    _Outptr_ OrtPreparedRun** out) {
+  API_IMPL_BEGIN
+  std::vector<std::string> feed_names(input_len);
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+    feed_names[i] = input_names[i];
+  }
+
+  std::vector<std::string> output_names(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    output_names[i] = output_names1[i];
+  }
+
+  std::unique_ptr<::onnxruntime::InferenceSession::PreparedRun> prepared_run;
+  ORT_C_API_RETURN_IF_ERROR(reinterpret_cast<::onnxruntime::InferenceSession*>(sess)->PrepareRun(
+      feed_names, output_names, &prepared_run));
+  *out = reinterpret_cast<OrtPreparedRun*>(prepared_run.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunPrepared, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_ const OrtPreparedRun* prepared_run, _In_ const OrtValue* const* input,
+                    _Inout_ OrtValue** output) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  const auto& run = *reinterpret_cast<const ::onnxruntime::InferenceSession::PreparedRun*>(prepared_run);
+  const int queue_id = 0;
+
+  const size_t input_len = run.GetFeedNames().size();
+  std::vector<OrtValue> feeds(input_len);
+  for (size_t i = 0; i != input_len; ++i) {
+    auto& ort_value = feeds[i] = *reinterpret_cast<const ::OrtValue*>(input[i]);
+    if (ort_value.Fence()) ort_value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+  }
+
+  const size_t output_names_len = run.GetOutputNames().size();
+  std::vector<OrtValue> fetches(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output[i] != nullptr) {
+      ::OrtValue& value = *(output[i]);
+      if (value.Fence())
+        value.Fence()->BeforeUsingAsOutput(onnxruntime::kCpuExecutionProvider, queue_id);
+      fetches[i] = value;
+    }
+  }
+
+  Status status;
+  if (run_options == nullptr) {
+    OrtRunOptions op;
+    status = session->Run(op, run, feeds, &fetches);
+  } else {
+    status = session->Run(*run_options, run, feeds, &fetches);
+  }
+
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    ::OrtValue& value = fetches[i];
+    if (value.Fence())
+      value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+    if (output[i] == nullptr) {
+      output[i] = new OrtValue(value);
+    }
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::SessionGetInputName, _In_ const OrtSession* sess, size_t index,
                     _Inout_ OrtAllocator* allocator, _Outptr_ char** output) {
   API_IMPL_BEGIN
@@ -1514,6 +1920,64 @@ static constexpr OrtApi ort_api_1_to_3 = {
     // Version 3 - In development, feel free to add/remove/rearrange here
     &OrtApis::CreateEnvWithGlobalThreadPools,
     &OrtApis::DisablePerSessionThreads,
+    &OrtApis::RunOptionsSetShrinkMemoryArenas,
+    &OrtApis::CreateAndRegisterAllocator,
+    &OrtApis::EnableEnvAllocators,
+    &OrtApis::EnableMemPatternBucketing,
+    &OrtApis::SetThreadPoolSpinning,
+    &OrtApis::SetIntraOpThreadAffinity,
+    &OrtApis::SetInterOpThreadAffinity,
+    &OrtApis::SetThreadPoolNumaNode,
+    &OrtApis::SetSessionStateCacheFilePath,
+    &OrtApis::DisablePrePacking,
+    &OrtApis::EnableEnvPrePackedWeights,
+    &OrtApis::EnableCpuTuning,
+    &OrtApis::RunOptionsSetComputeStream,
+    &OrtApis::EnableMemoryEfficientExecutionOrder,
+    &OrtApis::AddFreeDimensionOverrideByName,
+    &OrtApis::EnableShapeSpecialization,
+    &OrtApis::AddStateBinding,
+    &OrtApis::RunOptionsSetStateStreamId,
+    &OrtApis::ReleaseStateStream,
+    &OrtApis::CreateIoBinding,
+    &OrtApis::ReleaseIoBinding,
+    &OrtApis::BindInput,
+    &OrtApis::BindOutput,
+    &OrtApis::BindOutputToDevice,
+    &OrtApis::RunWithBinding,
+    &OrtApis::GetBoundOutputNames,
+    &OrtApis::GetBoundOutputValues,
+    &OrtApis::ClearBoundInputs,
+    &OrtApis::ClearBoundOutputs,
+    &OrtApis::CreatePreparedRun,
+    &OrtApis::ReleasePreparedRun,
+    &OrtApis::RunPrepared,
+    &OrtApis::RunAsync,
+    &OrtApis::SessionGetMemoryArenaStats,
+    &OrtApis::EnableRunResultCache,
+    &OrtApis::SessionGetRunResultCacheStats,
+    &OrtApis::SessionWarmUp,
+    &OrtApis::EnableEnvSharedInitializers,
+    &OrtApis::RunOptionsSetCollectRunStats,
+    &OrtApis::RunOptionsGetRunStats,
+    &OrtApis::SessionGetCumulativeRunStats,
+    &OrtApis::EnableOpStats,
+    &OrtApis::SessionGetOpStatsCount,
+    &OrtApis::SessionGetOpStats,
+    &OrtApis::EnableMemoryProfiling,
+    &OrtApis::SessionGetMemoryArenaUtilization,
+    &OrtApis::SessionGetThreadPoolStats,
+    &OrtApis::GetEnvThreadPoolStats,
+    &OrtApis::EnableCostBasedPartitioning,
+    &OrtApis::KernelContext_GetThreadPool,
+    &OrtApis::ThreadPool_GetDegreeOfParallelism,
+    &OrtApis::ThreadPool_ParallelFor,
+    &OrtApis::KernelContext_Allocate,
+    &OrtApis::KernelContext_Free,
+    &OrtApis::EnableLazyInitializerLoading,
+    &OrtApis::EnableCudaMixedPrecision,
+    &OrtApis::RunOptionsSetPriority,
+    &OrtApis::RunOptionsSetDeadline,
 };
 
 // Assert to do a limited check to ensure Version 1 of OrtApi never changes (will detect an addition or deletion but not if they cancel out each other)
@@ -1543,3 +2007,5 @@ DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Value, OrtValue)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(RunOptions, OrtRunOptions)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Session, ::onnxruntime::InferenceSession)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(ModelMetadata, ::onnxruntime::ModelMetadata)
+DEFINE_RELEASE_ORT_OBJECT_FUNCTION(IoBinding, ::onnxruntime::IOBinding)
+DEFINE_RELEASE_ORT_OBJECT_FUNCTION(PreparedRun, ::onnxruntime::InferenceSession::PreparedRun)
@@ -19,6 +19,8 @@ ORT_API(void, ReleaseCustomOpDomain, OrtCustomOpDomain*);
 ORT_API(void, ReleaseMapTypeInfo, OrtMapTypeInfo*);
 ORT_API(void, ReleaseSequenceTypeInfo, OrtSequenceTypeInfo*);
 ORT_API(void, ReleaseModelMetadata, OrtModelMetadata*);
+ORT_API(void, ReleaseIoBinding, OrtIoBinding*);
+ORT_API(void, ReleasePreparedRun, OrtPreparedRun*);
 
 ORT_API_STATUS_IMPL(CreateStatus, OrtErrorCode code, _In_ const char* msg);
 OrtErrorCode ORT_API_CALL GetErrorCode(_In_ const OrtStatus* status) NO_EXCEPTION ORT_ALL_ARGS_NONNULL;
@@ -183,4 +185,106 @@ ORT_API_STATUS_IMPL(CreateEnvWithGlobalThreadPools, OrtLoggingLevel default_logg
 ORT_ALL_ARGS_NONNULL;
 
 ORT_API_STATUS_IMPL(DisablePerSessionThreads, _In_ OrtSessionOptions* options);
+
+ORT_API_STATUS_IMPL(RunOptionsSetShrinkMemoryArenas, _Inout_ OrtRunOptions* options, int value);
+
+ORT_API_STATUS_IMPL(CreateAndRegisterAllocator, _Inout_ OrtEnv* env, _In_ const OrtMemoryInfo* mem_info);
+ORT_API_STATUS_IMPL(EnableEnvAllocators, _In_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(EnableMemPatternBucketing, _In_ OrtSessionOptions* options,
+                    _In_opt_ const int64_t* bucket_boundaries, size_t num_boundaries);
+ORT_API_STATUS_IMPL(SetThreadPoolSpinning, _Inout_ OrtSessionOptions* options, unsigned int spin_duration_us,
+                    int allow_worker_spinning);
+ORT_API_STATUS_IMPL(SetIntraOpThreadAffinity, _Inout_ OrtSessionOptions* options,
+                    _In_ const size_t* logical_processors, size_t len);
+ORT_API_STATUS_IMPL(SetInterOpThreadAffinity, _Inout_ OrtSessionOptions* options,
+                    _In_ const size_t* logical_processors, size_t len);
+ORT_API_STATUS_IMPL(SetThreadPoolNumaNode, _Inout_ OrtSessionOptions* options, int numa_node);
+ORT_API_STATUS_IMPL(SetSessionStateCacheFilePath, _Inout_ OrtSessionOptions* options, _In_ const ORTCHAR_T* cache_file_path);
+ORT_API_STATUS_IMPL(DisablePrePacking, _Inout_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(EnableEnvPrePackedWeights, _Inout_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(EnableCpuTuning, _Inout_ OrtSessionOptions* options, _In_opt_ const ORTCHAR_T* cache_file_path);
+ORT_API_STATUS_IMPL(RunOptionsSetComputeStream, _Inout_ OrtRunOptions* options, _In_opt_ void* stream);
+ORT_API_STATUS_IMPL(EnableMemoryEfficientExecutionOrder, _Inout_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(AddFreeDimensionOverrideByName, _Inout_ OrtSessionOptions* options, _In_ const char* dim_name,
+                    _In_ int64_t dim_value);
+ORT_API_STATUS_IMPL(EnableShapeSpecialization, _Inout_ OrtSessionOptions* options, int max_variants, int min_runs);
+ORT_API_STATUS_IMPL(AddStateBinding, _Inout_ OrtSessionOptions* options, _In_ const char* output_name,
+                    _In_ const char* input_name);
+ORT_API_STATUS_IMPL(RunOptionsSetStateStreamId, _Inout_ OrtRunOptions* options, int64_t stream_id);
+ORT_API_STATUS_IMPL(ReleaseStateStream, _Inout_ OrtSession* sess, int64_t stream_id);
+
+ORT_API_STATUS_IMPL(CreateIoBinding, _Inout_ OrtSession* sess, _Outptr_ OrtIoBinding** out);
+ORT_API_STATUS_IMPL(BindInput, _Inout_ OrtIoBinding* binding, _In_ const char* name, _In_ const OrtValue* value);
+ORT_API_STATUS_IMPL(BindOutput, _Inout_ OrtIoBinding* binding, _In_ const char* name, _In_ const OrtValue* value);
+ORT_API_STATUS_IMPL(BindOutputToDevice, _Inout_ OrtIoBinding* binding, _In_ const char* name,
+                    _In_ const OrtMemoryInfo* mem_info);
+ORT_API_STATUS_IMPL(RunWithBinding, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _Inout_ OrtIoBinding* binding);
+ORT_API_STATUS_IMPL(GetBoundOutputNames, _In_ const OrtIoBinding* binding, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char*** names, _Out_ size_t* count);
+ORT_API_STATUS_IMPL(GetBoundOutputValues, _In_ const OrtIoBinding* binding, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ OrtValue*** values, _Out_ size_t* count);
+ORT_API(void, ClearBoundInputs, _Inout_ OrtIoBinding* binding);
+ORT_API(void, ClearBoundOutputs, _Inout_ OrtIoBinding* binding);
+
+ORT_API_STATUS_IMPL(CreatePreparedRun, _In_ OrtSession* sess, _In_ const char* const* input_names, size_t input_len,
+                    _In_ const char* const* output_names, size_t output_names_len, _Outptr_ OrtPreparedRun** out);
+ORT_API_STATUS_IMPL(RunPrepared, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_ const OrtPreparedRun* prepared_run, _In_ const OrtValue* const* input,
+                    _Inout_ OrtValue** output);
+ORT_API_STATUS_IMPL(RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_ const char* const* input_names, _In_ const OrtValue* const* input, size_t input_len,
+                    _In_ const char* const* output_names, size_t output_names_len, _Inout_ OrtValue** output,
+                    _In_ RunAsyncCallbackFn callback, _In_opt_ void* user_data);
+ORT_API_STATUS_IMPL(SessionGetMemoryArenaStats, _In_ const OrtSession* sess, _Out_opt_ int64_t* bytes_in_use,
+                    _Out_opt_ int64_t* total_allocated_bytes, _Out_opt_ int64_t* max_bytes_in_use,
+                    _Out_opt_ int64_t* num_allocs);
+ORT_API_STATUS_IMPL(EnableRunResultCache, _Inout_ OrtSessionOptions* options, size_t max_bytes);
+ORT_API_STATUS_IMPL(SessionGetRunResultCacheStats, _In_ const OrtSession* sess, _Out_opt_ int64_t* hits,
+                    _Out_opt_ int64_t* misses, _Out_opt_ int64_t* num_entries, _Out_opt_ int64_t* bytes);
+ORT_API_STATUS_IMPL(SessionWarmUp, _Inout_ OrtSession* sess, _In_reads_(input_count) const char* const* input_names,
+                    _In_reads_(input_count) const int64_t* const* input_shapes,
+                    _In_reads_(input_count) const size_t* input_shape_lengths, size_t input_count);
+ORT_API_STATUS_IMPL(EnableEnvSharedInitializers, _Inout_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(RunOptionsSetCollectRunStats, _Inout_ OrtRunOptions* options, int value);
+ORT_API_STATUS_IMPL(RunOptionsGetRunStats, _In_ const OrtRunOptions* options, _Out_opt_ int64_t* num_allocations,
+                    _Out_opt_ int64_t* bytes_allocated, _Out_opt_ int64_t* peak_bytes, _Out_opt_ int64_t* bytes_copied,
+                    _Out_opt_ int64_t* execution_time_us, _Out_opt_ int64_t* copy_time_us,
+                    _Out_opt_ int64_t* memory_pattern_hit);
+ORT_API_STATUS_IMPL(SessionGetCumulativeRunStats, _In_ const OrtSession* sess, _Out_opt_ int64_t* num_runs,
+                    _Out_opt_ int64_t* num_allocations, _Out_opt_ int64_t* bytes_allocated,
+                    _Out_opt_ int64_t* peak_bytes, _Out_opt_ int64_t* bytes_copied,
+                    _Out_opt_ int64_t* execution_time_us, _Out_opt_ int64_t* copy_time_us,
+                    _Out_opt_ int64_t* memory_pattern_hits);
+ORT_API_STATUS_IMPL(EnableOpStats, _Inout_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(SessionGetOpStatsCount, _In_ const OrtSession* sess, int by_op_type, _Out_ size_t* count);
+ORT_API_STATUS_IMPL(SessionGetOpStats, _In_ const OrtSession* sess, int by_op_type, size_t index,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** name, _Outptr_opt_ char** op_type,
+                    _Out_opt_ int64_t* num_calls, _Out_opt_ int64_t* total_time_us, _Out_opt_ int64_t* min_time_us,
+                    _Out_opt_ int64_t* max_time_us, _Out_opt_ int64_t* p99_time_us, _Out_opt_ int64_t* bytes_read,
+                    _Out_opt_ int64_t* bytes_written, _Out_opt_ int64_t* flops);
+ORT_API_STATUS_IMPL(EnableMemoryProfiling, _Inout_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(SessionGetMemoryArenaUtilization, _In_ const OrtSession* sess, _Out_opt_ int64_t* bytes_in_use,
+                    _Out_opt_ int64_t* bytes_reserved, _Out_opt_ int64_t* largest_free_chunk,
+                    _Out_opt_ int64_t* num_extends);
+ORT_API_STATUS_IMPL(SessionGetThreadPoolStats, _In_ const OrtSession* sess, int inter_op, _Out_opt_ int* num_threads,
+                    _Out_opt_ int64_t* queued_tasks, _Out_opt_ int64_t* active_workers, _Out_opt_ int64_t* num_tasks,
+                    _Out_opt_ int64_t* num_steals);
+ORT_API_STATUS_IMPL(GetEnvThreadPoolStats, _In_ const OrtEnv* env, int inter_op, _Out_opt_ int* num_threads,
+                    _Out_opt_ int64_t* queued_tasks, _Out_opt_ int64_t* active_workers, _Out_opt_ int64_t* num_tasks,
+                    _Out_opt_ int64_t* num_steals);
+ORT_API_STATUS_IMPL(EnableCostBasedPartitioning, _Inout_ OrtSessionOptions* options, double host_gflops,
+                    double device_gflops, double copy_gbps);
+ORT_API_STATUS_IMPL(KernelContext_GetThreadPool, _In_ const OrtKernelContext* context,
+                    _Outptr_result_maybenull_ OrtThreadPool** out);
+ORT_API_STATUS_IMPL(ThreadPool_GetDegreeOfParallelism, _In_opt_ const OrtThreadPool* pool, _Out_ int* out);
+ORT_API_STATUS_IMPL(ThreadPool_ParallelFor, _In_opt_ OrtThreadPool* pool, size_t total,
+                    _In_ void(ORT_API_CALL* fn)(void* user_data, size_t index), _In_opt_ void* user_data);
+ORT_API_STATUS_IMPL(KernelContext_Allocate, _In_ const OrtKernelContext* context, size_t size, _Outptr_ void** out);
+ORT_API_STATUS_IMPL(KernelContext_Free, _In_ const OrtKernelContext* context, _In_opt_ void* p);
+ORT_API_STATUS_IMPL(EnableLazyInitializerLoading, _Inout_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(EnableCudaMixedPrecision, _Inout_ OrtSessionOptions* options, _In_opt_ const char* allow_ops,
+                    _In_opt_ const char* deny_ops);
+ORT_API_STATUS_IMPL(RunOptionsSetPriority, _Inout_ OrtRunOptions* options, int priority);
+ORT_API_STATUS_IMPL(RunOptionsSetDeadline, _Inout_ OrtRunOptions* options, int64_t timeout_ms);
 }  // namespace OrtApis
@@ -90,4 +90,9 @@ onnxruntime::logging::LoggingManager* OrtEnv::GetLoggingManager() const {
 
 void OrtEnv::SetLoggingManager(std::unique_ptr<onnxruntime::logging::LoggingManager> logging_manager) {
   value_->SetLoggingManager(std::move(logging_manager));
+}
+
+onnxruntime::common::Status OrtEnv::RegisterAllocator(onnxruntime::AllocatorPtr allocator) {
+  std::lock_guard<onnxruntime::OrtMutex> lock(m_);
+  return value_->RegisterAllocator(std::move(allocator));
 }
\ No newline at end of file
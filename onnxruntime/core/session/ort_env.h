@@ -8,6 +8,7 @@
 #include "core/common/logging/isink.h"
 #include "core/platform/ort_mutex.h"
 #include "core/common/status.h"
+#include "core/framework/allocator.h"
 
 namespace onnxruntime {
 class Environment;
@@ -55,6 +56,12 @@ struct OrtEnv {
   onnxruntime::logging::LoggingManager* GetLoggingManager() const;
   void SetLoggingManager(std::unique_ptr<onnxruntime::logging::LoggingManager> logging_manager);
 
+  /**
+   * Registers an allocator for sharing between multiple sessions.
+   * Returns an error if an allocator with the same OrtMemoryInfo is already registered.
+  */
+  onnxruntime::common::Status RegisterAllocator(onnxruntime::AllocatorPtr allocator);
+
  private:
   static OrtEnv* p_instance_;
   static onnxruntime::OrtMutex m_;
@@ -0,0 +1,457 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/pipeline_session.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <unordered_set>
+
+#include "core/common/logging/logging.h"
+#include "core/common/path_string.h"
+#include "core/framework/allocator.h"
+#include "core/framework/data_transfer_manager.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/graph/model.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// the values a node reads, including the outer scope values read by its subgraphs
+std::vector<const NodeArg*> GetNodeInputs(const Node& node) {
+  std::vector<const NodeArg*> inputs;
+  for (const auto* defs : {&node.InputDefs(), &node.ImplicitInputDefs()}) {
+    for (const auto* def : *defs) {
+      if (def->Exists() && std::find(inputs.begin(), inputs.end(), def) == inputs.end()) {
+        inputs.push_back(def);
+      }
+    }
+  }
+  return inputs;
+}
+
+void AddValueInfo(const NodeArg& node_arg, google::protobuf::RepeatedPtrField<ONNX_NAMESPACE::ValueInfoProto>& values) {
+  *values.Add() = node_arg.ToProto();
+}
+
+OrtValue MakeCpuTensorValue(MLDataType element_type, const TensorShape& shape, const AllocatorPtr& allocator) {
+  auto p_tensor = onnxruntime::make_unique<Tensor>(element_type, shape, allocator);
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  OrtValue value;
+  value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+  return value;
+}
+
+// Slices the feeds along dimension 0. Feeds that can't be sliced run as a single micro-batch.
+Status SplitFeeds(const NameMLValMap& feeds, int num_micro_batches, const AllocatorPtr& allocator,
+                  std::vector<NameMLValMap>& micro_batches) {
+  int64_t batch_size = -1;
+  bool can_split = num_micro_batches > 1 && !feeds.empty();
+  for (const auto& feed : feeds) {
+    if (!can_split) {
+      break;
+    }
+    if (!feed.second.IsTensor()) {
+      can_split = false;
+      break;
+    }
+    const auto& tensor = feed.second.Get<Tensor>();
+    if (tensor.Location().device.Type() != OrtDevice::CPU || tensor.IsDataTypeString() ||
+        tensor.Shape().NumDimensions() == 0 || (batch_size >= 0 && tensor.Shape()[0] != batch_size)) {
+      can_split = false;
+    } else {
+      batch_size = tensor.Shape()[0];
+    }
+  }
+
+  if (!can_split || batch_size <= 1) {
+    if (num_micro_batches > 1) {
+      LOGS_DEFAULT(WARNING) << "The feeds can't be split along dimension 0, running them as a single micro-batch.";
+    }
+    micro_batches.assign(1, feeds);
+    return Status::OK();
+  }
+
+  const int64_t num_slices = std::min<int64_t>(num_micro_batches, batch_size);
+  micro_batches.resize(static_cast<size_t>(num_slices));
+  for (int64_t m = 0; m < num_slices; ++m) {
+    const int64_t begin = batch_size * m / num_slices;
+    const int64_t end = batch_size * (m + 1) / num_slices;
+    for (const auto& feed : feeds) {
+      const auto& tensor = feed.second.Get<Tensor>();
+      const size_t row_bytes = tensor.SizeInBytes() / static_cast<size_t>(batch_size);
+      std::vector<int64_t> dims = tensor.Shape().GetDims();
+      dims[0] = end - begin;
+      OrtValue slice = MakeCpuTensorValue(tensor.DataType(), TensorShape(dims), allocator);
+      memcpy(slice.GetMutable<Tensor>()->MutableDataRaw(),
+             static_cast<const char*>(tensor.DataRaw()) + begin * row_bytes, (end - begin) * row_bytes);
+      micro_batches[m].insert({feed.first, slice});
+    }
+  }
+
+  return Status::OK();
+}
+
+// Concatenates the outputs of the micro-batches along dimension 0.
+Status ConcatFetches(const std::string& name, const std::vector<OrtValue>& parts, const AllocatorPtr& allocator,
+                     OrtValue& fetch) {
+  if (parts.size() == 1) {
+    fetch = parts[0];
+    return Status::OK();
+  }
+
+  const auto& first = parts[0].Get<Tensor>();
+  std::vector<int64_t> dims = first.Shape().GetDims();
+  if (dims.empty() || first.IsDataTypeString()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The micro-batches of output ", name, " can't be concatenated.");
+  }
+
+  dims[0] = 0;
+  for (const auto& part : parts) {
+    const auto& tensor = part.Get<Tensor>();
+    const auto& part_dims = tensor.Shape().GetDims();
+    if (tensor.DataType() != first.DataType() || part_dims.size() != dims.size() ||
+        !std::equal(part_dims.begin() + 1, part_dims.end(), dims.begin() + 1)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The micro-batches of output ", name,
+                             " have different shapes, they can't be concatenated.");
+    }
+    dims[0] += part_dims[0];
+  }
+
+  fetch = MakeCpuTensorValue(first.DataType(), TensorShape(dims), allocator);
+  char* data = static_cast<char*>(fetch.GetMutable<Tensor>()->MutableDataRaw());
+  for (const auto& part : parts) {
+    const auto& tensor = part.Get<Tensor>();
+    memcpy(data, tensor.DataRaw(), tensor.SizeInBytes());
+    data += tensor.SizeInBytes();
+  }
+
+  return Status::OK();
+}
+
+}  // namespace
+
+PipelineSession::PipelineSession(const SessionOptions& session_options, const Environment& session_env,
+                                 const PipelineSessionOptions& pipeline_options,
+                                 PipelineProviderFactory provider_factory)
+    : session_options_(session_options),
+      session_env_(session_env),
+      pipeline_options_(pipeline_options),
+      provider_factory_(std::move(provider_factory)) {
+}
+
+PipelineSession::~PipelineSession() = default;
+
+Status PipelineSession::Load(const std::string& model_uri) {
+  ONNX_NAMESPACE::ModelProto model_proto;
+  ORT_RETURN_IF_ERROR(Model::Load(ToPathString(model_uri), model_proto));
+  return Load(model_proto);
+}
+
+Status PipelineSession::Load(const ONNX_NAMESPACE::ModelProto& model_proto) {
+  if (!stages_.empty()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The pipeline has already been loaded.");
+  }
+  const size_t num_devices = pipeline_options_.device_ids.size();
+  if (num_devices == 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The pipeline has no device to run on.");
+  }
+
+  std::shared_ptr<Model> model;
+  ORT_RETURN_IF_ERROR(Model::Load(model_proto, model, nullptr, logging::LoggingManager::DefaultLogger()));
+  const Graph& graph = model->MainGraph();
+  const auto& initializers = graph.GetAllInitializedTensors();
+
+  std::unordered_map<std::string, size_t> initializer_bytes;
+  size_t total_bytes = 0;
+  for (const auto& initializer : initializers) {
+    size_t bytes = 0;
+    ORT_RETURN_IF_ERROR(utils::GetSizeInBytesFromTensorProto<0>(*initializer.second, &bytes));
+    initializer_bytes[initializer.first] = bytes;
+    total_bytes += bytes;
+  }
+  const size_t budget = pipeline_options_.device_memory_budget > 0 ? pipeline_options_.device_memory_budget
+                                                                   : (total_bytes + num_devices - 1) / num_devices;
+
+  // assign the nodes in topological order, a new stage starts when the next node's initializers exceed the budget
+  std::vector<std::vector<const Node*>> stage_nodes(1);
+  std::vector<size_t> stage_bytes(1, 0);
+  std::unordered_set<std::string> stage_initializers;
+  GraphViewer graph_viewer(graph);
+  for (auto node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+    const Node* node = graph.GetNode(node_index);
+    std::vector<std::string> node_initializers;
+    for (const auto* input : GetNodeInputs(*node)) {
+      if (initializer_bytes.count(input->Name()) > 0) {
+        node_initializers.push_back(input->Name());
+      }
+    }
+
+    auto new_bytes = [&]() {
+      size_t bytes = 0;
+      for (const auto& name : node_initializers) {
+        bytes += stage_initializers.count(name) > 0 ? 0 : initializer_bytes[name];
+      }
+      return bytes;
+    };
+
+    if (!stage_nodes.back().empty() && stage_nodes.size() < num_devices && stage_bytes.back() + new_bytes() > budget) {
+      stage_nodes.emplace_back();
+      stage_bytes.push_back(0);
+      stage_initializers.clear();
+    }
+
+    stage_bytes.back() += new_bytes();
+    stage_initializers.insert(node_initializers.begin(), node_initializers.end());
+    stage_nodes.back().push_back(node);
+  }
+
+  // where each value is produced and the last stage that reads it
+  std::unordered_map<std::string, size_t> producer_stages;
+  std::unordered_map<std::string, size_t> last_consumer_stages;
+  for (size_t s = 0; s < stage_nodes.size(); ++s) {
+    for (const Node* node : stage_nodes[s]) {
+      for (const auto* output : node->OutputDefs()) {
+        if (output->Exists()) {
+          producer_stages[output->Name()] = s;
+        }
+      }
+      for (const auto* input : GetNodeInputs(*node)) {
+        last_consumer_stages[input->Name()] = s;
+      }
+    }
+  }
+
+  std::unordered_set<std::string> graph_outputs;
+  for (const auto* output : graph.GetOutputs()) {
+    graph_outputs.insert(output->Name());
+  }
+
+  stages_.resize(stage_nodes.size());
+  for (size_t s = 0; s < stage_nodes.size(); ++s) {
+    Stage& stage = stages_[s];
+    stage.device_id = pipeline_options_.device_ids[s];
+
+    ONNX_NAMESPACE::ModelProto stage_proto;
+    stage_proto.set_ir_version(model_proto.ir_version());
+    *stage_proto.mutable_opset_import() = model_proto.opset_import();
+    stage_proto.set_producer_name(model_proto.producer_name());
+    stage_proto.set_producer_version(model_proto.producer_version());
+    stage_proto.set_domain(model_proto.domain());
+    stage_proto.set_model_version(model_proto.model_version());
+    auto& graph_proto = *stage_proto.mutable_graph();
+    graph_proto.set_name(graph.Name() + "_stage_" + std::to_string(s));
+
+    std::unordered_set<std::string> stage_inputs;
+    for (const Node* node : stage_nodes[s]) {
+      node->ToProto(*graph_proto.add_node());
+      for (const auto* input : GetNodeInputs(*node)) {
+        const auto& name = input->Name();
+        if (!stage_inputs.insert(name).second) {
+          continue;
+        }
+
+        auto initializer = initializers.find(name);
+        auto producer = producer_stages.find(name);
+        if (initializer != initializers.end()) {
+          *graph_proto.add_initializer() = *initializer->second;
+        } else if (producer == producer_stages.end() || producer->second < s) {
+          if (input->TypeAsProto() == nullptr) {
+            return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The model can't be split before value ", name,
+                                   " as its type is unknown.");
+          }
+          AddValueInfo(*input, *graph_proto.mutable_input());
+          stage.input_names.push_back(name);
+        }
+      }
+    }
+
+    for (const Node* node : stage_nodes[s]) {
+      for (const auto* output : node->OutputDefs()) {
+        if (!output->Exists()) {
+          continue;
+        }
+        const auto& name = output->Name();
+        auto consumer = last_consumer_stages.find(name);
+        if (graph_outputs.count(name) > 0 || (consumer != last_consumer_stages.end() && consumer->second > s)) {
+          if (output->TypeAsProto() == nullptr) {
+            return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The model can't be split after value ", name,
+                                   " as its type is unknown.");
+          }
+          AddValueInfo(*output, *graph_proto.mutable_output());
+          stage.output_names.push_back(name);
+          producer_stages_[name] = s;
+        }
+      }
+    }
+
+    for (const auto& name : stage.input_names) {
+      if (last_consumer_stages[name] == s && graph_outputs.count(name) == 0) {
+        stage.last_use_names.push_back(name);
+      }
+    }
+
+    LOGS_DEFAULT(INFO) << "Pipeline stage " << s << " on device " << stage.device_id << ": "
+                       << stage_nodes[s].size() << " nodes, " << stage_bytes[s] << " bytes of initializers, "
+                       << stage.input_names.size() << " inputs, " << stage.output_names.size() << " outputs";
+
+    ORT_RETURN_IF_ERROR(CreateStage(stage_proto, stage));
+  }
+
+  return Status::OK();
+}
+
+Status PipelineSession::CreateStage(const ONNX_NAMESPACE::ModelProto& stage_proto, Stage& stage) {
+  stage.session = onnxruntime::make_unique<InferenceSession>(session_options_, session_env_);
+  if (provider_factory_) {
+    auto provider = provider_factory_(stage.device_id);
+    if (provider != nullptr) {
+      ORT_RETURN_IF_ERROR(stage.session->RegisterExecutionProvider(std::move(provider)));
+    }
+  }
+
+  std::string model_data;
+  if (!stage_proto.SerializeToString(&model_data)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to serialize the model of pipeline stage on device ",
+                           stage.device_id);
+  }
+  return stage.session->Load(model_data.data(), static_cast<int>(model_data.size()));
+}
+
+Status PipelineSession::Initialize() {
+  if (stages_.empty()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Load the model before initializing the pipeline.");
+  }
+  for (auto& stage : stages_) {
+    ORT_RETURN_IF_ERROR(stage.session->Initialize());
+  }
+  return Status::OK();
+}
+
+Status PipelineSession::Run(const RunOptions& run_options, const NameMLValMap& feeds,
+                            const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches) {
+  if (stages_.empty()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Load and initialize the pipeline before running it.");
+  }
+  if (p_fetches == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Output vector pointer is NULL");
+  }
+  for (const auto& name : output_names) {
+    if (producer_stages_.count(name) == 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid Output Name:", name);
+    }
+  }
+
+  auto cpu_allocator = std::make_shared<CPUAllocator>();
+
+  // micro_batches[m] holds the feeds of micro-batch m and the outputs of the stages done with it
+  std::vector<NameMLValMap> micro_batches;
+  ORT_RETURN_IF_ERROR(SplitFeeds(feeds, pipeline_options_.num_micro_batches, cpu_allocator, micro_batches));
+  const size_t num_micro_batches = micro_batches.size();
+  std::unordered_set<std::string> requested_outputs(output_names.begin(), output_names.end());
+
+  OrtMutex mutex;
+  OrtCondVar cv;
+  std::vector<size_t> done_stages(num_micro_batches, 0);
+  Status status;
+
+  auto run_stage = [&](size_t s) {
+    Stage& stage = stages_[s];
+    RunOptions stage_run_options;
+    stage_run_options.run_log_severity_level = run_options.run_log_severity_level;
+    stage_run_options.run_log_verbosity_level = run_options.run_log_verbosity_level;
+    stage_run_options.run_tag = run_options.run_tag;
+    // the outputs of the last stage go to CPU memory, the other stages hand theirs over on their device
+    stage_run_options.fetches_on_device = s + 1 < stages_.size();
+
+    for (size_t m = 0; m < num_micro_batches; ++m) {
+      std::vector<OrtValue> stage_feeds;
+      {
+        std::unique_lock<OrtMutex> lock(mutex);
+        cv.wait(lock, [&]() { return done_stages[m] == s || !status.IsOK(); });
+        if (status.IsOK() && run_options.terminate) {
+          status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+        }
+        if (!status.IsOK()) {
+          cv.notify_all();
+          return;
+        }
+
+        for (const auto& name : stage.input_names) {
+          auto value = micro_batches[m].find(name);
+          if (value == micro_batches[m].end()) {
+            status = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Missing Input: ", name);
+            cv.notify_all();
+            return;
+          }
+          stage_feeds.push_back(value->second);
+        }
+      }
+
+      std::vector<OrtValue> stage_fetches;
+      auto stage_status = stage.session->Run(stage_run_options, stage.input_names, stage_feeds,
+                                             stage.output_names, &stage_fetches);
+
+      {
+        std::lock_guard<OrtMutex> lock(mutex);
+        if (!stage_status.IsOK()) {
+          if (status.IsOK()) {
+            status = stage_status;
+          }
+        } else {
+          for (size_t i = 0; i < stage.output_names.size(); ++i) {
+            micro_batches[m][stage.output_names[i]] = stage_fetches[i];
+          }
+          // free the device memory of the boundary values the later stages don't read
+          for (const auto& name : stage.last_use_names) {
+            if (requested_outputs.count(name) == 0) {
+              micro_batches[m].erase(name);
+            }
+          }
+          done_stages[m] = s + 1;
+        }
+      }
+      cv.notify_all();
+      if (!stage_status.IsOK()) {
+        return;
+      }
+    }
+  };
+
+  std::vector<std::thread> stage_threads;
+  for (size_t s = 1; s < stages_.size(); ++s) {
+    stage_threads.emplace_back(run_stage, s);
+  }
+  run_stage(0);
+  for (auto& thread : stage_threads) {
+    thread.join();
+  }
+  ORT_RETURN_IF_ERROR(status);
+
+  p_fetches->resize(output_names.size());
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    const auto& name = output_names[i];
+    const auto& data_transfer_mgr = stages_[producer_stages_[name]].session->GetDataTransferManager();
+    std::vector<OrtValue> parts;
+    for (auto& micro_batch : micro_batches) {
+      const OrtValue& value = micro_batch[name];
+      if (value.IsTensor() && value.Get<Tensor>().Location().device.Type() != OrtDevice::CPU) {
+        const auto& tensor = value.Get<Tensor>();
+        OrtValue cpu_value = MakeCpuTensorValue(tensor.DataType(), tensor.Shape(), cpu_allocator);
+        ORT_RETURN_IF_ERROR(data_transfer_mgr.CopyTensor(tensor, *cpu_value.GetMutable<Tensor>()));
+        parts.push_back(cpu_value);
+      } else {
+        parts.push_back(value);
+      }
+    }
+    ORT_RETURN_IF_ERROR(ConcatFetches(name, parts, cpu_allocator, (*p_fetches)[i]));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
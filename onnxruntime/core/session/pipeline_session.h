@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/execution_provider.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/session_options.h"
+#include "core/graph/onnx_protobuf.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+/**
+ * Configuration of a PipelineSession.
+ */
+struct PipelineSessionOptions {
+  // Devices of the pipeline stages, in stage order. The model is split into at most this many stages.
+  std::vector<int> device_ids;
+
+  // Bytes of initializers a stage may hold before the next stage starts. 0 spreads the initializers evenly over
+  // the devices. The last stage takes the remaining nodes whatever their size.
+  size_t device_memory_budget = 0;
+
+  // Number of slices the batch, dimension 0 of every input, is split into. While stage s runs micro-batch m,
+  // stage s - 1 runs micro-batch m + 1.
+  int num_micro_batches = 1;
+};
+
+// Creates the execution provider of the stage on a device, e.g. the CUDA execution provider of the device.
+using PipelineProviderFactory = std::function<std::unique_ptr<IExecutionProvider>(int device_id)>;
+
+/**
+ * Runs a model that doesn't fit on one device as a pipeline of sessions, one per device.
+ *
+ * Load splits the nodes, in topological order, into contiguous stages by the size of the initializers they use,
+ * and creates an InferenceSession per stage with the execution provider of its device. The values crossing a stage
+ * boundary stay on the device of the stage that produced them and the next stage copies them to its device through
+ * its DataTransferManager, peer to peer between CUDA devices. Run splits the inputs into micro-batches that flow
+ * through the stages concurrently, and concatenates the outputs of the micro-batches.
+ *
+ * Sample usage:
+ *  PipelineSessionOptions pipeline_options;
+ *  pipeline_options.device_ids = {0, 1};
+ *  pipeline_options.num_micro_batches = 4;
+ *  PipelineSession session{session_options, env, pipeline_options, [](int device_id) {
+ *    return CreateExecutionProviderFactory_CUDA(device_id)->CreateProvider();
+ *  }};
+ *  ORT_RETURN_IF_ERROR(session.Load(model_uri));
+ *  ORT_RETURN_IF_ERROR(session.Initialize());
+ *  ORT_RETURN_IF_ERROR(session.Run(run_options, feeds, output_names, &fetches));
+ */
+class PipelineSession {
+ public:
+  PipelineSession(const SessionOptions& session_options, const Environment& session_env,
+                  const PipelineSessionOptions& pipeline_options, PipelineProviderFactory provider_factory);
+
+  ~PipelineSession();
+
+  /**
+    * Split the model into stages and load the session of each stage.
+    */
+  common::Status Load(const std::string& model_uri);
+  common::Status Load(const ONNX_NAMESPACE::ModelProto& model_proto);
+
+  common::Status Initialize();
+
+  /**
+    * Run the model on the feeds. The feeds are split into micro-batches along dimension 0 when they are all tensors
+    * in CPU memory with the same dimension 0, otherwise they run as one batch. The fetches are in CPU memory.
+    */
+  common::Status Run(const RunOptions& run_options, const NameMLValMap& feeds,
+                     const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches);
+
+  size_t NumStages() const { return stages_.size(); }
+
+  // Names of the values the stage reads and produces.
+  const std::vector<std::string>& GetStageInputs(size_t stage) const { return stages_[stage].input_names; }
+  const std::vector<std::string>& GetStageOutputs(size_t stage) const { return stages_[stage].output_names; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PipelineSession);
+
+  struct Stage {
+    int device_id;
+    std::vector<std::string> input_names;
+    std::vector<std::string> output_names;
+    // values no later stage reads, released once the stage is done with a micro-batch
+    std::vector<std::string> last_use_names;
+    std::unique_ptr<InferenceSession> session;
+  };
+
+  common::Status CreateStage(const ONNX_NAMESPACE::ModelProto& stage_proto, Stage& stage);
+
+  const SessionOptions session_options_;
+  const Environment& session_env_;
+  const PipelineSessionOptions pipeline_options_;
+  const PipelineProviderFactory provider_factory_;
+
+  std::vector<Stage> stages_;
+  // stage that produces each stage output
+  std::unordered_map<std::string, size_t> producer_stages_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,166 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/run_result_cache.h"
+
+#include <cstring>
+#include <unordered_set>
+
+#include "core/framework/data_types.h"
+#include "core/framework/tensor.h"
+#include "core/graph/constants.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Ops whose outputs differ between two runs with the same inputs.
+const std::unordered_set<std::string> kNondeterministicOps = {"RandomNormal", "RandomUniform", "RandomNormalLike",
+                                                             "RandomUniformLike", "Multinomial", "Dropout",
+                                                             "TrainableDropout"};
+
+bool IsCachedTensor(const OrtValue& value) {
+  if (!value.IsTensor()) {
+    return false;
+  }
+  const auto& tensor = value.Get<Tensor>();
+  return tensor.Location().device.Type() == OrtDevice::CPU && !tensor.IsDataTypeString();
+}
+
+void AppendBytes(const void* data, size_t size, std::string& key) {
+  key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+  key.append(static_cast<const char*>(data), size);
+}
+
+void AppendString(const std::string& value, std::string& key) {
+  AppendBytes(value.data(), value.size(), key);
+}
+
+OrtValue CopyTensor(const Tensor& tensor, const AllocatorPtr& allocator) {
+  auto copy = onnxruntime::make_unique<Tensor>(tensor.DataType(), tensor.Shape(), allocator);
+  if (tensor.SizeInBytes() > 0) {
+    memcpy(copy->MutableDataRaw(), tensor.DataRaw(), tensor.SizeInBytes());
+  }
+  OrtValue value;
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  value.Init(copy.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+  return value;
+}
+
+}  // namespace
+
+RunResultCache::RunResultCache(size_t max_bytes) : max_bytes_(max_bytes), allocator_(std::make_shared<CPUAllocator>()) {}
+
+bool RunResultCache::IsDeterministic(const Graph& graph) {
+  for (const auto& node : graph.Nodes()) {
+    const auto& domain = node.Domain();
+    if ((domain != kOnnxDomain && domain != kOnnxDomainAlias && domain != kMLDomain && domain != kMSDomain &&
+         domain != kMSNchwcDomain) ||
+        kNondeterministicOps.count(node.OpType()) != 0) {
+      return false;
+    }
+    if (node.ContainsSubgraph()) {
+      for (const auto* subgraph : node.GetSubgraphs()) {
+        if (!IsDeterministic(*subgraph)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool RunResultCache::MakeKey(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                             const std::vector<std::string>& output_names, std::string& key) {
+  key.clear();
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (!IsCachedTensor(feeds[i])) {
+      key.clear();
+      return false;
+    }
+    const auto& tensor = feeds[i].Get<Tensor>();
+    const auto& dims = tensor.Shape().GetDims();
+    AppendString(feed_names[i], key);
+    const auto* type = tensor.DataType();
+    key.append(reinterpret_cast<const char*>(&type), sizeof(type));
+    AppendBytes(dims.data(), dims.size() * sizeof(int64_t), key);
+    AppendBytes(tensor.DataRaw(), tensor.SizeInBytes(), key);
+  }
+  for (const auto& name : output_names) {
+    AppendString(name, key);
+  }
+  return true;
+}
+
+bool RunResultCache::Lookup(const std::string& key, std::vector<OrtValue>& fetches) {
+  std::vector<OrtValue> cached;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      ++misses_;
+      return false;
+    }
+    ++hits_;
+    lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+    cached = it->second.fetches;  // shares the buffers, which are never modified
+  }
+
+  // copied outside the lock, the entry may be evicted meanwhile
+  fetches.clear();
+  fetches.reserve(cached.size());
+  for (const auto& value : cached) {
+    fetches.push_back(CopyTensor(value.Get<Tensor>(), allocator_));
+  }
+  return true;
+}
+
+void RunResultCache::Insert(const std::string& key, const std::vector<OrtValue>& fetches) {
+  size_t bytes = key.size();
+  for (const auto& value : fetches) {
+    if (!IsCachedTensor(value)) {
+      return;
+    }
+    bytes += value.Get<Tensor>().SizeInBytes();
+  }
+  if (bytes > max_bytes_) {
+    return;
+  }
+
+  std::vector<OrtValue> copies;
+  copies.reserve(fetches.size());
+  for (const auto& value : fetches) {
+    copies.push_back(CopyTensor(value.Get<Tensor>(), allocator_));
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (entries_.count(key) != 0) {
+    return;  // cached by a concurrent run
+  }
+  EvictUntilFits(bytes);
+  auto it = entries_.emplace(key, Entry{std::move(copies), bytes, {}}).first;
+  lru_.push_front(&it->first);
+  it->second.lru_position = lru_.begin();
+  bytes_ += bytes;
+}
+
+void RunResultCache::EvictUntilFits(size_t bytes) {
+  while (!lru_.empty() && bytes_ + bytes > max_bytes_) {
+    auto it = entries_.find(*lru_.back());
+    bytes_ -= it->second.bytes;
+    lru_.pop_back();
+    entries_.erase(it);
+  }
+}
+
+RunResultCacheStats RunResultCache::GetStats() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  RunResultCacheStats stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.num_entries = static_cast<int64_t>(entries_.size());
+  stats.bytes = static_cast<int64_t>(bytes_);
+  return stats;
+}
+
+}  // namespace onnxruntime
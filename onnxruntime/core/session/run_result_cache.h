@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/framework/allocator.h"
+#include "core/framework/ml_value.h"
+#include "core/graph/graph.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+struct RunResultCacheStats {
+  int64_t hits = 0;
+  int64_t misses = 0;
+  int64_t num_entries = 0;
+  int64_t bytes = 0;  // bytes held by the entries, keys included
+};
+
+/**
+ * LRU cache of the outputs of the Run calls of a session, for deterministic models that get the same inputs
+ * repeatedly. A run is keyed by its input and output names and the types, shapes and bytes of its inputs, so a hit is
+ * exact. The map of the keys uses a hash of all of that.
+ *
+ * Only the runs whose inputs are non-string tensors in CPU memory are cached, and only if their outputs are too.
+ * The entries hold copies of the outputs, and lookups return new copies, so the callers can modify them. The keys and
+ * the outputs count towards the bytes of the cache, which evicts the least recently used entries to stay below its
+ * maximum. This class is thread-safe.
+ */
+class RunResultCache {
+ public:
+  explicit RunResultCache(size_t max_bytes);
+
+  // Returns true if the outputs of the graph only depend on its inputs: none of its nodes or the nodes of its
+  // subgraphs is a random op or a custom op, which may not be deterministic.
+  static bool IsDeterministic(const Graph& graph);
+
+  // Sets `key` to the key of a run and returns true, or clears it and returns false if the run can't be cached.
+  static bool MakeKey(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                      const std::vector<std::string>& output_names, std::string& key);
+
+  // Sets `fetches` to copies of the outputs cached for `key` and returns true, or returns false if there are none.
+  bool Lookup(const std::string& key, std::vector<OrtValue>& fetches);
+
+  // Caches copies of the outputs of the run of `key`, unless they can't be cached or don't fit in the cache.
+  void Insert(const std::string& key, const std::vector<OrtValue>& fetches);
+
+  RunResultCacheStats GetStats() const;
+
+ private:
+  struct Entry {
+    std::vector<OrtValue> fetches;
+    size_t bytes;
+    std::list<const std::string*>::iterator lru_position;
+  };
+
+  void EvictUntilFits(size_t bytes);
+
+  const size_t max_bytes_;
+  AllocatorPtr allocator_;  // of the cached outputs and their copies
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::list<const std::string*> lru_;  // the keys of the entries, the most recently used first
+  size_t bytes_ = 0;
+  int64_t hits_ = 0;
+  int64_t misses_ = 0;
+};
+
+}  // namespace onnxruntime
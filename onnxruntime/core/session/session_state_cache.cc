@@ -0,0 +1,255 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/session_state_cache.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include "core/framework/tensor_external_data_info.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/onnx_protobuf.h"
+#include "core/platform/env.h"
+#include "core/platform/path_lib.h"
+#include "gsl/gsl"
+#include "core/util/protobuf_parsing_utils.h"
+#include "onnxruntime_config.h"
+
+namespace onnxruntime {
+namespace session_state_cache {
+
+static constexpr const char* kCacheKeyMetadataKey = "onnxruntime.session_state_cache.key";
+static constexpr const char* kPlacementsMetadataKey = "onnxruntime.session_state_cache.placements";
+
+// initializers of at least this size go to the data file, the others stay in the graph
+static constexpr size_t kMinDataFileBytes = 4096;
+// offset alignment of the initializers in the data file, enough for any element type and for the vectorized kernels
+static constexpr size_t kDataFileAlignment = 64;
+
+// FNV-1a, which unlike std::hash gives the same value in every process
+static void HashBytes(const std::string& bytes, uint64_t& hash) {
+  for (unsigned char c : bytes) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  // separate consecutive values so ("ab", "c") and ("a", "bc") hash differently
+  hash ^= 0xff;
+  hash *= 1099511628211ULL;
+}
+
+std::string ComputeKey(Model& model, const SessionOptions& session_options,
+                       const std::vector<std::string>& provider_types,
+                       const std::vector<std::string>& transformers_to_enable) {
+  uint64_t hash = 14695981039346656037ULL;
+  HashBytes(ORT_VERSION, hash);
+  HashBytes(model.ToProto().SerializeAsString(), hash);
+  HashBytes(std::to_string(static_cast<int>(session_options.graph_optimization_level)), hash);
+  for (const auto& provider_type : provider_types) {
+    HashBytes(provider_type, hash);
+  }
+  for (const auto& transformer : transformers_to_enable) {
+    HashBytes(transformer, hash);
+  }
+  for (const auto& free_dim_override : session_options.free_dimension_overrides) {
+    HashBytes(free_dim_override.dimension_identifier, hash);
+    HashBytes(std::to_string(static_cast<int>(free_dim_override.dimension_identifier_type)), hash);
+    HashBytes(std::to_string(free_dim_override.dimension_override), hash);
+  }
+
+  std::ostringstream key;
+  key << std::hex << hash;
+  return key.str();
+}
+
+bool CanCache(const Graph& graph) {
+  for (const auto& node : graph.Nodes()) {
+    // placements are keyed on the first output of each node
+    if (node.NodeType() == Node::Type::Fused || node.ContainsSubgraph() || node.OutputDefs().empty() ||
+        node.GetExecutionProviderType().empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static std::basic_string<ORTCHAR_T> GetDataFilePath(const std::basic_string<ORTCHAR_T>& cache_file_path) {
+  return cache_file_path + ORT_TSTR(".data");
+}
+
+// the raw data of an initializer with raw or external data, empty if it has neither
+static Status GetInitializerData(const ONNX_NAMESPACE::TensorProto& tensor,
+                                 const std::basic_string<ORTCHAR_T>& model_location, std::string& data) {
+  data.clear();
+  if (tensor.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    return Status::OK();
+  }
+  if (tensor.data_location() != ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL) {
+    if (utils::HasRawData(tensor)) {
+      data = tensor.raw_data();
+    }
+    return Status::OK();
+  }
+
+  std::unique_ptr<ExternalDataInfo> external_data_info;
+  ORT_RETURN_IF_ERROR(ExternalDataInfo::Create(tensor.external_data(), external_data_info));
+  std::basic_string<ORTCHAR_T> data_path = external_data_info->GetRelPath();
+  if (!model_location.empty()) {
+    std::basic_string<ORTCHAR_T> model_dir;
+    ORT_RETURN_IF_ERROR(GetDirNameFromFilePath(model_location, model_dir));
+    data_path = ConcatPathComponent<ORTCHAR_T>(model_dir, data_path);
+  }
+  size_t length = external_data_info->GetLength();
+  if (length == 0) {
+    ORT_RETURN_IF_ERROR(utils::GetSizeInBytesFromTensorProto<0>(tensor, &length));
+  }
+  data.resize(length);
+  return Env::Default().ReadFileIntoBuffer(data_path.c_str(), external_data_info->GetOffset(), length,
+                                           gsl::make_span(&data[0], length));
+}
+
+// moves the data of the large initializers of the graph to the data file, and makes the others inline
+static Status WriteDataFile(ONNX_NAMESPACE::GraphProto& graph_proto, const std::basic_string<ORTCHAR_T>& model_location,
+                            const std::basic_string<ORTCHAR_T>& cache_file_path) {
+  const auto data_file_path = GetDataFilePath(cache_file_path);
+  std::basic_string<ORTCHAR_T> data_file_name = data_file_path;
+  const auto separator = data_file_name.find_last_of(ORT_TSTR("/\\"));
+  if (separator != std::basic_string<ORTCHAR_T>::npos) {
+    data_file_name = data_file_name.substr(separator + 1);
+  }
+
+  std::ofstream data_file(data_file_path, std::ios::binary | std::ios::trunc);
+  ORT_RETURN_IF_NOT(data_file.good(), "Failed to create ", ToMBString(data_file_path));
+  size_t offset = 0;
+  std::string data;
+  for (auto& tensor : *graph_proto.mutable_initializer()) {
+    ORT_RETURN_IF_ERROR(GetInitializerData(tensor, model_location, data));
+    if (tensor.data_location() == ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL) {
+      tensor.clear_external_data();
+      tensor.clear_data_location();
+      if (data.size() < kMinDataFileBytes) {
+        tensor.set_raw_data(data);
+        continue;
+      }
+    } else if (data.size() < kMinDataFileBytes) {
+      continue;
+    }
+
+    const size_t padding = (kDataFileAlignment - offset % kDataFileAlignment) % kDataFileAlignment;
+    data_file.write(std::string(padding, '\0').data(), padding);
+    offset += padding;
+    data_file.write(data.data(), data.size());
+
+    tensor.clear_raw_data();
+    tensor.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
+    auto* location = tensor.add_external_data();
+    location->set_key("location");
+    location->set_value(ToMBString(data_file_name));
+    auto* offset_entry = tensor.add_external_data();
+    offset_entry->set_key("offset");
+    offset_entry->set_value(std::to_string(offset));
+    auto* length_entry = tensor.add_external_data();
+    length_entry->set_key("length");
+    length_entry->set_value(std::to_string(data.size()));
+    offset += data.size();
+  }
+  data_file.close();
+  ORT_RETURN_IF_NOT(data_file.good(), "Failed to write ", ToMBString(data_file_path));
+  return Status::OK();
+}
+
+Status Save(Model& model, const std::string& key, const std::basic_string<ORTCHAR_T>& model_location,
+            const std::basic_string<ORTCHAR_T>& cache_file_path) {
+  // one line per node: <first output name> <tab> <execution provider>
+  std::ostringstream placements;
+  for (const auto& node : model.MainGraph().Nodes()) {
+    placements << node.OutputDefs()[0]->Name() << '\t' << node.GetExecutionProviderType() << '\n';
+  }
+
+  auto model_proto = model.ToProto();
+  ORT_RETURN_IF_ERROR(WriteDataFile(*model_proto.mutable_graph(), model_location, cache_file_path));
+  auto* key_entry = model_proto.add_metadata_props();
+  key_entry->set_key(kCacheKeyMetadataKey);
+  key_entry->set_value(key);
+  auto* placements_entry = model_proto.add_metadata_props();
+  placements_entry->set_key(kPlacementsMetadataKey);
+  placements_entry->set_value(placements.str());
+
+  int fd;
+  ORT_RETURN_IF_ERROR(Env::Default().FileOpenWr(cache_file_path, fd));
+  bool result;
+  {
+    google::protobuf::io::FileOutputStream output(fd);
+    result = model_proto.SerializeToZeroCopyStream(&output) && output.Flush();
+  }
+  ORT_RETURN_IF_ERROR(Env::Default().FileClose(fd));
+  if (!result) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_PROTOBUF, "Failed to serialize the session state cache.");
+  }
+  return Status::OK();
+}
+
+Status Load(const std::basic_string<ORTCHAR_T>& cache_file_path, const std::string& key,
+            const IOnnxRuntimeOpSchemaRegistryList* local_registries, const logging::Logger& logger,
+            std::shared_ptr<Model>& model, bool& loaded) {
+  loaded = false;
+
+  ONNX_NAMESPACE::ModelProto model_proto;
+  if (!Model::Load(cache_file_path, model_proto).IsOK()) {
+    LOGS(logger, INFO) << "No session state cache was found.";
+    return Status::OK();
+  }
+
+  // take the cache entries out of the metadata, so the loaded model has the metadata of the original model
+  std::string cached_key;
+  std::string placements;
+  auto* metadata_props = model_proto.mutable_metadata_props();
+  for (auto it = metadata_props->begin(); it != metadata_props->end();) {
+    if (it->key() == kCacheKeyMetadataKey) {
+      cached_key = it->value();
+      it = metadata_props->erase(it);
+    } else if (it->key() == kPlacementsMetadataKey) {
+      placements = it->value();
+      it = metadata_props->erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (cached_key != key) {
+    LOGS(logger, INFO) << "The session state cache was created for a different model or configuration.";
+    return Status::OK();
+  }
+
+  std::unordered_map<std::string, std::string> output_to_provider;
+  std::istringstream placements_stream(placements);
+  std::string line;
+  while (std::getline(placements_stream, line)) {
+    auto tab = line.find('\t');
+    if (tab == std::string::npos) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Invalid node placement in the session state cache: ", line);
+    }
+    output_to_provider[line.substr(0, tab)] = line.substr(tab + 1);
+  }
+
+  std::shared_ptr<Model> cached_model;
+  // the initializers in the data file are relative to the cache file
+  ORT_RETURN_IF_ERROR(Model::Load(std::move(model_proto), cache_file_path, cached_model, local_registries, logger));
+
+  for (auto& node : cached_model->MainGraph().Nodes()) {
+    auto it = node.OutputDefs().empty() ? output_to_provider.end()
+                                        : output_to_provider.find(node.OutputDefs()[0]->Name());
+    if (it == output_to_provider.end()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The session state cache has no placement for node ", node.Name());
+    }
+    node.SetExecutionProviderType(it->second);
+  }
+
+  model = std::move(cached_model);
+  loaded = true;
+  return Status::OK();
+}
+
+}  // namespace session_state_cache
+}  // namespace onnxruntime
@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/session_options.h"
+#include "core/graph/model.h"
+
+namespace onnxruntime {
+
+/**
+ * Cache of the graph of a session after the graph transformations and partitioning, so a process loading the same
+ * model with the same options and execution providers can skip them.
+ *
+ * The cache file is an ONNX model holding the transformed graph. Its metadata records the key the cache was created
+ * for and the execution provider each node was assigned to. The key is a hash of the original model, the session
+ * options that affect the transformations, the registered execution providers and the onnxruntime version, so a
+ * stale cache is ignored and replaced.
+ *
+ * The initializers of at least 4 KiB with raw or external data are written to a data file next to the cache file
+ * (<cache file>.data), at offsets aligned for any element type, and the cached graph refers to them as external data.
+ * Loading the cache then only parses the graph structure, and the session state maps the initializers on the CPU
+ * from the data file in place instead of copying them. The model loaded from the cache has the path of the cache
+ * file, which the external data of its initializers is relative to.
+ *
+ * Graphs with subgraphs or nodes fused by an execution provider are not cached, as they can't be recreated from the
+ * saved graph alone.
+ */
+namespace session_state_cache {
+
+std::string ComputeKey(Model& model, const SessionOptions& session_options,
+                       const std::vector<std::string>& provider_types,
+                       const std::vector<std::string>& transformers_to_enable);
+
+// Returns true if the transformed and partitioned graph can be restored from a cache file.
+bool CanCache(const Graph& graph);
+
+// Saves the graph of 'model', loaded from 'model_location' (empty if it wasn't loaded from a file), which the external
+// data of its initializers is relative to.
+common::Status Save(Model& model, const std::string& key, const std::basic_string<ORTCHAR_T>& model_location,
+                    const std::basic_string<ORTCHAR_T>& cache_file_path);
+
+// Loads the cached graph into 'model' with the node placements applied, if the cache file exists and was created
+// for 'key'. 'loaded' is false if there was no usable cache.
+common::Status Load(const std::basic_string<ORTCHAR_T>& cache_file_path, const std::string& key,
+                    const IOnnxRuntimeOpSchemaRegistryList* local_registries, const logging::Logger& logger,
+                    std::shared_ptr<Model>& model, bool& loaded);
+
+}  // namespace session_state_cache
+}  // namespace onnxruntime
@@ -2,18 +2,37 @@
 #include <algorithm>
 
 #include <core/common/make_unique.h>
+#include "core/platform/env.h"
 
 namespace onnxruntime {
 namespace concurrency {
 
 std::unique_ptr<ThreadPool> CreateThreadPool(const std::string& name, int thread_pool_size) {
+  return CreateThreadPool(name, thread_pool_size, ThreadOptions());
+}
+
+std::unique_ptr<ThreadPool> CreateThreadPool(const std::string& name, int thread_pool_size,
+                                             const ThreadOptions& thread_options) {
   if (thread_pool_size <= 0) {  // default
-    thread_pool_size = std::max<int>(1, std::thread::hardware_concurrency() / 2);
+    // one thread per physical core: the logical processors sharing a core would compete for its execution units
+    thread_pool_size = thread_options.affinity.empty()
+                           ? std::max<int>(1, Env::Default().GetNumCpuCores())
+                           : static_cast<int>(thread_options.affinity.size());
   }
 
   // since we use the main thread for execution we don't have to create any threads on the thread pool when
   // the requested size is 1. For other cases, we will have thread_pool_size + 1 threads for execution
-  return thread_pool_size == 1 ? nullptr : onnxruntime::make_unique<concurrency::ThreadPool>(name, thread_pool_size);
+  return thread_pool_size == 1
+             ? nullptr
+             : onnxruntime::make_unique<concurrency::ThreadPool>(name, thread_pool_size, thread_options);
+}
+
+common::Status SetNumaNodeAffinity(int numa_node, ThreadOptions& thread_options) {
+  if (numa_node < 0 || !thread_options.affinity.empty()) {
+    return common::Status::OK();
+  }
+
+  return Env::Default().GetNumaNodeProcessors(numa_node, thread_options.affinity);
 }
 }  // namespace concurrency
 }  // namespace onnxruntime
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include "core/common/status.h"
 #include "core/platform/threadpool.h"
 #include <memory>
 #include <string>
@@ -6,5 +7,14 @@ namespace onnxruntime {
 namespace concurrency {
 
 std::unique_ptr<ThreadPool> CreateThreadPool(const std::string& name, int thread_pool_size);
+
+// If thread_options has an affinity and thread_pool_size is the default (<= 0), one thread is created per
+// logical processor in the affinity.
+std::unique_ptr<ThreadPool> CreateThreadPool(const std::string& name, int thread_pool_size,
+                                             const ThreadOptions& thread_options);
+
+// Sets the affinity of thread_options to the logical processors of numa_node, unless numa_node is negative or
+// an explicit affinity was already given.
+common::Status SetNumaNodeAffinity(int numa_node, ThreadOptions& thread_options);
 }  // namespace concurrency
 }  // namespace onnxruntime
\ No newline at end of file
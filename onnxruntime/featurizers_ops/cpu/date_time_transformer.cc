@@ -7,7 +7,7 @@
 #include "core/framework/op_kernel.h"
 
 #include "Featurizers/DateTimeFeaturizer.h"
-#include "Featurizers/../Archive.h"
+#include "featurizers_ops/cpu/parallel_execute.h"
 
 namespace onnxruntime {
 namespace featurizers {
@@ -18,16 +18,6 @@ class DateTimeTransformer final : public OpKernel {
   }
 
   Status Compute(OpKernelContext* ctx) const override {
-    // Create the transformer
-    Microsoft::Featurizer::Featurizers::DateTimeTransformer transformer(
-        [ctx](void) {
-          const auto* state_tensor(ctx->Input<Tensor>(0));
-          const uint8_t* const state_data(state_tensor->Data<uint8_t>());
-
-          Microsoft::Featurizer::Archive archive(state_data, state_tensor->Shape().GetDims()[0]);
-          return Microsoft::Featurizer::Featurizers::DateTimeTransformer(archive);
-        }());
-
     // Get the input
     const auto* input_tensor(ctx->Input<Tensor>(1));
     const int64_t* input_data(input_tensor->Data<int64_t>());
@@ -80,31 +70,34 @@ class DateTimeTransformer final : public OpKernel {
     // Execute
     const int64_t length(input_tensor->Shape().Size());
 
-    for (int64_t i = 0; i < length; ++i) {
-      auto result(transformer.execute(std::chrono::system_clock::from_time_t(input_data[i])));
+    using TransformerT = Microsoft::Featurizer::Featurizers::DateTimeTransformer;
+    ParallelExecute<TransformerT>(ctx, length, [&](TransformerT& transformer, int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        auto result(transformer.execute(std::chrono::system_clock::from_time_t(input_data[i])));
 
-      year_data[i] = std::move(result.year);
-      month_data[i] = std::move(result.month);
-      day_data[i] = std::move(result.day);
-      hour_data[i] = std::move(result.hour);
-      minute_data[i] = std::move(result.minute);
-      second_data[i] = std::move(result.second);
-      amPm_data[i] = std::move(result.amPm);
-      hour12_data[i] = std::move(result.hour12);
-      dayOfWeek_data[i] = std::move(result.dayOfWeek);
-      dayOfQuarter_data[i] = std::move(result.dayOfQuarter);
-      dayOfYear_data[i] = std::move(result.dayOfYear);
-      weekOfMonth_data[i] = std::move(result.weekOfMonth);
-      quarterOfYear_data[i] = std::move(result.quarterOfYear);
-      halfOfYear_data[i] = std::move(result.halfOfYear);
-      weekIso_data[i] = std::move(result.weekIso);
-      yearIso_data[i] = std::move(result.yearIso);
-      monthLabel_data[i] = std::move(result.monthLabel);
-      amPmLabel_data[i] = std::move(result.amPmLabel);
-      dayOfWeekLabel_data[i] = std::move(result.dayOfWeekLabel);
-      holidayName_data[i] = std::move(result.holidayName);
-      isPaidTimeOff_data[i] = std::move(result.isPaidTimeOff);
-    }
+        year_data[i] = std::move(result.year);
+        month_data[i] = std::move(result.month);
+        day_data[i] = std::move(result.day);
+        hour_data[i] = std::move(result.hour);
+        minute_data[i] = std::move(result.minute);
+        second_data[i] = std::move(result.second);
+        amPm_data[i] = std::move(result.amPm);
+        hour12_data[i] = std::move(result.hour12);
+        dayOfWeek_data[i] = std::move(result.dayOfWeek);
+        dayOfQuarter_data[i] = std::move(result.dayOfQuarter);
+        dayOfYear_data[i] = std::move(result.dayOfYear);
+        weekOfMonth_data[i] = std::move(result.weekOfMonth);
+        quarterOfYear_data[i] = std::move(result.quarterOfYear);
+        halfOfYear_data[i] = std::move(result.halfOfYear);
+        weekIso_data[i] = std::move(result.weekIso);
+        yearIso_data[i] = std::move(result.yearIso);
+        monthLabel_data[i] = std::move(result.monthLabel);
+        amPmLabel_data[i] = std::move(result.amPmLabel);
+        dayOfWeekLabel_data[i] = std::move(result.dayOfWeekLabel);
+        holidayName_data[i] = std::move(result.holidayName);
+        isPaidTimeOff_data[i] = std::move(result.isPaidTimeOff);
+      }
+    });
 
     return Status::OK();
   }
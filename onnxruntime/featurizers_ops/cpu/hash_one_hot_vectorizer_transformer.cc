@@ -7,7 +7,7 @@
 #include "core/framework/op_kernel.h"
 
 #include "Featurizers/HashOneHotVectorizerFeaturizer.h"
-#include "Featurizers/../Archive.h"
+#include "featurizers_ops/cpu/parallel_execute.h"
 
 namespace onnxruntime {
 namespace featurizers {
@@ -15,16 +15,6 @@ namespace featurizers {
 template <typename InputT>
 struct HashOneHotVectorizerTransformerImpl {
   void operator()(OpKernelContext* ctx) const {
-    // Create the transformer
-    Microsoft::Featurizer::Featurizers::HashOneHotVectorizerTransformer<InputT> transformer(
-        [ctx](void) {
-          const auto* state_tensor(ctx->Input<Tensor>(0));
-          const uint8_t* const state_data(state_tensor->Data<uint8_t>());
-
-          Microsoft::Featurizer::Archive archive(state_data, state_tensor->Shape().GetDims()[0]);
-          return Microsoft::Featurizer::Featurizers::HashOneHotVectorizerTransformer<InputT>(archive);
-        }());
-
     // Get the input
     const auto* input_tensor(ctx->Input<Tensor>(1));
     const InputT* input_data(input_tensor->Data<InputT>());
@@ -41,13 +31,16 @@ struct HashOneHotVectorizerTransformerImpl {
     // Execute
     const int64_t length(input_tensor->Shape().Size());
 
-    for (int64_t i = 0; i < length; ++i) {
-      auto result(transformer.execute(input_data[i]));
+    using TransformerT = Microsoft::Featurizer::Featurizers::HashOneHotVectorizerTransformer<InputT>;
+    ParallelExecute<TransformerT>(ctx, length, [&](TransformerT& transformer, int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        auto result(transformer.execute(input_data[i]));
 
-      NumElements_data[i] = std::move(result.NumElements);
-      Value_data[i] = std::move(result.Value);
-      Index_data[i] = std::move(result.Index);
-    }
+        NumElements_data[i] = std::move(result.NumElements);
+        Value_data[i] = std::move(result.Value);
+        Index_data[i] = std::move(result.Index);
+      }
+    });
   }
 };
 
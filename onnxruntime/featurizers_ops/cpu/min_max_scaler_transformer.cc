@@ -7,7 +7,7 @@
 #include "core/framework/op_kernel.h"
 
 #include "Featurizers/MinMaxScalerFeaturizer.h"
-#include "Featurizers/../Archive.h"
+#include "featurizers_ops/cpu/parallel_execute.h"
 
 namespace onnxruntime {
 namespace featurizers {
@@ -15,16 +15,6 @@ namespace featurizers {
 template <typename InputT>
 struct MinMaxScalerTransformerImpl {
   void operator()(OpKernelContext* ctx) const {
-    // Create the transformer
-    Microsoft::Featurizer::Featurizers::MinMaxScalerTransformer<InputT> transformer(
-        [ctx](void) {
-          const auto* state_tensor(ctx->Input<Tensor>(0));
-          const uint8_t* const state_data(state_tensor->Data<uint8_t>());
-
-          Microsoft::Featurizer::Archive archive(state_data, state_tensor->Shape().GetDims()[0]);
-          return Microsoft::Featurizer::Featurizers::MinMaxScalerTransformer<InputT>(archive);
-        }());
-
     // Get the input
     const auto* input_tensor(ctx->Input<Tensor>(1));
     const InputT* input_data(input_tensor->Data<InputT>());
@@ -36,9 +26,12 @@ struct MinMaxScalerTransformerImpl {
     // Execute
     const int64_t length(input_tensor->Shape().Size());
 
-    for (int64_t i = 0; i < length; ++i) {
-      output_data[i] = transformer.execute(input_data[i]);
-    }
+    using TransformerT = Microsoft::Featurizer::Featurizers::MinMaxScalerTransformer<InputT>;
+    ParallelExecute<TransformerT>(ctx, length, [&](TransformerT& transformer, int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        output_data[i] = transformer.execute(input_data[i]);
+      }
+    });
   }
 };
 
@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+
+#include "Featurizers/../Archive.h"
+
+namespace onnxruntime {
+namespace featurizers {
+
+// Elements handled by each chunk of ParallelExecute, enough to amortize the creation of the transformer of a chunk.
+constexpr int64_t kParallelExecuteMinChunkSize = 4096;
+
+// Creates a transformer from the serialized state in the first input of the kernel.
+template <typename TransformerT>
+TransformerT CreateTransformer(OpKernelContext* ctx) {
+  const auto* state_tensor(ctx->Input<Tensor>(0));
+  const uint8_t* const state_data(state_tensor->Data<uint8_t>());
+
+  Microsoft::Featurizer::Archive archive(state_data, state_tensor->Shape().GetDims()[0]);
+  return TransformerT(archive);
+}
+
+// Calls fn(transformer, begin, end) over contiguous chunks of the `length` input elements, in parallel on the
+// operator thread pool when there are enough elements. The transformers of the featurizer library keep no promise of
+// thread safety, so each chunk gets its own transformer created from the state.
+template <typename TransformerT, typename F>
+void ParallelExecute(OpKernelContext* ctx, int64_t length, F&& fn) {
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  int64_t num_chunks = std::min<int64_t>(tp == nullptr ? 1 : tp->NumThreads(),
+                                         length / kParallelExecuteMinChunkSize);
+  if (num_chunks <= 1) {
+    TransformerT transformer(CreateTransformer<TransformerT>(ctx));
+    fn(transformer, int64_t{0}, length);
+    return;
+  }
+
+  const int64_t chunk_size = (length + num_chunks - 1) / num_chunks;
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_chunks), [&](int32_t chunk) {
+    const int64_t begin = chunk * chunk_size;
+    const int64_t end = std::min(length, begin + chunk_size);
+    TransformerT transformer(CreateTransformer<TransformerT>(ctx));
+    fn(transformer, begin, end);
+  });
+}
+
+}  // namespace featurizers
+}  // namespace onnxruntime
@@ -0,0 +1,215 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "onnxruntime_pybind_dlpack.h"
+
+#include <memory>
+#include <vector>
+
+#include "core/framework/allocator.h"
+#include "core/framework/data_types.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+namespace python {
+
+namespace {
+
+constexpr const char* kDltensorName = "dltensor";
+constexpr const char* kUsedDltensorName = "used_dltensor";
+
+DLDataType GetDlpackDataType(MLDataType type) {
+  DLDataType dtype;
+  dtype.lanes = 1;
+  dtype.bits = static_cast<uint8_t>(type->Size() * 8);
+  if (type == DataTypeImpl::GetType<float>() || type == DataTypeImpl::GetType<double>() ||
+      type == DataTypeImpl::GetType<MLFloat16>()) {
+    dtype.code = kDLFloat;
+  } else if (type == DataTypeImpl::GetType<BFloat16>()) {
+    dtype.code = kDLBfloat;
+  } else if (type == DataTypeImpl::GetType<int8_t>() || type == DataTypeImpl::GetType<int16_t>() ||
+             type == DataTypeImpl::GetType<int32_t>() || type == DataTypeImpl::GetType<int64_t>()) {
+    dtype.code = kDLInt;
+  } else if (type == DataTypeImpl::GetType<uint8_t>() || type == DataTypeImpl::GetType<uint16_t>() ||
+             type == DataTypeImpl::GetType<uint32_t>() || type == DataTypeImpl::GetType<uint64_t>()) {
+    dtype.code = kDLUInt;
+  } else if (type == DataTypeImpl::GetType<bool>()) {
+    dtype.code = kDLBool;
+  } else {
+    throw std::runtime_error("The element type of the tensor can't be exported to DLPack.");
+  }
+  return dtype;
+}
+
+MLDataType GetOrtDataType(const DLDataType& dtype) {
+  if (dtype.lanes != 1) {
+    throw std::runtime_error("DLPack tensors with vector elements aren't supported.");
+  }
+  switch (dtype.code) {
+    case kDLFloat:
+      switch (dtype.bits) {
+        case 16:
+          return DataTypeImpl::GetType<MLFloat16>();
+        case 32:
+          return DataTypeImpl::GetType<float>();
+        case 64:
+          return DataTypeImpl::GetType<double>();
+      }
+      break;
+    case kDLBfloat:
+      if (dtype.bits == 16) {
+        return DataTypeImpl::GetType<BFloat16>();
+      }
+      break;
+    case kDLInt:
+      switch (dtype.bits) {
+        case 8:
+          return DataTypeImpl::GetType<int8_t>();
+        case 16:
+          return DataTypeImpl::GetType<int16_t>();
+        case 32:
+          return DataTypeImpl::GetType<int32_t>();
+        case 64:
+          return DataTypeImpl::GetType<int64_t>();
+      }
+      break;
+    case kDLUInt:
+      switch (dtype.bits) {
+        case 8:
+          return DataTypeImpl::GetType<uint8_t>();
+        case 16:
+          return DataTypeImpl::GetType<uint16_t>();
+        case 32:
+          return DataTypeImpl::GetType<uint32_t>();
+        case 64:
+          return DataTypeImpl::GetType<uint64_t>();
+      }
+      break;
+    case kDLBool:
+      if (dtype.bits == 8) {
+        return DataTypeImpl::GetType<bool>();
+      }
+      break;
+  }
+  throw std::runtime_error("Unsupported DLPack element type, code " + std::to_string(dtype.code) + " with " +
+                           std::to_string(dtype.bits) + " bits.");
+}
+
+// The manager_ctx of the exported tensors, which holds a copy of the value so its buffer outlives the OrtValue
+struct ExportedTensor {
+  OrtValue value;
+  std::vector<int64_t> shape;
+  DLManagedTensor managed;
+};
+
+// A tensor using the memory of an imported DLPack tensor, which is released with it
+class DlpackTensor : public Tensor {
+ public:
+  DlpackTensor(MLDataType type, const TensorShape& shape, void* data, const OrtMemoryInfo& location,
+               DLManagedTensor* managed) : Tensor(type, shape, data, location), managed_(managed) {}
+
+  ~DlpackTensor() {
+    if (managed_->deleter != nullptr) {
+      // the deleter of the producer may release Python objects, and the value may be released by any thread
+      py::gil_scoped_acquire acquire;
+      managed_->deleter(managed_);
+    }
+  }
+
+ private:
+  DLManagedTensor* managed_;
+};
+
+}  // namespace
+
+py::object ToDlpack(const OrtValue& value) {
+  if (!value.IsTensor()) {
+    throw std::runtime_error("Only tensors can be exported to DLPack.");
+  }
+  const Tensor& tensor = value.Get<Tensor>();
+  const OrtDevice& device = tensor.Location().device;
+  if (device.Type() != OrtDevice::CPU && device.Type() != OrtDevice::GPU) {
+    throw std::runtime_error("Only the tensors on CPU or CUDA devices can be exported to DLPack.");
+  }
+
+  auto exported = onnxruntime::make_unique<ExportedTensor>();
+  exported->value = value;
+  exported->shape = tensor.Shape().GetDims();
+  DLTensor& dl_tensor = exported->managed.dl_tensor;
+  dl_tensor.data = const_cast<void*>(tensor.DataRaw());
+  dl_tensor.ctx.device_type = device.Type() == OrtDevice::GPU ? kDLGPU : kDLCPU;
+  dl_tensor.ctx.device_id = device.Id();
+  dl_tensor.ndim = static_cast<int>(exported->shape.size());
+  dl_tensor.dtype = GetDlpackDataType(tensor.DataType());
+  dl_tensor.shape = exported->shape.data();
+  dl_tensor.strides = nullptr;  // compact row major
+  dl_tensor.byte_offset = 0;
+  exported->managed.manager_ctx = exported.get();
+  exported->managed.deleter = [](DLManagedTensor* self) {
+    delete static_cast<ExportedTensor*>(self->manager_ctx);
+  };
+
+  // a capsule which isn't consumed still owns the tensor
+  PyObject* capsule = PyCapsule_New(&exported->managed, kDltensorName, [](PyObject* self) {
+    if (PyCapsule_IsValid(self, kDltensorName)) {
+      auto* managed = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(self, kDltensorName));
+      managed->deleter(managed);
+    }
+  });
+  if (capsule == nullptr) {
+    throw py::error_already_set();
+  }
+  exported.release();
+  return py::reinterpret_steal<py::object>(capsule);
+}
+
+OrtValue FromDlpack(py::object capsule) {
+  if (!PyCapsule_IsValid(capsule.ptr(), kDltensorName)) {
+    throw std::runtime_error("Expected a DLPack capsule named 'dltensor' which wasn't consumed yet.");
+  }
+  auto* managed = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(capsule.ptr(), kDltensorName));
+  const DLTensor& dl_tensor = managed->dl_tensor;
+
+  const MLDataType type = GetOrtDataType(dl_tensor.dtype);
+  std::vector<int64_t> dims(dl_tensor.shape, dl_tensor.shape + dl_tensor.ndim);
+  if (dl_tensor.strides != nullptr) {
+    int64_t expected_stride = 1;
+    for (int i = dl_tensor.ndim - 1; i >= 0; --i) {
+      // the stride of a dimension of size 1 doesn't matter
+      if (dims[i] != 1 && dl_tensor.strides[i] != expected_stride) {
+        throw std::runtime_error("Only contiguous DLPack tensors are supported.");
+      }
+      expected_stride *= dims[i];
+    }
+  }
+
+  std::unique_ptr<OrtMemoryInfo> location;
+  switch (dl_tensor.ctx.device_type) {
+    case kDLCPU:
+      location = onnxruntime::make_unique<OrtMemoryInfo>(CPU, OrtDeviceAllocator);
+      break;
+    case kDLGPU: {
+      const auto device_id = static_cast<OrtDevice::DeviceId>(dl_tensor.ctx.device_id);
+      location = onnxruntime::make_unique<OrtMemoryInfo>(
+          CUDA, OrtDeviceAllocator, OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, device_id), device_id);
+      break;
+    }
+    default:
+      throw std::runtime_error("Only the DLPack tensors on CPU or CUDA devices are supported.");
+  }
+
+  void* data = static_cast<char*>(dl_tensor.data) + dl_tensor.byte_offset;
+  auto tensor = onnxruntime::make_unique<DlpackTensor>(type, TensorShape(dims), data, *location, managed);
+  // the value owns the DLPack tensor from now on
+  PyCapsule_SetName(capsule.ptr(), kUsedDltensorName);
+
+  OrtValue value;
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  value.Init(static_cast<Tensor*>(tensor.release()), ml_tensor, [](void* p) {
+    delete static_cast<DlpackTensor*>(static_cast<Tensor*>(p));
+  });
+  return value;
+}
+
+}  // namespace python
+}  // namespace onnxruntime
@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+
+#include <pybind11/pybind11.h>
+
+#include "core/framework/ml_value.h"
+
+// The structures of the DLPack ABI (https://github.com/dmlc/dlpack), which are the same in all its released versions.
+// They are declared here so the bindings don't depend on the DLPack headers.
+extern "C" {
+typedef enum {
+  kDLCPU = 1,
+  kDLGPU = 2,
+} DLDeviceType;
+
+typedef struct {
+  int device_type;
+  int device_id;
+} DLContext;
+
+typedef enum {
+  kDLInt = 0U,
+  kDLUInt = 1U,
+  kDLFloat = 2U,
+  kDLBfloat = 4U,
+  kDLBool = 6U,
+} DLDataTypeCode;
+
+typedef struct {
+  uint8_t code;
+  uint8_t bits;
+  uint16_t lanes;
+} DLDataType;
+
+typedef struct {
+  void* data;
+  DLContext ctx;
+  int ndim;
+  DLDataType dtype;
+  int64_t* shape;
+  int64_t* strides;
+  uint64_t byte_offset;
+} DLTensor;
+
+typedef struct DLManagedTensor {
+  DLTensor dl_tensor;
+  void* manager_ctx;
+  void (*deleter)(struct DLManagedTensor* self);
+} DLManagedTensor;
+}
+
+namespace onnxruntime {
+namespace python {
+
+namespace py = pybind11;
+
+// Returns a "dltensor" capsule sharing the memory of the tensor value, which stays alive until the consumer of the
+// capsule releases it. Throws for the values which aren't tensors on CPU or CUDA devices, and for string tensors.
+py::object ToDlpack(const OrtValue& value);
+
+// Returns a tensor value using the memory of a "dltensor" capsule, e.g. from torch.utils.dlpack.to_dlpack, without
+// copying it. The capsule is consumed, and released with the last copy of the value. The tensor must be contiguous.
+OrtValue FromDlpack(py::object capsule);
+
+}  // namespace python
+}  // namespace onnxruntime
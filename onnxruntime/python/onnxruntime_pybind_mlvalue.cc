@@ -203,6 +203,51 @@ std::unique_ptr<Tensor> CreateTensor(AllocatorPtr alloc, const std::string& name
   return p_tensor;
 }
 
+namespace {
+// A tensor using the memory of a numpy array, which is referenced until the tensor is released
+class NumpyTensor : public Tensor {
+ public:
+  NumpyTensor(MLDataType type, const TensorShape& shape, PyArrayObject* array)
+      : Tensor(type, shape, PyArray_DATA(array), OrtMemoryInfo(CPU, OrtDeviceAllocator)), array_(array) {
+    Py_INCREF(array_);
+  }
+
+  ~NumpyTensor() {
+    // the value may be released by any thread
+    py::gil_scoped_acquire acquire;
+    Py_DECREF(array_);
+  }
+
+ private:
+  PyArrayObject* array_;
+};
+}  // namespace
+
+OrtValue CreateOrtValueFromNumpy(AllocatorPtr alloc, py::object& value) {
+  if (!PyObjectCheck_Array(value.ptr())) {
+    throw std::runtime_error("Expected a numpy array.");
+  }
+  PyArrayObject* array = reinterpret_cast<PyArrayObject*>(value.ptr());
+  const int npy_type = PyArray_TYPE(array);
+
+  OrtValue ml_value;
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  if (PyArray_ISCARRAY_RO(array) && npy_type != NPY_UNICODE && npy_type != NPY_STRING && npy_type != NPY_VOID &&
+      npy_type != NPY_OBJECT) {
+    std::vector<int64_t> dims(PyArray_DIMS(array), PyArray_DIMS(array) + PyArray_NDIM(array));
+    auto p_tensor = onnxruntime::make_unique<NumpyTensor>(NumpyToOnnxRuntimeTensorType(npy_type), TensorShape(dims),
+                                                          array);
+    ml_value.Init(static_cast<Tensor*>(p_tensor.release()), ml_tensor, [](void* p) {
+      delete static_cast<NumpyTensor*>(static_cast<Tensor*>(p));
+    });
+  } else {
+    // CreateTensor copies the arrays which can't be used in place
+    auto p_tensor = CreateTensor(alloc, "", array);
+    ml_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+  }
+  return ml_value;
+}
+
 bool CheckIfInputIsSequenceType(const std::string& name_input,
                                 const InputDefList* input_def_list,
                                 /*out*/ onnx::TypeProto& type_proto) {
@@ -25,5 +25,9 @@ int OnnxRuntimeTensorToNumpyType(const DataTypeImpl* tensor_type);
 void CreateGenericMLValue(const onnxruntime::InputDefList* input_def_list, AllocatorPtr alloc, const std::string& name_input,
                           py::object& value, OrtValue* p_mlvalue);
 
+// Creates a tensor value from a numpy array. The value uses the memory of a contiguous numeric array, which it keeps
+// alive, and copies the other arrays.
+OrtValue CreateOrtValueFromNumpy(AllocatorPtr alloc, py::object& value);
+
 }  // namespace python
 }  // namespace onnxruntime
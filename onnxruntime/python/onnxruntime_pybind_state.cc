@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include "onnxruntime_pybind_dlpack.h"
 #include "onnxruntime_pybind_exceptions.h"
 #include "onnxruntime_pybind_mlvalue.h"
 
@@ -15,6 +16,7 @@
 #include "core/common/logging/severity.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/session_options.h"
+#include "core/session/IOBinding.h"
 
 #if USE_CUDA
 #define BACKEND_PROC "GPU"
@@ -123,7 +125,9 @@ std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_BrainS
 #pragma warning(disable : 4267 4996 4503 4003)
 #endif  // _MSC_VER
 
+#include <condition_variable>
 #include <iterator>
+#include <mutex>
 
 #if defined(_MSC_VER)
 #pragma warning(disable : 4267 4996 4503 4003)
@@ -234,6 +238,147 @@ void AddTensorAsPyObj(OrtValue& val, std::vector<py::object>& pyobjs) {
   GetPyObjFromTensor(rtensor, obj);
   pyobjs.push_back(obj);
 }
+
+// Converts the python feeds of a Run. The tensors share the buffers of the contiguous numpy arrays.
+// Returns a numpy array using the memory of a tensor on CPU, which it keeps alive. String tensors are copied.
+static py::object GetNumpyViewOfTensor(const OrtValue& value) {
+  const Tensor& tensor = value.Get<Tensor>();
+  if (tensor.Location().device.Type() != OrtDevice::CPU) {
+    throw std::runtime_error("Only the tensors in CPU memory can be viewed as numpy arrays, use to_dlpack instead.");
+  }
+  const int numpy_type = OnnxRuntimeTensorToNumpyType(tensor.DataType());
+  if (numpy_type == NPY_OBJECT) {
+    py::object obj;
+    GetPyObjFromTensor(tensor, obj);
+    return obj;
+  }
+
+  std::vector<npy_intp> npy_dims(tensor.Shape().GetDims().begin(), tensor.Shape().GetDims().end());
+  auto obj = py::reinterpret_steal<py::object>(PyArray_SimpleNewFromData(
+      static_cast<int>(npy_dims.size()), npy_dims.data(), numpy_type, const_cast<void*>(tensor.DataRaw())));
+  if (!obj) {
+    throw py::error_already_set();
+  }
+  // the array holds a copy of the value, which shares the tensor
+  py::capsule base(new OrtValue(value), [](void* p) { delete static_cast<OrtValue*>(p); });
+  if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(obj.ptr()), base.release().ptr()) != 0) {
+    throw py::error_already_set();
+  }
+  return obj;
+}
+
+static NameMLValMap CreateFeeds(InferenceSession* sess, const std::map<std::string, py::object>& pyfeeds) {
+  NameMLValMap feeds;
+  for (auto _ : pyfeeds) {
+    OrtValue ml_value;
+    auto px = sess->GetModelInputs();
+    if (!px.first.IsOK() || !px.second) {
+      throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+    }
+    CreateGenericMLValue(px.second, GetAllocator(), _.first, _.second, &ml_value);
+    if (PyErr_Occurred()) {
+      PyObject *ptype, *pvalue, *ptraceback;
+      PyErr_Fetch(&ptype, &pvalue, &ptraceback);
+
+      PyObject* pStr = PyObject_Str(ptype);
+      std::string sType = py::reinterpret_borrow<py::str>(pStr);
+      Py_XDECREF(pStr);
+      pStr = PyObject_Str(pvalue);
+      sType += ": ";
+      sType += py::reinterpret_borrow<py::str>(pStr);
+      Py_XDECREF(pStr);
+      throw std::runtime_error(sType);
+    }
+    feeds.insert(std::make_pair(_.first, ml_value));
+  }
+  return feeds;
+}
+
+static std::vector<py::object> CreateFetches(std::vector<OrtValue>& fetches) {
+  std::vector<py::object> rfetch;
+  rfetch.reserve(fetches.size());
+  for (auto _ : fetches) {
+    if (_.IsTensor()) {
+      AddTensorAsPyObj(_, rfetch);
+    } else {
+      AddNonTensorAsPyObj(_, rfetch);
+    }
+  }
+  return rfetch;
+}
+
+static std::map<std::string, int64_t> RunStatsToMap(const RunStats& stats) {
+  return {{"num_runs", stats.num_runs},
+          {"num_allocations", stats.num_allocations},
+          {"bytes_allocated", stats.bytes_allocated},
+          {"peak_bytes", stats.peak_bytes},
+          {"bytes_copied", stats.bytes_copied},
+          {"execution_time_us", stats.execution_time_us},
+          {"copy_time_us", stats.copy_time_us},
+          {"memory_pattern_hits", stats.num_memory_pattern_hits}};
+}
+
+// Runs each of the feeds with RunAsync, so they run concurrently on the thread pool of the session, and waits for
+// all of them. Without a thread pool they run one after the other on the calling thread. Called without the GIL.
+static void RunMany(InferenceSession* sess, const RunOptions& run_options, const std::vector<NameMLValMap>& feeds_list,
+                    const std::vector<std::string>& output_names, std::vector<common::Status>& statuses,
+                    std::vector<std::vector<OrtValue>>& fetches_list) {
+  std::mutex mutex;
+  std::condition_variable done;
+  size_t pending = 0;
+
+  for (size_t i = 0; i < feeds_list.size(); ++i) {
+    std::vector<std::string> feed_names;
+    std::vector<OrtValue> feeds;
+    for (const auto& feed : feeds_list[i]) {
+      feed_names.push_back(feed.first);
+      feeds.push_back(feed.second);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ++pending;
+    }
+    auto on_done = [&, i](const common::Status& status, std::vector<OrtValue>& fetches) {
+      std::lock_guard<std::mutex> lock(mutex);
+      statuses[i] = status;
+      fetches_list[i] = std::move(fetches);
+      if (--pending == 0) {
+        done.notify_all();
+      }
+    };
+    if (!sess->RunAsync(run_options, feed_names, feeds, output_names, {}, on_done).IsOK()) {
+      // RunAsync only fails when the session has no intra-op thread pool
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        --pending;
+      }
+      statuses[i] = sess->Run(run_options, feeds_list[i], output_names, &fetches_list[i]);
+    }
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  done.wait(lock, [&pending]() { return pending == 0; });
+}
+
+// The python objects used by a RunAsync, referenced until it's done. They're released on the thread of the Run, so
+// the GIL is acquired to delete them.
+struct AsyncRunState {
+  std::map<std::string, py::object> pyfeeds;  // the feeds share their buffers
+  py::object run_options;
+  py::function callback;
+};
+
+// The binding of the inputs and outputs of a session, with the session that creates the values bound to it.
+struct SessionIOBinding {
+  SessionIOBinding(InferenceSession* session) : sess(session) {
+    OrtPybindThrowIfError(sess->NewIOBinding(&binding));
+  }
+
+  InferenceSession* sess;
+  std::unique_ptr<IOBinding> binding;
+};
+
 class SessionObjectInitializer {
  public:
   typedef const SessionOptions& Arg1;
@@ -571,6 +716,20 @@ Set this option to false if you don't want it. Default is True.)pbdoc")
                      R"pbdoc(File path to serialize optimized model. By default, optimized model is not serialized if optimized_model_filepath is not provided.)pbdoc")
       .def_readwrite("enable_mem_pattern", &SessionOptions::enable_mem_pattern,
                      R"pbdoc(Enable the memory pattern optimization. Default is true.)pbdoc")
+      .def_readwrite("enable_mem_pattern_bucketing", &SessionOptions::enable_mem_pattern_bucketing,
+                     R"pbdoc(Share memory patterns between inputs whose dimensions round up to the same power of two.
+Useful for models with dynamic input shapes. Default is false.)pbdoc")
+      .def_readwrite("shape_specialization_max_variants", &SessionOptions::shape_specialization_max_variants,
+                     R"pbdoc(Maximum number of variants of the graph optimized for fixed values of the named free
+dimensions of the inputs, created for the values seen most often. Only used with the CPU execution provider.
+Default is 0 (disabled).)pbdoc")
+      .def_readwrite("shape_specialization_min_runs", &SessionOptions::shape_specialization_min_runs,
+                     R"pbdoc(Number of runs with the same free dimension values after which a variant is created.
+Default is 10.)pbdoc")
+      .def_readwrite("run_result_cache_max_bytes", &SessionOptions::run_result_cache_max_bytes,
+                     R"pbdoc(Maximum number of bytes of the cached outputs of the runs, returned again for the runs with
+the same inputs instead of running the graph. Only used for graphs without random or custom ops.
+Default is 0 (disabled).)pbdoc")
       .def_readwrite("logid", &SessionOptions::session_logid,
                      R"pbdoc(Logger id to use for session output.)pbdoc")
       .def_readwrite("log_severity_level", &SessionOptions::session_log_severity_level,
@@ -639,7 +798,30 @@ Applies to a particular Run() invocation. Default is 0.)pbdoc")
                      "To identify logs generated by a particular Run() invocation.")
       .def_readwrite("terminate", &RunOptions::terminate,
                      R"pbdoc(Set to True to terminate any currently executing calls that are using this
-RunOptions instance. The individual calls will exit gracefully and return an error status.)pbdoc");
+RunOptions instance. The individual calls will exit gracefully and return an error status.)pbdoc")
+      .def_readwrite("shrink_memory_arenas", &RunOptions::shrink_memory_arenas,
+                     R"pbdoc(Set to True to release the entirely free regions of the session's memory arenas
+back to the device once the Run() call completes. Default is False.)pbdoc")
+      .def_readwrite("collect_run_stats", &RunOptions::collect_run_stats,
+                     R"pbdoc(Set to True to record the memory and time statistics of the Run() calls using this
+RunOptions instance in run_stats. Default is False.)pbdoc")
+      .def_readwrite("priority", &RunOptions::priority,
+                     R"pbdoc(Priority of the Run() calls among the ones of the sessions using the global thread
+pools. Between two nodes, a call waits while a call of a higher priority is in progress. Default is 0.)pbdoc")
+      .def(
+          "set_deadline", [](RunOptions* options, int64_t timeout_ms) -> void {
+            options->deadline = timeout_ms < 0
+                                    ? std::chrono::steady_clock::time_point::max()
+                                    : std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+          },
+          R"pbdoc(Abandon the Run() calls using this RunOptions instance which are still running timeout_ms
+milliseconds from now, with an error. A negative timeout_ms removes the deadline.)pbdoc")
+      .def_property_readonly(
+          "run_stats", [](const RunOptions* options) -> std::map<std::string, int64_t> {
+            return RunStatsToMap(options->run_stats);
+          },
+          R"pbdoc(Statistics of the last Run() call which collected them: its allocations, peak bytes, bytes copied
+between devices, execution and copy times in microseconds and memory pattern hit.)pbdoc");
 
   py::class_<ModelMetadata>(m, "ModelMetadata", R"pbdoc(Pre-defined and custom metadata about the model.
 It is usually used to identify the model used to run the prediction and
@@ -711,6 +893,103 @@ including arg name, arg type (contains both type and shape).)pbdoc")
           },
           "node shape (assuming the node holds a tensor)");
 
+  py::class_<SessionIOBinding>(m, "SessionIOBinding", R"pbdoc(The inputs and outputs bound to a session for run_with_iobinding.)pbdoc")
+      .def(py::init<InferenceSession*>(), py::keep_alive<1, 2>())
+      .def("bind_input", [](SessionIOBinding* io_binding, const std::string& name, py::object arr) {
+        auto px = io_binding->sess->GetModelInputs();
+        if (!px.first.IsOK() || !px.second) {
+          throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+        }
+        OrtValue ml_value;
+        CreateGenericMLValue(px.second, GetAllocator(), name, arr, &ml_value);
+        if (PyErr_Occurred()) {
+          throw py::error_already_set();
+        }
+        OrtPybindThrowIfError(io_binding->binding->BindInput(name, ml_value));
+      },
+           R"pbdoc(Binds the input to a numpy array, copying it to the device of the node that consumes it.)pbdoc")
+      .def("bind_output", [](SessionIOBinding* io_binding, const std::string& name, const std::string& device_type, int device_id) {
+        if (device_type == "cpu") {
+          OrtPybindThrowIfError(io_binding->binding->BindOutput(name, OrtMemoryInfo(CPU, OrtDeviceAllocator)));
+        } else if (device_type == "cuda") {
+          OrtMemoryInfo location(CUDA, OrtDeviceAllocator,
+                                 OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, static_cast<OrtDevice::DeviceId>(device_id)),
+                                 device_id);
+          OrtPybindThrowIfError(io_binding->binding->BindOutput(name, location));
+        } else {
+          throw std::runtime_error("Unsupported device type " + device_type + ". Expected cpu or cuda.");
+        }
+      },
+           py::arg("name"), py::arg("device_type") = "cpu", py::arg("device_id") = 0,
+           R"pbdoc(Binds the output to a device. The runs allocate it there and keep it on the device.)pbdoc")
+      .def("clear_binding_inputs", [](SessionIOBinding* io_binding) {
+        io_binding->binding->ClearInputs();
+      })
+      .def("clear_binding_outputs", [](SessionIOBinding* io_binding) {
+        io_binding->binding->ClearOutputs();
+      })
+      .def("get_output_names", [](SessionIOBinding* io_binding) -> const std::vector<std::string>& {
+        return io_binding->binding->GetOutputNames();
+      })
+      .def("copy_outputs_to_cpu", [](SessionIOBinding* io_binding) -> std::vector<py::object> {
+        std::vector<py::object> rfetch;
+        for (auto& output : io_binding->binding->GetOutputs()) {
+          if (!output.IsTensor()) {
+            AddNonTensorAsPyObj(output, rfetch);
+            continue;
+          }
+
+          const Tensor& tensor = output.Get<Tensor>();
+          if (tensor.Location().device.Type() == OrtDevice::CPU) {
+            AddTensorAsPyObj(output, rfetch);
+          } else {
+            Tensor cpu_tensor(tensor.DataType(), tensor.Shape(), GetAllocator());
+            OrtPybindThrowIfError(io_binding->sess->GetDataTransferManager().CopyTensor(tensor, cpu_tensor));
+            py::object obj;
+            GetPyObjFromTensor(cpu_tensor, obj);
+            rfetch.push_back(obj);
+          }
+        }
+        return rfetch;
+      },
+           R"pbdoc(Returns the bound outputs as numpy arrays, copying those kept on a device to CPU memory.)pbdoc");
+
+  py::class_<OrtValue>(m, "OrtValue", R"pbdoc(A value of the runtime, usually a tensor, which may be on a device.)pbdoc")
+      .def_static(
+          "ortvalue_from_numpy", [](py::object arr) {
+            return CreateOrtValueFromNumpy(GetAllocator(), arr);
+          },
+          R"pbdoc(Creates a tensor using the memory of a contiguous numeric numpy array, which it keeps alive. The other arrays are copied.)pbdoc")
+      .def_static("ortvalue_from_dlpack", &FromDlpack,
+                  R"pbdoc(Creates a tensor using the memory of a DLPack capsule, which it consumes.)pbdoc")
+      .def("to_dlpack", &ToDlpack,
+           R"pbdoc(Returns a DLPack capsule sharing the memory of the tensor.)pbdoc")
+      .def(
+          "numpy", [](const OrtValue* ml_value) -> py::object {
+            if (!ml_value->IsTensor()) {
+              std::vector<py::object> obj;
+              AddNonTensorAsPyObj(*const_cast<OrtValue*>(ml_value), obj);
+              return obj[0];
+            }
+            return GetNumpyViewOfTensor(*ml_value);
+          },
+          R"pbdoc(Returns a numpy array sharing the memory of a tensor in CPU memory. String tensors and non-tensor values are copied.)pbdoc")
+      .def("is_tensor", [](const OrtValue* ml_value) -> bool {
+        return ml_value->IsTensor();
+      })
+      .def("shape", [](const OrtValue* ml_value) -> std::vector<int64_t> {
+        return ml_value->Get<Tensor>().Shape().GetDims();
+      })
+      .def("data_type", [](const OrtValue* ml_value) -> std::string {
+        return DataTypeImpl::ToString(ml_value->Type());
+      })
+      .def("device_name", [](const OrtValue* ml_value) -> std::string {
+        return ml_value->Get<Tensor>().Location().device.Type() == OrtDevice::GPU ? "cuda" : "cpu";
+      })
+      .def("data_ptr", [](const OrtValue* ml_value) -> int64_t {
+        return reinterpret_cast<int64_t>(ml_value->Get<Tensor>().DataRaw());
+      });
+
   py::class_<SessionObjectInitializer>(m, "SessionObjectInitializer");
   py::class_<InferenceSession>(m, "InferenceSession", R"pbdoc(This is the main class used to run a model.)pbdoc")
       // In Python3, a Python bytes object will be passed to C++ functions that accept std::string or char*
@@ -733,29 +1012,7 @@ including arg name, arg type (contains both type and shape).)pbdoc")
           },
           R"pbdoc(Load a model saved in ONNX format.)pbdoc")
       .def("run", [](InferenceSession* sess, std::vector<std::string> output_names, std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr) -> std::vector<py::object> {
-        NameMLValMap feeds;
-        for (auto _ : pyfeeds) {
-          OrtValue ml_value;
-          auto px = sess->GetModelInputs();
-          if (!px.first.IsOK() || !px.second) {
-            throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-          }
-          CreateGenericMLValue(px.second, GetAllocator(), _.first, _.second, &ml_value);
-          if (PyErr_Occurred()) {
-            PyObject *ptype, *pvalue, *ptraceback;
-            PyErr_Fetch(&ptype, &pvalue, &ptraceback);
-
-            PyObject* pStr = PyObject_Str(ptype);
-            std::string sType = py::reinterpret_borrow<py::str>(pStr);
-            Py_XDECREF(pStr);
-            pStr = PyObject_Str(pvalue);
-            sType += ": ";
-            sType += py::reinterpret_borrow<py::str>(pStr);
-            Py_XDECREF(pStr);
-            throw std::runtime_error(sType);
-          }
-          feeds.insert(std::make_pair(_.first, ml_value));
-        }
+        NameMLValMap feeds = CreateFeeds(sess, pyfeeds);
 
         std::vector<OrtValue> fetches;
         common::Status status;
@@ -770,20 +1027,109 @@ including arg name, arg type (contains both type and shape).)pbdoc")
           }
         }
 
-        std::vector<py::object> rfetch;
-        rfetch.reserve(fetches.size());
-        for (auto _ : fetches) {
-          if (_.IsTensor()) {
-            AddTensorAsPyObj(_, rfetch);
+        return CreateFetches(fetches);
+      })
+      .def("run_async", [](InferenceSession* sess, std::vector<std::string> output_names, std::map<std::string, py::object> pyfeeds, py::function callback, py::object run_options) {
+        NameMLValMap feeds_map = CreateFeeds(sess, pyfeeds);
+        std::vector<std::string> feed_names;
+        std::vector<OrtValue> feeds;
+        for (const auto& feed : feeds_map) {
+          feed_names.push_back(feed.first);
+          feeds.push_back(feed.second);
+        }
+
+        std::shared_ptr<AsyncRunState> state(new AsyncRunState{std::move(pyfeeds), run_options, std::move(callback)},
+                                             [](AsyncRunState* p) {
+                                               py::gil_scoped_acquire acquire;
+                                               delete p;
+                                             });
+        static RunOptions default_run_options;
+        const RunOptions& options = run_options.is_none() ? default_run_options : *run_options.cast<RunOptions*>();
+
+        // the callback gets the outputs, or None and the error message if the run failed
+        auto on_done = [state](const common::Status& status, std::vector<OrtValue>& fetches) {
+          py::gil_scoped_acquire acquire;
+          try {
+            if (status.IsOK()) {
+              state->callback(CreateFetches(fetches), py::none());
+            } else {
+              state->callback(py::none(), status.ErrorMessage());
+            }
+          } catch (py::error_already_set& e) {
+            e.restore();
+            PyErr_WriteUnraisable(state->callback.ptr());
+          }
+        };
+
+        py::gil_scoped_release release;
+        OrtPybindThrowIfError(sess->RunAsync(options, feed_names, feeds, output_names, {}, on_done));
+      })
+      .def("run_many", [](InferenceSession* sess, std::vector<std::string> output_names, std::vector<std::map<std::string, py::object>> pyfeeds_list, RunOptions* run_options = nullptr) -> std::vector<std::vector<py::object>> {
+        // the conversion of the inputs and outputs uses the Python objects, so only the runs are done without the GIL
+        std::vector<NameMLValMap> feeds_list;
+        feeds_list.reserve(pyfeeds_list.size());
+        for (const auto& pyfeeds : pyfeeds_list) {
+          feeds_list.push_back(CreateFeeds(sess, pyfeeds));
+        }
+
+        std::vector<common::Status> statuses(feeds_list.size());
+        std::vector<std::vector<OrtValue>> fetches_list(feeds_list.size());
+        {
+          static RunOptions default_run_options;
+          py::gil_scoped_release release;
+          RunMany(sess, run_options != nullptr ? *run_options : default_run_options, feeds_list, output_names,
+                  statuses, fetches_list);
+        }
+
+        std::vector<std::vector<py::object>> results;
+        results.reserve(fetches_list.size());
+        for (size_t i = 0; i < fetches_list.size(); ++i) {
+          OrtPybindThrowIfError(statuses[i]);
+          results.push_back(CreateFetches(fetches_list[i]));
+        }
+        return results;
+      })
+      .def("run_with_ortvalues", [](InferenceSession* sess, std::vector<std::string> output_names, std::map<std::string, OrtValue> feeds, std::vector<OrtValue> fetches, RunOptions* run_options = nullptr) -> std::vector<OrtValue> {
+        NameMLValMap feeds_map(feeds.begin(), feeds.end());
+        {
+          // release GIL to allow multiple python threads to invoke Run() in parallel.
+          py::gil_scoped_release release;
+          if (run_options != nullptr) {
+            OrtPybindThrowIfError(sess->Run(*run_options, feeds_map, output_names, &fetches));
           } else {
-            AddNonTensorAsPyObj(_, rfetch);
+            OrtPybindThrowIfError(sess->Run(feeds_map, output_names, &fetches));
           }
         }
-        return rfetch;
+        return fetches;
+      })
+      .def("run_with_iobinding", [](InferenceSession* sess, SessionIOBinding& io_binding, RunOptions* run_options = nullptr) {
+        // release GIL to allow multiple python threads to invoke Run() in parallel.
+        py::gil_scoped_release release;
+        if (run_options != nullptr) {
+          OrtPybindThrowIfError(sess->Run(*run_options, *io_binding.binding));
+        } else {
+          OrtPybindThrowIfError(sess->Run(*io_binding.binding));
+        }
       })
       .def("end_profiling", [](InferenceSession* sess) -> std::string {
         return sess->EndProfiling();
       })
+      .def("warm_up", [](InferenceSession* sess, const std::map<std::string, std::vector<int64_t>>& input_shapes) {
+        std::unordered_map<std::string, TensorShape> shapes;
+        for (const auto& pair : input_shapes) {
+          shapes[pair.first] = TensorShape(pair.second);
+        }
+        py::gil_scoped_release release;
+        OrtPybindThrowIfError(sess->WarmUp(shapes));
+      })
+      .def("get_cumulative_run_stats", [](const InferenceSession* sess) -> std::map<std::string, int64_t> {
+        return RunStatsToMap(sess->GetCumulativeRunStats());
+      })
+      .def("get_run_result_cache_stats", [](const InferenceSession* sess) -> std::map<std::string, int64_t> {
+        const auto stats = sess->GetRunResultCacheStats();
+        return {{"hits", stats.hits}, {"misses", stats.misses}, {"num_entries", stats.num_entries},
+                {"bytes", stats.bytes}};
+      })
       .def("get_providers", [](InferenceSession* sess) -> const std::vector<std::string>& {
         return sess->GetRegisteredProviderTypes();
       })
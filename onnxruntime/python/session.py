@@ -3,6 +3,8 @@
 # Licensed under the MIT License.
 #--------------------------------------------------------------------------
 
+import concurrent.futures
+import numpy
 import sys
 import os
 
@@ -91,6 +93,42 @@ class InferenceSession:
         "Return list of registered execution providers."
         return self._providers
 
+    def warm_up(self, input_shapes=None):
+        """
+        Run the model twice with zero-filled inputs and discard the outputs, so that the kernels, the memory patterns
+        and the memory arenas are initialized before the first real run.
+
+        :param input_shapes: a dictionary mapping input names to shapes, or a list of such dictionaries to warm the
+            session up for several representative shapes. The inputs which aren't listed use the shapes of the model,
+            which must not have free dimensions.
+
+        ::
+
+            sess.warm_up([{"input": [1, 3, 224, 224]}, {"input": [32, 3, 224, 224]}])
+        """
+        if input_shapes is None:
+            input_shapes = {}
+        if isinstance(input_shapes, dict):
+            input_shapes = [input_shapes]
+        for shapes in input_shapes:
+            self._sess.warm_up({name: list(shape) for name, shape in shapes.items()})
+
+    def get_run_result_cache_stats(self):
+        """
+        Return the statistics of the cache of the run results as a dictionary with the keys ``hits``, ``misses``,
+        ``num_entries`` and ``bytes``. See :attr:`onnxruntime.SessionOptions.run_result_cache_max_bytes`.
+        """
+        return self._sess.get_run_result_cache_stats()
+
+    def get_cumulative_run_stats(self):
+        """
+        Return the memory and time statistics summed over the runs of the session as a dictionary with the keys
+        ``num_runs``, ``num_allocations``, ``bytes_allocated``, ``peak_bytes``, ``bytes_copied``,
+        ``execution_time_us``, ``copy_time_us`` and ``memory_pattern_hits``. See
+        :attr:`onnxruntime.RunOptions.collect_run_stats` for the statistics of a single run.
+        """
+        return self._sess.get_cumulative_run_stats()
+
     def set_providers(self, providers):
         """
         Register the input list of execution providers. The underlying session is re-created.
@@ -153,6 +191,123 @@ class InferenceSession:
             else:
                 raise
 
+    def run_async(self, output_names, input_feed, run_options=None):
+        """
+        Compute the predictions on a thread of the session's intra-op thread pool, without blocking the
+        calling thread. The session must have more than one intra-op thread.
+
+        :param output_names: name of the outputs
+        :param input_feed: dictionary ``{ input_name: input_value }``
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :return: a :class:`concurrent.futures.Future` of the outputs. Use ``asyncio.wrap_future`` to await it
+            in a coroutine.
+
+        ::
+
+            outputs = sess.run_async([output_name], {input_name: x}).result()
+        """
+        num_required_inputs = len(self._inputs_meta)
+        num_inputs = len(input_feed)
+        # the graph may have optional inputs used to override initializers. allow for that.
+        if num_inputs < num_required_inputs:
+            raise ValueError("Model requires {} inputs. Input Feed contains {}".format(num_required_inputs, num_inputs))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+
+        future = concurrent.futures.Future()
+
+        def on_done(outputs, error):
+            if error is None:
+                future.set_result(outputs)
+            else:
+                future.set_exception(C.Fail(error))
+
+        self._sess.run_async(output_names, input_feed, on_done, run_options)
+        return future
+
+    def run_many(self, output_names, input_feeds, run_options=None):
+        """
+        Compute the predictions of several input feeds concurrently on the session's intra-op thread pool,
+        and wait for all of them. Without an intra-op thread pool they're computed one after the other.
+        The GIL is only held to convert the inputs and the outputs, so other Python threads keep running.
+
+        :param output_names: name of the outputs
+        :param input_feeds: list of dictionaries ``{ input_name: input_value }``
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :return: the list of the outputs of each input feed, in the same order. If any run fails, the error
+            of the first failed one is raised.
+
+        ::
+
+            outputs_x, outputs_y = sess.run_many([output_name], [{input_name: x}, {input_name: y}])
+        """
+        num_required_inputs = len(self._inputs_meta)
+        for input_feed in input_feeds:
+            num_inputs = len(input_feed)
+            # the graph may have optional inputs used to override initializers. allow for that.
+            if num_inputs < num_required_inputs:
+                raise ValueError("Model requires {} inputs. Input Feed contains {}".format(num_required_inputs,
+                                                                                         num_inputs))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        return self._sess.run_many(output_names, list(input_feeds), run_options)
+
+    def run_with_ortvalues(self, output_names, input_feed, run_options=None, output_ortvalues=None):
+        """
+        Compute the predictions on :class:`onnxruntime.OrtValue` inputs, without copying them.
+
+        :param output_names: name of the outputs
+        :param input_feed: dictionary ``{ input_name: OrtValue }``
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :param output_ortvalues: optional list of :class:`onnxruntime.OrtValue`, one per output name, which the
+            run writes to instead of allocating the outputs. They can be reused across runs.
+        :return: a list of :class:`onnxruntime.OrtValue`, the preallocated ones when they're given
+
+        ::
+
+            x = onnxruntime.OrtValue.ortvalue_from_numpy(x_array)
+            y = onnxruntime.OrtValue.ortvalue_from_shape_and_type(y_shape, numpy.float32)
+            sess.run_with_ortvalues([output_name], {input_name: x}, output_ortvalues=[y])
+            y_array = y.numpy()
+        """
+        num_required_inputs = len(self._inputs_meta)
+        num_inputs = len(input_feed)
+        # the graph may have optional inputs used to override initializers. allow for that.
+        if num_inputs < num_required_inputs:
+            raise ValueError("Model requires {} inputs. Input Feed contains {}".format(num_required_inputs, num_inputs))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        feeds = {name: value._ortvalue for name, value in input_feed.items()}
+        fetches = [value._ortvalue for value in output_ortvalues] if output_ortvalues else []
+        outputs = self._sess.run_with_ortvalues(output_names, feeds, fetches, run_options)
+        if output_ortvalues:
+            return list(output_ortvalues)
+        return [OrtValue(value) for value in outputs]
+
+    def io_binding(self):
+        """
+        Return an :class:`onnxruntime.IOBinding` of the inputs and outputs of this session for
+        :meth:`run_with_iobinding`.
+        """
+        return IOBinding(self)
+
+    def run_with_iobinding(self, iobinding, run_options=None):
+        """
+        Compute the predictions with the bound inputs, writing the bound outputs.
+
+        :param iobinding: the :class:`onnxruntime.IOBinding` returned by :meth:`io_binding`
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+
+        ::
+
+            binding = sess.io_binding()
+            binding.bind_input(input_name, x)
+            binding.bind_output(output_name)
+            sess.run_with_iobinding(binding)
+            y = binding.copy_outputs_to_cpu()[0]
+        """
+        self._sess.run_with_iobinding(iobinding._iobinding, run_options)
+
     def end_profiling(self):
         """
         End profiling and return results in a file.
@@ -161,3 +316,114 @@ class InferenceSession:
         :meth:`onnxruntime.SessionOptions.enable_profiling`.
         """
         return self._sess.end_profiling()
+
+
+class IOBinding:
+    """
+    The inputs and outputs bound to an :class:`onnxruntime.InferenceSession`. The bound inputs are copied once to the
+    device that consumes them, and the outputs bound to a device stay there between the runs.
+    """
+
+    def __init__(self, session):
+        self._iobinding = C.SessionIOBinding(session._sess)
+
+    def bind_input(self, name, arr):
+        """
+        :param name: name of the input
+        :param arr: numpy array of the input value
+        """
+        self._iobinding.bind_input(name, arr)
+
+    def bind_output(self, name, device_type='cpu', device_id=0):
+        """
+        :param name: name of the output
+        :param device_type: ``'cpu'`` or ``'cuda'``, the device the output is allocated on
+        :param device_id: id of the device
+        """
+        self._iobinding.bind_output(name, device_type, device_id)
+
+    def get_output_names(self):
+        return self._iobinding.get_output_names()
+
+    def copy_outputs_to_cpu(self):
+        """
+        Return the bound outputs as numpy arrays, copying the ones kept on a device to CPU memory.
+        """
+        return self._iobinding.copy_outputs_to_cpu()
+
+    def clear_binding_inputs(self):
+        self._iobinding.clear_binding_inputs()
+
+    def clear_binding_outputs(self):
+        self._iobinding.clear_binding_outputs()
+
+
+class OrtValue:
+    """
+    A value of ONNX Runtime, usually a tensor, which may be on a device. The tensors created from numpy arrays or
+    DLPack capsules share their memory, so they go in and out of :meth:`InferenceSession.run_with_ortvalues` without
+    copies, e.g. to and from PyTorch or CuPy tensors on a GPU.
+    """
+
+    def __init__(self, ortvalue):
+        self._ortvalue = ortvalue
+
+    @staticmethod
+    def ortvalue_from_numpy(numpy_obj):
+        """
+        Return a tensor using the memory of a contiguous numeric numpy array, which it keeps alive. Other arrays,
+        e.g. of strings or not contiguous, are copied.
+        """
+        return OrtValue(C.OrtValue.ortvalue_from_numpy(numpy_obj))
+
+    @staticmethod
+    def ortvalue_from_shape_and_type(shape, element_type=numpy.float32):
+        """
+        Return a tensor in CPU memory of the shape and numpy element type, e.g. to be reused as a preallocated
+        output of :meth:`InferenceSession.run_with_ortvalues`.
+        """
+        return OrtValue.ortvalue_from_numpy(numpy.empty(shape, dtype=element_type))
+
+    @staticmethod
+    def ortvalue_from_dlpack(dlpack_capsule):
+        """
+        Return a tensor using the memory of a DLPack capsule, e.g. from ``torch.utils.dlpack.to_dlpack``, which it
+        consumes. The tensor must be contiguous, in CPU or CUDA memory.
+        """
+        return OrtValue(C.OrtValue.ortvalue_from_dlpack(dlpack_capsule))
+
+    def to_dlpack(self):
+        """
+        Return a DLPack capsule sharing the memory of the tensor, e.g. for ``torch.utils.dlpack.from_dlpack``.
+        """
+        return self._ortvalue.to_dlpack()
+
+    def numpy(self):
+        """
+        Return a numpy array sharing the memory of a tensor in CPU memory. String tensors and other values are copied.
+        """
+        return self._ortvalue.numpy()
+
+    def is_tensor(self):
+        return self._ortvalue.is_tensor()
+
+    def shape(self):
+        return self._ortvalue.shape()
+
+    def data_type(self):
+        """
+        Return the type of the value, e.g. ``'tensor(float)'``.
+        """
+        return self._ortvalue.data_type()
+
+    def device_name(self):
+        """
+        Return ``'cpu'`` or ``'cuda'``, the device of the tensor.
+        """
+        return self._ortvalue.device_name()
+
+    def data_ptr(self):
+        """
+        Return the address of the data of the tensor.
+        """
+        return self._ortvalue.data_ptr()
@@ -0,0 +1,115 @@
+#!/usr/bin/env python
+# coding: utf-8
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See License.txt in the project root for
+# license information.
+# --------------------------------------------------------------------------
+'''
+Writes the INT8 calibration table of the TensorRT execution provider: the largest absolute value each float tensor
+of a model takes over a set of sample feeds, as one "<tensor name> <max abs value>" line per tensor.
+
+The sample feeds are read from directories laid out like the ONNX test data sets, one directory per sample with an
+input_<i>.pb TensorProto file per model input, e.g.
+    python trt_calibration_table.py --model_path model.onnx --dataset_path samples --output_path calibration.txt
+and the table is passed to the provider with ORT_TENSORRT_INT8_CALIBRATION_TABLE=calibration.txt.
+'''
+
+import argparse
+import glob
+import os
+
+import numpy as np
+import onnx
+import onnxruntime
+from onnx import helper, numpy_helper, shape_inference, TensorProto
+
+
+def augment_graph(model):
+    '''
+    Adds an Abs and a ReduceMax node to every float tensor of the model and makes their outputs graph outputs
+        parameter model: FP32 ONNX model
+        return: augmented ONNX model and the list of the calibrated tensor names
+    '''
+    model = shape_inference.infer_shapes(model)
+    float_tensors = set()
+    for value_info in list(model.graph.input) + list(model.graph.value_info) + list(model.graph.output):
+        if value_info.type.tensor_type.elem_type == TensorProto.FLOAT:
+            float_tensors.add(value_info.name)
+    initializers = set(initializer.name for initializer in model.graph.initializer)
+
+    tensor_names = [tensor.name for tensor in model.graph.input if tensor.name in float_tensors]
+    for node in model.graph.node:
+        tensor_names.extend(output for output in node.output if output in float_tensors)
+    tensor_names = [name for name in tensor_names if name not in initializers]
+
+    added_nodes = []
+    added_outputs = []
+    for name in tensor_names:
+        abs_node = helper.make_node('Abs', [name], [name + '_Abs'], name + '_Abs')
+        reduce_max_node = helper.make_node('ReduceMax', [name + '_Abs'], [name + '_AbsMax'], name + '_AbsMax',
+                                           keepdims=0)
+        added_nodes.extend([abs_node, reduce_max_node])
+        added_outputs.append(helper.make_tensor_value_info(reduce_max_node.output[0], TensorProto.FLOAT, ()))
+    model.graph.node.extend(added_nodes)
+    model.graph.output.extend(added_outputs)
+    return model, tensor_names
+
+
+def load_feeds(dataset_path, session):
+    '''
+    Loads the input_<i>.pb files of each sample directory of dataset_path
+        return: list of feed dictionaries
+    '''
+    input_names = [model_input.name for model_input in session.get_inputs()]
+    feeds = []
+    for sample_path in sorted(glob.glob(os.path.join(dataset_path, '*'))):
+        if not os.path.isdir(sample_path):
+            continue
+        feed = {}
+        for i, input_name in enumerate(input_names):
+            tensor = TensorProto()
+            with open(os.path.join(sample_path, 'input_{}.pb'.format(i)), 'rb') as f:
+                tensor.ParseFromString(f.read())
+            feed[input_name] = numpy_helper.to_array(tensor)
+        feeds.append(feed)
+    if not feeds:
+        raise ValueError('No sample directories found in {}'.format(dataset_path))
+    return feeds
+
+
+def compute_dynamic_ranges(model_path, dataset_path):
+    '''
+    Runs the sample feeds through the augmented model on the CPU
+        return: dictionary of the max abs value of each float tensor over all the samples
+    '''
+    augmented_model, tensor_names = augment_graph(onnx.load(model_path))
+    session = onnxruntime.InferenceSession(augmented_model.SerializeToString(), providers=['CPUExecutionProvider'])
+    output_names = [name + '_AbsMax' for name in tensor_names]
+
+    dynamic_ranges = dict((name, 0.0) for name in tensor_names)
+    for feed in load_feeds(dataset_path, session):
+        for name, value in zip(tensor_names, session.run(output_names, feed)):
+            dynamic_ranges[name] = max(dynamic_ranges[name], float(np.max(value)))
+    return dynamic_ranges
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Writes the INT8 calibration table of the TensorRT execution provider')
+    parser.add_argument('--model_path', required=True)
+    parser.add_argument('--dataset_path', required=True, help='directory with a sub-directory of .pb inputs per sample')
+    parser.add_argument('--output_path', type=str, default='calibration.txt')
+    args = parser.parse_args()
+
+    dynamic_ranges = compute_dynamic_ranges(args.model_path, args.dataset_path)
+    with open(args.output_path, 'w') as f:
+        for name, value in dynamic_ranges.items():
+            # a range of 0 can't be quantized, leave the tensor to a higher precision
+            if value > 0:
+                f.write('{} {}\n'.format(name, value))
+
+    print('Calibration table of {} tensors saved to {}.'.format(len(dynamic_ranges), args.output_path))
+
+
+if __name__ == '__main__':
+    main()
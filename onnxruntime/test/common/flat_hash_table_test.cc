@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/flat_hash_table.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+namespace onnxruntime {
+namespace test {
+
+TEST(FlatHashTableTest, InsertAndFind) {
+  FlatHashTable<std::string, int64_t> table;
+  EXPECT_EQ(table.Find("a"), nullptr);
+
+  // enough entries to rehash several times
+  for (int64_t i = 0; i < 1000; ++i) {
+    auto result = table.Emplace("key" + std::to_string(i), i);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(*result.first, i);
+  }
+  EXPECT_EQ(table.Size(), 1000u);
+
+  // Emplace keeps the existing value, InsertOrAssign replaces it
+  auto result = table.Emplace("key7", -1);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(*result.first, 7);
+  table.InsertOrAssign("key7", -7);
+  EXPECT_EQ(table.Size(), 1000u);
+
+  for (int64_t i = 0; i < 1000; ++i) {
+    const auto* value = table.Find("key" + std::to_string(i));
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, i == 7 ? -7 : i);
+  }
+  EXPECT_EQ(table.Find("key1000"), nullptr);
+  EXPECT_EQ(table.Find(""), nullptr);
+}
+
+TEST(FlatHashTableTest, IntegerKeysDifferingInHighBits) {
+  FlatHashTable<int64_t, int64_t> table;
+  table.Reserve(64);
+  for (int64_t i = 0; i < 64; ++i) {
+    table.InsertOrAssign(i << 40, i);
+  }
+  for (int64_t i = 0; i < 64; ++i) {
+    const auto* value = table.Find(i << 40);
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, i);
+  }
+  EXPECT_EQ(table.Find(1), nullptr);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
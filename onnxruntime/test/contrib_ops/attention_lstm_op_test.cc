@@ -63,7 +63,8 @@ static void RunAttnLstmTest(
     // copy the following vectors as we may modify them
     std::vector<std::string> activations = {},
     std::vector<float> activation_alphas = {},
-    std::vector<float> activation_betas = {}) {
+    std::vector<float> activation_betas = {},
+    bool weights_are_initializers = false) {
   const int64_t input_size = x_depth + aw_attn_size;
 
   OpTester test("AttnLSTM", 1, onnxruntime::kMSDomain);
@@ -96,8 +97,8 @@ static void RunAttnLstmTest(
   std::vector<int64_t> R_dims = {num_directions, 4 * hidden_size, hidden_size};
 
   test.AddInput<float>("X", X_dims, X_data);
-  test.AddInput<float>("W", W_dims, W_data);
-  test.AddInput<float>("R", R_dims, R_data);
+  test.AddInput<float>("W", W_dims, W_data, weights_are_initializers);
+  test.AddInput<float>("R", R_dims, R_data, weights_are_initializers);
 
   if (B_data) {
     std::vector<int64_t> B_dims = {num_directions, 8 * hidden_size};
@@ -387,13 +388,16 @@ TEST(AttnLSTMTest, ForwardLstmWithBahdanauAM) {
   const std::vector<float> Y_h_data{};
   const std::vector<float> Y_c_data{};
 
-  RunAttnLstmTest(
-      X_data, W_data, R_data, Y_data, Y_h_data, Y_c_data,
-      s_memory_layer_weight, s_query_layer_weight, s_attn_v, s_M_data, &s_mem_seq_lenghts, &s_attn_layer_weight,
-      input_only_depth, batch_size, cell_hidden_size, input_max_step,
-      memory_max_step, memory_depth, am_attn_size, aw_attn_size,
-      &B_data, nullptr, nullptr, nullptr, &s_seq_lengths,
-      "forward", -9999.f, true, false);
+  // constant W and R are pre-packed by the kernel
+  for (bool weights_are_initializers : {false, true}) {
+    RunAttnLstmTest(
+        X_data, W_data, R_data, Y_data, Y_h_data, Y_c_data,
+        s_memory_layer_weight, s_query_layer_weight, s_attn_v, s_M_data, &s_mem_seq_lenghts, &s_attn_layer_weight,
+        input_only_depth, batch_size, cell_hidden_size, input_max_step,
+        memory_max_step, memory_depth, am_attn_size, aw_attn_size,
+        &B_data, nullptr, nullptr, nullptr, &s_seq_lengths,
+        "forward", -9999.f, true, false, {}, {}, {}, weights_are_initializers);
+  }
 }
 
 TEST(AttnLSTMTest, ForwardLstmWithBahdanauAMShortenSeqLength) {
@@ -576,13 +580,15 @@ TEST(AttnLSTMTest, BidirectionLstmWithBahdanauAM2BatchShortenSeqLen) {
   auto d_attn_v = ConcatDup(s_attn_v);
   auto d_attn_layer_weight = ConcatDup(s_attn_layer_weight);
 
-  RunAttnLstmTest(
-      X_data, d_W_data, d_R_data, Y_data, Y_h_data, Y_c_data,
-      d_memory_layer_weight, d_query_layer_weight, d_attn_v, s_M_2batch, &s_mem_seq_lenghts_2batch, &d_attn_layer_weight,
-      input_only_depth, batch2Size, cell_hidden_size, inputMaxStep4,
-      memory_max_step, memory_depth, am_attn_size, aw_attn_size,
-      &d_B_data, nullptr, nullptr, nullptr, &s_seq_lengths_2batch,
-      "bidirectional", -9999.f, true, false);
+  for (bool weights_are_initializers : {false, true}) {
+    RunAttnLstmTest(
+        X_data, d_W_data, d_R_data, Y_data, Y_h_data, Y_c_data,
+        d_memory_layer_weight, d_query_layer_weight, d_attn_v, s_M_2batch, &s_mem_seq_lenghts_2batch, &d_attn_layer_weight,
+        input_only_depth, batch2Size, cell_hidden_size, inputMaxStep4,
+        memory_max_step, memory_depth, am_attn_size, aw_attn_size,
+        &d_B_data, nullptr, nullptr, nullptr, &s_seq_lengths_2batch,
+        "bidirectional", -9999.f, true, false, {}, {}, {}, weights_are_initializers);
+  }
 }
 
 }  // namespace test
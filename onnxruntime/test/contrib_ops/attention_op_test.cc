@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
@@ -204,5 +207,278 @@ TEST(AttentionTest, AttentionMaskExceedSequence) {
                    batch_size, sequence_length, hidden_size, number_of_heads);
 }
 
+// Reference attention: output = softmax(Q * K' / sqrt(H)) * V per head, keys past mask_index are masked.
+// When unidirectional, the keys after the query are masked as well.
+static std::vector<float> ComputeAttentionReference(
+    const std::vector<float>& input_data, const std::vector<float>& weights_data, const std::vector<float>& bias_data,
+    const std::vector<int32_t>& mask_index_data, int batch_size, int sequence_length, int hidden_size,
+    int number_of_heads, bool is_unidirectional = false) {
+  const int head_size = hidden_size / number_of_heads;
+  std::vector<float> qkv(batch_size * sequence_length * 3 * hidden_size);
+  for (int i = 0; i < batch_size * sequence_length; ++i) {
+    for (int j = 0; j < 3 * hidden_size; ++j) {
+      float sum = bias_data[j];
+      for (int k = 0; k < hidden_size; ++k) {
+        sum += input_data[i * hidden_size + k] * weights_data[k * 3 * hidden_size + j];
+      }
+      qkv[i * 3 * hidden_size + j] = sum;
+    }
+  }
+
+  std::vector<float> output_data(batch_size * sequence_length * hidden_size);
+  std::vector<float> scores(sequence_length);
+  for (int b = 0; b < batch_size; ++b) {
+    const int num_keys = mask_index_data.empty() ? sequence_length
+                                                 : std::min(sequence_length, static_cast<int>(mask_index_data[b]));
+    for (int n = 0; n < number_of_heads; ++n) {
+      for (int s = 0; s < sequence_length; ++s) {
+        const int num_valid = is_unidirectional ? std::min(num_keys, s + 1) : num_keys;
+        const float* q = &qkv[(b * sequence_length + s) * 3 * hidden_size + n * head_size];
+        float max_score = -INFINITY;
+        for (int t = 0; t < num_valid; ++t) {
+          const float* k = &qkv[(b * sequence_length + t) * 3 * hidden_size + hidden_size + n * head_size];
+          float score = 0.f;
+          for (int h = 0; h < head_size; ++h) {
+            score += q[h] * k[h];
+          }
+          scores[t] = score / std::sqrt(static_cast<float>(head_size));
+          max_score = std::max(max_score, scores[t]);
+        }
+
+        float sum = 0.f;
+        for (int t = 0; t < num_valid; ++t) {
+          scores[t] = std::exp(scores[t] - max_score);
+          sum += scores[t];
+        }
+
+        float* output = &output_data[(b * sequence_length + s) * hidden_size + n * head_size];
+        for (int t = 0; t < num_valid; ++t) {
+          const float* v = &qkv[(b * sequence_length + t) * 3 * hidden_size + 2 * hidden_size + n * head_size];
+          for (int h = 0; h < head_size; ++h) {
+            output[h] += scores[t] / sum * v[h];
+          }
+        }
+      }
+    }
+  }
+
+  return output_data;
+}
+
+// Several query and key tiles of the fused CUDA kernels, with a mask that ends inside a key tile. The values are
+// kept small so that the fp16 run stays within the fp16 comparison threshold.
+static void RunAttentionLongSequenceTest(bool use_float16) {
+  int batch_size = 2;
+  int sequence_length = 70;
+  int hidden_size = 32;
+  int number_of_heads = 2;
+
+  std::vector<float> input_data(batch_size * sequence_length * hidden_size);
+  for (size_t i = 0; i < input_data.size(); ++i) {
+    input_data[i] = 0.2f * std::sin(0.37f * static_cast<float>(i));
+  }
+
+  std::vector<float> weight_data(hidden_size * 3 * hidden_size);
+  for (size_t i = 0; i < weight_data.size(); ++i) {
+    weight_data[i] = 0.1f * std::cos(0.11f * static_cast<float>(i));
+  }
+
+  std::vector<float> bias_data(3 * hidden_size);
+  for (size_t i = 0; i < bias_data.size(); ++i) {
+    bias_data[i] = 0.01f * static_cast<float>(i % 7) - 0.03f;
+  }
+
+  std::vector<int32_t> mask_index_data = {70L, 37L};
+
+  std::vector<float> output_data = ComputeAttentionReference(input_data, weight_data, bias_data, mask_index_data,
+                                                             batch_size, sequence_length, hidden_size,
+                                                             number_of_heads);
+
+  RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads, use_float16);
+}
+
+TEST(AttentionTest, AttentionLongSequenceMask) {
+  RunAttentionLongSequenceTest(false);
+}
+
+TEST(AttentionTest, AttentionLongSequenceMask_Float16) {
+  RunAttentionLongSequenceTest(true);
+}
+
+// GPT-2 style attention where every token only attends to itself and the tokens before it, without mask_index.
+// Only the CPU kernel supports it.
+TEST(AttentionTest, AttentionUnidirectional) {
+  int batch_size = 2;
+  int sequence_length = 5;
+  int hidden_size = 8;
+  int number_of_heads = 2;
+
+  std::vector<float> input_data(batch_size * sequence_length * hidden_size);
+  for (size_t i = 0; i < input_data.size(); ++i) {
+    input_data[i] = 0.5f * std::sin(0.29f * static_cast<float>(i));
+  }
+
+  std::vector<float> weight_data(hidden_size * 3 * hidden_size);
+  for (size_t i = 0; i < weight_data.size(); ++i) {
+    weight_data[i] = 0.3f * std::cos(0.13f * static_cast<float>(i));
+  }
+
+  std::vector<float> bias_data(3 * hidden_size);
+  for (size_t i = 0; i < bias_data.size(); ++i) {
+    bias_data[i] = 0.05f * static_cast<float>(i % 5) - 0.1f;
+  }
+
+  std::vector<float> output_data = ComputeAttentionReference(input_data, weight_data, bias_data, {},
+                                                             batch_size, sequence_length, hidden_size,
+                                                             number_of_heads, true);
+
+  OpTester tester("Attention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
+  tester.AddAttribute<int64_t>("unidirectional", static_cast<int64_t>(1));
+  tester.AddInput<float>("input", {batch_size, sequence_length, hidden_size}, input_data);
+  tester.AddInput<float>("weight", {hidden_size, 3 * hidden_size}, weight_data);
+  tester.AddInput<float>("bias", {3 * hidden_size}, bias_data);
+  tester.AddOutput<float>("output", {batch_size, sequence_length, hidden_size}, output_data);
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider});
+}
+
+// Long enough for the CPU kernel to compute the attention by tiles of queries and keys, with a mask that ends
+// inside a key tile.
+static void RunAttentionBlockedTest(bool is_unidirectional) {
+  int batch_size = 2;
+  int sequence_length = 600;
+  int hidden_size = 16;
+  int number_of_heads = 2;
+
+  std::vector<float> input_data(batch_size * sequence_length * hidden_size);
+  for (size_t i = 0; i < input_data.size(); ++i) {
+    input_data[i] = 0.5f * std::sin(0.37f * static_cast<float>(i));
+  }
+
+  std::vector<float> weight_data(hidden_size * 3 * hidden_size);
+  for (size_t i = 0; i < weight_data.size(); ++i) {
+    weight_data[i] = 0.3f * std::cos(0.11f * static_cast<float>(i));
+  }
+
+  std::vector<float> bias_data(3 * hidden_size);
+  for (size_t i = 0; i < bias_data.size(); ++i) {
+    bias_data[i] = 0.01f * static_cast<float>(i % 7) - 0.03f;
+  }
+
+  std::vector<int32_t> mask_index_data = {600L, 301L};
+
+  std::vector<float> output_data = ComputeAttentionReference(input_data, weight_data, bias_data, mask_index_data,
+                                                             batch_size, sequence_length, hidden_size,
+                                                             number_of_heads, is_unidirectional);
+
+  OpTester tester("Attention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
+  tester.AddAttribute<int64_t>("unidirectional", static_cast<int64_t>(is_unidirectional));
+  tester.AddInput<float>("input", {batch_size, sequence_length, hidden_size}, input_data);
+  tester.AddInput<float>("weight", {hidden_size, 3 * hidden_size}, weight_data);
+  tester.AddInput<float>("bias", {3 * hidden_size}, bias_data);
+  tester.AddInput<int32_t>("mask_index", {batch_size}, mask_index_data);
+  tester.AddOutput<float>("output", {batch_size, sequence_length, hidden_size}, output_data);
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider});
+}
+
+TEST(AttentionTest, AttentionBlockedLongSequence) {
+  RunAttentionBlockedTest(false);
+}
+
+TEST(AttentionTest, AttentionBlockedLongSequenceUnidirectional) {
+  RunAttentionBlockedTest(true);
+}
+
+// Reference key and value state: present(2, B, N, S, H) with the K and V of every token of the input.
+static std::vector<float> ComputeKeyValueReference(
+    const std::vector<float>& input_data, const std::vector<float>& weights_data, const std::vector<float>& bias_data,
+    int batch_size, int sequence_length, int hidden_size, int number_of_heads) {
+  const int head_size = hidden_size / number_of_heads;
+  std::vector<float> present_data(2 * batch_size * sequence_length * hidden_size);
+  for (int kv = 0; kv < 2; ++kv) {
+    for (int b = 0; b < batch_size; ++b) {
+      for (int n = 0; n < number_of_heads; ++n) {
+        for (int s = 0; s < sequence_length; ++s) {
+          for (int h = 0; h < head_size; ++h) {
+            const int j = (kv + 1) * hidden_size + n * head_size + h;
+            float sum = bias_data[j];
+            for (int k = 0; k < hidden_size; ++k) {
+              sum += input_data[(b * sequence_length + s) * hidden_size + k] * weights_data[k * 3 * hidden_size + j];
+            }
+            present_data[(((kv * batch_size + b) * number_of_heads + n) * sequence_length + s) * head_size + h] = sum;
+          }
+        }
+      }
+    }
+  }
+  return present_data;
+}
+
+// Incremental decoding: the state of the first tokens is fed as past with the last tokens, which must give the
+// outputs of the last tokens of the whole sequence.
+TEST(AttentionTest, AttentionPastState) {
+  int batch_size = 2;
+  int past_sequence_length = 3;
+  int sequence_length = 2;
+  int all_sequence_length = past_sequence_length + sequence_length;
+  int hidden_size = 8;
+  int number_of_heads = 2;
+  int head_size = hidden_size / number_of_heads;
+
+  std::vector<float> all_input_data(batch_size * all_sequence_length * hidden_size);
+  for (size_t i = 0; i < all_input_data.size(); ++i) {
+    all_input_data[i] = 0.5f * std::sin(0.29f * static_cast<float>(i));
+  }
+
+  std::vector<float> weight_data(hidden_size * 3 * hidden_size);
+  for (size_t i = 0; i < weight_data.size(); ++i) {
+    weight_data[i] = 0.3f * std::cos(0.13f * static_cast<float>(i));
+  }
+
+  std::vector<float> bias_data(3 * hidden_size);
+  for (size_t i = 0; i < bias_data.size(); ++i) {
+    bias_data[i] = 0.05f * static_cast<float>(i % 5) - 0.1f;
+  }
+
+  // the second sequence has a padding token at the end
+  std::vector<int32_t> mask_index_data = {5L, 4L};
+
+  std::vector<float> all_output_data = ComputeAttentionReference(all_input_data, weight_data, bias_data,
+                                                                 mask_index_data, batch_size, all_sequence_length,
+                                                                 hidden_size, number_of_heads, true);
+  std::vector<float> present_data = ComputeKeyValueReference(all_input_data, weight_data, bias_data, batch_size,
+                                                             all_sequence_length, hidden_size, number_of_heads);
+
+  // split the tokens of the whole sequence between past and input
+  std::vector<float> input_data;
+  std::vector<float> output_data;
+  for (int b = 0; b < batch_size; ++b) {
+    const size_t begin = (b * all_sequence_length + past_sequence_length) * hidden_size;
+    const size_t end = (b + 1) * all_sequence_length * hidden_size;
+    input_data.insert(input_data.end(), all_input_data.begin() + begin, all_input_data.begin() + end);
+    output_data.insert(output_data.end(), all_output_data.begin() + begin, all_output_data.begin() + end);
+  }
+  std::vector<float> past_data;
+  for (int i = 0; i < 2 * batch_size * number_of_heads; ++i) {
+    const auto head = present_data.begin() + i * all_sequence_length * head_size;
+    past_data.insert(past_data.end(), head, head + past_sequence_length * head_size);
+  }
+
+  OpTester tester("Attention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
+  tester.AddAttribute<int64_t>("unidirectional", static_cast<int64_t>(1));
+  tester.AddInput<float>("input", {batch_size, sequence_length, hidden_size}, input_data);
+  tester.AddInput<float>("weight", {hidden_size, 3 * hidden_size}, weight_data);
+  tester.AddInput<float>("bias", {3 * hidden_size}, bias_data);
+  tester.AddInput<int32_t>("mask_index", {batch_size}, mask_index_data);
+  tester.AddInput<float>("past", {2, batch_size, number_of_heads, past_sequence_length, head_size}, past_data);
+  tester.AddOutput<float>("output", {batch_size, sequence_length, hidden_size}, output_data);
+  tester.AddOutput<float>("present", {2, batch_size, number_of_heads, all_sequence_length, head_size},
+                          present_data);
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,183 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <sstream>
+
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "test/framework/test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Probabilities of the next token given the last one, for a vocabulary of 4 tokens where 0 ends a sequence.
+const std::vector<float> kNextTokenProbabilities = {
+    0.25f, 0.25f, 0.25f, 0.25f,
+    0.05f, 0.05f, 0.5f, 0.4f,
+    0.2f, 0.4f, 0.3f, 0.1f,
+    0.9f, 0.06f, 0.03f, 0.01f};
+
+// A decoder with a single layer whose logits only depend on the last token. The presents append the ids of the
+// tokens to the pasts, with 1 head of size 1.
+GraphProto CreateDecoder() {
+  Model model("BeamSearch decoder", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto ids_type;
+  ids_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  ids_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch_x_beams");
+  ids_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("sequence_length");
+
+  TypeProto past_type;
+  past_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto* past_shape = past_type.mutable_tensor_type()->mutable_shape();
+  past_shape->add_dim()->set_dim_value(2);
+  past_shape->add_dim()->set_dim_param("batch_x_beams");
+  past_shape->add_dim()->set_dim_value(1);
+  past_shape->add_dim()->set_dim_param("past_sequence_length");
+  past_shape->add_dim()->set_dim_value(1);
+
+  TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  auto& input_ids = graph.GetOrCreateNodeArg("input_ids", &ids_type);
+  auto& position_ids = graph.GetOrCreateNodeArg("position_ids", &ids_type);
+  auto& past = graph.GetOrCreateNodeArg("past_0", &past_type);
+  auto& table = graph.GetOrCreateNodeArg("table", &float_type);
+  auto& logits = graph.GetOrCreateNodeArg("logits", &float_type);
+  auto& ids_float = graph.GetOrCreateNodeArg("ids_float", &float_type);
+  auto& ids_5d = graph.GetOrCreateNodeArg("ids_5d", &float_type);
+  auto& key_value = graph.GetOrCreateNodeArg("key_value", &float_type);
+  auto& present = graph.GetOrCreateNodeArg("present_0", &float_type);
+
+  TensorProto table_proto;
+  table_proto.set_name("table");
+  table_proto.set_data_type(TensorProto_DataType_FLOAT);
+  table_proto.add_dims(4);
+  table_proto.add_dims(4);
+  for (float p : kNextTokenProbabilities) {
+    table_proto.add_float_data(std::log(p));
+  }
+  graph.AddInitializedTensor(table_proto);
+
+  graph.AddNode("gather", "Gather", "logits of the next token", {&table, &input_ids}, {&logits});
+  auto& cast = graph.AddNode("cast", "Cast", "ids as key/value state", {&input_ids}, {&ids_float});
+  cast.AddAttribute("to", int64_t(TensorProto_DataType_FLOAT));
+  auto& unsqueeze = graph.AddNode("unsqueeze", "Unsqueeze", "to (1, batch_x_beams, 1, sequence_length, 1)",
+                                  {&ids_float}, {&ids_5d});
+  unsqueeze.AddAttribute("axes", std::vector<int64_t>{0, 2, 4});
+  auto& stack = graph.AddNode("stack", "Concat", "key and value", {&ids_5d, &ids_5d}, {&key_value});
+  stack.AddAttribute("axis", int64_t(0));
+  auto& append = graph.AddNode("append", "Concat", "present", {&past, &key_value}, {&present});
+  append.AddAttribute("axis", int64_t(3));
+
+  graph.SetInputs({&input_ids, &position_ids, &past});
+  graph.SetOutputs({&logits, &present});
+
+  auto status = graph.Resolve();
+  EXPECT_EQ(status, Status::OK());
+
+  return graph.ToGraphProto();
+}
+
+void RunBeamSearch(const std::vector<int64_t>& input_ids_dims, const std::vector<int64_t>& input_ids,
+                   int64_t max_length, int64_t num_beams, int64_t num_return_sequences, float length_penalty,
+                   const std::vector<int64_t>& expected_sequences, const std::vector<float>& expected_scores) {
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 11}, {kMSDomain, 1}};
+  Model model("BeamSearch", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, std::vector<FunctionProto>{}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto int64_type;
+  int64_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  std::vector<NodeArg*> inputs{&graph.GetOrCreateNodeArg("input_ids", &int64_type),
+                               &graph.GetOrCreateNodeArg("max_length", &int64_type),
+                               &graph.GetOrCreateNodeArg("num_beams", &int64_type),
+                               &graph.GetOrCreateNodeArg("num_return_sequences", &int64_type),
+                               &graph.GetOrCreateNodeArg("length_penalty", &float_type)};
+  std::vector<NodeArg*> outputs{&graph.GetOrCreateNodeArg("sequences", &int64_type),
+                                &graph.GetOrCreateNodeArg("sequences_scores", &float_type)};
+  auto& node = graph.AddNode("beam_search", "BeamSearch", "BeamSearch node", inputs, outputs, nullptr, kMSDomain);
+  node.AddAttribute("decoder", CreateDecoder());
+  node.AddAttribute("eos_token_id", int64_t(0));
+
+  Status status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  SessionOptions so;
+  so.session_logid = "BeamSearch";
+  InferenceSession session_object{so, GetEnvironment()};
+  std::string serialized;
+  model.ToProto().SerializeToString(&serialized);
+  std::istringstream model_stream(serialized);
+  ASSERT_TRUE((status = session_object.Load(model_stream)).IsOK()) << status;
+  ASSERT_TRUE((status = session_object.Initialize()).IsOK()) << status;
+
+  auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  NameMLValMap feeds;
+  OrtValue ml_value;
+  CreateMLValue<int64_t>(allocator, input_ids_dims, input_ids, &ml_value);
+  feeds.insert(std::make_pair("input_ids", ml_value));
+  CreateMLValue<int64_t>(allocator, {}, {max_length}, &ml_value);
+  feeds.insert(std::make_pair("max_length", ml_value));
+  CreateMLValue<int64_t>(allocator, {}, {num_beams}, &ml_value);
+  feeds.insert(std::make_pair("num_beams", ml_value));
+  CreateMLValue<int64_t>(allocator, {}, {num_return_sequences}, &ml_value);
+  feeds.insert(std::make_pair("num_return_sequences", ml_value));
+  CreateMLValue<float>(allocator, {}, {length_penalty}, &ml_value);
+  feeds.insert(std::make_pair("length_penalty", ml_value));
+
+  std::vector<std::string> output_names{"sequences", "sequences_scores"};
+  std::vector<OrtValue> fetches;
+  RunOptions run_options;
+  ASSERT_TRUE((status = session_object.Run(run_options, feeds, output_names, &fetches)).IsOK()) << status;
+
+  const auto& sequences = fetches[0].Get<Tensor>();
+  EXPECT_EQ(sequences.Shape(), TensorShape({input_ids_dims[0], num_return_sequences, max_length}));
+  auto sequences_data = sequences.DataAsSpan<int64_t>();
+  EXPECT_THAT(std::vector<int64_t>(sequences_data.begin(), sequences_data.end()),
+              testing::ContainerEq(expected_sequences));
+
+  auto scores_data = fetches[1].Get<Tensor>().DataAsSpan<float>();
+  ASSERT_EQ(static_cast<size_t>(scores_data.size()), expected_scores.size());
+  for (size_t i = 0; i < expected_scores.size(); ++i) {
+    EXPECT_NEAR(scores_data[i], expected_scores[i], 1e-5f);
+  }
+}
+
+}  // namespace
+
+TEST(BeamSearchTest, GreedySearch) {
+  // always the most likely next token: 1 -> 2 (0.5) -> 1 (0.4) -> 2 (0.5)
+  RunBeamSearch({1, 1}, {1}, 4, 1, 1, 1.0f, {1, 2, 1, 2}, {std::log(0.1f) / 4});
+}
+
+TEST(BeamSearchTest, BeamSearchFinishesShortSequences) {
+  // [1, 3, 0] has the probability 0.36 over 2 tokens, better than 0.1 over 4 tokens for the greedy sequence.
+  // The second prompt finishes [2, 1, 3] at the last step but [2, 1, 2, 1] scores better.
+  RunBeamSearch({2, 1}, {1, 2}, 4, 2, 2, 1.0f,
+                {1, 3, 0, 0, 1, 2, 1, 2, 2, 1, 2, 1, 2, 1, 3, 0},
+                {std::log(0.36f) / 2, std::log(0.1f) / 4, std::log(0.08f) / 4, std::log(0.144f) / 3});
+}
+
+TEST(BeamSearchTest, LengthPenalty) {
+  // a length penalty of 2 favors the longer sequences over [1, 3]
+  RunBeamSearch({1, 1}, {1}, 4, 2, 2, 2.0f,
+                {1, 2, 1, 2, 1, 2, 1, 3},
+                {std::log(0.1f) / 16, std::log(0.08f) / 16});
+}
+
+}  // namespace test
+}  // namespace onnxruntime
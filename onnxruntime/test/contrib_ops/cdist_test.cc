@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+const std::vector<float> kA = {0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f,
+                               1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f,
+                               0.5f, -1.f, 2.f, 0.f, 0.f, 0.f, 3.f, 1.f, 0.f};
+const std::vector<float> kB = {1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f,
+                               0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f};
+
+// the first n columns of the rows of a [rows, 9] matrix
+std::vector<float> FirstColumns(const std::vector<float>& m, size_t n) {
+  std::vector<float> columns;
+  for (size_t i = 0; i < m.size(); i += 9) {
+    columns.insert(columns.end(), m.begin() + i, m.begin() + i + n);
+  }
+  return columns;
+}
+
+void RunCDistTest(const std::string& metric, int64_t n, const std::vector<float>& expected) {
+  OpTester test("CDist", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("metric", metric);
+  test.AddInput<float>("A", {3, n}, FirstColumns(kA, static_cast<size_t>(n)));
+  test.AddInput<float>("B", {2, n}, FirstColumns(kB, static_cast<size_t>(n)));
+  test.AddOutput<float>("C", {3, 2}, expected);
+  test.Run();
+}
+
+}  // namespace
+
+TEST(CDistTest, Sqeuclidean) {
+  RunCDistTest("sqeuclidean", 9, {141.f, 0.f, 6.f, 183.f, 13.25f, 163.25f});
+}
+
+TEST(CDistTest, Euclidean) {
+  // the distance of equal rows stays 0 when it's computed from the norms and A * B^T
+  RunCDistTest("euclidean", 9, {11.8743421f, 0.f, 2.4494897f, 13.5277493f, 3.6400549f, 12.7769323f});
+}
+
+TEST(CDistTest, SmallVectors) {
+  RunCDistTest("sqeuclidean", 2, {1.f, 0.f, 1.f, 2.f, 4.25f, 4.25f});
+  RunCDistTest("euclidean", 2, {1.f, 0.f, 1.f, 1.4142136f, 2.0615528f, 2.0615528f});
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// [seq_length = 3, batch_size = 1, input_size = 3]
+const std::vector<float> kX = {0.5f, -1.25f, 2.f, 1.5f, 0.25f, -0.75f, -1.75f, 1.f, 0.5f};
+
+// [input_size = 3, 4 * hidden_size = 8] and [hidden_size = 2, 8], quantized around 128
+const std::vector<uint8_t> kW = {130, 120, 140, 100, 128, 160, 90, 135,
+                                 110, 150, 128, 140, 125, 100, 170, 118,
+                                 140, 128, 115, 132, 150, 120, 128, 100};
+const std::vector<uint8_t> kR = {120, 140, 128, 110, 135, 125, 150, 100,
+                                 140, 118, 130, 128, 100, 138, 122, 145};
+
+// the columns of kW and kR in reverse order
+std::vector<uint8_t> ReverseColumns(const std::vector<uint8_t>& weights) {
+  std::vector<uint8_t> reversed(weights);
+  for (auto row = reversed.begin(); row != reversed.end(); row += 8) {
+    std::reverse(row, row + 8);
+  }
+  return reversed;
+}
+
+}  // namespace
+
+// The expected values quantize every GEMM input like DynamicQuantizeLinear and compute the gates in float.
+TEST(DynamicQuantizeLSTMTest, ForwardPerChannelScales) {
+  OpTester test("DynamicQuantizeLSTM", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("hidden_size", 2);
+  test.AddAttribute<std::string>("direction", "forward");
+
+  test.AddInput<float>("X", {3, 1, 3}, kX);
+  test.AddInput<uint8_t>("W", {1, 3, 8}, kW, true);
+  test.AddInput<uint8_t>("R", {1, 2, 8}, kR, true);
+  test.AddInput<float>("B", {1, 16}, {0.1f, -0.1f, 0.2f, 0.f, 0.05f, 0.3f, -0.2f, 0.1f,
+                                      0.f, 0.1f, -0.05f, 0.1f, 0.f, 0.f, 0.1f, -0.1f});
+  test.AddMissingOptionalInput<int32_t>();
+  test.AddMissingOptionalInput<float>();
+  test.AddMissingOptionalInput<float>();
+  test.AddMissingOptionalInput<float>();
+  test.AddInput<float>("W_scale", {1, 8}, {0.01f, 0.02f, 0.015f, 0.01f, 0.02f, 0.012f, 0.01f, 0.018f});
+  test.AddInput<uint8_t>("W_zero_point", {1}, {128});
+  test.AddInput<float>("R_scale", {1, 8}, {0.02f, 0.01f, 0.015f, 0.02f, 0.01f, 0.018f, 0.012f, 0.01f});
+  test.AddInput<uint8_t>("R_zero_point", {1}, {128});
+
+  test.AddOutput<float>("Y", {3, 1, 1, 2},
+                        {-0.1875826f, -0.09977773f, -0.2722f, 0.03690063f, 0.04825931f, -0.2122782f});
+  test.AddOutput<float>("Y_h", {1, 1, 2}, {0.04825931f, -0.2122782f});
+  test.AddOutput<float>("Y_c", {1, 1, 2}, {0.111395f, -0.3150344f});
+  test.Run();
+}
+
+TEST(DynamicQuantizeLSTMTest, BidirectionalPerDirectionScales) {
+  OpTester test("DynamicQuantizeLSTM", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("hidden_size", 2);
+  test.AddAttribute<std::string>("direction", "bidirectional");
+
+  std::vector<uint8_t> W(kW);
+  std::vector<uint8_t> W_reverse = ReverseColumns(kW);
+  W.insert(W.end(), W_reverse.begin(), W_reverse.end());
+  std::vector<uint8_t> R(kR);
+  std::vector<uint8_t> R_reverse = ReverseColumns(kR);
+  R.insert(R.end(), R_reverse.begin(), R_reverse.end());
+
+  test.AddInput<float>("X", {3, 1, 3}, kX);
+  test.AddInput<uint8_t>("W", {2, 3, 8}, W);
+  test.AddInput<uint8_t>("R", {2, 2, 8}, R);
+  test.AddMissingOptionalInput<float>();
+  test.AddMissingOptionalInput<int32_t>();
+  test.AddMissingOptionalInput<float>();
+  test.AddMissingOptionalInput<float>();
+  test.AddMissingOptionalInput<float>();
+  test.AddInput<float>("W_scale", {2}, {0.02f, 0.01f});
+  test.AddInput<uint8_t>("W_zero_point", {2}, {120, 135});
+  test.AddInput<float>("R_scale", {2}, {0.015f, 0.02f});
+  test.AddInput<uint8_t>("R_zero_point", {2}, {130, 125});
+
+  test.AddOutput<float>("Y", {3, 2, 1, 2},
+                        {-0.2542827f, -0.09285524f, -0.08010535f, 0.03299047f,
+                         -0.3762633f, 0.06427417f, -0.003391291f, -0.05751426f,
+                         0.03179803f, -0.2395096f, 0.04403953f, -0.05360026f});
+  test.AddOutput<float>("Y_h", {2, 1, 2}, {0.03179803f, -0.2395096f, -0.08010535f, 0.03299047f});
+  test.AddOutput<float>("Y_c", {2, 1, 2}, {0.0887491f, -0.312585f, -0.1436242f, 0.05476308f});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
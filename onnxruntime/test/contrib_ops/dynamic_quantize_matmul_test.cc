@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// A spans [0, 127.5] so it's quantized exactly with a scale of 0.5 and a zero point of 0.
+TEST(DynamicQuantizeMatMulOpTest, UInt8WeightsWithBias) {
+  OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 2}, {0.f, 1.f, 2.f, 127.5f});
+  test.AddInput<uint8_t>("B", {2, 2}, {1, 2, 3, 4});
+  test.AddInput<float>("b_scale", {}, {0.25f});
+  test.AddInput<uint8_t>("b_zero_point", {}, {1});
+  test.AddInput<float>("bias", {2}, {1.f, -1.f});
+  test.AddOutput<float>("Y", {2, 2}, {1.5f, -0.25f, 64.75f, 95.125f});
+  test.Run();
+}
+
+TEST(DynamicQuantizeMatMulOpTest, Int8Weights) {
+  OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 2}, {0.f, 1.f, 2.f, 127.5f});
+  test.AddInput<int8_t>("B", {2, 2}, {-1, 2, 3, -4});
+  test.AddInput<float>("b_scale", {1}, {1.f});
+  test.AddOutput<float>("Y", {2, 2}, {3.f, -4.f, 380.5f, -506.f});
+  test.Run();
+}
+
+// Each of the 3-D A matrices is multiplied with the same B.
+TEST(DynamicQuantizeMatMulOpTest, Batched) {
+  OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 1, 2}, {0.f, 1.f, 2.f, 127.5f});
+  test.AddInput<uint8_t>("B", {2, 2}, {1, 2, 3, 4});
+  test.AddInput<float>("b_scale", {}, {0.25f});
+  test.AddInput<uint8_t>("b_zero_point", {}, {1});
+  test.AddOutput<float>("Y", {2, 1, 2}, {0.5f, 0.75f, 63.75f, 96.125f});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
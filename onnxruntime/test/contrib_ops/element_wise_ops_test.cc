@@ -114,5 +114,17 @@ TEST(BiasGeluTest, Two_One_Dim) {
   RunBiasGeluTest(input_a_data, input_b_data, {2, 4}, {4});
 }
 
+// the bias length is not a multiple of the vector width of the CUDA kernel
+TEST(BiasGeluTest, Two_One_Dim_Unaligned) {
+  std::vector<float> input_a_data = {
+      0.8f, -0.5f, 0.0f,
+      1.f, 0.5f, 0.2f};
+
+  std::vector<float> input_b_data = {
+      -0.5f, 0.6f, 1.2f};
+
+  RunBiasGeluTest(input_a_data, input_b_data, {2, 3}, {3});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
@@ -423,5 +425,75 @@ TEST(EmbedLayerNormTest, EmbedLayerNormLargeBatchSmallHiddenSize) {
           sequence_length,
           hidden_size);
 }
+
+// The embedding values are exact in float16 and in int8 with the scales below, so all the table types give the
+// output of the float tables.
+static void RunCompressedTablesTest(bool use_int8) {
+  const std::vector<int64_t> ids_dims = {1, 2};
+  const std::vector<int64_t> hidden_dims = {4};
+  const std::vector<int32_t> input_ids_data = {1, 2};
+  const std::vector<int32_t> segment_ids_data = {0, 1};
+  const std::vector<int32_t> mask_data = {1, 1};
+
+  const std::vector<float> word_embedding_data = {
+      0.25f, 0.125f, 0.5f, -0.75f,
+      0.375f, 0.25f, 0.5f, 0.625f,
+      1.0f, -2.0f, 1.125f, 0.75f};
+  const std::vector<float> word_embedding_scale = {1.0f / 16, 1.0f / 32, 1.0f / 16};
+
+  const std::vector<float> position_embedding_data = {
+      0.125f, 0.125f, 0.5f, 0.625f,
+      0.625f, 0.0f, 0.75f, 0.5f};
+  const std::vector<float> position_embedding_scale = {1.0f / 16, 1.0f / 16};
+
+  const std::vector<float> segment_embedding_data = {
+      0.25f, 0.5f, 0.875f, 0.125f,
+      0.75f, 0.25f, 0.5f, 0.25f};
+  const std::vector<float> segment_embedding_scale = {1.0f / 16, 1.0f / 16};
+
+  auto quantize = [](const std::vector<float>& data, const std::vector<float>& scale) {
+    std::vector<int8_t> quantized(data.size());
+    const size_t hidden_size = data.size() / scale.size();
+    for (size_t i = 0; i < data.size(); ++i) {
+      quantized[i] = static_cast<int8_t>(std::lround(data[i] / scale[i / hidden_size]));
+    }
+    return quantized;
+  };
+
+  OpTester tester("EmbedLayerNormalization", 1, onnxruntime::kMSDomain);
+  tester.AddInput<int32_t>("input_ids", ids_dims, input_ids_data);
+  tester.AddInput<int32_t>("segment_ids", ids_dims, segment_ids_data);
+  if (use_int8) {
+    tester.AddInput<int8_t>("word_embedding", {3, 4}, quantize(word_embedding_data, word_embedding_scale));
+    tester.AddInput<int8_t>("position_embedding", {2, 4},
+                            quantize(position_embedding_data, position_embedding_scale));
+    tester.AddInput<int8_t>("segment_embedding", {2, 4}, quantize(segment_embedding_data, segment_embedding_scale));
+  } else {
+    tester.AddInput<MLFloat16>("word_embedding", {3, 4}, ToFloat16(word_embedding_data));
+    tester.AddInput<MLFloat16>("position_embedding", {2, 4}, ToFloat16(position_embedding_data));
+    tester.AddInput<MLFloat16>("segment_embedding", {2, 4}, ToFloat16(segment_embedding_data));
+  }
+  tester.AddInput<float>("gamma", hidden_dims, {0.25f, 0.15f, 0.45f, -0.66f});
+  tester.AddInput<float>("beta", hidden_dims, {0.6f, 0.2f, 0.5f, -0.6f});
+  tester.AddInput<int32_t>("mask", ids_dims, mask_data);
+  if (use_int8) {
+    tester.AddInput<float>("word_embedding_scale", {3}, word_embedding_scale);
+    tester.AddInput<float>("position_embedding_scale", {2}, position_embedding_scale);
+    tester.AddInput<float>("segment_embedding_scale", {2}, segment_embedding_scale);
+  }
+  tester.AddOutput<float>("output", {1, 2, 4},
+                          {0.3368016f, 0.0841927f, 1.1632600f, -0.8316146f,
+                           0.7840525f, -0.0539925f, 0.8312946f, -0.7457696f});
+  tester.AddOutput<int32_t>("mask_index", {1}, {2});
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider});
+}
+
+TEST(EmbedLayerNormTest, EmbedLayerNormFloat16Tables) {
+  RunCompressedTablesTest(false);
+}
+
+TEST(EmbedLayerNormTest, EmbedLayerNormInt8Tables) {
+  RunCompressedTablesTest(true);
+}
 }  // namespace test
 }  // namespace onnxruntime
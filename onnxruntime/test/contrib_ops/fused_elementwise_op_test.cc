@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+static float Sigmoid(float x) {
+  return 1.0f / (1.0f + std::exp(-x));
+}
+
+// y = (x * scale + bias) * Sigmoid(x * scale + bias), with a scalar scale and a bias broadcast over the rows
+TEST(FusedElementwiseOpTest, BroadcastChain) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+
+  const std::vector<float> x{-2.0f, -1.0f, 0.0f, 1.0f, 2.0f, 3.0f};
+  const std::vector<float> bias{0.5f, -0.5f, 1.0f};
+  const float scale = 2.0f;
+  std::vector<float> y;
+  for (size_t i = 0; i < x.size(); ++i) {
+    const float value = x[i] * scale + bias[i % bias.size()];
+    y.push_back(value * Sigmoid(value));
+  }
+
+  test.AddAttribute("ops", std::vector<std::string>{"Mul", "Add", "Sigmoid", "Mul"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 3, 2, 4, -1, 4, 5});
+  test.AddInput<float>("x", {2, 3}, x);
+  test.AddInput<float>("scale", {}, {scale});
+  test.AddInput<float>("bias", {1, 3}, bias);
+  test.AddOutput<float>("y", {2, 3}, y);
+  test.Run();
+}
+
+// large enough to be split into many blocks and across the thread pool
+TEST(FusedElementwiseOpTest, ManyBlocks) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+
+  const int64_t rows = 64;
+  const int64_t cols = 1001;
+  std::vector<float> a(rows * cols);
+  std::vector<float> b(cols);
+  std::vector<float> y(rows * cols);
+  for (int64_t i = 0; i < cols; ++i) {
+    b[i] = static_cast<float>(i % 7) - 3.0f;
+  }
+  for (int64_t i = 0; i < rows * cols; ++i) {
+    a[i] = static_cast<float>(i % 13) - 6.0f;
+    y[i] = std::tanh(std::max(a[i] - b[i % cols], 0.0f)) + a[i];
+  }
+
+  test.AddAttribute("ops", std::vector<std::string>{"Sub", "Relu", "Tanh", "Add"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 2, -1, 3, -1, 4, 0});
+  test.AddInput<float>("a", {rows, cols}, a);
+  test.AddInput<float>("b", {cols}, b);
+  test.AddOutput<float>("y", {rows, cols}, y);
+  test.Run();
+}
+
+TEST(FusedElementwiseOpTest, UnsupportedBroadcast) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Add", "Relu"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 2, -1});
+  test.AddInput<float>("a", {2, 3}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<float>("b", {2, 1}, {1.0f, 2.0f});
+  test.AddOutput<float>("y", {2, 3}, {2.0f, 3.0f, 4.0f, 6.0f, 7.0f, 8.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "can only be broadcast over the leading axes");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
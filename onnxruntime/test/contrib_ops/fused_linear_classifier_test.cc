@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Scaler -> Normalizer (L2) -> LinearClassifier with three classes and a softmax, over enough rows for several blocks
+TEST(FusedLinearClassifierTest, ScalerNormalizerSoftmax) {
+  OpTester test("FusedLinearClassifier", 1, onnxruntime::kMSDomain);
+
+  const int64_t rows = 200;
+  const std::vector<float> scale{0.5f, 2.f};
+  const std::vector<float> offset{1.f, -1.f};
+  const std::vector<float> coefficients{1.f, -1.f, -1.f, 1.f, 0.5f, 0.5f};
+  const std::vector<float> intercepts{0.1f, -0.1f, 0.f};
+  const std::vector<int64_t> labels{10, 20, 30};
+
+  std::vector<float> x;
+  std::vector<int64_t> y;
+  std::vector<float> z;
+  for (int64_t r = 0; r < rows; ++r) {
+    const float x0 = static_cast<float>(r % 11) - 5.f;
+    const float x1 = static_cast<float>(r % 7) - 3.f;
+    x.push_back(x0);
+    x.push_back(x1);
+
+    float f0 = (x0 - offset[0]) * scale[0];
+    float f1 = (x1 - offset[1]) * scale[1];
+    const float norm = std::sqrt(f0 * f0 + f1 * f1);
+    if (norm != 0.f) {
+      f0 /= norm;
+      f1 /= norm;
+    }
+
+    float scores[3];
+    float sum = 0.f;
+    int64_t best = 0;
+    for (int64_t c = 0; c < 3; ++c) {
+      scores[c] = coefficients[2 * c] * f0 + coefficients[2 * c + 1] * f1 + intercepts[c];
+      if (scores[c] > scores[best]) {
+        best = c;
+      }
+    }
+    for (int64_t c = 0; c < 3; ++c) {
+      scores[c] = std::exp(scores[c] - scores[best]);
+      sum += scores[c];
+    }
+    y.push_back(labels[best]);
+    for (int64_t c = 0; c < 3; ++c) {
+      z.push_back(scores[c] / sum);
+    }
+  }
+
+  test.AddAttribute("steps", std::vector<std::string>{"Scaler", "Normalizer"});
+  test.AddAttribute("scale", scale);
+  test.AddAttribute("offset", offset);
+  test.AddAttribute("norm", std::string("L2"));
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", labels);
+  test.AddAttribute("post_transform", std::string("SOFTMAX"));
+  test.AddInput<float>("X", {rows, 2}, x);
+  test.AddOutput<int64_t>("Y", {rows}, y);
+  test.AddOutput<float>("Z", {rows, 3}, z);
+  test.Run();
+}
+
+// Binarizer -> LinearClassifier with one class and two string labels. The scores of the two classes are 1 - s and s.
+TEST(FusedLinearClassifierTest, BinarizerBinaryClass) {
+  OpTester test("FusedLinearClassifier", 1, onnxruntime::kMSDomain);
+
+  test.AddAttribute("steps", std::vector<std::string>{"Binarizer"});
+  test.AddAttribute("threshold", 0.5f);
+  test.AddAttribute("coefficients", std::vector<float>{1.f, -2.f});
+  test.AddAttribute("intercepts", std::vector<float>{0.5f});
+  test.AddAttribute("classlabels_strings", std::vector<std::string>{"no", "yes"});
+  test.AddInput<float>("X", {3, 2}, {1.f, 0.f, 0.f, 1.f, 1.f, 1.f});
+  test.AddOutput<std::string>("Y", {3}, {"yes", "no", "no"});
+  test.AddOutput<float>("Z", {3, 2}, {-0.5f, 1.5f, 2.5f, -1.5f, 1.5f, -0.5f});
+  test.Run();
+}
+
+TEST(FusedLinearClassifierTest, BinarizerNaN) {
+  OpTester test("FusedLinearClassifier", 1, onnxruntime::kMSDomain);
+
+  test.AddAttribute("steps", std::vector<std::string>{"Binarizer"});
+  test.AddAttribute("coefficients", std::vector<float>{1.f, -2.f});
+  test.AddAttribute("intercepts", std::vector<float>{0.5f});
+  test.AddAttribute("classlabels_ints", std::vector<int64_t>{0, 1});
+  test.AddInput<float>("X", {1, 2}, {1.f, std::nanf("")});
+  test.AddOutput<int64_t>("Y", {1}, {0});
+  test.AddOutput<float>("Z", {1, 2}, {0.f, 0.f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "the input of the Binarizer step is NaN");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
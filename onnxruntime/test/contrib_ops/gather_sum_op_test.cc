@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(GatherSumOpTest, Indices2D) {
+  OpTester test("GatherSum", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {4, 2},
+                       {1.0f, 2.0f,
+                        3.0f, 4.0f,
+                        5.0f, 6.0f,
+                        7.0f, 8.0f});
+  test.AddInput<int64_t>("indices", {2, 3},
+                         {0, 1, 3,
+                          2, 2, -4});
+  test.AddOutput<float>("output", {2, 2},
+                        {11.0f, 14.0f,
+                         11.0f, 14.0f});
+  test.Run();
+}
+
+TEST(GatherSumOpTest, Indices1DInt32) {
+  OpTester test("GatherSum", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {3, 1, 2},
+                       {1.0f, 2.0f,
+                        3.0f, 4.0f,
+                        5.0f, 6.0f});
+  test.AddInput<int32_t>("indices", {2}, {2, 0});
+  test.AddOutput<float>("output", {1, 2}, {6.0f, 8.0f});
+  test.Run();
+}
+
+TEST(GatherSumOpTest, EmptyBags) {
+  OpTester test("GatherSum", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {2, 2}, {1.0f, 2.0f, 3.0f, 4.0f});
+  test.AddInput<int64_t>("indices", {2, 0}, std::vector<int64_t>{});
+  test.AddOutput<float>("output", {2, 2}, {0.0f, 0.0f, 0.0f, 0.0f});
+  test.Run();
+}
+
+TEST(GatherSumOpTest, InvalidIndex) {
+  OpTester test("GatherSum", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {2, 2}, {1.0f, 2.0f, 3.0f, 4.0f});
+  test.AddInput<int64_t>("indices", {1, 2}, {0, 2});
+  test.AddOutput<float>("output", {1, 2}, {0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds");
+}
+
+// large enough to split the bags across the thread pool
+TEST(GatherSumOpTest, EmbeddingBag) {
+  OpTester test("GatherSum", 1, onnxruntime::kMSDomain);
+
+  const int64_t num_rows = 500;
+  const int64_t row_size = 32;
+  const int64_t num_bags = 512;
+  const int64_t bag_size = 4;
+
+  std::vector<float> data(num_rows * row_size);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 13);
+  }
+
+  std::vector<int64_t> indices(num_bags * bag_size);
+  std::vector<float> output(num_bags * row_size, 0.0f);
+  for (int64_t bag = 0; bag < num_bags; ++bag) {
+    for (int64_t j = 0; j < bag_size; ++j) {
+      const int64_t index = (bag * 31 + j * 97) % num_rows;
+      indices[bag * bag_size + j] = index;
+      for (int64_t k = 0; k < row_size; ++k) {
+        output[bag * row_size + k] += data[index * row_size + k];
+      }
+    }
+  }
+
+  test.AddInput<float>("data", {num_rows, row_size}, data);
+  test.AddInput<int64_t>("indices", {num_bags, bag_size}, indices);
+  test.AddOutput<float>("output", {num_bags, row_size}, output);
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -116,5 +116,49 @@ TEST(MurmurHash3OpTest, StringKeyUIntWithSeed42) {
   test.Run();
 }
 
+TEST(MurmurHash3OpTest, Buckets) {
+  OpTester test("MurmurHash3", 1, onnxruntime::kMSDomain);
+  test.AddInput<int32_t>("X", {2}, {3L, 4L});
+  test.AddAttribute<int64_t>("num_buckets", 1000LL);
+  test.AddOutput<uint32_t>("Y", {2}, {505L, 975L});
+  test.Run();
+}
+
+TEST(MurmurHash3OpTest, StringKeyBucketsIntResult) {
+  // the bucket of the unsigned hash 2972666014
+  OpTester test("MurmurHash3", 1, onnxruntime::kMSDomain);
+  test.AddInput<std::string>("X", {1}, {"foo"});
+  test.AddAttribute<int64_t>("seed", 42LL);
+  test.AddAttribute<int64_t>("positive", 0);
+  test.AddAttribute<int64_t>("num_buckets", 1000LL);
+  test.AddOutput<int32_t>("Y", {1}, {14L});
+  test.Run();
+}
+
+TEST(MurmurHash3OpTest, ManyKeys) {
+  // enough keys to be hashed in several blocks
+  const int64_t count = 100000;
+  std::vector<int32_t> keys(count);
+  std::vector<uint32_t> int_hashes(count);
+  std::vector<std::string> string_keys(count);
+  std::vector<uint32_t> string_hashes(count);
+  for (int64_t i = 0; i < count; ++i) {
+    keys[i] = i % 2 == 0 ? 3 : 4;
+    int_hashes[i] = i % 2 == 0 ? 847579505UL : 1889779975UL;
+    string_keys[i] = i % 2 == 0 ? "foo" : "bar";
+    string_hashes[i] = i % 2 == 0 ? 4138058784UL : 1158584717UL;
+  }
+
+  OpTester int_test("MurmurHash3", 1, onnxruntime::kMSDomain);
+  int_test.AddInput<int32_t>("X", {count}, keys);
+  int_test.AddOutput<uint32_t>("Y", {count}, int_hashes);
+  int_test.Run();
+
+  OpTester string_test("MurmurHash3", 1, onnxruntime::kMSDomain);
+  string_test.AddInput<std::string>("X", {count}, string_keys);
+  string_test.AddOutput<uint32_t>("Y", {count}, string_hashes);
+  string_test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// B = [[1, 0, 2],
+//      [0, 0, 0],
+//      [0, 3, 0],
+//      [4, 0, 0]]
+static void AddSparseB(OpTester& test) {
+  test.AddAttribute<int64_t>("N", 3);
+  test.AddInput<float>("B_values", {4}, {1.0f, 2.0f, 3.0f, 4.0f});
+  test.AddInput<int32_t>("B_col_indices", {4}, {0, 2, 1, 0});
+  test.AddInput<int64_t>("B_row_offsets", {5}, {0, 2, 2, 3, 4});
+}
+
+TEST(SparseMatMulOpTest, Basic) {
+  OpTester test("SparseMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 4}, {1.0f, 2.0f, 3.0f, 4.0f,
+                                     0.0f, -1.0f, 0.5f, 0.0f});
+  AddSparseB(test);
+  test.AddOutput<float>("Y", {2, 3}, {17.0f, 9.0f, 2.0f,
+                                      0.0f, 1.5f, 0.0f});
+  test.Run();
+}
+
+TEST(SparseMatMulOpTest, BatchedWithBias) {
+  OpTester test("SparseMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 1, 4}, {1.0f, 2.0f, 3.0f, 4.0f,
+                                        0.0f, -1.0f, 0.5f, 0.0f});
+  AddSparseB(test);
+  test.AddInput<float>("bias", {3}, {1.0f, -1.0f, 0.5f});
+  test.AddOutput<float>("Y", {2, 1, 3}, {18.0f, 8.0f, 2.5f,
+                                         1.0f, 0.5f, 0.5f});
+  test.Run();
+}
+
+TEST(SparseMatMulOpTest, InvalidColumn) {
+  OpTester test("SparseMatMul", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("N", 2);
+  test.AddInput<float>("A", {1, 2}, {1.0f, 2.0f});
+  test.AddInput<float>("B_values", {2}, {1.0f, 2.0f});
+  test.AddInput<int32_t>("B_col_indices", {2}, {0, 2});
+  test.AddInput<int64_t>("B_row_offsets", {3}, {0, 1, 2});
+  test.AddOutput<float>("Y", {1, 2}, {1.0f, 4.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "column index 2 is out of range");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -864,5 +864,34 @@ TEST(ContribOpTest, Tokenizer_EmptyInput) {
     test.Run(OpTester::ExpectResult::kExpectSuccess);
   }
 }
+
+TEST(ContribOpTest, TokenizerWithSeparators_ManyRowsNC) {
+  // Enough rows to be tokenized in several batches, with a varying number of tokens per row
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, true, {" "}, 1);
+
+  const int64_t N = 64;
+  const int64_t C = 3;
+  const size_t max_tokens = 5 + 2;
+  std::vector<std::string> input;
+  std::vector<std::string> output;
+  for (int64_t i = 0; i < N * C; ++i) {
+    std::string s;
+    output.push_back(start_mark);
+    const int64_t num_tokens = i % 6;
+    for (int64_t t = 0; t < num_tokens; ++t) {
+      const std::string token = "w" + std::to_string(i) + "_" + std::to_string(t);
+      s += (t == 0 ? "" : " ") + token;
+      output.push_back(token);
+    }
+    output.push_back(end_mark);
+    output.resize(output.size() + max_tokens - (num_tokens + 2), padval);
+    input.push_back(s);
+  }
+  test.AddInput<std::string>("T", {N, C}, input);
+  test.AddOutput<std::string>("Y", {N, C, static_cast<int64_t>(max_tokens)}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -63,5 +63,32 @@ TEST(FeaturizersTests, MinMaxScalerTransformer_only_one_input) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(FeaturizersTests, MinMaxScalerTransformer_large_input) {
+  using InputType = int32_t;
+  using TransformedType = double;
+
+  auto training_batches = NS::TestHelpers::make_vector<std::vector<InputType>>(
+      NS::TestHelpers::make_vector<InputType>(static_cast<InputType>(0)),
+      NS::TestHelpers::make_vector<InputType>(static_cast<InputType>(1000)));
+
+  auto stream = GetStream<InputType, TransformedType>(training_batches);
+
+  // enough elements to be split between several transformers
+  const int64_t length = 100000;
+  std::vector<InputType> input(length);
+  std::vector<TransformedType> output(length);
+  for (int64_t i = 0; i < length; ++i) {
+    input[i] = static_cast<InputType>(i % 1000);
+    output[i] = static_cast<TransformedType>(i % 1000) / 1000;
+  }
+
+  OpTester test("MinMaxScalerTransformer", 1, onnxruntime::kMSFeaturizersDomain);
+  auto dim = static_cast<int64_t>(stream.size());
+  test.AddInput<uint8_t>("State", {dim}, stream);
+  test.AddInput<InputType>("Input", {length}, input);
+  test.AddOutput<TransformedType>("Output", {length}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
\ No newline at end of file
@@ -125,15 +125,19 @@ typedef std::unordered_map<const onnxruntime::NodeArg*, TensorShapeProto*> Shape
 
 class SequentialPlannerTestContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerTestContext(ShapeMap* shape_map) : shape_map_(shape_map) {}
+  SequentialPlannerTestContext(ShapeMap* shape_map, bool enable_memory_efficient_order = false)
+      : shape_map_(shape_map), enable_memory_efficient_order_(enable_memory_efficient_order) {}
 
   TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
     auto iter = shape_map_->find(&arg);
     return (shape_map_->end() != iter) ? iter->second : nullptr;
   }
 
+  bool IsMemoryEfficientOrderEnabled() const override { return enable_memory_efficient_order_; }
+
  private:
   ShapeMap* shape_map_;
+  bool enable_memory_efficient_order_;
 };
 
 class PlannerTest : public ::testing::Test {
@@ -219,7 +223,8 @@ class PlannerTest : public ::testing::Test {
     }
   }
 
-  void CreatePlan(const std::vector<const NodeArg*>& outer_scope_node_args = {}) {
+  void CreatePlan(const std::vector<const NodeArg*>& outer_scope_node_args = {},
+                  bool enable_memory_efficient_order = false) {
     EXPECT_EQ(graph_.Resolve(), Status::OK());
 
     state_.SetGraph(graph_);
@@ -239,7 +244,7 @@ class PlannerTest : public ::testing::Test {
     EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
     status = state_.CreateKernels(kernel_registry_manager);
     EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
-    SequentialPlannerTestContext test_context(&shape_map_);
+    SequentialPlannerTestContext test_context(&shape_map_, enable_memory_efficient_order);
     status = SequentialPlanner::CreatePlan(nullptr, GraphViewer(graph_), outer_scope_node_args, execution_providers,
                                            kernel_registry_manager, state_.GetOrtValueNameIdxMap(), test_context, plan_);
 
@@ -415,6 +420,95 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X2});
 }
 
+// SymbolicSizeReuseTest: Check that a freed buffer is reused by a tensor with a different shape but the
+// same symbolic size, and not by one whose symbolic size differs.
+TEST_F(PlannerTest, SymbolicSizeReuseTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), X6("X6");
+
+  // graph structure:
+  AddNormalNode(X1, X2);  // X1: input; X2: temporary
+  AddNormalNode(X2, X3);  // X3: temporary
+  AddNormalNode(X3, X4);  // X4: temporary. X2 is free and has the same symbolic size
+  AddNormalNode(X4, X5);  // X5: temporary. X3 is free but has a different symbolic size
+  AddNormalNode(X5, X6);  // X6: output
+
+  // simulate shape-inference results:
+  Shape shape_mn{"M", "N"};
+  Shape shape_nm{"N", "M"};
+  Shape shape_mk{"M", "K"};
+  Shape shape_mm{"M", "M"};
+  SetShape({{X1, &shape_mn.value},
+            {X2, &shape_mn.value},
+            {X3, &shape_mk.value},
+            {X4, &shape_nm.value},
+            {X5, &shape_mm.value},
+            {X6, &shape_mn.value}});
+
+  CreatePlan();
+
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kReuse);
+  CheckAllocKind(X5, AllocKind::kAllocate);
+  CheckAllocKind(X6, AllocKind::kAllocateOutput);
+
+  int x2_idx, x4_idx;
+  ASSERT_TRUE(GetState().GetOrtValueNameIdxMap().GetIdx(X2, x2_idx).IsOK());
+  ASSERT_TRUE(GetState().GetOrtValueNameIdxMap().GetIdx(X4, x4_idx).IsOK());
+  EXPECT_EQ(GetPlan().allocation_plan[x4_idx].reused_buffer, x2_idx);
+}
+
+// NodePriorityTest: Check that nodes on the longest path to an output get the highest priority.
+TEST_F(PlannerTest, NodePriorityTest) {
+  // tensor variables:
+  std::string X("X"), A("A"), B("B"), C("C"), D("D");
+
+  // graph structure: X is consumed by a chain of three nodes and by a single node
+  auto* node_a = AddNormalNode(X, A);
+  auto* node_b = AddNormalNode(A, B);
+  auto* node_c = AddNormalNode(B, C);
+  auto* node_d = AddNormalNode(X, D);
+
+  CreatePlan();
+
+  const auto& plan = GetPlan();
+  EXPECT_EQ(plan.NodePriority(node_a->Index()), 3u);
+  EXPECT_EQ(plan.NodePriority(node_b->Index()), 2u);
+  EXPECT_EQ(plan.NodePriority(node_c->Index()), 1u);
+  EXPECT_EQ(plan.NodePriority(node_d->Index()), 1u);
+}
+
+// MemoryEfficientOrderTest: Check that the consumers of a large temporary run before another large temporary is
+// created when the memory efficient order is enabled.
+TEST_F(PlannerTest, MemoryEfficientOrderTest) {
+  // tensor variables:
+  std::string X("X"), P("P"), Q("Q"), C1("C1"), C2("C2"), Q1("Q1");
+
+  // graph structure: the default order is P, C2, Q, Q1, C1, so P and Q are alive together
+  auto* node_p = AddNormalNode(X, P);    // P: large temporary
+  auto* node_c1 = AddNormalNode(P, C1);  // C1: small output
+  auto* node_q = AddNormalNode(X, Q);    // Q: large temporary
+  auto* node_q1 = AddNormalNode(Q, Q1);  // Q1: small output
+  auto* node_c2 = AddNormalNode(P, C2);  // C2: small output
+
+  // simulate shape-inference results:
+  Shape large{100, 100};
+  Shape small{1};
+  SetShape({{X, &large.value}, {P, &large.value}, {Q, &large.value},
+            {C1, &small.value}, {C2, &small.value}, {Q1, &small.value}});
+
+  CreatePlan({}, true);
+
+  std::vector<NodeIndex> order;
+  for (const auto& step : GetPlan().execution_plan) {
+    order.push_back(step.node_index);
+  }
+  EXPECT_EQ(order, (std::vector<NodeIndex>{node_p->Index(), node_c2->Index(), node_c1->Index(), node_q->Index(),
+                                           node_q1->Index()}));
+  CheckFreed(2, {P});
+}
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
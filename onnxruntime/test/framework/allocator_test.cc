@@ -3,6 +3,7 @@
 
 #include "core/framework/allocatormgr.h"
 #include "core/framework/allocator.h"
+#include "core/framework/numa_allocator.h"
 #include "test_utils.h"
 #include "gtest/gtest.h"
 
@@ -32,6 +33,40 @@ TEST(AllocatorTest, CPUAllocatorTest) {
   //todo: test the used / max api.
 }
 
+TEST(AllocatorTest, NumaCPUAllocatorTest) {
+  // node 0 is always present, and the placement is best effort on platforms without NUMA support
+  NumaCPUAllocator allocator(0);
+  EXPECT_STREQ(allocator.Info().name, CPU);
+  EXPECT_EQ(allocator.Info().alloc_type, OrtAllocatorType::OrtDeviceAllocator);
+
+  EXPECT_EQ(allocator.Alloc(0), nullptr);
+
+  // sizes that are not a multiple of the page size, and more than one live allocation
+  auto* small = static_cast<char*>(allocator.Alloc(10));
+  auto* large = static_cast<char*>(allocator.Alloc(3 * 4096 + 1));
+  ASSERT_NE(small, nullptr);
+  ASSERT_NE(large, nullptr);
+  memset(small, 1, 10);
+  memset(large, 2, 3 * 4096 + 1);
+  EXPECT_EQ(small[9], 1);
+  EXPECT_EQ(large[3 * 4096], 2);
+
+  allocator.Free(small);
+  allocator.Free(nullptr);
+  // large is released by the destructor
+}
+
+TEST(AllocatorTest, CPUExecutionProviderNumaNodeTest) {
+  CPUExecutionProviderInfo info(false, 0);
+  CPUExecutionProvider provider(info);
+  auto allocator = provider.GetAllocator(0, OrtMemTypeDefault);
+  ASSERT_NE(dynamic_cast<NumaCPUAllocator*>(allocator.get()), nullptr);
+
+  auto bytes = allocator->Alloc(1024);
+  EXPECT_TRUE(bytes);
+  allocator->Free(bytes);
+}
+
 // helper class to validate values in Alloc and Free calls made via IAllocator::MakeUniquePtr
 class TestAllocator : public IAllocator {
  public:
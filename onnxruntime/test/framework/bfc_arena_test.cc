@@ -4,6 +4,7 @@
 #include "core/framework/bfc_arena.h"
 #include "gtest/gtest.h"
 #include <cstdlib>
+#include <thread>
 
 namespace onnxruntime {
 namespace test {
@@ -234,5 +235,114 @@ TEST(BFCArenaTest, TestReserve) {
   a.GetStats(&stats);
   EXPECT_EQ(stats.total_allocated_bytes, 1048576);
 }
+
+TEST(BFCArenaTest, TestShrink) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+
+  // the first region is 1MiB, the large allocation needs a second region
+  void* small_ptr = a.Alloc(1024);
+  void* large_ptr = a.Alloc(16 << 20);
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_GT(stats.total_allocated_bytes, 16 << 20);
+
+  // only the region of the large allocation is free
+  a.Free(large_ptr);
+  ASSERT_TRUE(a.Shrink().IsOK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 1 << 20);
+  EXPECT_EQ(1024u, a.RequestedSize(small_ptr));
+
+  a.Free(small_ptr);
+  ASSERT_TRUE(a.Shrink().IsOK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+
+  // the arena can grow again after everything was released
+  void* ptr = a.Alloc(4096);
+  EXPECT_NE(ptr, nullptr);
+  a.Free(ptr);
+}
+
+TEST(BFCArenaTest, TestShrinkWithThreadCache) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, true);
+
+  void* ptr = a.Alloc(1024);
+  a.Free(ptr);
+  // the chunk is held by the thread cache until Shrink returns it to the bins
+  ASSERT_TRUE(a.Shrink().IsOK());
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, ThreadCacheReusesFreedChunk) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, true);
+
+  void* first_ptr = a.Alloc(1000);
+  a.Free(first_ptr);
+  // same bin so it should come straight back from the cache
+  void* second_ptr = a.Alloc(900);
+  EXPECT_EQ(first_ptr, second_ptr);
+  EXPECT_EQ(900u, a.RequestedSize(second_ptr));
+
+  // large allocations bypass the cache
+  void* large_ptr = a.Alloc(1 << 20);
+  a.Free(large_ptr);
+  a.Free(second_ptr);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  EXPECT_EQ(stats.num_thread_cache_misses, 1);
+  // only the misses reach the bins
+  EXPECT_EQ(stats.num_allocs, 2);
+}
+
+TEST(BFCArenaTest, ThreadCacheConcurrentAllocations) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, true);
+
+  constexpr int num_threads = 8;
+  std::vector<std::thread> threads;
+  std::vector<void*> shared_ptrs(num_threads * 64, nullptr);
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&a, &shared_ptrs, t]() {
+      for (int i = 0; i < 1000; ++i) {
+        size_t size = 64 + (i * 37 + t * 101) % 32768;
+        void* p = a.Alloc(size);
+        ASSERT_NE(p, nullptr);
+        memset(p, t, size);
+        a.Free(p);
+      }
+      // allocate on this thread and free on another one
+      for (int i = 0; i < 64; ++i) {
+        shared_ptrs[t * 64 + i] = a.Alloc(256 * (i + 1));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<void*> sorted_ptrs(shared_ptrs);
+  std::sort(sorted_ptrs.begin(), sorted_ptrs.end());
+  for (size_t i = 1; i < sorted_ptrs.size(); i++) {
+    ASSERT_NE(sorted_ptrs[i], sorted_ptrs[i - 1]);  // No dups
+  }
+
+  std::thread freeing_thread([&a, &shared_ptrs]() {
+    for (void* p : shared_ptrs) {
+      a.Free(p);
+    }
+  });
+  freeing_thread.join();
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits + stats.num_thread_cache_misses, num_threads * (1000 + 64));
+  EXPECT_GT(stats.num_thread_cache_hits, 0);
+}
 }  // namespace test
 }  // namespace onnxruntime
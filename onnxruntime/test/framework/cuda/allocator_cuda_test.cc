@@ -7,6 +7,8 @@
 #include "cuda_runtime.h"
 #include "core/providers/cuda/cuda_allocator.h"
 #include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/cuda_stream_arena.h"
+#include <thread>
 
 namespace onnxruntime {
 namespace test {
@@ -111,5 +113,54 @@ TEST(AllocatorTest, CUDAAllocatorFallbackTest) {
   auto last_error = cudaGetLastError();
   EXPECT_EQ(last_error, cudaSuccess) << "Last error should be cleared if handled gracefully";
 }
+
+TEST(AllocatorTest, CUDAStreamArenaTest) {
+  OrtDevice::DeviceId cuda_device_id = 0;
+  CUDA_CALL_THROW(cudaSetDevice(cuda_device_id));
+  CUDAStreamArena cuda_arena(onnxruntime::make_unique<CUDAAllocator>(cuda_device_id, CUDA),
+                             std::numeric_limits<size_t>::max());
+
+  EXPECT_STREQ(cuda_arena.Info().name, CUDA);
+  EXPECT_EQ(cuda_arena.Info().alloc_type, OrtArenaAllocator);
+
+  // a block freed on this thread's stream is reused right away by the same stream
+  void* cuda_addr_0 = cuda_arena.Alloc(1000);
+  EXPECT_TRUE(cuda_addr_0);
+  cuda_arena.Free(cuda_addr_0);
+  void* cuda_addr_1 = cuda_arena.Alloc(1024);
+  EXPECT_EQ(cuda_addr_0, cuda_addr_1);
+  cuda_arena.Free(cuda_addr_1);
+
+  // the stream of another thread waits for the free before reusing the block
+  void* cuda_addr_2 = nullptr;
+  std::thread other([&cuda_arena, &cuda_addr_2]() {
+    CUDA_CALL_THROW(cudaSetDevice(0));
+    cuda_addr_2 = cuda_arena.Alloc(1024);
+    cuda_arena.Free(cuda_addr_2);
+    CUDA_CALL_THROW(cudaStreamSynchronize(cudaStreamPerThread));
+  });
+  other.join();
+  EXPECT_EQ(cuda_addr_0, cuda_addr_2);
+
+  // requests much smaller than the cached block get their own
+  void* cuda_addr_3 = cuda_arena.Alloc(100);
+  EXPECT_NE(cuda_addr_0, cuda_addr_3);
+
+  AllocatorStats stats;
+  cuda_arena.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 4);
+  EXPECT_EQ(stats.num_cross_stream_reuses, 1);
+  EXPECT_EQ(stats.bytes_in_use, 512);
+  EXPECT_EQ(stats.total_allocated_bytes, 1024 + 512);
+  EXPECT_EQ(stats.max_total_allocated_bytes, 1024 + 512);
+  EXPECT_GT(stats.Fragmentation(), 0.0);
+
+  ASSERT_TRUE(cuda_arena.Shrink().IsOK());
+  cuda_arena.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 512);
+  EXPECT_EQ(stats.Fragmentation(), 0.0);
+
+  cuda_arena.Free(cuda_addr_3);
+}
 }  // namespace test
 }  // namespace onnxruntime
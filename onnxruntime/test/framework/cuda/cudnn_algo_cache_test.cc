@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstdio>
+
+#include "gtest/gtest.h"
+#include "core/providers/cuda/cudnn_algo_cache.h"
+
+namespace onnxruntime {
+namespace test {
+
+// the entries of a device model survive a save and load, the entries of another model in the same file are kept
+TEST(CudnnAlgoCacheTest, SaveAndLoad) {
+  const std::basic_string<ORTCHAR_T> file_path = ORT_TSTR("cudnn_algo_cache_test.txt");
+  std::remove(ToMBString(file_path).c_str());
+
+  const auto key = cuda::CudnnAlgoCache::MakeKey("fwd", 0, {1, 3, 224, 224}, {64, 3, 7, 7},
+                                                 {3, 3, 3, 3}, {2, 2}, {1, 1}, 1);
+  {
+    cuda::CudnnAlgoCache cache_a("gpu a cudnn 7605");
+    cache_a.Insert(key, {1, 1024, 0});
+    ASSERT_TRUE(cache_a.Save(file_path).IsOK());
+
+    cuda::CudnnAlgoCache cache_b("gpu b cudnn 7605");
+    cache_b.Insert(key, {6, 4096, 1});
+    ASSERT_TRUE(cache_b.Save(file_path).IsOK());
+  }
+
+  cuda::CudnnAlgoCache cache_a("gpu a cudnn 7605");
+  ASSERT_TRUE(cache_a.Load(file_path).IsOK());
+  ASSERT_EQ(cache_a.Size(), 1u);
+  cuda::CudnnAlgoCache::Entry entry;
+  ASSERT_TRUE(cache_a.Lookup(key, entry));
+  EXPECT_EQ(entry.algo, 1);
+  EXPECT_EQ(entry.workspace_bytes, 1024);
+  EXPECT_EQ(entry.math_type, 0);
+
+  cuda::CudnnAlgoCache cache_b("gpu b cudnn 7605");
+  ASSERT_TRUE(cache_b.Load(file_path).IsOK());
+  ASSERT_TRUE(cache_b.Lookup(key, entry));
+  EXPECT_EQ(entry.algo, 6);
+
+  cuda::CudnnAlgoCache cache_c("gpu a cudnn 8000");
+  ASSERT_TRUE(cache_c.Load(file_path).IsOK());
+  EXPECT_EQ(cache_c.Size(), 0u);
+
+  std::remove(ToMBString(file_path).c_str());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
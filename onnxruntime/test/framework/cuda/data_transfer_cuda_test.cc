@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/allocatormgr.h"
+#include "test/framework/test_utils.h"
+#include "gtest/gtest.h"
+#include "core/providers/cuda/cuda_allocator.h"
+#include "core/providers/cuda/gpu_data_transfer.h"
+
+namespace onnxruntime {
+namespace test {
+
+// the copies from and to pageable host memory above the staging threshold span several staging chunks
+TEST(GPUDataTransferTest, StagedCopyRoundTrip) {
+  OrtDevice::DeviceId cuda_device_id = 0;
+  DeviceAllocatorRegistrationInfo default_memory_info(
+      {OrtMemTypeDefault,
+       [](OrtDevice::DeviceId id) { return onnxruntime::make_unique<CUDAAllocator>(id, CUDA); },
+       std::numeric_limits<size_t>::max()});
+  auto cuda_allocator = CreateAllocator(default_memory_info, cuda_device_id);
+  auto cpu_allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+
+  for (int64_t num_elements : {1000, 1 << 16, 3 * (1 << 20) + 7}) {
+    std::vector<int64_t> dims = {num_elements};
+    std::vector<float> values(static_cast<size_t>(num_elements));
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = static_cast<float>(i % 1000);
+    }
+
+    OrtValue cpu_value;
+    CreateMLValue<float>(cpu_allocator, dims, values, &cpu_value);
+    Tensor gpu_tensor(DataTypeImpl::GetType<float>(), TensorShape(dims), cuda_allocator);
+    Tensor cpu_result(DataTypeImpl::GetType<float>(), TensorShape(dims), cpu_allocator);
+
+    GPUDataTransfer data_transfer;
+    ASSERT_TRUE(data_transfer.CopyTensor(cpu_value.Get<Tensor>(), gpu_tensor, kCudaStreamDefault).IsOK());
+    ASSERT_TRUE(data_transfer.CopyTensor(gpu_tensor, cpu_result, kCudaStreamDefault).IsOK());
+
+    const float* result = cpu_result.Data<float>();
+    for (size_t i = 0; i < values.size(); ++i) {
+      ASSERT_EQ(values[i], result[i]) << "at " << i;
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
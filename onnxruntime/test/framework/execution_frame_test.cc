@@ -163,6 +163,64 @@ TEST_F(ExecutionFrameTest, FeedInDataTest) {
   EXPECT_EQ(p_tensor_arg_0->MutableData<float>(), value.GetMutable<Tensor>()->MutableData<float>());
 }
 
+TEST_F(ExecutionFrameTest, FramePoolReuseTest) {
+  onnxruntime::Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           std::unordered_map<std::string, int>{{"", 10}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def("X", &tensor_float), output_def("Y", &tensor_float);
+
+  graph.AddNode("node1", "Clip", "Clip operator", ArgMap{&input_def}, ArgMap{&output_def})
+      .SetExecutionProviderType(kCpuExecutionProvider);
+  graph.Resolve();
+  auto element_type = DataTypeImpl::GetType<float>();
+  TensorShape shape({3, 2});
+  std::vector<float> fdata1(static_cast<size_t>(shape.Size()));
+  std::vector<float> fdata2(static_cast<size_t>(shape.Size()));
+  OrtMemoryInfo cpuinfo(kCpuExecutionProvider, OrtDeviceAllocator);
+  OrtValue value1, value2;
+  value1.Init(new Tensor(element_type, shape, fdata1.data(), cpuinfo), DataTypeImpl::GetType<Tensor>(),
+              DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+  value2.Init(new Tensor(element_type, shape, fdata2.data(), cpuinfo), DataTypeImpl::GetType<Tensor>(),
+              DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_typ = cpu_xp->Type();
+
+  KernelRegistryManager kernel_registry_manager;
+  ExecutionProviders execution_providers;
+  execution_providers.Add(xp_typ, std::move(cpu_xp));
+  EXPECT_TRUE(kernel_registry_manager.RegisterKernels(execution_providers).IsOK());
+  SessionState state{execution_providers, true, &tp_, nullptr};
+  auto status = state.SetGraphAndCreateKernels(graph, kernel_registry_manager);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  const OrtValueNameIdxMap& mlvalue_name_idx_map = state.GetOrtValueNameIdxMap();
+  int x_idx, y_idx;
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("X", x_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("Y", y_idx).IsOK());
+
+  vector<OrtValue> outputs;
+  ExecutionFramePool& pool = state.GetExecutionFramePool();
+  const ExecutionFrame* first_frame = nullptr;
+  {
+    auto frame = pool.Acquire({x_idx}, {value1}, {y_idx}, outputs, {}, state);
+    first_frame = &*frame;
+    const OrtValue* p_ml_value = frame->GetMutableNodeInputOrOutputMLValue(0);
+    ASSERT_TRUE(p_ml_value);
+    EXPECT_EQ(p_ml_value->Get<Tensor>().Data<float>(), fdata1.data());
+  }
+
+  // the frame given back by the first run is reset with the feeds of the second one
+  auto frame = pool.Acquire({x_idx}, {value2}, {y_idx}, outputs, {}, state);
+  EXPECT_EQ(&*frame, first_frame);
+  const OrtValue* p_ml_value = frame->GetMutableNodeInputOrOutputMLValue(0);
+  ASSERT_TRUE(p_ml_value);
+  EXPECT_EQ(p_ml_value->Get<Tensor>().Data<float>(), fdata2.data());
+}
+
 TEST_F(ExecutionFrameTest, MemPatternTest) {
   auto cpu_xp = CreateCPUExecutionProvider();
   auto xp_type = cpu_xp->Type();
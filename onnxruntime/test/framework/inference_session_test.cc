@@ -8,12 +8,14 @@
 #include <functional>
 #include <iterator>
 #include <thread>
+#include <unordered_set>
 #include <fstream>
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include "core/common/logging/logging.h"
 #include "core/common/logging/sinks/clog_sink.h"
 #include "core/common/profiler.h"
+#include "core/framework/arena.h"
 #include "core/framework/compute_capability.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/execution_provider.h"
@@ -364,6 +366,176 @@ TEST(InferenceSessionTests, DisableCPUArena) {
   RunModel(session_object, run_options);
 }
 
+TEST(InferenceSessionTests, ShrinkMemoryArenasAfterRun) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.ShrinkMemoryArenasAfterRun";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "one session/one tag";
+  run_options.shrink_memory_arenas = true;
+  RunModel(session_object, run_options);
+  // the arenas must be usable again after being shrunk
+  RunModel(session_object, run_options);
+
+  ASSERT_TRUE(session_object.ShrinkMemoryArenas().IsOK());
+}
+
+TEST(InferenceSessionTests, MemoryArenaStatsAfterRun) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.MemoryArenaStatsAfterRun";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "one session/one tag";
+  RunModel(session_object, run_options);
+
+  AllocatorStats stats;
+  session_object.GetMemoryArenaStats(stats);
+  EXPECT_GT(stats.num_allocs, 0);
+  EXPECT_GT(stats.max_bytes_in_use, 0);
+  EXPECT_LE(stats.bytes_in_use, stats.total_allocated_bytes);
+  EXPECT_GT(stats.num_extends, 0);
+  EXPECT_LE(stats.largest_free_chunk, stats.total_allocated_bytes);
+}
+
+TEST(InferenceSessionTests, RunResultCache) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.RunResultCache";
+  so.run_result_cache_max_bytes = 1024 * 1024;
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  // the second run returns the outputs of the first one
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options);
+  auto stats = session_object.GetRunResultCacheStats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.num_entries, 1);
+  EXPECT_GT(stats.bytes, 0);
+
+  // the runs writing pre-allocated outputs aren't cached
+  RunModel(session_object, run_options, true);
+  stats = session_object.GetRunResultCacheStats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 1);
+
+  // the outputs which don't fit in the cache aren't kept
+  so.run_result_cache_max_bytes = 16;
+  InferenceSession small_session_object{so, GetEnvironment()};
+  ASSERT_TRUE(small_session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(small_session_object.Initialize().IsOK());
+  RunModel(small_session_object, run_options);
+  RunModel(small_session_object, run_options);
+  stats = small_session_object.GetRunResultCacheStats();
+  EXPECT_EQ(stats.hits, 0);
+  EXPECT_EQ(stats.misses, 2);
+  EXPECT_EQ(stats.num_entries, 0);
+}
+
+TEST(InferenceSessionTests, WarmUp) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.WarmUp";
+  so.run_result_cache_max_bytes = 1024 * 1024;
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  // the shape of X is the one of the model if it isn't given
+  ASSERT_STATUS_OK(session_object.WarmUp({}));
+  ASSERT_STATUS_OK(session_object.WarmUp({{"X", TensorShape({3, 2})}}));
+
+  // the warm-up runs aren't cached
+  auto stats = session_object.GetRunResultCacheStats();
+  EXPECT_EQ(stats.misses, 0);
+  EXPECT_EQ(stats.num_entries, 0);
+
+  auto status = session_object.WarmUp({{"X", TensorShape({2, 3})}});
+  EXPECT_EQ(status.Code(), common::INVALID_ARGUMENT);
+  status = session_object.WarmUp({{"Z", TensorShape({3, 2})}});
+  EXPECT_EQ(status.Code(), common::INVALID_ARGUMENT);
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+}
+
+TEST(InferenceSessionTests, RunStats) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.RunStats";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.collect_run_stats = true;
+  RunModel(session_object, run_options);
+
+  // Y is allocated by the run
+  const auto run_stats = run_options.run_stats;
+  EXPECT_EQ(run_stats.num_runs, 1);
+  EXPECT_GE(run_stats.num_allocations, 1);
+  EXPECT_GE(run_stats.bytes_allocated, static_cast<int64_t>(6 * sizeof(float)));
+  EXPECT_GE(run_stats.peak_bytes, static_cast<int64_t>(6 * sizeof(float)));
+  EXPECT_EQ(run_stats.bytes_copied, 0);
+
+  RunOptions run_options_no_stats;
+  RunModel(session_object, run_options_no_stats);
+  EXPECT_EQ(run_options_no_stats.run_stats.num_runs, 0);
+
+  const auto cumulative_stats = session_object.GetCumulativeRunStats();
+  EXPECT_EQ(cumulative_stats.num_runs, 2);
+  EXPECT_GE(cumulative_stats.num_allocations, 2 * run_stats.num_allocations);
+  EXPECT_EQ(cumulative_stats.peak_bytes, run_stats.peak_bytes);
+  EXPECT_LE(cumulative_stats.num_memory_pattern_hits, 2);
+}
+
+TEST(InferenceSessionTests, RunPastDeadline) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.RunPastDeadline";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims_mul_x, values_mul_x,
+                       &ml_value);
+  NameMLValMap feeds{{"X", ml_value}};
+  std::vector<OrtValue> fetches;
+
+  RunOptions run_options;
+  run_options.deadline = std::chrono::steady_clock::now();
+  auto status = session_object.Run(run_options, feeds, {"Y"}, &fetches);
+  EXPECT_FALSE(status.IsOK());
+  EXPECT_NE(status.ErrorMessage().find("deadline"), std::string::npos);
+
+  // a later deadline and a priority leave the Run as is
+  RunOptions run_options_in_time;
+  run_options_in_time.deadline = std::chrono::steady_clock::now() + std::chrono::hours(1);
+  run_options_in_time.priority = 1;
+  RunModel(session_object, run_options_in_time);
+}
+
 TEST(InferenceSessionTests, TestModelSerialization) {
   // Load model with level 0 transform level
   // and assert that the model has Identity nodes.
@@ -426,6 +598,249 @@ TEST(InferenceSessionTests, TestModelSerialization) {
   ASSERT_TRUE(session_object_emptyValidation.Initialize().IsOK());
 }
 
+TEST(InferenceSessionTests, TestSessionStateCache) {
+  SessionOptions so;
+  const string test_model = "testdata/transform/abs-id-max.onnx";
+  so.session_logid = "InferenceSessionTests.TestSessionStateCache";
+  so.graph_optimization_level = TransformerLevel::Level1;
+  const string cache_file = test_model + "-SessionStateCache";
+  so.session_state_cache_filepath = ToWideString(cache_file);
+  std::remove(cache_file.c_str());
+  std::remove((cache_file + ".data").c_str());
+
+  // the first session optimizes the model and writes the cache
+  InferenceSessionGetGraphWrapper session_object{so, GetEnvironment()};
+  ASSERT_TRUE(session_object.Load(test_model).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+  std::ifstream cache_fs(so.session_state_cache_filepath, ios::in | ios::binary);
+  ASSERT_TRUE(cache_fs.good());
+  std::ifstream cache_data_fs(cache_file + ".data", ios::in | ios::binary);
+  ASSERT_TRUE(cache_data_fs.good());
+
+  // the second one restores the optimized and partitioned graph from it
+  InferenceSessionGetGraphWrapper cached_session_object{so, GetEnvironment()};
+  ASSERT_TRUE(cached_session_object.Load(test_model).IsOK());
+  Status st = cached_session_object.Initialize();
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+
+  const auto& graph = cached_session_object.GetGraph();
+  ASSERT_EQ(CountOpsInGraph(graph), CountOpsInGraph(session_object.GetGraph()));
+  ASSERT_EQ(CountOpsInGraph(graph)["Identity"], 0);
+  for (const auto& node : graph.Nodes()) {
+    ASSERT_EQ(node.GetExecutionProviderType(), kCpuExecutionProvider);
+  }
+
+  // a cache created with other options is ignored and replaced
+  so.graph_optimization_level = TransformerLevel::Default;
+  InferenceSessionGetGraphWrapper noopt_session_object{so, GetEnvironment()};
+  ASSERT_TRUE(noopt_session_object.Load(test_model).IsOK());
+  ASSERT_TRUE(noopt_session_object.Initialize().IsOK());
+  ASSERT_GT(CountOpsInGraph(noopt_session_object.GetGraph())["Identity"], 0);
+}
+
+// Y = X * X, where X has the free dimension "batch"
+static std::string CreateSquareModelWithFreeDimension() {
+  onnxruntime::Model model("square", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  auto& x = graph.GetOrCreateNodeArg("X", &input_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+  graph.AddNode("square", "Mul", "", {&x, &x}, {&y});
+  ORT_ENFORCE(graph.Resolve().IsOK());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+  return model_data;
+}
+
+TEST(InferenceSessionTests, ShapeSpecializedVariants) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ShapeSpecializedVariants";
+  so.shape_specialization_max_variants = 1;
+  so.shape_specialization_min_runs = 2;
+
+  auto capturing_sink = new CapturingSink();
+  auto logging_manager = onnxruntime::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(capturing_sink), logging::Severity::kVERBOSE, false,
+      LoggingManager::InstanceType::Temporal);
+  std::unique_ptr<Environment> env;
+  ASSERT_TRUE(Environment::Create(std::move(logging_manager), env).IsOK());
+
+  const std::string model_data = CreateSquareModelWithFreeDimension();
+  InferenceSession session_object{so, *env};
+  ASSERT_TRUE(session_object.Load(model_data.data(), static_cast<int>(model_data.size())).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  // the variant for batch=3 is created by the second run, batch=1 is run by the generic graph as there's no slot
+  // left for it.
+  const std::vector<int64_t> batches{3, 3, 3, 1, 1, 1, 3};
+  for (auto batch : batches) {
+    std::vector<int64_t> dims{batch, 2};
+    std::vector<float> values;
+    std::vector<float> expected_values;
+    for (int64_t i = 0; i < batch * 2; ++i) {
+      values.push_back(static_cast<float>(i) - 1.0f);
+      expected_values.push_back(values.back() * values.back());
+    }
+
+    OrtValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims, values, &ml_value);
+    NameMLValMap feeds{{"X", ml_value}};
+    std::vector<OrtValue> fetches;
+    Status st = session_object.Run(RunOptions{}, feeds, {"Y"}, &fetches);
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+    VerifyOutputs(fetches, dims, expected_values);
+  }
+
+  const auto& msgs = capturing_sink->Messages();
+  auto num_variants = std::count_if(msgs.begin(), msgs.end(), [](const std::string& msg) {
+    return msg.find("Created the shape-specialized variant for batch=3;") != std::string::npos;
+  });
+  ASSERT_EQ(num_variants, 1);
+}
+
+// S_out = S_in + X, Y = -S_out
+static std::string CreateAccumulatorModel() {
+  onnxruntime::Model model("accumulator", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  auto& x = graph.GetOrCreateNodeArg("X", &input_type);
+  auto& s_in = graph.GetOrCreateNodeArg("S_in", &input_type);
+  auto& s_out = graph.GetOrCreateNodeArg("S_out", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+  graph.AddNode("accumulate", "Add", "", {&s_in, &x}, {&s_out});
+  graph.AddNode("negate", "Neg", "", {&s_out}, {&y});
+  ORT_ENFORCE(graph.Resolve().IsOK());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+  return model_data;
+}
+
+TEST(InferenceSessionTests, StateStreams) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.StateStreams";
+  so.state_bindings.emplace_back("S_out", "S_in");
+
+  const std::string model_data = CreateAccumulatorModel();
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_TRUE(session_object.Load(model_data.data(), static_cast<int>(model_data.size())).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  auto run = [&](int64_t stream_id, const std::vector<float>& x, const std::vector<float>* s_in,
+                 const std::vector<float>& expected_y) {
+    OrtValue x_value;
+    CreateMLValue<float>(allocator, {2}, x, &x_value);
+    NameMLValMap feeds{{"X", x_value}};
+    if (s_in != nullptr) {
+      OrtValue s_value;
+      CreateMLValue<float>(allocator, {2}, *s_in, &s_value);
+      feeds.emplace("S_in", s_value);
+    }
+
+    RunOptions run_options;
+    run_options.state_stream_id = stream_id;
+    std::vector<OrtValue> fetches;
+    Status st = session_object.Run(run_options, feeds, {"Y"}, &fetches);
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+    VerifyOutputs(fetches, {2}, expected_y);
+  };
+
+  // the state of each stream starts from the fed S_in and accumulates X across the Run calls
+  const std::vector<float> zeros{0.0f, 0.0f};
+  const std::vector<float> tens{10.0f, 20.0f};
+  run(0, {1.0f, 2.0f}, &zeros, {-1.0f, -2.0f});
+  run(1, {1.0f, 1.0f}, &tens, {-11.0f, -21.0f});
+  run(0, {1.0f, 2.0f}, nullptr, {-2.0f, -4.0f});
+  run(0, {1.0f, 2.0f}, nullptr, {-3.0f, -6.0f});
+  run(1, {1.0f, 1.0f}, nullptr, {-12.0f, -22.0f});
+
+  // feeding S_in resets the state
+  run(0, {1.0f, 2.0f}, &tens, {-11.0f, -22.0f});
+  run(0, {1.0f, 2.0f}, nullptr, {-12.0f, -24.0f});
+
+  // a released stream has no state, so S_in must be fed again
+  session_object.ReleaseStateStream(0);
+  OrtValue x_value;
+  CreateMLValue<float>(allocator, {2}, std::vector<float>{1.0f, 2.0f}, &x_value);
+  RunOptions run_options;
+  run_options.state_stream_id = 0;
+  std::vector<OrtValue> fetches;
+  ASSERT_FALSE(session_object.Run(run_options, NameMLValMap{{"X", x_value}}, {"Y"}, &fetches).IsOK());
+  run(1, {1.0f, 1.0f}, nullptr, {-13.0f, -23.0f});
+}
+
+TEST(InferenceSessionTests, InvalidStateBinding) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.InvalidStateBinding";
+  so.state_bindings.emplace_back("S", "S_in");
+
+  const std::string model_data = CreateAccumulatorModel();
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_TRUE(session_object.Load(model_data.data(), static_cast<int>(model_data.size())).IsOK());
+  Status st = session_object.Initialize();
+  ASSERT_FALSE(st.IsOK());
+  EXPECT_NE(st.ErrorMessage().find("must bind an output of the model to one of its inputs"), std::string::npos);
+}
+
+// The outputs of a Split with a leading dim of 1 are views of the input. Their consumers may alias or update their
+// input in-place, which must not write to the buffer of the Split input.
+TEST(InferenceSessionTests, SplitOutputViews) {
+  onnxruntime::Model model("split_views", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(6);
+  auto& x = graph.GetOrCreateNodeArg("X", &input_type);
+  auto& a = graph.GetOrCreateNodeArg("A", nullptr);
+  auto& b = graph.GetOrCreateNodeArg("B", nullptr);
+  auto& c = graph.GetOrCreateNodeArg("C", nullptr);
+  auto& r = graph.GetOrCreateNodeArg("R", nullptr);
+  auto& sum = graph.GetOrCreateNodeArg("S", nullptr);
+  auto& y1 = graph.GetOrCreateNodeArg("Y1", nullptr);
+  auto& y2 = graph.GetOrCreateNodeArg("Y2", nullptr);
+  auto& split = graph.AddNode("split", "Split", "", {&x}, {&a, &b});
+  split.AddAttribute("axis", int64_t{1});
+  split.AddAttribute("split", std::vector<int64_t>{2, 4});
+  graph.AddNode("identity", "Identity", "", {&a}, {&c});
+  graph.AddNode("neg", "Neg", "", {&c}, {&y1});
+  graph.AddNode("relu", "Relu", "", {&b}, {&r});
+  graph.AddNode("add", "Add", "", {&b, &r}, {&sum});
+  graph.AddNode("neg2", "Neg", "", {&sum}, {&y2});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.SplitOutputViews";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_TRUE(session_object.Load(model_data.data(), static_cast<int>(model_data.size())).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  OrtValue x_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 6},
+                       {1.0f, -2.0f, 3.0f, -4.0f, 5.0f, -6.0f}, &x_value);
+  // a write to X through one of the views would change the results of the second run
+  std::vector<OrtValue> fetches;
+  for (int i = 0; i < 2; ++i) {
+    Status st = session_object.Run(NameMLValMap{{"X", x_value}}, {"Y1", "Y2"}, &fetches);
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+    VerifyOutputs(fetches[0].Get<Tensor>(), {1, 2}, {-1.0f, 2.0f});
+    VerifyOutputs(fetches[1].Get<Tensor>(), {1, 4}, {-6.0f, 4.0f, -10.0f, 6.0f});
+  }
+}
+
 #ifdef ORT_RUN_EXTERNAL_ONNX_TESTS
 static bool Compare(const InputDefList& f_arg, const InputDefList& s_arg) {
   if (f_arg.size() != s_arg.size()) {
@@ -573,24 +988,77 @@ TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
   ASSERT_TRUE(profile);
   std::string line;
 
-  std::vector<std::string> tags = {"pid", "dur", "ts", "ph", "X", "name", "args"};
-  int count = 0;
+  std::vector<std::string> lines;
   while (std::getline(profile, line)) {
-    if (count == 0) {
-      ASSERT_TRUE(line.find("[") != string::npos);
-    } else if (count <= 7) {
-      for (auto& s : tags) {
-        ASSERT_TRUE(line.find(s) != string::npos);
-      }
-    } else {
-      ASSERT_TRUE(line.find("]") != string::npos);
+    lines.push_back(line);
+  }
+  ASSERT_GT(lines.size(), 2u);
+  ASSERT_TRUE(lines.front().find("[") != string::npos);
+  ASSERT_TRUE(lines.back().find("]") != string::npos);
+
+  std::vector<std::string> tags = {"pid", "dur", "ts", "ph", "X", "name", "args"};
+  // the steps of the session initialization are recorded separately
+  std::unordered_set<std::string> session_events = {"model_protobuf_parsing", "graph_building", "model_loading_uri",
+                                                    "graph_partitioning", "graph_resolve", "allocation_planning",
+                                                    "initializer_loading", "kernel_creation", "session_initialization"};
+  bool has_kernel_cost = false;
+  for (size_t i = 1; i + 1 < lines.size(); ++i) {
+    for (auto& s : tags) {
+      ASSERT_TRUE(lines[i].find(s) != string::npos);
+    }
+    for (auto it = session_events.begin(); it != session_events.end();) {
+      it = lines[i].find(R"("name" :")" + *it + "\"") != string::npos ? session_events.erase(it) : std::next(it);
     }
+    // the cost model of Mul: an operation per output element, reading X and W and writing Y, all [3, 2] floats
+    if (lines[i].find("mul_1_kernel_time") != string::npos) {
+      has_kernel_cost = true;
+      EXPECT_NE(lines[i].find(R"("flops" : "6")"), string::npos);
+      EXPECT_NE(lines[i].find(R"("bytes" : "72")"), string::npos);
+    }
+  }
+  EXPECT_TRUE(session_events.empty()) << "missing event " << *session_events.begin();
+  EXPECT_TRUE(has_kernel_cost);
+}
 
-    if (count == 1) {
-      ASSERT_TRUE(line.find("model_loading_uri") != string::npos);
+TEST(InferenceSessionTests, CheckRunProfilerWithMemoryProfiling) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfilerWithMemoryProfiling";
+  so.enable_profiling = true;
+  so.enable_memory_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_memory_profile_test");
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  bool has_alloc = false;
+  bool has_counter = false;
+  while (std::getline(profile, line)) {
+    if (line.find(R"("cat" : "Memory")") == string::npos) {
+      continue;
+    }
+    // the output Y of mul_1 is allocated by the frame from the CPU arena
+    if (line.find(R"("name" :"memory_alloc")") != string::npos && line.find(R"("value" : "Y")") != string::npos) {
+      has_alloc = true;
+      EXPECT_NE(line.find(R"("ph" : "i")"), string::npos);
+      EXPECT_NE(line.find(R"("node" : "mul_1")"), string::npos);
+      EXPECT_NE(line.find(R"("arena_in_use_bytes" : ")"), string::npos);
+    }
+    if (line.find(R"("ph" : "C")") != string::npos) {
+      has_counter = true;
+      EXPECT_NE(line.find(R"("frame_in_use_bytes" : )"), string::npos);
     }
-    count++;
   }
+  EXPECT_TRUE(has_alloc);
+  EXPECT_TRUE(has_counter);
 }
 
 TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
@@ -632,6 +1100,148 @@ TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
   }
 }
 
+TEST(InferenceSessionTests, CheckRunProfilerWithSampling) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfilerWithSampling";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_sampling_test");
+  so.profiling_sampling_interval = 2;
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  for (int i = 0; i < 4; ++i) {
+    RunModel(session_object, run_options);
+  }
+
+  // the node events of 1 in 2 executions are aggregated, while the session events are recorded for every run
+  auto histograms = session_object.GetProfilingHistograms();
+  ASSERT_EQ(histograms.count("mul_1_kernel_time"), 1u);
+  const auto& kernel_time = histograms["mul_1_kernel_time"];
+  EXPECT_EQ(kernel_time.count, 2u);
+  uint64_t bucket_total = 0;
+  for (auto bucket_count : kernel_time.buckets) {
+    bucket_total += bucket_count;
+  }
+  EXPECT_EQ(bucket_total, 2u);
+  EXPECT_LE(kernel_time.max_us, kernel_time.total_us);
+  ASSERT_EQ(histograms.count("model_run"), 1u);
+  EXPECT_EQ(histograms["model_run"].count, 4u);
+
+  std::string profile_file = session_object.EndProfiling();
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string contents((std::istreambuf_iterator<char>(profile)), std::istreambuf_iterator<char>());
+  EXPECT_NE(contents.find(R"({"name" :"mul_1_kernel_time","count" :2,)"), string::npos);
+}
+
+TEST(InferenceSessionTests, CheckOpStats) {
+  SessionOptions so;
+
+  so.session_logid = "CheckOpStats";
+  so.enable_op_stats = true;
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  // the node is listed before it runs
+  auto node_stats = session_object.GetOpStats(false);
+  ASSERT_EQ(node_stats.size(), 1u);
+  EXPECT_EQ(node_stats[0].name, "mul_1");
+  EXPECT_EQ(node_stats[0].num_calls, 0);
+
+  RunOptions run_options;
+  for (int i = 0; i < 3; ++i) {
+    RunModel(session_object, run_options);
+  }
+
+  // X and W are read and Y is written, all [3, 2] floats
+  node_stats = session_object.GetOpStats(false);
+  ASSERT_EQ(node_stats.size(), 1u);
+  const auto& mul_stats = node_stats[0];
+  EXPECT_EQ(mul_stats.op_type, "Mul");
+  EXPECT_EQ(mul_stats.num_calls, 3);
+  EXPECT_EQ(mul_stats.bytes_read, 3 * 2 * 6 * static_cast<int64_t>(sizeof(float)));
+  EXPECT_EQ(mul_stats.bytes_written, 3 * 6 * static_cast<int64_t>(sizeof(float)));
+  EXPECT_EQ(mul_stats.flops, 3 * 6);
+  EXPECT_LE(mul_stats.min_time_us, mul_stats.max_time_us);
+  EXPECT_LE(mul_stats.p99_time_us, mul_stats.max_time_us);
+  EXPECT_LE(mul_stats.max_time_us, mul_stats.total_time_us);
+
+  auto op_type_stats = session_object.GetOpStats(true);
+  ASSERT_EQ(op_type_stats.size(), 1u);
+  EXPECT_EQ(op_type_stats[0].name, "Mul");
+  EXPECT_EQ(op_type_stats[0].num_calls, 3);
+  EXPECT_EQ(op_type_stats[0].bytes_read, mul_stats.bytes_read);
+
+  SessionOptions so_disabled;
+  InferenceSession session_without_stats(so_disabled, GetEnvironment());
+  ASSERT_TRUE(session_without_stats.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_without_stats.Initialize().IsOK());
+  EXPECT_TRUE(session_without_stats.GetOpStats(false).empty());
+}
+
+// Reports a device event for each node it was correlated with.
+class FakeDeviceProfiler : public profiling::DeviceProfiler {
+ public:
+  void Start(TimePoint /*profiling_start_time*/) override {}
+  void PushCorrelation(uint64_t correlation_id) override { correlation_ids_.push_back(correlation_id); }
+  void PopCorrelation() override {}
+  std::vector<std::pair<uint64_t, profiling::EventRecord>> Stop() override {
+    std::vector<std::pair<uint64_t, profiling::EventRecord>> events;
+    for (auto correlation_id : correlation_ids_) {
+      events.emplace_back(correlation_id, profiling::EventRecord(profiling::DEVICE_EVENT, 0, 0, "fake_kernel", 0, 1,
+                                                                 {{"stream", "0"}}));
+    }
+    return events;
+  }
+
+ private:
+  std::vector<uint64_t> correlation_ids_;
+};
+
+class DeviceProfilingExecutionProvider : public CPUExecutionProvider {
+ public:
+  DeviceProfilingExecutionProvider() : CPUExecutionProvider(CPUExecutionProviderInfo()) {}
+  std::unique_ptr<profiling::DeviceProfiler> GetProfiler() override {
+    return onnxruntime::make_unique<FakeDeviceProfiler>();
+  }
+};
+
+TEST(InferenceSessionTests, CheckRunProfilerWithDeviceProfiler) {
+  SessionOptions so;
+  so.session_logid = "CheckRunProfilerWithDeviceProfiler";
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(
+      session_object.RegisterExecutionProvider(onnxruntime::make_unique<DeviceProfilingExecutionProvider>()));
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  session_object.StartProfiling("onnxruntime_profile_device");
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  std::string line;
+  bool has_device_event = false;
+  while (std::getline(profile, line)) {
+    if (line.find("fake_kernel") != string::npos) {
+      ASSERT_TRUE(line.find("\"Device\"") != string::npos);
+      ASSERT_TRUE(line.find("\"node_name\" : \"mul_1\"") != string::npos);
+      has_device_event = true;
+    }
+  }
+  ASSERT_TRUE(has_device_event);
+}
+
 TEST(InferenceSessionTests, MultipleSessionsNoTimeout) {
   SessionOptions session_options;
 
@@ -911,6 +1521,90 @@ TEST(InferenceSessionTests, TestBindCudaPreallocateOutputOnCpu2) {
                  kCpuExecutionProvider);
 }
 
+TEST(InferenceSessionTests, ReplayCudaGraph) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.ReplayCudaGraph";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  CUDAExecutionProviderInfo epi;
+  epi.device_id = 0;
+  epi.enable_cuda_graph = true;
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(onnxruntime::make_unique<CUDAExecutionProvider>(epi)));
+
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kCudaExecutionProvider);
+  std::string s1;
+  p_model->ToProto().SerializeToString(&s1);
+  std::stringstream sstr(s1);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding));
+
+  // the bound inputs are copied to the device once, so every Run reads the same device buffers
+  std::vector<float> values_mul_x = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f};
+  auto cpu_allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  OrtValue input_ml_value_A;
+  CreateMLValue<float>(cpu_allocator, {3, 4}, values_mul_x, &input_ml_value_A);
+  OrtValue input_ml_value_B;
+  CreateMLValue<float>(cpu_allocator, {4, 3}, values_mul_x, &input_ml_value_B);
+  ASSERT_STATUS_OK(io_binding->BindInput("A", input_ml_value_A));
+  ASSERT_STATUS_OK(io_binding->BindInput("B", input_ml_value_B));
+
+  std::vector<int64_t> expected_output_dims = {3, 3};
+  OrtValue output_ml_value;
+  AllocateMLValue<float>(TestCudaExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), expected_output_dims,
+                         &output_ml_value);
+  ASSERT_STATUS_OK(io_binding->BindOutput("Y", output_ml_value));
+  ASSERT_STATUS_OK(io_binding->SynchronizeInputs());
+
+  // warm up, record and replay
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_STATUS_OK(session_object.Run(run_options, *io_binding.get()));
+  }
+
+  auto& rtensor = io_binding->GetOutputs().front().Get<Tensor>();
+  std::unique_ptr<Tensor> cpu_tensor = onnxruntime::make_unique<Tensor>(rtensor.DataType(), rtensor.Shape(),
+                                                                        cpu_allocator);
+  ASSERT_STATUS_OK(GPUDataTransfer().CopyTensor(rtensor, *cpu_tensor.get(), 0));
+  OrtValue ml_value;
+  ml_value.Init(cpu_tensor.release(),
+                DataTypeImpl::GetType<Tensor>(),
+                DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+  std::vector<float> expected_values_mul_y = {42, 48, 54, 114, 136, 158, 186, 224, 262};
+  VerifyOutputs({ml_value}, expected_output_dims, expected_values_mul_y);
+}
+
+TEST(InferenceSessionTests, RunWithUserComputeStream) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.RunWithUserComputeStream";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  CUDAExecutionProviderInfo epi;
+  epi.device_id = 0;
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(onnxruntime::make_unique<CUDAExecutionProvider>(epi)));
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  cudaStream_t stream = nullptr;
+  ASSERT_EQ(cudaSuccess, cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  run_options.compute_stream = stream;
+  RunModel(session_object, run_options);
+  // the stream must stay usable across Run calls
+  RunModel(session_object, run_options);
+
+  ASSERT_EQ(cudaSuccess, cudaStreamSynchronize(stream));
+  ASSERT_EQ(cudaSuccess, cudaStreamDestroy(stream));
+}
+
 #endif
 
 TEST(InferenceSessionTests, ModelWithoutOpset) {
@@ -1873,7 +2567,7 @@ TEST(InferenceSessionTests, CheckIfGlobalThreadPoolsAreBeingUsed) {
       LoggingManager::InstanceType::Temporal);
 
   std::unique_ptr<Environment> env;
-  ThreadingOptions tp_options{0, 0};
+  ThreadingOptions tp_options{};
   auto st = Environment::Create(std::move(logging_manager), env, &tp_options, true /*create_global_thread_pools*/);
   ASSERT_TRUE(st.IsOK());
 
@@ -1911,7 +2605,7 @@ TEST(InferenceSessionTests, CheckIfPerSessionThreadPoolsAreBeingUsed2) {
       LoggingManager::InstanceType::Temporal);
 
   std::unique_ptr<Environment> env;
-  ThreadingOptions tp_options{0, 0};
+  ThreadingOptions tp_options{};
   auto st = Environment::Create(std::move(logging_manager), env, &tp_options, true /*create_global_thread_pools*/);
   ASSERT_TRUE(st.IsOK());
 
@@ -1972,5 +2666,55 @@ TEST(InferenceSessionTests, InvalidSessionEnvCombination) {
   }
 }
 
+// Sessions created with use_env_allocators share the CPU arena registered on the env.
+// The CPU execution provider only uses an arena in these builds.
+#if !defined(USE_JEMALLOC) && (defined(__amd64__) || defined(_M_AMD64))
+TEST(InferenceSessionTests, CheckIfEnvAllocatorsAreBeingUsed) {
+  auto logging_manager = onnxruntime::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(new CLogSink()), logging::Severity::kVERBOSE, false,
+      LoggingManager::InstanceType::Temporal);
+
+  std::unique_ptr<Environment> env;
+  auto st = Environment::Create(std::move(logging_manager), env);
+  ASSERT_TRUE(st.IsOK());
+
+  DeviceAllocatorRegistrationInfo device_info{OrtMemTypeDefault,
+                                              [](int) { return onnxruntime::make_unique<TAllocator>(); },
+                                              std::numeric_limits<size_t>::max()};
+  AllocatorPtr shared_allocator = CreateAllocator(device_info);
+  ASSERT_TRUE(env->RegisterAllocator(shared_allocator).IsOK());
+  // registering a second allocator for the same device fails
+  ASSERT_FALSE(env->RegisterAllocator(CreateAllocator(device_info)).IsOK());
+
+  SessionOptions so;
+  so.session_logid = "CheckIfEnvAllocatorsAreBeingUsed";
+  so.use_env_allocators = true;
+
+  InferenceSessionTestGlobalThreadPools session_object_1{so, *env.get()};
+  ASSERT_TRUE(session_object_1.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object_1.Initialize().IsOK());
+
+  InferenceSessionTestGlobalThreadPools session_object_2{so, *env.get()};
+  ASSERT_TRUE(session_object_2.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object_2.Initialize().IsOK());
+
+  const auto& info = shared_allocator->Info();
+  ASSERT_EQ(session_object_1.GetSessionState().GetExecutionProviders().GetAllocator(info), shared_allocator);
+  ASSERT_EQ(session_object_2.GetSessionState().GetExecutionProviders().GetAllocator(info), shared_allocator);
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+  RunModel(session_object_1, run_options);
+  RunModel(session_object_2, run_options);
+
+  // without the option the session builds its own arena
+  so.use_env_allocators = false;
+  InferenceSessionTestGlobalThreadPools session_object_3{so, *env.get()};
+  ASSERT_TRUE(session_object_3.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object_3.Initialize().IsOK());
+  ASSERT_NE(session_object_3.GetSessionState().GetExecutionProviders().GetAllocator(info), shared_allocator);
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -292,6 +292,72 @@ TEST(TransformerTest, TestCopyNodeInsertionInitializerInSubgraph) {
   EXPECT_TRUE(modified);
 }
 
+TEST(TransformerTest, MemcpyTransformerPinsShapeComputationToHost) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 7;
+  auto model = std::make_shared<onnxruntime::Model>("test", false, ModelMetaData(), PathString(),
+                                                    IOnnxRuntimeOpSchemaRegistryList(),
+                                                    domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                                    DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model->MainGraph();
+
+  TensorProto indices;
+  indices.set_name("indices");
+  indices.add_dims(2);
+  indices.add_int64_data(1);
+  indices.add_int64_data(0);
+  indices.set_data_type(TensorProto_DataType_INT64);
+  graph.AddInitializedTensor(indices);
+
+  TypeProto tensor_float_type;
+  tensor_float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  TypeProto tensor_int64_type;
+  tensor_int64_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  onnxruntime::NodeArg i1_def("I1", &tensor_float_type),
+      shape_def("shape", &tensor_int64_type),
+      new_shape_def("new_shape", &tensor_int64_type),
+      o1_def("O1", &tensor_float_type);
+
+  // Shape writes its output to the host, and Reshape reads the shape from the host: the Gather between them
+  // shouldn't copy the shape to the device and back
+  auto& shape_node = graph.AddNode("shape", "Shape", "gpu shape", ArgMap{&i1_def}, ArgMap{&shape_def});
+  shape_node.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+  auto& gather_node = graph.AddNode("gather", "Gather", "gpu gather",
+                                    ArgMap{&shape_def, &graph.GetOrCreateNodeArg("indices", &tensor_int64_type)},
+                                    ArgMap{&new_shape_def});
+  gather_node.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+  auto& reshape_node = graph.AddNode("reshape", "Reshape", "gpu reshape", ArgMap{&i1_def, &new_shape_def},
+                                     ArgMap{&o1_def});
+  reshape_node.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  ExecutionProviders execution_providers;
+  execution_providers.Add(onnxruntime::kCudaExecutionProvider,
+                          onnxruntime::make_unique<CUDAExecutionProvider>(CUDAExecutionProviderInfo()));
+  execution_providers.Add(onnxruntime::kCpuExecutionProvider,
+                          onnxruntime::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo()));
+  KernelRegistryManager test_registry_manager;
+  test_registry_manager.RegisterKernels(execution_providers);
+
+  MemcpyTransformer transformer({onnxruntime::kCudaExecutionProvider}, test_registry_manager);
+
+  bool modified = false;
+  status = transformer.Apply(graph, modified, DefaultLoggingManager().DefaultLogger());
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  EXPECT_TRUE(modified);
+
+  EXPECT_EQ(gather_node.GetExecutionProviderType(), onnxruntime::kCpuExecutionProvider);
+  EXPECT_EQ(reshape_node.GetExecutionProviderType(), onnxruntime::kCudaExecutionProvider);
+  ExpectSame(shape_node, gather_node, 0);
+  ExpectSame(gather_node, reshape_node, 1);
+  for (const auto& node : graph.Nodes()) {
+    EXPECT_NE(node.OpType(), "MemcpyToHost");
+    EXPECT_NE(node.OpType(), "MemcpyFromHost");
+  }
+}
+
 #endif
 
 }  // namespace test
@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/packed_strings.h"
+#include "test_utils.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(PackedStringsTest, AppendAndCopyTo) {
+  auto alloc = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  PackedStrings strings(alloc, 1, 4);
+
+  // grows past the hints
+  const std::vector<std::string> expected{"a", "", "a longer string than the small string buffer", "bc", ""};
+  for (const auto& s : expected) {
+    strings.Append(s);
+  }
+  ASSERT_EQ(strings.Size(), expected.size());
+  EXPECT_EQ(strings.NumBytes(), 47u);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(strings[i].ToString(), expected[i]);
+    EXPECT_TRUE(strings[i] == PackedStrings::View(expected[i]));
+  }
+
+  Tensor tensor(DataTypeImpl::GetType<std::string>(), TensorShape({5}), alloc);
+  ASSERT_TRUE(strings.CopyTo(tensor).IsOK());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(tensor.Data<std::string>()[i], expected[i]);
+  }
+
+  Tensor too_small(DataTypeImpl::GetType<std::string>(), TensorShape({4}), alloc);
+  EXPECT_FALSE(strings.CopyTo(too_small).IsOK());
+
+  strings.Clear();
+  EXPECT_EQ(strings.Size(), 0u);
+  strings.AppendTensor(tensor);
+  ASSERT_EQ(strings.Size(), expected.size());
+  EXPECT_EQ(strings[2].ToString(), expected[2]);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
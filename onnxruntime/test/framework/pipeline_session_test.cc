@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/pipeline_session.h"
+
+#include "core/graph/model.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "core/session/inference_session.h"
+#include "gtest/gtest.h"
+#include "test_utils.h"
+#include "test/test_environment.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Y = Relu(Relu(Relu(X * W0) * W1) * W2), with X [4, 8] and each W [8, 8]
+ModelProto CreateMatMulChainModel() {
+  onnxruntime::Model model("matmul_chain", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(8);
+
+  NodeArg* input_arg = &graph.GetOrCreateNodeArg("X", &float_tensor);
+  for (int i = 0; i < 3; ++i) {
+    const std::string suffix = std::to_string(i);
+    TensorProto weights;
+    weights.set_name("W" + suffix);
+    weights.set_data_type(TensorProto_DataType_FLOAT);
+    weights.add_dims(8);
+    weights.add_dims(8);
+    for (int j = 0; j < 64; ++j) {
+      weights.add_float_data(static_cast<float>((j * 7 + i * 3) % 11 - 4) * 0.1f);
+    }
+    graph.AddInitializedTensor(weights);
+
+    auto& weights_arg = graph.GetOrCreateNodeArg("W" + suffix, nullptr);
+    auto& matmul_arg = graph.GetOrCreateNodeArg("MatMul" + suffix, &float_tensor);
+    auto& relu_arg = graph.GetOrCreateNodeArg(i == 2 ? "Y" : "Relu" + suffix, &float_tensor);
+    graph.AddNode("matmul" + suffix, "MatMul", "", {input_arg, &weights_arg}, {&matmul_arg});
+    graph.AddNode("relu" + suffix, "Relu", "", {&matmul_arg}, {&relu_arg});
+    input_arg = &relu_arg;
+  }
+
+  EXPECT_TRUE(graph.Resolve().IsOK());
+  return model.ToProto();
+}
+
+std::vector<float> RunModel(InferenceSession& session, const NameMLValMap& feeds) {
+  std::vector<OrtValue> fetches;
+  EXPECT_TRUE(session.Run(RunOptions{}, feeds, {"Y"}, &fetches).IsOK());
+  const auto& tensor = fetches[0].Get<Tensor>();
+  return std::vector<float>(tensor.Data<float>(), tensor.Data<float>() + tensor.Shape().Size());
+}
+
+}  // namespace
+
+// The model is split into a stage per weight and the micro-batches give the same outputs as one session.
+TEST(PipelineSessionTest, ThreeStagesMatchInferenceSession) {
+  const auto model_proto = CreateMatMulChainModel();
+
+  std::vector<float> x_values(32);
+  for (size_t i = 0; i < x_values.size(); ++i) {
+    x_values[i] = static_cast<float>(i % 5) - 2.f;
+  }
+  OrtValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {4, 8}, x_values, &x);
+  NameMLValMap feeds{{"X", x}};
+
+  std::string model_data;
+  ASSERT_TRUE(model_proto.SerializeToString(&model_data));
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  ASSERT_TRUE(session.Load(model_data.data(), static_cast<int>(model_data.size())).IsOK());
+  ASSERT_TRUE(session.Initialize().IsOK());
+  const auto expected = RunModel(session, feeds);
+
+  PipelineSessionOptions pipeline_options;
+  pipeline_options.device_ids = {0, 0, 0};
+  // one 8x8 float weight per stage
+  pipeline_options.device_memory_budget = 8 * 8 * sizeof(float);
+  pipeline_options.num_micro_batches = 2;
+  PipelineSession pipeline{so, GetEnvironment(), pipeline_options, [](int) {
+                             return onnxruntime::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+                           }};
+  ASSERT_TRUE(pipeline.Load(model_proto).IsOK());
+  ASSERT_TRUE(pipeline.Initialize().IsOK());
+  ASSERT_EQ(pipeline.NumStages(), 3u);
+  EXPECT_EQ(pipeline.GetStageInputs(1), std::vector<std::string>{"Relu0"});
+  EXPECT_EQ(pipeline.GetStageOutputs(2), std::vector<std::string>{"Y"});
+
+  std::vector<OrtValue> fetches;
+  auto status = pipeline.Run(RunOptions{}, feeds, {"Y"}, &fetches);
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  const auto& y = fetches[0].Get<Tensor>();
+  ASSERT_EQ(y.Shape(), TensorShape({4, 8}));
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(y.Data<float>()[i], expected[i], 1e-5f);
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/run_scheduler.h"
+
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(RunSchedulerTest, NoRunOnThread) {
+  bool terminate = false;
+  EXPECT_TRUE(RunScheduler::BeforeNode(terminate).IsOK());
+}
+
+TEST(RunSchedulerTest, PastDeadline) {
+  RunOptions run_options;
+  run_options.deadline = std::chrono::steady_clock::now() - std::chrono::milliseconds(1);
+  bool terminate = false;
+  {
+    RunScheduler::ScopedRun run(run_options, false);
+    const auto status = RunScheduler::BeforeNode(terminate);
+    EXPECT_FALSE(status.IsOK());
+    EXPECT_NE(status.ErrorMessage().find("deadline"), std::string::npos);
+  }
+  // the Run of the thread ended with its scope
+  EXPECT_TRUE(RunScheduler::BeforeNode(terminate).IsOK());
+}
+
+TEST(RunSchedulerTest, LowerPriorityWaitsForHigherPriority) {
+  RunOptions high_priority;
+  high_priority.priority = 1;
+  RunOptions low_priority;
+
+  std::atomic<bool> high_priority_ended{false};
+  bool waited = false;
+  auto high_priority_run = onnxruntime::make_unique<RunScheduler::ScopedRun>(high_priority, true);
+  std::thread low_priority_thread([&]() {
+    RunScheduler::ScopedRun run(low_priority, true);
+    bool terminate = false;
+    EXPECT_TRUE(RunScheduler::BeforeNode(terminate).IsOK());
+    waited = high_priority_ended;
+  });
+
+  // a Run of a higher priority than the others doesn't wait
+  bool terminate = false;
+  EXPECT_TRUE(RunScheduler::BeforeNode(terminate).IsOK());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  high_priority_ended = true;
+  high_priority_run.reset();
+  low_priority_thread.join();
+  EXPECT_TRUE(waited);
+}
+
+TEST(RunSchedulerTest, TerminateWhileWaiting) {
+  RunOptions high_priority;
+  high_priority.priority = 1;
+  RunOptions low_priority;
+  bool terminate = false;
+
+  RunScheduler::ScopedRun high_priority_run(high_priority, true);
+  std::thread low_priority_thread([&]() {
+    RunScheduler::ScopedRun run(low_priority, true);
+    // returns while the Run of higher priority is still in progress, for the executor to check the flag
+    EXPECT_TRUE(RunScheduler::BeforeNode(terminate).IsOK());
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  terminate = true;
+  low_priority_thread.join();
+}
+
+TEST(RunSchedulerTest, OwnThreadPoolsDontWait) {
+  RunOptions high_priority;
+  high_priority.priority = 1;
+  RunOptions low_priority;
+
+  RunScheduler::ScopedRun high_priority_run(high_priority, true);
+  std::thread low_priority_thread([&]() {
+    RunScheduler::ScopedRun run(low_priority, false);
+    bool terminate = false;
+    EXPECT_TRUE(RunScheduler::BeforeNode(terminate).IsOK());
+  });
+  low_priority_thread.join();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
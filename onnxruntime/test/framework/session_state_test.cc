@@ -1,13 +1,17 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 #include "core/framework/execution_providers.h"
 #include "core/framework/graph_partitioner.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/prepacked_weights_container.h"
 #include "core/framework/session_state.h"
 #include "core/framework/session_state_initializer.h"
+#include "core/framework/shared_initializer_store.h"
 #include "core/graph/graph_utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
@@ -124,6 +128,21 @@ TEST_P(SessionStateTestP, TestInitializerProcessing) {
   status = session_initializer.CreatePlan(nullptr, nullptr, ExecutionMode::ORT_SEQUENTIAL);
   ASSERT_TRUE(status.IsOK()) << status;
 
+  // the executor's view of the plan is resolved with the kernels
+  const auto& execution_plan = session_state.GetExecutionPlan()->execution_plan;
+  const auto& steps = session_state.GetExecutionSteps();
+  ASSERT_EQ(steps.size(), execution_plan.size());
+  ASSERT_EQ(session_state.GetExecutionStepEventNames().size(), execution_plan.size());
+  for (size_t i = 0; i < steps.size(); ++i) {
+    EXPECT_EQ(steps[i].node_index, execution_plan[i].node_index);
+    EXPECT_EQ(steps[i].kernel, session_state.GetKernel(execution_plan[i].node_index));
+    EXPECT_EQ(steps[i].node_input_start_index,
+              session_state.GetNodeIndexInfo().GetNodeOffset(execution_plan[i].node_index));
+    EXPECT_EQ(steps[i].release_end - steps[i].release_begin,
+              std::max(execution_plan[i].free_to_index - execution_plan[i].free_from_index + 1, 0));
+    EXPECT_EQ(session_state.GetExecutionStepEventNames()[i].kernel_time, steps[i].node->Name() + "_kernel_time");
+  }
+
   const auto& initialized_tensors = session_state.GetInitializedTensors();
   const auto& const_initialized_tensors = session_state.GetConstantInitializedTensors();
 
@@ -152,5 +171,210 @@ TEST_P(SessionStateTestP, TestInitializerProcessing) {
 }
 
 INSTANTIATE_TEST_SUITE_P(SessionStateTests, SessionStateTestP, testing::ValuesIn(param_list));
+
+TEST(SessionStateTest, MemoryPatternBucketing) {
+  concurrency::ThreadPool tp{"test", 1};
+  ExecutionProviders execution_providers;
+
+  TensorShape shape_5({1, 5});
+  TensorShape shape_7({1, 7});
+  TensorShape shape_9({1, 9});
+  TensorShape shape_40({1, 40});
+
+  // without bucketing only the exact shapes match
+  {
+    SessionState s{execution_providers, true, &tp, nullptr};
+    ASSERT_TRUE(s.UpdateMemoryPatternGroupCache({shape_7}, onnxruntime::make_unique<MemoryPatternGroup>()).IsOK());
+    EXPECT_NE(s.GetMemoryPatternGroup({shape_7}), nullptr);
+    EXPECT_EQ(s.GetMemoryPatternGroup({shape_5}), nullptr);
+  }
+
+  // dimensions are rounded up to the next power of two by default
+  {
+    SessionState s{execution_providers, true, &tp, nullptr};
+    s.EnableMemoryPatternBucketing({});
+    ASSERT_TRUE(s.UpdateMemoryPatternGroupCache({shape_7}, onnxruntime::make_unique<MemoryPatternGroup>()).IsOK());
+    auto mem_patterns = s.GetMemoryPatternGroup({shape_7});
+    ASSERT_NE(mem_patterns, nullptr);
+    EXPECT_EQ(s.GetMemoryPatternGroup({shape_5}), mem_patterns);
+    EXPECT_EQ(s.GetMemoryPatternGroup({shape_9}), nullptr);
+  }
+
+  // explicit boundaries. dimensions past the last boundary are not rounded
+  {
+    SessionState s{execution_providers, true, &tp, nullptr};
+    s.EnableMemoryPatternBucketing({4, 10, 32});
+    ASSERT_TRUE(s.UpdateMemoryPatternGroupCache({shape_9}, onnxruntime::make_unique<MemoryPatternGroup>()).IsOK());
+    auto mem_patterns = s.GetMemoryPatternGroup({shape_5});
+    ASSERT_NE(mem_patterns, nullptr);
+    EXPECT_EQ(s.GetMemoryPatternGroup({shape_7}), mem_patterns);
+    EXPECT_EQ(s.GetMemoryPatternGroup({shape_40}), nullptr);
+  }
+}
+
+namespace {
+// Identity kernel that pre-packs its input into a copy and records the buffer it was handed back
+class PrePackingTestKernel : public OpKernel {
+ public:
+  explicit PrePackingTestKernel(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* /*context*/) const override { return Status::OK(); }
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                 PrePackedWeights& prepacked_weights) override {
+    ORT_UNUSED_PARAMETER(input_idx);
+    ++num_prepack_calls;
+    size_t len = tensor.SizeInBytes();
+    prepacked_weights.buffers_.push_back(BufferUniquePtr(alloc->Alloc(len), BufferDeleter(alloc)));
+    prepacked_weights.buffer_sizes_.push_back(len);
+    memcpy(prepacked_weights.buffers_[0].get(), tensor.DataRaw(), len);
+    is_packed = true;
+    return Status::OK();
+  }
+
+  Status UseSharedPrePackedBuffers(const PrePackedWeights& prepacked_weights, int /*input_idx*/) override {
+    packed_data = static_cast<const float*>(prepacked_weights.buffers_[0].get());
+    return Status::OK();
+  }
+
+  static int num_prepack_calls;
+  const float* packed_data = nullptr;
+};
+int PrePackingTestKernel::num_prepack_calls = 0;
+
+std::unique_ptr<Model> CreatePrePackingTestModel() {
+  auto model = onnxruntime::make_unique<Model>("prepacking", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model->MainGraph();
+
+  TensorProto weights;
+  weights.set_name("W");
+  weights.set_data_type(TensorProto_DataType_FLOAT);
+  weights.add_dims(4);
+  for (float value : {1.f, 2.f, 3.f, 4.f}) {
+    weights.add_float_data(value);
+  }
+  graph.AddInitializedTensor(weights);
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  auto& input_arg = graph.GetOrCreateNodeArg("W", &float_tensor);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("node", "Identity", "", {&input_arg}, {&output_arg}).SetExecutionProviderType(kCpuExecutionProvider);
+  EXPECT_TRUE(graph.Resolve().IsOK());
+  return model;
+}
+}  // namespace
+
+// The constant initializers are pre-packed once per container and the packed buffers are shared by the sessions.
+TEST(SessionStateTest, PrePackingSharesWeights) {
+  concurrency::ThreadPool tp{"test", 1};
+  ExecutionProviders execution_providers;
+  ASSERT_TRUE(execution_providers.Add(kCpuExecutionProvider, onnxruntime::make_unique<CPUExecutionProvider>(
+                                                                     CPUExecutionProviderInfo{false}))
+                  .IsOK());
+
+  KernelRegistryManager krm;
+  ASSERT_TRUE(krm.RegisterKernels(execution_providers).IsOK());
+  auto kernel_registry = std::make_shared<KernelRegistry>();
+  kernel_registry->Register(KernelCreateInfo(
+      KernelDefBuilder().SetName("Identity").Provider(kCpuExecutionProvider).SinceVersion(1).Build(),
+      [](const OpKernelInfo& info) -> OpKernel* { return new PrePackingTestKernel(info); }));
+  krm.RegisterKernelRegistry(kernel_registry);
+
+  PrepackedWeightsContainer container;
+  PrePackingTestKernel::num_prepack_calls = 0;
+  const std::basic_string<PATH_CHAR_TYPE> model_location;
+
+  auto create_session_state = [&](std::unique_ptr<Model>& model, PrepackedWeightsContainer* shared_container) {
+    model = CreatePrePackingTestModel();
+    auto session_state = onnxruntime::make_unique<SessionState>(execution_providers, false, &tp, nullptr);
+    session_state->EnablePrePacking(shared_container);
+    SessionStateInitializer initializer(false, model_location, model->MainGraph(), *session_state,
+                                        execution_providers, krm);
+    auto status = initializer.CreatePlan(nullptr, nullptr, ExecutionMode::ORT_SEQUENTIAL);
+    EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+    return session_state;
+  };
+
+  auto packed_data = [](const SessionState& session_state) {
+    for (const auto& node : session_state.GetGraphViewer()->Nodes()) {
+      return static_cast<const PrePackingTestKernel*>(session_state.GetKernel(node.Index()))->packed_data;
+    }
+    return static_cast<const float*>(nullptr);
+  };
+
+  std::unique_ptr<Model> model_1, model_2, model_3;
+  auto session_state_1 = create_session_state(model_1, &container);
+  auto session_state_2 = create_session_state(model_2, &container);
+  ASSERT_NE(packed_data(*session_state_1), nullptr);
+  EXPECT_EQ(packed_data(*session_state_1), packed_data(*session_state_2));
+  EXPECT_EQ(packed_data(*session_state_1)[3], 4.f);
+  EXPECT_EQ(PrePackingTestKernel::num_prepack_calls, 1);
+  EXPECT_EQ(container.NumPrePackedWeights(), 1u);
+
+  // without a container each session packs its own copy
+  auto session_state_3 = create_session_state(model_3, nullptr);
+  ASSERT_NE(packed_data(*session_state_3), nullptr);
+  EXPECT_NE(packed_data(*session_state_3), packed_data(*session_state_1));
+  EXPECT_EQ(PrePackingTestKernel::num_prepack_calls, 2);
+}
+
+// The constant initializers with the same content are loaded once per store and shared by the sessions.
+TEST(SessionStateTest, SharedInitializerStoreSharesInitializers) {
+  concurrency::ThreadPool tp{"test", 1};
+  ExecutionProviders execution_providers;
+  ASSERT_TRUE(execution_providers.Add(kCpuExecutionProvider, onnxruntime::make_unique<CPUExecutionProvider>(
+                                                                     CPUExecutionProviderInfo{false}))
+                  .IsOK());
+
+  KernelRegistryManager krm;
+  ASSERT_TRUE(krm.RegisterKernels(execution_providers).IsOK());
+  auto kernel_registry = std::make_shared<KernelRegistry>();
+  kernel_registry->Register(KernelCreateInfo(
+      KernelDefBuilder().SetName("Identity").Provider(kCpuExecutionProvider).SinceVersion(1).Build(),
+      [](const OpKernelInfo& info) -> OpKernel* { return new PrePackingTestKernel(info); }));
+  krm.RegisterKernelRegistry(kernel_registry);
+
+  SharedInitializerStore store;
+  const std::basic_string<PATH_CHAR_TYPE> model_location;
+
+  auto create_session_state = [&](std::unique_ptr<Model>& model, SharedInitializerStore* shared_store) {
+    model = CreatePrePackingTestModel();
+    auto session_state = onnxruntime::make_unique<SessionState>(execution_providers, false, &tp, nullptr);
+    session_state->SetSharedInitializerStore(shared_store);
+    SessionStateInitializer initializer(false, model_location, model->MainGraph(), *session_state,
+                                        execution_providers, krm);
+    auto status = initializer.CreatePlan(nullptr, nullptr, ExecutionMode::ORT_SEQUENTIAL);
+    EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+    return session_state;
+  };
+
+  auto initializer_data = [](const SessionState& session_state) {
+    const auto& initializers = session_state.GetConstantInitializedTensors();
+    EXPECT_EQ(initializers.size(), 1u);
+    return initializers.begin()->second.Get<Tensor>().Data<float>();
+  };
+
+  std::unique_ptr<Model> model_1, model_2, model_3;
+  auto session_state_1 = create_session_state(model_1, &store);
+  auto session_state_2 = create_session_state(model_2, &store);
+  EXPECT_EQ(initializer_data(*session_state_1), initializer_data(*session_state_2));
+  EXPECT_EQ(initializer_data(*session_state_1)[3], 4.f);
+  EXPECT_EQ(store.NumInitializers(), 1u);
+
+  // without a store each session loads its own copy
+  auto session_state_3 = create_session_state(model_3, nullptr);
+  EXPECT_NE(initializer_data(*session_state_3), initializer_data(*session_state_1));
+  EXPECT_EQ(initializer_data(*session_state_3)[3], 4.f);
+
+  // the initializer is released once no session uses it
+  session_state_1.reset();
+  store.ReleaseUnused();
+  EXPECT_EQ(store.NumInitializers(), 1u);
+  session_state_2.reset();
+  store.ReleaseUnused();
+  EXPECT_EQ(store.NumInitializers(), 0u);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/tensor.h"
+#include "core/framework/TensorSeq.h"
 #include "core/framework/allocatormgr.h"
 #include "test_utils.h"
 
@@ -214,5 +215,28 @@ TEST(TensorTest, SizeOverflow) {
   ptrdiff_t offset = sizeof(float);  // one more element to push past max
   EXPECT_THROW(Tensor(type, shape2, alloc, offset), OnnxRuntimeException);
 }
+
+TEST(TensorSeqTest, SharedElements) {
+  auto alloc = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  auto type = DataTypeImpl::GetType<float>();
+  std::vector<Tensor> tensors;
+  tensors.emplace_back(type, TensorShape({2}), alloc);
+  tensors.emplace_back(type, TensorShape({3}), alloc);
+  const float* first_data = tensors[0].Data<float>();
+
+  auto seq = onnxruntime::make_unique<TensorSeq>(type);
+  seq->SetElements(std::move(tensors));
+  ASSERT_EQ(seq->Size(), 2u);
+  EXPECT_EQ(seq->Get(0).Data<float>(), first_data);
+
+  // a sequence built from another one shares its tensors, which outlive it
+  TensorSeq erased(type);
+  erased.SetElements(std::vector<TensorSeq::ElementPtr>{seq->GetElement(0)});
+  seq.reset();
+  ASSERT_EQ(erased.Size(), 1u);
+  EXPECT_EQ(erased.Get(0).Data<float>(), first_data);
+  EXPECT_EQ(erased.begin()->Shape(), TensorShape({2}));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -136,6 +136,57 @@ TEST(CApiTensorTest, load_float_tensor_with_external_data) {
   run_external_data_test<false>();
 }
 
+TEST(CApiTensorTest, load_float_tensor_with_external_data_in_place) {
+  FILE* fp;
+  std::basic_string<ORTCHAR_T> filename(ORT_TSTR("tensor_XXXXXX"));
+  CreateTestFile(fp, filename);
+  std::unique_ptr<ORTCHAR_T, decltype(&DeleteFileFromDisk)> file_deleter(const_cast<ORTCHAR_T*>(filename.c_str()),
+                                                                         DeleteFileFromDisk);
+  // the data is written at offset 1, which is not aligned for float, and at offset 16, which is
+  const char padding[3] = {0, 0, 0};
+  float test_data[] = {1.0f, 2.2f, 3.5f};
+  ASSERT_EQ(1u, fwrite(padding, 1, 1, fp));
+  ASSERT_EQ(sizeof(test_data), fwrite(test_data, 1, sizeof(test_data), fp));
+  ASSERT_EQ(sizeof(padding), fwrite(padding, 1, sizeof(padding), fp));
+  ASSERT_EQ(sizeof(test_data), fwrite(test_data, 1, sizeof(test_data), fp));
+  ASSERT_EQ(0, fclose(fp));
+
+  auto make_tensor_proto = [&filename](const char* offset) {
+    onnx::TensorProto p;
+    onnx::StringStringEntryProto* location = p.mutable_external_data()->Add();
+    location->set_key("location");
+    location->set_value(ToMBString(filename));
+    onnx::StringStringEntryProto* offset_entry = p.mutable_external_data()->Add();
+    offset_entry->set_key("offset");
+    offset_entry->set_value(offset);
+    onnx::StringStringEntryProto* length = p.mutable_external_data()->Add();
+    length->set_key("length");
+    length->set_value(std::to_string(3 * sizeof(float)));
+    p.mutable_dims()->Add(3);
+    p.set_data_location(onnx::TensorProto_DataLocation_EXTERNAL);
+    p.set_data_type(onnx::TensorProto_DataType_FLOAT);
+    return p;
+  };
+
+  ASSERT_FALSE(utils::CanUseExternalDataInPlace(make_tensor_proto("1")));
+
+  // the aligned copy can be used without a preallocated buffer
+  const auto p = make_tensor_proto("16");
+  ASSERT_TRUE(utils::CanUseExternalDataInPlace(p));
+  OrtValue value;
+  auto deleter = onnxruntime::make_unique<onnxruntime::OrtCallback>();
+  OrtMemoryInfo cpu_memory_info(onnxruntime::CPU, OrtDeviceAllocator, OrtDevice(), 0, OrtMemTypeDefault);
+  auto st = utils::TensorProtoToMLValue(Env::Default(), nullptr, p, MemBuffer(nullptr, 0, cpu_memory_info), value,
+                                        *deleter);
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+  const float* real_output = value.Get<Tensor>().Data<float>();
+  ASSERT_EQ(real_output[0], 1.0f);
+  ASSERT_EQ(real_output[1], 2.2f);
+  ASSERT_EQ(real_output[2], 3.5f);
+  ASSERT_NE(deleter->f, nullptr);
+  OrtRunCallback(deleter.release());
+}
+
 #if defined(__amd64__) || defined(_M_X64)
 #ifndef __ANDROID__
 #ifdef NDEBUG
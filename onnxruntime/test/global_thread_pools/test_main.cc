@@ -43,7 +43,7 @@ int main(int argc, char** argv) {
   int status = 0;
   try {
     ::testing::InitGoogleTest(&argc, argv);
-    ThreadingOptions tp_options{0, 0};
+    ThreadingOptions tp_options{};
     ort_env.reset(new Ort::Env(tp_options, ORT_LOGGING_LEVEL_VERBOSE, "Default"));  // this is the only change from test/providers/test_main.cc
     status = RUN_ALL_TESTS();
   } catch (const std::exception& ex) {
@@ -227,6 +227,44 @@ TEST_F(GraphTest, SimpleAddWrongDomain2) {
   ASSERT_FALSE((st = Model::Load(std::move(m), model, nullptr, *logger_)).IsOK());
 }
 
+TEST_F(GraphTest, SparseInitializer) {
+  ModelProto m;
+  m.set_ir_version(4);
+  ImportOpset(m, "", 10);
+  ConstructASimpleAddGraph(*m.mutable_graph(), nullptr);
+
+  // y has two non-zero values, at [0, 1, 2] and [2, 3, 4]
+  SparseTensorProto* sparse = m.mutable_graph()->add_sparse_initializer();
+  sparse->add_dims(3);
+  sparse->add_dims(4);
+  sparse->add_dims(5);
+  TensorProto* values = sparse->mutable_values();
+  values->set_name("y");
+  values->set_data_type(TensorProto_DataType_FLOAT);
+  values->add_dims(2);
+  values->add_float_data(1.5f);
+  values->add_float_data(-2.0f);
+  TensorProto* indices = sparse->mutable_indices();
+  indices->set_data_type(TensorProto_DataType_INT64);
+  indices->add_dims(2);
+  indices->add_int64_data(7);
+  indices->add_int64_data(59);
+
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(std::move(m), model, nullptr, *logger_));
+
+  const TensorProto* y = nullptr;
+  ASSERT_TRUE(model->MainGraph().GetInitializedTensor("y", y));
+  ASSERT_EQ(y->dims_size(), 3);
+  ASSERT_EQ(y->raw_data().size(), 60 * sizeof(float));
+  std::vector<float> y_data(60);
+  memcpy(y_data.data(), y->raw_data().data(), y->raw_data().size());
+  std::vector<float> expected(60, 0.0f);
+  expected[7] = 1.5f;
+  expected[59] = -2.0f;
+  EXPECT_EQ(y_data, expected);
+}
+
 TEST_F(GraphTest, SimpleUnique) {
   ModelProto m;
   m.set_ir_version(3);
@@ -969,6 +1007,56 @@ TEST_F(GraphTest, ShapeInferenceErrorHandling) {
                                                         "[ShapeInferenceError] try harder"));
 }
 
+// Resolve only infers the nodes that changed since the previous Resolve, so check that a change to the input of a
+// node is still propagated to the shapes of the nodes after it.
+TEST_F(GraphTest, IncrementalResolve) {
+  Model model("graph", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto float_n_by_3;
+  float_n_by_3.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_n_by_3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  float_n_by_3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  TypeProto float_2_by_3;
+  float_2_by_3.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_2_by_3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  float_2_by_3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  auto& x = graph.GetOrCreateNodeArg("x", &float_n_by_3);
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  auto& z = graph.GetOrCreateNodeArg("z", nullptr);
+  auto& relu = graph.AddNode("relu", "Relu", "relu", {&x}, {&y});
+  graph.AddNode("abs", "Abs", "abs", {&y}, {&z});
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  ASSERT_NE(z.Shape(), nullptr);
+  EXPECT_EQ(z.Shape()->dim(0).dim_param(), "N");
+
+  // a Resolve without changes leaves the shapes as they are
+  graph.SetGraphResolveNeeded();
+  status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  EXPECT_EQ(z.Shape()->dim(0).dim_param(), "N");
+
+  // replace the input of the first node with a value of a known shape
+  auto& x2 = graph.GetOrCreateNodeArg("x2", &float_2_by_3);
+  relu.MutableInputDefs()[0] = &x2;
+  graph.SetGraphResolveNeeded();
+
+  status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  ASSERT_EQ(graph.GetInputs().size(), 1u);
+  EXPECT_EQ(graph.GetInputs()[0]->Name(), "x2");
+  for (const auto* arg : {&y, &z}) {
+    ASSERT_NE(arg->Shape(), nullptr);
+    ASSERT_EQ(arg->Shape()->dim_size(), 2);
+    EXPECT_EQ(arg->Shape()->dim(0).dim_value(), 2);
+    EXPECT_EQ(arg->Shape()->dim(1).dim_value(), 3);
+  }
+}
+
 TEST_F(GraphTest, AddTensorAttribute) {
   OPERATOR_SCHEMA(__Constant)
       .SetDoc("Constant Op.")
@@ -2,7 +2,10 @@
 // Licensed under the MIT License.
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <cstdio>
+#include <fstream>
 #include <memory>
+#include "core/framework/tensor_external_data_info.h"
 #include "core/platform/env.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
@@ -188,5 +191,63 @@ TEST_F(ONNXModelsTest, TestModelsWithAnOpContainingAFunctionBody) {
   ASSERT_STATUS_OK(model->MainGraph().Resolve());
 }
 
+// the raw data of the large initializers is left in the model file, and the rest of the model is parsed as usual
+TEST_F(ONNXModelsTest, LoadReferencingInitializerData) {
+  ModelProto model_proto;
+  model_proto.set_ir_version(ONNX_NAMESPACE::Version::IR_VERSION);
+  model_proto.set_producer_name("test");
+  model_proto.add_opset_import()->set_version(11);
+  GraphProto* graph_proto = model_proto.mutable_graph();
+  graph_proto->set_name("graph");
+  std::vector<float> large_values(2048);
+  for (size_t i = 0; i < large_values.size(); ++i) {
+    large_values[i] = static_cast<float>(i);
+  }
+  TensorProto* large = graph_proto->add_initializer();
+  large->set_name("large");
+  large->set_data_type(TensorProto_DataType_FLOAT);
+  large->add_dims(static_cast<int64_t>(large_values.size()));
+  large->set_raw_data(large_values.data(), large_values.size() * sizeof(float));
+  TensorProto* small = graph_proto->add_initializer();
+  small->set_name("small");
+  small->set_data_type(TensorProto_DataType_INT64);
+  small->add_dims(1);
+  small->add_int64_data(42);
+
+  const PathString model_path = ORT_TSTR("load_referencing_initializer_data.onnx");
+  {
+    std::ofstream model_file(model_path, std::ios::binary);
+    ASSERT_TRUE(model_proto.SerializeToOstream(&model_file));
+  }
+
+  ModelProto loaded;
+  ASSERT_STATUS_OK(Model::LoadReferencingInitializerData(model_path, loaded));
+  EXPECT_EQ(loaded.producer_name(), "test");
+  EXPECT_EQ(loaded.graph().name(), "graph");
+  ASSERT_EQ(loaded.graph().initializer_size(), 2);
+
+  const TensorProto& loaded_large = loaded.graph().initializer(0);
+  EXPECT_EQ(loaded_large.name(), "large");
+  EXPECT_FALSE(loaded_large.has_raw_data());
+  ASSERT_EQ(loaded_large.data_location(), TensorProto_DataLocation_EXTERNAL);
+  std::unique_ptr<ExternalDataInfo> external_data;
+  ASSERT_STATUS_OK(ExternalDataInfo::Create(loaded_large.external_data(), external_data));
+  EXPECT_EQ(external_data->GetRelPath(), model_path);
+  ASSERT_EQ(external_data->GetLength(), large_values.size() * sizeof(float));
+  std::vector<float> file_values(large_values.size());
+  ASSERT_STATUS_OK(Env::Default().ReadFileIntoBuffer(
+      model_path.c_str(), external_data->GetOffset(), external_data->GetLength(),
+      gsl::make_span(reinterpret_cast<char*>(file_values.data()), external_data->GetLength())));
+  EXPECT_EQ(file_values, large_values);
+
+  const TensorProto& loaded_small = loaded.graph().initializer(1);
+  EXPECT_EQ(loaded_small.name(), "small");
+  EXPECT_NE(loaded_small.data_location(), TensorProto_DataLocation_EXTERNAL);
+  ASSERT_EQ(loaded_small.int64_data_size(), 1);
+  EXPECT_EQ(loaded_small.int64_data(0), 42);
+
+  std::remove(ToMBString(model_path).c_str());
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,134 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bench_activation.cpp
+
+Abstract:
+
+    This module implements micro-benchmarks of the activation and elementwise
+    transcendental routines.
+
+--*/
+
+#include "bench_util.h"
+
+#include <vector>
+
+//
+// The elementwise routines run on the calling thread, so only the element
+// count varies: a buffer resident in L1, one resident in L2 and one that
+// streams from memory.
+//
+
+static
+void
+ElementwiseArgs(
+    benchmark::internal::Benchmark* b
+    )
+{
+    b->ArgNames({"N"});
+    b->Arg(1024)->Arg(64 * 1024)->Arg(4 * 1024 * 1024);
+}
+
+using MlasElementwiseRoutine = void(MLASCALL*)(const float*, float*, size_t);
+
+template <MlasElementwiseRoutine Routine>
+static
+void
+BM_Elementwise(
+    benchmark::State& state
+    )
+{
+    const size_t N = size_t(state.range(0));
+
+    auto Input = RandomVectorUniform<float>(N, -4.0f, 4.0f);
+    std::vector<float> Output(N);
+
+    for (auto _ : state) {
+        Routine(Input.data(), Output.data(), N);
+    }
+
+    ReportOpsAndBytes(state, double(N), int64_t(2 * N * sizeof(float)));
+}
+
+BENCHMARK_TEMPLATE(BM_Elementwise, MlasComputeLogistic)->Apply(ElementwiseArgs);
+BENCHMARK_TEMPLATE(BM_Elementwise, MlasComputeTanh)->Apply(ElementwiseArgs);
+BENCHMARK_TEMPLATE(BM_Elementwise, MlasComputeErf)->Apply(ElementwiseArgs);
+BENCHMARK_TEMPLATE(BM_Elementwise, MlasComputeExp)->Apply(ElementwiseArgs);
+
+template <MLAS_ACTIVATION_KIND ActivationKind>
+static
+void
+BM_Activation(
+    benchmark::State& state
+    )
+{
+    const size_t N = size_t(state.range(0));
+
+    auto Buffer = RandomVectorUniform<float>(N, -4.0f, 4.0f);
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = ActivationKind;
+    Activation.Parameters.LeakyRelu.alpha = 0.01f;
+    if (ActivationKind == MlasClipActivation) {
+        Activation.Parameters.Clip.minimum = 0.0f;
+        Activation.Parameters.Clip.maximum = 6.0f;
+    }
+
+    //
+    // The activation is applied in place, so the buffer values change after
+    // the first iteration. The routines are branch free, so this doesn't
+    // change their cost.
+    //
+
+    for (auto _ : state) {
+        MlasActivation(&Activation, Buffer.data(), nullptr, 1, N, N);
+    }
+
+    ReportOpsAndBytes(state, double(N), int64_t(2 * N * sizeof(float)));
+}
+
+BENCHMARK_TEMPLATE(BM_Activation, MlasReluActivation)->Apply(ElementwiseArgs);
+BENCHMARK_TEMPLATE(BM_Activation, MlasLeakyReluActivation)->Apply(ElementwiseArgs);
+BENCHMARK_TEMPLATE(BM_Activation, MlasClipActivation)->Apply(ElementwiseArgs);
+BENCHMARK_TEMPLATE(BM_Activation, MlasGeluActivation)->Apply(ElementwiseArgs);
+
+//
+// Rows and row length of the softmax, the attention probabilities of BERT
+// base and a classifier over a large vocabulary.
+//
+
+static const std::vector<std::vector<int64_t>> SoftmaxShapes = {
+    {12 * 128, 128},
+    {64, 30522},
+};
+
+static
+void
+BM_Softmax(
+    benchmark::State& state
+    )
+{
+    const size_t N = size_t(state.range(0));
+    const size_t D = size_t(state.range(1));
+    MLAS_THREADPOOL* ThreadPool = GetMlasThreadPool(state.range(2));
+
+    auto Input = RandomVectorUniform<float>(N * D, -4.0f, 4.0f);
+    std::vector<float> Output(N * D);
+
+    for (auto _ : state) {
+        MlasComputeSoftmax(Input.data(), Output.data(), N, D, false, ThreadPool);
+    }
+
+    ReportOpsAndBytes(state, double(N * D), int64_t(2 * N * D * sizeof(float)));
+}
+
+BENCHMARK(BM_Softmax)->Apply([](benchmark::internal::Benchmark* b) {
+    b->ArgNames({"N", "D", "Threads"});
+    ArgsShapesAndThreads(b, SoftmaxShapes);
+})->UseRealTime();
@@ -0,0 +1,238 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bench_conv.cpp
+
+Abstract:
+
+    This module implements micro-benchmarks of the NCHW and NCHWc two
+    dimensional convolution routines.
+
+--*/
+
+#include "bench_util.h"
+
+#include <vector>
+
+//
+// Groups, input channels per group, input height, input width, filters per
+// group, kernel size, stride and padding of the convolutions, with a batch of
+// one. The shapes are taken from ResNet-50 and MobileNet-V2.
+//
+
+static const std::vector<std::vector<int64_t>> ConvShapes = {
+    {1, 3, 224, 224, 64, 7, 2, 3},
+    {1, 64, 56, 56, 64, 3, 1, 1},
+    {1, 64, 56, 56, 256, 1, 1, 0},
+    {1, 256, 56, 56, 64, 1, 1, 0},
+    {1, 128, 28, 28, 128, 3, 1, 1},
+    {1, 256, 14, 14, 256, 3, 1, 1},
+    {1, 512, 7, 7, 2048, 1, 1, 0},
+    {32, 1, 112, 112, 1, 3, 1, 1},
+    {144, 1, 56, 56, 1, 3, 2, 1},
+};
+
+static
+void
+ConvArgs(
+    benchmark::internal::Benchmark* b
+    )
+{
+    b->ArgNames({"G", "Cpg", "H", "W", "Fpg", "K", "S", "P", "Threads"});
+    ArgsShapesAndThreads(b, ConvShapes);
+}
+
+struct ConvShape {
+    size_t GroupCount;
+    size_t InputChannels;
+    size_t FilterCount;
+    int64_t InputShape[2];
+    int64_t KernelShape[2];
+    int64_t DilationShape[2];
+    int64_t Padding[4];
+    int64_t StrideShape[2];
+    int64_t OutputShape[2];
+
+    explicit ConvShape(const benchmark::State& state)
+    {
+        GroupCount = size_t(state.range(0));
+        InputChannels = size_t(state.range(1));
+        FilterCount = size_t(state.range(4));
+
+        const int64_t Kernel = state.range(5);
+        const int64_t Stride = state.range(6);
+        const int64_t Pad = state.range(7);
+
+        for (size_t i = 0; i < 2; i++) {
+            InputShape[i] = state.range(2 + i);
+            KernelShape[i] = Kernel;
+            DilationShape[i] = 1;
+            Padding[i] = Pad;
+            Padding[i + 2] = Pad;
+            StrideShape[i] = Stride;
+            OutputShape[i] = (InputShape[i] + 2 * Pad - Kernel) / Stride + 1;
+        }
+    }
+
+    size_t InputSize() const { return size_t(InputShape[0] * InputShape[1]); }
+    size_t OutputSize() const { return size_t(OutputShape[0] * OutputShape[1]); }
+    size_t KernelSize() const { return size_t(KernelShape[0] * KernelShape[1]); }
+
+    void
+    Report(
+        benchmark::State& state
+        ) const
+    {
+        const size_t InputElements = GroupCount * InputChannels * InputSize();
+        const size_t FilterElements = GroupCount * FilterCount * InputChannels * KernelSize();
+        const size_t OutputElements = GroupCount * FilterCount * OutputSize();
+
+        ReportOpsAndBytes(state, 2.0 * OutputElements * InputChannels * KernelSize(),
+            int64_t((InputElements + FilterElements + OutputElements) * sizeof(float)));
+    }
+};
+
+static
+void
+BM_Conv(
+    benchmark::State& state
+    )
+{
+    const ConvShape Shape(state);
+    MLAS_THREADPOOL* ThreadPool = GetMlasThreadPool(state.range(8));
+
+    auto Input = RandomVectorUniform<float>(Shape.GroupCount * Shape.InputChannels * Shape.InputSize(), -1.0f, 1.0f);
+    auto Filter = RandomVectorUniform<float>(Shape.GroupCount * Shape.FilterCount * Shape.InputChannels * Shape.KernelSize(), -1.0f, 1.0f);
+    auto Bias = RandomVectorUniform<float>(Shape.GroupCount * Shape.FilterCount, -1.0f, 1.0f);
+    std::vector<float> Output(Shape.GroupCount * Shape.FilterCount * Shape.OutputSize());
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasIdentityActivation;
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvPrepare(&Parameters,
+                    2,
+                    1,
+                    Shape.GroupCount,
+                    Shape.InputChannels,
+                    Shape.InputShape,
+                    Shape.KernelShape,
+                    Shape.DilationShape,
+                    Shape.Padding,
+                    Shape.StrideShape,
+                    Shape.OutputShape,
+                    Shape.FilterCount,
+                    &Activation,
+                    &WorkingBufferSize,
+                    ThreadPool);
+
+    std::vector<float> WorkingBuffer(WorkingBufferSize);
+
+    for (auto _ : state) {
+        MlasConv(&Parameters,
+                 Input.data(),
+                 Filter.data(),
+                 Bias.data(),
+                 WorkingBuffer.data(),
+                 Output.data(),
+                 ThreadPool);
+    }
+
+    Shape.Report(state);
+}
+
+BENCHMARK(BM_Conv)->Apply(ConvArgs)->UseRealTime();
+
+//
+// The NCHWc benchmark times the convolution alone. The input and filter are
+// reordered to the blocked layouts up front, as the NCHWc transformer does for
+// the weights and for consecutive NCHWc operators.
+//
+
+static
+void
+BM_NchwcConv(
+    benchmark::State& state
+    )
+{
+    const size_t BlockSize = MlasNchwcGetBlockSize();
+
+    if (BlockSize <= 1) {
+        state.SkipWithError("NCHWc is not supported on this platform");
+        return;
+    }
+
+    const ConvShape Shape(state);
+    MLAS_THREADPOOL* ThreadPool = GetMlasThreadPool(state.range(8));
+
+    const size_t Channels = Shape.GroupCount * Shape.InputChannels;
+    const size_t Filters = Shape.GroupCount * Shape.FilterCount;
+    const size_t NchwcChannels = (Channels + BlockSize - 1) & ~(BlockSize - 1);
+    const size_t NchwcFilters = (Filters + BlockSize - 1) & ~(BlockSize - 1);
+
+    //
+    // Select the filter layout in the same way as the NCHWc transformer.
+    // Inputs with fewer channels than the block size are read in NCHW layout.
+    //
+
+    const bool Depthwise = Shape.GroupCount > 1 && Shape.InputChannels == 1 && Shape.FilterCount == 1;
+    const bool ReorderInput = Depthwise || Shape.InputChannels >= BlockSize;
+
+    int64_t InputShape[] = {1, int64_t(Channels), Shape.InputShape[0], Shape.InputShape[1]};
+    int64_t FilterShape[] = {int64_t(Filters), int64_t(Shape.InputChannels), Shape.KernelShape[0], Shape.KernelShape[1]};
+    int64_t OutputShape[] = {1, int64_t(NchwcFilters), Shape.OutputShape[0], Shape.OutputShape[1]};
+
+    auto Input = RandomVectorUniform<float>(Channels * Shape.InputSize(), -1.0f, 1.0f);
+    auto Filter = RandomVectorUniform<float>(Filters * Shape.InputChannels * Shape.KernelSize(), -1.0f, 1.0f);
+    auto Bias = RandomVectorUniform<float>(NchwcFilters, -1.0f, 1.0f);
+    std::vector<float> Output(NchwcFilters * Shape.OutputSize());
+
+    std::vector<float> NchwcFilter;
+    if (ReorderInput && !Depthwise) {
+        NchwcFilter.resize(NchwcFilters * NchwcChannels * Shape.KernelSize());
+        MlasReorderFilterOIHWBiBo(FilterShape, Filter.data(), NchwcFilter.data());
+    } else {
+        NchwcFilter.resize(NchwcFilters * Shape.InputChannels * Shape.KernelSize());
+        MlasReorderFilterOIHWBo(FilterShape, Filter.data(), NchwcFilter.data());
+    }
+
+    std::vector<float> NchwcInput;
+    if (ReorderInput) {
+        NchwcInput.resize(NchwcChannels * Shape.InputSize());
+        MlasReorderInput(InputShape, Input.data(), NchwcInput.data());
+        InputShape[1] = int64_t(NchwcChannels);
+    } else {
+        NchwcInput = std::move(Input);
+    }
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasIdentityActivation;
+
+    for (auto _ : state) {
+        MlasNchwcConv(InputShape,
+                      Shape.KernelShape,
+                      Shape.DilationShape,
+                      Shape.Padding,
+                      Shape.StrideShape,
+                      OutputShape,
+                      Shape.GroupCount,
+                      NchwcInput.data(),
+                      NchwcFilter.data(),
+                      Bias.data(),
+                      Output.data(),
+                      &Activation,
+                      true,
+                      ThreadPool);
+    }
+
+    Shape.Report(state);
+}
+
+BENCHMARK(BM_NchwcConv)->Apply(ConvArgs)->UseRealTime();
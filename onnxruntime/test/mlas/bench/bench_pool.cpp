@@ -0,0 +1,142 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bench_pool.cpp
+
+Abstract:
+
+    This module implements micro-benchmarks of the NCHW and NCHWc two
+    dimensional pooling routines.
+
+--*/
+
+#include "bench_util.h"
+
+#include <vector>
+
+//
+// Channels, input height, input width, kernel size, stride and padding of the
+// pooling operations, with a batch of one.
+//
+
+static const std::vector<std::vector<int64_t>> PoolShapes = {
+    {64, 112, 112, 3, 2, 1},
+    {256, 56, 56, 2, 2, 0},
+    {512, 28, 28, 3, 1, 1},
+    {2048, 7, 7, 7, 1, 0},
+};
+
+static
+void
+PoolArgs(
+    benchmark::internal::Benchmark* b
+    )
+{
+    b->ArgNames({"C", "H", "W", "K", "S", "P", "Threads"});
+    ArgsShapesAndThreads(b, PoolShapes);
+}
+
+struct PoolShape {
+    int64_t Channels;
+    int64_t InputShape[2];
+    int64_t KernelShape[2];
+    int64_t DilationShape[2];
+    int64_t Padding[4];
+    int64_t StrideShape[2];
+    int64_t OutputShape[2];
+
+    explicit PoolShape(const benchmark::State& state)
+    {
+        Channels = state.range(0);
+
+        for (size_t i = 0; i < 2; i++) {
+            InputShape[i] = state.range(1 + i);
+            KernelShape[i] = state.range(3);
+            DilationShape[i] = 1;
+            StrideShape[i] = state.range(4);
+            Padding[i] = state.range(5);
+            Padding[i + 2] = state.range(5);
+            OutputShape[i] = (InputShape[i] + 2 * Padding[i] - KernelShape[i]) / StrideShape[i] + 1;
+        }
+    }
+
+    void
+    Report(
+        benchmark::State& state
+        ) const
+    {
+        const size_t InputElements = size_t(Channels * InputShape[0] * InputShape[1]);
+        const size_t OutputElements = size_t(Channels * OutputShape[0] * OutputShape[1]);
+
+        ReportOpsAndBytes(state, double(OutputElements) * KernelShape[0] * KernelShape[1],
+            int64_t((InputElements + OutputElements) * sizeof(float)));
+    }
+};
+
+template <MLAS_POOLING_KIND PoolingKind>
+static
+void
+BM_Pool(
+    benchmark::State& state
+    )
+{
+    const PoolShape Shape(state);
+    MLAS_THREADPOOL* ThreadPool = GetMlasThreadPool(state.range(6));
+
+    int64_t InputShape[] = {1, Shape.Channels, Shape.InputShape[0], Shape.InputShape[1]};
+    int64_t OutputShape[] = {1, Shape.Channels, Shape.OutputShape[0], Shape.OutputShape[1]};
+
+    auto Input = RandomVectorUniform<float>(size_t(Shape.Channels * Shape.InputShape[0] * Shape.InputShape[1]), -1.0f, 1.0f);
+    std::vector<float> Output(size_t(Shape.Channels * Shape.OutputShape[0] * Shape.OutputShape[1]));
+
+    for (auto _ : state) {
+        MlasPool(PoolingKind, 2, InputShape, Shape.KernelShape, Shape.Padding, Shape.StrideShape, OutputShape,
+                 Input.data(), Output.data(), ThreadPool);
+    }
+
+    Shape.Report(state);
+}
+
+BENCHMARK_TEMPLATE(BM_Pool, MlasMaximumPooling)->Apply(PoolArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Pool, MlasAveragePoolingExcludePad)->Apply(PoolArgs)->UseRealTime();
+
+template <MLAS_POOLING_KIND PoolingKind>
+static
+void
+BM_NchwcPool(
+    benchmark::State& state
+    )
+{
+    const int64_t BlockSize = int64_t(MlasNchwcGetBlockSize());
+
+    if (BlockSize <= 1) {
+        state.SkipWithError("NCHWc is not supported on this platform");
+        return;
+    }
+
+    const PoolShape Shape(state);
+    MLAS_THREADPOOL* ThreadPool = GetMlasThreadPool(state.range(6));
+
+    const int64_t NchwcChannels = (Shape.Channels + BlockSize - 1) & ~(BlockSize - 1);
+
+    int64_t InputShape[] = {1, NchwcChannels, Shape.InputShape[0], Shape.InputShape[1]};
+    int64_t OutputShape[] = {1, NchwcChannels, Shape.OutputShape[0], Shape.OutputShape[1]};
+
+    auto Input = RandomVectorUniform<float>(size_t(NchwcChannels * Shape.InputShape[0] * Shape.InputShape[1]), -1.0f, 1.0f);
+    std::vector<float> Output(size_t(NchwcChannels * Shape.OutputShape[0] * Shape.OutputShape[1]));
+
+    for (auto _ : state) {
+        MlasNchwcPool(PoolingKind, InputShape, Shape.KernelShape, Shape.DilationShape, Shape.Padding,
+                      Shape.StrideShape, OutputShape, Input.data(), Output.data(), ThreadPool);
+    }
+
+    Shape.Report(state);
+}
+
+BENCHMARK_TEMPLATE(BM_NchwcPool, MlasMaximumPooling)->Apply(PoolArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_NchwcPool, MlasAveragePoolingExcludePad)->Apply(PoolArgs)->UseRealTime();
@@ -0,0 +1,80 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bench_qgemm.cpp
+
+Abstract:
+
+    This module implements micro-benchmarks of the quantized integer matrix
+    multiply routines.
+
+--*/
+
+#include "bench_util.h"
+
+#include <limits>
+#include <vector>
+
+#if defined(_M_IX86) || defined(__i386__) || defined(_M_AMD64) || defined(__x86_64__)
+
+//
+// M, N, K of the matrix multiplies, matching the shapes of the SGEMM
+// benchmarks so the two can be compared.
+//
+
+static const std::vector<std::vector<int64_t>> QgemmShapes = {
+    {1, 1024, 1024},
+    {64, 1024, 1024},
+    {256, 256, 256},
+    {1024, 1024, 1024},
+    {128, 768, 768},
+    {128, 3072, 768},
+    {128, 768, 3072},
+    {64, 3136, 576},
+};
+
+static
+void
+QgemmArgs(
+    benchmark::internal::Benchmark* b
+    )
+{
+    b->ArgNames({"M", "N", "K", "Threads"});
+    ArgsShapesAndThreads(b, QgemmShapes);
+}
+
+template <typename BType>
+static
+void
+BM_Qgemm(
+    benchmark::State& state
+    )
+{
+    const size_t M = size_t(state.range(0));
+    const size_t N = size_t(state.range(1));
+    const size_t K = size_t(state.range(2));
+    MLAS_THREADPOOL* ThreadPool = GetMlasThreadPool(state.range(3));
+
+    auto A = RandomVectorUniform<uint8_t>(M * K, 0, 255);
+    auto B = RandomVectorUniform<BType>(K * N, std::numeric_limits<BType>::min(), std::numeric_limits<BType>::max());
+    std::vector<int32_t> C(M * N);
+
+    const uint8_t offa = 131;
+    const BType offb = BType(7);
+
+    for (auto _ : state) {
+        MlasGemm(M, N, K, A.data(), K, offa, B.data(), N, offb, C.data(), N, ThreadPool);
+    }
+
+    ReportOpsAndBytes(state, 2.0 * M * N * K, int64_t(M * K + K * N + M * N * sizeof(int32_t)));
+}
+
+BENCHMARK_TEMPLATE(BM_Qgemm, int8_t)->Apply(QgemmArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Qgemm, uint8_t)->Apply(QgemmArgs)->UseRealTime();
+
+#endif
@@ -0,0 +1,79 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bench_quantize.cpp
+
+Abstract:
+
+    This module implements micro-benchmarks of the linear quantization and
+    requantization routines.
+
+--*/
+
+#include "bench_util.h"
+
+#include <vector>
+
+static
+void
+QuantizeArgs(
+    benchmark::internal::Benchmark* b
+    )
+{
+    b->ArgNames({"N"});
+    b->Arg(1024)->Arg(64 * 1024)->Arg(4 * 1024 * 1024);
+}
+
+template <typename OutputType>
+static
+void
+BM_QuantizeLinear(
+    benchmark::State& state
+    )
+{
+    const size_t N = size_t(state.range(0));
+
+    auto Input = RandomVectorUniform<float>(N, -8.0f, 8.0f);
+    std::vector<OutputType> Output(N);
+
+    for (auto _ : state) {
+        MlasQuantizeLinear(Input.data(), Output.data(), N, 0.0625f, OutputType(3));
+    }
+
+    ReportOpsAndBytes(state, double(N), int64_t(N * (sizeof(float) + sizeof(OutputType))));
+}
+
+BENCHMARK_TEMPLATE(BM_QuantizeLinear, uint8_t)->Apply(QuantizeArgs);
+BENCHMARK_TEMPLATE(BM_QuantizeLinear, int8_t)->Apply(QuantizeArgs);
+
+//
+// M and N of the int32 accumulator matrices produced by the quantized GEMM
+// benchmarks.
+//
+
+static
+void
+BM_RequantizeOutput(
+    benchmark::State& state
+    )
+{
+    const size_t M = size_t(state.range(0));
+    const size_t N = size_t(state.range(1));
+
+    auto Input = RandomVectorUniform<int32_t>(M * N, -65536, 65536);
+    auto Bias = RandomVectorUniform<int32_t>(N, -1024, 1024);
+    std::vector<uint8_t> Output(M * N);
+
+    for (auto _ : state) {
+        MlasRequantizeOutput(Input.data(), Output.data(), Bias.data(), M, N, 0.001f, 128);
+    }
+
+    ReportOpsAndBytes(state, double(M * N), int64_t(M * N * (sizeof(int32_t) + sizeof(uint8_t)) + N * sizeof(int32_t)));
+}
+
+BENCHMARK(BM_RequantizeOutput)->ArgNames({"M", "N"})->Args({128, 768})->Args({128, 3072})->Args({1024, 1024});
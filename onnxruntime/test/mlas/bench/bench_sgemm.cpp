@@ -0,0 +1,114 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bench_sgemm.cpp
+
+Abstract:
+
+    This module implements micro-benchmarks of the single precision matrix
+    multiply routines.
+
+--*/
+
+#include "bench_util.h"
+
+#include <vector>
+
+//
+// M, N, K of the matrix multiplies. The shapes cover a GEMV, square matrices,
+// the fully connected layers of BERT base and the im2col GEMM of a ResNet-50
+// 3x3 convolution.
+//
+
+static const std::vector<std::vector<int64_t>> SgemmShapes = {
+    {1, 1024, 1024},
+    {64, 1024, 1024},
+    {256, 256, 256},
+    {1024, 1024, 1024},
+    {128, 768, 768},
+    {128, 3072, 768},
+    {128, 768, 3072},
+    {64, 3136, 576},
+};
+
+static
+void
+SgemmArgs(
+    benchmark::internal::Benchmark* b
+    )
+{
+    b->ArgNames({"M", "N", "K", "Threads"});
+    ArgsShapesAndThreads(b, SgemmShapes);
+}
+
+static
+void
+ReportSgemm(
+    benchmark::State& state,
+    size_t M,
+    size_t N,
+    size_t K
+    )
+{
+    ReportOpsAndBytes(state, 2.0 * M * N * K, int64_t((M * K + K * N + M * N) * sizeof(float)));
+}
+
+template <CBLAS_TRANSPOSE TransB>
+static
+void
+BM_Sgemm(
+    benchmark::State& state
+    )
+{
+    const size_t M = size_t(state.range(0));
+    const size_t N = size_t(state.range(1));
+    const size_t K = size_t(state.range(2));
+    MLAS_THREADPOOL* ThreadPool = GetMlasThreadPool(state.range(3));
+
+    auto A = RandomVectorUniform<float>(M * K, -1.0f, 1.0f);
+    auto B = RandomVectorUniform<float>(K * N, -1.0f, 1.0f);
+    std::vector<float> C(M * N);
+
+    const size_t ldb = (TransB == CblasNoTrans) ? N : K;
+
+    for (auto _ : state) {
+        MlasGemm(CblasNoTrans, TransB, M, N, K, 1.0f, A.data(), K, B.data(), ldb, 0.0f, C.data(), N, ThreadPool);
+    }
+
+    ReportSgemm(state, M, N, K);
+}
+
+BENCHMARK_TEMPLATE(BM_Sgemm, CblasNoTrans)->Apply(SgemmArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Sgemm, CblasTrans)->Apply(SgemmArgs)->UseRealTime();
+
+static
+void
+BM_SgemmPackedB(
+    benchmark::State& state
+    )
+{
+    const size_t M = size_t(state.range(0));
+    const size_t N = size_t(state.range(1));
+    const size_t K = size_t(state.range(2));
+    MLAS_THREADPOOL* ThreadPool = GetMlasThreadPool(state.range(3));
+
+    auto A = RandomVectorUniform<float>(M * K, -1.0f, 1.0f);
+    auto B = RandomVectorUniform<float>(K * N, -1.0f, 1.0f);
+    std::vector<float> C(M * N);
+
+    std::vector<uint8_t> PackedB(MlasGemmPackBSize(N, K));
+    MlasGemmPackB(CblasNoTrans, N, K, B.data(), N, PackedB.data());
+
+    for (auto _ : state) {
+        MlasGemm(CblasNoTrans, M, N, K, 1.0f, A.data(), K, PackedB.data(), 0.0f, C.data(), N, ThreadPool);
+    }
+
+    ReportSgemm(state, M, N, K);
+}
+
+BENCHMARK(BM_SgemmPackedB)->Apply(SgemmArgs)->UseRealTime();
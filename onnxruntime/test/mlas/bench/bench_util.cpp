@@ -0,0 +1,79 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bench_util.cpp
+
+Abstract:
+
+    This module implements the helpers shared by the MLAS micro-benchmarks.
+
+--*/
+
+#include "bench_util.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "core/platform/threadpool.h"
+
+MLAS_THREADPOOL*
+GetMlasThreadPool(
+    int64_t ThreadCount
+    )
+{
+    if (ThreadCount <= 1) {
+        return nullptr;
+    }
+
+    static std::mutex mutex;
+    static std::map<int64_t, std::unique_ptr<onnxruntime::concurrency::ThreadPool>> pools;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto& pool = pools[ThreadCount];
+
+    if (pool == nullptr) {
+
+        //
+        // The calling thread also runs work items of ParallelFor, so the pool
+        // needs one thread less than the requested count.
+        //
+
+        pool.reset(new onnxruntime::concurrency::ThreadPool(
+            "mlas_bench_" + std::to_string(ThreadCount), static_cast<int>(ThreadCount - 1)));
+    }
+
+    return pool.get();
+}
+
+void
+ArgsShapesAndThreads(
+    benchmark::internal::Benchmark* b,
+    const std::vector<std::vector<int64_t>>& Shapes
+    )
+{
+    const int64_t HardwareThreads = std::max<int64_t>(1, std::thread::hardware_concurrency());
+
+    for (const auto& Shape : Shapes) {
+        for (int64_t ThreadCount = 1; ; ThreadCount *= 2) {
+            if (ThreadCount > HardwareThreads) {
+                ThreadCount = HardwareThreads;
+            }
+            std::vector<int64_t> Args(Shape);
+            Args.push_back(ThreadCount);
+            b->Args(Args);
+            if (ThreadCount == HardwareThreads) {
+                break;
+            }
+        }
+    }
+}
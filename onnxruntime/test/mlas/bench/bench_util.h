@@ -0,0 +1,92 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bench_util.h
+
+Abstract:
+
+    This module contains the helpers shared by the MLAS micro-benchmarks.
+
+--*/
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <mlas.h>
+
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+//
+// Returns a thread pool that runs MLAS operations on ThreadCount threads
+// including the calling thread, or nullptr to run on the calling thread only.
+// The pools live for the duration of the process.
+//
+
+MLAS_THREADPOOL*
+GetMlasThreadPool(
+    int64_t ThreadCount
+    );
+
+//
+// Adds the argument lists of a benchmark: each shape of Shapes is combined
+// with the thread counts 1, 2, 4, ... up to the number of hardware threads.
+// The thread count is appended as the last argument.
+//
+
+void
+ArgsShapesAndThreads(
+    benchmark::internal::Benchmark* b,
+    const std::vector<std::vector<int64_t>>& Shapes
+    );
+
+//
+// Reports the rate of floating point (or integer multiply-add) operations and
+// the number of bytes read and written by an operation, per iteration.
+//
+
+inline
+void
+ReportOpsAndBytes(
+    benchmark::State& state,
+    double OpsPerIteration,
+    int64_t BytesPerIteration
+    )
+{
+    state.counters["FLOPS"] = benchmark::Counter(OpsPerIteration,
+        benchmark::Counter::kIsIterationInvariantRate, benchmark::Counter::OneK::kIs1000);
+    state.SetBytesProcessed(state.iterations() * BytesPerIteration);
+}
+
+template <typename T>
+std::vector<T>
+RandomVectorUniform(
+    size_t N,
+    T Min,
+    T Max
+    )
+{
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(N));
+    std::vector<T> v(N);
+
+    if (std::is_floating_point<T>::value) {
+        std::uniform_real_distribution<double> distribution(static_cast<double>(Min), static_cast<double>(Max));
+        for (auto& e : v) {
+            e = static_cast<T>(distribution(generator));
+        }
+    } else {
+        std::uniform_int_distribution<int64_t> distribution(static_cast<int64_t>(Min), static_cast<int64_t>(Max));
+        for (auto& e : v) {
+            e = static_cast<T>(distribution(generator));
+        }
+    }
+
+    return v;
+}
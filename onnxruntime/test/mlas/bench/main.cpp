@@ -0,0 +1,26 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    main.cpp
+
+Abstract:
+
+    This module implements the entry point of the MLAS micro-benchmarks.
+
+    Each benchmark reports a FLOPS counter, the rate of floating point (or
+    integer multiply-add) operations, and bytes_per_second, the rate of the
+    minimum memory traffic of the operation. Benchmarks that take a thread
+    count run MLAS on an ONNX Runtime thread pool with that many threads.
+    Use --benchmark_filter to select a subset and --benchmark_format=json
+    to record results for comparison.
+
+--*/
+
+#include <benchmark/benchmark.h>
+
+BENCHMARK_MAIN();
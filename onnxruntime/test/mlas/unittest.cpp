@@ -19,6 +19,8 @@ Abstract:
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <random>
+#include <cmath>
 #include <mlas.h>
 
 #if defined(_WIN32)
@@ -223,6 +225,12 @@ private:
         Test(CblasNoTrans, CblasTrans, M, N, K, alpha, A, K, B, K, beta, C, CReference, N);
         Test(CblasTrans, CblasNoTrans, M, N, K, alpha, A, M, B, N, beta, C, CReference, N);
         Test(CblasTrans, CblasTrans, M, N, K, alpha, A, M, B, K, beta, C, CReference, N);
+
+        const size_t BatchCount = 3;
+
+        TestBatch(M, N, K, alpha, beta, BatchCount,
+            BufferA.GetBuffer(K * M * BatchCount), BufferB.GetBuffer(N * K * BatchCount),
+            BufferC.GetBuffer(N * M * BatchCount), BufferCReference.GetBuffer(N * M * BatchCount));
     }
 
     void
@@ -255,6 +263,198 @@ private:
                 printf("mismatch TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, alpha=%f, beta=%f  %f %f!\n", TransA, TransB, M, N, K, alpha, beta, float(C[f]), float(CReference[f]));
             }
         }
+
+        TestPackedB(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, CReference, ldc);
+        TestEpilogue(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, CReference, ldc);
+    }
+
+    void
+    TestPackedB(
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        const float* A,
+        size_t lda,
+        const float* B,
+        size_t ldb,
+        float beta,
+        float* C,
+        const float* CReference,
+        size_t ldc
+        )
+    {
+        size_t PackedBSize = MlasGemmPackBSize(N, K);
+        void* PackedB = BufferBPacked.GetBuffer(PackedBSize / sizeof(float));
+        MlasGemmPackB(TransB, N, K, B, ldb, PackedB);
+
+        std::fill_n(C, M * N, -0.5f);
+
+        MlasGemm(TransA, M, N, K, alpha, A, lda, PackedB, beta, C, ldc, threadpool);
+
+        for (size_t f = 0; f < M * N; f++) {
+            // Sensitive to comparing positive/negative zero.
+            if (C[f] != CReference[f]) {
+                printf("mismatch PackedB TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, alpha=%f, beta=%f  %f %f!\n", TransA, TransB, M, N, K, alpha, beta, C[f], CReference[f]);
+            }
+        }
+    }
+
+    void
+    TestPackedB(
+        CBLAS_TRANSPOSE,
+        CBLAS_TRANSPOSE,
+        size_t,
+        size_t,
+        size_t,
+        float,
+        const double*,
+        size_t,
+        const double*,
+        size_t,
+        float,
+        double*,
+        const double*,
+        size_t
+        )
+    {
+        // packing B is only supported for single precision.
+    }
+
+    void
+    TestEpilogue(
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        const float* A,
+        size_t lda,
+        const float* B,
+        size_t ldb,
+        float beta,
+        float* C,
+        const float* CReference,
+        size_t ldc
+        )
+    {
+        const float* Bias = BufferBias.GetBuffer(N);
+        const float* Residual = BufferResidual.GetBuffer(M * N);
+
+        MLAS_ACTIVATION Activation;
+        Activation.ActivationKind = MlasReluActivation;
+
+        MLAS_GEMM_EPILOGUE Epilogue;
+        Epilogue.Bias = Bias;
+        Epilogue.Activation = &Activation;
+        Epilogue.Residual = Residual;
+        Epilogue.ldr = N;
+
+        size_t PackedBSize = MlasGemmPackBSize(N, K);
+        void* PackedB = BufferBPacked.GetBuffer(PackedBSize / sizeof(float));
+        MlasGemmPackB(TransB, N, K, B, ldb, PackedB);
+
+        for (int Packed = 0; Packed < 2; Packed++) {
+
+            std::fill_n(C, M * N, -0.5f);
+
+            if (Packed != 0) {
+                MlasGemm(TransA, M, N, K, alpha, A, lda, PackedB, beta, C, ldc, &Epilogue, threadpool);
+            } else {
+                MlasGemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, &Epilogue, threadpool);
+            }
+
+            for (size_t m = 0; m < M; m++) {
+                for (size_t n = 0; n < N; n++) {
+                    float Expected = std::max(CReference[m * ldc + n] + Bias[n], 0.0f) + Residual[m * N + n];
+                    if (C[m * ldc + n] != Expected) {
+                        printf("mismatch Epilogue Packed=%d TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, alpha=%f, beta=%f  %f %f!\n", Packed, TransA, TransB, M, N, K, alpha, beta, C[m * ldc + n], Expected);
+                    }
+                }
+            }
+        }
+    }
+
+    void
+    TestEpilogue(
+        CBLAS_TRANSPOSE,
+        CBLAS_TRANSPOSE,
+        size_t,
+        size_t,
+        size_t,
+        float,
+        const double*,
+        size_t,
+        const double*,
+        size_t,
+        float,
+        double*,
+        const double*,
+        size_t
+        )
+    {
+        // the epilogue is only supported for single precision.
+    }
+
+    void
+    TestBatch(
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        float beta,
+        size_t BatchCount,
+        const float* A,
+        const float* B,
+        float* C,
+        float* CReference
+        )
+    {
+        //
+        // Test with a distinct matrix B for each batch and with a single
+        // matrix B broadcast to every batch.
+        //
+
+        for (size_t StrideB : { N * K, size_t(0) }) {
+
+            std::fill_n(C, M * N * BatchCount, -0.5f);
+            std::fill_n(CReference, M * N * BatchCount, -0.5f);
+
+            MlasGemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, alpha, A, K, K * M,
+                B, N, StrideB, beta, C, N, N * M, BatchCount, threadpool);
+
+            for (size_t b = 0; b < BatchCount; b++) {
+                ReferenceGemm(CblasNoTrans, CblasNoTrans, M, N, K, alpha, A + K * M * b,
+                    K, B + StrideB * b, N, beta, CReference + N * M * b, N);
+            }
+
+            for (size_t f = 0; f < M * N * BatchCount; f++) {
+                // Sensitive to comparing positive/negative zero.
+                if (C[f] != CReference[f]) {
+                    printf("mismatch Batch M=%zd, N=%zd, K=%zd, alpha=%f, beta=%f, StrideB=%zd  %f %f!\n", M, N, K, alpha, beta, StrideB, C[f], CReference[f]);
+                }
+            }
+        }
+    }
+
+    void
+    TestBatch(
+        size_t,
+        size_t,
+        size_t,
+        float,
+        float,
+        size_t,
+        const double*,
+        const double*,
+        double*,
+        double*
+        )
+    {
+        // batching is only supported for single precision.
     }
 
     void
@@ -370,6 +570,9 @@ private:
     MatrixGuardBuffer<T> BufferB;
     MatrixGuardBuffer<T> BufferC;
     MatrixGuardBuffer<T> BufferCReference;
+    MatrixGuardBuffer<float> BufferBPacked;
+    MatrixGuardBuffer<float> BufferBias;
+    MatrixGuardBuffer<float> BufferResidual;
 
 public:
     void
@@ -913,6 +1116,34 @@ public:
             Test(1, 1, 16, i, i, 32, i, 1, 0, 0, 0, 0, 1, 1, 1, 1);
             Test(1, 1, 16, i, i, 32, 1, i, 0, 0, 0, 0, 1, 1, 1, 1);
         }
+
+        //
+        // Depthwise convolutions.
+        //
+
+        for (unsigned i = 1; i <= 36; i += 5) {
+            for (unsigned k = 3; k <= 5; k += 2) {
+                for (unsigned s = 1; s <= 2; s++) {
+                    for (unsigned d = 1; d <= 2; d++) {
+                        Test(2, 16, 1, i, i + 9, 1, k, k, k / 2, k / 2, k / 2, k / 2, d, d, s, s);
+                        Test(1, 32, 1, i + 9, i, 1, k, k, 0, 1, 1, 0, d, d, s, s);
+                    }
+                }
+            }
+        }
+
+        Test(1, 16, 1, 17, 33, 1, 3, 7, 1, 3, 1, 3, 1, 1, 3, 3);
+        Test(1, 16, 1, 17, 33, 1, 1, 1, 0, 0, 0, 0, 1, 1, 2, 2);
+
+        //
+        // Winograd convolutions with odd output sizes and asymmetric padding.
+        //
+
+        for (unsigned i = 4; i <= 32; i += 7) {
+            Test(2, 1, 16, i, i + 5, 32, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+            Test(1, 1, 32, i + 5, i, 16, 3, 3, 0, 1, 1, 0, 1, 1, 1, 1);
+            Test(3, 1, 48, i, i, 16, 3, 3, 0, 0, 0, 0, 1, 1, 1, 1);
+        }
     }
 
     void
@@ -968,6 +1199,113 @@ public:
     }
 };
 
+class MlasConv2DAlgorithmTest : public MlasConv2DTest
+{
+protected:
+    void
+    MlasConv2D(
+        size_t BatchCount,
+        size_t GroupCount,
+        size_t InputChannels,
+        size_t InputHeight,
+        size_t InputWidth,
+        size_t FilterCount,
+        size_t KernelHeight,
+        size_t KernelWidth,
+        size_t PaddingLeftHeight,
+        size_t PaddingLeftWidth,
+        size_t PaddingRightHeight,
+        size_t PaddingRightWidth,
+        size_t DilationHeight,
+        size_t DilationWidth,
+        size_t StrideHeight,
+        size_t StrideWidth,
+        size_t OutputHeight,
+        size_t OutputWidth,
+        const float* Input,
+        const float* Filter,
+        const float* Bias,
+        float* Output
+        ) override
+    {
+        int64_t InputShape[] = { int64_t(InputHeight), int64_t(InputWidth) };
+        int64_t KernelShape[] = { int64_t(KernelHeight), int64_t(KernelWidth) };
+        int64_t DilationShape[] = { int64_t(DilationHeight), int64_t(DilationWidth) };
+        int64_t Padding[] = { int64_t(PaddingLeftHeight), int64_t(PaddingLeftWidth), int64_t(PaddingRightHeight), int64_t(PaddingRightWidth) };
+        int64_t StrideShape[] = { int64_t(StrideHeight), int64_t(StrideWidth) };
+        int64_t OutputShape[] = { int64_t(OutputHeight), int64_t(OutputWidth) };
+
+        MLAS_ACTIVATION Activation;
+        Activation.ActivationKind = MlasIdentityActivation;
+
+        MLAS_CONV_PARAMETERS Parameters;
+        size_t WorkingBufferSize;
+
+        MlasConvPrepare(&Parameters,
+                        2,
+                        BatchCount,
+                        GroupCount,
+                        InputChannels,
+                        InputShape,
+                        KernelShape,
+                        DilationShape,
+                        Padding,
+                        StrideShape,
+                        OutputShape,
+                        FilterCount,
+                        &Activation,
+                        &WorkingBufferSize,
+                        threadpool);
+
+        //
+        // Keep the algorithm selected by MlasConvPrepare if the requested
+        // algorithm cannot compute the convolution.
+        //
+
+        MlasConvPrepareAlgorithm(&Parameters, Algorithm, ThreadCount, &WorkingBufferSize, threadpool);
+
+        MlasConv(&Parameters,
+                 Input,
+                 Filter,
+                 Bias,
+                 BufferWorking.GetBuffer(WorkingBufferSize),
+                 Output,
+                 threadpool);
+    }
+
+    MLAS_CONV_ALGORITHM Algorithm = MlasConvAlgorithmExpandThenGemmSegmented;
+    int32_t ThreadCount = 0;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        static const MLAS_CONV_ALGORITHM Algorithms[] = {
+            MlasConvAlgorithmGemmDirect,
+            MlasConvAlgorithmExpandThenGemm,
+            MlasConvAlgorithmExpandThenGemmSegmented,
+            MlasConvAlgorithmDepthwise,
+            MlasConvAlgorithmWinograd,
+        };
+        static const int32_t ThreadCounts[] = { 0, 1, 3 };
+
+        for (unsigned a = 0; a < _countof(Algorithms); a++) {
+            for (unsigned t = 0; t < _countof(ThreadCounts); t++) {
+                Algorithm = Algorithms[a];
+                ThreadCount = ThreadCounts[t];
+                Test(1, 1, 16, 9, 9, 32, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1);
+                Test(2, 1, 16, 11, 6, 32, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+                Test(1, 1, 32, 4, 4, 16, 3, 3, 0, 1, 1, 0, 1, 1, 1, 1);
+                Test(1, 1, 16, 13, 13, 16, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2);
+                Test(2, 16, 1, 12, 9, 1, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+                Test(1, 16, 1, 15, 15, 1, 5, 5, 2, 2, 2, 2, 2, 2, 1, 1);
+            }
+        }
+    }
+};
+
 class MlasNchwcConv2DTest : public MlasConv2DTest
 {
 protected:
@@ -1967,6 +2305,570 @@ public:
     }
 };
 
+class MlasSoftmaxTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferOutput;
+    MatrixGuardBuffer<float> BufferOutputReference;
+
+    void
+    Test(
+        size_t N,
+        size_t D,
+        float MinimumValue,
+        float MaximumValue
+        )
+    {
+        float* Input = BufferInput.GetBuffer(N * D);
+        float* Output = BufferOutput.GetBuffer(N * D);
+        float* OutputReference = BufferOutputReference.GetBuffer(N * D);
+
+        std::default_random_engine generator(static_cast<unsigned>(N * D));
+        std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+
+        for (size_t nd = 0; nd < N * D; nd++) {
+            Input[nd] = distribution(generator);
+        }
+
+        Test(Input, Output, OutputReference, N, D, false);
+        Test(Input, Output, OutputReference, N, D, true);
+    }
+
+    void
+    Test(
+        const float* Input,
+        float* Output,
+        float* OutputReference,
+        size_t N,
+        size_t D,
+        bool LogSoftmax
+        )
+    {
+        MlasComputeSoftmax(Input, Output, N, D, LogSoftmax, threadpool);
+        ReferenceSoftmax(Input, OutputReference, N, D, LogSoftmax);
+
+        constexpr float AbsoluteTolerance = 1e-6f;
+        constexpr float RelativeTolerance = 1e-6f;
+
+        for (size_t nd = 0; nd < N * D; nd++) {
+            float diff = std::fabs(Output[nd] - OutputReference[nd]);
+            if (diff > AbsoluteTolerance && diff > std::fabs(OutputReference[nd]) * RelativeTolerance) {
+                printf("mismatch %sSoftmax: N=%zd D=%zd nd=%zd %f %f\n",
+                    LogSoftmax ? "Log" : "", N, D, nd, Output[nd], OutputReference[nd]);
+                break;
+            }
+        }
+    }
+
+    void
+    ReferenceSoftmax(
+        const float* Input,
+        float* Output,
+        size_t N,
+        size_t D,
+        bool LogSoftmax
+        )
+    {
+        for (size_t n = 0; n < N; n++) {
+
+            float MaximumValue = std::numeric_limits<float>::lowest();
+
+            for (size_t d = 0; d < D; d++) {
+                MaximumValue = (std::max)(MaximumValue, Input[d]);
+            }
+
+            double Sum = 0.0;
+
+            for (size_t d = 0; d < D; d++) {
+                double e = std::exp(double(Input[d]) - double(MaximumValue));
+                Sum += e;
+                Output[d] = float(e);
+            }
+
+            if (LogSoftmax) {
+
+                float Scale = float(std::log(Sum));
+
+                for (size_t d = 0; d < D; d++) {
+                    Output[d] = Input[d] - MaximumValue - Scale;
+                }
+
+            } else {
+
+                float Scale = float(1.0 / Sum);
+
+                for (size_t d = 0; d < D; d++) {
+                    Output[d] = Output[d] * Scale;
+                }
+            }
+
+            Input += D;
+            Output += D;
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t d = 1; d < 128; d++) {
+            Test(1, d, -10.f, 10.f);
+        }
+
+        Test(3, 128, 20.f, 30.f);
+        Test(63, 95, -150.f, 190.f);
+        Test(16, 211, 20.f, 30.f);
+        Test(128, 384, -10.f, 10.f);
+    }
+};
+
+class MlasReduceTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferOutput;
+    MatrixGuardBuffer<int64_t> BufferIndexOutput;
+
+    void
+    Test(
+        size_t OuterCount,
+        size_t ReduceCount,
+        size_t InnerCount
+        )
+    {
+        const size_t InputElements = OuterCount * ReduceCount * InnerCount;
+        const size_t OutputElements = OuterCount * InnerCount;
+
+        float* Input = BufferInput.GetBuffer(InputElements);
+        float* Output = BufferOutput.GetBuffer(OutputElements);
+        int64_t* IndexOutput = BufferIndexOutput.GetBuffer(OutputElements);
+
+        //
+        // Use a small set of values so that the arg reductions see ties.
+        //
+
+        std::default_random_engine generator(static_cast<unsigned>(InputElements));
+        std::uniform_int_distribution<int> distribution(-32, 32);
+
+        for (size_t n = 0; n < InputElements; n++) {
+            Input[n] = float(distribution(generator)) * 0.25f;
+        }
+
+        static const MLAS_REDUCTION_KIND ReductionKinds[] = {
+            MlasSumReduction,
+            MlasSumSquareReduction,
+            MlasMeanReduction,
+            MlasMaximumReduction,
+            MlasMinimumReduction,
+        };
+
+        for (MLAS_REDUCTION_KIND ReductionKind : ReductionKinds) {
+
+            MlasReduce(ReductionKind, Input, Output, OuterCount, ReduceCount, InnerCount, threadpool);
+
+            for (size_t o = 0; o < OuterCount; o++) {
+                for (size_t i = 0; i < InnerCount; i++) {
+
+                    const float* input = Input + o * ReduceCount * InnerCount + i;
+
+                    double Reference = 0.0;
+
+                    if (ReductionKind == MlasMaximumReduction || ReductionKind == MlasMinimumReduction) {
+                        Reference = input[0];
+                    }
+
+                    for (size_t r = 0; r < ReduceCount; r++) {
+                        double Value = input[r * InnerCount];
+                        switch (ReductionKind) {
+                            case MlasSumReduction:
+                            case MlasMeanReduction:
+                                Reference += Value;
+                                break;
+                            case MlasSumSquareReduction:
+                                Reference += Value * Value;
+                                break;
+                            case MlasMaximumReduction:
+                                Reference = (std::max)(Reference, Value);
+                                break;
+                            case MlasMinimumReduction:
+                                Reference = (std::min)(Reference, Value);
+                                break;
+                        }
+                    }
+
+                    if (ReductionKind == MlasMeanReduction) {
+                        Reference /= double(ReduceCount);
+                    }
+
+                    float Value = Output[o * InnerCount + i];
+
+                    if (std::fabs(Value - Reference) > 1e-5 * (std::max)(1.0, std::fabs(Reference))) {
+                        printf("mismatch Reduce(%d): outer=%zd reduce=%zd inner=%zd %f %f\n",
+                            int(ReductionKind), OuterCount, ReduceCount, InnerCount, Value, Reference);
+                        return;
+                    }
+                }
+            }
+        }
+
+        static const MLAS_ARG_REDUCTION_KIND ArgReductionKinds[] = {
+            MlasArgMaximumReduction,
+            MlasArgMinimumReduction,
+        };
+
+        for (MLAS_ARG_REDUCTION_KIND ReductionKind : ArgReductionKinds) {
+
+            MlasArgReduce(ReductionKind, Input, IndexOutput, OuterCount, ReduceCount, InnerCount, threadpool);
+
+            for (size_t o = 0; o < OuterCount; o++) {
+                for (size_t i = 0; i < InnerCount; i++) {
+
+                    const float* input = Input + o * ReduceCount * InnerCount + i;
+
+                    size_t Reference = 0;
+
+                    for (size_t r = 1; r < ReduceCount; r++) {
+                        float Value = input[r * InnerCount];
+                        float Best = input[Reference * InnerCount];
+                        if ((ReductionKind == MlasArgMaximumReduction) ? (Value > Best) : (Value < Best)) {
+                            Reference = r;
+                        }
+                    }
+
+                    if (IndexOutput[o * InnerCount + i] != int64_t(Reference)) {
+                        printf("mismatch ArgReduce(%d): outer=%zd reduce=%zd inner=%zd %lld %zd\n",
+                            int(ReductionKind), OuterCount, ReduceCount, InnerCount,
+                            (long long)IndexOutput[o * InnerCount + i], Reference);
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t r = 1; r < 40; r++) {
+            Test(1, r, 1);
+            Test(3, r, 1);
+            Test(1, r, 7);
+            Test(2, r, 37);
+        }
+
+        Test(1, 768, 1);
+        Test(128, 768, 1);
+        Test(1, 128, 768);
+        Test(5, 49, 67);
+        Test(64, 1001, 3);
+        Test(2, 4, 9000);
+    }
+};
+
+class MlasHalfGemmTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<uint16_t> BufferA;
+    MatrixGuardBuffer<uint16_t> BufferB;
+    MatrixGuardBuffer<uint16_t> BufferC;
+    MatrixGuardBuffer<uint16_t> BufferCReference;
+    MatrixGuardBuffer<float> BufferFloat;
+
+    uint16_t
+    ToHalf(
+        MLAS_HALF_FORMAT Format,
+        float Value
+        )
+    {
+        uint16_t Half;
+        MlasConvertFloatToHalf(Format, &Value, &Half, 1);
+        return Half;
+    }
+
+    float
+    ToFloat(
+        MLAS_HALF_FORMAT Format,
+        uint16_t Half
+        )
+    {
+        float Value;
+        MlasConvertHalfToFloat(Format, &Half, &Value, 1);
+        return Value;
+    }
+
+    void
+    TestConversion(
+        MLAS_HALF_FORMAT Format
+        )
+    {
+        const uint16_t ExponentMask = (Format == MlasFloat16Format) ? 0x7C00 : 0x7F80;
+
+        uint16_t* Half = BufferA.GetBuffer(65536);
+        uint16_t* HalfRoundTrip = BufferB.GetBuffer(65536);
+        float* Float = BufferFloat.GetBuffer(65536);
+
+        for (size_t i = 0; i < 65536; i++) {
+            Half[i] = uint16_t(i);
+        }
+
+        MlasConvertHalfToFloat(Format, Half, Float, 65536);
+        MlasConvertFloatToHalf(Format, Float, HalfRoundTrip, 65536);
+
+        for (size_t i = 0; i < 65536; i++) {
+            bool IsNaN = (Half[i] & ExponentMask) == ExponentMask && (Half[i] & ~(ExponentMask | 0x8000)) != 0;
+            if (IsNaN ? !std::isnan(Float[i]) : (HalfRoundTrip[i] != Half[i])) {
+                printf("mismatch HalfConversion(%d): %04zx %04x\n", int(Format), i, HalfRoundTrip[i]);
+                break;
+            }
+        }
+
+        //
+        // Values halfway between two half precision values round to even.
+        //
+
+        const float Ulp = (Format == MlasFloat16Format) ? 1.0f / 1024.0f : 1.0f / 128.0f;
+
+        if (ToHalf(Format, 1.0f + Ulp * 0.5f) != ToHalf(Format, 1.0f) ||
+            ToHalf(Format, 1.0f + Ulp * 1.5f) != ToHalf(Format, 1.0f + Ulp * 2.0f) ||
+            ToHalf(Format, 1.0f + Ulp * 0.75f) != ToHalf(Format, 1.0f + Ulp)) {
+            printf("mismatch HalfConversion(%d): rounding\n", int(Format));
+        }
+    }
+
+    void
+    Test(
+        MLAS_HALF_FORMAT Format,
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t M,
+        size_t N,
+        size_t K,
+        float beta
+        )
+    {
+        uint16_t* A = BufferA.GetBuffer(M * K);
+        uint16_t* B = BufferB.GetBuffer(K * N);
+        uint16_t* C = BufferC.GetBuffer(M * N);
+        uint16_t* CReference = BufferCReference.GetBuffer(M * N);
+
+        //
+        // Use small integer values so that the single precision accumulation is
+        // exact and the result is rounded to half precision exactly once.
+        //
+
+        int v = -4;
+
+        for (size_t i = 0; i < M * K; i++) {
+            A[i] = ToHalf(Format, float(v));
+            v = (v == 4) ? -4 : v + 1;
+        }
+
+        for (size_t i = 0; i < K * N; i++) {
+            B[i] = ToHalf(Format, float(v));
+            v = (v == 3) ? -4 : v + 1;
+        }
+
+        for (size_t i = 0; i < M * N; i++) {
+            C[i] = ToHalf(Format, float(v));
+            v = (v == 4) ? -4 : v + 1;
+        }
+
+        const size_t lda = (TransA == CblasNoTrans) ? K : M;
+        const size_t ldb = (TransB == CblasNoTrans) ? N : K;
+
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < N; n++) {
+                float Sum = 0.0f;
+                for (size_t k = 0; k < K; k++) {
+                    uint16_t a = (TransA == CblasNoTrans) ? A[m * lda + k] : A[k * lda + m];
+                    uint16_t b = (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+                    Sum += ToFloat(Format, a) * ToFloat(Format, b);
+                }
+                if (beta != 0.0f) {
+                    Sum += beta * ToFloat(Format, C[m * N + n]);
+                }
+                CReference[m * N + n] = ToHalf(Format, Sum);
+            }
+        }
+
+        MlasHalfGemm(Format, TransA, TransB, M, N, K, 1.0f, A, lda, B, ldb, beta, C, N, threadpool);
+
+        for (size_t i = 0; i < M * N; i++) {
+            if (C[i] != CReference[i]) {
+                printf("mismatch HalfGemm(%d,%d,%d): M=%zd N=%zd K=%zd beta=%f i=%zd %04x %04x\n",
+                    int(Format), int(TransA), int(TransB), M, N, K, beta, i, C[i], CReference[i]);
+                break;
+            }
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        static const MLAS_HALF_FORMAT Formats[] = { MlasFloat16Format, MlasBFloat16Format };
+
+        for (MLAS_HALF_FORMAT Format : Formats) {
+
+            TestConversion(Format);
+
+            for (size_t b = 1; b < 20; b++) {
+                Test(Format, CblasNoTrans, CblasNoTrans, b, b, b, 0.0f);
+                Test(Format, CblasNoTrans, CblasTrans, b, b, b, 1.0f);
+                Test(Format, CblasTrans, CblasNoTrans, b, b, b, -0.5f);
+                Test(Format, CblasTrans, CblasTrans, b, b, b, 0.0f);
+            }
+
+            Test(Format, CblasNoTrans, CblasNoTrans, 1, 200, 300, 0.0f);
+            Test(Format, CblasNoTrans, CblasTrans, 1, 200, 300, 1.0f);
+            Test(Format, CblasNoTrans, CblasNoTrans, 70, 130, 257, 1.0f);
+            Test(Format, CblasTrans, CblasTrans, 130, 70, 129, -0.5f);
+            Test(Format, CblasNoTrans, CblasNoTrans, 16, 16, 0, 1.0f);
+        }
+    }
+};
+
+template<typename ElementType>
+class MlasTransposeTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<ElementType> BufferInput;
+    MatrixGuardBuffer<ElementType> BufferOutput;
+    MatrixGuardBuffer<ElementType> BufferOutputReference;
+
+    void
+    Test(
+        size_t BatchCount,
+        size_t M,
+        size_t N
+        )
+    {
+        ElementType* Input = BufferInput.GetBuffer(BatchCount * M * N);
+        ElementType* Output = BufferOutput.GetBuffer(BatchCount * M * N);
+        ElementType* OutputReference = BufferOutputReference.GetBuffer(BatchCount * M * N);
+
+        for (size_t i = 0; i < BatchCount * M * N; i++) {
+            Input[i] = ElementType(i * 7 + 1);
+        }
+
+        MlasTranspose(Input, Output, BatchCount, M, N, threadpool);
+        ReferenceTranspose(Input, OutputReference, BatchCount, M, N);
+
+        if (memcmp(Output, OutputReference, BatchCount * M * N * sizeof(ElementType)) != 0) {
+            printf("mismatch Transpose(%zd): batch=%zd M=%zd N=%zd\n", sizeof(ElementType), BatchCount, M, N);
+        }
+    }
+
+    void
+    ReferenceTranspose(
+        const ElementType* Input,
+        ElementType* Output,
+        size_t BatchCount,
+        size_t M,
+        size_t N
+        )
+    {
+        for (size_t b = 0; b < BatchCount; b++) {
+            for (size_t m = 0; m < M; m++) {
+                for (size_t n = 0; n < N; n++) {
+                    Output[n * M + m] = Input[m * N + n];
+                }
+            }
+            Input += M * N;
+            Output += M * N;
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t m = 1; m <= 37; m++) {
+            for (size_t n = 1; n <= 37; n++) {
+                Test(1, m, n);
+                Test(3, m, n);
+            }
+        }
+
+        Test(1, 1000, 1000);
+        Test(12, 128, 64);
+        Test(7, 129, 250);
+    }
+};
+
+class MlasReorderInputTest : public MlasTestBase
+{
+private:
+    const size_t BlockSize = MlasNchwcGetBlockSize();
+
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferOutput;
+    MatrixGuardBuffer<float> BufferOutputReference;
+
+    void
+    Test(
+        size_t BatchCount,
+        size_t Channels,
+        size_t Height,
+        size_t Width
+        )
+    {
+        size_t NchwcChannels = (Channels + BlockSize - 1) & ~(BlockSize - 1);
+        size_t SpatialSize = Height * Width;
+
+        size_t InputBufferElements = BatchCount * Channels * SpatialSize;
+        size_t OutputBufferElements = BatchCount * NchwcChannels * SpatialSize;
+
+        const float* Input = BufferInput.GetBuffer(InputBufferElements);
+        float* Output = BufferOutput.GetBuffer(OutputBufferElements);
+        float* OutputReference = BufferOutputReference.GetBuffer(OutputBufferElements);
+
+        int64_t NhwcInputShape[] = { int64_t(BatchCount), int64_t(Height), int64_t(Width), int64_t(Channels) };
+
+        std::fill_n(Output, OutputBufferElements, -0.5f);
+        std::fill_n(OutputReference, OutputBufferElements, 0.0f);
+
+        MlasReorderInputNhwc(NhwcInputShape, Input, Output);
+
+        for (size_t n = 0; n < BatchCount; n++) {
+            for (size_t hw = 0; hw < SpatialSize; hw++) {
+                for (size_t c = 0; c < Channels; c++) {
+                    size_t offset = ((c & ~(BlockSize - 1)) * SpatialSize) + (hw * BlockSize) + (c & (BlockSize - 1));
+                    OutputReference[n * NchwcChannels * SpatialSize + offset] =
+                        Input[(n * SpatialSize + hw) * Channels + c];
+                }
+            }
+        }
+
+        if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+            printf("mismatch ReorderInputNhwc: batch=%zd channels=%zd height=%zd width=%zd\n",
+                BatchCount, Channels, Height, Width);
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t c = 1; c < 48; c++) {
+            Test(1, c, 112, 112);
+            Test(4, c, 15, 21);
+        }
+    }
+};
+
 class MlasReorderOutputTest : public MlasTestBase
 {
 private:
@@ -2094,6 +2996,7 @@ main(
 
         printf("Conv2D tests.\n");
         onnxruntime::make_unique<MlasConv2DTest>()->ExecuteShort();
+        onnxruntime::make_unique<MlasConv2DAlgorithmTest>()->ExecuteShort();
         if (MlasNchwcGetBlockSize() > 1) {
           onnxruntime::make_unique<MlasNchwcConv2DTest>()->ExecuteShort();
         }
@@ -2107,6 +3010,19 @@ main(
         printf("Pool3D tests.\n");
         onnxruntime::make_unique<MlasPool3DTest>()->ExecuteShort();
 
+        printf("Softmax tests.\n");
+        onnxruntime::make_unique<MlasSoftmaxTest>()->ExecuteShort();
+
+        printf("Reduce tests.\n");
+        onnxruntime::make_unique<MlasReduceTest>()->ExecuteShort();
+
+        printf("HalfGemm tests.\n");
+        onnxruntime::make_unique<MlasHalfGemmTest>()->ExecuteShort();
+
+        printf("Transpose tests.\n");
+        onnxruntime::make_unique<MlasTransposeTest<uint32_t>>()->ExecuteShort();
+        onnxruntime::make_unique<MlasTransposeTest<uint64_t>>()->ExecuteShort();
+
         printf("Done.\n");
 #if !defined(MLAS_NO_ONNXRUNTIME_THREADPOOL)
         if(threadpool != nullptr) threadpool = new onnxruntime::concurrency::ThreadPool("test", 2);
@@ -2121,6 +3037,11 @@ main(
     printf("Activation tests.\n");
     onnxruntime::make_unique<MlasActivationTest>()->ExecuteShort();
 
+    printf("ReorderInput tests.\n");
+    if (MlasNchwcGetBlockSize() > 1) {
+        onnxruntime::make_unique<MlasReorderInputTest>()->ExecuteShort();
+    }
+
     printf("ReorderOutput tests.\n");
     if (MlasNchwcGetBlockSize() > 1) {
         onnxruntime::make_unique<MlasReorderOutputTest>()->ExecuteShort();
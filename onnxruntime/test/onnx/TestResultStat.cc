@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <vector>
@@ -57,3 +59,78 @@ std::string TestResultStat::ToString() {
   oss << "Failed Test Cases:" << containerToStr(failed_test_cases) << "\n";
   return oss.str();
 }
+
+bool TestResultStat::Save(const PATH_CHAR_TYPE* path) const {
+  std::ofstream ofs(path);
+  if (!ofs.good()) return false;
+  ofs << "total_test_case_count " << total_test_case_count << "\n"
+      << "total_model_count " << total_model_count << "\n"
+      << "succeeded " << succeeded << "\n"
+      << "not_implemented " << not_implemented << "\n"
+      << "load_model_failed " << load_model_failed << "\n"
+      << "throwed_exception " << throwed_exception << "\n"
+      << "result_differs " << result_differs << "\n"
+      << "skipped " << skipped << "\n"
+      << "invalid_graph " << invalid_graph << "\n";
+  std::lock_guard<onnxruntime::OrtMutex> l(m_);
+  for (const auto& s : not_implemented_kernels) {
+    ofs << "not_implemented_kernel " << s << "\n";
+  }
+  for (const auto& s : failed_kernels) {
+    ofs << "failed_kernel " << s << "\n";
+  }
+  // the version may be empty, or have spaces as in "unknown version"
+  for (const auto& p : failed_test_cases) {
+    ofs << "failed_test " << p.first << "\t" << p.second << "\n";
+  }
+  ofs.flush();
+  return ofs.good();
+}
+
+bool TestResultStat::Load(const PATH_CHAR_TYPE* path) {
+  std::ifstream ifs(path);
+  if (!ifs.good()) return false;
+  std::string line;
+  while (std::getline(ifs, line)) {
+    if (line.empty()) continue;
+    const size_t pos = line.find(' ');
+    if (pos == std::string::npos) return false;
+    const std::string key = line.substr(0, pos);
+    const std::string value = line.substr(pos + 1);
+    if (key == "not_implemented_kernel") {
+      AddNotImplementedKernels(value);
+    } else if (key == "failed_kernel") {
+      AddFailedKernels(value);
+    } else if (key == "failed_test") {
+      const size_t tab = value.find('\t');
+      if (tab == std::string::npos) return false;
+      AddFailedTest(std::make_pair(value.substr(0, tab), value.substr(tab + 1)));
+    } else {
+      char* end = nullptr;
+      const long long count = std::strtoll(value.c_str(), &end, 10);
+      if (end == value.c_str() || *end != '\0') return false;
+      if (key == "total_test_case_count") {
+        total_test_case_count = static_cast<size_t>(count);
+      } else if (key == "total_model_count") {
+        total_model_count = static_cast<size_t>(count);
+      } else if (key == "succeeded") {
+        succeeded = static_cast<int>(count);
+      } else if (key == "not_implemented") {
+        not_implemented = static_cast<int>(count);
+      } else if (key == "load_model_failed") {
+        load_model_failed = static_cast<int>(count);
+      } else if (key == "throwed_exception") {
+        throwed_exception = static_cast<int>(count);
+      } else if (key == "result_differs") {
+        result_differs = static_cast<int>(count);
+      } else if (key == "skipped") {
+        skipped = static_cast<int>(count);
+      } else if (key == "invalid_graph") {
+        invalid_graph = static_cast<int>(count);
+      } else {
+        return false;
+      }
+    }
+  }
+  return ifs.eof();
+}
@@ -8,6 +8,7 @@
 #include <string>
 #include <atomic>
 #include <core/platform/ort_mutex.h>
+#include <core/platform/path_lib.h>
 #include <cstring>
 #include <set>
 
@@ -47,6 +48,13 @@ class TestResultStat {
 
   std::string ToString();
 
+  // Writes the counters and the kernels and test cases of the stat to a text file, so that the stats of the shards
+  // of a test run, run in separate processes, can be merged with Load and operator+=. Returns false on I/O errors.
+  bool Save(const PATH_CHAR_TYPE* path) const;
+
+  // Reads a file written by Save into this stat, which must be empty. Returns false if it can't be read or parsed.
+  bool Load(const PATH_CHAR_TYPE* path);
+
   TestResultStat& operator += (const TestResultStat& result) {
     total_test_case_count += result.total_test_case_count;
     total_model_count     += result.total_model_count;
@@ -41,6 +41,10 @@ void usage() {
       "Default: 'cpu'.\n"
       "\t-x: Use parallel executor, default (without -x): sequential executor.\n"
       "\t-d [device_id]: Specifies the device id for multi-device (e.g. GPU). The value should > 0\n"
+      "\t-s [index]/[count]: Runs the test cases of the shard [index] out of [count], from 0, to split a test suite "
+      "across processes.\n"
+      "\t-w [report_file]: Writes the results to a report file, which -m merges.\n"
+      "\t-m: Merges the report files given in place of the data dirs, and reports the results like a test run.\n"
       "\t-o [optimization level]: Default is 99. Valid values are 0 (disable), 1 (basic), 2 (extended), 99 (all).\n"
       "\t\tPlease see onnxruntime_c_api.h (enum GraphOptimizationLevel) for the full list of all optimization levels. "
       "\n"
@@ -105,11 +109,15 @@ int real_main(int argc, char* argv[], Ort::Env& env) {
   GraphOptimizationLevel graph_optimization_level = ORT_DISABLE_ALL;
   bool user_graph_optimization_level_set = false;
   int verbosity_option_count = 0;
+  size_t shard_index = 0;
+  size_t shard_count = 1;
+  std::basic_string<PATH_CHAR_TYPE> report_file;
+  bool merge_reports = false;
 
   OrtLoggingLevel logging_level = ORT_LOGGING_LEVEL_WARNING;
   {
     int ch;
-    while ((ch = getopt(argc, argv, ORT_TSTR("Ac:hj:Mn:r:e:xvo:d:"))) != -1) {
+    while ((ch = getopt(argc, argv, ORT_TSTR("Ac:hj:Mn:r:e:xvo:d:s:w:m"))) != -1) {
       switch (ch) {
         case 'A':
           enable_cpu_mem_arena = false;
@@ -210,6 +218,24 @@ int real_main(int argc, char* argv[], Ort::Env& env) {
             return -1;
           }
           break;
+        case 's': {
+          PATH_CHAR_TYPE* end = nullptr;
+          long index = OrtStrtol<PATH_CHAR_TYPE>(optarg, &end);
+          long count = *end == '/' ? OrtStrtol<PATH_CHAR_TYPE>(end + 1, &end) : 0;
+          if (*end != '\0' || index < 0 || count <= 0 || index >= count) {
+            usage();
+            return -1;
+          }
+          shard_index = static_cast<size_t>(index);
+          shard_count = static_cast<size_t>(count);
+          break;
+        }
+        case 'w':
+          report_file = optarg;
+          break;
+        case 'm':
+          merge_reports = true;
+          break;
         case '?':
         case 'h':
         default:
@@ -234,7 +260,7 @@ int real_main(int argc, char* argv[], Ort::Env& env) {
   argc -= optind;
   argv += optind;
   if (argc < 1) {
-    fprintf(stderr, "please specify a test data dir\n");
+    fprintf(stderr, merge_reports ? "please specify the report files to merge\n" : "please specify a test data dir\n");
     usage();
     return -1;
   }
@@ -252,7 +278,19 @@ int real_main(int argc, char* argv[], Ort::Env& env) {
   for (int i = 0; i != argc; ++i) {
     data_dirs.emplace_back(argv[i]);
   }
-  {
+  if (merge_reports) {
+    // the failed tests of the shards are checked against the broken tests below, like those of a run
+    for (const auto& path : data_dirs) {
+      TestResultStat shard_stat;
+      if (!shard_stat.Load(path.c_str())) {
+        fprintf(stderr, "failed to read the report file %s\n", ToMBString(path).c_str());
+        return -1;
+      }
+      stat += shard_stat;
+    }
+    std::string res = stat.ToString();
+    fwrite(res.c_str(), 1, res.size(), stdout);
+  } else {
     double per_sample_tolerance = 1e-3;
     // when cuda is enabled, set it to a larger value for resolving random MNIST test failure
     // when openvino is enabled, set it to a larger value for resolving MNIST accuracy mismatch
@@ -422,6 +460,7 @@ int real_main(int argc, char* argv[], Ort::Env& env) {
 
     std::vector<ITestCase*> tests;
     LoadTests(data_dirs, whitelisted_test_cases, per_sample_tolerance, relative_per_sample_tolerance, all_disabled_tests,
+              GetDefaultThreadPool(Env::Default()), shard_index, shard_count,
               [&tests](ITestCase* l) { tests.push_back(l); });
 
     TestEnv args(tests, stat, env, sf);
@@ -436,6 +475,10 @@ int real_main(int argc, char* argv[], Ort::Env& env) {
     }
     std::string res = stat.ToString();
     fwrite(res.c_str(), 1, res.size(), stdout);
+    if (!report_file.empty() && !stat.Save(report_file.c_str())) {
+      fprintf(stderr, "failed to write the report file %s\n", ToMBString(report_file).c_str());
+      return -1;
+    }
   }
 
   struct BrokenTest {
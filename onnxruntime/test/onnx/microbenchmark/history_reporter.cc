@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "history_reporter.h"
+
+#include <core/session/onnxruntime_c_api.h>
+
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+namespace {
+
+std::string EscapeJson(const std::string& s) {
+  std::ostringstream ss;
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      ss << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      ss << ' ';
+    } else {
+      ss << c;
+    }
+  }
+  return ss.str();
+}
+
+std::string CurrentDate() {
+  std::time_t now = std::time(nullptr);
+  std::tm tm;
+#ifdef _WIN32
+  gmtime_s(&tm, &now);
+#else
+  gmtime_r(&now, &tm);
+#endif
+  char date[32];
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", &tm);
+  return date;
+}
+
+}  // namespace
+
+// all the runs of an invocation share its date
+HistoryReporter::HistoryReporter(std::string path, std::string label)
+    : path_(std::move(path)), label_(std::move(label)), date_(CurrentDate()) {}
+
+void HistoryReporter::ReportRuns(const std::vector<Run>& runs) {
+  ConsoleReporter::ReportRuns(runs);
+
+  std::ofstream history(path_, std::ofstream::out | std::ofstream::app);
+  if (!history.good()) {
+    GetErrorStream() << "failed to open the history file " << path_ << std::endl;
+    return;
+  }
+
+  for (const auto& run : runs) {
+    history << "{\"date\": \"" << date_ << "\", \"version\": \"" << OrtGetApiBase()->GetVersionString()
+            << "\", \"label\": \"" << EscapeJson(label_) << "\", \"name\": \"" << EscapeJson(run.benchmark_name())
+            << "\", \"iterations\": " << run.iterations << ", \"real_time\": " << run.GetAdjustedRealTime()
+            << ", \"cpu_time\": " << run.GetAdjustedCPUTime() << ", \"time_unit\": \""
+            << benchmark::GetTimeUnitString(run.time_unit) << "\", \"error\": \""
+            << (run.error_occurred ? EscapeJson(run.error_message) : "") << "\"}" << std::endl;
+  }
+}
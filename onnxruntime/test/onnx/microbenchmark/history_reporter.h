@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+// Reports the runs on the console like the default reporter, and appends them to a history file so the results of
+// successive builds or onnxruntime versions can be compared. Each run is a line holding a JSON object:
+//   {"date": "2020-03-01T12:00:00Z", "version": "1.2.0", "label": "...", "name": "BM_ModelZoo/resnet50/cpu",
+//    "iterations": 100, "real_time": 12.5, "cpu_time": 48.1, "time_unit": "ms", "error": ""}
+// where version is the onnxruntime version and label a free text given on the command line, e.g. a commit.
+class HistoryReporter : public benchmark::ConsoleReporter {
+ public:
+  HistoryReporter(std::string path, std::string label);
+
+  void ReportRuns(const std::vector<Run>& runs) override;
+
+ private:
+  std::string path_;
+  std::string label_;
+  std::string date_;
+};
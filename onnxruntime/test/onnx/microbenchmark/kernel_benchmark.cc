@@ -0,0 +1,172 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "kernel_benchmark.h"
+
+#include <core/framework/op_kernel_context_internal.h>
+#include <core/framework/run_options.h>
+#include <core/framework/session_state.h>
+#include <core/framework/utils.h>
+#include <core/graph/model.h>
+#include <core/session/inference_session.h>
+#include <core/session/ort_env.h>
+
+#include <algorithm>
+#include <sstream>
+
+#include "test/util/include/default_providers.h"
+
+extern OrtEnv* env;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+constexpr const char* kNodeName = "node1";
+
+// gives access to the session state the kernels live in
+class KernelBenchmarkSession : public InferenceSession {
+ public:
+  using InferenceSession::InferenceSession;
+
+  const SessionState& GetSessionState() const { return *session_state_; }
+};
+
+std::unique_ptr<IExecutionProvider> CreateExecutionProvider(const std::string& provider_type) {
+  if (provider_type == kCpuExecutionProvider)
+    return DefaultCpuExecutionProvider();
+  if (provider_type == kCudaExecutionProvider)
+    return DefaultCudaExecutionProvider();
+  if (provider_type == kDnnlExecutionProvider)
+    return DefaultDnnlExecutionProvider();
+  return nullptr;
+}
+
+}  // namespace
+
+KernelBenchmark::KernelBenchmark(const char* op, int opset_version, const char* domain)
+    : op_(op), opset_version_(opset_version), domain_(domain) {}
+
+std::unique_ptr<Model> KernelBenchmark::BuildModel() {
+  std::vector<NodeArg*> input_defs;
+  for (auto& input : inputs_) {
+    input_defs.push_back(&input.def);
+  }
+  std::vector<NodeArg*> output_defs;
+  for (auto& output : outputs_) {
+    output_defs.push_back(&output);
+  }
+
+  auto model = onnxruntime::make_unique<Model>(
+      "kernel_benchmark", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+      std::unordered_map<std::string, int>{{domain_, opset_version_}}, std::vector<ONNX_NAMESPACE::FunctionProto>{},
+      logging::LoggingManager::DefaultLogger());
+  Node& node = model->MainGraph().AddNode(kNodeName, op_, op_, input_defs, output_defs, nullptr, domain_);
+  for (auto& add_attribute_fn : add_attribute_funcs_) {
+    add_attribute_fn(node);
+  }
+  return model;
+}
+
+void KernelBenchmark::Run(benchmark::State& state, const std::string& provider_type) {
+  try {
+    Status status = RunImpl(state, provider_type);
+    if (!status.IsOK()) {
+      state.SkipWithError(status.ErrorMessage().c_str());
+    }
+  } catch (const std::exception& ex) {
+    state.SkipWithError(ex.what());
+  }
+}
+
+Status KernelBenchmark::RunImpl(benchmark::State& state, const std::string& provider_type) {
+  std::unique_ptr<IExecutionProvider> execution_provider = CreateExecutionProvider(provider_type);
+  if (execution_provider == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "The execution provider ", provider_type,
+                           " isn't enabled in this build");
+  }
+  // owned by the session from now on
+  IExecutionProvider& provider = *execution_provider;
+
+  std::unique_ptr<Model> model = BuildModel();
+  ORT_RETURN_IF_ERROR(model->MainGraph().Resolve());
+  std::string model_data;
+  model->ToProto().SerializeToString(&model_data);
+  std::istringstream model_stream(model_data);
+
+  SessionOptions session_options;
+  session_options.session_logid = "KernelBenchmark";
+  // no rewrite of the node, e.g. to the NCHWc layout, so the kernel timed is the one of the op
+  session_options.graph_optimization_level = TransformerLevel::Default;
+  session_options.enable_mem_pattern = false;
+  KernelBenchmarkSession session(session_options, env->GetEnvironment());
+  ORT_RETURN_IF_ERROR(session.RegisterExecutionProvider(std::move(execution_provider)));
+  ORT_RETURN_IF_ERROR(session.Load(model_stream));
+  ORT_RETURN_IF_ERROR(session.Initialize());
+
+  const SessionState& session_state = session.GetSessionState();
+  const auto& steps = session_state.GetExecutionSteps();
+  auto target = std::find_if(steps.begin(), steps.end(), [](const SessionState::ExecutionStep& step) {
+    return step.node->Name() == kNodeName;
+  });
+  if (target == steps.end()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The ", op_, " node was removed from the graph");
+  }
+  if (target->node->GetExecutionProviderType() != provider_type) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "The execution provider ", provider_type,
+                           " has no kernel for ", op_, " with these inputs");
+  }
+
+  // the feeds are copied to the device of the kernel once, like the session does on each run
+  const OrtValueNameIdxMap& name_idx_map = session_state.GetOrtValueNameIdxMap();
+  std::vector<int> feed_mlvalue_idxs;
+  std::vector<OrtValue> feeds;
+  for (const auto& input : inputs_) {
+    if (!input.def.Exists()) {
+      continue;
+    }
+    int idx;
+    ORT_RETURN_IF_ERROR(name_idx_map.GetIdx(input.def.Name(), idx));
+    OrtValue feed;
+    ORT_RETURN_IF_ERROR(utils::CopyOneInputAcrossDevices(session_state, input.def.Name(), input.value, feed));
+    feed_mlvalue_idxs.push_back(idx);
+    feeds.push_back(std::move(feed));
+  }
+
+  // the outputs aren't fetched: they stay in the frame, where the kernel finds them allocated with the same shapes
+  // on the next iterations
+  std::vector<OrtValue> fetches;
+  auto frame = session_state.GetExecutionFramePool().Acquire(feed_mlvalue_idxs, feeds, {}, fetches, {},
+                                                             session_state);
+  const logging::Logger& logger = session_state.Logger();
+  const bool terminate_flag = false;
+
+  RunOptions run_options;
+  ORT_RETURN_IF_ERROR(provider.OnRunStart(run_options));
+  Status status;
+  // nodes inserted before the op, e.g. casts, run once
+  for (auto step = steps.begin(); step != target && status.IsOK(); ++step) {
+    OpKernelContextInternal context(session_state, *frame, *step, logger, terminate_flag);
+    status = step->kernel->Compute(&context);
+  }
+  if (status.IsOK()) {
+    for (auto _ : state) {
+      OpKernelContextInternal context(session_state, *frame, *target, logger, terminate_flag);
+      status = target->kernel->Compute(&context);
+      if (status.IsOK()) {
+        // the kernels of the devices return once their work is queued
+        status = provider.Sync();
+      }
+      if (!status.IsOK()) {
+        break;
+      }
+    }
+  }
+  Status end_status = provider.OnRunEnd();
+  ORT_RETURN_IF_ERROR(status);
+  return end_status;
+}
+
+}  // namespace test
+}  // namespace onnxruntime
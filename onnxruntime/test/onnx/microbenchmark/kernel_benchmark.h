@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <core/common/common.h>
+#include <core/framework/allocator.h>
+#include <core/framework/data_types.h>
+#include <core/framework/ml_value.h>
+#include <core/framework/tensor.h>
+#include <core/graph/constants.h>
+#include <core/graph/graph.h>
+#include <core/graph/node_arg.h>
+
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace onnxruntime {
+class Model;
+
+namespace test {
+
+// Times the Compute method of the kernel of a single operator. It is set up like OpTester: the op, its attributes,
+// its inputs and its outputs are added, then Run builds a model holding the node, initializes a session on the
+// execution provider, and calls Compute of the kernel on each iteration. The feeds are copied to the device, and the
+// execution frame is created, before the timed loop, so the timings are those of the kernel without the graph
+// effects. e.g.
+//   KernelBenchmark bm("Softmax", 11);
+//   bm.AddAttribute("axis", int64_t{1});
+//   bm.AddRandomInput<float>("input", {64, 1000});
+//   bm.AddOutput<float>("output");
+//   bm.Run(state, kCpuExecutionProvider);
+class KernelBenchmark {
+ public:
+  explicit KernelBenchmark(const char* op, int opset_version = 11, const char* domain = kOnnxDomain);
+  KernelBenchmark(KernelBenchmark&&) = default;
+
+  template <typename T>
+  void AddAttribute(std::string name, T value) {
+    add_attribute_funcs_.emplace_back([name = std::move(name), value = std::move(value)](Node& node) {
+      node.AddAttribute(name, value);
+    });
+  }
+
+  template <typename T>
+  void AddInput(const char* name, const std::vector<int64_t>& dims, const std::vector<T>& values) {
+    TensorShape shape(dims);
+    ORT_ENFORCE(shape.Size() == static_cast<int64_t>(values.size()), values.size(),
+                " input values doesn't match tensor size of ", shape.Size());
+
+    auto p_tensor = onnxruntime::make_unique<Tensor>(DataTypeImpl::GetType<T>(), shape, allocator_);
+    T* data = p_tensor->template MutableData<T>();
+    for (size_t i = 0; i != values.size(); ++i) {
+      data[i] = values[i];
+    }
+
+    OrtValue value;
+    value.Init(p_tensor.release(), DataTypeImpl::GetType<Tensor>(), DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+    auto type_proto = TensorTypeProto<T>(&dims);
+    inputs_.push_back(Input{NodeArg(name, &type_proto), std::move(value)});
+  }
+
+  // Input with values drawn uniformly from [low, high). The values are the same on every run.
+  template <typename T>
+  void AddRandomInput(const char* name, const std::vector<int64_t>& dims, double low = -1.0, double high = 1.0) {
+    std::vector<T> values(static_cast<size_t>(TensorShape(dims).Size()));
+    std::uniform_real_distribution<double> distribution(low, high);
+    for (auto& value : values) {
+      value = static_cast<T>(distribution(engine_));
+    }
+    AddInput<T>(name, dims, values);
+  }
+
+  template <typename T>
+  void AddMissingOptionalInput() {
+    auto type_proto = TensorTypeProto<T>(nullptr);
+    inputs_.push_back(Input{NodeArg(std::string(), &type_proto), OrtValue()});
+  }
+
+  // The output shapes come from the shape inference of the op.
+  template <typename T>
+  void AddOutput(const char* name) {
+    auto type_proto = TensorTypeProto<T>(nullptr);
+    outputs_.emplace_back(name, &type_proto);
+  }
+
+  // Reports the errors, e.g. a provider without a kernel for the op, with state.SkipWithError.
+  void Run(benchmark::State& state, const std::string& provider_type);
+
+ private:
+  struct Input {
+    NodeArg def;
+    OrtValue value;
+  };
+
+  template <typename T>
+  static ONNX_NAMESPACE::TypeProto TensorTypeProto(const std::vector<int64_t>* dims) {
+    ONNX_NAMESPACE::TypeProto type_proto(*DataTypeImpl::GetTensorType<T>()->GetTypeProto());
+    if (dims != nullptr) {
+      auto* shape = type_proto.mutable_tensor_type()->mutable_shape();
+      for (int64_t dim : *dims) {
+        shape->add_dim()->set_dim_value(dim);
+      }
+    }
+    return type_proto;
+  }
+
+  std::unique_ptr<Model> BuildModel();
+
+  common::Status RunImpl(benchmark::State& state, const std::string& provider_type);
+
+  std::string op_;
+  int opset_version_;
+  std::string domain_;
+  std::vector<std::function<void(Node& node)>> add_attribute_funcs_;
+  std::vector<Input> inputs_;
+  std::vector<NodeArg> outputs_;
+
+  AllocatorPtr allocator_ = std::make_shared<CPUAllocator>();
+  std::mt19937 engine_;
+};
+
+}  // namespace test
+}  // namespace onnxruntime
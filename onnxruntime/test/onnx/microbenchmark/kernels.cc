@@ -0,0 +1,353 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Benchmarks of the kernels of the ops that take most of the time of our workloads, on each execution provider of
+// the build. The shapes are those of the models they come from: ResNet-50 for the convolutional ops, BERT base with a
+// sequence length of 128 for the transformer ops.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/constants.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "kernel_benchmark.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+// 3x3 convolution of the second stage of ResNet-50
+KernelBenchmark Conv() {
+  KernelBenchmark bm("Conv");
+  bm.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+  bm.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+  bm.AddRandomInput<float>("X", {1, 128, 28, 28});
+  bm.AddRandomInput<float>("W", {128, 128, 3, 3});
+  bm.AddRandomInput<float>("B", {128});
+  bm.AddOutput<float>("Y");
+  return bm;
+}
+
+// feed forward expansion of BERT
+KernelBenchmark MatMul() {
+  KernelBenchmark bm("MatMul");
+  bm.AddRandomInput<float>("A", {1, 128, 768});
+  bm.AddRandomInput<float>("B", {768, 3072});
+  bm.AddOutput<float>("Y");
+  return bm;
+}
+
+// classifier of ResNet-50
+KernelBenchmark Gemm() {
+  KernelBenchmark bm("Gemm");
+  bm.AddAttribute("transB", int64_t{1});
+  bm.AddRandomInput<float>("A", {1, 2048});
+  bm.AddRandomInput<float>("B", {1000, 2048});
+  bm.AddRandomInput<float>("C", {1000});
+  bm.AddOutput<float>("Y");
+  return bm;
+}
+
+// bias of a projection
+KernelBenchmark Add() {
+  KernelBenchmark bm("Add");
+  bm.AddRandomInput<float>("A", {1, 128, 768});
+  bm.AddRandomInput<float>("B", {768});
+  bm.AddOutput<float>("C");
+  return bm;
+}
+
+KernelBenchmark Mul() {
+  KernelBenchmark bm("Mul");
+  bm.AddRandomInput<float>("A", {1, 128, 768});
+  bm.AddRandomInput<float>("B", {1, 128, 768});
+  bm.AddOutput<float>("C");
+  return bm;
+}
+
+// centering of the layer normalization subgraph
+KernelBenchmark Sub() {
+  KernelBenchmark bm("Sub");
+  bm.AddRandomInput<float>("A", {1, 128, 768});
+  bm.AddRandomInput<float>("B", {1, 128, 1});
+  bm.AddOutput<float>("C");
+  return bm;
+}
+
+KernelBenchmark Div() {
+  KernelBenchmark bm("Div");
+  bm.AddRandomInput<float>("A", {1, 128, 768});
+  bm.AddRandomInput<float>("B", {1, 128, 1}, 0.5, 1.5);
+  bm.AddOutput<float>("C");
+  return bm;
+}
+
+KernelBenchmark Relu() {
+  KernelBenchmark bm("Relu");
+  bm.AddRandomInput<float>("X", {1, 256, 56, 56});
+  bm.AddOutput<float>("Y");
+  return bm;
+}
+
+KernelBenchmark Sigmoid() {
+  KernelBenchmark bm("Sigmoid");
+  bm.AddRandomInput<float>("X", {1, 128, 3072});
+  bm.AddOutput<float>("Y");
+  return bm;
+}
+
+KernelBenchmark Tanh() {
+  KernelBenchmark bm("Tanh");
+  bm.AddRandomInput<float>("input", {1, 128, 3072});
+  bm.AddOutput<float>("output");
+  return bm;
+}
+
+// GELU subgraph of the models exported without the fused op
+KernelBenchmark Erf() {
+  KernelBenchmark bm("Erf");
+  bm.AddRandomInput<float>("input", {1, 128, 3072});
+  bm.AddOutput<float>("output");
+  return bm;
+}
+
+KernelBenchmark Sqrt() {
+  KernelBenchmark bm("Sqrt");
+  bm.AddRandomInput<float>("X", {1, 128, 3072}, 0.0, 1.0);
+  bm.AddOutput<float>("Y");
+  return bm;
+}
+
+// variance of the layer normalization subgraph
+KernelBenchmark Pow() {
+  KernelBenchmark bm("Pow");
+  bm.AddRandomInput<float>("X", {1, 128, 768});
+  bm.AddInput<float>("Y", {}, {2.0f});
+  bm.AddOutput<float>("Z");
+  return bm;
+}
+
+// attention probabilities of the 12 heads
+KernelBenchmark Softmax() {
+  KernelBenchmark bm("Softmax");
+  bm.AddAttribute("axis", int64_t{3});
+  bm.AddRandomInput<float>("input", {1, 12, 128, 128});
+  bm.AddOutput<float>("output");
+  return bm;
+}
+
+KernelBenchmark BatchNormalization() {
+  KernelBenchmark bm("BatchNormalization");
+  bm.AddRandomInput<float>("X", {1, 256, 56, 56});
+  bm.AddRandomInput<float>("scale", {256});
+  bm.AddRandomInput<float>("B", {256});
+  bm.AddRandomInput<float>("mean", {256});
+  bm.AddRandomInput<float>("var", {256}, 0.5, 1.5);
+  bm.AddOutput<float>("Y");
+  return bm;
+}
+
+// stem of ResNet-50
+KernelBenchmark MaxPool() {
+  KernelBenchmark bm("MaxPool");
+  bm.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+  bm.AddAttribute("strides", std::vector<int64_t>{2, 2});
+  bm.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+  bm.AddRandomInput<float>("X", {1, 64, 112, 112});
+  bm.AddOutput<float>("Y");
+  return bm;
+}
+
+KernelBenchmark AveragePool() {
+  KernelBenchmark bm("AveragePool");
+  bm.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+  bm.AddAttribute("strides", std::vector<int64_t>{2, 2});
+  bm.AddRandomInput<float>("X", {1, 256, 56, 56});
+  bm.AddOutput<float>("Y");
+  return bm;
+}
+
+KernelBenchmark GlobalAveragePool() {
+  KernelBenchmark bm("GlobalAveragePool");
+  bm.AddRandomInput<float>("X", {1, 2048, 7, 7});
+  bm.AddOutput<float>("Y");
+  return bm;
+}
+
+KernelBenchmark Concat() {
+  KernelBenchmark bm("Concat");
+  bm.AddAttribute("axis", int64_t{1});
+  bm.AddRandomInput<float>("input0", {1, 128, 56, 56});
+  bm.AddRandomInput<float>("input1", {1, 128, 56, 56});
+  bm.AddOutput<float>("concat_result");
+  return bm;
+}
+
+// split of the hidden state into the attention heads
+KernelBenchmark Reshape() {
+  KernelBenchmark bm("Reshape");
+  bm.AddRandomInput<float>("data", {1, 128, 768});
+  bm.AddInput<int64_t>("shape", {4}, {1, 128, 12, 64});
+  bm.AddOutput<float>("reshaped");
+  return bm;
+}
+
+KernelBenchmark Transpose() {
+  KernelBenchmark bm("Transpose");
+  bm.AddAttribute("perm", std::vector<int64_t>{0, 2, 1, 3});
+  bm.AddRandomInput<float>("data", {1, 128, 12, 64});
+  bm.AddOutput<float>("transposed");
+  return bm;
+}
+
+// word embedding lookup
+KernelBenchmark Gather() {
+  KernelBenchmark bm("Gather");
+  bm.AddRandomInput<float>("data", {30522, 768});
+  bm.AddRandomInput<int64_t>("indices", {1, 128}, 0.0, 30522.0);
+  bm.AddOutput<float>("output");
+  return bm;
+}
+
+KernelBenchmark Slice() {
+  KernelBenchmark bm("Slice");
+  bm.AddRandomInput<float>("data", {1, 128, 768});
+  bm.AddInput<int64_t>("starts", {1}, {0});
+  bm.AddInput<int64_t>("ends", {1}, {64});
+  bm.AddInput<int64_t>("axes", {1}, {1});
+  bm.AddOutput<float>("output");
+  return bm;
+}
+
+KernelBenchmark ReduceMean() {
+  KernelBenchmark bm("ReduceMean");
+  bm.AddAttribute("axes", std::vector<int64_t>{-1});
+  bm.AddRandomInput<float>("data", {1, 128, 768});
+  bm.AddOutput<float>("reduced");
+  return bm;
+}
+
+// attention mask
+KernelBenchmark Cast() {
+  KernelBenchmark bm("Cast");
+  bm.AddAttribute("to", static_cast<int64_t>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT));
+  bm.AddRandomInput<int64_t>("input", {1, 12, 128, 128}, 0.0, 2.0);
+  bm.AddOutput<float>("output");
+  return bm;
+}
+
+// ReLU6 of MobileNet
+KernelBenchmark Clip() {
+  KernelBenchmark bm("Clip");
+  bm.AddRandomInput<float>("input", {1, 256, 56, 56}, -1.0, 8.0);
+  bm.AddInput<float>("min", {}, {0.0f});
+  bm.AddInput<float>("max", {}, {6.0f});
+  bm.AddOutput<float>("output");
+  return bm;
+}
+
+// query, key and value of a fused projection
+KernelBenchmark Split() {
+  KernelBenchmark bm("Split");
+  bm.AddAttribute("axis", int64_t{2});
+  bm.AddRandomInput<float>("input", {1, 128, 2304});
+  bm.AddOutput<float>("output0");
+  bm.AddOutput<float>("output1");
+  bm.AddOutput<float>("output2");
+  return bm;
+}
+
+KernelBenchmark LSTM() {
+  KernelBenchmark bm("LSTM");
+  bm.AddAttribute("hidden_size", int64_t{256});
+  bm.AddRandomInput<float>("X", {32, 1, 256});
+  bm.AddRandomInput<float>("W", {1, 1024, 256});
+  bm.AddRandomInput<float>("R", {1, 1024, 256});
+  bm.AddRandomInput<float>("B", {1, 2048});
+  bm.AddOutput<float>("Y");
+  return bm;
+}
+
+KernelBenchmark LayerNormalization() {
+  KernelBenchmark bm("LayerNormalization");
+  bm.AddAttribute("axis", int64_t{-1});
+  bm.AddAttribute("epsilon", 1e-12f);
+  bm.AddRandomInput<float>("X", {1, 128, 768});
+  bm.AddRandomInput<float>("scale", {768});
+  bm.AddRandomInput<float>("B", {768});
+  bm.AddOutput<float>("Y");
+  return bm;
+}
+
+KernelBenchmark Gelu() {
+  KernelBenchmark bm("Gelu", 1, kMSDomain);
+  bm.AddRandomInput<float>("X", {1, 128, 3072});
+  bm.AddOutput<float>("Y");
+  return bm;
+}
+
+struct KernelCase {
+  const char* name;
+  KernelBenchmark (*create)();
+};
+
+const KernelCase kKernels[] = {
+    {"Conv", Conv},
+    {"MatMul", MatMul},
+    {"Gemm", Gemm},
+    {"Add", Add},
+    {"Mul", Mul},
+    {"Sub", Sub},
+    {"Div", Div},
+    {"Relu", Relu},
+    {"Sigmoid", Sigmoid},
+    {"Tanh", Tanh},
+    {"Erf", Erf},
+    {"Sqrt", Sqrt},
+    {"Pow", Pow},
+    {"Softmax", Softmax},
+    {"BatchNormalization", BatchNormalization},
+    {"MaxPool", MaxPool},
+    {"AveragePool", AveragePool},
+    {"GlobalAveragePool", GlobalAveragePool},
+    {"Concat", Concat},
+    {"Reshape", Reshape},
+    {"Transpose", Transpose},
+    {"Gather", Gather},
+    {"Slice", Slice},
+    {"ReduceMean", ReduceMean},
+    {"Cast", Cast},
+    {"Clip", Clip},
+    {"Split", Split},
+    {"LSTM", LSTM},
+    {"LayerNormalization", LayerNormalization},
+    {"Gelu", Gelu},
+};
+
+void BM_Kernel(benchmark::State& state, KernelBenchmark (*create)(), const char* provider_type) {
+  try {
+    create().Run(state, provider_type);
+  } catch (const std::exception& ex) {
+    state.SkipWithError(ex.what());
+  }
+}
+
+}  // namespace
+
+void RegisterKernelBenchmarks() {
+  std::vector<std::pair<const char*, const char*>> providers{{"cpu", kCpuExecutionProvider}};
+#ifdef USE_CUDA
+  providers.emplace_back("cuda", kCudaExecutionProvider);
+#endif
+  for (const auto& kernel : kKernels) {
+    for (const auto& provider : providers) {
+      benchmark::RegisterBenchmark((std::string("BM_Kernel/") + kernel.name + "/" + provider.first).c_str(),
+                                   BM_Kernel, kernel.create, provider.second)
+          ->UseRealTime()
+          ->Unit(benchmark::TimeUnit::kMicrosecond);
+    }
+  }
+}
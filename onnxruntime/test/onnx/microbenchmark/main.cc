@@ -16,8 +16,12 @@
 #include <core/session/onnxruntime_cxx_api.h>
 #include <core/session/ort_env.h>
 
+#include <cstring>
+#include <string>
 #include <unordered_map>
 
+#include "history_reporter.h"
+
 const OrtApi* g_ort = OrtGetApiBase()->GetApi(ORT_API_VERSION);
 OrtEnv* env = nullptr;
 
@@ -77,12 +81,42 @@ static void BM_CreateThreadPool(benchmark::State& state) {
 }
 BENCHMARK(BM_CreateThreadPool)->UseRealTime()->Unit(benchmark::TimeUnit::kMillisecond);
 
+void RegisterModelZooBenchmarks();
+void RegisterKernelBenchmarks();
+
+// Removes --benchmark_history=<file> and --benchmark_history_label=<label> from the arguments, see HistoryReporter.
+static void ParseHistoryArguments(int& argc, char** argv, std::string& history_path, std::string& history_label) {
+  static const char kPath[] = "--benchmark_history=";
+  static const char kLabel[] = "--benchmark_history_label=";
+  int kept = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i], kPath, sizeof(kPath) - 1) == 0) {
+      history_path = argv[i] + sizeof(kPath) - 1;
+    } else if (strncmp(argv[i], kLabel, sizeof(kLabel) - 1) == 0) {
+      history_label = argv[i] + sizeof(kLabel) - 1;
+    } else {
+      argv[kept++] = argv[i];
+    }
+  }
+  argc = kept;
+}
+
 int main(int argc, char** argv) {
+  std::string history_path;
+  std::string history_label;
+  ParseHistoryArguments(argc, argv, history_path, history_label);
+  RegisterModelZooBenchmarks();
+  RegisterKernelBenchmarks();
   ::benchmark::Initialize(&argc, argv);
   if (::benchmark::ReportUnrecognizedArguments(argc, argv))
     return -1;
   ORT_ABORT_ON_ERROR(g_ort->CreateEnv(ORT_LOGGING_LEVEL_ERROR, "test", &env));
-  ::benchmark::RunSpecifiedBenchmarks();
+  if (history_path.empty()) {
+    ::benchmark::RunSpecifiedBenchmarks();
+  } else {
+    HistoryReporter reporter(history_path, history_label);
+    ::benchmark::RunSpecifiedBenchmarks(&reporter);
+  }
   g_ort->ReleaseEnv(env);
   return 0;
 }
@@ -0,0 +1,191 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Inference benchmarks of a curated set of end-to-end models on each execution provider of the build. The models
+// aren't part of the repository: they are read from the directory in the ORT_BENCHMARK_MODEL_ZOO environment
+// variable, ../models/zoo by default, as <model name>/model.onnx. A missing model is reported as an error of its
+// benchmarks rather than failing the others.
+
+#include <benchmark/benchmark.h>
+#include <core/common/common.h>
+#include <core/session/onnxruntime_cxx_api.h>
+
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "providers.h"
+
+extern OrtEnv* env;
+
+namespace {
+
+const char* const kModels[] = {
+    "resnet50",          // image classification, convolutions
+    "bert_base",         // transformer encoder, sequence length 128
+    "gpt2",              // transformer decoder
+    "ssd_mobilenet",     // object detection with depthwise convolutions and post-processing
+    "gbdt",              // gradient boosted trees converted to TreeEnsembleClassifier
+    "sklearn_pipeline",  // scaler, imputer and linear model from the traditional ML domain
+};
+
+// the inputs are the same on every run and every machine
+constexpr unsigned kSeed = 42;
+
+// free dimensions are the batch size 1, except for the sequence lengths of the transformers
+int64_t FreeDimensionValue(const char* dim_param) {
+  const std::string name = dim_param != nullptr ? dim_param : "";
+  return name.find("seq") != std::string::npos || name.find("sequence") != std::string::npos ? 128 : 1;
+}
+
+template <typename T, typename Distribution>
+void FillRandom(Ort::Value& tensor, size_t count, Distribution distribution, std::mt19937& engine) {
+  T* data = tensor.GetTensorMutableData<T>();
+  for (size_t i = 0; i != count; ++i) {
+    data[i] = static_cast<T>(distribution(engine));
+  }
+}
+
+// Random inputs shaped by the input metadata of the session. Returns false with the reason in error if an input
+// type isn't supported.
+bool CreateInputs(Ort::Session& session, std::vector<Ort::Value>& inputs, std::string& error) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::mt19937 engine(kSeed);
+  for (size_t i = 0; i != session.GetInputCount(); ++i) {
+    Ort::TypeInfo type_info = session.GetInputTypeInfo(i);
+    if (type_info.GetONNXType() != ONNX_TYPE_TENSOR) {
+      error = "input " + std::to_string(i) + " isn't a tensor";
+      return false;
+    }
+
+    auto tensor_info = type_info.GetTensorTypeAndShapeInfo();
+    std::vector<int64_t> shape = tensor_info.GetShape();
+    std::vector<const char*> dim_params(shape.size(), nullptr);
+    tensor_info.GetSymbolicDimensions(dim_params.data(), dim_params.size());
+    size_t count = 1;
+    for (size_t d = 0; d != shape.size(); ++d) {
+      if (shape[d] < 0) {
+        shape[d] = FreeDimensionValue(dim_params[d]);
+      }
+      count *= static_cast<size_t>(shape[d]);
+    }
+
+    const ONNXTensorElementDataType type = tensor_info.GetElementType();
+    Ort::Value tensor = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), type);
+    // small non-negative integers are valid token ids and indices
+    std::uniform_real_distribution<double> real(-1.0, 1.0);
+    std::uniform_int_distribution<int> integer(0, 9);
+    switch (type) {
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+        FillRandom<float>(tensor, count, real, engine);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+        FillRandom<double>(tensor, count, real, engine);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+        FillRandom<uint8_t>(tensor, count, integer, engine);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+        FillRandom<int32_t>(tensor, count, integer, engine);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+        FillRandom<int64_t>(tensor, count, integer, engine);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+        FillRandom<bool>(tensor, count, std::uniform_int_distribution<int>(0, 1), engine);
+        break;
+      default:
+        error = "input " + std::to_string(i) + " has the unsupported element type " + std::to_string(type);
+        return false;
+    }
+    inputs.push_back(std::move(tensor));
+  }
+  return true;
+}
+
+std::basic_string<ORTCHAR_T> ModelPath(const char* model) {
+  const char* zoo = std::getenv("ORT_BENCHMARK_MODEL_ZOO");
+  const std::string path = std::string(zoo != nullptr ? zoo : "../models/zoo") + "/" + model + "/model.onnx";
+#ifdef _WIN32
+  return onnxruntime::ToWideString(path);
+#else
+  return path;
+#endif
+}
+
+void BM_ModelZoo(benchmark::State& state, const char* model, const char* provider) {
+  try {
+    Ort::SessionOptions session_options;
+    session_options.SetGraphOptimizationLevel(ORT_ENABLE_ALL);
+    const std::string provider_name = provider;
+    if (provider_name == "tensorrt") {
+#ifdef USE_TENSORRT
+      Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_Tensorrt(session_options, 0));
+#endif
+    }
+    if (provider_name == "cuda" || provider_name == "tensorrt") {
+#ifdef USE_CUDA
+      Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_CUDA(session_options, 0));
+#endif
+    }
+
+    Ort::Unowned<Ort::Env> shared_env{env};
+    Ort::Session session(shared_env, ModelPath(model).c_str(), session_options);
+    std::vector<Ort::Value> inputs;
+    std::string error;
+    if (!CreateInputs(session, inputs, error)) {
+      state.SkipWithError(error.c_str());
+      return;
+    }
+
+    Ort::AllocatorWithDefaultOptions allocator;
+    std::vector<std::string> names;
+    for (size_t i = 0; i != session.GetInputCount(); ++i) {
+      char* name = session.GetInputName(i, allocator);
+      names.emplace_back(name);
+      allocator.Free(name);
+    }
+    const size_t input_count = names.size();
+    for (size_t i = 0; i != session.GetOutputCount(); ++i) {
+      char* name = session.GetOutputName(i, allocator);
+      names.emplace_back(name);
+      allocator.Free(name);
+    }
+    std::vector<const char*> name_ptrs;
+    for (const auto& name : names) {
+      name_ptrs.push_back(name.c_str());
+    }
+
+    // the first run initializes the providers and the memory patterns
+    session.Run(Ort::RunOptions{nullptr}, name_ptrs.data(), inputs.data(), input_count,
+                name_ptrs.data() + input_count, names.size() - input_count);
+    for (auto _ : state) {
+      auto outputs = session.Run(Ort::RunOptions{nullptr}, name_ptrs.data(), inputs.data(), input_count,
+                                 name_ptrs.data() + input_count, names.size() - input_count);
+      benchmark::DoNotOptimize(outputs);
+    }
+  } catch (const std::exception& ex) {
+    state.SkipWithError(ex.what());
+  }
+}
+
+}  // namespace
+
+void RegisterModelZooBenchmarks() {
+  std::vector<const char*> providers{"cpu"};
+#ifdef USE_CUDA
+  providers.push_back("cuda");
+#endif
+#ifdef USE_TENSORRT
+  providers.push_back("tensorrt");
+#endif
+  for (const char* model : kModels) {
+    for (const char* provider : providers) {
+      benchmark::RegisterBenchmark((std::string("BM_ModelZoo/") + model + "/" + provider).c_str(), BM_ModelZoo,
+                                   model, provider)
+          ->UseRealTime()
+          ->Unit(benchmark::TimeUnit::kMillisecond);
+    }
+  }
+}
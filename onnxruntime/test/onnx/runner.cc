@@ -3,6 +3,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "runner.h"
 
+#include <algorithm>
 #include <fstream>
 #include <cmath>
 
@@ -242,11 +243,47 @@ Status RunTests(TestEnv& env, int p_models, int concurrent_runs, size_t repeat_c
   return common::Status::OK();
 }
 
+namespace {
+
+// A model to load on the thread pool by LoadTests. The last task to complete signals finished.
+struct LoadTestCaseTask {
+  std::string test_case_name;
+  std::basic_string<PATH_CHAR_TYPE> model_path;
+  double per_sample_tolerance;
+  double relative_per_sample_tolerance;
+  std::atomic<size_t>* remaining;
+  ORT_EVENT finished;
+  ITestCase* test_case;
+  std::string error;
+};
+
+void ORT_CALLBACK LoadTestCase(ORT_CALLBACK_INSTANCE pci, void* context, ORT_WORK work) {
+  OnnxRuntimeCloseThreadpoolWork(work);
+  LoadTestCaseTask* task = static_cast<LoadTestCaseTask*>(context);
+  try {
+    task->test_case = CreateOnnxTestCase(task->test_case_name, TestModelInfo::LoadOnnxModel(task->model_path.c_str()),
+                                         task->per_sample_tolerance, task->relative_per_sample_tolerance);
+  } catch (std::exception& ex) {
+    task->error = ex.what();
+  }
+  if (--*task->remaining == 0) {
+    Status st = OnnxRuntimeSetEventWhenCallbackReturns(pci, task->finished);
+    if (!st.IsOK()) {
+      LOGF_DEFAULT(ERROR, "FATAL ERROR");
+      abort();
+    }
+  }
+}
+
+}  // namespace
+
 void LoadTests(const std::vector<std::basic_string<PATH_CHAR_TYPE>>& input_paths,
                const std::vector<std::basic_string<PATH_CHAR_TYPE>>& whitelisted_test_cases,
                double default_per_sample_tolerance, double default_relative_per_sample_tolerance,
-               const std::unordered_set<std::basic_string<ORTCHAR_T>>& disabled_tests,
-               const std::function<void(ITestCase*)>& process_function) {
+               const std::unordered_set<std::basic_string<ORTCHAR_T>>& disabled_tests, PThreadPool tpool,
+               size_t shard_index, size_t shard_count, const std::function<void(ITestCase*)>& process_function) {
+  // test case name and model path
+  std::vector<std::pair<std::basic_string<PATH_CHAR_TYPE>, std::basic_string<PATH_CHAR_TYPE>>> models;
   std::vector<std::basic_string<PATH_CHAR_TYPE>> paths(input_paths);
   while (!paths.empty()) {
     std::basic_string<PATH_CHAR_TYPE> node_data_root_path = paths.back();
@@ -272,13 +309,53 @@ void LoadTests(const std::vector<std::basic_string<PATH_CHAR_TYPE>>& input_paths
       if (disabled_tests.find(test_case_name) != disabled_tests.end()) return true;
 
       std::basic_string<PATH_CHAR_TYPE> p = ConcatPathComponent<PATH_CHAR_TYPE>(node_data_root_path, filename_str);
-
-      ITestCase* l = CreateOnnxTestCase(ToMBString(test_case_name), TestModelInfo::LoadOnnxModel(p.c_str()),
-                                        default_per_sample_tolerance, default_relative_per_sample_tolerance);
-      process_function(l);
+      models.emplace_back(test_case_name, p);
       return true;
     });
   }
+
+  // the directories are listed in no particular order, so sort them for every shard to split them the same way
+  std::sort(models.begin(), models.end());
+  std::vector<std::unique_ptr<LoadTestCaseTask>> tasks;
+  std::atomic<size_t> remaining{0};
+  ORT_EVENT finished = nullptr;
+  auto st = CreateOnnxRuntimeEvent(&finished);
+  if (!st.IsOK()) {
+    ORT_THROW(st.ErrorMessage());
+  }
+  for (size_t i = shard_index; i < models.size(); i += shard_count) {
+    tasks.emplace_back(new LoadTestCaseTask{ToMBString(models[i].first), models[i].second,
+                                            default_per_sample_tolerance, default_relative_per_sample_tolerance,
+                                            &remaining, finished, nullptr, std::string()});
+  }
+  if (tasks.empty()) {
+    OrtCloseEvent(finished);
+    return;
+  }
+
+  remaining = tasks.size();
+  for (auto& task : tasks) {
+    if (!CreateAndSubmitThreadpoolWork(LoadTestCase, task.get(), tpool).IsOK()) {
+      // load it here instead, the event is signaled right away if it is the last one
+      LoadTestCase(nullptr, task.get(), nullptr);
+    }
+  }
+  st = WaitAndCloseEvent(finished);
+  if (!st.IsOK()) {
+    ORT_THROW(st.ErrorMessage());
+  }
+
+  for (auto& task : tasks) {
+    if (!task->error.empty()) {
+      for (auto& t : tasks) {
+        delete t->test_case;
+      }
+      ORT_THROW("Failed to load the model of ", task->test_case_name, ": ", task->error);
+    }
+  }
+  for (auto& task : tasks) {
+    process_function(task->test_case);
+  }
 }
 
 SeqTestRunner::SeqTestRunner(OrtSession* session1,
@@ -127,11 +127,14 @@ struct DataTask {
   const size_t task_id;
 };
 
+// Finds the test cases under input_paths and loads their models in parallel on tpool. The test cases are sorted by
+// name, and only the ones of the shard shard_index out of shard_count are loaded, so that the shards of a test suite
+// can run in separate processes. process_function is called on the calling thread, in order.
 void LoadTests(const std::vector<std::basic_string<PATH_CHAR_TYPE>>& input_paths,
                const std::vector<std::basic_string<PATH_CHAR_TYPE>>& whitelisted_test_cases,
                double default_per_sample_tolerance, double default_relative_per_sample_tolerance,
-               const std::unordered_set<std::basic_string<ORTCHAR_T>>& disabled_tests,
-               const std::function<void(ITestCase*)>& process_function);
+               const std::unordered_set<std::basic_string<ORTCHAR_T>>& disabled_tests, PThreadPool tpool,
+               size_t shard_index, size_t shard_count, const std::function<void(ITestCase*)>& process_function);
 
 //Do not run this function in the thread pool passed in
 ::onnxruntime::common::Status RunTests(TestEnv& env, int p_models, int concurrent_runs, size_t repeat_count, PThreadPool tpool);
@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/model.h"
+#include "core/optimizer/common_subexpression_elimination.h"
+#include "core/optimizer/graph_transformer_mgr.h"
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Unsqueeze(Cast(Gather(Shape(x), index)), 0), named after the layer that computes it
+NodeArg& AddShapeDim(Graph& graph, NodeArg& x, NodeArg& index, const std::string& layer) {
+  auto& shape = graph.GetOrCreateNodeArg("shape_" + layer, nullptr);
+  auto& dim = graph.GetOrCreateNodeArg("dim_" + layer, nullptr);
+  auto& cast = graph.GetOrCreateNodeArg("cast_" + layer, nullptr);
+  auto& unsqueezed = graph.GetOrCreateNodeArg("unsqueezed_" + layer, nullptr);
+  graph.AddNode("shape_node_" + layer, "Shape", "", {&x}, {&shape});
+  graph.AddNode("gather_node_" + layer, "Gather", "", {&shape, &index}, {&dim});
+  graph.AddNode("cast_node_" + layer, "Cast", "", {&dim}, {&cast})
+      .AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_INT64));
+  graph.AddNode("unsqueeze_node_" + layer, "Unsqueeze", "", {&cast}, {&unsqueezed})
+      .AddAttribute("axes", std::vector<int64_t>{0});
+  return unsqueezed;
+}
+
+}  // namespace
+
+// The shape chains repeated by two layers are merged, nodes with different attributes and random ops are kept.
+TEST(CommonSubexpressionEliminationTest, MergeRepeatedShapeChains) {
+  Model model("cse", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(8);
+  auto& x = graph.GetOrCreateNodeArg("x", &input_type);
+
+  TensorProto index_proto;
+  index_proto.set_name("index");
+  index_proto.set_data_type(TensorProto_DataType_INT64);
+  index_proto.add_int64_data(0);
+  graph.AddInitializedTensor(index_proto);
+  auto& index = graph.GetOrCreateNodeArg("index", nullptr);
+
+  auto& dim_layer0 = AddShapeDim(graph, x, index, "layer0");
+  auto& dim_layer1 = AddShapeDim(graph, x, index, "layer1");
+  auto& shape = graph.GetOrCreateNodeArg("shape", nullptr);
+  graph.AddNode("concat", "Concat", "", {&dim_layer0, &dim_layer1}, {&shape}).AddAttribute("axis", int64_t{0});
+
+  // Softmax over different axes isn't the same value
+  auto& softmax0 = graph.GetOrCreateNodeArg("softmax0", nullptr);
+  auto& softmax1 = graph.GetOrCreateNodeArg("softmax1", nullptr);
+  graph.AddNode("softmax_node0", "Softmax", "", {&x}, {&softmax0}).AddAttribute("axis", int64_t{0});
+  graph.AddNode("softmax_node1", "Softmax", "", {&x}, {&softmax1}).AddAttribute("axis", int64_t{1});
+
+  auto& random0 = graph.GetOrCreateNodeArg("random0", nullptr);
+  auto& random1 = graph.GetOrCreateNodeArg("random1", nullptr);
+  graph.AddNode("random_node0", "RandomNormalLike", "", {&x}, {&random0});
+  graph.AddNode("random_node1", "RandomNormalLike", "", {&x}, {&random1});
+
+  graph.SetInputs({&x});
+  graph.SetOutputs({&shape, &softmax0, &softmax1, &random0, &random1});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<CommonSubexpressionElimination>(),
+                                    TransformerLevel::Level1);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1,
+                                                              DefaultLoggingManager().DefaultLogger()));
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Shape"], 1);
+  EXPECT_EQ(op_to_count["Gather"], 1);
+  EXPECT_EQ(op_to_count["Cast"], 1);
+  EXPECT_EQ(op_to_count["Unsqueeze"], 1);
+  EXPECT_EQ(op_to_count["Concat"], 1);
+  EXPECT_EQ(op_to_count["Softmax"], 2);
+  EXPECT_EQ(op_to_count["RandomNormalLike"], 2);
+
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "Concat") {
+      EXPECT_EQ(node.InputDefs()[0]->Name(), "unsqueezed_layer0");
+      EXPECT_EQ(node.InputDefs()[1]->Name(), "unsqueezed_layer0");
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
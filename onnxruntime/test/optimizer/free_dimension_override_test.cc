@@ -60,5 +60,40 @@ TEST(FreeDimensionOverrideTransformerTest, Test) {
   ASSERT_TRUE(input_shape->dim(1).dim_value() == 42);
 }
 
+TEST(FreeDimensionOverrideTransformerTest, OverrideByName) {
+  Model model("free_dims", false, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("seq");
+  auto& x = graph.GetOrCreateNodeArg("x", &input_type);
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("abs", "Abs", "", {&x}, {&y});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  // only the dimension named "batch" is replaced, a denotation override with the same name doesn't match
+  std::vector<FreeDimensionOverride> overrides =
+      {
+          FreeDimensionOverride{"batch", 4, FreeDimensionOverrideType::Name},
+          FreeDimensionOverride{"seq", 16, FreeDimensionOverrideType::Denotation},
+      };
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr(5);
+  graph_transformation_mgr.Register(onnxruntime::make_unique<FreeDimensionOverrideTransformer>(overrides),
+                                    TransformerLevel::Level1);
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1,
+                                                         DefaultLoggingManager().DefaultLogger())
+                  .IsOK());
+
+  const auto* input_shape = graph.GetInputs()[0]->Shape();
+  ASSERT_EQ(input_shape->dim_size(), 2);
+  ASSERT_TRUE(input_shape->dim(0).has_dim_value());
+  ASSERT_EQ(input_shape->dim(0).dim_value(), 4);
+  ASSERT_TRUE(input_shape->dim(1).has_dim_param());
+  ASSERT_EQ(input_shape->dim(1).dim_param(), "seq");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -3,7 +3,9 @@
 #include "core/graph/onnx_protobuf.h"
 
 #include "core/session/inference_session.h"
+#include "core/common/profiler.h"
 #include "core/framework/data_types.h"
+#include "core/framework/kernel_registry.h"
 #include "core/framework/ml_value.h"
 #include "core/graph/graph_utils.h"
 #include "core/graph/graph_viewer.h"
@@ -14,6 +16,8 @@
 #include "core/optimizer/conv_add_fusion.h"
 #include "core/optimizer/conv_activation_fusion.h"
 #include "core/optimizer/dropout_elimination.h"
+#include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
 #include "core/optimizer/gemm_activation_fusion.h"
 #include "core/optimizer/bias_gelu_fusion.h"
 #include "core/optimizer/gelu_fusion.h"
@@ -30,10 +34,13 @@
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/shape_to_initializer.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/sparse_matmul_transformer.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/attention_fusion.h"
+#include "core/optimizer/auto_mixed_precision_transformer.h"
 #include "core/optimizer/fast_gelu_fusion.h"
+#include "core/optimizer/gather_sum_fusion.h"
 #include "core/optimizer/utils.h"
 #include "core/platform/env.h"
 #include "core/util/math.h"
@@ -70,6 +77,34 @@ TEST(GraphTransformationTests, IdentityElimination) {
   ASSERT_TRUE(op_to_count["Identity"] == 0);
 }
 
+TEST(GraphTransformationTests, TransformerStats) {
+  auto model_uri = MODEL_FOLDER "abs-id-max.onnx";
+  std::shared_ptr<Model> model;
+  ASSERT_TRUE(Model::Load(model_uri, model, nullptr, DefaultLoggingManager().DefaultLogger()).IsOK());
+  Graph& graph = model->MainGraph();
+
+  auto rule_transformer_L1 = onnxruntime::make_unique<RuleBasedGraphTransformer>("RuleTransformer1");
+  rule_transformer_L1->Register(onnxruntime::make_unique<EliminateIdentity>());
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::move(rule_transformer_L1), TransformerLevel::Level1);
+
+  profiling::Profiler profiler;
+  profiler.Initialize(&DefaultLoggingManager().DefaultLogger());
+  profiler.StartProfiling(std::string("transformer_stats_profile.json"));
+  graph_transformation_mgr.SetProfiler(&profiler);
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, DefaultLoggingManager().DefaultLogger()).IsOK());
+  profiler.EndProfiling();
+
+  // the first step removes the Identity node and the second one finds nothing to do
+  const auto& stats = graph_transformation_mgr.GetStats();
+  ASSERT_EQ(stats.size(), 1u);
+  const auto& rule_transformer_stats = stats.at("RuleTransformer1");
+  EXPECT_EQ(rule_transformer_stats.num_applied, 2u);
+  EXPECT_EQ(rule_transformer_stats.num_modified, 1u);
+  EXPECT_EQ(rule_transformer_stats.num_nodes_added, 0u);
+  EXPECT_EQ(rule_transformer_stats.num_nodes_removed, 1u);
+}
+
 TEST(GraphTransformationTests, DropoutElimination) {
   auto model_uri = MODEL_FOLDER "dropout.onnx";
   std::shared_ptr<Model> model;
@@ -234,6 +269,118 @@ TEST(GraphTransformationTests, ConstantFoldingSubgraph) {
       << "Constant folding should have been able to remove the Add node in both subgraphs";
 }
 
+// Expand makes its constant 256 times bigger so it isn't folded, unless a ReduceSum folded with it makes it small again.
+TEST(GraphTransformationTests, ConstantFoldingOutputGrowthBudget) {
+  Model model("ConstantFoldingOutputGrowthBudget", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(256);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor_type);
+
+  TensorProto small;
+  small.set_name("small");
+  small.set_data_type(TensorProto_DataType_FLOAT);
+  small.add_dims(1);
+  small.add_dims(4);
+  for (int i = 0; i < 4; ++i) {
+    small.add_float_data(static_cast<float>(i));
+  }
+  graph.AddInitializedTensor(small);
+  TensorProto shape;
+  shape.set_name("shape");
+  shape.set_data_type(TensorProto_DataType_INT64);
+  shape.add_dims(2);
+  shape.add_int64_data(256);
+  shape.add_int64_data(4);
+  graph.AddInitializedTensor(shape);
+  auto& small_arg = graph.GetOrCreateNodeArg("small", nullptr);
+  auto& shape_arg = graph.GetOrCreateNodeArg("shape", nullptr);
+
+  auto& expanded = graph.GetOrCreateNodeArg("expanded", nullptr);
+  graph.AddNode("expand", "Expand", "", {&small_arg, &shape_arg}, {&expanded});
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("add", "Add", "", {&x, &expanded}, {&y});
+
+  auto& expanded_to_reduce = graph.GetOrCreateNodeArg("expanded_to_reduce", nullptr);
+  graph.AddNode("expand_to_reduce", "Expand", "", {&small_arg, &shape_arg}, {&expanded_to_reduce});
+  auto& reduced = graph.GetOrCreateNodeArg("reduced", nullptr);
+  graph.AddNode("reduce", "ReduceSum", "", {&expanded_to_reduce}, {&reduced})
+      .AddAttribute("axes", std::vector<int64_t>{0});
+  auto& z = graph.GetOrCreateNodeArg("z", nullptr);
+  graph.AddNode("add_reduced", "Add", "", {&x, &reduced}, {&z});
+
+  graph.SetInputs({&x});
+  graph.SetOutputs({&y, &z});
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<ConstantFolding>(std::unordered_set<std::string>{}, 1024),
+                                    TransformerLevel::Level1);
+  status = graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1,
+                                                      DefaultLoggingManager().DefaultLogger());
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Expand"], 1);
+  EXPECT_EQ(op_to_count["ReduceSum"], 0);
+  EXPECT_EQ(op_to_count["Add"], 2);
+  EXPECT_EQ(graph.GetAllInitializedTensors().count("expanded"), 0u);
+
+  const TensorProto* reduced_tensor = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("reduced", reduced_tensor));
+  Initializer reduced_values{*reduced_tensor, graph.ModelPath()};
+  ASSERT_EQ(reduced_values.size(), 4);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(reduced_values.data<float>()[i], 256.f * i);
+  }
+}
+
+TEST(GraphTransformationTests, ConstantFoldingDeduplicatesInitializers) {
+  Model model("ConstantFoldingDeduplicatesInitializers", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor_type);
+
+  // the same weights, shared by two layers of the exported model
+  for (const char* name : {"weights_0", "weights_1"}) {
+    TensorProto weights;
+    weights.set_name(name);
+    weights.set_data_type(TensorProto_DataType_FLOAT);
+    weights.add_dims(4);
+    for (int i = 0; i < 4; ++i) {
+      weights.add_float_data(0.5f * i);
+    }
+    graph.AddInitializedTensor(weights);
+  }
+  auto& hidden = graph.GetOrCreateNodeArg("hidden", nullptr);
+  graph.AddNode("mul_0", "Mul", "", {&x, &graph.GetOrCreateNodeArg("weights_0", nullptr)}, {&hidden});
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("mul_1", "Mul", "", {&hidden, &graph.GetOrCreateNodeArg("weights_1", nullptr)}, {&y});
+  graph.SetInputs({&x});
+  graph.SetOutputs({&y});
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<ConstantFolding>(), TransformerLevel::Level1);
+  status = graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1,
+                                                      DefaultLoggingManager().DefaultLogger());
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  EXPECT_EQ(graph.GetAllInitializedTensors().size(), 1u);
+  EXPECT_EQ(graph.GetAllInitializedTensors().count("weights_0"), 1u);
+  for (const auto& node : graph.Nodes()) {
+    EXPECT_EQ(node.InputDefs()[1]->Name(), "weights_0");
+  }
+}
+
 TEST(GraphTransformationTests, ShapeToInitializer) {
   auto model_uri = MODEL_FOLDER "shape-add.onnx";
   std::shared_ptr<Model> model;
@@ -1208,6 +1355,60 @@ TEST(GraphTransformationTests, BiasGeluTest) {
   ASSERT_TRUE(op_to_count["BiasGelu"] == 1);
 }
 
+TEST(GraphTransformationTests, GatherSumFusion) {
+  Model model("GatherSumFusion", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto data_type;
+  data_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  data_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(100);
+  data_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(8);
+
+  TypeProto indices_type;
+  indices_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  indices_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  indices_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  // 2 paths in the model, each with Gather followed by ReduceSum
+  // One sums over the last axis of the indices (fuse)
+  // One sums over the last axis of the gathered rows (don't fuse)
+  auto& data = graph.GetOrCreateNodeArg("data", &data_type);
+  auto& indices = graph.GetOrCreateNodeArg("indices", &indices_type);
+  auto& gather0_output = graph.GetOrCreateNodeArg("gather0_output", nullptr);
+  auto& gather1_output = graph.GetOrCreateNodeArg("gather1_output", nullptr);
+  auto& sum0_output = graph.GetOrCreateNodeArg("sum0_output", nullptr);
+  auto& sum1_output = graph.GetOrCreateNodeArg("sum1_output", nullptr);
+
+  graph.AddNode("gather0", "Gather", "Gather to fuse", {&data, &indices}, {&gather0_output});
+  graph.AddNode("gather1", "Gather", "Gather to not fuse", {&data, &indices}, {&gather1_output});
+
+  auto& sum0 = graph.AddNode("sum0", "ReduceSum", "ReduceSum over the bags", {&gather0_output}, {&sum0_output});
+  sum0.AddAttribute("axes", std::vector<int64_t>{-2});
+  sum0.AddAttribute("keepdims", static_cast<int64_t>(0));
+
+  auto& sum1 = graph.AddNode("sum1", "ReduceSum", "ReduceSum over the rows", {&gather1_output}, {&sum1_output});
+  sum1.AddAttribute("axes", std::vector<int64_t>{2});
+  sum1.AddAttribute("keepdims", static_cast<int64_t>(0));
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<GatherSumFusion>(), TransformerLevel::Level2);
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, DefaultLoggingManager().DefaultLogger()).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["Gather"] == 1);
+  ASSERT_TRUE(op_to_count["ReduceSum"] == 1);
+  ASSERT_TRUE(op_to_count["GatherSum"] == 1);
+
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType() == "GatherSum") {
+      ASSERT_EQ(node.OutputDefs()[0]->Name(), "sum0_output");
+    }
+  }
+}
+
 // Test Gelu -> FastGelu
 TEST(GraphTransformationTests, GeluApproximation_Gelu) {
   auto model_uri = MODEL_FOLDER "approximation/gelu.onnx";
@@ -1663,6 +1864,482 @@ TEST(GraphTransformationTests, EmbedLayerNormFusionFormat5) {
   }
 }
 
+TEST(GraphTransformationTests, DynamicQuantizeMatMulFusion) {
+  Model model("DynamicQuantizeMatMulFusion", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  auto& a = graph.GetOrCreateNodeArg("a", &float_tensor_type);
+
+  TensorProto b;
+  b.set_name("b");
+  b.set_data_type(TensorProto_DataType_UINT8);
+  b.add_dims(3);
+  b.add_dims(4);
+  b.set_raw_data(std::string(12, '\x02'));
+  graph.AddInitializedTensor(b);
+  TensorProto b_scale;
+  b_scale.set_name("b_scale");
+  b_scale.set_data_type(TensorProto_DataType_FLOAT);
+  b_scale.add_float_data(0.5f);
+  graph.AddInitializedTensor(b_scale);
+  TensorProto bias;
+  bias.set_name("bias");
+  bias.set_data_type(TensorProto_DataType_FLOAT);
+  bias.add_dims(4);
+  for (int i = 0; i < 4; ++i) {
+    bias.add_float_data(static_cast<float>(i));
+  }
+  graph.AddInitializedTensor(bias);
+  auto& b_arg = graph.GetOrCreateNodeArg("b", nullptr);
+  auto& b_scale_arg = graph.GetOrCreateNodeArg("b_scale", nullptr);
+  auto& bias_arg = graph.GetOrCreateNodeArg("bias", nullptr);
+
+  auto& a_quantized = graph.GetOrCreateNodeArg("a_quantized", nullptr);
+  auto& a_scale = graph.GetOrCreateNodeArg("a_scale", nullptr);
+  auto& a_zero_point = graph.GetOrCreateNodeArg("a_zero_point", nullptr);
+  graph.AddNode("dql", "DynamicQuantizeLinear", "", {&a}, {&a_quantized, &a_scale, &a_zero_point});
+  auto& matmul_output = graph.GetOrCreateNodeArg("matmul_output", nullptr);
+  graph.AddNode("matmul", "MatMulInteger", "", {&a_quantized, &b_arg, &a_zero_point}, {&matmul_output});
+  auto& cast_output = graph.GetOrCreateNodeArg("cast_output", nullptr);
+  graph.AddNode("cast", "Cast", "", {&matmul_output}, {&cast_output})
+      .AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_FLOAT));
+  auto& scale = graph.GetOrCreateNodeArg("scale", nullptr);
+  graph.AddNode("scale_mul", "Mul", "", {&a_scale, &b_scale_arg}, {&scale});
+  auto& mul_output = graph.GetOrCreateNodeArg("mul_output", nullptr);
+  graph.AddNode("mul", "Mul", "", {&cast_output, &scale}, {&mul_output});
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("add", "Add", "", {&mul_output, &bias_arg}, {&y});
+
+  graph.SetInputs({&a});
+  graph.SetOutputs({&y});
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<DynamicQuantizeMatMulFusion>(), TransformerLevel::Level2);
+  status = graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2,
+                                                      DefaultLoggingManager().DefaultLogger());
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["DynamicQuantizeLinear"], 0);
+  EXPECT_EQ(op_to_count["MatMulInteger"], 0);
+  EXPECT_EQ(op_to_count["Cast"], 0);
+  EXPECT_EQ(op_to_count["Mul"], 0);
+  EXPECT_EQ(op_to_count["Add"], 0);
+  EXPECT_EQ(op_to_count["DynamicQuantizeMatMul"], 1);
+
+  for (const Node& node : graph.Nodes()) {
+    if (node.OpType() == "DynamicQuantizeMatMul") {
+      ASSERT_EQ(node.InputDefs().size(), 5u);
+      EXPECT_EQ(node.InputDefs()[0]->Name(), "a");
+      EXPECT_EQ(node.InputDefs()[1]->Name(), "b");
+      EXPECT_EQ(node.InputDefs()[2]->Name(), "b_scale");
+      EXPECT_FALSE(node.InputDefs()[3]->Exists());
+      EXPECT_EQ(node.InputDefs()[4]->Name(), "bias");
+      EXPECT_EQ(node.OutputDefs()[0]->Name(), "y");
+    }
+  }
+}
+
+static NodeArg& AddFloatInitializer(Graph& graph, const std::string& name, const std::vector<int64_t>& dims,
+                                    const std::vector<float>& values) {
+  TensorProto tensor;
+  tensor.set_name(name);
+  tensor.set_data_type(TensorProto_DataType_FLOAT);
+  for (auto dim : dims) {
+    tensor.add_dims(dim);
+  }
+  for (auto value : values) {
+    tensor.add_float_data(value);
+  }
+  graph.AddInitializedTensor(tensor);
+  return graph.GetOrCreateNodeArg(name, nullptr);
+}
+
+static NodeArg& AddFloatInput(Graph& graph, const std::string& name, const std::vector<int64_t>& dims) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (auto dim : dims) {
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+  return graph.GetOrCreateNodeArg(name, &type);
+}
+
+// x * ((1 + erf(1/sqrt(2) * x)) * 0.5), with the Mul inputs in the other order than in the pattern
+TEST(GraphTransformationTests, GeluFusionMulByInverseSqrtTwo) {
+  Model model("GeluFusionMulByInverseSqrtTwo", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto& x = AddFloatInput(graph, "x", {2, 4});
+  auto& scaled = graph.GetOrCreateNodeArg("scaled", nullptr);
+  graph.AddNode("scale", "Mul", "", {&AddFloatInitializer(graph, "inv_sqrt_two", {}, {0.70710678f}), &x}, {&scaled});
+  auto& erf = graph.GetOrCreateNodeArg("erf", nullptr);
+  graph.AddNode("erf", "Erf", "", {&scaled}, {&erf});
+  auto& add = graph.GetOrCreateNodeArg("add", nullptr);
+  graph.AddNode("add", "Add", "", {&AddFloatInitializer(graph, "one", {}, {1.0f}), &erf}, {&add});
+  auto& half_add = graph.GetOrCreateNodeArg("half_add", nullptr);
+  graph.AddNode("half_add", "Mul", "", {&add, &AddFloatInitializer(graph, "half", {}, {0.5f})}, {&half_add});
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("output", "Mul", "", {&half_add, &x}, {&y});
+
+  graph.SetInputs({&x});
+  graph.SetOutputs({&y});
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<GeluFusion>(), TransformerLevel::Level2);
+  status = graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2,
+                                                      DefaultLoggingManager().DefaultLogger());
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Mul"], 0);
+  EXPECT_EQ(op_to_count["Erf"], 0);
+  EXPECT_EQ(op_to_count["Add"], 0);
+  EXPECT_EQ(op_to_count["Gelu"], 1);
+  for (const Node& node : graph.Nodes()) {
+    EXPECT_EQ(node.InputDefs()[0]->Name(), "x");
+    EXPECT_EQ(node.OutputDefs()[0]->Name(), "y");
+  }
+}
+
+// The form exported from TF-Keras: X * scale + (beta - mean * scale), with scale = gamma / sqrt(variance + epsilon)
+TEST(GraphTransformationTests, LayerNormFusionKerasForm) {
+  Model model("LayerNormFusionKerasForm", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto& x = AddFloatInput(graph, "x", {2, 3, 4});
+  auto add_node = [&graph](const std::string& name, const std::string& op_type,
+                           const std::vector<NodeArg*>& inputs) -> NodeArg& {
+    auto& output = graph.GetOrCreateNodeArg(name, nullptr);
+    graph.AddNode(name, op_type, "", inputs, {&output});
+    return output;
+  };
+  auto& mean = add_node("mean", "ReduceMean", {&x});
+  auto& diff = add_node("diff", "Sub", {&x, &mean});
+  auto& square = add_node("square", "Mul", {&diff, &diff});
+  auto& variance = add_node("variance", "ReduceMean", {&square});
+  auto& add_epsilon = add_node("add_epsilon", "Add", {&variance, &AddFloatInitializer(graph, "epsilon", {}, {1e-3f})});
+  auto& std_dev = add_node("std", "Sqrt", {&add_epsilon});
+  auto& inv_std = add_node("inv_std", "Reciprocal", {&std_dev});
+  auto& scale = add_node("scale", "Mul", {&inv_std, &AddFloatInitializer(graph, "gamma", {4}, {1.f, 2.f, 3.f, 4.f})});
+  auto& scaled_x = add_node("scaled_x", "Mul", {&x, &scale});
+  auto& scaled_mean = add_node("scaled_mean", "Mul", {&mean, &scale});
+  auto& beta = AddFloatInitializer(graph, "beta", {4}, {0.f, 1.f, 0.f, 1.f});
+  auto& shift = add_node("shift", "Sub", {&beta, &scaled_mean});
+  auto& y = add_node("y", "Add", {&scaled_x, &shift});
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType() == "ReduceMean") {
+      node.AddAttribute("axes", std::vector<int64_t>{-1});
+    }
+  }
+
+  graph.SetInputs({&x});
+  graph.SetOutputs({&y});
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<LayerNormFusion>(), TransformerLevel::Level2);
+  status = graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2,
+                                                      DefaultLoggingManager().DefaultLogger());
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["ReduceMean"], 0);
+  EXPECT_EQ(op_to_count["Sub"], 0);
+  EXPECT_EQ(op_to_count["Mul"], 0);
+  EXPECT_EQ(op_to_count["Add"], 0);
+  EXPECT_EQ(op_to_count["Sqrt"], 0);
+  EXPECT_EQ(op_to_count["Reciprocal"], 0);
+  EXPECT_EQ(op_to_count["LayerNormalization"], 1);
+  for (const Node& node : graph.Nodes()) {
+    ASSERT_EQ(node.InputDefs().size(), 3u);
+    EXPECT_EQ(node.InputDefs()[0]->Name(), "x");
+    EXPECT_EQ(node.InputDefs()[1]->Name(), "gamma");
+    EXPECT_EQ(node.InputDefs()[2]->Name(), "beta");
+    EXPECT_EQ(node.OutputDefs()[0]->Name(), "y");
+    EXPECT_FLOAT_EQ(node.GetAttributes().at("epsilon").f(), 1e-3f);
+  }
+}
+
+// The unidirectional self attention of GPT-2 with 2 heads of size 2 and a constant causal mask
+TEST(GraphTransformationTests, AttentionFusionUnidirectional) {
+  Model model("AttentionFusionUnidirectional", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto& x = AddFloatInput(graph, "x", {1, 3, 4});
+  auto add_node = [&graph](const std::string& name, const std::string& op_type, const std::vector<NodeArg*>& inputs,
+                           const std::vector<int64_t>& perm = {}) -> NodeArg& {
+    auto& output = graph.GetOrCreateNodeArg(name, nullptr);
+    Node& node = graph.AddNode(name, op_type, "", inputs, {&output});
+    if (!perm.empty()) {
+      node.AddAttribute("perm", perm);
+    }
+    return output;
+  };
+  auto add_int64_initializer = [&graph](const std::string& name, const std::vector<int64_t>& values) -> NodeArg* {
+    TensorProto tensor;
+    tensor.set_name(name);
+    tensor.set_data_type(TensorProto_DataType_INT64);
+    tensor.add_dims(static_cast<int64_t>(values.size()));
+    for (auto value : values) {
+      tensor.add_int64_data(value);
+    }
+    graph.AddInitializedTensor(tensor);
+    return &graph.GetOrCreateNodeArg(name, nullptr);
+  };
+
+  std::vector<float> weights(48);
+  for (size_t i = 0; i < weights.size(); ++i) {
+    weights[i] = 0.01f * static_cast<float>(i);
+  }
+  auto& qkv = add_node("qkv", "MatMul", {&x, &AddFloatInitializer(graph, "weights", {4, 12}, weights)});
+  auto& qkv_bias = add_node("qkv_bias", "Add", {&qkv, &AddFloatInitializer(graph, "bias", {12},
+                                                                            std::vector<float>(12, 0.1f))});
+  auto& q = graph.GetOrCreateNodeArg("q", nullptr);
+  auto& k = graph.GetOrCreateNodeArg("k", nullptr);
+  auto& v = graph.GetOrCreateNodeArg("v", nullptr);
+  graph.AddNode("split", "Split", "", {&qkv_bias}, {&q, &k, &v}).AddAttribute("axis", static_cast<int64_t>(2));
+  NodeArg* heads_shape = add_int64_initializer("heads_shape", {0, 0, 2, 2});
+  auto& q_heads = add_node("q_heads", "Transpose", {&add_node("q_reshape", "Reshape", {&q, heads_shape})},
+                           {0, 2, 1, 3});
+  auto& k_heads = add_node("k_heads", "Transpose", {&add_node("k_reshape", "Reshape", {&k, heads_shape})},
+                           {0, 2, 3, 1});
+  auto& v_heads = add_node("v_heads", "Transpose", {&add_node("v_reshape", "Reshape", {&v, heads_shape})},
+                           {0, 2, 1, 3});
+  auto& qk = add_node("qk", "MatMul", {&q_heads, &k_heads});
+  auto& scaled_qk = add_node("scaled_qk", "Div", {&qk, &AddFloatInitializer(graph, "sqrt_head_size", {},
+                                                                            {std::sqrt(2.0f)})});
+  auto& causal = AddFloatInitializer(graph, "causal", {1, 1, 3, 3}, {1, 0, 0, 1, 1, 0, 1, 1, 1});
+  auto& masked_qk = add_node("masked_qk", "Mul", {&scaled_qk, &causal});
+  auto& inverted_causal = add_node("inverted_causal", "Sub", {&AddFloatInitializer(graph, "one", {}, {1.0f}), &causal});
+  auto& mask_bias = add_node("mask_bias", "Mul", {&AddFloatInitializer(graph, "mask_value", {}, {10000.0f}),
+                                                  &inverted_causal});
+  auto& scores = add_node("scores", "Sub", {&masked_qk, &mask_bias});
+  auto& probs = graph.GetOrCreateNodeArg("probs", nullptr);
+  graph.AddNode("softmax", "Softmax", "", {&scores}, {&probs}).AddAttribute("axis", static_cast<int64_t>(-1));
+  auto& context = add_node("context", "MatMul", {&probs, &v_heads});
+  auto& context_transpose = add_node("context_transpose", "Transpose", {&context}, {0, 2, 1, 3});
+  auto& y = add_node("y", "Reshape", {&context_transpose, add_int64_initializer("output_shape", {0, 0, 4})});
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCpuExecutionProvider);
+  }
+
+  graph.SetInputs({&x});
+  graph.SetOutputs({&y});
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<AttentionFusion>(), TransformerLevel::Level2);
+  status = graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2,
+                                                      DefaultLoggingManager().DefaultLogger());
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["MatMul"], 0);
+  EXPECT_EQ(op_to_count["Split"], 0);
+  EXPECT_EQ(op_to_count["Reshape"], 0);
+  EXPECT_EQ(op_to_count["Transpose"], 0);
+  EXPECT_EQ(op_to_count["Softmax"], 0);
+  EXPECT_EQ(op_to_count["Attention"], 1);
+  for (const Node& node : graph.Nodes()) {
+    ASSERT_EQ(node.InputDefs().size(), 3u);
+    EXPECT_EQ(node.InputDefs()[0]->Name(), "x");
+    EXPECT_EQ(node.InputDefs()[1]->Name(), "weights");
+    EXPECT_EQ(node.InputDefs()[2]->Name(), "bias");
+    EXPECT_EQ(node.OutputDefs()[0]->Name(), "y");
+    EXPECT_EQ(node.GetAttributes().at("num_heads").i(), 2);
+    EXPECT_EQ(node.GetAttributes().at("unidirectional").i(), 1);
+  }
+}
+
+// (x * scale + bias) * Sigmoid(x * scale + bias) becomes one FusedElementwise node
+TEST(GraphTransformationTests, ElementwiseFusion) {
+  Model model("ElementwiseFusion", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto& x = AddFloatInput(graph, "x", {2, 4});
+  auto& scale = AddFloatInitializer(graph, "scale", {}, {2.0f});
+  auto& bias = AddFloatInitializer(graph, "bias", {4}, {0.0f, 1.0f, 2.0f, 3.0f});
+  auto& scaled = graph.GetOrCreateNodeArg("scaled", nullptr);
+  auto& biased = graph.GetOrCreateNodeArg("biased", nullptr);
+  auto& gate = graph.GetOrCreateNodeArg("gate", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("mul", "Mul", "", {&x, &scale}, {&scaled});
+  graph.AddNode("add", "Add", "", {&scaled, &bias}, {&biased});
+  graph.AddNode("sigmoid", "Sigmoid", "", {&biased}, {&gate});
+  graph.AddNode("gate_mul", "Mul", "", {&biased, &gate}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<ElementwiseFusion>(), TransformerLevel::Level3);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level3,
+                                                              DefaultLoggingManager().DefaultLogger()));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Mul"], 0);
+  EXPECT_EQ(op_to_count["Add"], 0);
+  EXPECT_EQ(op_to_count["Sigmoid"], 0);
+  ASSERT_EQ(op_to_count["FusedElementwise"], 1);
+  for (const Node& node : graph.Nodes()) {
+    ASSERT_EQ(node.InputDefs().size(), 3u);
+    EXPECT_EQ(node.InputDefs()[0]->Name(), "x");
+    EXPECT_EQ(node.InputDefs()[1]->Name(), "scale");
+    EXPECT_EQ(node.InputDefs()[2]->Name(), "bias");
+    EXPECT_EQ(node.OutputDefs()[0]->Name(), "y");
+    const auto& ops = node.GetAttributes().at("ops").strings();
+    EXPECT_EQ(std::vector<std::string>(ops.begin(), ops.end()),
+              (std::vector<std::string>{"Mul", "Add", "Sigmoid", "Mul"}));
+    const auto& operands = node.GetAttributes().at("operands").ints();
+    EXPECT_EQ(std::vector<int64_t>(operands.begin(), operands.end()),
+              (std::vector<int64_t>{0, 1, 3, 2, 4, -1, 4, 5}));
+  }
+}
+
+// a value read outside of the chain ends it, so the chain is split in two around that value
+TEST(GraphTransformationTests, ElementwiseFusionSharedValue) {
+  Model model("ElementwiseFusionSharedValue", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto& x = AddFloatInput(graph, "x", {2, 4});
+  auto& bias = AddFloatInitializer(graph, "bias", {4}, {0.0f, 1.0f, 2.0f, 3.0f});
+  auto& abs = graph.GetOrCreateNodeArg("abs", nullptr);
+  auto& biased = graph.GetOrCreateNodeArg("biased", nullptr);
+  auto& gate = graph.GetOrCreateNodeArg("gate", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("abs", "Abs", "", {&x}, {&abs});
+  graph.AddNode("add", "Add", "", {&abs, &bias}, {&biased});
+  graph.AddNode("tanh", "Tanh", "", {&biased}, {&gate});
+  graph.AddNode("gate_mul", "Mul", "", {&biased, &gate}, {&y});
+  graph.SetOutputs({&biased, &y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<ElementwiseFusion>(), TransformerLevel::Level3);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level3,
+                                                              DefaultLoggingManager().DefaultLogger()));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["FusedElementwise"], 2);
+  EXPECT_EQ(graph.NumberOfNodes(), 2);
+  for (const Node& node : graph.Nodes()) {
+    if (node.InputDefs()[0]->Name() == "x") {
+      EXPECT_EQ(node.OutputDefs()[0]->Name(), "biased");
+    } else {
+      EXPECT_EQ(node.InputDefs()[0]->Name(), "biased");
+      EXPECT_EQ(node.OutputDefs()[0]->Name(), "y");
+    }
+  }
+}
+
+TEST(GraphTransformationTests, SparseMatMulTransformer) {
+  Model model("SparseMatMulTransformer", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  // a [4, 3] weight with 10 zeros out of 12, and a dense one that is left alone
+  std::vector<float> sparse_weight(12, 0.0f);
+  sparse_weight[2] = 2.0f;
+  sparse_weight[9] = -1.0f;
+  auto& x = AddFloatInput(graph, "x", {2, 4});
+  auto& sparse_w = AddFloatInitializer(graph, "sparse_w", {4, 3}, sparse_weight);
+  auto& dense_w = AddFloatInitializer(graph, "dense_w", {3, 3}, std::vector<float>(9, 1.0f));
+  auto& hidden = graph.GetOrCreateNodeArg("hidden", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("sparse_matmul", "MatMul", "", {&x, &sparse_w}, {&hidden});
+  graph.AddNode("dense_matmul", "MatMul", "", {&hidden, &dense_w}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<SparseMatMulTransformer>(), TransformerLevel::Level2);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2,
+                                                              DefaultLoggingManager().DefaultLogger()));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["SparseMatMul"], 1);
+  EXPECT_EQ(op_to_count["MatMul"], 1);
+  for (const Node& node : graph.Nodes()) {
+    if (node.OpType() == "SparseMatMul") {
+      EXPECT_EQ(node.OutputDefs()[0]->Name(), "hidden");
+      const ONNX_NAMESPACE::TensorProto* values = nullptr;
+      ASSERT_TRUE(graph.GetInitializedTensor(node.InputDefs()[1]->Name(), values));
+      Initializer values_init{*values, graph.ModelPath()};
+      ASSERT_EQ(values_init.size(), 2);
+      EXPECT_EQ(values_init.data<float>()[0], 2.0f);
+      EXPECT_EQ(values_init.data<float>()[1], -1.0f);
+    }
+  }
+}
+
+// x -> MatMul(w) -> Softmax -> y on CUDA: the MatMul, which has a float16 kernel, runs in float16 between Casts, and
+// the Softmax, in the deny list, stays in float
+TEST(GraphTransformationTests, AutoMixedPrecisionMatMulSoftmax) {
+  Model model("AutoMixedPrecisionMatMulSoftmax", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto& x = AddFloatInput(graph, "x", {2, 2});
+  auto& w = AddFloatInitializer(graph, "w", {2, 2}, {1.f, 0.5f, -2.f, 0.25f});
+  auto& hidden = graph.GetOrCreateNodeArg("hidden", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("matmul", "MatMul", "", {&x, &w}, {&hidden});
+  graph.AddNode("softmax", "Softmax", "", {&hidden}, {&y});
+  graph.SetInputs({&x});
+  graph.SetOutputs({&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCudaExecutionProvider);
+  }
+
+  // the CUDA kernels of the test: a float16 MatMul, and a float only Softmax
+  auto registry = std::make_shared<KernelRegistry>();
+  auto fake_kernel = [](const OpKernelInfo&) -> OpKernel* { return nullptr; };
+  ASSERT_STATUS_OK(registry->Register(KernelCreateInfo(
+      KernelDefBuilder().SetName("MatMul").SetDomain(kOnnxDomain).SinceVersion(1).Provider(kCudaExecutionProvider)
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()).Build(),
+      fake_kernel)));
+  ASSERT_STATUS_OK(registry->Register(KernelCreateInfo(
+      KernelDefBuilder().SetName("Softmax").SetDomain(kOnnxDomain).SinceVersion(1).Provider(kCudaExecutionProvider)
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).Build(),
+      fake_kernel)));
+  KernelRegistryManager kernel_registry_manager;
+  kernel_registry_manager.RegisterKernelRegistry(registry);
+
+  AutoMixedPrecisionTransformer transformer(kernel_registry_manager, {}, {"Softmax"});
+  bool modified = false;
+  ASSERT_STATUS_OK(transformer.Apply(graph, modified, DefaultLoggingManager().DefaultLogger()));
+  EXPECT_TRUE(modified);
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["MatMul"], 1);
+  EXPECT_EQ(op_to_count["Softmax"], 1);
+  EXPECT_EQ(op_to_count["Cast"], 2);
+  const ONNX_NAMESPACE::TensorProto* w_initializer = nullptr;
+  EXPECT_FALSE(graph.GetInitializedTensor("w", w_initializer));
+  for (const Node& node : graph.Nodes()) {
+    EXPECT_EQ(node.GetExecutionProviderType(), kCudaExecutionProvider);
+    if (node.OpType() == "MatMul") {
+      for (const NodeArg* arg : node.InputDefs()) {
+        EXPECT_EQ(arg->TypeAsProto()->tensor_type().elem_type(), TensorProto_DataType_FLOAT16);
+      }
+      EXPECT_EQ(node.OutputDefs()[0]->TypeAsProto()->tensor_type().elem_type(), TensorProto_DataType_FLOAT16);
+      ASSERT_TRUE(graph.GetInitializedTensor(node.InputDefs()[1]->Name(), w_initializer));
+      EXPECT_EQ(w_initializer->data_type(), TensorProto_DataType_FLOAT16);
+      Initializer w_values{*w_initializer, graph.ModelPath()};
+      EXPECT_EQ(math::halfToFloat(w_values.data<MLFloat16>()[1].val), 0.5f);
+    } else if (node.OpType() == "Softmax") {
+      EXPECT_EQ(node.InputDefs()[0]->Name(), "hidden");
+      EXPECT_EQ(node.OutputDefs()[0]->Name(), "y");
+    }
+  }
+}
+
 #endif
 
 }  // namespace test
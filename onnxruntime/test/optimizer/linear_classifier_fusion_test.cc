@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/model.h"
+#include "core/optimizer/graph_transformer_mgr.h"
+#include "core/optimizer/linear_classifier_fusion.h"
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+// X -> Scaler -> Normalizer -> LinearClassifier, as exported for a scikit-learn pipeline. The scaled values are also
+// read by an Identity in the second graph, so only the Normalizer can be fused there.
+static void BuildPipeline(Graph& graph, bool scaled_is_read) {
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  TypeProto int64_tensor_type;
+  int64_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor_type);
+  auto& scaled = graph.GetOrCreateNodeArg("scaled", &float_tensor_type);
+  auto& normalized = graph.GetOrCreateNodeArg("normalized", &float_tensor_type);
+  auto& label = graph.GetOrCreateNodeArg("label", &int64_tensor_type);
+  auto& scores = graph.GetOrCreateNodeArg("scores", &float_tensor_type);
+
+  auto& scaler = graph.AddNode("scaler", "Scaler", "", {&x}, {&scaled}, nullptr, kMLDomain);
+  scaler.AddAttribute("scale", std::vector<float>{2.f, 0.5f});
+  scaler.AddAttribute("offset", std::vector<float>{1.f, -1.f});
+  auto& normalizer = graph.AddNode("normalizer", "Normalizer", "", {&scaled}, {&normalized}, nullptr, kMLDomain);
+  normalizer.AddAttribute("norm", std::string("L2"));
+  auto& classifier = graph.AddNode("classifier", "LinearClassifier", "", {&normalized}, {&label, &scores}, nullptr,
+                                   kMLDomain);
+  classifier.AddAttribute("coefficients", std::vector<float>{1.f, -1.f, -1.f, 1.f});
+  classifier.AddAttribute("intercepts", std::vector<float>{0.f, 0.5f});
+  classifier.AddAttribute("classlabels_ints", std::vector<int64_t>{0, 1});
+
+  std::vector<const NodeArg*> outputs{&label, &scores};
+  if (scaled_is_read) {
+    auto& scaled_copy = graph.GetOrCreateNodeArg("scaled_copy", &float_tensor_type);
+    graph.AddNode("identity", "Identity", "", {&scaled}, {&scaled_copy});
+    outputs.push_back(&scaled_copy);
+  }
+  graph.SetOutputs(outputs);
+}
+
+TEST(LinearClassifierFusionTest, FuseScalerAndNormalizer) {
+  Model model("LinearClassifierFusion", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  BuildPipeline(graph, false);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<LinearClassifierFusion>(), TransformerLevel::Level2);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2,
+                                                              DefaultLoggingManager().DefaultLogger()));
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Scaler"], 0);
+  EXPECT_EQ(op_to_count["Normalizer"], 0);
+  EXPECT_EQ(op_to_count["LinearClassifier"], 0);
+  ASSERT_EQ(op_to_count["FusedLinearClassifier"], 1);
+
+  for (const auto& node : graph.Nodes()) {
+    EXPECT_EQ(node.InputDefs()[0]->Name(), "X");
+    EXPECT_EQ(node.OutputDefs()[1]->Name(), "scores");
+    const auto& attrs = node.GetAttributes();
+    ASSERT_EQ(attrs.at("steps").strings_size(), 2);
+    EXPECT_EQ(attrs.at("steps").strings(0), "Scaler");
+    EXPECT_EQ(attrs.at("steps").strings(1), "Normalizer");
+    EXPECT_EQ(attrs.at("norm").s(), "L2");
+    EXPECT_EQ(attrs.at("scale").floats_size(), 2);
+  }
+}
+
+TEST(LinearClassifierFusionTest, KeepStepReadElsewhere) {
+  Model model("LinearClassifierFusion", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  BuildPipeline(graph, true);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<LinearClassifierFusion>(), TransformerLevel::Level2);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2,
+                                                              DefaultLoggingManager().DefaultLogger()));
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Scaler"], 1);
+  EXPECT_EQ(op_to_count["Normalizer"], 0);
+  EXPECT_EQ(op_to_count["FusedLinearClassifier"], 1);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
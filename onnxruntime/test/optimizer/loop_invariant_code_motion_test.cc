@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/model.h"
+#include "core/optimizer/graph_transformer_mgr.h"
+#include "core/optimizer/loop_invariant_code_motion.h"
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+// The Loop body computes v_out = v_in + Relu(x * scale) + RandomNormalLike(x), with x from the outer scope and scale
+// an initializer of the body. Mul and Relu are moved out of the body, RandomNormalLike and the Adds stay.
+TEST(LoopInvariantCodeMotionTest, HoistFromLoopBody) {
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  TypeProto int64_scalar_type;
+  int64_scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  int64_scalar_type.mutable_tensor_type()->mutable_shape();
+  TypeProto bool_scalar_type;
+  bool_scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  bool_scalar_type.mutable_tensor_type()->mutable_shape();
+
+  GraphProto body_proto;
+  {
+    Model body_model("LoopInvariantCodeMotion_body", false, DefaultLoggingManager().DefaultLogger());
+    auto& body = body_model.MainGraph();
+
+    TensorProto scale;
+    scale.set_name("scale");
+    scale.set_data_type(TensorProto_DataType_FLOAT);
+    scale.add_dims(2);
+    scale.add_float_data(2.f);
+    scale.add_float_data(3.f);
+    body.AddInitializedTensor(scale);
+
+    auto& iter = body.GetOrCreateNodeArg("iter", &int64_scalar_type);
+    auto& cond_in = body.GetOrCreateNodeArg("cond_in", &bool_scalar_type);
+    auto& v_in = body.GetOrCreateNodeArg("v_in", &float_tensor_type);
+    auto& x = body.GetOrCreateNodeArg("x", &float_tensor_type);
+    body.AddOuterScopeNodeArg("x");
+    auto& scale_arg = body.GetOrCreateNodeArg("scale", &float_tensor_type);
+
+    auto& scaled = body.GetOrCreateNodeArg("scaled", &float_tensor_type);
+    auto& activated = body.GetOrCreateNodeArg("activated", &float_tensor_type);
+    auto& random = body.GetOrCreateNodeArg("random", &float_tensor_type);
+    auto& sum = body.GetOrCreateNodeArg("sum", &float_tensor_type);
+    auto& v_out = body.GetOrCreateNodeArg("v_out", &float_tensor_type);
+    auto& cond_out = body.GetOrCreateNodeArg("cond_out", &bool_scalar_type);
+    body.AddNode("mul", "Mul", "", {&x, &scale_arg}, {&scaled});
+    body.AddNode("relu", "Relu", "", {&scaled}, {&activated});
+    body.AddNode("random", "RandomNormalLike", "", {&x}, {&random});
+    body.AddNode("add_activated", "Add", "", {&v_in, &activated}, {&sum});
+    body.AddNode("add_random", "Add", "", {&sum, &random}, {&v_out});
+    body.AddNode("cond", "Identity", "", {&cond_in}, {&cond_out});
+
+    body.SetInputs({&iter, &cond_in, &v_in});
+    body.SetOutputs({&cond_out, &v_out});
+    ASSERT_STATUS_OK(body.Resolve());
+    body_proto = body.ToGraphProto();
+  }
+
+  Model model("LoopInvariantCodeMotion", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  auto& max_trip_count = graph.GetOrCreateNodeArg("max_trip_count", &int64_scalar_type);
+  auto& cond = graph.GetOrCreateNodeArg("cond", &bool_scalar_type);
+  auto& v_initial = graph.GetOrCreateNodeArg("v_initial", &float_tensor_type);
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor_type);
+  auto& v_final = graph.GetOrCreateNodeArg("v_final", &float_tensor_type);
+  auto& loop = graph.AddNode("loop", "Loop", "", {&max_trip_count, &cond, &v_initial}, {&v_final});
+  loop.AddAttribute("body", body_proto);
+  graph.SetInputs({&max_trip_count, &cond, &v_initial, &x});
+  graph.SetOutputs({&v_final});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<LoopInvariantCodeMotion>(), TransformerLevel::Level1);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1,
+                                                              DefaultLoggingManager().DefaultLogger()));
+
+  std::map<std::string, int> main_graph_ops;
+  for (const auto& node : graph.Nodes()) {
+    main_graph_ops[node.OpType()]++;
+  }
+  EXPECT_EQ(main_graph_ops["Mul"], 1);
+  EXPECT_EQ(main_graph_ops["Relu"], 1);
+  EXPECT_EQ(main_graph_ops["RandomNormalLike"], 0);
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Mul"], 1);
+  EXPECT_EQ(op_to_count["Relu"], 1);
+  EXPECT_EQ(op_to_count["RandomNormalLike"], 1);
+  EXPECT_EQ(op_to_count["Add"], 2);
+
+  // the body reads the hoisted value from the outer scope
+  bool reads_hoisted_value = false;
+  for (const auto* implicit_input : graph.GetNode(loop.Index())->ImplicitInputDefs()) {
+    reads_hoisted_value = reads_hoisted_value || implicit_input->Name() == "activated";
+  }
+  EXPECT_TRUE(reads_hoisted_value);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
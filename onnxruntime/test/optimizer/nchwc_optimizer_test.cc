@@ -1171,6 +1171,58 @@ TEST(NchwcOptimizerTests, ConvReorderOutputCnhw) {
   NchwcOptimizerTester(build_test_case, check_nchwc_graph);
 }
 
+TEST(NchwcOptimizerTests, ConvReorderInputNhwc) {
+  auto build_test_case = [&](NchwcTestHelper& helper) {
+    auto* input_arg = helper.MakeInput({3, 27, 31, 64});
+    auto* nchw_input_arg = helper.MakeIntermediate();
+    auto* conv_output_arg = helper.MakeIntermediate();
+    auto* pool_output_arg = helper.MakeIntermediate();
+    auto* output_arg = helper.MakeOutput();
+
+    helper.AddTransposeToNchwNode(input_arg, nchw_input_arg);
+    helper.AddConvNode(nchw_input_arg, conv_output_arg, {32, 64, 3, 3});
+    auto& pool_node = helper.AddNode("MaxPool", {nchw_input_arg}, {pool_output_arg});
+    pool_node.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+    helper.AddNode("Concat", {conv_output_arg, pool_output_arg}, {output_arg})
+        .AddAttribute("axis", static_cast<int64_t>(1));
+  };
+
+  auto check_nchwc_graph = [&](NchwcInferenceSession& session) {
+    auto op_to_count = session.CountOpsInGraph();
+    EXPECT_EQ(op_to_count["nchwc.Conv"], 1);
+    EXPECT_EQ(op_to_count["nchwc.MaxPool"], 1);
+    EXPECT_EQ(op_to_count["nchwc.ReorderInput"], 1);
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+  };
+
+  // Verify that a NCHW transpose is fused into ReorderInput when all of its
+  // uses are converted to NCHWc.
+  NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+}
+
+TEST(NchwcOptimizerTests, ConvReorderInputNhwcMixedUsage) {
+  auto build_test_case = [&](NchwcTestHelper& helper) {
+    auto* input_arg = helper.MakeInput({1, 28, 32, 64});
+    auto* nchw_input_arg = helper.MakeIntermediate();
+    auto* conv_output_arg = helper.MakeOutput();
+    auto* neg_output_arg = helper.MakeOutput();
+
+    helper.AddTransposeToNchwNode(input_arg, nchw_input_arg);
+    helper.AddConvNode(nchw_input_arg, conv_output_arg, {32, 64, 1, 1});
+    helper.AddNode("Neg", {nchw_input_arg}, {neg_output_arg});
+  };
+
+  auto check_nchwc_graph = [&](NchwcInferenceSession& session) {
+    auto op_to_count = session.CountOpsInGraph();
+    EXPECT_EQ(op_to_count["nchwc.Conv"], 1);
+    EXPECT_EQ(op_to_count["nchwc.ReorderInput"], 1);
+    EXPECT_EQ(op_to_count["Transpose"], 1);
+  };
+
+  // Verify that the transpose is kept if it is also used in NCHW format.
+  NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+}
+
 TEST(NchwcOptimizerTests, Upsample) {
   auto test_case = [&](int opset_version, float scale_h, float scale_w) {
     auto build_test_case = [&](NchwcTestHelper& helper) {
@@ -0,0 +1,195 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/graph_utils.h"
+#include "core/graph/model.h"
+#include "core/optimizer/graph_transformer_mgr.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/qdq_fusion.h"
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+NodeArg& AddInput(Graph& graph, const std::string& name, const std::vector<int64_t>& dims) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_UINT8);
+  for (auto dim : dims) {
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+  return graph.GetOrCreateNodeArg(name, &type);
+}
+
+NodeArg& AddUInt8Initializer(Graph& graph, const std::string& name, const std::vector<uint8_t>& values,
+                             const std::vector<int64_t>& dims) {
+  TensorProto tensor_proto;
+  tensor_proto.set_name(name);
+  tensor_proto.set_data_type(TensorProto_DataType_UINT8);
+  for (auto dim : dims) {
+    tensor_proto.add_dims(dim);
+  }
+  tensor_proto.set_raw_data(values.data(), values.size());
+  graph.AddInitializedTensor(tensor_proto);
+  return graph.GetOrCreateNodeArg(name, nullptr);
+}
+
+NodeArg& AddFloatInitializer(Graph& graph, const std::string& name, const std::vector<float>& values,
+                             const std::vector<int64_t>& dims) {
+  TensorProto tensor_proto;
+  tensor_proto.set_name(name);
+  tensor_proto.set_data_type(TensorProto_DataType_FLOAT);
+  for (auto dim : dims) {
+    tensor_proto.add_dims(dim);
+  }
+  for (auto value : values) {
+    tensor_proto.add_float_data(value);
+  }
+  graph.AddInitializedTensor(tensor_proto);
+  return graph.GetOrCreateNodeArg(name, nullptr);
+}
+
+// Adds DequantizeLinear(input, scale, zero_point) and returns its output.
+NodeArg& AddDequantize(Graph& graph, NodeArg& input, float scale, uint8_t zero_point) {
+  auto& output = graph.GetOrCreateNodeArg(input.Name() + "_dq", nullptr);
+  graph.AddNode(input.Name() + "_dq", "DequantizeLinear", "",
+                {&input, &AddFloatInitializer(graph, input.Name() + "_scale", {scale}, {}),
+                 &AddUInt8Initializer(graph, input.Name() + "_zero_point", {zero_point}, {})},
+                {&output});
+  return output;
+}
+
+NodeArg& AddQuantize(Graph& graph, NodeArg& input, const std::string& name) {
+  auto& output = graph.GetOrCreateNodeArg(name, nullptr);
+  graph.AddNode(name, "QuantizeLinear", "",
+                {&input, &AddFloatInitializer(graph, name + "_scale", {0.5f}, {}),
+                 &AddUInt8Initializer(graph, name + "_zero_point", {100}, {})},
+                {&output});
+  return output;
+}
+
+std::unique_ptr<Model> CreateModel() {
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 10}};
+  return onnxruntime::make_unique<Model>("qdq_fusion", false, ModelMetaData(), PathString(),
+                                         IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+                                         std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                         DefaultLoggingManager().DefaultLogger());
+}
+
+Status ApplyQDQFusion(Graph& graph) {
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<QDQFusion>(), TransformerLevel::Level2);
+  return graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2,
+                                                    DefaultLoggingManager().DefaultLogger());
+}
+
+const Node* FindNode(const Graph& graph, const std::string& op_type) {
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == op_type) {
+      return &node;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST(QDQFusionTest, MatMulToQLinearMatMul) {
+  auto model = CreateModel();
+  auto& graph = model->MainGraph();
+
+  auto& a = AddInput(graph, "a", {2, 3});
+  auto& b = AddUInt8Initializer(graph, "b", std::vector<uint8_t>(12, 3), {3, 4});
+  auto& matmul_output = graph.GetOrCreateNodeArg("matmul", nullptr);
+  graph.AddNode("matmul", "MatMul", "", {&AddDequantize(graph, a, 0.1f, 128), &AddDequantize(graph, b, 0.2f, 0)},
+                {&matmul_output});
+  auto& y = AddQuantize(graph, matmul_output, "y");
+  graph.SetInputs({&a});
+  graph.SetOutputs({&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  ASSERT_STATUS_OK(ApplyQDQFusion(graph));
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
+  EXPECT_EQ(op_to_count["QuantizeLinear"], 0);
+  EXPECT_EQ(op_to_count["MatMul"], 0);
+  EXPECT_EQ(op_to_count["QLinearMatMul"], 1);
+  const auto* qlinear_matmul = FindNode(graph, "QLinearMatMul");
+  ASSERT_NE(qlinear_matmul, nullptr);
+  EXPECT_EQ(qlinear_matmul->InputDefs()[0]->Name(), "a");
+  EXPECT_EQ(qlinear_matmul->InputDefs()[3]->Name(), "b");
+  EXPECT_EQ(qlinear_matmul->InputDefs()[6]->Name(), "y_scale");
+  EXPECT_EQ(qlinear_matmul->OutputDefs()[0]->Name(), "y");
+}
+
+// The float output of the MatMul is kept, so the int32 result of MatMulInteger is scaled by a_scale * b_scale.
+TEST(QDQFusionTest, MatMulToMatMulInteger) {
+  auto model = CreateModel();
+  auto& graph = model->MainGraph();
+
+  auto& a = AddInput(graph, "a", {2, 3});
+  auto& b = AddUInt8Initializer(graph, "b", std::vector<uint8_t>(12, 3), {3, 4});
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("matmul", "MatMul", "", {&AddDequantize(graph, a, 0.5f, 128), &AddDequantize(graph, b, 0.25f, 0)},
+                {&y});
+  graph.SetInputs({&a});
+  graph.SetOutputs({&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  ASSERT_STATUS_OK(ApplyQDQFusion(graph));
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
+  EXPECT_EQ(op_to_count["MatMul"], 0);
+  EXPECT_EQ(op_to_count["MatMulInteger"], 1);
+  EXPECT_EQ(op_to_count["Cast"], 1);
+  EXPECT_EQ(op_to_count["Mul"], 1);
+  const auto* mul = FindNode(graph, "Mul");
+  ASSERT_NE(mul, nullptr);
+  EXPECT_EQ(mul->OutputDefs()[0]->Name(), "y");
+  const auto* scale = graph_utils::GetConstantInitializer(graph, mul->InputDefs()[1]->Name());
+  ASSERT_NE(scale, nullptr);
+  EXPECT_FLOAT_EQ(Initializer(*scale, graph.ModelPath()).data<float>()[0], 0.125f);
+}
+
+// The float bias of the Conv is quantized with x_scale * w_scale.
+TEST(QDQFusionTest, ConvToQLinearConv) {
+  auto model = CreateModel();
+  auto& graph = model->MainGraph();
+
+  auto& x = AddInput(graph, "x", {1, 1, 3, 3});
+  auto& w = AddUInt8Initializer(graph, "w", std::vector<uint8_t>(8, 2), {2, 1, 2, 2});
+  auto& bias = AddFloatInitializer(graph, "bias", {1.f, -0.5f}, {2});
+  auto& conv_output = graph.GetOrCreateNodeArg("conv", nullptr);
+  graph.AddNode("conv", "Conv", "", {&AddDequantize(graph, x, 0.5f, 0), &AddDequantize(graph, w, 0.25f, 0), &bias},
+                {&conv_output});
+  auto& y = AddQuantize(graph, conv_output, "y");
+  graph.SetInputs({&x});
+  graph.SetOutputs({&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  ASSERT_STATUS_OK(ApplyQDQFusion(graph));
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
+  EXPECT_EQ(op_to_count["QuantizeLinear"], 0);
+  EXPECT_EQ(op_to_count["Conv"], 0);
+  EXPECT_EQ(op_to_count["QLinearConv"], 1);
+  const auto* qlinear_conv = FindNode(graph, "QLinearConv");
+  ASSERT_NE(qlinear_conv, nullptr);
+  ASSERT_EQ(qlinear_conv->InputDefs().size(), 9u);
+  const auto* quantized_bias = graph_utils::GetConstantInitializer(graph, qlinear_conv->InputDefs()[8]->Name());
+  ASSERT_NE(quantized_bias, nullptr);
+  Initializer bias_values{*quantized_bias, graph.ModelPath()};
+  EXPECT_EQ(std::vector<int32_t>(bias_values.data<int32_t>(), bias_values.data<int32_t>() + 2),
+            (std::vector<int32_t>{8, -4}));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,152 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/graph_utils.h"
+#include "core/graph/model.h"
+#include "core/optimizer/graph_transformer_mgr.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/symbolic_shape_inference.h"
+#include "core/optimizer/symbolic_shape_transformer.h"
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+TEST(SymbolicShapeInferenceTest, DimExprArithmetic) {
+  const DimExpr batch("batch");
+  const DimExpr seq("seq");
+
+  const auto size = batch * seq * DimExpr(int64_t{768});
+  EXPECT_EQ(size.ToString(), "768*batch*seq");
+  EXPECT_EQ(size / (seq * DimExpr(int64_t{12})), DimExpr(int64_t{64}) * batch);
+  EXPECT_FALSE((size / DimExpr(int64_t{7})).IsKnown());
+
+  const auto expr = seq * DimExpr(int64_t{2}) + DimExpr(int64_t{1});
+  EXPECT_EQ(expr.ToString(), "2*seq+1");
+  EXPECT_EQ(DimExpr::FromDimParam(expr.ToString()), expr);
+  EXPECT_EQ(expr - seq - seq, DimExpr(int64_t{1}));
+  EXPECT_TRUE((expr - seq - seq).IsConstant());
+
+  // a dim_param that isn't an expression is a symbol of its own
+  EXPECT_EQ(DimExpr::FromDimParam("batch size"), DimExpr("batch size"));
+  EXPECT_NE(DimExpr(), DimExpr());
+}
+
+namespace {
+
+NodeArg& AddInt64Initializer(Graph& graph, const std::string& name, const std::vector<int64_t>& values,
+                             const std::vector<int64_t>& dims) {
+  TensorProto tensor_proto;
+  tensor_proto.set_name(name);
+  tensor_proto.set_data_type(TensorProto_DataType_INT64);
+  for (auto dim : dims) {
+    tensor_proto.add_dims(dim);
+  }
+  for (auto value : values) {
+    tensor_proto.add_int64_data(value);
+  }
+  graph.AddInitializedTensor(tensor_proto);
+  return graph.GetOrCreateNodeArg(name, nullptr);
+}
+
+// Unsqueeze(Gather(Shape(x), index), 0)
+NodeArg& AddShapeDim(Graph& graph, NodeArg& x, int64_t index) {
+  const auto suffix = std::to_string(index);
+  auto& shape = graph.GetOrCreateNodeArg("shape" + suffix, nullptr);
+  auto& dim = graph.GetOrCreateNodeArg("dim" + suffix, nullptr);
+  auto& unsqueezed = graph.GetOrCreateNodeArg("unsqueezed" + suffix, nullptr);
+  graph.AddNode("shape_node" + suffix, "Shape", "", {&x}, {&shape});
+  graph.AddNode("gather_node" + suffix, "Gather", "",
+                {&shape, &AddInt64Initializer(graph, "index" + suffix, {index}, {})}, {&dim});
+  graph.AddNode("unsqueeze_node" + suffix, "Unsqueeze", "", {&dim}, {&unsqueezed})
+      .AddAttribute("axes", std::vector<int64_t>{0});
+  return unsqueezed;
+}
+
+std::vector<int64_t> GetReshapeShape(const Graph& graph, const std::string& node_name) {
+  for (const auto& node : graph.Nodes()) {
+    if (node.Name() == node_name) {
+      const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+      if (tensor_proto == nullptr) {
+        return {};
+      }
+      Initializer initializer{*tensor_proto, graph.ModelPath()};
+      return std::vector<int64_t>(initializer.data<int64_t>(), initializer.data<int64_t>() + initializer.size());
+    }
+  }
+  return {};
+}
+
+}  // namespace
+
+// The Shape -> Gather -> Unsqueeze -> Concat chains of a multi-head attention layer are replaced by constants.
+TEST(SymbolicShapeInferenceTest, ReshapeShapeFromShapeChains) {
+  Model model("symbolic_shape", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto* input_shape = input_type.mutable_tensor_type()->mutable_shape();
+  input_shape->add_dim()->set_dim_param("batch");
+  input_shape->add_dim()->set_dim_param("seq");
+  input_shape->add_dim()->set_dim_value(768);
+  auto& x = graph.GetOrCreateNodeArg("x", &input_type);
+
+  // [batch, seq, 768] -> [batch, seq, 12, 64]
+  auto& dim0 = AddShapeDim(graph, x, 0);
+  auto& dim1 = AddShapeDim(graph, x, 1);
+  auto& split_shape = graph.GetOrCreateNodeArg("split_shape", nullptr);
+  graph.AddNode("concat_split", "Concat", "",
+                {&dim0, &dim1, &AddInt64Initializer(graph, "heads", {12, 64}, {2})}, {&split_shape})
+      .AddAttribute("axis", int64_t{0});
+  auto& split = graph.GetOrCreateNodeArg("split", nullptr);
+  graph.AddNode("reshape_split", "Reshape", "", {&x, &split_shape}, {&split});
+
+  // [batch, seq, 12, 64] -> [batch * seq, 768]
+  auto& tokens = graph.GetOrCreateNodeArg("tokens", nullptr);
+  graph.AddNode("mul_tokens", "Mul", "", {&dim0, &dim1}, {&tokens});
+  auto& merge_shape = graph.GetOrCreateNodeArg("merge_shape", nullptr);
+  graph.AddNode("concat_merge", "Concat", "",
+                {&tokens, &AddInt64Initializer(graph, "hidden", {768}, {1})}, {&merge_shape})
+      .AddAttribute("axis", int64_t{0});
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("reshape_merge", "Reshape", "", {&split, &merge_shape}, {&y});
+  graph.SetInputs({&x});
+  graph.SetOutputs({&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  SymbolicShapeInference inference(graph);
+  const auto* split_dims = inference.GetShape("split");
+  ASSERT_NE(split_dims, nullptr);
+  EXPECT_EQ(*split_dims, (SymbolicShape{DimExpr("batch"), DimExpr("seq"), DimExpr(int64_t{12}),
+                                        DimExpr(int64_t{64})}));
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<SymbolicShapeTransformer>(), TransformerLevel::Level1);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1,
+                                                              DefaultLoggingManager().DefaultLogger()));
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Shape"], 0);
+  EXPECT_EQ(op_to_count["Gather"], 0);
+  EXPECT_EQ(op_to_count["Unsqueeze"], 0);
+  EXPECT_EQ(op_to_count["Concat"], 0);
+  EXPECT_EQ(op_to_count["Mul"], 0);
+  EXPECT_EQ(op_to_count["Reshape"], 2);
+
+  EXPECT_EQ(GetReshapeShape(graph, "reshape_split"), (std::vector<int64_t>{0, 0, 12, 64}));
+  EXPECT_EQ(GetReshapeShape(graph, "reshape_merge"), (std::vector<int64_t>{-1, 768}));
+
+  const auto* y_shape = graph.GetNodeArg("y")->Shape();
+  ASSERT_NE(y_shape, nullptr);
+  ASSERT_EQ(y_shape->dim_size(), 2);
+  EXPECT_EQ(y_shape->dim(0).dim_param(), "batch*seq");
+  EXPECT_EQ(y_shape->dim(1).dim_value(), 768);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
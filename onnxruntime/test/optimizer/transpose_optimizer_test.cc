@@ -0,0 +1,161 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/graph_utils.h"
+#include "core/graph/model.h"
+#include "core/optimizer/graph_transformer_mgr.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/transpose_optimizer.h"
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+NodeArg& AddInput(Graph& graph, const std::string& name, const std::vector<int64_t>& dims) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (auto dim : dims) {
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+  return graph.GetOrCreateNodeArg(name, &type);
+}
+
+NodeArg& AddFloatInitializer(Graph& graph, const std::string& name, const std::vector<float>& values,
+                             const std::vector<int64_t>& dims) {
+  TensorProto tensor_proto;
+  tensor_proto.set_name(name);
+  tensor_proto.set_data_type(TensorProto_DataType_FLOAT);
+  for (auto dim : dims) {
+    tensor_proto.add_dims(dim);
+  }
+  for (auto value : values) {
+    tensor_proto.add_float_data(value);
+  }
+  graph.AddInitializedTensor(tensor_proto);
+  return graph.GetOrCreateNodeArg(name, nullptr);
+}
+
+Status ApplyTransposeOptimizer(Graph& graph) {
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<TransposeOptimizer>(), TransformerLevel::Level1);
+  return graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1,
+                                                    DefaultLoggingManager().DefaultLogger());
+}
+
+const Node* FindNode(const Graph& graph, const std::string& op_type) {
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == op_type) {
+      return &node;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+// NHWC -> NCHW -> Relu -> Add(per channel bias) -> NCHW -> NHWC: the Transposes cancel and the bias is transposed.
+TEST(TransposeOptimizerTest, CancelAroundElementwiseOps) {
+  Model model("transpose_optimizer", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto& x = AddInput(graph, "x", {1, 2, 2, 3});
+  auto& nchw = graph.GetOrCreateNodeArg("nchw", nullptr);
+  graph.AddNode("to_nchw", "Transpose", "", {&x}, {&nchw}).AddAttribute("perm", std::vector<int64_t>{0, 3, 1, 2});
+  auto& relu = graph.GetOrCreateNodeArg("relu", nullptr);
+  graph.AddNode("relu", "Relu", "", {&nchw}, {&relu});
+  auto& add = graph.GetOrCreateNodeArg("add", nullptr);
+  graph.AddNode("add", "Add", "", {&relu, &AddFloatInitializer(graph, "bias", {1.f, 2.f, 3.f}, {3, 1, 1})}, {&add});
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("to_nhwc", "Transpose", "", {&add}, {&y}).AddAttribute("perm", std::vector<int64_t>{0, 2, 3, 1});
+  graph.SetInputs({&x});
+  graph.SetOutputs({&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  ASSERT_STATUS_OK(ApplyTransposeOptimizer(graph));
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Transpose"], 0);
+  EXPECT_EQ(op_to_count["Relu"], 1);
+  EXPECT_EQ(op_to_count["Add"], 1);
+
+  const auto* add_node = FindNode(graph, "Add");
+  ASSERT_NE(add_node, nullptr);
+  const auto* relu_node = FindNode(graph, "Relu");
+  ASSERT_NE(relu_node, nullptr);
+  EXPECT_EQ(relu_node->InputDefs()[0]->Name(), "x");
+  EXPECT_EQ(add_node->InputDefs()[0], relu_node->OutputDefs()[0]);
+  EXPECT_EQ(add_node->OutputDefs()[0]->Name(), "y");
+  const auto* bias = graph_utils::GetConstantInitializer(graph, add_node->InputDefs()[1]->Name());
+  ASSERT_NE(bias, nullptr);
+  Initializer bias_values{*bias, graph.ModelPath()};
+  EXPECT_EQ(bias_values.dims(), (std::vector<int64_t>{1, 1, 1, 3}));
+  EXPECT_EQ(std::vector<float>(bias_values.data<float>(), bias_values.data<float>() + 3),
+            (std::vector<float>{1.f, 2.f, 3.f}));
+}
+
+// The reduced axes are mapped to the input of the Transpose, after which the dimensions left are in order.
+TEST(TransposeOptimizerTest, PushThroughReduce) {
+  Model model("transpose_optimizer", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto& x = AddInput(graph, "x", {2, 3, 4});
+  auto& transposed = graph.GetOrCreateNodeArg("transposed", nullptr);
+  graph.AddNode("transpose", "Transpose", "", {&x}, {&transposed})
+      .AddAttribute("perm", std::vector<int64_t>{2, 0, 1});
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  auto& reduce = graph.AddNode("reduce", "ReduceSum", "", {&transposed}, {&y});
+  reduce.AddAttribute("axes", std::vector<int64_t>{0});
+  reduce.AddAttribute("keepdims", int64_t{0});
+  graph.SetInputs({&x});
+  graph.SetOutputs({&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  ASSERT_STATUS_OK(ApplyTransposeOptimizer(graph));
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Transpose"], 0);
+  const auto* reduce_node = FindNode(graph, "ReduceSum");
+  ASSERT_NE(reduce_node, nullptr);
+  std::vector<int64_t> axes;
+  ASSERT_TRUE(graph_utils::GetRepeatedNodeAttributeValues(*reduce_node, "axes", axes));
+  EXPECT_EQ(axes, std::vector<int64_t>{2});
+  EXPECT_EQ(reduce_node->InputDefs()[0]->Name(), "x");
+}
+
+// A Transpose of the first input of a 2-D MatMul becomes the transA attribute of a Gemm.
+TEST(TransposeOptimizerTest, FoldIntoGemm) {
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 11}};
+  Model model("transpose_optimizer", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto& a = AddInput(graph, "a", {4, 3});
+  auto& transposed = graph.GetOrCreateNodeArg("transposed", nullptr);
+  graph.AddNode("transpose", "Transpose", "", {&a}, {&transposed}).AddAttribute("perm", std::vector<int64_t>{1, 0});
+  auto& b = AddFloatInitializer(graph, "b", std::vector<float>(20, 1.f), {4, 5});
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("matmul", "MatMul", "", {&transposed, &b}, {&y});
+  graph.SetInputs({&a});
+  graph.SetOutputs({&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  ASSERT_STATUS_OK(ApplyTransposeOptimizer(graph));
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Transpose"], 0);
+  EXPECT_EQ(op_to_count["MatMul"], 0);
+  const auto* gemm = FindNode(graph, "Gemm");
+  ASSERT_NE(gemm, nullptr);
+  EXPECT_EQ(gemm->InputDefs()[0]->Name(), "a");
+  EXPECT_EQ(gemm->GetAttributes().at("transA").i(), 1);
+  EXPECT_EQ(gemm->OutputDefs()[0]->Name(), "y");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -4,7 +4,9 @@
 #include "command_args_parser.h"
 
 #include <string.h>
+#include <cstdlib>
 #include <iostream>
+#include <sstream>
 
 // Windows Specific
 #ifdef _WIN32
@@ -27,8 +29,10 @@ namespace perftest {
   printf(
       "perf_test [options...] model_path result_file\n"
       "Options:\n"
-      "\t-m [test_mode]: Specifies the test mode. Value could be 'duration' or 'times'.\n"
+      "\t-m [test_mode]: Specifies the test mode. Value could be 'duration', 'times' or 'load'.\n"
       "\t\tProvide 'duration' to run the test for a fix duration, and 'times' to repeated for a certain times. \n"
+      "\t\tProvide 'load' to serve requests from -c clients over -n sessions for the -t duration and report the\n"
+      "\t\tlatency percentiles, throughput, CPU usage and peak memory. \n"
       "\t-M: Disable memory pattern.\n"
       "\t-A: Disable memory arena\n"
       "\t-c [parallel runs]: Specifies the (max) number of runs to invoke simultaneously. Default:1.\n"
@@ -47,18 +51,69 @@ namespace perftest {
       "\t-o [optimization level]: Default is 1. Valid values are 0 (disable), 1 (basic), 2 (extended), 99 (all).\n"
       "\t\tPlease see onnxruntime_c_api.h (enum GraphOptimizationLevel) for the full list of all optimization levels. \n"
       "\t-u [optimized_model_path]: Specify the optimized model path for saving.\n"
+      "\t-q [queries_per_second]: Arrival rate of the requests in 'load' mode, as a Poisson process. Default:0, each\n"
+      "\t\tclient sends its next request when the previous one completes.\n"
+      "\t-n [num_sessions]: Number of sessions the clients of 'load' mode are spread over. Default:1.\n"
+      "\t-w [warmup_seconds]: Seconds of 'load' mode whose requests aren't measured. Default:0.\n"
+      "\t-f [csv|json]: Format of the report of 'load' mode appended to the result file. Default:csv.\n"
+      "\t-g: Run with random inputs generated from the input metadata of the model instead of its test data.\n"
+      "\t-d [free_dimension_values]: Values of the free dimensions of the inputs, implies -g. The test runs for each\n"
+      "\t\tcombination of them, e.g. 'batch=1,8,32 seq=16..512' where 16..512 doubles from 16 up to 512. A free\n"
+      "\t\tdimension which isn't listed is 1.\n"
       "\t-h: help\n");
 }
 
+// Parses "name=v1,v2,... name=lo..hi ...", where lo..hi expands to lo, 2 * lo, 4 * lo, ... and hi.
+static bool ParseFreeDimensionValues(const std::string& text,
+                                     std::vector<std::pair<std::string, std::vector<int64_t>>>& free_dimension_values) {
+  std::istringstream ss(text);
+  std::string token;
+  while (ss >> token) {
+    const size_t eq = token.find('=');
+    if (eq == 0 || eq == std::string::npos || eq + 1 == token.size()) {
+      return false;
+    }
+
+    std::vector<int64_t> values;
+    const std::string spec = token.substr(eq + 1);
+    const size_t range = spec.find("..");
+    if (range != std::string::npos) {
+      const int64_t lo = std::strtoll(spec.c_str(), nullptr, 10);
+      const int64_t hi = std::strtoll(spec.c_str() + range + 2, nullptr, 10);
+      if (lo <= 0 || hi < lo) {
+        return false;
+      }
+      for (int64_t v = lo; v < hi; v *= 2) {
+        values.push_back(v);
+      }
+      values.push_back(hi);
+    } else {
+      std::istringstream values_ss(spec);
+      std::string value;
+      while (std::getline(values_ss, value, ',')) {
+        const int64_t v = std::strtoll(value.c_str(), nullptr, 10);
+        if (v <= 0) {
+          return false;
+        }
+        values.push_back(v);
+      }
+    }
+    free_dimension_values.emplace_back(token.substr(0, eq), std::move(values));
+  }
+  return !free_dimension_values.empty();
+}
+
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:o:u:AMPvhs"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:o:u:q:n:w:f:d:AMPvhsg"))) != -1) {
     switch (ch) {
       case 'm':
         if (!CompareCString(optarg, ORT_TSTR("duration"))) {
           test_config.run_config.test_mode = TestMode::kFixDurationMode;
         } else if (!CompareCString(optarg, ORT_TSTR("times"))) {
           test_config.run_config.test_mode = TestMode::KFixRepeatedTimesMode;
+        } else if (!CompareCString(optarg, ORT_TSTR("load"))) {
+          test_config.run_config.test_mode = TestMode::kLoadMode;
         } else {
           return false;
         }
@@ -170,6 +225,39 @@ namespace perftest {
       case 'u':
         test_config.run_config.optimized_model_path = optarg;
         break;
+      case 'q':
+        test_config.run_config.target_qps = OrtStrtod<PATH_CHAR_TYPE>(optarg, nullptr);
+        if (test_config.run_config.target_qps < 0) {
+          return false;
+        }
+        break;
+      case 'n':
+        test_config.run_config.num_sessions = static_cast<size_t>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
+        if (test_config.run_config.num_sessions <= 0) {
+          return false;
+        }
+        break;
+      case 'w':
+        test_config.run_config.warmup_seconds = static_cast<size_t>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
+        break;
+      case 'f':
+        if (!CompareCString(optarg, ORT_TSTR("csv"))) {
+          test_config.run_config.f_load_report_json = false;
+        } else if (!CompareCString(optarg, ORT_TSTR("json"))) {
+          test_config.run_config.f_load_report_json = true;
+        } else {
+          return false;
+        }
+        break;
+      case 'g':
+        test_config.run_config.generate_random_inputs = true;
+        break;
+      case 'd':
+        if (!ParseFreeDimensionValues(ToMBString(optarg), test_config.run_config.free_dimension_values)) {
+          return false;
+        }
+        test_config.run_config.generate_random_inputs = true;
+        break;
       case '?':
       case 'h':
       default:
@@ -11,10 +11,99 @@
 namespace onnxruntime {
 namespace perftest {
 
+namespace {
+
+template <typename T, typename Distribution>
+void FillRandom(Ort::Value& tensor, size_t count, Distribution distribution, std::mt19937& engine) {
+  T* data = tensor.GetTensorMutableData<T>();
+  for (size_t i = 0; i != count; ++i) {
+    data[i] = static_cast<T>(distribution(engine));
+  }
+}
+
+}  // namespace
+
+void OnnxRuntimeTestSession::GenerateRandomInputs(
+    const std::unordered_map<std::string, int64_t>& free_dimension_values) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::vector<Ort::Value> inputs;
+  for (size_t i = 0; i != input_names_.size(); ++i) {
+    Ort::TypeInfo type_info = session_.GetInputTypeInfo(i);
+    if (type_info.GetONNXType() != ONNX_TYPE_TENSOR) {
+      ORT_THROW("input ", input_names_[i], " isn't a tensor, random inputs can't be generated for it");
+    }
+
+    auto tensor_info = type_info.GetTensorTypeAndShapeInfo();
+    std::vector<int64_t> shape = tensor_info.GetShape();
+    std::vector<const char*> dim_params(shape.size(), nullptr);
+    tensor_info.GetSymbolicDimensions(dim_params.data(), dim_params.size());
+    size_t count = 1;
+    for (size_t d = 0; d != shape.size(); ++d) {
+      if (shape[d] < 0) {
+        auto value = dim_params[d] != nullptr ? free_dimension_values.find(dim_params[d]) : free_dimension_values.end();
+        shape[d] = value != free_dimension_values.end() ? value->second : 1;
+      }
+      count *= static_cast<size_t>(shape[d]);
+    }
+
+    const ONNXTensorElementDataType type = tensor_info.GetElementType();
+    Ort::Value tensor = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), type);
+    // the integers are small non-negative values, so they are valid indices such as token ids of any vocabulary
+    std::uniform_real_distribution<double> real(-1.0, 1.0);
+    std::uniform_int_distribution<int> integer(0, 9);
+    switch (type) {
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+        FillRandom<float>(tensor, count, real, rand_engine_);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+        FillRandom<double>(tensor, count, real, rand_engine_);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+        FillRandom<int8_t>(tensor, count, integer, rand_engine_);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+        FillRandom<uint8_t>(tensor, count, integer, rand_engine_);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+        FillRandom<int16_t>(tensor, count, integer, rand_engine_);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+        FillRandom<uint16_t>(tensor, count, integer, rand_engine_);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+        FillRandom<int32_t>(tensor, count, integer, rand_engine_);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+        FillRandom<uint32_t>(tensor, count, integer, rand_engine_);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+        FillRandom<int64_t>(tensor, count, integer, rand_engine_);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+        FillRandom<uint64_t>(tensor, count, integer, rand_engine_);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+        FillRandom<bool>(tensor, count, std::uniform_int_distribution<int>(0, 1), rand_engine_);
+        break;
+      default:
+        ORT_THROW("random inputs of element type ", type, " aren't supported, input ", input_names_[i]);
+    }
+    inputs.push_back(std::move(tensor));
+  }
+
+  test_inputs_.clear();
+  test_inputs_.push_back(std::move(inputs));
+}
+
+
 std::chrono::duration<double> OnnxRuntimeTestSession::Run() {
-  //Randomly pick one OrtValueArray from test_inputs_. (NOT ThreadSafe)
-  const std::uniform_int_distribution<int>::param_type p(0, static_cast<int>(test_inputs_.size() - 1));
-  const size_t id = static_cast<size_t>(dist_(rand_engine_, p));
+  //Randomly pick one OrtValueArray from test_inputs_. The clients of the load test mode share the session.
+  size_t id;
+  {
+    std::lock_guard<std::mutex> lock(rand_mutex_);
+    const std::uniform_int_distribution<int>::param_type p(0, static_cast<int>(test_inputs_.size() - 1));
+    id = static_cast<size_t>(dist_(rand_engine_, p));
+  }
   auto& input = test_inputs_.at(id);
   auto start = std::chrono::high_resolution_clock::now();
   auto output_values = session_.Run(Ort::RunOptions{nullptr}, input_names_.data(), input.data(), input_names_.size(),
@@ -3,6 +3,7 @@
 
 #pragma once
 #include <core/session/onnxruntime_cxx_api.h>
+#include <mutex>
 #include <random>
 #include "test_configuration.h"
 #include "test_session.h"
@@ -30,6 +31,8 @@ class OnnxRuntimeTestSession : public TestSession {
       free(p);
     }
   }
+  void GenerateRandomInputs(const std::unordered_map<std::string, int64_t>& free_dimension_values) override;
+
   std::chrono::duration<double> Run() override;
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OnnxRuntimeTestSession);
@@ -38,6 +41,7 @@ class OnnxRuntimeTestSession : public TestSession {
   Ort::Session session_{nullptr};
   std::mt19937 rand_engine_;
   std::uniform_int_distribution<int> dist_;
+  std::mutex rand_mutex_;  // Run is called concurrently in the load test mode
   std::vector<std::vector<Ort::Value>> test_inputs_;
   std::vector<std::string> output_names_;
   // The same size with output_names_.
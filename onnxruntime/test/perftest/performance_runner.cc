@@ -7,7 +7,12 @@
 #endif
 
 #include "performance_runner.h"
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
 #include <iostream>
+#include <thread>
 
 #include "TestCase.h"
 #include "TFModelInfo.h"
@@ -41,11 +46,133 @@ Eigen::ThreadPoolInterface* GetDefaultThreadPool(const onnxruntime::Env& env) {
 
 namespace onnxruntime {
 namespace perftest {
+double LoadTestResult::MeanLatency() const {
+  if (latencies.empty()) {
+    return 0;
+  }
+  double total = 0;
+  for (double latency : latencies) {
+    total += latency;
+  }
+  return total / latencies.size();
+}
+
+double LoadTestResult::LatencyPercentile(double p) const {
+  if (latencies.empty()) {
+    return 0;
+  }
+  // nearest rank
+  const auto rank = static_cast<size_t>(std::ceil(p * latencies.size()));
+  return latencies[std::min(std::max<size_t>(rank, 1), latencies.size()) - 1];
+}
+
+void LoadTestResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_json) const {
+  bool empty_file = true;
+  {
+    std::ifstream infile(path);
+    empty_file = !infile.good() || infile.peek() == std::ifstream::traits_type::eof();
+  }
+
+  std::ofstream outfile;
+  outfile.open(path, std::ofstream::out | std::ofstream::app);
+  if (!outfile.good()) {
+    printf("failed to open result file");
+    return;
+  }
+
+  const double throughput = measured_seconds > 0 ? num_completed / measured_seconds : 0;
+  const double min_ms = latencies.empty() ? 0 : latencies.front() * 1000;
+  const double max_ms = latencies.empty() ? 0 : latencies.back() * 1000;
+  if (f_json) {
+    outfile << "{\"model_name\": \"" << model_name << "\", \"num_sessions\": " << num_sessions
+            << ", \"num_clients\": " << num_clients << ", \"target_qps\": " << target_qps
+            << ", \"requests\": " << latencies.size() << ", \"errors\": " << num_errors
+            << ", \"throughput_qps\": " << throughput << ", \"min_ms\": " << min_ms
+            << ", \"mean_ms\": " << MeanLatency() * 1000 << ", \"p50_ms\": " << LatencyPercentile(0.5) * 1000
+            << ", \"p90_ms\": " << LatencyPercentile(0.9) * 1000 << ", \"p99_ms\": " << LatencyPercentile(0.99) * 1000
+            << ", \"p999_ms\": " << LatencyPercentile(0.999) * 1000 << ", \"max_ms\": " << max_ms
+            << ", \"cpu_usage_percent\": " << average_CPU_usage
+            << ", \"peak_workingset_bytes\": " << peak_workingset_size << "}" << std::endl;
+  } else {
+    if (empty_file) {
+      outfile << "model_name,num_sessions,num_clients,target_qps,requests,errors,throughput_qps,min_ms,mean_ms,p50_ms,"
+                 "p90_ms,p99_ms,p999_ms,max_ms,cpu_usage_percent,peak_workingset_bytes"
+              << std::endl;
+    }
+    outfile << model_name << "," << num_sessions << "," << num_clients << "," << target_qps << ","
+            << latencies.size() << "," << num_errors << "," << throughput << "," << min_ms << ","
+            << MeanLatency() * 1000 << "," << LatencyPercentile(0.5) * 1000 << "," << LatencyPercentile(0.9) * 1000
+            << "," << LatencyPercentile(0.99) * 1000 << "," << LatencyPercentile(0.999) * 1000 << "," << max_ms << ","
+            << average_CPU_usage << "," << peak_workingset_size << std::endl;
+  }
+  outfile.close();
+}
+
 Status PerformanceRunner::Run() {
   if (!Initialize()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize.");
   }
 
+  if (!performance_test_config_.run_config.generate_random_inputs) {
+    return RunTest();
+  }
+
+  // every combination of the free dimension values, the last dimension varying the fastest
+  const auto& free_dimension_values = performance_test_config_.run_config.free_dimension_values;
+  std::vector<size_t> indices(free_dimension_values.size(), 0);
+  const std::string model_name = performance_result_.model_name;
+  for (;;) {
+    std::unordered_map<std::string, int64_t> dimensions;
+    std::string label;
+    for (size_t d = 0; d != free_dimension_values.size(); ++d) {
+      const int64_t value = free_dimension_values[d].second[indices[d]];
+      dimensions[free_dimension_values[d].first] = value;
+      label += (d == 0 ? "" : " ") + free_dimension_values[d].first + "=" + std::to_string(value);
+    }
+
+    try {
+      for (auto& session : sessions_) {
+        session->GenerateRandomInputs(dimensions);
+      }
+    } catch (const std::exception& ex) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to generate the random inputs: ", ex.what());
+    }
+
+    std::cout << "Input dimensions:" << (label.empty() ? "default" : label) << std::endl;
+    performance_result_ = PerformanceResult();
+    performance_result_.model_name = label.empty() ? model_name : model_name + "[" + label + "]";
+    load_test_result_ = LoadTestResult();
+    ORT_RETURN_IF_ERROR(RunTest());
+    sweep_results_.emplace_back(label, performance_result_, load_test_result_);
+
+    size_t d = indices.size();
+    while (d > 0 && ++indices[d - 1] == free_dimension_values[d - 1].second.size()) {
+      indices[--d] = 0;
+    }
+    if (d == 0) {
+      break;
+    }
+  }
+
+  // the peak working set of the process only grows, so it is the peak of the largest inputs so far
+  std::cout << std::endl
+            << "input dimensions,average latency ms,p50 latency ms,p90 latency ms,p99 latency ms,peak working set bytes"
+            << std::endl;
+  const bool load_mode = performance_test_config_.run_config.test_mode == TestMode::kLoadMode;
+  for (const auto& result : sweep_results_) {
+    LoadTestResult latencies;
+    latencies.latencies = load_mode ? std::get<2>(result).latencies : std::get<1>(result).time_costs;
+    std::sort(latencies.latencies.begin(), latencies.latencies.end());
+    std::cout << std::get<0>(result) << "," << latencies.MeanLatency() * 1000 << ","
+              << latencies.LatencyPercentile(0.5) * 1000 << "," << latencies.LatencyPercentile(0.9) * 1000 << ","
+              << latencies.LatencyPercentile(0.99) * 1000 << ","
+              << (load_mode ? std::get<2>(result).peak_workingset_size : std::get<1>(result).peak_workingset_size)
+              << std::endl;
+  }
+  return Status::OK();
+}
+
+Status PerformanceRunner::RunTest() {
   // warm up
   RunOneIteration<true>();
 
@@ -61,6 +188,8 @@ Status PerformanceRunner::Run() {
     case TestMode::KFixRepeatedTimesMode:
       ORT_RETURN_IF_ERROR(RepeatedTimesTest());
       break;
+    case TestMode::kLoadMode:
+      return LoadTest();
     default:
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
   }
@@ -79,7 +208,8 @@ Status PerformanceRunner::Run() {
             << "Total inference requests:" << performance_result_.time_costs.size() << std::endl
             << "Average inference time cost:" << performance_result_.total_time_cost / performance_result_.time_costs.size() * 1000 << " ms" << std::endl
             // Time between start and end of run. Less than Total time cost when running requests in parallel.
-            << "Total inference run time:" << inference_duration.count() << " s" << std::endl;
+            << "Total inference run time:" << inference_duration.count() << " s" << std::endl
+            << "Peak working set size:" << performance_result_.peak_workingset_size << " bytes" << std::endl;
   return Status::OK();
 }
 
@@ -117,7 +247,7 @@ Status PerformanceRunner::RunParallelDuration() {
       count++;
       counter++;
       tpool->Schedule([this, &counter, &m, &cv]() {
-        session_->ThreadSafeRun();
+        sessions_.front()->ThreadSafeRun();
         // Simplified version of Eigen::Barrier
         std::lock_guard<std::mutex> lg(m);
         counter--;
@@ -168,6 +298,133 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::LoadTest() {
+  using Clock = std::chrono::high_resolution_clock;
+  const auto& run_config = performance_test_config_.run_config;
+  const size_t num_clients = std::max<size_t>(run_config.concurrent_session_runs, 1);
+  const bool open_loop = run_config.target_qps > 0;
+  const auto start = Clock::now();
+  const auto measure_start = start + std::chrono::seconds(run_config.warmup_seconds);
+  const auto measure_end = measure_start + std::chrono::seconds(run_config.duration_in_seconds);
+
+  // arrival times of the requests waiting for a client in open loop
+  std::deque<Clock::time_point> arrivals;
+  std::atomic<bool> done{false};
+  std::mutex m;
+  std::condition_variable cv;
+  std::mutex results_mutex;
+  LoadTestResult& result = load_test_result_;
+
+  std::vector<std::thread> clients;
+  for (size_t c = 0; c != num_clients; ++c) {
+    TestSession* session = sessions_[c % sessions_.size()].get();
+    clients.emplace_back([&, session, open_loop]() {
+      for (;;) {
+        Clock::time_point arrival;
+        if (open_loop) {
+          std::unique_lock<std::mutex> lock(m);
+          cv.wait(lock, [&]() { return done || !arrivals.empty(); });
+          // the requests which arrived before the end are served even if it passed
+          if (arrivals.empty()) {
+            break;
+          }
+          arrival = arrivals.front();
+          arrivals.pop_front();
+        } else {
+          if (done) {
+            break;
+          }
+          arrival = Clock::now();
+        }
+
+        bool succeeded = true;
+        try {
+          session->Run();
+        } catch (const std::exception& ex) {
+          succeeded = false;
+          if (run_config.f_verbose) {
+            std::cerr << ex.what() << std::endl;
+          }
+        }
+        const auto completion = Clock::now();
+
+        std::lock_guard<std::mutex> lock(results_mutex);
+        if (arrival >= measure_start && arrival < measure_end) {
+          if (succeeded) {
+            result.latencies.push_back(std::chrono::duration<double>(completion - arrival).count());
+          } else {
+            ++result.num_errors;
+          }
+        }
+        if (succeeded && completion >= measure_start && completion < measure_end) {
+          ++result.num_completed;
+        }
+      }
+    });
+  }
+
+  // the CPU usage is measured over the measurement window, while the requests arrive
+  std::unique_ptr<utils::ICPUUsage> cpu_usage = utils::CreateICPUUsage();
+  bool measuring = run_config.warmup_seconds == 0;
+  if (open_loop) {
+    std::exponential_distribution<double> inter_arrival_seconds(run_config.target_qps);
+    for (auto next = start; next < measure_end;
+         next += std::chrono::duration_cast<Clock::duration>(
+             std::chrono::duration<double>(inter_arrival_seconds(rand_engine_)))) {
+      std::this_thread::sleep_until(next);
+      if (!measuring && next >= measure_start) {
+        cpu_usage->Reset();
+        measuring = true;
+      }
+      {
+        std::lock_guard<std::mutex> lock(m);
+        arrivals.push_back(next);
+      }
+      cv.notify_one();
+    }
+    std::this_thread::sleep_until(measure_end);
+  } else {
+    std::this_thread::sleep_until(measure_start);
+    cpu_usage->Reset();
+    std::this_thread::sleep_until(measure_end);
+  }
+  result.average_CPU_usage = cpu_usage->GetUsage();
+
+  {
+    std::lock_guard<std::mutex> lock(m);
+    done = true;
+  }
+  cv.notify_all();
+  for (auto& client : clients) {
+    client.join();
+  }
+
+  result.model_name = performance_result_.model_name;
+  result.num_sessions = sessions_.size();
+  result.num_clients = num_clients;
+  result.target_qps = run_config.target_qps;
+  result.measured_seconds = std::chrono::duration<double>(measure_end - measure_start).count();
+  result.peak_workingset_size = utils::GetPeakWorkingSetSize();
+  std::sort(result.latencies.begin(), result.latencies.end());
+
+  std::chrono::duration<double> session_create_duration = session_create_end_ - session_create_start_;
+  std::cout << "Session creation time cost:" << session_create_duration.count() << " s" << std::endl
+            << "Measured requests:" << result.latencies.size() << ", errors:" << result.num_errors << std::endl
+            << "Throughput:" << result.num_completed / result.measured_seconds << " requests/s" << std::endl;
+  if (!result.latencies.empty()) {
+    std::cout << "Min Latency is " << result.latencies.front() << "sec" << std::endl
+              << "Mean Latency is " << result.MeanLatency() << "sec" << std::endl
+              << "P50 Latency is " << result.LatencyPercentile(0.5) << "sec" << std::endl
+              << "P90 Latency is " << result.LatencyPercentile(0.9) << "sec" << std::endl
+              << "P99 Latency is " << result.LatencyPercentile(0.99) << "sec" << std::endl
+              << "P999 Latency is " << result.LatencyPercentile(0.999) << "sec" << std::endl
+              << "Max Latency is " << result.latencies.back() << "sec" << std::endl;
+  }
+  std::cout << "Average CPU usage:" << result.average_CPU_usage << "%" << std::endl
+            << "Peak working set size:" << result.peak_workingset_size << " bytes" << std::endl;
+  return Status::OK();
+}
+
 static TestModelInfo* CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   if (CompareCString(performance_test_config_.backend.c_str(), ORT_TSTR("ort")) == 0) {
     return TestModelInfo::LoadOnnxModel(performance_test_config_.model_info.model_file_path.c_str());
@@ -193,9 +450,14 @@ static TestSession* CreateSession(Ort::Env& env, std::random_device& rd,
 }
 PerformanceRunner::PerformanceRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd)
     : performance_test_config_(test_config),
-      test_model_info_(CreateModelInfo(test_config)) {
+      test_model_info_(CreateModelInfo(test_config)),
+      rand_engine_(rd()) {
+  const size_t num_sessions =
+      test_config.run_config.test_mode == TestMode::kLoadMode ? test_config.run_config.num_sessions : 1;
   session_create_start_ = std::chrono::high_resolution_clock::now();
-  session_.reset(CreateSession(env, rd, test_config, test_model_info_));
+  for (size_t i = 0; i != num_sessions; ++i) {
+    sessions_.emplace_back(CreateSession(env, rd, test_config, test_model_info_));
+  }
   session_create_end_ = std::chrono::high_resolution_clock::now();
 }
 
@@ -219,24 +481,28 @@ bool PerformanceRunner::Initialize() {
   test_case_.reset(CreateOnnxTestCase(narrow_model_name, test_model_info_, 0.0, 0.0));
 
   // TODO: Place input tensor on cpu memory if dnnl provider type to avoid CopyTensor logic in CopyInputAcrossDevices
-  size_t test_data_count = test_case_->GetDataCount();
-  if (test_data_count == 0) {
+  // the random inputs are generated for each combination of the free dimension values by Run
+  size_t test_data_count = performance_test_config_.run_config.generate_random_inputs ? 0 : test_case_->GetDataCount();
+  if (test_data_count == 0 && !performance_test_config_.run_config.generate_random_inputs) {
     std::cout << "there is no test data for model " << test_case_->GetTestCaseName() << std::endl;
     return false;
   }
-  for (size_t test_data_id = 0; test_data_id != test_data_count; ++test_data_id) {
-    std::unordered_map<std::string, OrtValue*> feeds;
-    test_case_->LoadTestData(test_data_id /* id */, b_, feeds, true);
-    // Discard the names in feeds
-    int input_count = test_model_info_->GetInputCount();
-    for (int i = 0; i != input_count; ++i) {
-      auto iter = feeds.find(test_model_info_->GetInputName(i));
-      if (iter == feeds.end()) {
-        std::cout << "there is no test input data for input " << test_model_info_->GetInputName(i) << " and model "
-                  << test_case_->GetTestCaseName() << std::endl;
-        return false;
+  // each session owns its copy of the inputs
+  for (auto& session : sessions_) {
+    for (size_t test_data_id = 0; test_data_id != test_data_count; ++test_data_id) {
+      std::unordered_map<std::string, OrtValue*> feeds;
+      test_case_->LoadTestData(test_data_id /* id */, b_, feeds, true);
+      // Discard the names in feeds
+      int input_count = test_model_info_->GetInputCount();
+      for (int i = 0; i != input_count; ++i) {
+        auto iter = feeds.find(test_model_info_->GetInputName(i));
+        if (iter == feeds.end()) {
+          std::cout << "there is no test input data for input " << test_model_info_->GetInputName(i) << " and model "
+                    << test_case_->GetTestCaseName() << std::endl;
+          return false;
+        }
+        session->PreLoadTestData(test_data_id, static_cast<size_t>(i), iter->second);
       }
-      session_->PreLoadTestData(test_data_id, static_cast<size_t>(i), iter->second);
     }
   }
   test_case_.reset(nullptr);
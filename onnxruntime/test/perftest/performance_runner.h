@@ -11,6 +11,7 @@
 #include <iostream>
 #include <random>
 #include <chrono>
+#include <tuple>
 // onnxruntime dependencies
 #include <core/common/common.h>
 #include <core/common/status.h>
@@ -79,6 +80,31 @@ struct PerformanceResult {
   }
 };
 
+// Results of the load test mode, see RunConfig::target_qps.
+struct LoadTestResult {
+  std::string model_name;
+  size_t num_sessions{0};
+  size_t num_clients{0};
+  double target_qps{0};
+  // seconds from the arrival of each request of the measurement window until its completion, so the time waiting
+  // for a free client is included when the requests arrive faster than they are served
+  std::vector<double> latencies;
+  size_t num_errors{0};
+  // requests completed during the measurement window, and its length
+  size_t num_completed{0};
+  double measured_seconds{0};
+  short average_CPU_usage{0};
+  size_t peak_workingset_size{0};
+
+  // latencies must be sorted
+  double MeanLatency() const;
+  // nearest rank percentile, p in [0, 1]
+  double LatencyPercentile(double p) const;
+
+  // Appends the report to the file as a CSV line, after a header if the file is empty, or as a JSON object line.
+  void DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_json) const;
+};
+
 class PerformanceRunner {
  public:
   PerformanceRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd);
@@ -89,20 +115,38 @@ class PerformanceRunner {
   inline const PerformanceResult& GetResult() const { return performance_result_; }
 
   inline void SerializeResult() const {
-    performance_result_.DumpToFile(performance_test_config_.model_info.result_file_path,
-                                   performance_test_config_.run_config.f_dump_statistics);
+    if (sweep_results_.empty()) {
+      SerializeResult(performance_result_, load_test_result_);
+      return;
+    }
+    for (const auto& result : sweep_results_) {
+      SerializeResult(std::get<1>(result), std::get<2>(result));
+    }
   }
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PerformanceRunner);
 
  private:
   bool Initialize();
+  // runs the test mode with the current inputs
+  Status RunTest();
+
+  inline void SerializeResult(const PerformanceResult& performance_result,
+                              const LoadTestResult& load_test_result) const {
+    if (performance_test_config_.run_config.test_mode == TestMode::kLoadMode) {
+      load_test_result.DumpToFile(performance_test_config_.model_info.result_file_path,
+                                  performance_test_config_.run_config.f_load_report_json);
+      return;
+    }
+    performance_result.DumpToFile(performance_test_config_.model_info.result_file_path,
+                                  performance_test_config_.run_config.f_dump_statistics);
+  }
 
   template <bool isWarmup>
   Status RunOneIteration() {
     std::chrono::duration<double> duration_seconds;
 
     try {
-      duration_seconds = session_->Run();
+      duration_seconds = sessions_.front()->Run();
     } catch (const std::exception& ex) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunOneIteration caught exception: ", ex.what());
     }
@@ -123,6 +167,7 @@ class PerformanceRunner {
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
+  Status LoadTest();
 
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
@@ -142,9 +187,14 @@ class PerformanceRunner {
   std::chrono::time_point<std::chrono::high_resolution_clock> session_create_start_;
   std::chrono::time_point<std::chrono::high_resolution_clock> session_create_end_;
   PerformanceResult performance_result_;
+  LoadTestResult load_test_result_;
+  // input dimensions and results of each combination of the free dimension values with random inputs
+  std::vector<std::tuple<std::string, PerformanceResult, LoadTestResult>> sweep_results_;
   PerformanceTestConfig performance_test_config_;
   TestModelInfo* test_model_info_;
-  std::unique_ptr<TestSession> session_;
+  // a single session except in the load test mode
+  std::vector<std::unique_ptr<TestSession>> sessions_;
+  std::mt19937 rand_engine_;
   onnxruntime::test::HeapBuffer b_;
   std::unique_ptr<ITestCase> test_case_;
 
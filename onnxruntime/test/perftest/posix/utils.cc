@@ -4,11 +4,11 @@
 #include "test/perftest/utils.h"
 
 #include <cstddef>
+#include <thread>
 
 #include <sys/times.h>
 #include <sys/resource.h>
 
-#include "core/platform/env.h"
 
 namespace onnxruntime {
 namespace perftest {
@@ -37,7 +37,7 @@ class CPUUsage : public ICPUUsage {
     } else {
       clock_t proc_total_clock_diff = (time_sample.tms_stime - proc_sys_clock_start_) + (time_sample.tms_utime - proc_user_clock_start_);
       clock_t total_clock_diff = total_clock_now - total_clock_start_;
-      return static_cast<short>(100.0 * proc_total_clock_diff / total_clock_diff / onnxruntime::Env::Default().GetNumCpuCores());
+      return static_cast<short>(100.0 * proc_total_clock_diff / total_clock_diff / std::thread::hardware_concurrency());
     }
   }
 
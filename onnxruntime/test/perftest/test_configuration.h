@@ -5,6 +5,8 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "core/graph/constants.h"
 #include "core/framework/session_options.h"
@@ -14,7 +16,8 @@ namespace perftest {
 
 enum class TestMode : std::uint8_t {
   kFixDurationMode = 0,
-  KFixRepeatedTimesMode
+  KFixRepeatedTimesMode,
+  kLoadMode
 };
 
 enum class Platform : std::uint8_t {
@@ -49,6 +52,18 @@ struct RunConfig {
   int inter_op_num_threads{0};
   GraphOptimizationLevel optimization_level{ORT_ENABLE_ALL};
   std::basic_string<ORTCHAR_T> optimized_model_path;
+  // load test mode: requests arrive at target_qps as a Poisson process, or back to back on each client if 0. They
+  // are served by concurrent_session_runs client threads spread over num_sessions sessions for duration_in_seconds,
+  // after warmup_seconds whose requests aren't measured. The report is appended to the result file as CSV or JSON.
+  double target_qps{0};
+  size_t num_sessions{1};
+  size_t warmup_seconds{0};
+  bool f_load_report_json{false};
+  // random inputs shaped by the input metadata of the model instead of the test data of the model directory. A free
+  // dimension takes the values listed for its name in free_dimension_values, or 1, and the test runs once for each
+  // combination of them.
+  bool generate_random_inputs{false};
+  std::vector<std::pair<std::string, std::vector<int64_t>>> free_dimension_values;
 };
 
 struct PerformanceTestConfig {
@@ -3,7 +3,10 @@
 
 #pragma once
 #include <stdlib.h>
+#include <string>
+#include <unordered_map>
 
+#include "core/common/common.h"
 #include "OrtValueList.h"
 
 namespace onnxruntime {
@@ -16,6 +19,11 @@ class TestSession {
   // Please measure the perf at a higher level.
   void ThreadSafeRun() { abort(); }
   virtual void PreLoadTestData(size_t test_data_id, size_t input_id, OrtValue* value) = 0;
+  // Replaces the test data with random inputs shaped by the input metadata of the model, whose free dimensions take
+  // their values in free_dimension_values by name, or 1.
+  virtual void GenerateRandomInputs(const std::unordered_map<std::string, int64_t>& /*free_dimension_values*/) {
+    ORT_THROW("this backend doesn't support random inputs");
+  }
 
   virtual ~TestSession() = default;
 };
@@ -8,7 +8,9 @@
 #include <utility>
 #include <vector>
 
-#ifndef _WIN32
+#ifdef _WIN32
+#include <Windows.h>  // for GetSystemInfo()
+#else
 #include <unistd.h>  // for sysconf() and _SC_PAGESIZE
 #endif
 
@@ -109,9 +111,15 @@ TEST(FileIoTest, ReadFileIntoBuffer) {
   ASSERT_FALSE(Env::Default().ReadFileIntoBuffer(tmp.path.c_str(), 0, 3, gsl::make_span(buffer.data(), 2)).IsOK());
 }
 
-#ifndef _WIN32  // not implemented on Windows
 TEST(FileIoTest, MapFileIntoMemory) {
+#ifdef _WIN32
+  // mappings on Windows are aligned to the allocation granularity rather than to the page size
+  SYSTEM_INFO system_info;
+  GetSystemInfo(&system_info);
+  const long page_size = static_cast<long>(system_info.dwAllocationGranularity);
+#else
   static const auto page_size = sysconf(_SC_PAGESIZE);
+#endif
   ASSERT_GT(page_size, 0);
 
   TempFilePath tmp(ORT_TSTR("map_file_test_"));
@@ -144,7 +152,6 @@ TEST(FileIoTest, MapFileIntoMemory) {
     ASSERT_FALSE(Env::Default().MapFileIntoMemory(tmp.path.c_str(), -1, 0, mapped_memory).IsOK());
   }
 }
-#endif
 
 }  // namespace test
 }  // namespace onnxruntime
@@ -4,12 +4,16 @@
 #include "core/platform/threadpool.h"
 
 #include <core/common/make_unique.h>
+#include "core/platform/env.h"
+#include "core/util/thread_utils.h"
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <functional>
 #include <mutex>
+#include <thread>
 
 using namespace onnxruntime::concurrency;
 
@@ -54,6 +58,17 @@ void TestParallelFor(const std::string& name, int num_threads, int num_tasks) {
   ValidateTestData(*test_data);
 }
 
+void TestParallelForStdFunction(const std::string& name, int num_threads, int num_tasks) {
+  auto test_data = CreateTestData(num_tasks);
+  CreateThreadPoolAndTest(name, num_threads, [&](ThreadPool* tp) {
+    std::function<void(int32_t)> fn = [&](int i) {
+      IncrementElement(*test_data, i);
+    };
+    tp->ParallelFor(num_tasks, fn);
+  });
+  ValidateTestData(*test_data);
+}
+
 void TestBatchParallelFor(const std::string& name, int num_threads, int num_tasks, int batch_size) {
   auto test_data = CreateTestData(num_tasks);
   CreateThreadPoolAndTest(name, num_threads, [&](ThreadPool* tp) {
@@ -66,6 +81,16 @@ void TestBatchParallelFor(const std::string& name, int num_threads, int num_task
   ValidateTestData(*test_data);
 }
 
+void TestParallelForWithOptions(const std::string& name, int num_threads, int num_tasks,
+                                const ThreadOptions& thread_options) {
+  auto test_data = CreateTestData(num_tasks);
+  auto tp = onnxruntime::make_unique<ThreadPool>(name, num_threads, thread_options);
+  tp->ParallelFor(num_tasks, [&](int i) {
+    IncrementElement(*test_data, i);
+  });
+  ValidateTestData(*test_data);
+}
+
 }  // namespace
 
 TEST(ThreadPoolTest, TestParallelFor_2_Thread_NoTask) {
@@ -80,6 +105,14 @@ TEST(ThreadPoolTest, TestParallelFor_1_Thread_50_Task) {
   TestParallelFor("TestParallelFor_1_Thread_50_Task", 1, 50);
 }
 
+TEST(ThreadPoolTest, TestParallelFor_4_Thread_1000_Task) {
+  TestParallelFor("TestParallelFor_4_Thread_1000_Task", 4, 1000);
+}
+
+TEST(ThreadPoolTest, TestParallelFor_StdFunction_4_Thread_1000_Task) {
+  TestParallelForStdFunction("TestParallelFor_StdFunction_4_Thread_1000_Task", 4, 1000);
+}
+
 TEST(ThreadPoolTest, TestBatchParallelFor_2_Thread_50_Task_10_Batch) {
   TestBatchParallelFor("TestBatchParallelFor_2_Thread_50_Task_10_Batch", 2, 50, 10);
 }
@@ -99,3 +132,49 @@ TEST(ThreadPoolTest, TestBatchParallelFor_2_Thread_50_Task_100_Batch) {
 TEST(ThreadPoolTest, TestBatchParallelFor_2_Thread_81_Task_20_Batch) {
   TestBatchParallelFor("TestBatchParallelFor_2_Thread_81_Task_20_Batch", 2, 81, 20);
 }
+
+TEST(ThreadPoolTest, TestParallelFor_4_Thread_1000_Task_Spin) {
+  ThreadOptions thread_options;
+  thread_options.spin_duration_us = 1000;
+  TestParallelForWithOptions("TestParallelFor_4_Thread_1000_Task_Spin", 4, 1000, thread_options);
+}
+
+TEST(ThreadPoolTest, TestParallelFor_2_Thread_50_Task_NoWorkerSpinning_Affinity) {
+  ThreadOptions thread_options;
+  thread_options.allow_spinning = false;
+  // pinning is best effort, so a processor that is unavailable must not stop the pool from working
+  thread_options.affinity = {0};
+  TestParallelForWithOptions("TestParallelFor_2_Thread_50_Task_NoWorkerSpinning_Affinity", 2, 50, thread_options);
+}
+
+TEST(ThreadPoolTest, TestStats) {
+  auto tp = onnxruntime::make_unique<ThreadPool>("TestStats", 2);
+  ThreadPoolStats stats = tp->GetStats();
+  EXPECT_EQ(stats.num_threads, 2);
+  EXPECT_EQ(stats.num_tasks, 0);
+
+  const int num_tasks = 10;
+  std::atomic<int> num_calls{0};
+  for (int i = 0; i < num_tasks; ++i) {
+    tp->Schedule([&num_calls]() { ++num_calls; });
+  }
+
+  // a task is counted as completed right after it returns
+  while (tp->GetStats().num_tasks != num_tasks) {
+    std::this_thread::yield();
+  }
+  stats = tp->GetStats();
+  EXPECT_EQ(num_calls, num_tasks);
+  EXPECT_EQ(stats.queued_tasks, 0);
+  EXPECT_EQ(stats.active_workers, 0);
+}
+
+TEST(ThreadPoolTest, TestDefaultSizeIsPhysicalCores) {
+  // the logical processors sharing a physical core count once
+  const int num_cores = onnxruntime::Env::Default().GetNumCpuCores();
+  EXPECT_GE(num_cores, 1);
+  EXPECT_LE(num_cores, static_cast<int>(std::thread::hardware_concurrency()));
+
+  auto tp = CreateThreadPool("TestDefaultSizeIsPhysicalCores", 0);
+  EXPECT_EQ(tp == nullptr ? 1 : tp->NumThreads(), num_cores);
+}
@@ -12,6 +12,9 @@
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/default_providers.h"
 #include "test/framework/test_utils.h"
+#ifdef USE_CUDA
+#include "core/providers/cuda/cuda_execution_provider.h"
+#endif
 
 using namespace ONNX_NAMESPACE;
 
@@ -24,6 +27,7 @@ struct RunOptions {
   bool include_dim_values_in_subgraph = false;
   bool include_types_in_subgraph = false;
   bool mixed_execution_providers = false;
+  bool speculative_cuda_loop = false;
   bool init_cond_1d_tensor = true;
   bool init_iter_num_1d_tensor = true;
   bool subgraph_cond_1d_tensor = true;
@@ -357,6 +361,16 @@ void RunTest(int64_t max_iterations,
     execution_providers.push_back(DefaultCpuExecutionProvider());
 
     test.Run(expect_result, failure_message, {kTensorrtExecutionProvider}, nullptr, &execution_providers);
+#ifdef USE_CUDA
+  } else if (options.speculative_cuda_loop) {
+    CUDAExecutionProviderInfo info;
+    info.enable_speculative_loop = true;
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(onnxruntime::make_unique<CUDAExecutionProvider>(info));
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+
+    test.Run(expect_result, failure_message, {kTensorrtExecutionProvider}, nullptr, &execution_providers);
+#endif
   } else {
     test.Run(expect_result, failure_message, {kTensorrtExecutionProvider});  // Disable TensorRT because of unsupported data type INT64
   }
@@ -722,6 +736,14 @@ TEST(Loop, MixedExecutionProviders) {
 
   ExitDueToCond(options);
 }
+
+// the 'cond' of an iteration is read while the next one runs, and the next one is dropped when it's false
+TEST(Loop, SpeculativeCudaLoop) {
+  RunOptions options{};
+  options.speculative_cuda_loop = true;
+
+  ExitDueToCond(options);
+}
 #endif
 
 }  // namespace test
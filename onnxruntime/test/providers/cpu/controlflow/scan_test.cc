@@ -893,6 +893,70 @@ TEST(Scan9, TransposeOutputDim2) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", RunOptions().excluded_provider_types);
 }
 
+// without loop state variables the iterations are independent and run in parallel after the first. the output of
+// the subgraph has a symbolic dimension so the first iteration allocates the Scan outputs.
+TEST(Scan9, IndependentIterations) {
+  // Construct scan body subgraph with 2 scan inputs, 2 scan outputs
+  // scan-in-1 + scan-in-2 => scan-out-1
+  // scan-in-1 * scan-in-1 => scan-out-2
+  Model model("ScanBody", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("param");
+
+  auto& scan_in_1 = graph.GetOrCreateNodeArg("scan_in_1", &float_tensor);
+  auto& scan_in_2 = graph.GetOrCreateNodeArg("scan_in_2", &float_tensor);
+  auto& scan_out_1 = graph.GetOrCreateNodeArg("scan_out_1", &float_tensor);
+  auto& scan_out_2 = graph.GetOrCreateNodeArg("scan_out_2", &float_tensor);
+
+  graph.AddNode("add", "Add", "Add scan_in_1 and scan_in_2", {&scan_in_1, &scan_in_2}, {&scan_out_1});
+  graph.AddNode("mul", "Mul", "Square scan_in_1", {&scan_in_1, &scan_in_1}, {&scan_out_2});
+
+  graph.SetInputs({&scan_in_1, &scan_in_2});
+  graph.SetOutputs({&scan_out_1, &scan_out_2});
+
+  auto status = graph.Resolve();
+  EXPECT_EQ(status, Status::OK());
+
+  auto& scan_body = graph.ToGraphProto();
+
+  const int64_t sequence_len = 64;
+  const int64_t input_size = 3;
+  std::vector<float> input_1(sequence_len * input_size);
+  std::vector<float> input_2(sequence_len * input_size);
+  for (size_t i = 0; i < input_1.size(); ++i) {
+    input_1[i] = static_cast<float>(i);
+    input_2[i] = static_cast<float>(i % 5);
+  }
+
+  // scan_input_2 is read in reverse, and scan_output_2 is written in reverse
+  std::vector<float> output_1(input_1.size());
+  std::vector<float> output_2(input_1.size());
+  for (int64_t seq = 0; seq < sequence_len; ++seq) {
+    for (int64_t i = 0; i < input_size; ++i) {
+      const float value = input_1[seq * input_size + i];
+      output_1[seq * input_size + i] = value + input_2[(sequence_len - 1 - seq) * input_size + i];
+      output_2[(sequence_len - 1 - seq) * input_size + i] = value * value;
+    }
+  }
+
+  ScanOpTester test{9};
+
+  test.AddAttribute("body", scan_body);
+  test.AddAttribute<int64_t>("num_scan_inputs", 2);
+  test.AddAttribute<std::vector<int64_t>>("scan_input_directions", {0, 1});
+  test.AddAttribute<std::vector<int64_t>>("scan_output_directions", {0, 1});
+
+  test.AddInput<float>("scan_input_1", {sequence_len, input_size}, input_1);
+  test.AddInput<float>("scan_input_2", {sequence_len, input_size}, input_2);
+  test.AddOutput<float>("scan_output_1", {sequence_len, input_size}, output_1);
+  test.AddOutput<float>("scan_output_2", {sequence_len, input_size}, output_2);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", RunOptions().excluded_provider_types);
+}
+
 static void InvalidInput(bool is_v8) {
   const int64_t batch_size = 1;
   const int64_t sequence_len = 2;
@@ -3,13 +3,66 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "core/common/make_unique.h"
+#include "core/providers/cpu/generator/philox.h"
 
 #include <algorithm>
-#include <random>
 using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
 namespace test {
 
+namespace {
+// The uniform values in [0, 1) of the type of the first argument of the first Compute call of a kernel with the seed,
+// generated from one counter after the other.
+std::vector<float> ReferenceUniform(float, float seed, int64_t size) {
+  std::vector<float> values;
+  for (uint64_t counter = 0; static_cast<int64_t>(values.size()) < size; ++counter) {
+    uint32_t bits[4];
+    PhiloxGenerator::Generate(gsl::narrow_cast<uint32_t>(seed), counter, bits);
+    for (uint32_t b : bits) {
+      values.push_back(philox::ToUniform(b));
+    }
+  }
+  values.resize(size);
+  return values;
+}
+
+std::vector<double> ReferenceUniform(double, float seed, int64_t size) {
+  std::vector<double> values;
+  for (uint64_t counter = 0; static_cast<int64_t>(values.size()) < size; ++counter) {
+    uint32_t bits[4];
+    PhiloxGenerator::Generate(gsl::narrow_cast<uint32_t>(seed), counter, bits);
+    values.push_back(philox::ToUniform(bits[0] | static_cast<uint64_t>(bits[1]) << 32));
+    values.push_back(philox::ToUniform(bits[2] | static_cast<uint64_t>(bits[3]) << 32));
+  }
+  values.resize(size);
+  return values;
+}
+
+template <typename T>
+std::vector<T> ReferenceUniform(float seed, float low, float high, int64_t size) {
+  std::vector<T> values = ReferenceUniform(T{}, seed, size);
+  for (T& value : values) {
+    value = static_cast<T>(low) + (static_cast<T>(high) - static_cast<T>(low)) * value;
+  }
+  return values;
+}
+
+template <typename T>
+std::vector<T> ReferenceNormal(float seed, float mean, float scale, int64_t size) {
+  // the values of each counter are an even count, so the pairs never span two counters
+  std::vector<T> values = ReferenceUniform(T{}, seed, size + 1);
+  for (size_t i = 0; i + 1 < values.size(); i += 2) {
+    T z0, z1;
+    philox::BoxMuller(values[i], values[i + 1], z0, z1);
+    values[i] = static_cast<T>(mean) + static_cast<T>(scale) * z0;
+    values[i + 1] = static_cast<T>(mean) + static_cast<T>(scale) * z1;
+  }
+  values.resize(size);
+  return values;
+}
+}  // namespace
+
 TEST(Random, RandomNormal2DDouble) {
   OpTester test("RandomNormal");
 
@@ -25,12 +78,7 @@ TEST(Random, RandomNormal2DDouble) {
   test.AddAttribute<int64_t>("dtype", TensorProto::DOUBLE);
   test.AddAttribute("shape", dims);
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::normal_distribution<double> distribution{mean, scale};
-
-  std::vector<double> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](double& value) { value = distribution(generator); });
+  std::vector<double> expected_output = ReferenceNormal<double>(seed, mean, scale, TensorShape(dims).Size());
 
   test.AddOutput<double>("Y", dims, expected_output);
   test.Run();
@@ -59,12 +107,7 @@ void RunRandomNormalLike3DFloat(bool infer_dtype = false) {
                         0.f, 0.f, 0.f,
                         0.f, 0.f, 0.f});
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::normal_distribution<float> distribution{mean, scale};
-
-  std::vector<float> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](float& value) { value = distribution(generator); });
+  std::vector<float> expected_output = ReferenceNormal<float>(seed, mean, scale, TensorShape(dims).Size());
 
   test.AddOutput<float>("Y", dims, expected_output);
 
@@ -95,12 +138,7 @@ TEST(Random, RandomUniform1DFloat) {
   test.AddAttribute<int64_t>("dtype", TensorProto::FLOAT);
   test.AddAttribute("shape", dims);
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::uniform_real_distribution<float> distribution{low, high};
-
-  std::vector<float> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](float& value) { value = distribution(generator); });
+  std::vector<float> expected_output = ReferenceUniform<float>(seed, low, high, TensorShape(dims).Size());
 
   test.AddOutput<float>("Y", dims, expected_output);
 
@@ -128,12 +166,7 @@ void RunRandomUniformLikeTest(bool infer_dtype = false) {
                         {0., 0., 0., 0., 0., 0.,
                          0., 0., 0., 0., 0., 0.});
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::uniform_real_distribution<double> distribution{low, high};
-
-  std::vector<double> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](double& value) { value = distribution(generator); });
+  std::vector<double> expected_output = ReferenceUniform<double>(seed, low, high, TensorShape(dims).Size());
 
   test.AddOutput<double>("Y", dims, expected_output);
 
@@ -149,6 +182,63 @@ TEST(Random, RandomUniformLikeInferDType) {
   RunRandomUniformLikeTest(infer_dtype);
 }
 
+TEST(Random, RandomNormalLargeFloat) {
+  // spans several of the blocks generated in parallel
+  OpTester test("RandomNormal");
+
+  std::vector<int64_t> dims{100, 1001};
+
+  float scale = 2.f;
+  float mean = 1.f;
+  float seed = 7.f;
+
+  test.AddAttribute("scale", scale);
+  test.AddAttribute("mean", mean);
+  test.AddAttribute("seed", seed);
+  test.AddAttribute<int64_t>("dtype", TensorProto::FLOAT);
+  test.AddAttribute("shape", dims);
+
+  std::vector<float> expected_output = ReferenceNormal<float>(seed, mean, scale, TensorShape(dims).Size());
+  test.AddOutput<float>("Y", dims, expected_output);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(Random, PhiloxKnownAnswer) {
+  // Random123 known answer for the counter and key 0
+  uint32_t bits[4];
+  PhiloxGenerator::Generate(0, 0, bits);
+  EXPECT_EQ(bits[0], 0x6627e8d5u);
+  EXPECT_EQ(bits[1], 0xe169c58du);
+  EXPECT_EQ(bits[2], 0xbc57ac4cu);
+  EXPECT_EQ(bits[3], 0x9b00dbd8u);
+}
+
+TEST(Random, PhiloxSameValuesForAnyThreadCount) {
+  const int64_t size = 100003;
+  std::vector<float> sequential(size), parallel(size);
+  philox::GenerateNormal<float>(42, 5, 0.f, 1.f, sequential.data(), size, nullptr);
+  auto tp = onnxruntime::make_unique<concurrency::ThreadPool>("PhiloxTest", 4);
+  philox::GenerateNormal<float>(42, 5, 0.f, 1.f, parallel.data(), size, tp.get());
+  EXPECT_EQ(sequential, parallel);
+
+  double mean = 0.;
+  double square_mean = 0.;
+  for (float value : parallel) {
+    mean += value;
+    square_mean += static_cast<double>(value) * value;
+  }
+  mean /= size;
+  square_mean /= size;
+  EXPECT_NEAR(mean, 0., 0.02);
+  EXPECT_NEAR(square_mean - mean * mean, 1., 0.02);
+
+  // the next counters of the generator give other values
+  PhiloxGenerator generator(42);
+  EXPECT_EQ(generator.NextCounters(philox::NumCounters<float>(size)), 0u);
+  EXPECT_EQ(generator.NextCounters(1), static_cast<uint64_t>(philox::NumCounters<float>(size)));
+}
+
 TEST(Random, InvalidDType) {
   float seed = 123.f;
 
@@ -5,6 +5,10 @@
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/default_providers.h"
 #include "core/util/math.h"
+#include "core/framework/kernel_registry.h"
+#include "core/graph/model.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "test/test_environment.h"
 #include <algorithm>
 #include <cmath>
 
@@ -276,6 +280,105 @@ TEST(MathOpTest, Add_Broadcast_2x1x1_3x4) {
 #endif
 }
 
+// The output is large enough to be split into blocks that are computed in parallel, with spans crossing the
+// block boundaries.
+TEST(MathOpTest, Add_Broadcast_Large_3x1x2000_1x7x1) {
+  OpTester test("Add");
+
+  std::vector<float> a(3 * 2000), b(7), c(3 * 7 * 2000);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<float>(i % 1000);
+  }
+  for (size_t i = 0; i < b.size(); ++i) {
+    b[i] = static_cast<float>(i) * 1000.0f;
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 7; ++j) {
+      for (size_t k = 0; k < 2000; ++k) {
+        c[(i * 7 + j) * 2000 + k] = a[i * 2000 + k] + b[j];
+      }
+    }
+  }
+
+  test.AddInput<float>("A", {3, 1, 2000}, a);
+  test.AddInput<float>("B", {1, 7, 1}, b);
+  test.AddOutput<float>("C", {3, 7, 2000}, c);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(MathOpTest, Mul_Broadcast_Large_3x7x1000_7x1000) {
+  OpTester test("Mul");
+
+  std::vector<float> a(3 * 7 * 1000), b(7 * 1000), c(3 * 7 * 1000);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<float>(i % 100);
+  }
+  for (size_t i = 0; i < b.size(); ++i) {
+    b[i] = static_cast<float>(i % 7) - 3.0f;
+  }
+  for (size_t i = 0; i < c.size(); ++i) {
+    c[i] = a[i] * b[i % b.size()];
+  }
+
+  test.AddInput<float>("A", {3, 7, 1000}, a);
+  test.AddInput<float>("B", {7, 1000}, b);
+  test.AddOutput<float>("C", {3, 7, 1000}, c);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+// B broadcast along the last axis and per channel, with the axes a multiple of the CUDA vector size
+TEST(MathOpTest, Add_Broadcast_Vectorized) {
+  std::vector<float> a(2 * 3 * 8), row(8), channel(3), row_c(a.size()), channel_c(a.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<float>(i);
+  }
+  for (size_t i = 0; i < row.size(); ++i) {
+    row[i] = static_cast<float>(i) * 100.0f;
+  }
+  for (size_t i = 0; i < channel.size(); ++i) {
+    channel[i] = static_cast<float>(i) * 1000.0f;
+  }
+  for (size_t i = 0; i < a.size(); ++i) {
+    row_c[i] = a[i] + row[i % 8];
+    channel_c[i] = a[i] + channel[i / 8 % 3];
+  }
+
+  OpTester row_test("Add");
+  row_test.AddInput<float>("A", {2, 3, 8}, a);
+  row_test.AddInput<float>("B", {8}, row);
+  row_test.AddOutput<float>("C", {2, 3, 8}, row_c);
+  row_test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+
+  OpTester channel_test("Add");
+  channel_test.AddInput<float>("A", {2, 3, 8}, a);
+  channel_test.AddInput<float>("B", {3, 1}, channel);
+  channel_test.AddOutput<float>("C", {2, 3, 8}, channel_c);
+  channel_test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+// the last elements don't fill a CUDA vector
+TEST(MathOpTest, Sub_Vectorized_Partial_Vector) {
+  std::vector<float> a(13), b(13), c(13), scalar_c(13);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<float>(i);
+    b[i] = static_cast<float>(i * i);
+    c[i] = a[i] - b[i];
+    scalar_c[i] = 2.0f - b[i];
+  }
+
+  OpTester test("Sub");
+  test.AddInput<float>("A", {13}, a);
+  test.AddInput<float>("B", {13}, b);
+  test.AddOutput<float>("C", {13}, c);
+  test.Run();
+
+  OpTester scalar_test("Sub");
+  scalar_test.AddInput<float>("A", {1}, {2.0f});
+  scalar_test.AddInput<float>("B", {13}, b);
+  scalar_test.AddOutput<float>("C", {13}, scalar_c);
+  scalar_test.Run();
+}
+
 // Validate runtime failure has useful error message when ORT_ENFORCE is used
 TEST(MathOpTest, Add_Invalid_Broadcast) {
   OpTester test("Add");
@@ -1415,6 +1518,36 @@ TEST(MathOpTest, Expand_8_1x3_float16) {
   test.Run();
 }
 
+// large enough to be expanded across the thread pool
+TEST(MathOpTest, Expand_8_Large) {
+  const int64_t channels = 256;
+  std::vector<float> input(channels);
+  for (int64_t c = 0; c < channels; ++c) {
+    input[c] = static_cast<float>(c);
+  }
+  std::vector<float> output;
+  output.reserve(64 * channels * 32);
+  for (int64_t n = 0; n < 64; ++n) {
+    for (int64_t c = 0; c < channels; ++c) {
+      output.insert(output.end(), 32, input[c]);
+    }
+  }
+
+  OpTester test("Expand", 8);
+  test.AddInput<float>("data_0", {channels, 1}, input);
+  test.AddInput<int64_t>("data_1", {3}, {64, 1, 32});
+  test.AddOutput<float>("result", {64, channels, 32}, output);
+  test.Run();
+}
+
+TEST(MathOpTest, Expand_8_InvalidShape) {
+  OpTester test("Expand", 8);
+  test.AddInput<float>("data_0", {3}, {1.0f, 2.0f, 3.0f});
+  test.AddInput<int64_t>("data_1", {2}, {2, 2});
+  test.AddOutput<float>("result", {2, 2}, {1.0f, 2.0f, 1.0f, 2.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "can't be broadcast");
+}
+
 TEST(MathOpTest, Erf) {
   OpTester test("Erf", 9);
   std::vector<int64_t> dims{2, 2};
@@ -1707,5 +1840,31 @@ TEST(BitShiftOpTest, BroadcastXRight_Uint8) {
   test.Run();
 }
 
+// the allocation planner can only run these ops in-place if their kernels declare it
+TEST(MathOpTest, UnaryElementwiseOpsMayInplace) {
+  CPUExecutionProvider cpu_provider{CPUExecutionProviderInfo()};
+  auto registry = cpu_provider.GetKernelRegistry();
+
+  for (const auto* op_type : {"Abs", "Neg", "Floor", "Ceil", "Reciprocal", "Sqrt", "Exp", "Log", "Erf", "Round",
+                              "Sign", "Sin", "Cos", "Tan", "Asin", "Acos", "Atan", "Sinh", "Cosh", "Asinh", "Acosh",
+                              "Atanh", "Relu", "Sigmoid", "Tanh"}) {
+    onnxruntime::Model model("test", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+    ONNX_NAMESPACE::TypeProto float_tensor;
+    float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    auto& input = graph.GetOrCreateNodeArg("X", &float_tensor);
+    auto& output = graph.GetOrCreateNodeArg("Y", &float_tensor);
+    auto& node = graph.AddNode("node", op_type, "", {&input}, {&output});
+    ASSERT_TRUE(graph.Resolve().IsOK()) << op_type;
+    node.SetExecutionProviderType(kCpuExecutionProvider);
+
+    const auto* kernel_create_info = registry->TryFindKernel(node, kCpuExecutionProvider);
+    ASSERT_NE(kernel_create_info, nullptr) << op_type;
+    const auto& may_inplace = kernel_create_info->kernel_def->MayInplace();
+    EXPECT_NE(std::find(may_inplace.cbegin(), may_inplace.cend(), std::make_pair(0, 0)), may_inplace.cend())
+        << op_type << " should allow its input to be reused for its output";
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
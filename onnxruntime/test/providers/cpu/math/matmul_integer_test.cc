@@ -8,6 +8,7 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
+#include "core/util/qmath.h"
 
 #include <random>
 
@@ -246,6 +247,18 @@ TEST(MatmulIntegerOpTest, MatMulInteger_WithZero_ZeroPoint) {
   test.Run();
 }
 
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+TEST(MatmulIntegerOpTest, MatMulInteger_Uint8_Int8_Zero_Point) {
+  OpTester test("MatMulInteger", 10);
+  test.AddInput<uint8_t>("T1", {4, 3}, {11, 7, 3, 10, 6, 2, 9, 5, 1, 8, 4, 0});
+  test.AddInput<int8_t>("T2", {3, 2}, {1, -4, 2, 5, -3, 6});
+  test.AddInput<uint8_t>("a_zero_point", {}, {1});
+  test.AddInput<int8_t>("b_zero_point", {}, {1});
+  test.AddOutput<int32_t>("T3", {4, 2}, {-2, -16, 1, -20, 4, -24, 7, -28});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kNGraphExecutionProvider});
+}
+#endif
+
 template <typename T>
 std::vector<T> ToVector(const int* value, int size) {
   std::vector<T> data(size);
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "test/common/cuda_op_test_utils.h"
 #include "test/providers/provider_test_utils.h"
 
 namespace onnxruntime {
@@ -58,5 +59,38 @@ TEST(QuantizeLinearMatmulOpTest, QLinearMatMul) {
   test.AddOutput<uint8_t>("T3", {2, 3}, {168, 115, 255, 1, 66, 151});
   test.Run();
 }
+TEST(QuantizeLinearMatmulOpTest, QLinearMatMulInt8Weight) {
+  OpTester test("QLinearMatMul", 10);
+  test.AddInput<uint8_t>("T1", {2, 4}, {208, 236, 0, 238, 3, 214, 255, 29});
+  test.AddInput<float>("a_scale", {}, {0.0066f});
+  test.AddInput<uint8_t>("a_zero_point", {}, {113});
+  test.AddInput<int8_t>("T2", {4, 3}, {24, -77, 116, -68, -102, 127, -128, -1, 118, -1, 126, 119});
+  test.AddInput<float>("b_scale", {}, {0.00705f});
+  test.AddInput<int8_t>("b_zero_point", {}, {-14});
+  test.AddInput<float>("y_scale", {}, {0.0107f});
+  test.AddInput<uint8_t>("y_zero_point", {}, {118});
+  test.AddOutput<uint8_t>("T3", {2, 3}, {168, 115, 255, 1, 66, 151});
+  test.Run();
+}
+// int8 input and result, which only the CUDA kernel supports
+TEST(QuantizeLinearMatmulOpTest, QLinearMatMulInt8) {
+  if (!DefaultCudaExecutionProvider() || !HasCudaEnvironment(530 /*min_cuda_architecture*/)) return;
+
+  OpTester test("QLinearMatMul", 10);
+  test.AddInput<int8_t>("T1", {2, 4}, {80, 108, -128, 110, -125, 86, 127, -99});
+  test.AddInput<float>("a_scale", {}, {0.0066f});
+  test.AddInput<int8_t>("a_zero_point", {}, {-15});
+  test.AddInput<int8_t>("T2", {4, 3}, {24, -77, 116, -68, -102, 127, -128, -1, 118, -1, 126, 119});
+  test.AddInput<float>("b_scale", {}, {0.00705f});
+  test.AddInput<int8_t>("b_zero_point", {}, {-14});
+  test.AddInput<float>("y_scale", {}, {0.0107f});
+  test.AddInput<int8_t>("y_zero_point", {}, {-10});
+  test.AddOutput<int8_t>("T3", {2, 3}, {40, -13, 127, -127, -62, 23});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
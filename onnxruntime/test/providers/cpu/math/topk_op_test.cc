@@ -532,5 +532,59 @@ TEST(TopKOperator, BigArrayBigTopKSorted) {
   RunTest(11, 9000, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false, 0, 1, 1);
 }
 
+// several rows, sorted together by the segmented sort of the CUDA TopK for large k
+TEST(TopKOperator, BigArrayBigTopKSortedRows) {
+  const int64_t cols = 10000;
+  const int64_t k = 9000;
+  std::vector<float> input_vals(2 * cols);
+  std::iota(input_vals.begin(), input_vals.begin() + cols, 0.0f);
+  std::iota(input_vals.begin() + cols, input_vals.end(), 0.0f);
+  std::reverse(input_vals.begin() + cols, input_vals.end());
+
+  std::vector<float> expected_vals(2 * k);
+  std::vector<int64_t> expected_indices(2 * k);
+  for (int64_t i = 0; i < k; ++i) {
+    expected_vals[i] = static_cast<float>(cols - 1 - i);
+    expected_indices[i] = cols - 1 - i;
+    expected_vals[k + i] = static_cast<float>(cols - 1 - i);
+    expected_indices[k + i] = i;
+  }
+  RunTest(11, k, input_vals, {2, cols}, expected_vals, expected_indices, {2, k}, false, -1, 1, 1);
+}
+
+// large rows with many repeated values, split across the thread pool. the values equal to the k-th one must be
+// selected in order of their indices.
+static void large_vocabulary_top_k(int64_t largest) {
+  const int64_t rows = 4;
+  const int64_t cols = 50000;
+  const int64_t k = 5;
+  std::vector<float> input_vals(rows * cols);
+  for (int64_t i = 0; i < rows * cols; ++i) {
+    input_vals[i] = static_cast<float>((i * 7919) % 1000) - 500.0f;
+  }
+
+  std::vector<float> expected_vals;
+  std::vector<int64_t> expected_indices;
+  for (int64_t r = 0; r < rows; ++r) {
+    std::vector<int64_t> order(cols);
+    std::iota(order.begin(), order.end(), 0);
+    const float* row = input_vals.data() + r * cols;
+    std::stable_sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+      return largest ? row[a] > row[b] : row[a] < row[b];
+    });
+    for (int64_t l = 0; l < k; ++l) {
+      expected_vals.push_back(row[order[l]]);
+      expected_indices.push_back(order[l]);
+    }
+  }
+
+  RunTest(11, k, input_vals, {rows, cols}, expected_vals, expected_indices, {rows, k}, false, -1, largest, 1);
+}
+
+TEST(TopKOperator, LargeVocabularyTopKSorted) {
+  large_vocabulary_top_k(1);
+  large_vocabulary_top_k(0);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -82,6 +82,44 @@ TEST(MLOpTest, SVMRegressorNuSVCPolyKernel) {
   test.Run();
 }
 
+// enough rows for several blocks of kernels, split across the threads
+TEST(MLOpTest, SVMRegressorNuSVCPolyKernelManyRows) {
+  OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> dual_coefficients = {-2.74322388e+01f, 5.81893108e+01f, -1.00000000e+02f, 6.91693781e+01f,
+                                          7.62161261e-02f, -2.66618042e-03f};
+  std::vector<float> support_vectors = {0.f, 0.5f, 32.f, 1.f, 1.5f, 1.f, 2.f, 2.9f, -32.f, 3.f, 13.3f, -11.f,
+                                        12.f, 12.9f, -312.f, 43.f, 413.3f, -114.f};
+  std::vector<float> rho = {1.5004596f};
+  std::vector<float> kernel_params = {0.001f, 0.f, 3.f};  //gamma, coef0, degree
+
+  std::vector<float> x_rows = {1.f, 0.0f, 0.4f, 3.0f, 44.0f, -3.f, 12.0f, 12.9f, -312.f, 23.0f, 11.3f, -222.f,
+                               23.0f, 11.3f, -222.f, 23.0f, 3311.3f, -222.f, 23.0f, 11.3f, -222.f, 43.0f, 413.3f,
+                               -114.f};
+  std::vector<float> row_predictions = {1.50041863e+00f, 3.49624795e-01f, 2.75850969e+00f, -2.28659294e+02f,
+                                        -2.28659294e+02f, -6.09640826e+05f, -2.28659294e+02f, 3.89055773e+00f};
+
+  const int64_t repeats = 50;
+  std::vector<float> X;
+  std::vector<float> predictions;
+  for (int64_t i = 0; i < repeats; ++i) {
+    X.insert(X.end(), x_rows.begin(), x_rows.end());
+    predictions.insert(predictions.end(), row_predictions.begin(), row_predictions.end());
+  }
+
+  test.AddAttribute("kernel_type", std::string("POLY"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("n_supports", static_cast<int64_t>(6));
+
+  test.AddInput<float>("X", {8 * repeats, 3}, X);
+  test.AddOutput<float>("Y", {8 * repeats, 1}, predictions);
+  test.SetOutputRelErr("Y", 0.01f);
+  test.Run();
+}
+
 TEST(MLOpTest, SVMRegressorLinear) {
   OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
   std::vector<float> coefficients = {0.28290501f, -0.0266512f, 0.01674867f};
@@ -59,8 +59,9 @@ void GenTreeAndRunTest(const std::vector<T>& X, const std::vector<float>& base_v
     test.AddInput<T>("X", {1, 3}, X1);
     test.AddOutput<float>("Y", {1, 2}, results1);
   } else {
-    test.AddInput<T>("X", {8, 3}, X);
-    test.AddOutput<float>("Y", {8, 2}, results);
+    const auto n_rows = static_cast<int64_t>(X.size() / 3);
+    test.AddInput<T>("X", {n_rows, 3}, X);
+    test.AddOutput<float>("Y", {n_rows, 2}, results);
   }
   test.Run();
 }  // namespace test
@@ -73,6 +74,24 @@ TEST(MLOpTest, TreeRegressorMultiTargetAverage) {
   GenTreeAndRunTest<float>(X, base_values, results, "AVERAGE", true);
 }
 
+// enough rows to be evaluated in parallel, in blocks of rows with a partial last block
+TEST(MLOpTest, TreeRegressorMultiTargetManyRows) {
+  std::vector<float> X_8 = {1.f, 0.0f, 0.4f, 3.0f, 44.0f, -3.f, 12.0f, 12.9f, -312.f, 23.0f, 11.3f, -222.f, 23.0f, 11.3f, -222.f, 23.0f, 3311.3f, -222.f, 23.0f, 11.3f, -222.f, 43.0f, 413.3f, -114.f};
+  std::vector<float> results_8 = {1.33333333f, 29.f, 3.f, 14.f, 2.f, 23.f, 2.f, 23.f, 2.f, 23.f, 2.66666667f, 17.f, 2.f, 23.f, 3.f, 14.f};
+  std::vector<float> X;
+  std::vector<float> results;
+  for (int i = 0; i < 12; ++i) {
+    X.insert(X.end(), X_8.begin(), X_8.end());
+    results.insert(results.end(), results_8.begin(), results_8.end());
+  }
+  // 99 rows
+  X.insert(X.end(), X_8.begin(), X_8.begin() + 9);
+  results.insert(results.end(), results_8.begin(), results_8.begin() + 6);
+
+  std::vector<float> base_values{0.f, 0.f};
+  GenTreeAndRunTest<float>(X, base_values, results, "AVERAGE", false);
+}
+
 TEST(MLOpTest, TreeRegressorMultiTargetMin) {
   std::vector<float> X = {1.f, 0.0f, 0.4f, 3.0f, 44.0f, -3.f, 12.0f, 12.9f, -312.f, 23.0f, 11.3f, -222.f, 23.0f, 11.3f, -222.f, 23.0f, 3311.3f, -222.f, 23.0f, 11.3f, -222.f, 43.0f, 413.3f, -114.f};
   std::vector<float> results = {5.f, 28.f, 8.f, 19.f, 7.f, 28.f, 7.f, 28.f, 7.f, 28.f, 7.f, 19.f, 7.f, 28.f, 8.f, 19.f};
@@ -183,5 +202,58 @@ TEST(MLOpTest, TreeRegressorSingleTargetMax) {
   GenTreeAndRunTest1("MAX", true);
 }
 
+// stumps alternating BRANCH_LT and BRANCH_GTE on a single row, enough of them to be evaluated in parallel
+TEST(MLOpTest, TreeRegressorSingleTargetManyTreesMixedModes) {
+  OpTester test("TreeEnsembleRegressor", 1, onnxruntime::kMLDomain);
+
+  const int64_t n_trees = 150;
+  const std::vector<float> X = {0.5f, 2.f};
+  std::vector<int64_t> lefts, rights, treeids, nodeids, featureids;
+  std::vector<float> thresholds;
+  std::vector<std::string> modes;
+  std::vector<int64_t> target_treeids, target_nodeids, target_ids;
+  std::vector<float> target_weights;
+  float expected = 0.f;
+  for (int64_t t = 0; t < n_trees; ++t) {
+    const bool is_lt = t % 2 == 0;
+    const int64_t feature = t % 3 == 0 ? 1 : 0;
+    const float threshold = static_cast<float>(t % 5) * 0.5f;
+    lefts.insert(lefts.end(), {1, 0, 0});
+    rights.insert(rights.end(), {2, 0, 0});
+    treeids.insert(treeids.end(), {t, t, t});
+    nodeids.insert(nodeids.end(), {0, 1, 2});
+    featureids.insert(featureids.end(), {feature, 0, 0});
+    thresholds.insert(thresholds.end(), {threshold, 0.f, 0.f});
+    modes.insert(modes.end(), {is_lt ? "BRANCH_LT" : "BRANCH_GTE", "LEAF", "LEAF"});
+
+    const float true_weight = static_cast<float>(t);
+    const float false_weight = -0.5f;
+    target_treeids.insert(target_treeids.end(), {t, t});
+    target_nodeids.insert(target_nodeids.end(), {1, 2});
+    target_ids.insert(target_ids.end(), {0, 0});
+    target_weights.insert(target_weights.end(), {true_weight, false_weight});
+
+    const float val = X[feature];
+    expected += (is_lt ? val < threshold : val >= threshold) ? true_weight : false_weight;
+  }
+
+  test.AddAttribute("nodes_truenodeids", lefts);
+  test.AddAttribute("nodes_falsenodeids", rights);
+  test.AddAttribute("nodes_treeids", treeids);
+  test.AddAttribute("nodes_nodeids", nodeids);
+  test.AddAttribute("nodes_featureids", featureids);
+  test.AddAttribute("nodes_values", thresholds);
+  test.AddAttribute("nodes_modes", modes);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_ids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", (int64_t)1);
+
+  test.AddInput<float>("X", {1, 2}, X);
+  test.AddOutput<float>("Y", {1, 1}, {expected});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -71,5 +71,38 @@ TEST(MLOpTest, ZipMapOpInt64FloatStrideMoreThanNumLabels) {
 TEST(MLOpTest, ZipMapOpInt64FloatStrideLessThanNumLabels) {
   TestHelper<int64_t>({10, 20, 30}, "int64_t", {3, 2}, OpTester::ExpectResult::kExpectFailure);
 }
+
+// unsorted labels and enough rows to be split across the threads
+TEST(MLOpTest, ZipMapOpStringFloatManyRows) {
+  OpTester test("ZipMap", 1, onnxruntime::kMLDomain);
+  const std::vector<string> classes{"zeta", "alpha", "mu"};
+  const int64_t batch_size = 1000;
+
+  std::vector<float> input;
+  std::vector<std::map<string, float>> expected_output;
+  for (int64_t i = 0; i < batch_size; ++i) {
+    std::map<string, float> var_map;
+    for (size_t j = 0; j < classes.size(); ++j) {
+      input.push_back(static_cast<float>(i * 3 + j));
+      var_map.emplace(classes[j], input.back());
+    }
+    expected_output.push_back(var_map);
+  }
+
+  test.AddAttribute("classlabels_strings", classes);
+  test.AddInput<float>("X", {batch_size, 3}, input);
+  test.AddOutput<string, float>("Z", expected_output);
+  test.Run();
+}
+
+// the value of a repeated label is the last one
+TEST(MLOpTest, ZipMapOpInt64FloatRepeatedLabel) {
+  OpTester test("ZipMap", 1, onnxruntime::kMLDomain);
+  test.AddAttribute("classlabels_int64s", std::vector<int64_t>{30, 10, 30});
+  test.AddInput<float>("X", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddOutput<int64_t, float>("Z", std::vector<std::map<int64_t, float>>{{{10, 2.f}, {30, 3.f}},
+                                                                             {{10, 5.f}, {30, 6.f}}});
+  test.Run();
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -235,5 +235,25 @@ TEST(ConvIntegerTest, WithStride3_2D) {
   test.Run();
 }
 
+TEST(ConvIntegerTest, Int8Filter_2D) {
+  OpTester test("ConvInteger", 10);
+  std::vector<int64_t> x_dims{1, 1, 3, 3};
+  test.AddInput<uint8_t>("x", x_dims,
+                         {2, 3, 4,
+                          5, 6, 7,
+                          8, 9, 10});
+  std::vector<int64_t> w_dims{1, 1, 2, 2};
+  test.AddInput<int8_t>("w", w_dims,
+                        {2, -1,
+                         0, 1});
+  test.AddInput<uint8_t>("x_zero_point", {}, {1});
+  test.AddInput<int8_t>("w_zero_point", {}, {1});
+  std::vector<int64_t> y_dims{1, 1, 2, 2};
+  test.AddOutput<int32_t>("y", y_dims,
+                          {-7, -9,
+                           -13, -15});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
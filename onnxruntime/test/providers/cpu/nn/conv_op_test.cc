@@ -1,7 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cstdio>
+#include <fstream>
+
 #include "gtest/gtest.h"
+#include "core/framework/session_options.h"
 #include "test/providers/provider_test_utils.h"
 using namespace std;
 namespace onnxruntime {
@@ -608,6 +612,83 @@ TEST(ConvTest, Conv2D_group) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
 }
 
+// Shape that the CPU provider computes with the Winograd algorithm of MlasConv, with the filter either prepacked as a
+// constant initializer or transformed on each run
+TEST(ConvTest, Conv2D_Winograd) {
+  const int64_t N = 2, C = 16, H = 11, W = 12, M = 16;
+
+  vector<float> X(N * C * H * W);
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<float>(i % 13) * 0.125f - 0.75f;
+  }
+  vector<float> Wt(M * C * 3 * 3);
+  for (size_t i = 0; i < Wt.size(); i++) {
+    Wt[i] = static_cast<float>(i % 7) * 0.25f - 0.75f;
+  }
+  vector<float> B(M);
+  for (size_t i = 0; i < B.size(); i++) {
+    B[i] = static_cast<float>(i) * 0.5f - 4.0f;
+  }
+
+  vector<float> expected_vals(N * M * H * W);
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t m = 0; m < M; m++) {
+      for (int64_t oh = 0; oh < H; oh++) {
+        for (int64_t ow = 0; ow < W; ow++) {
+          float sum = B[m];
+          for (int64_t c = 0; c < C; c++) {
+            for (int64_t kh = 0; kh < 3; kh++) {
+              for (int64_t kw = 0; kw < 3; kw++) {
+                const int64_t ih = oh + kh - 1;
+                const int64_t iw = ow + kw - 1;
+                if (ih >= 0 && ih < H && iw >= 0 && iw < W) {
+                  sum += X[((n * C + c) * H + ih) * W + iw] * Wt[((m * C + c) * 3 + kh) * 3 + kw];
+                }
+              }
+            }
+          }
+          expected_vals[((n * M + m) * H + oh) * W + ow] = sum;
+        }
+      }
+    }
+  }
+
+  for (bool is_initializer : {false, true}) {
+    OpTester test("Conv", 11);
+    test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+    test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+    test.AddInput<float>("X", {N, C, H, W}, X);
+    test.AddInput<float>("W", {M, C, 3, 3}, Wt, is_initializer);
+    test.AddInput<float>("B", {M}, B, is_initializer);
+    test.AddOutput<float>("Y", {N, M, H, W}, expected_vals);
+    // Disable TensorRT because weight as input is not supported
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  }
+
+  // with autotuning the first session measures the algorithms of the shape and records the fastest in the cache
+  // file, the second one reuses it
+  SessionOptions so;
+  so.enable_cpu_tuning = true;
+  so.cpu_tuning_cache_filepath = ORT_TSTR("conv_cpu_tuning_cache.txt");
+  std::remove("conv_cpu_tuning_cache.txt");
+  for (int session = 0; session < 2; session++) {
+    OpTester test("Conv", 11);
+    test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+    test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+    test.AddInput<float>("X", {N, C, H, W}, X);
+    test.AddInput<float>("W", {M, C, 3, 3}, Wt, true);
+    test.AddInput<float>("B", {M}, B, true);
+    test.AddOutput<float>("Y", {N, M, H, W}, expected_vals);
+    test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+
+    std::ifstream cache_file("conv_cpu_tuning_cache.txt");
+    string entry;
+    ASSERT_TRUE(std::getline(cache_file, entry));
+    ASSERT_NE(entry.find("\tConv N2 G1 C16 M16 I11x12 K3x3"), string::npos) << entry;
+    ASSERT_FALSE(std::getline(cache_file, entry));
+  }
+}
+
 TEST(ConvTest, ConvDimWithZero) {
   ConvOpAndTestAttributes attrs = {
       "",                           // auto_pad
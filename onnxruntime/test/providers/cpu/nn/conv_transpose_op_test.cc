@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 using namespace std;
@@ -552,5 +555,105 @@ TEST(ConvTransposeTest, ConvTranspose_2D_NonDefaultStridesAndDilations) {
   TestConvTransposeOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
 }
 
+// Runs a grouped ConvTranspose with bias, stride 2, padding 1 and kernel 3 on every spatial axis, against a reference
+// that accumulates each input pixel into the output. The output is large enough to be scattered across the threads.
+static void TestLargeGroupedConvTranspose(const vector<int64_t>& input_spatial_shape) {
+  const int64_t batch = 2;
+  const int64_t group = 2;
+  const int64_t input_channels = 4;
+  const int64_t output_channels = 16;
+  const int64_t group_input_channels = input_channels / group;
+  const int64_t group_output_channels = output_channels / group;
+  const size_t rank = input_spatial_shape.size();
+
+  vector<int64_t> output_spatial_shape;
+  int64_t input_size = 1;
+  int64_t output_size = 1;
+  for (auto dim : input_spatial_shape) {
+    output_spatial_shape.push_back((dim - 1) * 2 - 2 + 3);
+    input_size *= dim;
+    output_size *= output_spatial_shape.back();
+  }
+  const int64_t kernel_size = static_cast<int64_t>(std::pow(3, rank));
+
+  vector<float> X(batch * input_channels * input_size);
+  vector<float> W(input_channels * group_output_channels * kernel_size);
+  vector<float> B(output_channels);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>(i % 7) - 3.f;
+  }
+  for (size_t i = 0; i < W.size(); ++i) {
+    W[i] = static_cast<float>(i % 5) - 2.f;
+  }
+  for (size_t i = 0; i < B.size(); ++i) {
+    B[i] = static_cast<float>(i);
+  }
+
+  vector<float> Y(batch * output_channels * output_size);
+  for (int64_t n = 0; n < batch; ++n) {
+    for (int64_t oc = 0; oc < output_channels; ++oc) {
+      std::fill_n(Y.begin() + (n * output_channels + oc) * output_size, output_size, B[oc]);
+    }
+    for (int64_t ic = 0; ic < input_channels; ++ic) {
+      const int64_t g = ic / group_input_channels;
+      for (int64_t i = 0; i < input_size; ++i) {
+        for (int64_t k = 0; k < kernel_size; ++k) {
+          // the output index of input pixel i and kernel offset k, if it isn't in the padding
+          int64_t index = 0;
+          int64_t i_rest = i;
+          int64_t k_rest = k;
+          bool in_output = true;
+          for (size_t d = 0; d < rank; ++d) {
+            int64_t i_pitch = 1;
+            int64_t k_pitch = 1;
+            for (size_t e = d + 1; e < rank; ++e) {
+              i_pitch *= input_spatial_shape[e];
+              k_pitch *= 3;
+            }
+            const int64_t o = (i_rest / i_pitch) * 2 - 1 + k_rest / k_pitch;
+            i_rest %= i_pitch;
+            k_rest %= k_pitch;
+            in_output = in_output && o >= 0 && o < output_spatial_shape[d];
+            index = index * output_spatial_shape[d] + o;
+          }
+          if (!in_output) {
+            continue;
+          }
+          for (int64_t o = 0; o < group_output_channels; ++o) {
+            Y[(n * output_channels + g * group_output_channels + o) * output_size + index] +=
+                X[(n * input_channels + ic) * input_size + i] * W[(ic * group_output_channels + o) * kernel_size + k];
+          }
+        }
+      }
+    }
+  }
+
+  OpTester test("ConvTranspose");
+  test.AddAttribute("kernel_shape", vector<int64_t>(rank, 3));
+  test.AddAttribute("pads", vector<int64_t>(2 * rank, 1));
+  test.AddAttribute("strides", vector<int64_t>(rank, 2));
+  test.AddAttribute("group", group);
+
+  vector<int64_t> X_shape{batch, input_channels};
+  vector<int64_t> W_shape{input_channels, group_output_channels};
+  vector<int64_t> Y_shape{batch, output_channels};
+  X_shape.insert(X_shape.end(), input_spatial_shape.begin(), input_spatial_shape.end());
+  W_shape.insert(W_shape.end(), rank, 3);
+  Y_shape.insert(Y_shape.end(), output_spatial_shape.begin(), output_spatial_shape.end());
+  test.AddInput<float>("X", X_shape, X);
+  test.AddInput<float>("W", W_shape, W);
+  test.AddInput<float>("B", {output_channels}, B);
+  test.AddOutput<float>("Y", Y_shape, Y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(ConvTransposeTest, ConvTranspose_2D_Large_Group_Bias) {
+  TestLargeGroupedConvTranspose({32, 32});
+}
+
+TEST(ConvTransposeTest, ConvTranspose_3D_Large_Group_Bias) {
+  TestLargeGroupedConvTranspose({8, 8, 8});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
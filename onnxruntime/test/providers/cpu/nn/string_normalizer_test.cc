@@ -200,5 +200,34 @@ TEST(ContribOpTest, StringNormalizerTest) {
   }
 }
 
+// Enough ASCII and non ASCII strings to be normalized in several batches, case-insensitive stopwords
+TEST(ContribOpTest, StringNormalizerManyStrings) {
+  OpTester test("StringNormalizer", opset_ver, domain);
+  InitTestAttr(test, "LOWER", false, {u8"Monday", u8"ÉCOLE"}, test_locale);
+  std::vector<std::string> input;
+  std::vector<std::string> output;
+  for (int i = 0; i < 500; ++i) {
+    switch (i % 4) {
+      case 0:
+        input.push_back(u8"MONDAY");
+        break;
+      case 1:
+        input.push_back(u8"école");
+        break;
+      case 2:
+        input.push_back(u8"Tuesday " + std::to_string(i));
+        output.push_back(u8"tuesday " + std::to_string(i));
+        break;
+      default:
+        input.push_back(u8"Besançon " + std::to_string(i));
+        output.push_back(u8"besançon " + std::to_string(i));
+        break;
+    }
+  }
+  test.AddInput<std::string>("T", {static_cast<int64_t>(input.size())}, input);
+  test.AddOutput<std::string>("Y", {static_cast<int64_t>(output.size())}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
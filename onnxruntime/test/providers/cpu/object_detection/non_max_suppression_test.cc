@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -383,5 +385,77 @@ TEST(NonMaxSuppressionOpTest, WithIOUThresholdOpset11) {
   test.Run();
 }
 
+// many batches and classes, split across the thread pool. the boxes come in pairs of identical boxes that don't
+// overlap the other pairs, so only the best box of each pair can be selected.
+TEST(NonMaxSuppressionOpTest, ManyBatchesAndClasses) {
+  const int64_t num_batches = 2;
+  const int64_t num_classes = 20;
+  const int64_t num_boxes = 1000;
+  const int64_t max_output_boxes_per_class = 50;
+
+  std::vector<float> boxes;
+  for (int64_t b = 0; b < num_batches; ++b) {
+    for (int64_t i = 0; i < num_boxes; ++i) {
+      const auto pair_offset = static_cast<float>(i / 2) * 2.0f;
+      boxes.insert(boxes.end(), {0.0f, pair_offset, 1.0f, pair_offset + 1.0f});
+    }
+  }
+
+  std::vector<float> scores;
+  std::vector<int64_t> expected;
+  for (int64_t b = 0; b < num_batches; ++b) {
+    for (int64_t c = 0; c < num_classes; ++c) {
+      std::vector<float> class_scores;
+      for (int64_t i = 0; i < num_boxes; ++i) {
+        class_scores.push_back(static_cast<float>((i * 37 + c * 11 + b) % num_boxes) / num_boxes);
+      }
+      scores.insert(scores.end(), class_scores.begin(), class_scores.end());
+
+      std::vector<int64_t> best_of_pairs;
+      for (int64_t i = 0; i < num_boxes; i += 2) {
+        best_of_pairs.push_back(class_scores[i] >= class_scores[i + 1] ? i : i + 1);
+      }
+      std::sort(best_of_pairs.begin(), best_of_pairs.end(),
+                [&](int64_t lhs, int64_t rhs) { return class_scores[lhs] > class_scores[rhs]; });
+      for (int64_t k = 0; k < max_output_boxes_per_class; ++k) {
+        expected.insert(expected.end(), {b, c, best_of_pairs[k]});
+      }
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {num_batches, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {num_batches, num_classes, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {max_output_boxes_per_class});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {num_batches * num_classes * max_output_boxes_per_class, 3}, expected);
+  test.Run();
+}
+
+// classes with different numbers of boxes over the score threshold, none for the second one
+TEST(NonMaxSuppressionOpTest, ScoreThresholdPerClass) {
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {1, 4, 4},
+                       {0.0f, 0.0f, 1.0f, 1.0f,
+                        0.0f, 10.0f, 1.0f, 11.0f,
+                        0.0f, 20.0f, 1.0f, 21.0f,
+                        0.0f, 30.0f, 1.0f, 31.0f});
+  test.AddInput<float>("scores", {1, 3, 4},
+                       {0.9f, 0.8f, 0.7f, 0.95f,
+                        0.1f, 0.2f, 0.1f, 0.2f,
+                        0.3f, 0.6f, 0.1f, 0.5f});
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {3L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.4f});
+  test.AddOutput<int64_t>("selected_indices", {5, 3},
+                          {0L, 0L, 3L,
+                           0L, 0L, 0L,
+                           0L, 0L, 1L,
+                           0L, 2L, 1L,
+                           0L, 2L, 3L});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
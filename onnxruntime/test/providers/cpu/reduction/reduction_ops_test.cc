@@ -935,6 +935,26 @@ TEST(ReductionOpTest, ReduceSum_axes02) {
   test.Run();
 }
 
+TEST(ReductionOpTest, ReduceMean_adjacent_middle_axes) {
+  OpTester test("ReduceMean");
+  test.AddAttribute("axes", std::vector<int64_t>{1, 2});
+  test.AddAttribute("keepdims", (int64_t)1);
+  test.AddInput<float>("data", {2, 2, 2, 2},
+                       {1.0f, 2.0f,
+                        3.0f, 4.0f,
+
+                        5.0f, 6.0f,
+                        7.0f, 8.0f,
+
+                        9.0f, 10.0f,
+                        11.0f, 12.0f,
+
+                        13.0f, 14.0f,
+                        15.0f, 16.0f});
+  test.AddOutput<float>("reduced", {2, 1, 1, 2}, {4.0f, 5.0f, 12.0f, 13.0f});
+  test.Run();
+}
+
 TEST(ReductionOpTest, ReduceSum_int32) {
   OpTester test("ReduceSum");
   test.AddAttribute("axes", std::vector<int64_t>{0, 2});
@@ -1059,6 +1079,60 @@ TEST(ReductionOpTest, ReduceSum_apex_more) {
   }
 }
 
+TEST(ReductionOpTest, ReduceMean_apex_reduction) {
+  OpTester test("ReduceMean");
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddAttribute("axes", std::vector<int64_t>{0, 1});
+  test.AddInput<float>("data", {3, 2, 2},
+                       {1.0f, 2.0f,
+                        3.0f, 4.0f,
+
+                        5.0f, 6.0f,
+                        7.0f, 8.0f,
+
+                        9.0f, 10.0f,
+                        11.0f, 12.0f});
+  test.AddOutput<float>("reduced", {2}, {6.0f, 7.0f});
+  test.Run();
+}
+
+// Reduces the last axis of a m-by-n matrix, which CUDA does with a warp per row for short rows and a block per row
+// for long ones.
+void test_last_axis_reduce(const std::string& op, int64_t m, int64_t n) {
+  OpTester test(op.c_str());
+  std::vector<float> X(m * n, 0.0f);
+  std::vector<float> Y(m, 0.0f);
+  std::default_random_engine generator(0);
+  std::uniform_real_distribution<float> distribution(-1.0, 1.0);
+  for (int64_t i = 0; i < m; ++i) {
+    for (int64_t j = 0; j < n; ++j) {
+      const float value = distribution(generator);
+      X[i * n + j] = value;
+      Y[i] += op == "ReduceL2" ? value * value : value;
+    }
+    if (op == "ReduceMean") {
+      Y[i] /= static_cast<float>(n);
+    } else if (op == "ReduceL2") {
+      Y[i] = std::sqrt(Y[i]);
+    }
+  }
+
+  test.AddAttribute("keepdims", (int64_t)1);
+  test.AddAttribute("axes", std::vector<int64_t>{-1});
+  test.AddInput<float>("data", {m, n}, X);
+  test.AddOutput<float>("reduced", {m, 1}, Y);
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceLastAxis) {
+  for (const char* op : {"ReduceSum", "ReduceMean", "ReduceL2"}) {
+    for (int64_t n : {1, 7, 32, 129, 768, 4099}) {
+      test_last_axis_reduce(op, 1, n);
+      test_last_axis_reduce(op, 37, n);
+    }
+  }
+}
+
 TEST(ReductionOpTest, ReduceSum_int64) {
   OpTester test("ReduceSum");
   test.AddAttribute("axes", std::vector<int64_t>{0, 2});
@@ -1427,6 +1501,31 @@ TEST(ReductionOpTest, ArgMax) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});  //TensorRT: axis must be 0
 }
 
+TEST(ReductionOpTest, ArgMax_ArgMin_ties) {
+  // the index of the first extreme element is selected
+  const std::vector<float> data = {1.0f, 5.0f,
+                                   3.0f, 5.0f,
+                                   3.0f, 2.0f,
+
+                                   -1.0f, 0.0f,
+                                   -1.0f, -2.0f,
+                                   -3.0f, 0.0f};
+
+  OpTester test_max("ArgMax");
+  test_max.AddAttribute("axis", (int64_t)1);
+  test_max.AddAttribute("keepdims", (int64_t)0);
+  test_max.AddInput<float>("data", {2, 3, 2}, data);
+  test_max.AddOutput<int64_t>("reduced", {2, 2}, {1, 0, 0, 0});
+  test_max.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});  //TensorRT: axis must be 0
+
+  OpTester test_min("ArgMin");
+  test_min.AddAttribute("axis", (int64_t)1);
+  test_min.AddAttribute("keepdims", (int64_t)0);
+  test_min.AddInput<float>("data", {2, 3, 2}, data);
+  test_min.AddOutput<int64_t>("reduced", {2, 2}, {0, 2, 2, 1});
+  test_min.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});  //TensorRT: axis must be 0
+}
+
 TEST(ReductionOpTest, ArgMax_do_not_keepdims) {
   OpTester test("ArgMax");
   test.AddAttribute("axis", (int64_t)1);
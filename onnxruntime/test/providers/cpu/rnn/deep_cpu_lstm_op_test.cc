@@ -46,7 +46,8 @@ static void RunLstmTest(const std::vector<float>& X_data,
                         std::vector<string> activations = {},
                         std::vector<float> activation_alphas = {},
                         std::vector<float> activation_betas = {},
-                        bool hasClip = true) {
+                        bool hasClip = true,
+                        bool weights_are_initializers = false) {
   OpTester test("LSTM");
 
   int num_directions = (direction == "bidirectional") ? 2 : 1;
@@ -78,8 +79,9 @@ static void RunLstmTest(const std::vector<float>& X_data,
   std::vector<int64_t> R_dims = {num_directions, 4 * hidden_size, hidden_size};
 
   test.AddInput<float>("X", X_dims, X_data);
-  test.AddInput<float>("W", W_dims, W_data);
-  test.AddInput<float>("R", R_dims, R_data);
+  // constant weights are packed once by the kernel
+  test.AddInput<float>("W", W_dims, W_data, weights_are_initializers);
+  test.AddInput<float>("R", R_dims, R_data, weights_are_initializers);
 
   if (B_data) {
     std::vector<int64_t> B_dims = {num_directions, 8 * hidden_size};
@@ -372,7 +374,8 @@ TEST(LSTMTest, BatchParallelFalseSeqLengthGreaterThanOne) {
 }
 
 // make sure GateComputations works correctly if batch_parallel_ is true due to large batch size
-static void LargeBatchWithClip(const std::vector<float>& Y_h_data, float clip = 9999.0) {
+static void LargeBatchWithClip(const std::vector<float>& Y_h_data, float clip = 9999.0,
+                               bool weights_are_initializers = false) {
   int64_t seq_length = 2;
   int batch_size = 32;
   int64_t input_size = 1;
@@ -395,7 +398,8 @@ static void LargeBatchWithClip(const std::vector<float>& Y_h_data, float clip =
 
   RunLstmTest(X_data, W_data, R_data, {}, Y_h_data, {},
               input_size, batch_size, hidden_size, seq_length,
-              nullptr, nullptr, nullptr, nullptr, nullptr, direction, clip);
+              nullptr, nullptr, nullptr, nullptr, nullptr, direction, clip,
+              true, false, {}, {}, {}, true, weights_are_initializers);
 }
 
 TEST(LSTMTest, LargeBatchNoClipping) {
@@ -475,6 +479,45 @@ TEST(LSTMTest, LargeBatchWithClip) {
   LargeBatchWithClip(Y_h_data, 4.f);
 }
 
+// same as LargeBatchNoClipping with W and R packed by the kernel, running the batch parallel path on the packed R
+TEST(LSTMTest, LargeBatchPrePackedWeights) {
+  std::vector<float> Y_h_data = {
+      0.90387899f, 0.9135572f, 0.91772245f,
+      0.90897038f, 0.92132433f, 0.92825467f,
+      0.91365823f, 0.92815113f, 0.93676105f,
+      0.91799162f, 0.93406357f, 0.94344562f,
+      0.92199681f, 0.93912057f, 0.94859476f,
+      0.92569357f, 0.94340185f, 0.95250664f,
+      0.92909964f, 0.94699686f, 0.95545127f,
+      0.93223207f, 0.94999634f, 0.95765468f,
+      0.93510761f, 0.9524867f, 0.95929726f,
+      0.93774272f, 0.9545467f, 0.96051891f,
+      0.9401536f, 0.95624603f, 0.96142619f,
+      0.94235605f, 0.95764499f, 0.96209939f,
+      0.94436539f, 0.95879495f, 0.96259862f,
+      0.94619635f, 0.95973921f, 0.96296872f,
+      0.94786299f, 0.96051397f, 0.96324302f,
+      0.94937864f, 0.96114929f, 0.96344629f,
+      0.95075587f, 0.96167006f, 0.96359692f,
+      0.95200645f, 0.96209679f, 0.96370852f,
+      0.95314133f, 0.9624464f, 0.9637912f,
+      0.95417069f, 0.96273278f, 0.96385246f,
+      0.95510395f, 0.96296733f, 0.96389785f,
+      0.95594975f, 0.96315942f, 0.96393147f,
+      0.95671607f, 0.96331673f, 0.96395638f,
+      0.9574102f, 0.96344554f, 0.96397483f,
+      0.9580388f, 0.96355102f, 0.9639885f,
+      0.95860795f, 0.96363739f, 0.96399863f,
+      0.95912322f, 0.96370811f, 0.96400613f,
+      0.95958963f, 0.96376601f, 0.96401169f,
+      0.96001179f, 0.96381342f, 0.96401581f,
+      0.96039386f, 0.96385224f, 0.96401886f,
+      0.96073964f, 0.96388402f, 0.96402112f,
+      0.96105254f, 0.96391004f, 0.96402279f};
+
+  LargeBatchWithClip(Y_h_data, 9999.0, true);
+}
+
 // ONNXRuntime tests
 class LstmOpContext2x1x2x2 {
  public:
@@ -171,5 +171,51 @@ TEST(CompressTest, Compress_3dims_neg_axis) {
   test.Run();
 }
 
+TEST(CompressTest, Compress_large_condition) {
+  // spans several of the blocks of the condition counted and copied in parallel
+  OpTester test("Compress", 11);
+
+  const int64_t size = 50000;
+  std::vector<float> input(size);
+  // std::vector<bool> has no contiguous data to add the condition from
+  std::unique_ptr<bool[]> condition(new bool[size]);
+  std::vector<float> output;
+  for (int64_t i = 0; i < size; ++i) {
+    input[i] = static_cast<float>(i);
+    condition[i] = i % 3 == 1;
+    if (condition[i]) {
+      output.push_back(input[i]);
+    }
+  }
+  test.AddInput<float>("input", {size}, input);
+  test.AddInput<bool>("condition", {size}, condition.get(), static_cast<size_t>(size));
+  test.AddOutput<float>("output", {static_cast<int64_t>(output.size())}, output);
+  test.Run();
+}
+
+TEST(CompressTest, Compress_axis_many_slices) {
+  OpTester test("Compress", 11);
+
+  test.AddAttribute("axis", int64_t(1));
+
+  const int64_t rows = 1000, cols = 40;
+  std::vector<int64_t> input(rows * cols);
+  std::unique_ptr<bool[]> condition(new bool[cols]);
+  std::vector<int64_t> output;
+  for (int64_t j = 0; j < cols; ++j) {
+    condition[j] = j % 4 != 0;
+  }
+  for (int64_t i = 0; i < rows * cols; ++i) {
+    input[i] = i;
+    if (condition[i % cols]) {
+      output.push_back(i);
+    }
+  }
+  test.AddInput<int64_t>("input", {rows, cols}, input);
+  test.AddInput<bool>("condition", {cols}, condition.get(), static_cast<size_t>(cols));
+  test.AddOutput<int64_t>("output", {rows, cols * 3 / 4}, output);
+  test.Run();
+}
+
 }  // namespace Test
 }  // namespace onnxruntime
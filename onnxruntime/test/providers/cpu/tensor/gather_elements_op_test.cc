@@ -315,5 +315,34 @@ TEST(GatherElementsOpTest, string) {
   RunTypedTest<std::string>();
 }
 
+// large enough to split the 'inner_dimension' chunks across the thread pool
+TEST(GatherElementsOpTest, float_axis0_large) {
+  OpTester test("GatherElements", 11);
+  test.AddAttribute<int64_t>("axis", 0LL);
+
+  const int64_t rows = 64;
+  const int64_t cols = 1024;
+
+  std::vector<float> data(rows * cols);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i);
+  }
+
+  std::vector<int32_t> indices(rows * cols);
+  std::vector<float> output(rows * cols);
+  for (int64_t i = 0; i < rows; ++i) {
+    for (int64_t j = 0; j < cols; ++j) {
+      const int32_t index = static_cast<int32_t>((i + j) % rows);
+      indices[i * cols + j] = index;
+      output[i * cols + j] = data[index * cols + j];
+    }
+  }
+
+  test.AddInput<float>("data", {rows, cols}, data);
+  test.AddInput<int32_t>("indices", {rows, cols}, indices);
+  test.AddOutput<float>("output", {rows, cols}, output);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
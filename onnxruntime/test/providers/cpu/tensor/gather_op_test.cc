@@ -323,5 +323,48 @@ TEST(GatherOpTest, Gather_axis1_neg_indices2d_int8) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});  //TensorRT: Assertion `regionRanges != nullptr' failed
 }
 
+TEST(GatherOpTest, Gather_axis0_string_rows) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<std::string>("data", {3, 2},
+                             {"a", "b",
+                              "c", "d",
+                              "e", "f"});
+  test.AddInput<int64_t>("indices", {3}, {2, 0, -2});
+  test.AddOutput<std::string>("output", {3, 2},
+                              {"e", "f",
+                               "a", "b",
+                               "c", "d"});
+  test.Run();
+}
+
+// large enough to split the rows across the thread pool
+TEST(GatherOpTest, Gather_axis0_embedding_rows) {
+  OpTester test("Gather", 11);
+  test.AddAttribute<int64_t>("axis", 0LL);
+
+  const int64_t num_rows = 1000;
+  const int64_t row_size = 16;
+  const int64_t num_indices = 2048;
+
+  std::vector<float> data(num_rows * row_size);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i);
+  }
+
+  std::vector<int64_t> indices(num_indices);
+  std::vector<float> output;
+  output.reserve(num_indices * row_size);
+  for (int64_t i = 0; i < num_indices; ++i) {
+    indices[i] = (i * 7919) % num_rows;
+    output.insert(output.end(), data.begin() + indices[i] * row_size, data.begin() + (indices[i] + 1) * row_size);
+  }
+
+  test.AddInput<float>("data", {num_rows, row_size}, data);
+  test.AddInput<int64_t>("indices", {num_indices / 2, 2}, indices);
+  test.AddOutput<float>("output", {num_indices / 2, 2, row_size}, output);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -93,5 +93,25 @@ TEST(NonZeroOpTest, EmptyInput) {
   test.Run();
 }
 
+TEST(NonZeroOpTest, LargeInput) {
+  // spans several of the blocks counted and written in parallel
+  OpTester test{kOpName, kOpVersion};
+
+  const int64_t rows = 3, cols = 20000;
+  std::vector<int32_t> X(rows * cols, 0);
+  std::vector<int64_t> row_coordinates, col_coordinates;
+  for (int64_t i = 0; i < rows * cols; i += 7) {
+    X[i] = 1;
+    row_coordinates.push_back(i / cols);
+    col_coordinates.push_back(i % cols);
+  }
+  test.AddInput<int32_t>("X", {rows, cols}, X);
+
+  std::vector<int64_t> Y(row_coordinates);
+  Y.insert(Y.end(), col_coordinates.begin(), col_coordinates.end());
+  test.AddOutput<int64_t>("Y", {2, static_cast<int64_t>(row_coordinates.size())}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
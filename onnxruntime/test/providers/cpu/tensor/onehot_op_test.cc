@@ -251,5 +251,40 @@ TEST(OneHotOpTest, DimWithZero) {
   test.Run();
 }
 
+TEST(OneHotOpTest, Axis_0_LongSuffix) {
+  // the suffix is split across several work items, and the indices out of range select nothing
+  OpTester test("OneHot", 11);
+  int64_t axis = 0;
+  test.AddAttribute("axis", axis);
+
+  const int64_t depth = 3, size = 20000;
+  std::vector<int64_t> indices(size);
+  std::vector<float> output(depth * size, 0.0f);
+  for (int64_t i = 0; i < size; ++i) {
+    indices[i] = i % 7 - 3;  // -3 to 3
+    const int64_t index = indices[i] < 0 ? indices[i] + depth : indices[i];
+    if (index < depth) {
+      output[index * size + i] = 1.0f;
+    }
+  }
+  test.AddInput<int64_t>("indices", {size}, indices);
+  test.AddInput<int64_t>("depth", {1}, {depth});
+  test.AddInput<float>("values", {2}, {0.0f, 1.0f});
+  test.AddOutput<float>("output", {depth, size}, output);
+  test.Run();
+}
+
+TEST(OneHotOpTest, NonIntegralIndex) {
+  OpTester test("OneHot", 11);
+  test.AddInput<float>("indices", {3}, {1.0f, 1.5f, -1.0f});
+  test.AddInput<float>("depth", {1}, {3.0f});
+  test.AddInput<float>("values", {2}, {0.0f, 1.0f});
+  test.AddOutput<float>("output", {3, 3},
+                        {0.0f, 1.0f, 0.0f,
+                         0.0f, 0.0f, 0.0f,
+                         0.0f, 0.0f, 1.0f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
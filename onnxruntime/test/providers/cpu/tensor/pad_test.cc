@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -296,6 +298,69 @@ TEST(TensorOpTest, Pad_Reflect_2D) {
                                "reflect");
 }
 
+// Pads a 3D input with a reference computed per output element. The output is large enough to be padded across the
+// thread pool.
+static void RunLarge3DPadTest(const std::string& mode) {
+  const std::vector<int64_t> input_dims{40, 30, 50};
+  const std::vector<int64_t> pads{2, 1, 3, 3, 2, 1};
+  const float value = -1.0f;
+  std::vector<int64_t> output_dims(3);
+  for (size_t i = 0; i < 3; ++i) {
+    output_dims[i] = input_dims[i] + pads[i] + pads[i + 3];
+  }
+
+  std::vector<float> input(static_cast<size_t>(input_dims[0] * input_dims[1] * input_dims[2]));
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i);
+  }
+
+  // maps an output index to the input index it reads, or returns false for a constant pad
+  auto source_index = [&](int64_t index, size_t axis, int64_t& source) {
+    source = index - pads[axis];
+    if (source >= 0 && source < input_dims[axis]) {
+      return true;
+    }
+    if (mode == "constant") {
+      return false;
+    }
+    if (mode == "edge") {
+      source = std::min(std::max<int64_t>(source, 0), input_dims[axis] - 1);
+    } else {
+      source = source < 0 ? -source : 2 * (input_dims[axis] - 1) - source;
+    }
+    return true;
+  };
+
+  std::vector<float> output;
+  output.reserve(static_cast<size_t>(output_dims[0] * output_dims[1] * output_dims[2]));
+  for (int64_t i = 0; i < output_dims[0]; ++i) {
+    for (int64_t j = 0; j < output_dims[1]; ++j) {
+      for (int64_t k = 0; k < output_dims[2]; ++k) {
+        int64_t si, sj, sk;
+        if (source_index(i, 0, si) && source_index(j, 1, sj) && source_index(k, 2, sk)) {
+          output.push_back(input[static_cast<size_t>((si * input_dims[1] + sj) * input_dims[2] + sk)]);
+        } else {
+          output.push_back(value);
+        }
+      }
+    }
+  }
+
+  RunAllOpsetAllDomainPadTests(input_dims, input, pads, value, output_dims, output, mode);
+}
+
+TEST(TensorOpTest, Pad_Constant_3D_Large) {
+  RunLarge3DPadTest("constant");
+}
+
+TEST(TensorOpTest, Pad_Edge_3D_Large) {
+  RunLarge3DPadTest("edge");
+}
+
+TEST(TensorOpTest, Pad_Reflect_3D_Large) {
+  RunLarge3DPadTest("reflect");
+}
+
 TEST(TensorOpTest, Pad_Constant_2D_int) {
   std::vector<int32_t> X = {11, 21, 31,
                             12, 22, 32};
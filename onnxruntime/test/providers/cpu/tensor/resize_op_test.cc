@@ -173,6 +173,71 @@ TEST(ResizeOpTest, ResizeOpLineartUpSampleTest_4DBilinear_asymmetric) {
   test.Run();
 }
 
+TEST(ResizeOpTest, ResizeOpLineartUpSampleTest_4DBilinear_NHWC_asymmetric) {
+  OpTester test("Resize", 11);
+  std::vector<float> roi{};
+  std::vector<float> scales{1.0f, 2.0f, 4.0f, 1.0f};
+
+  test.AddAttribute("mode", "linear");
+  test.AddAttribute("coordinate_transformation_mode", "asymmetric");
+
+  // the images of ResizeOpLineartUpSampleTest_4DBilinear_asymmetric as the 2 channels of an NHWC input
+  const int64_t N = 1, H = 2, W = 2, C = 2;
+  std::vector<float> X = {1.0f, 6.0f, 3.0f, 2.0f,
+                          4.0f, 7.0f, 8.0f, 11.0f};
+
+  test.AddInput<float>("X", {N, H, W, C}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  std::vector<float> Y = {
+      1.0f, 6.0f, 1.5f, 5.0f, 2.0f, 4.0f, 2.5f, 3.0f, 3.0f, 2.0f, 3.0f, 2.0f, 3.0f, 2.0f, 3.0f, 2.0f,
+      2.5f, 6.5f, 3.25f, 6.5f, 4.0f, 6.5f, 4.75f, 6.5f, 5.5f, 6.5f, 5.5f, 6.5f, 5.5f, 6.5f, 5.5f, 6.5f,
+      4.0f, 7.0f, 5.0f, 8.0f, 6.0f, 9.0f, 7.0f, 10.0f, 8.0f, 11.0f, 8.0f, 11.0f, 8.0f, 11.0f, 8.0f, 11.0f,
+      4.0f, 7.0f, 5.0f, 8.0f, 6.0f, 9.0f, 7.0f, 10.0f, 8.0f, 11.0f, 8.0f, 11.0f, 8.0f, 11.0f, 8.0f, 11.0f};
+
+  test.AddOutput<float>("Y", {N, static_cast<int64_t>(H * scales[1]), static_cast<int64_t>(W * scales[2]), C}, Y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kTensorrtExecutionProvider});
+}
+
+// large enough for the rows of the output to be split across the thread pool
+TEST(ResizeOpTest, ResizeOpLineartUpSampleTest_4DBilinear_ManyRows) {
+  OpTester test("Resize", 11);
+  std::vector<float> roi{};
+  std::vector<float> scales{1.0f, 1.0f, 2.0f, 2.0f};
+
+  test.AddAttribute("mode", "linear");
+  test.AddAttribute("coordinate_transformation_mode", "align_corners");
+
+  // each image is a linear function of its coordinates, so it is reproduced exactly by the interpolation
+  const int64_t N = 2, C = 4, H = 64, W = 64;
+  const int64_t OH = H * 2, OW = W * 2;
+  std::vector<float> X;
+  for (int64_t i = 0; i < N * C; ++i) {
+    for (int64_t h = 0; h < H; ++h) {
+      for (int64_t w = 0; w < W; ++w) {
+        X.push_back(0.1f * i + 0.02f * h + 0.005f * w);
+      }
+    }
+  }
+  std::vector<float> Y;
+  for (int64_t i = 0; i < N * C; ++i) {
+    for (int64_t h = 0; h < OH; ++h) {
+      for (int64_t w = 0; w < OW; ++w) {
+        const float in_h = static_cast<float>(h) * (H - 1) / (OH - 1);
+        const float in_w = static_cast<float>(w) * (W - 1) / (OW - 1);
+        Y.push_back(0.1f * i + 0.02f * in_h + 0.005f * in_w);
+      }
+    }
+  }
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+  test.AddOutput<float>("Y", {N, C, OH, OW}, Y);
+  test.Run();
+}
+
 TEST(ResizeOpTest, ResizeOpLineartUpSampleTest_2DBilinear_align_corners) {
   OpTester test("Resize", 11);
   std::vector<float> roi{};
@@ -155,5 +155,37 @@ TEST(ScatterNDOpTest, ScatterND_batched_3tensor_int64) {
   test3.Run();
 }
 
+TEST(ScatterNDOpTest, ScatterND_duplicate_indices_last_update_wins) {
+  OpTester test("ScatterND", 11);
+  test.AddInput<float>("data", {3, 2}, {0.f, 0.f, 0.f, 0.f, 0.f, 0.f});
+  test.AddInput<int64_t>("indices", {3, 1}, {1, 0, 1});
+  test.AddInput<float>("updates", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddOutput<float>("output", {3, 2}, {3.f, 4.f, 5.f, 6.f, 0.f, 0.f});
+  // the order of the duplicate updates is not deterministic on the other EPs
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kNupharExecutionProvider});
+}
+
+TEST(ScatterNDOpTest, ScatterND_many_slices) {
+  // spans several parallel blocks, with runs of consecutive slices
+  OpTester test("ScatterND", 11);
+  const int64_t rows = 5000, cols = 3, num_updates = 3000;
+  std::vector<int64_t> data(rows * cols, -1);
+  std::vector<int64_t> indices(num_updates);
+  std::vector<int64_t> updates(num_updates * cols);
+  std::vector<int64_t> output(data);
+  for (int64_t i = 0; i < num_updates; ++i) {
+    indices[i] = i < num_updates / 2 ? i : rows - 1 - (i - num_updates / 2) * 2;
+    for (int64_t j = 0; j < cols; ++j) {
+      updates[i * cols + j] = i * cols + j;
+      output[indices[i] * cols + j] = i * cols + j;
+    }
+  }
+  test.AddInput<int64_t>("data", {rows, cols}, data);
+  test.AddInput<int64_t>("indices", {num_updates, 1}, indices);
+  test.AddInput<int64_t>("updates", {num_updates, cols}, updates);
+  test.AddOutput<int64_t>("output", {rows, cols}, output);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
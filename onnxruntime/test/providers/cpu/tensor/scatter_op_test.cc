@@ -224,5 +224,56 @@ TEST(Scatter, BoolInputWithAxis) {
   scatter_bool_with_axis_tests("ScatterElements", 11);
 }
 
+static void scatter_updates_smaller_than_data(const char* op_name, int op_version) {
+  // the updates cover part of the inner dimensions, and many outer ones for the parallel blocks
+  OpTester test(op_name, op_version);
+  test.AddAttribute<int64_t>("axis", 1);
+
+  const std::vector<int64_t> data_dims{3000, 4, 3};
+  const std::vector<int64_t> updates_dims{2500, 2, 2};
+  std::vector<int32_t> data(3000 * 4 * 3, 0);
+  std::vector<int64_t> indices;
+  std::vector<int32_t> updates;
+  std::vector<int32_t> output(data);
+  for (int64_t i = 0; i < updates_dims[0]; ++i) {
+    for (int64_t j = 0; j < updates_dims[1]; ++j) {
+      for (int64_t k = 0; k < updates_dims[2]; ++k) {
+        const int64_t index = (i + j * 2 + k) % 4;
+        indices.push_back(index);
+        updates.push_back(static_cast<int32_t>(indices.size()));
+        output[(i * 4 + index) * 3 + k] = updates.back();
+      }
+    }
+  }
+  test.AddInput<int32_t>("data", data_dims, data);
+  test.AddInput<int64_t>("indices", updates_dims, indices);
+  test.AddInput<int32_t>("updates", updates_dims, updates);
+  test.AddOutput<int32_t>("y", data_dims, output);
+  test.Run();
+}
+
+TEST(Scatter, UpdatesSmallerThanData) {
+  scatter_updates_smaller_than_data("Scatter", 9);
+  scatter_updates_smaller_than_data("ScatterElements", 11);
+}
+
+static void scatter_duplicate_indices(const char* op_name, int op_version) {
+  OpTester test(op_name, op_version);
+  test.AddAttribute<int64_t>("axis", 0);
+
+  test.AddInput<float>("data", {3, 2}, {0.f, 0.f, 0.f, 0.f, 0.f, 0.f});
+  test.AddInput<int64_t>("indices", {3, 2}, {1, 2, 1, 0, 1, 2});
+  test.AddInput<float>("updates", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  // the last update of each element wins
+  test.AddOutput<float>("y", {3, 2}, {0.f, 4.f, 5.f, 0.f, 0.f, 6.f});
+  // the order of the duplicate updates is not deterministic on the other EPs
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kNupharExecutionProvider});
+}
+
+TEST(Scatter, DuplicateIndices) {
+  scatter_duplicate_indices("Scatter", 9);
+  scatter_duplicate_indices("ScatterElements", 11);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -297,6 +297,35 @@ TEST(TensorOpTest, CastToString) {
   TestCastOp(int_16_input, int_string_data, shape, TensorProto::STRING);
 }
 
+// large enough to be split across the thread pool, including the casts through a block of floats
+TEST(TensorOpTest, CastLargeTensors) {
+  const std::vector<int64_t> shape{3, 40000};
+  std::vector<float> float_data(120000);
+  std::vector<MLFloat16> float16_data(float_data.size());
+  std::vector<int32_t> int32_data(float_data.size());
+  std::vector<std::string> string_data(float_data.size());
+  for (size_t i = 0; i < float_data.size(); ++i) {
+    int32_data[i] = static_cast<int32_t>(i % 2001) - 1000;
+    float_data[i] = static_cast<float>(int32_data[i]);
+    float16_data[i] = MLFloat16(math::floatToHalf(float_data[i]));
+    string_data[i] = std::to_string(int32_data[i]);
+  }
+
+  auto run = [&shape](int64_t to, auto input, auto output) {
+    OpTester test("Cast", 9);
+    test.AddAttribute("to", to);
+    test.AddInput("input", shape, input);
+    test.AddOutput("output", shape, output);
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  };
+  run(TensorProto::FLOAT16, float_data, float16_data);
+  run(TensorProto::FLOAT, float16_data, float_data);
+  run(TensorProto::INT32, float16_data, int32_data);
+  run(TensorProto::FLOAT16, int32_data, float16_data);
+  run(TensorProto::STRING, int32_data, string_data);
+  run(TensorProto::INT32, string_data, int32_data);
+}
+
 void MeanVarianceNormalizationFunctionDefaultPerChannel() {
   const int64_t N = 2, C = 2, H = 2, W = 3;
 
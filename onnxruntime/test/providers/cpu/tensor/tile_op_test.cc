@@ -106,5 +106,30 @@ TEST(TensorOpTest, TileUint64Type) {
 TEST(TensorOpTest, TileBoolType) {
   RunTestWrapper<bool>();
 }
+// large enough to be tiled across the thread pool
+TEST(TensorOpTest, TileLarge) {
+  const int64_t rows = 512;
+  const int64_t cols = 64;
+  std::vector<float> input(rows * cols);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i);
+  }
+  std::vector<float> output;
+  output.reserve(input.size() * 12);
+  for (int64_t r = 0; r < 4; ++r) {
+    for (int64_t i = 0; i < rows; ++i) {
+      for (int64_t c = 0; c < 3; ++c) {
+        output.insert(output.end(), input.begin() + i * cols, input.begin() + (i + 1) * cols);
+      }
+    }
+  }
+
+  OpTester test("Tile");
+  test.AddInput<float>("input", {rows, cols}, input);
+  test.AddInput<int64_t>("repeats", {2}, {4, 3});
+  test.AddOutput<float>("output", {rows * 4, cols * 3}, output);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -3,6 +3,8 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include <functional>
+#include <numeric>
 
 namespace onnxruntime {
 namespace test {
@@ -414,5 +416,67 @@ TEST(TransposeOpTest, SingleAxisMovingInwardsBlockCopy) {
 
   TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals, false, false);
 }
+
+// Transpose input of the given shape using a simple loop over the output to produce the expected values
+template <typename T>
+static void LargeTransposeTest(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perm) {
+  const size_t rank = input_shape.size();
+  const int64_t size = std::accumulate(input_shape.begin(), input_shape.end(), int64_t{1}, std::multiplies<int64_t>());
+
+  std::vector<T> input_vals(size);
+  for (int64_t i = 0; i < size; ++i) {
+    input_vals[i] = static_cast<T>(i % 1000);
+  }
+
+  std::vector<int64_t> input_strides(rank, 1);
+  for (size_t i = rank - 1; i > 0; --i) {
+    input_strides[i - 1] = input_strides[i] * input_shape[i];
+  }
+
+  std::vector<int64_t> expected_shape(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    expected_shape[i] = input_shape[perm[i]];
+  }
+
+  std::vector<T> expected_vals(size);
+  std::vector<int64_t> index(rank, 0);
+  for (int64_t i = 0; i < size; ++i) {
+    int64_t offset = 0;
+    for (size_t j = 0; j < rank; ++j) {
+      offset += index[j] * input_strides[perm[j]];
+    }
+    expected_vals[i] = input_vals[offset];
+
+    for (size_t j = rank; j > 0; --j) {
+      if (++index[j - 1] < expected_shape[j - 1]) break;
+      index[j - 1] = 0;
+    }
+  }
+
+  OpTester test("Transpose");
+  test.AddAttribute("perm", perm);
+  test.AddInput<T>("X", input_shape, input_vals);
+  test.AddOutput<T>("Y", expected_shape, expected_vals);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
+// the transpose of the attention heads in BERT, which moves blocks of entries from the innermost axis
+TEST(TransposeOpTest, LargeAttentionHeads) {
+  LargeTransposeTest<float>({2, 128, 12, 32}, {0, 2, 1, 3});
+}
+
+// large enough to use the blocked transpose of 32 and 64 bit elements on multiple threads
+TEST(TransposeOpTest, LargeTwoDim) {
+  LargeTransposeTest<int32_t>({403, 517}, {1, 0});
+  LargeTransposeTest<int64_t>({403, 517}, {1, 0});
+}
+
+// the axes of size 1 are dropped and the adjacent axes 3 and 4 are merged
+TEST(TransposeOpTest, LargeCollapsedAxes) {
+  LargeTransposeTest<float>({3, 1, 37, 41, 43}, {2, 1, 3, 4, 0});
+  LargeTransposeTest<uint8_t>({3, 1, 37, 41, 43}, {3, 4, 1, 0, 2});
+  LargeTransposeTest<int16_t>({51, 1, 27, 61}, {3, 0, 1, 2});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
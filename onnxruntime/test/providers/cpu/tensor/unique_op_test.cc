@@ -118,6 +118,38 @@ TEST(Unique, Flatten_Sorted_String) {
                              inverse_indices_dims, inverse_indices, counts_dims, counts);
 }
 
+// enough elements to be deduplicated in parallel
+TEST(Unique, Flatten_LargeInput) {
+  // 37 is coprime with 1000, so the first 1000 values are a permutation of [0, 1000) which repeats
+  const int64_t num_elements = 200000;
+  const int64_t num_unique = 1000;
+  std::vector<int64_t> X(num_elements);
+  for (int64_t i = 0; i < num_elements; ++i) {
+    X[i] = (i * 37) % num_unique;
+  }
+
+  std::vector<int64_t> Y(X.begin(), X.begin() + num_unique);
+  std::vector<int64_t> indices(num_unique);
+  std::vector<int64_t> inverse_indices(num_elements);
+  std::vector<int64_t> counts(num_unique, num_elements / num_unique);
+  for (int64_t i = 0; i < num_unique; ++i) {
+    indices[i] = i;
+  }
+  for (int64_t i = 0; i < num_elements; ++i) {
+    inverse_indices[i] = i % num_unique;
+  }
+  RunUniqueTest<int64_t>({num_elements}, X, nullptr, false, {num_unique}, Y, {num_unique}, indices,
+                         {num_elements}, inverse_indices, {num_unique}, counts);
+
+  // sorted, the value v first occurs at v * 973 % 1000 as 37 * 973 = 1 (mod 1000)
+  for (int64_t v = 0; v < num_unique; ++v) {
+    Y[v] = v;
+    indices[v] = (v * 973) % num_unique;
+  }
+  RunUniqueTest<int64_t>({num_elements}, X, nullptr, true, {num_unique}, Y, {num_unique}, indices,
+                         {num_elements}, X, {num_unique}, counts);
+}
+
 TEST(Unique, NoOptionalOutput) {
   const std::vector<int64_t> X_dims{2, 4};
   const std::vector<int8_t> X{1, 4, -1, 2, 2, 0, -1, 4};
@@ -122,5 +122,38 @@ TEST(WhereOpTest, BroadcastDimWithZero) {
   // exclude NGraph as this isn't handled by that EP
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kNGraphExecutionProvider});
 }
+TEST(WhereOpTest, ScalarInputs) {
+  {
+    OpTester test{kOpName, kOpVersion};
+
+    test.AddInput<bool>("condition", {2, 3}, {true, false, true, false, false, true});
+    test.AddInput<float>("X", {}, {1.0f});
+    test.AddInput<float>("Y", {2, 3}, {2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f});
+
+    test.AddOutput<float>("output", {2, 3}, {1.0f, 3.0f, 1.0f, 5.0f, 6.0f, 1.0f});
+    test.Run();
+  }
+  {
+    OpTester test{kOpName, kOpVersion};
+
+    test.AddInput<bool>("condition", {1}, {false});
+    test.AddInput<int32_t>("X", {2, 2}, {1, 2, 3, 4});
+    test.AddInput<int32_t>("Y", {}, {-1});
+
+    test.AddOutput<int32_t>("output", {2, 2}, {-1, -1, -1, -1});
+    test.Run();
+  }
+  {
+    // the rank of the output is the highest one of the inputs
+    OpTester test{kOpName, kOpVersion};
+
+    test.AddInput<bool>("condition", {1, 1}, {true});
+    test.AddInput<std::string>("X", {1}, {"x"});
+    test.AddInput<std::string>("Y", {}, {"y"});
+
+    test.AddOutput<std::string>("output", {1, 1}, {"x"});
+    test.Run();
+  }
+}
 }  // namespace test
 }  // namespace onnxruntime
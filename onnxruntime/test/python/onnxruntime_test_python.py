@@ -83,6 +83,103 @@ class TestInferenceSession(unittest.TestCase):
         output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
         np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
+    def testRunModelWithIOBinding(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.onnx"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        binding = sess.io_binding()
+        binding.bind_input("X", x)
+        binding.bind_output("Y")
+        sess.run_with_iobinding(binding)
+        self.assertEqual(binding.get_output_names(), ["Y"])
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, binding.copy_outputs_to_cpu()[0], rtol=1e-05, atol=1e-08)
+
+        # the output allocated by the first run is reused by the next one
+        binding.bind_input("X", 2 * x)
+        sess.run_with_iobinding(binding)
+        np.testing.assert_allclose(4 * output_expected, binding.copy_outputs_to_cpu()[0], rtol=1e-05, atol=1e-08)
+
+    def testRunModelWithOrtValues(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.onnx"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        x_ortvalue = onnxrt.OrtValue.ortvalue_from_numpy(x)
+        # the input uses the memory of the array
+        self.assertEqual(x_ortvalue.data_ptr(), x.ctypes.data)
+        self.assertEqual(x_ortvalue.shape(), [3, 2])
+        self.assertEqual(x_ortvalue.data_type(), "tensor(float)")
+        self.assertEqual(x_ortvalue.device_name(), "cpu")
+
+        res = sess.run_with_ortvalues(["Y"], {"X": x_ortvalue})
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, res[0].numpy(), rtol=1e-05, atol=1e-08)
+
+        # a preallocated output is written by every run, and its numpy view sees the updates
+        y_ortvalue = onnxrt.OrtValue.ortvalue_from_shape_and_type([3, 2], np.float32)
+        y = y_ortvalue.numpy()
+        sess.run_with_ortvalues(["Y"], {"X": x_ortvalue}, output_ortvalues=[y_ortvalue])
+        np.testing.assert_allclose(output_expected, y, rtol=1e-05, atol=1e-08)
+        x *= 2
+        sess.run_with_ortvalues(["Y"], {"X": x_ortvalue}, output_ortvalues=[y_ortvalue])
+        np.testing.assert_allclose(4 * output_expected, y, rtol=1e-05, atol=1e-08)
+
+    def testOrtValueDlpack(self):
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        x_ortvalue = onnxrt.OrtValue.ortvalue_from_numpy(x)
+        capsule = x_ortvalue.to_dlpack()
+        y_ortvalue = onnxrt.OrtValue.ortvalue_from_dlpack(capsule)
+        self.assertEqual(y_ortvalue.data_ptr(), x.ctypes.data)
+        self.assertEqual(y_ortvalue.shape(), [3, 2])
+        np.testing.assert_array_equal(x, y_ortvalue.numpy())
+        # the capsule is consumed
+        self.assertRaises(RuntimeError, onnxrt.OrtValue.ortvalue_from_dlpack, capsule)
+
+        # the memory stays valid once the original values are released
+        del x_ortvalue
+        del x
+        np.testing.assert_array_equal(np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32),
+                                      y_ortvalue.numpy())
+
+    def testRunModelAsync(self):
+        so = onnxrt.SessionOptions()
+        so.intra_op_num_threads = 2
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.onnx"), sess_options=so)
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        futures = [sess.run_async(["Y"], {"X": i * x}) for i in range(1, 5)]
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        for i, future in enumerate(futures, 1):
+            res = future.result(timeout=60)
+            np.testing.assert_allclose(i * i * output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+        with self.assertRaises(onnxrt.capi._pybind_state.Fail):
+            sess.run_async(["Y"], {"X": x.reshape(2, 3)}).result(timeout=60)
+
+    def testRunModelMany(self):
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        # concurrently on the intra-op thread pool, then one after the other without it
+        for num_threads in [2, 1]:
+            so = onnxrt.SessionOptions()
+            so.intra_op_num_threads = num_threads
+            sess = onnxrt.InferenceSession(self.get_name("mul_1.onnx"), sess_options=so)
+            results = sess.run_many(["Y"], [{"X": i * x} for i in range(1, 5)])
+            self.assertEqual(len(results), 4)
+            for i, res in enumerate(results, 1):
+                np.testing.assert_allclose(i * i * output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+            with self.assertRaises(onnxrt.capi._pybind_state.InvalidArgument):
+                sess.run_many(["Y"], [{"X": x}, {"X": x.reshape(2, 3)}])
+
+    def testWarmUp(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.onnx"))
+        sess.warm_up()
+        sess.warm_up([{"X": [3, 2]}, {"X": (3, 2)}])
+        with self.assertRaises(onnxrt.capi._pybind_state.InvalidArgument):
+            sess.warm_up({"X": [2, 3]})
+
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        res = sess.run(["Y"], {"X": x})
+        np.testing.assert_allclose(x * x, res[0], rtol=1e-05, atol=1e-08)
+
     def testRunModelFromBytes(self):
         with open(self.get_name("mul_1.onnx"), "rb") as f:
             content = f.read()
@@ -11,6 +11,7 @@
 #include <fstream>
 #include <sstream>
 #include <atomic>
+#include <future>
 #include <gtest/gtest.h>
 #include "test_allocator.h"
 #include "test_fixture.h"
@@ -286,6 +287,66 @@ TEST(CApiTest, custom_op_handler) {
 #endif
 }
 
+// adds the inputs on the intra-op thread pool of the session, through a scratch buffer of the kernel
+struct MyParallelCustomKernel {
+  MyParallelCustomKernel(Ort::CustomOpApi ort, const OrtKernelInfo* /*info*/) : ort_(ort) {
+  }
+
+  void Compute(OrtKernelContext* context) {
+    const OrtValue* input_X = ort_.KernelContext_GetInput(context, 0);
+    const OrtValue* input_Y = ort_.KernelContext_GetInput(context, 1);
+    const float* X = ort_.GetTensorData<float>(input_X);
+    const float* Y = ort_.GetTensorData<float>(input_Y);
+
+    OrtTensorDimensions dimensions(ort_, input_X);
+    OrtValue* output = ort_.KernelContext_GetOutput(context, 0, dimensions.data(), dimensions.size());
+    float* out = ort_.GetTensorMutableData<float>(output);
+
+    OrtTensorTypeAndShapeInfo* output_info = ort_.GetTensorTypeAndShape(output);
+    size_t size = ort_.GetTensorShapeElementCount(output_info);
+    ort_.ReleaseTensorTypeAndShapeInfo(output_info);
+
+    float* scratch = static_cast<float*>(ort_.KernelContext_Allocate(context, size * sizeof(float)));
+    OrtThreadPool* pool = ort_.KernelContext_GetThreadPool(context);
+    ASSERT_GE(ort_.ThreadPool_GetDegreeOfParallelism(pool), 1);
+    ort_.ThreadPool_ParallelFor(pool, size, [&](size_t i) { scratch[i] = X[i] + Y[i]; });
+    ort_.ThreadPool_ParallelFor(pool, size, [&](size_t i) { out[i] = scratch[i]; });
+    ort_.KernelContext_Free(context, scratch);
+  }
+
+ private:
+  Ort::CustomOpApi ort_;
+};
+
+struct MyParallelCustomOp : Ort::CustomOpBase<MyParallelCustomOp, MyParallelCustomKernel> {
+  void* CreateKernel(Ort::CustomOpApi api, const OrtKernelInfo* info) { return new MyParallelCustomKernel(api, info); };
+  const char* GetName() const { return "Foo"; };
+
+  size_t GetInputTypeCount() const { return 2; };
+  ONNXTensorElementDataType GetInputType(size_t /*index*/) const { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT; };
+
+  size_t GetOutputTypeCount() const { return 1; };
+  ONNXTensorElementDataType GetOutputType(size_t /*index*/) const { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT; };
+};
+
+TEST(CApiTest, custom_op_thread_pool_and_allocator) {
+  std::vector<Input> inputs(1);
+  Input& input = inputs[0];
+  input.name = "X";
+  input.dims = {3, 2};
+  input.values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+
+  std::vector<int64_t> expected_dims_y = {3, 2};
+  std::vector<float> expected_values_y = {2.0f, 4.0f, 6.0f, 8.0f, 10.0f, 12.0f};
+
+  MyParallelCustomOp custom_op;
+  Ort::CustomOpDomain custom_op_domain("");
+  custom_op_domain.Add(&custom_op);
+
+  TestInference<PATH_TYPE, float>(*ort_env, CUSTOM_OP_MODEL_URI, inputs, "Y", expected_dims_y, expected_values_y, 0,
+                                  custom_op_domain, nullptr);
+}
+
 TEST(CApiTest, DISABLED_test_custom_op_library) {
   std::cout << "Running inference using custom op shared library" << std::endl;
 
@@ -447,6 +508,119 @@ TEST(CApiTest, override_initializer) {
   ASSERT_EQ(*output_data, f11_input_data[0]);
 }
 
+TEST(CApiTest, io_binding) {
+  Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+  Ort::Session session(*ort_env, MODEL_URI, Ort::SessionOptions{});
+
+  std::vector<int64_t> dims = {3, 2};
+  std::vector<float> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::Value input_tensor = Ort::Value::CreateTensor<float>(info, x_values.data(), x_values.size(),
+                                                            dims.data(), dims.size());
+  std::vector<float> y_values(6);
+  Ort::Value output_tensor = Ort::Value::CreateTensor<float>(info, y_values.data(), y_values.size(),
+                                                             dims.data(), dims.size());
+
+  Ort::IoBinding binding(session);
+  binding.BindInput("X", input_tensor);
+  binding.BindOutput("Y", output_tensor);
+
+  // the preallocated output is written by each run
+  for (int i = 0; i != 2; ++i) {
+    session.Run(Ort::RunOptions{}, binding);
+    for (size_t j = 0; j != x_values.size(); ++j) {
+      ASSERT_EQ(y_values[j], x_values[j] * x_values[j]);
+    }
+    x_values[0] += 1.0f;
+  }
+
+  // an output bound to a device is allocated by the run and kept by the binding
+  binding.ClearBoundOutputs();
+  binding.BindOutput("Y", info);
+  session.Run(Ort::RunOptions{}, binding);
+
+  std::vector<std::string> output_names = binding.GetOutputNames();
+  ASSERT_EQ(output_names, std::vector<std::string>{"Y"});
+  std::vector<Ort::Value> outputs = binding.GetOutputValues();
+  ASSERT_EQ(outputs.size(), 1U);
+  ASSERT_EQ(outputs[0].GetTensorTypeAndShapeInfo().GetShape(), dims);
+  const float* output_data = outputs[0].GetTensorMutableData<float>();
+  ASSERT_NE(output_data, y_values.data());
+  for (size_t j = 0; j != x_values.size(); ++j) {
+    ASSERT_EQ(output_data[j], x_values[j] * x_values[j]);
+  }
+}
+
+TEST(CApiTest, prepared_run) {
+  Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+  Ort::Session session(*ort_env, MODEL_URI, Ort::SessionOptions{});
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::PreparedRun prepared_run(session, input_names, 1, output_names, 1);
+
+  std::vector<int64_t> dims = {3, 2};
+  std::vector<float> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::Value input_tensor = Ort::Value::CreateTensor<float>(info, x_values.data(), x_values.size(),
+                                                            dims.data(), dims.size());
+  for (int i = 0; i != 2; ++i) {
+    std::vector<Ort::Value> outputs = session.Run(Ort::RunOptions{}, prepared_run, &input_tensor);
+    ASSERT_EQ(outputs.size(), 1U);
+    ASSERT_EQ(outputs[0].GetTensorTypeAndShapeInfo().GetShape(), dims);
+    const float* output_data = outputs[0].GetTensorMutableData<float>();
+    for (size_t j = 0; j != x_values.size(); ++j) {
+      ASSERT_EQ(output_data[j], x_values[j] * x_values[j]);
+    }
+    x_values[0] += 1.0f;
+  }
+
+  // the names are validated when the run is prepared
+  const char* invalid_names[] = {"invalid"};
+  bool failed = false;
+  try {
+    Ort::PreparedRun invalid_run(session, invalid_names, 1, output_names, 1);
+  } catch (const Ort::Exception& e) {
+    failed = e.GetOrtErrorCode() == ORT_INVALID_ARGUMENT;
+  }
+  ASSERT_EQ(failed, true);
+}
+
+static void ORT_API_CALL RunAsyncCallback(void* user_data, OrtValue** outputs, size_t num_outputs,
+                                          OrtStatus* status) {
+  auto* done = reinterpret_cast<std::promise<bool>*>(user_data);
+  bool succeeded = status == nullptr && num_outputs == 1 && outputs[0] != nullptr;
+  if (status != nullptr) {
+    Ort::GetApi().ReleaseStatus(status);
+  }
+  done->set_value(succeeded);
+}
+
+TEST(CApiTest, run_async) {
+  Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(2);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  std::vector<int64_t> dims = {3, 2};
+  std::vector<float> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::Value input_tensor = Ort::Value::CreateTensor<float>(info, x_values.data(), x_values.size(),
+                                                            dims.data(), dims.size());
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::Value output_tensor{nullptr};
+
+  Ort::RunOptions run_options;
+  std::promise<bool> done;
+  session.RunAsync(run_options, input_names, &input_tensor, 1, output_names, &output_tensor, 1, RunAsyncCallback,
+                   &done);
+  ASSERT_TRUE(done.get_future().get());
+
+  ASSERT_EQ(output_tensor.GetTensorTypeAndShapeInfo().GetShape(), dims);
+  const float* output_data = output_tensor.GetTensorMutableData<float>();
+  for (size_t j = 0; j != x_values.size(); ++j) {
+    ASSERT_EQ(output_data[j], x_values[j] * x_values[j]);
+  }
+}
+
 TEST(CApiTest, end_profiling) {
   Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
   auto allocator = onnxruntime::make_unique<MockedOrtAllocator>();
@@ -0,0 +1,322 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+#include "batcher.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace chrono = std::chrono;
+
+size_t NumericElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      return 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+      return 8;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+      return 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+Ort::Value ConcatenateBatch(const std::vector<const OrtValue*>& values, OrtAllocator* allocator) {
+  const Ort::Unowned<Ort::Value> first{const_cast<OrtValue*>(values.front())};
+  const auto type = first.GetTensorTypeAndShapeInfo().GetElementType();
+  const size_t element_size = NumericElementSize(type);
+  if (element_size == 0) {
+    throw Ort::Exception("Only numeric tensors can be batched", ORT_INVALID_ARGUMENT);
+  }
+
+  auto shape = first.GetTensorTypeAndShapeInfo().GetShape();
+  shape[0] = 0;
+  for (const auto* value : values) {
+    shape[0] += Ort::Unowned<Ort::Value>{const_cast<OrtValue*>(value)}.GetTensorTypeAndShapeInfo().GetShape()[0];
+  }
+
+  auto batch = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), type);
+  auto* data = batch.GetTensorMutableData<char>();
+  for (const auto* value : values) {
+    Ort::Unowned<Ort::Value> tensor{const_cast<OrtValue*>(value)};
+    const size_t size = tensor.GetTensorTypeAndShapeInfo().GetElementCount() * element_size;
+    std::memcpy(data, tensor.GetTensorMutableData<char>(), size);
+    data += size;
+  }
+  return batch;
+}
+
+Ort::Value SliceBatch(const OrtValue* value, int64_t begin, int64_t count, OrtAllocator* allocator) {
+  Ort::Unowned<Ort::Value> tensor{const_cast<OrtValue*>(value)};
+  const auto info = tensor.GetTensorTypeAndShapeInfo();
+  const size_t element_size = NumericElementSize(info.GetElementType());
+  auto shape = info.GetShape();
+  if (element_size == 0 || shape.empty() || begin < 0 || count < 0 || begin + count > shape[0]) {
+    throw Ort::Exception("The output of the batch can't be sliced back to the requests", ORT_FAIL);
+  }
+
+  const size_t row_size = shape[0] == 0 ? 0 : info.GetElementCount() / static_cast<size_t>(shape[0]) * element_size;
+  shape[0] = count;
+  auto slice = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), info.GetElementType());
+  std::memcpy(slice.GetTensorMutableData<char>(), tensor.GetTensorMutableData<char>() + begin * row_size,
+              count * row_size);
+  return slice;
+}
+
+struct Batcher::Request {
+  // the inputs, sorted by name so requests listing them in another order share batches
+  std::vector<std::string> input_names;
+  std::vector<const OrtValue*> input_values;
+  std::vector<ONNXTensorElementDataType> input_types;
+  std::vector<std::vector<int64_t>> input_shapes;
+  const std::vector<std::string>* output_names = nullptr;
+  int64_t rows = 0;
+  chrono::steady_clock::time_point enqueued;
+
+  std::vector<Ort::Value> outputs;
+  std::string error_message;
+  OrtErrorCode error_code = ORT_OK;
+  bool done = false;
+};
+
+Batcher::Batcher(RunSessionFn run, const BatchingOptions& options, size_t num_workers)
+    : run_(std::move(run)),
+      max_batch_size_(options.max_batch_size),
+      max_queue_delay_(options.max_queue_delay_us),
+      batch_sizes_(Histogram::ExponentialBounds(1, 2, static_cast<double>(options.max_batch_size))),
+      queue_delays_us_(Histogram::ExponentialBounds(10, 2, std::max<double>(10, 8 * options.max_queue_delay_us))) {
+  for (size_t i = 0; i < std::max<size_t>(num_workers, 1); ++i) {
+    workers_.emplace_back(&Batcher::Worker, this);
+  }
+}
+
+Batcher::~Batcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  queue_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+bool Batcher::CanBatch(const Ort::Session& session) {
+  auto has_free_batch_dimension = [](const Ort::TypeInfo& type_info) {
+    if (type_info.GetONNXType() != ONNX_TYPE_TENSOR) {
+      return false;
+    }
+    const auto info = type_info.GetTensorTypeAndShapeInfo();
+    const auto shape = info.GetShape();
+    return NumericElementSize(info.GetElementType()) != 0 && !shape.empty() && shape[0] < 0;
+  };
+
+  for (size_t i = 0, count = session.GetInputCount(); i < count; ++i) {
+    if (!has_free_batch_dimension(session.GetInputTypeInfo(i))) {
+      return false;
+    }
+  }
+  for (size_t i = 0, count = session.GetOutputCount(); i < count; ++i) {
+    if (!has_free_batch_dimension(session.GetOutputTypeInfo(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Batcher::CanShareBatch(const Request& first, const Request& request) const {
+  if (request.input_names != first.input_names || *request.output_names != *first.output_names ||
+      request.input_types != first.input_types) {
+    return false;
+  }
+  for (size_t i = 0; i < first.input_shapes.size(); ++i) {
+    if (!std::equal(first.input_shapes[i].begin() + 1, first.input_shapes[i].end(),
+                    request.input_shapes[i].begin() + 1, request.input_shapes[i].end())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<Ort::Value> Batcher::Run(const std::vector<std::string>& input_names,
+                                     const std::vector<Ort::Value>& input_values,
+                                     const std::vector<std::string>& output_names) {
+  std::vector<size_t> order(input_names.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return input_names[a] < input_names[b]; });
+
+  Request request;
+  request.output_names = &output_names;
+  bool can_batch = !input_values.empty() && !output_names.empty();
+  for (size_t i : order) {
+    if (!can_batch || !input_values[i].IsTensor()) {
+      can_batch = false;
+      break;
+    }
+    const auto info = input_values[i].GetTensorTypeAndShapeInfo();
+    auto shape = info.GetShape();
+    if (NumericElementSize(info.GetElementType()) == 0 || shape.empty() ||
+        (!request.input_shapes.empty() && shape[0] != request.rows)) {
+      can_batch = false;
+      break;
+    }
+    request.rows = shape[0];
+    request.input_names.push_back(input_names[i]);
+    request.input_values.push_back(input_values[i]);
+    request.input_types.push_back(info.GetElementType());
+    request.input_shapes.push_back(std::move(shape));
+  }
+
+  // the requests which fill a batch on their own don't wait
+  if (!can_batch || request.rows == 0 || request.rows >= max_batch_size_) {
+    std::vector<const OrtValue*> values;
+    values.reserve(input_values.size());
+    for (const auto& value : input_values) {
+      values.push_back(value);
+    }
+    return run_(input_names, values, output_names);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  request.enqueued = chrono::steady_clock::now();
+  queue_.push_back(&request);
+  queue_cv_.notify_all();
+  done_cv_.wait(lock, [&request] { return request.done; });
+
+  if (request.error_code != ORT_OK) {
+    throw Ort::Exception(std::move(request.error_message), request.error_code);
+  }
+  return std::move(request.outputs);
+}
+
+void Batcher::Worker() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    queue_cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return;
+    }
+
+    // the oldest request waits for more requests it can share its batch with until its delay expires, unless
+    // another worker takes it first
+    const Request* oldest = queue_.front();
+    auto taken = [&]() { return queue_.empty() || queue_.front() != oldest; };
+    auto queued_rows = [&]() {
+      int64_t rows = 0;
+      for (const auto* request : queue_) {
+        if (CanShareBatch(*oldest, *request)) {
+          rows += request->rows;
+        }
+      }
+      return rows;
+    };
+    queue_cv_.wait_until(lock, oldest->enqueued + max_queue_delay_,
+                         [&] { return stop_ || taken() || queued_rows() >= max_batch_size_; });
+    if (taken()) {
+      continue;
+    }
+
+    std::vector<Request*> batch;
+    int64_t rows = 0;
+    for (auto it = queue_.begin(); it != queue_.end();) {
+      if (batch.empty() || (CanShareBatch(*batch.front(), **it) && rows + (*it)->rows <= max_batch_size_)) {
+        rows += (*it)->rows;
+        batch.push_back(*it);
+        it = queue_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    if (!queue_.empty()) {
+      queue_cv_.notify_all();
+    }
+
+    lock.unlock();
+    RunBatch(batch, rows);
+    lock.lock();
+
+    for (auto* request : batch) {
+      request->done = true;
+    }
+    done_cv_.notify_all();
+  }
+}
+
+void Batcher::RunBatch(std::vector<Request*>& batch, int64_t rows) {
+  const auto start = chrono::steady_clock::now();
+  batch_sizes_.Observe(static_cast<double>(rows));
+  for (const auto* request : batch) {
+    const auto delay = chrono::duration_cast<chrono::microseconds>(start - request->enqueued);
+    queue_delays_us_.Observe(static_cast<double>(delay.count()));
+  }
+
+  Request& first = *batch.front();
+  try {
+    if (batch.size() == 1) {
+      first.outputs = run_(first.input_names, first.input_values, *first.output_names);
+      return;
+    }
+
+    std::vector<Ort::Value> inputs;
+    std::vector<const OrtValue*> input_ptrs;
+    std::vector<const OrtValue*> values(batch.size());
+    for (size_t i = 0; i < first.input_values.size(); ++i) {
+      for (size_t r = 0; r < batch.size(); ++r) {
+        values[r] = batch[r]->input_values[i];
+      }
+      inputs.push_back(ConcatenateBatch(values, allocator_));
+      input_ptrs.push_back(inputs.back());
+    }
+
+    auto outputs = run_(first.input_names, input_ptrs, *first.output_names);
+    for (const auto& output : outputs) {
+      if (!output.IsTensor() || output.GetTensorTypeAndShapeInfo().GetShape().front() != rows) {
+        throw Ort::Exception("The outputs of the batch don't have a batch dimension", ORT_FAIL);
+      }
+    }
+
+    int64_t begin = 0;
+    for (auto* request : batch) {
+      for (const auto& output : outputs) {
+        request->outputs.push_back(SliceBatch(output, begin, request->rows, allocator_));
+      }
+      begin += request->rows;
+    }
+  } catch (const Ort::Exception& e) {
+    for (auto* request : batch) {
+      request->outputs.clear();
+      request->error_code = e.GetOrtErrorCode();
+      request->error_message = e.what();
+    }
+  }
+}
+
+void Batcher::ExportMetrics(const std::string& labels, std::string& out) const {
+  size_t queued;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queued = queue_.size();
+  }
+  ExportValue("onnxruntime_server_batch_queue_depth", labels, static_cast<double>(queued), out);
+  batch_sizes_.Export("onnxruntime_server_batch_size", labels, out);
+  queue_delays_us_.Export("onnxruntime_server_batch_queue_delay_us", labels, out);
+}
+
+}  // namespace server
+}  // namespace onnxruntime
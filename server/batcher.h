@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "onnxruntime_cxx_api.h"
+#include "metrics.h"
+
+namespace onnxruntime {
+namespace server {
+
+// Options of the dynamic batching of the requests of a model
+struct BatchingOptions {
+  // Largest number of rows (the sum of the batch dimensions of the requests) run at once. 1 disables batching.
+  int64_t max_batch_size = 1;
+  // Longest time the first request of a batch waits for more requests before the batch is run
+  int64_t max_queue_delay_us = 1000;
+};
+
+// Size of an element of the numeric tensor types, which can be batched. 0 for the other types
+size_t NumericElementSize(ONNXTensorElementDataType type);
+
+// Concatenates numeric tensors of the same element type and shape except for dimension 0 along it
+Ort::Value ConcatenateBatch(const std::vector<const OrtValue*>& values, OrtAllocator* allocator);
+
+// Copies `count` rows of a numeric tensor, starting with row `begin`, to a new tensor
+Ort::Value SliceBatch(const OrtValue* value, int64_t begin, int64_t count, OrtAllocator* allocator);
+
+// Runs a request on a session of the model, and returns its outputs. Throws Ort::Exception like Session::Run.
+using RunSessionFn = std::function<std::vector<Ort::Value>(const std::vector<std::string>& input_names,
+                                                           const std::vector<const OrtValue*>& input_values,
+                                                           const std::vector<std::string>& output_names)>;
+
+// Runs the requests of a model whose inputs and outputs have a free batch dimension (dimension 0) in batches.
+// The requests with the same input and output names, element types and shapes except for the batch dimension are
+// queued, and run at once by one of the worker threads when they add up to max_batch_size rows, or when the oldest one
+// has waited for max_queue_delay_us. Their inputs are concatenated along the batch dimension, and the outputs of the
+// batch are sliced back to each request. The requests that can't be batched, e.g. with string inputs, are run on their
+// own.
+class Batcher {
+ public:
+  // The batches are run with `run`, by `num_workers` threads
+  Batcher(RunSessionFn run, const BatchingOptions& options, size_t num_workers = 1);
+  ~Batcher();
+  Batcher(const Batcher&) = delete;
+  Batcher& operator=(const Batcher&) = delete;
+
+  // Whether the inputs and outputs of the session all have a free batch dimension
+  static bool CanBatch(const Ort::Session& session);
+
+  // Blocks until the batch of the request is run, and returns its outputs. Throws Ort::Exception like Session::Run.
+  std::vector<Ort::Value> Run(const std::vector<std::string>& input_names,
+                              const std::vector<Ort::Value>& input_values,
+                              const std::vector<std::string>& output_names);
+
+  // Appends the number of queued requests, and the histograms of the batch sizes and of the queueing delays with the
+  // `labels` to `out`
+  void ExportMetrics(const std::string& labels, std::string& out) const;
+
+ private:
+  struct Request;
+
+  void Worker();
+  void RunBatch(std::vector<Request*>& batch, int64_t rows);
+  bool CanShareBatch(const Request& first, const Request& request) const;
+
+  const RunSessionFn run_;
+  const int64_t max_batch_size_;
+  const std::chrono::microseconds max_queue_delay_;
+  Ort::AllocatorWithDefaultOptions allocator_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable queue_cv_;  // notifies the workers of the changes of the queue
+  std::condition_variable done_cv_;   // notifies the requests of their completion
+  std::deque<Request*> queue_;
+  bool stop_ = false;
+
+  Histogram batch_sizes_;
+  Histogram queue_delays_us_;
+
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
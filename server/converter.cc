@@ -87,6 +87,7 @@ void MLValueToTensorProto(Ort::Value& ml_value, bool using_raw_data,
       if (using_raw_data) {
         tensor_proto.set_raw_data(data, sizeof(float) * elem_count);
       } else {
+        tensor_proto.mutable_float_data()->Reserve(static_cast<int>(elem_count));
         for (size_t i = 0, count = elem_count; i < count; ++i) {
           tensor_proto.add_float_data(data[i]);
         }
@@ -98,6 +99,7 @@ void MLValueToTensorProto(Ort::Value& ml_value, bool using_raw_data,
       if (using_raw_data) {
         tensor_proto.set_raw_data(data, sizeof(int32_t) * elem_count);
       } else {
+        tensor_proto.mutable_int32_data()->Reserve(static_cast<int>(elem_count));
         for (size_t i = 0, count = elem_count; i < count; ++i) {
           tensor_proto.add_int32_data(data[i]);
         }
@@ -109,6 +111,7 @@ void MLValueToTensorProto(Ort::Value& ml_value, bool using_raw_data,
       if (using_raw_data) {
         tensor_proto.set_raw_data(data, sizeof(uint8_t) * elem_count);
       } else {
+        tensor_proto.mutable_int32_data()->Reserve(static_cast<int>(elem_count));
         for (size_t i = 0, count = elem_count; i < count; ++i) {
           tensor_proto.add_int32_data(data[i]);
         }
@@ -120,6 +123,7 @@ void MLValueToTensorProto(Ort::Value& ml_value, bool using_raw_data,
       if (using_raw_data) {
         tensor_proto.set_raw_data(data, sizeof(int8_t) * elem_count);
       } else {
+        tensor_proto.mutable_int32_data()->Reserve(static_cast<int>(elem_count));
         for (size_t i = 0, count = elem_count; i < count; ++i) {
           tensor_proto.add_int32_data(data[i]);
         }
@@ -131,6 +135,7 @@ void MLValueToTensorProto(Ort::Value& ml_value, bool using_raw_data,
       if (using_raw_data) {
         tensor_proto.set_raw_data(data, sizeof(uint16_t) * elem_count);
       } else {
+        tensor_proto.mutable_int32_data()->Reserve(static_cast<int>(elem_count));
         for (size_t i = 0, count = elem_count; i < count; ++i) {
           tensor_proto.add_int32_data(data[i]);
         }
@@ -142,6 +147,7 @@ void MLValueToTensorProto(Ort::Value& ml_value, bool using_raw_data,
       if (using_raw_data) {
         tensor_proto.set_raw_data(data, sizeof(int16_t) * elem_count);
       } else {
+        tensor_proto.mutable_int32_data()->Reserve(static_cast<int>(elem_count));
         for (size_t i = 0, count = elem_count; i < count; ++i) {
           tensor_proto.add_int32_data(data[i]);
         }
@@ -153,6 +159,7 @@ void MLValueToTensorProto(Ort::Value& ml_value, bool using_raw_data,
       if (using_raw_data) {
         tensor_proto.set_raw_data(data, sizeof(bool) * elem_count);
       } else {
+        tensor_proto.mutable_int32_data()->Reserve(static_cast<int>(elem_count));
         for (size_t i = 0, count = elem_count; i < count; ++i) {
           tensor_proto.add_int32_data(data[i]);
         }
@@ -181,6 +188,7 @@ void MLValueToTensorProto(Ort::Value& ml_value, bool using_raw_data,
       if (using_raw_data) {
         tensor_proto.set_raw_data(data, sizeof(int64_t) * elem_count);
       } else {
+        tensor_proto.mutable_int64_data()->Reserve(static_cast<int>(elem_count));
         for (size_t x = 0, loop_length = elem_count; x < loop_length; ++x) {
           tensor_proto.add_int64_data(data[x]);
         }
@@ -192,6 +200,7 @@ void MLValueToTensorProto(Ort::Value& ml_value, bool using_raw_data,
       if (using_raw_data) {
         tensor_proto.set_raw_data(data, sizeof(uint32_t) * elem_count);
       } else {
+        tensor_proto.mutable_uint64_data()->Reserve(static_cast<int>(elem_count));
         for (size_t i = 0, count = elem_count; i < count; ++i) {
           tensor_proto.add_uint64_data(data[i]);
         }
@@ -203,6 +212,7 @@ void MLValueToTensorProto(Ort::Value& ml_value, bool using_raw_data,
       if (using_raw_data) {
         tensor_proto.set_raw_data(data, sizeof(uint64_t) * elem_count);
       } else {
+        tensor_proto.mutable_uint64_data()->Reserve(static_cast<int>(elem_count));
         for (size_t x = 0, loop_length = elem_count; x < loop_length; ++x) {
           tensor_proto.add_uint64_data(data[x]);
         }
@@ -214,6 +224,7 @@ void MLValueToTensorProto(Ort::Value& ml_value, bool using_raw_data,
       if (using_raw_data) {
         tensor_proto.set_raw_data(data, sizeof(double) * elem_count);
       } else {
+        tensor_proto.mutable_double_data()->Reserve(static_cast<int>(elem_count));
         for (size_t x = 0, loop_length = elem_count; x < loop_length; ++x) {
           tensor_proto.add_double_data(data[x]);
         }
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <memory>
 #include "environment.h"
 #include "onnxruntime_cxx_api.h"
@@ -86,33 +87,92 @@ void ServerEnvironment::RegisterExecutionProviders(){
 
 }
 
-void ServerEnvironment::InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version) {
-  RegisterExecutionProviders();
-  auto result = sessions_.emplace(std::piecewise_construct, std::forward_as_tuple(model_name, model_version), std::forward_as_tuple(runtime_environment_, model_path.c_str(), options_));
+void ServerEnvironment::InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version,
+                                        const BatchingOptions& batching, size_t num_replicas) {
+  AddModel(model_name, model_version, CreateModel(model_path, batching, num_replicas), false);
+}
+
+std::shared_ptr<ServedModel> ServerEnvironment::CreateModel(const std::string& model_path, const BatchingOptions& batching,
+                                                            size_t num_replicas) {
+  std::call_once(providers_registered_, [this]() { RegisterExecutionProviders(); });
+  auto model = std::make_shared<ServedModel>(runtime_environment_, model_path, options_, num_replicas, batching);
+  if (batching.max_batch_size > 1 && model->GetBatcher() == nullptr) {
+    default_logger_->warn("Model {} isn't batched: its inputs and outputs must all be numeric tensors with a free batch dimension",
+                          model_path);
+  }
+  return model;
+}
 
-  if (!result.second) {
+void ServerEnvironment::AddModel(const std::string& model_name, const std::string& model_version, std::shared_ptr<ServedModel> model,
+                                 bool replace) {
+  auto identifier = std::make_pair(model_name, model_version);
+  std::unique_lock<std::mutex> lock(models_mutex_);
+  auto it = models_.find(identifier);
+  if (it == models_.end()) {
+    models_.emplace(std::move(identifier), std::move(model));
+    return;
+  }
+  if (!replace) {
     throw Ort::Exception("Model of that name already loaded.", ORT_INVALID_ARGUMENT);
   }
 
-  auto iterator = result.first;
-  auto output_count = (iterator->second).session.GetOutputCount();
+  // the replaced model is released out of the lock, as it may wait for its batches
+  it->second.swap(model);
+  lock.unlock();
+}
 
-  Ort::AllocatorWithDefaultOptions allocator;
-  for (size_t i = 0; i < output_count; i++) {
-    auto name = (iterator->second).session.GetOutputName(i, allocator);
-    (iterator->second).output_names.push_back(name);
-    allocator.Free(name);
+// Orders the versions numerically when they're numbers, and lexicographically otherwise
+static bool VersionLess(const std::string& a, const std::string& b) {
+  auto is_number = [](const std::string& version) {
+    return !version.empty() && std::all_of(version.begin(), version.end(), [](char c) { return c >= '0' && c <= '9'; });
+  };
+  if (is_number(a) && is_number(b) && a.size() != b.size()) {
+    return a.size() < b.size();
   }
+  return a < b;
 }
 
-const std::vector<std::string>& ServerEnvironment::GetModelOutputNames(const std::string& model_name, const std::string& model_version) const {
-  auto identifier = std::make_pair(model_name, model_version);
-  auto it = sessions_.find(identifier);
-  if (it == sessions_.end()) {
+std::shared_ptr<ServedModel> ServerEnvironment::GetModel(const std::string& model_name, const std::string& model_version) const {
+  std::lock_guard<std::mutex> lock(models_mutex_);
+  if (!model_version.empty()) {
+    auto it = models_.find(std::make_pair(model_name, model_version));
+    if (it == models_.end()) {
+      throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+    }
+    return it->second;
+  }
+
+  const std::pair<const std::pair<std::string, std::string>, std::shared_ptr<ServedModel>>* latest = nullptr;
+  for (const auto& model : models_) {
+    if (model.first.first == model_name && (latest == nullptr || VersionLess(latest->first.second, model.first.second))) {
+      latest = &model;
+    }
+  }
+  if (latest == nullptr) {
     throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
   }
+  return latest->second;
+}
+
+std::string ServerEnvironment::ExportMetrics() const {
+  // the models are exported outside of the lock, which the requests take to get their model
+  std::vector<std::pair<std::string, std::shared_ptr<ServedModel>>> models;
+  {
+    std::lock_guard<std::mutex> lock(models_mutex_);
+    for (const auto& model : models_) {
+      models.emplace_back("model=\"" + model.first.first + "\",version=\"" + model.first.second + "\"", model.second);
+    }
+  }
 
-  return it->second.output_names;
+  std::string metrics;
+  for (const auto& model : models) {
+    model.second->ExportMetrics(model.first, metrics);
+  }
+  return metrics;
+}
+
+const std::vector<std::string>& ServerEnvironment::GetModelOutputNames(const std::string& model_name, const std::string& model_version) const {
+  return GetModel(model_name, model_version)->GetOutputNames();
 }
 
 OrtLoggingLevel ServerEnvironment::GetLogSeverity() const {
@@ -120,13 +180,7 @@ OrtLoggingLevel ServerEnvironment::GetLogSeverity() const {
 }
 
 const Ort::Session& ServerEnvironment::GetSession(const std::string& model_name, const std::string& model_version) const {
-  auto identifier = std::make_pair(model_name, model_version);
-  auto it = sessions_.find(identifier);
-  if (it == sessions_.end()) {
-    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
-  }
-
-  return it->second.session;
+  return GetModel(model_name, model_version)->GetSession();
 }
 
 std::shared_ptr<spdlog::logger> ServerEnvironment::GetLogger(const std::string& request_id) const {
@@ -141,12 +195,17 @@ std::shared_ptr<spdlog::logger> ServerEnvironment::GetAppLogger() const {
 
 void ServerEnvironment::UnloadModel(const std::string& model_name, const std::string& model_version) {
   auto identifier = std::make_pair(model_name, model_version);
-  auto it = sessions_.find(identifier);
-  if (it == sessions_.end()) {
+  std::shared_ptr<ServedModel> model;
+  std::unique_lock<std::mutex> lock(models_mutex_);
+  auto it = models_.find(identifier);
+  if (it == models_.end()) {
     throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
   }
 
-  sessions_.erase(it);
+  // released out of the lock, as it may wait for its batches
+  model = std::move(it->second);
+  models_.erase(it);
+  lock.unlock();
 }
 
 }  // namespace server
@@ -4,9 +4,11 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "onnxruntime_cxx_api.h"
+#include "served_model.h"
 #include <spdlog/spdlog.h>
 #include <unordered_map>
 #include <boost/functional/hash.hpp>
@@ -22,9 +24,25 @@ class ServerEnvironment {
 
   OrtLoggingLevel GetLogSeverity() const;
 
+  // The session and output names of a model are valid until the model is unloaded or replaced
   const Ort::Session& GetSession(const std::string& model_name, const std::string& model_version) const;
-  void InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version);
   const std::vector<std::string>& GetModelOutputNames(const std::string& model_name, const std::string& model_version) const;
+  // Loads a model with `num_replicas` sessions. Batches its requests when batching.max_batch_size > 1 and its inputs
+  // and outputs have a free batch dimension
+  void InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version,
+                       const BatchingOptions& batching = {}, size_t num_replicas = 1);
+  // Loads a model without adding it to the served ones
+  std::shared_ptr<ServedModel> CreateModel(const std::string& model_path, const BatchingOptions& batching = {},
+                                           size_t num_replicas = 1);
+  // Serves the model, replacing the one of that name and version if `replace`. The requests already running on the
+  // replaced model complete with it.
+  void AddModel(const std::string& model_name, const std::string& model_version, std::shared_ptr<ServedModel> model,
+                bool replace);
+  // The model of that name and version, or of the latest version of that name when `model_version` is empty. The model
+  // stays valid while it's held, even if it's unloaded or replaced.
+  std::shared_ptr<ServedModel> GetModel(const std::string& model_name, const std::string& model_version) const;
+  // The metrics of the models in the Prometheus text format
+  std::string ExportMetrics() const;
   std::shared_ptr<spdlog::logger> GetLogger(const std::string& request_id) const;
   std::shared_ptr<spdlog::logger> GetAppLogger() const;
   void UnloadModel(const std::string& model_name, const std::string& model_version);
@@ -38,20 +56,10 @@ class ServerEnvironment {
 
   Ort::Env runtime_environment_;
   Ort::SessionOptions options_;
+  std::once_flag providers_registered_;
 
-  struct SessionHolder {
-    Ort::Session session;
-    std::vector<std::string> output_names;
-    explicit SessionHolder(Ort::Env& env, std::string path, const Ort::SessionOptions& options) : session(nullptr) {
-      session = Ort::Session(env, path.c_str(), options);
-    };
-    ~SessionHolder() = default;
-    SessionHolder(const SessionHolder&) = delete;
-    SessionHolder(const SessionHolder&&) = delete;
-    SessionHolder& operator=(const SessionHolder&) = delete;
-  };
-
-  std::unordered_map<std::pair<std::string, std::string>, ServerEnvironment::SessionHolder, boost::hash<std::pair<std::string, std::string>>> sessions_;
+  mutable std::mutex models_mutex_;  // guards models_, which is updated by the model repository in the background
+  std::unordered_map<std::pair<std::string, std::string>, std::shared_ptr<ServedModel>, boost::hash<std::pair<std::string, std::string>>> models_;
 };
 
 }  // namespace server
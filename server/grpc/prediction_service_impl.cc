@@ -13,14 +13,25 @@ PredictionServiceImpl::PredictionServiceImpl(const std::shared_ptr<onnxruntime::
 ::grpc::Status PredictionServiceImpl::Predict(::grpc::ServerContext* context, const ::onnxruntime::server::PredictRequest* request, ::onnxruntime::server::PredictResponse* response) {
   auto request_id = SetRequestContext(context);
   onnxruntime::server::Executor executor(environment_.get(), request_id);
-  //TODO: (csteegz) Add modelspec for both paths.
-  auto status = executor.Predict("default", "1", *request, *response);  // Currently only support one model so hard coded.
+  // the model is given by the optional model-name and model-version metadata, the latest version by default
+  auto model_name = GetMetadata(context, "model-name");
+  auto status = executor.Predict(model_name.empty() ? "default" : model_name, GetMetadata(context, "model-version"),
+                                 *request, *response);
   if (!status.ok()) {
     return ::grpc::Status(::grpc::StatusCode(status.error_code()), status.error_message());
   }
   return ::grpc::Status::OK;
 }
 
+std::string PredictionServiceImpl::GetMetadata(::grpc::ServerContext* context, const std::string& key) {
+  const auto& metadata = context->client_metadata();
+  auto search = metadata.find(key);
+  if (search == metadata.end()) {
+    return "";
+  }
+  return std::string{search->second.data(), search->second.length()};
+}
+
 std::string PredictionServiceImpl::SetRequestContext(::grpc::ServerContext* context) {
   auto metadata = context->client_metadata();
   auto request_id = util::InternalRequestId();
@@ -20,6 +20,9 @@ class PredictionServiceImpl final : public onnxruntime::server::PredictionServic
 
   //Extract customer request ID and set request ID for response.
   std::string SetRequestContext(::grpc::ServerContext* context);
+
+  //Value of a client metadata key, empty if it's missing.
+  static std::string GetMetadata(::grpc::ServerContext* context, const std::string& key);
 };
 }  // namespace grpc
 }  // namespace server
@@ -40,7 +40,6 @@ void Predict(const std::string& name,
   logger->info("Model Name: {}, Version: {}, Action: {}", name, version, action);
 
   auto effective_name = name.empty() ? "default" : name;
-  auto effective_version = version.empty() ? "1" : version;
 
   if (!context.client_request_id.empty()) {
     logger->info("{}: [{}]", util::MS_CLIENT_REQUEST_ID_HEADER, context.client_request_id);
@@ -54,7 +53,6 @@ void Predict(const std::string& name,
   }
 
   // Deserialize the payload
-  auto body = context.request.body();
   PredictRequest predict_request{};
   http::status error_code;
   std::string error_message;
@@ -67,7 +65,8 @@ void Predict(const std::string& name,
   // Run Prediction
   Executor executor(env.get(), context.request_id);
   PredictResponse predict_response{};
-  auto status = executor.Predict(effective_name, effective_version, predict_request, predict_response);
+  // without a version, the request runs on the latest version of the model
+  auto status = executor.Predict(effective_name, version, predict_request, predict_response);
   if (!status.ok()) {
     GenerateErrorResponse(logger, GetHttpStatusCode((status)), status.error_message(), context);
     return;
@@ -96,12 +95,12 @@ void Predict(const std::string& name,
   if (!context.client_request_id.empty()) {
     context.response.insert(util::MS_CLIENT_REQUEST_ID_HEADER, context.client_request_id);
   }
-  context.response.body() = response_body;
+  context.response.body() = std::move(response_body);
   context.response.result(http::status::ok);
 };
 
 static bool ParseRequestPayload(const HttpContext& context, SupportedContentType request_type, PredictRequest& predictRequest, http::status& error_code, std::string& error_message) {
-  auto body = context.request.body();
+  const auto& body = context.request.body();
   protobufutil::Status status;
   switch (request_type) {
     case SupportedContentType::Json: {
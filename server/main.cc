@@ -6,6 +6,7 @@
 #include "predict_request_handler.h"
 #include "server_configuration.h"
 #include "grpc/grpc_app.h"
+#include "model_repository.h"
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/sink.h>
 #include <spdlog/sinks/stdout_sinks.h>
@@ -60,16 +61,32 @@ int main(int argc, char* argv[]) {
 
   const auto env = std::make_shared<server::ServerEnvironment>(config.logging_level, spdlog::sinks_init_list{std::make_shared<spdlog::sinks::stdout_sink_mt>(), std::make_shared<spdlog::sinks::syslog_sink_mt>()});
   auto logger = env->GetAppLogger();
-  logger->info("Model path: {}, ", config.model_path);
-  logger->info("Model name: {}", config.model_name);
-  logger->info("Model version: {}", config.model_version);
-
-  try {
-    env->InitializeModel(config.model_path, config.model_name, config.model_version);
-    logger->debug("Initialize Model Successfully!");
-  } catch (const Ort::Exception& ex) {
-    logger->critical("Initialize Model Failed: {} ---- Error: [{}]", ex.GetOrtErrorCode(), ex.what());
-    exit(EXIT_FAILURE);
+  logger->info("Max batch size: {}, max queue delay: {}us", config.max_batch_size, config.max_queue_delay_us);
+  logger->info("Number of replicas: {}", config.num_replicas);
+
+  server::BatchingOptions batching{};
+  batching.max_batch_size = config.max_batch_size;
+  batching.max_queue_delay_us = config.max_queue_delay_us;
+  std::unique_ptr<server::ModelRepository> repository;
+  if (!config.model_repository.empty()) {
+    logger->info("Model repository: {}", config.model_repository);
+    repository = std::make_unique<server::ModelRepository>(env.get(), config.model_repository, batching,
+                                                           static_cast<size_t>(config.num_replicas));
+    logger->info("Serving {} model versions", repository->Poll());
+    repository->Start(std::chrono::seconds(config.repository_poll_interval_s));
+  } else {
+    logger->info("Model path: {}, ", config.model_path);
+    logger->info("Model name: {}", config.model_name);
+    logger->info("Model version: {}", config.model_version);
+
+    try {
+      env->InitializeModel(config.model_path, config.model_name, config.model_version, batching,
+                           static_cast<size_t>(config.num_replicas));
+      logger->debug("Initialize Model Successfully!");
+    } catch (const Ort::Exception& ex) {
+      logger->critical("Initialize Model Failed: {} ---- Error: [{}]", ex.GetOrtErrorCode(), ex.what());
+      exit(EXIT_FAILURE);
+    }
   }
 
   //Setup GRPC Server
@@ -118,6 +135,14 @@ int main(int argc, char* argv[]) {
       }
   );
 
+  app.RegisterGet(
+      R"(/metrics()()())",
+      [&env](const auto& /*name*/, const auto& /*version*/, const auto& /*action*/, auto& context) -> void {
+        context.response.result(http::status::ok);
+        context.response.set(http::field::content_type, "text/plain; version=0.0.4");
+        context.response.body() = env->ExportMetrics();
+      });
+
   app.Bind(boost_address, config.http_port)
       .NumThreads(config.num_http_threads)
       .Run();
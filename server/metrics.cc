@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <sstream>
+
+#include "metrics.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace chrono = std::chrono;
+
+// digits of the exported values, so the counts and sums of microseconds don't switch to the scientific notation
+static constexpr int kPrecision = 15;
+
+Histogram::Histogram(std::vector<double> upper_bounds) : upper_bounds_(std::move(upper_bounds)),
+                                                         counts_(new std::atomic<uint64_t>[upper_bounds_.size() + 1]) {
+  for (size_t i = 0; i <= upper_bounds_.size(); ++i) {
+    counts_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+std::vector<double> Histogram::ExponentialBounds(double start, double factor, double end) {
+  std::vector<double> bounds{start};
+  while (bounds.back() < end) {
+    bounds.push_back(bounds.back() * factor);
+  }
+  return bounds;
+}
+
+void Histogram::Observe(double value) {
+  const size_t bucket = std::lower_bound(upper_bounds_.begin(), upper_bounds_.end(), value) - upper_bounds_.begin();
+  counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+  // there's no fetch_add for double before C++20
+  double sum = sum_.load(std::memory_order_relaxed);
+  while (!sum_.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) {
+  }
+}
+
+void Histogram::Export(const std::string& name, const std::string& labels, std::string& out) const {
+  std::ostringstream stream;
+  stream.precision(kPrecision);
+  const std::string separator = labels.empty() ? "" : ",";
+
+  uint64_t count = 0;
+  for (size_t i = 0; i <= upper_bounds_.size(); ++i) {
+    count += counts_[i].load(std::memory_order_relaxed);
+    stream << name << "_bucket{" << labels << separator << "le=\"";
+    if (i < upper_bounds_.size()) {
+      stream << upper_bounds_[i];
+    } else {
+      stream << "+Inf";
+    }
+    stream << "\"} " << count << "\n";
+  }
+  stream << name << "_sum{" << labels << "} " << sum_.load(std::memory_order_relaxed) << "\n";
+  stream << name << "_count{" << labels << "} " << count << "\n";
+  out += stream.str();
+}
+
+void ExportValue(const std::string& name, const std::string& labels, double value, std::string& out) {
+  std::ostringstream stream;
+  stream.precision(kPrecision);
+  stream << name << "{" << labels << "} " << value << "\n";
+  out += stream.str();
+}
+
+ModelMetrics::ModelMetrics() : request_latencies_us_(Histogram::ExponentialBounds(100, 2, 10000000)),
+                               run_latencies_us_(Histogram::ExponentialBounds(100, 2, 10000000)) {}
+
+ModelMetrics::Request::Request(ModelMetrics& metrics) : metrics_(metrics), start_(chrono::steady_clock::now()) {
+  metrics_.in_flight_.fetch_add(1, std::memory_order_relaxed);
+}
+
+ModelMetrics::Request::~Request() {
+  const auto latency = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_);
+  metrics_.request_latencies_us_.Observe(static_cast<double>(latency.count()));
+  metrics_.requests_.fetch_add(1, std::memory_order_relaxed);
+  if (!succeeded_) {
+    metrics_.failures_.fetch_add(1, std::memory_order_relaxed);
+  }
+  metrics_.in_flight_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ModelMetrics::ObserveRun(chrono::steady_clock::duration duration) {
+  run_latencies_us_.Observe(static_cast<double>(chrono::duration_cast<chrono::microseconds>(duration).count()));
+}
+
+void ModelMetrics::Export(const std::string& labels, std::string& out) const {
+  ExportValue("onnxruntime_server_requests_total", labels,
+              static_cast<double>(requests_.load(std::memory_order_relaxed)), out);
+  ExportValue("onnxruntime_server_request_failures_total", labels,
+              static_cast<double>(failures_.load(std::memory_order_relaxed)), out);
+  ExportValue("onnxruntime_server_requests_in_flight", labels,
+              static_cast<double>(in_flight_.load(std::memory_order_relaxed)), out);
+  request_latencies_us_.Export("onnxruntime_server_request_latency_us", labels, out);
+  run_latencies_us_.Export("onnxruntime_server_run_latency_us", labels, out);
+}
+
+}  // namespace server
+}  // namespace onnxruntime
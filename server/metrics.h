@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace onnxruntime {
+namespace server {
+
+// Counts of the observed values in buckets of increasing upper bounds, exported in the Prometheus text format.
+// Observing is lock free, so it can be done on the path of every request.
+class Histogram {
+ public:
+  explicit Histogram(std::vector<double> upper_bounds);
+
+  // Upper bounds start, start * factor, ... up to and including the first one >= end
+  static std::vector<double> ExponentialBounds(double start, double factor, double end);
+
+  void Observe(double value);
+
+  // Appends the lines of the histogram `name` with the `labels` (e.g. model="m",version="1") to `out`.
+  // The buckets are read one at a time, so the values observed meanwhile may be missing from some of them.
+  void Export(const std::string& name, const std::string& labels, std::string& out) const;
+
+ private:
+  const std::vector<double> upper_bounds_;
+  std::unique_ptr<std::atomic<uint64_t>[]> counts_;  // one per upper bound, and one for +Inf
+  std::atomic<double> sum_{0};
+};
+
+// Appends the line of the counter or gauge `name` with the `labels` to `out`
+void ExportValue(const std::string& name, const std::string& labels, double value, std::string& out);
+
+// The metrics of the requests of a served model, fed by the executor
+class ModelMetrics {
+ public:
+  ModelMetrics();
+
+  // Tracks a request from its construction to its destruction: the request is counted in flight meanwhile, then its
+  // latency is observed, and it's counted as failed unless Succeeded was called
+  class Request {
+   public:
+    explicit Request(ModelMetrics& metrics);
+    ~Request();
+    Request(const Request&) = delete;
+    Request& operator=(const Request&) = delete;
+
+    void Succeeded() { succeeded_ = true; }
+
+   private:
+    ModelMetrics& metrics_;
+    const std::chrono::steady_clock::time_point start_;
+    bool succeeded_ = false;
+  };
+
+  // Observes the duration of a run of the model, queueing in the batcher included
+  void ObserveRun(std::chrono::steady_clock::duration duration);
+
+  // Appends the metrics with the `labels` to `out`
+  void Export(const std::string& labels, std::string& out) const;
+
+ private:
+  std::atomic<uint64_t> requests_{0};
+  std::atomic<uint64_t> failures_{0};
+  std::atomic<int64_t> in_flight_{0};
+  Histogram request_latencies_us_;
+  Histogram run_latencies_us_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <boost/filesystem.hpp>
+
+#include "model_repository.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace fs = boost::filesystem;
+
+static const char* const kModelFileName = "model.onnx";
+
+ModelRepository::ModelRepository(ServerEnvironment* env, std::string path, const BatchingOptions& batching,
+                                 size_t num_replicas) : env_(env),
+                                                        path_(std::move(path)),
+                                                        batching_(batching),
+                                                        num_replicas_(num_replicas) {}
+
+ModelRepository::~ModelRepository() {
+  if (poller_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    stop_cv_.notify_one();
+    poller_.join();
+  }
+}
+
+size_t ModelRepository::Poll() {
+  auto logger = env_->GetAppLogger();
+
+  // the versions in the directory, with the last write time of their model
+  std::map<ModelKey, std::time_t> found;
+  boost::system::error_code ec;
+  for (fs::directory_iterator model_dir(path_, ec), end; !ec && model_dir != end; model_dir.increment(ec)) {
+    boost::system::error_code version_ec;
+    if (!fs::is_directory(model_dir->path(), version_ec)) {
+      continue;
+    }
+    for (fs::directory_iterator version_dir(model_dir->path(), version_ec); !version_ec && version_dir != end;
+         version_dir.increment(version_ec)) {
+      boost::system::error_code file_ec;
+      const auto model_file = version_dir->path() / kModelFileName;
+      if (!fs::is_regular_file(model_file, file_ec)) {
+        continue;
+      }
+      const auto last_write_time = fs::last_write_time(model_file, file_ec);
+      if (!file_ec) {
+        found[{model_dir->path().filename().string(), version_dir->path().filename().string()}] = last_write_time;
+      }
+    }
+  }
+  if (ec) {
+    // keeps serving the loaded versions
+    logger->error("Failed to list the model repository {}: {}", path_, ec.message());
+    return loaded_.size();
+  }
+
+  for (auto it = loaded_.begin(); it != loaded_.end();) {
+    if (found.find(it->first) == found.end()) {
+      env_->UnloadModel(it->first.first, it->first.second);
+      logger->info("Unloaded model {} version {}", it->first.first, it->first.second);
+      it = loaded_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto it = failed_.begin(); it != failed_.end();) {
+    it = found.find(it->first) == found.end() ? failed_.erase(it) : std::next(it);
+  }
+
+  for (const auto& version : found) {
+    const auto loaded = loaded_.find(version.first);
+    const auto failed = failed_.find(version.first);
+    if ((loaded != loaded_.end() && loaded->second == version.second) ||
+        (failed != failed_.end() && failed->second == version.second)) {
+      continue;
+    }
+
+    const auto& name = version.first.first;
+    const auto& model_version = version.first.second;
+    const auto model_file = (fs::path(path_) / name / model_version / kModelFileName).string();
+    try {
+      auto model = env_->CreateModel(model_file, batching_, num_replicas_);
+      model->WarmUp();
+      env_->AddModel(name, model_version, std::move(model), true);
+      logger->info("{} model {} version {}", loaded == loaded_.end() ? "Loaded" : "Reloaded", name, model_version);
+      loaded_[version.first] = version.second;
+      failed_.erase(version.first);
+    } catch (const Ort::Exception& e) {
+      // a reloaded version keeps serving its previous model
+      logger->error("Failed to load model {} version {} from {}: {}", name, model_version, model_file, e.what());
+      failed_[version.first] = version.second;
+    }
+  }
+
+  return loaded_.size();
+}
+
+void ModelRepository::Start(std::chrono::seconds interval) {
+  poller_ = std::thread([this, interval]() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_cv_.wait_for(lock, interval, [this]() { return stop_; })) {
+      lock.unlock();
+      Poll();
+      lock.lock();
+    }
+  });
+}
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "environment.h"
+
+namespace onnxruntime {
+namespace server {
+
+// Serves the models of a directory laid out as <repository>/<model name>/<version>/model.onnx.
+// Each poll synchronizes the served models with the directory: the new versions are loaded and warmed up before they're
+// served, the versions whose model.onnx was modified are reloaded and swapped in the same way, and the removed ones are
+// unloaded. The requests already running on a replaced or unloaded version complete with it, so the server keeps
+// serving while the models are updated.
+class ModelRepository {
+ public:
+  ModelRepository(ServerEnvironment* env, std::string path, const BatchingOptions& batching, size_t num_replicas);
+  ~ModelRepository();
+  ModelRepository(const ModelRepository&) = delete;
+  ModelRepository& operator=(const ModelRepository&) = delete;
+
+  // Synchronizes the served models with the directory once, and returns the number of served versions.
+  // Must not be called once the background polling is started.
+  size_t Poll();
+
+  // Polls the directory every `interval` on a background thread, until the repository is destroyed
+  void Start(std::chrono::seconds interval);
+
+ private:
+  using ModelKey = std::pair<std::string, std::string>;  // model name and version
+
+  ServerEnvironment* env_;
+  const std::string path_;
+  const BatchingOptions batching_;
+  const size_t num_replicas_;
+
+  // the last write time of the model.onnx of the served versions, and of the ones which failed to load, which are
+  // retried when they're modified
+  std::map<ModelKey, std::time_t> loaded_;
+  std::map<ModelKey, std::time_t> failed_;
+
+  std::mutex mutex_;
+  std::condition_variable stop_cv_;
+  bool stop_ = false;
+  std::thread poller_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
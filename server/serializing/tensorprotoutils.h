@@ -27,6 +27,16 @@ void GetSizeInBytesFromTensorProto(const onnx::TensorProto& tensor_proto, size_t
  */
 void TensorProtoToMLValue(const onnx::TensorProto& input, const server::MemBuffer& m, /* out */ Ort::Value& value);
 
+/**
+ * wrap the raw_data of a numeric TensorProto as the buffer of a tensor, without copying it.
+ * The TensorProto must outlive the value, which must not be written to.
+ * Returns false when the data can't be used as is: it isn't in raw_data, the tensor is empty or of strings, the host
+ * is big endian or the data isn't aligned on its element size. The TensorProto must then go through
+ * TensorProtoToMLValue.
+ */
+bool TryWrapTensorProtoRawData(const onnx::TensorProto& input, const OrtMemoryInfo& memory_info,
+                               /* out */ Ort::Value& value);
+
 template <typename T>
 void UnpackTensor(const onnx::TensorProto& tensor, const void* raw_data, size_t raw_data_len,
                   /*out*/ T* p_data, int64_t expected_size);
@@ -0,0 +1,166 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <chrono>
+
+#include "served_model.h"
+
+namespace onnxruntime {
+namespace server {
+
+std::vector<Ort::Value> RunSession(const Ort::Session& session,
+                                   const Ort::RunOptions& run_options,
+                                   const std::vector<std::string>& input_names,
+                                   const std::vector<const OrtValue*>& input_values,
+                                   const std::vector<std::string>& output_names) {
+  std::vector<const char*> input_ptrs;
+  input_ptrs.reserve(input_names.size());
+  for (const auto& input : input_names) {
+    input_ptrs.push_back(input.data());
+  }
+  std::vector<const char*> output_ptrs;
+  output_ptrs.reserve(output_names.size());
+  for (const auto& output : output_names) {
+    output_ptrs.push_back(output.data());
+  }
+
+  std::vector<OrtValue*> outputs(output_names.size(), nullptr);
+  Ort::ThrowOnError(Ort::GetApi().Run(const_cast<OrtSession*>(static_cast<const OrtSession*>(session)), run_options,
+                                      input_ptrs.data(), input_values.data(), input_values.size(),
+                                      output_ptrs.data(), output_ptrs.size(), outputs.data()));
+
+  std::vector<Ort::Value> result;
+  result.reserve(outputs.size());
+  for (auto* output : outputs) {
+    result.emplace_back(output);
+  }
+  return result;
+}
+
+ServedModel::ServedModel(Ort::Env& env, const std::string& path, const Ort::SessionOptions& options,
+                         size_t num_replicas, const BatchingOptions& batching) {
+  for (size_t i = 0; i < std::max<size_t>(num_replicas, 1); ++i) {
+    replicas_.push_back(std::make_unique<Replica>());
+    replicas_.back()->session = Ort::Session(env, path.c_str(), options);
+  }
+
+  const auto& session = GetSession();
+  Ort::AllocatorWithDefaultOptions allocator;
+  for (size_t i = 0, count = session.GetOutputCount(); i < count; i++) {
+    auto name = session.GetOutputName(i, allocator);
+    output_names_.push_back(name);
+    allocator.Free(name);
+  }
+
+  if (batching.max_batch_size > 1 && Batcher::CanBatch(session)) {
+    // a batch is run by default, as the options of the requests sharing it may differ
+    auto run = [this](const std::vector<std::string>& input_names, const std::vector<const OrtValue*>& input_values,
+                      const std::vector<std::string>& output_names) {
+      Ort::RunOptions run_options;
+      return RunOnReplica(run_options, input_names, input_values, output_names);
+    };
+    batcher_ = std::make_unique<Batcher>(run, batching, replicas_.size());
+  }
+}
+
+std::vector<Ort::Value> ServedModel::RunOnReplica(const Ort::RunOptions& run_options,
+                                                  const std::vector<std::string>& input_names,
+                                                  const std::vector<const OrtValue*>& input_values,
+                                                  const std::vector<std::string>& output_names) {
+  // the count of a replica may change between the reads, which at worst picks a replica that isn't the least loaded
+  auto& replica = **std::min_element(replicas_.begin(), replicas_.end(), [](const auto& a, const auto& b) {
+    return a->num_running.load(std::memory_order_relaxed) < b->num_running.load(std::memory_order_relaxed);
+  });
+
+  struct RunningCount {
+    explicit RunningCount(std::atomic<int>& count) : count_(count) { ++count_; }
+    ~RunningCount() { --count_; }
+    std::atomic<int>& count_;
+  } running{replica.num_running};
+
+  return RunSession(replica.session, run_options, input_names, input_values, output_names);
+}
+
+std::vector<Ort::Value> ServedModel::Run(const Ort::RunOptions& run_options,
+                                         const std::vector<std::string>& input_names,
+                                         const std::vector<Ort::Value>& input_values,
+                                         const std::vector<std::string>& output_names) {
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<Ort::Value> outputs;
+  if (batcher_ != nullptr) {
+    outputs = batcher_->Run(input_names, input_values, output_names);
+  } else {
+    std::vector<const OrtValue*> values;
+    values.reserve(input_values.size());
+    for (const auto& value : input_values) {
+      values.push_back(value);
+    }
+    outputs = RunOnReplica(run_options, input_names, values, output_names);
+  }
+  metrics_.ObserveRun(std::chrono::steady_clock::now() - start);
+  return outputs;
+}
+
+void ServedModel::ExportMetrics(const std::string& labels, std::string& out) const {
+  metrics_.Export(labels, out);
+
+  Ort::MemoryArenaStats arena;
+  for (const auto& replica : replicas_) {
+    const auto stats = replica->session.GetMemoryArenaStats();
+    arena.bytes_in_use += stats.bytes_in_use;
+    arena.total_allocated_bytes += stats.total_allocated_bytes;
+    arena.max_bytes_in_use += stats.max_bytes_in_use;
+    arena.num_allocs += stats.num_allocs;
+  }
+  ExportValue("onnxruntime_server_arena_bytes_in_use", labels, static_cast<double>(arena.bytes_in_use), out);
+  ExportValue("onnxruntime_server_arena_allocated_bytes", labels, static_cast<double>(arena.total_allocated_bytes),
+              out);
+  ExportValue("onnxruntime_server_arena_max_bytes_in_use", labels, static_cast<double>(arena.max_bytes_in_use), out);
+  ExportValue("onnxruntime_server_arena_allocations_total", labels, static_cast<double>(arena.num_allocs), out);
+
+  if (batcher_ != nullptr) {
+    batcher_->ExportMetrics(labels, out);
+  }
+}
+
+void ServedModel::WarmUp() {
+  const auto& session = GetSession();
+  Ort::AllocatorWithDefaultOptions allocator;
+
+  std::vector<std::string> input_names;
+  std::vector<Ort::Value> inputs;
+  std::vector<const OrtValue*> input_values;
+  for (size_t i = 0, count = session.GetInputCount(); i < count; ++i) {
+    const auto type_info = session.GetInputTypeInfo(i);
+    if (type_info.GetONNXType() != ONNX_TYPE_TENSOR) {
+      return;
+    }
+    const auto info = type_info.GetTensorTypeAndShapeInfo();
+    const size_t element_size = NumericElementSize(info.GetElementType());
+    if (element_size == 0) {
+      return;
+    }
+    auto shape = info.GetShape();
+    for (auto& dim : shape) {
+      dim = dim < 0 ? 1 : dim;
+    }
+
+    auto name = session.GetInputName(i, allocator);
+    input_names.push_back(name);
+    allocator.Free(name);
+
+    inputs.push_back(Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), info.GetElementType()));
+    auto* data = inputs.back().GetTensorMutableData<char>();
+    std::fill(data, data + inputs.back().GetTensorTypeAndShapeInfo().GetElementCount() * element_size, 0);
+    input_values.push_back(inputs.back());
+  }
+
+  Ort::RunOptions run_options;
+  for (const auto& replica : replicas_) {
+    RunSession(replica->session, run_options, input_names, input_values, output_names_);
+  }
+}
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "onnxruntime_cxx_api.h"
+#include "batcher.h"
+#include "metrics.h"
+
+namespace onnxruntime {
+namespace server {
+
+// Runs the session with the inputs, and returns the outputs. Throws Ort::Exception like Session::Run.
+std::vector<Ort::Value> RunSession(const Ort::Session& session,
+                                   const Ort::RunOptions& run_options,
+                                   const std::vector<std::string>& input_names,
+                                   const std::vector<const OrtValue*>& input_values,
+                                   const std::vector<std::string>& output_names);
+
+// A version of a model served by the server. Its requests are dispatched to the least loaded of its session
+// replicas, and batched when the batching is enabled and the model has a free batch dimension.
+class ServedModel {
+ public:
+  ServedModel(Ort::Env& env, const std::string& path, const Ort::SessionOptions& options, size_t num_replicas,
+              const BatchingOptions& batching);
+  ~ServedModel() = default;
+  ServedModel(const ServedModel&) = delete;
+  ServedModel& operator=(const ServedModel&) = delete;
+
+  // The session of the first replica, for the metadata of the model
+  const Ort::Session& GetSession() const { return replicas_.front()->session; }
+  const std::vector<std::string>& GetOutputNames() const { return output_names_; }
+  // The batcher of the requests, null when they aren't batched
+  Batcher* GetBatcher() const { return batcher_.get(); }
+  ModelMetrics& GetMetrics() { return metrics_; }
+
+  // Appends the metrics of the requests, the usage of the memory arenas summed over the replicas and the metrics of
+  // the batcher with the `labels` to `out`
+  void ExportMetrics(const std::string& labels, std::string& out) const;
+
+  // Runs the request, in a batch when the requests are batched, and observes its duration in the metrics.
+  // Throws Ort::Exception like Session::Run.
+  std::vector<Ort::Value> Run(const Ort::RunOptions& run_options,
+                              const std::vector<std::string>& input_names,
+                              const std::vector<Ort::Value>& input_values,
+                              const std::vector<std::string>& output_names);
+
+  // Runs each replica once with inputs of zeros, so the first requests don't pay for the lazy initializations of the
+  // execution providers. The free dimensions of the inputs are 1. Does nothing if an input isn't a numeric tensor.
+  // Throws Ort::Exception if a run fails.
+  void WarmUp();
+
+ private:
+  struct Replica {
+    Ort::Session session{nullptr};
+    std::atomic<int> num_running{0};
+  };
+
+  std::vector<Ort::Value> RunOnReplica(const Ort::RunOptions& run_options,
+                                       const std::vector<std::string>& input_names,
+                                       const std::vector<const OrtValue*>& input_values,
+                                       const std::vector<std::string>& output_names);
+
+  std::vector<std::unique_ptr<Replica>> replicas_;
+  std::vector<std::string> output_names_;
+  ModelMetrics metrics_;
+  std::unique_ptr<Batcher> batcher_;  // declared last to be destroyed first, as its workers run the replicas
+};
+
+}  // namespace server
+}  // namespace onnxruntime
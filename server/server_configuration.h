@@ -39,6 +39,9 @@ class ServerConfiguration {
  public:
   const std::string full_desc = "ONNX Server: host an ONNX model with ONNX Runtime";
   std::string model_path;
+  std::string model_repository;
+  int repository_poll_interval_s = 10;
+  int num_replicas = 1;
   std::string model_name = "default";
   std::string model_version = "1";
   std::string address = "0.0.0.0";
@@ -46,17 +49,24 @@ class ServerConfiguration {
   unsigned short grpc_port = 50051;
   int num_http_threads = std::thread::hardware_concurrency();
   OrtLoggingLevel logging_level{};
+  int64_t max_batch_size = 1;
+  int64_t max_queue_delay_us = 1000;
 
   ServerConfiguration() {
     desc.add_options()("help,h", "Shows a help message and exits");
     desc.add_options()("log_level", po::value(&log_level_str)->default_value(log_level_str), "Logging level. Allowed options (case sensitive): verbose, info, warning, error, fatal");
-    desc.add_options()("model_path", po::value(&model_path)->required(), "Path to ONNX model");
+    desc.add_options()("model_path", po::value(&model_path), "Path to ONNX model");
+    desc.add_options()("model_repository", po::value(&model_repository), "Directory of the models to serve, laid out as <model name>/<version>/model.onnx. Replaces model_path, and is polled for new, modified and removed versions");
+    desc.add_options()("repository_poll_interval_s", po::value(&repository_poll_interval_s)->default_value(repository_poll_interval_s), "Interval in seconds between the polls of the model repository");
+    desc.add_options()("num_replicas", po::value(&num_replicas)->default_value(num_replicas), "Number of sessions of each model, which run its requests concurrently");
     desc.add_options()("model_name", po::value(&model_name)->default_value(model_name), "ONNX model name");
     desc.add_options()("model_version", po::value(&model_version)->default_value(model_version), "ONNX model version");
     desc.add_options()("address", po::value(&address)->default_value(address), "The base HTTP address");
     desc.add_options()("http_port", po::value(&http_port)->default_value(http_port), "HTTP port to listen to requests");
     desc.add_options()("num_http_threads", po::value(&num_http_threads)->default_value(num_http_threads), "Number of http threads");
     desc.add_options()("grpc_port", po::value(&grpc_port)->default_value(grpc_port), "GRPC port to listen to requests");
+    desc.add_options()("max_batch_size", po::value(&max_batch_size)->default_value(max_batch_size), "Largest number of rows of the requests batched together. 1 disables batching");
+    desc.add_options()("max_queue_delay_us", po::value(&max_queue_delay_us)->default_value(max_queue_delay_us), "Longest time in microseconds a request waits for others to batch with");
   }
 
   // Parses argc and argv and sets the values for the class
@@ -103,6 +113,24 @@ class ServerConfiguration {
     } else if (num_http_threads <= 0) {
       PrintHelp(std::cerr, "num_http_threads must be greater than 0");
       return Result::ExitFailure;
+    } else if (max_batch_size <= 0) {
+      PrintHelp(std::cerr, "max_batch_size must be greater than 0");
+      return Result::ExitFailure;
+    } else if (max_queue_delay_us < 0) {
+      PrintHelp(std::cerr, "max_queue_delay_us must not be negative");
+      return Result::ExitFailure;
+    } else if (num_replicas <= 0) {
+      PrintHelp(std::cerr, "num_replicas must be greater than 0");
+      return Result::ExitFailure;
+    } else if (model_path.empty() == model_repository.empty()) {
+      PrintHelp(std::cerr, "one of model_path or model_repository is required");
+      return Result::ExitFailure;
+    } else if (!model_repository.empty()) {
+      if (repository_poll_interval_s <= 0) {
+        PrintHelp(std::cerr, "repository_poll_interval_s must be greater than 0");
+        return Result::ExitFailure;
+      }
+      return Result::ContinueSuccess;
     } else if (!file_exists(model_path)) {
       PrintHelp(std::cerr, "model_path must be the location of a valid file");
       return Result::ExitFailure;
@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+
+#include "batcher.h"
+#include "executor.h"
+#include "http/json_handling.h"
+#include "test_server_environment.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+static Ort::Value CreateFloatTensor(std::vector<int64_t> shape, const std::vector<float>& data) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  auto value = Ort::Value::CreateTensor<float>(allocator, shape.data(), shape.size());
+  std::copy(data.begin(), data.end(), value.GetTensorMutableData<float>());
+  return value;
+}
+
+static std::vector<float> GetFloatData(Ort::Value& value) {
+  const auto* data = value.GetTensorMutableData<float>();
+  return std::vector<float>(data, data + value.GetTensorTypeAndShapeInfo().GetElementCount());
+}
+
+TEST(BatcherTests, ConcatenateAndSlice) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  auto a = CreateFloatTensor({1, 2}, {1, 2});
+  auto b = CreateFloatTensor({2, 2}, {3, 4, 5, 6});
+
+  auto batch = ConcatenateBatch({a, b}, allocator);
+  EXPECT_EQ(batch.GetTensorTypeAndShapeInfo().GetShape(), (std::vector<int64_t>{3, 2}));
+  EXPECT_EQ(GetFloatData(batch), (std::vector<float>{1, 2, 3, 4, 5, 6}));
+
+  auto slice = SliceBatch(batch, 1, 2, allocator);
+  EXPECT_EQ(slice.GetTensorTypeAndShapeInfo().GetShape(), (std::vector<int64_t>{2, 2}));
+  EXPECT_EQ(GetFloatData(slice), (std::vector<float>{3, 4, 5, 6}));
+
+  EXPECT_THROW(SliceBatch(batch, 2, 2, allocator), Ort::Exception);
+}
+
+TEST(BatcherTests, FixedBatchDimensionIsNotBatched) {
+  // the input of mul_1 has the fixed shape [3, 2]
+  ServerEnvironment* env = ServerEnv();
+  BatchingOptions batching{};
+  batching.max_batch_size = 8;
+  env->InitializeModel("testdata/mul_1.onnx", "Batched", "1", batching);
+  EXPECT_FALSE(Batcher::CanBatch(env->GetSession("Batched", "1")));
+  EXPECT_EQ(env->GetModel("Batched", "1")->GetBatcher(), nullptr);
+  EXPECT_EQ(env->ExportMetrics().find("onnxruntime_server_batch_"), std::string::npos);
+
+  const static auto input_json = R"({"inputs":{"X":{"dims":[3,2],"dataType":1,"floatData":[1,2,3,4,5,6]}},"outputFilter":["Y"]})";
+  const static auto expected = R"({"outputs":{"Y":{"dims":["3","2"],"dataType":1,"floatData":[1,4,9,16,25,36]}}})";
+  Executor executor(env, "RequestId");
+  PredictRequest request{};
+  PredictResponse response{};
+  EXPECT_TRUE(GetRequestFromJson(input_json, request).ok());
+  EXPECT_TRUE(executor.Predict("Batched", "1", request, response).ok());
+  std::string body;
+  GenerateResponseInJson(response, body);
+  EXPECT_EQ(expected, body);
+
+  env->UnloadModel("Batched", "1");
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
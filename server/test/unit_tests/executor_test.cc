@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cstring>
 #include <iostream>
 
 #include "gtest/gtest.h"
@@ -52,6 +53,57 @@ TEST_F(ExecutorTest, TestMul_1) {
   EXPECT_EQ(expected, body);
 }
 
+TEST_F(ExecutorTest, TestMul_1_RawData) {
+  // the raw data of the input is used in place, and the outputs are returned in raw data as well
+  const std::vector<float> x{1, 2, 3, 4, 5, 6};
+  const std::vector<float> expected{1, 4, 9, 16, 25, 36};
+
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+
+  onnxruntime::server::Executor executor(env, "RequestId");
+  onnxruntime::server::PredictRequest request{};
+  onnxruntime::server::PredictResponse response{};
+
+  auto& input = (*request.mutable_inputs())["X"];
+  input.add_dims(3);
+  input.add_dims(2);
+  input.set_data_type(onnx::TensorProto_DataType_FLOAT);
+  input.set_raw_data(x.data(), x.size() * sizeof(float));
+  request.add_output_filter("Y");
+
+  auto prediction_res = executor.Predict("Name", "version", request, response);
+  EXPECT_TRUE(prediction_res.ok());
+
+  // the request is left untouched
+  EXPECT_EQ(input.raw_data(), std::string(reinterpret_cast<const char*>(x.data()), x.size() * sizeof(float)));
+
+  const auto& output = response.outputs().at("Y");
+  EXPECT_EQ(output.float_data_size(), 0);
+  ASSERT_EQ(output.raw_data().size(), expected.size() * sizeof(float));
+  std::vector<float> y(expected.size());
+  memcpy(y.data(), output.raw_data().data(), output.raw_data().size());
+  EXPECT_EQ(y, expected);
+}
+
+TEST_F(ExecutorTest, TestMul_1_RawDataSizeMismatch) {
+  const std::vector<float> x{1, 2, 3, 4};
+
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+
+  onnxruntime::server::Executor executor(env, "RequestId");
+  onnxruntime::server::PredictRequest request{};
+  onnxruntime::server::PredictResponse response{};
+
+  auto& input = (*request.mutable_inputs())["X"];
+  input.add_dims(3);
+  input.add_dims(2);
+  input.set_data_type(onnx::TensorProto_DataType_FLOAT);
+  input.set_raw_data(x.data(), x.size() * sizeof(float));
+
+  auto prediction_res = executor.Predict("Name", "version", request, response);
+  EXPECT_FALSE(prediction_res.ok());
+}
+
 }  // namespace test
 }  // namespace server
 }  // namespace onnxruntime
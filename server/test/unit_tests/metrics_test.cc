@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "executor.h"
+#include "http/json_handling.h"
+#include "metrics.h"
+#include "test_server_environment.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+TEST(MetricsTests, Histogram) {
+  Histogram histogram{Histogram::ExponentialBounds(1, 2, 4)};
+  histogram.Observe(1);
+  histogram.Observe(3);
+  histogram.Observe(8);
+
+  std::string out;
+  histogram.Export("batch_size", "model=\"m\"", out);
+  EXPECT_EQ(out,
+            "batch_size_bucket{model=\"m\",le=\"1\"} 1\n"
+            "batch_size_bucket{model=\"m\",le=\"2\"} 1\n"
+            "batch_size_bucket{model=\"m\",le=\"4\"} 2\n"
+            "batch_size_bucket{model=\"m\",le=\"+Inf\"} 3\n"
+            "batch_size_sum{model=\"m\"} 12\n"
+            "batch_size_count{model=\"m\"} 3\n");
+}
+
+TEST(MetricsTests, HistogramConcurrentObservations) {
+  Histogram histogram{{10}};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&histogram]() {
+      for (int j = 0; j < 10000; ++j) {
+        histogram.Observe(1);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::string out;
+  histogram.Export("h", "", out);
+  EXPECT_EQ(out,
+            "h_bucket{le=\"10\"} 40000\n"
+            "h_bucket{le=\"+Inf\"} 40000\n"
+            "h_sum{} 40000\n"
+            "h_count{} 40000\n");
+}
+
+TEST(MetricsTests, ModelMetricsCountsRequests) {
+  ModelMetrics metrics;
+  {
+    ModelMetrics::Request request{metrics};
+    request.Succeeded();
+  }
+  {
+    ModelMetrics::Request request{metrics};
+    std::string out;
+    metrics.Export("", out);
+    EXPECT_NE(out.find("onnxruntime_server_requests_in_flight{} 1\n"), std::string::npos);
+  }
+
+  std::string out;
+  metrics.Export("", out);
+  EXPECT_NE(out.find("onnxruntime_server_requests_total{} 2\n"), std::string::npos);
+  EXPECT_NE(out.find("onnxruntime_server_request_failures_total{} 1\n"), std::string::npos);
+  EXPECT_NE(out.find("onnxruntime_server_requests_in_flight{} 0\n"), std::string::npos);
+  EXPECT_NE(out.find("onnxruntime_server_request_latency_us_count{} 2\n"), std::string::npos);
+}
+
+TEST(MetricsTests, ExecutorFeedsModelMetrics) {
+  ServerEnvironment* env = ServerEnv();
+  env->InitializeModel("testdata/mul_1.onnx", "Metrics", "1");
+
+  const static auto input_json = R"({"inputs":{"X":{"dims":[3,2],"dataType":1,"floatData":[1,2,3,4,5,6]}},"outputFilter":["Y"]})";
+  Executor executor(env, "RequestId");
+  PredictRequest request{};
+  PredictResponse response{};
+  EXPECT_TRUE(GetRequestFromJson(input_json, request).ok());
+  EXPECT_TRUE(executor.Predict("Metrics", "1", request, response).ok());
+
+  const auto metrics = env->ExportMetrics();
+  EXPECT_NE(metrics.find("onnxruntime_server_requests_total{model=\"Metrics\",version=\"1\"} 1\n"),
+            std::string::npos);
+  EXPECT_NE(metrics.find("onnxruntime_server_run_latency_us_count{model=\"Metrics\",version=\"1\"} 1\n"),
+            std::string::npos);
+  EXPECT_NE(metrics.find("onnxruntime_server_arena_allocations_total{model=\"Metrics\",version=\"1\"}"),
+            std::string::npos);
+
+  env->UnloadModel("Metrics", "1");
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
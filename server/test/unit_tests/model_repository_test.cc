@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include "gtest/gtest.h"
+
+#include "executor.h"
+#include "http/json_handling.h"
+#include "model_repository.h"
+#include "test_server_environment.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+namespace fs = boost::filesystem;
+
+class ModelRepositoryTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    repository_path = fs::temp_directory_path() / fs::unique_path();
+    fs::create_directories(repository_path);
+  }
+
+  void TearDown() override {
+    fs::remove_all(repository_path);
+  }
+
+  void AddVersion(const std::string& version) {
+    fs::create_directories(repository_path / "mul" / version);
+    fs::copy_file("testdata/mul_1.onnx", repository_path / "mul" / version / "model.onnx");
+  }
+
+  fs::path repository_path;
+};
+
+static void ExpectPredicts(ServerEnvironment* env, const std::string& version) {
+  const static auto input_json = R"({"inputs":{"X":{"dims":[3,2],"dataType":1,"floatData":[1,2,3,4,5,6]}},"outputFilter":["Y"]})";
+  const static auto expected = R"({"outputs":{"Y":{"dims":["3","2"],"dataType":1,"floatData":[1,4,9,16,25,36]}}})";
+  Executor executor(env, "RequestId");
+  PredictRequest request{};
+  PredictResponse response{};
+  EXPECT_TRUE(GetRequestFromJson(input_json, request).ok());
+  EXPECT_TRUE(executor.Predict("mul", version, request, response).ok());
+  std::string body;
+  GenerateResponseInJson(response, body);
+  EXPECT_EQ(expected, body);
+}
+
+TEST_F(ModelRepositoryTest, LoadsAndUnloadsVersions) {
+  ServerEnvironment* env = ServerEnv();
+  ModelRepository repository(env, repository_path.string(), BatchingOptions{}, 2);
+
+  AddVersion("1");
+  EXPECT_EQ(repository.Poll(), 1u);
+  ExpectPredicts(env, "1");
+
+  // the requests without a version run on the latest one
+  auto version_1 = env->GetModel("mul", "");
+  AddVersion("10");
+  AddVersion("9");
+  EXPECT_EQ(repository.Poll(), 3u);
+  EXPECT_EQ(env->GetModel("mul", ""), env->GetModel("mul", "10"));
+  ExpectPredicts(env, "");
+
+  // a version held by a request stays valid once it's unloaded
+  fs::remove_all(repository_path / "mul" / "1");
+  EXPECT_EQ(repository.Poll(), 2u);
+  EXPECT_THROW(env->GetModel("mul", "1"), Ort::Exception);
+  EXPECT_EQ(version_1->GetOutputNames(), std::vector<std::string>{"Y"});
+
+  // a model which fails to load isn't served
+  fs::create_directories(repository_path / "broken" / "1");
+  fs::ofstream(repository_path / "broken" / "1" / "model.onnx") << "not a model";
+  EXPECT_EQ(repository.Poll(), 2u);
+  EXPECT_THROW(env->GetModel("broken", ""), Ort::Exception);
+
+  fs::remove_all(repository_path / "mul");
+  EXPECT_EQ(repository.Poll(), 0u);
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
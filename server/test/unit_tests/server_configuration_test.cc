@@ -49,6 +49,33 @@ TEST(ConfigParsingTests, Defaults) {
   EXPECT_EQ(config.http_port, 8001);
   EXPECT_EQ(config.num_http_threads, 3);
   EXPECT_EQ(config.logging_level, ORT_LOGGING_LEVEL_INFO);
+  EXPECT_EQ(config.max_batch_size, 1);
+  EXPECT_EQ(config.max_queue_delay_us, 1000);
+}
+
+TEST(ConfigParsingTests, Batching) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+      const_cast<char*>("--max_batch_size"), const_cast<char*>("32"),
+      const_cast<char*>("--max_queue_delay_us"), const_cast<char*>("500")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(7, test_argv);
+  EXPECT_EQ(res, Result::ContinueSuccess);
+  EXPECT_EQ(config.max_batch_size, 32);
+  EXPECT_EQ(config.max_queue_delay_us, 500);
+}
+
+TEST(ConfigParsingTests, WrongMaxBatchSize) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+      const_cast<char*>("--max_batch_size"), const_cast<char*>("0")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(5, test_argv);
+  EXPECT_EQ(res, Result::ExitFailure);
 }
 
 TEST(ConfigParsingTests, Help) {
@@ -154,6 +154,10 @@ Use the individual flags to only run the specified stages.
     parser.add_argument("--tensorrt_home", help="Path to TensorRT installation dir")
     parser.add_argument("--use_full_protobuf", action='store_true', help="Use the full protobuf library")
     parser.add_argument("--disable_contrib_ops", action='store_true', help="Disable contrib ops (reduces binary size)")
+    parser.add_argument("--include_ops_by_model", action='append',
+                        help="Include only the CPU kernels used by the ONNX models of this path, a model or a directory of them (reduces binary size)")
+    parser.add_argument("--include_ops_by_config", action='append',
+                        help="Include only the CPU kernels of the operators of this config file, one 'domain;opset;op1,op2,...' per line (reduces binary size)")
     parser.add_argument("--skip_onnx_tests", action='store_true', help="Explicitly disable all onnx related tests. Note: Use --skip_tests to skip all tests.")
     parser.add_argument("--skip_winml_tests", action='store_true', help="Explicitly disable all WinML related tests")
     parser.add_argument("--enable_msvc_static_runtime", action='store_true', help="Enable static linking of MSVC runtimes.")
@@ -880,6 +884,20 @@ def generate_documentation(source_dir, build_dir, configs):
         raise BuildError('The updated operator document file '+str(operator_doc_path)+' must be checked in.\n diff:\n'+str(docdiff))
 
 
+def exclude_unused_ops(source_dir, args):
+    log.info("Excluding the kernels of the operators the models don't use")
+    log.warning("The kernel registrations of the sources are modified in place, "
+                "run tools/ci_build/exclude_unused_ops.py --restore to restore them. "
+                "The tests of the excluded kernels will fail.")
+    cmd_args = [sys.executable, os.path.join(source_dir, 'tools', 'ci_build', 'exclude_unused_ops.py'),
+                '--ort_root', source_dir]
+    for model_path in args.include_ops_by_model or []:
+        cmd_args += ['--model_path', model_path]
+    for config_path in args.include_ops_by_config or []:
+        cmd_args += ['--config_path', config_path]
+    run_subprocess(cmd_args)
+
+
 def main():
     args = parse_arguments()
 
@@ -987,6 +1005,9 @@ def main():
         if args.path_to_protoc_exe:
             path_to_protoc_exe = args.path_to_protoc_exe
 
+        if args.include_ops_by_model or args.include_ops_by_config:
+            exclude_unused_ops(source_dir, args)
+
         generate_build_tree(cmake_path, source_dir, build_dir, cuda_home, cudnn_home, tensorrt_home, path_to_protoc_exe, configs, cmake_extra_defines,
                             args, cmake_extra_args)
 
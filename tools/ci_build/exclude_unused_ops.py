@@ -0,0 +1,291 @@
+#!/usr/bin/env python3
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+
+"""
+Excludes the CPU kernels that a set of models doesn't use from the kernel registration tables, for a reduced operator
+build. The excluded entries of the tables are commented out in place, so the linker drops the code of their kernels.
+Run again with --restore to bring the tables back to the full set of kernels.
+
+The kernels kept are the ones of the operators of the models, restricted to the version of the operator the models
+import and, for the kernels registered per type, to the types of the tensors the nodes of the operator consume and
+produce. The operators the graph transformers may insert are always kept.
+"""
+
+import argparse
+import logging
+import os
+import re
+import sys
+
+logging.basicConfig(format="%(asctime)s %(name)s [%(levelname)s] - %(message)s", level=logging.DEBUG)
+log = logging.getLogger("ExcludeUnusedOps")
+
+# the registration tables to reduce, relative to the root of the repository
+KERNEL_REGISTRATION_FILES = [
+    os.path.join("onnxruntime", "core", "providers", "cpu", "cpu_execution_provider.cc"),
+    os.path.join("onnxruntime", "contrib_ops", "cpu_contrib_kernels.cc"),
+]
+
+# prefix of the lines of the excluded entries
+EXCLUDED_MARKER = "// [reduced ops] "
+
+DOMAINS = {
+    "kOnnxDomain": "ai.onnx",
+    "kMLDomain": "ai.onnx.ml",
+    "kMSDomain": "com.microsoft",
+    "kMSNchwcDomain": "com.microsoft.nchwc",
+}
+
+# the operators inserted by the graph transformers, kept for all versions and types
+OPTIMIZER_OPS = {
+    "ai.onnx": {"Cast", "Conv", "Gemm", "LayerNormalization", "MatMulInteger", "Mul", "QLinearConv", "QLinearMatMul",
+                "ReduceSum", "Transpose"},
+    "com.microsoft": {"Attention", "BiasGelu", "DynamicQuantizeMatMul", "EmbedLayerNormalization", "FastGelu",
+                      "FusedConv", "FusedElementwise", "FusedGemm", "FusedLinearClassifier", "GatherSum", "Gelu",
+                      "SkipLayerNormalization", "SparseMatMul"},
+}
+
+# the domains of which all the operators are kept, as the graph transformers insert them
+OPTIMIZER_DOMAINS = {"com.microsoft.nchwc"}
+
+# the names of the TensorProto data types in the kernel class names
+TENSOR_TYPES = {
+    "FLOAT": "float",
+    "UINT8": "uint8_t",
+    "INT8": "int8_t",
+    "UINT16": "uint16_t",
+    "INT16": "int16_t",
+    "INT32": "int32_t",
+    "INT64": "int64_t",
+    "STRING": "string",
+    "BOOL": "bool",
+    "FLOAT16": "MLFloat16",
+    "DOUBLE": "double",
+    "UINT32": "uint32_t",
+    "UINT64": "uint64_t",
+    "BFLOAT16": "BFloat16",
+}
+
+ENTRY_PATTERN = re.compile(r"BuildKernelCreateInfo<\s*(ONNX_OPERATOR_\w*KERNEL_CLASS_NAME)\s*\(([^)]*)\)\s*>\s*,")
+
+
+class RequiredOps:
+    """The versions and types of the operators needed, by domain and operator. None stands for all of them."""
+
+    def __init__(self):
+        self.ops = {}
+
+    def add(self, domain, op_type, since_version=None, types=None):
+        domain = domain or "ai.onnx"
+        versions, op_types = self.ops.setdefault((domain, op_type), (set(), set()))
+        versions.add(since_version)
+        if types is None:
+            op_types.add(None)
+        else:
+            op_types.update(types)
+
+    def keeps(self, domain, op_type, start_version, end_version, types):
+        if domain in OPTIMIZER_DOMAINS or op_type in OPTIMIZER_OPS.get(domain, set()):
+            return True
+        if (domain, op_type) not in self.ops:
+            return False
+        versions, op_types = self.ops[(domain, op_type)]
+        if None not in versions and not any(start_version <= v <= end_version for v in versions):
+            return False
+        return types is None or None in op_types or all(t in op_types for t in types)
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--model_path", action="append", default=[],
+                        help="Path to an ONNX model, or to a directory searched for *.onnx models. May be repeated.")
+    parser.add_argument("--config_path", action="append", default=[],
+                        help="Path to a file of the operators to keep, one 'domain;opset;op1,op2,...' per line. "
+                             "May be repeated.")
+    parser.add_argument("--ort_root", default=os.path.normpath(os.path.join(os.path.dirname(__file__), "..", "..")),
+                        help="Root of the onnxruntime repository.")
+    parser.add_argument("--restore", action="store_true",
+                        help="Restore the kernels excluded by a previous run, instead of excluding any.")
+    return parser.parse_args()
+
+
+def import_onnx():
+    try:
+        import onnx
+        return onnx
+    except ImportError:
+        return None
+
+
+def since_version(onnx, domain, op_type, opset):
+    """The version of the schema the operator has in the opset, or None when it can't be told."""
+    if onnx is None or opset is None:
+        return None
+    try:
+        return onnx.defs.get_schema(op_type, opset, "" if domain == "ai.onnx" else domain).since_version
+    except Exception:
+        return None
+
+
+def process_graph(onnx, graph, opsets, value_types, required_ops):
+    value_types = dict(value_types)
+    for value in list(graph.input) + list(graph.output) + list(graph.value_info):
+        if value.type.HasField("tensor_type"):
+            value_types[value.name] = value.type.tensor_type.elem_type
+    for initializer in graph.initializer:
+        value_types[initializer.name] = initializer.data_type
+
+    for node in graph.node:
+        domain = node.domain or "ai.onnx"
+        types = set()
+        for name in list(node.input) + list(node.output):
+            if not name:
+                continue
+            type_name = TENSOR_TYPES.get(onnx.TensorProto.DataType.Name(value_types.get(name, 0)))
+            if type_name is None:
+                # a value of unknown or non-tensor type, any type specific kernel may be needed
+                types = None
+                break
+            types.add(type_name)
+        required_ops.add(domain, node.op_type, since_version(onnx, domain, node.op_type, opsets.get(domain)), types)
+
+        for attribute in node.attribute:
+            if attribute.type == onnx.AttributeProto.GRAPH:
+                process_graph(onnx, attribute.g, opsets, value_types, required_ops)
+            elif attribute.type == onnx.AttributeProto.GRAPHS:
+                for subgraph in attribute.graphs:
+                    process_graph(onnx, subgraph, opsets, value_types, required_ops)
+
+
+def process_model(onnx, model_path, required_ops):
+    log.info("Reading the operators of %s", model_path)
+    model = onnx.load(model_path)
+    try:
+        model = onnx.shape_inference.infer_shapes(model)
+    except Exception as e:
+        log.warning("Shape inference of %s failed, all the types of its operators are kept: %s", model_path, e)
+    opsets = {(opset.domain or "ai.onnx"): opset.version for opset in model.opset_import}
+    process_graph(onnx, model.graph, opsets, {}, required_ops)
+
+
+def process_config(onnx, config_path, required_ops):
+    log.info("Reading the operators of %s", config_path)
+    with open(config_path, "r") as f:
+        for line in f:
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            domain, opset, op_types = line.split(";")
+            domain = domain.strip() or "ai.onnx"
+            for op_type in op_types.split(","):
+                op_type = op_type.strip()
+                if op_type:
+                    required_ops.add(domain, op_type, since_version(onnx, domain, op_type, int(opset)))
+
+
+def parse_types(type_name):
+    """The types of a type name of a kernel class, e.g. int64_t_float_float or string_int64."""
+    types = []
+    for part in type_name.split("_"):
+        if part == "t" and types:
+            types[-1] += "_t"
+        else:
+            types.append(part)
+    return [t + "_t" if re.match(r"^u?int\d+$", t) else t for t in types]
+
+
+def parse_entry(macro, args):
+    """The domain, operator, version range and types of a registration table entry, or None if it isn't a kernel."""
+    args = [arg.strip() for arg in args.split(",")]
+    domain = DOMAINS.get(args[1])
+    if domain is None:
+        return None
+    versioned = "VERSIONED" in macro
+    typed = "TYPED" in macro
+    start_version = int(args[2])
+    end_version = int(args[3]) if versioned else sys.maxsize
+    types = parse_types(args[-2]) if typed else None
+    return domain, args[-1], start_version, end_version, types
+
+
+def restore_file(path):
+    with open(path, "r") as f:
+        lines = f.readlines()
+    restored = [line[len(EXCLUDED_MARKER):] if line.startswith(EXCLUDED_MARKER) else line for line in lines]
+    if restored != lines:
+        with open(path, "w") as f:
+            f.writelines(restored)
+    return restored
+
+
+def exclude_from_file(path, required_ops):
+    lines = restore_file(path)
+    output = []
+    entry = []
+    num_entries = 0
+    num_excluded = 0
+    for line in lines:
+        if entry or line.lstrip().startswith("BuildKernelCreateInfo<ONNX_OPERATOR_"):
+            entry.append(line)
+            match = ENTRY_PATTERN.search("".join(entry))
+            if match is None:
+                continue
+            num_entries += 1
+            kernel = parse_entry(match.group(1), match.group(2))
+            if kernel is not None and not required_ops.keeps(*kernel):
+                num_excluded += 1
+                entry = [EXCLUDED_MARKER + entry_line for entry_line in entry]
+            output.extend(entry)
+            entry = []
+        else:
+            output.append(line)
+
+    if entry:
+        raise RuntimeError("Unterminated kernel registration in {}: {}".format(path, "".join(entry)))
+
+    with open(path, "w") as f:
+        f.writelines(output)
+    log.info("Excluded %d of the %d kernels of %s", num_excluded, num_entries, path)
+
+
+def main():
+    args = parse_arguments()
+    paths = [os.path.join(args.ort_root, path) for path in KERNEL_REGISTRATION_FILES]
+
+    if args.restore:
+        for path in paths:
+            restore_file(path)
+        log.info("Restored the kernels of %s", ", ".join(paths))
+        return 0
+
+    if not args.model_path and not args.config_path:
+        log.error("Either --model_path or --config_path is required to exclude the unused kernels.")
+        return 1
+
+    onnx = import_onnx()
+    if onnx is None:
+        if args.model_path:
+            log.error("The onnx python package is required to read the operators of the models: pip install onnx")
+            return 1
+        log.warning("The onnx python package isn't installed, all the versions of the configured operators are kept.")
+
+    required_ops = RequiredOps()
+    for model_path in args.model_path:
+        if os.path.isdir(model_path):
+            for root, _, files in os.walk(model_path):
+                for name in sorted(files):
+                    if name.endswith(".onnx"):
+                        process_model(onnx, os.path.join(root, name), required_ops)
+        else:
+            process_model(onnx, model_path, required_ops)
+    for config_path in args.config_path:
+        process_config(onnx, config_path, required_ops)
+
+    for path in paths:
+        exclude_from_file(path, required_ops)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -26,6 +26,8 @@ struct IMLOperatorRegistry;
 enum OrtProfilerEventCategory {
   SESSION_EVENT = 0,
   NODE_EVENT,
+  DEVICE_EVENT,
+  MEMORY_EVENT,
   EVENT_CATEGORY_MAX
 };
 
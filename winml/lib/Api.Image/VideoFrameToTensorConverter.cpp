@@ -114,6 +114,13 @@ void VideoFrameToTensorConverter::VideoFrameToSoftwareTensor(
 
 ComPtr<ID3D12Resource> VideoFrameToTensorConverter::ShareD3D11Texture(ID3D11Texture2D* pTexture, ID3D12Device* pDevice)
 {
+  return OpenD3D11TextureOnD3D12(pTexture, pDevice, &shared_handle_);
+}
+
+ComPtr<ID3D12Resource> VideoFrameToTensorConverter::OpenD3D11TextureOnD3D12(
+    _In_ ID3D11Texture2D* pTexture,
+    _In_ ID3D12Device* pDevice,
+    _Out_opt_ HANDLE* pSharedHandle) {
   assert(pTexture != nullptr);
   assert(pDevice != nullptr);
 
@@ -128,11 +135,52 @@ ComPtr<ID3D12Resource> VideoFrameToTensorConverter::ShareD3D11Texture(ID3D11Text
   ComPtr<ID3D12Resource> d3d12Resource;
   WINML_THROW_IF_FAILED(pDevice->OpenSharedHandle(safeHandle.get(), IID_PPV_ARGS(&d3d12Resource)));
 
-  shared_handle_ = safeHandle.get();
+  if (pSharedHandle != nullptr) {
+    *pSharedHandle = safeHandle.get();
+  }
 
   return d3d12Resource;
 }
 
+ComPtr<ID3D12Resource> VideoFrameToTensorConverter::TryOpenVideoFrameTextureInPlace(
+    _In_ ID3D11Texture2D* pTexture,
+    _In_ const BitmapBounds& bounds,
+    _In_ ID3D12Device* pDevice) {
+  assert(pTexture != nullptr);
+  assert(pDevice != nullptr);
+
+  D3D11_TEXTURE2D_DESC desc;
+  pTexture->GetDesc(&desc);
+
+  bool formatSupported = desc.Format == DXGI_FORMAT_B8G8R8X8_UNORM || desc.Format == DXGI_FORMAT_B8G8R8A8_UNORM ||
+                         desc.Format == DXGI_FORMAT_R8G8B8A8_UNORM || desc.Format == DXGI_FORMAT_R8_UNORM;
+  bool coversTexture = bounds.X == 0 && bounds.Y == 0 && bounds.Width == desc.Width && bounds.Height == desc.Height;
+
+  if (!(desc.MiscFlags & D3D11_RESOURCE_MISC_SHARED_NTHANDLE) || !(desc.BindFlags & D3D11_BIND_SHADER_RESOURCE) ||
+      desc.MipLevels != 1 || desc.ArraySize != 1 || desc.SampleDesc.Count != 1 || !formatSupported || !coversTexture) {
+    return nullptr;
+  }
+
+  // Reuse the resource opened for an earlier evaluation of the same texture on the same device
+  ComPtr<ID3D12Resource> spD3D12Resource;
+  UINT comPtrSize = static_cast<UINT>(sizeof(spD3D12Resource.GetAddressOf()));
+  if (SUCCEEDED(pTexture->GetPrivateData(d3d12_resource_GUID_, &comPtrSize, spD3D12Resource.GetAddressOf())) &&
+      spD3D12Resource) {
+    ComPtr<ID3D12Device> spResourceDevice;
+    WINML_THROW_IF_FAILED(spD3D12Resource->GetDevice(IID_PPV_ARGS(&spResourceDevice)));
+    if (spResourceDevice.Get() == pDevice) {
+      return spD3D12Resource;
+    }
+  }
+
+  // The resource refers to the shared allocation rather than to the texture, so caching it on the texture ties
+  // their lifetime together without a reference cycle
+  spD3D12Resource = OpenD3D11TextureOnD3D12(pTexture, pDevice, nullptr);
+  WINML_THROW_IF_FAILED(pTexture->SetPrivateDataInterface(d3d12_resource_GUID_, spD3D12Resource.Get()));
+
+  return spD3D12Resource;
+}
+
 void VideoFrameToTensorConverter::VideoFrameToDX12Tensor(
     _In_ const UINT32 batchIdx,
     _In_ winrt::Windows::AI::MachineLearning::LearningModelSession& session,
@@ -177,7 +225,14 @@ void VideoFrameToTensorConverter::VideoFrameToDX12Tensor(
     D3D11_TEXTURE2D_DESC videoFrameTextureDesc;
     spVideoFrameTexture->GetDesc(&videoFrameTextureDesc);
 
-    if (ImageConversionHelpers::TextureIsOnDevice(spVideoFrameTexture.Get(), pDeviceCache->GetD3D11Device())) {
+    // Tensorize straight from the video frame texture when it can be shared with D3D12, which saves the copy into
+    // an intermediate texture
+    ComPtr<ID3D12Resource> spInputResource =
+        TryOpenVideoFrameTextureInPlace(spVideoFrameTexture.Get(), scaledBounds, pDeviceCache->GetD3D12Device());
+    bool readInPlace = spInputResource != nullptr;
+
+    if (!readInPlace &&
+        ImageConversionHelpers::TextureIsOnDevice(spVideoFrameTexture.Get(), pDeviceCache->GetD3D11Device())) {
       // The texture is on our device, so we can just create own texture, share it and cache it
       if (!D3D11_cached_texture_) {
         WINML_THROW_IF_FAILED(pDeviceCache->GetD3D11Device()->CreateTexture2D(&videoFrameTextureDesc, nullptr, &D3D11_cached_texture_));
@@ -194,7 +249,7 @@ void VideoFrameToTensorConverter::VideoFrameToDX12Tensor(
       }
 
       CopyTextureIntoTexture(spVideoFrameTexture.Get(), scaledBounds, D3D11_cached_texture_.Get());
-    } else {
+    } else if (!readInPlace) {
       // We are not on the same device, so we can't rely on our cached texture
       ComPtr<ID3D11Device> spTextureDevice;
       spVideoFrameTexture->GetDevice(&spTextureDevice);
@@ -219,12 +274,21 @@ void VideoFrameToTensorConverter::VideoFrameToDX12Tensor(
       CopyTextureIntoTexture(spVideoFrameTexture.Get(), scaledBounds, spSharedD3D11Texture.Get());
     }
 
-    // Sync to make sure that the D3D11 texture is done copying
+    if (!readInPlace) {
+      spInputResource = input_D3D12_resource_;
+    }
+
+    // Sync to make sure that the D3D11 texture is done copying, or done being written when it is read in place
     SyncD3D11ToD3D12(*pDeviceCache, spVideoFrameTexture.Get());
 
     // We cropped the texture, shared it and converted it to a known color format, so it's time to tensorize
     // TODO: merge all videoframes to a single DX12Texture Resource before call ConvertDX12TextureToGPUTensor.
-    ConvertDX12TextureToGPUTensor(batchIdx, input_D3D12_resource_.Get(), *pDeviceCache, tensorDesc, pOutputTensor);
+    ConvertDX12TextureToGPUTensor(batchIdx, spInputResource.Get(), *pDeviceCache, tensorDesc, pOutputTensor);
+
+    if (readInPlace) {
+      // The caller owns the texture, so its next D3D11 writes must wait until the tensorization read it
+      SyncD3D12ToD3D11(*pDeviceCache, spVideoFrameTexture.Get());
+    }
   } else {
     // Invalid video frame
     WINML_THROW_IF_FAILED(E_INVALIDARG);
@@ -59,12 +59,26 @@ class VideoFrameToTensorConverter : IVideoFrameToTensorConverter, public ImageCo
   GUID d3d11_texture_GUID_ = {0x485e4bb3, 0x3fe8, 0x497b, {0x85, 0x9e, 0xc7, 0x5, 0x18, 0xdb, 0x11, 0x2a}};  // {485E4BB3-3FE8-497B-859E-C70518DB112A}
   GUID handle_GUID_ = {0xce43264e, 0x41f7, 0x4882, {0x9e, 0x20, 0xfa, 0xa5, 0x1e, 0x37, 0x64, 0xfc}};
   ;  // CE43264E-41F7-4882-9E20-FAA51E3764FC
+  GUID d3d12_resource_GUID_ = {0x9d2b5a7e, 0x64c1, 0x4f0a, {0xb3, 0x8e, 0x2f, 0x71, 0xc4, 0x05, 0x9a, 0xd6}};  // {9D2B5A7E-64C1-4F0A-B38E-2F71C4059AD6}
   Microsoft::WRL::ComPtr<ID3D12Resource> upload_heap_;
   Microsoft::WRL::ComPtr<ID3D12Resource> input_D3D12_resource_;
   HANDLE shared_handle_;
 
   Microsoft::WRL::ComPtr<ID3D12Resource> ShareD3D11Texture(ID3D11Texture2D* pTexture, ID3D12Device* pDevice);
 
+  static Microsoft::WRL::ComPtr<ID3D12Resource> OpenD3D11TextureOnD3D12(
+      _In_ ID3D11Texture2D* pTexture,
+      _In_ ID3D12Device* pDevice,
+      _Out_opt_ HANDLE* pSharedHandle);
+
+  // Returns the texture of the video frame opened on the D3D12 device when the tensorizer can read it in place,
+  // i.e. the texture was created shareable through an NT handle, can be bound as a shader resource, has a format
+  // the tensorizer converts and the bounds cover all of it. Returns nullptr when the texture has to be copied.
+  Microsoft::WRL::ComPtr<ID3D12Resource> TryOpenVideoFrameTextureInPlace(
+      _In_ ID3D11Texture2D* pTexture,
+      _In_ const winrt::Windows::Graphics::Imaging::BitmapBounds& bounds,
+      _In_ ID3D12Device* pDevice);
+
   void ConvertSoftwareBitmapToGPUTensor(
       _In_ const UINT32 batch_index,
       _In_ const winrt::Windows::Media::IVideoFrame& videoFrame,
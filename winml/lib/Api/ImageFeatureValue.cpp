@@ -8,6 +8,7 @@
 #include "LearningModelSession.h"
 #include <windows.media.h>
 #include <wrl\wrappers\corewrappers.h>
+#include <thread>
 #include "LearningModelBinding.h"
 #include "LearningModelSession.h"
 #include "LearningModelDevice.h"
@@ -239,10 +240,53 @@ static void CPUTensorize(
     com_ptr<LearningModelSession> spSession,
     BYTE* resource,
     unsigned int singleFrameBufferSize) {
-  // Tensorize video frames one by one without extra copy.
-  for (uint32_t batchIdx = 0; batchIdx < videoFrames.Size(); ++batchIdx) {
-    CPUTensorize(videoFrames.GetAt(batchIdx), bounds[batchIdx], tensorDescriptor, spSession, resource);
-    resource += singleFrameBufferSize;
+  std::vector<Windows::Media::VideoFrame> frames(videoFrames.Size(), nullptr);
+  videoFrames.GetMany(0, frames);
+
+  // Each frame is tensorized without extra copy into its own slice of the batch with its own converter, so the
+  // frames of a batch are spread over worker threads.
+  uint32_t numThreads = std::min(static_cast<uint32_t>(frames.size()), std::thread::hardware_concurrency());
+  if (numThreads <= 1) {
+    for (uint32_t batchIdx = 0; batchIdx < frames.size(); ++batchIdx) {
+      CPUTensorize(frames[batchIdx], bounds[batchIdx], tensorDescriptor, spSession, resource);
+      resource += singleFrameBufferSize;
+    }
+    return;
+  }
+
+  std::atomic<uint32_t> nextBatchIdx{0};
+  std::vector<std::exception_ptr> errors(numThreads);
+  auto tensorizeFrames = [&](uint32_t threadIdx) {
+    try {
+      for (uint32_t batchIdx = nextBatchIdx++; batchIdx < frames.size(); batchIdx = nextBatchIdx++) {
+        CPUTensorize(frames[batchIdx], bounds[batchIdx], tensorDescriptor, spSession,
+                     resource + static_cast<size_t>(batchIdx) * singleFrameBufferSize);
+      }
+    } catch (...) {
+      errors[threadIdx] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (uint32_t threadIdx = 1; threadIdx < numThreads; ++threadIdx) {
+    threads.emplace_back([&, threadIdx]() {
+      // The video frames are accessed from the multithreaded apartment, as on the background threads of EvaluateAsync
+      winrt::init_apartment(winrt::apartment_type::multi_threaded);
+      tensorizeFrames(threadIdx);
+      winrt::uninit_apartment();
+    });
+  }
+
+  // The calling thread tensorizes frames too, in its own apartment
+  tensorizeFrames(0);
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
   }
 }
 
@@ -261,7 +305,8 @@ static void GPUTensorize(
   descriptor.height = static_cast<int>(tensorDescriptor.sizes[2]);
   descriptor.luid = spDevice->GetD3DDevice()->GetAdapterLuid();  // Converted image on GPU
 
-  // Tensorize video frames one by one without extra copy.
+  // Tensorize video frames one by one without extra copy. Each frame gets its own converter, as the GPU work of a
+  // converter has to complete before it is reused.
   for (uint32_t batchIdx = 0; batchIdx < videoFrames.Size(); ++batchIdx) {
     auto pooledConverter = PoolObjectWrapper::Create(spDevice->TensorizerStore()->Fetch(descriptor));
     {
@@ -282,8 +327,8 @@ static void GPUTensorize(
       // not released to the cache.
       //
       // This object will be returned to the cache when evaluate has completed. So we cache this
-      // on the binding context.
-      context.converter = pooledConverter;
+      // on the binding context, along with the converters of the other frames of the batch.
+      context.converters.push_back(pooledConverter);
     }
   }
 }
@@ -495,8 +540,8 @@ HRESULT ImageFeatureValue::UpdateSourceResourceData(BindingContext& context, IVa
     }
   }
 
-  // Release any converters back to the pool by nulling out the wrapper.
-  context.converter = nullptr;
+  // Release any converters back to the pool by clearing out the wrappers.
+  context.converters.clear();
   return S_OK;
 }
 WINML_CATCH_ALL_COM
@@ -466,10 +466,10 @@ std::unordered_map<std::string, wf::IInspectable> LearningModelBinding::UpdatePr
 
   // Clear any converters cached on inputs to return them to the pool
   for (auto&& provider : m_providers) {
-    if (provider.second.Context.converter != nullptr) {
-      provider.second.Context.converter->Get()->Tensorizer->ResetAllocator();
-      provider.second.Context.converter = nullptr;
+    for (auto&& converter : provider.second.Context.converters) {
+      converter->Get()->Tensorizer->ResetAllocator();
     }
+    provider.second.Context.converters.clear();
   }
 
   return outputs;
@@ -20,7 +20,8 @@ struct BindingContext {
   winrt::Windows::AI::MachineLearning::LearningModelSession session = nullptr;
   winrt::Windows::AI::MachineLearning::ILearningModelFeatureDescriptor descriptor = nullptr;
   winrt::Windows::Foundation::Collections::IPropertySet properties = nullptr;
-  std::shared_ptr<PoolObjectWrapper> converter;
+  // the converters used to tensorize the value, kept out of the pool until the evaluation completed
+  std::vector<std::shared_ptr<PoolObjectWrapper>> converters;
 };
 
 struct __declspec(uuid("27e2f437-0112-4693-849e-e04323a620fb")) __declspec(novtable) ILotusValueProviderPrivate : IUnknown {
@@ -1411,6 +1411,70 @@ static void D2DInterop() {
       renderTarget.put()));
 }
 
+// Binds a texture created shareable through an NT handle, which the DirectX device tensorizes in place, and checks
+// the result matches the same pixels bound in a texture that gets copied before the tensorization
+static void SharedTextureInputBinding() {
+  // load a model (model.onnx == squeezenet[1,3,224,224])
+  std::wstring filePath = FileHelpers::GetModulePath() + L"model.onnx";
+  LearningModel model = LearningModel::LoadFromFilePath(filePath);
+  LearningModelSession session(model, LearningModelDevice(LearningModelDeviceKind::DirectX));
+
+  // grab the d3d11 device of the session
+  com_ptr<ID3D11Device> d3d11Device;
+  com_ptr<IDirect3DDxgiInterfaceAccess> deviceAccess = session.Device().Direct3D11Device().as<IDirect3DDxgiInterfaceAccess>();
+  WINML_EXPECT_HRESULT_SUCCEEDED(deviceAccess->GetInterface(__uuidof(ID3D11Device), d3d11Device.put_void()));
+
+  // a gradient, so that reading the wrong texel or channel changes the result
+  const UINT width = 224;
+  const UINT height = 224;
+  std::vector<uint8_t> pixels(width * height * 4);
+  for (UINT y = 0; y < height; y++) {
+    for (UINT x = 0; x < width; x++) {
+      uint8_t* pixel = &pixels[(y * width + x) * 4];
+      pixel[0] = static_cast<uint8_t>(x);
+      pixel[1] = static_cast<uint8_t>(y);
+      pixel[2] = static_cast<uint8_t>((x + y) / 2);
+      pixel[3] = 255;
+    }
+  }
+  D3D11_SUBRESOURCE_DATA initialData = {pixels.data(), width * 4, 0};
+
+  auto evaluate = [&](UINT miscFlags) {
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = width;
+    desc.Height = height;
+    desc.MipLevels = 1;
+    desc.ArraySize = 1;
+    desc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+    desc.MiscFlags = miscFlags;
+    com_ptr<ID3D11Texture2D> texture;
+    WINML_EXPECT_HRESULT_SUCCEEDED(d3d11Device->CreateTexture2D(&desc, &initialData, texture.put()));
+
+    com_ptr<::IInspectable> surface;
+    WINML_EXPECT_HRESULT_SUCCEEDED(CreateDirect3D11SurfaceFromDXGISurface(texture.as<IDXGISurface>().get(), surface.put()));
+    VideoFrame frame = VideoFrame::CreateWithDirect3D11Surface(
+        surface.as<winrt::Windows::Graphics::DirectX::Direct3D11::IDirect3DSurface>());
+
+    LearningModelBinding binding(session);
+    WINML_EXPECT_NO_THROW(binding.Bind(model.InputFeatures().GetAt(0).Name(), ImageFeatureValue::CreateFromVideoFrame(frame)));
+    auto result = session.Evaluate(binding, L"");
+    auto output = result.Outputs().Lookup(model.OutputFeatures().GetAt(0).Name()).as<TensorFloat>().GetAsVectorView();
+    std::vector<float> values(output.Size());
+    output.GetMany(0, values);
+    return values;
+  };
+
+  std::vector<float> copied = evaluate(0);
+  std::vector<float> inPlace = evaluate(D3D11_RESOURCE_MISC_SHARED | D3D11_RESOURCE_MISC_SHARED_NTHANDLE);
+  WINML_EXPECT_EQUAL(copied.size(), inPlace.size());
+  for (size_t i = 0; i < copied.size(); i++) {
+    WINML_EXPECT_TRUE(std::abs(copied[i] - inPlace[i]) <= 1e-5f);
+  }
+}
+
 const ScenarioTestApi& getapi() {
   static constexpr ScenarioTestApi api =
       {
@@ -1451,6 +1515,7 @@ const ScenarioTestApi& getapi() {
         DeviceLostRecovery,
         Scenario8SetDeviceSampleD3D11Device,
         D2DInterop,
+        SharedTextureInputBinding,
       };
   return api;
 }
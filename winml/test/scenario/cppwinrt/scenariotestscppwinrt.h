@@ -41,6 +41,7 @@ struct ScenarioTestApi
     VoidTest DeviceLostRecovery;
     VoidTest Scenario8SetDeviceSampleD3D11Device;
     VoidTest D2DInterop;
+    VoidTest SharedTextureInputBinding;
 };
 const ScenarioTestApi& getapi();
 
@@ -85,4 +86,5 @@ WINML_TEST_CLASS_BEGIN_WITH_SETUP(ScenarioCppWinrtGpuSkipEdgeCoreTest, ScenarioC
 WINML_TEST(ScenarioCppWinrtGpuSkipEdgeCoreTest, Scenario8SetDeviceSampleMyCameraDevice)
 WINML_TEST(ScenarioCppWinrtGpuSkipEdgeCoreTest, Scenario8SetDeviceSampleD3D11Device )
 WINML_TEST(ScenarioCppWinrtGpuSkipEdgeCoreTest, D2DInterop)
+WINML_TEST(ScenarioCppWinrtGpuSkipEdgeCoreTest, SharedTextureInputBinding)
 WINML_TEST_CLASS_END()
\ No newline at end of file